@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Persistent analysis worker for dase_cli
+=======================================
+
+dase_cli's python_analyze / analyze_fields used to start a fresh interpreter
+per script, paying interpreter start-up and the numpy / scipy / matplotlib
+imports every call.  This worker is started once and runs scripts in-process
+on request; imported modules stay loaded between runs.
+
+Protocol (one JSON object per line on stdin / stdout):
+
+    request:  {"script": "analyze_igsoa_state.py", "argv": ["state.json", "2.0"]}
+    response: {"exit_code": 0, "stdout": "...", "stderr": "..."}
+
+Each script runs as __main__ in fresh globals with sys.argv set as if it had
+been started from the command line.  Nothing but responses is written to
+the real stdout.
+"""
+
+import contextlib
+import io
+import json
+import os
+import runpy
+import sys
+import traceback
+
+# Scripts save figures; never try to open a window
+os.environ.setdefault("MPLBACKEND", "Agg")
+
+
+def run_script(request):
+    script = request["script"]
+    argv = [script] + [str(arg) for arg in request.get("argv", [])]
+    out = io.StringIO()
+    err = io.StringIO()
+    exit_code = 0
+
+    saved_argv = sys.argv
+    saved_path = list(sys.path)
+    sys.argv = argv
+    sys.path.insert(0, os.path.dirname(os.path.abspath(script)))
+    try:
+        with contextlib.redirect_stdout(out), contextlib.redirect_stderr(err):
+            runpy.run_path(script, run_name="__main__")
+    except SystemExit as e:
+        if e.code is None:
+            exit_code = 0
+        elif isinstance(e.code, int):
+            exit_code = e.code
+        else:
+            err.write(str(e.code) + "\n")
+            exit_code = 1
+    except BaseException:
+        traceback.print_exc(file=err)
+        exit_code = 1
+    finally:
+        sys.argv = saved_argv
+        sys.path[:] = saved_path
+        # Figures left open by one script must not leak into the next
+        pyplot = sys.modules.get("matplotlib.pyplot")
+        if pyplot is not None:
+            pyplot.close("all")
+
+    return {"exit_code": exit_code, "stdout": out.getvalue(), "stderr": err.getvalue()}
+
+
+def main():
+    responses = sys.stdout
+    for line in sys.stdin:
+        line = line.strip()
+        if not line:
+            continue
+        try:
+            response = run_script(json.loads(line))
+        except Exception as e:
+            response = {"exit_code": 1, "stdout": "", "stderr": "worker error: %s\n" % e}
+        responses.write(json.dumps(response) + "\n")
+        responses.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,67 @@
+/**
+ * FFT analysis micro-benchmarks (Google Benchmark)
+ *
+ * EngineFFTAnalysis 1D/2D/3D spectra of a real field, as analyze_fields
+ * and engine_fft run them.  Items are field samples; bytes are the real
+ * input plus the complex spectrum.
+ */
+
+#include "engine_fft_analysis.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using dase::analysis::EngineFFTAnalysis;
+
+std::vector<double> testField(size_t n) {
+    std::vector<double> field(n);
+    for (size_t i = 0; i < n; ++i) {
+        field[i] = std::sin(0.05 * static_cast<double>(i)) + 0.25 * std::cos(0.31 * static_cast<double>(i));
+    }
+    return field;
+}
+
+void setFFTCounters(benchmark::State& state, std::int64_t samples) {
+    state.SetItemsProcessed(state.iterations() * samples);
+    state.SetBytesProcessed(state.iterations() * samples * static_cast<std::int64_t>(3 * sizeof(double)));
+}
+
+void BM_FFT1D(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto field = testField(n);
+    for (auto _ : state) {
+        auto result = EngineFFTAnalysis::compute1DFFT(field, "psi_real");
+        benchmark::DoNotOptimize(result.total_power);
+    }
+    setFFTCounters(state, static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_FFT1D)->RangeMultiplier(16)->Range(1 << 12, 1 << 20)->UseRealTime();
+
+void BM_FFT2D(benchmark::State& state) {
+    const auto side = static_cast<size_t>(state.range(0));
+    const auto field = testField(side * side);
+    for (auto _ : state) {
+        auto result = EngineFFTAnalysis::compute2DFFT(field, side, side, "psi_real");
+        benchmark::DoNotOptimize(result.total_power);
+    }
+    setFFTCounters(state, static_cast<std::int64_t>(side * side));
+}
+BENCHMARK(BM_FFT2D)->Arg(128)->Arg(512)->UseRealTime();
+
+void BM_FFT3D(benchmark::State& state) {
+    const auto side = static_cast<size_t>(state.range(0));
+    const auto field = testField(side * side * side);
+    for (auto _ : state) {
+        auto result = EngineFFTAnalysis::compute3DFFT(field, side, side, side, "psi_real");
+        benchmark::DoNotOptimize(result.total_power);
+    }
+    setFFTCounters(state, static_cast<std::int64_t>(side * side * side));
+}
+BENCHMARK(BM_FFT3D)->Arg(32)->Arg(64)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,261 @@
+/**
+ * DASE engine kernel micro-benchmarks (Google Benchmark)
+ *
+ * Phase 4B/4C missions, IGSOA 1D/2D/3D time steps and neighbour reads, and
+ * SATP evolve.  Each iteration advances the engine (or one coupling pass);
+ * items are node updates and bytes are the node state each update reads
+ * and writes, so items/s and bytes/s compare across sizes and versions.  Where RAPL / EMI package energy counters are
+ * readable, watts and J_per_node_update are reported as well (package-wide:
+ * run on an otherwise idle machine).
+ */
+
+#include "analog_universal_node_engine_avx2.h"
+#include "energy_meter.h"
+#include "igsoa_complex_engine.h"
+#include "igsoa_complex_engine_2d.h"
+#include "igsoa_complex_engine_3d.h"
+#include "igsoa_simd_coupling.h"
+#include "igsoa_state_soa.h"
+#include "neighbor_cache.h"
+#include "satp_higgs_engine_1d.h"
+#include "satp_higgs_engine_3d.h"
+#include "satp_higgs_physics_1d.h"
+#include "satp_higgs_physics_3d.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t kMissionIterations = 30;   // Default iterations_per_node
+constexpr std::uint64_t kMissionSteps = 16;
+
+// Integrator, feedback, previous input and output per node
+constexpr std::int64_t kAnalogNodeStateBytes = 4 * sizeof(double);
+
+struct MissionSignals {
+    std::vector<double> input;
+    std::vector<double> control;
+
+    explicit MissionSignals(std::uint64_t steps) : input(steps), control(steps) {
+        for (std::uint64_t i = 0; i < steps; ++i) {
+            input[i] = std::sin(static_cast<double>(i) * 0.01);
+            control[i] = std::cos(static_cast<double>(i) * 0.01);
+        }
+    }
+};
+
+// Package energy over the timed loop; construct just before it
+class LoopEnergy {
+public:
+    LoopEnergy() {
+        if (meter_.open()) {
+            meter_.start();
+        }
+    }
+    EnergySample stop() noexcept { return meter_.isOpen() ? meter_.stop() : EnergySample{}; }
+
+private:
+    EnergyMeter meter_;
+};
+
+void setNodeCounters(benchmark::State& state, std::int64_t node_updates, std::int64_t bytes_per_update,
+                     LoopEnergy& energy) {
+    state.SetItemsProcessed(node_updates);
+    state.SetBytesProcessed(node_updates * bytes_per_update * 2);   // Read + write
+    const EnergySample sample = energy.stop();
+    if (sample.valid && node_updates > 0) {
+        state.counters["watts"] = sample.averageWatts();
+        state.counters["J_per_node_update"] = sample.joules / static_cast<double>(node_updates);
+    }
+}
+
+void BM_Phase4B_Mission(benchmark::State& state) {
+    const auto nodes = static_cast<std::size_t>(state.range(0));
+    AnalogCellularEngineAVX2 engine(nodes);
+    MissionSignals signals(kMissionSteps);
+    LoopEnergy energy;
+    for (auto _ : state) {
+        engine.runMissionOptimized_Phase4B(signals.input.data(), signals.control.data(), kMissionSteps,
+                                           kMissionIterations);
+        benchmark::ClobberMemory();
+    }
+    setNodeCounters(state, static_cast<std::int64_t>(state.iterations() * nodes * kMissionSteps * kMissionIterations),
+                    kAnalogNodeStateBytes, energy);
+}
+BENCHMARK(BM_Phase4B_Mission)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->UseRealTime();
+
+void BM_Phase4C_Mission(benchmark::State& state) {
+    const auto nodes = static_cast<std::size_t>(state.range(0));
+    AnalogCellularEngineAVX2 engine(nodes);
+    MissionSignals signals(kMissionSteps);
+    LoopEnergy energy;
+    for (auto _ : state) {
+        engine.runMissionOptimized_Phase4C(signals.input.data(), signals.control.data(), kMissionSteps,
+                                           kMissionIterations);
+        benchmark::ClobberMemory();
+    }
+    setNodeCounters(state, static_cast<std::int64_t>(state.iterations() * nodes * kMissionSteps * kMissionIterations),
+                    kAnalogNodeStateBytes, energy);
+    state.SetLabel(engine.getMissionKernelISA() == KernelISA::AVX512 ? "avx512"
+                   : engine.getMissionKernelISA() == KernelISA::AVX2 ? "avx2" : "scalar");
+}
+BENCHMARK(BM_Phase4C_Mission)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->UseRealTime();
+
+// IGSOA: args are (nodes per side, R_c).  One iteration is one timeStep.
+dase::igsoa::IGSOAComplexConfig igsoaConfig(std::size_t num_nodes, double R_c) {
+    dase::igsoa::IGSOAComplexConfig config;
+    config.num_nodes = static_cast<std::uint32_t>(num_nodes);
+    config.R_c_default = R_c;
+    return config;
+}
+
+constexpr std::int64_t kIgsoaNodeStateBytes = sizeof(dase::igsoa::IGSOAComplexNode);
+
+void BM_IGSOA1D_TimeStep(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    dase::igsoa::IGSOAComplexEngine engine(igsoaConfig(n, static_cast<double>(state.range(1))));
+    LoopEnergy energy;
+    for (auto _ : state) {
+        engine.runMission(1);
+        benchmark::ClobberMemory();
+    }
+    setNodeCounters(state, static_cast<std::int64_t>(state.iterations() * n), kIgsoaNodeStateBytes, energy);
+}
+BENCHMARK(BM_IGSOA1D_TimeStep)
+    ->ArgsProduct({{1 << 12, 1 << 16}, {1, 3, 8}})
+    ->ArgNames({"N", "R_c"})
+    ->UseRealTime();
+
+void BM_IGSOA2D_TimeStep(benchmark::State& state) {
+    const auto side = static_cast<std::size_t>(state.range(0));
+    dase::igsoa::IGSOAComplexEngine2D engine(igsoaConfig(side * side, static_cast<double>(state.range(1))), side, side);
+    LoopEnergy energy;
+    for (auto _ : state) {
+        engine.runMission(1);
+        benchmark::ClobberMemory();
+    }
+    setNodeCounters(state, static_cast<std::int64_t>(state.iterations() * side * side), kIgsoaNodeStateBytes, energy);
+}
+BENCHMARK(BM_IGSOA2D_TimeStep)
+    ->ArgsProduct({{64, 256}, {1, 3, 8}})
+    ->ArgNames({"side", "R_c"})
+    ->UseRealTime();
+
+// Ψ mirror (igsoa_state_soa.h): one 2D coupling pass over the interior
+// nodes, walking the uniform-R_c stencil's contiguous runs as the engines
+// do.  read = 0 reads neighbour Ψ from the node records; 1 and 2 gather
+// IGSOAStateSoA from them first (timed with the pass) and read the packed
+// arrays with the scalar (1) or AVX2 (2, where available) run kernel.
+void BM_IGSOA2D_NeighbourReads(benchmark::State& state) {
+    const auto side = static_cast<std::size_t>(state.range(0));
+    const std::int64_t read = state.range(2);
+    std::vector<dase::igsoa::IGSOAComplexNode> nodes(side * side);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].psi = {std::cos(0.1 * static_cast<double>(i)), std::sin(0.1 * static_cast<double>(i))};
+    }
+    dase::igsoa::NeighborStencil2D stencil;
+    stencil.build(side, side, static_cast<double>(state.range(1)));
+    dase::igsoa::IGSOAStateSoA soa(nodes.size());
+    std::vector<std::complex<double>> coupling(nodes.size());
+    const bool simd = read == 2 && dase::igsoa::IGSOACouplingKernels::avx2Available();
+
+    const std::size_t reach = static_cast<std::size_t>(stencil.reach());
+    const std::ptrdiff_t* offset = stencil.linearOffset();
+    const std::size_t* run_begin = stencil.runBegin();
+    const std::size_t* run_length = stencil.runLength();
+    const double* weight = stencil.weight();
+    auto pass = [&](auto accumulate_run) {
+        for (std::size_t y = reach; y < side - reach; ++y) {
+            for (std::size_t x = reach; x < side - reach; ++x) {
+                const std::size_t i = y * side + x;
+                double sum_re = 0.0;
+                double sum_im = 0.0;
+                for (std::size_t r = 0; r < stencil.numRuns(); ++r) {
+                    const std::size_t k0 = run_begin[r];
+                    accumulate_run(i, static_cast<std::size_t>(static_cast<std::ptrdiff_t>(i) + offset[k0]),
+                                   weight + k0, run_length[r], sum_re, sum_im);
+                }
+                coupling[i] = {sum_re, sum_im};
+            }
+        }
+    };
+    LoopEnergy energy;
+    for (auto _ : state) {
+        if (read == 0) {
+            pass([&](std::size_t i, std::size_t j0, const double* w, std::size_t n, double& sum_re, double& sum_im) {
+                const std::complex<double> self = nodes[i].psi;
+                for (std::size_t k = 0; k < n; ++k) {
+                    sum_re += w[k] * (nodes[j0 + k].psi.real() - self.real());
+                    sum_im += w[k] * (nodes[j0 + k].psi.imag() - self.imag());
+                }
+            });
+        } else {
+            soa.gatherPsi(nodes);
+            pass([&](std::size_t i, std::size_t j0, const double* w, std::size_t n, double& sum_re, double& sum_im) {
+                dase::igsoa::IGSOACouplingKernels::accumulateContiguous(
+                    simd, soa.psi_re.data() + j0, soa.psi_im.data() + j0, w, n,
+                    soa.psi_re[i], soa.psi_im[i], sum_re, sum_im);
+            });
+        }
+        benchmark::DoNotOptimize(coupling.data());
+        benchmark::ClobberMemory();
+    }
+    const std::size_t interior = (side - 2 * reach) * (side - 2 * reach);
+    setNodeCounters(state, static_cast<std::int64_t>(state.iterations() * interior), kIgsoaNodeStateBytes, energy);
+}
+BENCHMARK(BM_IGSOA2D_NeighbourReads)
+    ->ArgsProduct({{256, 1024}, {1, 3, 8}, {0, 1, 2}})
+    ->ArgNames({"side", "R_c", "read"})
+    ->UseRealTime();
+
+void BM_IGSOA3D_TimeStep(benchmark::State& state) {
+    const auto side = static_cast<std::size_t>(state.range(0));
+    dase::igsoa::IGSOAComplexEngine3D engine(igsoaConfig(side * side * side, static_cast<double>(state.range(1))),
+                                             side, side, side);
+    LoopEnergy energy;
+    for (auto _ : state) {
+        engine.runMission(1);
+        benchmark::ClobberMemory();
+    }
+    setNodeCounters(state, static_cast<std::int64_t>(state.iterations() * side * side * side), kIgsoaNodeStateBytes,
+                    energy);
+}
+BENCHMARK(BM_IGSOA3D_TimeStep)
+    ->ArgsProduct({{16, 32}, {1, 3}})
+    ->ArgNames({"side", "R_c"})
+    ->UseRealTime();
+
+// SATP: phi, phi_dot, h, h_dot per node.  One iteration is one evolve step.
+constexpr std::int64_t kSatpNodeStateBytes = 4 * sizeof(double);
+
+void BM_SATP1D_Evolve(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    dase::satp_higgs::SATPHiggsEngine1D engine(n, 0.1, 0.01, dase::satp_higgs::SATPHiggsParams());
+    LoopEnergy energy;
+    for (auto _ : state) {
+        engine.evolve(1);
+        benchmark::ClobberMemory();
+    }
+    setNodeCounters(state, static_cast<std::int64_t>(state.iterations() * n), kSatpNodeStateBytes, energy);
+}
+BENCHMARK(BM_SATP1D_Evolve)->RangeMultiplier(16)->Range(1 << 12, 1 << 20)->UseRealTime();
+
+void BM_SATP3D_Evolve(benchmark::State& state) {
+    const auto side = static_cast<std::size_t>(state.range(0));
+    dase::satp_higgs::SATPHiggsEngine3D engine(side, side, side, 0.1, 0.01, dase::satp_higgs::SATPHiggsParams());
+    LoopEnergy energy;
+    for (auto _ : state) {
+        engine.evolve(1);
+        benchmark::ClobberMemory();
+    }
+    setNodeCounters(state, static_cast<std::int64_t>(state.iterations() * side * side * side), kSatpNodeStateBytes,
+                    energy);
+}
+BENCHMARK(BM_SATP3D_Evolve)->Arg(32)->Arg(64)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,12 @@
+/**
+ * dase_benchmarks entry point
+ *
+ *   dase_benchmarks --benchmark_out=results.json --benchmark_out_format=json
+ *
+ * writes the machine-readable results for regression tracking alongside
+ * the console table; --benchmark_filter=<regex> picks a subset.
+ */
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
@@ -0,0 +1,85 @@
+/**
+ * SID micro-benchmarks (Google Benchmark)
+ *
+ * Expression parsing, pattern matching over a diagram of many candidate
+ * roots, and in-place rewriting (undone after every application so each
+ * iteration sees the same diagram).
+ */
+
+#include "sid_ssp/sid_diagram.hpp"
+#include "sid_ssp/sid_parser_impl.hpp"
+#include "sid_ssp/sid_rewrite.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using namespace sid;
+
+// `copies` - 1 roots C(P(A_i), P(B_i)) that fail the C(P($x), O(P($y)))
+// pattern at the second argument, then one that matches
+Diagram candidateDiagram(int copies) {
+    Diagram diagram;
+    const Bindings none;
+    for (int i = 0; i + 1 < copies; ++i) {
+        const std::string n = std::to_string(i);
+        buildExpr(parseExpression("C(P(A" + n + "), P(B" + n + "))"), diagram, none, "bench");
+    }
+    buildExpr(parseExpression("C(P(Freedom), O(P(Liberty)))"), diagram, none, "bench");
+    return diagram;
+}
+
+void BM_SID_Parse(benchmark::State& state) {
+    // A nested expression of about state.range(0) operators
+    std::string text = "Freedom";
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        text = (i % 2 ? "O(" : "P(") + text + ")";
+    }
+    text = "C(" + text + ", S+(P(A), P(B), P(D)))";
+    for (auto _ : state) {
+        auto expr = parseExpression(text);
+        benchmark::DoNotOptimize(expr);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_SID_Parse)->Arg(4)->Arg(64);
+
+void BM_SID_Match(benchmark::State& state) {
+    const int copies = static_cast<int>(state.range(0));
+    const Diagram diagram = candidateDiagram(copies);
+    const ASTNode pattern = parseExpression("C(P($x), O(P($y)))");
+    MatchScratch scratch;
+    for (auto _ : state) {
+        auto match = findExprMatch(diagram, pattern, scratch);
+        benchmark::DoNotOptimize(match);
+    }
+    // Items are candidate roots tried; bytes the nodes they span
+    state.SetItemsProcessed(state.iterations() * copies);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(diagram.nodes_count() * sizeof(Node)));
+}
+BENCHMARK(BM_SID_Match)->RangeMultiplier(16)->Range(16, 4096);
+
+void BM_SID_Rewrite(benchmark::State& state) {
+    Diagram diagram = candidateDiagram(static_cast<int>(state.range(0)));
+    const CompiledRule rule = compileRule("C(P($x), O(P($y)))", "C(O(P($x)), P($y))", "bench");
+    MatchScratch scratch;
+    int64_t nodes_added = 0;
+    for (auto _ : state) {
+        auto result = applyCompiledRewriteInPlace(diagram, rule, &scratch);
+        if (!result.applied) {
+            state.SkipWithError("rewrite did not apply");
+            break;
+        }
+        nodes_added += static_cast<int64_t>(result.added_nodes.size());
+        undoRewrite(diagram, result.undo);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(nodes_added * static_cast<int64_t>(sizeof(Node)));
+}
+BENCHMARK(BM_SID_Rewrite)->Arg(16)->Arg(1024);
+
+} // namespace
@@ -0,0 +1,159 @@
+/**
+ * Process counters implementation: counting allocator and RSS queries
+ */
+
+#include "process_counters.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// COUNTING ALLOCATOR
+// ============================================================================
+
+namespace {
+
+std::atomic<uint64_t> g_alloc_calls{0};
+std::atomic<uint64_t> g_alloc_bytes{0};
+std::atomic<uint64_t> g_free_calls{0};
+
+void* countedAlloc(std::size_t size) {
+    g_alloc_calls.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* countedAlignedAlloc(std::size_t size, std::size_t alignment) {
+    g_alloc_calls.fetch_add(1, std::memory_order_relaxed);
+    g_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+#if defined(_WIN32)
+    return _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment,
+                          size == 0 ? 1 : size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void countedFree(void* ptr) {
+    if (ptr) {
+        g_free_calls.fetch_add(1, std::memory_order_relaxed);
+        std::free(ptr);
+    }
+}
+
+void countedAlignedFree(void* ptr) {
+    if (ptr) {
+        g_free_calls.fetch_add(1, std::memory_order_relaxed);
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* ptr = countedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* ptr = countedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = countedAlignedAlloc(size, static_cast<std::size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = countedAlignedAlloc(size, static_cast<std::size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { countedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { countedAlignedFree(ptr); }
+
+// ============================================================================
+// PROCESS COUNTERS
+// ============================================================================
+
+namespace dase {
+namespace bench {
+
+AllocSnapshot AllocSnapshot::take() {
+    AllocSnapshot snapshot;
+    snapshot.calls = g_alloc_calls.load(std::memory_order_relaxed);
+    snapshot.bytes = g_alloc_bytes.load(std::memory_order_relaxed);
+    const uint64_t frees = g_free_calls.load(std::memory_order_relaxed);
+    snapshot.live = snapshot.calls > frees ? snapshot.calls - frees : 0;
+    return snapshot;
+}
+
+double residentMB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<double>(counters.WorkingSetSize) / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    unsigned long long pages_total = 0;
+    unsigned long long pages_resident = 0;
+    if (!(statm >> pages_total >> pages_resident)) {
+        return 0.0;
+    }
+    return static_cast<double>(pages_resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#else
+    return 0.0;
+#endif
+}
+
+double peakResidentMB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#elif defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            double kb = 0.0;
+            status >> kb;
+            return kb / 1024.0;
+        }
+        status.ignore(4096, '\n');
+    }
+    return 0.0;
+#else
+    return 0.0;
+#endif
+}
+
+} // namespace bench
+} // namespace dase
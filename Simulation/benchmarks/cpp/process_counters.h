@@ -0,0 +1,35 @@
+/**
+ * Process counters shared by the long-running benchmark tools (dase_soak,
+ * dase_replay)
+ *
+ * process_counters.cpp replaces the global operator new / delete with
+ * counting versions, which covers every container in the engines and the
+ * CLI router.  List it among an executable's sources, never in a library
+ * that other targets link.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace dase {
+namespace bench {
+
+// Heap allocations since process start (every thread)
+struct AllocSnapshot {
+    uint64_t calls = 0;
+    uint64_t bytes = 0;
+    uint64_t live = 0;          // Allocations not yet freed
+
+    static AllocSnapshot take();
+};
+
+// Resident set size in MB; 0 where the platform has no cheap query
+double residentMB();
+
+// Peak resident set size of the process in MB (VmHWM on Linux, peak
+// working set on Windows); 0 where unavailable
+double peakResidentMB();
+
+} // namespace bench
+} // namespace dase
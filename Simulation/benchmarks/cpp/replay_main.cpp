@@ -0,0 +1,529 @@
+/**
+ * dase_replay - mission replay benchmark
+ *
+ *   dase_replay --mission=missions/SATP_v1.json --repeat=5 --out=satp_v1.replay.json
+ *   dase_replay --mission=missions/SATP_v1.json --repeat=5 --baseline=satp_v1.replay.json
+ *
+ * Runs a mission file in-process through CommandRouter, the way dase_cli
+ * runs it from stdin, --warmup + --repeat times with a fresh router each
+ * time (engine ids restart at engine_001), and writes one JSON report:
+ *
+ *   steps       per mission command: parse / execute / serialize latency
+ *               over the repetitions, share of the mission time, errors,
+ *               heap allocations and bytes out per repetition
+ *   by_command  the same time summed per command name
+ *   engines     per engine id: steps advanced (steps_completed of its
+ *               commands), execute time and steps/s
+ *   memory      peak RSS, RSS and live allocations after each repetition,
+ *               allocation calls / bytes per repetition
+ *
+ * A report doubles as the saved replay profile: with --baseline, the run is
+ * diffed against an earlier report and the exit code is 1 on any
+ * regression beyond --max-regression (relative; timings also need
+ * --min-delta-us absolute):
+ *
+ *   mission_time        median repetition time rose
+ *   step_time           a step's median parse + execute + serialize rose
+ *   engine_throughput   an engine's steps/s fell
+ *   allocations         allocation calls per repetition rose
+ *   peak_rss            peak RSS rose (and by more than 8 MB)
+ *
+ * Step comparisons need the same command sequence; a changed mission is
+ * reported as mission_changed and only the totals are compared.
+ *
+ * Mission files are JSON lines (one command per line) or a single JSON
+ * command or array of commands.  Files the commands write land relative to
+ * --workdir (default: the current directory; --out stays relative to where
+ * dase_replay started).  Commands run inside run_graph / run_batch count
+ * toward that one step.
+ */
+
+#include "command_router.h"
+#include "json_text_writer.h"
+#include "process_counters.h"
+#include "router_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+using dase::bench::AllocSnapshot;
+
+uint64_t nsSince(Clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+// ============================================================================
+// MISSION
+// ============================================================================
+
+struct MissionCommand {
+    std::string text;           // Parsed again in every repetition
+    std::string name;           // "" when the text is not a command
+};
+
+std::vector<MissionCommand> loadMission(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open mission " + path);
+    }
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::vector<std::string> texts;
+    if (json::accept(content)) {
+        const json whole = json::parse(content);
+        if (whole.is_array()) {
+            for (const auto& command : whole) texts.push_back(command.dump());
+        } else {
+            texts.push_back(whole.dump());
+        }
+    } else {
+        std::istringstream lines(content);
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.find_first_not_of(" \t") != std::string::npos) texts.push_back(line);
+        }
+    }
+
+    std::vector<MissionCommand> mission;
+    for (auto& text : texts) {
+        MissionCommand command;
+        if (json::accept(text)) {
+            const json parsed = json::parse(text);
+            if (parsed.is_object() && parsed.contains("command") && parsed["command"].is_string()) {
+                command.name = parsed["command"].get<std::string>();
+            }
+        }
+        command.text = std::move(text);
+        mission.push_back(std::move(command));
+    }
+    if (mission.empty()) {
+        throw std::runtime_error("mission has no commands: " + path);
+    }
+    return mission;
+}
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+
+struct ReplayOptions {
+    std::string mission;
+    int repeat = 5;
+    int warmup = 1;
+    std::string out = "-";
+    std::string baseline;
+    std::string workdir;
+    double max_regression = 0.15;
+    double min_delta_us = 100.0;
+};
+
+void printUsage() {
+    std::cerr << "usage: dase_replay --mission=<file> [--repeat=5] [--warmup=1] [--out=-]\n"
+                 "                   [--baseline=<report>] [--max-regression=0.15] [--min-delta-us=100]\n"
+                 "                   [--workdir=<dir>]\n";
+}
+
+bool parseOptions(int argc, char** argv, ReplayOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string key = arg.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--help" || key == "-h") {
+            return false;
+        }
+        if (value.empty()) {
+            std::cerr << "dase_replay: " << key << " needs =<value>" << std::endl;
+            return false;
+        }
+        if (key == "--mission") options.mission = value;
+        else if (key == "--repeat") options.repeat = std::stoi(value);
+        else if (key == "--warmup") options.warmup = std::stoi(value);
+        else if (key == "--out") options.out = value;
+        else if (key == "--baseline") options.baseline = value;
+        else if (key == "--workdir") options.workdir = value;
+        else if (key == "--max-regression") options.max_regression = std::stod(value);
+        else if (key == "--min-delta-us") options.min_delta_us = std::stod(value);
+        else {
+            std::cerr << "dase_replay: unknown option " << key << std::endl;
+            return false;
+        }
+    }
+    if (options.mission.empty()) {
+        std::cerr << "dase_replay: --mission is required" << std::endl;
+        return false;
+    }
+    if (options.repeat < 1 || options.warmup < 0 || options.max_regression < 0.0 || options.min_delta_us < 0.0) {
+        std::cerr << "dase_replay: repeat must be positive, warmup and thresholds non-negative" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+struct StepStats {
+    dase::LatencyHistogram parse;
+    dase::LatencyHistogram execute;
+    dase::LatencyHistogram serialize;
+    uint64_t errors = 0;
+    uint64_t alloc_calls = 0;
+    uint64_t alloc_bytes = 0;
+    uint64_t bytes_out = 0;
+};
+
+struct EngineStats {
+    std::string engine_type;
+    uint64_t steps = 0;
+    uint64_t execute_ns = 0;
+};
+
+struct ReplayTotals {
+    std::vector<StepStats> steps;
+    std::map<std::string, EngineStats> engines;
+    dase::LatencyHistogram repetition;
+    json rss_mb = json::array();
+    json live_allocs = json::array();
+    uint64_t alloc_calls = 0;
+    uint64_t alloc_bytes = 0;
+};
+
+// One repetition on a fresh router; recorded into `totals` if `measured`
+void replayOnce(const std::vector<MissionCommand>& mission, bool measured, ReplayTotals& totals) {
+    const AllocSnapshot repetition_alloc = AllocSnapshot::take();
+    uint64_t repetition_ns = 0;
+    {
+        CommandRouter router;
+        uint64_t stream_bytes = 0;
+        router.setStreamSink([&stream_bytes](const json& message, dase::protocol::Segments& segments) {
+            stream_bytes += dase::protocol::dumpJsonText(message, segments).size() + 1;
+        });
+
+        for (size_t i = 0; i < mission.size(); ++i) {
+            const AllocSnapshot before = AllocSnapshot::take();
+            stream_bytes = 0;
+
+            const auto parse_start = Clock::now();
+            json command;
+            bool parsed = true;
+            try {
+                command = json::parse(mission[i].text);
+            } catch (const json::parse_error&) {
+                parsed = false;
+            }
+            const uint64_t parse_ns = nsSince(parse_start);
+
+            uint64_t execute_ns = 0;
+            uint64_t serialize_ns = 0;
+            bool ok = false;
+            json response;
+            if (parsed) {
+                dase::protocol::Segments segments;
+                const auto execute_start = Clock::now();
+                response = router.execute(command, &segments);
+                execute_ns = nsSince(execute_start);
+
+                const auto serialize_start = Clock::now();
+                const std::string text = dase::protocol::dumpJsonText(response, segments);
+                serialize_ns = nsSince(serialize_start);
+                router.recycleSegments(segments);
+                stream_bytes += text.size() + 1;
+                ok = response.value("status", "") != "error";
+            }
+            repetition_ns += parse_ns + execute_ns + serialize_ns;
+            if (!measured) {
+                continue;
+            }
+
+            const AllocSnapshot after = AllocSnapshot::take();
+            StepStats& step = totals.steps[i];
+            step.parse.record(parse_ns);
+            if (parsed) {
+                step.execute.record(execute_ns);
+                step.serialize.record(serialize_ns);
+            }
+            step.errors += ok ? 0 : 1;
+            step.alloc_calls += after.calls - before.calls;
+            step.alloc_bytes += after.bytes - before.bytes;
+            step.bytes_out += stream_bytes;
+
+            // Engine ids and the steps their commands advanced
+            if (!ok || !response.contains("result") || !response["result"].is_object()) {
+                continue;
+            }
+            const json& result = response["result"];
+            const json params = command.value("params", json::object());
+            if (mission[i].name == "create_engine" && result.contains("engine_id") && result["engine_id"].is_string()) {
+                totals.engines[result["engine_id"].get<std::string>()].engine_type =
+                    params.value("engine_type", std::string());
+            }
+            if (result.contains("steps_completed") && result["steps_completed"].is_number() &&
+                params.contains("engine_id") && params["engine_id"].is_string()) {
+                EngineStats& engine = totals.engines[params["engine_id"].get<std::string>()];
+                engine.steps += result["steps_completed"].get<uint64_t>();
+                engine.execute_ns += execute_ns;
+            }
+        }
+    }
+
+    if (measured) {
+        const AllocSnapshot after = AllocSnapshot::take();
+        totals.repetition.record(repetition_ns);
+        totals.rss_mb.push_back(dase::bench::residentMB());
+        totals.live_allocs.push_back(after.live);
+        totals.alloc_calls += after.calls - repetition_alloc.calls;
+        totals.alloc_bytes += after.bytes - repetition_alloc.bytes;
+    }
+}
+
+json makeReport(const ReplayOptions& options, const std::vector<MissionCommand>& mission, const ReplayTotals& totals) {
+    const double repeat = static_cast<double>(options.repeat);
+    const auto totalMs = [](const json& histogram) { return histogram.value("total_ms", 0.0); };
+
+    double mission_ms = 0.0;
+    json steps = json::array();
+    for (size_t i = 0; i < mission.size(); ++i) {
+        const StepStats& stats = totals.steps[i];
+        json step = {
+            {"index", i},
+            {"command", mission[i].name},
+            {"errors", stats.errors},
+            {"parse", stats.parse.toJson()},
+            {"execute", stats.execute.toJson()},
+            {"serialize", stats.serialize.toJson()},
+            {"alloc_calls", static_cast<double>(stats.alloc_calls) / repeat},
+            {"alloc_bytes", static_cast<double>(stats.alloc_bytes) / repeat},
+            {"bytes_out", static_cast<double>(stats.bytes_out) / repeat}
+        };
+        step["ms"] = (totalMs(step["parse"]) + totalMs(step["execute"]) + totalMs(step["serialize"])) / repeat;
+        mission_ms += step["ms"].get<double>();
+        steps.push_back(std::move(step));
+    }
+
+    json by_command = json::object();
+    for (auto& step : steps) {
+        step["share"] = mission_ms > 0.0 ? step["ms"].get<double>() / mission_ms : 0.0;
+        const std::string name = step["command"].get<std::string>().empty() ? "(unparsed)"
+                                                                          : step["command"].get<std::string>();
+        json& entry = by_command[name];
+        entry["steps"] = entry.value("steps", 0) + 1;
+        entry["ms"] = entry.value("ms", 0.0) + step["ms"].get<double>();
+        entry["share"] = entry.value("share", 0.0) + step["share"].get<double>();
+    }
+
+    json engines = json::object();
+    for (const auto& entry : totals.engines) {
+        const EngineStats& engine = entry.second;
+        engines[entry.first] = {
+            {"engine_type", engine.engine_type},
+            {"steps", static_cast<double>(engine.steps) / repeat},
+            {"execute_ms", static_cast<double>(engine.execute_ns) * 1.0e-6 / repeat},
+            {"steps_per_s", engine.execute_ns > 0
+                ? static_cast<double>(engine.steps) * 1.0e9 / static_cast<double>(engine.execute_ns) : 0.0}
+        };
+    }
+
+    return {
+        {"mission", options.mission},
+        {"commands", mission.size()},
+        {"repeat", options.repeat},
+        {"warmup", options.warmup},
+        {"repetition", totals.repetition.toJson()},
+        {"mission_ms", mission_ms},
+        {"steps", steps},
+        {"by_command", by_command},
+        {"engines", engines},
+        {"memory", {
+            {"peak_rss_mb", dase::bench::peakResidentMB()},
+            {"rss_mb", totals.rss_mb},
+            {"live_allocs", totals.live_allocs},
+            {"alloc_calls", static_cast<double>(totals.alloc_calls) / repeat},
+            {"alloc_bytes", static_cast<double>(totals.alloc_bytes) / repeat}
+        }}
+    };
+}
+
+// ============================================================================
+// PROFILE DIFF
+// ============================================================================
+
+double stepP50Us(const json& step) {
+    double us = 0.0;
+    for (const char* phase : {"parse", "execute", "serialize"}) {
+        if (step.contains(phase)) us += step[phase].value("p50_us", 0.0);
+    }
+    return us;
+}
+
+json diffReports(const json& current, const json& baseline, const ReplayOptions& options) {
+    const double r = options.max_regression;
+    json regressions = json::array();
+    const auto change = [](double now, double before) { return before > 0.0 ? now / before - 1.0 : 0.0; };
+    const auto slower = [&](double now_us, double before_us) {
+        return now_us > before_us * (1.0 + r) && now_us - before_us > options.min_delta_us;
+    };
+
+    const double mission_us = current["repetition"].value("p50_us", 0.0);
+    const double baseline_mission_us = baseline.value("repetition", json::object()).value("p50_us", 0.0);
+    if (slower(mission_us, baseline_mission_us)) {
+        regressions.push_back({{"kind", "mission_time"}, {"baseline_us", baseline_mission_us},
+                               {"current_us", mission_us}, {"change", change(mission_us, baseline_mission_us)}});
+    }
+
+    const json& steps = current["steps"];
+    const json baseline_steps = baseline.value("steps", json::array());
+    bool same_mission = steps.size() == baseline_steps.size();
+    for (size_t i = 0; same_mission && i < steps.size(); ++i) {
+        same_mission = steps[i]["command"] == baseline_steps[i].value("command", std::string());
+    }
+    if (same_mission) {
+        for (size_t i = 0; i < steps.size(); ++i) {
+            const double now = stepP50Us(steps[i]);
+            const double before = stepP50Us(baseline_steps[i]);
+            if (slower(now, before)) {
+                regressions.push_back({{"kind", "step_time"}, {"step", i}, {"command", steps[i]["command"]},
+                                       {"baseline_us", before}, {"current_us", now}, {"change", change(now, before)}});
+            }
+        }
+    }
+
+    const json baseline_engines = baseline.value("engines", json::object());
+    for (const auto& entry : current["engines"].items()) {
+        if (!baseline_engines.contains(entry.key())) continue;
+        const double now = entry.value().value("steps_per_s", 0.0);
+        const double before = baseline_engines[entry.key()].value("steps_per_s", 0.0);
+        if (before > 0.0 && now < before * (1.0 - r)) {
+            regressions.push_back({{"kind", "engine_throughput"}, {"engine", entry.key()},
+                                   {"baseline_steps_per_s", before}, {"current_steps_per_s", now},
+                                   {"change", change(now, before)}});
+        }
+    }
+
+    const json& memory = current["memory"];
+    const json baseline_memory = baseline.value("memory", json::object());
+    const double allocs = memory.value("alloc_calls", 0.0);
+    const double baseline_allocs = baseline_memory.value("alloc_calls", 0.0);
+    if (allocs > baseline_allocs * (1.0 + r) && allocs - baseline_allocs >= 64.0) {
+        regressions.push_back({{"kind", "allocations"}, {"baseline", baseline_allocs}, {"current", allocs},
+                               {"change", change(allocs, baseline_allocs)}});
+    }
+    const double peak = memory.value("peak_rss_mb", 0.0);
+    const double baseline_peak = baseline_memory.value("peak_rss_mb", 0.0);
+    if (baseline_peak > 0.0 && peak > baseline_peak * (1.0 + r) && peak - baseline_peak > 8.0) {
+        regressions.push_back({{"kind", "peak_rss"}, {"baseline_mb", baseline_peak}, {"current_mb", peak},
+                               {"change", change(peak, baseline_peak)}});
+    }
+
+    return {
+        {"baseline", options.baseline},
+        {"mission_changed", !same_mission},
+        {"mission_time_change", change(mission_us, baseline_mission_us)},
+        {"alloc_calls_change", change(allocs, baseline_allocs)},
+        {"peak_rss_change", change(peak, baseline_peak)},
+        {"regressions", regressions}
+    };
+}
+
+// Where the time went: the heaviest steps, one line each
+void printSummary(const json& report) {
+    const double repeat = report["repeat"].get<double>();
+    const auto phaseMs = [repeat](const json& step, const char* phase) {
+        return step[phase].value("total_ms", 0.0) / repeat;
+    };
+    std::vector<const json*> steps;
+    for (const auto& step : report["steps"]) steps.push_back(&step);
+    std::sort(steps.begin(), steps.end(), [](const json* a, const json* b) {
+        return (*a)["ms"].get<double>() > (*b)["ms"].get<double>();
+    });
+    std::cerr << "dase_replay: " << report["mission"].get<std::string>() << ", " << report["commands"]
+              << " commands, " << std::fixed << std::setprecision(3) << report["mission_ms"].get<double>()
+              << " ms per repetition, peak RSS " << std::setprecision(1)
+              << report["memory"]["peak_rss_mb"].get<double>() << " MB" << std::endl;
+    for (size_t i = 0; i < steps.size() && i < 5; ++i) {
+        const json& step = *steps[i];
+        std::cerr << "  " << std::setw(5) << std::setprecision(1) << 100.0 * step["share"].get<double>() << "%  #"
+                  << step["index"] << " " << step["command"].get<std::string>() << "  " << std::setprecision(3)
+                  << step["ms"].get<double>() << " ms (parse " << phaseMs(step, "parse") << ", execute "
+                  << phaseMs(step, "execute") << ", serialize " << phaseMs(step, "serialize") << ")"
+                  << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    std::vector<MissionCommand> mission;
+    json baseline;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            printUsage();
+            return 2;
+        }
+        mission = loadMission(options.mission);
+        if (!options.baseline.empty()) {
+            std::ifstream in(options.baseline);
+            if (!in) {
+                throw std::runtime_error("cannot open baseline " + options.baseline);
+            }
+            baseline = json::parse(in);
+        }
+        if (!options.workdir.empty()) {
+            if (options.out != "-") {
+                options.out = std::filesystem::absolute(options.out).string();
+            }
+            std::filesystem::current_path(options.workdir);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "dase_replay: " << e.what() << std::endl;
+        return 2;
+    }
+
+    ReplayTotals totals;
+    totals.steps.resize(mission.size());
+    for (int repetition = 0; repetition < options.warmup + options.repeat; ++repetition) {
+        replayOnce(mission, repetition >= options.warmup, totals);
+    }
+
+    json report = makeReport(options, mission, totals);
+    int status = 0;
+    if (!baseline.is_null()) {
+        report["diff"] = diffReports(report, baseline, options);
+        status = report["diff"]["regressions"].empty() ? 0 : 1;
+    }
+
+    if (options.out == "-") {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::ofstream out(options.out, std::ios::trunc);
+        out << report.dump(2) << '\n';
+        if (!out) {
+            std::cerr << "dase_replay: cannot write " << options.out << std::endl;
+            return 2;
+        }
+    }
+    printSummary(report);
+    if (report.contains("diff")) {
+        for (const auto& regression : report["diff"]["regressions"]) {
+            std::cerr << "  regression: " << regression.dump() << std::endl;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,508 @@
+/**
+ * dase_soak - long-duration soak benchmark
+ *
+ *   dase_soak --duration=4h --window=60 \
+ *             --mix=igsoa_2d:128x128,satp_3d:32x32x32,gw:16x16x16 \
+ *             --out=soak.jsonl
+ *
+ * Steps every engine of the mix round-robin until the duration runs out and
+ * writes one JSON line per window: per-engine step latency percentiles and
+ * steps/s (with drift against the first window after warm-up), process RSS,
+ * heap allocations and bytes made during the window and the live
+ * allocation count, and the value of each size probe (solver kernel caches
+ * and the like).  A final summary line lists anomalies:
+ *
+ *   rss_growth          least-squares RSS slope above --max-rss-slope MB/h
+ *   live_alloc_growth   live allocations rose in every window
+ *   throughput_drift    last window's steps/s below baseline by > --max-drift
+ *   p99_growth          last window's p99 above baseline by > --max-p99-growth
+ *   probe_growth        a size probe rose in every window
+ *
+ * and the exit code is 1 when there are any, so a nightly job can gate on
+ * it.  Allocation counts come from the global operator new / delete
+ * replacement in process_counters.cpp, which covers every container in the
+ * engines.
+ *
+ * Mix entries are <engine>:<dims>[@<R_c>] with engine one of igsoa_1d,
+ * igsoa_2d, igsoa_3d, satp_1d, satp_2d, satp_3d or gw; dims are N, NxM or
+ * NxMxK to match.  Durations take an s / m / h suffix (plain = seconds).
+ */
+
+#include "../../dase_cli/src/router_stats.h"
+#include "process_counters.h"
+#include "igsoa_complex_engine.h"
+#include "igsoa_complex_engine_2d.h"
+#include "igsoa_complex_engine_3d.h"
+#include "igsoa_state_init_2d.h"
+#include "igsoa_state_init_3d.h"
+#include "satp_higgs_engine_1d.h"
+#include "satp_higgs_engine_2d.h"
+#include "satp_higgs_engine_3d.h"
+#include "satp_higgs_physics_1d.h"
+#include "satp_higgs_physics_2d.h"
+#include "satp_higgs_physics_3d.h"
+#include "igsoa_gw_engine/core/fractional_solver.h"
+#include "igsoa_gw_engine/core/source_manager.h"
+#include "igsoa_gw_engine/core/symmetry_field.h"
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+using dase::bench::AllocSnapshot;
+using dase::bench::residentMB;
+
+// ============================================================================
+// ENGINE MIX
+// ============================================================================
+
+struct SizeProbe {
+    std::string name;
+    std::function<double()> read;
+};
+
+struct SoakEngine {
+    std::string name;                          // Mix entry as given
+    std::function<void(int)> step;             // Advance `steps` time steps
+    std::vector<SizeProbe> probes;
+
+    // Current window
+    dase::LatencyHistogram step_ns;            // One sample per call, per step
+    uint64_t window_steps = 0;
+    uint64_t window_ns = 0;
+
+    // First window after warm-up
+    bool has_baseline = false;
+    double baseline_steps_per_s = 0.0;
+    double baseline_p99_us = 0.0;
+    double last_steps_per_s = 0.0;
+    double last_p99_us = 0.0;
+};
+
+std::vector<size_t> parseDims(const std::string& text) {
+    std::vector<size_t> dims;
+    std::stringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, 'x')) {
+        const long long value = std::stoll(part);
+        if (value <= 0) {
+            throw std::invalid_argument("dimension must be positive: " + text);
+        }
+        dims.push_back(static_cast<size_t>(value));
+    }
+    return dims;
+}
+
+dase::igsoa::IGSOAComplexConfig igsoaConfig(size_t num_nodes, double R_c) {
+    dase::igsoa::IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(num_nodes);
+    config.R_c_default = R_c;
+    return config;
+}
+
+template <typename Engine>
+std::function<void(int)> satpStep(std::shared_ptr<Engine> engine) {
+    return [engine](int steps) { engine->evolve(static_cast<size_t>(steps)); };
+}
+
+SoakEngine makeEngine(const std::string& entry) {
+    const size_t colon = entry.find(':');
+    if (colon == std::string::npos) {
+        throw std::invalid_argument("mix entry needs <engine>:<dims>: " + entry);
+    }
+    const std::string kind = entry.substr(0, colon);
+    std::string dims_text = entry.substr(colon + 1);
+    double R_c = 2.0;
+    const size_t at = dims_text.find('@');
+    if (at != std::string::npos) {
+        R_c = std::stod(dims_text.substr(at + 1));
+        dims_text = dims_text.substr(0, at);
+    }
+    const std::vector<size_t> d = parseDims(dims_text);
+    const auto need = [&](size_t count) {
+        if (d.size() != count) {
+            throw std::invalid_argument(kind + " takes " + std::to_string(count) + " dimension(s): " + entry);
+        }
+    };
+
+    SoakEngine soak;
+    soak.name = entry;
+    const dase::satp_higgs::SATPHiggsParams satp_params;
+
+    if (kind == "igsoa_1d") {
+        need(1);
+        auto engine = std::make_shared<dase::igsoa::IGSOAComplexEngine>(igsoaConfig(d[0], R_c));
+        soak.step = [engine](int steps) { engine->runMission(static_cast<uint64_t>(steps)); };
+    } else if (kind == "igsoa_2d") {
+        need(2);
+        auto engine = std::make_shared<dase::igsoa::IGSOAComplexEngine2D>(igsoaConfig(d[0] * d[1], R_c), d[0], d[1]);
+        dase::igsoa::IGSOAStateInit2D::initCircularGaussian(*engine, 1.0, d[0] / 2.0, d[1] / 2.0, d[0] / 8.0 + 1.0);
+        soak.step = [engine](int steps) { engine->runMission(static_cast<uint64_t>(steps)); };
+    } else if (kind == "igsoa_3d") {
+        need(3);
+        auto engine = std::make_shared<dase::igsoa::IGSOAComplexEngine3D>(igsoaConfig(d[0] * d[1] * d[2], R_c),
+                                                                        d[0], d[1], d[2]);
+        dase::igsoa::IGSOAStateInit3D::initSphericalGaussian(*engine, 1.0, d[0] / 2.0, d[1] / 2.0, d[2] / 2.0,
+                                                            d[0] / 8.0 + 1.0);
+        soak.step = [engine](int steps) { engine->runMission(static_cast<uint64_t>(steps)); };
+    } else if (kind == "satp_1d") {
+        need(1);
+        soak.step = satpStep(std::make_shared<dase::satp_higgs::SATPHiggsEngine1D>(d[0], 0.1, 0.01, satp_params));
+    } else if (kind == "satp_2d") {
+        need(2);
+        soak.step = satpStep(std::make_shared<dase::satp_higgs::SATPHiggsEngine2D>(d[0], d[1], 0.1, 0.01,
+                                                                                  satp_params));
+    } else if (kind == "satp_3d") {
+        need(3);
+        soak.step = satpStep(std::make_shared<dase::satp_higgs::SATPHiggsEngine3D>(d[0], d[1], d[2], 0.1, 0.01,
+                                                                                  satp_params));
+    } else if (kind == "gw") {
+        need(3);
+        // The CLI's IGSOAGWEngine step: source update, field step, fused
+        // fractional history / derivative pass, orbit
+        namespace gw = dase::igsoa::gw;
+        struct GWState {
+            gw::SymmetryField field;
+            gw::FractionalSolver solver;
+            gw::BinaryMerger merger;
+            std::vector<std::complex<double>> second_derivs;
+            std::vector<std::complex<double>> frac_derivs;
+            GWState(const gw::SymmetryFieldConfig& field_config)
+                : field(field_config),
+                  solver(gw::FractionalSolverConfig(), field.getTotalPoints()),
+                  merger(gw::BinaryMergerConfig()) {}
+        };
+        gw::SymmetryFieldConfig field_config;
+        field_config.nx = static_cast<int>(d[0]);
+        field_config.ny = static_cast<int>(d[1]);
+        field_config.nz = static_cast<int>(d[2]);
+        auto state = std::make_shared<GWState>(field_config);
+        const double alpha = 0.5 * (field_config.alpha_min + field_config.alpha_max);
+        for (int i = 0; i < field_config.nx; ++i) {
+            for (int j = 0; j < field_config.ny; ++j) {
+                for (int k = 0; k < field_config.nz; ++k) {
+                    state->field.setAlpha(i, j, k, alpha);
+                }
+            }
+        }
+        state->second_derivs.assign(static_cast<size_t>(state->field.getTotalPoints()), {0.0, 0.0});
+        state->solver.setPointAlphas(state->field.getAlphaFlat());
+        soak.step = [state](int steps) {
+            state->solver.computeDerivatives(state->frac_derivs);
+            for (int step = 0; step < steps; ++step) {
+                const double t = state->field.getCurrentTime();
+                const auto& sources = state->merger.updateSourceTerms(state->field, t);
+                state->field.evolveStep(state->frac_derivs, sources);
+                state->solver.updateHistoryAndDerivatives(state->second_derivs, state->field.getTimestep(),
+                                                          state->frac_derivs);
+                state->merger.evolveOrbit(state->field.getTimestep());
+                state->field.setCurrentTime(t + state->field.getTimestep());
+            }
+        };
+        soak.probes.push_back({"gw.cached_kernels",
+                               [state] { return static_cast<double>(state->solver.getNumCachedKernels()); }});
+        soak.probes.push_back({"gw.ml_table_cache", [] {
+            return static_cast<double>(gw::MittagLefflerFunction::get_table_cache_size());
+        }});
+    } else {
+        throw std::invalid_argument("unknown engine: " + kind);
+    }
+    return soak;
+}
+
+// ============================================================================
+// OPTIONS
+// ============================================================================
+
+struct SoakOptions {
+    double duration_s = 3600.0;
+    double window_s = 60.0;
+    int warmup_windows = 1;
+    int steps_per_call = 1;
+    std::string mix = "igsoa_2d:128x128,satp_3d:32x32x32,gw:16x16x16";
+    std::string out = "-";
+    double max_rss_slope_mb_h = 16.0;
+    double max_drift = 0.10;
+    double max_p99_growth = 0.50;
+};
+
+double parseDuration(const std::string& text) {
+    size_t used = 0;
+    const double value = std::stod(text, &used);
+    const std::string unit = text.substr(used);
+    if (unit.empty() || unit == "s") return value;
+    if (unit == "m") return value * 60.0;
+    if (unit == "h") return value * 3600.0;
+    throw std::invalid_argument("bad duration: " + text);
+}
+
+void printUsage() {
+    std::cerr << "usage: dase_soak [--duration=1h] [--window=60s] [--warmup=1] [--steps-per-call=1]\n"
+                 "                 [--mix=igsoa_2d:128x128,satp_3d:32x32x32,gw:16x16x16] [--out=-]\n"
+                 "                 [--max-rss-slope=16] [--max-drift=0.10] [--max-p99-growth=0.50]\n";
+}
+
+bool parseOptions(int argc, char** argv, SoakOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string key = arg.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--help" || key == "-h") {
+            return false;
+        }
+        if (value.empty()) {
+            std::cerr << "dase_soak: " << key << " needs =<value>" << std::endl;
+            return false;
+        }
+        if (key == "--duration") options.duration_s = parseDuration(value);
+        else if (key == "--window") options.window_s = parseDuration(value);
+        else if (key == "--warmup") options.warmup_windows = std::stoi(value);
+        else if (key == "--steps-per-call") options.steps_per_call = std::stoi(value);
+        else if (key == "--mix") options.mix = value;
+        else if (key == "--out") options.out = value;
+        else if (key == "--max-rss-slope") options.max_rss_slope_mb_h = std::stod(value);
+        else if (key == "--max-drift") options.max_drift = std::stod(value);
+        else if (key == "--max-p99-growth") options.max_p99_growth = std::stod(value);
+        else {
+            std::cerr << "dase_soak: unknown option " << key << std::endl;
+            return false;
+        }
+    }
+    if (options.duration_s <= 0.0 || options.window_s <= 0.0 || options.steps_per_call < 1 ||
+        options.warmup_windows < 0) {
+        std::cerr << "dase_soak: duration, window and steps-per-call must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// TREND CHECKS
+// ============================================================================
+
+// Least-squares slope of y over x
+double slope(const std::vector<double>& x, const std::vector<double>& y) {
+    const double n = static_cast<double>(x.size());
+    if (x.size() < 2) return 0.0;
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sx += x[i];
+        sy += y[i];
+        sxx += x[i] * x[i];
+        sxy += x[i] * y[i];
+    }
+    const double denom = n * sxx - sx * sx;
+    return denom != 0.0 ? (n * sxy - sx * sy) / denom : 0.0;
+}
+
+// Rose in every window and ended above where it started
+bool risingThroughout(const std::vector<double>& values) {
+    if (values.size() < 3) return false;
+    for (size_t i = 1; i < values.size(); ++i) {
+        if (values[i] <= values[i - 1]) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SoakOptions options;
+    std::vector<SoakEngine> engines;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            printUsage();
+            return 2;
+        }
+        std::stringstream mix(options.mix);
+        std::string entry;
+        while (std::getline(mix, entry, ',')) {
+            if (!entry.empty()) engines.push_back(makeEngine(entry));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "dase_soak: " << e.what() << std::endl;
+        printUsage();
+        return 2;
+    }
+    if (engines.empty()) {
+        std::cerr << "dase_soak: empty mix" << std::endl;
+        return 2;
+    }
+
+    std::ofstream file;
+    if (options.out != "-") {
+        file.open(options.out);
+        if (!file) {
+            std::cerr << "dase_soak: cannot open " << options.out << std::endl;
+            return 2;
+        }
+    }
+    std::ostream& out = options.out == "-" ? std::cout : file;
+
+    // Post-warm-up series for the trend checks
+    std::vector<double> window_hours;
+    std::vector<double> rss_series;
+    std::vector<double> live_series;
+    std::vector<std::vector<double>> probe_series;
+    for (const auto& engine : engines) {
+        probe_series.resize(probe_series.size() + engine.probes.size());
+    }
+
+    const auto start = Clock::now();
+    const auto deadline = start + std::chrono::duration_cast<Clock::duration>(
+                                      std::chrono::duration<double>(options.duration_s));
+    AllocSnapshot window_alloc = AllocSnapshot::take();
+    auto window_end = start + std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<double>(options.window_s));
+    int window = 0;
+
+    while (true) {
+        for (auto& engine : engines) {
+            const auto call_start = Clock::now();
+            engine.step(options.steps_per_call);
+            const auto ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - call_start).count());
+            engine.step_ns.record(ns / static_cast<uint64_t>(options.steps_per_call));
+            engine.window_steps += static_cast<uint64_t>(options.steps_per_call);
+            engine.window_ns += ns;
+        }
+
+        const auto now = Clock::now();
+        const bool last = now >= deadline;
+        if (now < window_end && !last) {
+            continue;
+        }
+
+        const double t_s = std::chrono::duration<double>(now - start).count();
+        const AllocSnapshot alloc = AllocSnapshot::take();
+        const double rss_mb = residentMB();
+        const bool measured = window >= options.warmup_windows;
+
+        json record = {
+            {"window", window},
+            {"t_s", t_s},
+            {"warmup", !measured},
+            {"rss_mb", rss_mb},
+            {"alloc", {
+                {"calls", alloc.calls - window_alloc.calls},
+                {"bytes", alloc.bytes - window_alloc.bytes},
+                {"live", alloc.live}
+            }}
+        };
+        json engine_records = json::object();
+        json probes = json::object();
+        size_t probe_slot = 0;
+        for (auto& engine : engines) {
+            const double steps_per_s = engine.window_ns > 0
+                ? static_cast<double>(engine.window_steps) * 1.0e9 / static_cast<double>(engine.window_ns)
+                : 0.0;
+            const double p99_us = static_cast<double>(engine.step_ns.percentile(99.0)) * 1.0e-3;
+            if (measured && !engine.has_baseline) {
+                engine.has_baseline = true;
+                engine.baseline_steps_per_s = steps_per_s;
+                engine.baseline_p99_us = p99_us;
+            }
+            engine.last_steps_per_s = steps_per_s;
+            engine.last_p99_us = p99_us;
+
+            json stats = engine.step_ns.toJson();
+            stats["steps"] = engine.window_steps;
+            stats["steps_per_s"] = steps_per_s;
+            if (engine.has_baseline && engine.baseline_steps_per_s > 0.0) {
+                stats["drift"] = steps_per_s / engine.baseline_steps_per_s - 1.0;
+            }
+            engine_records[engine.name] = stats;
+
+            for (const auto& probe : engine.probes) {
+                const double value = probe.read();
+                probes[probe.name] = value;
+                if (measured) probe_series[probe_slot].push_back(value);
+                ++probe_slot;
+            }
+
+            engine.step_ns = dase::LatencyHistogram();
+            engine.window_steps = 0;
+            engine.window_ns = 0;
+        }
+        record["engines"] = engine_records;
+        if (!probes.empty()) record["probes"] = probes;
+        out << record.dump() << std::endl;
+
+        if (measured) {
+            window_hours.push_back(t_s / 3600.0);
+            rss_series.push_back(rss_mb);
+            live_series.push_back(static_cast<double>(alloc.live));
+        }
+
+        window_alloc = alloc;
+        window++;
+        if (last) {
+            break;
+        }
+        window_end = now + std::chrono::duration_cast<Clock::duration>(
+                               std::chrono::duration<double>(options.window_s));
+    }
+
+    // Summary and anomalies over the post-warm-up windows
+    json anomalies = json::array();
+    const double rss_slope = slope(window_hours, rss_series);
+    if (rss_series.size() >= 3 && rss_slope > options.max_rss_slope_mb_h) {
+        anomalies.push_back({{"kind", "rss_growth"}, {"mb_per_hour", rss_slope}});
+    }
+    if (risingThroughout(live_series)) {
+        anomalies.push_back({{"kind", "live_alloc_growth"},
+                             {"from", live_series.front()}, {"to", live_series.back()}});
+    }
+    size_t probe_slot = 0;
+    for (const auto& engine : engines) {
+        if (engine.has_baseline && window_hours.size() >= 2) {
+            const double drift = engine.baseline_steps_per_s > 0.0
+                ? engine.last_steps_per_s / engine.baseline_steps_per_s - 1.0 : 0.0;
+            if (drift < -options.max_drift) {
+                anomalies.push_back({{"kind", "throughput_drift"}, {"engine", engine.name}, {"drift", drift}});
+            }
+            if (engine.baseline_p99_us > 0.0 &&
+                engine.last_p99_us > engine.baseline_p99_us * (1.0 + options.max_p99_growth)) {
+                anomalies.push_back({{"kind", "p99_growth"}, {"engine", engine.name},
+                                     {"baseline_us", engine.baseline_p99_us}, {"last_us", engine.last_p99_us}});
+            }
+        }
+        for (const auto& probe : engine.probes) {
+            const auto& series = probe_series[probe_slot++];
+            if (risingThroughout(series)) {
+                anomalies.push_back({{"kind", "probe_growth"}, {"probe", probe.name},
+                                     {"from", series.front()}, {"to", series.back()}});
+            }
+        }
+    }
+
+    json summary = {
+        {"summary", true},
+        {"windows", window},
+        {"measured_windows", window_hours.size()},
+        {"duration_s", std::chrono::duration<double>(Clock::now() - start).count()},
+        {"rss_slope_mb_per_hour", rss_slope},
+        {"anomalies", anomalies}
+    };
+    out << summary.dump() << std::endl;
+    if (options.out != "-") {
+        std::cerr << "dase_soak: " << window << " windows, " << anomalies.size() << " anomalies -> "
+                  << options.out << std::endl;
+    }
+    return anomalies.empty() ? 0 : 1;
+}
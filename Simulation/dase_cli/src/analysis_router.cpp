@@ -8,6 +8,7 @@
 #include <fstream>
 #include <filesystem>
 #include <cstdlib>
+#include <cstring>
 
 // Windows compatibility for popen/pclose
 #ifdef _WIN32
@@ -22,6 +23,10 @@ namespace dase {
 AnalysisRouter::AnalysisRouter(EngineManager* engine_mgr)
     : engine_manager_(engine_mgr)
 {
+    const std::string worker_script = python::PythonWorker::findWorkerScript();
+    if (!worker_script.empty()) {
+        python_worker_ = std::make_unique<python::PythonWorker>("python", worker_script);
+    }
 }
 
 CombinedAnalysisResult AnalysisRouter::routeAnalysis(
@@ -34,12 +39,20 @@ CombinedAnalysisResult AnalysisRouter::routeAnalysis(
     result.success = true;
 
     try {
-        // Extract engine state once for all analyses
-        nlohmann::json state_data = extractEngineState(engine_id);
+        if (!engine_manager_->getEngine(engine_id)) {
+            throw std::runtime_error("Engine not found: " + engine_id);
+        }
+
+        // Extract engine state once for the external tools; engine
+        // analyses read the fields directly
+        nlohmann::json state_data;
+        if (config.python.enabled || config.julia_efa.enabled) {
+            state_data = extractEngineState(engine_id);
+        }
 
         // Run Python analysis if enabled
         if (config.python.enabled) {
-            runPythonAnalysis(engine_id, config, result);
+            runPythonAnalysis(state_data, config, result);
         }
 
         // Run Julia EFA if enabled
@@ -52,6 +65,10 @@ CombinedAnalysisResult AnalysisRouter::routeAnalysis(
             runEngineAnalysis(engine_id, config, result);
         }
 
+        if (config.matched_filter.enabled) {
+            runMatchedFilterAnalysis(engine_id, config, result);
+        }
+
         // Cross-validate results if enabled
         if (config.enable_cross_validation &&
             (result.python.executed + result.julia_efa.executed + result.engine.executed) >= 2) {
@@ -73,7 +90,8 @@ CombinedAnalysisResult AnalysisRouter::routeAnalysis(
 python::PythonAnalysisResult AnalysisRouter::quickPythonAnalysis(
     const std::string& engine_id,
     const std::string& script_name,
-    const std::map<std::string, std::string>& args
+    const std::map<std::string, std::string>& args,
+    bool persistent
 ) {
     // Extract state
     nlohmann::json state_data = extractEngineState(engine_id);
@@ -86,9 +104,10 @@ python::PythonAnalysisResult AnalysisRouter::quickPythonAnalysis(
     config.script_path = script_name;
     config.args = args;
     config.output_dir = "analysis_output";
+    config.persistent = persistent;
 
     // Run analysis
-    auto result = python::PythonBridge::runAnalysisScript(temp_file, config);
+    auto result = runPythonScript(temp_file, config);
 
     // Cleanup
     fs::remove(temp_file);
@@ -100,60 +119,105 @@ analysis::FFTResult AnalysisRouter::quickFFT(
     const std::string& engine_id,
     const std::string& field_name
 ) {
-    // Extract state
-    nlohmann::json state_data = extractEngineState(engine_id);
-
-    // Get field data
     std::vector<double> field_data;
+    size_t dims[3];
+    gatherField(engine_id, field_name, field_data, dims);
 
-    if (field_name == "psi_real" && state_data.contains("psi_real")) {
-        field_data = state_data["psi_real"].get<std::vector<double>>();
-    } else if (field_name == "psi_imag" && state_data.contains("psi_imag")) {
-        field_data = state_data["psi_imag"].get<std::vector<double>>();
-    } else if (field_name == "phi" && state_data.contains("phi")) {
-        field_data = state_data["phi"].get<std::vector<double>>();
-    } else {
-        throw std::runtime_error("Field not found: " + field_name);
+    if (dims[2] > 1) {
+        return analysis::EngineFFTAnalysis::compute3DFFT(field_data, dims[0], dims[1], dims[2], field_name);
     }
-
-    // Determine dimensionality
-    if (state_data.contains("dimensions")) {
-        auto dims = state_data["dimensions"];
-        if (dims.contains("N_z") && dims["N_z"].get<int>() > 1) {
-            // 3D
-            return analysis::EngineFFTAnalysis::compute3DFFT(
-                field_data,
-                dims["N_x"].get<size_t>(),
-                dims["N_y"].get<size_t>(),
-                dims["N_z"].get<size_t>(),
-                field_name
-            );
-        } else if (dims.contains("N_y") && dims["N_y"].get<int>() > 1) {
-            // 2D
-            return analysis::EngineFFTAnalysis::compute2DFFT(
-                field_data,
-                dims["N_x"].get<size_t>(),
-                dims["N_y"].get<size_t>(),
-                field_name
-            );
-        }
+    if (dims[1] > 1) {
+        return analysis::EngineFFTAnalysis::compute2DFFT(field_data, dims[0], dims[1], field_name);
     }
-
-    // Default to 1D
     return analysis::EngineFFTAnalysis::compute1DFFT(field_data, field_name);
 }
 
+analysis::FieldStatistics AnalysisRouter::quickStatistics(
+    const std::string& engine_id,
+    const std::string& field_name
+) {
+    std::vector<double> field_data;
+    size_t dims[3];
+    gatherField(engine_id, field_name, field_data, dims);
+    return analysis::EngineFFTAnalysis::computeStatistics(field_data, field_name);
+}
+
 std::vector<std::string> AnalysisRouter::getAvailablePythonScripts() const {
     return python::PythonBridge::listAvailableScripts(".");
 }
 
-nlohmann::json AnalysisRouter::checkToolAvailability() const {
-    nlohmann::json status;
+namespace {
+
+// Probe results older than this (seconds, $DASE_TOOL_PROBE_TTL) are redone
+int64_t toolProbeTtl() {
+    if (const char* value = std::getenv("DASE_TOOL_PROBE_TTL")) {
+        char* end = nullptr;
+        const long long ttl = std::strtoll(value, &end, 10);
+        if (end != value && *end == '\0' && ttl >= 0) {
+            return static_cast<int64_t>(ttl);
+        }
+    }
+    return 3600;
+}
+
+// On-disk probe cache ($DASE_TOOL_PROBE_CACHE; "none" keeps it in memory only)
+std::string toolProbeCachePath() {
+    if (const char* value = std::getenv("DASE_TOOL_PROBE_CACHE")) {
+        return std::strcmp(value, "none") == 0 ? std::string() : std::string(value);
+    }
+    return "./cache/tool_probes.json";
+}
+
+int64_t unixSeconds() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// {"version": 1, "probed_at": unix seconds, "python": ..., "julia_efa": ...}
+bool readToolProbes(const std::string& path, nlohmann::json& probes) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    nlohmann::json cached = nlohmann::json::parse(file, nullptr, false);
+    if (!cached.is_object() || cached.value("version", 0) != 1 ||
+        !cached.contains("probed_at") || !cached["probed_at"].is_number_integer() ||
+        !cached.contains("python") || !cached.contains("julia_efa")) {
+        return false;
+    }
+    probes = std::move(cached);
+    return true;
+}
+
+void writeToolProbes(const std::string& path, const nlohmann::json& probes) {
+    std::error_code ec;
+    const fs::path parent = fs::path(path).parent_path();
+    if (!parent.empty()) {
+        fs::create_directories(parent, ec);
+    }
+    // Written aside and renamed so a concurrent reader never sees half a file
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::trunc);
+        if (!file) {
+            return;
+        }
+        file << probes.dump(2);
+    }
+    fs::rename(temp, path, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+    }
+}
+
+// Python and Julia versions, each a subprocess or several: the slow part
+nlohmann::json probeExternalTools() {
+    nlohmann::json probes = {{"version", 1}, {"probed_at", unixSeconds()}};
 
     // Check Python
     std::vector<std::string> python_packages = {"numpy", "scipy", "matplotlib"};
     bool python_available = python::PythonBridge::checkDependencies("python", python_packages);
-    status["python"] = {
+    probes["python"] = {
         {"available", python_available},
         {"executable", "python"},
         {"version", python::PythonBridge::getPythonVersion("python")},
@@ -175,11 +239,60 @@ nlohmann::json AnalysisRouter::checkToolAvailability() const {
         julia_version = "";
     }
 
-    status["julia_efa"] = {
+    probes["julia_efa"] = {
         {"available", !julia_version.empty()},
         {"executable", "julia"},
         {"version", julia_version}
     };
+    return probes;
+}
+
+} // namespace
+
+nlohmann::json AnalysisRouter::checkToolAvailability(bool refresh) const {
+    nlohmann::json status;
+
+    // External tool probes: this router's copy, else the on-disk cache,
+    // else probe (and save) again
+    {
+        std::lock_guard<std::mutex> lock(probe_mutex_);
+        const int64_t now = unixSeconds();
+        const int64_t ttl = toolProbeTtl();
+        const std::string path = toolProbeCachePath();
+        auto fresh = [&](const nlohmann::json& probes) {
+            const int64_t age = now - probes["probed_at"].get<int64_t>();
+            return age >= 0 && age <= ttl;
+        };
+
+        bool hit = !refresh && !tool_probes_.is_null() && fresh(tool_probes_);
+        if (!hit && !refresh && !path.empty()) {
+            nlohmann::json cached;
+            if (readToolProbes(path, cached) && fresh(cached)) {
+                tool_probes_ = std::move(cached);
+                hit = true;
+            }
+        }
+        if (!hit) {
+            tool_probes_ = probeExternalTools();
+            if (!path.empty()) {
+                writeToolProbes(path, tool_probes_);
+            }
+        }
+
+        status["python"] = tool_probes_["python"];
+        status["julia_efa"] = tool_probes_["julia_efa"];
+        status["probe_cache"] = {
+            {"hit", hit},
+            {"age_s", now - tool_probes_["probed_at"].get<int64_t>()},
+            {"ttl_s", ttl},
+            {"path", path}
+        };
+    }
+
+    status["python_worker"] = {
+        {"available", python_worker_ != nullptr},
+        {"script", python_worker_ ? python::PythonWorker::findWorkerScript() : std::string()}
+    };
 
     // Engine analysis (always available if FFTW3 is linked)
     status["engine_fft"] = {
@@ -188,6 +301,12 @@ nlohmann::json AnalysisRouter::checkToolAvailability() const {
         {"features", {"1D_FFT", "2D_FFT", "3D_FFT", "radial_profile"}}
     };
 
+    // Native statistics need nothing external
+    status["engine_statistics"] = {
+        {"available", true},
+        {"features", {"mean", "variance", "std_dev", "min", "max", "rms", "energy", "field_peaks"}}
+    };
+
     return status;
 }
 
@@ -248,8 +367,68 @@ nlohmann::json AnalysisRouter::extractEngineState(const std::string& engine_id)
     return state;
 }
 
-void AnalysisRouter::runPythonAnalysis(
+void AnalysisRouter::gatherField(
     const std::string& engine_id,
+    const std::string& field_name,
+    std::vector<double>& data,
+    size_t dims[3]
+) {
+    auto instance = engine_manager_->getEngine(engine_id);
+    if (!instance) {
+        throw std::runtime_error("Engine not found: " + engine_id);
+    }
+
+    // Same dimensionality rule as extractEngineState's "dimensions"
+    dims[0] = instance->num_nodes;
+    dims[1] = 1;
+    dims[2] = 1;
+    if (instance->dimension_x > 0 && instance->dimension_y > 0) {
+        dims[0] = static_cast<size_t>(instance->dimension_x);
+        dims[1] = static_cast<size_t>(instance->dimension_y);
+        if (instance->dimension_z > 0) {
+            dims[2] = static_cast<size_t>(instance->dimension_z);
+        }
+    }
+
+    bool found = false;
+    if (instance->engine_type.find("igsoa_complex") != std::string::npos) {
+        std::vector<double> psi_real, psi_imag, phi;
+        if (engine_manager_->getAllNodeStates(engine_id, psi_real, psi_imag, phi)) {
+            found = true;
+            if (field_name == "psi_real") data = std::move(psi_real);
+            else if (field_name == "psi_imag") data = std::move(psi_imag);
+            else if (field_name == "phi") data = std::move(phi);
+            else found = false;
+        }
+    } else if (instance->engine_type.find("satp_higgs") != std::string::npos) {
+        std::vector<double> phi, phi_dot, h, h_dot;
+        if (engine_manager_->getSatpState(engine_id, phi, phi_dot, h, h_dot)) {
+            found = true;
+            if (field_name == "phi") data = std::move(phi);
+            else if (field_name == "phi_dot") data = std::move(phi_dot);
+            else if (field_name == "h") data = std::move(h);
+            else if (field_name == "h_dot") data = std::move(h_dot);
+            else found = false;
+        }
+    }
+    if (!found) {
+        throw std::runtime_error("Field not found: " + field_name);
+    }
+}
+
+python::PythonAnalysisResult AnalysisRouter::runPythonScript(
+    const std::string& state_json_path,
+    const python::PythonAnalysisConfig& config
+) {
+    python::PythonAnalysisResult result{};
+    if (config.persistent && python_worker_ && python_worker_->run(state_json_path, config, result)) {
+        return result;
+    }
+    return python::PythonBridge::runAnalysisScript(state_json_path, config);
+}
+
+void AnalysisRouter::runPythonAnalysis(
+    const nlohmann::json& state_data,
     const AnalysisConfig& config,
     CombinedAnalysisResult& result
 ) {
@@ -257,8 +436,7 @@ void AnalysisRouter::runPythonAnalysis(
 
     std::string temp_file;
     try {
-        // Extract state and write to file
-        nlohmann::json state_data = extractEngineState(engine_id);
+        // Write the state once for every script
         temp_file = writeTempStateFile(state_data);
 
         // Run each requested script
@@ -267,8 +445,9 @@ void AnalysisRouter::runPythonAnalysis(
             py_config.script_path = script;
             py_config.output_dir = config.python.output_dir;
             py_config.args = config.python.args;
+            py_config.persistent = config.python.persistent;
 
-            auto py_result = python::PythonBridge::runAnalysisScript(temp_file, py_config);
+            auto py_result = runPythonScript(temp_file, py_config);
             result.python.script_results.push_back(py_result);
         }
 
@@ -336,13 +515,13 @@ void AnalysisRouter::runEngineAnalysis(
     result.engine.executed = true;
 
     try {
+        std::vector<std::string> fields = config.engine.fields_to_analyze;
+        if (fields.empty()) {
+            fields = {"psi_real", "phi"};  // Default fields
+        }
+
         if (config.engine.compute_fft) {
             // Run FFT on requested fields
-            std::vector<std::string> fields = config.engine.fields_to_analyze;
-            if (fields.empty()) {
-                fields = {"psi_real", "phi"};  // Default fields
-            }
-
             for (const auto& field : fields) {
                 try {
                     auto fft_result = quickFFT(engine_id, field);
@@ -353,6 +532,27 @@ void AnalysisRouter::runEngineAnalysis(
             }
         }
 
+        if (config.engine.compute_statistics || config.engine.find_peaks) {
+            for (const auto& field : fields) {
+                std::vector<double> field_data;
+                size_t dims[3];
+                try {
+                    gatherField(engine_id, field, field_data, dims);
+                } catch (...) {
+                    continue;  // Skip fields that don't exist
+                }
+                if (config.engine.compute_statistics) {
+                    result.engine.statistics.push_back(
+                        analysis::EngineFFTAnalysis::computeStatistics(field_data, field));
+                }
+                if (config.engine.find_peaks) {
+                    result.engine.field_peaks[field] = analysis::EngineFFTAnalysis::findFieldPeaks(
+                        field_data, dims[0], dims[1], dims[2],
+                        config.engine.n_peaks, config.engine.peak_threshold);
+                }
+            }
+        }
+
         if (config.engine.perturbation_test) {
             // Placeholder for perturbation testing
             result.engine.perturbation_result = nlohmann::json::object();
@@ -365,6 +565,52 @@ void AnalysisRouter::runEngineAnalysis(
     }
 }
 
+void AnalysisRouter::runMatchedFilterAnalysis(
+    const std::string& engine_id,
+    const AnalysisConfig& config,
+    CombinedAnalysisResult& result
+) {
+    result.matched_filter.executed = true;
+
+    try {
+        const auto& mf = config.matched_filter;
+        analysis::MatchedFilterConfig filter = mf.filter;
+        std::vector<double> probe_series;
+        const std::vector<double>* series = &mf.series;
+        if (mf.probe_id > 0) {
+            std::vector<uint64_t> steps;
+            std::vector<double> values;
+            uint64_t dropped = 0;
+            ProbeSpec spec;
+            if (!engine_manager_->drainProbe(engine_id, mf.probe_id, steps, values, dropped, spec)) {
+                throw std::runtime_error("Unknown probe " + std::to_string(mf.probe_id) + " on engine " + engine_id);
+            }
+            const size_t channels = spec.points.size() * spec.fields.size();
+            if (mf.channel >= channels) {
+                throw std::runtime_error("Probe channel " + std::to_string(mf.channel) + " out of range");
+            }
+            probe_series.resize(steps.size());
+            for (size_t s = 0; s < steps.size(); ++s) {
+                probe_series[s] = values[s * channels + mf.channel];
+            }
+            series = &probe_series;
+            filter.sample_interval = static_cast<double>(spec.decimation) *
+                                     engine_manager_->getEngine(engine_id)->dt;
+        }
+
+        if (!filter_bank_ || mf.block_size != filter_block_size_ || mf.templates != filter_templates_) {
+            filter_bank_ = std::make_unique<analysis::MatchedFilterBank>(mf.templates, mf.block_size);
+            filter_templates_ = mf.templates;
+            filter_block_size_ = mf.block_size;
+        }
+        result.matched_filter.result = filter_bank_->filter(*series, filter);
+
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error_message += std::string("Matched filter failed: ") + e.what() + "; ";
+    }
+}
+
 void AnalysisRouter::performCrossValidation(CombinedAnalysisResult& result) {
     result.validation.performed = true;
     result.validation.all_checks_passed = true;
@@ -394,7 +640,7 @@ std::string AnalysisRouter::writeTempStateFile(const nlohmann::json& state_data)
 
     // Write state data
     std::ofstream file(temp_file);
-    file << state_data.dump(2);
+    file << state_data.dump();   // Compact: scripts parse it, nobody reads it
     file.close();
 
     return temp_file.string();
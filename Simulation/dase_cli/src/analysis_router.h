@@ -4,7 +4,12 @@
  * Coordinates analysis across three systems:
  * 1. Python tools (numpy, scipy, matplotlib)
  * 2. Julia EFA (Emergent Field Analysis)
- * 3. DASE engines (internal FFTW3, perturbation tests)
+ * 3. DASE engines (internal FFTW3, native statistics, perturbation tests)
+ *
+ * Engine analyses gather fields straight from the engine and never leave
+ * the process, as does the matched-filter search of a strain series (inline
+ * or drained from a probe) against a template bank (matched_filter.h).  Python scripts run in a persistent worker interpreter when
+ * analysis_worker.py is found, else one interpreter per script.
  */
 
 #pragma once
@@ -12,9 +17,11 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include "json.hpp"
 #include "python_bridge.h"
 #include "engine_fft_analysis.h"
+#include "matched_filter.h"
 #include "engine_manager.h"
 
 namespace dase {
@@ -23,6 +30,7 @@ enum class AnalysisType {
     PYTHON_ONLY,
     JULIA_EFA_ONLY,
     ENGINE_ONLY,
+    MATCHED_FILTER,
     COMBINED_ALL
 };
 
@@ -35,6 +43,7 @@ struct AnalysisConfig {
         std::vector<std::string> scripts;
         std::string output_dir = "python_analysis";
         std::map<std::string, std::string> args;
+        bool persistent = true;         // Run scripts in the shared worker
     } python;
 
     // Julia EFA configuration
@@ -51,9 +60,25 @@ struct AnalysisConfig {
         bool enabled = false;
         bool compute_fft = false;
         bool perturbation_test = false;
-        std::vector<std::string> fields_to_analyze;  // Which fields to FFT
+        bool compute_statistics = false;
+        bool find_peaks = false;        // Real-space local maxima
+        size_t n_peaks = 10;
+        double peak_threshold = 0.01;   // Fraction of the field maximum
+        std::vector<std::string> fields_to_analyze;  // Which fields to analyze
     } engine;
 
+    // Matched-filter echo search
+    struct {
+        bool enabled = false;
+        std::vector<std::vector<double>> templates;
+        std::vector<double> series;     // Strain series, unless probe_id > 0
+        int probe_id = 0;               // Drain this probe of the engine instead
+        size_t channel = 0;             // Probe channel (field * points + point)
+        size_t block_size = 0;          // 0 = MatchedFilterBank default
+        bool include_series = false;    // Return every SNR series
+        analysis::MatchedFilterConfig filter;
+    } matched_filter;
+
     // Cross-validation
     bool enable_cross_validation = true;
 };
@@ -80,9 +105,17 @@ struct CombinedAnalysisResult {
     struct {
         bool executed = false;
         std::vector<analysis::FFTResult> fft_results;
+        std::vector<analysis::FieldStatistics> statistics;
+        std::map<std::string, std::vector<analysis::FieldPeak>> field_peaks;
         nlohmann::json perturbation_result;
     } engine;
 
+    // Matched-filter results
+    struct {
+        bool executed = false;
+        analysis::MatchedFilterResult result;
+    } matched_filter;
+
     // Cross-validation results
     struct {
         bool performed = false;
@@ -118,7 +151,8 @@ public:
     python::PythonAnalysisResult quickPythonAnalysis(
         const std::string& engine_id,
         const std::string& script_name,
-        const std::map<std::string, std::string>& args
+        const std::map<std::string, std::string>& args,
+        bool persistent = true
     );
 
     /**
@@ -133,6 +167,18 @@ public:
         const std::string& field_name
     );
 
+    /**
+     * Native statistics of one field
+     *
+     * @param engine_id Engine to analyze
+     * @param field_name Field to analyze
+     * @return Mean, variance, extrema, RMS and energy
+     */
+    analysis::FieldStatistics quickStatistics(
+        const std::string& engine_id,
+        const std::string& field_name
+    );
+
     /**
      * Get available Python analysis scripts
      *
@@ -143,19 +189,48 @@ public:
     /**
      * Check if all analysis tools are available
      *
-     * @return JSON with tool availability status
+     * The Python and Julia probes spawn interpreters, so their results are
+     * kept for $DASE_TOOL_PROBE_TTL seconds (default 3600), in this router
+     * and in $DASE_TOOL_PROBE_CACHE (default ./cache/tool_probes.json,
+     * "none" to skip the file) for later CLI runs.
+     *
+     * @param refresh Probe again even if cached results are fresh
+     * @return JSON with tool availability status and a probe_cache section
      */
-    nlohmann::json checkToolAvailability() const;
+    nlohmann::json checkToolAvailability(bool refresh = false) const;
 
 private:
     EngineManager* engine_manager_;
+    std::unique_ptr<python::PythonWorker> python_worker_;   // Null without analysis_worker.py
+
+    mutable std::mutex probe_mutex_;
+    mutable nlohmann::json tool_probes_;    // Last Python / Julia probe results
 
     // Extract engine state to JSON for analysis
     nlohmann::json extractEngineState(const std::string& engine_id);
 
+    /**
+     * Copy one field out of the engine, with the lattice dimensions used
+     * for FFT / peak dimensionality (1 for absent axes)
+     *
+     * @throws std::runtime_error if the engine or field does not exist
+     */
+    void gatherField(
+        const std::string& engine_id,
+        const std::string& field_name,
+        std::vector<double>& data,
+        size_t dims[3]
+    );
+
+    // Run one script in the worker, falling back to a fresh interpreter
+    python::PythonAnalysisResult runPythonScript(
+        const std::string& state_json_path,
+        const python::PythonAnalysisConfig& config
+    );
+
     // Run Python analysis
     void runPythonAnalysis(
-        const std::string& engine_id,
+        const nlohmann::json& state_data,
         const AnalysisConfig& config,
         CombinedAnalysisResult& result
     );
@@ -174,6 +249,18 @@ private:
         CombinedAnalysisResult& result
     );
 
+    // Run the matched-filter search; the transformed bank is kept for the
+    // next request with the same templates and block size
+    void runMatchedFilterAnalysis(
+        const std::string& engine_id,
+        const AnalysisConfig& config,
+        CombinedAnalysisResult& result
+    );
+
+    std::unique_ptr<analysis::MatchedFilterBank> filter_bank_;
+    std::vector<std::vector<double>> filter_templates_;   // Templates of filter_bank_
+    size_t filter_block_size_ = 0;                          // Requested block size of filter_bank_
+
     // Cross-validate results from multiple tools
     void performCrossValidation(CombinedAnalysisResult& result);
 
@@ -0,0 +1,179 @@
+/**
+ * Batch References Implementation
+ */
+
+#include "batch_references.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace dase {
+
+namespace {
+
+// Follow dot-separated keys from `node`; nullptr if any key is missing
+const nlohmann::json* lookup(const nlohmann::json* node, const std::string& path, size_t pos) {
+    while (node && pos < path.size()) {
+        size_t end = path.find('.', pos);
+        if (end == std::string::npos) end = path.size();
+        const std::string key = path.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (node->is_object()) {
+            auto it = node->find(key);
+            node = it == node->end() ? nullptr : &*it;
+        } else if (node->is_array() && !key.empty() &&
+                   key.find_first_not_of("0123456789") == std::string::npos) {
+            const size_t index = std::stoul(key);
+            node = index < node->size() ? &(*node)[index] : nullptr;
+        } else {
+            node = nullptr;
+        }
+    }
+    return node;
+}
+
+// Replace `value` with what the reference `text` names in `response`; the
+// key path starts after the '.' at `pos` (pos == size: the whole result)
+bool resolveIn(nlohmann::json& value, const std::string& text, size_t pos,
+               const nlohmann::json& response, const std::string& source, std::string& error) {
+    if (pos == text.size()) {
+        value = response.contains("result") ? response["result"] : response;
+        return true;
+    }
+    const nlohmann::json* found = nullptr;
+    if (response.contains("result")) {
+        found = lookup(&response["result"], text, pos + 1);
+    }
+    if (!found) {
+        found = lookup(&response, text, pos + 1);
+    }
+    if (!found) {
+        error = "Reference '" + text + "' not found in the response of " + source;
+        return false;
+    }
+    value = *found;
+    return true;
+}
+
+bool resolveString(nlohmann::json& value, const std::vector<nlohmann::json>& responses, std::string& error) {
+    const std::string& text = value.get_ref<const std::string&>();
+    if (text.size() < 2 || text[0] != '$') {
+        return true;
+    }
+    if (text[1] == '$') {
+        value = text.substr(1);
+        return true;
+    }
+    if (!std::isdigit(static_cast<unsigned char>(text[1]))) {
+        return true;
+    }
+
+    size_t pos = 1;
+    size_t index = 0;
+    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+        index = index * 10 + static_cast<size_t>(text[pos] - '0');
+        ++pos;
+    }
+    if (index >= responses.size()) {
+        error = "Reference '" + text + "' names command " + std::to_string(index) +
+                ", which has not run";
+        return false;
+    }
+    if (pos != text.size() && text[pos] != '.') {
+        return true;   // "$1abc" is not a reference
+    }
+    const std::string source = "command " + std::to_string(index);
+    const std::string copy = text;   // `value` is overwritten below
+    return resolveIn(value, copy, pos, responses[index], source, error);
+}
+
+bool isIdChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-';
+}
+
+// Node id a graph reference names ("" if `text` is not of the form
+// "$<id>" or "$<id>.<path>"); `end` receives the position after the id
+std::string graphReferenceId(const std::string& text, size_t& end) {
+    if (text.size() < 2 || text[0] != '$' || text[1] == '$') {
+        return "";
+    }
+    end = 1;
+    while (end < text.size() && isIdChar(text[end])) {
+        ++end;
+    }
+    if (end == 1 || (end < text.size() && text[end] != '.')) {
+        return "";
+    }
+    return text.substr(1, end - 1);
+}
+
+} // namespace
+
+bool resolveBatchReferences(nlohmann::json& value,
+                            const std::vector<nlohmann::json>& responses,
+                            std::string& error) {
+    if (value.is_string()) {
+        return resolveString(value, responses, error);
+    }
+    if (value.is_object() || value.is_array()) {
+        for (auto& child : value) {
+            if (!resolveBatchReferences(child, responses, error)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool resolveGraphReferences(nlohmann::json& value,
+                            const std::map<std::string, const nlohmann::json*>& responses,
+                            std::string& error) {
+    if (value.is_string()) {
+        const std::string text = value.get<std::string>();
+        if (text.size() >= 2 && text[0] == '$' && text[1] == '$') {
+            value = text.substr(1);
+            return true;
+        }
+        size_t end = 0;
+        const std::string id = graphReferenceId(text, end);
+        auto it = id.empty() ? responses.end() : responses.find(id);
+        if (it == responses.end()) {
+            return true;
+        }
+        return resolveIn(value, text, end, *it->second, "node '" + id + "'", error);
+    }
+    if (value.is_object() || value.is_array()) {
+        for (auto& child : value) {
+            if (!resolveGraphReferences(child, responses, error)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void collectGraphReferences(const nlohmann::json& value,
+                            const std::set<std::string>& ids,
+                            std::set<std::string>& found) {
+    if (value.is_string()) {
+        size_t end = 0;
+        const std::string id = graphReferenceId(value.get_ref<const std::string&>(), end);
+        if (!id.empty() && ids.count(id)) {
+            found.insert(id);
+        }
+    } else if (value.is_object() || value.is_array()) {
+        for (const auto& child : value) {
+            collectGraphReferences(child, ids, found);
+        }
+    }
+}
+
+bool isGraphNodeId(const std::string& id) {
+    if (id.empty() || !(std::isalpha(static_cast<unsigned char>(id[0])) || id[0] == '_')) {
+        return false;
+    }
+    return std::all_of(id.begin(), id.end(), isIdChar);
+}
+
+} // namespace dase
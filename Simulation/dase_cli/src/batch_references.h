@@ -0,0 +1,61 @@
+/**
+ * Batch References - Results of earlier batch commands as later parameters
+ *
+ * The batch command runs an ordered list of commands in one request.  A
+ * command's params may refer to the response of an earlier command in the
+ * same batch with a string of the form
+ *
+ *   "$<index>.<key>[.<key>...]"      e.g. "$0.engine_id", "$2.metrics.ns_per_op"
+ *
+ * Numeric keys index arrays.  Keys are looked up in the earlier response's
+ * "result" object first, then in the response itself (so "$1.status"
+ * works).  The whole string is replaced by the referenced value, keeping
+ * its JSON type.  "$$..." is a literal string starting with "$"; any
+ * other string is left as it is.
+ *
+ * run_graph (mission_graph.h) names nodes instead of indices:
+ * "$<node id>.<key>..." refers to the response of that node and makes it
+ * a dependency.  A "$name" that is not a node id of the graph stays a
+ * literal string.
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+
+/**
+ * Replace every reference inside `value` (recursively) with the value it
+ * names in `responses` (the batch's responses so far, in order)
+ *
+ * @return false with `error` set for a reference to a command that has not
+ *         run or a key its response does not have
+ */
+bool resolveBatchReferences(nlohmann::json& value,
+                            const std::vector<nlohmann::json>& responses,
+                            std::string& error);
+
+/**
+ * Graph form: replace every "$<node id>..." reference inside `value` whose
+ * node is a key of `responses` (the node's finished dependencies)
+ *
+ * @return false with `error` set for a key the response does not have
+ */
+bool resolveGraphReferences(nlohmann::json& value,
+                            const std::map<std::string, const nlohmann::json*>& responses,
+                            std::string& error);
+
+// Add to `found` every id of `ids` that a reference inside `value` names
+void collectGraphReferences(const nlohmann::json& value,
+                            const std::set<std::string>& ids,
+                            std::set<std::string>& found);
+
+// Whether `id` can be named by a graph reference: [A-Za-z_][A-Za-z0-9_-]*
+bool isGraphNodeId(const std::string& id);
+
+} // namespace dase
@@ -0,0 +1,294 @@
+/**
+ * Binary Protocol - Frame encoding and decoding
+ */
+
+#include "binary_protocol.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace dase {
+namespace protocol {
+
+namespace {
+
+bool hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+template <typename T>
+void putLE(std::vector<uint8_t>& out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<uint8_t>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+    }
+}
+
+template <typename T>
+T getLE(const uint8_t* bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+bool readExact(std::istream& in, void* dst, size_t bytes) {
+    in.read(static_cast<char*>(dst), static_cast<std::streamsize>(bytes));
+    return static_cast<size_t>(in.gcount()) == bytes;
+}
+
+// Byte-swap 8-byte values in place (big-endian hosts)
+void swapDoubles(double* values, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        unsigned char bytes[8];
+        std::memcpy(bytes, &values[i], 8);
+        for (size_t b = 0; b < 4; ++b) {
+            const unsigned char t = bytes[b];
+            bytes[b] = bytes[7 - b];
+            bytes[7 - b] = t;
+        }
+        std::memcpy(&values[i], bytes, 8);
+    }
+}
+
+bool isSegmentReference(const json& value) {
+    return value.is_object() && value.contains("$segment");
+}
+
+// Channel of segments no reference asked to encode
+constexpr uint32_t kUntaggedChannel = 0xFFFFFFFFu;
+
+struct SegmentTag {
+    bool tagged = false;
+    SegmentEncoding encoding;
+    uint32_t channel = kUntaggedChannel;
+    bool key = false;
+};
+
+// Encodings asked for by the segment references of `value`
+void collectTags(const json& value, std::vector<SegmentTag>& tags) {
+    if (isSegmentReference(value)) {
+        const json& index = value["$segment"];
+        if (value.contains("encoding") && index.is_number_unsigned() && index.get<uint64_t>() < tags.size()) {
+            SegmentTag& tag = tags[index.get<size_t>()];
+            std::string error;
+            tag.tagged = SegmentEncoding::parse(value["encoding"], tag.encoding, error);
+            tag.channel = value.value("channel", uint32_t(0));
+            tag.key = value.value("key", false);
+        }
+        return;
+    }
+    if (value.is_object() || value.is_array()) {
+        for (const auto& item : value) {
+            collectTags(item, tags);
+        }
+    }
+}
+
+} // namespace
+
+ReadStatus readFrame(std::istream& in, Frame& frame, std::string& error, SegmentDecoder* decoder) {
+    uint8_t header[20];
+    in.read(reinterpret_cast<char*>(header), 1);
+    if (in.gcount() == 0) {
+        return ReadStatus::EndOfStream;
+    }
+    if (!readExact(in, header + 1, sizeof(header) - 1)) {
+        error = "Truncated frame header";
+        return ReadStatus::Error;
+    }
+
+    if (getLE<uint32_t>(header) != kFrameMagic) {
+        error = "Bad frame magic";
+        return ReadStatus::Error;
+    }
+    if (header[4] != kFrameVersion) {
+        error = "Unsupported frame version " + std::to_string(header[4]);
+        return ReadStatus::Error;
+    }
+    if (header[5] != static_cast<uint8_t>(EnvelopeFormat::CBOR) &&
+        header[5] != static_cast<uint8_t>(EnvelopeFormat::MsgPack)) {
+        error = "Unknown envelope format " + std::to_string(header[5]);
+        return ReadStatus::Error;
+    }
+    const auto format = static_cast<EnvelopeFormat>(header[5]);
+    const uint16_t flags = getLE<uint16_t>(header + 6);
+    if ((flags & ~kFrameFlagEncoded) != 0) {
+        error = "Unknown frame flags " + std::to_string(flags);
+        return ReadStatus::Error;
+    }
+    const bool encoded = (flags & kFrameFlagEncoded) != 0;
+    const uint32_t segment_count = getLE<uint32_t>(header + 8);
+    const uint64_t envelope_bytes = getLE<uint64_t>(header + 12);
+    if (segment_count > kMaxSegments || envelope_bytes > kMaxFrameBytes) {
+        error = "Frame too large";
+        return ReadStatus::Error;
+    }
+
+    std::vector<uint64_t> segment_bytes(segment_count);
+    uint64_t total = envelope_bytes;
+    for (uint32_t k = 0; k < segment_count; ++k) {
+        uint8_t length[8];
+        if (!readExact(in, length, sizeof(length))) {
+            error = "Truncated segment table";
+            return ReadStatus::Error;
+        }
+        segment_bytes[k] = getLE<uint64_t>(length);
+        if (!encoded && segment_bytes[k] % sizeof(double) != 0) {
+            error = "Segment " + std::to_string(k) + " is not a whole number of float64 values";
+            return ReadStatus::Error;
+        }
+        total += segment_bytes[k];
+        if (segment_bytes[k] > kMaxFrameBytes || total > kMaxFrameBytes) {
+            error = "Frame too large";
+            return ReadStatus::Error;
+        }
+    }
+
+    std::vector<uint8_t> envelope(static_cast<size_t>(envelope_bytes));
+    if (!readExact(in, envelope.data(), envelope.size())) {
+        error = "Truncated envelope";
+        return ReadStatus::Error;
+    }
+
+    frame.format = format;
+    frame.wire_bytes = sizeof(header) + 8 * uint64_t(segment_count) + total;
+    frame.encoded = encoded;
+    frame.segments.assign(segment_count, std::vector<double>());
+    SegmentDecoder local_decoder;
+    std::vector<uint8_t> block;
+    for (uint32_t k = 0; k < segment_count; ++k) {
+        std::vector<double>& segment = frame.segments[k];
+        if (encoded) {
+            block.resize(static_cast<size_t>(segment_bytes[k]));
+            if (!readExact(in, block.data(), block.size())) {
+                error = "Truncated segment " + std::to_string(k);
+                return ReadStatus::Error;
+            }
+            if (!(decoder ? decoder : &local_decoder)->decode(block.data(), block.size(), segment, error)) {
+                error = "Segment " + std::to_string(k) + ": " + error;
+                return ReadStatus::Error;
+            }
+            continue;
+        }
+        segment.resize(static_cast<size_t>(segment_bytes[k] / sizeof(double)));
+        if (!readExact(in, segment.data(), static_cast<size_t>(segment_bytes[k]))) {
+            error = "Truncated segment " + std::to_string(k);
+            return ReadStatus::Error;
+        }
+        if (!hostIsLittleEndian()) {
+            swapDoubles(segment.data(), segment.size());
+        }
+    }
+
+    try {
+        frame.envelope = (format == EnvelopeFormat::CBOR) ? json::from_cbor(envelope) : json::from_msgpack(envelope);
+    } catch (const json::exception& e) {
+        error = std::string("Envelope decode error: ") + e.what();
+        return ReadStatus::Error;
+    }
+    return ReadStatus::Ok;
+}
+
+uint64_t writeFrame(std::ostream& out, const Frame& frame, SegmentEncoder* encoder) {
+    const std::vector<uint8_t> envelope = (frame.format == EnvelopeFormat::CBOR)
+        ? json::to_cbor(frame.envelope)
+        : json::to_msgpack(frame.envelope);
+
+    // Codec blocks, when a reference asks for an encoding
+    std::vector<std::vector<uint8_t>> blocks;
+    if (encoder) {
+        std::vector<SegmentTag> tags(frame.segments.size());
+        collectTags(frame.envelope, tags);
+        bool any = false;
+        for (const auto& tag : tags) {
+            any = any || (tag.tagged && !tag.encoding.isIdentity());
+        }
+        if (any) {
+            blocks.resize(frame.segments.size());
+            for (size_t k = 0; k < frame.segments.size(); ++k) {
+                const std::vector<double>& segment = frame.segments[k];
+                encoder->encode(tags[k].channel, tags[k].encoding, segment.data(), segment.size(),
+                                blocks[k], tags[k].key);
+            }
+        }
+    }
+    const bool encoded = !blocks.empty();
+
+    std::vector<uint8_t> header;
+    header.reserve(20 + 8 * frame.segments.size());
+    putLE<uint32_t>(header, kFrameMagic);
+    header.push_back(kFrameVersion);
+    header.push_back(static_cast<uint8_t>(frame.format));
+    putLE<uint16_t>(header, encoded ? kFrameFlagEncoded : 0);
+    putLE<uint32_t>(header, static_cast<uint32_t>(frame.segments.size()));
+    putLE<uint64_t>(header, envelope.size());
+    for (size_t k = 0; k < frame.segments.size(); ++k) {
+        putLE<uint64_t>(header, encoded ? blocks[k].size() : frame.segments[k].size() * sizeof(double));
+    }
+
+    out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    out.write(reinterpret_cast<const char*>(envelope.data()), static_cast<std::streamsize>(envelope.size()));
+    if (encoded) {
+        uint64_t written = header.size() + envelope.size();
+        for (const auto& block : blocks) {
+            out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+            written += block.size();
+        }
+        return written;
+    }
+    for (const auto& segment : frame.segments) {
+        if (hostIsLittleEndian()) {
+            out.write(reinterpret_cast<const char*>(segment.data()),
+                      static_cast<std::streamsize>(segment.size() * sizeof(double)));
+        } else {
+            std::vector<double> swapped(segment);
+            swapDoubles(swapped.data(), swapped.size());
+            out.write(reinterpret_cast<const char*>(swapped.data()),
+                      static_cast<std::streamsize>(swapped.size() * sizeof(double)));
+        }
+    }
+
+    uint64_t written = header.size() + envelope.size();
+    for (const auto& segment : frame.segments) {
+        written += segment.size() * sizeof(double);
+    }
+    return written;
+}
+
+bool expandSegments(json& value, const Segments& segments, std::string& error) {
+    if (isSegmentReference(value)) {
+        const json& index_value = value["$segment"];
+        if (!index_value.is_number_unsigned() || index_value.get<uint64_t>() >= segments.size()) {
+            error = "Segment reference out of range";
+            return false;
+        }
+        const std::vector<double>& segment = segments[index_value.get<size_t>()];
+        if (value.contains("count") && value["count"].is_number() &&
+            value["count"].get<uint64_t>() != segment.size()) {
+            error = "Segment reference count mismatch";
+            return false;
+        }
+        value = segment;
+        return true;
+    }
+    if (value.is_object() || value.is_array()) {
+        for (auto& item : value) {
+            if (!expandSegments(item, segments, error)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+json segmentReference(size_t index, size_t count) {
+    return json{{"$segment", index}, {"dtype", "f64"}, {"count", count}};
+}
+
+} // namespace protocol
+} // namespace dase
@@ -0,0 +1,122 @@
+/**
+ * Binary Protocol - Length-prefixed frames for dase_cli --protocol=binary
+ *
+ * The default protocol is one JSON text command per line and one JSON text
+ * response per line.  Large state arrays then travel as decimal text (a
+ * get_state on a 1M-node engine is ~60 MB).  In binary mode each message
+ * is a frame: a fixed header, a CBOR or MessagePack envelope carrying the
+ * same command / response object, and raw little-endian float64 payload
+ * segments that the envelope refers to.
+ *
+ * Frame layout (all integers little-endian):
+ *
+ *   u32  magic            "DASB" (0x42534144)
+ *   u8   version          1
+ *   u8   envelope format  1 = CBOR, 2 = MessagePack
+ *   u16  flags            bit 0: segments are codec blocks (segment_codec.h)
+ *   u32  segment count    S
+ *   u64  envelope bytes   E
+ *   u64  x S              byte length of each segment (a multiple of 8
+ *                         unless the segments are codec blocks)
+ *   E bytes               envelope
+ *   segments, in order    raw float64 values, or one codec block each
+ *
+ * In the envelope, an array may be replaced by a segment reference
+ *
+ *   {"$segment": k, "dtype": "f64", "count": n}
+ *
+ * A response reference may add "precision": "f32" when the values were
+ * rounded to float32 on request ("dtype": "f32" selections); the segment
+ * still holds float64 values.
+ *
+ * A reference may also carry "encoding" (SegmentEncoding::describe), a
+ * "channel" and "key": true.  writeFrame with a SegmentEncoder then sends
+ * every segment of the frame as a codec block (untagged ones as plain
+ * float64 blocks) and sets flag bit 0; readFrame decodes the blocks back to
+ * float64 segments, keeping the delta reference of each channel in its
+ * SegmentDecoder.  Encoder and decoder state spans the frames of one
+ * stream, so streamed snapshots are delta-coded against the previous one.
+ *
+ * Requests may use references anywhere (they are expanded to JSON arrays
+ * before the command runs); responses use them for the state arrays of
+ * get_state, get_satp_state and run_mission_with_snapshots.  A response is
+ * written in the envelope format of its request.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "json.hpp"
+#include "segment_codec.h"
+
+namespace dase {
+namespace protocol {
+
+using json = nlohmann::json;
+
+enum class EnvelopeFormat : uint8_t {
+    CBOR = 1,
+    MsgPack = 2
+};
+
+constexpr uint32_t kFrameMagic = 0x42534144u;   // "DASB" as little-endian bytes
+constexpr uint8_t kFrameVersion = 1;
+constexpr uint16_t kFrameFlagEncoded = 1;   // Segments are codec blocks
+constexpr uint32_t kMaxSegments = 1u << 16;
+constexpr uint64_t kMaxFrameBytes = uint64_t(1) << 34;   // 16 GiB
+
+using Segments = std::vector<std::vector<double>>;
+
+struct Frame {
+    EnvelopeFormat format = EnvelopeFormat::CBOR;
+    json envelope;
+    Segments segments;
+    uint64_t wire_bytes = 0;   // Size on the wire, set by readFrame
+    bool encoded = false;      // Segments arrived as codec blocks (readFrame)
+};
+
+enum class ReadStatus {
+    Ok,
+    EndOfStream,   // Clean EOF before a frame started
+    Error          // Bad header, truncated frame or undecodable envelope
+};
+
+/**
+ * Read one frame
+ *
+ * @param error Set to a description when the result is ReadStatus::Error
+ * @param decoder Delta state of the stream for encoded frames (null: a
+ *        frame-local decoder, so delta blocks must reference blocks of
+ *        the same frame)
+ */
+ReadStatus readFrame(std::istream& in, Frame& frame, std::string& error,
+                     SegmentDecoder* decoder = nullptr);
+
+/**
+ * Write one frame (does not flush)
+ *
+ * @param encoder Delta state of the stream; when given and a segment
+ *        reference of the envelope asks for an encoding, the segments are
+ *        written as codec blocks.  Null writes raw float64 segments.
+ * @return Bytes written
+ */
+uint64_t writeFrame(std::ostream& out, const Frame& frame, SegmentEncoder* encoder = nullptr);
+
+/**
+ * Replace every segment reference in `value` by its array
+ *
+ * @return false (value partly expanded) if a reference names a missing
+ *         segment or its count disagrees with the segment
+ */
+bool expandSegments(json& value, const Segments& segments, std::string& error);
+
+/**
+ * Reference to segment `index` of `count` float64 values
+ */
+json segmentReference(size_t index, size_t count);
+
+} // namespace protocol
+} // namespace dase
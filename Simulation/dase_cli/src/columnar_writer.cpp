@@ -0,0 +1,802 @@
+/**
+ * Columnar Writer Implementation
+ *
+ * Arrow metadata is FlatBuffers; the builder below lays each object out
+ * front to back (vtable, then table, then the objects it references), so
+ * every uoffset points forward as the format requires.  Parquet metadata
+ * is Thrift compact protocol.
+ */
+
+#include "columnar_writer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace dase {
+namespace columnar {
+
+namespace {
+
+size_t fixedWidth(Type type) {
+    switch (type) {
+        case Type::Int32:   return 4;
+        case Type::Int64:   return 8;
+        case Type::UInt64:  return 8;
+        case Type::Float32: return 4;
+        case Type::Float64: return 8;
+        case Type::Bool:    return 1;
+        case Type::Utf8:    return 0;
+    }
+    return 0;
+}
+
+// Rows [first, first + rows) of a Bool column bit-packed LSB first
+std::vector<uint8_t> packBits(const ColumnBatch::Column& column, size_t first, size_t rows) {
+    std::vector<uint8_t> bits((rows + 7) / 8, 0);
+    for (size_t r = 0; r < rows; ++r) {
+        if (column.values[first + r]) {
+            bits[r / 8] |= static_cast<uint8_t>(1u << (r % 8));
+        }
+    }
+    return bits;
+}
+
+// ----------------------------------------------------------------------------
+// FlatBuffers (Arrow IPC metadata)
+// ----------------------------------------------------------------------------
+
+class FlatBuilder {
+public:
+    // A table's fields: scalars by value, offsets linked after writeTable
+    class Table {
+    public:
+        template <typename T>
+        Table& scalar(uint16_t id, T value) {
+            Slot slot{id, static_cast<uint8_t>(sizeof(T)), 0, false};
+            std::memcpy(&slot.bits, &value, sizeof(T));
+            slots_.push_back(slot);
+            return *this;
+        }
+        Table& offset(uint16_t id) {
+            slots_.push_back(Slot{id, 4, 0, true});
+            return *this;
+        }
+
+    private:
+        friend class FlatBuilder;
+        struct Slot {
+            uint16_t id;
+            uint8_t size;
+            uint64_t bits;
+            bool is_offset;
+        };
+        std::vector<Slot> slots_;
+    };
+
+    FlatBuilder() : buf_(4, 0) {}   // Root uoffset, linked by finish()
+
+    /**
+     * Write a table (its vtable right before it)
+     *
+     * @return Positions of its offset slots, in the order offset() was called
+     */
+    std::vector<size_t> writeTable(const Table& table, size_t* table_pos = nullptr) {
+        const auto& slots = table.slots_;
+        // Widest fields first, each aligned to its size from the table start
+        std::vector<size_t> order(slots.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return slots[a].size > slots[b].size; });
+        std::vector<uint16_t> field_offset(slots.size());
+        size_t size = 4;
+        uint16_t num_ids = 0;
+        for (size_t i : order) {
+            size = (size + slots[i].size - 1) / slots[i].size * slots[i].size;
+            field_offset[i] = static_cast<uint16_t>(size);
+            size += slots[i].size;
+            num_ids = std::max<uint16_t>(num_ids, static_cast<uint16_t>(slots[i].id + 1));
+        }
+
+        align(2);
+        const size_t vtable = buf_.size();
+        std::vector<uint16_t> entries(2 + num_ids, 0);
+        entries[0] = static_cast<uint16_t>(2 * entries.size());
+        entries[1] = static_cast<uint16_t>(size);
+        for (size_t i = 0; i < slots.size(); ++i) {
+            entries[2 + slots[i].id] = field_offset[i];
+        }
+        append(entries.data(), entries.size() * sizeof(uint16_t));
+
+        align(8);   // Field offsets are then aligned in the buffer too
+        const size_t start = buf_.size();
+        buf_.resize(start + size, 0);
+        put<int32_t>(start, static_cast<int32_t>(start - vtable));
+        std::vector<size_t> offset_slots;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (slots[i].is_offset) {
+                offset_slots.push_back(start + field_offset[i]);
+            } else {
+                std::memcpy(buf_.data() + start + field_offset[i], &slots[i].bits, slots[i].size);
+            }
+        }
+        if (table_pos) *table_pos = start;
+        return offset_slots;
+    }
+
+    size_t writeString(const std::string& text) {
+        align(4);
+        const size_t pos = buf_.size();
+        const uint32_t length = static_cast<uint32_t>(text.size());
+        append(&length, sizeof(length));
+        append(text.data(), text.size());
+        buf_.push_back(0);
+        return pos;
+    }
+
+    // Vector of `count` uoffsets; element i's slot is at return + 4 + 4 i
+    size_t writeOffsetVector(size_t count) {
+        align(4);
+        const size_t pos = buf_.size();
+        const uint32_t length = static_cast<uint32_t>(count);
+        append(&length, sizeof(length));
+        buf_.resize(buf_.size() + 4 * count, 0);
+        return pos;
+    }
+
+    // Vector of 16-byte structs of two int64 (FieldNode, Buffer)
+    size_t writePairVector(const std::vector<std::pair<int64_t, int64_t>>& pairs) {
+        align(4);
+        if ((buf_.size() + 4) % 8 != 0) buf_.resize(buf_.size() + 4, 0);
+        const size_t pos = buf_.size();
+        const uint32_t length = static_cast<uint32_t>(pairs.size());
+        append(&length, sizeof(length));
+        for (const auto& pair : pairs) {
+            append(&pair.first, sizeof(int64_t));
+            append(&pair.second, sizeof(int64_t));
+        }
+        return pos;
+    }
+
+    // Point the uoffset at `slot` to `target` (always later in the buffer)
+    void link(size_t slot, size_t target) { put<uint32_t>(slot, static_cast<uint32_t>(target - slot)); }
+
+    // Root table, padded to 8 bytes
+    std::vector<uint8_t> finish(size_t root) {
+        link(0, root);
+        align(8);
+        return std::move(buf_);
+    }
+
+private:
+    std::vector<uint8_t> buf_;
+
+    void align(size_t alignment) {
+        buf_.resize((buf_.size() + alignment - 1) / alignment * alignment, 0);
+    }
+    void append(const void* data, size_t bytes) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        buf_.insert(buf_.end(), p, p + bytes);
+    }
+    template <typename T>
+    void put(size_t at, T value) {
+        std::memcpy(buf_.data() + at, &value, sizeof(T));
+    }
+};
+
+// Schema.fbs / Message.fbs constants
+constexpr int16_t kMetadataV5 = 4;
+constexpr uint8_t kHeaderSchema = 1;
+constexpr uint8_t kHeaderRecordBatch = 3;
+constexpr uint8_t kTypeInt = 2;
+constexpr uint8_t kTypeFloatingPoint = 3;
+constexpr uint8_t kTypeUtf8 = 5;
+constexpr uint8_t kTypeBool = 6;
+constexpr int16_t kPrecisionSingle = 1;
+constexpr int16_t kPrecisionDouble = 2;
+
+// Message table with its header union; returns the header's slot
+size_t writeMessage(FlatBuilder& fb, uint8_t header_type, int64_t body_length, size_t& message_pos) {
+    FlatBuilder::Table message;
+    message.scalar<int16_t>(0, kMetadataV5)
+           .scalar<uint8_t>(1, header_type)
+           .offset(2)
+           .scalar<int64_t>(3, body_length);
+    return fb.writeTable(message, &message_pos)[0];
+}
+
+void writeKeyValues(FlatBuilder& fb, size_t slot, const std::vector<std::pair<std::string, std::string>>& pairs) {
+    const size_t vector = fb.writeOffsetVector(pairs.size());
+    fb.link(slot, vector);
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        FlatBuilder::Table kv;
+        kv.offset(0).offset(1);
+        size_t table = 0;
+        const std::vector<size_t> slots = fb.writeTable(kv, &table);
+        fb.link(vector + 4 + 4 * i, table);
+        fb.link(slots[0], fb.writeString(pairs[i].first));
+        fb.link(slots[1], fb.writeString(pairs[i].second));
+    }
+}
+
+void writeArrowField(FlatBuilder& fb, size_t slot, const ColumnSchema& column) {
+    uint8_t type_type = kTypeInt;
+    FlatBuilder::Table type;
+    switch (column.type) {
+        case Type::Int32:   type.scalar<int32_t>(0, 32).scalar<uint8_t>(1, 1); break;
+        case Type::Int64:   type.scalar<int32_t>(0, 64).scalar<uint8_t>(1, 1); break;
+        case Type::UInt64:  type.scalar<int32_t>(0, 64).scalar<uint8_t>(1, 0); break;
+        case Type::Float32: type_type = kTypeFloatingPoint; type.scalar<int16_t>(0, kPrecisionSingle); break;
+        case Type::Float64: type_type = kTypeFloatingPoint; type.scalar<int16_t>(0, kPrecisionDouble); break;
+        case Type::Bool:    type_type = kTypeBool; break;
+        case Type::Utf8:    type_type = kTypeUtf8; break;
+    }
+
+    FlatBuilder::Table field;
+    field.offset(0)                       // name
+         .scalar<uint8_t>(1, 0)           // nullable = false
+         .scalar<uint8_t>(2, type_type)
+         .offset(3)                       // type
+         .offset(5);                      // children (readers require the vector)
+    size_t table = 0;
+    const std::vector<size_t> slots = fb.writeTable(field, &table);
+    fb.link(slot, table);
+    fb.link(slots[0], fb.writeString(column.name));
+    size_t type_table = 0;
+    fb.writeTable(type, &type_table);
+    fb.link(slots[1], type_table);
+    fb.link(slots[2], fb.writeOffsetVector(0));
+}
+
+// ----------------------------------------------------------------------------
+// Thrift compact protocol (Parquet metadata)
+// ----------------------------------------------------------------------------
+
+class ThriftWriter {
+public:
+    enum : uint8_t { kI32 = 5, kI64 = 6, kBinary = 8, kList = 9, kStruct = 12 };
+
+    void i32(int16_t id, int32_t value) {
+        field(id, kI32);
+        varint(zigzag(value));
+    }
+    void i64(int16_t id, int64_t value) {
+        field(id, kI64);
+        varint(zigzag(value));
+    }
+    void string(int16_t id, const std::string& value) {
+        field(id, kBinary);
+        varint(value.size());
+        out_.insert(out_.end(), value.begin(), value.end());
+    }
+    void beginStruct(int16_t id) {
+        field(id, kStruct);
+        last_.push_back(0);
+    }
+    void endStruct() {
+        out_.push_back(0);
+        last_.pop_back();
+    }
+    void beginList(int16_t id, uint8_t element_type, size_t size) {
+        field(id, kList);
+        if (size < 15) {
+            out_.push_back(static_cast<uint8_t>(size << 4 | element_type));
+        } else {
+            out_.push_back(static_cast<uint8_t>(0xF0 | element_type));
+            varint(size);
+        }
+    }
+    // List elements
+    void beginElement() { last_.push_back(0); }
+    void endElement() { endStruct(); }
+    void element(int32_t value) { varint(zigzag(value)); }
+    void element(const std::string& value) {
+        varint(value.size());
+        out_.insert(out_.end(), value.begin(), value.end());
+    }
+    // Top-level struct end
+    void stop() { out_.push_back(0); }
+
+    const std::vector<uint8_t>& bytes() const { return out_; }
+
+private:
+    std::vector<uint8_t> out_;
+    std::vector<int16_t> last_{0};
+
+    void field(int16_t id, uint8_t type) {
+        const int delta = id - last_.back();
+        if (delta > 0 && delta <= 15) {
+            out_.push_back(static_cast<uint8_t>(delta << 4 | type));
+        } else {
+            out_.push_back(type);
+            varint(zigzag(static_cast<int32_t>(id)));
+        }
+        last_.back() = id;
+    }
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            out_.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out_.push_back(static_cast<uint8_t>(value));
+    }
+    static uint64_t zigzag(int32_t value) {
+        return static_cast<uint32_t>((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+    }
+    static uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+};
+
+// parquet.thrift enums
+constexpr int32_t kParquetBoolean = 0;
+constexpr int32_t kParquetInt32 = 1;
+constexpr int32_t kParquetInt64 = 2;
+constexpr int32_t kParquetFloat = 4;
+constexpr int32_t kParquetDouble = 5;
+constexpr int32_t kParquetByteArray = 6;
+constexpr int32_t kRequired = 0;
+constexpr int32_t kConvertedUtf8 = 0;
+constexpr int32_t kConvertedUInt64 = 14;
+constexpr int32_t kEncodingPlain = 0;
+constexpr int32_t kEncodingRle = 3;
+constexpr int32_t kUncompressed = 0;
+constexpr int32_t kDataPage = 0;
+
+int32_t parquetType(Type type) {
+    switch (type) {
+        case Type::Int32:   return kParquetInt32;
+        case Type::Int64:
+        case Type::UInt64:  return kParquetInt64;
+        case Type::Float32: return kParquetFloat;
+        case Type::Float64: return kParquetDouble;
+        case Type::Bool:    return kParquetBoolean;
+        case Type::Utf8:    return kParquetByteArray;
+    }
+    return kParquetByteArray;
+}
+
+// ----------------------------------------------------------------------------
+// Writers
+// ----------------------------------------------------------------------------
+
+class ArrowStreamWriter : public ColumnarWriter {
+public:
+    ~ArrowStreamWriter() override {
+        std::string ignored;
+        close(ignored);
+    }
+
+    bool open(const std::string& path, const std::vector<ColumnSchema>& schema,
+              const std::vector<std::pair<std::string, std::string>>& metadata, std::string& error) override {
+        if (!openFile(path, error)) {
+            return false;
+        }
+        schema_ = schema;
+
+        FlatBuilder fb;
+        size_t message = 0;
+        const size_t header = writeMessage(fb, kHeaderSchema, 0, message);
+        FlatBuilder::Table table;
+        table.scalar<int16_t>(0, 0)   // Little-endian
+             .offset(1);              // fields
+        if (!metadata.empty()) {
+            table.offset(2);          // custom_metadata
+        }
+        size_t schema_table = 0;
+        const std::vector<size_t> slots = fb.writeTable(table, &schema_table);
+        fb.link(header, schema_table);
+        const size_t fields = fb.writeOffsetVector(schema.size());
+        fb.link(slots[0], fields);
+        for (size_t i = 0; i < schema.size(); ++i) {
+            writeArrowField(fb, fields + 4 + 4 * i, schema[i]);
+        }
+        if (!metadata.empty()) {
+            writeKeyValues(fb, slots[1], metadata);
+        }
+        if (!writeMessageBytes(fb.finish(message), {})) {
+            error = "Failed to write Arrow schema: " + path;
+            closeFile();
+            return false;
+        }
+        return true;
+    }
+
+    bool write(const ColumnBatch& batch, std::string& error) override {
+        if (!file_) {
+            error = "Arrow stream is not open";
+            return false;
+        }
+        if (!checkBatch(batch, schema_, error)) {
+            return false;
+        }
+        const size_t rows = batch.numRows();
+        for (size_t first = 0; first < rows; first += max_rows_) {
+            if (!writeRecordBatch(batch, first, std::min(max_rows_, rows - first), error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool close(std::string& error) override {
+        if (!file_) {
+            return true;
+        }
+        const uint32_t eos[2] = {0xFFFFFFFFu, 0};
+        const bool ok = writeBytes(eos, sizeof(eos)) && closeFile();
+        if (!ok) error = "Failed to finish Arrow stream";
+        return ok;
+    }
+
+private:
+    std::vector<ColumnSchema> schema_;
+
+    bool writeRecordBatch(const ColumnBatch& batch, size_t first, size_t rows, std::string& error) {
+        // Body: per column its validity (empty: no nulls) and data buffers,
+        // each at an 8-byte aligned offset
+        std::vector<uint8_t> body;
+        std::vector<std::pair<int64_t, int64_t>> nodes;
+        std::vector<std::pair<int64_t, int64_t>> buffers;
+        auto add_buffer = [&](const void* data, size_t bytes) {
+            buffers.emplace_back(static_cast<int64_t>(body.size()), static_cast<int64_t>(bytes));
+            const auto* p = static_cast<const uint8_t*>(data);
+            body.insert(body.end(), p, p + bytes);
+            body.resize((body.size() + 7) / 8 * 8, 0);
+        };
+
+        for (size_t c = 0; c < schema_.size(); ++c) {
+            const ColumnBatch::Column& column = batch.column(c);
+            nodes.emplace_back(static_cast<int64_t>(rows), 0);
+            add_buffer(nullptr, 0);
+            if (schema_[c].type == Type::Bool) {
+                const std::vector<uint8_t> bits = packBits(column, first, rows);
+                add_buffer(bits.data(), bits.size());
+            } else if (schema_[c].type == Type::Utf8) {
+                const int64_t base = column.offsets[first];
+                const int64_t chars = column.offsets[first + rows] - base;
+                if (chars > std::numeric_limits<int32_t>::max()) {
+                    error = "Utf8 column '" + schema_[c].name + "' exceeds 2 GiB in one batch";
+                    return false;
+                }
+                std::vector<int32_t> offsets(rows + 1);
+                for (size_t r = 0; r <= rows; ++r) {
+                    offsets[r] = static_cast<int32_t>(column.offsets[first + r] - base);
+                }
+                add_buffer(offsets.data(), offsets.size() * sizeof(int32_t));
+                add_buffer(column.values.data() + base, static_cast<size_t>(chars));
+            } else {
+                const size_t width = fixedWidth(schema_[c].type);
+                add_buffer(column.values.data() + first * width, rows * width);
+            }
+        }
+
+        FlatBuilder fb;
+        size_t message = 0;
+        const size_t header = writeMessage(fb, kHeaderRecordBatch, static_cast<int64_t>(body.size()), message);
+        FlatBuilder::Table table;
+        table.scalar<int64_t>(0, static_cast<int64_t>(rows)).offset(1).offset(2);
+        size_t record_batch = 0;
+        const std::vector<size_t> slots = fb.writeTable(table, &record_batch);
+        fb.link(header, record_batch);
+        fb.link(slots[0], fb.writePairVector(nodes));
+        fb.link(slots[1], fb.writePairVector(buffers));
+
+        if (!writeMessageBytes(fb.finish(message), body)) {
+            error = "Failed to write Arrow record batch";
+            return false;
+        }
+        rows_written_ += rows;
+        return true;
+    }
+
+    // Encapsulated message: continuation marker, metadata size, metadata
+    // (8-byte padded), body
+    bool writeMessageBytes(const std::vector<uint8_t>& metadata, const std::vector<uint8_t>& body) {
+        const uint32_t prefix[2] = {0xFFFFFFFFu, static_cast<uint32_t>(metadata.size())};
+        return writeBytes(prefix, sizeof(prefix)) && writeBytes(metadata.data(), metadata.size()) &&
+               writeBytes(body.data(), body.size());
+    }
+};
+
+class ParquetWriter : public ColumnarWriter {
+public:
+    ~ParquetWriter() override {
+        std::string ignored;
+        close(ignored);
+    }
+
+    bool open(const std::string& path, const std::vector<ColumnSchema>& schema,
+              const std::vector<std::pair<std::string, std::string>>& metadata, std::string& error) override {
+        if (!openFile(path, error)) {
+            return false;
+        }
+        schema_ = schema;
+        metadata_ = metadata;
+        row_groups_.clear();
+        if (!writeBytes("PAR1", 4)) {
+            error = "Failed to write Parquet header: " + path;
+            closeFile();
+            return false;
+        }
+        return true;
+    }
+
+    bool write(const ColumnBatch& batch, std::string& error) override {
+        if (!file_) {
+            error = "Parquet file is not open";
+            return false;
+        }
+        if (!checkBatch(batch, schema_, error)) {
+            return false;
+        }
+        const size_t rows = batch.numRows();
+        for (size_t first = 0; first < rows; first += max_rows_) {
+            if (!writeRowGroup(batch, first, std::min(max_rows_, rows - first), error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool close(std::string& error) override {
+        if (!file_) {
+            return true;
+        }
+        ThriftWriter meta;
+        meta.i32(1, 1);   // version
+        meta.beginList(2, ThriftWriter::kStruct, schema_.size() + 1);
+        meta.beginElement();
+        meta.string(4, "schema");
+        meta.i32(5, static_cast<int32_t>(schema_.size()));
+        meta.endElement();
+        for (const ColumnSchema& column : schema_) {
+            meta.beginElement();
+            meta.i32(1, parquetType(column.type));
+            meta.i32(3, kRequired);
+            meta.string(4, column.name);
+            if (column.type == Type::Utf8) {
+                meta.i32(6, kConvertedUtf8);
+            } else if (column.type == Type::UInt64) {
+                meta.i32(6, kConvertedUInt64);
+            }
+            meta.endElement();
+        }
+        int64_t num_rows = 0;
+        for (const RowGroup& group : row_groups_) num_rows += group.rows;
+        meta.i64(3, num_rows);
+        meta.beginList(4, ThriftWriter::kStruct, row_groups_.size());
+        for (const RowGroup& group : row_groups_) {
+            meta.beginElement();
+            meta.beginList(1, ThriftWriter::kStruct, group.chunks.size());
+            int64_t total_bytes = 0;
+            for (size_t c = 0; c < group.chunks.size(); ++c) {
+                const Chunk& chunk = group.chunks[c];
+                total_bytes += chunk.bytes;
+                meta.beginElement();
+                meta.i64(2, chunk.offset);
+                meta.beginStruct(3);   // ColumnMetaData
+                meta.i32(1, parquetType(schema_[c].type));
+                meta.beginList(2, ThriftWriter::kI32, 2);
+                meta.element(kEncodingPlain);
+                meta.element(kEncodingRle);
+                meta.beginList(3, ThriftWriter::kBinary, 1);
+                meta.element(schema_[c].name);
+                meta.i32(4, kUncompressed);
+                meta.i64(5, group.rows);
+                meta.i64(6, chunk.bytes);
+                meta.i64(7, chunk.bytes);
+                meta.i64(9, chunk.offset);
+                meta.endStruct();
+                meta.endElement();
+            }
+            meta.i64(2, total_bytes);
+            meta.i64(3, group.rows);
+            meta.endElement();
+        }
+        if (!metadata_.empty()) {
+            meta.beginList(5, ThriftWriter::kStruct, metadata_.size());
+            for (const auto& kv : metadata_) {
+                meta.beginElement();
+                meta.string(1, kv.first);
+                meta.string(2, kv.second);
+                meta.endElement();
+            }
+        }
+        meta.string(6, "dase_cli columnar_writer");
+        meta.stop();
+
+        const uint32_t footer = static_cast<uint32_t>(meta.bytes().size());
+        const bool ok = writeBytes(meta.bytes().data(), meta.bytes().size()) &&
+                        writeBytes(&footer, sizeof(footer)) && writeBytes("PAR1", 4) && closeFile();
+        if (!ok) error = "Failed to write Parquet footer";
+        return ok;
+    }
+
+private:
+    struct Chunk {
+        int64_t offset;   // Of the page header
+        int64_t bytes;    // Page header + data
+    };
+    struct RowGroup {
+        int64_t rows;
+        std::vector<Chunk> chunks;
+    };
+
+    std::vector<ColumnSchema> schema_;
+    std::vector<std::pair<std::string, std::string>> metadata_;
+    std::vector<RowGroup> row_groups_;
+    std::vector<uint8_t> page_;
+
+    bool writeRowGroup(const ColumnBatch& batch, size_t first, size_t rows, std::string& error) {
+        RowGroup group;
+        group.rows = static_cast<int64_t>(rows);
+        for (size_t c = 0; c < schema_.size(); ++c) {
+            // PLAIN values of a REQUIRED column: no level data
+            const ColumnBatch::Column& column = batch.column(c);
+            page_.clear();
+            if (schema_[c].type == Type::Bool) {
+                page_ = packBits(column, first, rows);
+            } else if (schema_[c].type == Type::Utf8) {
+                for (size_t r = first; r < first + rows; ++r) {
+                    const uint32_t length = static_cast<uint32_t>(column.offsets[r + 1] - column.offsets[r]);
+                    const auto* p = reinterpret_cast<const uint8_t*>(&length);
+                    page_.insert(page_.end(), p, p + 4);
+                    page_.insert(page_.end(), column.values.begin() + column.offsets[r],
+                                 column.values.begin() + column.offsets[r + 1]);
+                }
+            } else {
+                const size_t width = fixedWidth(schema_[c].type);
+                page_.assign(column.values.begin() + first * width, column.values.begin() + (first + rows) * width);
+            }
+            if (page_.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+                error = "Parquet page of column '" + schema_[c].name + "' exceeds 2 GiB";
+                return false;
+            }
+
+            ThriftWriter header;
+            header.i32(1, kDataPage);
+            header.i32(2, static_cast<int32_t>(page_.size()));
+            header.i32(3, static_cast<int32_t>(page_.size()));
+            header.beginStruct(5);   // DataPageHeader
+            header.i32(1, static_cast<int32_t>(rows));
+            header.i32(2, kEncodingPlain);
+            header.i32(3, kEncodingRle);
+            header.i32(4, kEncodingRle);
+            header.endStruct();
+            header.stop();
+
+            Chunk chunk;
+            chunk.offset = static_cast<int64_t>(bytes_written_);
+            chunk.bytes = static_cast<int64_t>(header.bytes().size() + page_.size());
+            if (!writeBytes(header.bytes().data(), header.bytes().size()) ||
+                !writeBytes(page_.data(), page_.size())) {
+                error = "Failed to write Parquet column chunk";
+                return false;
+            }
+            group.chunks.push_back(chunk);
+        }
+        row_groups_.push_back(std::move(group));
+        rows_written_ += rows;
+        return true;
+    }
+};
+
+} // namespace
+
+bool parseFormat(const std::string& name, Format& format) {
+    if (name == "arrow") {
+        format = Format::Arrow;
+        return true;
+    }
+    if (name == "parquet") {
+        format = Format::Parquet;
+        return true;
+    }
+    return false;
+}
+
+const char* formatExtension(Format format) {
+    return format == Format::Arrow ? ".arrows" : ".parquet";
+}
+
+ColumnBatch::ColumnBatch(std::vector<ColumnSchema> schema)
+    : schema_(std::move(schema))
+    , columns_(schema_.size()) {
+    clear();
+}
+
+size_t ColumnBatch::numRows() const {
+    return columns_.empty() ? 0 : columns_[0].rows;
+}
+
+void ColumnBatch::appendFixed(size_t c, const void* data, size_t bytes) {
+    Column& column = columns_[c];
+    const auto* p = static_cast<const uint8_t*>(data);
+    column.values.insert(column.values.end(), p, p + bytes);
+    column.rows += bytes / fixedWidth(schema_[c].type);
+}
+
+void ColumnBatch::appendBool(size_t c, bool value) {
+    columns_[c].values.push_back(value ? 1 : 0);
+    columns_[c].rows++;
+}
+
+void ColumnBatch::appendString(size_t c, const std::string& value) {
+    Column& column = columns_[c];
+    column.values.insert(column.values.end(), value.begin(), value.end());
+    column.offsets.push_back(static_cast<int64_t>(column.values.size()));
+    column.rows++;
+}
+
+void ColumnBatch::clear() {
+    for (size_t c = 0; c < columns_.size(); ++c) {
+        columns_[c].values.clear();
+        columns_[c].offsets.assign(schema_[c].type == Type::Utf8 ? 1 : 0, 0);
+        columns_[c].rows = 0;
+    }
+}
+
+std::unique_ptr<ColumnarWriter> ColumnarWriter::create(Format format) {
+    if (format == Format::Arrow) {
+        return std::unique_ptr<ColumnarWriter>(new ArrowStreamWriter());
+    }
+    return std::unique_ptr<ColumnarWriter>(new ParquetWriter());
+}
+
+bool ColumnarWriter::openFile(const std::string& path, std::string& error) {
+    std::string ignored;
+    close(ignored);
+    file_ = std::fopen(path.c_str(), "wb");
+    bytes_written_ = 0;
+    rows_written_ = 0;
+    if (!file_) {
+        error = "Cannot open columnar output file: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool ColumnarWriter::writeBytes(const void* data, size_t bytes) {
+    if (bytes == 0) {
+        return true;
+    }
+    if (!file_ || std::fwrite(data, 1, bytes, file_) != bytes) {
+        return false;
+    }
+    bytes_written_ += bytes;
+    return true;
+}
+
+bool ColumnarWriter::closeFile() {
+    if (!file_) {
+        return true;
+    }
+    const bool ok = std::fclose(file_) == 0;
+    file_ = nullptr;
+    return ok;
+}
+
+bool ColumnarWriter::checkBatch(const ColumnBatch& batch, const std::vector<ColumnSchema>& schema,
+                                std::string& error) {
+    if (batch.numColumns() != schema.size()) {
+        error = "Batch has " + std::to_string(batch.numColumns()) + " columns, the schema " +
+                std::to_string(schema.size());
+        return false;
+    }
+    for (size_t c = 0; c < schema.size(); ++c) {
+        if (batch.schema()[c].type != schema[c].type || batch.schema()[c].name != schema[c].name) {
+            error = "Batch column " + std::to_string(c) + " does not match the schema";
+            return false;
+        }
+        if (batch.column(c).rows != batch.numRows()) {
+            error = "Batch column '" + schema[c].name + "' has " + std::to_string(batch.column(c).rows) +
+                    " rows, column 0 " + std::to_string(batch.numRows());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace columnar
+} // namespace dase
@@ -0,0 +1,149 @@
+/**
+ * Columnar Writer - Arrow IPC streams and Parquet files without the Arrow
+ * libraries
+ *
+ * Analysis clusters ingest Arrow / Parquet; converting the CLI's JSON
+ * arrays client-side cost more CPU than the simulation.  A ColumnBatch is
+ * a set of equal-length typed columns filled straight from engine arrays;
+ * a ColumnarWriter appends batches to one file of one schema:
+ *
+ *   Arrow    IPC streaming format (metadata version V5, little-endian):
+ *            a Schema message, one RecordBatch message per batch, the
+ *            end-of-stream marker.  Readable with pyarrow.ipc.open_stream.
+ *   Parquet  Format version 1: "PAR1", one row group per batch (one
+ *            uncompressed PLAIN data page per column chunk), the Thrift
+ *            compact FileMetaData footer.
+ *
+ * Every column is non-nullable.  Batches longer than maxRows() are split.
+ * Column types and their physical layout:
+ *
+ *   Type      Arrow                  Parquet
+ *   Int32     Int(32, signed)        INT32
+ *   Int64     Int(64, signed)        INT64
+ *   UInt64    Int(64, unsigned)      INT64, converted type UINT_64
+ *   Float32   FloatingPoint(SINGLE)  FLOAT
+ *   Float64   FloatingPoint(DOUBLE)  DOUBLE
+ *   Bool      Bool (bit-packed)      BOOLEAN (bit-packed)
+ *   Utf8      Utf8 (int32 offsets)   BYTE_ARRAY, converted type UTF8
+ *
+ * `metadata` key / value pairs go to the Arrow schema's custom_metadata
+ * and the Parquet key_value_metadata.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dase {
+namespace columnar {
+
+enum class Type { Int32, Int64, UInt64, Float32, Float64, Bool, Utf8 };
+
+enum class Format { Arrow, Parquet };
+
+// "arrow" / "parquet"; false for another name
+bool parseFormat(const std::string& name, Format& format);
+// File extension of a format (".arrows" or ".parquet")
+const char* formatExtension(Format format);
+
+struct ColumnSchema {
+    std::string name;
+    Type type;
+};
+
+class ColumnBatch {
+public:
+    explicit ColumnBatch(std::vector<ColumnSchema> schema);
+
+    const std::vector<ColumnSchema>& schema() const { return schema_; }
+    size_t numColumns() const { return schema_.size(); }
+
+    // Rows of column 0 (every column must reach it before writing)
+    size_t numRows() const;
+
+    // Append to column c, which must have the matching type
+    void appendInt32(size_t c, int32_t value) { appendFixed(c, &value, sizeof(value)); }
+    void appendInt64(size_t c, int64_t value) { appendFixed(c, &value, sizeof(value)); }
+    void appendUInt64(size_t c, uint64_t value) { appendFixed(c, &value, sizeof(value)); }
+    void appendFloat32(size_t c, float value) { appendFixed(c, &value, sizeof(value)); }
+    void appendFloat64(size_t c, double value) { appendFixed(c, &value, sizeof(value)); }
+    void appendBool(size_t c, bool value);
+    void appendString(size_t c, const std::string& value);
+
+    // Bulk append of a fixed-width column from an engine array
+    void appendFloat64(size_t c, const double* values, size_t count) {
+        appendFixed(c, values, count * sizeof(double));
+    }
+
+    void clear();
+
+    // Layout for the writers: values (fixed width: little-endian values;
+    // Bool: one byte per row; Utf8: the characters), and Utf8 row offsets
+    // (rows + 1 entries)
+    struct Column {
+        std::vector<uint8_t> values;
+        std::vector<int64_t> offsets;
+        size_t rows = 0;
+    };
+    const Column& column(size_t c) const { return columns_[c]; }
+
+private:
+    std::vector<ColumnSchema> schema_;
+    std::vector<Column> columns_;
+
+    void appendFixed(size_t c, const void* data, size_t bytes);
+};
+
+class ColumnarWriter {
+public:
+    static constexpr size_t kDefaultMaxRows = size_t(1) << 20;
+
+    virtual ~ColumnarWriter() = default;
+
+    static std::unique_ptr<ColumnarWriter> create(Format format);
+
+    /**
+     * Create `path` for batches of `schema`
+     *
+     * @return false with `error` set if the file cannot be written
+     */
+    virtual bool open(const std::string& path, const std::vector<ColumnSchema>& schema,
+                      const std::vector<std::pair<std::string, std::string>>& metadata,
+                      std::string& error) = 0;
+
+    // One record batch / row group per maxRows() rows; false with `error`
+    // set on a write failure or a ragged / mistyped batch
+    virtual bool write(const ColumnBatch& batch, std::string& error) = 0;
+
+    // Finish the file (end-of-stream marker / footer); idempotent
+    virtual bool close(std::string& error) = 0;
+
+    uint64_t bytesWritten() const { return bytes_written_; }
+    uint64_t rowsWritten() const { return rows_written_; }
+
+    size_t maxRows() const { return max_rows_; }
+    void setMaxRows(size_t rows) { max_rows_ = rows > 0 ? rows : kDefaultMaxRows; }
+
+protected:
+    std::FILE* file_ = nullptr;
+    uint64_t bytes_written_ = 0;
+    uint64_t rows_written_ = 0;
+    size_t max_rows_ = kDefaultMaxRows;
+
+    bool openFile(const std::string& path, std::string& error);
+    bool writeBytes(const void* data, size_t bytes);
+    bool closeFile();
+
+    // Whether `batch` has this schema and equal-length columns
+    static bool checkBatch(const ColumnBatch& batch, const std::vector<ColumnSchema>& schema,
+                           std::string& error);
+};
+
+} // namespace columnar
+} // namespace dase
@@ -7,20 +7,42 @@
 #include "../../src/cpp/satp_higgs_engine_1d.h"
 #include "../../src/cpp/satp_higgs_engine_2d.h"
 #include "../../src/cpp/satp_higgs_engine_3d.h"
+#include "../../src/cpp/igsoa_ensemble_engine.h"
+#include "../../src/cpp/sid_ssp/sid_fixpoint.hpp"
 #include "analysis_router.h"
 #include "python_bridge.h"
 #include "engine_fft_analysis.h"
+#include "snapshot_stream.h"
+#include "columnar_writer.h"
+#include "batch_references.h"
+#include "mission_graph.h"
+#include "sweep_scheduler.h"
+#include "../../src/cpp/trace_zones.h"
+#include "../../src/cpp/cpu_features.h"
+#include "../../src/cpp/state_digest.h"
+#ifdef USE_FFTW3
+#include "../../src/cpp/fftw_plan_registry.hpp"
+#endif
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <cmath>
 #include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <numeric>
 #include <random>
+#include <set>
+#include <unordered_map>
 
 CommandRouter::CommandRouter()
     : engine_manager(std::make_unique<EngineManager>()) {
 
-    // Initialize analysis router
-    analysis_router_ = std::make_unique<dase::AnalysisRouter>(engine_manager.get());
+    // The analysis router, engine library and FFTW wisdom initialize on
+    // first use (analysisRouter(), EngineManager::ensureEngineLibrary(),
+    // FFTPlanRegistry), or in the background through warmup()
+    job_manager_ = std::make_unique<dase::JobManager>(engine_manager.get());
 
     // Register command handlers
     command_handlers["get_capabilities"] = [this](const json& p) { return handleGetCapabilities(p); };
@@ -33,15 +55,62 @@ CommandRouter::CommandRouter()
     command_handlers["set_igsoa_state"] = [this](const json& p) { return handleSetIgsoaState(p); };
     command_handlers["set_satp_state"] = [this](const json& p) { return handleSetSatpState(p); };
     command_handlers["run_mission"] = [this](const json& p) { return handleRunMission(p); };
+    command_handlers["run_ensemble"] = [this](const json& p) { return handleRunEnsemble(p); };
     command_handlers["run_steps"] = [this](const json& p) { return handleRunSteps(p); };
+    command_handlers["cancel_mission"] = [this](const json& p) { return handleCancelMission(p); };
     command_handlers["run_mission_with_snapshots"] = [this](const json& p) { return handleRunMissionWithSnapshots(p); };
+    command_handlers["run_mission_adaptive"] = [this](const json& p) { return handleRunMissionAdaptive(p); };
     command_handlers["run_benchmark"] = [this](const json& p) { return handleRunBenchmark(p); };
+    command_handlers["run_scaling_study"] = [this](const json& p) { return handleRunScalingStudy(p); };
+    command_handlers["run_sweep"] = [this](const json& p) { return handleRunSweep(p); };
+    command_handlers["run_pipeline"] = [this](const json& p) { return handleRunPipeline(p); };
     command_handlers["get_metrics"] = [this](const json& p) { return handleGetMetrics(p); };
     command_handlers["get_state"] = [this](const json& p) { return handleGetState(p); };
     command_handlers["get_satp_state"] = [this](const json& p) { return handleGetSatpState(p); };
+    command_handlers["get_state_digest"] = [this](const json& p) { return handleGetStateDigest(p); };
+    command_handlers["get_ensemble_state"] = [this](const json& p) { return handleGetEnsembleState(p); };
+    command_handlers["set_ensemble_state"] = [this](const json& p) { return handleSetEnsembleState(p); };
+    command_handlers["map_state"] = [this](const json& p) { return handleMapState(p); };
+    command_handlers["unmap_state"] = [this](const json& p) { return handleUnmapState(p); };
+    command_handlers["buffer_state"] = [this](const json& p) { return handleBufferState(p); };
+    command_handlers["read_snapshot"] = [this](const json& p) { return handleReadSnapshot(p); };
+    command_handlers["unbuffer_state"] = [this](const json& p) { return handleUnbufferState(p); };
+    command_handlers["subscribe_metrics"] = [this](const json& p) { return handleSubscribeMetrics(p); };
+    command_handlers["unsubscribe_metrics"] = [this](const json& p) { return handleUnsubscribeMetrics(p); };
+    command_handlers["add_probe"] = [this](const json& p) { return handleAddProbe(p); };
+    command_handlers["drain_probe"] = [this](const json& p) { return handleDrainProbe(p); };
+    command_handlers["remove_probe"] = [this](const json& p) { return handleRemoveProbe(p); };
+    command_handlers["add_observable"] = [this](const json& p) { return handleAddObservable(p); };
+    command_handlers["drain_observable"] = [this](const json& p) { return handleDrainObservable(p); };
+    command_handlers["remove_observable"] = [this](const json& p) { return handleRemoveObservable(p); };
+    command_handlers["add_trigger"] = [this](const json& p) { return handleAddTrigger(p); };
+    command_handlers["remove_trigger"] = [this](const json& p) { return handleRemoveTrigger(p); };
+    command_handlers["add_spectral_monitor"] = [this](const json& p) { return handleAddSpectralMonitor(p); };
+    command_handlers["get_spectrum"] = [this](const json& p) { return handleGetSpectrum(p); };
+    command_handlers["remove_spectral_monitor"] = [this](const json& p) { return handleRemoveSpectralMonitor(p); };
+    command_handlers["trace_start"] = [this](const json& p) { return handleTraceStart(p); };
+    command_handlers["trace_stop"] = [this](const json& p) { return handleTraceStop(p); };
+    command_handlers["get_router_stats"] = [this](const json& p) { return handleGetRouterStats(p); };
+    command_handlers["checkpoint_engine"] = [this](const json& p) { return handleCheckpointEngine(p); };
+    command_handlers["restore_engine"] = [this](const json& p) { return handleRestoreEngine(p); };
+    command_handlers["clone_engine"] = [this](const json& p) { return handleCloneEngine(p); };
+    command_handlers["reset_engine"] = [this](const json& p) { return handleResetEngine(p); };
+    command_handlers["set_engine_pool"] = [this](const json& p) { return handleSetEnginePool(p); };
+    command_handlers["set_memory_budget"] = [this](const json& p) { return handleSetMemoryBudget(p); };
+    command_handlers["set_thread_budget"] = [this](const json& p) { return handleSetThreadBudget(p); };
+    command_handlers["set_thread_limit"] = [this](const json& p) { return handleSetThreadLimit(p); };
+    command_handlers["get_memory_usage"] = [this](const json& p) { return handleGetMemoryUsage(p); };
+    command_handlers["submit_mission"] = [this](const json& p) { return handleSubmitMission(p); };
+    command_handlers["job_status"] = [this](const json& p) { return handleJobStatus(p); };
+    command_handlers["job_wait"] = [this](const json& p) { return handleJobWait(p); };
+    command_handlers["job_cancel"] = [this](const json& p) { return handleJobCancel(p); };
+    command_handlers["list_jobs"] = [this](const json& p) { return handleListJobs(p); };
+    command_handlers["batch"] = [this](const json& p) { return handleBatch(p); };
+    command_handlers["run_graph"] = [this](const json& p) { return handleRunGraph(p); };
     command_handlers["get_center_of_mass"] = [this](const json& p) { return handleGetCenterOfMass(p); };
     command_handlers["sid_step"] = [this](const json& p) { return handleSidStep(p); };
     command_handlers["sid_collapse"] = [this](const json& p) { return handleSidCollapse(p); };
+    command_handlers["sid_batch"] = [this](const json& p) { return handleSidBatch(p); };
     command_handlers["sid_rewrite"] = [this](const json& p) { return handleSidRewrite(p); };
     command_handlers["sid_metrics"] = [this](const json& p) { return handleSidMetrics(p); };
     command_handlers["sid_set_diagram_expr"] = [this](const json& p) { return handleSidSetDiagramExpr(p); };
@@ -49,6 +118,7 @@ CommandRouter::CommandRouter()
     // command_handlers["sid_set_diagram_json"] = [this](const json& p) { return handleSidSetDiagramJson(p); };
     // command_handlers["sid_get_diagram_json"] = [this](const json& p) { return handleSidGetDiagramJson(p); };
     command_handlers["sid_rewrite_events"] = [this](const json& p) { return handleSidRewriteEvents(p); };
+    command_handlers["sid_rewrite_log"] = [this](const json& p) { return handleSidRewriteLog(p); };
     command_handlers["sid_run_rewrites"] = [this](const json& p) { return handleSidRunRewrites(p); };
     command_handlers["sid_wrapper_apply_motion"] = [this](const json& p) { return handleSidWrapperApplyMotion(p); };
     command_handlers["sid_wrapper_metrics"] = [this](const json& p) { return handleSidWrapperMetrics(p); };
@@ -63,11 +133,96 @@ CommandRouter::CommandRouter()
     command_handlers["analyze_fields"] = [this](const json& p) { return handleAnalyzeFields(p); };
 }
 
-CommandRouter::~CommandRouter() = default;
+CommandRouter::~CommandRouter() {
+    if (warmup_thread_.joinable()) {
+        warmup_thread_.join();
+    }
+}
+
+dase::AnalysisRouter& CommandRouter::analysisRouter() {
+    std::call_once(analysis_router_once_, [this] {
+        analysis_router_ = std::make_unique<dase::AnalysisRouter>(engine_manager.get());
+    });
+    return *analysis_router_;
+}
+
+bool CommandRouter::isWarmupTarget(const std::string& name) {
+    return name == "phase4b" || name == "fftw" || name == "analysis";
+}
+
+void CommandRouter::warmup(const std::vector<std::string>& targets) {
+    for (const std::string& target : targets) {
+        if (!isWarmupTarget(target)) {
+            throw std::invalid_argument("Unknown warmup target '" + target +
+                                        "' (expected phase4b, fftw or analysis)");
+        }
+    }
+    if (targets.empty() || warmup_thread_.joinable()) {
+        return;
+    }
+    // Every step is idempotent and thread-safe, so commands arriving
+    // meanwhile simply wait for (or repeat nothing of) the same work
+    warmup_thread_ = std::thread([this, targets] {
+        for (const std::string& target : targets) {
+            try {
+                if (target == "phase4b") {
+                    EngineManager::ensureEngineLibrary();
+                } else if (target == "fftw") {
+#ifdef USE_FFTW3
+                    dase::FFTPlanRegistry::initialize();
+#endif
+                } else if (target == "analysis") {
+                    analysisRouter().checkToolAvailability();
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "[WARNING] warmup of " << target << " failed: " << e.what() << std::endl;
+            }
+        }
+    });
+}
+
+namespace {
+
+// Points `target` at `value` for one execute() call, restoring the enclosing
+// call's value afterwards; a null `value` leaves the target alone
+template <typename Pointer>
+struct SegmentScope {
+    Pointer& target;
+    Pointer previous;
+    bool active;
+    SegmentScope(Pointer& t, Pointer value) : target(t), previous(t), active(value != nullptr) {
+        if (active) target = value;
+    }
+    ~SegmentScope() {
+        if (active) target = previous;
+    }
+};
+
+} // namespace
+
+bool CommandRouter::readsRequestSegments(const std::string& command) {
+    return command == "set_igsoa_state" || command == "set_satp_state";
+}
 
-json CommandRouter::execute(const json& command) {
+json CommandRouter::execute(const json& command, dase::protocol::Segments* segments,
+                            const dase::protocol::Segments* request_segments) {
+    DASE_TRACE_ZONE("cli.execute");
     auto start_time = std::chrono::high_resolution_clock::now();
 
+    // Handlers emit segment references only for the duration of this call
+    // (restoring the enclosing batch's target afterwards).  Calls without a
+    // target leave the member alone, so job commands from server sessions
+    // may run concurrently with another session's command.
+    SegmentScope<dase::protocol::Segments*> segment_scope(response_segments_, segments);
+    SegmentScope<const dase::protocol::Segments*> request_scope(request_segments_, request_segments);
+
+    // Set once the command is known to the router (execute histogram key)
+    std::string dispatched;
+    const auto elapsedNs = [&start_time]() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - start_time).count());
+    };
+
     try {
         // Extract command name
         if (!command.contains("command")) {
@@ -84,9 +239,35 @@ json CommandRouter::execute(const json& command) {
         if (it == command_handlers.end()) {
             return createErrorResponse(cmd_name, "Unknown command: " + cmd_name, "UNKNOWN_COMMAND");
         }
+        dispatched = cmd_name;
+
+        // Hold the lock of every engine the command names, so it never
+        // overlaps a running job's chunk on that engine.  Job commands take
+        // none (job_wait would otherwise block the job it waits for), nor
+        // does cancel_mission (it must reach the mission holding the lock)
+        // or read_snapshot (it reads published frames, never the engine).
+        std::vector<std::string> locked_ids;
+        if (cmd_name.compare(0, 4, "job_") != 0 && cmd_name != "submit_mission" && cmd_name != "cancel_mission" &&
+            cmd_name != "read_snapshot") {
+            if (params.contains("engine_id") && params["engine_id"].is_string()) {
+                locked_ids.push_back(params["engine_id"].get<std::string>());
+            }
+            if (params.contains("engine_ids") && params["engine_ids"].is_array()) {
+                for (const auto& id : params["engine_ids"]) {
+                    if (id.is_string()) locked_ids.push_back(id.get<std::string>());
+                }
+            }
+            std::sort(locked_ids.begin(), locked_ids.end());
+            locked_ids.erase(std::unique(locked_ids.begin(), locked_ids.end()), locked_ids.end());
+        }
+        std::vector<std::unique_lock<std::mutex>> engine_locks;
+        for (const auto& id : locked_ids) {
+            engine_locks.push_back(job_manager_->lockEngine(id));
+        }
 
         // Execute command
         json result = it->second(params);
+        engine_locks.clear();
 
         // Calculate execution time
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -95,10 +276,14 @@ json CommandRouter::execute(const json& command) {
 
         // Add execution time to result
         result["execution_time_ms"] = execution_time_ms;
+        stats_.recordExecute(cmd_name, elapsedNs(), result.value("status", "") != "error");
 
         return result;
 
     } catch (const std::exception& e) {
+        if (!dispatched.empty()) {
+            stats_.recordExecute(dispatched, elapsedNs(), false);
+        }
         return createErrorResponse("", std::string("Exception: ") + e.what(), "INTERNAL_ERROR");
     }
 }
@@ -107,12 +292,13 @@ json CommandRouter::handleGetCapabilities(const json& /*params*/) {
     json result = {
         {"version", "1.0.0"},
         {"status", "prototype"},
-        {"engines", json::array({"phase4b", "igsoa_complex", "igsoa_complex_2d", "igsoa_complex_3d", "satp_higgs_1d", "satp_higgs_2d", "satp_higgs_3d", "sid_ternary", "igsoa_gw", "fftw_cache_example"})},
+        {"engines", json::array({"phase4b", "igsoa_complex", "igsoa_complex_2d", "igsoa_complex_3d", "igsoa_ensemble_1d", "satp_higgs_1d", "satp_higgs_2d", "satp_higgs_3d", "sid_ternary", "igsoa_gw", "fftw_cache_example"})},
         {"cpu_features", {
-            {"avx2", true},
-            {"avx512", false},
-            {"fma", true}
+            {"avx2", CPUFeatures::hasAVX2()},
+            {"avx512", CPUFeatures::hasAVX512F()},
+            {"fma", CPUFeatures::hasFMA()}
         }},
+        {"engine_library", EngineManager::ensureEngineLibrary() ? EngineManager::getEngineLibraryPath() : std::string()},
         {"max_nodes", 1048576}
     };
 
@@ -216,6 +402,28 @@ json CommandRouter::handleDescribeEngine(const json& params) {
                     {"default", 12},
                     {"range", json::array({4, 32})},
                     {"description", "Sum-of-exponentials approximation rank"}
+                }},
+                {"amr_levels", {
+                    {"type", "integer"},
+                    {"default", 0},
+                    {"range", json::array({0, 4})},
+                    {"description", "Refined patch levels following the binary (0 = uniform grid)"}
+                }},
+                {"amr_ratio", {
+                    {"type", "integer"},
+                    {"default", 2},
+                    {"range", json::array({2, 4})},
+                    {"description", "Space and time refinement ratio between levels"}
+                }},
+                {"amr_margin", {
+                    {"type", "integer"},
+                    {"default", 4},
+                    {"description", "Parent cells between a source and its patch edge"}
+                }},
+                {"amr_regrid_margin", {
+                    {"type", "integer"},
+                    {"default", 2},
+                    {"description", "Regrid once a source is closer than this to a patch edge"}
                 }}
             }},
             {"equations", json::array({
@@ -311,6 +519,53 @@ json CommandRouter::handleDescribeEngine(const json& params) {
         return createSuccessResponse("describe_engine", description, 0);
     }
 
+    if (engine_name == "igsoa_ensemble_1d") {
+        json description = {
+            {"engine", "igsoa_ensemble_1d"},
+            {"display_name", "IGSOA Ensemble 1D"},
+            {"description", "Replicas of one 1D IGSOA lattice stepped together (per-replica state, kappa and gamma)"},
+            {"version", "1.0.0"},
+            {"parameters", {
+                {"num_nodes", {
+                    {"type", "integer"},
+                    {"default", 1024},
+                    {"range", json::array({1, 1048576})},
+                    {"description", "Nodes per replica"}
+                }},
+                {"replicas", {
+                    {"type", "integer"},
+                    {"default", 1},
+                    {"range", json::array({1, 16777216})},
+                    {"description", "Number of replicas (num_nodes * replicas <= 16777216)"}
+                }},
+                {"R_c", {
+                    {"type", "float"},
+                    {"default", 1.0},
+                    {"range", json::array({0.1, 10.0})},
+                    {"description", "Causal radius shared by every replica"}
+                }},
+                {"kappa", {
+                    {"type", "float"},
+                    {"default", 1.0},
+                    {"description", "Initial field coupling strength of every replica"}
+                }},
+                {"gamma", {
+                    {"type", "float"},
+                    {"default", 0.1},
+                    {"description", "Initial damping coefficient of every replica"}
+                }},
+                {"dt", {
+                    {"type", "float"},
+                    {"default", 0.01},
+                    {"description", "Time step"}
+                }}
+            }},
+            {"commands", json::array({"run_mission", "get_metrics", "get_ensemble_state", "set_ensemble_state"})}
+        };
+
+        return createSuccessResponse("describe_engine", description, 0);
+    }
+
     if (engine_name == "sid_ternary") {
         json description = {
             {"engine", "sid_ternary"},
@@ -331,7 +586,7 @@ json CommandRouter::handleDescribeEngine(const json& params) {
                     {"description", "Total mass / conservation constant"}
                 }}
             }},
-            {"commands", json::array({"sid_step", "sid_collapse", "sid_rewrite", "sid_metrics", "sid_set_diagram_expr"})}
+            {"commands", json::array({"sid_step", "sid_collapse", "sid_batch", "sid_rewrite", "sid_metrics", "sid_set_diagram_expr"})}
         };
 
         return createSuccessResponse("describe_engine", description, 0);
@@ -339,10 +594,175 @@ json CommandRouter::handleDescribeEngine(const json& params) {
 
     // Unknown engine
     return createErrorResponse("describe_engine",
-                              "Unknown engine: " + engine_name + ". Available engines: igsoa_gw, igsoa_complex, igsoa_complex_2d, igsoa_complex_3d, phase4b, satp_higgs_1d, satp_higgs_2d, satp_higgs_3d, sid_ternary.",
+                              "Unknown engine: " + engine_name + ". Available engines: igsoa_gw, igsoa_complex, igsoa_complex_2d, igsoa_complex_3d, igsoa_ensemble_1d, phase4b, satp_higgs_1d, satp_higgs_2d, satp_higgs_3d, sid_ternary.",
                               "UNKNOWN_ENGINE");
 }
 
+namespace {
+
+json footprintJson(const dase::MemoryFootprint& bytes) {
+    return {
+        {"state_bytes", bytes.state},
+        {"caches_bytes", bytes.caches},
+        {"history_bytes", bytes.history},
+        {"scratch_bytes", bytes.scratch},
+        {"total_bytes", bytes.total()}
+    };
+}
+
+// Energy of the engine's last mission (get_metrics, run_benchmark)
+json energyJson(const EngineManager::EngineMetrics& metrics) {
+    return {
+        {"source", metrics.energy_source},
+        {"joules", metrics.energy_joules},
+        {"seconds", metrics.energy_seconds},
+        {"average_watts", metrics.energy_average_watts},
+        {"joules_per_step", metrics.energy_joules_per_step},
+        {"joules_per_node_update", metrics.energy_joules_per_node_update}
+    };
+}
+
+// "burn_in": {"steps": N, "factor": 2 | 4} of create_engine / run_mission
+// (igsoa_burn_in.h); false with `error` set if malformed
+bool parseBurnIn(const json& spec, dase::igsoa::IGSOABurnInOptions& out, std::string& error) {
+    if (!spec.is_object() || !spec.contains("steps") || !spec["steps"].is_number_integer() ||
+        spec["steps"].get<int64_t>() <= 0) {
+        error = "burn_in must be an object with a positive integer steps";
+        return false;
+    }
+    const json factor = spec.value("factor", json(2));
+    if (!factor.is_number_integer() || (factor.get<int>() != 2 && factor.get<int>() != 4)) {
+        error = "burn_in factor must be 2 or 4";
+        return false;
+    }
+    out.steps = spec["steps"].get<uint64_t>();
+    out.factor = factor.get<uint32_t>();
+    return true;
+}
+
+} // namespace
+
+json CommandRouter::handleSetMemoryBudget(const json& params) {
+    // Required: budget_mb (process-wide limit on engine memory; 0 = unlimited)
+    if (!params.contains("budget_mb")) {
+        return createErrorResponse("set_memory_budget", "Missing 'budget_mb' parameter", "MISSING_PARAMETER");
+    }
+    if (!params["budget_mb"].is_number() || params["budget_mb"].get<double>() < 0.0 ||
+        !std::isfinite(params["budget_mb"].get<double>())) {
+        return createErrorResponse("set_memory_budget", "budget_mb must be a non-negative number",
+                                   "INVALID_PARAMETER");
+    }
+    const double budget_mb = params["budget_mb"].get<double>();
+    engine_manager->setMemoryBudget(static_cast<uint64_t>(budget_mb * 1024.0 * 1024.0));
+    json result = {
+        {"budget_bytes", engine_manager->getMemoryBudget()},
+        {"admitted_bytes", engine_manager->getAdmittedBytes()}
+    };
+    return createSuccessResponse("set_memory_budget", result, 0);
+}
+
+json CommandRouter::handleSetThreadBudget(const json& params) {
+    // Optional: threads (cores shared by every engine's missions; 0 = the
+    // processor count).  Without it, only reports the budget.
+    if (params.contains("threads")) {
+        if (!params["threads"].is_number_integer() || params["threads"].get<int>() < 0) {
+            return createErrorResponse("set_thread_budget", "threads must be a non-negative integer",
+                                       "INVALID_PARAMETER");
+        }
+        engine_manager->setThreadBudget(params["threads"].get<int>());
+    }
+    return createSuccessResponse("set_thread_budget", engine_manager->threadBudgetStats(), 0);
+}
+
+json CommandRouter::handleSetThreadLimit(const json& params) {
+    // Required: engine_id, threads (most per mission; 0 = team width)
+    // Optional: cpus (CPU ids to pin mission teams to; [] = no pinning)
+    const std::string engine_id = params.value("engine_id", "");
+    if (engine_id.empty() || !params.contains("threads")) {
+        return createErrorResponse("set_thread_limit", "Missing 'engine_id' or 'threads' parameter",
+                                   "MISSING_PARAMETER");
+    }
+    if (!params["threads"].is_number_integer() || params["threads"].get<int>() < 0) {
+        return createErrorResponse("set_thread_limit", "threads must be a non-negative integer",
+                                   "INVALID_PARAMETER");
+    }
+    std::vector<int> cpus;
+    if (params.contains("cpus")) {
+        if (!params["cpus"].is_array()) {
+            return createErrorResponse("set_thread_limit", "cpus must be an array of CPU ids", "INVALID_PARAMETER");
+        }
+        for (const auto& cpu : params["cpus"]) {
+            if (!cpu.is_number_integer() || cpu.get<int>() < 0) {
+                return createErrorResponse("set_thread_limit", "cpus must be non-negative integers",
+                                           "INVALID_PARAMETER");
+            }
+            cpus.push_back(cpu.get<int>());
+        }
+    }
+    const int threads = params["threads"].get<int>();
+    if (!engine_manager->setThreadLimit(engine_id, threads, cpus)) {
+        return createErrorResponse("set_thread_limit", "Engine not found: " + engine_id, "ENGINE_NOT_FOUND");
+    }
+    json result = {
+        {"engine_id", engine_id},
+        {"threads", threads},
+        {"cpus", cpus},
+        {"budget", engine_manager->threadBudgetStats()}
+    };
+    return createSuccessResponse("set_thread_limit", result, 0);
+}
+
+json CommandRouter::handleGetMemoryUsage(const json& params) {
+    // Optional: engine_id (one engine; default every live engine)
+    std::vector<std::string> ids;
+    const bool single = params.contains("engine_id");
+    if (single) {
+        ids.push_back(params["engine_id"].get<std::string>());
+    } else {
+        for (const auto* engine : engine_manager->listEngines()) {
+            ids.push_back(engine->engine_id);
+        }
+    }
+
+    json engines = json::array();
+    dase::MemoryFootprint total;
+    for (const auto& id : ids) {
+        dase::MemoryFootprint bytes;
+        bool tracked = false;
+        bool found = false;
+        if (single) {
+            found = engine_manager->engineMemory(id, bytes, tracked);   // execute() holds its lock
+        } else {
+            auto lock = job_manager_->lockEngine(id);
+            found = engine_manager->engineMemory(id, bytes, tracked);
+        }
+        if (!found) {
+            if (single) {
+                return createErrorResponse("get_memory_usage", "Engine not found: " + id, "ENGINE_NOT_FOUND");
+            }
+            continue;   // Destroyed since it was listed
+        }
+        const auto* instance = engine_manager->getEngineConst(id);
+        json entry = footprintJson(bytes);
+        entry["engine_id"] = id;
+        entry["engine_type"] = instance ? instance->engine_type : "";
+        entry["admitted_bytes"] = instance ? instance->admitted_bytes : 0;
+        entry["tracked"] = tracked;
+        engines.push_back(entry);
+        total += bytes;
+    }
+
+    json result = {
+        {"engines", engines},
+        {"total", footprintJson(total)},
+        {"admitted_bytes", engine_manager->getAdmittedBytes()},
+        {"budget_bytes", engine_manager->getMemoryBudget()},
+        {"pool", engine_manager->enginePoolStats()},
+        {"extraction_pool", engine_manager->bufferPool().stats()}
+    };
+    return createSuccessResponse("get_memory_usage", result, 0);
+}
+
 json CommandRouter::handleListEngines(const json& /*params*/) {
     auto engine_list = engine_manager->listEngines();
 
@@ -372,6 +792,14 @@ json CommandRouter::handleListEngines(const json& /*params*/) {
                 {"gamma", engine->gamma},
                 {"dt", engine->dt}
             };
+        } else if (engine->engine_type == "igsoa_ensemble_1d") {
+            engine_json["config"] = {
+                {"replicas", engine->num_replicas},
+                {"R_c", engine->R_c},
+                {"kappa", engine->kappa},
+                {"gamma", engine->gamma},
+                {"dt", engine->dt}
+            };
         } else if (engine->engine_type == "sid_ternary") {
             engine_json["config"] = {
                 {"R_c", engine->R_c}
@@ -417,6 +845,162 @@ json CommandRouter::handleCreateEngine(const json& params) {
     int N_z = params.value("N_z", params.value("depth", params.value("grid_nz", 0)));
     int sid_role = params.value("role", 2);
 
+    // NUMA placement / thread pinning (phase4b and igsoa_complex engines)
+    NumaOptions numa;
+    numa.first_touch = params.value("numa_first_touch", false);
+    numa.interleave = params.value("numa_interleave", false);
+    const std::string thread_affinity = params.value("thread_affinity", "none");
+    if (!NumaPlacement::parseThreadAffinity(thread_affinity, numa.thread_affinity)) {
+        return createErrorResponse("create_engine",
+                                   "Invalid thread_affinity. Must be none, compact or spread.",
+                                   "INVALID_PARAMETER");
+    }
+    if (!NumaPlacement::parseHugePages(params.value("huge_pages", "none"), numa.huge_pages)) {
+        return createErrorResponse("create_engine",
+                                   "Invalid huge_pages. Must be none or transparent.",
+                                   "INVALID_PARAMETER");
+    }
+
+    // Compute device (igsoa_complex_3d and satp_higgs_3d can run on a GPU)
+    ComputeDevice device = ComputeDevice::CPU;
+    if (!GpuDevice::parse(params.value("device", "cpu"), device)) {
+        return createErrorResponse("create_engine",
+                                   "Invalid device. Must be cpu or gpu.",
+                                   "INVALID_PARAMETER");
+    }
+    if (device == ComputeDevice::GPU) {
+        if (engine_type != "igsoa_complex_3d" && engine_type != "satp_higgs_3d") {
+            return createErrorResponse("create_engine",
+                                       "device=gpu is supported by igsoa_complex_3d and satp_higgs_3d only.",
+                                       "INVALID_PARAMETER");
+        }
+        if (!GpuDevice::isAvailable()) {
+            return createErrorResponse("create_engine",
+                                       GpuDevice::isCompiled()
+                                           ? "No GPU device found."
+                                           : "This build has no GPU backend (configure with ENABLE_CUDA or ENABLE_HIP).",
+                                       "GPU_UNAVAILABLE");
+        }
+    }
+
+    // Activity-mask sparse evolution (igsoa_complex_2d / igsoa_complex_3d)
+    const double sparse_threshold = params.value("sparse_threshold", 0.0);
+    const int sparse_block = params.value("sparse_block", 8);
+    if (params.contains("sparse_threshold") || params.contains("sparse_block")) {
+        if (engine_type != "igsoa_complex_2d" && engine_type != "igsoa_complex_3d") {
+            return createErrorResponse("create_engine",
+                                       "sparse_threshold is supported by igsoa_complex_2d and igsoa_complex_3d only.",
+                                       "INVALID_PARAMETER");
+        }
+        if (!(sparse_threshold >= 0.0) || !std::isfinite(sparse_threshold) || sparse_block < 1) {
+            return createErrorResponse("create_engine",
+                                       "Invalid sparse settings. sparse_threshold must be non-negative and sparse_block positive.",
+                                       "INVALID_PARAMETER");
+        }
+    }
+
+    // Coupling law K(r, R_c) of the IGSOA lattice engines (igsoa_kernel_policy.h)
+    dase::igsoa::IGSOAKernelPolicy kernel_policy = dase::igsoa::IGSOAKernelPolicy::Exponential;
+    if (params.contains("coupling_kernel")) {
+        if (engine_type != "igsoa_complex" && engine_type != "igsoa_complex_2d" &&
+            engine_type != "igsoa_complex_3d") {
+            return createErrorResponse("create_engine",
+                                       "coupling_kernel is supported by igsoa_complex, igsoa_complex_2d and igsoa_complex_3d only.",
+                                       "INVALID_PARAMETER");
+        }
+        if (!params["coupling_kernel"].is_string() ||
+            !dase::igsoa::parseKernelPolicy(params["coupling_kernel"].get<std::string>(), kernel_policy)) {
+            return createErrorResponse("create_engine",
+                                       "Invalid coupling_kernel. Must be exponential, gaussian or wendland.",
+                                       "INVALID_PARAMETER");
+        }
+    }
+
+    // Coarse-to-fine burn-in of the first run_mission (igsoa_burn_in.h)
+    dase::igsoa::IGSOABurnInOptions burn_in;
+    if (params.contains("burn_in")) {
+        if (engine_type != "igsoa_complex_2d" && engine_type != "igsoa_complex_3d") {
+            return createErrorResponse("create_engine",
+                                       "burn_in is supported by igsoa_complex_2d and igsoa_complex_3d only.",
+                                       "INVALID_PARAMETER");
+        }
+        std::string error;
+        if (!parseBurnIn(params["burn_in"], burn_in, error)) {
+            return createErrorResponse("create_engine", error, "INVALID_PARAMETER");
+        }
+    }
+
+    // Kernel autotuning (igsoa_complex* / satp_higgs_*): true uses the
+    // tuning database's choice when it has one, "force" always re-times
+    bool autotune = false;
+    bool autotune_force = false;
+    if (params.contains("autotune") && !params["autotune"].is_null()) {
+        const json& value = params["autotune"];
+        if (value.is_boolean()) {
+            autotune = value.get<bool>();
+        } else if (value.is_string() && value.get<std::string>() == "force") {
+            autotune = true;
+            autotune_force = true;
+        } else {
+            return createErrorResponse("create_engine",
+                                       "Invalid autotune. Must be true, false or \"force\".",
+                                       "INVALID_PARAMETER");
+        }
+    }
+    const int autotune_steps = params.value("autotune_steps", 16);
+    if (autotune) {
+        if (engine_type.rfind("igsoa_complex", 0) != 0 && engine_type.rfind("satp_higgs", 0) != 0) {
+            return createErrorResponse("create_engine",
+                                       "autotune is supported by igsoa_complex* and satp_higgs_* engines only.",
+                                       "INVALID_PARAMETER");
+        }
+        if (device == ComputeDevice::GPU) {
+            return createErrorResponse("create_engine",
+                                       "autotune is not supported with device=gpu.",
+                                       "INVALID_PARAMETER");
+        }
+        if (autotune_steps < 2 || autotune_steps > 10000) {
+            return createErrorResponse("create_engine",
+                                       "Invalid autotune_steps. Must be in range [2, 10000].",
+                                       "INVALID_PARAMETER");
+        }
+    }
+
+    // Mesh refinement around the binary (igsoa_gw)
+    const int amr_levels = params.value("amr_levels", 0);
+    const int amr_ratio = params.value("amr_ratio", 2);
+    const int amr_margin = params.value("amr_margin", 4);
+    const int amr_regrid_margin = params.value("amr_regrid_margin", 2);
+    if (params.contains("amr_levels") || params.contains("amr_ratio") ||
+        params.contains("amr_margin") || params.contains("amr_regrid_margin")) {
+        if (engine_type != "igsoa_gw") {
+            return createErrorResponse("create_engine",
+                                       "amr_levels is supported by igsoa_gw only.",
+                                       "INVALID_PARAMETER");
+        }
+        if (amr_levels < 0 || amr_levels > 4 || amr_ratio < 2 || amr_ratio > 4 ||
+            amr_margin < 1 || amr_regrid_margin < 0 || amr_regrid_margin >= amr_margin) {
+            return createErrorResponse("create_engine",
+                                       "Invalid refinement. amr_levels must be in [0, 4], amr_ratio in [2, 4], "
+                                       "amr_margin positive and amr_regrid_margin in [0, amr_margin).",
+                                       "INVALID_PARAMETER");
+        }
+    }
+
+    // Replica count (igsoa_ensemble_1d)
+    const int replicas = params.value("replicas", 1);
+    if (params.contains("replicas") && engine_type != "igsoa_ensemble_1d") {
+        return createErrorResponse("create_engine",
+                                   "replicas is supported by igsoa_ensemble_1d only.",
+                                   "INVALID_PARAMETER");
+    }
+    if (engine_type == "igsoa_ensemble_1d" &&
+        (replicas < 1 || static_cast<int64_t>(num_nodes) * static_cast<int64_t>(replicas) > 16777216)) {
+        return createErrorResponse("create_engine",
+                                   "Invalid replicas. Must be positive with num_nodes * replicas <= 16777216.",
+                                   "INVALID_PARAMETER");
+    }
+
     if (engine_type == "sid_ssp") {
         if (params.contains("capacity") && !params["capacity"].is_null()) {
             R_c = params["capacity"].get<double>();
@@ -488,6 +1072,7 @@ json CommandRouter::handleCreateEngine(const json& params) {
     }
 
     // Create engine
+    json admission_error;
     std::string engine_id = engine_manager->createEngine(
         engine_type,
         num_nodes,
@@ -500,13 +1085,67 @@ json CommandRouter::handleCreateEngine(const json& params) {
         N_y,
         N_z,
         sid_role,
-        engine_id_hint
+        engine_id_hint,
+        numa,
+        replicas,
+        &admission_error
     );
 
+    if (engine_id.empty() && !admission_error.is_null()) {
+        json error = createErrorResponse("create_engine", "Engine would exceed the memory budget.",
+                                         "MEMORY_BUDGET_EXCEEDED");
+        error["details"] = admission_error;
+        return error;
+    }
     if (engine_id.empty()) {
         return createErrorResponse("create_engine", "Failed to create engine.", "ENGINE_CREATE_FAILED");
     }
 
+    if (device == ComputeDevice::GPU && !engine_manager->setComputeDevice(engine_id, device)) {
+        engine_manager->destroyEngine(engine_id);
+        return createErrorResponse("create_engine", "Failed to select the GPU device.", "GPU_UNAVAILABLE");
+    }
+
+    if (sparse_threshold > 0.0 &&
+        !engine_manager->setSparseEvolution(engine_id, sparse_threshold, static_cast<uint32_t>(sparse_block))) {
+        engine_manager->destroyEngine(engine_id);
+        return createErrorResponse("create_engine", "Failed to enable sparse evolution.", "ENGINE_CREATE_FAILED");
+    }
+
+    if (kernel_policy != dase::igsoa::IGSOAKernelPolicy::Exponential &&
+        !engine_manager->setKernelPolicy(engine_id, kernel_policy)) {
+        engine_manager->destroyEngine(engine_id);
+        return createErrorResponse("create_engine", "Failed to select the coupling kernel.", "ENGINE_CREATE_FAILED");
+    }
+
+    if (burn_in.steps > 0) {
+        std::string error;
+        if (!engine_manager->setPendingBurnIn(engine_id, burn_in, error)) {
+            engine_manager->destroyEngine(engine_id);
+            return createErrorResponse("create_engine", "Invalid burn_in: " + error, "ENGINE_CREATE_FAILED");
+        }
+    }
+
+    json refinement_info;
+    if (amr_levels > 0) {
+        std::string error;
+        if (!engine_manager->setGWRefinement(engine_id, amr_levels, amr_ratio, amr_margin, amr_regrid_margin,
+                                             refinement_info, error)) {
+            engine_manager->destroyEngine(engine_id);
+            return createErrorResponse("create_engine", "Failed to enable mesh refinement: " + error,
+                                       "ENGINE_CREATE_FAILED");
+        }
+    }
+
+    json autotune_info;
+    if (autotune) {
+        std::string error;
+        if (!engine_manager->autotuneEngine(engine_id, autotune_force, autotune_steps, autotune_info, error)) {
+            engine_manager->destroyEngine(engine_id);
+            return createErrorResponse("create_engine", "Autotuning failed: " + error, "ENGINE_CREATE_FAILED");
+        }
+    }
+
     json result = {
         {"engine_id", engine_id},
         {"engine_type", engine_type},
@@ -514,8 +1153,26 @@ json CommandRouter::handleCreateEngine(const json& params) {
         {"R_c", R_c},
         {"kappa", kappa},
         {"gamma", gamma},
-        {"dt", dt}
+        {"dt", dt},
+        {"device", GpuDevice::name(device)}
     };
+    if (sparse_threshold > 0.0) {
+        result["sparse_threshold"] = sparse_threshold;
+        result["sparse_block"] = sparse_block;
+    }
+    if (params.contains("coupling_kernel")) {
+        result["coupling_kernel"] = dase::igsoa::kernelPolicyName(kernel_policy);
+    }
+    if (burn_in.steps > 0) {
+        result["burn_in"] = {{"steps", burn_in.steps}, {"factor", burn_in.factor}};
+    }
+
+    if (autotune) {
+        result["autotune"] = autotune_info;
+    }
+    if (amr_levels > 0) {
+        result["refinement"] = refinement_info;
+    }
 
     if (engine_type == "igsoa_complex_2d") {
         result["N_x"] = N_x;
@@ -524,6 +1181,17 @@ json CommandRouter::handleCreateEngine(const json& params) {
         result["N_x"] = N_x;
         result["N_y"] = N_y;
         result["N_z"] = N_z;
+    } else if (engine_type == "igsoa_ensemble_1d") {
+        result["replicas"] = replicas;
+    }
+
+    // Optional per-mission cycle / instruction / LLC-miss collection
+    if (params.value("hardware_counters", false)) {
+        result["hardware_counters"] = engine_manager->enableHardwareCounters(engine_id, true);
+    }
+    // Optional per-mission package energy (RAPL / EMI)
+    if (params.value("energy_meter", false)) {
+        result["energy_meter"] = engine_manager->enableEnergyMeter(engine_id, true);
     }
 
     return createSuccessResponse("create_engine", result, 0);
@@ -591,50 +1259,342 @@ json CommandRouter::handleGetNodeState(const json& params) {
     return createSuccessResponse("get_node_state", result, 0);
 }
 
-json CommandRouter::handleRunMission(const json& params) {
-    std::string engine_id = params.value("engine_id", "");
-    int num_steps = params.value("num_steps", 0);
-    int iterations_per_node = params.value("iterations_per_node", 30);
-    json motion_metadata = params.value("motion_metadata", json::object());
-    bool auto_apply_wrapper_motion = params.value("auto_apply_wrapper_motion", false);
-
-    bool success = engine_manager->runMission(engine_id, num_steps, iterations_per_node);
-
-    if (!success) {
-        return createErrorResponse("run_mission",
-                                   "Mission execution failed.",
-                                   "EXECUTION_FAILED");
+// Parse time_budget_ms into `control`; false with `error` set if invalid
+static bool missionControl(const json& params, MissionControl& control, std::string& error) {
+    control.time_budget_ms = params.value("time_budget_ms", 0.0);
+    if (!(control.time_budget_ms >= 0.0) || !std::isfinite(control.time_budget_ms)) {
+        error = "time_budget_ms must be a non-negative number";
+        return false;
     }
+    return true;
+}
 
-    // If sid_ssp: record commit event and optionally apply wrapper motion
-    if (auto* inst = engine_manager->getEngine(engine_id)) {
-        if (inst->engine_type == "sid_ssp") {
-            std::string rule_id = motion_metadata.value("rule_id", std::string("sid_ssp_commit"));
-            engine_manager->recordSidRewriteEvent(engine_id, rule_id, true, "sid_ssp_commit", motion_metadata);
-            if (auto_apply_wrapper_motion) {
-                EngineManager::SidWrapperState state{};
-                engine_manager->sidWrapperApplyMotion(engine_id, 0, state);
+// add_trigger "condition" / "action" names, in TriggerCondition / TriggerAction order
+static const char* const kTriggerConditions[] = {"above", "below", "crosses_up", "crosses_down", "settles"};
+static const char* const kTriggerActions[] = {"stop", "snapshot", "emit", "drive"};
+
+// steps_completed / stop_reason / wall time / throughput of a controlled
+// mission, and the triggers that fired during it
+static void addMissionProgress(EngineManager& engines, const std::string& engine_id,
+                               const MissionControl& control, json& result) {
+    result["steps_completed"] = control.steps_completed;
+    result["stop_reason"] = control.stop_reason;
+    result["wall_ms"] = control.wall_ms;
+    result["steps_per_second"] = control.wall_ms > 0.0 ? 1e3 * control.steps_completed / control.wall_ms : 0.0;
+    double simulated_time = 0.0;
+    if (engines.getSimulatedTime(engine_id, simulated_time)) {
+        result["simulated_time"] = simulated_time;
+    }
+    if (!engines.hasTriggers(engine_id) && control.trigger_events.empty()) {
+        return;
+    }
+    json events = json::array();
+    for (const MissionTriggerEvent& fired : control.trigger_events) {
+        json event = {
+            {"trigger_id", fired.event.trigger},
+            {"observable_id", fired.event.observable},
+            {"step", fired.event.step},
+            {"value", fired.event.value},
+            {"action", kTriggerActions[static_cast<int>(fired.event.action)]}
+        };
+        if (fired.event.action == dase::TriggerAction::Snapshot) {
+            event["path"] = fired.snapshot_path;
+            if (!fired.error.empty()) {
+                event["error"] = fired.error;
             }
         }
+        events.push_back(std::move(event));
     }
+    result["trigger_events"] = std::move(events);
+    result["trigger_events_dropped"] = control.trigger_events_dropped;
+    result["drive_gain"] = control.drive_gain;
+}
 
-    auto metrics = engine_manager->getMetrics(engine_id);
-    double total_ops = static_cast<double>(metrics.total_operations);
-    if (total_ops <= 0.0) {
-        // Fallback to legacy estimate only when real metrics are unavailable
-        total_ops = static_cast<double>(num_steps) * iterations_per_node * 1024;
+// columnar_output of run_mission and of run_sweep pipeline missions (see
+// columnar_writer.h): each requested table goes to its own file,
+// <path>.<table><extension>, filled straight from the drained arrays
+//
+//   probes          probe_id, step, point, field, value   (one row per value)
+//   observables     observable_id, kind, step, component, value
+//   rewrite_events  event_id, rule_id, applied, message, metadata (JSON), timestamp
+//   snapshot        step (steps_completed), node (flat lattice index), one
+//                   column per field
+//
+// "probes" / "observables" are true (all of the engine's) or id arrays and
+// are drained; rewrite events are paged from "events_cursor" (default 0)
+// without clearing the log; "snapshot" is true or a state selection
+// (fields, region, slice, stride, dtype) of the engine at the mission end.
+struct ColumnarOutput {
+    std::string path;
+    dase::columnar::Format format = dase::columnar::Format::Arrow;
+    bool all_probes = false;
+    std::vector<int> probes;
+    bool all_observables = false;
+    std::vector<int> observables;
+    bool rewrite_events = false;
+    uint64_t events_cursor = 0;
+    json snapshot;                   // null: no snapshot
+    size_t max_rows = dase::columnar::ColumnarWriter::kDefaultMaxRows;
+};
+
+// "probes": true / [ids]; false with `error` set for another value
+static bool parseColumnarIds(const json& spec, const char* key, bool& all, std::vector<int>& ids,
+                             std::string& error) {
+    all = false;
+    ids.clear();
+    if (!spec.contains(key) || spec[key].is_null() || spec[key] == false) {
+        return true;
+    }
+    if (spec[key] == true) {
+        all = true;
+        return true;
+    }
+    if (spec[key].is_array()) {
+        for (const auto& id : spec[key]) {
+            if (!id.is_number_integer()) {
+                error = std::string("columnar_output.") + key + " must hold integer ids";
+                return false;
+            }
+            ids.push_back(id.get<int>());
+        }
+        return true;
+    }
+    error = std::string("columnar_output.") + key + " must be true or an array of ids";
+    return false;
+}
+
+static bool parseColumnarOutput(const json& spec, ColumnarOutput& out, std::string& error) {
+    if (!spec.is_object() || !spec.contains("path") || !spec["path"].is_string() ||
+        spec["path"].get<std::string>().empty()) {
+        error = "columnar_output needs a 'path' prefix";
+        return false;
+    }
+    out.path = spec["path"].get<std::string>();
+    if (!dase::columnar::parseFormat(spec.value("format", std::string("arrow")), out.format)) {
+        error = "columnar_output.format must be \"arrow\" or \"parquet\"";
+        return false;
+    }
+    if (!parseColumnarIds(spec, "probes", out.all_probes, out.probes, error) ||
+        !parseColumnarIds(spec, "observables", out.all_observables, out.observables, error)) {
+        return false;
+    }
+    out.rewrite_events = spec.value("rewrite_events", false);
+    out.events_cursor = spec.value("events_cursor", uint64_t(0));
+    if (spec.contains("snapshot") && spec["snapshot"] != false && !spec["snapshot"].is_null()) {
+        out.snapshot = spec["snapshot"].is_object() ? spec["snapshot"] : json::object();
+    }
+    const int64_t max_rows = spec.value("max_rows_per_batch", static_cast<int64_t>(out.max_rows));
+    if (max_rows <= 0) {
+        error = "columnar_output.max_rows_per_batch must be positive";
+        return false;
+    }
+    out.max_rows = static_cast<size_t>(max_rows);
+    if (!out.all_probes && out.probes.empty() && !out.all_observables && out.observables.empty() &&
+        !out.rewrite_events && out.snapshot.is_null()) {
+        error = "columnar_output selects no table (probes, observables, rewrite_events, snapshot)";
+        return false;
+    }
+    return true;
+}
+
+static bool writeColumnarTable(const ColumnarOutput& output, const std::string& table,
+                               const dase::columnar::ColumnBatch& batch,
+                               const std::vector<std::pair<std::string, std::string>>& metadata,
+                               json& files, std::string& error) {
+    const std::string path = output.path + "." + table + dase::columnar::formatExtension(output.format);
+    std::unique_ptr<dase::columnar::ColumnarWriter> writer = dase::columnar::ColumnarWriter::create(output.format);
+    writer->setMaxRows(output.max_rows);
+    if (!writer->open(path, batch.schema(), metadata, error) || !writer->write(batch, error) ||
+        !writer->close(error)) {
+        return false;
+    }
+    files.push_back({{"table", table}, {"path", path}, {"rows", writer->rowsWritten()},
+                     {"bytes", writer->bytesWritten()}});
+    return true;
+}
+
+// Defined with the observable helpers below
+static bool writeColumnarOutput(EngineManager& engines, const std::string& engine_id,
+                                const ColumnarOutput& output, int64_t step, json& report, std::string& error);
+
+json CommandRouter::handleRunMission(const json& params) {
+    // Required: engine_id, num_steps (optional with time_budget_ms: run
+    //           until the budget is spent)
+    // Optional: iterations_per_node, time_budget_ms (wall-clock limit),
+    //           cancellable (stoppable by cancel_mission), motion_metadata,
+    //           auto_apply_wrapper_motion, columnar_output (probes,
+    //           observables, rewrite events and a state snapshot written as
+    //           Arrow / Parquet after the mission; see ColumnarOutput),
+    //           burn_in ({"steps", "factor"}: the first steps of num_steps run
+    //           on a coarser lattice, igsoa_burn_in.h; a create_engine
+    //           burn_in applies to the first mission)
+    // An engine with triggers (add_trigger) reports progress as a
+    // controlled mission does, plus the trigger events
+    std::string engine_id = params.value("engine_id", "");
+    int num_steps = params.value("num_steps", 0);
+    int iterations_per_node = params.value("iterations_per_node", 30);
+    json motion_metadata = params.value("motion_metadata", json::object());
+    bool auto_apply_wrapper_motion = params.value("auto_apply_wrapper_motion", false);
+
+    MissionControl control;
+    std::string control_error;
+    if (!missionControl(params, control, control_error)) {
+        return createErrorResponse("run_mission", control_error, "INVALID_PARAMETER");
+    }
+    ColumnarOutput columnar;
+    const bool write_columnar = params.contains("columnar_output");
+    if (write_columnar) {
+        if (!parseColumnarOutput(params["columnar_output"], columnar, control_error)) {
+            return createErrorResponse("run_mission", control_error, "INVALID_PARAMETER");
+        }
+    }
+    const bool controlled = control.time_budget_ms > 0.0 || params.value("cancellable", false) ||
+                            engine_manager->hasTriggers(engine_id);
+    if (!params.contains("num_steps") && control.time_budget_ms > 0.0) {
+        num_steps = std::numeric_limits<int>::max();
+    }
+
+    dase::igsoa::IGSOABurnInOptions burn_in;
+    bool burn = false;
+    if (params.contains("burn_in")) {
+        std::string error;
+        if (!parseBurnIn(params["burn_in"], burn_in, error)) {
+            return createErrorResponse("run_mission", error, "INVALID_PARAMETER");
+        }
+        burn = true;
+    } else {
+        burn = engine_manager->takePendingBurnIn(engine_id, burn_in);
+    }
+    int burned = 0;
+    if (burn) {
+        burn_in.steps = std::min<uint64_t>(burn_in.steps, static_cast<uint64_t>(std::max(num_steps, 0)));
+        std::string error;
+        if (burn_in.steps > 0 && !engine_manager->runBurnIn(engine_id, burn_in, 0, error)) {
+            return createErrorResponse("run_mission", "Burn-in failed: " + error, "INVALID_PARAMETER");
+        }
+        burned = static_cast<int>(burn_in.steps);
+    }
+
+    bool success = (burned > 0 && burned == num_steps) ||
+                   engine_manager->runMission(engine_id, num_steps - burned, iterations_per_node, burned,
+                                              controlled ? &control : nullptr);
+    if (controlled) {
+        num_steps = burned + control.steps_completed;
+    }
+
+    if (!success) {
+        return createErrorResponse("run_mission",
+                                   "Mission execution failed.",
+                                   "EXECUTION_FAILED");
+    }
+
+    // If sid_ssp: record commit event and optionally apply wrapper motion
+    if (auto* inst = engine_manager->getEngine(engine_id)) {
+        if (inst->engine_type == "sid_ssp") {
+            std::string rule_id = motion_metadata.value("rule_id", std::string("sid_ssp_commit"));
+            engine_manager->recordSidRewriteEvent(engine_id, rule_id, true, "sid_ssp_commit", motion_metadata);
+            if (auto_apply_wrapper_motion) {
+                EngineManager::SidWrapperState state{};
+                engine_manager->sidWrapperApplyMotion(engine_id, 0, state);
+            }
+        }
+    }
+
+    auto metrics = engine_manager->getMetrics(engine_id);
+    double total_ops = static_cast<double>(metrics.total_operations);
+    if (total_ops <= 0.0) {
+        // Fallback to legacy estimate only when real metrics are unavailable
+        total_ops = static_cast<double>(num_steps) * iterations_per_node * 1024;
     }
 
     json result = {
         {"steps_completed", num_steps},
         {"total_operations", total_ops}
     };
+    if (controlled) {
+        addMissionProgress(*engine_manager, engine_id, control, result);
+        result["steps_completed"] = num_steps;
+    }
+    if (burned > 0) {
+        result["burn_in"] = {{"steps", burned}, {"factor", burn_in.factor}};
+    }
+    if (write_columnar) {
+        json report;
+        std::string error;
+        if (!writeColumnarOutput(*engine_manager, engine_id, columnar, num_steps, report, error)) {
+            return createErrorResponse("run_mission", error, "OUTPUT_FAILED");
+        }
+        result["columnar_output"] = std::move(report);
+    }
 
     return createSuccessResponse("run_mission", result, 0);
 }
 
+json CommandRouter::handleCancelMission(const json& params) {
+    // Required: engine_id (engine running a time_budget_ms / cancellable
+    //           run_mission or run_steps, or a job chunk)
+    const std::string engine_id = params.value("engine_id", "");
+    if (!engine_manager->cancelMission(engine_id)) {
+        return createErrorResponse("cancel_mission", "No cancellable mission running on " + engine_id,
+                                   "NOT_RUNNING");
+    }
+    return createSuccessResponse("cancel_mission", {{"engine_id", engine_id}, {"cancel_requested", true}}, 0);
+}
+
+json CommandRouter::handleRunEnsemble(const json& params) {
+    // Required: engine_ids (phase4b engines), num_steps
+    // Optional: iterations_per_node, input_signals / control_patterns
+    //           (one num_steps array per engine; default: run_mission's drive)
+    if (!params.contains("engine_ids") || !params["engine_ids"].is_array()) {
+        return createErrorResponse("run_ensemble",
+                                   "engine_ids must be an array of engine ids",
+                                   "INVALID_PARAMETER");
+    }
+
+    std::vector<std::string> engine_ids;
+    std::vector<std::vector<double>> input_signals;
+    std::vector<std::vector<double>> control_patterns;
+    try {
+        engine_ids = params["engine_ids"].get<std::vector<std::string>>();
+        if (params.contains("input_signals")) {
+            input_signals = params["input_signals"].get<std::vector<std::vector<double>>>();
+        }
+        if (params.contains("control_patterns")) {
+            control_patterns = params["control_patterns"].get<std::vector<std::vector<double>>>();
+        }
+    } catch (const json::exception&) {
+        return createErrorResponse("run_ensemble",
+                                   "engine_ids must be strings; signals must be arrays of number arrays",
+                                   "INVALID_PARAMETER");
+    }
+
+    int num_steps = params.value("num_steps", 0);
+    int iterations_per_node = params.value("iterations_per_node", 30);
+
+    std::string error;
+    if (!engine_manager->runEnsemble(engine_ids, num_steps, iterations_per_node,
+                                     input_signals, control_patterns, error)) {
+        return createErrorResponse("run_ensemble", error, "EXECUTION_FAILED");
+    }
+
+    double total_ops = 0.0;
+    for (const auto& id : engine_ids) {
+        total_ops += static_cast<double>(engine_manager->getMetrics(id).total_operations);
+    }
+
+    json result = {
+        {"engines", engine_ids.size()},
+        {"steps_completed", num_steps},
+        {"total_operations", total_ops}
+    };
+
+    return createSuccessResponse("run_ensemble", result, 0);
+}
+
 json CommandRouter::handleRunSteps(const json& params) {
     // Required: engine_id, num_steps
+    // Optional: iterations_per_node, alpha (sid_ternary), time_budget_ms,
+    //           cancellable (as for run_mission)
     std::string engine_id = params.value("engine_id", "");
     int num_steps = params.value("num_steps", 1);
     int iterations_per_node = params.value("iterations_per_node", 1);
@@ -650,17 +1610,37 @@ json CommandRouter::handleRunSteps(const json& params) {
     if (!inst) {
         return createErrorResponse("run_steps", "Engine not found: " + engine_id, "INVALID_ENGINE");
     }
+    MissionControl control;
+    std::string control_error;
+    if (!missionControl(params, control, control_error)) {
+        return createErrorResponse("run_steps", control_error, "INVALID_PARAMETER");
+    }
+    const bool controlled = control.time_budget_ms > 0.0 || params.value("cancellable", false) ||
+                            engine_manager->hasTriggers(engine_id);
 
     bool ok = false;
     if (inst->engine_type == "sid_ternary") {
-        for (int i = 0; i < num_steps; ++i) {
+        // Steps one at a time anyway; only the budget applies
+        const auto start = std::chrono::steady_clock::now();
+        const auto elapsedMs = [&start]() {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+        int done = 0;
+        for (; done < num_steps; ++done) {
+            if (controlled && done > 0 && control.time_budget_ms > 0.0 &&
+                elapsedMs() * (done + 1) / done > control.time_budget_ms) {
+                control.stop_reason = "time_budget";
+                break;
+            }
             ok = engine_manager->sidStep(engine_id, alpha);
             if (!ok) break;
         }
+        control.steps_completed = done;
+        control.wall_ms = elapsedMs();
     } else if (inst->engine_type == "sid_ssp") {
-        ok = engine_manager->runMission(engine_id, num_steps, 1);
+        ok = engine_manager->runMission(engine_id, num_steps, 1, 0, controlled ? &control : nullptr);
     } else {
-        ok = engine_manager->runMission(engine_id, num_steps, iterations_per_node);
+        ok = engine_manager->runMission(engine_id, num_steps, iterations_per_node, 0, controlled ? &control : nullptr);
     }
 
     if (!ok) {
@@ -672,8 +1652,8 @@ json CommandRouter::handleRunSteps(const json& params) {
 
     if (inst->engine_type == "sid_ssp") {
         // Count non-zero field entries as active nodes and total mass
-        std::vector<double> psi_real, psi_imag, field;
-        if (engine_manager->getAllNodeStates(engine_id, psi_real, psi_imag, field)) {
+        if (const auto* state = engine_manager->extractAllNodeStates(engine_id)) {
+            const std::vector<double>& field = state->fields[2];
             size_t active = 0;
             long double mass = 0.0;
             for (double v : field) {
@@ -713,8 +1693,10 @@ json CommandRouter::handleRunSteps(const json& params) {
         stability_metrics["active_nodes"] = static_cast<uint64_t>(active);
         stability_metrics["total_mass"] = total_mass;
     } else {
-        std::vector<double> psi_real, psi_imag, phi;
-        if (engine_manager->getAllNodeStates(engine_id, psi_real, psi_imag, phi)) {
+        if (const auto* state = engine_manager->extractAllNodeStates(engine_id)) {
+            const std::vector<double>& psi_real = state->fields[0];
+            const std::vector<double>& psi_imag = state->fields[1];
+            const std::vector<double>& phi = state->fields[2];
             long double sumsq = 0.0;
             bool used_complex = !psi_real.empty() || !psi_imag.empty();
             if (used_complex) {
@@ -746,6 +1728,9 @@ json CommandRouter::handleRunSteps(const json& params) {
         {"speedup_factor", metrics.speedup_factor},
         {"metrics", stability_metrics}
     };
+    if (controlled) {
+        addMissionProgress(*engine_manager, engine_id, control, result);
+    }
     return createSuccessResponse("run_steps", result, 0);
 }
 
@@ -754,22 +1739,61 @@ json CommandRouter::handleRunMissionWithSnapshots(const json& params) {
     int num_steps = params.value("num_steps", 0);
     int iterations_per_node = params.value("iterations_per_node", 30);
     int snapshot_interval = params.value("snapshot_interval", 1);
+    bool stream = params.value("stream", false);
+    std::string output_file = params.value("output_file", "");
 
     if (snapshot_interval <= 0) {
         return createErrorResponse("run_mission_with_snapshots",
                                    "snapshot_interval must be positive",
                                    "INVALID_PARAMETER");
     }
+    if (stream && !stream_sink_) {
+        return createErrorResponse("run_mission_with_snapshots",
+                                   "Streaming is not available on this interface",
+                                   "STREAM_UNAVAILABLE");
+    }
+
+    // Optional quantization / delta / compression of the snapshot arrays
+    // in binary frames and snapshot files (segment_codec.h)
+    dase::protocol::SegmentEncoding encoding;
+    const bool encode = params.contains("encoding");
+    const int key_interval = params.value("key_interval", 0);
+    if (encode) {
+        std::string error;
+        if (!dase::protocol::SegmentEncoding::parse(params["encoding"], encoding, error)) {
+            return createErrorResponse("run_mission_with_snapshots", error, "INVALID_PARAMETER");
+        }
+    }
+    if (key_interval < 0) {
+        return createErrorResponse("run_mission_with_snapshots",
+                                   "key_interval must be non-negative",
+                                   "INVALID_PARAMETER");
+    }
+    double max_error = 0.0;
 
+    // Streamed and file output keep one snapshot in memory, so only the
+    // accumulated array is capped
+    const bool accumulate = !stream && output_file.empty();
     int max_snapshots = (snapshot_interval > 0) ? (num_steps / snapshot_interval) : 0;
     const int MAX_ALLOWED_SNAPSHOTS = 10000;
-    if (max_snapshots > MAX_ALLOWED_SNAPSHOTS) {
+    if (accumulate && max_snapshots > MAX_ALLOWED_SNAPSHOTS) {
         return createErrorResponse("run_mission_with_snapshots",
                                    "Too many snapshots requested. Max: " + std::to_string(MAX_ALLOWED_SNAPSHOTS),
                                    "TOO_MANY_SNAPSHOTS");
     }
 
+    // Selected fields, reused across snapshots; fields moved into segments
+    // are leased again from the pool they are recycled to
+    dase::RequestArena arena(engine_manager->bufferPool());
+    std::vector<std::vector<double>>& selected = arena.fields();
+
+    // Selection is resolved against the lattice on the first capture
+    dase::SnapshotSelection selection;
+    bool selection_ready = false;
+    dase::SnapshotFileWriter writer;
+
     json snapshots = json::array();
+    size_t snapshot_count = 0;
 
     for (int step = snapshot_interval; step <= num_steps; step += snapshot_interval) {
         int steps_to_run = snapshot_interval;
@@ -781,11 +1805,46 @@ json CommandRouter::handleRunMissionWithSnapshots(const json& params) {
                                        "EXECUTION_FAILED");
         }
 
-        json snapshot;
-        snapshot["timestep"] = step;
+        if (!selection_ready) {
+            const auto* instance = engine_manager->getEngineConst(engine_id);
+            const bool satp = instance && instance->engine_type.rfind("satp_higgs", 0) == 0;
+            size_t dims[3] = {0, 1, 1};
+            std::string error;
+            if (!engine_manager->getStateDims(engine_id, dims)) {
+                return createErrorResponse("run_mission_with_snapshots",
+                                           "Failed to get state at step " + std::to_string(step),
+                                           "STATE_CAPTURE_FAILED");
+            }
+            if (!selection.parse(params, dims,
+                                 satp ? dase::SnapshotSelection::satpFields() : dase::SnapshotSelection::igsoaFields(),
+                                 error)) {
+                return createErrorResponse("run_mission_with_snapshots", error, "INVALID_PARAMETER");
+            }
+            if (selection.float32() && encoding.quantization == dase::protocol::Quantization::F64) {
+                encoding.quantization = dase::protocol::Quantization::F32;   // Lossless for rounded values
+            }
+            if (!output_file.empty()) {
+                json header = selection.describe();
+                header["engine_id"] = engine_id;
+                header["engine_type"] = instance ? instance->engine_type : "";
+                header["snapshot_interval"] = snapshot_interval;
+                if (encode && !encoding.isIdentity()) {
+                    header["encoding"] = encoding.describe();
+                    header["key_interval"] = key_interval;
+                    writer.setEncoding(encoding, static_cast<size_t>(key_interval));
+                }
+                if (!writer.open(output_file, header, error, selection.float32())) {
+                    return createErrorResponse("run_mission_with_snapshots", error, "OUTPUT_FAILED");
+                }
+            }
+            selection_ready = true;
+        }
 
-        std::vector<double> psi_real, psi_imag, phi;
-        bool success_state = engine_manager->getAllNodeStates(engine_id, psi_real, psi_imag, phi);
+        bool success_state = false;
+        {
+            DASE_TRACE_ZONE("cli.snapshot_capture");
+            success_state = engine_manager->getSelectedState(engine_id, selection, selected);
+        }
 
         if (!success_state) {
             return createErrorResponse("run_mission_with_snapshots",
@@ -793,23 +1852,201 @@ json CommandRouter::handleRunMissionWithSnapshots(const json& params) {
                                        "STATE_CAPTURE_FAILED");
         }
 
-        snapshot["num_nodes"] = psi_real.size();
-        snapshot["psi_real"] = psi_real;
-        snapshot["psi_imag"] = psi_imag;
-        snapshot["phi"] = phi;
+        std::vector<const std::vector<double>*> record;
+        double snapshot_error = 0.0;
+        for (auto& values : selected) {
+            if (!output_file.empty()) {
+                values.resize(selection.count(), 0.0);   // Fixed-size file records
+            }
+            snapshot_error = std::max(snapshot_error,
+                                      dase::protocol::quantize(encoding.quantization, values.data(), values.size()));
+            record.push_back(&values);
+        }
+        max_error = std::max(max_error, snapshot_error);
+        const bool key = snapshot_count == 0 || (key_interval > 0 && snapshot_count % key_interval == 0);
+        snapshot_count++;
+
+        // Segment reference tagged with the encoding its frame should use
+        auto snapshotArray = [&](size_t k, dase::protocol::Segments* target) {
+            json array = stateArray(selected[k], target,
+                                    selection.float32() || encoding.quantization != dase::protocol::Quantization::F64);
+            if (encode && array.is_object()) {
+                array["encoding"] = encoding.describe();
+                array["channel"] = k;
+                if (key) {
+                    array["key"] = true;
+                }
+            }
+            return array;
+        };
+
+        if (!output_file.empty()) {
+            if (!writer.append(step, record)) {
+                return createErrorResponse("run_mission_with_snapshots",
+                                           "Failed to write snapshot at step " + std::to_string(step),
+                                           "OUTPUT_FAILED");
+            }
+            continue;
+        }
+
+        json snapshot;
+        snapshot["timestep"] = step;
+        snapshot["num_nodes"] = selection.count();
+        if (encode) {
+            snapshot["max_error"] = snapshot_error;
+        }
+
+        if (stream) {
+            dase::protocol::Segments segments;
+            dase::protocol::Segments* target = response_segments_ ? &segments : nullptr;
+            for (size_t k = 0; k < selected.size(); ++k) {
+                snapshot[selection.fields()[k]] = snapshotArray(k, target);
+            }
+            json message = {
+                {"status", "streaming"},
+                {"command", "run_mission_with_snapshots"},
+                {"snapshot", snapshot}
+            };
+            stream_sink_(message, segments);
+            recycleSegments(segments);
+            continue;
+        }
 
+        for (size_t k = 0; k < selected.size(); ++k) {
+            snapshot[selection.fields()[k]] = snapshotArray(k, response_segments_);
+        }
         snapshots.push_back(snapshot);
     }
 
     json result = {
         {"steps_completed", num_steps},
-        {"snapshot_count", snapshots.size()},
-        {"snapshots", snapshots}
+        {"snapshot_count", snapshot_count}
     };
+    if (accumulate) {
+        result["snapshots"] = snapshots;
+    } else if (stream) {
+        result["streamed"] = true;
+    } else {
+        if (!writer.close()) {
+            return createErrorResponse("run_mission_with_snapshots", "Failed to close snapshot file", "OUTPUT_FAILED");
+        }
+        result["output_file"] = output_file;
+        result["bytes_written"] = writer.bytesWritten();
+    }
+    if (selection_ready) {
+        result["selection"] = selection.describe();
+    }
+    if (encode) {
+        result["encoding"] = encoding.describe();
+        result["max_error"] = max_error;
+    }
 
     return createSuccessResponse("run_mission_with_snapshots", result, 0);
 }
 
+json CommandRouter::handleRunMissionAdaptive(const json& params) {
+    // Required: engine_id, duration (simulated time)
+    // Optional: dt_min, dt_max, dt_initial, tolerance (IGSOA error control),
+    //           cfl, cfl_check_steps (SATP stability control), drive,
+    //           snapshot_time_interval (simulated time between snapshots),
+    //           snapshot selectors (fields, region, slice, stride, dtype)
+    std::string engine_id = params.value("engine_id", "");
+    double duration = params.value("duration", 0.0);
+    double snapshot_time_interval = params.value("snapshot_time_interval", 0.0);
+    bool drive = params.value("drive", true);
+
+    dase::AdaptiveStepOptions options;
+    options.dt_min = params.value("dt_min", options.dt_min);
+    options.dt_max = params.value("dt_max", options.dt_max);
+    options.dt_initial = params.value("dt_initial", options.dt_initial);
+    options.tolerance = params.value("tolerance", options.tolerance);
+    options.cfl = params.value("cfl", options.cfl);
+    options.cfl_check_steps = params.value("cfl_check_steps", options.cfl_check_steps);
+
+    if (!(duration > 0.0)) {
+        return createErrorResponse("run_mission_adaptive", "duration must be positive", "INVALID_PARAMETER");
+    }
+    if (snapshot_time_interval < 0.0) {
+        return createErrorResponse("run_mission_adaptive",
+                                   "snapshot_time_interval must be non-negative",
+                                   "INVALID_PARAMETER");
+    }
+    const int MAX_ALLOWED_SNAPSHOTS = 10000;
+    if (snapshot_time_interval > 0.0 && duration / snapshot_time_interval > MAX_ALLOWED_SNAPSHOTS) {
+        return createErrorResponse("run_mission_adaptive",
+                                   "Too many snapshots requested. Max: " + std::to_string(MAX_ALLOWED_SNAPSHOTS),
+                                   "TOO_MANY_SNAPSHOTS");
+    }
+
+    // Snapshots split the run into segments that each end on a snapshot
+    // time; the controller lands each segment exactly on its end
+    const double segment = snapshot_time_interval > 0.0 ? snapshot_time_interval : duration;
+    dase::AdaptiveStepStats stats;
+    json snapshots = json::array();
+
+    // Snapshot selectors (fields, region, slice, stride, dtype)
+    dase::SnapshotSelection selection;
+    dase::RequestArena arena(engine_manager->bufferPool());
+    std::vector<std::vector<double>>& selected = arena.fields();
+    if (snapshot_time_interval > 0.0) {
+        const auto* instance = engine_manager->getEngineConst(engine_id);
+        const bool satp = instance && instance->engine_type.rfind("satp_higgs", 0) == 0;
+        size_t dims[3] = {0, 1, 1};
+        std::string error;
+        if (engine_manager->getStateDims(engine_id, dims) &&
+            !selection.parse(params, dims,
+                             satp ? dase::SnapshotSelection::satpFields() : dase::SnapshotSelection::igsoaFields(),
+                             error)) {
+            return createErrorResponse("run_mission_adaptive", error, "INVALID_PARAMETER");
+        }
+    }
+
+    for (double elapsed = 0.0; elapsed < duration * (1.0 - 1.0e-12); ) {
+        const double length = std::min(segment, duration - elapsed);
+        dase::AdaptiveStepStats segment_stats;
+        std::string error;
+        if (!engine_manager->runMissionAdaptive(engine_id, length, options, drive, segment_stats, error)) {
+            return createErrorResponse("run_mission_adaptive", error, "EXECUTION_FAILED");
+        }
+        stats.merge(segment_stats);
+        elapsed += length;
+
+        if (snapshot_time_interval > 0.0) {
+            if (!engine_manager->getSelectedState(engine_id, selection, selected)) {
+                return createErrorResponse("run_mission_adaptive",
+                                           "Failed to get state at time " + std::to_string(elapsed),
+                                           "STATE_CAPTURE_FAILED");
+            }
+            json snapshot = {
+                {"time", elapsed},
+                {"steps", stats.accepted_steps}
+            };
+            for (size_t k = 0; k < selected.size(); ++k) {
+                snapshot[selection.fields()[k]] = stateArray(selected[k], response_segments_, selection.float32());
+            }
+            snapshots.push_back(snapshot);
+        }
+    }
+
+    json result = {
+        {"simulated_time", stats.simulated_time},
+        {"accepted_steps", stats.accepted_steps},
+        {"rejected_steps", stats.rejected_steps},
+        {"forced_steps", stats.forced_steps},
+        {"dt_min_used", stats.dt_min_used},
+        {"dt_max_used", stats.dt_max_used},
+        {"max_error", stats.max_error}
+    };
+    if (snapshot_time_interval > 0.0) {
+        result["snapshot_count"] = snapshots.size();
+        result["snapshots"] = snapshots;
+        if (!selection.isDefault()) {
+            result["selection"] = selection.describe();
+        }
+    }
+    return createSuccessResponse("run_mission_adaptive", result, 0);
+}
+
 json CommandRouter::handleRunBenchmark(const json& params) {
     std::string engine_id = params.value("engine_id", "");
     int num_steps = params.value("num_steps", 1);
@@ -821,6 +2058,10 @@ json CommandRouter::handleRunBenchmark(const json& params) {
     if (num_steps <= 0 || iterations_per_node <= 0) {
         return createErrorResponse("run_benchmark", "Invalid num_steps or iterations_per_node", "INVALID_PARAMETER");
     }
+    // energy: measure this run (otherwise as set at create_engine)
+    if (params.value("energy", false)) {
+        engine_manager->enableEnergyMeter(engine_id, true);
+    }
 
     bool ok = engine_manager->runMission(engine_id, num_steps, iterations_per_node);
     if (!ok) {
@@ -836,226 +2077,2566 @@ json CommandRouter::handleRunBenchmark(const json& params) {
         {"ops_per_sec", metrics.ops_per_sec},
         {"total_operations", metrics.total_operations}
     };
+    if (metrics.energy_valid) {
+        result["energy"] = energyJson(metrics);
+    } else if (params.value("energy", false)) {
+        result["energy"] = nullptr;   // No readable counters
+    }
 
     return createSuccessResponse("run_benchmark", result, 0);
 }
 
-json CommandRouter::handleGetMetrics(const json& params) {
-    std::string engine_id = params.value("engine_id", "");
+json CommandRouter::handleRunScalingStudy(const json& params) {
+    // Required: engine_type
+    // Optional: mode ("strong" | "weak"), threads (OMP team sizes, default
+    //           powers of two up to the core count), sizes (create_engine
+    //           size params per point, e.g. {"N_x": 128, "N_y": 128}; for
+    //           weak scaling the size per thread, N_x / num_nodes scaled by
+    //           the team size), thread_affinity (layouts to sweep), num_steps,
+    //           iterations_per_node, repeats, hardware_counters (phase4b),
+    //           energy (package joules per node step, RAPL / EMI),
+    //           R_c / kappa / gamma / dt / alpha
+    //
+    // Every point runs on a freshly created engine, so first-touch
+    // placement and pinning follow that point's team.  Wall time is the
+    // median of `repeats` missions after one warm-up mission.  Bandwidth is
+    // the engine state read and written once per step (a lower bound), or
+    // the DRAM bandwidth measured by hardware counters when available.
+    static const std::vector<std::string> kScalableEngines = {
+        "phase4b", "igsoa_complex", "igsoa_complex_2d", "igsoa_complex_3d",
+        "satp_higgs_1d", "satp_higgs_2d", "satp_higgs_3d", "igsoa_gw"
+    };
+    const std::string engine_type = params.value("engine_type", "");
+    if (std::find(kScalableEngines.begin(), kScalableEngines.end(), engine_type) == kScalableEngines.end()) {
+        return createErrorResponse("run_scaling_study",
+                                   "engine_type must be one of phase4b, igsoa_complex, igsoa_complex_2d, "
+                                   "igsoa_complex_3d, satp_higgs_1d, satp_higgs_2d, satp_higgs_3d, igsoa_gw",
+                                   "INVALID_PARAMETER");
+    }
+    const std::string mode = params.value("mode", "strong");
+    if (mode != "strong" && mode != "weak") {
+        return createErrorResponse("run_scaling_study", "mode must be strong or weak", "INVALID_PARAMETER");
+    }
 
-    if (engine_id.empty()) {
-        return createErrorResponse("get_metrics",
-                                   "Missing 'engine_id' parameter",
-                                   "MISSING_PARAMETER");
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+    const int num_procs = omp_get_num_procs();
+#else
+    const int max_threads = 1;
+    const int num_procs = 1;
+#endif
+
+    std::vector<int> threads;
+    std::vector<std::string> affinities;
+    std::vector<json> sizes;
+    try {
+        if (params.contains("threads")) {
+            threads = params["threads"].get<std::vector<int>>();
+        } else {
+            for (int t = 1; t < num_procs; t *= 2) threads.push_back(t);
+            threads.push_back(num_procs);
+        }
+        affinities = params.contains("thread_affinity")
+            ? params["thread_affinity"].get<std::vector<std::string>>()
+            : std::vector<std::string>{"none"};
+        if (params.contains("sizes")) {
+            sizes = params["sizes"].get<std::vector<json>>();
+        }
+    } catch (const json::exception&) {
+        return createErrorResponse("run_scaling_study",
+                                   "threads must be integers, thread_affinity strings, sizes objects",
+                                   "INVALID_PARAMETER");
+    }
+    if (sizes.empty()) {
+        const bool is_3d = engine_type == "igsoa_complex_3d" || engine_type == "satp_higgs_3d" ||
+                           engine_type == "igsoa_gw";
+        const bool is_2d = engine_type == "igsoa_complex_2d" || engine_type == "satp_higgs_2d";
+        sizes.push_back(is_3d ? json{{"N_x", 32}, {"N_y", 32}, {"N_z", 32}}
+                      : is_2d ? json{{"N_x", 256}, {"N_y", 256}}
+                              : json{{"num_nodes", 65536}});
+    }
+    std::sort(threads.begin(), threads.end());
+    threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+    if (threads.empty() || threads.front() <= 0) {
+        return createErrorResponse("run_scaling_study", "threads must be positive", "INVALID_PARAMETER");
+    }
+    std::vector<ThreadAffinity> layouts;
+    for (const auto& name : affinities) {
+        ThreadAffinity affinity;
+        if (!NumaPlacement::parseThreadAffinity(name, affinity)) {
+            return createErrorResponse("run_scaling_study",
+                                       "Invalid thread_affinity. Must be none, compact or spread.",
+                                       "INVALID_PARAMETER");
+        }
+        layouts.push_back(affinity);
     }
 
-    // Get engine instance to retrieve actual engine type
-    auto* instance = engine_manager->getEngine(engine_id);
-    if (!instance) {
-        return createErrorResponse("get_metrics",
-                                   "Engine not found: " + engine_id + ".",
-                                   "ENGINE_NOT_FOUND");
+    const int num_steps = params.value("num_steps", 100);
+    const int iterations_per_node = params.value("iterations_per_node", 30);
+    const int repeats = std::max(1, params.value("repeats", 3));
+    const bool hardware_counters = params.value("hardware_counters", false);
+    const bool energy = params.value("energy", false);
+    if (num_steps <= 0 || iterations_per_node <= 0) {
+        return createErrorResponse("run_scaling_study", "Invalid num_steps or iterations_per_node", "INVALID_PARAMETER");
+    }
+    const double R_c = params.value("R_c", 1.0);
+    const double kappa = params.value("kappa", 1.0);
+    const double gamma = params.value("gamma", 0.1);
+    const double dt = params.value("dt", 0.01);
+    const double alpha = params.value("alpha", 0.1);
+
+    json points = json::array();
+    auto run_point = [&](const json& size, int team, ThreadAffinity affinity, json& point) -> bool {
+        const int scale = (mode == "weak") ? team : 1;
+        int num_nodes = size.value("num_nodes", 0);
+        int N_x = size.value("N_x", 0);
+        const int N_y = size.value("N_y", 0);
+        const int N_z = size.value("N_z", 0);
+        if (N_x > 0) N_x *= scale; else num_nodes *= scale;
+        if (N_x > 0) {
+            const int64_t lattice = static_cast<int64_t>(N_x) * std::max(1, N_y) * std::max(1, N_z);
+            if (lattice > 1048576) {
+                return false;   // create_engine's lattice limit
+            }
+            num_nodes = static_cast<int>(lattice);
+        }
+        if (num_nodes <= 0) {
+            return false;
+        }
+
+#ifdef _OPENMP
+        omp_set_num_threads(team);
+#endif
+        NumaOptions numa;
+        numa.first_touch = true;
+        numa.thread_affinity = affinity;
+        const std::string id = engine_manager->createEngine(engine_type, num_nodes, R_c, kappa, gamma, dt, alpha,
+                                                            N_x, N_y, N_z, 2, "", numa);
+        if (id.empty()) {
+            return false;
+        }
+        const bool counters = hardware_counters && engine_manager->enableHardwareCounters(id, true);
+        const bool metered = energy && engine_manager->enableEnergyMeter(id, true);
+
+        // Energy: the median of the repeats' joules, like the wall time
+        std::vector<double> wall_s;
+        std::vector<double> joules;
+        bool ok = engine_manager->runMission(id, std::min(num_steps, 10), iterations_per_node);
+        for (int r = 0; ok && r < repeats; ++r) {
+            const auto t0 = std::chrono::steady_clock::now();
+            ok = engine_manager->runMission(id, num_steps, iterations_per_node);
+            wall_s.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+            if (metered) {
+                const auto run_metrics = engine_manager->getMetrics(id);
+                if (run_metrics.energy_valid) {
+                    joules.push_back(run_metrics.energy_joules);
+                }
+            }
+        }
+        const uint64_t state_bytes = engine_manager->stateBytes(id);
+        const auto metrics = engine_manager->getMetrics(id);
+        engine_manager->destroyEngine(id);
+        if (!ok) {
+            return false;
+        }
+
+        std::sort(wall_s.begin(), wall_s.end());
+        const double median = wall_s[wall_s.size() / 2];
+        const double node_steps = static_cast<double>(num_nodes) * num_steps;
+        point = {
+            {"threads", team},
+            {"thread_affinity", NumaPlacement::threadAffinityName(affinity)},
+            {"num_nodes", num_nodes},
+            {"wall_s", median},
+            {"wall_s_min", wall_s.front()},
+            {"wall_s_max", wall_s.back()},
+            {"ns_per_node_step", median * 1.0e9 / node_steps},
+            {"state_bytes", state_bytes}
+        };
+        if (N_x > 0) {
+            point["N_x"] = N_x;
+            point["N_y"] = N_y;
+            if (N_z > 0) point["N_z"] = N_z;
+        }
+        if (metrics.model_bytes_per_step > 0.0) {
+            point["model_gflops"] = metrics.model_flops_per_step * num_steps / median / 1.0e9;
+            point["arithmetic_intensity"] = metrics.arithmetic_intensity;
+        }
+        if (counters && metrics.hw_counters_valid) {
+            point["bandwidth_gbps"] = metrics.hw_dram_bandwidth_gbps;
+            point["bandwidth_source"] = "hw_counters";
+        } else if (metrics.model_bytes_per_step > 0.0) {
+            point["bandwidth_gbps"] = metrics.model_bytes_per_step * num_steps / median / 1.0e9;
+            point["bandwidth_source"] = "kernel_model";
+        } else if (state_bytes > 0) {
+            point["bandwidth_gbps"] = 2.0 * static_cast<double>(state_bytes) * num_steps / median / 1.0e9;
+            point["bandwidth_source"] = "state_model";
+        } else {
+            point["bandwidth_gbps"] = nullptr;
+            point["bandwidth_source"] = "unavailable";
+        }
+        if (energy) {
+            if (joules.size() == wall_s.size()) {
+                std::sort(joules.begin(), joules.end());
+                const double energy_j = joules[joules.size() / 2];
+                point["energy_j"] = energy_j;
+                point["average_watts"] = energy_j / median;
+                point["joules_per_node_step"] = energy_j / node_steps;
+            } else {
+                point["energy_j"] = nullptr;   // No readable counters
+            }
+        }
+        return true;
+    };
+
+    std::string failure;
+    for (size_t s = 0; s < sizes.size() && failure.empty(); ++s) {
+        for (ThreadAffinity affinity : layouts) {
+            double base_wall = 0.0;
+            int base_threads = 0;
+            for (int team : threads) {
+                json point;
+                if (!run_point(sizes[s], team, affinity, point)) {
+                    failure = "Scaling point failed: " + sizes[s].dump() + " at " + std::to_string(team) + " threads";
+                    break;
+                }
+                const double wall = point["wall_s"].get<double>();
+                if (base_threads == 0) {
+                    base_wall = wall;
+                    base_threads = team;
+                }
+                // Strong: same problem, speedup = T(base) / T(n).  Weak: problem
+                // grows with the team, so the scaled speedup also counts the
+                // extra work.  Efficiency is speedup per added thread either way.
+                const double ratio = static_cast<double>(team) / base_threads;
+                const double speedup = (mode == "weak") ? ratio * base_wall / wall : base_wall / wall;
+                point["size_index"] = s;
+                point["speedup"] = speedup;
+                point["parallel_efficiency"] = speedup / ratio;
+                points.push_back(std::move(point));
+            }
+            if (!failure.empty()) break;
+        }
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+#endif
+    if (!failure.empty()) {
+        return createErrorResponse("run_scaling_study", failure, "EXECUTION_FAILED");
+    }
+
+    json result = {
+        {"engine_type", engine_type},
+        {"mode", mode},
+        {"num_steps", num_steps},
+        {"iterations_per_node", iterations_per_node},
+        {"repeats", repeats},
+        {"num_procs", num_procs},
+        {"sizes", sizes},
+        {"points", points}
+    };
+    return createSuccessResponse("run_scaling_study", result, 0);
+}
+
+json CommandRouter::handleRunPipeline(const json& params) {
+    // Required: engine_ids, links [{from, field, to, input: source|drive,
+    //           channel: input|control, reduce: mean|rms|max_abs, scale, offset}], num_steps
+    // Optional: exchange_interval (default 1), iterations_per_node (default 30)
+    if (!params.contains("engine_ids") || !params["engine_ids"].is_array() || params["engine_ids"].empty()) {
+        return createErrorResponse("run_pipeline", "Missing 'engine_ids' array", "MISSING_PARAMETER");
+    }
+    if (!params.contains("links") || !params["links"].is_array()) {
+        return createErrorResponse("run_pipeline", "Missing 'links' array", "MISSING_PARAMETER");
+    }
+    if (!params.contains("num_steps")) {
+        return createErrorResponse("run_pipeline", "Missing 'num_steps' parameter", "MISSING_PARAMETER");
+    }
+
+    std::vector<std::string> engine_ids;
+    for (const auto& id : params["engine_ids"]) {
+        if (!id.is_string()) {
+            return createErrorResponse("run_pipeline", "engine_ids must be strings", "INVALID_PARAMETER");
+        }
+        engine_ids.push_back(id.get<std::string>());
+    }
+
+    std::vector<dase::PipelineLink> links;
+    for (const auto& spec : params["links"]) {
+        if (!spec.is_object() || !spec.contains("from") || !spec.contains("to") || !spec.contains("field")) {
+            return createErrorResponse("run_pipeline", "Each link needs from, field and to", "INVALID_PARAMETER");
+        }
+        dase::PipelineLink link;
+        link.from = spec["from"].get<std::string>();
+        link.to = spec["to"].get<std::string>();
+        link.field = spec["field"].get<std::string>();
+        const std::string channel = spec.value("channel", "input");
+        if (!dase::parsePipelineInput(spec.value("input", "source"), link.input) ||
+            !dase::parsePipelineReduce(spec.value("reduce", "mean"), link.reduce) ||
+            (channel != "input" && channel != "control")) {
+            return createErrorResponse("run_pipeline",
+                                       "Invalid link. input must be source or drive, channel input or control, "
+                                       "reduce mean, rms or max_abs.",
+                                       "INVALID_PARAMETER");
+        }
+        link.control_channel = (channel == "control");
+        link.scale = spec.value("scale", 1.0);
+        link.offset = spec.value("offset", 0.0);
+        if (!std::isfinite(link.scale) || !std::isfinite(link.offset)) {
+            return createErrorResponse("run_pipeline", "Link scale and offset must be finite", "INVALID_PARAMETER");
+        }
+        links.push_back(std::move(link));
+    }
+
+    const int num_steps = params["num_steps"].get<int>();
+    const int exchange_interval = params.value("exchange_interval", 1);
+    const int iterations_per_node = params.value("iterations_per_node", 30);
+    if (num_steps <= 0 || exchange_interval <= 0) {
+        return createErrorResponse("run_pipeline", "num_steps and exchange_interval must be positive",
+                                   "INVALID_PARAMETER");
+    }
+
+    json info;
+    std::string error;
+    if (!engine_manager->runPipeline(engine_ids, links, num_steps, exchange_interval, iterations_per_node,
+                                     info, error)) {
+        return createErrorResponse("run_pipeline", error, "EXECUTION_FAILED");
+    }
+    return createSuccessResponse("run_pipeline", info, 0);
+}
+
+// run_sweep summary table: one row per run in grid order, the numeric
+// values of the run's last observables step as extra columns (NaN when the
+// run has none)
+static bool writeSweepColumnar(const ColumnarOutput& output, const std::vector<json>& runs, json& files,
+                               std::string& error) {
+    using dase::columnar::Type;
+    static const char* const kParams[] = {"R_c", "kappa", "gamma", "dt", "alpha"};
+    std::vector<const json*> observables(runs.size(), nullptr);
+    std::set<std::string> names;
+    for (size_t r = 0; r < runs.size(); ++r) {
+        for (const auto& step : runs[r].value("steps", json::array())) {
+            if (step.value("command", "") == "observables") observables[r] = &step;
+        }
+        if (!observables[r]) continue;
+        for (auto it = observables[r]->begin(); it != observables[r]->end(); ++it) {
+            if (it.value().is_number()) names.insert(it.key());
+        }
+    }
+
+    std::vector<dase::columnar::ColumnSchema> schema = {
+        {"index", Type::Int32}, {"size_index", Type::Int32}, {"num_nodes", Type::Int64}};
+    for (const char* name : kParams) schema.push_back({name, Type::Float64});
+    schema.push_back({"threads", Type::Int32});
+    schema.push_back({"wall_s", Type::Float64});
+    schema.push_back({"status", Type::Utf8});
+    schema.push_back({"error", Type::Utf8});
+    schema.push_back({"steps_completed", Type::Int64});
+    const size_t first_observable = schema.size();
+    for (const std::string& name : names) schema.push_back({name, Type::Float64});
+
+    dase::columnar::ColumnBatch batch(schema);
+    for (size_t r = 0; r < runs.size(); ++r) {
+        const json& run = runs[r];
+        int64_t steps_completed = 0;
+        for (const auto& step : run.value("steps", json::array())) {
+            steps_completed = step.value("steps_completed", steps_completed);
+        }
+        batch.appendInt32(0, run.value("index", 0));
+        batch.appendInt32(1, run.value("size_index", 0));
+        batch.appendInt64(2, run.value("num_nodes", int64_t(0)));
+        for (size_t k = 0; k < 5; ++k) batch.appendFloat64(3 + k, run.value(kParams[k], 0.0));
+        batch.appendInt32(8, run.value("threads", 0));
+        batch.appendFloat64(9, run.value("wall_s", 0.0));
+        batch.appendString(10, run.value("status", std::string()));
+        batch.appendString(11, run.value("error", std::string()));
+        batch.appendInt64(12, steps_completed);
+        size_t c = first_observable;
+        for (const std::string& name : names) {
+            const bool present = observables[r] && observables[r]->contains(name) && (*observables[r])[name].is_number();
+            batch.appendFloat64(c++, present ? (*observables[r])[name].get<double>()
+                                             : std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+    return writeColumnarTable(output, "runs", batch, {}, files, error);
+}
+
+json CommandRouter::handleRunSweep(const json& params) {
+    // Required: engine_type
+    // Optional: base create params (num_nodes or N_x / N_y / N_z, R_c,
+    //           kappa, gamma, dt, alpha), grid (arrays per parameter: R_c,
+    //           kappa, gamma, dt, alpha, and sizes as size objects; runs are
+    //           their Cartesian product), pipeline (per-run steps in mission
+    //           file form, {"command": ..., "params": {...}} without
+    //           engine_id: set_igsoa_state, set_satp_state, run_mission,
+    //           get_metrics, get_center_of_mass, observables), threads_per_run
+    //           (fixed budget) or nodes_per_thread (budget from the lattice
+    //           size, default 32768), max_concurrent, stream,
+    //           columnar_output ({path, format}: one row per run, with the
+    //           last observables step as columns, in <path>.runs.arrows /
+    //           .parquet)
+    //
+    // A pipeline run_mission may carry columnar_output as run_mission does;
+    // "{run}" in its path is replaced by the run index (required with more
+    // than one run).
+    // Every run creates its own engine, runs the pipeline with its budget as
+    // OMP team and destroys the engine; runs share the cores through a
+    // work-stealing pool (see sweep_scheduler.h).  With stream, each run's
+    // result is sent as a streaming message as soon as the run ends; the
+    // final response lists every run in grid order either way.
+    static const std::vector<std::string> kSweepEngines = {
+        "phase4b", "igsoa_complex", "igsoa_complex_2d", "igsoa_complex_3d",
+        "satp_higgs_1d", "satp_higgs_2d", "satp_higgs_3d", "igsoa_gw"
+    };
+    static const std::vector<std::string> kPipelineCommands = {
+        "set_igsoa_state", "set_satp_state", "run_mission", "get_metrics", "get_center_of_mass", "observables"
+    };
+    const size_t kMaxRuns = 4096;
+
+    const std::string engine_type = params.value("engine_type", "");
+    if (std::find(kSweepEngines.begin(), kSweepEngines.end(), engine_type) == kSweepEngines.end()) {
+        return createErrorResponse("run_sweep",
+                                   "engine_type must be one of phase4b, igsoa_complex, igsoa_complex_2d, "
+                                   "igsoa_complex_3d, satp_higgs_1d, satp_higgs_2d, satp_higgs_3d, igsoa_gw",
+                                   "INVALID_PARAMETER");
+    }
+    const bool stream = params.value("stream", false);
+    if (stream && !stream_sink_) {
+        return createErrorResponse("run_sweep", "Streaming is not available on this interface", "STREAM_UNAVAILABLE");
+    }
+
+    // Grid axes; a missing axis holds the base value only
+    static const char* const kAxes[] = {"R_c", "kappa", "gamma", "dt", "alpha"};
+    const double kDefaults[] = {1.0, 1.0, 0.1, 0.01, 0.1};
+    std::vector<std::vector<double>> axes(5);
+    std::vector<json> sizes;
+    json pipeline;
+    try {
+        const json grid = params.value("grid", json::object());
+        for (size_t a = 0; a < axes.size(); ++a) {
+            axes[a] = grid.contains(kAxes[a]) ? grid[kAxes[a]].get<std::vector<double>>()
+                                              : std::vector<double>{params.value(kAxes[a], kDefaults[a])};
+        }
+        if (grid.contains("sizes")) {
+            sizes = grid["sizes"].get<std::vector<json>>();
+        }
+        pipeline = params.value("pipeline", json::array({
+            {{"command", "run_mission"}, {"params", {{"num_steps", 100}}}},
+            {{"command", "observables"}}
+        }));
+    } catch (const json::exception&) {
+        return createErrorResponse("run_sweep",
+                                   "grid axes must be number arrays, grid.sizes an array of objects",
+                                   "INVALID_PARAMETER");
+    }
+    if (sizes.empty()) {
+        json size = json::object();
+        for (const char* key : {"num_nodes", "N_x", "N_y", "N_z"}) {
+            if (params.contains(key)) size[key] = params[key];
+        }
+        if (size.empty()) {
+            size["num_nodes"] = 1024;
+        }
+        sizes.push_back(size);
+    }
+    if (!pipeline.is_array() || pipeline.empty()) {
+        return createErrorResponse("run_sweep", "pipeline must be a non-empty array of steps", "INVALID_PARAMETER");
+    }
+    for (const auto& step : pipeline) {
+        const std::string name = step.is_object() ? step.value("command", "") : "";
+        if (std::find(kPipelineCommands.begin(), kPipelineCommands.end(), name) == kPipelineCommands.end()) {
+            return createErrorResponse("run_sweep",
+                                       "pipeline steps must be set_igsoa_state, set_satp_state, run_mission, "
+                                       "get_metrics, get_center_of_mass or observables",
+                                       "INVALID_PARAMETER");
+        }
+    }
+
+    size_t num_runs = sizes.size();
+    for (const auto& axis : axes) {
+        if (axis.empty()) {
+            return createErrorResponse("run_sweep", "grid axes must not be empty", "INVALID_PARAMETER");
+        }
+        num_runs *= axis.size();
+    }
+    if (num_runs > kMaxRuns) {
+        return createErrorResponse("run_sweep", "Too many runs. Max: " + std::to_string(kMaxRuns),
+                                   "INVALID_PARAMETER");
+    }
+
+    ColumnarOutput sweep_columnar;
+    const bool write_columnar = params.contains("columnar_output");
+    if (write_columnar) {
+        const json& spec = params["columnar_output"];
+        if (!spec.is_object() || !spec.contains("path") || !spec["path"].is_string() ||
+            !dase::columnar::parseFormat(spec.value("format", std::string("arrow")), sweep_columnar.format)) {
+            return createErrorResponse("run_sweep",
+                                       "columnar_output needs a 'path' and format \"arrow\" or \"parquet\"",
+                                       "INVALID_PARAMETER");
+        }
+        sweep_columnar.path = spec["path"].get<std::string>();
+    }
+    for (const auto& step : pipeline) {
+        const json step_params = step.value("params", json::object());
+        if (!step_params.contains("columnar_output")) continue;
+        ColumnarOutput output;
+        std::string error;
+        if (!parseColumnarOutput(step_params["columnar_output"], output, error)) {
+            return createErrorResponse("run_sweep", error, "INVALID_PARAMETER");
+        }
+        if (num_runs > 1 && output.path.find("{run}") == std::string::npos) {
+            return createErrorResponse("run_sweep", "A pipeline columnar_output path needs {run} with several runs",
+                                       "INVALID_PARAMETER");
+        }
+    }
+
+    // Resolve sizes up front so a bad one fails the sweep before any run
+    struct RunSize {
+        int num_nodes = 0;
+        int N_x = 0;
+        int N_y = 0;
+        int N_z = 0;
+    };
+    std::vector<RunSize> run_sizes;
+    for (const auto& size : sizes) {
+        RunSize rs;
+        rs.num_nodes = size.value("num_nodes", 0);
+        rs.N_x = size.value("N_x", 0);
+        rs.N_y = size.value("N_y", 0);
+        rs.N_z = size.value("N_z", 0);
+        if (rs.N_x > 0) {
+            const int64_t lattice = static_cast<int64_t>(rs.N_x) * std::max(1, rs.N_y) * std::max(1, rs.N_z);
+            if (lattice > 1048576) {
+                return createErrorResponse("run_sweep", "Lattice too large: " + size.dump(), "INVALID_PARAMETER");
+            }
+            rs.num_nodes = static_cast<int>(lattice);
+        }
+        if (rs.num_nodes <= 0) {
+            return createErrorResponse("run_sweep", "Invalid size: " + size.dump(), "INVALID_PARAMETER");
+        }
+        run_sizes.push_back(rs);
+    }
+
+    dase::SweepScheduler scheduler(params.value("max_threads", 0));
+    const int threads_per_run = params.value("threads_per_run", 0);
+    const uint64_t nodes_per_thread = params.value("nodes_per_thread", uint64_t(32768));
+    const size_t max_concurrent = params.value("max_concurrent", size_t(0));
+
+    // Runs in grid order: size outermost, then R_c, kappa, gamma, dt, alpha
+    std::vector<json> runs(num_runs);
+    std::vector<dase::SweepTask> tasks(num_runs);
+    std::mutex stream_mutex;
+
+    auto run_pipeline = [&](size_t run_index, const std::string& id, const std::string& type,
+                            json& steps) -> std::string {
+        int steps_done = 0;
+        for (const auto& step : pipeline) {
+            const std::string name = step.value("command", "");
+            const json step_params = step.value("params", json::object());
+            json out = json::object();
+            if (name == "set_igsoa_state" || name == "set_satp_state") {
+                const std::string profile_type = step_params.value("profile_type", "");
+                const json profile = step_params.value("params", json::object());
+                if (profile_type == "arrays") {
+                    json origins;
+                    std::string error;
+                    const auto& family = (name == "set_igsoa_state") ? dase::SnapshotSelection::igsoaFields()
+                                                                     : dase::SnapshotSelection::satpFields();
+                    if (!setStateFromArrays(id, profile, family, origins, error)) {
+                        return name + " failed: " + error;
+                    }
+                } else {
+                    const bool ok = (name == "set_igsoa_state") ? engine_manager->setIgsoaState(id, profile_type, profile)
+                                                                : engine_manager->setSatpState(id, profile_type, profile);
+                    if (!ok) {
+                        return name + " failed (profile " + profile_type + ")";
+                    }
+                }
+                out["profile_type"] = profile_type;
+            } else if (name == "run_mission") {
+                const int num_steps = step_params.value("num_steps", 0);
+                const int iterations_per_node = step_params.value("iterations_per_node", 30);
+                const auto t0 = std::chrono::steady_clock::now();
+                if (num_steps <= 0 || !engine_manager->runMission(id, num_steps, iterations_per_node, steps_done)) {
+                    return "run_mission failed at step " + std::to_string(steps_done);
+                }
+                steps_done += num_steps;
+                out["steps_completed"] = steps_done;
+                out["wall_s"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                if (step_params.contains("columnar_output")) {
+                    ColumnarOutput output;
+                    std::string error;
+                    parseColumnarOutput(step_params["columnar_output"], output, error);   // Checked up front
+                    const size_t at = output.path.find("{run}");
+                    if (at != std::string::npos) {
+                        output.path.replace(at, 5, std::to_string(run_index));
+                    }
+                    json report;
+                    if (!writeColumnarOutput(*engine_manager, id, output, steps_done, report, error)) {
+                        return "run_mission columnar_output failed: " + error;
+                    }
+                    out["columnar_output"] = std::move(report);
+                }
+            } else if (name == "get_metrics") {
+                const auto metrics = engine_manager->getMetrics(id);
+                out["ns_per_op"] = metrics.ns_per_op;
+                out["ops_per_sec"] = metrics.ops_per_sec;
+                out["total_operations"] = metrics.total_operations;
+                if (metrics.roofline_valid) {
+                    out["achieved_gbps"] = metrics.achieved_gbps;
+                    out["achieved_gflops"] = metrics.achieved_gflops;
+                }
+            } else if (name == "get_center_of_mass") {
+                double x = 0.0, y = 0.0, z = 0.0;
+                if (type == "igsoa_complex_2d" && engine_manager->computeCenterOfMass2D(id, x, y)) {
+                    out = {{"x_cm", x}, {"y_cm", y}};
+                } else if (type == "igsoa_complex_3d" && engine_manager->computeCenterOfMass3D(id, x, y, z)) {
+                    out = {{"x_cm", x}, {"y_cm", y}, {"z_cm", z}};
+                } else {
+                    return "get_center_of_mass needs an IGSOA 2D or 3D lattice";
+                }
+            } else if (name == "observables") {
+                // Lattice sums instead of full state arrays
+                const bool satp = type.compare(0, 10, "satp_higgs") == 0;
+                const auto* state = satp ? engine_manager->extractSatpState(id)
+                                         : engine_manager->extractAllNodeStates(id);
+                if (!state) {
+                    return "Failed to read state";
+                }
+                const std::vector<double>& a = state->fields[0];
+                const std::vector<double>& b = state->fields[1];
+                const std::vector<double>& c = state->fields[2];
+                const auto mean = [](const std::vector<double>& v) {
+                    return v.empty() ? 0.0 : std::accumulate(v.begin(), v.end(), 0.0) / v.size();
+                };
+                const auto rms = [](const std::vector<double>& v) {
+                    double s = 0.0;
+                    for (double x : v) s += x * x;
+                    return v.empty() ? 0.0 : std::sqrt(s / v.size());
+                };
+                if (satp) {
+                    out = {{"phi_mean", mean(a)}, {"phi_rms", rms(a)}, {"phi_dot_rms", rms(b)},
+                           {"h_mean", mean(c)}, {"h_rms", rms(c)}};
+                } else {
+                    double norm = 0.0;
+                    for (size_t i = 0; i < a.size() && i < b.size(); ++i) norm += a[i] * a[i] + b[i] * b[i];
+                    out = {{"psi_norm", norm}, {"phi_mean", mean(c)}, {"phi_rms", rms(c)}};
+                }
+                out["num_nodes"] = std::max(a.size(), c.size());
+            }
+            out["command"] = name;
+            steps.push_back(std::move(out));
+        }
+        return "";
+    };
+
+    size_t index = 0;
+    for (size_t s = 0; s < run_sizes.size(); ++s) {
+        for (double R_c : axes[0]) for (double kappa : axes[1]) for (double gamma : axes[2])
+        for (double dt : axes[3]) for (double alpha : axes[4]) {
+            const RunSize rs = run_sizes[s];
+            const size_t i = index++;
+            json& run = runs[i];
+            run = {{"index", i}, {"size_index", s}, {"num_nodes", rs.num_nodes},
+                   {"R_c", R_c}, {"kappa", kappa}, {"gamma", gamma}, {"dt", dt}, {"alpha", alpha}};
+            if (rs.N_x > 0) {
+                run["N_x"] = rs.N_x;
+                run["N_y"] = rs.N_y;
+                if (rs.N_z > 0) run["N_z"] = rs.N_z;
+            }
+            dase::SweepTask& task = tasks[i];
+            task.cost = static_cast<double>(rs.num_nodes);
+            task.threads = threads_per_run > 0 ? std::min(threads_per_run, scheduler.capacity())
+                                               : scheduler.threadBudget(static_cast<uint64_t>(rs.num_nodes),
+                                                                        nodes_per_thread);
+            task.body = [&, &run = run, i, rs, R_c, kappa, gamma, dt, alpha, threads = task.threads] {
+                const auto t0 = std::chrono::steady_clock::now();
+                NumaOptions numa;
+                numa.first_touch = true;
+                const std::string id = engine_manager->createEngine(engine_type, rs.num_nodes, R_c, kappa, gamma,
+                                                                    dt, alpha, rs.N_x, rs.N_y, rs.N_z, 2, "", numa);
+                std::string error = id.empty() ? "Engine creation failed" : "";
+                json steps = json::array();
+                if (!id.empty()) {
+                    error = run_pipeline(i, id, engine_type, steps);
+                    engine_manager->destroyEngine(id);
+                }
+                run["threads"] = threads;
+                run["steps"] = std::move(steps);
+                run["wall_s"] = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                run["status"] = error.empty() ? "success" : "error";
+                if (!error.empty()) {
+                    run["error"] = error;
+                }
+                if (stream) {
+                    json message = {
+                        {"status", "streaming"},
+                        {"command", "run_sweep"},
+                        {"run", run}
+                    };
+                    dase::protocol::Segments segments;
+                    std::lock_guard<std::mutex> lock(stream_mutex);
+                    stream_sink_(message, segments);
+                }
+            };
+        }
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    scheduler.run(std::move(tasks), max_concurrent);
+    const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    size_t failed = 0;
+    for (const auto& run : runs) {
+        if (run.value("status", "") != "success") failed++;
+    }
+    const auto stats = scheduler.lastStats();
+    json result = {
+        {"engine_type", engine_type},
+        {"runs", num_runs},
+        {"failed", failed},
+        {"wall_s", wall_s},
+        {"threads", scheduler.capacity()},
+        {"workers", stats.workers},
+        {"steals", stats.steals},
+        {"peak_threads", stats.peak_threads},
+        {"results", stream ? json::array() : json(runs)}
+    };
+    if (write_columnar) {
+        json files = json::array();
+        std::string error;
+        if (!writeSweepColumnar(sweep_columnar, runs, files, error)) {
+            return createErrorResponse("run_sweep", error, "OUTPUT_FAILED");
+        }
+        result["columnar_output"] = {{"format", params["columnar_output"].value("format", std::string("arrow"))},
+                                     {"files", std::move(files)}};
+    }
+    json response = createSuccessResponse("run_sweep", result, 0);
+    if (failed > 0) {
+        response["status"] = "error";
+        response["error"] = std::to_string(failed) + " sweep run(s) failed";
+        response["error_code"] = "SWEEP_FAILED";
+    }
+    return response;
+}
+
+json CommandRouter::handleGetMetrics(const json& params) {
+    std::string engine_id = params.value("engine_id", "");
+
+    if (engine_id.empty()) {
+        return createErrorResponse("get_metrics",
+                                   "Missing 'engine_id' parameter",
+                                   "MISSING_PARAMETER");
+    }
+
+    // Get engine instance to retrieve actual engine type
+    auto* instance = engine_manager->getEngine(engine_id);
+    if (!instance) {
+        return createErrorResponse("get_metrics",
+                                   "Engine not found: " + engine_id + ".",
+                                   "ENGINE_NOT_FOUND");
+    }
+    std::string engine_type = instance->engine_type;
+
+    auto metrics = engine_manager->getMetrics(engine_id);
+
+    json result = {
+        {"engine_type", engine_type},  // Use actual engine type from instance
+        {"ns_per_op", metrics.ns_per_op},
+        {"ops_per_sec", metrics.ops_per_sec},
+        {"total_operations", metrics.total_operations}
+    };
+    if (metrics.page_size_bytes > 0) {
+        result["page_size_bytes"] = metrics.page_size_bytes;
+    }
+
+    if (metrics.hw_counters_valid) {
+        result["hardware_counters"] = {
+            {"cycles", metrics.hw_cycles},
+            {"instructions", metrics.hw_instructions},
+            {"llc_misses", metrics.hw_llc_misses},
+            {"ipc", metrics.hw_ipc},
+            {"dram_bandwidth_gbps", metrics.hw_dram_bandwidth_gbps}
+        };
+    }
+
+    if (metrics.model_bytes_per_step > 0.0) {
+        result["roofline"] = {
+            {"model_bytes_per_step", metrics.model_bytes_per_step},
+            {"model_flops_per_step", metrics.model_flops_per_step},
+            {"arithmetic_intensity", metrics.arithmetic_intensity},
+            {"achieved_gbps", metrics.roofline_valid ? json(metrics.achieved_gbps) : json(nullptr)},
+            {"achieved_gflops", metrics.roofline_valid ? json(metrics.achieved_gflops) : json(nullptr)}
+        };
+    }
+
+    if (metrics.sparse_valid) {
+        result["sparse"] = {
+            {"skipped_fraction", metrics.sparse_skipped_fraction}
+        };
+    }
+
+    if (metrics.energy_valid) {
+        result["energy"] = energyJson(metrics);
+    }
+
+    const dase::AdaptiveStepStats& adaptive = metrics.adaptive;
+    if (adaptive.accepted_steps > 0 || adaptive.rejected_steps > 0) {
+        result["adaptive"] = {
+            {"accepted_steps", adaptive.accepted_steps},
+            {"rejected_steps", adaptive.rejected_steps},
+            {"forced_steps", adaptive.forced_steps},
+            {"simulated_time", adaptive.simulated_time},
+            {"dt_min_used", adaptive.dt_min_used},
+            {"dt_max_used", adaptive.dt_max_used},
+            {"dt_last", adaptive.dt_last},
+            {"max_error", adaptive.max_error}
+        };
+    }
+
+    return createSuccessResponse("get_metrics", result, 0);
+}
+
+bool CommandRouter::setStateFromArrays(const std::string& engine_id, const json& arrays,
+                                       const std::vector<std::string>& family,
+                                       json& field_origins, std::string& error) {
+    if (!arrays.is_object() || arrays.empty()) {
+        error = "'params' must map field names to array sources";
+        return false;
+    }
+    // Engine order, so the engine writes fields in one pass each
+    std::vector<std::string> fields;
+    std::vector<dase::TypedArray> values;
+    field_origins = json::object();
+    for (const auto& field : family) {
+        if (!arrays.contains(field)) {
+            continue;
+        }
+        dase::TypedArray array;
+        if (!dase::TypedArray::resolve(arrays[field], request_segments_, array, error)) {
+            error = field + ": " + error;
+            return false;
+        }
+        field_origins[field] = array.origin();
+        fields.push_back(field);
+        values.push_back(std::move(array));
+    }
+    if (fields.size() != arrays.size()) {
+        for (auto it = arrays.begin(); it != arrays.end(); ++it) {
+            if (std::find(family.begin(), family.end(), it.key()) == family.end()) {
+                error = "Unknown field '" + it.key() + "'";
+                break;
+            }
+        }
+        return false;
+    }
+    return engine_manager->setStateArrays(engine_id, fields, values, error);
+}
+
+json CommandRouter::handleSetIgsoaState(const json& params) {
+    // Extract engine_id
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("set_igsoa_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+
+    // Extract profile type
+    if (!params.contains("profile_type")) {
+        return createErrorResponse("set_igsoa_state", "Missing 'profile_type' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string profile_type = params["profile_type"].get<std::string>();
+
+    // Extract profile parameters
+    if (!params.contains("params")) {
+        return createErrorResponse("set_igsoa_state", "Missing 'params' parameter", "MISSING_PARAMETER");
+    }
+
+    json profile_params = params["params"];
+
+    if (profile_type == "arrays") {
+        json origins;
+        std::string error;
+        if (!setStateFromArrays(engine_id, profile_params, dase::SnapshotSelection::igsoaFields(), origins, error)) {
+            return createErrorResponse("set_igsoa_state", error, "INVALID_PARAMETER");
+        }
+        return createSuccessResponse("set_igsoa_state", {{"profile_type", profile_type}, {"applied", true}, {"fields", origins}}, 0);
+    }
+
+    // Call engine manager to set state
+    if (!engine_manager->setIgsoaState(engine_id, profile_type, profile_params)) {
+        return createErrorResponse("set_igsoa_state",
+                                   "Failed to set state (wrong engine type, invalid engine_id, or unsupported profile)",
+                                   "STATE_SET_FAILED");
+    }
+
+    json result = {
+        {"profile_type", profile_type},
+        {"applied", true}
+    };
+
+    return createSuccessResponse("set_igsoa_state", result, 0);
+}
+
+json CommandRouter::handleSetSatpState(const json& params) {
+    // Extract engine_id
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("set_satp_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+
+    // Extract profile type
+    if (!params.contains("profile_type")) {
+        return createErrorResponse("set_satp_state", "Missing 'profile_type' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string profile_type = params["profile_type"].get<std::string>();
+
+    // Extract profile parameters
+    if (!params.contains("params")) {
+        return createErrorResponse("set_satp_state", "Missing 'params' parameter", "MISSING_PARAMETER");
+    }
+
+    json profile_params = params["params"];
+
+    if (profile_type == "arrays") {
+        json origins;
+        std::string error;
+        if (!setStateFromArrays(engine_id, profile_params, dase::SnapshotSelection::satpFields(), origins, error)) {
+            return createErrorResponse("set_satp_state", error, "INVALID_PARAMETER");
+        }
+        return createSuccessResponse("set_satp_state", {{"profile_type", profile_type}, {"applied", true}, {"fields", origins}}, 0);
+    }
+
+    // Call engine manager to set state
+    if (!engine_manager->setSatpState(engine_id, profile_type, profile_params)) {
+        return createErrorResponse("set_satp_state",
+                                   "Failed to set SATP state (wrong engine type, invalid engine_id, or unsupported profile)",
+                                   "STATE_SET_FAILED");
+    }
+
+    json result = {
+        {"profile_type", profile_type},
+        {"applied", true}
+    };
+
+    return createSuccessResponse("set_satp_state", result, 0);
+}
+
+// Parse the state selectors of `params` (fields, region, slice, stride,
+// dtype) against an engine's lattice and gather the selected values
+static bool selectState(EngineManager& engines, const json& params, const std::string& engine_id,
+                        const std::vector<std::string>& known_fields,
+                        dase::SnapshotSelection& selection,
+                        std::vector<std::vector<double>>& values,
+                        std::string& error, std::string& error_code) {
+    size_t dims[3] = {0, 1, 1};
+    if (!engines.getStateDims(engine_id, dims)) {
+        error_code = "STATE_EXTRACTION_FAILED";
+        return false;
+    }
+    if (!selection.parse(params, dims, known_fields, error)) {
+        error_code = "INVALID_PARAMETER";
+        return false;
+    }
+    if (!engines.getSelectedState(engine_id, selection, values)) {
+        error_code = "STATE_EXTRACTION_FAILED";
+        return false;
+    }
+    return true;
+}
+
+json CommandRouter::handleGetState(const json& params) {
+    // Required: engine_id
+    // Optional: fields, region, slice, stride, dtype (see snapshot_stream.h)
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("get_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+
+    // Extract the selected node states into pooled buffers: binary and
+    // text transports move them into segments and recycle them once
+    // written, plain json copies them and the arena takes them back
+    dase::SnapshotSelection selection;
+    dase::RequestArena arena(engine_manager->bufferPool());
+    std::vector<std::vector<double>>& values = arena.fields();
+    std::string error;
+    std::string error_code;
+    if (!selectState(*engine_manager, params, engine_id, dase::SnapshotSelection::igsoaFields(),
+                     selection, values, error, error_code)) {
+        return createErrorResponse("get_state",
+                                   error.empty() ? "Failed to extract state (wrong engine type or invalid engine_id)" : error,
+                                   error_code);
+    }
+
+    // Return state arrays
+    json result = {{"num_nodes", values.front().size()}};
+    for (size_t k = 0; k < values.size(); k++) {
+        result[selection.fields()[k]] = stateArray(values[k], response_segments_, selection.float32());
+    }
+    if (!selection.isDefault()) {
+        result["selection"] = selection.describe();
+    }
+
+    if (auto* instance = engine_manager->getEngine(engine_id)) {
+        result["engine_type"] = instance->engine_type;
+        if (instance->dimension_x > 0 && instance->dimension_y > 0) {
+            json dims = {
+                {"N_x", instance->dimension_x},
+                {"N_y", instance->dimension_y}
+            };
+            if (instance->dimension_z > 0) {
+                dims["N_z"] = instance->dimension_z;
+            }
+            result["dimensions"] = dims;
+        }
+    }
+
+    return createSuccessResponse("get_state", result, 0);
+}
+
+json CommandRouter::handleGetStateDigest(const json& params) {
+    // Required: engine_id
+    // Optional: tolerance (quantization step, 0 = exact bits), block_size
+    //           (values per block digest, 0 = none), fields, region, slice,
+    //           stride, dtype (see snapshot_stream.h)
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("get_state_digest", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+
+    const double tolerance = params.value("tolerance", 0.0);
+    if (!(tolerance >= 0.0) || !std::isfinite(tolerance)) {
+        return createErrorResponse("get_state_digest",
+                                   "Invalid tolerance. Must be non-negative and finite.",
+                                   "INVALID_PARAMETER");
+    }
+    const int64_t block_size = params.value("block_size", static_cast<int64_t>(0));
+    if (block_size < 0) {
+        return createErrorResponse("get_state_digest", "Invalid block_size. Must be non-negative.",
+                                   "INVALID_PARAMETER");
+    }
+
+    const auto* instance = engine_manager->getEngineConst(engine_id);
+    std::string error;
+    if (instance && instance->engine_type == "phase4b") {
+        // The library digests its own state arrays (no selectors)
+        uint64_t digest = 0;
+        if (!engine_manager->getPhase4bStateDigest(engine_id, tolerance, digest, error)) {
+            return createErrorResponse("get_state_digest", error, "STATE_EXTRACTION_FAILED");
+        }
+        json result = {
+            {"digest", dase::StateDigest::hex(digest)},
+            {"algorithm", "xxh64"},
+            {"tolerance", tolerance},
+            {"num_nodes", instance->num_nodes},
+            {"engine_type", instance->engine_type}
+        };
+        return createSuccessResponse("get_state_digest", result, 0);
+    }
+
+    const bool satp = instance && instance->engine_type.rfind("satp_higgs", 0) == 0;
+    dase::SnapshotSelection selection;
+    dase::RequestArena arena(engine_manager->bufferPool());
+    std::vector<std::vector<double>>& values = arena.fields();
+    std::string error_code;
+    if (!selectState(*engine_manager, params, engine_id,
+                     satp ? dase::SnapshotSelection::satpFields() : dase::SnapshotSelection::igsoaFields(),
+                     selection, values, error, error_code)) {
+        return createErrorResponse("get_state_digest",
+                                   error.empty() ? "Failed to extract state (wrong engine type or invalid engine_id)" : error,
+                                   error_code);
+    }
+
+    // Per-field digests (and block digests), then one over all of them
+    json fields = json::object();
+    std::vector<uint64_t> digests(values.size());
+    std::vector<std::vector<uint64_t>> blocks(values.size());
+    #pragma omp parallel for schedule(dynamic, 1) if(values.size() > 1 && values.front().size() >= 65536)
+    for (int64_t k = 0; k < static_cast<int64_t>(values.size()); k++) {
+        digests[k] = dase::StateDigest::field(values[k].data(), values[k].size(), tolerance,
+                                              static_cast<size_t>(block_size), &blocks[k]);
+    }
+    for (size_t k = 0; k < values.size(); k++) {
+        json field = {{"digest", dase::StateDigest::hex(digests[k])}};
+        if (block_size > 0) {
+            json block_digests = json::array();
+            for (uint64_t digest : blocks[k]) {
+                block_digests.push_back(dase::StateDigest::hex(digest));
+            }
+            field["blocks"] = std::move(block_digests);
+        }
+        fields[selection.fields()[k]] = std::move(field);
+    }
+
+    json result = {
+        {"digest", dase::StateDigest::hex(dase::StateDigest::combine(selection.fields(), digests))},
+        {"algorithm", "xxh64"},
+        {"tolerance", tolerance},
+        {"num_nodes", values.front().size()},
+        {"fields", std::move(fields)}
+    };
+    if (block_size > 0) {
+        result["block_size"] = block_size;
+    }
+    if (!selection.isDefault()) {
+        result["selection"] = selection.describe();
+    }
+    if (instance) {
+        result["engine_type"] = instance->engine_type;
+    }
+    return createSuccessResponse("get_state_digest", result, 0);
+}
+
+// RMS of φ and h over a whole SATP+Higgs lattice, read in place
+template <typename Engine>
+static void satpRms(const Engine& engine, double& phi_rms, double& h_rms) {
+    const auto& nodes = engine.getNodes();
+    for (const auto& node : nodes) {
+        phi_rms += node.phi * node.phi;
+        h_rms += node.h * node.h;
+    }
+    if (!nodes.empty()) {
+        phi_rms = std::sqrt(phi_rms / static_cast<double>(nodes.size()));
+        h_rms = std::sqrt(h_rms / static_cast<double>(nodes.size()));
+    }
+}
+
+json CommandRouter::handleGetSatpState(const json& params) {
+    // Required: engine_id
+    // Optional: fields, region, slice, stride, dtype (see snapshot_stream.h);
+    //           diagnostics always cover the whole lattice
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("get_satp_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+
+    // Extract the selected SATP+Higgs field states (pooled, as in get_state)
+    dase::SnapshotSelection selection;
+    dase::RequestArena arena(engine_manager->bufferPool());
+    std::vector<std::vector<double>>& values = arena.fields();
+    std::string error;
+    std::string error_code;
+    if (!selectState(*engine_manager, params, engine_id, dase::SnapshotSelection::satpFields(),
+                     selection, values, error, error_code)) {
+        return createErrorResponse("get_satp_state",
+                                   error.empty() ? "Failed to extract SATP state (wrong engine type or invalid engine_id)" : error,
+                                   error_code);
+    }
+
+    // Diagnostics of the whole lattice
+    double phi_rms = 0.0, h_rms = 0.0, total_energy = 0.0;
+    if (auto* instance = engine_manager->getEngine(engine_id)) {
+        if (instance->engine_type == "satp_higgs_1d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
+            total_energy = engine->computeTotalEnergy();
+            satpRms(*engine, phi_rms, h_rms);
+        } else if (instance->engine_type == "satp_higgs_2d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
+            total_energy = engine->computeTotalEnergy();
+            satpRms(*engine, phi_rms, h_rms);
+        } else if (instance->engine_type == "satp_higgs_3d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
+            total_energy = engine->computeTotalEnergy();
+            satpRms(*engine, phi_rms, h_rms);
+        }
+    }
+
+    // Return state arrays with diagnostics
+    json result = {
+        {"num_nodes", values.front().size()},
+        {"diagnostics", {
+            {"phi_rms", phi_rms},
+            {"h_rms", h_rms},
+            {"total_energy", total_energy}
+        }}
+    };
+    for (size_t k = 0; k < values.size(); k++) {
+        result[selection.fields()[k]] = stateArray(values[k], response_segments_, selection.float32());
+    }
+    if (!selection.isDefault()) {
+        result["selection"] = selection.describe();
+    }
+
+    if (auto* instance = engine_manager->getEngine(engine_id)) {
+        result["engine_type"] = instance->engine_type;
+        if (instance->engine_type == "satp_higgs_1d") {
+            result["time"] = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle)->getTime();
+        } else if (instance->engine_type == "satp_higgs_2d") {
+            result["time"] = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle)->getTime();
+        } else if (instance->engine_type == "satp_higgs_3d") {
+            result["time"] = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->getTime();
+        } else {
+            result["time"] = 0.0;
+        }
+    }
+
+    return createSuccessResponse("get_satp_state", result, 0);
+}
+
+json CommandRouter::handleGetEnsembleState(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("get_ensemble_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    auto* instance = engine_manager->getEngine(engine_id);
+    if (!instance || instance->engine_type != "igsoa_ensemble_1d") {
+        return createErrorResponse("get_ensemble_state",
+                                   "Engine is not an igsoa_ensemble_1d engine: " + engine_id,
+                                   "INVALID_ENGINE_TYPE");
+    }
+
+    // Optional replica range (default: the whole ensemble)
+    const int first_replica = params.value("first_replica", 0);
+    const int num_replicas = params.value("num_replicas", instance->num_replicas - first_replica);
+    EngineManager::EnsembleState state;
+    if (first_replica < 0 || num_replicas < 0 ||
+        !engine_manager->getEnsembleState(engine_id, static_cast<size_t>(first_replica),
+                                          static_cast<size_t>(num_replicas), state)) {
+        return createErrorResponse("get_ensemble_state",
+                                   "Replica range exceeds the ensemble (" + std::to_string(instance->num_replicas) + " replicas)",
+                                   "INVALID_PARAMETER");
+    }
+
+    auto* engine = static_cast<dase::igsoa::IGSOAEnsembleEngine1D*>(instance->engine_handle);
+    const size_t nodes = engine->getNumNodes();
+    json replicas = json::array();
+    for (int r = 0; r < num_replicas; ++r) {
+        const size_t replica = static_cast<size_t>(first_replica + r);
+        const auto slice = [&](const std::vector<double>& field) {
+            return std::vector<double>(field.begin() + r * nodes, field.begin() + (r + 1) * nodes);
+        };
+        std::vector<double> psi_real = slice(state.psi_real);
+        std::vector<double> psi_imag = slice(state.psi_imag);
+        std::vector<double> phi = slice(state.phi);
+        replicas.push_back({
+            {"replica", replica},
+            {"kappa", state.kappa[r]},
+            {"gamma", state.gamma[r]},
+            {"psi_real", stateArray(psi_real)},
+            {"psi_imag", stateArray(psi_imag)},
+            {"phi", stateArray(phi)},
+            {"total_energy", engine->getTotalEnergy(replica)},
+            {"entropy_rate", engine->getTotalEntropyRate(replica)}
+        });
+    }
+
+    json result = {
+        {"engine_type", instance->engine_type},
+        {"num_nodes", nodes},
+        {"num_replicas", engine->getNumReplicas()},
+        {"first_replica", first_replica},
+        {"time", engine->getCurrentTime()},
+        {"replicas", replicas}
+    };
+
+    return createSuccessResponse("get_ensemble_state", result, 0);
+}
+
+json CommandRouter::handleSetEnsembleState(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("set_ensemble_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+    if (!params.contains("replicas") || !params["replicas"].is_array()) {
+        return createErrorResponse("set_ensemble_state", "Missing 'replicas' array", "MISSING_PARAMETER");
+    }
+
+    // replicas[k] updates replica first_replica + k; absent fields are kept.
+    // Every entry is parsed and checked before any replica is written.
+    std::string engine_id = params["engine_id"].get<std::string>();
+    auto* instance = engine_manager->getEngine(engine_id);
+    if (!instance || instance->engine_type != "igsoa_ensemble_1d") {
+        return createErrorResponse("set_ensemble_state",
+                                   "Engine is not an igsoa_ensemble_1d engine: " + engine_id,
+                                   "INVALID_ENGINE_TYPE");
+    }
+    const int first_replica = params.value("first_replica", 0);
+    const json& replicas = params["replicas"];
+    if (first_replica < 0 ||
+        static_cast<int64_t>(first_replica) + static_cast<int64_t>(replicas.size()) > instance->num_replicas) {
+        return createErrorResponse("set_ensemble_state",
+                                   "Replica range exceeds the ensemble (" + std::to_string(instance->num_replicas) + " replicas)",
+                                   "INVALID_PARAMETER");
+    }
+
+    const size_t nodes = static_cast<size_t>(instance->num_nodes);
+    std::vector<EngineManager::EnsembleState> states(replicas.size());
+    for (size_t k = 0; k < replicas.size(); ++k) {
+        const json& entry = replicas[k];
+        EngineManager::EnsembleState& state = states[k];
+        try {
+            if (entry.contains("psi_real")) state.psi_real = entry["psi_real"].get<std::vector<double>>();
+            if (entry.contains("psi_imag")) state.psi_imag = entry["psi_imag"].get<std::vector<double>>();
+            if (entry.contains("phi")) state.phi = entry["phi"].get<std::vector<double>>();
+            if (entry.contains("kappa")) state.kappa.assign(1, entry["kappa"].get<double>());
+            if (entry.contains("gamma")) state.gamma.assign(1, entry["gamma"].get<double>());
+        } catch (const json::exception& e) {
+            return createErrorResponse("set_ensemble_state",
+                                       "Invalid replica " + std::to_string(k) + ": " + e.what(),
+                                       "INVALID_PARAMETER");
+        }
+        for (const auto* field : {&state.psi_real, &state.psi_imag, &state.phi}) {
+            if (!field->empty() && field->size() != nodes) {
+                return createErrorResponse("set_ensemble_state",
+                                           "Replica " + std::to_string(k) + ": fields must hold num_nodes (" +
+                                               std::to_string(nodes) + ") values",
+                                           "INVALID_PARAMETER");
+            }
+        }
+    }
+    for (size_t k = 0; k < states.size(); ++k) {
+        std::string error;
+        if (!engine_manager->setEnsembleState(engine_id, static_cast<size_t>(first_replica) + k, 1, states[k], error)) {
+            return createErrorResponse("set_ensemble_state", error, "STATE_SET_FAILED");
+        }
+    }
+
+    json result = {
+        {"first_replica", first_replica},
+        {"num_replicas", replicas.size()},
+        {"applied", true}
+    };
+
+    return createSuccessResponse("set_ensemble_state", result, 0);
+}
+
+json CommandRouter::handleMapState(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("map_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    std::string name = params.value("name", "dase_state_" + engine_id);
+    int publish_interval = params.value("publish_interval", 1);
+
+    json layout;
+    std::string error;
+    if (!engine_manager->mapState(engine_id, name, publish_interval, layout, error)) {
+        return createErrorResponse("map_state", error, "MAP_STATE_FAILED");
+    }
+
+    layout["engine_id"] = engine_id;
+    return createSuccessResponse("map_state", layout, 0);
+}
+
+json CommandRouter::handleUnmapState(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("unmap_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    if (!engine_manager->unmapState(engine_id)) {
+        return createErrorResponse("unmap_state", "No state export for engine: " + engine_id, "NOT_MAPPED");
+    }
+
+    json result = {
+        {"engine_id", engine_id},
+        {"unmapped", true}
+    };
+    return createSuccessResponse("unmap_state", result, 0);
+}
+
+json CommandRouter::handleBufferState(const json& params) {
+    // Required: engine_id
+    // Optional: fields, region, slice, stride, dtype (see snapshot_stream.h),
+    //           publish_interval (1), frames (3)
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("buffer_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const auto* instance = engine_manager->getEngineConst(engine_id);
+    size_t dims[3] = {0, 1, 1};
+    if (!instance || !engine_manager->getStateDims(engine_id, dims)) {
+        return createErrorResponse("buffer_state", "Engine not found: " + engine_id, "INVALID_ENGINE");
+    }
+    const bool satp = instance->engine_type.rfind("satp_higgs", 0) == 0;
+    dase::SnapshotSelection selection;
+    std::string error;
+    if (!selection.parse(params, dims, satp ? dase::SnapshotSelection::satpFields()
+                                            : dase::SnapshotSelection::igsoaFields(), error)) {
+        return createErrorResponse("buffer_state", error, "INVALID_PARAMETER");
+    }
+
+    const int publish_interval = params.value("publish_interval", 1);
+    const int64_t frames = params.value("frames", static_cast<int64_t>(3));
+    json info;
+    if (frames < 0 ||
+        !engine_manager->bufferState(engine_id, selection, static_cast<size_t>(frames), publish_interval,
+                                     info, error)) {
+        return createErrorResponse("buffer_state", frames < 0 ? "frames must be positive" : error,
+                                   "BUFFER_STATE_FAILED");
+    }
+
+    info["engine_id"] = engine_id;
+    return createSuccessResponse("buffer_state", info, 0);
+}
+
+json CommandRouter::handleReadSnapshot(const json& params) {
+    // Required: engine_id (with buffer_state).  Runs without the engine's
+    // lock, so it answers while a job is stepping the engine.
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("read_snapshot", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    std::shared_ptr<dase::SnapshotBuffer> buffer = engine_manager->snapshotBuffer(engine_id);
+    if (!buffer) {
+        return createErrorResponse("read_snapshot", "No snapshot buffer for engine: " + engine_id, "NOT_BUFFERED");
+    }
+    dase::SnapshotBuffer::Lease frame = buffer->lease();
+    if (!frame) {
+        return createErrorResponse("read_snapshot", "No snapshot published yet", "NOT_BUFFERED");
+    }
+
+    // Copy the frame and let it go before serializing, so the writer can
+    // reuse it as soon as possible
+    std::vector<std::vector<double>> values = frame->fields;
+    const dase::SnapshotSelection& selection = buffer->selection();
+    json result = {
+        {"engine_id", engine_id},
+        {"step", frame->step},
+        {"sequence", frame->sequence},
+        {"num_nodes", selection.count()}
+    };
+    if (!std::isnan(frame->simulated_time)) {
+        result["simulated_time"] = frame->simulated_time;
+    }
+    frame.release();
+    result["published"] = buffer->published();
+    result["skipped"] = buffer->skipped();
+    for (size_t k = 0; k < values.size(); k++) {
+        result[selection.fields()[k]] = stateArray(values[k], response_segments_, selection.float32());
+    }
+    if (!selection.isDefault()) {
+        result["selection"] = selection.describe();
+    }
+    return createSuccessResponse("read_snapshot", result, 0);
+}
+
+json CommandRouter::handleUnbufferState(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("unbuffer_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    if (!engine_manager->unbufferState(engine_id)) {
+        return createErrorResponse("unbuffer_state", "No snapshot buffer for engine: " + engine_id, "NOT_BUFFERED");
+    }
+
+    json result = {
+        {"engine_id", engine_id},
+        {"unbuffered", true}
+    };
+    return createSuccessResponse("unbuffer_state", result, 0);
+}
+
+json CommandRouter::handleSubscribeMetrics(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("subscribe_metrics", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+    if (!params.contains("metrics") || !params["metrics"].is_array()) {
+        return createErrorResponse("subscribe_metrics", "Missing 'metrics' array", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    std::vector<std::string> names = params["metrics"].get<std::vector<std::string>>();
+    std::string sink = params.value("sink", "stdout");
+    std::string target = params.value("path", params.value("name", "dase_metrics_" + engine_id));
+
+    dase::MetricEmitterOptions options;
+    const int every_steps = params.value("every_steps", 1);
+    if (every_steps < 1) {
+        return createErrorResponse("subscribe_metrics", "every_steps must be >= 1", "INVALID_PARAMETER");
+    }
+    options.every_steps = static_cast<uint64_t>(every_steps);
+    options.every_ms = params.value("every_ms", 0.0);
+    options.buffer_samples = params.value("buffer_samples", options.buffer_samples);
+
+    json info;
+    std::string error;
+    if (!engine_manager->subscribeMetrics(engine_id, names, options, sink, target, info, error)) {
+        return createErrorResponse("subscribe_metrics", error, "SUBSCRIBE_FAILED");
+    }
+
+    info["engine_id"] = engine_id;
+    return createSuccessResponse("subscribe_metrics", info, 0);
+}
+
+json CommandRouter::handleUnsubscribeMetrics(const json& params) {
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("unsubscribe_metrics", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+
+    std::string engine_id = params["engine_id"].get<std::string>();
+    if (!engine_manager->unsubscribeMetrics(engine_id)) {
+        return createErrorResponse("unsubscribe_metrics", "No metric subscription for engine: " + engine_id,
+                                   "NOT_SUBSCRIBED");
+    }
+
+    json result = {
+        {"engine_id", engine_id},
+        {"unsubscribed", true}
+    };
+    return createSuccessResponse("unsubscribe_metrics", result, 0);
+}
+
+json CommandRouter::handleAddProbe(const json& params) {
+    // Required: engine_id, and nodes (flat indices) or positions ([x, y, z]
+    // in meters, igsoa_gw detectors)
+    // Optional: fields (default all), decimation (1), capacity (4096 samples)
+    if (!params.contains("engine_id")) {
+        return createErrorResponse("add_probe", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const std::vector<std::string> field_names = engine_manager->probeFields(engine_id);
+    if (field_names.empty()) {
+        return createErrorResponse("add_probe", "Engine not found or without probes: " + engine_id,
+                                   "INVALID_ENGINE");
+    }
+
+    dase::ProbeSpec spec;
+    if (params.contains("nodes") && params["nodes"].is_array()) {
+        for (const auto& node : params["nodes"]) {
+            if (!node.is_number_integer() || node.get<int64_t>() < 0) {
+                return createErrorResponse("add_probe", "nodes must be non-negative integers", "INVALID_PARAMETER");
+            }
+            spec.points.push_back(node.get<uint64_t>());
+        }
+    } else if (params.contains("positions") && params["positions"].is_array()) {
+        std::vector<std::array<double, 3>> positions;
+        for (const auto& position : params["positions"]) {
+            if (!position.is_array() || position.size() != 3) {
+                return createErrorResponse("add_probe", "positions must be [x, y, z] triples", "INVALID_PARAMETER");
+            }
+            positions.push_back({position[0].get<double>(), position[1].get<double>(), position[2].get<double>()});
+        }
+        std::string error;
+        if (!engine_manager->probePointsAt(engine_id, positions, spec.points, error)) {
+            return createErrorResponse("add_probe", error, "INVALID_PARAMETER");
+        }
+    } else {
+        return createErrorResponse("add_probe", "Missing 'nodes' or 'positions' array", "MISSING_PARAMETER");
+    }
+
+    const std::vector<std::string> requested = params.contains("fields")
+        ? params["fields"].get<std::vector<std::string>>() : field_names;
+    for (const std::string& name : requested) {
+        auto it = std::find(field_names.begin(), field_names.end(), name);
+        if (it == field_names.end()) {
+            return createErrorResponse("add_probe", "Unknown probe field: " + name, "INVALID_PARAMETER");
+        }
+        spec.fields.push_back(static_cast<int>(it - field_names.begin()));
+    }
+
+    const int64_t decimation = params.value("decimation", static_cast<int64_t>(1));
+    const int64_t capacity = params.value("capacity", static_cast<int64_t>(spec.capacity));
+    const int64_t kMaxProbeValues = int64_t(1) << 27;   // 1 GiB of ring per probe
+    if (decimation < 1 || decimation > static_cast<int64_t>(UINT32_MAX)) {
+        return createErrorResponse("add_probe", "decimation must be >= 1", "INVALID_PARAMETER");
+    }
+    if (capacity < 1 || capacity > kMaxProbeValues /
+            static_cast<int64_t>(std::max<size_t>(spec.points.size() * spec.fields.size(), 1))) {
+        return createErrorResponse("add_probe", "capacity must be >= 1 and fit 2^27 values", "INVALID_PARAMETER");
+    }
+    spec.decimation = static_cast<uint32_t>(decimation);
+    spec.capacity = static_cast<size_t>(capacity);
+
+    std::string error;
+    const int probe_id = engine_manager->addProbe(engine_id, spec, error);
+    if (probe_id < 0) {
+        return createErrorResponse("add_probe", error, "INVALID_PARAMETER");
+    }
+
+    json result = {
+        {"engine_id", engine_id},
+        {"probe_id", probe_id},
+        {"points", spec.points},
+        {"fields", requested},
+        {"decimation", spec.decimation},
+        {"capacity", spec.capacity}
+    };
+    return createSuccessResponse("add_probe", result, 0);
+}
+
+json CommandRouter::handleDrainProbe(const json& params) {
+    // Pending samples oldest first: steps[s] and
+    // values[(s * num_fields + f) * num_points + p]
+    if (!params.contains("engine_id") || !params.contains("probe_id")) {
+        return createErrorResponse("drain_probe", "Missing 'engine_id' or 'probe_id' parameter", "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const int probe_id = params["probe_id"].get<int>();
+
+    std::vector<uint64_t> steps;
+    std::vector<double> values;
+    uint64_t dropped = 0;
+    dase::ProbeSpec spec;
+    if (!engine_manager->drainProbe(engine_id, probe_id, steps, values, dropped, spec)) {
+        return createErrorResponse("drain_probe", "Unknown probe " + std::to_string(probe_id) +
+                                   " on engine " + engine_id, "INVALID_PROBE");
+    }
+
+    const std::vector<std::string> field_names = engine_manager->probeFields(engine_id);
+    json fields = json::array();
+    for (int field : spec.fields) {
+        fields.push_back(field_names[static_cast<size_t>(field)]);
+    }
+    std::vector<double> step_values(steps.begin(), steps.end());   // Exact below 2^53
+    json result = {
+        {"engine_id", engine_id},
+        {"probe_id", probe_id},
+        {"num_samples", steps.size()},
+        {"num_points", spec.points.size()},
+        {"fields", fields},
+        {"dropped", dropped},
+        {"steps", stateArray(step_values)},
+        {"values", stateArray(values)}
+    };
+    return createSuccessResponse("drain_probe", result, 0);
+}
+
+json CommandRouter::handleRemoveProbe(const json& params) {
+    if (!params.contains("engine_id") || !params.contains("probe_id")) {
+        return createErrorResponse("remove_probe", "Missing 'engine_id' or 'probe_id' parameter", "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const int probe_id = params["probe_id"].get<int>();
+    if (!engine_manager->removeProbe(engine_id, probe_id)) {
+        return createErrorResponse("remove_probe", "Unknown probe " + std::to_string(probe_id) +
+                                   " on engine " + engine_id, "INVALID_PROBE");
+    }
+    json result = {
+        {"engine_id", engine_id},
+        {"probe_id", probe_id},
+        {"removed", true}
+    };
+    return createSuccessResponse("remove_probe", result, 0);
+}
+
+namespace {
+
+// add_observable "kind" names, in ObservableKind order
+const char* const kObservableKinds[] = {
+    "sum", "mean", "min", "max", "max_abs", "moments", "correlation", "center_of_mass"};
+
+// Values per sample of each kind, named
+json observableValueNames(dase::ObservableKind kind) {
+    switch (kind) {
+        case dase::ObservableKind::Moments: return {"mean", "variance"};
+        case dase::ObservableKind::CenterOfMass: return {"x", "y", "z"};
+        default: return {kObservableKinds[static_cast<int>(kind)]};
+    }
+}
+
+// {"origin": [x0, y0, z0], "size": [nx, ny, nz]}; absent axes are 0 / 1,
+// an absent box is the whole lattice
+bool parseObservableBox(const json& params, const char* key, dase::ObservableBox& box, std::string& error) {
+    if (!params.contains(key)) {
+        return true;
+    }
+    const json& value = params[key];
+    auto axes = [&](const char* name, size_t* out, size_t fill) {
+        out[0] = out[1] = out[2] = fill;
+        if (!value.contains(name)) return true;
+        const json& list = value[name];
+        if (!list.is_array() || list.empty() || list.size() > 3) return false;
+        for (size_t a = 0; a < list.size(); ++a) {
+            if (!list[a].is_number_integer() || list[a].get<int64_t>() < 0) return false;
+            out[a] = list[a].get<size_t>();
+        }
+        return true;
+    };
+    size_t origin[3], size[3];
+    if (!value.is_object() || !value.contains("size") || !axes("origin", origin, 0) || !axes("size", size, 1)) {
+        error = std::string(key) + " needs \"size\" (and optional \"origin\"): 1-3 non-negative integers";
+        return false;
+    }
+    box.x0 = origin[0];
+    box.y0 = origin[1];
+    box.z0 = origin[2];
+    box.nx = size[0];
+    box.ny = size[1];
+    box.nz = size[2];
+    if (box.count() == 0) {
+        error = std::string(key) + " must not be empty";
+        return false;
+    }
+    return true;
+}
+
+json observableBoxJson(const dase::ObservableBox& box) {
+    return {{"origin", {box.x0, box.y0, box.z0}}, {"size", {box.nx, box.ny, box.nz}}};
+}
+
+} // namespace
+
+static bool writeColumnarOutput(EngineManager& engines, const std::string& engine_id,
+                                const ColumnarOutput& output, int64_t step, json& report, std::string& error) {
+    using dase::columnar::ColumnBatch;
+    using dase::columnar::Type;
+    json files = json::array();
+    const std::vector<std::pair<std::string, std::string>> engine_meta = {{"engine_id", engine_id}};
+
+    const std::vector<int> probe_ids = output.all_probes ? engines.probeIds(engine_id) : output.probes;
+    if (output.all_probes || !probe_ids.empty()) {
+        const std::vector<std::string> field_names = engines.probeFields(engine_id);
+        ColumnBatch batch({{"probe_id", Type::Int32}, {"step", Type::UInt64}, {"point", Type::UInt64},
+                           {"field", Type::Utf8}, {"value", Type::Float64}});
+        json dropped = json::object();
+        for (int id : probe_ids) {
+            std::vector<uint64_t> steps;
+            std::vector<double> values;
+            uint64_t lost = 0;
+            dase::ProbeSpec spec;
+            if (!engines.drainProbe(engine_id, id, steps, values, lost, spec)) {
+                error = "Unknown probe " + std::to_string(id) + " on engine " + engine_id;
+                return false;
+            }
+            // values[(sample * fields + f) * points + p]: rows in that order
+            for (size_t s = 0; s < steps.size(); ++s) {
+                for (int field : spec.fields) {
+                    const std::string& name = static_cast<size_t>(field) < field_names.size()
+                                                  ? field_names[field] : std::to_string(field);
+                    for (uint64_t point : spec.points) {
+                        batch.appendInt32(0, id);
+                        batch.appendUInt64(1, steps[s]);
+                        batch.appendUInt64(2, point);
+                        batch.appendString(3, name);
+                    }
+                }
+            }
+            batch.appendFloat64(4, values.data(), values.size());
+            dropped[std::to_string(id)] = lost;
+        }
+        if (!writeColumnarTable(output, "probes", batch, engine_meta, files, error)) {
+            return false;
+        }
+        files.back()["dropped"] = std::move(dropped);
+    }
+
+    const std::vector<int> observable_ids = output.all_observables ? engines.observableIds(engine_id)
+                                                                   : output.observables;
+    if (output.all_observables || !observable_ids.empty()) {
+        ColumnBatch batch({{"observable_id", Type::Int32}, {"kind", Type::Utf8}, {"step", Type::UInt64},
+                           {"component", Type::Utf8}, {"value", Type::Float64}});
+        json dropped = json::object();
+        for (int id : observable_ids) {
+            std::vector<uint64_t> steps;
+            std::vector<double> values;
+            uint64_t lost = 0;
+            dase::ObservableSpec spec;
+            if (!engines.drainObservable(engine_id, id, steps, values, lost, spec)) {
+                error = "Unknown observable " + std::to_string(id) + " on engine " + engine_id;
+                return false;
+            }
+            const std::string kind = kObservableKinds[static_cast<int>(spec.kind)];
+            const std::vector<std::string> components = observableValueNames(spec.kind).get<std::vector<std::string>>();
+            for (size_t s = 0; s < steps.size(); ++s) {
+                for (const std::string& component : components) {
+                    batch.appendInt32(0, id);
+                    batch.appendString(1, kind);
+                    batch.appendUInt64(2, steps[s]);
+                    batch.appendString(3, component);
+                }
+            }
+            batch.appendFloat64(4, values.data(), values.size());
+            dropped[std::to_string(id)] = lost;
+        }
+        if (!writeColumnarTable(output, "observables", batch, engine_meta, files, error)) {
+            return false;
+        }
+        files.back()["dropped"] = std::move(dropped);
+    }
+
+    if (output.rewrite_events) {
+        std::vector<EngineManager::SidRewriteEvent> events;
+        uint64_t next_cursor = 0;
+        json log;
+        if (!engines.getSidRewriteEvents(engine_id, output.events_cursor, 0, events, next_cursor, log)) {
+            error = "Engine has no rewrite event log: " + engine_id;
+            return false;
+        }
+        ColumnBatch batch({{"event_id", Type::UInt64}, {"rule_id", Type::Utf8}, {"applied", Type::Bool},
+                           {"message", Type::Utf8}, {"metadata", Type::Utf8}, {"timestamp", Type::Float64}});
+        for (const auto& event : events) {
+            batch.appendUInt64(0, event.event_id);
+            batch.appendString(1, event.rule_id);
+            batch.appendBool(2, event.applied);
+            batch.appendString(3, event.message);
+            batch.appendString(4, event.metadata.is_null() ? std::string() : event.metadata.dump());
+            batch.appendFloat64(5, event.timestamp);
+        }
+        if (!writeColumnarTable(output, "rewrite_events", batch, engine_meta, files, error)) {
+            return false;
+        }
+        files.back()["next_cursor"] = next_cursor;
+    }
+
+    if (!output.snapshot.is_null()) {
+        const EngineInstance* instance = engines.getEngine(engine_id);
+        const bool satp = instance && instance->engine_type.compare(0, 10, "satp_higgs") == 0;
+        dase::SnapshotSelection selection;
+        dase::RequestArena arena(engines.bufferPool());
+        std::vector<std::vector<double>>& values = arena.fields();
+        std::string error_code;
+        if (!selectState(engines, output.snapshot, engine_id,
+                         satp ? dase::SnapshotSelection::satpFields() : dase::SnapshotSelection::igsoaFields(),
+                         selection, values, error, error_code)) {
+            if (error.empty()) error = "Failed to extract state of engine " + engine_id;
+            return false;
+        }
+        std::vector<dase::columnar::ColumnSchema> schema = {{"step", Type::Int64}, {"node", Type::UInt64}};
+        for (const std::string& field : selection.fields()) {
+            schema.push_back({field, selection.float32() ? Type::Float32 : Type::Float64});
+        }
+        ColumnBatch batch(schema);
+        selection.forEachIndex([&](size_t node) {
+            batch.appendInt64(0, step);
+            batch.appendUInt64(1, node);
+        });
+        for (size_t k = 0; k < values.size(); ++k) {
+            if (selection.float32()) {
+                for (double value : values[k]) batch.appendFloat32(2 + k, static_cast<float>(value));
+            } else {
+                batch.appendFloat64(2 + k, values[k].data(), values[k].size());
+            }
+        }
+        std::vector<std::pair<std::string, std::string>> metadata = engine_meta;
+        metadata.emplace_back("selection", selection.describe().dump());
+        if (!writeColumnarTable(output, "snapshot", batch, metadata, files, error)) {
+            return false;
+        }
+    }
+
+    report = {{"format", output.format == dase::columnar::Format::Arrow ? "arrow" : "parquet"},
+              {"files", std::move(files)}};
+    return true;
+}
+
+json CommandRouter::handleAddObservable(const json& params) {
+    // Required: engine_id, kind (sum, mean, min, max, max_abs, moments,
+    // correlation, center_of_mass)
+    // Optional: field (default "F"), box (whole lattice), other_field /
+    // other_box (correlation; default field / box), decimation (1),
+    // capacity (4096 samples)
+    if (!params.contains("engine_id") || !params.contains("kind")) {
+        return createErrorResponse("add_observable", "Missing 'engine_id' or 'kind' parameter", "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const std::vector<std::string> field_names = {"psi_real", "psi_imag", "phi", "F"};   // IGSOANodeField order
+    auto fieldId = [&](const std::string& name) {
+        auto it = std::find(field_names.begin(), field_names.end(), name);
+        return it == field_names.end() ? -1 : static_cast<int>(it - field_names.begin());
+    };
+
+    dase::ObservableSpec spec;
+    const std::string kind = params["kind"].get<std::string>();
+    const auto* kind_it = std::find_if(std::begin(kObservableKinds), std::end(kObservableKinds),
+                                       [&](const char* name) { return kind == name; });
+    if (kind_it == std::end(kObservableKinds)) {
+        return createErrorResponse("add_observable", "Unknown observable kind: " + kind, "INVALID_PARAMETER");
+    }
+    spec.kind = static_cast<dase::ObservableKind>(kind_it - std::begin(kObservableKinds));
+
+    const std::string field = params.value("field", std::string("F"));
+    const std::string other_field = params.value("other_field", field);
+    spec.field = fieldId(field);
+    spec.other_field = fieldId(other_field);
+    if (spec.field < 0 || spec.other_field < 0) {
+        return createErrorResponse("add_observable", "Unknown observable field: " +
+                                   (spec.field < 0 ? field : other_field), "INVALID_PARAMETER");
+    }
+
+    std::string error;
+    if (!parseObservableBox(params, "box", spec.box, error) ||
+        !parseObservableBox(params, "other_box", spec.other_box, error)) {
+        return createErrorResponse("add_observable", error, "INVALID_PARAMETER");
+    }
+
+    const int64_t decimation = params.value("decimation", static_cast<int64_t>(1));
+    const int64_t capacity = params.value("capacity", static_cast<int64_t>(spec.capacity));
+    const int64_t kMaxObservableSamples = int64_t(1) << 24;
+    if (decimation < 1 || decimation > static_cast<int64_t>(UINT32_MAX)) {
+        return createErrorResponse("add_observable", "decimation must be >= 1", "INVALID_PARAMETER");
+    }
+    if (capacity < 1 || capacity > kMaxObservableSamples) {
+        return createErrorResponse("add_observable", "capacity must be in [1, 2^24]", "INVALID_PARAMETER");
+    }
+    spec.decimation = static_cast<uint32_t>(decimation);
+    spec.capacity = static_cast<size_t>(capacity);
+
+    const int observable_id = engine_manager->addObservable(engine_id, spec, error);
+    if (observable_id < 0) {
+        return createErrorResponse("add_observable", error, "INVALID_PARAMETER");
+    }
+
+    json result = {
+        {"engine_id", engine_id},
+        {"observable_id", observable_id},
+        {"kind", kind},
+        {"field", field},
+        {"box", observableBoxJson(spec.box)},
+        {"values", observableValueNames(spec.kind)},
+        {"decimation", spec.decimation},
+        {"capacity", spec.capacity}
+    };
+    if (spec.kind == dase::ObservableKind::Correlation) {
+        result["other_field"] = other_field;
+        result["other_box"] = observableBoxJson(spec.other_box);
+    }
+    return createSuccessResponse("add_observable", result, 0);
+}
+
+json CommandRouter::handleDrainObservable(const json& params) {
+    // Pending samples oldest first: steps[s] and values[s * width + k],
+    // k naming value_names[k]
+    if (!params.contains("engine_id") || !params.contains("observable_id")) {
+        return createErrorResponse("drain_observable", "Missing 'engine_id' or 'observable_id' parameter",
+                                   "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const int observable_id = params["observable_id"].get<int>();
+
+    std::vector<uint64_t> steps;
+    std::vector<double> values;
+    uint64_t dropped = 0;
+    dase::ObservableSpec spec;
+    if (!engine_manager->drainObservable(engine_id, observable_id, steps, values, dropped, spec)) {
+        return createErrorResponse("drain_observable", "Unknown observable " + std::to_string(observable_id) +
+                                   " on engine " + engine_id, "INVALID_OBSERVABLE");
+    }
+
+    std::vector<double> step_values(steps.begin(), steps.end());   // Exact below 2^53
+    json result = {
+        {"engine_id", engine_id},
+        {"observable_id", observable_id},
+        {"kind", kObservableKinds[static_cast<int>(spec.kind)]},
+        {"num_samples", steps.size()},
+        {"value_names", observableValueNames(spec.kind)},
+        {"dropped", dropped},
+        {"steps", stateArray(step_values)},
+        {"values", stateArray(values)}
+    };
+    return createSuccessResponse("drain_observable", result, 0);
+}
+
+json CommandRouter::handleRemoveObservable(const json& params) {
+    if (!params.contains("engine_id") || !params.contains("observable_id")) {
+        return createErrorResponse("remove_observable", "Missing 'engine_id' or 'observable_id' parameter",
+                                   "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const int observable_id = params["observable_id"].get<int>();
+    if (!engine_manager->removeObservable(engine_id, observable_id)) {
+        return createErrorResponse("remove_observable", "Unknown observable " + std::to_string(observable_id) +
+                                   " on engine " + engine_id, "INVALID_OBSERVABLE");
+    }
+    json result = {
+        {"engine_id", engine_id},
+        {"observable_id", observable_id},
+        {"removed", true}
+    };
+    return createSuccessResponse("remove_observable", result, 0);
+}
+
+json CommandRouter::handleAddTrigger(const json& params) {
+    // Required: engine_id, observable_id, condition (above, below,
+    // crosses_up, crosses_down, settles), threshold
+    // Optional: component (index into the observable's value_names; 0),
+    // hold (consecutive samples; 1), action (stop, snapshot, emit, drive;
+    // default stop), path (snapshot; "{step}" becomes the engine step),
+    // drive_gain (drive), repeat (false: fire once)
+    if (!params.contains("engine_id") || !params.contains("observable_id") ||
+        !params.contains("condition") || !params.contains("threshold")) {
+        return createErrorResponse("add_trigger", "Missing 'engine_id', 'observable_id', 'condition' or 'threshold' parameter",
+                                   "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+
+    dase::TriggerSpec spec;
+    spec.observable = params["observable_id"].get<int>();
+    const std::string condition = params["condition"].get<std::string>();
+    const auto* condition_it = std::find_if(std::begin(kTriggerConditions), std::end(kTriggerConditions),
+                                            [&](const char* name) { return condition == name; });
+    if (condition_it == std::end(kTriggerConditions)) {
+        return createErrorResponse("add_trigger", "Unknown trigger condition: " + condition, "INVALID_PARAMETER");
+    }
+    spec.condition = static_cast<dase::TriggerCondition>(condition_it - std::begin(kTriggerConditions));
+    const std::string action = params.value("action", std::string("stop"));
+    const auto* action_it = std::find_if(std::begin(kTriggerActions), std::end(kTriggerActions),
+                                         [&](const char* name) { return action == name; });
+    if (action_it == std::end(kTriggerActions)) {
+        return createErrorResponse("add_trigger", "Unknown trigger action: " + action, "INVALID_PARAMETER");
+    }
+    spec.action = static_cast<dase::TriggerAction>(action_it - std::begin(kTriggerActions));
+
+    const int64_t component = params.value("component", static_cast<int64_t>(0));
+    const int64_t hold = params.value("hold", static_cast<int64_t>(1));
+    if (component < 0 || hold < 1 || hold > static_cast<int64_t>(UINT32_MAX)) {
+        return createErrorResponse("add_trigger", "component must be >= 0 and hold >= 1", "INVALID_PARAMETER");
+    }
+    spec.component = static_cast<size_t>(component);
+    spec.hold = static_cast<uint32_t>(hold);
+    spec.threshold = params["threshold"].get<double>();
+    spec.drive_gain = params.value("drive_gain", 1.0);
+    spec.path = params.value("path", std::string());
+    spec.repeat = params.value("repeat", false);
+
+    std::string error;
+    const int trigger_id = engine_manager->addTrigger(engine_id, spec, error);
+    if (trigger_id < 0) {
+        return createErrorResponse("add_trigger", error, "INVALID_PARAMETER");
+    }
+
+    json result = {
+        {"engine_id", engine_id},
+        {"trigger_id", trigger_id},
+        {"observable_id", spec.observable},
+        {"condition", condition},
+        {"threshold", spec.threshold},
+        {"component", spec.component},
+        {"hold", spec.hold},
+        {"action", action},
+        {"repeat", spec.repeat}
+    };
+    if (spec.action == dase::TriggerAction::Snapshot) {
+        result["path"] = spec.path;
+    } else if (spec.action == dase::TriggerAction::Drive) {
+        result["drive_gain"] = spec.drive_gain;
+    }
+    return createSuccessResponse("add_trigger", result, 0);
+}
+
+json CommandRouter::handleRemoveTrigger(const json& params) {
+    if (!params.contains("engine_id") || !params.contains("trigger_id")) {
+        return createErrorResponse("remove_trigger", "Missing 'engine_id' or 'trigger_id' parameter",
+                                   "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const int trigger_id = params["trigger_id"].get<int>();
+    if (!engine_manager->removeTrigger(engine_id, trigger_id)) {
+        return createErrorResponse("remove_trigger", "Unknown trigger " + std::to_string(trigger_id) +
+                                   " on engine " + engine_id, "INVALID_TRIGGER");
+    }
+    json result = {
+        {"engine_id", engine_id},
+        {"trigger_id", trigger_id},
+        {"removed", true}
+    };
+    return createSuccessResponse("remove_trigger", result, 0);
+}
+
+json CommandRouter::handleAddSpectralMonitor(const json& params) {
+    // Required: engine_id, probe_id
+    // Optional: segment (256 samples), overlap (segment / 2), window
+    // ("hann" or "rectangular"), detrend (true: subtract each window's mean)
+    if (!params.contains("engine_id") || !params.contains("probe_id")) {
+        return createErrorResponse("add_spectral_monitor", "Missing 'engine_id' or 'probe_id' parameter",
+                                   "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const int probe_id = params["probe_id"].get<int>();
+
+    const int64_t kMaxSegment = int64_t(1) << 24;
+    const int64_t segment = params.value("segment", static_cast<int64_t>(256));
+    if (segment < 2 || segment > kMaxSegment) {
+        return createErrorResponse("add_spectral_monitor", "segment must be in [2, 2^24]", "INVALID_PARAMETER");
+    }
+    const int64_t overlap = params.value("overlap", segment / 2);
+    if (overlap < 0 || overlap >= segment) {
+        return createErrorResponse("add_spectral_monitor", "overlap must be in [0, segment)", "INVALID_PARAMETER");
+    }
+    const std::string window = params.value("window", std::string("hann"));
+    if (window != "hann" && window != "rectangular") {
+        return createErrorResponse("add_spectral_monitor", "window must be 'hann' or 'rectangular'",
+                                   "INVALID_PARAMETER");
     }
-    std::string engine_type = instance->engine_type;
 
-    auto metrics = engine_manager->getMetrics(engine_id);
+    dase::analysis::SpectralMonitorConfig config;
+    config.segment = static_cast<size_t>(segment);
+    config.overlap = static_cast<size_t>(overlap);
+    config.hann = window == "hann";
+    config.detrend = params.value("detrend", true);
+
+    std::string error;
+    const int monitor_id = engine_manager->addSpectralMonitor(engine_id, probe_id, config, error);
+    if (monitor_id < 0) {
+        return createErrorResponse("add_spectral_monitor", error, "INVALID_PARAMETER");
+    }
+    const auto* monitor = engine_manager->spectralMonitor(engine_id, monitor_id);
 
     json result = {
-        {"engine_type", engine_type},  // Use actual engine type from instance
-        {"ns_per_op", metrics.ns_per_op},
-        {"ops_per_sec", metrics.ops_per_sec},
-        {"total_operations", metrics.total_operations}
+        {"engine_id", engine_id},
+        {"monitor_id", monitor_id},
+        {"probe_id", probe_id},
+        {"channels", monitor->channels()},
+        {"bins", monitor->bins()},
+        {"sample_interval", monitor->config().sample_interval},
+        {"frequency_resolution", monitor->frequencyResolution()}
     };
-
-    return createSuccessResponse("get_metrics", result, 0);
+    return createSuccessResponse("add_spectral_monitor", result, 0);
 }
 
-json CommandRouter::handleSetIgsoaState(const json& params) {
-    // Extract engine_id
-    if (!params.contains("engine_id")) {
-        return createErrorResponse("set_igsoa_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+json CommandRouter::handleGetSpectrum(const json& params) {
+    // Averaged PSD of one probe channel: bin k at k * frequency_resolution
+    // Optional: point (index into the probe's points, 0), field (name,
+    // the probe's first), num_peaks (10), threshold (0.01 of the peak
+    // amplitude), include_psd (true), reset (false: keep accumulating)
+    if (!params.contains("engine_id") || !params.contains("monitor_id")) {
+        return createErrorResponse("get_spectrum", "Missing 'engine_id' or 'monitor_id' parameter",
+                                   "MISSING_PARAMETER");
     }
-
     std::string engine_id = params["engine_id"].get<std::string>();
+    const int monitor_id = params["monitor_id"].get<int>();
+
+    int probe_id = 0;
+    dase::ProbeSpec spec;
+    auto* monitor = engine_manager->spectralMonitor(engine_id, monitor_id, &probe_id, &spec);
+    if (!monitor) {
+        return createErrorResponse("get_spectrum", "Unknown spectral monitor " + std::to_string(monitor_id) +
+                                   " on engine " + engine_id, "INVALID_MONITOR");
+    }
 
-    // Extract profile type
-    if (!params.contains("profile_type")) {
-        return createErrorResponse("set_igsoa_state", "Missing 'profile_type' parameter", "MISSING_PARAMETER");
+    const int64_t point = params.value("point", static_cast<int64_t>(0));
+    if (point < 0 || point >= static_cast<int64_t>(spec.points.size())) {
+        return createErrorResponse("get_spectrum", "point must index the probe's points", "INVALID_PARAMETER");
+    }
+    const std::vector<std::string> field_names = engine_manager->probeFields(engine_id);
+    size_t field_slot = 0;
+    std::string field = field_names.empty() ? std::string() : field_names[static_cast<size_t>(spec.fields[0])];
+    if (params.contains("field")) {
+        field = params["field"].get<std::string>();
+        auto it = std::find_if(spec.fields.begin(), spec.fields.end(), [&](int id) {
+            return static_cast<size_t>(id) < field_names.size() && field_names[static_cast<size_t>(id)] == field;
+        });
+        if (it == spec.fields.end()) {
+            return createErrorResponse("get_spectrum", "Field not recorded by the probe: " + field,
+                                       "INVALID_PARAMETER");
+        }
+        field_slot = static_cast<size_t>(it - spec.fields.begin());
     }
 
-    std::string profile_type = params["profile_type"].get<std::string>();
+    const size_t channel = field_slot * spec.points.size() + static_cast<size_t>(point);
+    const dase::analysis::FFTResult spectrum = monitor->spectrum(channel, field);
+    const auto peaks = dase::analysis::EngineFFTAnalysis::findPeaks(
+        spectrum, params.value("num_peaks", static_cast<size_t>(10)), params.value("threshold", 0.01));
+    json peak_list = json::array();
+    for (const auto& [frequency, amplitude] : peaks) {
+        peak_list.push_back({{"frequency", frequency}, {"psd", amplitude * amplitude}});
+    }
 
-    // Extract profile parameters
-    if (!params.contains("params")) {
-        return createErrorResponse("set_igsoa_state", "Missing 'params' parameter", "MISSING_PARAMETER");
+    json result = {
+        {"engine_id", engine_id},
+        {"monitor_id", monitor_id},
+        {"probe_id", probe_id},
+        {"node", spec.points[static_cast<size_t>(point)]},
+        {"field", field},
+        {"segments", monitor->segments()},
+        {"samples", monitor->samples()},
+        {"frequency_resolution", monitor->frequencyResolution()},
+        {"total_power", spectrum.total_power},
+        {"peak_frequency", spectrum.peak_frequency},
+        {"peaks", peak_list}
+    };
+    if (params.value("include_psd", true)) {
+        std::vector<double> psd = spectrum.power_spectrum;
+        result["psd"] = stateArray(psd);
+    }
+    if (params.value("reset", false)) {
+        monitor->reset();
     }
+    return createSuccessResponse("get_spectrum", result, 0);
+}
 
-    json profile_params = params["params"];
+json CommandRouter::handleRemoveSpectralMonitor(const json& params) {
+    if (!params.contains("engine_id") || !params.contains("monitor_id")) {
+        return createErrorResponse("remove_spectral_monitor", "Missing 'engine_id' or 'monitor_id' parameter",
+                                   "MISSING_PARAMETER");
+    }
+    std::string engine_id = params["engine_id"].get<std::string>();
+    const int monitor_id = params["monitor_id"].get<int>();
+    if (!engine_manager->removeSpectralMonitor(engine_id, monitor_id)) {
+        return createErrorResponse("remove_spectral_monitor", "Unknown spectral monitor " +
+                                   std::to_string(monitor_id) + " on engine " + engine_id, "INVALID_MONITOR");
+    }
+    json result = {
+        {"engine_id", engine_id},
+        {"monitor_id", monitor_id},
+        {"removed", true}
+    };
+    return createSuccessResponse("remove_spectral_monitor", result, 0);
+}
 
-    // Call engine manager to set state
-    if (!engine_manager->setIgsoaState(engine_id, profile_type, profile_params)) {
-        return createErrorResponse("set_igsoa_state",
-                                   "Failed to set state (wrong engine type, invalid engine_id, or unsupported profile)",
-                                   "STATE_SET_FAILED");
+json CommandRouter::handleTraceStart(const json& /*params*/) {
+    if (!dase::trace::kTraceCompiledIn) {
+        return createErrorResponse("trace_start",
+                                   "Trace zones are compiled out; rebuild with -DDASE_ENABLE_TRACE=ON",
+                                   "TRACE_DISABLED");
     }
+    dase::trace::TraceRecorder::instance().start();
+    return createSuccessResponse("trace_start", {{"recording", true}}, 0);
+}
 
+json CommandRouter::handleTraceStop(const json& params) {
+    // Optional: path (write the recorded zones there as Chrome trace JSON)
+    auto& recorder = dase::trace::TraceRecorder::instance();
+    recorder.stop();
+    const std::string path = params.value("path", "");
+    if (!path.empty() && !recorder.writeChromeTrace(path)) {
+        return createErrorResponse("trace_stop", "Failed to write trace: " + path, "OUTPUT_FAILED");
+    }
+    const auto summary = recorder.summary();
     json result = {
-        {"profile_type", profile_type},
-        {"applied", true}
+        {"recording", false},
+        {"events", summary.events},
+        {"dropped", summary.dropped},
+        {"threads", summary.threads}
     };
+    if (!path.empty()) {
+        result["path"] = path;
+    }
+    return createSuccessResponse("trace_stop", result, 0);
+}
 
-    return createSuccessResponse("set_igsoa_state", result, 0);
+json CommandRouter::handleGetRouterStats(const json& params) {
+    // Optional: command (only that row), reset (clear after reading)
+    json result = stats_.toJson(params.value("command", ""));
+    if (params.value("reset", false)) {
+        stats_.reset();
+        result["reset"] = true;
+    }
+    return createSuccessResponse("get_router_stats", result, 0);
 }
 
-json CommandRouter::handleSetSatpState(const json& params) {
-    // Extract engine_id
+json CommandRouter::handleCheckpointEngine(const json& params) {
     if (!params.contains("engine_id")) {
-        return createErrorResponse("set_satp_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+        return createErrorResponse("checkpoint_engine", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+    if (!params.contains("path")) {
+        return createErrorResponse("checkpoint_engine", "Missing 'path' parameter", "MISSING_PARAMETER");
     }
 
     std::string engine_id = params["engine_id"].get<std::string>();
+    std::string path = params["path"].get<std::string>();
 
-    // Extract profile type
-    if (!params.contains("profile_type")) {
-        return createErrorResponse("set_satp_state", "Missing 'profile_type' parameter", "MISSING_PARAMETER");
+    json result;
+    std::string error;
+    if (!engine_manager->checkpointEngine(engine_id, path, result, error)) {
+        return createErrorResponse("checkpoint_engine", error, "CHECKPOINT_FAILED");
     }
+    return createSuccessResponse("checkpoint_engine", result, 0);
+}
 
-    std::string profile_type = params["profile_type"].get<std::string>();
+json CommandRouter::handleRestoreEngine(const json& params) {
+    if (!params.contains("path")) {
+        return createErrorResponse("restore_engine", "Missing 'path' parameter", "MISSING_PARAMETER");
+    }
 
-    // Extract profile parameters
-    if (!params.contains("params")) {
-        return createErrorResponse("set_satp_state", "Missing 'params' parameter", "MISSING_PARAMETER");
+    std::string path = params["path"].get<std::string>();
+    std::string engine_id = params.value("engine_id", "");
+
+    json result;
+    std::string error;
+    if (!engine_manager->restoreEngine(path, engine_id, result, error)) {
+        return createErrorResponse("restore_engine", error, "RESTORE_FAILED");
     }
+    return createSuccessResponse("restore_engine", result, 0);
+}
 
-    json profile_params = params["params"];
+json CommandRouter::handleCloneEngine(const json& params) {
+    // Required: engine_id.  Optional: count (clones to create, default 1)
+    const std::string engine_id = params.value("engine_id", "");
+    const int count = params.value("count", 1);
+    const int MAX_CLONES = 1024;
+    if (engine_id.empty()) {
+        return createErrorResponse("clone_engine", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+    if (count <= 0 || count > MAX_CLONES) {
+        return createErrorResponse("clone_engine", "count must be in [1, " + std::to_string(MAX_CLONES) + "]",
+                                   "INVALID_PARAMETER");
+    }
 
-    // Call engine manager to set state
-    if (!engine_manager->setSatpState(engine_id, profile_type, profile_params)) {
-        return createErrorResponse("set_satp_state",
-                                   "Failed to set SATP state (wrong engine type, invalid engine_id, or unsupported profile)",
-                                   "STATE_SET_FAILED");
+    json result;
+    std::vector<std::string> clones;
+    std::string error;
+    if (!engine_manager->cloneEngine(engine_id, count, clones, result, error)) {
+        return createErrorResponse("clone_engine", error, "CLONE_FAILED");
     }
+    return createSuccessResponse("clone_engine", result, 0);
+}
 
+json CommandRouter::handleResetEngine(const json& params) {
+    // Required: engine_id.  Optional: R_c, kappa, gamma, dt, alpha (default:
+    // the engine's current values)
+    const std::string engine_id = params.value("engine_id", "");
+    if (engine_id.empty()) {
+        return createErrorResponse("reset_engine", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+    }
+    const EngineInstance* instance = engine_manager->getEngineConst(engine_id);
+    if (!instance) {
+        return createErrorResponse("reset_engine", "Engine not found: " + engine_id, "ENGINE_NOT_FOUND");
+    }
+    const double R_c = params.value("R_c", instance->R_c);
+    const double kappa = params.value("kappa", instance->kappa);
+    const double gamma = params.value("gamma", instance->gamma);
+    const double dt = params.value("dt", instance->dt);
+    const double alpha = params.value("alpha", instance->alpha);
+
+    std::string error;
+    if (!engine_manager->resetEngine(engine_id, R_c, kappa, gamma, dt, alpha, error)) {
+        return createErrorResponse("reset_engine", error, "RESET_FAILED");
+    }
     json result = {
-        {"profile_type", profile_type},
-        {"applied", true}
+        {"engine_id", engine_id},
+        {"R_c", R_c},
+        {"kappa", kappa},
+        {"gamma", gamma},
+        {"dt", dt},
+        {"alpha", alpha}
     };
-
-    return createSuccessResponse("set_satp_state", result, 0);
+    return createSuccessResponse("reset_engine", result, 0);
 }
 
-json CommandRouter::handleGetState(const json& params) {
-    // Extract engine_id
-    if (!params.contains("engine_id")) {
-        return createErrorResponse("get_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+json CommandRouter::handleSetEnginePool(const json& params) {
+    // Optional: max_idle (idle engines kept per type and shape; 0 = off).
+    // Without it, only reports the pool.
+    if (params.contains("max_idle")) {
+        const int max_idle = params.value("max_idle", 0);
+        const int MAX_IDLE = 1024;
+        if (max_idle < 0 || max_idle > MAX_IDLE) {
+            return createErrorResponse("set_engine_pool", "max_idle must be in [0, " + std::to_string(MAX_IDLE) + "]",
+                                       "INVALID_PARAMETER");
+        }
+        engine_manager->setEnginePool(static_cast<size_t>(max_idle));
     }
+    return createSuccessResponse("set_engine_pool", engine_manager->enginePoolStats(), 0);
+}
 
-    std::string engine_id = params["engine_id"].get<std::string>();
-
-    // Extract all node states
-    std::vector<double> psi_real, psi_imag, phi;
-
-    if (!engine_manager->getAllNodeStates(engine_id, psi_real, psi_imag, phi)) {
-        return createErrorResponse("get_state", "Failed to extract state (wrong engine type or invalid engine_id)", "STATE_EXTRACTION_FAILED");
+json CommandRouter::handleSubmitMission(const json& params) {
+    std::string engine_id = params.value("engine_id", "");
+    dase::JobRequest request;
+    request.engine_id = engine_id;
+    request.num_steps = params.value("num_steps", 0);
+    request.iterations_per_node = params.value("iterations_per_node", 30);
+    request.chunk_steps = params.value("chunk_steps", 1);
+    request.time_budget_ms = params.value("time_budget_ms", 0.0);
+
+    if (!engine_manager->getEngine(engine_id)) {
+        return createErrorResponse("submit_mission", "Engine not found: " + engine_id, "ENGINE_NOT_FOUND");
+    }
+    if (request.num_steps <= 0 || request.chunk_steps <= 0) {
+        return createErrorResponse("submit_mission", "num_steps and chunk_steps must be positive", "INVALID_PARAMETER");
+    }
+    if (!(request.time_budget_ms >= 0.0) || !std::isfinite(request.time_budget_ms)) {
+        return createErrorResponse("submit_mission", "time_budget_ms must be a non-negative number", "INVALID_PARAMETER");
     }
 
-    // Return state arrays
     json result = {
-        {"num_nodes", psi_real.size()},
-        {"psi_real", psi_real},
-        {"psi_imag", psi_imag},
-        {"phi", phi}
+        {"job_id", job_manager_->submit(request)},
+        {"engine_id", engine_id},
+        {"state", "queued"}
     };
+    return createSuccessResponse("submit_mission", result, 0);
+}
 
-    if (auto* instance = engine_manager->getEngine(engine_id)) {
-        result["engine_type"] = instance->engine_type;
-        if (instance->dimension_x > 0 && instance->dimension_y > 0) {
-            json dims = {
-                {"N_x", instance->dimension_x},
-                {"N_y", instance->dimension_y}
-            };
-            if (instance->dimension_z > 0) {
-                dims["N_z"] = instance->dimension_z;
-            }
-            result["dimensions"] = dims;
-        }
+json CommandRouter::handleJobStatus(const json& params) {
+    json status = job_manager_->status(params.value("job_id", ""));
+    if (status.is_null()) {
+        return createErrorResponse("job_status", "Unknown job_id", "JOB_NOT_FOUND");
     }
-
-    return createSuccessResponse("get_state", result, 0);
+    return createSuccessResponse("job_status", status, 0);
 }
 
-json CommandRouter::handleGetSatpState(const json& params) {
-    // Extract engine_id
-    if (!params.contains("engine_id")) {
-        return createErrorResponse("get_satp_state", "Missing 'engine_id' parameter", "MISSING_PARAMETER");
+json CommandRouter::handleJobWait(const json& params) {
+    json status;
+    if (!job_manager_->wait(params.value("job_id", ""), params.value("timeout_ms", int64_t(-1)), status)) {
+        return createErrorResponse("job_wait", "Unknown job_id", "JOB_NOT_FOUND");
     }
+    return createSuccessResponse("job_wait", status, 0);
+}
 
-    std::string engine_id = params["engine_id"].get<std::string>();
+json CommandRouter::handleJobCancel(const json& params) {
+    std::string job_id = params.value("job_id", "");
+    if (!job_manager_->cancel(job_id)) {
+        return createErrorResponse("job_cancel", "Unknown or finished job: " + job_id, "JOB_NOT_CANCELLABLE");
+    }
+    return createSuccessResponse("job_cancel", job_manager_->status(job_id), 0);
+}
 
-    // Extract SATP+Higgs field states
-    std::vector<double> phi, phi_dot, h, h_dot;
+json CommandRouter::handleListJobs(const json& /*params*/) {
+    json result = {
+        {"jobs", job_manager_->list()}
+    };
+    return createSuccessResponse("list_jobs", result, 0);
+}
 
-    if (!engine_manager->getSatpState(engine_id, phi, phi_dot, h, h_dot)) {
-        return createErrorResponse("get_satp_state", "Failed to extract SATP state (wrong engine type or invalid engine_id)", "STATE_EXTRACTION_FAILED");
+// Run params.commands back to back in one request.  Params may reference
+// earlier results ("$0.engine_id", see batch_references.h).  "return" picks
+// all results, only the last one or only failures; by default the batch
+// stops at the first failure.
+json CommandRouter::handleBatch(const json& params) {
+    if (!params.contains("commands") || !params["commands"].is_array()) {
+        return createErrorResponse("batch", "Missing 'commands' array", "MISSING_PARAMETER");
     }
+    const std::string mode = params.value("return", std::string("all"));
+    if (mode != "all" && mode != "last" && mode != "failures") {
+        return createErrorResponse("batch", "'return' must be all, last or failures", "INVALID_PARAMETER");
+    }
+    const bool stop_on_error = params.value("stop_on_error", true);
+    const json& commands = params["commands"];
+
+    // Every response is kept for "$<index>..." references, whatever is returned
+    std::vector<json> responses;
+    responses.reserve(commands.size());
+    json returned = json::array();
+    size_t failed = 0;
+
+    for (size_t i = 0; i < commands.size(); ++i) {
+        json response;
+        std::string error;
+        if (!commands[i].is_object()) {
+            response = createErrorResponse("", "Batch entry is not a command object", "INVALID_PARAMETER");
+        } else if (commands[i].value("command", "") == "batch") {
+            response = createErrorResponse("batch", "Batches cannot be nested", "INVALID_PARAMETER");
+        } else {
+            json command = commands[i];
+            if (command.contains("params") && !dase::resolveBatchReferences(command["params"], responses, error)) {
+                response = createErrorResponse(command.value("command", ""), error, "INVALID_REFERENCE");
+            } else {
+                response = batch_runner_ ? batch_runner_(command, response_segments_)
+                                         : execute(command, response_segments_);
+            }
+        }
 
-    // Compute additional diagnostics
-    double phi_rms = 0.0, h_rms = 0.0, total_energy = 0.0;
-    size_t num_nodes = phi.size();
-
-    // Get engine for energy computation
-    if (auto* instance = engine_manager->getEngine(engine_id)) {
-        if (instance->engine_type == "satp_higgs_1d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
-            total_energy = engine->computeTotalEnergy();
-        } else if (instance->engine_type == "satp_higgs_2d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
-            total_energy = engine->computeTotalEnergy();
-        } else if (instance->engine_type == "satp_higgs_3d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
-            total_energy = engine->computeTotalEnergy();
+        const bool ok = response.value("status", "") == "success";
+        if (!ok) {
+            failed++;
+        }
+        if (mode == "all" || (mode == "failures" && !ok)) {
+            json entry = response;
+            entry["index"] = i;
+            returned.push_back(std::move(entry));
+        }
+        responses.push_back(std::move(response));
+        if (!ok && stop_on_error) {
+            break;
         }
     }
-
-    for (size_t i = 0; i < num_nodes; i++) {
-        phi_rms += phi[i] * phi[i];
-        h_rms += h[i] * h[i];
+    if (mode == "last" && !responses.empty()) {
+        json entry = responses.back();
+        entry["index"] = responses.size() - 1;
+        returned.push_back(std::move(entry));
     }
 
-    // Guard against division by zero (should not occur, but defensive)
-    if (num_nodes > 0) {
-        phi_rms = std::sqrt(phi_rms / static_cast<double>(num_nodes));
-        h_rms = std::sqrt(h_rms / static_cast<double>(num_nodes));
+    json result = {
+        {"count", commands.size()},
+        {"executed", responses.size()},
+        {"failed", failed},
+        {"results", std::move(returned)}
+    };
+    json response = createSuccessResponse("batch", result, 0);
+    if (failed > 0) {
+        response["status"] = "error";
+        response["error"] = std::to_string(failed) + " batch command(s) failed";
+        response["error_code"] = "BATCH_FAILED";
     }
+    return response;
+}
 
-    // Return state arrays with diagnostics
-    json result = {
-        {"num_nodes", num_nodes},
-        {"phi", phi},
-        {"phi_dot", phi_dot},
-        {"h", h},
-        {"h_dot", h_dot},
-        {"diagnostics", {
-            {"phi_rms", phi_rms},
-            {"h_rms", h_rms},
-            {"total_energy", total_energy}
-        }}
+json CommandRouter::handleRunGraph(const json& params) {
+    // Required: nodes ([{id, command, params, depends_on, threads,
+    //           memory_mb}], see mission_graph.h)
+    // Optional: max_concurrent (0 = no limit), max_threads (thread tokens,
+    //           default the process thread budget), max_memory_mb (memory
+    //           hints running at once, default the memory budget; 0 =
+    //           unlimited), stop_on_error (default true), return (all or
+    //           failures)
+    // Commands confined to the engines they name run beside each other;
+    // every other command runs alone.  Node responses carry state arrays
+    // as plain JSON, since nodes answer concurrently.
+    static const std::set<std::string> kConcurrentCommands = {
+        "create_engine", "destroy_engine", "run_mission", "run_steps", "run_mission_adaptive",
+        "get_metrics", "get_state", "get_satp_state", "get_state_digest", "get_node_state",
+        "set_node_state", "set_igsoa_state", "set_satp_state", "get_center_of_mass",
+        "checkpoint_engine", "restore_engine", "reset_engine"
     };
+    const std::string mode = params.value("return", std::string("all"));
+    if (mode != "all" && mode != "failures") {
+        return createErrorResponse("run_graph", "'return' must be all or failures", "INVALID_PARAMETER");
+    }
 
-    if (auto* instance = engine_manager->getEngine(engine_id)) {
-        result["engine_type"] = instance->engine_type;
-        if (instance->engine_type == "satp_higgs_1d") {
-            result["time"] = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle)->getTime();
-        } else if (instance->engine_type == "satp_higgs_2d") {
-            result["time"] = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle)->getTime();
-        } else if (instance->engine_type == "satp_higgs_3d") {
-            result["time"] = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->getTime();
-        } else {
-            result["time"] = 0.0;
+    dase::MissionGraph graph;
+    std::string error;
+    const auto concurrent = [](const std::string& name) { return kConcurrentCommands.count(name) > 0; };
+    if (!graph.build(params.value("nodes", json()), concurrent, error)) {
+        return createErrorResponse("run_graph", error, "INVALID_PARAMETER");
+    }
+    for (const auto& node : graph.nodes()) {
+        const std::string name = node.command["command"].get<std::string>();
+        if (name == "run_graph" || name == "batch") {
+            return createErrorResponse("run_graph", "Node '" + node.id + "': graphs and batches cannot be nested",
+                                       "INVALID_PARAMETER");
         }
     }
 
-    return createSuccessResponse("get_satp_state", result, 0);
+    dase::MissionGraphLimits limits;
+    limits.threads = params.value("max_threads", 0);
+    if (limits.threads <= 0) {
+        limits.threads = engine_manager->threadBudgetStats().value("capacity", 1);
+    }
+    limits.memory_bytes = params.contains("max_memory_mb")
+        ? static_cast<uint64_t>(params.value("max_memory_mb", 0.0) * 1024.0 * 1024.0)
+        : engine_manager->getMemoryBudget();
+    limits.max_concurrent = params.value("max_concurrent", size_t(0));
+    limits.stop_on_error = params.value("stop_on_error", true);
+
+    // Nodes answer on their own threads: none may append to the segments
+    // of this response
+    dase::protocol::Segments* const segments = response_segments_;
+    response_segments_ = nullptr;
+    const auto t0 = std::chrono::steady_clock::now();
+    std::vector<json> responses = graph.run([this](const dase::MissionGraphNode&, const json& command) {
+        return batch_runner_ ? batch_runner_(command, nullptr) : execute(command, nullptr);
+    }, limits);
+    const double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    response_segments_ = segments;
+
+    json returned = json::array();
+    for (auto& response : responses) {
+        if (mode == "all" || response.value("status", "") != "success") {
+            returned.push_back(std::move(response));
+        }
+    }
+    json order = json::array();
+    for (size_t i : graph.order()) {
+        order.push_back(graph.nodes()[i].id);
+    }
+    const auto stats = graph.lastStats();
+    json result = {
+        {"count", graph.nodes().size()},
+        {"executed", stats.executed},
+        {"failed", stats.failed},
+        {"skipped", stats.skipped},
+        {"wall_s", wall_s},
+        {"threads", limits.threads},
+        {"peak_running", stats.peak_running},
+        {"peak_threads", stats.peak_threads},
+        {"peak_memory_mb", static_cast<double>(stats.peak_memory_bytes) / (1024.0 * 1024.0)},
+        {"order", std::move(order)},
+        {"results", std::move(returned)}
+    };
+    json response = createSuccessResponse("run_graph", result, 0);
+    if (stats.failed > 0) {
+        response["status"] = "error";
+        response["error"] = std::to_string(stats.failed) + " graph node(s) failed";
+        response["error_code"] = "GRAPH_FAILED";
+    }
+    return response;
 }
 
 json CommandRouter::handleGetCenterOfMass(const json& params) {
@@ -1165,6 +4746,71 @@ json CommandRouter::handleSidCollapse(const json& params) {
     return createSuccessResponse("sid_collapse", result, 0);
 }
 
+json CommandRouter::handleSidBatch(const json& params) {
+    if (!params.contains("engine_ids") || !params["engine_ids"].is_array()) {
+        return createErrorResponse("sid_batch", "Missing engine_ids array", "MISSING_PARAMETER");
+    }
+    std::vector<std::string> engine_ids;
+    for (const auto& id : params["engine_ids"]) {
+        if (!id.is_string()) {
+            return createErrorResponse("sid_batch", "engine_ids must be strings", "INVALID_PARAMETER");
+        }
+        engine_ids.push_back(id.get<std::string>());
+    }
+
+    // op: "step", "collapse", "step_collapse" (a step then a collapse per
+    // round) or "metrics" (read only)
+    const std::string op = params.value("op", "step");
+    if (op != "step" && op != "collapse" && op != "step_collapse" && op != "metrics") {
+        return createErrorResponse("sid_batch",
+                                   "op must be step, collapse, step_collapse or metrics",
+                                   "INVALID_PARAMETER");
+    }
+    double alpha = params.value("alpha", 0.0);
+    int64_t steps = params.value("steps", int64_t(1));
+    if (steps < 0) {
+        return createErrorResponse("sid_batch", "steps must be non-negative", "INVALID_PARAMETER");
+    }
+
+    std::vector<EngineManager::SidBatchEntry> entries;
+    std::string error;
+    const bool step = op == "step" || op == "step_collapse";
+    const bool collapse = op == "collapse" || op == "step_collapse";
+    if (!engine_manager->sidBatchRun(engine_ids, step, collapse, alpha, static_cast<uint64_t>(steps),
+                                     entries, error)) {
+        return createErrorResponse("sid_batch", error, "EXECUTION_FAILED");
+    }
+
+    // Column per quantity, row i = engine_ids[i]
+    json I_mass = json::array();
+    json N_mass = json::array();
+    json U_mass = json::array();
+    json gain = json::array();
+    json step_count = json::array();
+    json conserved = json::array();
+    for (const auto& entry : entries) {
+        I_mass.push_back(entry.I_mass);
+        N_mass.push_back(entry.N_mass);
+        U_mass.push_back(entry.U_mass);
+        gain.push_back(entry.instantaneous_gain);
+        step_count.push_back(entry.step_count);
+        conserved.push_back(entry.is_conserved);
+    }
+    json result = {
+        {"engine_ids", engine_ids},
+        {"op", op},
+        {"alpha", alpha},
+        {"steps", steps},
+        {"I_mass", I_mass},
+        {"N_mass", N_mass},
+        {"U_mass", U_mass},
+        {"instantaneous_gain", gain},
+        {"step_count", step_count},
+        {"is_conserved", conserved}
+    };
+    return createSuccessResponse("sid_batch", result, 0);
+}
+
 json CommandRouter::handleSidRewrite(const json& params) {
     std::string engine_id = params.value("engine_id", "");
     std::string pattern = params.value("pattern", "");
@@ -1224,8 +4870,25 @@ json CommandRouter::handleSidRunRewrites(const json& params) {
     }
 
     std::string policy = params.value("policy", "P1");
+    // "sweep": apply every rule per pass over the whole diagram until a pass
+    // applies nothing; "worklist": sid_ssp fixpoint that re-tries only rules
+    // that could match where the last rewrite changed the diagram;
+    // "parallel" / "parallel_batch": search all rules concurrently each
+    // round, apply the best match / a maximal non-overlapping set;
+    // "network": the rewrites of "parallel", picked from a match network
+    // kept up to date where each rewrite changed the diagram
+    std::string mode = params.value("mode", "sweep");
+    if (mode != "sweep" && mode != "worklist" && mode != "parallel" && mode != "parallel_batch" &&
+        mode != "network") {
+        return createErrorResponse("sid_run_rewrites",
+                                   "mode must be 'sweep', 'worklist', 'parallel', 'parallel_batch' or 'network'",
+                                   "INVALID_PARAMETER");
+    }
     uint64_t horizon_cap = params.value("horizon_cap", static_cast<uint64_t>(1000));
     uint64_t seed = params.value("seed", static_cast<uint64_t>(42));
+    // Sweep only: stop once the diagram returns to a state it had earlier in
+    // this run (same canonical hash), instead of looping to the horizon
+    bool detect_cycles = params.value("detect_cycles", false);
 
     auto* inst = engine_manager->getEngine(engine_id);
     if (!inst) {
@@ -1239,45 +4902,106 @@ json CommandRouter::handleSidRunRewrites(const json& params) {
     bool horizon_hit = false;
 
     auto build_order = [&](size_t n, const std::string& pol, std::mt19937& gen) {
-        std::vector<size_t> idx(n);
-        std::iota(idx.begin(), idx.end(), 0);
-        if (pol == "P2") {
-            std::reverse(idx.begin(), idx.end());
-        } else if (pol == "P3") {
-            std::shuffle(idx.begin(), idx.end(), gen);
-        }
-        // P4/P5 placeholders map to lex for now
-        return idx;
+        return sid::buildRuleOrder(n, pol, gen);  // P4/P5 placeholders map to lex for now
     };
 
+    // Parse every rule once up front; the horizon loop applies handles
+    struct PreparedRule {
+        std::string rule_id;
+        nlohmann::json rule_metadata;
+        int64_t handle = -1;   // -1: ill-formed, skipped
+    };
+    std::vector<PreparedRule> prepared(rules.size());
+    for (size_t rule_idx = 0; rule_idx < rules.size(); ++rule_idx) {
+        const auto& rule = rules[rule_idx];
+        std::string pattern = rule.value("pattern", "");
+        std::string replacement = rule.value("replacement", "");
+        prepared[rule_idx].rule_id = rule.value("rule_id", "rw_" + std::to_string(rule_idx));
+        prepared[rule_idx].rule_metadata = rule.value("rule_metadata", nlohmann::json::object());
+
+        if (pattern.empty() || replacement.empty()) {
+            continue;  // skip ill-formed rule silently
+        }
+
+        std::string message;
+        if (!engine_manager->sidCompileRule(engine_id, pattern, replacement, prepared[rule_idx].rule_id,
+                                            prepared[rule_idx].handle, message)) {
+            return createErrorResponse("sid_run_rewrites", "Rewrite application failed (engine/rule invalid)", "EXECUTION_FAILED");
+        }
+    }
+
     std::vector<std::string> applied_trace;
-    while (steps < horizon_cap) {
+    if (mode != "sweep") {
+        std::vector<int64_t> handles;
+        std::vector<size_t> rule_of_handle;
+        for (size_t rule_idx = 0; rule_idx < prepared.size(); ++rule_idx) {
+            if (prepared[rule_idx].handle >= 0) {
+                handles.push_back(prepared[rule_idx].handle);
+                rule_of_handle.push_back(rule_idx);
+            }
+        }
+
+        std::vector<size_t> trace;
+        std::string message;
+        if (!engine_manager->sidRunFixpoint(engine_id, mode, handles, policy, horizon_cap, seed,
+                                            trace, horizon_hit, message)) {
+            return createErrorResponse("sid_run_rewrites", "Rewrite application failed (engine/rule invalid)", "EXECUTION_FAILED");
+        }
+        // Only applications are logged: these modes have no per-rule attempts
+        for (size_t handle_idx : trace) {
+            const PreparedRule& rule = prepared[rule_of_handle[handle_idx]];
+            engine_manager->recordSidRewriteEvent(engine_id, rule.rule_id, true,
+                                                  "Rewrite " + rule.rule_id + " applied", rule.rule_metadata);
+            applied_trace.push_back(rule.rule_id);
+        }
+        steps = applied_total = static_cast<uint64_t>(trace.size());
+    }
+
+    // Canonical diagram hash -> step it was first seen at
+    std::unordered_map<uint64_t, uint64_t> seen_states;
+    bool cycle_found = false;
+    uint64_t cycle_start = 0;
+    if (mode == "sweep" && detect_cycles) {
+        uint64_t hash = 0;
+        if (!engine_manager->sidDiagramHash(engine_id, hash)) {
+            return createErrorResponse("sid_run_rewrites", "detect_cycles needs a sid_ternary engine", "INVALID_PARAMETER");
+        }
+        seen_states.emplace(hash, 0);
+    }
+
+    while (mode == "sweep" && steps < horizon_cap && !cycle_found) {
         auto order = build_order(rules.size(), policy, rng);
         bool applied_pass = false;
 
         for (size_t rule_idx : order) {
-            const auto& rule = rules[rule_idx];
-            std::string pattern = rule.value("pattern", "");
-            std::string replacement = rule.value("replacement", "");
-            std::string rule_id = rule.value("rule_id", "rw_" + std::to_string(rule_idx));
-            nlohmann::json rule_metadata = rule.value("rule_metadata", nlohmann::json::object());
-
-            if (pattern.empty() || replacement.empty()) {
-                continue;  // skip ill-formed rule silently
+            const PreparedRule& rule = prepared[rule_idx];
+            if (rule.handle < 0) {
+                continue;
             }
+            const std::string& rule_id = rule.rule_id;
 
             bool applied = false;
             std::string message;
-            if (!engine_manager->sidApplyRewrite(engine_id, pattern, replacement, rule_id, rule_metadata, applied, message)) {
+            if (!engine_manager->sidApplyCompiledRule(engine_id, rule.handle, applied, message)) {
                 return createErrorResponse("sid_run_rewrites", "Rewrite application failed (engine/rule invalid)", "EXECUTION_FAILED");
             }
-            engine_manager->recordSidRewriteEvent(engine_id, rule_id, applied, message, rule_metadata);
+            engine_manager->recordSidRewriteEvent(engine_id, rule_id, applied, message, rule.rule_metadata);
 
             if (applied) {
                 applied_pass = true;
                 applied_total++;
                 applied_trace.push_back(rule_id);
                 steps++;
+                if (detect_cycles) {
+                    uint64_t hash = 0;
+                    engine_manager->sidDiagramHash(engine_id, hash);
+                    auto inserted = seen_states.emplace(hash, steps);
+                    if (!inserted.second) {
+                        cycle_found = true;
+                        cycle_start = inserted.first->second;
+                        break;
+                    }
+                }
                 if (steps >= horizon_cap) {
                     horizon_hit = true;
                     break;
@@ -1291,10 +5015,10 @@ json CommandRouter::handleSidRunRewrites(const json& params) {
     }
 
     // Compute simple metrics (active nodes + total mass) from state.
-    std::vector<double> psi_r, psi_i, field;
     double active_nodes = 0.0;
     double total_mass = 0.0;
-    if (engine_manager->getAllNodeStates(engine_id, psi_r, psi_i, field)) {
+    if (const auto* state = engine_manager->extractAllNodeStates(engine_id)) {
+        const std::vector<double>& field = state->fields[2];
         for (double v : field) {
             if (std::abs(v) > 1e-12) active_nodes += 1.0;
             total_mass += v;
@@ -1308,16 +5032,21 @@ json CommandRouter::handleSidRunRewrites(const json& params) {
     json result = {
         {"engine_id", engine_id},
         {"policy", policy},
+        {"mode", mode},
         {"steps", steps},
         {"horizon_hit", horizon_hit},
         {"rules_applied", applied_total},
-        {"termination", horizon_hit ? "horizon" : "fixed_point"},
+        {"termination", cycle_found ? "cycle" : (horizon_hit ? "horizon" : "fixed_point")},
         {"applied_trace", applied_trace},
         {"metrics", {
             {"active_nodes", active_nodes},
             {"total_mass", total_mass}
         }}
     };
+    if (cycle_found) {
+        // The state after step `first_step` recurred after `steps`
+        result["cycle"] = {{"first_step", cycle_start}, {"period", steps - cycle_start}};
+    }
     return createSuccessResponse("sid_run_rewrites", result, 0);
 }
 
@@ -1516,7 +5245,7 @@ json CommandRouter::handleSidGetDiagramJson(const json& params) {
 
 json CommandRouter::handleSidRewriteEvents(const json& params) {
     std::string engine_id = params.value("engine_id", "");
-    size_t cursor = static_cast<size_t>(params.value("cursor", 0));
+    uint64_t cursor = params.value("cursor", static_cast<uint64_t>(0));
     size_t limit = static_cast<size_t>(params.value("limit", 100));
 
     if (engine_id.empty()) {
@@ -1524,7 +5253,9 @@ json CommandRouter::handleSidRewriteEvents(const json& params) {
     }
 
     std::vector<EngineManager::SidRewriteEvent> events;
-    if (!engine_manager->getSidRewriteEvents(engine_id, cursor, limit, events)) {
+    uint64_t next_cursor = 0;
+    json log;
+    if (!engine_manager->getSidRewriteEvents(engine_id, cursor, limit, events, next_cursor, log)) {
         return createErrorResponse("sid_rewrite_events", "Unable to fetch rewrite events", "EXECUTION_FAILED");
     }
 
@@ -1540,15 +5271,36 @@ json CommandRouter::handleSidRewriteEvents(const json& params) {
         });
     }
 
+    // A cursor older than first_event_id lost events the log dropped
     json result = {
         {"engine_id", engine_id},
         {"events", ev_json},
-        {"next_cursor", cursor + ev_json.size()}
+        {"next_cursor", next_cursor},
+        {"first_event_id", log["first_event_id"]},
+        {"dropped", cursor < log["first_event_id"].get<uint64_t>()}
     };
 
     return createSuccessResponse("sid_rewrite_events", result, 0);
 }
 
+json CommandRouter::handleSidRewriteLog(const json& params) {
+    std::string engine_id = params.value("engine_id", "");
+    if (engine_id.empty()) {
+        return createErrorResponse("sid_rewrite_log", "Missing engine_id", "MISSING_PARAMETER");
+    }
+
+    json log;
+    std::string error;
+    if (!engine_manager->configureSidRewriteLog(engine_id, params, log, error)) {
+        if (error.empty()) {
+            return createErrorResponse("sid_rewrite_log", "Engine has no rewrite event log", "INVALID_ENGINE");
+        }
+        return createErrorResponse("sid_rewrite_log", error, "INVALID_PARAMETER");
+    }
+    log["engine_id"] = engine_id;
+    return createSuccessResponse("sid_rewrite_log", log, 0);
+}
+
 json CommandRouter::handleSidWrapperApplyMotion(const json& params) {
     std::string engine_id = params.value("engine_id", "");
     size_t max_events = static_cast<size_t>(params.value("max_events", 0));
@@ -1606,8 +5358,8 @@ json CommandRouter::handleSidWrapperMetrics(const json& params) {
 // ANALYSIS COMMANDS
 // ============================================================================
 
-json CommandRouter::handleCheckAnalysisTools(const json& /*params*/) {
-    json result = analysis_router_->checkToolAvailability();
+json CommandRouter::handleCheckAnalysisTools(const json& params) {
+    json result = analysisRouter().checkToolAvailability(params.value("refresh", false));
     return createSuccessResponse("check_analysis_tools", result, 0);
 }
 
@@ -1632,7 +5384,8 @@ json CommandRouter::handlePythonAnalyze(const json& params) {
     }
 
     try {
-        auto result_data = analysis_router_->quickPythonAnalysis(engine_id, script, args);
+        auto result_data = analysisRouter().quickPythonAnalysis(engine_id, script, args,
+                                                                 params.value("persistent", true));
 
         json result = {
             {"success", result_data.success},
@@ -1663,7 +5416,7 @@ json CommandRouter::handleEngineFFT(const json& params) {
     }
 
     try {
-        auto fft_result = analysis_router_->quickFFT(engine_id, field);
+        auto fft_result = analysisRouter().quickFFT(engine_id, field);
         json result = dase::analysis::EngineFFTAnalysis::toJSON(fft_result);
 
         return createSuccessResponse("engine_fft", result, fft_result.execution_time_ms);
@@ -1690,6 +5443,8 @@ json CommandRouter::handleAnalyzeFields(const json& params) {
         analysis_type = dase::AnalysisType::JULIA_EFA_ONLY;
     } else if (analysis_type_str == "engine") {
         analysis_type = dase::AnalysisType::ENGINE_ONLY;
+    } else if (analysis_type_str == "matched_filter") {
+        analysis_type = dase::AnalysisType::MATCHED_FILTER;
     } else {
         analysis_type = dase::AnalysisType::COMBINED_ALL;
     }
@@ -1697,6 +5452,7 @@ json CommandRouter::handleAnalyzeFields(const json& params) {
     // Build configuration
     dase::AnalysisConfig config;
     config.type = analysis_type;
+    config.matched_filter.enabled = analysis_type == dase::AnalysisType::MATCHED_FILTER;
 
     if (params.contains("config")) {
         const auto& cfg = params["config"];
@@ -1710,6 +5466,7 @@ json CommandRouter::handleAnalyzeFields(const json& params) {
                 }
             }
             config.python.output_dir = cfg["python"].value("output_dir", "analysis_output");
+            config.python.persistent = cfg["python"].value("persistent", true);
 
             if (cfg["python"].contains("args")) {
                 for (auto& [key, value] : cfg["python"]["args"].items()) {
@@ -1729,6 +5486,10 @@ json CommandRouter::handleAnalyzeFields(const json& params) {
         if (cfg.contains("engine")) {
             config.engine.enabled = cfg["engine"].value("enabled", false);
             config.engine.compute_fft = cfg["engine"].value("compute_fft", false);
+            config.engine.compute_statistics = cfg["engine"].value("compute_statistics", false);
+            config.engine.find_peaks = cfg["engine"].value("find_peaks", false);
+            config.engine.n_peaks = cfg["engine"].value("n_peaks", size_t(10));
+            config.engine.peak_threshold = cfg["engine"].value("peak_threshold", 0.01);
 
             if (cfg["engine"].contains("fields_to_analyze")) {
                 for (const auto& field : cfg["engine"]["fields_to_analyze"]) {
@@ -1737,11 +5498,33 @@ json CommandRouter::handleAnalyzeFields(const json& params) {
             }
         }
 
+        // Matched-filter search
+        if (cfg.contains("matched_filter")) {
+            const auto& mf = cfg["matched_filter"];
+            config.matched_filter.enabled = mf.value("enabled", config.matched_filter.enabled);
+            if (mf.contains("templates")) {
+                config.matched_filter.templates = mf["templates"].get<std::vector<std::vector<double>>>();
+            }
+            if (mf.contains("series")) {
+                config.matched_filter.series = mf["series"].get<std::vector<double>>();
+            }
+            config.matched_filter.probe_id = mf.value("probe_id", 0);
+            config.matched_filter.channel = mf.value("channel", size_t(0));
+            config.matched_filter.block_size = mf.value("block_size", size_t(0));
+            config.matched_filter.include_series = mf.value("include_series", false);
+            auto& filter = config.matched_filter.filter;
+            filter.detrend = mf.value("detrend", filter.detrend);
+            filter.noise_sigma = mf.value("noise_sigma", filter.noise_sigma);
+            filter.sample_interval = mf.value("sample_interval", filter.sample_interval);
+            filter.n_peaks = mf.value("n_peaks", filter.n_peaks);
+            filter.min_snr = mf.value("min_snr", filter.min_snr);
+        }
+
         config.enable_cross_validation = cfg.value("enable_cross_validation", true);
     }
 
     try {
-        auto combined_result = analysis_router_->routeAnalysis(engine_id, config);
+        auto combined_result = analysisRouter().routeAnalysis(engine_id, config);
 
         json result = {
             {"success", combined_result.success},
@@ -1787,6 +5570,26 @@ json CommandRouter::handleAnalyzeFields(const json& params) {
                 {"executed", true},
                 {"fft_results", fft_results}
             };
+            if (!combined_result.engine.statistics.empty()) {
+                json statistics = json::array();
+                for (const auto& stats : combined_result.engine.statistics) {
+                    statistics.push_back(dase::analysis::EngineFFTAnalysis::toJSON(stats));
+                }
+                result["engine"]["statistics"] = statistics;
+            }
+            if (!combined_result.engine.field_peaks.empty()) {
+                json peaks = json::object();
+                for (const auto& [field, field_peaks] : combined_result.engine.field_peaks) {
+                    peaks[field] = dase::analysis::EngineFFTAnalysis::toJSON(field_peaks);
+                }
+                result["engine"]["field_peaks"] = peaks;
+            }
+        }
+
+        if (combined_result.matched_filter.executed) {
+            result["matched_filter"] = dase::analysis::MatchedFilterBank::toJSON(
+                combined_result.matched_filter.result, config.matched_filter.include_series);
+            result["matched_filter"]["executed"] = true;
         }
 
         // Add validation results
@@ -1805,6 +5608,28 @@ json CommandRouter::handleAnalyzeFields(const json& params) {
     }
 }
 
+void CommandRouter::recycleSegments(dase::protocol::Segments& segments) {
+    engine_manager->bufferPool().releaseAll(segments);
+}
+
+json CommandRouter::stateArray(std::vector<double>& values) {
+    return stateArray(values, response_segments_);
+}
+
+json CommandRouter::stateArray(std::vector<double>& values, dase::protocol::Segments* segments, bool float32) {
+    if (!segments) {
+        return json(values);
+    }
+    const size_t index = segments->size();
+    const size_t count = values.size();
+    segments->push_back(std::move(values));
+    json reference = dase::protocol::segmentReference(index, count);
+    if (float32) {
+        reference["precision"] = "f32";
+    }
+    return reference;
+}
+
 json CommandRouter::createSuccessResponse(const std::string& command,
                                                  const json& result,
                                                  double execution_time_ms) {
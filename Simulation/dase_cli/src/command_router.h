@@ -8,8 +8,14 @@
 #include <map>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "json.hpp"
 #include "analysis_router.h"
+#include "binary_protocol.h"
+#include "job_manager.h"
+#include "router_stats.h"
 
 // Forward declarations
 class EngineManager;
@@ -21,8 +27,53 @@ public:
     CommandRouter();
     ~CommandRouter();
 
-    // Execute a JSON command and return JSON response
-    json execute(const json& command);
+    // Execute a JSON command and return JSON response.  With `segments`
+    // (binary protocol), large state arrays are appended there and the
+    // response carries segment references in their place.
+    // `request_segments` are the request frame's segments, left unexpanded
+    // for commands that take them directly (readsRequestSegments).
+    json execute(const json& command, dase::protocol::Segments* segments = nullptr,
+                 const dase::protocol::Segments* request_segments = nullptr);
+
+    // Hand a written response's segments back to the extraction buffer
+    // pool (extraction_buffers.h) so the next state read reuses them;
+    // clears `segments`
+    void recycleSegments(dase::protocol::Segments& segments);
+
+    // Whether `command` reads segment references of its request itself
+    // (binary mode then skips expandSegments and passes the segments along)
+    static bool readsRequestSegments(const std::string& command);
+
+    // Receiver of intermediate messages (streamed snapshots) sent before a
+    // command's final response; `segments` is non-empty in binary mode only.
+    // Segments the sink leaves in place are recycled after it returns.
+    using StreamSink = std::function<void(const json& message, dase::protocol::Segments& segments)>;
+    void setStreamSink(StreamSink sink) { stream_sink_ = std::move(sink); }
+
+    // Runs each command of a batch in place of execute() (server sessions
+    // use it to apply their ownership checks per command)
+    using BatchRunner = std::function<json(const json& command, dase::protocol::Segments* segments)>;
+    void setBatchRunner(BatchRunner runner) { batch_runner_ = std::move(runner); }
+
+    // Transport timings of a command execute() just ran (parse before it,
+    // serialize after); see router_stats.h
+    void recordTransport(const std::string& command, uint64_t parse_ns, uint64_t serialize_ns,
+                         uint64_t bytes_in, uint64_t bytes_out) {
+        stats_.recordTransport(command, parse_ns, serialize_ns, bytes_in, bytes_out);
+    }
+    void recordParseError(uint64_t bytes_in) { stats_.recordParseError(bytes_in); }
+
+    // get_router_stats result (whole table)
+    json routerStats() const { return stats_.toJson(); }
+
+    // Names warmup() accepts: "phase4b" (engine library), "fftw" (wisdom
+    // and planner threads), "analysis" (analysis router and tool probes)
+    static bool isWarmupTarget(const std::string& name);
+
+    // Initialize `targets` on a background thread (once per router) so the
+    // first command that needs them does not pay for it; commands may run
+    // meanwhile.  Throws std::invalid_argument for an unknown name.
+    void warmup(const std::vector<std::string>& targets);
 
 private:
     // Command handlers
@@ -36,15 +87,62 @@ private:
     json handleSetIgsoaState(const json& params);
     json handleSetSatpState(const json& params);
     json handleRunMission(const json& params);
+    json handleRunEnsemble(const json& params);
     json handleRunSteps(const json& params);
+    json handleCancelMission(const json& params);
     json handleRunMissionWithSnapshots(const json& params);
+    json handleRunMissionAdaptive(const json& params);
     json handleRunBenchmark(const json& params);
+    json handleRunScalingStudy(const json& params);
+    json handleRunSweep(const json& params);
+    json handleRunPipeline(const json& params);
     json handleGetMetrics(const json& params);
     json handleGetState(const json& params);
     json handleGetSatpState(const json& params);
+    json handleGetStateDigest(const json& params);
+    json handleGetEnsembleState(const json& params);
+    json handleSetEnsembleState(const json& params);
+    json handleMapState(const json& params);
+    json handleUnmapState(const json& params);
+    json handleBufferState(const json& params);
+    json handleReadSnapshot(const json& params);
+    json handleUnbufferState(const json& params);
+    json handleSubscribeMetrics(const json& params);
+    json handleUnsubscribeMetrics(const json& params);
+    json handleAddProbe(const json& params);
+    json handleDrainProbe(const json& params);
+    json handleRemoveProbe(const json& params);
+    json handleAddObservable(const json& params);
+    json handleDrainObservable(const json& params);
+    json handleRemoveObservable(const json& params);
+    json handleAddTrigger(const json& params);
+    json handleRemoveTrigger(const json& params);
+    json handleAddSpectralMonitor(const json& params);
+    json handleGetSpectrum(const json& params);
+    json handleRemoveSpectralMonitor(const json& params);
+    json handleTraceStart(const json& params);
+    json handleTraceStop(const json& params);
+    json handleGetRouterStats(const json& params);
+    json handleCheckpointEngine(const json& params);
+    json handleRestoreEngine(const json& params);
+    json handleCloneEngine(const json& params);
+    json handleResetEngine(const json& params);
+    json handleSetEnginePool(const json& params);
+    json handleSetMemoryBudget(const json& params);
+    json handleSetThreadBudget(const json& params);
+    json handleSetThreadLimit(const json& params);
+    json handleGetMemoryUsage(const json& params);
+    json handleSubmitMission(const json& params);
+    json handleJobStatus(const json& params);
+    json handleJobWait(const json& params);
+    json handleJobCancel(const json& params);
+    json handleListJobs(const json& params);
+    json handleBatch(const json& params);
+    json handleRunGraph(const json& params);
     json handleGetCenterOfMass(const json& params);
     json handleSidStep(const json& params);
     json handleSidCollapse(const json& params);
+    json handleSidBatch(const json& params);
     json handleSidRewrite(const json& params);
     json handleSidMetrics(const json& params);
     json handleSidSetDiagramExpr(const json& params);
@@ -52,6 +150,7 @@ private:
     json handleSidGetDiagramJson(const json& params) = delete;
     json handleSidRunRewrites(const json& params);
     json handleSidRewriteEvents(const json& params);
+    json handleSidRewriteLog(const json& params);
     json handleSidWrapperApplyMotion(const json& params);
     json handleSidWrapperMetrics(const json& params);
 
@@ -61,6 +160,9 @@ private:
     json handleEngineFFT(const json& params);
     json handleAnalyzeFields(const json& params);
 
+    // Analysis router, built on first call (thread-safe)
+    dase::AnalysisRouter& analysisRouter();
+
     // Helper to create success response
     json createSuccessResponse(const std::string& command,
                                      const json& result,
@@ -71,10 +173,40 @@ private:
                                    const std::string& error,
                                    const std::string& error_code);
 
+    // State array as JSON, or as a reference into the response segments
+    // while a binary-protocol command runs (moves the values out);
+    // `float32` tags values already rounded to float32
+    json stateArray(std::vector<double>& values);
+    json stateArray(std::vector<double>& values, dase::protocol::Segments* segments, bool float32 = false);
+
+    // The "arrays" profile of set_igsoa_state / set_satp_state: resolve each
+    // field's source (typed_array_input.h) and write it into the engine.
+    // `field_origins` receives {field: origin}.
+    bool setStateFromArrays(const std::string& engine_id, const json& arrays,
+                            const std::vector<std::string>& family,
+                            json& field_origins, std::string& error);
+
     // Engine manager (manages engine lifecycle)
     std::unique_ptr<EngineManager> engine_manager;
+    // Built on first use by analysisRouter() (finds the worker script)
     std::unique_ptr<dase::AnalysisRouter> analysis_router_;
+    std::once_flag analysis_router_once_;
+    // Declared after engine_manager so jobs stop before engines go away
+    std::unique_ptr<dase::JobManager> job_manager_;
 
     // Command registry
     std::map<std::string, std::function<json(const json&)>> command_handlers;
+
+    // Segments of the binary-protocol response being built, if any
+    dase::protocol::Segments* response_segments_ = nullptr;
+    // Unexpanded segments of the binary-protocol request being run, if any
+    const dase::protocol::Segments* request_segments_ = nullptr;
+
+    StreamSink stream_sink_;
+    BatchRunner batch_runner_;
+
+    dase::RouterStats stats_;
+
+    // Runs warmup(); joined by the destructor before any member goes away
+    std::thread warmup_thread_;
 };
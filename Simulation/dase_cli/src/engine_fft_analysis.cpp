@@ -6,9 +6,12 @@
 #include <cmath>
 #include <algorithm>
 #include <chrono>
+#include <stdexcept>
 
 #ifdef USE_FFTW3
 #include <fftw3.h>
+#include "fft_plan_cache.h"
+#include "../../src/cpp/reproducible_sum.h"
 #endif
 
 #ifndef M_PI
@@ -18,6 +21,94 @@
 namespace dase {
 namespace analysis {
 
+namespace {
+
+// Spectra smaller than this are processed on one thread
+constexpr size_t kParallelMinSamples = size_t(1) << 15;
+
+#ifdef USE_FFTW3
+/**
+ * One fused pass over a 2D / 3D r2c output: total power, DC, peak and the
+ * radial profile (shells from the plan cache), with per-thread shell sums
+ * merged at the end.  Of equal peaks the lowest index wins, as serially.
+ */
+void spectrumPass(FFTResult& result, FFTPlanCache::Lease& lease) {
+    const fftw_complex* out = lease.output();
+    const auto& shells = lease.radialBins();
+    const long long count = static_cast<long long>(lease.outputSize());
+    const size_t num_shells = shells.count.size();
+
+    std::vector<double> shell_power(num_shells, 0.0);
+    double total_power = 0.0;
+    double peak_power = -1.0;
+    long long peak_index = 0;
+
+    #pragma omp parallel if (static_cast<size_t>(count) >= kParallelMinSamples)
+    {
+        std::vector<double> local_shells(num_shells, 0.0);
+        double local_total = 0.0;
+        double local_peak = -1.0;
+        long long local_index = 0;
+
+        #pragma omp for schedule(static) nowait
+        for (long long i = 0; i < count; ++i) {
+            const double power = out[i][0] * out[i][0] + out[i][1] * out[i][1];
+            local_total += power;
+            local_shells[shells.bin[i]] += power;
+            if (i > 0 && power > local_peak) {
+                local_peak = power;
+                local_index = i;
+            }
+        }
+
+        #pragma omp critical
+        {
+            total_power += local_total;
+            for (size_t b = 0; b < num_shells; ++b) {
+                shell_power[b] += local_shells[b];
+            }
+            if (local_peak > peak_power || (local_peak == peak_power && local_index < peak_index)) {
+                peak_power = local_peak;
+                peak_index = local_index;
+            }
+        }
+    }
+
+    result.total_power = total_power;
+    result.dc_component = std::sqrt(out[0][0] * out[0][0] + out[0][1] * out[0][1]);
+    result.peak_magnitude = peak_power > 0.0 ? std::sqrt(peak_power) : 0.0;
+
+    // Peak frequency in cycles per sample, signed wavenumbers per axis
+    const std::vector<int>& dims = lease.dims();
+    double f_sq = 0.0;
+    if (peak_power > 0.0) {
+        size_t rest = static_cast<size_t>(peak_index);
+        const size_t half = static_cast<size_t>(dims.back()) / 2 + 1;
+        const double f_last = static_cast<double>(rest % half) / dims.back();
+        f_sq = f_last * f_last;
+        rest /= half;
+        for (size_t axis = dims.size() - 1; axis-- > 0;) {
+            const int n = dims[axis];
+            const int c = static_cast<int>(rest % static_cast<size_t>(n));
+            rest /= static_cast<size_t>(n);
+            const double f = static_cast<double>(c > n / 2 ? c - n : c) / n;
+            f_sq += f * f;
+        }
+    }
+    result.peak_frequency = std::sqrt(f_sq);
+
+    const double max_extent = static_cast<double>(*std::max_element(dims.begin(), dims.end()));
+    for (size_t b = 0; b < num_shells; ++b) {
+        if (shells.count[b] > 0) {
+            result.radial_k.push_back(static_cast<double>(b) / max_extent);
+            result.radial_power.push_back(shell_power[b] / static_cast<double>(shells.count[b]));
+        }
+    }
+}
+#endif // USE_FFTW3
+
+} // namespace
+
 FFTResult EngineFFTAnalysis::compute1DFFT(
     const std::vector<double>& field_data,
     const std::string& field_name
@@ -48,18 +139,11 @@ FFTResult EngineFFTAnalysis::compute1DFFT(
     result.N_z = 1;
     result.field_name = field_name;
 
-    // Allocate FFTW arrays
-    double* in = fftw_alloc_real(result.N);
-    fftw_complex* out = fftw_alloc_complex(result.N / 2 + 1);
-
-    // Copy input data
-    for (size_t i = 0; i < result.N; ++i) {
-        in[i] = field_data[i];
-    }
-
-    // Create plan and execute
-    fftw_plan plan = fftw_plan_dft_r2c_1d(static_cast<int>(result.N), in, out, FFTW_ESTIMATE);
-    fftw_execute(plan);
+    // Cached plan and aligned buffers for this length
+    auto lease = FFTPlanCache::acquireR2C({static_cast<int>(result.N)});
+    std::copy(field_data.begin(), field_data.begin() + result.N, lease.input());
+    lease.execute();
+    const fftw_complex* out = lease.output();
 
     // Process results
     size_t half_N = result.N / 2 + 1;
@@ -68,22 +152,26 @@ FFTResult EngineFFTAnalysis::compute1DFFT(
     result.magnitude.resize(half_N);
     result.phase.resize(half_N);
 
-    result.total_power = 0.0;
     result.peak_magnitude = 0.0;
     result.peak_frequency = 0.0;
 
-    for (size_t i = 0; i < half_N; ++i) {
-        double re = out[i][0];
-        double im = out[i][1];
+    // Fused pass: every per-bin quantity from one read of the output; the
+    // total power is summed in fixed blocks (same bits for any thread count)
+    const int64_t bins = static_cast<int64_t>(half_N);
+    result.total_power = reproducibleSum(bins, [&](int64_t i) {
+        const double re = out[i][0];
+        const double im = out[i][1];
+        const double power = re * re + im * im;
 
-        result.magnitude[i] = std::sqrt(re * re + im * im);
-        result.power_spectrum[i] = result.magnitude[i] * result.magnitude[i];
+        result.power_spectrum[i] = power;
+        result.magnitude[i] = std::sqrt(power);
         result.phase[i] = std::atan2(im, re);
         result.frequencies[i] = static_cast<double>(i) / static_cast<double>(result.N);
+        return power;
+    }, half_N >= kParallelMinSamples);
 
-        result.total_power += result.power_spectrum[i];
-
-        if (i > 0 && result.magnitude[i] > result.peak_magnitude) {
+    for (size_t i = 1; i < half_N; ++i) {
+        if (result.magnitude[i] > result.peak_magnitude) {
             result.peak_magnitude = result.magnitude[i];
             result.peak_frequency = result.frequencies[i];
         }
@@ -91,11 +179,6 @@ FFTResult EngineFFTAnalysis::compute1DFFT(
 
     result.dc_component = result.magnitude[0];
 
-    // Cleanup
-    fftw_destroy_plan(plan);
-    fftw_free(in);
-    fftw_free(out);
-
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     result.execution_time_ms = duration.count();
@@ -136,61 +219,17 @@ FFTResult EngineFFTAnalysis::compute2DFFT(
     result.N_z = 1;
     result.field_name = field_name;
 
-    // Allocate FFTW arrays
-    double* in = fftw_alloc_real(result.N);
-    fftw_complex* out = fftw_alloc_complex(N_x * (N_y / 2 + 1));
-
-    // Copy input data
-    for (size_t i = 0; i < result.N; ++i) {
-        in[i] = field_data[i];
+    if (field_data.size() < result.N) {
+        throw std::runtime_error("Field has fewer values than its dimensions");
     }
 
-    // Create plan and execute
-    fftw_plan plan = fftw_plan_dft_r2c_2d(
-        static_cast<int>(N_y),
-        static_cast<int>(N_x),
-        in,
-        out,
-        FFTW_ESTIMATE
-    );
-    fftw_execute(plan);
-
-    // Process results - store full spectrum
-    std::vector<std::complex<double>> fft_complex;
-    size_t out_size = N_x * (N_y / 2 + 1);
-    fft_complex.reserve(out_size);
-
-    result.total_power = 0.0;
-    result.peak_magnitude = 0.0;
-    result.peak_frequency = 0.0;
+    // Cached plan and aligned buffers for this shape
+    auto lease = FFTPlanCache::acquireR2C({static_cast<int>(N_y), static_cast<int>(N_x)});
+    std::copy(field_data.begin(), field_data.begin() + result.N, lease.input());
+    lease.execute();
 
-    for (size_t i = 0; i < out_size; ++i) {
-        std::complex<double> val(out[i][0], out[i][1]);
-        fft_complex.push_back(val);
-
-        double mag = std::abs(val);
-        if (i > 0 && mag > result.peak_magnitude) {
-            result.peak_magnitude = mag;
-            // Compute k_x, k_y for peak
-            size_t ix = i % N_x;
-            size_t iy = i / N_x;
-            double kx = static_cast<double>(ix) / static_cast<double>(N_x);
-            double ky = static_cast<double>(iy) / static_cast<double>(N_y);
-            result.peak_frequency = std::sqrt(kx * kx + ky * ky);
-        }
-
-        result.total_power += mag * mag;
-    }
-
-    result.dc_component = std::abs(fft_complex[0]);
-
-    // Compute radial profile
-    computeRadialProfile2D(result, fft_complex, N_x, N_y);
-
-    // Cleanup
-    fftw_destroy_plan(plan);
-    fftw_free(in);
-    fftw_free(out);
+    // Power, peak and radial profile in one pass
+    spectrumPass(result, lease);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -233,56 +272,18 @@ FFTResult EngineFFTAnalysis::compute3DFFT(
     result.N_z = N_z;
     result.field_name = field_name;
 
-    // Allocate FFTW arrays
-    double* in = fftw_alloc_real(result.N);
-    fftw_complex* out = fftw_alloc_complex(N_x * N_y * (N_z / 2 + 1));
-
-    // Copy input data
-    for (size_t i = 0; i < result.N; ++i) {
-        in[i] = field_data[i];
-    }
-
-    // Create plan and execute
-    fftw_plan plan = fftw_plan_dft_r2c_3d(
-        static_cast<int>(N_z),
-        static_cast<int>(N_y),
-        static_cast<int>(N_x),
-        in,
-        out,
-        FFTW_ESTIMATE
-    );
-    fftw_execute(plan);
-
-    // Process results
-    std::vector<std::complex<double>> fft_complex;
-    size_t out_size = N_x * N_y * (N_z / 2 + 1);
-    fft_complex.reserve(out_size);
-
-    result.total_power = 0.0;
-    result.peak_magnitude = 0.0;
-    result.peak_frequency = 0.0;
-
-    for (size_t i = 0; i < out_size; ++i) {
-        std::complex<double> val(out[i][0], out[i][1]);
-        fft_complex.push_back(val);
-
-        double mag = std::abs(val);
-        if (i > 0 && mag > result.peak_magnitude) {
-            result.peak_magnitude = mag;
-        }
-
-        result.total_power += mag * mag;
+    if (field_data.size() < result.N) {
+        throw std::runtime_error("Field has fewer values than its dimensions");
     }
 
-    result.dc_component = std::abs(fft_complex[0]);
-
-    // Compute radial profile
-    computeRadialProfile3D(result, fft_complex, N_x, N_y, N_z);
+    // Cached plan and aligned buffers for this shape (threaded when large)
+    auto lease = FFTPlanCache::acquireR2C(
+        {static_cast<int>(N_z), static_cast<int>(N_y), static_cast<int>(N_x)});
+    std::copy(field_data.begin(), field_data.begin() + result.N, lease.input());
+    lease.execute();
 
-    // Cleanup
-    fftw_destroy_plan(plan);
-    fftw_free(in);
-    fftw_free(out);
+    // Power, peak and radial profile in one pass
+    spectrumPass(result, lease);
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
@@ -292,116 +293,186 @@ FFTResult EngineFFTAnalysis::compute3DFFT(
 #endif // USE_FFTW3
 }
 
-#ifdef USE_FFTW3
-void EngineFFTAnalysis::computeRadialProfile2D(
-    FFTResult& result,
-    const std::vector<std::complex<double>>& fft_data,
-    size_t N_x,
-    size_t N_y
+std::vector<std::pair<double, double>> EngineFFTAnalysis::findPeaks(
+    const FFTResult& result,
+    size_t n_peaks,
+    double threshold
 ) {
-    // Compute maximum radius
-    size_t max_radius = static_cast<size_t>(
-        std::sqrt(static_cast<double>(N_x * N_x + N_y * N_y)) / 2.0
-    ) + 1;
-
-    std::vector<double> radial_sum(max_radius, 0.0);
-    std::vector<size_t> radial_count(max_radius, 0);
-
-    // Bin by radius
-    for (size_t iy = 0; iy < N_y / 2 + 1; ++iy) {
-        for (size_t ix = 0; ix < N_x; ++ix) {
-            size_t idx = iy * N_x + ix;
-            if (idx >= fft_data.size()) continue;
-
-            // Compute radius
-            double kx = static_cast<double>(ix);
-            double ky = static_cast<double>(iy);
-            if (ix > N_x / 2) kx = static_cast<double>(ix) - static_cast<double>(N_x);
-
-            double k_radius = std::sqrt(kx * kx + ky * ky);
-            size_t bin = static_cast<size_t>(k_radius);
-
-            if (bin < max_radius) {
-                double power = std::abs(fft_data[idx]) * std::abs(fft_data[idx]);
-                radial_sum[bin] += power;
-                radial_count[bin]++;
-            }
-        }
+    std::vector<std::pair<double, double>> peaks;
+
+    if (result.magnitude.empty()) {
+        return peaks;
     }
 
-    // Average and store
-    for (size_t i = 0; i < max_radius; ++i) {
-        if (radial_count[i] > 0) {
-            result.radial_k.push_back(static_cast<double>(i) / std::max(N_x, N_y));
-            result.radial_power.push_back(radial_sum[i] / radial_count[i]);
+    double max_mag = result.peak_magnitude;
+    double min_threshold = max_mag * threshold;
+
+    // Create pairs of (frequency, magnitude) above threshold
+    std::vector<std::pair<double, double>> all_peaks;
+    const long long bins = static_cast<long long>(result.magnitude.size());
+    #pragma omp parallel if (result.magnitude.size() >= kParallelMinSamples)
+    {
+        std::vector<std::pair<double, double>> local;
+        #pragma omp for schedule(static) nowait
+        for (long long i = 1; i < bins; ++i) {
+            if (result.magnitude[i] > min_threshold) {
+                local.push_back({result.frequencies[i], result.magnitude[i]});
+            }
         }
+        #pragma omp critical
+        all_peaks.insert(all_peaks.end(), local.begin(), local.end());
     }
+
+    // Top n_peaks by magnitude (descending); equal magnitudes by frequency,
+    // so the merge order of the threads does not matter
+    size_t count = (std::min)(n_peaks, all_peaks.size());
+    std::partial_sort(all_peaks.begin(), all_peaks.begin() + count, all_peaks.end(),
+        [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+    peaks.insert(peaks.end(), all_peaks.begin(), all_peaks.begin() + count);
+
+    return peaks;
 }
 
-void EngineFFTAnalysis::computeRadialProfile3D(
-    FFTResult& result,
-    const std::vector<std::complex<double>>& fft_data,
-    size_t N_x,
-    size_t N_y,
-    size_t N_z
+FieldStatistics EngineFFTAnalysis::computeStatistics(
+    const std::vector<double>& field_data,
+    const std::string& field_name
 ) {
-    // Similar to 2D but with 3D radius
-    size_t max_radius = static_cast<size_t>(
-        std::sqrt(static_cast<double>(N_x * N_x + N_y * N_y + N_z * N_z)) / 2.0
-    ) + 1;
-
-    std::vector<double> radial_sum(max_radius, 0.0);
-    std::vector<size_t> radial_count(max_radius, 0);
-
-    // Simplified binning (full implementation would iterate over all 3D indices)
-    // For now, just compute from available data
-    size_t max_N = std::max({N_x, N_y, N_z});
-    for (size_t i = 0; i < fft_data.size() && i < max_radius; ++i) {
-        double power = std::abs(fft_data[i]) * std::abs(fft_data[i]);
-        radial_sum[i] += power;
-        radial_count[i]++;
+    FieldStatistics stats;
+    stats.field_name = field_name;
+    stats.N = field_data.size();
+    if (field_data.empty()) {
+        return stats;
     }
 
-    for (size_t i = 0; i < max_radius; ++i) {
-        if (radial_count[i] > 0) {
-            result.radial_k.push_back(static_cast<double>(i) / max_N);
-            result.radial_power.push_back(radial_sum[i] / radial_count[i]);
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    stats.min = field_data[0];
+    stats.max = field_data[0];
+    for (size_t i = 0; i < field_data.size(); ++i) {
+        const double v = field_data[i];
+        sum += v;
+        sum_sq += v * v;
+        if (v < stats.min) {
+            stats.min = v;
+            stats.argmin = i;
+        }
+        if (v > stats.max) {
+            stats.max = v;
+            stats.argmax = i;
         }
     }
+    const double n = static_cast<double>(field_data.size());
+    stats.mean = sum / n;
+    stats.energy = sum_sq;
+    stats.rms = std::sqrt(sum_sq / n);
+
+    // Second pass about the mean: no cancellation for large offsets
+    double centered = 0.0;
+    for (double v : field_data) {
+        const double d = v - stats.mean;
+        centered += d * d;
+    }
+    stats.variance = centered / n;
+    stats.std_dev = std::sqrt(stats.variance);
+    return stats;
 }
-#endif // USE_FFTW3
 
-std::vector<std::pair<double, double>> EngineFFTAnalysis::findPeaks(
-    const FFTResult& result,
+std::vector<FieldPeak> EngineFFTAnalysis::findFieldPeaks(
+    const std::vector<double>& field_data,
+    size_t N_x,
+    size_t N_y,
+    size_t N_z,
     size_t n_peaks,
     double threshold
 ) {
-    std::vector<std::pair<double, double>> peaks;
-
-    if (result.magnitude.empty()) {
+    std::vector<FieldPeak> peaks;
+    N_x = (std::max)(N_x, size_t(1));
+    N_y = (std::max)(N_y, size_t(1));
+    N_z = (std::max)(N_z, size_t(1));
+    if (field_data.empty() || field_data.size() != N_x * N_y * N_z) {
         return peaks;
     }
 
-    double max_mag = result.peak_magnitude;
-    double min_threshold = max_mag * threshold;
-
-    // Create pairs of (frequency, magnitude)
-    std::vector<std::pair<double, double>> all_peaks;
-    for (size_t i = 1; i < result.magnitude.size(); ++i) {
-        if (result.magnitude[i] > min_threshold) {
-            all_peaks.push_back({result.frequencies[i], result.magnitude[i]});
+    const double max_value = *std::max_element(field_data.begin(), field_data.end());
+    const bool use_threshold = max_value > 0.0;
+    const double min_value = max_value * threshold;
+    const size_t dims[3] = {N_x, N_y, N_z};
+    const size_t strides[3] = {1, N_x, N_x * N_y};
+
+    for (size_t z = 0; z < N_z; ++z) {
+        for (size_t y = 0; y < N_y; ++y) {
+            for (size_t x = 0; x < N_x; ++x) {
+                const size_t coord[3] = {x, y, z};
+                const size_t index = x + N_x * (y + N_y * z);
+                const double v = field_data[index];
+                if (use_threshold && v < min_value) {
+                    continue;
+                }
+
+                bool is_peak = true;
+                for (int axis = 0; axis < 3 && is_peak; ++axis) {
+                    if (dims[axis] < 2) {
+                        continue;
+                    }
+                    const size_t base = index - coord[axis] * strides[axis];
+                    const size_t prev = base + ((coord[axis] + dims[axis] - 1) % dims[axis]) * strides[axis];
+                    const size_t next = base + ((coord[axis] + 1) % dims[axis]) * strides[axis];
+                    // Strict against lower indices, >= against higher ones:
+                    // one peak per plateau
+                    for (size_t neighbour : {prev, next}) {
+                        if (neighbour == index) continue;
+                        const double w = field_data[neighbour];
+                        if (neighbour < index ? !(v > w) : !(v >= w)) {
+                            is_peak = false;
+                            break;
+                        }
+                    }
+                }
+                if (is_peak) {
+                    peaks.push_back({index, x, y, z, v});
+                }
+            }
         }
     }
 
-    // Sort by magnitude (descending)
-    std::sort(all_peaks.begin(), all_peaks.end(),
-        [](const auto& a, const auto& b) { return a.second > b.second; });
+    std::sort(peaks.begin(), peaks.end(),
+        [](const FieldPeak& a, const FieldPeak& b) { return a.value > b.value; });
+    if (peaks.size() > n_peaks) {
+        peaks.resize(n_peaks);
+    }
+    return peaks;
+}
 
-    // Take top n_peaks
-    size_t count = (std::min)(n_peaks, all_peaks.size());
-    peaks.insert(peaks.end(), all_peaks.begin(), all_peaks.begin() + count);
+nlohmann::json EngineFFTAnalysis::toJSON(const FieldStatistics& stats) {
+    return {
+        {"field_name", stats.field_name},
+        {"N", stats.N},
+        {"mean", stats.mean},
+        {"variance", stats.variance},
+        {"std_dev", stats.std_dev},
+        {"min", stats.min},
+        {"max", stats.max},
+        {"argmin", stats.argmin},
+        {"argmax", stats.argmax},
+        {"rms", stats.rms},
+        {"energy", stats.energy}
+    };
+}
 
-    return peaks;
+nlohmann::json EngineFFTAnalysis::toJSON(const std::vector<FieldPeak>& peaks) {
+    nlohmann::json j = nlohmann::json::array();
+    for (const auto& peak : peaks) {
+        j.push_back({
+            {"index", peak.index},
+            {"x", peak.x},
+            {"y", peak.y},
+            {"z", peak.z},
+            {"value", peak.value}
+        });
+    }
+    return j;
 }
 
 nlohmann::json EngineFFTAnalysis::toJSON(const FFTResult& result) {
@@ -6,6 +6,8 @@
  * - Frequency domain analysis
  * - Peak detection in k-space
  * - Radial averaging for 2D/3D
+ * - Field statistics and real-space peak finding (no FFTW3 needed), so
+ *   analyze_fields can answer common questions without leaving the process
  */
 
 #pragma once
@@ -42,6 +44,27 @@ struct FFTResult {
     double execution_time_ms;
 };
 
+struct FieldStatistics {
+    std::string field_name;
+    size_t N = 0;
+    double mean = 0.0;
+    double variance = 0.0;                // Population variance (numpy.var)
+    double std_dev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    size_t argmin = 0;
+    size_t argmax = 0;
+    double rms = 0.0;
+    double energy = 0.0;                  // Sum of squares
+};
+
+// Local maximum of a field on the lattice
+struct FieldPeak {
+    size_t index;                         // Flattened (row-major, x fastest)
+    size_t x, y, z;
+    double value;
+};
+
 class EngineFFTAnalysis {
 public:
     /**
@@ -103,30 +126,42 @@ public:
     );
 
     /**
-     * Export FFT result to JSON
-     *
-     * @param result FFT result
-     * @return JSON representation
+     * Mean, variance, extrema, RMS and energy of a field in one pass
+     * (plus one for the variance)
      */
-    static nlohmann::json toJSON(const FFTResult& result);
-
-private:
-    // Radial averaging helper for 2D
-    static void computeRadialProfile2D(
-        FFTResult& result,
-        const std::vector<std::complex<double>>& fft_data,
-        size_t N_x,
-        size_t N_y
+    static FieldStatistics computeStatistics(
+        const std::vector<double>& field_data,
+        const std::string& field_name
     );
 
-    // Radial averaging helper for 3D
-    static void computeRadialProfile3D(
-        FFTResult& result,
-        const std::vector<std::complex<double>>& fft_data,
+    /**
+     * Find local maxima of a field on an N_x x N_y x N_z periodic lattice
+     *
+     * A node is a peak if it exceeds its axis neighbours (of a plateau, the
+     * lowest-index node counts) and, for a positive field maximum, is at
+     * least threshold * max.
+     *
+     * @return Up to n_peaks peaks, highest first
+     */
+    static std::vector<FieldPeak> findFieldPeaks(
+        const std::vector<double>& field_data,
         size_t N_x,
         size_t N_y,
-        size_t N_z
+        size_t N_z,
+        size_t n_peaks = 10,
+        double threshold = 0.01
     );
+
+    static nlohmann::json toJSON(const FieldStatistics& stats);
+    static nlohmann::json toJSON(const std::vector<FieldPeak>& peaks);
+
+    /**
+     * Export FFT result to JSON
+     *
+     * @param result FFT result
+     * @return JSON representation
+     */
+    static nlohmann::json toJSON(const FFTResult& result);
 };
 
 } // namespace analysis
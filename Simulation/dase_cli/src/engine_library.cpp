@@ -0,0 +1,162 @@
+/**
+ * Engine Library Implementation
+ */
+
+#include "engine_library.h"
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <climits>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+#endif
+
+namespace dase {
+
+namespace {
+
+#ifdef _WIN32
+const char kPathSeparators[] = "\\/";
+#else
+const char kPathSeparators[] = "/";
+#endif
+
+} // namespace
+
+EngineLibrary::~EngineLibrary() {
+    close();
+}
+
+std::vector<std::string> EngineLibrary::candidateNames(KernelISA best_isa, bool has_avx2_fma) {
+    std::vector<std::string> names;
+    if (!has_avx2_fma) {
+        return names;
+    }
+    if (best_isa == KernelISA::AVX512) {
+        names.push_back("dase_engine_phase4b_avx512");
+    }
+    names.push_back("dase_engine_phase4b_avx2");
+    names.push_back("dase_engine_phase4b");
+    names.push_back("dase_engine");
+    return names;
+}
+
+std::string EngineLibrary::fileName(const std::string& base_name) {
+#if defined(_WIN32)
+    return base_name + ".dll";
+#elif defined(__APPLE__)
+    return "lib" + base_name + ".dylib";
+#else
+    return "lib" + base_name + ".so";
+#endif
+}
+
+std::string EngineLibrary::executableDirectory() {
+    std::string exe;
+#if defined(_WIN32)
+    char buffer[MAX_PATH];
+    const DWORD length = GetModuleFileNameA(nullptr, buffer, MAX_PATH);
+    if (length > 0 && length < MAX_PATH) {
+        exe.assign(buffer, length);
+    }
+#elif defined(__APPLE__)
+    char buffer[PATH_MAX];
+    uint32_t size = sizeof(buffer);
+    if (_NSGetExecutablePath(buffer, &size) == 0) {
+        exe = buffer;
+    }
+#else
+    char buffer[PATH_MAX];
+    const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+    if (length > 0) {
+        exe.assign(buffer, static_cast<size_t>(length));
+    }
+#endif
+    const size_t slash = exe.find_last_of(kPathSeparators);
+    return slash == std::string::npos ? std::string() : exe.substr(0, slash + 1);
+}
+
+bool EngineLibrary::open() {
+    close();
+    std::string errors;
+
+    const char* override_path = std::getenv("DASE_ENGINE_LIBRARY");
+    if (override_path && *override_path) {
+        if (openFile(override_path)) {
+            return true;
+        }
+        errors += error_;
+    }
+
+    const std::vector<std::string> names =
+        candidateNames(CPUFeatures::bestKernelISA(), CPUFeatures::hasAVX2() && CPUFeatures::hasFMA());
+    if (names.empty()) {
+        errors += "CPU lacks AVX2/FMA, which every engine build requires\n";
+    }
+    const std::string directory = executableDirectory();
+    for (const std::string& name : names) {
+        const std::string file = fileName(name);
+        if (!directory.empty() && openFile(directory + file)) {
+            return true;
+        }
+        if (openFile(file)) {
+            return true;
+        }
+        errors += error_;
+    }
+
+    error_ = errors;
+    return false;
+}
+
+bool EngineLibrary::openFile(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HMODULE module = LoadLibraryA(path.c_str());
+    if (!module) {
+        error_ = path + ": LoadLibrary failed with error code " + std::to_string(GetLastError()) + "\n";
+        return false;
+    }
+    handle_ = reinterpret_cast<void*>(module);
+#else
+    handle_ = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle_) {
+        const char* reason = dlerror();
+        error_ = path + ": " + (reason ? reason : "dlopen failed") + "\n";
+        return false;
+    }
+#endif
+    path_ = path;
+    error_.clear();
+    return true;
+}
+
+void EngineLibrary::close() {
+    if (handle_) {
+#ifdef _WIN32
+        FreeLibrary(reinterpret_cast<HMODULE>(handle_));
+#else
+        dlclose(handle_);
+#endif
+        handle_ = nullptr;
+    }
+    path_.clear();
+}
+
+void* EngineLibrary::symbol(const char* name) const {
+    if (!handle_) {
+        return nullptr;
+    }
+#ifdef _WIN32
+    return reinterpret_cast<void*>(GetProcAddress(reinterpret_cast<HMODULE>(handle_), name));
+#else
+    return dlsym(handle_, name);
+#endif
+}
+
+} // namespace dase
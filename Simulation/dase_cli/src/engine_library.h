@@ -0,0 +1,70 @@
+/**
+ * Engine Library - Portable loading of the DASE engine shared library
+ *
+ * The phase4b engine lives in a separately built shared library (the
+ * add_engine_dll targets) that the CLI opens at runtime: LoadLibraryA /
+ * GetProcAddress on Windows, dlopen / dlsym on Linux and macOS.  open()
+ * tries, best first:
+ *
+ *   1. $DASE_ENGINE_LIBRARY, an explicit path
+ *   2. the per-ISA builds this CPU can run, chosen from CPUID:
+ *      dase_engine_phase4b_avx512 (x86-64-v3 + AVX-512F), then
+ *      dase_engine_phase4b_avx2 (x86-64-v3)
+ *   3. the host builds dase_engine_phase4b, then dase_engine
+ *
+ * Each base name gets the platform's decoration (dase_engine.dll,
+ * libdase_engine.so, libdase_engine.dylib) and is looked for next to the
+ * executable first, then on the loader's search path.  Every engine build
+ * needs AVX2 + FMA (AVX2Math), so on CPUs without them nothing but an
+ * explicit $DASE_ENGINE_LIBRARY is tried.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "../../src/cpp/cpu_features.h"
+
+namespace dase {
+
+class EngineLibrary {
+public:
+    EngineLibrary() = default;
+    ~EngineLibrary();
+    EngineLibrary(const EngineLibrary&) = delete;
+    EngineLibrary& operator=(const EngineLibrary&) = delete;
+
+    // Base names to try for a CPU with these features, best first
+    static std::vector<std::string> candidateNames(KernelISA best_isa, bool has_avx2_fma);
+
+    // "dase_engine" -> "dase_engine.dll" / "libdase_engine.so" / "libdase_engine.dylib"
+    static std::string fileName(const std::string& base_name);
+
+    // Directory of the running executable with a trailing separator ("" if unknown)
+    static std::string executableDirectory();
+
+    // Open the best library for this host; false (see error()) if none loads
+    bool open();
+
+    // Open one library by path or loader-searched name
+    bool openFile(const std::string& path);
+
+    void close();
+    bool isOpen() const { return handle_ != nullptr; }
+
+    // Exported symbol, or null
+    void* symbol(const char* name) const;
+
+    // Library that open() / openFile() loaded
+    const std::string& path() const { return path_; }
+
+    // Why the last open failed (one line per attempt)
+    const std::string& error() const { return error_; }
+
+private:
+    void* handle_ = nullptr;
+    std::string path_;
+    std::string error_;
+};
+
+} // namespace dase
@@ -4,20 +4,29 @@
  */
 
 #include "engine_manager.h"
+#include "engine_library.h"
 #include <chrono>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
 #include <stdexcept>
 #include <iostream>
+#include <cstddef>
 #include <cstdint>
 #include <algorithm>
 #include <complex>
 #include <atomic>
+#include <cstring>
+#include <limits>
+#include <mutex>
 
 // Lightweight FFT-backed engine using FFTW for validation coverage
 // FFTW headers (distributed with simulation)
 #include "../../fftw3.h"
+#include "../../src/cpp/engine_checkpoint.h"
+#include "../../src/cpp/fftw_plan_registry.hpp"
+#include "../../src/cpp/probe_recorder.h"
+#include "../../src/cpp/trace_zones.h"
 struct FFTWCacheExampleEngine {
     explicit FFTWCacheExampleEngine(size_t nodes)
         : num_nodes(nodes),
@@ -25,7 +34,7 @@ struct FFTWCacheExampleEngine {
           buffer(nullptr),
           plan_forward(nullptr),
           plan_inverse(nullptr) {
-        buffer = reinterpret_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * num_nodes));
+        buffer = dase::FFTPlanRegistry::allocComplex(num_nodes);
         if (!buffer) {
             throw std::runtime_error("Failed to allocate FFT buffer");
         }
@@ -35,44 +44,31 @@ struct FFTWCacheExampleEngine {
                 buffer[i][0] = (i == 0) ? 1.0 : 0.0;
                 buffer[i][1] = 0.0;
             }
-            plan_forward = fftw_plan_dft_1d(static_cast<int>(num_nodes), buffer, buffer, FFTW_FORWARD, FFTW_ESTIMATE);
-            plan_inverse = fftw_plan_dft_1d(static_cast<int>(num_nodes), buffer, buffer, FFTW_BACKWARD, FFTW_ESTIMATE);
-            if (!plan_forward || !plan_inverse) {
-                throw std::runtime_error("Failed to create FFTW plans");
-            }
+            // Shared in-place plans from the process-wide registry
+            using dase::FFTPlanKey;
+            const int n = static_cast<int>(num_nodes);
+            plan_forward = dase::FFTPlanRegistry::acquire(
+                FFTPlanKey::make(FFTPlanKey::Kind::C2C, {n}, FFTW_FORWARD, true),
+                dase::FFTPlanRegistry::Planning::Estimate);
+            plan_inverse = dase::FFTPlanRegistry::acquire(
+                FFTPlanKey::make(FFTPlanKey::Kind::C2C, {n}, FFTW_BACKWARD, true),
+                dase::FFTPlanRegistry::Planning::Estimate);
         } catch (...) {
-            if (plan_forward) {
-                fftw_destroy_plan(plan_forward);
-                plan_forward = nullptr;
-            }
-            if (plan_inverse) {
-                fftw_destroy_plan(plan_inverse);
-                plan_inverse = nullptr;
-            }
-            if (buffer) {
-                fftw_free(buffer);
-                buffer = nullptr;
-            }
+            dase::FFTPlanRegistry::release(buffer);
+            buffer = nullptr;
             throw;
         }
     }
 
     ~FFTWCacheExampleEngine() {
-        if (plan_forward) {
-            fftw_destroy_plan(plan_forward);
-        }
-        if (plan_inverse) {
-            fftw_destroy_plan(plan_inverse);
-        }
-        if (buffer) {
-            fftw_free(buffer);
-        }
+        // Plans belong to the registry
+        dase::FFTPlanRegistry::release(buffer);
     }
 
     void runMission(int num_steps) {
         for (int i = 0; i < num_steps; ++i) {
-            fftw_execute(plan_forward);
-            fftw_execute(plan_inverse);
+            fftw_execute_dft(plan_forward, buffer, buffer);
+            fftw_execute_dft(plan_inverse, buffer, buffer);
         // Rough op count: ~5*N*log2(N) per transform; forward+inverse doubles it
         const double logN = std::log2(static_cast<double>(num_nodes));
         const double ops_per_step = 10.0 * static_cast<double>(num_nodes) * logN;
@@ -106,6 +102,21 @@ struct FFTWCacheExampleEngine {
         }
     }
 
+    // Sections fftw_cache.buffer (c128) and fftw_cache.counters u64 [total_operations]
+    void saveCheckpoint(dase::CheckpointWriter& writer) const {
+        writer.add("fftw_cache.buffer", dase::CheckpointType::C128, buffer, sizeof(fftw_complex), num_nodes);
+        writer.addValues("fftw_cache.counters", {total_operations});
+    }
+
+    void restoreCheckpoint(const dase::CheckpointImage& image) {
+        const void* saved = image.data("fftw_cache.buffer", dase::CheckpointType::C128,
+                                       sizeof(fftw_complex), num_nodes);
+        uint64_t counters[1] = {};
+        image.readU64("fftw_cache.counters", counters, 1);
+        std::memcpy(buffer, saved, sizeof(fftw_complex) * num_nodes);
+        total_operations = counters[0];
+    }
+
     size_t num_nodes;
     uint64_t total_operations;
     fftw_complex* buffer;
@@ -114,9 +125,11 @@ struct FFTWCacheExampleEngine {
 };
 
 // Include IGSOA engine directly (header-only)
+#include "../../src/cpp/igsoa_bulk_access.h"
 #include "../../src/cpp/igsoa_complex_engine.h"
 #include "../../src/cpp/igsoa_complex_engine_2d.h"
 #include "../../src/cpp/igsoa_complex_engine_3d.h"
+#include "../../src/cpp/igsoa_ensemble_engine.h"
 #include "../../src/cpp/igsoa_state_init_2d.h"
 #include "../../src/cpp/igsoa_state_init_3d.h"
 
@@ -130,12 +143,14 @@ struct FFTWCacheExampleEngine {
 #include "../../src/cpp/satp_higgs_engine_3d.h"
 #include "../../src/cpp/satp_higgs_physics_3d.h"
 #include "../../src/cpp/satp_higgs_state_init_3d.h"
+#include "../../src/cpp/satp_higgs_adaptive.h"
 #include "../../src/cpp/sid_ssp/sid_capi.hpp"
 
 // Include IGSOA GW engine modules
 #include "../../src/cpp/igsoa_gw_engine/core/symmetry_field.h"
 #include "../../src/cpp/igsoa_gw_engine/core/fractional_solver.h"
 #include "../../src/cpp/igsoa_gw_engine/core/source_manager.h"
+#include "../../src/cpp/igsoa_gw_engine/core/mesh_refinement.h"
 
 struct IGSOAGWEngine {
     explicit IGSOAGWEngine(const dase::igsoa::gw::SymmetryFieldConfig& field_config,
@@ -145,7 +160,8 @@ struct IGSOAGWEngine {
           solver(solver_config, field.getTotalPoints()),
           merger(merger_config),
           step_count(0),
-          total_operations(0) {
+          total_operations(0),
+          bound_alpha_revision(0) {
         double alpha = 0.5 * (field_config.alpha_min + field_config.alpha_max);
         for (int i = 0; i < field_config.nx; ++i) {
             for (int j = 0; j < field_config.ny; ++j) {
@@ -155,24 +171,87 @@ struct IGSOAGWEngine {
             }
         }
         second_derivs.assign(field.getTotalPoints(), std::complex<double>(0.0, 0.0));
+        solver.setPointAlphas(field.getAlphaFlat());
+        bound_alpha_revision = field.getAlphaRevision();
+    }
+
+    // Constructed state with new couplings; dt, and with it the solver's
+    // SOE kernels, is kept
+    void reset(double R_c, double kappa) {
+        const auto& config = field.getConfig();
+        field.reset(0.5 * (config.alpha_min + config.alpha_max), R_c, kappa);
+        solver.resetHistory();
+        solver.setPointAlphas(field.getAlphaFlat());
+        bound_alpha_revision = field.getAlphaRevision();
+        merger.reset();
+        std::fill(second_derivs.begin(), second_derivs.end(), std::complex<double>(0.0, 0.0));
+        step_count = 0;
+        total_operations = 0;
+        if (refinement) {
+            refinement->regrid(field, solver, refinementTags());
+        }
+    }
+
+    // Refined patches around the binary (nullptr or levels = 0: base grid only)
+    void setRefinement(const dase::igsoa::gw::MeshRefinementConfig& config) {
+        refinement.reset();
+        if (config.levels > 0) {
+            refinement.reset(new dase::igsoa::gw::MeshHierarchy(field, config));
+            refinement->regrid(field, solver, refinementTags());
+        }
+    }
+
+    std::vector<dase::igsoa::gw::Vector3D> refinementTags() const {
+        return {merger.getPosition1(), merger.getPosition2()};
     }
 
     void runMission(int num_steps) {
         const int total_points = field.getTotalPoints();
+        // Derivatives for the first step; later steps get them from the
+        // fused history pass
+        solver.computeDerivatives(frac_derivs);
         for (int step = 0; step < num_steps; ++step) {
+            DASE_TRACE_ZONE("gw.step");
             double t = field.getCurrentTime();
-            auto sources = merger.computeSourceTerms(field, t);
-            auto alpha_values = field.getAlphaValues();
-            auto frac_derivs = solver.computeDerivatives(alpha_values);
+            const auto& sources = merger.updateSourceTerms(field, t);
+            if (field.getAlphaRevision() != bound_alpha_revision) {
+                solver.setPointAlphas(field.getAlphaFlat());
+                bound_alpha_revision = field.getAlphaRevision();
+            }
+            if (refinement) {
+                refinement->regridIfNeeded(field, solver, refinementTags());
+                refinement->beginStep(field);
+            }
             field.evolveStep(frac_derivs, sources);
-            solver.updateHistory(field.getDeltaPhiFlat(), second_derivs, alpha_values, field.getTimestep());
+            solver.updateHistoryAndDerivatives(second_derivs, field.getTimestep(), frac_derivs);
+            if (refinement) {
+                // Patches subcycle to the new base time, then restrict into it
+                refinement->endStep(field, [this](const dase::igsoa::gw::SymmetryField& patch, double patch_t,
+                                                  std::vector<std::complex<double>>& out) {
+                    out = merger.computeSourceTerms(patch, patch_t);
+                });
+                total_operations += refinement->getPointUpdatesPerStep();
+            }
             merger.evolveOrbit(field.getTimestep());
             field.setCurrentTime(t + field.getTimestep());
             step_count++;
             total_operations += static_cast<uint64_t>(total_points);
+            recordProbes();
         }
     }
 
+    // Probe fields: 0 = Re δΦ, 1 = Im δΦ, 2 = α (points are flat grid indices)
+    static constexpr int kNumProbeFields = 3;
+
+    void recordProbes() {
+        if (!probes.active()) return;
+        const auto& delta_phi = field.getDeltaPhiFlat();
+        const auto& alpha = field.getAlphaFlat();
+        probes.record(step_count, [&](uint64_t i, int f) {
+            return f == 0 ? delta_phi[i].real() : (f == 1 ? delta_phi[i].imag() : alpha[i]);
+        });
+    }
+
     void getMetrics(double& ns_per_op, double& ops_per_sec, uint64_t& total_ops) const {
         total_ops = total_operations;
         double elapsed_seconds = field.getCurrentTime();
@@ -201,12 +280,72 @@ struct IGSOAGWEngine {
         }
     }
 
+    // Field, solver history and orbit sections, plus gw.second_derivs (c128)
+    // and gw.counters u64 [step_count, total_operations].  frac_derivs is
+    // recomputed at the start of every runMission.
+    void saveCheckpoint(dase::CheckpointWriter& writer) const {
+        field.saveCheckpoint(writer);
+        solver.saveCheckpoint(writer);
+        merger.saveCheckpoint(writer);
+        writer.add("gw.second_derivs", dase::CheckpointType::C128, second_derivs.data(),
+                   sizeof(std::complex<double>), second_derivs.size());
+        writer.addValues("gw.counters", {step_count, total_operations});
+    }
+
+    void restoreCheckpoint(const dase::CheckpointImage& image) {
+        const void* saved_derivs = image.data("gw.second_derivs", dase::CheckpointType::C128,
+                                              sizeof(std::complex<double>), second_derivs.size());
+        uint64_t counters[2] = {};
+        image.readU64("gw.counters", counters, 2);
+
+        field.restoreCheckpoint(image);
+        solver.setPointAlphas(field.getAlphaFlat());
+        bound_alpha_revision = field.getAlphaRevision();
+        solver.restoreCheckpoint(image);
+        merger.restoreCheckpoint(image);
+        std::memcpy(second_derivs.data(), saved_derivs, second_derivs.size() * sizeof(std::complex<double>));
+        step_count = counters[0];
+        total_operations = counters[1];
+        // Patches are not checkpointed; they are prolonged anew from the base
+        if (refinement) {
+            refinement->regrid(field, solver, refinementTags());
+        }
+    }
+
+    // Field grids (state), fractional history and detector series (history)
+    // and the per-step derivative buffers (scratch)
+    dase::MemoryFootprint memoryFootprint() const {
+        dase::MemoryFootprint bytes;
+        bytes.state = field.getMemoryUsage();
+        bytes.history = solver.getMemoryUsage() + probes.memoryBytes();
+        bytes.scratch = dase::capacityBytes(second_derivs) + dase::capacityBytes(frac_derivs);
+        if (refinement) {
+            bytes.state += refinement->getFieldMemoryUsage();
+            bytes.history += refinement->getHistoryMemoryUsage();
+        }
+        return bytes;
+    }
+
+    static dase::MemoryFootprint estimateMemory(const dase::igsoa::gw::SymmetryFieldConfig& field_config,
+                                                const dase::igsoa::gw::FractionalSolverConfig& solver_config) {
+        const uint64_t points = static_cast<uint64_t>(field_config.nx) * field_config.ny * field_config.nz;
+        dase::MemoryFootprint bytes;
+        bytes.state = dase::igsoa::gw::SymmetryField::estimateMemoryUsage(field_config);
+        bytes.history = dase::igsoa::gw::FractionalSolver::estimateMemoryUsage(solver_config, static_cast<int>(points));
+        bytes.scratch = 2 * points * sizeof(std::complex<double>);
+        return bytes;
+    }
+
     dase::igsoa::gw::SymmetryField field;
     dase::igsoa::gw::FractionalSolver solver;
     dase::igsoa::gw::BinaryMerger merger;
     std::vector<std::complex<double>> second_derivs;
+    std::vector<std::complex<double>> frac_derivs;  // ₀D^α_t δΦ for the next step
     uint64_t step_count;
     uint64_t total_operations;
+    uint64_t bound_alpha_revision;  // α revision last passed to solver.setPointAlphas
+    dase::ProbeRecorder probes;     // Detector time series (add_probe)
+    std::unique_ptr<dase::igsoa::gw::MeshHierarchy> refinement;  // Refined patches (setGWRefinement)
 };
 
 struct SidSSPEngine {
@@ -274,6 +413,25 @@ struct SidSSPEngine {
         return diagram_json;
     }
 
+    // Sections sid_ssp.field (f64), sid_ssp.counters u64 [ssp step,
+    // step_count, total_operations] and sid_ssp.diagram (text)
+    void saveCheckpoint(dase::CheckpointWriter& writer) const {
+        writer.addF64("sid_ssp.field", sid_ssp_field(ssp), field_len);
+        writer.addValues("sid_ssp.counters", {sid_ssp_step(ssp), step_count, total_operations});
+        writer.addText("sid_ssp.diagram", diagram_json);
+    }
+
+    void restoreCheckpoint(const dase::CheckpointImage& image) {
+        uint64_t counters[3] = {};
+        image.readU64("sid_ssp.counters", counters, 3);
+        std::string saved_diagram = image.text("sid_ssp.diagram");
+        image.readF64("sid_ssp.field", sid_ssp_field(ssp), field_len);
+        sid_ssp_restore_step(ssp, counters[0]);
+        step_count = counters[1];
+        total_operations = counters[2];
+        diagram_json = std::move(saved_diagram);
+    }
+
     sid_ssp_t* ssp;
     uint64_t field_len;
     uint64_t step_count;
@@ -281,69 +439,137 @@ struct SidSSPEngine {
     std::string diagram_json;
 };
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <dlfcn.h>
-#endif
-
 // Function pointer types for DASE API
 typedef void* (*CreateEngineFunc)(uint32_t);
 typedef void (*DestroyEngineFunc)(void*);
 typedef void (*RunMissionFunc)(void*, const double*, const double*, uint64_t, uint32_t);
 typedef void (*GetMetricsFunc)(void*, double*, double*, double*, uint64_t*);
 
-// DLL handle and function pointers
-static HMODULE dll_handle = nullptr;
+// Mirrors DaseEngineOptions (version 2) in src/cpp/dase_capi.h; version-1
+// DLLs are passed the version-1 struct_size when huge pages are off
+struct DaseEngineOptionsV2 {
+    uint32_t struct_size;
+    int32_t numa_first_touch;
+    int32_t numa_interleave;
+    int32_t thread_affinity;
+    int32_t huge_pages;
+};
+typedef int (*CreateEngineWithOptionsFunc)(uint32_t, const DaseEngineOptionsV2*, void**, char*, uint32_t);
+typedef uint64_t (*GetStatePageSizeFunc)(void*);
+// Mirrors DaseHardwareCounters in src/cpp/dase_capi.h
+struct DaseHardwareCountersV1 {
+    uint32_t struct_size;
+    int32_t valid;
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t llc_misses;
+    double ipc;
+    double dram_bandwidth_gbps;
+};
+typedef int (*EnableHardwareCountersFunc)(void*, int32_t);
+typedef int (*GetHardwareCountersFunc)(void*, DaseHardwareCountersV1*);
+typedef int (*RunEnsembleFunc)(void* const*, uint32_t, const double* const*, const double* const*, uint64_t, uint32_t);
+typedef int (*CheckpointEngineFunc)(void*, const char*, const char*, char*, uint32_t);
+typedef int (*RestoreEngineFunc)(void*, const char*, char*, uint32_t);
+typedef int (*CopyEngineStateFunc)(void*, void*, char*, uint32_t);
+typedef int (*ResetEngineFunc)(void*);
+typedef int (*SetThreadBudgetFunc)(int32_t);
+typedef int (*GetStateDigestFunc)(void*, double, uint64_t*);
+
+// Engine library and function pointers
+static dase::EngineLibrary engine_library;
 static CreateEngineFunc dase_create_engine = nullptr;
+static CreateEngineWithOptionsFunc dase_create_engine_with_options = nullptr;  // Optional (newer DLLs)
 static DestroyEngineFunc dase_destroy_engine = nullptr;
 static RunMissionFunc dase_run_mission_optimized_phase4c = nullptr;
+static RunEnsembleFunc dase_run_ensemble = nullptr;  // Optional (newer DLLs)
+static EnableHardwareCountersFunc dase_enable_hardware_counters = nullptr;  // Optional (newer DLLs)
+static GetHardwareCountersFunc dase_get_hardware_counters = nullptr;        // Optional (newer DLLs)
+static GetStatePageSizeFunc dase_get_state_page_size = nullptr;             // Optional (newer DLLs)
+static CheckpointEngineFunc dase_checkpoint_engine = nullptr;                // Optional (newer DLLs)
+static RestoreEngineFunc dase_restore_engine = nullptr;                      // Optional (newer DLLs)
+static CopyEngineStateFunc dase_copy_engine_state = nullptr;                 // Optional (newer DLLs)
+static ResetEngineFunc dase_reset_engine = nullptr;                          // Optional (newer DLLs)
+static SetThreadBudgetFunc dase_set_thread_budget = nullptr;                // Optional (newer DLLs)
+static GetStateDigestFunc dase_get_state_digest = nullptr;                  // Optional (newer DLLs)
 static GetMetricsFunc dase_get_metrics = nullptr;
 std::atomic<bool> EngineManager::instance_created_{false};
 
 // Load the DASE DLL and get function pointers
+// Serialized: several routers in one process (in-process step runners, job
+// workers) may create their first Phase 4B engine at the same time
 static bool loadDaseDLL() {
-    if (dll_handle != nullptr) {
+    static std::mutex load_mutex;
+    std::lock_guard<std::mutex> lock(load_mutex);
+    if (engine_library.isOpen()) {
         return true; // Already loaded
     }
 
-    // Try to load dase_engine_phase4b.dll
-    dll_handle = LoadLibraryA("dase_engine_phase4b.dll");
-
-    if (!dll_handle) {
-        // Try fallback to dase_engine.dll
-        dll_handle = LoadLibraryA("dase_engine.dll");
-    }
-
-    if (!dll_handle) {
-        DWORD error = GetLastError();
-        std::cerr << "LoadLibrary failed with error code: " << error << std::endl;
+    // Best per-ISA build for this CPU, then the host builds (engine_library.h)
+    if (!engine_library.open()) {
+        std::cerr << "Engine library not loaded:\n" << engine_library.error();
         return false;
     }
 
     // Get function pointers
     dase_create_engine = reinterpret_cast<CreateEngineFunc>(
-        GetProcAddress(dll_handle, "dase_create_engine"));
+        engine_library.symbol("dase_create_engine"));
 
     dase_destroy_engine = reinterpret_cast<DestroyEngineFunc>(
-        GetProcAddress(dll_handle, "dase_destroy_engine"));
+        engine_library.symbol("dase_destroy_engine"));
+
+    dase_create_engine_with_options = reinterpret_cast<CreateEngineWithOptionsFunc>(
+        engine_library.symbol("dase_create_engine_with_options"));
 
     // Try Phase 4C first, then Phase 4B, then generic optimized
     dase_run_mission_optimized_phase4c = reinterpret_cast<RunMissionFunc>(
-        GetProcAddress(dll_handle, "dase_run_mission_optimized_phase4c"));
+        engine_library.symbol("dase_run_mission_optimized_phase4c"));
 
     if (!dase_run_mission_optimized_phase4c) {
         dase_run_mission_optimized_phase4c = reinterpret_cast<RunMissionFunc>(
-            GetProcAddress(dll_handle, "dase_run_mission_optimized_phase4b"));
+            engine_library.symbol("dase_run_mission_optimized_phase4b"));
     }
 
     if (!dase_run_mission_optimized_phase4c) {
         dase_run_mission_optimized_phase4c = reinterpret_cast<RunMissionFunc>(
-            GetProcAddress(dll_handle, "dase_run_mission_optimized"));
+            engine_library.symbol("dase_run_mission_optimized"));
     }
 
     dase_get_metrics = reinterpret_cast<GetMetricsFunc>(
-        GetProcAddress(dll_handle, "dase_get_metrics"));
+        engine_library.symbol("dase_get_metrics"));
+
+    dase_run_ensemble = reinterpret_cast<RunEnsembleFunc>(
+        engine_library.symbol("dase_run_ensemble"));
+
+    dase_enable_hardware_counters = reinterpret_cast<EnableHardwareCountersFunc>(
+        engine_library.symbol("dase_enable_hardware_counters"));
+
+    dase_get_hardware_counters = reinterpret_cast<GetHardwareCountersFunc>(
+        engine_library.symbol("dase_get_hardware_counters"));
+
+    dase_get_state_page_size = reinterpret_cast<GetStatePageSizeFunc>(
+        engine_library.symbol("dase_get_state_page_size"));
+
+    dase_checkpoint_engine = reinterpret_cast<CheckpointEngineFunc>(
+        engine_library.symbol("dase_checkpoint_engine"));
+
+    dase_restore_engine = reinterpret_cast<RestoreEngineFunc>(
+        engine_library.symbol("dase_restore_engine"));
+
+    dase_copy_engine_state = reinterpret_cast<CopyEngineStateFunc>(
+        engine_library.symbol("dase_copy_engine_state"));
+
+    dase_reset_engine = reinterpret_cast<ResetEngineFunc>(
+        engine_library.symbol("dase_reset_engine"));
+
+    dase_get_state_digest = reinterpret_cast<GetStateDigestFunc>(
+        engine_library.symbol("dase_get_state_digest"));
+
+    dase_set_thread_budget = reinterpret_cast<SetThreadBudgetFunc>(
+        engine_library.symbol("dase_set_thread_budget"));
+    if (dase_set_thread_budget) {
+        dase_set_thread_budget(dase::ThreadBudget::process().capacity());
+    }
 
     // Check if all functions were found
     if (!dase_create_engine) {
@@ -361,8 +587,7 @@ static bool loadDaseDLL() {
 
     if (!dase_create_engine || !dase_destroy_engine ||
         !dase_run_mission_optimized_phase4c || !dase_get_metrics) {
-        FreeLibrary(dll_handle);
-        dll_handle = nullptr;
+        engine_library.close();
         return false;
     }
 
@@ -374,28 +599,50 @@ EngineManager::EngineManager() : next_engine_id(1) {
     if (!instance_created_.compare_exchange_strong(expected, true)) {
         throw std::runtime_error("EngineManager already exists; CLI is single-instance/thread only");
     }
-    // Try to load the DLL on construction
-    // If DLL not available, phase4b engine will be unavailable but other engines still work
-    if (!loadDaseDLL()) {
-        std::cerr << "[WARNING] Phase4B DLL not loaded (dase_engine_phase4b.dll or dase_engine.dll not found)" << std::endl;
-        std::cerr << "[WARNING] phase4b engine will be unavailable. Other engines (igsoa_complex, satp_higgs, sid_ternary) will work normally." << std::endl;
-        // Continue - other engines are header-only and don't need the DLL
-    }
+    // The engine library loads on the first phase4b use (ensureEngineLibrary),
+    // keeping startup free of the dlopen and its search
+}
+
+bool EngineManager::ensureEngineLibrary() {
+    // One attempt per process: a missing library stays missing, so later
+    // phase4b requests fail fast instead of searching again
+    static std::once_flag attempted;
+    static bool loaded = false;
+    std::call_once(attempted, [] {
+        loaded = loadDaseDLL();
+        if (!loaded) {
+            std::cerr << "[WARNING] Phase4B engine library not loaded (no dase_engine_phase4b* or dase_engine build found)" << std::endl;
+            std::cerr << "[WARNING] phase4b engine will be unavailable. Other engines (igsoa_complex, satp_higgs, sid_ternary) will work normally." << std::endl;
+            // Continue - other engines are header-only and don't need the DLL
+        }
+    });
+    return loaded;
 }
 
 EngineManager::~EngineManager() {
-    // Clean up engines first to ensure proper FFTW cleanup
+    // Free parked engines, then the live ones, before FFTW cleanup
+    setEnginePool(0);
     engines.clear(); // Destroys all unique_ptrs, calls engine destructors
 
     // Clean up DLL resources if loaded
-    if (dll_handle) {
-        FreeLibrary(dll_handle);
-        dll_handle = nullptr;
+    if (engine_library.isOpen()) {
+        engine_library.close();
 
         // Reset function pointers to prevent dangling references
         dase_create_engine = nullptr;
+        dase_create_engine_with_options = nullptr;
         dase_destroy_engine = nullptr;
         dase_run_mission_optimized_phase4c = nullptr;
+        dase_run_ensemble = nullptr;
+        dase_enable_hardware_counters = nullptr;
+        dase_get_hardware_counters = nullptr;
+        dase_get_state_page_size = nullptr;
+        dase_checkpoint_engine = nullptr;
+        dase_restore_engine = nullptr;
+        dase_copy_engine_state = nullptr;
+        dase_reset_engine = nullptr;
+        dase_set_thread_budget = nullptr;
+        dase_get_state_digest = nullptr;
         dase_get_metrics = nullptr;
     }
 
@@ -405,6 +652,21 @@ EngineManager::~EngineManager() {
     instance_created_.store(false);
 }
 
+// SATP+Higgs couplings from the generic engine parameters: R_c is the wave
+// speed, gamma both dissipations, kappa the φ-h coupling; a Higgs with
+// μ² = -1, λ_h = 0.5 (spontaneous symmetry breaking)
+static dase::satp_higgs::SATPHiggsParams satpParams(double R_c, double kappa, double gamma) {
+    dase::satp_higgs::SATPHiggsParams params;
+    params.c = (R_c > 0.0) ? R_c : 1.0;
+    params.gamma_phi = gamma;
+    params.gamma_h = gamma;
+    params.lambda = kappa;
+    params.mu_squared = -1.0;
+    params.lambda_h = 0.5;
+    params.updateVEV();
+    return params;
+}
+
 std::string EngineManager::createEngine(const std::string& engine_type,
                                         int num_nodes,
                                         double R_c,
@@ -416,7 +678,10 @@ std::string EngineManager::createEngine(const std::string& engine_type,
                                         int N_y,
                                         int N_z,
                                         int sid_role,
-                                        const std::string& engine_id_hint) {
+                                        const std::string& engine_id_hint,
+                                        const NumaOptions& numa,
+                                        int num_replicas,
+                                        nlohmann::json* admission_error) {
     // Validate parameters
     if (num_nodes <= 0 || num_nodes > 1048576) {
         return "";
@@ -443,8 +708,11 @@ std::string EngineManager::createEngine(const std::string& engine_type,
     // Create engine instance
     auto instance = std::make_unique<EngineInstance>();
     instance->engine_id = engine_id_hint.empty() ? generateEngineId() : engine_id_hint;
-    if (engines.find(instance->engine_id) != engines.end()) {
-        return "";
+    {
+        std::shared_lock<std::shared_mutex> registry_lock(registry_mutex_);
+        if (engines.find(instance->engine_id) != engines.end()) {
+            return "";
+        }
     }
     instance->engine_type = engine_type;
     instance->num_nodes = num_nodes;
@@ -458,16 +726,93 @@ std::string EngineManager::createEngine(const std::string& engine_type,
     instance->dimension_y = N_y;
     instance->dimension_z = N_z;
     instance->sid_role = sid_role;
+    instance->numa = numa;
     instance->type_tag = EngineInstance::TypeTag::Unknown;
 
     void* handle = nullptr;
 
-    if (engine_type == "phase4b") {
+    // A parked engine of this shape is reset in place instead of rebuilt
+    const std::string pool_key = poolKey(engine_type, num_nodes, N_x, N_y, N_z, dt, numa);
+    std::unique_ptr<EngineInstance> pooled = pool_key.empty() ? nullptr : takePooledEngine(pool_key);
+
+    // Charge a new engine its estimate before anything is allocated; the
+    // charge is returned on every failure below
+    struct AdmissionCharge {
+        EngineManager* manager;
+        uint64_t bytes;
+        ~AdmissionCharge() {
+            if (bytes > 0) {
+                std::lock_guard<std::mutex> lock(manager->memory_mutex_);
+                manager->admitted_bytes_ -= bytes;
+            }
+        }
+    } charge{this, 0};
+    if (!pooled) {
+        dase::MemoryFootprint estimate;
+        if (estimateEngineMemory(engine_type, num_nodes, R_c, N_x, N_y, N_z, num_replicas, estimate)) {
+            std::lock_guard<std::mutex> lock(memory_mutex_);
+            const uint64_t budget = memory_budget_.load();
+            if (budget > 0 && admitted_bytes_ + estimate.total() > budget) {
+                if (admission_error) {
+                    *admission_error = {
+                        {"requested_bytes", estimate.total()},
+                        {"in_use_bytes", admitted_bytes_},
+                        {"budget_bytes", budget},
+                        {"breakdown", {{"state", estimate.state}, {"caches", estimate.caches},
+                                       {"history", estimate.history}, {"scratch", estimate.scratch}}}
+                    };
+                }
+                return "";
+            }
+            admitted_bytes_ += estimate.total();
+            charge.bytes = estimate.total();
+        }
+    }
+
+    if (pooled) {
+        instance->admitted_bytes = pooled->admitted_bytes;
+        instance->engine_handle = pooled->engine_handle;
+        instance->type_tag = pooled->type_tag;
+        instance->num_nodes = pooled->num_nodes;
+        instance->dimension_x = pooled->dimension_x;
+        instance->dimension_y = pooled->dimension_y;
+        instance->dimension_z = pooled->dimension_z;
+        std::string error;
+        if (!reinitializeEngine(instance.get(), R_c, kappa, gamma, dt, error)) {
+            std::cerr << "[ERROR] Failed to reset pooled " << engine_type << ": " << error << std::endl;
+            freeEngineHandle(instance.get());
+            return "";
+        }
+        handle = instance->engine_handle;
+
+    } else if (engine_type == "phase4b") {
         // Phase 4B - load from DLL
-        if (!dase_create_engine) {
+        if (!ensureEngineLibrary() || !dase_create_engine) {
             return "";
         }
-        handle = dase_create_engine(static_cast<uint32_t>(num_nodes));
+        const bool huge_pages = numa.huge_pages != HugePages::None;
+        const bool wants_placement = numa.first_touch || numa.interleave || huge_pages ||
+                                     numa.thread_affinity != ThreadAffinity::None;
+        if (wants_placement && dase_create_engine_with_options) {
+            DaseEngineOptionsV2 options;
+            options.struct_size = huge_pages ? sizeof(options) : offsetof(DaseEngineOptionsV2, huge_pages);
+            options.numa_first_touch = numa.first_touch ? 1 : 0;
+            options.numa_interleave = numa.interleave ? 1 : 0;
+            options.thread_affinity = static_cast<int32_t>(numa.thread_affinity);
+            options.huge_pages = static_cast<int32_t>(numa.huge_pages);
+            char error_msg[256] = {};
+            if (dase_create_engine_with_options(static_cast<uint32_t>(num_nodes), &options,
+                                                &handle, error_msg, sizeof(error_msg)) != 0) {
+                std::cerr << "[ERROR] Failed to create phase4b: " << error_msg << std::endl;
+                return "";
+            }
+        } else {
+            if (wants_placement) {
+                std::cerr << "[WARNING] DASE DLL lacks dase_create_engine_with_options; "
+                          << "NUMA/affinity options ignored" << std::endl;
+            }
+            handle = dase_create_engine(static_cast<uint32_t>(num_nodes));
+        }
         instance->type_tag = EngineInstance::TypeTag::Phase4B;
 
     } else if (engine_type == "igsoa_complex") {
@@ -479,6 +824,7 @@ std::string EngineManager::createEngine(const std::string& engine_type,
             config.kappa = kappa;
             config.gamma = gamma;
             config.dt = dt;
+            config.numa = numa;
 
             auto* engine = new dase::igsoa::IGSOAComplexEngine(config);
             handle = static_cast<void*>(engine);
@@ -516,6 +862,7 @@ std::string EngineManager::createEngine(const std::string& engine_type,
             config.kappa = kappa;
             config.gamma = gamma;
             config.dt = dt;
+            config.numa = numa;
             config.normalize_psi = false;
 
             auto* engine = new dase::igsoa::IGSOAComplexEngine2D(
@@ -557,6 +904,7 @@ std::string EngineManager::createEngine(const std::string& engine_type,
             config.kappa = kappa;
             config.gamma = gamma;
             config.dt = dt;
+            config.numa = numa;
             config.normalize_psi = false;
 
             auto* engine = new dase::igsoa::IGSOAComplexEngine3D(
@@ -577,6 +925,34 @@ std::string EngineManager::createEngine(const std::string& engine_type,
             return "";
         }
 
+    } else if (engine_type == "igsoa_ensemble_1d") {
+        // Replicas of one 1D lattice stepped together (igsoa_ensemble_engine.h)
+        int64_t total_states = static_cast<int64_t>(num_nodes) * static_cast<int64_t>(num_replicas);
+        if (num_replicas <= 0 || total_states > 16777216) {
+            return "";
+        }
+        instance->num_replicas = num_replicas;
+
+        try {
+            dase::igsoa::IGSOAComplexConfig config;
+            config.num_nodes = static_cast<uint32_t>(num_nodes);
+            config.R_c_default = R_c;
+            config.kappa = kappa;
+            config.gamma = gamma;
+            config.dt = dt;
+
+            auto* engine = new dase::igsoa::IGSOAEnsembleEngine1D(config, static_cast<size_t>(num_replicas));
+            handle = static_cast<void*>(engine);
+            instance->type_tag = EngineInstance::TypeTag::IgsoaEnsemble1D;
+
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR] Failed to create igsoa_ensemble_1d: " << e.what() << std::endl;
+            return "";
+        } catch (...) {
+            std::cerr << "[ERROR] Unknown exception creating igsoa_ensemble_1d" << std::endl;
+            return "";
+        }
+
     } else if (engine_type == "igsoa_gw") {
         int nx = (N_x > 0) ? N_x : 16;
         int ny = (N_y > 0) ? N_y : 16;
@@ -637,15 +1013,7 @@ std::string EngineManager::createEngine(const std::string& engine_type,
         }
 
         try {
-            // Create SATP+Higgs physics parameters
-            dase::satp_higgs::SATPHiggsParams params;
-            params.c = (R_c > 0.0) ? R_c : 1.0;  // Wave speed (reuse R_c parameter)
-            params.gamma_phi = gamma;             // Scale field dissipation
-            params.gamma_h = gamma;               // Higgs dissipation (same for now)
-            params.lambda = kappa;                // φ-h coupling (reuse kappa parameter)
-            params.mu_squared = -1.0;             // Higgs mass² (negative for SSB)
-            params.lambda_h = 0.5;                // Higgs self-coupling
-            params.updateVEV();                   // Compute VEV
+            const dase::satp_higgs::SATPHiggsParams params = satpParams(R_c, kappa, gamma);
 
             // Lattice parameters
             double dx = 0.1;  // Default spatial step (can be overridden via JSON)
@@ -684,14 +1052,7 @@ std::string EngineManager::createEngine(const std::string& engine_type,
 
         try {
             // Create SATP+Higgs physics parameters
-            dase::satp_higgs::SATPHiggsParams params;
-            params.c = (R_c > 0.0) ? R_c : 1.0;
-            params.gamma_phi = gamma;
-            params.gamma_h = gamma;
-            params.lambda = kappa;
-            params.mu_squared = -1.0;
-            params.lambda_h = 0.5;
-            params.updateVEV();
+            const dase::satp_higgs::SATPHiggsParams params = satpParams(R_c, kappa, gamma);
 
             // Lattice parameters
             double dx = 0.1;
@@ -730,14 +1091,7 @@ std::string EngineManager::createEngine(const std::string& engine_type,
         instance->num_nodes = static_cast<int>(expected_nodes);
 
         try {
-            dase::satp_higgs::SATPHiggsParams params;
-            params.c = (R_c > 0.0) ? R_c : 1.0;
-            params.gamma_phi = gamma;
-            params.gamma_h = gamma;
-            params.lambda = kappa;
-            params.mu_squared = -1.0;
-            params.lambda_h = 0.5;
-            params.updateVEV();
+            const dase::satp_higgs::SATPHiggsParams params = satpParams(R_c, kappa, gamma);
 
             double dx = 0.1;
             double dt_val = (dt > 0.0) ? dt : 0.001;
@@ -814,6 +1168,10 @@ std::string EngineManager::createEngine(const std::string& engine_type,
     }
 
     instance->engine_handle = handle;
+    if (charge.bytes > 0) {
+        instance->admitted_bytes = charge.bytes;
+        charge.bytes = 0;
+    }
 
     if (instance->engine_type == "sid_ternary") {
         sid_rewrite_events_[instance->engine_id] = {};
@@ -850,69 +1208,100 @@ std::string EngineManager::createEngine(const std::string& engine_type,
     }
 
     std::string id = instance->engine_id;
-    engines[id] = std::move(instance);
+    {
+        std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+        engines[id] = std::move(instance);
+    }
 
     return id;
 }
 
 bool EngineManager::destroyEngine(const std::string& engine_id) {
-    auto it = engines.find(engine_id);
-    if (it == engines.end()) {
-        return false;
+    std::map<std::string, std::unique_ptr<EngineInstance>>::iterator it;
+    {
+        std::shared_lock<std::shared_mutex> registry_lock(registry_mutex_);
+        it = engines.find(engine_id);
+        if (it == engines.end()) {
+            return false;
+        }
+    }
+    std::unique_ptr<EngineInstance> instance;
+    {
+        std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+        state_exports_.erase(engine_id);
+        metric_bindings_.erase(engine_id);
+        snapshot_buffers_.erase(engine_id);
+        spectral_monitors_.erase(engine_id);
+        instance = std::move(it->second);
+        engines.erase(it);
+    }
+    sid_rewrite_events_.erase(engine_id);
+    sid_wrapper_state_.erase(engine_id);
+
+    if (!parkEngine(instance)) {
+        freeEngineHandle(instance.get());
     }
+    return true;
+}
 
-    // Destroy engine based on type
-    if (it->second->engine_handle) {
-        switch (it->second->type_tag) {
+// Destroy the engine behind instance based on type
+void EngineManager::freeEngineHandle(EngineInstance* instance) {
+    if (instance->engine_handle) {
+        switch (instance->type_tag) {
             case EngineInstance::TypeTag::Phase4B:
                 if (dase_destroy_engine) {
-                    dase_destroy_engine(it->second->engine_handle);
+                    dase_destroy_engine(instance->engine_handle);
                 }
                 break;
             case EngineInstance::TypeTag::IgsoaComplex:
-                delete static_cast<dase::igsoa::IGSOAComplexEngine*>(it->second->engine_handle);
+                delete static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::IgsoaComplex2D:
-                delete static_cast<dase::igsoa::IGSOAComplexEngine2D*>(it->second->engine_handle);
+                delete static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::IgsoaComplex3D:
-                delete static_cast<dase::igsoa::IGSOAComplexEngine3D*>(it->second->engine_handle);
+                delete static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+                break;
+            case EngineInstance::TypeTag::IgsoaEnsemble1D:
+                delete static_cast<dase::igsoa::IGSOAEnsembleEngine1D*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::IgsoaGW:
-                delete static_cast<IGSOAGWEngine*>(it->second->engine_handle);
+                delete static_cast<IGSOAGWEngine*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::SatpHiggs1D:
-                delete static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(it->second->engine_handle);
+                delete static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::SatpHiggs2D:
-                delete static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(it->second->engine_handle);
+                delete static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::SatpHiggs3D:
-                delete static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(it->second->engine_handle);
+                delete static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::FFTWCache:
-                delete static_cast<FFTWCacheExampleEngine*>(it->second->engine_handle);
+                delete static_cast<FFTWCacheExampleEngine*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::SidTernary:
-                sid_destroy_engine(static_cast<sid_engine*>(it->second->engine_handle));
+                sid_destroy_engine(static_cast<sid_engine*>(instance->engine_handle));
                 break;
             case EngineInstance::TypeTag::SidSSP:
-                delete static_cast<SidSSPEngine*>(it->second->engine_handle);
+                delete static_cast<SidSSPEngine*>(instance->engine_handle);
                 break;
             case EngineInstance::TypeTag::Unknown:
             default:
-                std::cerr << "[ERROR] Unknown engine type_tag for " << engine_id << std::endl;
+                std::cerr << "[ERROR] Unknown engine type_tag for " << instance->engine_id << std::endl;
                 break;
         }
     }
-
-    engines.erase(it);
-    sid_rewrite_events_.erase(engine_id);
-    sid_wrapper_state_.erase(engine_id);
-    return true;
+    instance->engine_handle = nullptr;
+    if (instance->admitted_bytes > 0) {
+        std::lock_guard<std::mutex> lock(memory_mutex_);
+        admitted_bytes_ -= instance->admitted_bytes;
+        instance->admitted_bytes = 0;
+    }
 }
 
 EngineInstance* EngineManager::getEngine(const std::string& engine_id) {
+    std::shared_lock<std::shared_mutex> registry_lock(registry_mutex_);
     auto it = engines.find(engine_id);
     if (it == engines.end()) {
         return nullptr;
@@ -921,6 +1310,7 @@ EngineInstance* EngineManager::getEngine(const std::string& engine_id) {
 }
 
 const EngineInstance* EngineManager::getEngineConst(const std::string& engine_id) const {
+    std::shared_lock<std::shared_mutex> registry_lock(registry_mutex_);
     auto it = engines.find(engine_id);
     if (it == engines.end()) {
         return nullptr;
@@ -1100,7 +1490,11 @@ double EngineManager::getNodeState(const std::string& engine_id, int node_index,
     return 0.0;
 }
 
-bool EngineManager::runMission(const std::string& engine_id, int num_steps, int iterations_per_node) {
+static dase::ObservableRecorder* observableRecorder(EngineInstance* instance, size_t dims[3]);
+
+bool EngineManager::runMission(const std::string& engine_id, int num_steps, int iterations_per_node, int first_step,
+                               MissionControl* control) {
+    DASE_TRACE_ZONE("engine.run_mission");
     auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
         return false;
@@ -1110,89 +1504,192 @@ bool EngineManager::runMission(const std::string& engine_id, int num_steps, int
         return false;
     }
 
-    try {
-        // Pre-compute input signals and control patterns
-        std::vector<double> input_signals(num_steps);
-        std::vector<double> control_patterns(num_steps);
+    // Package energy of the whole call, block bookkeeping included
+    EnergyMeter* energy = instance->energy_meter.get();
+    if (energy) {
+        energy->start();
+    }
+
+    // A controlled mission can be stopped by cancelMission until it returns
+    std::shared_ptr<std::atomic<bool>> cancel_flag;
+    struct CancelRegistration {
+        EngineManager* manager = nullptr;
+        const std::string* engine_id = nullptr;
+        ~CancelRegistration() {
+            if (manager) {
+                std::lock_guard<std::mutex> lock(manager->mission_cancel_mutex_);
+                manager->mission_cancel_.erase(*engine_id);
+            }
+        }
+    } registration;
+    if (control) {
+        cancel_flag = std::make_shared<std::atomic<bool>>(false);
+        std::lock_guard<std::mutex> lock(mission_cancel_mutex_);
+        mission_cancel_[engine_id] = cancel_flag;
+        registration.manager = this;
+        registration.engine_id = &engine_id;
+    }
 
-        for (int i = 0; i < num_steps; i++) {
-            input_signals[i] = std::sin(i * 0.01);
-            control_patterns[i] = std::cos(i * 0.01);
+    try {
+        // Input signals and control patterns of the block being run
+        std::vector<double> input_signals;
+        std::vector<double> control_patterns;
+
+        // A mapped state export publishes every publish_interval steps, a
+        // snapshot buffer every its own interval and a metric subscription
+        // samples every every_steps, so the mission runs in chunks that end
+        // on all of them.  The bindings themselves are
+        // only replaced under this engine's lock, so the pointers stay valid.
+        StateExportBinding* binding = nullptr;
+        MetricBinding* metrics = nullptr;
+        SnapshotBinding* snapshots = nullptr;
+        {
+            std::shared_lock<std::shared_mutex> registry_lock(registry_mutex_);
+            auto export_it = state_exports_.find(engine_id);
+            if (export_it != state_exports_.end()) {
+                binding = &export_it->second;
+            }
+            auto metric_it = metric_bindings_.find(engine_id);
+            if (metric_it != metric_bindings_.end()) {
+                metrics = &metric_it->second;
+            }
+            auto snapshot_it = snapshot_buffers_.find(engine_id);
+            if (snapshot_it != snapshot_buffers_.end()) {
+                snapshots = &snapshot_it->second;
+            }
         }
+        const int publish_interval = binding ? binding->publish_interval : 0;
+        std::vector<double> metric_values(metrics ? metrics->emitter->names().size() : 0);
+
+        // Observable triggers end the engine's step loop on their step;
+        // their actions are applied here, between blocks
+        size_t dims[3];
+        dase::ObservableRecorder* observables = observableRecorder(instance, dims);
+        std::vector<dase::TriggerEvent> events;
+        bool trigger_stop = false;
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto elapsedMs = [&start]() {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+        double step_ms = 0.0;   // Mean wall time per step so far
+        int done = 0;
+        while (done < num_steps) {
+            int count = num_steps - done;
+            if (publish_interval > 0) {
+                count = std::min(count, publish_interval - done % publish_interval);
+            }
+            if (metrics) {
+                const uint64_t every = metrics->emitter->options().every_steps;
+                count = static_cast<int>(std::min<uint64_t>(count, every - metrics->steps % every));
+            }
+            if (snapshots) {
+                const uint64_t every = static_cast<uint64_t>(snapshots->buffer->publishInterval());
+                count = static_cast<int>(std::min<uint64_t>(count, every - snapshots->steps % every));
+            }
+            if (control) {
+                if (cancel_flag->load(std::memory_order_relaxed) ||
+                    (control->cancel && control->cancel->load(std::memory_order_relaxed))) {
+                    control->stop_reason = "cancelled";
+                    break;
+                }
+                // The first block is one step, which times the engine; the
+                // budget always allows it
+                double block = 1.0;
+                if (done > 0) {
+                    block = kMissionBlockMs / std::max(step_ms, 1e-6);
+                    if (control->time_budget_ms > 0.0) {
+                        const double remaining = control->time_budget_ms - elapsedMs();
+                        if (remaining < step_ms) {
+                            control->stop_reason = "time_budget";
+                            break;
+                        }
+                        block = std::min(block, remaining / std::max(step_ms, 1e-6));
+                    }
+                }
+                count = static_cast<int>(std::max(1.0, std::min(static_cast<double>(count), block)));
+            }
 
-        if (instance->engine_type == "phase4b") {
-            // Phase 4B - call DLL
-            if (!dase_run_mission_optimized_phase4c || iterations_per_node <= 0) {
+            const double gain = observables ? observables->driveGain() : 1.0;
+            input_signals.resize(count);
+            control_patterns.resize(count);
+            for (int i = 0; i < count; i++) {
+                input_signals[i] = gain * std::sin((first_step + done + i) * 0.01);
+                control_patterns[i] = gain * std::cos((first_step + done + i) * 0.01);
+            }
+            int ran = count;
+            if (!runMissionSteps(instance, input_signals.data(), control_patterns.data(),
+                                 count, iterations_per_node, ran)) {
                 return false;
             }
-
-            dase_run_mission_optimized_phase4c(
-                instance->engine_handle,
-                input_signals.data(),
-                control_patterns.data(),
-                static_cast<uint64_t>(num_steps),
-                static_cast<uint32_t>(iterations_per_node)
-            );
-
-        } else if (instance->engine_type == "igsoa_complex") {
-            // IGSOA Complex - call directly
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
-            engine->runMission(
-                num_steps,
-                input_signals.data(),
-                control_patterns.data()
-            );
-
-        } else if (instance->engine_type == "igsoa_complex_2d") {
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-            engine->runMission(
-                num_steps,
-                input_signals.data(),
-                control_patterns.data()
-            );
-
-        } else if (instance->engine_type == "igsoa_complex_3d") {
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-            engine->runMission(
-                num_steps,
-                input_signals.data(),
-                control_patterns.data()
-            );
-
-        } else if (instance->engine_type == "igsoa_gw") {
-            auto* engine = static_cast<IGSOAGWEngine*>(instance->engine_handle);
-            engine->runMission(num_steps);
-
-        } else if (instance->engine_type == "satp_higgs_1d") {
-            // SATP+Higgs engine - use evolve() method
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
-            engine->evolve(static_cast<size_t>(num_steps));
-
-        } else if (instance->engine_type == "satp_higgs_2d") {
-            // SATP+Higgs 2D engine
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
-            engine->evolve(static_cast<size_t>(num_steps));
-
-        } else if (instance->engine_type == "satp_higgs_3d") {
-            // SATP+Higgs 3D engine
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
-            engine->evolve(static_cast<size_t>(num_steps));
-
-        } else if (instance->engine_type == "fftw_cache_example") {
-            auto* engine = static_cast<FFTWCacheExampleEngine*>(instance->engine_handle);
-            engine->runMission(num_steps);
-
-        } else if (instance->engine_type == "sid_ternary") {
-            for (int i = 0; i < num_steps; ++i) {
-                sid_step(static_cast<sid_engine*>(instance->engine_handle), 1.0);
+            done += ran;
+            step_ms = elapsedMs() / done;
+            if (observables) {
+                events.clear();
+                const uint64_t dropped = observables->takeEvents(events);
+                for (const dase::TriggerEvent& event : events) {
+                    MissionTriggerEvent fired;
+                    fired.event = event;
+                    const dase::TriggerSpec* trigger = observables->trigger(event.trigger);
+                    if (event.action == dase::TriggerAction::Snapshot && trigger) {
+                        fired.snapshot_path = trigger->path;
+                        const size_t at = fired.snapshot_path.find("{step}");
+                        if (at != std::string::npos) {
+                            fired.snapshot_path.replace(at, 6, std::to_string(event.step));
+                        }
+                        nlohmann::json info;
+                        checkpointEngine(engine_id, fired.snapshot_path, info, fired.error);
+                    }
+                    trigger_stop = trigger_stop || event.action == dase::TriggerAction::Stop;
+                    if (control) {
+                        control->trigger_events.push_back(std::move(fired));
+                    }
+                }
+                if (control) {
+                    control->trigger_events_dropped += dropped;
+                }
             }
-
-        } else if (instance->engine_type == "sid_ssp") {
-            auto* engine = static_cast<SidSSPEngine*>(instance->engine_handle);
-            engine->runMission(num_steps);
-
-        } else {
-            return false;
+            if (binding) {
+                binding->steps += static_cast<uint64_t>(ran);
+                if (publish_interval > 0 && (done % publish_interval == 0 || done == num_steps)) {
+                    publishState(engine_id);
+                }
+            }
+            if (snapshots) {
+                snapshots->steps += static_cast<uint64_t>(ran);
+                if (snapshots->steps % static_cast<uint64_t>(snapshots->buffer->publishInterval()) == 0) {
+                    publishSnapshot(engine_id, *snapshots);
+                }
+            }
+            if (metrics) {
+                metrics->steps += static_cast<uint64_t>(ran);
+                if (metrics->emitter->due(metrics->steps) &&
+                    sampleMetrics(engine_id, metrics->emitter->names(), metrics->steps, metric_values.data())) {
+                    metrics->emitter->record(metrics->steps, metric_values.data());
+                }
+            }
+            if (trigger_stop) {
+                if (control) {
+                    control->stop_reason = "trigger";
+                }
+                break;
+            }
+        }
+        // A stopped mission publishes where it stopped, as a finished one does
+        if (binding && publish_interval > 0 && done < num_steps && done % publish_interval != 0) {
+            publishState(engine_id);
+        }
+        if (metrics) {
+            metrics->emitter->flush();
+        }
+        if (control) {
+            control->steps_completed = done;
+            control->wall_ms = elapsedMs();
+            control->drive_gain = observables ? observables->driveGain() : 1.0;
+        }
+        if (energy) {
+            instance->last_energy = energy->stop();
+            instance->last_energy_steps = done;
         }
 
         return true;
@@ -1202,77 +1699,383 @@ bool EngineManager::runMission(const std::string& engine_id, int num_steps, int
     }
 }
 
-bool EngineManager::setNodePsi(const std::string& engine_id, int node_index, double real, double imag) {
+bool EngineManager::cancelMission(const std::string& engine_id) {
+    std::lock_guard<std::mutex> lock(mission_cancel_mutex_);
+    auto it = mission_cancel_.find(engine_id);
+    if (it == mission_cancel_.end()) {
+        return false;
+    }
+    it->second->store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool EngineManager::getSimulatedTime(const std::string& engine_id, double& time_out) {
     auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
         return false;
     }
-
     if (instance->engine_type == "igsoa_complex") {
-        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
-        if (node_index < 0 || node_index >= instance->num_nodes) {
-            return false;
-        }
-        engine->setNodePsi(static_cast<size_t>(node_index), real, imag);
-        return true;
-
+        time_out = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle)->getCurrentTime();
     } else if (instance->engine_type == "igsoa_complex_2d") {
-        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-        if (node_index < 0 || node_index >= instance->num_nodes) {
-            return false;
-        }
-
-        size_t x = 0;
-        size_t y = 0;
-        engine->indexToCoord(static_cast<size_t>(node_index), x, y);
-        engine->setNodePsi(x, y, real, imag);
-        return true;
-
+        time_out = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->getCurrentTime();
     } else if (instance->engine_type == "igsoa_complex_3d") {
-        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-        if (node_index < 0 || node_index >= instance->num_nodes) {
-            return false;
-        }
-
-        size_t x = 0;
-        size_t y = 0;
-        size_t z = 0;
-        engine->indexToCoord(static_cast<size_t>(node_index), x, y, z);
-        engine->setNodePsi(x, y, z, real, imag);
-        return true;
-    }
-
-    return false;
-}
-
-bool EngineManager::getNodePsi(const std::string& engine_id, int node_index, double& real_out, double& imag_out) {
-    auto* instance = getEngine(engine_id);
-    if (!instance || !instance->engine_handle) {
+        time_out = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->getCurrentTime();
+    } else if (instance->engine_type == "igsoa_ensemble_1d") {
+        time_out = static_cast<dase::igsoa::IGSOAEnsembleEngine1D*>(instance->engine_handle)->getCurrentTime();
+    } else if (instance->engine_type == "igsoa_gw") {
+        time_out = static_cast<IGSOAGWEngine*>(instance->engine_handle)->field.getCurrentTime();
+    } else if (instance->engine_type == "satp_higgs_1d") {
+        time_out = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle)->getTime();
+    } else if (instance->engine_type == "satp_higgs_2d") {
+        time_out = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle)->getTime();
+    } else if (instance->engine_type == "satp_higgs_3d") {
+        time_out = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->getTime();
+    } else {
         return false;
     }
+    return true;
+}
 
-    if (instance->engine_type == "igsoa_complex") {
-        if (node_index < 0 || node_index >= instance->num_nodes) {
+bool EngineManager::runMissionSteps(EngineInstance* instance,
+                                    const double* input_signals,
+                                    const double* control_patterns,
+                                    int num_steps,
+                                    int iterations_per_node,
+                                    int& steps_run_out) {
+    steps_run_out = num_steps;
+    const dase::ThreadBudget::Lease threads =
+        dase::ThreadBudget::process().acquire(instance->thread_limit, &instance->thread_cpus);
+    if (instance->engine_type == "phase4b") {
+        // Phase 4B - call DLL
+        if (!dase_run_mission_optimized_phase4c || iterations_per_node <= 0) {
             return false;
         }
+
+        dase_run_mission_optimized_phase4c(
+            instance->engine_handle,
+            input_signals,
+            control_patterns,
+            static_cast<uint64_t>(num_steps),
+            static_cast<uint32_t>(iterations_per_node)
+        );
+
+    } else if (instance->engine_type == "igsoa_complex") {
+        // IGSOA Complex - call directly
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
-        engine->getNodePsi(static_cast<size_t>(node_index), real_out, imag_out);
-        return true;
+        steps_run_out = static_cast<int>(engine->runMission(
+            num_steps,
+            input_signals,
+            control_patterns
+        ));
 
     } else if (instance->engine_type == "igsoa_complex_2d") {
-        if (node_index < 0 || node_index >= instance->num_nodes) {
-            return false;
-        }
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-        size_t x = 0;
-        size_t y = 0;
-        engine->indexToCoord(static_cast<size_t>(node_index), x, y);
-        engine->getNodePsi(x, y, real_out, imag_out);
-        return true;
+        steps_run_out = static_cast<int>(engine->runMission(
+            num_steps,
+            input_signals,
+            control_patterns
+        ));
 
     } else if (instance->engine_type == "igsoa_complex_3d") {
-        if (node_index < 0 || node_index >= instance->num_nodes) {
-            return false;
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+        steps_run_out = static_cast<int>(engine->runMission(
+            num_steps,
+            input_signals,
+            control_patterns
+        ));
+
+    } else if (instance->engine_type == "igsoa_ensemble_1d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAEnsembleEngine1D*>(instance->engine_handle);
+        engine->runMission(
+            num_steps,
+            input_signals,
+            control_patterns
+        );
+
+    } else if (instance->engine_type == "igsoa_gw") {
+        auto* engine = static_cast<IGSOAGWEngine*>(instance->engine_handle);
+        engine->runMission(num_steps);
+
+    } else if (instance->engine_type == "satp_higgs_1d") {
+        // SATP+Higgs engine - use evolve() method
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
+        engine->evolve(static_cast<size_t>(num_steps));
+
+    } else if (instance->engine_type == "satp_higgs_2d") {
+        // SATP+Higgs 2D engine
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
+        engine->evolve(static_cast<size_t>(num_steps));
+
+    } else if (instance->engine_type == "satp_higgs_3d") {
+        // SATP+Higgs 3D engine
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
+        engine->evolve(static_cast<size_t>(num_steps));
+
+    } else if (instance->engine_type == "fftw_cache_example") {
+        auto* engine = static_cast<FFTWCacheExampleEngine*>(instance->engine_handle);
+        engine->runMission(num_steps);
+
+    } else if (instance->engine_type == "sid_ternary") {
+        for (int i = 0; i < num_steps; ++i) {
+            sid_step(static_cast<sid_engine*>(instance->engine_handle), 1.0);
+        }
+
+    } else if (instance->engine_type == "sid_ssp") {
+        auto* engine = static_cast<SidSSPEngine*>(instance->engine_handle);
+        engine->runMission(num_steps);
+
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+bool EngineManager::runMissionAdaptive(const std::string& engine_id,
+                                       double duration,
+                                       const dase::AdaptiveStepOptions& options,
+                                       bool drive,
+                                       dase::AdaptiveStepStats& stats_out,
+                                       std::string& error_out) {
+    DASE_TRACE_ZONE("engine.run_mission_adaptive");
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (!(duration > 0.0) || !std::isfinite(duration)) {
+        error_out = "duration must be positive";
+        return false;
+    }
+    if (!options.validate(&error_out)) {
+        return false;
+    }
+
+    try {
+        const dase::ThreadBudget::Lease threads =
+            dase::ThreadBudget::process().acquire(instance->thread_limit, &instance->thread_cpus);
+
+        // run_mission's drive on a simulated-time grid of the configured dt
+        std::vector<double> input_signals;
+        std::vector<double> control_patterns;
+        dase::igsoa::IGSOADrivingSchedule schedule;
+        const auto makeSchedule = [&](double now, double interval) {
+            if (!drive) {
+                return;
+            }
+            const size_t count = static_cast<size_t>(std::ceil(duration / interval)) + 1;
+            input_signals.resize(count);
+            control_patterns.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                input_signals[i] = std::sin(i * 0.01);
+                control_patterns[i] = std::cos(i * 0.01);
+            }
+            schedule.input_signals = input_signals.data();
+            schedule.control_patterns = control_patterns.data();
+            schedule.count = count;
+            schedule.start_time = now;
+            schedule.interval = interval;
+        };
+
+        if (instance->engine_type == "igsoa_complex") {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
+            makeSchedule(engine->getCurrentTime(), instance->dt);
+            stats_out = engine->runMissionAdaptive(duration, options, schedule);
+        } else if (instance->engine_type == "igsoa_complex_2d") {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+            makeSchedule(engine->getCurrentTime(), instance->dt);
+            stats_out = engine->runMissionAdaptive(duration, options, schedule);
+        } else if (instance->engine_type == "igsoa_complex_3d") {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+            makeSchedule(engine->getCurrentTime(), instance->dt);
+            stats_out = engine->runMissionAdaptive(duration, options, schedule);
+        } else if (instance->engine_type == "satp_higgs_1d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
+            stats_out = dase::satp_higgs::satpEvolveAdaptive(*engine, 1, duration, options);
+        } else if (instance->engine_type == "satp_higgs_2d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
+            stats_out = dase::satp_higgs::satpEvolveAdaptive(*engine, 2, duration, options);
+        } else if (instance->engine_type == "satp_higgs_3d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
+            stats_out = dase::satp_higgs::satpEvolveAdaptive(*engine, 3, duration, options);
+        } else {
+            error_out = "Adaptive missions support igsoa_complex* and satp_higgs_* engines only";
+            return false;
+        }
+    } catch (const std::exception& e) {
+        error_out = e.what();
+        return false;
+    }
+
+    instance->adaptive.merge(stats_out);
+    return true;
+}
+
+bool EngineManager::runEnsemble(const std::vector<std::string>& engine_ids,
+                                int num_steps,
+                                int iterations_per_node,
+                                const std::vector<std::vector<double>>& input_signals,
+                                const std::vector<std::vector<double>>& control_patterns,
+                                std::string& error_out) {
+    if (engine_ids.empty() || num_steps <= 0 || iterations_per_node <= 0) {
+        error_out = "engine_ids, num_steps and iterations_per_node must be non-empty/positive";
+        return false;
+    }
+    if (!dase_run_mission_optimized_phase4c) {
+        error_out = "Phase4B DLL not loaded";
+        return false;
+    }
+
+    const size_t num_engines = engine_ids.size();
+    std::vector<void*> handles(num_engines);
+    for (size_t e = 0; e < num_engines; ++e) {
+        auto* instance = getEngine(engine_ids[e]);
+        if (!instance || !instance->engine_handle) {
+            error_out = "Engine not found: " + engine_ids[e];
+            return false;
+        }
+        if (instance->type_tag != EngineInstance::TypeTag::Phase4B) {
+            error_out = "Ensembles support phase4b engines only: " + engine_ids[e];
+            return false;
+        }
+        handles[e] = instance->engine_handle;
+    }
+    std::vector<void*> sorted_handles(handles);
+    std::sort(sorted_handles.begin(), sorted_handles.end());
+    if (std::adjacent_find(sorted_handles.begin(), sorted_handles.end()) != sorted_handles.end()) {
+        error_out = "engine_ids lists the same engine more than once";
+        return false;
+    }
+
+    // Per-engine drive, or run_mission's shared sin/cos drive
+    const bool per_engine = !input_signals.empty() || !control_patterns.empty();
+    if (per_engine) {
+        if (input_signals.size() != num_engines || control_patterns.size() != num_engines) {
+            error_out = "input_signals and control_patterns need one array per engine";
+            return false;
+        }
+        for (size_t e = 0; e < num_engines; ++e) {
+            if (input_signals[e].size() != static_cast<size_t>(num_steps) ||
+                control_patterns[e].size() != static_cast<size_t>(num_steps)) {
+                error_out = "Signal arrays for " + engine_ids[e] + " must have num_steps entries";
+                return false;
+            }
+        }
+    }
+
+    std::vector<double> shared_input(num_steps);
+    std::vector<double> shared_control(num_steps);
+    for (int i = 0; i < num_steps; i++) {
+        shared_input[i] = std::sin(i * 0.01);
+        shared_control[i] = std::cos(i * 0.01);
+    }
+
+    std::vector<const double*> inputs(num_engines, shared_input.data());
+    std::vector<const double*> controls(num_engines, shared_control.data());
+    if (per_engine) {
+        for (size_t e = 0; e < num_engines; ++e) {
+            inputs[e] = input_signals[e].data();
+            controls[e] = control_patterns[e].data();
+        }
+    }
+
+    // The first engine's limit and CPUs, as dase_run_ensemble does
+    const auto* first = getEngine(engine_ids[0]);
+    const dase::ThreadBudget::Lease threads =
+        dase::ThreadBudget::process().acquire(first->thread_limit, &first->thread_cpus);
+
+    if (!dase_run_ensemble) {
+        // Older DLL: same results, one mission per engine
+        for (size_t e = 0; e < num_engines; ++e) {
+            dase_run_mission_optimized_phase4c(handles[e], inputs[e], controls[e],
+                                               static_cast<uint64_t>(num_steps),
+                                               static_cast<uint32_t>(iterations_per_node));
+        }
+        return true;
+    }
+
+    const int status = dase_run_ensemble(handles.data(), static_cast<uint32_t>(num_engines),
+                                         inputs.data(), controls.data(),
+                                         static_cast<uint64_t>(num_steps),
+                                         static_cast<uint32_t>(iterations_per_node));
+    if (status != 0) {
+        error_out = "dase_run_ensemble failed (status " + std::to_string(status) + ")";
+        return false;
+    }
+    return true;
+}
+
+bool EngineManager::setNodePsi(const std::string& engine_id, int node_index, double real, double imag) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+
+    if (instance->engine_type == "igsoa_complex") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
+        if (node_index < 0 || node_index >= instance->num_nodes) {
+            return false;
+        }
+        engine->setNodePsi(static_cast<size_t>(node_index), real, imag);
+        return true;
+
+    } else if (instance->engine_type == "igsoa_complex_2d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+        if (node_index < 0 || node_index >= instance->num_nodes) {
+            return false;
+        }
+
+        size_t x = 0;
+        size_t y = 0;
+        engine->indexToCoord(static_cast<size_t>(node_index), x, y);
+        engine->setNodePsi(x, y, real, imag);
+        return true;
+
+    } else if (instance->engine_type == "igsoa_complex_3d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+        if (node_index < 0 || node_index >= instance->num_nodes) {
+            return false;
+        }
+
+        size_t x = 0;
+        size_t y = 0;
+        size_t z = 0;
+        engine->indexToCoord(static_cast<size_t>(node_index), x, y, z);
+        engine->setNodePsi(x, y, z, real, imag);
+        return true;
+    }
+
+    return false;
+}
+
+bool EngineManager::getNodePsi(const std::string& engine_id, int node_index, double& real_out, double& imag_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+
+    if (instance->engine_type == "igsoa_complex") {
+        if (node_index < 0 || node_index >= instance->num_nodes) {
+            return false;
+        }
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
+        engine->getNodePsi(static_cast<size_t>(node_index), real_out, imag_out);
+        return true;
+
+    } else if (instance->engine_type == "igsoa_complex_2d") {
+        if (node_index < 0 || node_index >= instance->num_nodes) {
+            return false;
+        }
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+        size_t x = 0;
+        size_t y = 0;
+        engine->indexToCoord(static_cast<size_t>(node_index), x, y);
+        engine->getNodePsi(x, y, real_out, imag_out);
+        return true;
+
+    } else if (instance->engine_type == "igsoa_complex_3d") {
+        if (node_index < 0 || node_index >= instance->num_nodes) {
+            return false;
         }
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
         size_t x = 0;
@@ -1286,6 +2089,47 @@ bool EngineManager::getNodePsi(const std::string& engine_id, int node_index, dou
     return false;
 }
 
+// Ψ / Φ of a whole IGSOA lattice, row-major, one bulk copy per field
+static bool gatherIgsoaFields(const std::vector<dase::igsoa::IGSOAComplexNode>& nodes,
+                              size_t N_x, size_t N_y, size_t N_z,
+                              double* psi_real,
+                              double* psi_imag,
+                              double* phi) {
+    using dase::igsoa::IGSOABulkAccess;
+    using dase::igsoa::IGSOANodeField;
+
+    const auto all = IGSOABulkAccess::whole(N_x, N_y, N_z);
+    return IGSOABulkAccess::gather(nodes, N_x, N_y, N_z, all, IGSOANodeField::PsiReal, psi_real) &&
+           IGSOABulkAccess::gather(nodes, N_x, N_y, N_z, all, IGSOANodeField::PsiImag, psi_imag) &&
+           IGSOABulkAccess::gather(nodes, N_x, N_y, N_z, all, IGSOANodeField::Phi, phi);
+}
+
+static bool gatherIgsoaStates(const std::vector<dase::igsoa::IGSOAComplexNode>& nodes,
+                              size_t N_x, size_t N_y, size_t N_z,
+                              std::vector<double>& psi_real,
+                              std::vector<double>& psi_imag,
+                              std::vector<double>& phi) {
+    psi_real.resize(nodes.size());
+    psi_imag.resize(nodes.size());
+    phi.resize(nodes.size());
+    return gatherIgsoaFields(nodes, N_x, N_y, N_z, psi_real.data(), psi_imag.data(), phi.data());
+}
+
+// φ, φ̇, h, ḣ of any SATP+Higgs lattice
+template <typename SatpNode>
+static void gatherSatpFields(const std::vector<SatpNode>& nodes,
+                             double* phi_out,
+                             double* phi_dot_out,
+                             double* h_out,
+                             double* h_dot_out) {
+    for (size_t i = 0; i < nodes.size(); i++) {
+        phi_out[i] = nodes[i].phi;
+        phi_dot_out[i] = nodes[i].phi_dot;
+        h_out[i] = nodes[i].h;
+        h_dot_out[i] = nodes[i].h_dot;
+    }
+}
+
 bool EngineManager::getAllNodeStates(const std::string& engine_id,
                                       std::vector<double>& psi_real,
                                       std::vector<double>& psi_imag,
@@ -1298,53 +2142,15 @@ bool EngineManager::getAllNodeStates(const std::string& engine_id,
     if (instance->engine_type == "igsoa_complex") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
         const auto& nodes = engine->getNodes();
-
-        const size_t num_nodes = nodes.size();
-        psi_real.resize(num_nodes);
-        psi_imag.resize(num_nodes);
-        phi.resize(num_nodes);
-
-        for (size_t i = 0; i < num_nodes; i++) {
-            psi_real[i] = nodes[i].psi.real();
-            psi_imag[i] = nodes[i].psi.imag();
-            phi[i] = nodes[i].phi;
-        }
-
-        return true;
+        return gatherIgsoaStates(nodes, nodes.size(), 1, 1, psi_real, psi_imag, phi);
 
     } else if (instance->engine_type == "igsoa_complex_2d") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-        const auto& nodes = engine->getNodes();
-
-        const size_t num_nodes = nodes.size();
-        psi_real.resize(num_nodes);
-        psi_imag.resize(num_nodes);
-        phi.resize(num_nodes);
-
-        for (size_t i = 0; i < num_nodes; i++) {
-            psi_real[i] = nodes[i].psi.real();
-            psi_imag[i] = nodes[i].psi.imag();
-            phi[i] = nodes[i].phi;
-        }
-
-        return true;
+        return gatherIgsoaStates(engine->getNodes(), engine->getNx(), engine->getNy(), 1, psi_real, psi_imag, phi);
 
     } else if (instance->engine_type == "igsoa_complex_3d") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-        const auto& nodes = engine->getNodes();
-
-        const size_t num_nodes = nodes.size();
-        psi_real.resize(num_nodes);
-        psi_imag.resize(num_nodes);
-        phi.resize(num_nodes);
-
-        for (size_t i = 0; i < num_nodes; i++) {
-            psi_real[i] = nodes[i].psi.real();
-            psi_imag[i] = nodes[i].psi.imag();
-            phi[i] = nodes[i].phi;
-        }
-
-        return true;
+        return gatherIgsoaStates(engine->getNodes(), engine->getNx(), engine->getNy(), engine->getNz(), psi_real, psi_imag, phi);
 
     } else if (instance->engine_type == "igsoa_gw") {
         auto* engine = static_cast<IGSOAGWEngine*>(instance->engine_handle);
@@ -1359,9 +2165,7 @@ bool EngineManager::getAllNodeStates(const std::string& engine_id,
         psi_real.clear();
         psi_imag.clear();
         phi.clear();
-        std::vector<double> mag;
-        engine->getState(psi_real, psi_imag, mag);
-        phi = std::move(mag);  // reuse phi slot to expose magnitude for diagnostics
+        engine->getState(psi_real, psi_imag, phi);  // phi slot exposes magnitude for diagnostics
         return true;
 
     } else if (instance->engine_type == "sid_ssp") {
@@ -1395,13 +2199,7 @@ bool EngineManager::getSatpState(const std::string& engine_id,
         phi_dot_out.resize(num_nodes);
         h_out.resize(num_nodes);
         h_dot_out.resize(num_nodes);
-
-        for (size_t i = 0; i < num_nodes; i++) {
-            phi_out[i] = nodes[i].phi;
-            phi_dot_out[i] = nodes[i].phi_dot;
-            h_out[i] = nodes[i].h;
-            h_dot_out[i] = nodes[i].h_dot;
-        }
+        gatherSatpFields(nodes, phi_out.data(), phi_dot_out.data(), h_out.data(), h_dot_out.data());
 
         return true;
 
@@ -1414,13 +2212,7 @@ bool EngineManager::getSatpState(const std::string& engine_id,
         phi_dot_out.resize(num_nodes);
         h_out.resize(num_nodes);
         h_dot_out.resize(num_nodes);
-
-        for (size_t i = 0; i < num_nodes; i++) {
-            phi_out[i] = nodes[i].phi;
-            phi_dot_out[i] = nodes[i].phi_dot;
-            h_out[i] = nodes[i].h;
-            h_dot_out[i] = nodes[i].h_dot;
-        }
+        gatherSatpFields(nodes, phi_out.data(), phi_dot_out.data(), h_out.data(), h_dot_out.data());
 
         return true;
 
@@ -1433,13 +2225,7 @@ bool EngineManager::getSatpState(const std::string& engine_id,
         phi_dot_out.resize(num_nodes);
         h_out.resize(num_nodes);
         h_dot_out.resize(num_nodes);
-
-        for (size_t i = 0; i < num_nodes; i++) {
-            phi_out[i] = nodes[i].phi;
-            phi_dot_out[i] = nodes[i].phi_dot;
-            h_out[i] = nodes[i].h;
-            h_dot_out[i] = nodes[i].h_dot;
-        }
+        gatherSatpFields(nodes, phi_out.data(), phi_dot_out.data(), h_out.data(), h_dot_out.data());
 
         return true;
     }
@@ -1447,599 +2233,2947 @@ bool EngineManager::getSatpState(const std::string& engine_id,
     return false;
 }
 
-bool EngineManager::setIgsoaState(const std::string& engine_id,
-                                   const std::string& profile_type,
-                                   const nlohmann::json& params) {
+bool EngineManager::getPhase4bStateDigest(const std::string& engine_id,
+                                          double tolerance,
+                                          uint64_t& digest_out,
+                                          std::string& error_out) {
     auto* instance = getEngine(engine_id);
-    if (!instance || !instance->engine_handle) {
+    if (!instance || !instance->engine_handle || instance->type_tag != EngineInstance::TypeTag::Phase4B) {
+        error_out = "Not a phase4b engine: " + engine_id;
         return false;
     }
+    if (!dase_get_state_digest) {
+        error_out = "DASE DLL lacks dase_get_state_digest";
+        return false;
+    }
+    if (dase_get_state_digest(instance->engine_handle, tolerance, &digest_out) != 0) {
+        error_out = "dase_get_state_digest failed";
+        return false;
+    }
+    return true;
+}
 
-    try {
-        if (instance->engine_type == "igsoa_complex") {
-            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
-            const size_t num_nodes = static_cast<size_t>(instance->num_nodes);
-
-            if (profile_type == "gaussian") {
-            // Extract Gaussian profile parameters
-            const double amplitude = params.value("amplitude", 1.0);
-            const int default_center = static_cast<int>(num_nodes / 2);
-            const int center_node = params.value<int>("center_node", default_center);
-            const double width = params.value("width", static_cast<double>(num_nodes) / 16.0);
-            const double baseline_phi = params.value("baseline_phi", 0.0);
-
-            // Validate parameters
-            if (width <= 0.0 || !std::isfinite(width)) {
-                return false; // Invalid width
-            }
-            if (center_node < 0 || center_node >= static_cast<int>(num_nodes)) {
-                return false; // Center node out of bounds
-            }
-            if (!std::isfinite(amplitude) || !std::isfinite(baseline_phi)) {
-                return false; // Non-finite parameters
-            }
+bool EngineManager::getStateDims(const std::string& engine_id, size_t dims[3]) const {
+    const auto* instance = getEngineConst(engine_id);
+    if (!instance || !instance->engine_handle || instance->num_nodes <= 0) {
+        return false;
+    }
+    const size_t num_nodes = static_cast<size_t>(instance->num_nodes);
+    dims[0] = num_nodes;
+    dims[1] = 1;
+    dims[2] = 1;
+    if (instance->dimension_x > 0) {
+        const size_t N_x = static_cast<size_t>(instance->dimension_x);
+        const size_t N_y = static_cast<size_t>(std::max(instance->dimension_y, 1));
+        const size_t N_z = static_cast<size_t>(std::max(instance->dimension_z, 1));
+        if (N_x * N_y * N_z == num_nodes) {
+            dims[0] = N_x;
+            dims[1] = N_y;
+            dims[2] = N_z;
+        }
+    }
+    return true;
+}
 
-            // Extract mode parameter (default: "overwrite" for backwards compatibility)
-            std::string mode = params.value("mode", "overwrite");
+// Selected values of one per-node field, read in place through value(i)
+template <typename ValueFn>
+static void gatherSelected(const dase::SnapshotSelection& selection, ValueFn value, std::vector<double>& out) {
+    out.resize(selection.count());
+    double* dst = out.data();
+    if (selection.float32()) {
+        selection.forEachIndex([&](size_t i) { *dst++ = static_cast<float>(value(i)); });
+    } else {
+        selection.forEachIndex([&](size_t i) { *dst++ = value(i); });
+    }
+}
 
-            // Apply Gaussian profile based on mode
-            if (mode == "overwrite") {
-                // MODE: OVERWRITE - Replace entire field with baseline + gaussian
-                for (size_t i = 0; i < num_nodes; i++) {
-                    double distance = static_cast<double>(i) - static_cast<double>(center_node);
-                    double gaussian_value = amplitude * std::exp(-(distance * distance) / (2.0 * width * width));
+static bool gatherSelectedIgsoa(const std::vector<dase::igsoa::IGSOAComplexNode>& nodes,
+                                const dase::SnapshotSelection& selection,
+                                std::vector<std::vector<double>>& fields_out) {
+    if (selection.knownFields() != dase::SnapshotSelection::igsoaFields() ||
+        nodes.size() < selection.latticeSize()) {
+        return false;
+    }
+    const auto& fields = selection.fields();
+    fields_out.resize(fields.size());
+    for (size_t k = 0; k < fields.size(); k++) {
+        if (fields[k] == "psi_real") {
+            gatherSelected(selection, [&](size_t i) { return nodes[i].psi.real(); }, fields_out[k]);
+        } else if (fields[k] == "psi_imag") {
+            gatherSelected(selection, [&](size_t i) { return nodes[i].psi.imag(); }, fields_out[k]);
+        } else if (fields[k] == "phi") {
+            gatherSelected(selection, [&](size_t i) { return nodes[i].phi; }, fields_out[k]);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
 
-                    // Set Ψ (complex quantum state) - using Gaussian magnitude with zero phase
-                    engine->setNodePsi(i, gaussian_value, 0.0);
-
-                    // Set Φ (realized field) to baseline
-                    engine->setNodePhi(i, baseline_phi);
-                }
+template <typename SatpNode>
+static bool gatherSelectedSatp(const std::vector<SatpNode>& nodes,
+                               const dase::SnapshotSelection& selection,
+                               std::vector<std::vector<double>>& fields_out) {
+    if (selection.knownFields() != dase::SnapshotSelection::satpFields() ||
+        nodes.size() < selection.latticeSize()) {
+        return false;
+    }
+    const auto& fields = selection.fields();
+    fields_out.resize(fields.size());
+    for (size_t k = 0; k < fields.size(); k++) {
+        if (fields[k] == "phi") {
+            gatherSelected(selection, [&](size_t i) { return nodes[i].phi; }, fields_out[k]);
+        } else if (fields[k] == "phi_dot") {
+            gatherSelected(selection, [&](size_t i) { return nodes[i].phi_dot; }, fields_out[k]);
+        } else if (fields[k] == "h") {
+            gatherSelected(selection, [&](size_t i) { return nodes[i].h; }, fields_out[k]);
+        } else if (fields[k] == "h_dot") {
+            gatherSelected(selection, [&](size_t i) { return nodes[i].h_dot; }, fields_out[k]);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
 
-            } else if (mode == "add") {
-                // MODE: ADD - Add gaussian on top of existing field values (φ = φ + G)
-                for (size_t i = 0; i < num_nodes; i++) {
-                    double distance = static_cast<double>(i) - static_cast<double>(center_node);
-                    double gaussian_value = amplitude * std::exp(-(distance * distance) / (2.0 * width * width));
-
-                    // Add to Ψ (complex quantum state)
-                    const auto& node = engine->getNodes()[i];
-                    double psi_real = node.psi.real() + gaussian_value;
-                    double psi_imag = node.psi.imag();
-                    engine->setNodePsi(i, psi_real, psi_imag);
-
-                    // Add gaussian to Φ (realized field)
-                    double phi_current = node.phi;
-                    engine->setNodePhi(i, phi_current + gaussian_value);
-                }
+bool EngineManager::getSelectedState(const std::string& engine_id,
+                                     const dase::SnapshotSelection& selection,
+                                     std::vector<std::vector<double>>& fields_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    fields_out.resize(selection.fields().size());
+    for (auto& values : fields_out) {
+        if (values.capacity() == 0) {
+            values = buffer_pool_.acquire(selection.count());
+        }
+    }
 
-            } else if (mode == "blend") {
-                // MODE: BLEND - Blend toward gaussian target: φ = (1-beta)φ + beta(baseline + G)
-                double beta = params.value("beta", 0.1);  // Default blend factor 0.1
-
-                for (size_t i = 0; i < num_nodes; i++) {
-                    double distance = static_cast<double>(i) - static_cast<double>(center_node);
-                    double gaussian_value = amplitude * std::exp(-(distance * distance) / (2.0 * width * width));
-
-                    // Blend Ψ toward target
-                    const auto& node = engine->getNodes()[i];
-                    double target_psi_real = gaussian_value;
-                    double target_psi_imag = 0.0;
-                    double blended_psi_real = (1.0 - beta) * node.psi.real() + beta * target_psi_real;
-                    double blended_psi_imag = (1.0 - beta) * node.psi.imag() + beta * target_psi_imag;
-                    engine->setNodePsi(i, blended_psi_real, blended_psi_imag);
-
-                    // Blend Φ toward baseline + gaussian
-                    double target_phi = baseline_phi + gaussian_value;
-                    double blended_phi = (1.0 - beta) * node.phi + beta * target_phi;
-                    engine->setNodePhi(i, blended_phi);
-                }
+    if (instance->engine_type == "igsoa_complex") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
+        return gatherSelectedIgsoa(engine->getNodes(), selection, fields_out);
+    } else if (instance->engine_type == "igsoa_complex_2d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+        return gatherSelectedIgsoa(engine->getNodes(), selection, fields_out);
+    } else if (instance->engine_type == "igsoa_complex_3d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+        return gatherSelectedIgsoa(engine->getNodes(), selection, fields_out);
+    } else if (instance->engine_type == "satp_higgs_1d") {
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
+        return gatherSelectedSatp(engine->getNodes(), selection, fields_out);
+    } else if (instance->engine_type == "satp_higgs_2d") {
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
+        return gatherSelectedSatp(engine->getNodes(), selection, fields_out);
+    } else if (instance->engine_type == "satp_higgs_3d") {
+        auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
+        return gatherSelectedSatp(engine->getNodes(), selection, fields_out);
+    }
 
-            } else {
-                // Unknown mode - fail
-                return false;
+    // Engines without an in-place node view (GW, FFTW example, SID):
+    // copy the whole state into the engine's scratch, then select
+    const auto& names = dase::SnapshotSelection::igsoaFields();
+    const dase::ExtractionBuffers* full = nullptr;
+    if (selection.knownFields() != names || !(full = extractAllNodeStates(engine_id))) {
+        return false;
+    }
+    const auto& fields = selection.fields();
+    for (size_t k = 0; k < fields.size(); k++) {
+        const size_t slot = static_cast<size_t>(std::find(names.begin(), names.end(), fields[k]) - names.begin());
+        if (slot >= names.size()) {
+            return false;
+        }
+        selection.select(full->fields[slot], fields_out[k]);
+        if (selection.float32()) {
+            for (double& value : fields_out[k]) {
+                value = static_cast<float>(value);
             }
+        }
+    }
+    return true;
+}
 
-            return true;
+const dase::ExtractionBuffers* EngineManager::extractAllNodeStates(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!instance) {
+        return nullptr;
+    }
+    auto& buffers = instance->extraction.fields;
+    buffers[3].clear();
+    return getAllNodeStates(engine_id, buffers[0], buffers[1], buffers[2]) ? &instance->extraction : nullptr;
+}
 
-        } else if (profile_type == "uniform") {
-            // Extract uniform profile parameters
-            double psi_real = params.value("psi_real", 0.1);
-            double psi_imag = params.value("psi_imag", 0.0);
-            double phi = params.value("phi", 0.0);
+const dase::ExtractionBuffers* EngineManager::extractSatpState(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!instance) {
+        return nullptr;
+    }
+    auto& buffers = instance->extraction.fields;
+    return getSatpState(engine_id, buffers[0], buffers[1], buffers[2], buffers[3]) ? &instance->extraction : nullptr;
+}
 
-            // Apply uniform state to all nodes
-            for (size_t i = 0; i < num_nodes; i++) {
-                engine->setNodePsi(i, psi_real, psi_imag);
-                engine->setNodePhi(i, phi);
-            }
+bool EngineManager::gatherAllNodeStates(const std::string& engine_id,
+                                         double* psi_real,
+                                         double* psi_imag,
+                                         double* phi,
+                                         size_t capacity) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
 
-            return true;
+    if (instance->engine_type == "igsoa_complex") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
+        const auto& nodes = engine->getNodes();
+        return nodes.size() <= capacity &&
+               gatherIgsoaFields(nodes, nodes.size(), 1, 1, psi_real, psi_imag, phi);
 
-        } else if (profile_type == "localized") {
-            // Extract localized profile parameters
-            int node_index = params.value("node_index", 0);
-            double psi_real = params.value("psi_real", 1.0);
-            double psi_imag = params.value("psi_imag", 0.0);
-            double phi = params.value("phi", 0.0);
+    } else if (instance->engine_type == "igsoa_complex_2d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+        return engine->getNodes().size() <= capacity &&
+               gatherIgsoaFields(engine->getNodes(), engine->getNx(), engine->getNy(), 1, psi_real, psi_imag, phi);
 
-            // Zero out all nodes first
-            for (size_t i = 0; i < num_nodes; i++) {
-                engine->setNodePsi(i, 0.0, 0.0);
-                engine->setNodePhi(i, 0.0);
-            }
+    } else if (instance->engine_type == "igsoa_complex_3d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+        return engine->getNodes().size() <= capacity &&
+               gatherIgsoaFields(engine->getNodes(), engine->getNx(), engine->getNy(), engine->getNz(),
+                                 psi_real, psi_imag, phi);
+    }
 
-            // Set single node
-            if (node_index >= 0 && node_index < static_cast<int>(num_nodes)) {
-                engine->setNodePsi(node_index, psi_real, psi_imag);
-                engine->setNodePhi(node_index, phi);
-            }
+    // Engines that only hand out vectors: one copy through them
+    std::vector<double> r, i, p;
+    if (!getAllNodeStates(engine_id, r, i, p) ||
+        r.size() > capacity || i.size() > capacity || p.size() > capacity) {
+        return false;
+    }
+    std::copy(r.begin(), r.end(), psi_real);
+    std::copy(i.begin(), i.end(), psi_imag);
+    std::copy(p.begin(), p.end(), phi);
+    return true;
+}
 
-            return true;
+bool EngineManager::gatherSatpState(const std::string& engine_id,
+                                     double* phi_out,
+                                     double* phi_dot_out,
+                                     double* h_out,
+                                     double* h_dot_out,
+                                     size_t capacity) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
 
-        } else {
-            // Unsupported profile type
+    if (instance->engine_type == "satp_higgs_1d") {
+        const auto& nodes = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle)->getNodes();
+        if (nodes.size() > capacity) return false;
+        gatherSatpFields(nodes, phi_out, phi_dot_out, h_out, h_dot_out);
+        return true;
+
+    } else if (instance->engine_type == "satp_higgs_2d") {
+        const auto& nodes = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle)->getNodes();
+        if (nodes.size() > capacity) return false;
+        gatherSatpFields(nodes, phi_out, phi_dot_out, h_out, h_dot_out);
+        return true;
+
+    } else if (instance->engine_type == "satp_higgs_3d") {
+        const auto& nodes = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->getNodes();
+        if (nodes.size() > capacity) return false;
+        gatherSatpFields(nodes, phi_out, phi_dot_out, h_out, h_dot_out);
+        return true;
+    }
+
+    return false;
+}
+
+bool EngineManager::mapState(const std::string& engine_id,
+                             const std::string& segment_name,
+                             int publish_interval,
+                             nlohmann::json& layout_out,
+                             std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (publish_interval < 0) {
+        error_out = "publish_interval must be >= 0";
+        return false;
+    }
+
+    // Size the segment from one regular extraction
+    const bool satp = instance->engine_type.rfind("satp_higgs", 0) == 0;
+    std::vector<std::string> fields;
+    size_t num_nodes = 0;
+    if (satp) {
+        std::vector<double> phi, phi_dot, h, h_dot;
+        if (!getSatpState(engine_id, phi, phi_dot, h, h_dot)) {
+            error_out = "Failed to extract state";
+            return false;
+        }
+        fields = {"phi", "phi_dot", "h", "h_dot"};
+        num_nodes = phi.size();
+    } else {
+        std::vector<double> psi_real, psi_imag, phi;
+        if (!getAllNodeStates(engine_id, psi_real, psi_imag, phi)) {
+            error_out = "Engine type has no exportable state: " + instance->engine_type;
             return false;
         }
+        fields = {"psi_real", "psi_imag", "phi"};
+        num_nodes = std::max({psi_real.size(), psi_imag.size(), phi.size()});
+    }
 
-        } else if (instance->engine_type == "igsoa_complex_2d") {
-            auto* engine2d = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-            size_t N_x = instance->dimension_x > 0 ? static_cast<size_t>(instance->dimension_x) : engine2d->getNx();
-            size_t N_y = instance->dimension_y > 0 ? static_cast<size_t>(instance->dimension_y) : engine2d->getNy();
+    const uint32_t dims[3] = {
+        static_cast<uint32_t>(instance->dimension_x > 0 ? instance->dimension_x : static_cast<int>(num_nodes)),
+        static_cast<uint32_t>(instance->dimension_y > 0 ? instance->dimension_y : 1),
+        static_cast<uint32_t>(instance->dimension_z > 0 ? instance->dimension_z : 1)
+    };
 
-            if (profile_type == "gaussian" || profile_type == "gaussian_2d") {
-                dase::igsoa::Gaussian2DParams gparams;
-                gparams.amplitude = params.value("amplitude", 1.0);
-                gparams.center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
-                gparams.center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
-                double default_sigma_x = (std::max)(1.0, static_cast<double>(N_x) / 16.0);
-                double default_sigma_y = (std::max)(1.0, static_cast<double>(N_y) / 16.0);
-                gparams.sigma_x = params.value("sigma_x", default_sigma_x);
-                gparams.sigma_y = params.value("sigma_y", default_sigma_y);
-                gparams.baseline_phi = params.value("baseline_phi", 0.0);
-                gparams.mode = params.value("mode", std::string("overwrite"));
-                gparams.beta = params.value("beta", 1.0);
+    // Replacing an existing export releases its segment first
+    unmapState(engine_id);
+    StateExportBinding binding;
+    binding.segment = dase::SharedStateExport::create(segment_name, fields, num_nodes, dims, error_out);
+    if (!binding.segment) {
+        return false;
+    }
+    binding.satp = satp;
+    binding.publish_interval = publish_interval;
+    {
+        std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+        state_exports_[engine_id] = std::move(binding);
+    }
 
-                dase::igsoa::IGSOAStateInit2D::initGaussian2D(*engine2d, gparams);
-                return true;
+    if (!publishState(engine_id)) {
+        unmapState(engine_id);
+        error_out = "Failed to publish initial state";
+        return false;
+    }
+    layout_out = state_exports_[engine_id].segment->describe();
+    layout_out["publish_interval"] = publish_interval;
+    return true;
+}
 
-            } else if (profile_type == "circular_gaussian" || profile_type == "circular_gaussian_2d") {
-                double amplitude = params.value("amplitude", 1.0);
-                double center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
-                double center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
-                double min_dim = (std::min)(static_cast<double>(N_x), static_cast<double>(N_y));
-                double default_sigma = (std::max)(1.0, min_dim / 16.0);
-                double sigma = params.value("sigma", default_sigma);
-                double baseline_phi = params.value("baseline_phi", 0.0);
-                std::string mode = params.value("mode", std::string("overwrite"));
-                double beta = params.value("beta", 1.0);
+namespace {
 
-                dase::igsoa::IGSOAStateInit2D::initCircularGaussian(
-                    *engine2d,
-                    amplitude,
-                    center_x,
-                    center_y,
-                    sigma,
-                    baseline_phi,
-                    mode,
-                    beta
-                );
+const char* const kStreamableMetrics[] = {
+    "step", "ns_per_op", "ops_per_sec", "total_operations", "speedup_factor",
+    "hw_cycles", "hw_instructions", "hw_llc_misses", "hw_ipc", "hw_dram_bandwidth_gbps",
+    "achieved_gbps", "achieved_gflops", "arithmetic_intensity"
+};
 
-                return true;
+bool isStreamableMetric(const std::string& name) {
+    return std::find(std::begin(kStreamableMetrics), std::end(kStreamableMetrics), name) !=
+           std::end(kStreamableMetrics);
+}
 
-            } else if (profile_type == "plane_wave_2d" || profile_type == "plane_wave") {
-                dase::igsoa::PlaneWave2DParams wave_params;
-                wave_params.amplitude = params.value("amplitude", 1.0);
-                const double kx_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_x));
-                const double ky_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_y));
-                wave_params.k_x = params.value("k_x", kx_default);
-                wave_params.k_y = params.value("k_y", ky_default);
-                wave_params.phase_offset = params.value("phase_offset", 0.0);
+} // namespace
 
-                dase::igsoa::IGSOAStateInit2D::initPlaneWave2D(*engine2d, wave_params);
-                return true;
+bool EngineManager::subscribeMetrics(const std::string& engine_id,
+                                     const std::vector<std::string>& names,
+                                     const dase::MetricEmitterOptions& options,
+                                     const std::string& sink,
+                                     const std::string& target,
+                                     nlohmann::json& info_out,
+                                     std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (names.empty()) {
+        error_out = "No metrics named";
+        return false;
+    }
+    for (const auto& name : names) {
+        if (!isStreamableMetric(name)) {
+            error_out = "Unknown metric: " + name;
+            return false;
+        }
+    }
 
-            } else if (profile_type == "uniform") {
-                double psi_real = params.value("psi_real", 0.1);
-                double psi_imag = params.value("psi_imag", 0.0);
-                double phi = params.value("phi", 0.0);
+    // Replacing a subscription flushes and closes the old sink first
+    unsubscribeMetrics(engine_id);
+    std::unique_ptr<dase::MetricSink> metric_sink;
+    if (sink == "stdout") {
+        metric_sink = dase::makeStdoutMetricSink();
+    } else if (sink == "binary") {
+        metric_sink = dase::makeBinaryMetricSink(target, names, error_out);
+    } else if (sink == "shm") {
+        metric_sink = dase::makeSharedMemoryMetricSink(target, names, options.buffer_samples, error_out);
+    } else {
+        error_out = "Unknown metric sink: " + sink;
+    }
+    if (!metric_sink) {
+        return false;
+    }
 
-                dase::igsoa::IGSOAStateInit2D::initUniform(*engine2d, psi_real, psi_imag, phi);
-                return true;
+    MetricBinding binding;
+    binding.emitter = std::make_unique<dase::MetricEmitter>(engine_id, names, options, std::move(metric_sink));
+    info_out = binding.emitter->describe();
+    {
+        std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+        metric_bindings_[engine_id] = std::move(binding);
+    }
+    return true;
+}
 
-            } else if (profile_type == "random" || profile_type == "random_2d") {
-                double amplitude = params.value("amplitude", 1.0);
-                unsigned int seed = params.value("seed", 0u);
+bool EngineManager::unsubscribeMetrics(const std::string& engine_id) {
+    std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+    return metric_bindings_.erase(engine_id) > 0;
+}
 
-                dase::igsoa::IGSOAStateInit2D::initRandom(*engine2d, amplitude, seed);
-                return true;
+bool EngineManager::sampleMetrics(const std::string& engine_id,
+                                  const std::vector<std::string>& names,
+                                  uint64_t step,
+                                  double* values_out) {
+    const EngineMetrics m = getMetrics(engine_id);
+    for (size_t k = 0; k < names.size(); ++k) {
+        const std::string& name = names[k];
+        if (name == "step") values_out[k] = static_cast<double>(step);
+        else if (name == "ns_per_op") values_out[k] = m.ns_per_op;
+        else if (name == "ops_per_sec") values_out[k] = m.ops_per_sec;
+        else if (name == "total_operations") values_out[k] = static_cast<double>(m.total_operations);
+        else if (name == "speedup_factor") values_out[k] = m.speedup_factor;
+        else if (name == "hw_cycles") values_out[k] = static_cast<double>(m.hw_cycles);
+        else if (name == "hw_instructions") values_out[k] = static_cast<double>(m.hw_instructions);
+        else if (name == "hw_llc_misses") values_out[k] = static_cast<double>(m.hw_llc_misses);
+        else if (name == "hw_ipc") values_out[k] = m.hw_ipc;
+        else if (name == "hw_dram_bandwidth_gbps") values_out[k] = m.hw_dram_bandwidth_gbps;
+        else if (name == "achieved_gbps") values_out[k] = m.achieved_gbps;
+        else if (name == "achieved_gflops") values_out[k] = m.achieved_gflops;
+        else if (name == "arithmetic_intensity") values_out[k] = m.arithmetic_intensity;
+        else return false;
+    }
+    return true;
+}
 
-            } else if (profile_type == "reset") {
-                engine2d->reset();
-                return true;
+bool EngineManager::unmapState(const std::string& engine_id) {
+    std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+    return state_exports_.erase(engine_id) > 0;
+}
 
-            } else {
-                return false;
-            }
+bool EngineManager::publishState(const std::string& engine_id) {
+    StateExportBinding* found = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> registry_lock(registry_mutex_);
+        auto it = state_exports_.find(engine_id);
+        if (it != state_exports_.end()) {
+            found = &it->second;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    StateExportBinding& binding = *found;
+    dase::SharedStateExport& segment = *binding.segment;
+
+    segment.beginPublish();
+    const bool ok = binding.satp
+        ? gatherSatpState(engine_id, segment.field(0), segment.field(1), segment.field(2), segment.field(3),
+                          segment.numNodes())
+        : gatherAllNodeStates(engine_id, segment.field(0), segment.field(1), segment.field(2),
+                              segment.numNodes());
+    segment.endPublish(binding.steps);
+    return ok;
+}
 
-        } else if (instance->engine_type == "igsoa_complex_3d") {
-            auto* engine3d = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-            size_t N_x = instance->dimension_x > 0 ? static_cast<size_t>(instance->dimension_x) : engine3d->getNx();
-            size_t N_y = instance->dimension_y > 0 ? static_cast<size_t>(instance->dimension_y) : engine3d->getNy();
-            size_t N_z = instance->dimension_z > 0 ? static_cast<size_t>(instance->dimension_z) : engine3d->getNz();
+bool EngineManager::bufferState(const std::string& engine_id,
+                                const dase::SnapshotSelection& selection,
+                                size_t frames,
+                                int publish_interval,
+                                nlohmann::json& info_out,
+                                std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (publish_interval < 1) {
+        error_out = "publish_interval must be >= 1";
+        return false;
+    }
+    if (frames < dase::SnapshotBuffer::kMinFrames || frames > dase::SnapshotBuffer::kMaxFrames) {
+        error_out = "frames must be in [" + std::to_string(dase::SnapshotBuffer::kMinFrames) + ", " +
+                    std::to_string(dase::SnapshotBuffer::kMaxFrames) + "]";
+        return false;
+    }
 
-            if (profile_type == "gaussian" || profile_type == "gaussian_3d") {
-                dase::igsoa::Gaussian3DParams params3d;
-                params3d.amplitude = params.value("amplitude", 1.0);
-                params3d.center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
-                params3d.center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
-                params3d.center_z = params.value("center_z", static_cast<double>(N_z) / 2.0);
-                double default_sigma_x = (std::max)(1.0, static_cast<double>(N_x) / 16.0);
-                double default_sigma_y = (std::max)(1.0, static_cast<double>(N_y) / 16.0);
-                double default_sigma_z = (std::max)(1.0, static_cast<double>(N_z) / 16.0);
-                params3d.sigma_x = params.value("sigma_x", default_sigma_x);
-                params3d.sigma_y = params.value("sigma_y", default_sigma_y);
-                params3d.sigma_z = params.value("sigma_z", default_sigma_z);
-                params3d.baseline_phi = params.value("baseline_phi", 0.0);
-                params3d.mode = params.value("mode", std::string("overwrite"));
-                params3d.beta = params.value("beta", 1.0);
+    SnapshotBinding binding;
+    binding.buffer = std::make_shared<dase::SnapshotBuffer>(selection, frames, publish_interval);
+    if (!publishSnapshot(engine_id, binding)) {
+        error_out = "Failed to extract state";
+        return false;
+    }
+    info_out = binding.buffer->describe();
+    {
+        std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+        snapshot_buffers_[engine_id] = std::move(binding);
+    }
+    return true;
+}
 
-                dase::igsoa::IGSOAStateInit3D::initGaussian3D(*engine3d, params3d);
-                return true;
+bool EngineManager::unbufferState(const std::string& engine_id) {
+    std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+    return snapshot_buffers_.erase(engine_id) > 0;
+}
 
-            } else if (profile_type == "spherical_gaussian" || profile_type == "gaussian_spherical") {
-                double amplitude = params.value("amplitude", 1.0);
-                double center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
-                double center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
-                double center_z = params.value("center_z", static_cast<double>(N_z) / 2.0);
-                size_t min_dim = (std::min)((std::min)(N_x, N_y), N_z);
-                double default_sigma = (std::max)(1.0, static_cast<double>(min_dim) / 16.0);
+std::shared_ptr<dase::SnapshotBuffer> EngineManager::snapshotBuffer(const std::string& engine_id) const {
+    std::shared_lock<std::shared_mutex> registry_lock(registry_mutex_);
+    auto it = snapshot_buffers_.find(engine_id);
+    return it == snapshot_buffers_.end() ? nullptr : it->second.buffer;
+}
+
+bool EngineManager::publishSnapshot(const std::string& engine_id, SnapshotBinding& binding) {
+    dase::SnapshotBuffer& buffer = *binding.buffer;
+    dase::SnapshotBuffer::Frame* frame = buffer.beginPublish();
+    if (!frame || !getSelectedState(engine_id, buffer.selection(), frame->fields)) {
+        return false;
+    }
+    double simulated_time = std::numeric_limits<double>::quiet_NaN();
+    getSimulatedTime(engine_id, simulated_time);
+    buffer.endPublish(frame, binding.steps, simulated_time);
+    return true;
+}
+
+// Header-only engines: their own sections plus the manager's "config"
+template <typename Engine>
+static void writeEngineCheckpoint(const void* handle, const std::string& config, const std::string& path) {
+    dase::CheckpointWriter writer;
+    static_cast<const Engine*>(handle)->saveCheckpoint(writer);
+    writer.addText("config", config);
+    writer.write(path);
+}
+
+template <typename Engine>
+static void readEngineCheckpoint(void* handle, const dase::CheckpointImage& image) {
+    static_cast<Engine*>(handle)->restoreCheckpoint(image);
+}
+
+template <typename Engine>
+static uint64_t engineStateBytes(const void* handle) {
+    dase::CheckpointWriter writer;
+    static_cast<const Engine*>(handle)->saveCheckpoint(writer);
+    return writer.payloadBytes();
+}
+
+uint64_t EngineManager::stateBytes(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return 0;
+    }
+    const void* handle = instance->engine_handle;
+    try {
+        switch (instance->type_tag) {
+            case EngineInstance::TypeTag::IgsoaComplex:
+                return engineStateBytes<dase::igsoa::IGSOAComplexEngine>(handle);
+            case EngineInstance::TypeTag::IgsoaComplex2D:
+                return engineStateBytes<dase::igsoa::IGSOAComplexEngine2D>(handle);
+            case EngineInstance::TypeTag::IgsoaComplex3D:
+                return engineStateBytes<dase::igsoa::IGSOAComplexEngine3D>(handle);
+            case EngineInstance::TypeTag::IgsoaGW:
+                return engineStateBytes<IGSOAGWEngine>(handle);
+            case EngineInstance::TypeTag::SatpHiggs1D:
+                return engineStateBytes<dase::satp_higgs::SATPHiggsEngine1D>(handle);
+            case EngineInstance::TypeTag::SatpHiggs2D:
+                return engineStateBytes<dase::satp_higgs::SATPHiggsEngine2D>(handle);
+            case EngineInstance::TypeTag::SatpHiggs3D:
+                return engineStateBytes<dase::satp_higgs::SATPHiggsEngine3D>(handle);
+            default:
+                // Phase 4B state lives in the DLL; it only checkpoints to a file
+                return 0;
+        }
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+void EngineManager::setMemoryBudget(uint64_t bytes) {
+    memory_budget_.store(bytes);
+}
+
+uint64_t EngineManager::getAdmittedBytes() const {
+    std::lock_guard<std::mutex> lock(memory_mutex_);
+    return admitted_bytes_;
+}
+
+void EngineManager::setThreadBudget(int threads) {
+    dase::ThreadBudget::process().setCapacity(threads);
+    if (dase_set_thread_budget) {
+        dase_set_thread_budget(dase::ThreadBudget::process().capacity());
+    }
+}
+
+nlohmann::json EngineManager::threadBudgetStats() const {
+    const dase::ThreadBudgetStats stats = dase::ThreadBudget::process().stats();
+    return {
+        {"capacity", stats.capacity},
+        {"in_use", stats.in_use},
+        {"holders", stats.holders},
+        {"peak", stats.peak},
+        {"leases", stats.leases},
+        {"reduced", stats.reduced}
+    };
+}
+
+bool EngineManager::setThreadLimit(const std::string& engine_id, int threads, const std::vector<int>& cpus) {
+    auto* instance = getEngine(engine_id);
+    if (!instance) {
+        return false;
+    }
+    instance->thread_limit = threads;
+    instance->thread_cpus = cpus;
+    return true;
+}
+
+std::string EngineManager::getEngineLibraryPath() {
+    return engine_library.path();
+}
+
+bool EngineManager::estimateEngineMemory(const std::string& engine_type,
+                                         int num_nodes,
+                                         double R_c,
+                                         int N_x,
+                                         int N_y,
+                                         int N_z,
+                                         int num_replicas,
+                                         dase::MemoryFootprint& out) {
+    out = dase::MemoryFootprint();
+    // Shapes createEngine would reject are not estimated (it fails anyway)
+    const bool planar = N_x > 0 && N_y > 0;
+    const bool solid = planar && N_z > 0;
+    dase::igsoa::IGSOAComplexConfig config;
+    config.R_c_default = R_c;
+
+    if (engine_type == "igsoa_complex" && num_nodes > 0) {
+        config.num_nodes = static_cast<uint32_t>(num_nodes);
+        out = dase::igsoa::IGSOAComplexEngine::estimateMemory(config);
+    } else if (engine_type == "igsoa_complex_2d" && planar) {
+        out = dase::igsoa::IGSOAComplexEngine2D::estimateMemory(config, static_cast<size_t>(N_x),
+                                                                static_cast<size_t>(N_y));
+    } else if (engine_type == "igsoa_complex_3d" && solid) {
+        out = dase::igsoa::IGSOAComplexEngine3D::estimateMemory(config, static_cast<size_t>(N_x),
+                                                                static_cast<size_t>(N_y), static_cast<size_t>(N_z));
+    } else if (engine_type == "igsoa_ensemble_1d" && num_nodes > 0 && num_replicas > 0) {
+        config.num_nodes = static_cast<uint32_t>(num_nodes);
+        out = dase::igsoa::IGSOAEnsembleEngine1D::estimateMemory(config, static_cast<size_t>(num_replicas));
+    } else if (engine_type == "igsoa_gw") {
+        dase::igsoa::gw::SymmetryFieldConfig field_config;
+        field_config.nx = (N_x > 0) ? N_x : 16;
+        field_config.ny = (N_y > 0) ? N_y : 16;
+        field_config.nz = (N_z > 0) ? N_z : 16;
+        dase::igsoa::gw::FractionalSolverConfig solver_config;
+        out = IGSOAGWEngine::estimateMemory(field_config, solver_config);
+    } else if (engine_type == "satp_higgs_1d" && num_nodes > 0) {
+        out = dase::satp_higgs::SATPHiggsEngine1D::estimateMemory(static_cast<size_t>(num_nodes));
+    } else if (engine_type == "satp_higgs_2d" && planar) {
+        out = dase::satp_higgs::SATPHiggsEngine2D::estimateMemory(static_cast<size_t>(N_x), static_cast<size_t>(N_y));
+    } else if (engine_type == "satp_higgs_3d" && solid) {
+        out = dase::satp_higgs::SATPHiggsEngine3D::estimateMemory(static_cast<size_t>(N_x), static_cast<size_t>(N_y),
+                                                                  static_cast<size_t>(N_z));
+    } else if (engine_type == "fftw_cache_example" && num_nodes > 0) {
+        out.state = static_cast<uint64_t>(num_nodes) * sizeof(fftw_complex);
+    } else if (engine_type == "sid_ternary" && num_nodes > 0) {
+        out.state = 3 * static_cast<uint64_t>(num_nodes) * sizeof(double);   // I / N / U fields
+    } else if (engine_type == "sid_ssp" && num_nodes > 0) {
+        out.state = static_cast<uint64_t>(num_nodes) * sizeof(double);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool EngineManager::engineMemory(const std::string& engine_id, dase::MemoryFootprint& out, bool& tracked) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    const void* handle = instance->engine_handle;
+    tracked = true;
+    out = dase::MemoryFootprint();
+    switch (instance->type_tag) {
+        case EngineInstance::TypeTag::IgsoaComplex:
+            out = static_cast<const dase::igsoa::IGSOAComplexEngine*>(handle)->memoryFootprint();
+            break;
+        case EngineInstance::TypeTag::IgsoaComplex2D:
+            out = static_cast<const dase::igsoa::IGSOAComplexEngine2D*>(handle)->memoryFootprint();
+            break;
+        case EngineInstance::TypeTag::IgsoaComplex3D:
+            out = static_cast<const dase::igsoa::IGSOAComplexEngine3D*>(handle)->memoryFootprint();
+            break;
+        case EngineInstance::TypeTag::IgsoaEnsemble1D:
+            out = static_cast<const dase::igsoa::IGSOAEnsembleEngine1D*>(handle)->memoryFootprint();
+            break;
+        case EngineInstance::TypeTag::IgsoaGW:
+            out = static_cast<const IGSOAGWEngine*>(handle)->memoryFootprint();
+            break;
+        case EngineInstance::TypeTag::SatpHiggs1D:
+            out = static_cast<const dase::satp_higgs::SATPHiggsEngine1D*>(handle)->memoryFootprint();
+            break;
+        case EngineInstance::TypeTag::SatpHiggs2D:
+            out = static_cast<const dase::satp_higgs::SATPHiggsEngine2D*>(handle)->memoryFootprint();
+            break;
+        case EngineInstance::TypeTag::SatpHiggs3D:
+            out = static_cast<const dase::satp_higgs::SATPHiggsEngine3D*>(handle)->memoryFootprint();
+            break;
+        case EngineInstance::TypeTag::FFTWCache:
+        case EngineInstance::TypeTag::SidTernary:
+        case EngineInstance::TypeTag::SidSSP:
+            // Only their fields are known: the creation estimate
+            estimateEngineMemory(instance->engine_type, instance->num_nodes, instance->R_c, 0, 0, 0, 1, out);
+            break;
+        default:
+            tracked = false;
+            break;
+    }
+    return true;
+}
+
+bool EngineManager::checkpointEngine(const std::string& engine_id,
+                                     const std::string& path,
+                                     nlohmann::json& info_out,
+                                     std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+
+    // Everything createEngine needs to rebuild the instance, plus the SID
+    // wrapper bookkeeping kept here rather than in the engine
+    nlohmann::json config = {
+        {"engine_type", instance->engine_type},
+        {"num_nodes", instance->num_nodes},
+        {"dimension_x", instance->dimension_x},
+        {"dimension_y", instance->dimension_y},
+        {"dimension_z", instance->dimension_z},
+        {"R_c", instance->R_c},
+        {"kappa", instance->kappa},
+        {"gamma", instance->gamma},
+        {"dt", instance->dt},
+        {"alpha", instance->alpha},
+        {"sid_role", instance->sid_role}
+    };
+    auto wrapper_it = sid_wrapper_state_.find(engine_id);
+    if (wrapper_it != sid_wrapper_state_.end()) {
+        const SidWrapperState& wrapper = wrapper_it->second;
+        config["sid_wrapper"] = {
+            {"I_mass", wrapper.I_mass},
+            {"N_mass", wrapper.N_mass},
+            {"U_mass", wrapper.U_mass},
+            {"motion_applied_count", wrapper.motion_applied_count},
+            {"event_cursor", wrapper.event_cursor},
+            {"last_motion", wrapper.last_motion},
+            {"initialized", wrapper.initialized}
+        };
+    }
+    auto events_it = sid_rewrite_events_.find(engine_id);
+    if (events_it != sid_rewrite_events_.end()) {
+        config["sid_rewrite_events"] = events_it->second.eventsJson();
+        const auto& options = events_it->second.options();
+        config["sid_rewrite_log"] = {{"capacity", options.capacity}, {"applied_only", options.applied_only}};
+    }
+    const std::string config_text = config.dump();
+
+    void* handle = instance->engine_handle;
+    try {
+        switch (instance->type_tag) {
+            case EngineInstance::TypeTag::Phase4B: {
+                if (!dase_checkpoint_engine) {
+                    error_out = "DASE DLL lacks dase_checkpoint_engine";
+                    return false;
+                }
+                char error_msg[256] = {};
+                const int status = dase_checkpoint_engine(handle, path.c_str(), config_text.c_str(),
+                                                          error_msg, sizeof(error_msg));
+                if (status != 0) {
+                    error_out = "dase_checkpoint_engine failed (status " + std::to_string(status) + "): " + error_msg;
+                    return false;
+                }
+                break;
+            }
+            case EngineInstance::TypeTag::IgsoaComplex:
+                writeEngineCheckpoint<dase::igsoa::IGSOAComplexEngine>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex2D:
+                writeEngineCheckpoint<dase::igsoa::IGSOAComplexEngine2D>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex3D:
+                writeEngineCheckpoint<dase::igsoa::IGSOAComplexEngine3D>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::IgsoaGW:
+                writeEngineCheckpoint<IGSOAGWEngine>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs1D:
+                writeEngineCheckpoint<dase::satp_higgs::SATPHiggsEngine1D>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs2D:
+                writeEngineCheckpoint<dase::satp_higgs::SATPHiggsEngine2D>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs3D:
+                writeEngineCheckpoint<dase::satp_higgs::SATPHiggsEngine3D>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::FFTWCache:
+                writeEngineCheckpoint<FFTWCacheExampleEngine>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::SidTernary:
+                if (!sid_checkpoint_engine(static_cast<sid_engine*>(handle), path.c_str(), config_text.c_str())) {
+                    error_out = "sid_checkpoint_engine failed to write " + path;
+                    return false;
+                }
+                break;
+            case EngineInstance::TypeTag::SidSSP:
+                writeEngineCheckpoint<SidSSPEngine>(handle, config_text, path);
+                break;
+            case EngineInstance::TypeTag::Unknown:
+            default:
+                error_out = "Engine type cannot be checkpointed: " + instance->engine_type;
+                return false;
+        }
+    } catch (const std::exception& e) {
+        error_out = e.what();
+        return false;
+    }
+
+    info_out = {
+        {"engine_id", engine_id},
+        {"engine_type", instance->engine_type},
+        {"num_nodes", instance->num_nodes},
+        {"path", path}
+    };
+    return true;
+}
+
+bool EngineManager::restoreEngine(const std::string& path,
+                                  const std::string& engine_id,
+                                  nlohmann::json& info_out,
+                                  std::string& error_out) {
+    std::unique_ptr<dase::CheckpointImage> image;
+    nlohmann::json config;
+    try {
+        image = std::make_unique<dase::CheckpointImage>(path);
+        if (!image->has("config")) {
+            error_out = "Not an engine checkpoint (no config section): " + path;
+            return false;
+        }
+        config = nlohmann::json::parse(image->text("config"));
+    } catch (const std::exception& e) {
+        error_out = e.what();
+        return false;
+    }
+    const std::string engine_type = config.value("engine_type", "");
+
+    // Restore into the named engine if it exists, else create it
+    EngineInstance* instance = engine_id.empty() ? nullptr : getEngine(engine_id);
+    bool created = false;
+    if (instance) {
+        if (instance->engine_type != engine_type) {
+            error_out = "Checkpoint holds a " + engine_type + " engine; " + engine_id +
+                        " is " + instance->engine_type;
+            return false;
+        }
+    } else {
+        const std::string id = createEngine(engine_type,
+                                            config.value("num_nodes", 0),
+                                            config.value("R_c", 1.0),
+                                            config.value("kappa", 1.0),
+                                            config.value("gamma", 0.1),
+                                            config.value("dt", 0.01),
+                                            config.value("alpha", 0.1),
+                                            config.value("dimension_x", 0),
+                                            config.value("dimension_y", 0),
+                                            config.value("dimension_z", 0),
+                                            config.value("sid_role", 2),
+                                            engine_id);
+        if (id.empty()) {
+            error_out = "Failed to create " + engine_type + " engine from checkpoint";
+            return false;
+        }
+        instance = getEngine(id);
+        created = true;
+    }
+
+    void* handle = instance->engine_handle;
+    std::string failure;
+    try {
+        switch (instance->type_tag) {
+            case EngineInstance::TypeTag::Phase4B: {
+                if (!dase_restore_engine) {
+                    failure = "DASE DLL lacks dase_restore_engine";
+                    break;
+                }
+                char error_msg[256] = {};
+                const int status = dase_restore_engine(handle, path.c_str(), error_msg, sizeof(error_msg));
+                if (status != 0) {
+                    failure = "dase_restore_engine failed (status " + std::to_string(status) + "): " + error_msg;
+                }
+                break;
+            }
+            case EngineInstance::TypeTag::IgsoaComplex:
+                readEngineCheckpoint<dase::igsoa::IGSOAComplexEngine>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex2D:
+                readEngineCheckpoint<dase::igsoa::IGSOAComplexEngine2D>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex3D:
+                readEngineCheckpoint<dase::igsoa::IGSOAComplexEngine3D>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::IgsoaGW:
+                readEngineCheckpoint<IGSOAGWEngine>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs1D:
+                readEngineCheckpoint<dase::satp_higgs::SATPHiggsEngine1D>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs2D:
+                readEngineCheckpoint<dase::satp_higgs::SATPHiggsEngine2D>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs3D:
+                readEngineCheckpoint<dase::satp_higgs::SATPHiggsEngine3D>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::FFTWCache:
+                readEngineCheckpoint<FFTWCacheExampleEngine>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::SidTernary:
+                if (!sid_restore_engine(static_cast<sid_engine*>(handle), path.c_str())) {
+                    failure = "sid_restore_engine rejected " + path;
+                }
+                break;
+            case EngineInstance::TypeTag::SidSSP:
+                readEngineCheckpoint<SidSSPEngine>(handle, *image);
+                break;
+            case EngineInstance::TypeTag::Unknown:
+            default:
+                failure = "Engine type cannot be restored: " + instance->engine_type;
+                break;
+        }
+    } catch (const std::exception& e) {
+        failure = e.what();
+    }
+    if (!failure.empty()) {
+        if (created) {
+            destroyEngine(instance->engine_id);
+        }
+        error_out = failure;
+        return false;
+    }
+
+    const std::string id = instance->engine_id;
+    if (config.contains("sid_wrapper")) {
+        const nlohmann::json& saved = config["sid_wrapper"];
+        SidWrapperState wrapper{};
+        wrapper.I_mass = saved.value("I_mass", 1.0 / 3.0);
+        wrapper.N_mass = saved.value("N_mass", 1.0 / 3.0);
+        wrapper.U_mass = saved.value("U_mass", 1.0 / 3.0);
+        wrapper.motion_applied_count = saved.value("motion_applied_count", uint64_t(0));
+        wrapper.event_cursor = saved.value("event_cursor", size_t(0));
+        wrapper.last_motion = saved.value("last_motion", nlohmann::json::object());
+        wrapper.initialized = saved.value("initialized", true);
+        sid_wrapper_state_[id] = wrapper;
+    }
+    if (config.contains("sid_rewrite_events")) {
+        dase::SidEventLog::Options options;
+        std::string ignored;
+        if (config.contains("sid_rewrite_log")) {
+            dase::SidEventLog::parseOptions(config["sid_rewrite_log"], options, ignored);
+        }
+        dase::SidEventLog log(options);
+        log.restore(config["sid_rewrite_events"]);
+        sid_rewrite_events_[id] = std::move(log);
+    }
+    publishState(id);   // Refresh a map_state export, if any
+
+    info_out = {
+        {"engine_id", id},
+        {"engine_type", engine_type},
+        {"num_nodes", instance->num_nodes},
+        {"path", path},
+        {"created", created}
+    };
+    return true;
+}
+
+// Header-only engines: one in-memory image of the source, restored into
+// every target
+template <typename Engine>
+static void cloneEngineState(const void* source, const std::vector<void*>& targets) {
+    dase::CheckpointWriter writer;
+    static_cast<const Engine*>(source)->saveCheckpoint(writer);
+    const auto buffer = writer.writeMemory();
+    const dase::CheckpointImage image(*buffer);
+    for (void* target : targets) {
+        static_cast<Engine*>(target)->restoreCheckpoint(image);
+    }
+}
+
+bool EngineManager::cloneEngine(const std::string& engine_id,
+                                int count,
+                                std::vector<std::string>& clone_ids_out,
+                                nlohmann::json& info_out,
+                                std::string& error_out) {
+    clone_ids_out.clear();
+    auto* source = getEngine(engine_id);
+    if (!source || !source->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (count <= 0) {
+        error_out = "count must be positive";
+        return false;
+    }
+
+    std::vector<void*> targets;
+    auto discard = [&]() {
+        for (const auto& id : clone_ids_out) {
+            destroyEngine(id);
+        }
+        clone_ids_out.clear();
+    };
+    for (int i = 0; i < count; ++i) {
+        const std::string id = createEngine(source->engine_type, source->num_nodes, source->R_c, source->kappa,
+                                            source->gamma, source->dt, source->alpha, source->dimension_x,
+                                            source->dimension_y, source->dimension_z, source->sid_role);
+        EngineInstance* clone = id.empty() ? nullptr : getEngine(id);
+        if (!clone) {
+            discard();
+            error_out = "Failed to create " + source->engine_type + " clone";
+            return false;
+        }
+        clone_ids_out.push_back(id);
+        targets.push_back(clone->engine_handle);
+    }
+
+    const void* handle = source->engine_handle;
+    std::string failure;
+    try {
+        switch (source->type_tag) {
+            case EngineInstance::TypeTag::Phase4B:
+                if (!dase_copy_engine_state) {
+                    failure = "DASE DLL lacks dase_copy_engine_state";
+                    break;
+                }
+                for (void* target : targets) {
+                    char error_msg[256] = {};
+                    const int status = dase_copy_engine_state(target, const_cast<void*>(handle),
+                                                              error_msg, sizeof(error_msg));
+                    if (status != 0) {
+                        failure = "dase_copy_engine_state failed (status " + std::to_string(status) + "): " +
+                                  error_msg;
+                        break;
+                    }
+                }
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex:
+                cloneEngineState<dase::igsoa::IGSOAComplexEngine>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex2D:
+                cloneEngineState<dase::igsoa::IGSOAComplexEngine2D>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex3D:
+                cloneEngineState<dase::igsoa::IGSOAComplexEngine3D>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::IgsoaGW:
+                cloneEngineState<IGSOAGWEngine>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs1D:
+                cloneEngineState<dase::satp_higgs::SATPHiggsEngine1D>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs2D:
+                cloneEngineState<dase::satp_higgs::SATPHiggsEngine2D>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs3D:
+                cloneEngineState<dase::satp_higgs::SATPHiggsEngine3D>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::FFTWCache:
+                cloneEngineState<FFTWCacheExampleEngine>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::SidTernary:
+                for (void* target : targets) {
+                    if (!sid_copy_engine_state(static_cast<sid_engine*>(target),
+                                               static_cast<sid_engine*>(const_cast<void*>(handle)))) {
+                        failure = "sid_copy_engine_state failed";
+                        break;
+                    }
+                }
+                break;
+            case EngineInstance::TypeTag::SidSSP:
+                cloneEngineState<SidSSPEngine>(handle, targets);
+                break;
+            case EngineInstance::TypeTag::Unknown:
+            default:
+                failure = "Engine type cannot be cloned: " + source->engine_type;
+                break;
+        }
+    } catch (const std::exception& e) {
+        failure = e.what();
+    }
+    if (!failure.empty()) {
+        discard();
+        error_out = failure;
+        return false;
+    }
+
+    // State the manager keeps beside the engine
+    auto wrapper_it = sid_wrapper_state_.find(engine_id);
+    auto events_it = sid_rewrite_events_.find(engine_id);
+    for (const auto& id : clone_ids_out) {
+        if (wrapper_it != sid_wrapper_state_.end()) {
+            sid_wrapper_state_[id] = wrapper_it->second;
+        }
+        if (events_it != sid_rewrite_events_.end()) {
+            sid_rewrite_events_[id] = events_it->second;
+        }
+        getEngine(id)->adaptive = source->adaptive;
+    }
+
+    info_out = {
+        {"engine_id", engine_id},
+        {"engine_type", source->engine_type},
+        {"num_nodes", source->num_nodes},
+        {"clones", clone_ids_out}
+    };
+    return true;
+}
+
+bool EngineManager::setIgsoaState(const std::string& engine_id,
+                                   const std::string& profile_type,
+                                   const nlohmann::json& params) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+
+    try {
+        if (instance->engine_type == "igsoa_complex") {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
+            const size_t num_nodes = engine->getNumNodes();
+
+            // Profiles are built in whole-field buffers and written with one
+            // bulk copy per field
+            std::vector<double> psi_real;
+            std::vector<double> psi_imag;
+            std::vector<double> phi;
+
+            if (profile_type == "gaussian") {
+            // Extract Gaussian profile parameters
+            const double amplitude = params.value("amplitude", 1.0);
+            const int default_center = static_cast<int>(num_nodes / 2);
+            const int center_node = params.value<int>("center_node", default_center);
+            const double width = params.value("width", static_cast<double>(num_nodes) / 16.0);
+            const double baseline_phi = params.value("baseline_phi", 0.0);
+
+            // Validate parameters
+            if (width <= 0.0 || !std::isfinite(width)) {
+                return false; // Invalid width
+            }
+            if (center_node < 0 || center_node >= static_cast<int>(num_nodes)) {
+                return false; // Center node out of bounds
+            }
+            if (!std::isfinite(amplitude) || !std::isfinite(baseline_phi)) {
+                return false; // Non-finite parameters
+            }
+
+            // Extract mode parameter (default: "overwrite" for backwards compatibility)
+            std::string mode = params.value("mode", "overwrite");
+
+            std::vector<double> gaussian(num_nodes);
+            for (size_t i = 0; i < num_nodes; i++) {
+                double distance = static_cast<double>(i) - static_cast<double>(center_node);
+                gaussian[i] = amplitude * std::exp(-(distance * distance) / (2.0 * width * width));
+            }
+
+            // Apply Gaussian profile based on mode
+            if (mode == "overwrite") {
+                // MODE: OVERWRITE - Replace entire field with baseline + gaussian
+                // Ψ = Gaussian magnitude with zero phase, Φ = baseline
+                psi_real = std::move(gaussian);
+                psi_imag.assign(num_nodes, 0.0);
+                phi.assign(num_nodes, baseline_phi);
+
+            } else if (mode == "add" || mode == "blend") {
+                if (!getAllNodeStates(engine_id, psi_real, psi_imag, phi)) {
+                    return false;
+                }
+
+                if (mode == "add") {
+                    // MODE: ADD - Add gaussian on top of existing field values (φ = φ + G)
+                    for (size_t i = 0; i < num_nodes; i++) {
+                        psi_real[i] += gaussian[i];
+                        phi[i] += gaussian[i];
+                    }
+                } else {
+                    // MODE: BLEND - Blend toward gaussian target: φ = (1-beta)φ + beta(baseline + G)
+                    double beta = params.value("beta", 0.1);  // Default blend factor 0.1
+
+                    for (size_t i = 0; i < num_nodes; i++) {
+                        psi_real[i] = (1.0 - beta) * psi_real[i] + beta * gaussian[i];
+                        psi_imag[i] = (1.0 - beta) * psi_imag[i];
+                        phi[i] = (1.0 - beta) * phi[i] + beta * (baseline_phi + gaussian[i]);
+                    }
+                }
+
+            } else {
+                // Unknown mode - fail
+                return false;
+            }
+
+        } else if (profile_type == "uniform") {
+            // Apply uniform state to all nodes
+            psi_real.assign(num_nodes, params.value("psi_real", 0.1));
+            psi_imag.assign(num_nodes, params.value("psi_imag", 0.0));
+            phi.assign(num_nodes, params.value("phi", 0.0));
+
+        } else if (profile_type == "localized") {
+            // Extract localized profile parameters
+            int node_index = params.value("node_index", 0);
+
+            // Zero out all nodes, then set the single node
+            psi_real.assign(num_nodes, 0.0);
+            psi_imag.assign(num_nodes, 0.0);
+            phi.assign(num_nodes, 0.0);
+            if (node_index >= 0 && node_index < static_cast<int>(num_nodes)) {
+                psi_real[static_cast<size_t>(node_index)] = params.value("psi_real", 1.0);
+                psi_imag[static_cast<size_t>(node_index)] = params.value("psi_imag", 0.0);
+                phi[static_cast<size_t>(node_index)] = params.value("phi", 0.0);
+            }
+
+        } else {
+            // Unsupported profile type
+            return false;
+        }
+
+            auto& nodes = engine->getNodesMutable();
+            const auto all = dase::igsoa::IGSOABulkAccess::whole(nodes.size());
+            return dase::igsoa::IGSOABulkAccess::scatterPsi(nodes, nodes.size(), 1, 1, all,
+                                                             psi_real.data(), psi_imag.data()) &&
+                   dase::igsoa::IGSOABulkAccess::scatter(nodes, nodes.size(), 1, 1, all,
+                                                          dase::igsoa::IGSOANodeField::Phi, phi.data());
+
+        } else if (instance->engine_type == "igsoa_complex_2d") {
+            auto* engine2d = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+            size_t N_x = instance->dimension_x > 0 ? static_cast<size_t>(instance->dimension_x) : engine2d->getNx();
+            size_t N_y = instance->dimension_y > 0 ? static_cast<size_t>(instance->dimension_y) : engine2d->getNy();
+
+            if (profile_type == "gaussian" || profile_type == "gaussian_2d") {
+                dase::igsoa::Gaussian2DParams gparams;
+                gparams.amplitude = params.value("amplitude", 1.0);
+                gparams.center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
+                gparams.center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
+                double default_sigma_x = (std::max)(1.0, static_cast<double>(N_x) / 16.0);
+                double default_sigma_y = (std::max)(1.0, static_cast<double>(N_y) / 16.0);
+                gparams.sigma_x = params.value("sigma_x", default_sigma_x);
+                gparams.sigma_y = params.value("sigma_y", default_sigma_y);
+                gparams.baseline_phi = params.value("baseline_phi", 0.0);
+                gparams.mode = params.value("mode", std::string("overwrite"));
+                gparams.beta = params.value("beta", 1.0);
+
+                dase::igsoa::IGSOAStateInit2D::initGaussian2D(*engine2d, gparams);
+                return true;
+
+            } else if (profile_type == "circular_gaussian" || profile_type == "circular_gaussian_2d") {
+                double amplitude = params.value("amplitude", 1.0);
+                double center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
+                double center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
+                double min_dim = (std::min)(static_cast<double>(N_x), static_cast<double>(N_y));
+                double default_sigma = (std::max)(1.0, min_dim / 16.0);
+                double sigma = params.value("sigma", default_sigma);
+                double baseline_phi = params.value("baseline_phi", 0.0);
+                std::string mode = params.value("mode", std::string("overwrite"));
+                double beta = params.value("beta", 1.0);
+
+                dase::igsoa::IGSOAStateInit2D::initCircularGaussian(
+                    *engine2d,
+                    amplitude,
+                    center_x,
+                    center_y,
+                    sigma,
+                    baseline_phi,
+                    mode,
+                    beta
+                );
+
+                return true;
+
+            } else if (profile_type == "plane_wave_2d" || profile_type == "plane_wave") {
+                dase::igsoa::PlaneWave2DParams wave_params;
+                wave_params.amplitude = params.value("amplitude", 1.0);
+                const double kx_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_x));
+                const double ky_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_y));
+                wave_params.k_x = params.value("k_x", kx_default);
+                wave_params.k_y = params.value("k_y", ky_default);
+                wave_params.phase_offset = params.value("phase_offset", 0.0);
+
+                dase::igsoa::IGSOAStateInit2D::initPlaneWave2D(*engine2d, wave_params);
+                return true;
+
+            } else if (profile_type == "uniform") {
+                double psi_real = params.value("psi_real", 0.1);
+                double psi_imag = params.value("psi_imag", 0.0);
+                double phi = params.value("phi", 0.0);
+
+                dase::igsoa::IGSOAStateInit2D::initUniform(*engine2d, psi_real, psi_imag, phi);
+                return true;
+
+            } else if (profile_type == "random" || profile_type == "random_2d") {
+                double amplitude = params.value("amplitude", 1.0);
+                unsigned int seed = params.value("seed", 0u);
+
+                dase::igsoa::IGSOAStateInit2D::initRandom(*engine2d, amplitude, seed);
+                return true;
+
+            } else if (profile_type == "reset") {
+                engine2d->reset();
+                return true;
+
+            } else {
+                return false;
+            }
+
+        } else if (instance->engine_type == "igsoa_complex_3d") {
+            auto* engine3d = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+            size_t N_x = instance->dimension_x > 0 ? static_cast<size_t>(instance->dimension_x) : engine3d->getNx();
+            size_t N_y = instance->dimension_y > 0 ? static_cast<size_t>(instance->dimension_y) : engine3d->getNy();
+            size_t N_z = instance->dimension_z > 0 ? static_cast<size_t>(instance->dimension_z) : engine3d->getNz();
+
+            if (profile_type == "gaussian" || profile_type == "gaussian_3d") {
+                dase::igsoa::Gaussian3DParams params3d;
+                params3d.amplitude = params.value("amplitude", 1.0);
+                params3d.center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
+                params3d.center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
+                params3d.center_z = params.value("center_z", static_cast<double>(N_z) / 2.0);
+                double default_sigma_x = (std::max)(1.0, static_cast<double>(N_x) / 16.0);
+                double default_sigma_y = (std::max)(1.0, static_cast<double>(N_y) / 16.0);
+                double default_sigma_z = (std::max)(1.0, static_cast<double>(N_z) / 16.0);
+                params3d.sigma_x = params.value("sigma_x", default_sigma_x);
+                params3d.sigma_y = params.value("sigma_y", default_sigma_y);
+                params3d.sigma_z = params.value("sigma_z", default_sigma_z);
+                params3d.baseline_phi = params.value("baseline_phi", 0.0);
+                params3d.mode = params.value("mode", std::string("overwrite"));
+                params3d.beta = params.value("beta", 1.0);
+
+                dase::igsoa::IGSOAStateInit3D::initGaussian3D(*engine3d, params3d);
+                return true;
+
+            } else if (profile_type == "spherical_gaussian" || profile_type == "gaussian_spherical") {
+                double amplitude = params.value("amplitude", 1.0);
+                double center_x = params.value("center_x", static_cast<double>(N_x) / 2.0);
+                double center_y = params.value("center_y", static_cast<double>(N_y) / 2.0);
+                double center_z = params.value("center_z", static_cast<double>(N_z) / 2.0);
+                size_t min_dim = (std::min)((std::min)(N_x, N_y), N_z);
+                double default_sigma = (std::max)(1.0, static_cast<double>(min_dim) / 16.0);
                 double sigma = params.value("sigma", default_sigma);
                 double baseline_phi = params.value("baseline_phi", 0.0);
                 std::string mode = params.value("mode", std::string("overwrite"));
                 double beta = params.value("beta", 1.0);
 
-                dase::igsoa::IGSOAStateInit3D::initSphericalGaussian(
-                    *engine3d,
-                    amplitude,
-                    center_x,
-                    center_y,
-                    center_z,
-                    sigma,
-                    baseline_phi,
-                    mode,
-                    beta
-                );
+                dase::igsoa::IGSOAStateInit3D::initSphericalGaussian(
+                    *engine3d,
+                    amplitude,
+                    center_x,
+                    center_y,
+                    center_z,
+                    sigma,
+                    baseline_phi,
+                    mode,
+                    beta
+                );
+                return true;
+
+            } else if (profile_type == "plane_wave_3d" || profile_type == "plane_wave") {
+                dase::igsoa::PlaneWave3DParams wave_params;
+                wave_params.amplitude = params.value("amplitude", 1.0);
+                const double kx_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_x));
+                const double ky_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_y));
+                const double kz_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_z));
+                wave_params.k_x = params.value("k_x", kx_default);
+                wave_params.k_y = params.value("k_y", ky_default);
+                wave_params.k_z = params.value("k_z", kz_default);
+                wave_params.phase_offset = params.value("phase_offset", 0.0);
+
+                dase::igsoa::IGSOAStateInit3D::initPlaneWave3D(*engine3d, wave_params);
+                return true;
+
+            } else if (profile_type == "uniform") {
+                double psi_real = params.value("psi_real", 0.1);
+                double psi_imag = params.value("psi_imag", 0.0);
+                double phi = params.value("phi", 0.0);
+
+                dase::igsoa::IGSOAStateInit3D::initUniform(*engine3d, psi_real, psi_imag, phi);
+                return true;
+
+            } else if (profile_type == "random" || profile_type == "random_3d") {
+                double amplitude = params.value("amplitude", 1.0);
+                unsigned int seed = params.value("seed", 0u);
+
+                dase::igsoa::IGSOAStateInit3D::initRandom(*engine3d, amplitude, seed);
+                return true;
+
+            } else if (profile_type == "reset") {
+                engine3d->reset();
+                return true;
+
+            } else {
+                return false;
+            }
+
+        } else {
+            return false;
+        }
+
+    } catch (...) {
+        return false;
+    }
+}
+
+template <typename Node>
+static bool checkStateArrays(const std::vector<Node>& nodes,
+                             const std::vector<std::string>& known,
+                             const std::vector<std::string>& fields,
+                             const std::vector<dase::TypedArray>& values,
+                             std::string& error) {
+    for (size_t k = 0; k < fields.size(); k++) {
+        if (std::find(known.begin(), known.end(), fields[k]) == known.end()) {
+            error = "Field " + fields[k] + " does not belong to this engine";
+            return false;
+        }
+        if (values[k].size() != nodes.size()) {
+            error = "Field " + fields[k] + " has " + std::to_string(values[k].size()) +
+                    " values, engine has " + std::to_string(nodes.size()) + " nodes";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EngineManager::setStateArrays(const std::string& engine_id,
+                                   const std::vector<std::string>& fields,
+                                   const std::vector<dase::TypedArray>& values,
+                                   std::string& error) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error = "Engine not found: " + engine_id;
+        return false;
+    }
+
+    const auto igsoa = [&](std::vector<dase::igsoa::IGSOAComplexNode>& nodes) {
+        if (!checkStateArrays(nodes, dase::SnapshotSelection::igsoaFields(), fields, values, error)) {
+            return false;
+        }
+        bool psi_written = false;
+        for (size_t k = 0; k < fields.size(); k++) {
+            if (fields[k] == "psi_real") {
+                values[k].forEach([&](size_t i, double v) { nodes[i].psi.real(v); });
+                psi_written = true;
+            } else if (fields[k] == "psi_imag") {
+                values[k].forEach([&](size_t i, double v) { nodes[i].psi.imag(v); });
+                psi_written = true;
+            } else {
+                values[k].forEach([&](size_t i, double v) { nodes[i].phi = v; });
+            }
+        }
+        // F and the phase follow Ψ, as in IGSOABulkAccess::scatter
+        if (psi_written) {
+            for (auto& node : nodes) {
+                node.updateInformationalDensity();
+                node.updatePhase();
+            }
+        }
+        return true;
+    };
+    const auto satp = [&](std::vector<dase::satp_higgs::SATPHiggsNode>& nodes) {
+        if (!checkStateArrays(nodes, dase::SnapshotSelection::satpFields(), fields, values, error)) {
+            return false;
+        }
+        for (size_t k = 0; k < fields.size(); k++) {
+            double dase::satp_higgs::SATPHiggsNode::* member =
+                fields[k] == "phi" ? &dase::satp_higgs::SATPHiggsNode::phi
+                : fields[k] == "phi_dot" ? &dase::satp_higgs::SATPHiggsNode::phi_dot
+                : fields[k] == "h" ? &dase::satp_higgs::SATPHiggsNode::h
+                : &dase::satp_higgs::SATPHiggsNode::h_dot;
+            values[k].forEach([&](size_t i, double v) { nodes[i].*member = v; });
+        }
+        for (auto& node : nodes) {
+            node.updateDerived();
+        }
+        return true;
+    };
+
+    if (instance->engine_type == "igsoa_complex") {
+        return igsoa(static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle)->getNodesMutable());
+    } else if (instance->engine_type == "igsoa_complex_2d") {
+        return igsoa(static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->getNodesMutable());
+    } else if (instance->engine_type == "igsoa_complex_3d") {
+        return igsoa(static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->getNodesMutable());
+    } else if (instance->engine_type == "satp_higgs_1d") {
+        return satp(static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle)->getNodesMutable());
+    } else if (instance->engine_type == "satp_higgs_2d") {
+        return satp(static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle)->getNodesMutable());
+    } else if (instance->engine_type == "satp_higgs_3d") {
+        return satp(static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->getNodesMutable());
+    }
+    error = "Array state needs an IGSOA or SATP+Higgs engine (got " + instance->engine_type + ")";
+    return false;
+}
+
+bool EngineManager::setSatpState(const std::string& engine_id,
+                                  const std::string& profile_type,
+                                  const nlohmann::json& params) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+
+    try {
+        if (instance->engine_type == "satp_higgs_1d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
+
+            if (profile_type == "vacuum") {
+                // Initialize to Higgs vacuum (VEV)
+                dase::satp_higgs::SATPHiggsStateInit1D::initVacuum(*engine);
+                return true;
+
+            } else if (profile_type == "phi_gaussian") {
+                // Gaussian profile for φ field
+                dase::satp_higgs::GaussianProfileParams gparams;
+                gparams.amplitude = params.value("amplitude", 1.0);
+                gparams.center = params.value("center", static_cast<double>(engine->getN()) * engine->getDx() / 2.0);
+                gparams.sigma = params.value("sigma", static_cast<double>(engine->getN()) * engine->getDx() / 16.0);
+                gparams.set_velocity = params.value("set_velocity", false);
+                gparams.velocity_amplitude = params.value("velocity_amplitude", 0.0);
+                gparams.mode = params.value("mode", "overwrite");
+                gparams.beta = params.value("beta", 1.0);
+
+                dase::satp_higgs::SATPHiggsStateInit1D::initPhiGaussian(*engine, gparams);
+                return true;
+
+            } else if (profile_type == "higgs_gaussian") {
+                // Gaussian perturbation for h field around VEV
+                dase::satp_higgs::GaussianProfileParams gparams;
+                gparams.amplitude = params.value("amplitude", 0.1);
+                gparams.center = params.value("center", static_cast<double>(engine->getN()) * engine->getDx() / 2.0);
+                gparams.sigma = params.value("sigma", static_cast<double>(engine->getN()) * engine->getDx() / 16.0);
+                gparams.set_velocity = params.value("set_velocity", false);
+                gparams.velocity_amplitude = params.value("velocity_amplitude", 0.0);
+                gparams.mode = params.value("mode", "overwrite");
+                gparams.beta = params.value("beta", 1.0);
+
+                dase::satp_higgs::SATPHiggsStateInit1D::initHiggsGaussian(*engine, gparams);
+                return true;
+
+            } else if (profile_type == "three_zone_source") {
+                // Set up three-zone source function
+                dase::satp_higgs::ThreeZoneSourceParams sparams;
+                sparams.zone1_start = params.value("zone1_start", 0.0);
+                sparams.zone1_end = params.value("zone1_end", 0.0);
+                sparams.zone2_start = params.value("zone2_start", 0.0);
+                sparams.zone2_end = params.value("zone2_end", 0.0);
+                sparams.zone3_start = params.value("zone3_start", 0.0);
+                sparams.zone3_end = params.value("zone3_end", 0.0);
+                sparams.amplitude1 = params.value("amplitude1", 0.0);
+                sparams.amplitude2 = params.value("amplitude2", 0.0);
+                sparams.amplitude3 = params.value("amplitude3", 0.0);
+                sparams.frequency = params.value("frequency", 0.0);
+                sparams.t_start = params.value("t_start", 0.0);
+                sparams.t_end = params.value("t_end", -1.0);
+
+                auto source_func = dase::satp_higgs::SATPHiggsStateInit1D::createThreeZoneSource(
+                    sparams, engine->getDx());
+                engine->setSource(source_func);
+                return true;
+
+            } else if (profile_type == "uniform") {
+                // Uniform initialization
+                double phi_val = params.value("phi", 0.0);
+                double phi_dot_val = params.value("phi_dot", 0.0);
+                double h_val = params.value("h", engine->getParams().h_vev);
+                double h_dot_val = params.value("h_dot", 0.0);
+
+                dase::satp_higgs::SATPHiggsStateInit1D::initUniform(*engine,
+                    phi_val, phi_dot_val, h_val, h_dot_val);
+                return true;
+
+            } else if (profile_type == "random_perturbation") {
+                // Add random perturbations
+                double phi_amplitude = params.value("phi_amplitude", 0.01);
+                double h_amplitude = params.value("h_amplitude", 0.01);
+                unsigned int seed = params.value("seed", 0);
+
+                dase::satp_higgs::SATPHiggsStateInit1D::addRandomPerturbation(*engine,
+                    phi_amplitude, h_amplitude, seed);
+                return true;
+
+            } else {
+                return false;  // Unknown profile type
+            }
+
+        } else if (instance->engine_type == "satp_higgs_2d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
+
+            if (profile_type == "vacuum") {
+                // Initialize to Higgs vacuum (VEV)
+                dase::satp_higgs::SATPHiggsStateInit2D::initVacuum(*engine);
+                return true;
+
+            } else if (profile_type == "phi_circular_gaussian") {
+                // Circular Gaussian profile for φ field
+                double amplitude = params.value("amplitude", 1.0);
+                double center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
+                double center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
+                double sigma = params.value("sigma", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
+                std::string mode = params.value("mode", "overwrite");
+
+                dase::satp_higgs::SATPHiggsStateInit2D::initPhiCircularGaussian(
+                    *engine, amplitude, center_x, center_y, sigma, mode);
+                return true;
+
+            } else if (profile_type == "phi_gaussian") {
+                // Elliptical Gaussian profile for φ field
+                dase::satp_higgs::GaussianProfile2DParams gparams;
+                gparams.amplitude = params.value("amplitude", 1.0);
+                gparams.center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
+                gparams.center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
+                gparams.sigma_x = params.value("sigma_x", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
+                gparams.sigma_y = params.value("sigma_y", static_cast<double>(engine->getNy()) * engine->getDx() / 16.0);
+                gparams.set_velocity = params.value("set_velocity", false);
+                gparams.velocity_amplitude = params.value("velocity_amplitude", 0.0);
+                gparams.mode = params.value("mode", "overwrite");
+                gparams.beta = params.value("beta", 1.0);
+
+                dase::satp_higgs::SATPHiggsStateInit2D::initPhiGaussian(*engine, gparams);
+                return true;
+
+            } else if (profile_type == "higgs_circular_gaussian") {
+                // Circular Gaussian perturbation for h field around VEV
+                double amplitude = params.value("amplitude", 0.1);
+                double center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
+                double center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
+                double sigma = params.value("sigma", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
+                std::string mode = params.value("mode", "overwrite");
+
+                dase::satp_higgs::SATPHiggsStateInit2D::initHiggsCircularGaussian(
+                    *engine, amplitude, center_x, center_y, sigma, mode);
+                return true;
+
+            } else if (profile_type == "uniform") {
+                // Uniform initialization
+                double phi_val = params.value("phi", 0.0);
+                double phi_dot_val = params.value("phi_dot", 0.0);
+                double h_val = params.value("h", engine->getParams().h_vev);
+                double h_dot_val = params.value("h_dot", 0.0);
+
+                dase::satp_higgs::SATPHiggsStateInit2D::initUniform(*engine,
+                    phi_val, phi_dot_val, h_val, h_dot_val);
+                return true;
+
+            } else if (profile_type == "random_perturbation") {
+                // Add random perturbations
+                double phi_amplitude = params.value("phi_amplitude", 0.01);
+                double h_amplitude = params.value("h_amplitude", 0.01);
+                unsigned int seed = params.value("seed", 0);
+
+                dase::satp_higgs::SATPHiggsStateInit2D::addRandomPerturbation(*engine,
+                    phi_amplitude, h_amplitude, seed);
+                return true;
+
+            } else {
+                return false;  // Unknown profile type
+            }
+
+        } else if (instance->engine_type == "satp_higgs_3d") {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
+
+            if (profile_type == "vacuum") {
+                // Initialize to Higgs vacuum (VEV)
+                dase::satp_higgs::SATPHiggsStateInit3D::initVacuum(*engine);
+                return true;
+
+            } else if (profile_type == "phi_spherical_gaussian") {
+                // Spherical Gaussian profile for φ field
+                double amplitude = params.value("amplitude", 1.0);
+                double center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
+                double center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
+                double center_z = params.value("center_z", static_cast<double>(engine->getNz()) * engine->getDx() / 2.0);
+                double sigma = params.value("sigma", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
+                std::string mode = params.value("mode", "overwrite");
+
+                dase::satp_higgs::SATPHiggsStateInit3D::initPhiSphericalGaussian(
+                    *engine, amplitude, center_x, center_y, center_z, sigma, mode);
                 return true;
 
-            } else if (profile_type == "plane_wave_3d" || profile_type == "plane_wave") {
-                dase::igsoa::PlaneWave3DParams wave_params;
-                wave_params.amplitude = params.value("amplitude", 1.0);
-                const double kx_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_x));
-                const double ky_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_y));
-                const double kz_default = 2.0 * M_PI / std::max<double>(1.0, static_cast<double>(N_z));
-                wave_params.k_x = params.value("k_x", kx_default);
-                wave_params.k_y = params.value("k_y", ky_default);
-                wave_params.k_z = params.value("k_z", kz_default);
-                wave_params.phase_offset = params.value("phase_offset", 0.0);
+            } else if (profile_type == "phi_gaussian") {
+                // Ellipsoidal Gaussian profile for φ field
+                dase::satp_higgs::GaussianProfile3DParams gparams;
+                gparams.amplitude = params.value("amplitude", 1.0);
+                gparams.center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
+                gparams.center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
+                gparams.center_z = params.value("center_z", static_cast<double>(engine->getNz()) * engine->getDx() / 2.0);
+                gparams.sigma_x = params.value("sigma_x", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
+                gparams.sigma_y = params.value("sigma_y", static_cast<double>(engine->getNy()) * engine->getDx() / 16.0);
+                gparams.sigma_z = params.value("sigma_z", static_cast<double>(engine->getNz()) * engine->getDx() / 16.0);
+                gparams.set_velocity = params.value("set_velocity", false);
+                gparams.velocity_amplitude = params.value("velocity_amplitude", 0.0);
+                gparams.mode = params.value("mode", "overwrite");
+                gparams.beta = params.value("beta", 1.0);
 
-                dase::igsoa::IGSOAStateInit3D::initPlaneWave3D(*engine3d, wave_params);
+                dase::satp_higgs::SATPHiggsStateInit3D::initPhiGaussian(*engine, gparams);
                 return true;
 
-            } else if (profile_type == "uniform") {
-                double psi_real = params.value("psi_real", 0.1);
-                double psi_imag = params.value("psi_imag", 0.0);
-                double phi = params.value("phi", 0.0);
+            } else if (profile_type == "higgs_spherical_gaussian") {
+                // Spherical Gaussian perturbation for h field around VEV
+                double amplitude = params.value("amplitude", 0.1);
+                double center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
+                double center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
+                double center_z = params.value("center_z", static_cast<double>(engine->getNz()) * engine->getDx() / 2.0);
+                double sigma = params.value("sigma", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
+                std::string mode = params.value("mode", "overwrite");
 
-                dase::igsoa::IGSOAStateInit3D::initUniform(*engine3d, psi_real, psi_imag, phi);
+                dase::satp_higgs::SATPHiggsStateInit3D::initHiggsSphericalGaussian(
+                    *engine, amplitude, center_x, center_y, center_z, sigma, mode);
                 return true;
 
-            } else if (profile_type == "random" || profile_type == "random_3d") {
-                double amplitude = params.value("amplitude", 1.0);
-                unsigned int seed = params.value("seed", 0u);
+            } else if (profile_type == "uniform") {
+                // Uniform initialization
+                double phi_val = params.value("phi", 0.0);
+                double phi_dot_val = params.value("phi_dot", 0.0);
+                double h_val = params.value("h", engine->getParams().h_vev);
+                double h_dot_val = params.value("h_dot", 0.0);
 
-                dase::igsoa::IGSOAStateInit3D::initRandom(*engine3d, amplitude, seed);
+                dase::satp_higgs::SATPHiggsStateInit3D::initUniform(*engine,
+                    phi_val, phi_dot_val, h_val, h_dot_val);
                 return true;
 
-            } else if (profile_type == "reset") {
-                engine3d->reset();
+            } else if (profile_type == "random_perturbation") {
+                // Add random perturbations
+                double phi_amplitude = params.value("phi_amplitude", 0.01);
+                double h_amplitude = params.value("h_amplitude", 0.01);
+                unsigned int seed = params.value("seed", 0);
+
+                dase::satp_higgs::SATPHiggsStateInit3D::addRandomPerturbation(*engine,
+                    phi_amplitude, h_amplitude, seed);
                 return true;
 
             } else {
+                return false;  // Unknown profile type
+            }
+
+        } else {
+            return false;  // Wrong engine type
+        }
+
+    } catch (...) {
+        return false;
+    }
+}
+
+bool EngineManager::computeCenterOfMass2D(const std::string& engine_id,
+                                          double& x_cm_out,
+                                          double& y_cm_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+
+    if (instance->engine_type != "igsoa_complex_2d") {
+        return false;
+    }
+
+    auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+    dase::igsoa::IGSOAStateInit2D::computeCenterOfMass(*engine, x_cm_out, y_cm_out);
+    return true;
+}
+
+bool EngineManager::computeCenterOfMass3D(const std::string& engine_id,
+                                          double& x_cm_out,
+                                          double& y_cm_out,
+                                          double& z_cm_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+
+    if (instance->engine_type != "igsoa_complex_3d") {
+        return false;
+    }
+
+    auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+    dase::igsoa::IGSOAStateInit3D::computeCenterOfMass(*engine, x_cm_out, y_cm_out, z_cm_out);
+    return true;
+}
+
+bool EngineManager::enableHardwareCounters(const std::string& engine_id, bool enable) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle ||
+        instance->type_tag != EngineInstance::TypeTag::Phase4B || !dase_enable_hardware_counters) {
+        return false;
+    }
+    return dase_enable_hardware_counters(instance->engine_handle, enable ? 1 : 0) == 0 && enable;
+}
+
+bool EngineManager::enableEnergyMeter(const std::string& engine_id, bool enable) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    instance->last_energy = EnergySample();
+    instance->last_energy_steps = 0;
+    if (!enable) {
+        instance->energy_meter.reset();
+        return false;
+    }
+    auto meter = std::make_shared<EnergyMeter>();
+    if (!meter->open()) {
+        instance->energy_meter.reset();
+        return false;
+    }
+    instance->energy_meter = std::move(meter);
+    return true;
+}
+
+bool EngineManager::setComputeDevice(const std::string& engine_id, ComputeDevice device) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    if (instance->type_tag == EngineInstance::TypeTag::IgsoaComplex3D) {
+        return static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->setDevice(device);
+    }
+    if (instance->type_tag == EngineInstance::TypeTag::SatpHiggs3D) {
+        return static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->setDevice(device);
+    }
+    return device == ComputeDevice::CPU;
+}
+
+bool EngineManager::setSparseEvolution(const std::string& engine_id, double threshold, uint32_t block) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle || !(threshold >= 0.0) || block == 0) {
+        return false;
+    }
+    if (instance->type_tag == EngineInstance::TypeTag::IgsoaComplex2D) {
+        static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->setSparseEvolution(threshold, block);
+        return true;
+    }
+    if (instance->type_tag == EngineInstance::TypeTag::IgsoaComplex3D) {
+        static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->setSparseEvolution(threshold, block);
+        return true;
+    }
+    return false;
+}
+
+bool EngineManager::setKernelPolicy(const std::string& engine_id, dase::igsoa::IGSOAKernelPolicy policy) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    switch (instance->type_tag) {
+        case EngineInstance::TypeTag::IgsoaComplex:
+            static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle)->setKernelPolicy(policy);
+            return true;
+        case EngineInstance::TypeTag::IgsoaComplex2D:
+            static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->setKernelPolicy(policy);
+            return true;
+        case EngineInstance::TypeTag::IgsoaComplex3D:
+            static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->setKernelPolicy(policy);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool EngineManager::runBurnIn(const std::string& engine_id, const dase::igsoa::IGSOABurnInOptions& options,
+                              int first_step, std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (instance->type_tag != EngineInstance::TypeTag::IgsoaComplex2D &&
+        instance->type_tag != EngineInstance::TypeTag::IgsoaComplex3D) {
+        error_out = "burn_in needs an igsoa_complex_2d or igsoa_complex_3d engine";
+        return false;
+    }
+
+    try {
+        const dase::ThreadBudget::Lease threads =
+            dase::ThreadBudget::process().acquire(instance->thread_limit, &instance->thread_cpus);
+
+        // run_mission's drive over the burn-in steps
+        size_t dims[3];
+        const dase::ObservableRecorder* observables = observableRecorder(instance, dims);
+        const double gain = observables ? observables->driveGain() : 1.0;
+        std::vector<double> input_signals(options.steps);
+        std::vector<double> control_patterns(options.steps);
+        for (size_t i = 0; i < input_signals.size(); i++) {
+            input_signals[i] = gain * std::sin((first_step + static_cast<double>(i)) * 0.01);
+            control_patterns[i] = gain * std::cos((first_step + static_cast<double>(i)) * 0.01);
+        }
+
+        if (instance->type_tag == EngineInstance::TypeTag::IgsoaComplex2D) {
+            static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->runBurnIn(
+                options, input_signals.data(), control_patterns.data());
+        } else {
+            static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->runBurnIn(
+                options, input_signals.data(), control_patterns.data());
+        }
+        return true;
+    } catch (const std::exception& e) {
+        error_out = e.what();
+        return false;
+    }
+}
+
+bool EngineManager::setPendingBurnIn(const std::string& engine_id, const dase::igsoa::IGSOABurnInOptions& options,
+                                     std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (instance->type_tag != EngineInstance::TypeTag::IgsoaComplex2D &&
+        instance->type_tag != EngineInstance::TypeTag::IgsoaComplex3D) {
+        error_out = "burn_in needs an igsoa_complex_2d or igsoa_complex_3d engine";
+        return false;
+    }
+    dase::igsoa::IGSOAComplexConfig config;
+    config.R_c_default = instance->R_c;
+    const size_t N_z = instance->type_tag == EngineInstance::TypeTag::IgsoaComplex3D
+                           ? static_cast<size_t>(instance->dimension_z) : 1;
+    if (!options.validate(config, static_cast<size_t>(instance->dimension_x),
+                          static_cast<size_t>(instance->dimension_y), N_z, &error_out)) {
+        return false;
+    }
+    instance->burn_in = options;
+    return true;
+}
+
+bool EngineManager::takePendingBurnIn(const std::string& engine_id, dase::igsoa::IGSOABurnInOptions& options_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || instance->burn_in.steps == 0) {
+        return false;
+    }
+    options_out = instance->burn_in;
+    instance->burn_in = dase::igsoa::IGSOABurnInOptions();
+    return true;
+}
+
+bool EngineManager::setGWRefinement(const std::string& engine_id, int levels, int ratio, int margin,
+                                    int regrid_margin, nlohmann::json& info_out, std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle || instance->type_tag != EngineInstance::TypeTag::IgsoaGW) {
+        error_out = "Mesh refinement needs an igsoa_gw engine";
+        return false;
+    }
+    auto* engine = static_cast<IGSOAGWEngine*>(instance->engine_handle);
+    dase::igsoa::gw::MeshRefinementConfig config;
+    config.levels = levels;
+    config.ratio = ratio;
+    config.margin = margin;
+    config.regrid_margin = regrid_margin;
+    try {
+        engine->setRefinement(config);
+    } catch (const std::exception& e) {
+        engine->refinement.reset();
+        error_out = e.what();
+        return false;
+    }
+
+    nlohmann::json level_info = nlohmann::json::array();
+    uint64_t patch_points = 0;
+    if (engine->refinement) {
+        for (int level = 1; level <= engine->refinement->getNumLevels(); ++level) {
+            const auto& box = engine->refinement->getLevelBox(level);
+            const auto& patch = engine->refinement->getLevelField(level);
+            patch_points += static_cast<uint64_t>(patch.getTotalPoints());
+            level_info.push_back({
+                {"level", level},
+                {"box_lo", {box.lo[0], box.lo[1], box.lo[2]}},
+                {"box_hi", {box.hi[0], box.hi[1], box.hi[2]}},
+                {"dims", {patch.getNx(), patch.getNy(), patch.getNz()}},
+                {"dx", patch.getDx()},
+                {"dt", patch.getTimestep()},
+                {"points", patch.getTotalPoints()}
+            });
+        }
+    }
+    info_out = {
+        {"levels", levels},
+        {"ratio", ratio},
+        {"margin", margin},
+        {"regrid_margin", regrid_margin},
+        {"patches", level_info},
+        {"patch_points", patch_points},
+        {"base_points", engine->field.getTotalPoints()}
+    };
+    return true;
+}
+
+// Recorder of an engine with probes (nullptr otherwise)
+static dase::ProbeRecorder* probeRecorder(EngineInstance* instance) {
+    if (!instance || !instance->engine_handle) {
+        return nullptr;
+    }
+    switch (instance->type_tag) {
+        case EngineInstance::TypeTag::IgsoaComplex:
+            return &static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle)->probes();
+        case EngineInstance::TypeTag::IgsoaComplex2D:
+            return &static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle)->probes();
+        case EngineInstance::TypeTag::IgsoaComplex3D:
+            return &static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->probes();
+        case EngineInstance::TypeTag::IgsoaGW:
+            return &static_cast<IGSOAGWEngine*>(instance->engine_handle)->probes;
+        default:
+            return nullptr;
+    }
+}
+
+// Observable recorder of an IGSOA lattice engine and its N_x, N_y, N_z
+static dase::ObservableRecorder* observableRecorder(EngineInstance* instance, size_t dims[3]) {
+    if (!instance || !instance->engine_handle) {
+        return nullptr;
+    }
+    switch (instance->type_tag) {
+        case EngineInstance::TypeTag::IgsoaComplex: {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
+            dims[0] = engine->getNodes().size();
+            dims[1] = 1;
+            dims[2] = 1;
+            return &engine->observables();
+        }
+        case EngineInstance::TypeTag::IgsoaComplex2D: {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
+            dims[0] = engine->getNx();
+            dims[1] = engine->getNy();
+            dims[2] = 1;
+            return &engine->observables();
+        }
+        case EngineInstance::TypeTag::IgsoaComplex3D: {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
+            dims[0] = engine->getNx();
+            dims[1] = engine->getNy();
+            dims[2] = engine->getNz();
+            return &engine->observables();
+        }
+        default:
+            return nullptr;
+    }
+}
+
+// SATP engines: new couplings and dt, fields back at the VEV
+template <typename Engine>
+static void resetSatpEngine(void* handle, double R_c, double kappa, double gamma, double dt) {
+    auto* engine = static_cast<Engine*>(handle);
+    engine->setParams(satpParams(R_c, kappa, gamma));
+    engine->setDt(dt);
+    engine->reset();
+}
+
+bool EngineManager::reinitializeEngine(EngineInstance* instance,
+                                       double R_c,
+                                       double kappa,
+                                       double gamma,
+                                       double dt,
+                                       std::string& error_out) {
+    void* handle = instance->engine_handle;
+    try {
+        switch (instance->type_tag) {
+            case EngineInstance::TypeTag::Phase4B:
+                if (!dase_reset_engine) {
+                    error_out = "DASE DLL lacks dase_reset_engine";
+                    return false;
+                }
+                if (dase_reset_engine(handle) != 0) {
+                    error_out = "dase_reset_engine failed";
+                    return false;
+                }
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex:
+                static_cast<dase::igsoa::IGSOAComplexEngine*>(handle)->reconfigure(R_c, kappa, gamma, dt);
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex2D:
+                static_cast<dase::igsoa::IGSOAComplexEngine2D*>(handle)->reconfigure(R_c, kappa, gamma, dt);
+                break;
+            case EngineInstance::TypeTag::IgsoaComplex3D:
+                static_cast<dase::igsoa::IGSOAComplexEngine3D*>(handle)->reconfigure(R_c, kappa, gamma, dt);
+                break;
+            case EngineInstance::TypeTag::IgsoaGW: {
+                auto* engine = static_cast<IGSOAGWEngine*>(handle);
+                if (dt != engine->field.getTimestep()) {
+                    error_out = "igsoa_gw cannot change dt in place (its solver kernels are built for dt = " +
+                                std::to_string(engine->field.getTimestep()) + ")";
+                    return false;
+                }
+                engine->reset(R_c, kappa);
+                break;
+            }
+            case EngineInstance::TypeTag::SatpHiggs1D:
+                resetSatpEngine<dase::satp_higgs::SATPHiggsEngine1D>(handle, R_c, kappa, gamma, dt);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs2D:
+                resetSatpEngine<dase::satp_higgs::SATPHiggsEngine2D>(handle, R_c, kappa, gamma, dt);
+                break;
+            case EngineInstance::TypeTag::SatpHiggs3D:
+                resetSatpEngine<dase::satp_higgs::SATPHiggsEngine3D>(handle, R_c, kappa, gamma, dt);
+                break;
+            default:
+                error_out = instance->engine_type + " engines cannot be reset in place";
                 return false;
-            }
-
-        } else {
-            return false;
         }
-
-    } catch (...) {
+    } catch (const std::exception& e) {
+        error_out = e.what();
         return false;
     }
+    instance->R_c = R_c;
+    instance->kappa = kappa;
+    instance->gamma = gamma;
+    instance->dt = dt;
+    instance->adaptive = dase::AdaptiveStepStats();
+    return true;
 }
 
-bool EngineManager::setSatpState(const std::string& engine_id,
-                                  const std::string& profile_type,
-                                  const nlohmann::json& params) {
+bool EngineManager::resetEngine(const std::string& engine_id,
+                                double R_c,
+                                double kappa,
+                                double gamma,
+                                double dt,
+                                double alpha,
+                                std::string& error_out) {
     auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    // Same limits as createEngine
+    if (!(R_c > 0.0) || !std::isfinite(R_c) || !(kappa > 0.0) || !std::isfinite(kappa) ||
+        !(gamma >= 0.0) || !std::isfinite(gamma) || !(dt > 0.0) || !std::isfinite(dt)) {
+        error_out = "R_c, kappa and dt must be positive and finite, gamma non-negative and finite";
+        return false;
+    }
+    if (!reinitializeEngine(instance, R_c, kappa, gamma, dt, error_out)) {
         return false;
     }
+    instance->alpha = alpha;
+    return true;
+}
 
-    try {
-        if (instance->engine_type == "satp_higgs_1d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
+// Set a tuning's kernel variant, temporal block and thread limit
+static void applyKernelTuning(EngineInstance* instance, const dase::KernelTuning& tuning) {
+    void* handle = instance->engine_handle;
+    switch (instance->type_tag) {
+        case EngineInstance::TypeTag::IgsoaComplex2D: {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(handle);
+            engine->setCouplingMode(static_cast<dase::igsoa::IGSOACouplingMode>(tuning.variant));
+            engine->setTemporalBlockSteps(tuning.temporal_block_steps);
+            break;
+        }
+        case EngineInstance::TypeTag::IgsoaComplex3D: {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(handle);
+            engine->setCouplingMode(static_cast<dase::igsoa::IGSOACouplingMode>(tuning.variant));
+            engine->setTemporalBlockSteps(tuning.temporal_block_steps);
+            break;
+        }
+        case EngineInstance::TypeTag::SatpHiggs2D:
+            static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(handle)->setTemporalBlockSteps(
+                tuning.temporal_block_steps);
+            break;
+        case EngineInstance::TypeTag::SatpHiggs3D: {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(handle);
+            engine->setStencilMode(static_cast<dase::satp_higgs::SATPStencilMode>(tuning.variant));
+            engine->setTemporalBlockSteps(tuning.temporal_block_steps);
+            break;
+        }
+        default:
+            break;
+    }
+    instance->thread_limit = tuning.threads;
+}
 
-            if (profile_type == "vacuum") {
-                // Initialize to Higgs vacuum (VEV)
-                dase::satp_higgs::SATPHiggsStateInit1D::initVacuum(*engine);
-                return true;
+bool EngineManager::autotuneEngine(const std::string& engine_id,
+                                   bool force,
+                                   int steps,
+                                   nlohmann::json& info_out,
+                                   std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        error_out = "Engine not found: " + engine_id;
+        return false;
+    }
+    if (steps < 2) {
+        error_out = "autotune steps must be at least 2";
+        return false;
+    }
 
-            } else if (profile_type == "phi_gaussian") {
-                // Gaussian profile for φ field
-                dase::satp_higgs::GaussianProfileParams gparams;
-                gparams.amplitude = params.value("amplitude", 1.0);
-                gparams.center = params.value("center", static_cast<double>(engine->getN()) * engine->getDx() / 2.0);
-                gparams.sigma = params.value("sigma", static_cast<double>(engine->getN()) * engine->getDx() / 16.0);
-                gparams.set_velocity = params.value("set_velocity", false);
-                gparams.velocity_amplitude = params.value("velocity_amplitude", 0.0);
-                gparams.mode = params.value("mode", "overwrite");
-                gparams.beta = params.value("beta", 1.0);
+    const bool gpu =
+        (instance->type_tag == EngineInstance::TypeTag::IgsoaComplex3D &&
+         static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle)->getDevice() == ComputeDevice::GPU) ||
+        (instance->type_tag == EngineInstance::TypeTag::SatpHiggs3D &&
+         static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle)->getDevice() == ComputeDevice::GPU);
+    if (gpu) {
+        error_out = "GPU engines are not autotuned";
+        return false;
+    }
 
-                dase::satp_higgs::SATPHiggsStateInit1D::initPhiGaussian(*engine, gparams);
-                return true;
+    // Kernel variants and temporal blocks of the engine family
+    std::vector<int> variants = {0};
+    std::vector<uint32_t> blocks = {1};
+    switch (instance->type_tag) {
+        case EngineInstance::TypeTag::IgsoaComplex:
+        case EngineInstance::TypeTag::SatpHiggs1D:
+            break;
+        case EngineInstance::TypeTag::IgsoaComplex2D:
+        case EngineInstance::TypeTag::IgsoaComplex3D:
+            variants = {static_cast<int>(dase::igsoa::IGSOACouplingMode::Direct),
+                        static_cast<int>(dase::igsoa::IGSOACouplingMode::Stencil)};
+            blocks = {1, 4, 8};
+            break;
+        case EngineInstance::TypeTag::SatpHiggs2D:
+            blocks = {1, 4, 8};
+            break;
+        case EngineInstance::TypeTag::SatpHiggs3D:
+            variants = {static_cast<int>(dase::satp_higgs::SATPStencilMode::Reference),
+                        static_cast<int>(dase::satp_higgs::SATPStencilMode::Tiled),
+                        static_cast<int>(dase::satp_higgs::SATPStencilMode::Bricked),
+                        static_cast<int>(dase::satp_higgs::SATPStencilMode::Padded)};
+            blocks = {1, 4, 8};
+            break;
+        default:
+            error_out = "Autotuning supports igsoa_complex* and satp_higgs_* engines only";
+            return false;
+    }
 
-            } else if (profile_type == "higgs_gaussian") {
-                // Gaussian perturbation for h field around VEV
-                dase::satp_higgs::GaussianProfileParams gparams;
-                gparams.amplitude = params.value("amplitude", 0.1);
-                gparams.center = params.value("center", static_cast<double>(engine->getN()) * engine->getDx() / 2.0);
-                gparams.sigma = params.value("sigma", static_cast<double>(engine->getN()) * engine->getDx() / 16.0);
-                gparams.set_velocity = params.value("set_velocity", false);
-                gparams.velocity_amplitude = params.value("velocity_amplitude", 0.0);
-                gparams.mode = params.value("mode", "overwrite");
-                gparams.beta = params.value("beta", 1.0);
+    // The whole budget, or half of it
+    std::vector<int> thread_limits = {0};
+    const int capacity = dase::ThreadBudget::process().capacity();
+    if (capacity >= 4) {
+        thread_limits.push_back(capacity / 2);
+    }
 
-                dase::satp_higgs::SATPHiggsStateInit1D::initHiggsGaussian(*engine, gparams);
-                return true;
+    std::vector<dase::KernelTuning> candidates;
+    for (uint32_t block : blocks) {
+        for (int variant : variants) {
+            // SATP's temporally blocked path has one layout of its own
+            if (block > 1 && instance->type_tag == EngineInstance::TypeTag::SatpHiggs3D &&
+                variant != static_cast<int>(dase::satp_higgs::SATPStencilMode::Tiled)) {
+                continue;
+            }
+            for (int threads : thread_limits) {
+                dase::KernelTuning candidate;
+                candidate.variant = variant;
+                candidate.temporal_block_steps = block;
+                candidate.threads = threads;
+                candidates.push_back(candidate);
+            }
+        }
+    }
 
-            } else if (profile_type == "three_zone_source") {
-                // Set up three-zone source function
-                dase::satp_higgs::ThreeZoneSourceParams sparams;
-                sparams.zone1_start = params.value("zone1_start", 0.0);
-                sparams.zone1_end = params.value("zone1_end", 0.0);
-                sparams.zone2_start = params.value("zone2_start", 0.0);
-                sparams.zone2_end = params.value("zone2_end", 0.0);
-                sparams.zone3_start = params.value("zone3_start", 0.0);
-                sparams.zone3_end = params.value("zone3_end", 0.0);
-                sparams.amplitude1 = params.value("amplitude1", 0.0);
-                sparams.amplitude2 = params.value("amplitude2", 0.0);
-                sparams.amplitude3 = params.value("amplitude3", 0.0);
-                sparams.frequency = params.value("frequency", 0.0);
-                sparams.t_start = params.value("t_start", 0.0);
-                sparams.t_end = params.value("t_end", -1.0);
+    // run_mission's drive; each candidate warms up (stencil tables, SoA
+    // mirrors) for two steps, then runs `steps` timed steps
+    std::vector<double> input_signals(static_cast<size_t>(steps));
+    std::vector<double> control_patterns(static_cast<size_t>(steps));
+    for (int i = 0; i < steps; i++) {
+        input_signals[i] = std::sin(i * 0.01);
+        control_patterns[i] = std::cos(i * 0.01);
+    }
+    auto measure = [&](const dase::KernelTuning& candidate) {
+        applyKernelTuning(instance, candidate);
+        int ran = 0;
+        runMissionSteps(instance, input_signals.data(), control_patterns.data(), 2, 1, ran);
+        const auto start = std::chrono::steady_clock::now();
+        runMissionSteps(instance, input_signals.data(), control_patterns.data(), steps, 1, ran);
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / static_cast<double>(steps);
+    };
 
-                auto source_func = dase::satp_higgs::SATPHiggsStateInit1D::createThreeZoneSource(
-                    sparams, engine->getDx());
-                engine->setSource(source_func);
-                return true;
+    size_t dims[3];
+    getStateDims(engine_id, dims);
+    const std::string key = dase::KernelAutotuner::key(instance->engine_type, dims, instance->R_c);
+    bool measured = false;
+    dase::KernelTuning best;
+    try {
+        best = dase::KernelAutotuner::tune(key, candidates, measure, force, measured);
+    } catch (const std::exception& e) {
+        error_out = e.what();
+        return false;
+    }
+    applyKernelTuning(instance, best);
+    if (measured && !reinitializeEngine(instance, instance->R_c, instance->kappa, instance->gamma, instance->dt,
+                                        error_out)) {
+        return false;
+    }
 
-            } else if (profile_type == "uniform") {
-                // Uniform initialization
-                double phi_val = params.value("phi", 0.0);
-                double phi_dot_val = params.value("phi_dot", 0.0);
-                double h_val = params.value("h", engine->getParams().h_vev);
-                double h_dot_val = params.value("h_dot", 0.0);
+    info_out = {
+        {"key", key},
+        {"measured", measured},
+        {"candidates", measured ? candidates.size() : 0},
+        {"variant", best.variant},
+        {"temporal_block_steps", best.temporal_block_steps},
+        {"threads", best.threads},
+        {"ns_per_step", best.ns_per_step},
+        {"database", dase::KernelAutotuner::path()}
+    };
+    return true;
+}
 
-                dase::satp_higgs::SATPHiggsStateInit1D::initUniform(*engine,
-                    phi_val, phi_dot_val, h_val, h_dot_val);
-                return true;
+// Install (or, with a null buffer, clear) a SATP+Higgs batch source that
+// hands the link buffer to the stepper
+static bool setPipelineSource(EngineInstance* instance, std::shared_ptr<std::vector<double>> buffer) {
+    dase::satp_higgs::BatchSourceFunction source;
+    if (buffer) {
+        source = [buffer](double /*t*/, double* out, size_t num_points) {
+            std::copy(buffer->begin(), buffer->begin() + std::min(num_points, buffer->size()), out);
+        };
+    }
+    void* handle = instance->engine_handle;
+    switch (instance->type_tag) {
+        case EngineInstance::TypeTag::SatpHiggs1D: {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(handle);
+            if (buffer) {
+                engine->setBatchSource(std::move(source));
+            } else {
+                engine->clearSource();
+            }
+            return true;
+        }
+        case EngineInstance::TypeTag::SatpHiggs2D: {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(handle);
+            if (buffer) {
+                engine->setBatchSource(std::move(source));
+            } else {
+                engine->clearSource();
+            }
+            return true;
+        }
+        case EngineInstance::TypeTag::SatpHiggs3D: {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(handle);
+            if (buffer) {
+                engine->setBatchSource(std::move(source));
+            } else {
+                engine->clearSource();
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
 
-            } else if (profile_type == "random_perturbation") {
-                // Add random perturbations
-                double phi_amplitude = params.value("phi_amplitude", 0.01);
-                double h_amplitude = params.value("h_amplitude", 0.01);
-                unsigned int seed = params.value("seed", 0);
+bool EngineManager::runPipeline(const std::vector<std::string>& engine_ids,
+                                std::vector<dase::PipelineLink>& links,
+                                int num_steps,
+                                int exchange_interval,
+                                int iterations_per_node,
+                                nlohmann::json& info_out,
+                                std::string& error_out) {
+    DASE_TRACE_ZONE("engine.run_pipeline");
+    if (num_steps <= 0 || exchange_interval <= 0) {
+        error_out = "num_steps and exchange_interval must be positive";
+        return false;
+    }
 
-                dase::satp_higgs::SATPHiggsStateInit1D::addRandomPerturbation(*engine,
-                    phi_amplitude, h_amplitude, seed);
-                return true;
+    std::vector<EngineInstance*> instances;
+    for (const std::string& id : engine_ids) {
+        auto* instance = getEngine(id);
+        if (!instance || !instance->engine_handle) {
+            error_out = "Engine not found: " + id;
+            return false;
+        }
+        instances.push_back(instance);
+    }
+    const auto position = [&engine_ids](const std::string& id) {
+        return static_cast<size_t>(std::find(engine_ids.begin(), engine_ids.end(), id) - engine_ids.begin());
+    };
 
-            } else {
-                return false;  // Unknown profile type
-            }
+    // Validate every link and size its exchange before any engine changes
+    std::vector<dase::SnapshotSelection> selections(links.size());
+    std::vector<int> source_links(engine_ids.size(), -1);
+    std::vector<std::array<int, 2>> drive_links(engine_ids.size(), {{-1, -1}});
+    for (size_t l = 0; l < links.size(); l++) {
+        dase::PipelineLink& link = links[l];
+        const size_t from = position(link.from);
+        const size_t to = position(link.to);
+        if (from >= engine_ids.size() || to >= engine_ids.size()) {
+            error_out = "Link " + std::to_string(l) + " names an engine not in engine_ids";
+            return false;
+        }
+        if (from == to) {
+            error_out = "Link " + std::to_string(l) + " feeds an engine into itself";
+            return false;
+        }
+        size_t from_dims[3] = {0, 1, 1};
+        size_t to_dims[3] = {0, 1, 1};
+        if (!getStateDims(link.from, from_dims) || !getStateDims(link.to, to_dims)) {
+            error_out = "Link " + std::to_string(l) + ": engine has no state lattice";
+            return false;
+        }
+        const bool satp_source = instances[from]->engine_type.rfind("satp_higgs", 0) == 0;
+        std::string error;
+        if (!selections[l].parse(nlohmann::json{{"fields", nlohmann::json::array({link.field})}}, from_dims,
+                                 satp_source ? dase::SnapshotSelection::satpFields()
+                                             : dase::SnapshotSelection::igsoaFields(),
+                                 error)) {
+            error_out = "Link " + std::to_string(l) + ": " + error;
+            return false;
+        }
 
-        } else if (instance->engine_type == "satp_higgs_2d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
+        const std::string& target_type = instances[to]->engine_type;
+        if (link.input == dase::PipelineInput::Source) {
+            if (target_type.rfind("satp_higgs", 0) != 0) {
+                error_out = "Link " + std::to_string(l) + ": source inputs need a satp_higgs_* target";
+                return false;
+            }
+            if (source_links[to] >= 0) {
+                error_out = "Link " + std::to_string(l) + ": " + link.to + " already has a source link";
+                return false;
+            }
+            source_links[to] = static_cast<int>(l);
+            link.resampler = dase::FieldResampler(from_dims, to_dims);
+            link.buffer = std::make_shared<std::vector<double>>(link.resampler.outputSize(), 0.0);
+        } else {
+            if (target_type.rfind("igsoa_complex", 0) != 0 && target_type != "phase4b") {
+                error_out = "Link " + std::to_string(l) + ": drive inputs need an igsoa_complex* or phase4b target";
+                return false;
+            }
+            int& slot = drive_links[to][link.control_channel ? 1 : 0];
+            if (slot >= 0) {
+                error_out = "Link " + std::to_string(l) + ": " + link.to + " already has a drive link on that channel";
+                return false;
+            }
+            slot = static_cast<int>(l);
+        }
+    }
 
-            if (profile_type == "vacuum") {
-                // Initialize to Higgs vacuum (VEV)
-                dase::satp_higgs::SATPHiggsStateInit2D::initVacuum(*engine);
-                return true;
+    // Source links own the targets' sources for the run
+    struct SourceGuard {
+        std::vector<EngineInstance*> targets;
+        ~SourceGuard() {
+            for (EngineInstance* target : targets) {
+                setPipelineSource(target, nullptr);
+            }
+        }
+    } sources;
+    for (size_t e = 0; e < engine_ids.size(); e++) {
+        if (source_links[e] >= 0) {
+            setPipelineSource(instances[e], links[static_cast<size_t>(source_links[e])].buffer);
+            sources.targets.push_back(instances[e]);
+        }
+    }
 
-            } else if (profile_type == "phi_circular_gaussian") {
-                // Circular Gaussian profile for φ field
-                double amplitude = params.value("amplitude", 1.0);
-                double center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
-                double center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
-                double sigma = params.value("sigma", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
-                std::string mode = params.value("mode", "overwrite");
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::vector<double>> gathered;
+    std::vector<double> input_signals;
+    std::vector<double> control_patterns;
+    int done = 0;
+    int exchanges = 0;
+    try {
+        while (done < num_steps) {
+            const int count = std::min(exchange_interval, num_steps - done);
+
+            // Sample every link at the start of the block
+            for (size_t l = 0; l < links.size(); l++) {
+                dase::PipelineLink& link = links[l];
+                if (!getSelectedState(link.from, selections[l], gathered) || gathered.empty()) {
+                    error_out = "Link " + std::to_string(l) + ": failed to read " + link.field + " of " + link.from;
+                    return false;
+                }
+                if (link.input == dase::PipelineInput::Source) {
+                    std::vector<double>& buffer = *link.buffer;
+                    link.resampler.apply(gathered[0].data(), buffer.data());
+                    if (link.scale != 1.0 || link.offset != 0.0) {
+                        for (double& value : buffer) {
+                            value = link.scale * value + link.offset;
+                        }
+                    }
+                } else {
+                    link.last_value = link.scale * dase::reduceField(gathered[0], link.reduce) + link.offset;
+                }
+            }
+            exchanges++;
+
+            // Advance every engine through the block
+            input_signals.resize(count);
+            control_patterns.resize(count);
+            for (size_t e = 0; e < engine_ids.size(); e++) {
+                for (int i = 0; i < count; i++) {
+                    input_signals[i] = std::sin((done + i) * 0.01);
+                    control_patterns[i] = std::cos((done + i) * 0.01);
+                }
+                if (drive_links[e][0] >= 0) {
+                    std::fill(input_signals.begin(), input_signals.end(),
+                              links[static_cast<size_t>(drive_links[e][0])].last_value);
+                }
+                if (drive_links[e][1] >= 0) {
+                    std::fill(control_patterns.begin(), control_patterns.end(),
+                              links[static_cast<size_t>(drive_links[e][1])].last_value);
+                }
+                int ran = count;
+                if (!runMissionSteps(instances[e], input_signals.data(), control_patterns.data(), count,
+                                     iterations_per_node, ran)) {
+                    error_out = "Mission execution failed on " + engine_ids[e] + " at step " + std::to_string(done);
+                    return false;
+                }
+            }
+            done += count;
+        }
+    } catch (const std::exception& e) {
+        error_out = e.what();
+        return false;
+    }
 
-                dase::satp_higgs::SATPHiggsStateInit2D::initPhiCircularGaussian(
-                    *engine, amplitude, center_x, center_y, sigma, mode);
-                return true;
+    nlohmann::json link_info = nlohmann::json::array();
+    for (const dase::PipelineLink& link : links) {
+        nlohmann::json entry = {{"from", link.from}, {"field", link.field}, {"to", link.to}};
+        if (link.input == dase::PipelineInput::Source) {
+            entry["input"] = "source";
+            entry["resampled"] = !link.resampler.isIdentity();
+            entry["last_rms"] = dase::reduceField(*link.buffer, dase::PipelineReduce::Rms);
+        } else {
+            entry["input"] = "drive";
+            entry["channel"] = link.control_channel ? "control" : "input";
+            entry["reduce"] = dase::pipelineReduceName(link.reduce);
+            entry["last_value"] = link.last_value;
+        }
+        link_info.push_back(std::move(entry));
+    }
+    info_out = {
+        {"steps", done},
+        {"exchanges", exchanges},
+        {"exchange_interval", exchange_interval},
+        {"wall_ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()},
+        {"links", std::move(link_info)}
+    };
+    return true;
+}
 
-            } else if (profile_type == "phi_gaussian") {
-                // Elliptical Gaussian profile for φ field
-                dase::satp_higgs::GaussianProfile2DParams gparams;
-                gparams.amplitude = params.value("amplitude", 1.0);
-                gparams.center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
-                gparams.center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
-                gparams.sigma_x = params.value("sigma_x", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
-                gparams.sigma_y = params.value("sigma_y", static_cast<double>(engine->getNy()) * engine->getDx() / 16.0);
-                gparams.set_velocity = params.value("set_velocity", false);
-                gparams.velocity_amplitude = params.value("velocity_amplitude", 0.0);
-                gparams.mode = params.value("mode", "overwrite");
-                gparams.beta = params.value("beta", 1.0);
+std::string EngineManager::poolKey(const std::string& engine_type, int num_nodes,
+                                   int N_x, int N_y, int N_z, double dt, const NumaOptions& numa) {
+    std::ostringstream key;
+    key << engine_type << ':';
+    if (engine_type == "phase4b" || engine_type == "igsoa_complex" || engine_type == "satp_higgs_1d") {
+        key << num_nodes;
+    } else if (engine_type == "igsoa_complex_2d" || engine_type == "satp_higgs_2d") {
+        key << N_x << 'x' << N_y;
+    } else if (engine_type == "igsoa_complex_3d" || engine_type == "satp_higgs_3d") {
+        key << N_x << 'x' << N_y << 'x' << N_z;
+    } else if (engine_type == "igsoa_gw") {
+        // Shape as createEngine defaults it; dt is part of the solver kernels
+        key << (N_x > 0 ? N_x : 16) << 'x' << (N_y > 0 ? N_y : 16) << 'x' << (N_z > 0 ? N_z : 16)
+            << ":dt=" << std::hexfloat << dt << std::defaultfloat;
+    } else {
+        return "";
+    }
+    key << ":numa=" << numa.first_touch << numa.interleave
+        << static_cast<int>(numa.thread_affinity) << static_cast<int>(numa.huge_pages);
+    return key.str();
+}
 
-                dase::satp_higgs::SATPHiggsStateInit2D::initPhiGaussian(*engine, gparams);
-                return true;
+bool EngineManager::parkEngine(std::unique_ptr<EngineInstance>& instance) {
+    if (!instance->engine_handle) {
+        return false;
+    }
+    const std::string key = poolKey(instance->engine_type, instance->num_nodes, instance->dimension_x,
+                                    instance->dimension_y, instance->dimension_z, instance->dt, instance->numa);
+    if (key.empty() || (instance->type_tag == EngineInstance::TypeTag::Phase4B && !dase_reset_engine)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        const auto it = engine_pool_.find(key);
+        if (pool_max_idle_ == 0 || (it != engine_pool_.end() && it->second.size() >= pool_max_idle_)) {
+            return false;
+        }
+    }
 
-            } else if (profile_type == "higgs_circular_gaussian") {
-                // Circular Gaussian perturbation for h field around VEV
-                double amplitude = params.value("amplitude", 0.1);
-                double center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
-                double center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
-                double sigma = params.value("sigma", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
-                std::string mode = params.value("mode", "overwrite");
+    // Drop what the next owner must not inherit (state is reset on take)
+    if (auto* probes = probeRecorder(instance.get())) {
+        probes->clear();
+    }
+    size_t dims[3];
+    if (auto* observables = observableRecorder(instance.get(), dims)) {
+        observables->clear();
+    }
+    void* handle = instance->engine_handle;
+    const dase::igsoa::IGSOAComplexConfig defaults;
+    switch (instance->type_tag) {
+        case EngineInstance::TypeTag::IgsoaComplex:
+            static_cast<dase::igsoa::IGSOAComplexEngine*>(handle)->setKernelPolicy(defaults.kernel_policy);
+            break;
+        case EngineInstance::TypeTag::IgsoaComplex2D: {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(handle);
+            engine->setSparseEvolution(defaults.sparse_threshold, defaults.sparse_block);
+            engine->setKernelPolicy(defaults.kernel_policy);
+            break;
+        }
+        case EngineInstance::TypeTag::IgsoaComplex3D: {
+            auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(handle);
+            engine->setSparseEvolution(defaults.sparse_threshold, defaults.sparse_block);
+            engine->setKernelPolicy(defaults.kernel_policy);
+            engine->setDevice(ComputeDevice::CPU);
+            break;
+        }
+        case EngineInstance::TypeTag::IgsoaGW:
+            static_cast<IGSOAGWEngine*>(handle)->refinement.reset();
+            break;
+        case EngineInstance::TypeTag::SatpHiggs1D:
+            static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(handle)->clearSource();
+            break;
+        case EngineInstance::TypeTag::SatpHiggs2D:
+            static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(handle)->clearSource();
+            break;
+        case EngineInstance::TypeTag::SatpHiggs3D: {
+            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(handle);
+            engine->clearSource();
+            engine->setDevice(ComputeDevice::CPU);
+            break;
+        }
+        default:
+            break;
+    }
+    applyKernelTuning(instance.get(), dase::KernelTuning());
 
-                dase::satp_higgs::SATPHiggsStateInit2D::initHiggsCircularGaussian(
-                    *engine, amplitude, center_x, center_y, sigma, mode);
-                return true;
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    auto& idle = engine_pool_[key];
+    if (idle.size() >= pool_max_idle_) {
+        return false;
+    }
+    idle.push_back(std::move(instance));
+    return true;
+}
 
-            } else if (profile_type == "uniform") {
-                // Uniform initialization
-                double phi_val = params.value("phi", 0.0);
-                double phi_dot_val = params.value("phi_dot", 0.0);
-                double h_val = params.value("h", engine->getParams().h_vev);
-                double h_dot_val = params.value("h_dot", 0.0);
+std::unique_ptr<EngineInstance> EngineManager::takePooledEngine(const std::string& key) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (pool_max_idle_ == 0) {
+        return nullptr;
+    }
+    auto it = engine_pool_.find(key);
+    if (it == engine_pool_.end() || it->second.empty()) {
+        pool_misses_++;
+        return nullptr;
+    }
+    std::unique_ptr<EngineInstance> instance = std::move(it->second.back());
+    it->second.pop_back();
+    pool_hits_++;
+    return instance;
+}
 
-                dase::satp_higgs::SATPHiggsStateInit2D::initUniform(*engine,
-                    phi_val, phi_dot_val, h_val, h_dot_val);
-                return true;
+void EngineManager::setEnginePool(size_t max_idle) {
+    std::vector<std::unique_ptr<EngineInstance>> excess;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        pool_max_idle_ = max_idle;
+        for (auto it = engine_pool_.begin(); it != engine_pool_.end();) {
+            auto& idle = it->second;
+            while (idle.size() > max_idle) {
+                excess.push_back(std::move(idle.back()));
+                idle.pop_back();
+            }
+            it = idle.empty() ? engine_pool_.erase(it) : std::next(it);
+        }
+    }
+    for (auto& instance : excess) {
+        freeEngineHandle(instance.get());
+    }
+}
 
-            } else if (profile_type == "random_perturbation") {
-                // Add random perturbations
-                double phi_amplitude = params.value("phi_amplitude", 0.01);
-                double h_amplitude = params.value("h_amplitude", 0.01);
-                unsigned int seed = params.value("seed", 0);
+nlohmann::json EngineManager::enginePoolStats() const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    size_t idle = 0;
+    for (const auto& entry : engine_pool_) {
+        idle += entry.second.size();
+    }
+    return {
+        {"max_idle", pool_max_idle_},
+        {"idle", idle},
+        {"hits", pool_hits_},
+        {"misses", pool_misses_}
+    };
+}
 
-                dase::satp_higgs::SATPHiggsStateInit2D::addRandomPerturbation(*engine,
-                    phi_amplitude, h_amplitude, seed);
-                return true;
+std::vector<std::string> EngineManager::probeFields(const std::string& engine_id) {
+    auto* instance = getEngine(engine_id);
+    if (!probeRecorder(instance)) {
+        return {};
+    }
+    if (instance->type_tag == EngineInstance::TypeTag::IgsoaGW) {
+        return {"delta_phi_real", "delta_phi_imag", "alpha"};
+    }
+    return {"psi_real", "psi_imag", "phi", "F"};   // IGSOANodeField order
+}
 
-            } else {
-                return false;  // Unknown profile type
-            }
+bool EngineManager::probePointsAt(const std::string& engine_id,
+                                  const std::vector<std::array<double, 3>>& positions,
+                                  std::vector<uint64_t>& points_out,
+                                  std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle || instance->type_tag != EngineInstance::TypeTag::IgsoaGW) {
+        error_out = "Detector positions need an igsoa_gw engine";
+        return false;
+    }
+    const auto& field = static_cast<IGSOAGWEngine*>(instance->engine_handle)->field;
+    points_out.clear();
+    for (const auto& position : positions) {
+        int i = 0, j = 0, k = 0;
+        field.toIndices(dase::igsoa::gw::Vector3D(position[0], position[1], position[2]), i, j, k);
+        if (i < 0 || j < 0 || k < 0 || i >= field.getNx() || j >= field.getNy() || k >= field.getNz()) {
+            error_out = "Detector position outside the grid";
+            return false;
+        }
+        points_out.push_back(static_cast<uint64_t>(field.toFlatIndex(i, j, k)));
+    }
+    return true;
+}
 
-        } else if (instance->engine_type == "satp_higgs_3d") {
-            auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
+int EngineManager::addProbe(const std::string& engine_id, const dase::ProbeSpec& spec, std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    dase::ProbeRecorder* recorder = probeRecorder(instance);
+    if (!recorder) {
+        error_out = "Engine does not support probes";
+        return -1;
+    }
+    const uint64_t num_points = static_cast<uint64_t>(instance->num_nodes);   // Grid points for igsoa_gw
+    const int num_fields = instance->type_tag == EngineInstance::TypeTag::IgsoaGW
+        ? IGSOAGWEngine::kNumProbeFields : dase::igsoa::IGSOABulkAccess::kNumFields;
+    const int id = recorder->add(spec, num_points, num_fields);
+    if (id < 0) {
+        error_out = "Probe needs points below " + std::to_string(num_points) +
+                    ", at least one field, and positive decimation and capacity";
+    }
+    return id;
+}
 
-            if (profile_type == "vacuum") {
-                // Initialize to Higgs vacuum (VEV)
-                dase::satp_higgs::SATPHiggsStateInit3D::initVacuum(*engine);
-                return true;
+bool EngineManager::drainProbe(const std::string& engine_id, int probe_id,
+                               std::vector<uint64_t>& steps_out,
+                               std::vector<double>& values_out,
+                               uint64_t& dropped_out,
+                               dase::ProbeSpec& spec_out) {
+    dase::ProbeRecorder* recorder = probeRecorder(getEngine(engine_id));
+    const dase::ProbeSpec* spec = recorder ? recorder->spec(probe_id) : nullptr;
+    if (!spec) {
+        return false;
+    }
+    spec_out = *spec;
+    return recorder->drain(probe_id, steps_out, values_out, &dropped_out);
+}
 
-            } else if (profile_type == "phi_spherical_gaussian") {
-                // Spherical Gaussian profile for φ field
-                double amplitude = params.value("amplitude", 1.0);
-                double center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
-                double center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
-                double center_z = params.value("center_z", static_cast<double>(engine->getNz()) * engine->getDx() / 2.0);
-                double sigma = params.value("sigma", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
-                std::string mode = params.value("mode", "overwrite");
+bool EngineManager::removeProbe(const std::string& engine_id, int probe_id) {
+    dase::ProbeRecorder* recorder = probeRecorder(getEngine(engine_id));
+    return recorder && recorder->remove(probe_id);
+}
 
-                dase::satp_higgs::SATPHiggsStateInit3D::initPhiSphericalGaussian(
-                    *engine, amplitude, center_x, center_y, center_z, sigma, mode);
-                return true;
+std::vector<int> EngineManager::probeIds(const std::string& engine_id) {
+    dase::ProbeRecorder* recorder = probeRecorder(getEngine(engine_id));
+    return recorder ? recorder->ids() : std::vector<int>();
+}
 
-            } else if (profile_type == "phi_gaussian") {
-                // Ellipsoidal Gaussian profile for φ field
-                dase::satp_higgs::GaussianProfile3DParams gparams;
-                gparams.amplitude = params.value("amplitude", 1.0);
-                gparams.center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
-                gparams.center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
-                gparams.center_z = params.value("center_z", static_cast<double>(engine->getNz()) * engine->getDx() / 2.0);
-                gparams.sigma_x = params.value("sigma_x", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
-                gparams.sigma_y = params.value("sigma_y", static_cast<double>(engine->getNy()) * engine->getDx() / 16.0);
-                gparams.sigma_z = params.value("sigma_z", static_cast<double>(engine->getNz()) * engine->getDx() / 16.0);
-                gparams.set_velocity = params.value("set_velocity", false);
-                gparams.velocity_amplitude = params.value("velocity_amplitude", 0.0);
-                gparams.mode = params.value("mode", "overwrite");
-                gparams.beta = params.value("beta", 1.0);
+int EngineManager::addObservable(const std::string& engine_id, dase::ObservableSpec& spec,
+                                 std::string& error_out) {
+    size_t dims[3];
+    dase::ObservableRecorder* recorder = observableRecorder(getEngine(engine_id), dims);
+    if (!recorder) {
+        error_out = "Engine does not support observables";
+        return -1;
+    }
+    const int id = recorder->add(spec, dims[0], dims[1], dims[2], dase::igsoa::IGSOABulkAccess::kNumFields);
+    if (id < 0) {
+        error_out = "Observable needs boxes inside the " + std::to_string(dims[0]) + "x" +
+                    std::to_string(dims[1]) + "x" + std::to_string(dims[2]) +
+                    " lattice (correlation: two of one shape; center_of_mass: the whole lattice), "
+                    "and positive decimation and capacity";
+    } else {
+        spec = *recorder->spec(id);
+    }
+    return id;
+}
 
-                dase::satp_higgs::SATPHiggsStateInit3D::initPhiGaussian(*engine, gparams);
-                return true;
+bool EngineManager::drainObservable(const std::string& engine_id, int observable_id,
+                                    std::vector<uint64_t>& steps_out,
+                                    std::vector<double>& values_out,
+                                    uint64_t& dropped_out,
+                                    dase::ObservableSpec& spec_out) {
+    size_t dims[3];
+    dase::ObservableRecorder* recorder = observableRecorder(getEngine(engine_id), dims);
+    const dase::ObservableSpec* spec = recorder ? recorder->spec(observable_id) : nullptr;
+    if (!spec) {
+        return false;
+    }
+    spec_out = *spec;
+    return recorder->drain(observable_id, steps_out, values_out, &dropped_out);
+}
 
-            } else if (profile_type == "higgs_spherical_gaussian") {
-                // Spherical Gaussian perturbation for h field around VEV
-                double amplitude = params.value("amplitude", 0.1);
-                double center_x = params.value("center_x", static_cast<double>(engine->getNx()) * engine->getDx() / 2.0);
-                double center_y = params.value("center_y", static_cast<double>(engine->getNy()) * engine->getDx() / 2.0);
-                double center_z = params.value("center_z", static_cast<double>(engine->getNz()) * engine->getDx() / 2.0);
-                double sigma = params.value("sigma", static_cast<double>(engine->getNx()) * engine->getDx() / 16.0);
-                std::string mode = params.value("mode", "overwrite");
+bool EngineManager::removeObservable(const std::string& engine_id, int observable_id) {
+    size_t dims[3];
+    dase::ObservableRecorder* recorder = observableRecorder(getEngine(engine_id), dims);
+    return recorder && recorder->remove(observable_id);
+}
 
-                dase::satp_higgs::SATPHiggsStateInit3D::initHiggsSphericalGaussian(
-                    *engine, amplitude, center_x, center_y, center_z, sigma, mode);
-                return true;
+std::vector<int> EngineManager::observableIds(const std::string& engine_id) {
+    size_t dims[3];
+    dase::ObservableRecorder* recorder = observableRecorder(getEngine(engine_id), dims);
+    return recorder ? recorder->ids() : std::vector<int>();
+}
 
-            } else if (profile_type == "uniform") {
-                // Uniform initialization
-                double phi_val = params.value("phi", 0.0);
-                double phi_dot_val = params.value("phi_dot", 0.0);
-                double h_val = params.value("h", engine->getParams().h_vev);
-                double h_dot_val = params.value("h_dot", 0.0);
+int EngineManager::addTrigger(const std::string& engine_id, const dase::TriggerSpec& spec,
+                              std::string& error_out) {
+    size_t dims[3];
+    dase::ObservableRecorder* recorder = observableRecorder(getEngine(engine_id), dims);
+    if (!recorder) {
+        error_out = "Engine does not support observables";
+        return -1;
+    }
+    const int id = recorder->addTrigger(spec);
+    if (id < 0) {
+        error_out = "Trigger needs an observable of the engine, a value index below its width, "
+                    "hold >= 1 (crossings: 1), a finite threshold (settles: positive), "
+                    "a finite drive_gain and, to snapshot, a path";
+    }
+    return id;
+}
 
-                dase::satp_higgs::SATPHiggsStateInit3D::initUniform(*engine,
-                    phi_val, phi_dot_val, h_val, h_dot_val);
-                return true;
+bool EngineManager::removeTrigger(const std::string& engine_id, int trigger_id) {
+    size_t dims[3];
+    dase::ObservableRecorder* recorder = observableRecorder(getEngine(engine_id), dims);
+    return recorder && recorder->removeTrigger(trigger_id);
+}
 
-            } else if (profile_type == "random_perturbation") {
-                // Add random perturbations
-                double phi_amplitude = params.value("phi_amplitude", 0.01);
-                double h_amplitude = params.value("h_amplitude", 0.01);
-                unsigned int seed = params.value("seed", 0);
+bool EngineManager::hasTriggers(const std::string& engine_id) {
+    size_t dims[3];
+    dase::ObservableRecorder* recorder = observableRecorder(getEngine(engine_id), dims);
+    return recorder && !recorder->triggerIds().empty();
+}
 
-                dase::satp_higgs::SATPHiggsStateInit3D::addRandomPerturbation(*engine,
-                    phi_amplitude, h_amplitude, seed);
-                return true;
+int EngineManager::addSpectralMonitor(const std::string& engine_id, int probe_id,
+                                      dase::analysis::SpectralMonitorConfig config,
+                                      std::string& error_out) {
+    auto* instance = getEngine(engine_id);
+    dase::ProbeRecorder* recorder = probeRecorder(instance);
+    const dase::ProbeSpec* spec = recorder ? recorder->spec(probe_id) : nullptr;
+    if (!spec) {
+        error_out = "Unknown probe " + std::to_string(probe_id) + " on engine " + engine_id;
+        return -1;
+    }
+    config.sample_interval = static_cast<double>(spec->decimation) * instance->dt;
 
-            } else {
-                return false;  // Unknown profile type
-            }
+    SpectralBinding binding;
+    try {
+        binding.monitor = std::make_unique<dase::analysis::SpectralMonitor>(
+            config, spec->points.size() * spec->fields.size());
+    } catch (const std::exception& e) {
+        error_out = e.what();
+        return -1;
+    }
+    dase::analysis::SpectralMonitor* monitor = binding.monitor.get();
+    binding.probe_id = probe_id;
+    binding.spec = *spec;
+    binding.tap_id = recorder->addTap(probe_id, [monitor](uint64_t, const double* sample) {
+        monitor->push(sample);
+    });
+
+    std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+    const int id = next_monitor_id_++;
+    spectral_monitors_[engine_id][id] = std::move(binding);
+    return id;
+}
 
-        } else {
-            return false;  // Wrong engine type
-        }
+dase::analysis::SpectralMonitor* EngineManager::spectralMonitor(const std::string& engine_id, int monitor_id,
+                                                                int* probe_id_out,
+                                                                dase::ProbeSpec* spec_out) {
+    std::shared_lock<std::shared_mutex> registry_lock(registry_mutex_);
+    auto engine_it = spectral_monitors_.find(engine_id);
+    if (engine_it == spectral_monitors_.end()) {
+        return nullptr;
+    }
+    auto it = engine_it->second.find(monitor_id);
+    if (it == engine_it->second.end()) {
+        return nullptr;
+    }
+    if (probe_id_out) *probe_id_out = it->second.probe_id;
+    if (spec_out) *spec_out = it->second.spec;
+    return it->second.monitor.get();
+}
 
-    } catch (...) {
+bool EngineManager::removeSpectralMonitor(const std::string& engine_id, int monitor_id) {
+    dase::ProbeRecorder* recorder = probeRecorder(getEngine(engine_id));
+    std::unique_lock<std::shared_mutex> registry_lock(registry_mutex_);
+    auto engine_it = spectral_monitors_.find(engine_id);
+    if (engine_it == spectral_monitors_.end()) {
         return false;
     }
+    auto it = engine_it->second.find(monitor_id);
+    if (it == engine_it->second.end()) {
+        return false;
+    }
+    // Detach before the monitor goes (a no-op if the probe was removed)
+    if (recorder) {
+        recorder->removeTap(it->second.probe_id, it->second.tap_id);
+    }
+    engine_it->second.erase(it);
+    if (engine_it->second.empty()) {
+        spectral_monitors_.erase(engine_it);
+    }
+    return true;
 }
 
-bool EngineManager::computeCenterOfMass2D(const std::string& engine_id,
-                                          double& x_cm_out,
-                                          double& y_cm_out) {
+bool EngineManager::getEnsembleState(const std::string& engine_id, size_t first_replica, size_t count,
+                                     EnsembleState& state_out) {
     auto* instance = getEngine(engine_id);
-    if (!instance || !instance->engine_handle) {
+    if (!instance || !instance->engine_handle ||
+        instance->type_tag != EngineInstance::TypeTag::IgsoaEnsemble1D) {
         return false;
     }
-
-    if (instance->engine_type != "igsoa_complex_2d") {
+    auto* engine = static_cast<dase::igsoa::IGSOAEnsembleEngine1D*>(instance->engine_handle);
+    const size_t replicas = engine->getNumReplicas();
+    if (first_replica > replicas || count > replicas - first_replica) {
         return false;
     }
-
-    auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
-    dase::igsoa::IGSOAStateInit2D::computeCenterOfMass(*engine, x_cm_out, y_cm_out);
-    return true;
+    const size_t values = count * engine->getNumNodes();
+    state_out.psi_real.resize(values);
+    state_out.psi_imag.resize(values);
+    state_out.phi.resize(values);
+    state_out.kappa.resize(count);
+    state_out.gamma.resize(count);
+    for (size_t r = 0; r < count; ++r) {
+        state_out.kappa[r] = engine->getReplicaKappa(first_replica + r);
+        state_out.gamma[r] = engine->getReplicaGamma(first_replica + r);
+    }
+    return engine->getField(dase::igsoa::IGSOANodeField::PsiReal, first_replica, count, state_out.psi_real.data()) &&
+           engine->getField(dase::igsoa::IGSOANodeField::PsiImag, first_replica, count, state_out.psi_imag.data()) &&
+           engine->getField(dase::igsoa::IGSOANodeField::Phi, first_replica, count, state_out.phi.data());
 }
 
-bool EngineManager::computeCenterOfMass3D(const std::string& engine_id,
-                                          double& x_cm_out,
-                                          double& y_cm_out,
-                                          double& z_cm_out) {
+bool EngineManager::setEnsembleState(const std::string& engine_id, size_t first_replica, size_t count,
+                                     const EnsembleState& state, std::string& error_out) {
     auto* instance = getEngine(engine_id);
-    if (!instance || !instance->engine_handle) {
+    if (!instance || !instance->engine_handle ||
+        instance->type_tag != EngineInstance::TypeTag::IgsoaEnsemble1D) {
+        error_out = "Engine is not an igsoa_ensemble_1d engine: " + engine_id;
         return false;
     }
-
-    if (instance->engine_type != "igsoa_complex_3d") {
+    auto* engine = static_cast<dase::igsoa::IGSOAEnsembleEngine1D*>(instance->engine_handle);
+    const size_t replicas = engine->getNumReplicas();
+    if (first_replica > replicas || count > replicas - first_replica) {
+        error_out = "Replica range exceeds the ensemble (" + std::to_string(replicas) + " replicas)";
+        return false;
+    }
+    const size_t values = count * engine->getNumNodes();
+    const auto sized = [](const std::vector<double>& field, size_t expected) {
+        return field.empty() || field.size() == expected;
+    };
+    if (!sized(state.psi_real, values) || !sized(state.psi_imag, values) || !sized(state.phi, values) ||
+        !sized(state.kappa, count) || !sized(state.gamma, count)) {
+        error_out = "Ensemble state fields must hold num_nodes values per replica (kappa / gamma: one per replica)";
         return false;
     }
 
-    auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
-    dase::igsoa::IGSOAStateInit3D::computeCenterOfMass(*engine, x_cm_out, y_cm_out, z_cm_out);
+    using dase::igsoa::IGSOANodeField;
+    if (!state.psi_real.empty()) {
+        engine->setField(IGSOANodeField::PsiReal, first_replica, count, state.psi_real.data());
+    }
+    if (!state.psi_imag.empty()) {
+        engine->setField(IGSOANodeField::PsiImag, first_replica, count, state.psi_imag.data());
+    }
+    if (!state.phi.empty()) {
+        engine->setField(IGSOANodeField::Phi, first_replica, count, state.phi.data());
+    }
+    for (size_t r = 0; r < count; ++r) {
+        const size_t replica = first_replica + r;
+        engine->setReplicaCoupling(replica,
+                                   state.kappa.empty() ? engine->getReplicaKappa(replica) : state.kappa[r],
+                                   state.gamma.empty() ? engine->getReplicaGamma(replica) : state.gamma[r]);
+    }
     return true;
 }
 
@@ -2049,11 +5183,56 @@ EngineManager::EngineMetrics EngineManager::getMetrics(const std::string& engine
     metrics.ops_per_sec = 0;
     metrics.total_operations = 0;
     metrics.speedup_factor = 0;
+    metrics.hw_counters_valid = false;
+    metrics.hw_cycles = 0;
+    metrics.hw_instructions = 0;
+    metrics.hw_llc_misses = 0;
+    metrics.hw_ipc = 0;
+    metrics.hw_dram_bandwidth_gbps = 0;
+    metrics.roofline_valid = false;
+    metrics.model_bytes_per_step = 0;
+    metrics.model_flops_per_step = 0;
+    metrics.arithmetic_intensity = 0;
+    metrics.achieved_gbps = 0;
+    metrics.achieved_gflops = 0;
+    metrics.sparse_valid = false;
+    metrics.sparse_skipped_fraction = 0;
+    metrics.page_size_bytes = 0;
+    metrics.energy_valid = false;
+    metrics.energy_source = "";
+    metrics.energy_joules = 0;
+    metrics.energy_seconds = 0;
+    metrics.energy_average_watts = 0;
+    metrics.energy_joules_per_step = 0;
+    metrics.energy_joules_per_node_update = 0;
+
+    // Rates need a timed run; the per-step model is reported regardless
+    const auto setRoofline = [&metrics](const dase::KernelRoofline& roofline) {
+        metrics.roofline_valid = roofline.valid;
+        metrics.model_bytes_per_step = roofline.bytes_per_step;
+        metrics.model_flops_per_step = roofline.flops_per_step;
+        metrics.arithmetic_intensity = roofline.arithmetic_intensity;
+        metrics.achieved_gbps = roofline.achieved_gbps;
+        metrics.achieved_gflops = roofline.achieved_gflops;
+    };
 
     auto* instance = getEngine(engine_id);
     if (!instance || !instance->engine_handle) {
         return metrics;
     }
+    metrics.adaptive = instance->adaptive;
+    if (instance->energy_meter && instance->last_energy.valid && instance->last_energy_steps > 0) {
+        const EnergySample& energy = instance->last_energy;
+        const double node_updates = static_cast<double>(instance->num_nodes) *
+                                    std::max(1, instance->num_replicas) * instance->last_energy_steps;
+        metrics.energy_valid = true;
+        metrics.energy_source = instance->energy_meter->source();
+        metrics.energy_joules = energy.joules;
+        metrics.energy_seconds = energy.seconds;
+        metrics.energy_average_watts = energy.averageWatts();
+        metrics.energy_joules_per_step = energy.joules / instance->last_energy_steps;
+        metrics.energy_joules_per_node_update = node_updates > 0.0 ? energy.joules / node_updates : 0.0;
+    }
 
     if (instance->engine_type == "phase4b") {
         // Phase 4B - get from DLL
@@ -2069,6 +5248,21 @@ EngineManager::EngineMetrics EngineManager::getMetrics(const std::string& engine
             &metrics.total_operations
         );
 
+        DaseHardwareCountersV1 counters = {};
+        counters.struct_size = sizeof(counters);
+        if (dase_get_hardware_counters &&
+            dase_get_hardware_counters(instance->engine_handle, &counters) == 0 && counters.valid) {
+            metrics.hw_counters_valid = true;
+            metrics.hw_cycles = counters.cycles;
+            metrics.hw_instructions = counters.instructions;
+            metrics.hw_llc_misses = counters.llc_misses;
+            metrics.hw_ipc = counters.ipc;
+            metrics.hw_dram_bandwidth_gbps = counters.dram_bandwidth_gbps;
+        }
+        if (dase_get_state_page_size) {
+            metrics.page_size_bytes = dase_get_state_page_size(instance->engine_handle);
+        }
+
     } else if (instance->engine_type == "igsoa_complex") {
         // IGSOA Complex - get directly
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine*>(instance->engine_handle);
@@ -2078,6 +5272,8 @@ EngineManager::EngineMetrics EngineManager::getMetrics(const std::string& engine
             metrics.speedup_factor,
             metrics.total_operations
         );
+        setRoofline(engine->getRoofline());
+        metrics.page_size_bytes = engine->getStatePageSize();
 
     } else if (instance->engine_type == "igsoa_complex_2d") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine2D*>(instance->engine_handle);
@@ -2087,6 +5283,10 @@ EngineManager::EngineMetrics EngineManager::getMetrics(const std::string& engine
             metrics.speedup_factor,
             metrics.total_operations
         );
+        setRoofline(engine->getRoofline());
+        metrics.page_size_bytes = engine->getStatePageSize();
+        metrics.sparse_valid = engine->getSparseThreshold() > 0.0;
+        metrics.sparse_skipped_fraction = engine->getSparseSkippedFraction();
     } else if (instance->engine_type == "igsoa_complex_3d") {
         auto* engine = static_cast<dase::igsoa::IGSOAComplexEngine3D*>(instance->engine_handle);
         engine->getMetrics(
@@ -2095,18 +5295,34 @@ EngineManager::EngineMetrics EngineManager::getMetrics(const std::string& engine
             metrics.speedup_factor,
             metrics.total_operations
         );
+        setRoofline(engine->getRoofline());
+        metrics.page_size_bytes = engine->getStatePageSize();
+        metrics.sparse_valid = engine->getSparseThreshold() > 0.0;
+        metrics.sparse_skipped_fraction = engine->getSparseSkippedFraction();
+    } else if (instance->engine_type == "igsoa_ensemble_1d") {
+        auto* engine = static_cast<dase::igsoa::IGSOAEnsembleEngine1D*>(instance->engine_handle);
+        engine->getMetrics(
+            metrics.ns_per_op,
+            metrics.ops_per_sec,
+            metrics.speedup_factor,
+            metrics.total_operations
+        );
+        setRoofline(engine->getRoofline());
     } else if (instance->engine_type == "igsoa_gw") {
         auto* engine = static_cast<IGSOAGWEngine*>(instance->engine_handle);
         engine->getMetrics(metrics.ns_per_op, metrics.ops_per_sec, metrics.total_operations);
     } else if (instance->engine_type == "satp_higgs_1d") {
         auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine1D*>(instance->engine_handle);
         engine->getMetrics(metrics.ns_per_op, metrics.ops_per_sec, metrics.total_operations);
+        setRoofline(engine->getRoofline());
     } else if (instance->engine_type == "satp_higgs_2d") {
         auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine2D*>(instance->engine_handle);
         engine->getMetrics(metrics.ns_per_op, metrics.ops_per_sec, metrics.total_operations);
+        setRoofline(engine->getRoofline());
     } else if (instance->engine_type == "satp_higgs_3d") {
         auto* engine = static_cast<dase::satp_higgs::SATPHiggsEngine3D*>(instance->engine_handle);
         engine->getMetrics(metrics.ns_per_op, metrics.ops_per_sec, metrics.total_operations);
+        setRoofline(engine->getRoofline());
     } else if (instance->engine_type == "fftw_cache_example") {
         auto* engine = static_cast<FFTWCacheExampleEngine*>(instance->engine_handle);
         engine->getMetrics(metrics.ns_per_op, metrics.ops_per_sec, metrics.total_operations);
@@ -2146,6 +5362,40 @@ bool EngineManager::sidCollapse(const std::string& engine_id, double alpha) {
     return true;
 }
 
+bool EngineManager::sidBatchRun(const std::vector<std::string>& engine_ids,
+                                bool step, bool collapse, double alpha, uint64_t steps,
+                                std::vector<SidBatchEntry>& results_out,
+                                std::string& error_out) {
+    results_out.clear();
+    std::vector<sid_engine*> handles;
+    handles.reserve(engine_ids.size());
+    for (const auto& engine_id : engine_ids) {
+        auto* instance = getEngine(engine_id);
+        if (!instance || !instance->engine_handle) {
+            error_out = "Engine not found: " + engine_id;
+            return false;
+        }
+        if (instance->engine_type != "sid_ternary") {
+            error_out = "Engine is not sid_ternary: " + engine_id;
+            return false;
+        }
+        handles.push_back(static_cast<sid_engine*>(instance->engine_handle));
+    }
+
+    const uint32_t ops = (step ? SID_BATCH_STEP : 0u) | (collapse ? SID_BATCH_COLLAPSE : 0u);
+    std::vector<sid_batch_result> results(handles.size());
+    if (!sid_batch_run(handles.data(), handles.size(), ops, alpha, steps, 1e-6, results.data())) {
+        error_out = "Engine listed more than once";
+        return false;
+    }
+    results_out.reserve(results.size());
+    for (const auto& r : results) {
+        results_out.push_back(SidBatchEntry{r.I_mass, r.N_mass, r.U_mass, r.instantaneous_gain,
+                                            r.step_count, r.is_conserved});
+    }
+    return true;
+}
+
 bool EngineManager::sidApplyRewrite(const std::string& engine_id,
                                     const std::string& pattern,
                                     const std::string& replacement,
@@ -2174,6 +5424,97 @@ bool EngineManager::sidApplyRewrite(const std::string& engine_id,
     return true;
 }
 
+bool EngineManager::sidCompileRule(const std::string& engine_id,
+                                   const std::string& pattern,
+                                   const std::string& replacement,
+                                   const std::string& rule_id,
+                                   int64_t& handle_out,
+                                   std::string& message_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    if (instance->engine_type != "sid_ternary") {
+        return false;
+    }
+
+    auto* engine = static_cast<sid_engine*>(instance->engine_handle);
+    handle_out = sid_compile_rule(engine, pattern.c_str(), replacement.c_str(), rule_id.c_str());
+    if (handle_out < 0) {
+        const char* message = sid_last_rewrite_message(engine);
+        message_out = message ? message : "";
+        return false;
+    }
+    return true;
+}
+
+bool EngineManager::sidApplyCompiledRule(const std::string& engine_id,
+                                         int64_t rule_handle,
+                                         bool& applied_out,
+                                         std::string& message_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    if (instance->engine_type != "sid_ternary") {
+        return false;
+    }
+
+    auto* engine = static_cast<sid_engine*>(instance->engine_handle);
+    applied_out = sid_apply_compiled_rule(engine, rule_handle);
+
+    const char* message = sid_last_rewrite_message(engine);
+    message_out = message ? message : "";
+    return true;
+}
+
+bool EngineManager::sidRunFixpoint(const std::string& engine_id,
+                                   const std::string& strategy,
+                                   const std::vector<int64_t>& rule_handles,
+                                   const std::string& policy,
+                                   uint64_t horizon_cap,
+                                   uint64_t seed,
+                                   std::vector<size_t>& trace_out,
+                                   bool& horizon_hit_out,
+                                   std::string& message_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle) {
+        return false;
+    }
+    if (instance->engine_type != "sid_ternary") {
+        return false;
+    }
+
+    auto* engine = static_cast<sid_engine*>(instance->engine_handle);
+    // One trace entry per rewrite: horizon_cap bounds it (kept to a sane size)
+    constexpr uint64_t kMaxTrace = 1u << 20;
+    std::vector<uint64_t> trace(static_cast<size_t>(std::min(horizon_cap, kMaxTrace)));
+    int64_t steps = -1;
+    if (strategy == "worklist") {
+        steps = sid_run_fixpoint(engine, rule_handles.data(), rule_handles.size(),
+                                 policy.c_str(), horizon_cap, seed,
+                                 trace.data(), trace.size(), &horizon_hit_out);
+    } else if (strategy == "parallel" || strategy == "parallel_batch") {
+        steps = sid_run_parallel_rewrites(engine, rule_handles.data(), rule_handles.size(),
+                                          policy.c_str(), horizon_cap, seed, strategy == "parallel_batch",
+                                          trace.data(), trace.size(), &horizon_hit_out);
+    } else if (strategy == "network") {
+        steps = sid_run_network_rewrites(engine, rule_handles.data(), rule_handles.size(),
+                                         policy.c_str(), horizon_cap, seed,
+                                         trace.data(), trace.size(), &horizon_hit_out);
+    } else {
+        return false;
+    }
+    const char* message = sid_last_rewrite_message(engine);
+    message_out = message ? message : "";
+    if (steps < 0) {
+        return false;
+    }
+    trace_out.assign(trace.begin(), trace.begin() + static_cast<ptrdiff_t>(
+        std::min(static_cast<size_t>(steps), trace.size())));
+    return true;
+}
+
 bool EngineManager::sidSetDiagramExpr(const std::string& engine_id,
                                       const std::string& expr,
                                       const std::string& rule_id,
@@ -2245,6 +5586,15 @@ bool EngineManager::sidGetDiagramJson(const std::string& engine_id,
     return false;
 }
 
+bool EngineManager::sidDiagramHash(const std::string& engine_id, uint64_t& hash_out) {
+    auto* instance = getEngine(engine_id);
+    if (!instance || !instance->engine_handle || instance->engine_type != "sid_ternary") {
+        return false;
+    }
+    hash_out = sid_diagram_hash(static_cast<sid_engine*>(instance->engine_handle));
+    return true;
+}
+
 void EngineManager::recordSidRewriteEvent(const std::string& engine_id,
                                           const std::string& rule_id,
                                           bool applied,
@@ -2254,34 +5604,39 @@ void EngineManager::recordSidRewriteEvent(const std::string& engine_id,
     if (it == engines.end()) {
         return;
     }
-    auto& vec = sid_rewrite_events_[engine_id];
-    SidRewriteEvent ev{};
-    ev.event_id = static_cast<uint64_t>(vec.size());
-    ev.rule_id = rule_id;
-    ev.applied = applied;
-    ev.message = message;
-    ev.metadata = metadata;
-    ev.timestamp = getCurrentTimestamp();
-    vec.push_back(ev);
+    sid_rewrite_events_[engine_id].record(rule_id, applied, message, metadata, getCurrentTimestamp());
 }
 
 bool EngineManager::getSidRewriteEvents(const std::string& engine_id,
-                                        size_t cursor,
+                                        uint64_t cursor,
                                         size_t limit,
-                                        std::vector<SidRewriteEvent>& events_out) {
+                                        std::vector<SidRewriteEvent>& events_out,
+                                        uint64_t& next_cursor_out,
+                                        nlohmann::json& log_out) {
     auto it = sid_rewrite_events_.find(engine_id);
     if (it == sid_rewrite_events_.end()) {
         return false;
     }
-    const auto& vec = it->second;
-    if (cursor > vec.size()) {
-        cursor = vec.size();
+    next_cursor_out = it->second.page(cursor, limit, events_out);
+    log_out = it->second.optionsJson();
+    return true;
+}
+
+bool EngineManager::configureSidRewriteLog(const std::string& engine_id,
+                                           const nlohmann::json& params,
+                                           nlohmann::json& log_out,
+                                           std::string& error_out) {
+    error_out.clear();
+    auto it = sid_rewrite_events_.find(engine_id);
+    if (it == sid_rewrite_events_.end()) {
+        return false;
     }
-    size_t end = vec.size();
-    if (limit > 0 && cursor + limit < end) {
-        end = cursor + limit;
+    dase::SidEventLog::Options options = it->second.options();
+    if (!dase::SidEventLog::parseOptions(params, options, error_out)) {
+        return false;
     }
-    events_out.assign(vec.begin() + static_cast<ptrdiff_t>(cursor), vec.begin() + static_cast<ptrdiff_t>(end));
+    it->second.configure(options);
+    log_out = it->second.optionsJson();
     return true;
 }
 
@@ -2306,8 +5661,10 @@ bool EngineManager::sidWrapperApplyMotion(const std::string& engine_id,
     auto& wrapper = state_it->second;
     const auto& events = events_it->second;
 
-    size_t start = wrapper.event_cursor;
-    size_t end = events.size();
+    // event_cursor is the next event ID; events the log already dropped
+    // are skipped
+    uint64_t start = std::max<uint64_t>(wrapper.event_cursor, events.firstId());
+    uint64_t end = events.nextId();
     if (max_events_to_process > 0 && start + max_events_to_process < end) {
         end = start + max_events_to_process;
     }
@@ -2334,9 +5691,9 @@ bool EngineManager::sidWrapperApplyMotion(const std::string& engine_id,
         wrapper.last_motion = {{"rule_id", rule_id}, {"applied", true}, {"reason", "applied"}};
     };
 
-    for (size_t idx = start; idx < end; ++idx) {
-        const auto& ev = events[idx];
-        wrapper.event_cursor = idx + 1;
+    for (uint64_t idx = start; idx < end; ++idx) {
+        const auto ev = events.at(idx);
+        wrapper.event_cursor = static_cast<size_t>(idx + 1);
 
         bool semantic_motion = false;
         double epsilon = 0.0;
@@ -2,22 +2,47 @@
  * Engine Manager - Manages lifecycle of DASE engines
  * Handles both Phase 4B (real) and IGSOA Complex (complex) engines
  *
- * @warning SINGLE-THREADED ONLY
- * This class is designed for single-threaded CLI use only.
- * All operations assume sequential command execution from stdin.
- * No thread safety mechanisms are implemented.
- * DO NOT use from multiple threads - undefined behavior will occur.
+ * @warning MOSTLY SINGLE-THREADED
+ * Commands run sequentially on the CLI thread.  The one exception is
+ * runMission, which JobManager workers call for submitted missions; the
+ * caller must hold that engine's JobManager lock, and the engine registry
+ * (engines, state exports) is guarded so other engines can be created,
+ * destroyed or mapped meanwhile.  Registry writes happen on the CLI thread
+ * only.  Everything else must stay on the CLI thread.
  */
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <atomic>
+#include <shared_mutex>
 #include <unordered_map>
 #include "json.hpp"
+#include "../../src/cpp/numa_placement.h"
+#include "../../src/cpp/adaptive_timestep.h"
+#include "../../src/cpp/energy_meter.h"
+#include "../../src/cpp/engine_memory.h"
+#include "../../src/cpp/gpu_device.h"
+#include "../../src/cpp/igsoa_burn_in.h"
+#include "../../src/cpp/igsoa_kernel_policy.h"
+#include "../../src/cpp/kernel_autotuner.h"
+#include "../../src/cpp/observable_recorder.h"
+#include "../../src/cpp/probe_recorder.h"
+#include "../../src/cpp/thread_budget.h"
+#include "engine_pipeline.h"
+#include "extraction_buffers.h"
+#include "snapshot_buffer.h"
+#include "snapshot_stream.h"
+#include "state_export.h"
+#include "typed_array_input.h"
+#include "metric_emitter.h"
+#include "spectral_monitor.h"
+#include "sid_event_log.h"
 
 // Engine instance wrapper
 struct EngineInstance {
@@ -27,6 +52,7 @@ struct EngineInstance {
         IgsoaComplex,
         IgsoaComplex2D,
         IgsoaComplex3D,
+        IgsoaEnsemble1D,
         IgsoaGW,
         SatpHiggs1D,
         SatpHiggs2D,
@@ -45,12 +71,23 @@ struct EngineInstance {
     int dimension_y;
     int dimension_z;
     int sid_role;
+    int num_replicas;         // igsoa_ensemble_1d replicas (1 otherwise)
     double R_c;
     double kappa;
     double gamma;
     double dt;
     double alpha;
     TypeTag type_tag;
+    dase::AdaptiveStepStats adaptive;  // Totals of run_mission_adaptive
+    NumaOptions numa;                  // Placement it was created with (pool key)
+    uint64_t admitted_bytes;           // Estimate charged against the memory budget
+    int thread_limit;                  // Most threads per mission block (0 = team width)
+    std::vector<int> thread_cpus;      // CPUs its mission teams are pinned to (empty = none)
+    std::shared_ptr<EnergyMeter> energy_meter;   // Set by enableEnergyMeter
+    EnergySample last_energy;          // Energy of the last runMission call
+    int last_energy_steps;             // Steps that call ran
+    dase::ExtractionBuffers extraction;   // Whole-state scratch, reused (extractAllNodeStates)
+    dase::igsoa::IGSOABurnInOptions burn_in;  // create_engine burn-in for the first run_mission (steps 0 = none)
 
     EngineInstance()
         : engine_handle(nullptr)
@@ -60,14 +97,45 @@ struct EngineInstance {
         , dimension_y(0)
         , dimension_z(0)
         , sid_role(2)
+        , num_replicas(1)
         , R_c(1.0)
         , kappa(1.0)
         , gamma(0.1)
         , dt(0.01)
         , alpha(0.1)
-        , type_tag(TypeTag::Unknown) {}
+        , type_tag(TypeTag::Unknown)
+        , admitted_bytes(0)
+        , thread_limit(0)
+        , last_energy_steps(0) {}
 };
 
+// Stop conditions and progress of one mission (run_mission, run_steps,
+// job chunks).  The mission runs in blocks sized from the measured step
+// time (about kMissionBlockMs each, fewer steps near the end of a budget)
+// and checks the budget and the cancel flags between blocks, so a stop
+// lands within about one block.  Observable triggers stop the engine's own
+// step loop, so a trigger stop lands exactly on the firing step.
+struct MissionTriggerEvent {
+    dase::TriggerEvent event;
+    std::string snapshot_path;                   // Snapshot action: checkpoint written
+    std::string error;                           // Snapshot action: why it failed
+};
+
+struct MissionControl {
+    double time_budget_ms = 0.0;                 // Wall-clock limit (0: none)
+    const std::atomic<bool>* cancel = nullptr;   // Caller's cancel token
+
+    // Out
+    int steps_completed = 0;
+    double wall_ms = 0.0;
+    const char* stop_reason = "completed";       // "completed", "time_budget", "cancelled" or "trigger"
+    std::vector<MissionTriggerEvent> trigger_events;   // Fired triggers, oldest first
+    uint64_t trigger_events_dropped = 0;
+    double drive_gain = 1.0;                     // Drive gain at the end of the mission
+};
+
+constexpr double kMissionBlockMs = 10.0;
+
 class EngineManager {
 public:
     EngineManager();
@@ -85,7 +153,10 @@ public:
                              int N_y = 0,
                              int N_z = 0,
                              int sid_role = 2,
-                             const std::string& engine_id_hint = "");
+                             const std::string& engine_id_hint = "",
+                             const NumaOptions& numa = NumaOptions(),
+                             int num_replicas = 1,
+                             nlohmann::json* admission_error = nullptr);
     bool destroyEngine(const std::string& engine_id);
     EngineInstance* getEngine(const std::string& engine_id);
     const EngineInstance* getEngineConst(const std::string& engine_id) const;
@@ -96,7 +167,42 @@ public:
     // Engine operations (Phase 4B)
     bool setNodeState(const std::string& engine_id, int node_index, double value, const std::string& field = "phi");
     double getNodeState(const std::string& engine_id, int node_index, const std::string& field = "phi");
-    bool runMission(const std::string& engine_id, int num_steps, int iterations_per_node);
+    // first_step offsets the drive signals, so running [0, a) then [a, b)
+    // matches one mission of b steps.  With `control`, the mission may stop
+    // early on its budget or a cancel (still returning true); the steps
+    // actually run are in control->steps_completed.
+    bool runMission(const std::string& engine_id, int num_steps, int iterations_per_node, int first_step = 0,
+                    MissionControl* control = nullptr);
+
+    // Ask the controlled mission running on the engine to stop after its
+    // current block (thread-safe); false if none is running
+    bool cancelMission(const std::string& engine_id);
+
+    // Simulated time reached by IGSOA, SATP+Higgs and GW engines; false for
+    // engine types that do not track one
+    bool getSimulatedTime(const std::string& engine_id, double& time_out);
+
+    // Advance an IGSOA or SATP engine by `duration` of simulated time with
+    // adaptive dt (step-doubling error control for IGSOA, CFL control for
+    // SATP).  drive applies run_mission's sin/cos drive to IGSOA engines,
+    // one sample per configured dt of simulated time.  The run's stats are
+    // returned and added to the engine's totals.
+    bool runMissionAdaptive(const std::string& engine_id,
+                            double duration,
+                            const dase::AdaptiveStepOptions& options,
+                            bool drive,
+                            dase::AdaptiveStepStats& stats_out,
+                            std::string& error_out);
+
+    // Run the missions of several phase4b engines as one batched job
+    // (dase_run_ensemble).  input_signals / control_patterns hold one
+    // num_steps array per engine, or are empty for run_mission's drive.
+    bool runEnsemble(const std::vector<std::string>& engine_ids,
+                     int num_steps,
+                     int iterations_per_node,
+                     const std::vector<std::vector<double>>& input_signals,
+                     const std::vector<std::vector<double>>& control_patterns,
+                     std::string& error_out);
 
     // Engine operations (IGSOA Complex)
     bool setNodePsi(const std::string& engine_id, int node_index, double real, double imag);
@@ -115,6 +221,193 @@ public:
                       std::vector<double>& h_out,
                       std::vector<double>& h_dot_out);
 
+    // Lattice shape of an engine's state arrays (N_x, N_y, N_z; num_nodes
+    // x 1 x 1 when the dimensions do not cover the node count)
+    bool getStateDims(const std::string& engine_id, size_t dims[3]) const;
+
+    // The fields / nodes of `selection` (parsed against getStateDims and
+    // the engine family's fields), one vector per selection.fields() entry.
+    // IGSOA and SATP+Higgs nodes are read in place, so only the selected
+    // values are copied; other engine types are copied whole and selected.
+    // Output fields without capacity are leased from bufferPool(); hand
+    // them back (RequestArena, recycleSegments) to keep polling allocation-free.
+    bool getSelectedState(const std::string& engine_id,
+                          const dase::SnapshotSelection& selection,
+                          std::vector<std::vector<double>>& fields_out);
+
+    // getAllNodeStates / getSatpState into the engine's own ExtractionBuffers,
+    // which keep their capacity from call to call.  The buffers stay valid
+    // until the next extraction from, or destruction of, that engine
+    // (callers hold its lock); nullptr on failure.
+    const dase::ExtractionBuffers* extractAllNodeStates(const std::string& engine_id);
+    const dase::ExtractionBuffers* extractSatpState(const std::string& engine_id);
+
+    // Recycled state-array vectors shared by every engine (extraction_buffers.h)
+    dase::BufferPool& bufferPool() { return buffer_pool_; }
+
+    // The phase4b library's state digest (dase_get_state_digest); other
+    // engine types are digested from getSelectedState by the router
+    bool getPhase4bStateDigest(const std::string& engine_id,
+                               double tolerance,
+                               uint64_t& digest_out,
+                               std::string& error_out);
+
+    // Zero-copy variants: gather straight into caller buffers of `capacity`
+    // values each (a shared-memory state export); fails if the engine has
+    // more nodes than that
+    bool gatherAllNodeStates(const std::string& engine_id,
+                             double* psi_real,
+                             double* psi_imag,
+                             double* phi,
+                             size_t capacity);
+    bool gatherSatpState(const std::string& engine_id,
+                         double* phi_out,
+                         double* phi_dot_out,
+                         double* h_out,
+                         double* h_dot_out,
+                         size_t capacity);
+
+    // Shared-memory state export (map_state): publish the engine's state
+    // arrays into a named segment now and after every publish_interval
+    // steps of runMission (0 = only on publishState)
+    bool mapState(const std::string& engine_id,
+                  const std::string& segment_name,
+                  int publish_interval,
+                  nlohmann::json& layout_out,
+                  std::string& error_out);
+    bool unmapState(const std::string& engine_id);
+    bool publishState(const std::string& engine_id);
+
+    // Lock-free snapshots (buffer_state, snapshot_buffer.h): publish the
+    // selected fields into a pool of `frames` preallocated frames now and
+    // after every publish_interval steps of runMission, skipping a
+    // publication while readers hold every other frame.  Readers lease the
+    // latest frame through snapshotBuffer() without the engine's lock;
+    // holding the pointer keeps the buffer alive past unbufferState.
+    bool bufferState(const std::string& engine_id,
+                     const dase::SnapshotSelection& selection,
+                     size_t frames,
+                     int publish_interval,
+                     nlohmann::json& info_out,
+                     std::string& error_out);
+    bool unbufferState(const std::string& engine_id);
+    std::shared_ptr<dase::SnapshotBuffer> snapshotBuffer(const std::string& engine_id) const;
+
+    // Sampled metric stream (subscribe_metrics): while subscribed, runMission
+    // records the named metrics (getMetrics fields plus "step") at every
+    // options.every_steps steps and hands them to the sink in batches.
+    // sink is "stdout", "binary" (target = file path) or "shm" (target =
+    // segment name).  Unknown metric names are rejected.
+    bool subscribeMetrics(const std::string& engine_id,
+                          const std::vector<std::string>& names,
+                          const dase::MetricEmitterOptions& options,
+                          const std::string& sink,
+                          const std::string& target,
+                          nlohmann::json& info_out,
+                          std::string& error_out);
+    // Flushes what is buffered, then drops the subscription
+    bool unsubscribeMetrics(const std::string& engine_id);
+
+    // Bytes of the engine's state arrays (its checkpoint sections, so
+    // scratch buffers are not counted); 0 for phase4b and unknown engines
+    uint64_t stateBytes(const std::string& engine_id);
+
+    // Binary checkpoint (engine_checkpoint.h): the engine's state sections
+    // plus a "config" section holding the instance parameters (and SID
+    // wrapper state / rewrite events).  Compiled SID rules, SATP sources
+    // and NUMA placement are not saved.
+    bool checkpointEngine(const std::string& engine_id,
+                          const std::string& path,
+                          nlohmann::json& info_out,
+                          std::string& error_out);
+    // Restore into engine_id if it exists (same type and shape), otherwise
+    // create an engine from the checkpoint's config (engine_id as the id
+    // hint; empty = generated).  A newly created engine is destroyed again
+    // if its state is rejected.
+    bool restoreEngine(const std::string& path,
+                       const std::string& engine_id,
+                       nlohmann::json& info_out,
+                       std::string& error_out);
+    // `count` new engines of engine_id's type and shape holding its complete
+    // state (history buffers and SID diagrams included, as in a checkpoint),
+    // copied through one in-memory checkpoint image.  Every clone is
+    // destroyed again if any copy fails.
+    bool cloneEngine(const std::string& engine_id,
+                     int count,
+                     std::vector<std::string>& clone_ids_out,
+                     nlohmann::json& info_out,
+                     std::string& error_out);
+
+    // Reinitialize engine_id in place as a new engine of its type and shape
+    // with these scalar parameters: node state, clock, counters and adaptive
+    // totals cleared; allocations, placement, device, sparse settings,
+    // sources, probes and subscriptions kept.  igsoa_gw keeps its dt (its
+    // solver kernels are built for it); SID, ensemble and fftw engines
+    // cannot be reset.
+    bool resetEngine(const std::string& engine_id,
+                     double R_c,
+                     double kappa,
+                     double gamma,
+                     double dt,
+                     double alpha,
+                     std::string& error_out);
+
+    // Idle engine pool.  With max_idle > 0, destroyEngine parks up to
+    // max_idle engines per (type, shape, placement) instead of freeing them,
+    // after dropping their probes, sources, device and sparse settings, and
+    // createEngine hands a parked engine of the requested shape back, reset
+    // in place (resetEngine), instead of allocating and building one.
+    // 0 frees every parked engine and turns pooling off.
+    void setEnginePool(size_t max_idle);
+    // {"max_idle", "idle", "hits", "misses"}
+    nlohmann::json enginePoolStats() const;
+
+    // Process-wide memory budget (0 = unlimited).  createEngine charges each
+    // new engine its estimateMemory() total and refuses one that would take
+    // the live and parked engines past the budget, filling admission_error
+    // with {"requested_bytes", "in_use_bytes", "budget_bytes", "breakdown"}.
+    // A parked engine handed back by the pool is already charged.
+    void setMemoryBudget(uint64_t bytes);
+    uint64_t getMemoryBudget() const { return memory_budget_.load(); }
+    // Sum of the estimates charged for live and parked engines
+    uint64_t getAdmittedBytes() const;
+
+    // Process thread budget (thread_budget.h): every mission block, adaptive
+    // mission and ensemble leases its threads from one pool of `threads`
+    // tokens (0 = the processor count), so engines stepping at the same time
+    // share the cores.  The phase4b library's own budget is set to match.
+    void setThreadBudget(int threads);
+    // {"capacity", "in_use", "holders", "peak", "leases", "reduced"}
+    nlohmann::json threadBudgetStats() const;
+    // Most threads the engine's missions lease (0 = team width) and the CPUs
+    // their teams are pinned to (empty = no pinning; Linux only); false if
+    // not found
+    bool setThreadLimit(const std::string& engine_id, int threads, const std::vector<int>& cpus);
+
+    // Load the phase4b engine library on first call (thread-safe, tried
+    // once per process); false if no build could be loaded
+    static bool ensureEngineLibrary();
+
+    // Path of the loaded phase4b engine library ("" if none loaded)
+    static std::string getEngineLibraryPath();
+
+    // Footprint an engine createEngine would build would hold once it has
+    // stepped (engine defaults: direct coupling, Euler, double precision).
+    // False for phase4b, whose storage lives in the DLL, and unknown types.
+    static bool estimateEngineMemory(const std::string& engine_type,
+                                     int num_nodes,
+                                     double R_c,
+                                     int N_x,
+                                     int N_y,
+                                     int N_z,
+                                     int num_replicas,
+                                     dase::MemoryFootprint& out);
+
+    // Measured footprint of an engine; the caller holds its JobManager
+    // lock.  False if not found; `tracked` is false for phase4b (nothing
+    // measured) and SID engines report their fields only.
+    bool engineMemory(const std::string& engine_id, dase::MemoryFootprint& out, bool& tracked);
+
     // Bulk state initialization (for IGSOA engines)
     bool setIgsoaState(const std::string& engine_id,
                        const std::string& profile_type,
@@ -125,6 +418,15 @@ public:
                       const std::string& profile_type,
                       const nlohmann::json& params);
 
+    // Overwrite whole fields of an IGSOA or SATP+Higgs engine from typed
+    // arrays of num_nodes values, decoded straight into the nodes; fields
+    // not named keep their values.  False with `error` set for another
+    // engine type, a field outside the family or a wrong length.
+    bool setStateArrays(const std::string& engine_id,
+                        const std::vector<std::string>& fields,
+                        const std::vector<dase::TypedArray>& values,
+                        std::string& error);
+
     // 2D analysis helpers
     bool computeCenterOfMass2D(const std::string& engine_id,
                                double& x_cm_out,
@@ -140,10 +442,214 @@ public:
         double ops_per_sec;
         uint64_t total_operations;
         double speedup_factor;
+
+        // Hardware counters of the last mission (phase4b engines with
+        // enableHardwareCounters); the rest are zero when invalid
+        bool hw_counters_valid;
+        uint64_t hw_cycles;
+        uint64_t hw_instructions;
+        uint64_t hw_llc_misses;
+        double hw_ipc;
+        double hw_dram_bandwidth_gbps;
+
+        // Modelled bytes / FLOPs per step and the rates of the last mission
+        // (IGSOA and SATP engines, see kernel_traffic.h); zero when invalid
+        bool roofline_valid;
+        double model_bytes_per_step;
+        double model_flops_per_step;
+        double arithmetic_intensity;
+        double achieved_gbps;
+        double achieved_gflops;
+
+        // Totals of run_mission_adaptive (all zero before the first run)
+        dase::AdaptiveStepStats adaptive;
+
+        // Share of node updates the last mission skipped (igsoa_complex_2d /
+        // igsoa_complex_3d with setSparseEvolution)
+        bool sparse_valid;
+        double sparse_skipped_fraction;
+
+        // Page size backing the engine state (phase4b and igsoa_complex
+        // engines, see NumaOptions::huge_pages); 0 when unknown
+        uint64_t page_size_bytes;
+
+        // Package energy of the last runMission call (enableEnergyMeter);
+        // the rest are zero when invalid
+        bool energy_valid;
+        const char* energy_source;     // "rapl" / "emi"
+        double energy_joules;
+        double energy_seconds;
+        double energy_average_watts;
+        double energy_joules_per_step;
+        double energy_joules_per_node_update;
     };
 
     EngineMetrics getMetrics(const std::string& engine_id);
 
+    // Collect hardware counters around the missions of a phase4b engine
+    // @return whether they are now collected
+    bool enableHardwareCounters(const std::string& engine_id, bool enable);
+
+    // Measure package energy (RAPL / EMI, energy_meter.h) around the
+    // missions of any engine
+    // @return whether it is now measured (false without readable counters)
+    bool enableEnergyMeter(const std::string& engine_id, bool enable);
+
+    // Move an igsoa_complex_3d / satp_higgs_3d engine to the device or back
+    // @return false for other engines, or GPU without a device backend
+    bool setComputeDevice(const std::string& engine_id, ComputeDevice device);
+
+    // Kernel autotuning (kernel_autotuner.h) of a newly created igsoa_complex*
+    // or satp_higgs_* engine: the tuning database's choice of kernel variant
+    // (IGSOA 2D/3D coupling mode, SATP 3D stencil layout), temporal block and
+    // thread limit for the engine's type, shape, R_c and host, or with
+    // `force` (or nothing stored) the fastest candidate by a timed mission
+    // of `steps` steps each, stored for later engines.  Candidates run on
+    // the engine itself, which is then reset (resetEngine), so only call
+    // this before it has state worth keeping.  info_out holds the choice,
+    // "measured" and the database "key".
+    // @return false for other engine types, GPU engines or a failed reset
+    bool autotuneEngine(const std::string& engine_id,
+                        bool force,
+                        int steps,
+                        nlohmann::json& info_out,
+                        std::string& error_out);
+
+    // Advance `engine_ids` in lockstep for num_steps steps, exchanging the
+    // links' fields (engine_pipeline.h) every exchange_interval steps.
+    // Links are validated (engines listed, field of the source's family,
+    // source targets SATP+Higgs, drive targets igsoa_complex* / phase4b,
+    // one source per target and one drive per channel) before any step.
+    // Unlinked drive channels get run_mission's sin / cos drive.  Pipeline
+    // steps bypass state exports, snapshot buffers, metric subscriptions
+    // and observable triggers; source links replace the target's source
+    // for the run and clear it afterwards.
+    // info_out: steps, exchanges, wall_ms and each link's last value.
+    bool runPipeline(const std::vector<std::string>& engine_ids,
+                     std::vector<dase::PipelineLink>& links,
+                     int num_steps,
+                     int exchange_interval,
+                     int iterations_per_node,
+                     nlohmann::json& info_out,
+                     std::string& error_out);
+
+    // Activity-mask sparse evolution of an igsoa_complex_2d / 3d engine
+    // (threshold 0 = dense)
+    // @return false for other engines or invalid settings
+    bool setSparseEvolution(const std::string& engine_id, double threshold, uint32_t block);
+
+    // Coupling law of an igsoa_complex / igsoa_complex_2d / igsoa_complex_3d
+    // engine (igsoa_kernel_policy.h)
+    // @return false for other engines
+    bool setKernelPolicy(const std::string& engine_id, dase::igsoa::IGSOAKernelPolicy policy);
+
+    // Coarse-to-fine burn-in of an igsoa_complex_2d / igsoa_complex_3d
+    // engine (igsoa_burn_in.h), driven as run_mission drives steps
+    // [first_step, first_step + options.steps)
+    // @return false for other engines or options that do not fit the lattice
+    bool runBurnIn(const std::string& engine_id, const dase::igsoa::IGSOABurnInOptions& options,
+                   int first_step, std::string& error_out);
+
+    // Burn-in kept for the engine's first run_mission (create_engine
+    // burn_in); takePendingBurnIn hands it out once
+    bool setPendingBurnIn(const std::string& engine_id, const dase::igsoa::IGSOABurnInOptions& options,
+                          std::string& error_out);
+    bool takePendingBurnIn(const std::string& engine_id, dase::igsoa::IGSOABurnInOptions& options_out);
+
+    // Block-structured mesh refinement of an igsoa_gw engine (mesh_refinement.h):
+    // `levels` patches refined by `ratio` following the binary (levels 0 =
+    // base grid only).  info_out lists each level's box, points and spacing.
+    // @return false for other engines or an invalid configuration
+    bool setGWRefinement(const std::string& engine_id, int levels, int ratio, int margin,
+                         int regrid_margin, nlohmann::json& info_out, std::string& error_out);
+
+    // Probe recorders (probe_recorder.h) of igsoa_complex / _2d / _3d and
+    // igsoa_gw engines: runMission samples the probe fields at the probe
+    // points into preallocated rings, drained in bulk.
+    // Field names a probe may record, in field-id order (empty for engines
+    // without probes)
+    std::vector<std::string> probeFields(const std::string& engine_id);
+    // Nearest grid cells of physical positions in meters (igsoa_gw detectors)
+    bool probePointsAt(const std::string& engine_id,
+                       const std::vector<std::array<double, 3>>& positions,
+                       std::vector<uint64_t>& points_out,
+                       std::string& error_out);
+    // @return probe id (> 0), or -1 with error_out set
+    int addProbe(const std::string& engine_id, const dase::ProbeSpec& spec, std::string& error_out);
+    // Pending samples, oldest first (ProbeRecorder::drain layout), and the
+    // probe's spec; false for an unknown engine or probe
+    bool drainProbe(const std::string& engine_id, int probe_id,
+                    std::vector<uint64_t>& steps_out,
+                    std::vector<double>& values_out,
+                    uint64_t& dropped_out,
+                    dase::ProbeSpec& spec_out);
+    bool removeProbe(const std::string& engine_id, int probe_id);
+    // Registered probe ids, ascending (empty for engines without probes)
+    std::vector<int> probeIds(const std::string& engine_id);
+
+    // Observable recorders (observable_recorder.h) of igsoa_complex / _2d /
+    // _3d engines: runMission reduces a field over a box of the lattice at
+    // each observable's decimation, drained as compact time series.
+    // `spec` receives its resolved boxes.
+    // @return observable id (> 0), or -1 with error_out set
+    int addObservable(const std::string& engine_id, dase::ObservableSpec& spec, std::string& error_out);
+    // Pending samples, oldest first (ObservableRecorder::drain layout), and
+    // the observable's spec with its boxes resolved; false for an unknown
+    // engine or observable
+    bool drainObservable(const std::string& engine_id, int observable_id,
+                         std::vector<uint64_t>& steps_out,
+                         std::vector<double>& values_out,
+                         uint64_t& dropped_out,
+                         dase::ObservableSpec& spec_out);
+    bool removeObservable(const std::string& engine_id, int observable_id);
+    // Registered observable ids, ascending
+    std::vector<int> observableIds(const std::string& engine_id);
+
+    // Triggers on an engine's observables (ObservableRecorder::addTrigger),
+    // evaluated as each sample is recorded.  runMission applies the fired
+    // actions where the engine stopped: Stop ends the mission, Snapshot
+    // checkpoints to `path` ("{step}" replaced by the engine step), Drive
+    // scales the sin/cos drive from the next step on; every event is
+    // reported in MissionControl::trigger_events.
+    // @return trigger id (> 0), or -1 with error_out set
+    int addTrigger(const std::string& engine_id, const dase::TriggerSpec& spec, std::string& error_out);
+    bool removeTrigger(const std::string& engine_id, int trigger_id);
+    // True if the engine has a trigger (missions then report their events)
+    bool hasTriggers(const std::string& engine_id);
+
+    // Streaming Welch spectra (spectral_monitor.h) of every point / field
+    // channel of a probe, fed by a probe tap inside runMission.  The sample
+    // interval is the probe's decimation times the engine's dt; the config's
+    // own value is ignored.  A removed probe leaves its monitors readable.
+    // @return monitor id (> 0), or -1 with error_out set
+    int addSpectralMonitor(const std::string& engine_id, int probe_id,
+                           dase::analysis::SpectralMonitorConfig config,
+                           std::string& error_out);
+    // Monitor, or nullptr, with the probe it follows and that probe's spec
+    // (channel c = field * points + point); use under the engine's lock
+    dase::analysis::SpectralMonitor* spectralMonitor(const std::string& engine_id, int monitor_id,
+                                                     int* probe_id_out = nullptr,
+                                                     dase::ProbeSpec* spec_out = nullptr);
+    bool removeSpectralMonitor(const std::string& engine_id, int monitor_id);
+
+    // Per-replica state of an igsoa_ensemble_1d engine: replicas
+    // [first_replica, first_replica + count), each field replica-major
+    // (node i of replica first_replica + r at r * num_nodes + i) and kappa /
+    // gamma one entry per replica
+    struct EnsembleState {
+        std::vector<double> psi_real;
+        std::vector<double> psi_imag;
+        std::vector<double> phi;
+        std::vector<double> kappa;
+        std::vector<double> gamma;
+    };
+    // @return false for other engines or replicas out of range
+    bool getEnsembleState(const std::string& engine_id, size_t first_replica, size_t count,
+                          EnsembleState& state_out);
+    // Empty fields are left unchanged; non-empty ones must be full length
+    bool setEnsembleState(const std::string& engine_id, size_t first_replica, size_t count,
+                          const EnsembleState& state, std::string& error_out);
+
     // SID ternary operations
     struct SidMetrics {
         double I_mass;
@@ -154,14 +660,7 @@ public:
         bool last_rewrite_applied;
         std::string last_rewrite_message;
     };
-    struct SidRewriteEvent {
-        uint64_t event_id;
-        std::string rule_id;
-        bool applied;
-        std::string message;
-        nlohmann::json metadata;
-        double timestamp;
-    };
+    using SidRewriteEvent = dase::SidEventLog::Event;
     struct SidWrapperState {
         double I_mass;
         double N_mass;
@@ -172,8 +671,25 @@ public:
         bool initialized;
     };
 
+    struct SidBatchEntry {
+        double I_mass;
+        double N_mass;
+        double U_mass;
+        double instantaneous_gain;
+        uint64_t step_count;
+        bool is_conserved;
+    };
+
     bool sidStep(const std::string& engine_id, double alpha);
     bool sidCollapse(const std::string& engine_id, double alpha);
+    // `steps` rounds of step and / or collapse on every listed sid_ternary
+    // engine, in parallel across engines (sid_batch_run), then their
+    // masses; results_out[i] is engine_ids[i].  Runs nothing (error_out
+    // says why) if an ID is unknown, not sid_ternary or repeated.
+    bool sidBatchRun(const std::vector<std::string>& engine_ids,
+                     bool step, bool collapse, double alpha, uint64_t steps,
+                     std::vector<SidBatchEntry>& results_out,
+                     std::string& error_out);
     bool sidApplyRewrite(const std::string& engine_id,
                          const std::string& pattern,
                          const std::string& replacement,
@@ -181,6 +697,30 @@ public:
                          const nlohmann::json& rule_metadata,
                          bool& applied_out,
                          std::string& message_out);
+    // Compiled rules: parse once per engine, then apply by handle
+    bool sidCompileRule(const std::string& engine_id,
+                        const std::string& pattern,
+                        const std::string& replacement,
+                        const std::string& rule_id,
+                        int64_t& handle_out,
+                        std::string& message_out);
+    bool sidApplyCompiledRule(const std::string& engine_id,
+                              int64_t rule_handle,
+                              bool& applied_out,
+                              std::string& message_out);
+    // Rewrite to a fixed point with compiled rules; strategy is "worklist"
+    // (sid_run_fixpoint), "parallel" or "parallel_batch"
+    // (sid_run_parallel_rewrites) or "network" (sid_run_network_rewrites).
+    // trace_out holds the index into rule_handles of each rewrite
+    bool sidRunFixpoint(const std::string& engine_id,
+                        const std::string& strategy,
+                        const std::vector<int64_t>& rule_handles,
+                        const std::string& policy,
+                        uint64_t horizon_cap,
+                        uint64_t seed,
+                        std::vector<size_t>& trace_out,
+                        bool& horizon_hit_out,
+                        std::string& message_out);
     bool sidSetDiagramExpr(const std::string& engine_id,
                            const std::string& expr,
                            const std::string& rule_id,
@@ -190,11 +730,24 @@ public:
                             std::string& message_out);
     bool sidGetDiagramJson(const std::string& engine_id,
                            std::string& diagram_json_out);
+    // Canonical structural hash of a sid_ternary engine's diagram
+    bool sidDiagramHash(const std::string& engine_id, uint64_t& hash_out);
     SidMetrics getSidMetrics(const std::string& engine_id);
+    // Page of the engine's rewrite event log from event ID `cursor` (see
+    // sid_event_log.h); log_out gets optionsJson() of the log
     bool getSidRewriteEvents(const std::string& engine_id,
-                             size_t cursor,
+                             uint64_t cursor,
                              size_t limit,
-                             std::vector<SidRewriteEvent>& events_out);
+                             std::vector<SidRewriteEvent>& events_out,
+                             uint64_t& next_cursor_out,
+                             nlohmann::json& log_out);
+    // Bound / filter an engine's rewrite event log: "capacity" and
+    // "applied_only" from params, others kept.  false with an empty
+    // error_out when the engine has no log.
+    bool configureSidRewriteLog(const std::string& engine_id,
+                                const nlohmann::json& params,
+                                nlohmann::json& log_out,
+                                std::string& error_out);
     bool sidWrapperApplyMotion(const std::string& engine_id,
                                size_t max_events_to_process,
                                SidWrapperState& state_out);
@@ -206,12 +759,98 @@ public:
                                const nlohmann::json& metadata);
 
 private:
+    struct StateExportBinding {
+        std::unique_ptr<dase::SharedStateExport> segment;
+        bool satp = false;          // phi/phi_dot/h/h_dot rather than psi_real/psi_imag/phi
+        int publish_interval = 0;
+        uint64_t steps = 0;         // runMission steps since map_state
+    };
+
+    struct SnapshotBinding {
+        std::shared_ptr<dase::SnapshotBuffer> buffer;
+        uint64_t steps = 0;         // runMission steps since buffer_state
+    };
+
+    struct MetricBinding {
+        std::unique_ptr<dase::MetricEmitter> emitter;
+        uint64_t steps = 0;         // runMission steps since subscribe_metrics
+    };
+
+    struct SpectralBinding {
+        std::unique_ptr<dase::analysis::SpectralMonitor> monitor;
+        int probe_id = 0;
+        dase::ProbeSpec spec;       // Of the probe when the monitor was added
+        int tap_id = 0;             // Tap on the probe feeding the monitor
+    };
+
+    // Values of `names` for the engine, in order; false on an unknown name
+    bool sampleMetrics(const std::string& engine_id,
+                       const std::vector<std::string>& names,
+                       uint64_t step,
+                       double* values_out);
+
+    // steps_run_out: num_steps, or fewer when a trigger stopped an IGSOA
+    // engine's step loop
+    // Copy the binding's selection into a free frame and publish it
+    // (false if every frame was leased or the gather failed)
+    bool publishSnapshot(const std::string& engine_id, SnapshotBinding& binding);
+
+    bool runMissionSteps(EngineInstance* instance,
+                         const double* input_signals,
+                         const double* control_patterns,
+                         int num_steps,
+                         int iterations_per_node,
+                         int& steps_run_out);
+
+    // resetEngine on a validated instance; false for types without an
+    // in-place reset
+    bool reinitializeEngine(EngineInstance* instance,
+                            double R_c,
+                            double kappa,
+                            double gamma,
+                            double dt,
+                            std::string& error_out);
+
+    // Pool key of an engine shape ("" = never pooled); igsoa_gw includes dt
+    static std::string poolKey(const std::string& engine_type, int num_nodes,
+                               int N_x, int N_y, int N_z, double dt, const NumaOptions& numa);
+    // Park a destroyed engine (false if the pool is off, full or the type is
+    // not poolable) / take one out (nullptr if none is idle)
+    bool parkEngine(std::unique_ptr<EngineInstance>& instance);
+    std::unique_ptr<EngineInstance> takePooledEngine(const std::string& key);
+    void freeEngineHandle(EngineInstance* instance);
+
     std::map<std::string, std::unique_ptr<EngineInstance>> engines;
-    std::unordered_map<std::string, std::vector<SidRewriteEvent>> sid_rewrite_events_;
+    std::unordered_map<std::string, StateExportBinding> state_exports_;
+    std::unordered_map<std::string, MetricBinding> metric_bindings_;
+    std::unordered_map<std::string, SnapshotBinding> snapshot_buffers_;
+    std::unordered_map<std::string, std::map<int, SpectralBinding>> spectral_monitors_;
+    int next_monitor_id_ = 1;
+    // Guards engines / state_exports_ / metric_bindings_ / snapshot_buffers_ / spectral_monitors_: writers (CLI thread) take it
+    // exclusively, reads from job workers shared
+    mutable std::shared_mutex registry_mutex_;
+    dase::BufferPool buffer_pool_;   // Own mutex: sessions and sweep workers share it
+    std::unordered_map<std::string, dase::SidEventLog> sid_rewrite_events_;
     std::unordered_map<std::string, SidWrapperState> sid_wrapper_state_;
-    // Simple counter for engine ID generation (single-threaded, no atomic needed)
-    int next_engine_id;
+    // Idle engines by poolKey(); own mutex, as run_sweep workers create and
+    // destroy engines concurrently
+    std::map<std::string, std::vector<std::unique_ptr<EngineInstance>>> engine_pool_;
+    size_t pool_max_idle_ = 0;
+    uint64_t pool_hits_ = 0;
+    uint64_t pool_misses_ = 0;
+    mutable std::mutex pool_mutex_;
+    // Cancel flags of the controlled missions running now, by engine
+    std::map<std::string, std::shared_ptr<std::atomic<bool>>> mission_cancel_;
+    std::mutex mission_cancel_mutex_;
+    // Counter for engine ID generation (atomic: run_sweep workers create
+    // engines concurrently)
+    std::atomic<int> next_engine_id;
     static std::atomic<bool> instance_created_;
+    // Memory admission: estimates charged for live, parked and in-flight
+    // engines (run_sweep workers create concurrently)
+    std::atomic<uint64_t> memory_budget_{0};
+    uint64_t admitted_bytes_ = 0;
+    mutable std::mutex memory_mutex_;
 
     std::string generateEngineId();
     double getCurrentTimestamp();
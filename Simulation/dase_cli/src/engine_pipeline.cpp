@@ -0,0 +1,124 @@
+/**
+ * Engine Pipeline implementation
+ */
+
+#include "engine_pipeline.h"
+#include <algorithm>
+#include <cmath>
+
+namespace dase {
+
+FieldResampler::FieldResampler(const size_t in_dims[3], const size_t out_dims[3]) {
+    for (int axis = 0; axis < 3; ++axis) {
+        in_dims_[axis] = std::max<size_t>(1, in_dims[axis]);
+        out_dims_[axis] = std::max<size_t>(1, out_dims[axis]);
+        taps_[axis] = axisTaps(in_dims_[axis], out_dims_[axis]);
+        identity_ = identity_ && in_dims_[axis] == out_dims_[axis];
+    }
+}
+
+std::vector<FieldResampler::Tap> FieldResampler::axisTaps(size_t in, size_t out) {
+    std::vector<Tap> taps(out);
+    for (size_t j = 0; j < out; ++j) {
+        Tap& tap = taps[j];
+        if (in == out) {
+            tap.lo = tap.hi = j;
+            continue;
+        }
+        // Cell centre of output j in input coordinates, clamped to the lattice
+        const double x = std::min(std::max((static_cast<double>(j) + 0.5) * static_cast<double>(in) /
+                                           static_cast<double>(out) - 0.5, 0.0),
+                                  static_cast<double>(in - 1));
+        tap.lo = static_cast<size_t>(x);
+        tap.hi = std::min(tap.lo + 1, in - 1);
+        tap.w = x - static_cast<double>(tap.lo);
+    }
+    return taps;
+}
+
+void FieldResampler::apply(const double* in, double* out) const {
+    if (identity_) {
+        std::copy(in, in + inputSize(), out);
+        return;
+    }
+    const size_t nx = in_dims_[0];
+    const size_t nxy = in_dims_[0] * in_dims_[1];
+    const int64_t planes = static_cast<int64_t>(out_dims_[2]);
+    #pragma omp parallel for schedule(static) if(outputSize() >= 65536)
+    for (int64_t z = 0; z < planes; ++z) {
+        const Tap& tz = taps_[2][static_cast<size_t>(z)];
+        for (size_t y = 0; y < out_dims_[1]; ++y) {
+            const Tap& ty = taps_[1][y];
+            const double* rows[4] = {
+                in + tz.lo * nxy + ty.lo * nx, in + tz.lo * nxy + ty.hi * nx,
+                in + tz.hi * nxy + ty.lo * nx, in + tz.hi * nxy + ty.hi * nx
+            };
+            const double weights[4] = {
+                (1.0 - tz.w) * (1.0 - ty.w), (1.0 - tz.w) * ty.w, tz.w * (1.0 - ty.w), tz.w * ty.w
+            };
+            double* row_out = out + (static_cast<size_t>(z) * out_dims_[1] + y) * out_dims_[0];
+            for (size_t x = 0; x < out_dims_[0]; ++x) {
+                const Tap& tx = taps_[0][x];
+                double value = 0.0;
+                for (int k = 0; k < 4; ++k) {
+                    value += weights[k] * ((1.0 - tx.w) * rows[k][tx.lo] + tx.w * rows[k][tx.hi]);
+                }
+                row_out[x] = value;
+            }
+        }
+    }
+}
+
+bool parsePipelineInput(const std::string& name, PipelineInput& out) {
+    if (name == "source") {
+        out = PipelineInput::Source;
+    } else if (name == "drive") {
+        out = PipelineInput::Drive;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parsePipelineReduce(const std::string& name, PipelineReduce& out) {
+    if (name == "mean") {
+        out = PipelineReduce::Mean;
+    } else if (name == "rms") {
+        out = PipelineReduce::Rms;
+    } else if (name == "max_abs") {
+        out = PipelineReduce::MaxAbs;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* pipelineReduceName(PipelineReduce reduce) {
+    switch (reduce) {
+        case PipelineReduce::Rms: return "rms";
+        case PipelineReduce::MaxAbs: return "max_abs";
+        default: return "mean";
+    }
+}
+
+double reduceField(const std::vector<double>& values, PipelineReduce reduce) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    double acc = 0.0;
+    for (double value : values) {
+        switch (reduce) {
+            case PipelineReduce::Mean: acc += value; break;
+            case PipelineReduce::Rms: acc += value * value; break;
+            case PipelineReduce::MaxAbs: acc = std::max(acc, std::fabs(value)); break;
+        }
+    }
+    const double n = static_cast<double>(values.size());
+    switch (reduce) {
+        case PipelineReduce::Mean: return acc / n;
+        case PipelineReduce::Rms: return std::sqrt(acc / n);
+        default: return acc;
+    }
+}
+
+} // namespace dase
@@ -0,0 +1,100 @@
+/**
+ * Engine Pipeline - Field exchange between engines advancing in lockstep
+ *
+ * run_pipeline couples engines inside one command instead of a get_state /
+ * set_*_state round trip through JSON per exchange.  A link connects one
+ * field of a source engine to an input of a target engine:
+ *
+ *   source  the target's SATP+Higgs source term S(t, x): the field is
+ *           resampled onto the target's lattice into a buffer the link
+ *           shares with the target's batch source, which hands it to the
+ *           stepper every force evaluation until the next exchange
+ *   drive   one channel (input = real, control = imaginary part) of the
+ *           target's per-step drive (IGSOA complex, phase4b): the field
+ *           reduced to a number (mean, rms or max_abs)
+ *
+ * both scaled by scale and shifted by offset.  Every exchange_interval
+ * steps all links are sampled first, then every engine advances the same
+ * number of steps, so a link always carries its source's state at the
+ * start of the block (a zero-order hold).
+ *
+ * FieldResampler maps a row-major lattice onto another by multilinear
+ * interpolation between cell centres, axis by axis; an axis of one cell
+ * is broadcast, so a 1D chain can drive a 2D or 3D lattice.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dase {
+
+class FieldResampler {
+public:
+    FieldResampler() = default;
+    FieldResampler(const size_t in_dims[3], const size_t out_dims[3]);
+
+    // Whether the lattices match (apply() is a copy)
+    bool isIdentity() const { return identity_; }
+    size_t inputSize() const { return in_dims_[0] * in_dims_[1] * in_dims_[2]; }
+    size_t outputSize() const { return out_dims_[0] * out_dims_[1] * out_dims_[2]; }
+
+    // out[outputSize()] from in[inputSize()]
+    void apply(const double* in, double* out) const;
+
+private:
+    // Per output index along one axis: the two input cells and the weight of the second
+    struct Tap {
+        size_t lo = 0;
+        size_t hi = 0;
+        double w = 0.0;
+    };
+
+    static std::vector<Tap> axisTaps(size_t in, size_t out);
+
+    size_t in_dims_[3] = {0, 1, 1};
+    size_t out_dims_[3] = {0, 1, 1};
+    std::vector<Tap> taps_[3];
+    bool identity_ = true;
+};
+
+enum class PipelineInput {
+    Source,     // SATP+Higgs source term
+    Drive       // Drive channel
+};
+
+enum class PipelineReduce {
+    Mean,
+    Rms,
+    MaxAbs
+};
+
+struct PipelineLink {
+    std::string from;                       // Source engine
+    std::string field;                      // Field of the source engine's family
+    std::string to;                         // Target engine
+    PipelineInput input = PipelineInput::Source;
+    bool control_channel = false;           // Drive: imaginary (control) part
+    PipelineReduce reduce = PipelineReduce::Mean;
+    double scale = 1.0;
+    double offset = 0.0;
+
+    // Filled by EngineManager::runPipeline
+    FieldResampler resampler;
+    std::shared_ptr<std::vector<double>> buffer;    // Source: shared with the target
+    double last_value = 0.0;                        // Drive: last exchanged value
+};
+
+// "source" / "drive", "mean" / "rms" / "max_abs"
+bool parsePipelineInput(const std::string& name, PipelineInput& out);
+bool parsePipelineReduce(const std::string& name, PipelineReduce& out);
+const char* pipelineReduceName(PipelineReduce reduce);
+
+// The field reduced to one value (0 for an empty field)
+double reduceField(const std::vector<double>& values, PipelineReduce reduce);
+
+} // namespace dase
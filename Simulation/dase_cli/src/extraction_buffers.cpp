@@ -0,0 +1,102 @@
+/**
+ * Extraction Buffers Implementation
+ */
+
+#include "extraction_buffers.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace dase {
+
+std::vector<double> BufferPool::acquire(size_t count) {
+    std::vector<double> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        acquired_++;
+        size_t best = free_.size();
+        size_t largest = free_.size();
+        for (size_t i = 0; i < free_.size(); ++i) {
+            const size_t capacity = free_[i].capacity();
+            if (capacity >= count && (best == free_.size() || capacity < free_[best].capacity())) {
+                best = i;
+            }
+            if (largest == free_.size() || capacity > free_[largest].capacity()) {
+                largest = i;
+            }
+        }
+        const size_t pick = best < free_.size() ? best : largest;
+        if (pick < free_.size()) {
+            if (best < free_.size()) {
+                reused_++;
+            }
+            pooled_bytes_ -= free_[pick].capacity() * sizeof(double);
+            buffer = std::move(free_[pick]);
+            free_[pick] = std::move(free_.back());
+            free_.pop_back();
+        }
+    }
+    buffer.resize(count);
+    return buffer;
+}
+
+void BufferPool::release(std::vector<double>&& buffer) {
+    const uint64_t bytes = buffer.capacity() * sizeof(double);
+    if (bytes == 0) {
+        return;
+    }
+    std::vector<double> dropped;   // Freed outside the lock
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_.size() >= max_buffers_ || pooled_bytes_ + bytes > max_bytes_) {
+        dropped_++;
+        dropped = std::move(buffer);
+        return;
+    }
+    buffer.clear();
+    pooled_bytes_ += bytes;
+    free_.push_back(std::move(buffer));
+}
+
+void BufferPool::releaseAll(std::vector<std::vector<double>>& buffers) {
+    for (auto& buffer : buffers) {
+        release(std::move(buffer));
+    }
+    buffers.clear();
+}
+
+void BufferPool::clear() {
+    std::vector<std::vector<double>> freed;
+    std::lock_guard<std::mutex> lock(mutex_);
+    freed.swap(free_);
+    pooled_bytes_ = 0;
+}
+
+nlohmann::json BufferPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {
+        {"buffers", free_.size()},
+        {"pooled_bytes", pooled_bytes_},
+        {"max_buffers", max_buffers_},
+        {"max_bytes", max_bytes_},
+        {"acquired", acquired_},
+        {"reused", reused_},
+        {"dropped", dropped_}
+    };
+}
+
+RequestArena::~RequestArena() {
+    for (size_t i = 0; i < used_; ++i) {
+        pool_.release(std::move(slots_[i]));
+    }
+    pool_.releaseAll(fields_);
+}
+
+std::vector<double>& RequestArena::take(size_t count) {
+    if (used_ == kMaxBuffers) {
+        throw std::length_error("RequestArena: more than " + std::to_string(kMaxBuffers) + " buffers");
+    }
+    slots_[used_] = pool_.acquire(count);
+    return slots_[used_++];
+}
+
+} // namespace dase
@@ -0,0 +1,103 @@
+/**
+ * Extraction Buffers - Reused storage for state arrays
+ *
+ * Reading a 1M-node lattice fills tens of megabytes of fresh vectors, and
+ * a monitor polling get_state at 20 Hz spends most of each call faulting
+ * those pages in.  Three layers keep the steady state allocation-free:
+ *
+ *   ExtractionBuffers  whole-state scratch an engine owns (EngineInstance),
+ *                      refilled in place by extractAllNodeStates /
+ *                      extractSatpState for lattice sums and for the
+ *                      engines that are copied whole before selection
+ *   BufferPool         recycled vectors behind getSelectedState: an empty
+ *                      output field is leased from the pool, and the
+ *                      transport hands each response's segments back once
+ *                      they are written (CommandRouter::recycleSegments)
+ *   RequestArena       one handler's leases, returned to the pool when the
+ *                      handler returns (fields copied into json, digests)
+ *
+ * The pool keeps at most max_buffers vectors and max_bytes of capacity;
+ * anything beyond is freed on release, so one huge request does not pin
+ * its memory for the life of the process.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+
+// An engine's whole-state scratch: psi_real, psi_imag, phi for IGSOA-style
+// engines; phi, phi_dot, h, h_dot for SATP+Higgs
+struct ExtractionBuffers {
+    std::array<std::vector<double>, 4> fields;
+};
+
+class BufferPool {
+public:
+    static constexpr size_t kDefaultMaxBuffers = 64;
+    static constexpr uint64_t kDefaultMaxBytes = 512ull * 1024 * 1024;
+
+    explicit BufferPool(size_t max_buffers = kDefaultMaxBuffers, uint64_t max_bytes = kDefaultMaxBytes)
+        : max_buffers_(max_buffers), max_bytes_(max_bytes) {}
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // A vector of `count` values (contents unspecified): the smallest
+    // pooled buffer that holds them, else the largest one, grown
+    std::vector<double> acquire(size_t count);
+
+    // Keep `buffer`'s capacity for a later acquire (freed when over the limits)
+    void release(std::vector<double>&& buffer);
+    // Release every vector of `buffers`, then clear it
+    void releaseAll(std::vector<std::vector<double>>& buffers);
+
+    void clear();
+    nlohmann::json stats() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::vector<double>> free_;
+    size_t max_buffers_;
+    uint64_t max_bytes_;
+    uint64_t pooled_bytes_ = 0;
+    uint64_t acquired_ = 0;
+    uint64_t reused_ = 0;        // Acquires served without allocating
+    uint64_t dropped_ = 0;       // Releases freed for the limits
+};
+
+// Pool leases held for one request; everything still held goes back to
+// the pool on destruction.  The slots are fixed, so the arena itself does
+// not allocate.
+class RequestArena {
+public:
+    static constexpr size_t kMaxBuffers = 8;
+
+    explicit RequestArena(BufferPool& pool) : pool_(pool) {}
+    ~RequestArena();
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    // A pooled buffer of `count` values, valid for the arena's lifetime;
+    // throws std::length_error past kMaxBuffers
+    std::vector<double>& take(size_t count);
+
+    // Field vectors (for getSelectedState) released with the arena; fields
+    // moved out meanwhile (into response segments) simply come back empty
+    std::vector<std::vector<double>>& fields() { return fields_; }
+
+private:
+    BufferPool& pool_;
+    std::array<std::vector<double>, kMaxBuffers> slots_;
+    size_t used_ = 0;
+    std::vector<std::vector<double>> fields_;
+};
+
+} // namespace dase
@@ -0,0 +1,211 @@
+/**
+ * FFT Plan Cache Implementation
+ */
+
+#include "fft_plan_cache.h"
+
+#ifdef USE_FFTW3
+
+#include "../../src/cpp/fftw_plan_registry.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <new>
+#include <string>
+
+namespace dase {
+namespace analysis {
+
+namespace {
+
+struct CacheState {
+    std::mutex mutex;   // Guards the members below; taken before the registry's locks
+    std::map<std::vector<int>, std::shared_ptr<FFTPlanCache::Entry>> entries;
+    uint64_t clock = 0;
+    bool initialized = false;
+    FFTPlanCache::Planning planning = FFTPlanCache::Planning::Auto;
+};
+
+CacheState& state() {
+    static CacheState cache;
+    return cache;
+}
+
+FFTPlanCache::Planning planningFromEnvironment() {
+    const char* value = std::getenv("DASE_FFTW_PLANNING");
+    if (value && std::strcmp(value, "measure") == 0) return FFTPlanCache::Planning::Measure;
+    if (value && std::strcmp(value, "estimate") == 0) return FFTPlanCache::Planning::Estimate;
+    return FFTPlanCache::Planning::Auto;
+}
+
+// Read DASE_FFTW_PLANNING once; cache.mutex held (wisdom and FFTW's
+// threads are set up by FFTPlanRegistry)
+void initializeLocked(CacheState& cache) {
+    if (cache.initialized) {
+        return;
+    }
+    cache.initialized = true;
+    cache.planning = planningFromEnvironment();
+}
+
+FFTPlanRegistry::Planning registryPlanning(FFTPlanCache::Planning planning) {
+    switch (planning) {
+        case FFTPlanCache::Planning::Estimate: return FFTPlanRegistry::Planning::Estimate;
+        case FFTPlanCache::Planning::Measure: return FFTPlanRegistry::Planning::Measure;
+        case FFTPlanCache::Planning::Auto:
+        default: return FFTPlanRegistry::Planning::Auto;
+    }
+}
+
+} // namespace
+
+struct FFTPlanCache::Entry {
+    std::mutex mutex;       // Held by the Lease using the buffers
+    std::vector<int> dims;
+    std::unique_ptr<RadialBins> radial_bins;
+    fftw_plan plan = nullptr;   // Owned by FFTPlanRegistry
+    double* in = nullptr;
+    fftw_complex* out = nullptr;
+    size_t in_size = 0;
+    size_t out_size = 0;
+    uint64_t last_use = 0;
+
+    ~Entry() {
+        FFTPlanRegistry::release(in);
+        FFTPlanRegistry::release(out);
+    }
+};
+
+FFTPlanCache::Lease::Lease(std::shared_ptr<Entry> entry)
+    : entry_(std::move(entry))
+    , lock_(entry_->mutex) {}
+
+FFTPlanCache::Lease::~Lease() = default;
+
+double* FFTPlanCache::Lease::input() const { return entry_->in; }
+fftw_complex* FFTPlanCache::Lease::output() const { return entry_->out; }
+size_t FFTPlanCache::Lease::inputSize() const { return entry_->in_size; }
+size_t FFTPlanCache::Lease::outputSize() const { return entry_->out_size; }
+const std::vector<int>& FFTPlanCache::Lease::dims() const { return entry_->dims; }
+
+const FFTPlanCache::RadialBins& FFTPlanCache::Lease::radialBins() {
+    if (entry_->radial_bins) {
+        return *entry_->radial_bins;
+    }
+
+    // Signed wavenumber per axis; the last axis only has 0..n/2
+    const std::vector<int>& dims = entry_->dims;
+    const size_t rank = dims.size();
+    const size_t half = static_cast<size_t>(dims.back()) / 2 + 1;
+    double max_radius_sq = 0.0;
+    for (int n : dims) {
+        max_radius_sq += static_cast<double>(n) * static_cast<double>(n);
+    }
+    const size_t num_bins = static_cast<size_t>(std::sqrt(max_radius_sq) / 2.0) + 1;
+
+    auto bins = std::make_unique<RadialBins>();
+    bins->bin.resize(entry_->out_size);
+    bins->count.assign(num_bins, 0);
+    for (size_t i = 0; i < entry_->out_size; ++i) {
+        size_t rest = i;
+        double k_sq = static_cast<double>(rest % half) * static_cast<double>(rest % half);
+        rest /= half;
+        for (size_t axis = rank - 1; axis-- > 0;) {
+            const int n = dims[axis];
+            const int c = static_cast<int>(rest % static_cast<size_t>(n));
+            rest /= static_cast<size_t>(n);
+            const double k = static_cast<double>(c > n / 2 ? c - n : c);
+            k_sq += k * k;
+        }
+        const size_t shell = (std::min)(static_cast<size_t>(std::sqrt(k_sq)), num_bins - 1);
+        bins->bin[i] = static_cast<uint32_t>(shell);
+        bins->count[shell]++;
+    }
+    entry_->radial_bins = std::move(bins);
+    return *entry_->radial_bins;
+}
+
+void FFTPlanCache::Lease::execute() {
+    // New-array execute: thread-safe, and the registry's plan may be shared
+    fftw_execute_dft_r2c(entry_->plan, entry_->in, entry_->out);
+}
+
+FFTPlanCache::Lease FFTPlanCache::acquireR2C(const std::vector<int>& dims) {
+    if (dims.empty() || dims.size() > 3 ||
+        std::any_of(dims.begin(), dims.end(), [](int n) { return n <= 0; })) {
+        throw std::runtime_error("FFT dimensions must be 1 to 3 positive extents");
+    }
+
+    CacheState& cache = state();
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        initializeLocked(cache);
+
+        auto it = cache.entries.find(dims);
+        if (it != cache.entries.end()) {
+            entry = it->second;
+        } else {
+            entry = std::make_shared<Entry>();
+            entry->dims = dims;
+            entry->in_size = 1;
+            for (int n : dims) entry->in_size *= static_cast<size_t>(n);
+            entry->out_size = entry->in_size / static_cast<size_t>(dims.back()) *
+                              (static_cast<size_t>(dims.back()) / 2 + 1);
+
+            FFTPlanKey key;
+            key.kind = FFTPlanKey::Kind::R2C;
+            key.rank = static_cast<int>(dims.size());
+            std::copy(dims.begin(), dims.end(), key.n.begin());
+            key.nthreads = FFTPlanRegistry::plannerThreads(entry->in_size);
+
+            // Registry-planned on its own arrays, so the buffers need only be
+            // fftw_malloc-aligned (alignment 0, as the key says)
+            entry->plan = FFTPlanRegistry::acquire(key, registryPlanning(cache.planning));
+            entry->in = FFTPlanRegistry::allocReal(entry->in_size);
+            entry->out = FFTPlanRegistry::allocComplex(entry->out_size);
+            if (!entry->in || !entry->out) {
+                throw std::bad_alloc();
+            }
+
+            if (cache.entries.size() >= kMaxEntries) {
+                auto oldest = std::min_element(cache.entries.begin(), cache.entries.end(),
+                    [](const auto& a, const auto& b) { return a.second->last_use < b.second->last_use; });
+                cache.entries.erase(oldest);   // Freed when its last Lease ends
+            }
+            cache.entries[dims] = entry;
+        }
+        entry->last_use = ++cache.clock;
+    }
+    return Lease(std::move(entry));
+}
+
+void FFTPlanCache::setPlanning(Planning planning) {
+    CacheState& cache = state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    initializeLocked(cache);
+    cache.planning = planning;
+}
+
+size_t FFTPlanCache::size() {
+    CacheState& cache = state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.entries.size();
+}
+
+void FFTPlanCache::clear() {
+    std::map<std::vector<int>, std::shared_ptr<Entry>> released;
+    {
+        CacheState& cache = state();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        released.swap(cache.entries);
+    }
+}
+
+} // namespace analysis
+} // namespace dase
+
+#endif // USE_FFTW3
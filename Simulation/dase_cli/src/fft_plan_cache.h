@@ -0,0 +1,96 @@
+/**
+ * FFT Plan Cache - Reused FFTW plans and buffers for EngineFFTAnalysis
+ *
+ * engine_fft used to create an FFTW_ESTIMATE plan, execute it once and
+ * destroy it, with fresh arrays, on every call; repeated spectral
+ * monitoring of one lattice was dominated by planning.  Plans now live in
+ * a process-wide cache keyed by transform dimensions, each with its own
+ * SIMD-aligned input / output buffers.  The plans themselves belong to the
+ * process-wide dase::FFTPlanRegistry (fftw_plan_registry.hpp), which
+ * serializes FFTW's planner for every component and persists wisdom:
+ *
+ *   - Planning rigor follows
+ *     DASE_FFTW_PLANNING: "auto" (default) measures once wisdom for the
+ *     shape exists on disk and estimates otherwise, "measure" always
+ *     measures, "estimate" never does.
+ *   - Transforms of at least kThreadedMinSize points plan with
+ *     fftw_plan_with_nthreads (hardware concurrency) when FFTW was built
+ *     with threads (DASE_FFTW_THREADS).
+ *   - At most kMaxEntries shapes are kept; the least recently used goes.
+ *
+ * Each entry also caches the radial shell of every output sample
+ * (RadialBins) for the spectrum's radial profile, built on first use.
+ *
+ * A Lease holds its entry's lock from acquire until destruction: fill
+ * input(), execute(), read output().
+ */
+
+#pragma once
+
+#ifdef USE_FFTW3
+
+#include <fftw3.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dase {
+namespace analysis {
+
+class FFTPlanCache {
+public:
+    static constexpr size_t kThreadedMinSize = size_t(1) << 16;
+    static constexpr size_t kMaxEntries = 16;
+
+    enum class Planning { Auto, Estimate, Measure };
+
+    // Radial shells of an r2c output array (half spectrum along the last axis)
+    struct RadialBins {
+        std::vector<uint32_t> bin;      // Per output sample: floor(|k|), k in index units
+        std::vector<size_t> count;      // Samples per shell
+    };
+
+    struct Entry;
+
+    class Lease {
+    public:
+        Lease(std::shared_ptr<Entry> entry);
+        ~Lease();
+        Lease(Lease&&) = default;
+
+        double* input() const;
+        fftw_complex* output() const;
+        size_t inputSize() const;
+        size_t outputSize() const;    // n_0 * ... * (n_last / 2 + 1)
+        const std::vector<int>& dims() const;
+        void execute();
+
+        // Shell table for this shape, built on the first call
+        const RadialBins& radialBins();
+
+    private:
+        std::shared_ptr<Entry> entry_;
+        std::unique_lock<std::mutex> lock_;
+    };
+
+    /**
+     * Plan for a real-to-complex transform of a row-major array whose
+     * extents are `dims`, slowest axis first (FFTW order; rank 1 to 3)
+     *
+     * @throws std::runtime_error if FFTW cannot plan the transform
+     */
+    static Lease acquireR2C(const std::vector<int>& dims);
+
+    // Override DASE_FFTW_PLANNING (affects shapes planned afterwards)
+    static void setPlanning(Planning planning);
+
+    static size_t size();
+    static void clear();
+};
+
+} // namespace analysis
+} // namespace dase
+
+#endif // USE_FFTW3
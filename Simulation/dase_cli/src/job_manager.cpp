@@ -0,0 +1,257 @@
+/**
+ * Job Manager Implementation
+ */
+
+#include "job_manager.h"
+#include "engine_manager.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace dase {
+
+const char* jobStateName(JobState state) {
+    switch (state) {
+        case JobState::Queued: return "queued";
+        case JobState::Running: return "running";
+        case JobState::Completed: return "completed";
+        case JobState::Failed: return "failed";
+        case JobState::Cancelled: return "cancelled";
+    }
+    return "unknown";
+}
+
+JobManager::JobManager(EngineManager* engines, size_t num_workers)
+    : engines_(engines)
+    , num_workers_(num_workers > 0 ? num_workers : std::max(1u, std::thread::hardware_concurrency())) {}
+
+JobManager::~JobManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (auto& entry : jobs_) {
+            entry.second->cancel_requested.store(true);
+        }
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+std::string JobManager::submit(const JobRequest& request) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (workers_.empty()) {
+        for (size_t i = 0; i < num_workers_; ++i) {
+            workers_.emplace_back(&JobManager::workerLoop, this);
+        }
+    }
+
+    auto job = std::make_shared<Job>();
+    job->id = "job_" + std::to_string(next_job_id_++);
+    job->request = request;
+    job->request.chunk_steps = std::max(1, request.chunk_steps);
+    job->submitted_ms = nowMs();
+    jobs_[job->id] = job;
+    queue_.push_back(job);
+    work_available_.notify_all();
+    return job->id;
+}
+
+nlohmann::json JobManager::status(const std::string& job_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(job_id);
+    return it == jobs_.end() ? nlohmann::json() : statusLocked(*it->second);
+}
+
+bool JobManager::wait(const std::string& job_id, int64_t timeout_ms, nlohmann::json& status_out) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = jobs_.find(job_id);
+    if (it == jobs_.end()) {
+        return false;
+    }
+    std::shared_ptr<Job> job = it->second;
+    auto done = [&job] { return finished(job->state); };
+    bool timed_out = false;
+    if (timeout_ms < 0) {
+        job_finished_.wait(lock, done);
+    } else {
+        timed_out = !job_finished_.wait_for(lock, std::chrono::milliseconds(timeout_ms), done);
+    }
+    status_out = statusLocked(*job);
+    status_out["timed_out"] = timed_out;
+    return true;
+}
+
+bool JobManager::cancel(const std::string& job_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = jobs_.find(job_id);
+    if (it == jobs_.end() || finished(it->second->state)) {
+        return false;
+    }
+    Job& job = *it->second;
+    job.cancel_requested.store(true);
+    if (job.state == JobState::Queued) {
+        queue_.erase(std::remove(queue_.begin(), queue_.end(), it->second), queue_.end());
+        job.state = JobState::Cancelled;
+        job.finished_ms = nowMs();
+        job_finished_.notify_all();
+    }
+    return true;
+}
+
+nlohmann::json JobManager::list() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nlohmann::json jobs = nlohmann::json::array();
+    for (const auto& entry : jobs_) {
+        jobs.push_back(statusLocked(*entry.second));
+    }
+    return jobs;
+}
+
+std::unique_lock<std::mutex> JobManager::lockEngine(const std::string& engine_id) {
+    std::mutex* engine_mutex = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(engine_locks_mutex_);
+        auto& slot = engine_locks_[engine_id];
+        if (!slot) {
+            slot = std::make_unique<std::mutex>();
+        }
+        engine_mutex = slot.get();
+    }
+    return std::unique_lock<std::mutex>(*engine_mutex);
+}
+
+void JobManager::workerLoop() {
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_available_.wait(lock, [this, &job] {
+                if (stopping_) return true;
+                job = nextRunnableLocked();
+                return job != nullptr;
+            });
+            if (stopping_) {
+                return;
+            }
+            job->state = JobState::Running;
+            job->started_ms = nowMs();
+            busy_engines_.insert(job->request.engine_id);
+        }
+
+        runJob(*job);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_engines_.erase(job->request.engine_id);
+        }
+        job_finished_.notify_all();
+        work_available_.notify_all();   // A job queued behind this engine may run now
+    }
+}
+
+void JobManager::runJob(Job& job) {
+    const JobRequest& request = job.request;
+    JobState outcome = JobState::Completed;
+    std::string error;
+
+    std::string stop_reason = "completed";
+    int done = 0;
+    while (done < request.num_steps) {
+        if (job.cancel_requested.load()) {
+            outcome = JobState::Cancelled;
+            stop_reason = "cancelled";
+            break;
+        }
+        MissionControl control;
+        control.cancel = &job.cancel_requested;
+        if (request.time_budget_ms > 0.0) {
+            control.time_budget_ms = request.time_budget_ms - (nowMs() - job.started_ms);
+            if (control.time_budget_ms <= 0.0) {
+                stop_reason = "time_budget";
+                break;
+            }
+        }
+        const int count = std::min(request.chunk_steps, request.num_steps - done);
+        bool ok;
+        {
+            auto engine_lock = lockEngine(request.engine_id);
+            ok = engines_->runMission(request.engine_id, count, request.iterations_per_node, done, &control);
+        }
+        if (!ok) {
+            outcome = JobState::Failed;
+            stop_reason = "failed";
+            error = "Mission execution failed at step " + std::to_string(done) +
+                    (engines_->getEngine(request.engine_id) ? "" : " (engine destroyed)");
+            break;
+        }
+        done += control.steps_completed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job.steps_completed = done;
+        }
+        // A Stop trigger may fire on a chunk's last step
+        if (control.steps_completed < count || std::string(control.stop_reason) == "trigger") {
+            stop_reason = control.stop_reason;
+            if (stop_reason == "cancelled") {
+                outcome = JobState::Cancelled;
+            }
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    job.state = outcome;
+    job.error = error;
+    job.stop_reason = stop_reason;
+    job.finished_ms = nowMs();
+}
+
+std::shared_ptr<JobManager::Job> JobManager::nextRunnableLocked() {
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+        if (busy_engines_.count((*it)->request.engine_id) == 0) {
+            std::shared_ptr<Job> job = *it;
+            queue_.erase(it);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+nlohmann::json JobManager::statusLocked(const Job& job) const {
+    nlohmann::json status = {
+        {"job_id", job.id},
+        {"engine_id", job.request.engine_id},
+        {"state", jobStateName(job.state)},
+        {"steps_completed", job.steps_completed},
+        {"num_steps", job.request.num_steps},
+        {"chunk_steps", job.request.chunk_steps},
+        {"cancel_requested", job.cancel_requested.load()}
+    };
+    if (job.state != JobState::Queued) {
+        const double end = finished(job.state) ? job.finished_ms : nowMs();
+        status["elapsed_ms"] = end - (job.started_ms > 0.0 ? job.started_ms : job.submitted_ms);
+    }
+    if (job.request.time_budget_ms > 0.0) {
+        status["time_budget_ms"] = job.request.time_budget_ms;
+    }
+    if (!job.stop_reason.empty()) {
+        status["stop_reason"] = job.stop_reason;
+    }
+    if (!job.error.empty()) {
+        status["error"] = job.error;
+    }
+    return status;
+}
+
+bool JobManager::finished(JobState state) {
+    return state == JobState::Completed || state == JobState::Failed || state == JobState::Cancelled;
+}
+
+double JobManager::nowMs() {
+    using namespace std::chrono;
+    return duration_cast<duration<double, std::milli>>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace dase
@@ -0,0 +1,136 @@
+/**
+ * Job Manager - Asynchronous missions on a worker pool
+ *
+ * run_mission blocks the command loop until the mission ends.  A submitted
+ * mission (submit_mission) instead runs on a worker thread, in chunks of
+ * chunk_steps steps, while the CLI keeps answering commands:
+ *
+ *   - Each engine has a lock.  A job holds its engine's lock for one chunk
+ *     at a time, and the command router holds it for any command naming
+ *     that engine, so commands on a busy engine wait at most one chunk and
+ *     commands on other engines do not wait at all.
+ *   - At most one job runs per engine; later jobs for a busy engine stay
+ *     queued (in submission order) while other engines' jobs run.
+ *   - Cancellation is cooperative: job_cancel sets a flag that the
+ *     mission checks between step blocks (MissionControl), so a running
+ *     chunk stops early.  A queued job is cancelled immediately.
+ *   - time_budget_ms bounds the job's run time; it then completes with
+ *     stop_reason "time_budget" and the steps it reached.
+ *
+ * Chunks call EngineManager::runMission with first_step, so a job drives
+ * the same signals as one run_mission of num_steps.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "json.hpp"
+
+class EngineManager;
+
+namespace dase {
+
+enum class JobState {
+    Queued,
+    Running,
+    Completed,
+    Failed,
+    Cancelled
+};
+
+const char* jobStateName(JobState state);
+
+struct JobRequest {
+    std::string engine_id;
+    int num_steps = 0;
+    int iterations_per_node = 30;
+    int chunk_steps = 1;
+    double time_budget_ms = 0.0;   // 0: run all num_steps
+};
+
+class JobManager {
+public:
+    /**
+     * @param engines Engine manager the jobs run against (must outlive this)
+     * @param num_workers Worker threads; 0 = hardware concurrency.  Workers
+     *        start with the first submission.
+     */
+    JobManager(EngineManager* engines, size_t num_workers = 0);
+
+    // Cancels every job and joins the workers
+    ~JobManager();
+
+    JobManager(const JobManager&) = delete;
+    JobManager& operator=(const JobManager&) = delete;
+
+    // Queue a mission; returns its job ID
+    std::string submit(const JobRequest& request);
+
+    // Status of one job, or null JSON for an unknown ID
+    nlohmann::json status(const std::string& job_id) const;
+
+    /**
+     * Block until the job finishes or timeout_ms elapses (negative: no
+     * timeout)
+     *
+     * @return false for an unknown ID
+     */
+    bool wait(const std::string& job_id, int64_t timeout_ms, nlohmann::json& status_out);
+
+    // Request cancellation; false for an unknown or already finished job
+    bool cancel(const std::string& job_id);
+
+    nlohmann::json list() const;
+
+    // Lock serializing all access to one engine
+    std::unique_lock<std::mutex> lockEngine(const std::string& engine_id);
+
+private:
+    struct Job {
+        std::string id;
+        JobRequest request;
+        JobState state = JobState::Queued;
+        int steps_completed = 0;
+        std::string error;
+        std::string stop_reason;   // Set once finished (MissionControl::stop_reason)
+        std::atomic<bool> cancel_requested{false};
+        double submitted_ms = 0.0;
+        double started_ms = 0.0;
+        double finished_ms = 0.0;
+    };
+
+    void workerLoop();
+    void runJob(Job& job);
+    std::shared_ptr<Job> nextRunnableLocked();
+    nlohmann::json statusLocked(const Job& job) const;
+    static bool finished(JobState state);
+    static double nowMs();
+
+    EngineManager* engines_;
+    size_t num_workers_;
+
+    mutable std::mutex mutex_;   // Guards everything below except engine_locks_
+    std::condition_variable work_available_;
+    std::condition_variable job_finished_;
+    std::map<std::string, std::shared_ptr<Job>> jobs_;
+    std::deque<std::shared_ptr<Job>> queue_;
+    std::set<std::string> busy_engines_;
+    std::vector<std::thread> workers_;
+    uint64_t next_job_id_ = 1;
+    bool stopping_ = false;
+
+    std::mutex engine_locks_mutex_;
+    std::map<std::string, std::unique_ptr<std::mutex>> engine_locks_;
+};
+
+} // namespace dase
@@ -0,0 +1,129 @@
+/**
+ * JSON Text Writer Implementation
+ */
+
+#include "json_text_writer.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace dase {
+namespace protocol {
+
+namespace {
+
+// Longest to_chars output of a double ("-2.2250738585072014e-308")
+constexpr size_t kMaxNumberChars = 32;
+
+bool isSegmentReference(const json& value) {
+    return value.is_object() && value.contains("$segment");
+}
+
+// Whether a subtree can be dumped whole (holds no segment reference)
+bool isPlain(const json& value) {
+    if (isSegmentReference(value)) {
+        return false;
+    }
+    if (value.is_object() || value.is_array()) {
+        for (const auto& element : value) {
+            if (!isPlain(element)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename Real>
+char* writeNumber(char* first, Real value, int digits) {
+    if (!std::isfinite(value)) {
+        std::memcpy(first, "null", 4);
+        return first + 4;
+    }
+    char* last = first + kMaxNumberChars;
+    const std::to_chars_result written = digits > 0
+        ? std::to_chars(first, last, value, std::chars_format::general, digits)
+        : std::to_chars(first, last, value);
+    char* end = written.ptr;
+    // Keep the value a float to readers, as dump() does ("3" -> "3.0")
+    for (char* c = first; c != end; ++c) {
+        if (*c == '.' || *c == 'e') {
+            return end;
+        }
+    }
+    *end++ = '.';
+    *end++ = '0';
+    return end;
+}
+
+} // namespace
+
+void appendNumberArray(std::string& out, const double* values, size_t count, int digits, bool float32) {
+    if (digits > 17) {
+        digits = 17;
+    }
+    const size_t start = out.size();
+    // Worst case per value: number, ".0" and the separator
+    out.resize(start + 2 + count * (kMaxNumberChars + 3));
+    char* const base = &out[0];
+    char* cursor = base + start;
+    *cursor++ = '[';
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            *cursor++ = ',';
+        }
+        cursor = float32 ? writeNumber(cursor, static_cast<float>(values[i]), digits)
+                         : writeNumber(cursor, values[i], digits);
+    }
+    *cursor++ = ']';
+    out.resize(static_cast<size_t>(cursor - base));
+}
+
+void appendJsonText(std::string& out, const json& value, const Segments& segments, int digits) {
+    if (isSegmentReference(value)) {
+        const json& index = value["$segment"];
+        if (!index.is_number_unsigned() || index.get<size_t>() >= segments.size()) {
+            out += "null";
+            return;
+        }
+        const std::vector<double>& segment = segments[index.get<size_t>()];
+        const bool float32 = value.value("precision", std::string()) == "f32";
+        appendNumberArray(out, segment.data(), segment.size(), digits, float32);
+        return;
+    }
+    if (isPlain(value)) {
+        out += value.dump();
+        return;
+    }
+    if (value.is_object()) {
+        out += '{';
+        bool first = true;
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            if (!first) out += ',';
+            first = false;
+            out += json(it.key()).dump();
+            out += ':';
+            appendJsonText(out, it.value(), segments, digits);
+        }
+        out += '}';
+        return;
+    }
+    out += '[';
+    bool first = true;
+    for (const auto& element : value) {
+        if (!first) out += ',';
+        first = false;
+        appendJsonText(out, element, segments, digits);
+    }
+    out += ']';
+}
+
+std::string dumpJsonText(const json& value, const Segments& segments, int digits) {
+    std::string out;
+    appendJsonText(out, value, segments, digits);
+    return out;
+}
+
+} // namespace protocol
+} // namespace dase
@@ -0,0 +1,53 @@
+/**
+ * JSON Text Writer - JSON-lines responses without per-element DOM nodes
+ *
+ * In the default JSON protocol, a get_state on a 1M-node engine used to
+ * copy each state array into an nlohmann array (one json node per value)
+ * and then let dump() format the values one by one.  Handlers now hand
+ * their large arrays over as segments in JSON mode too (as in the binary
+ * protocol, see binary_protocol.h), and the response is written by
+ * appendJsonText: the small envelope is dumped as before, and every
+ * segment reference in it is replaced by the JSON array of its segment,
+ * formatted with std::to_chars straight from the segment buffer.
+ *
+ * Values are written shortest round-trip by default, or with `digits`
+ * significant digits (1..17) to shrink the text.  Segments referenced with
+ * "precision": "f32" (float32-rounded selections) are written as the
+ * shortest text that round-trips the float32 value.  As with dump(), finite
+ * values always carry a '.' or an exponent and NaN / infinities become
+ * null.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "binary_protocol.h"
+
+namespace dase {
+namespace protocol {
+
+/**
+ * Append `value` as compact JSON (value.dump() text) with every segment
+ * reference written as the array of its segment
+ *
+ * A reference to a missing segment is written as null.
+ *
+ * @param digits Significant digits of segment values (0 = shortest
+ *        round-trip)
+ */
+void appendJsonText(std::string& out, const json& value, const Segments& segments, int digits = 0);
+
+// appendJsonText into a new string
+std::string dumpJsonText(const json& value, const Segments& segments, int digits = 0);
+
+/**
+ * Append `count` doubles as a JSON array
+ *
+ * @param float32 Format each value as the float32 it rounds to
+ */
+void appendNumberArray(std::string& out, const double* values, size_t count, int digits = 0,
+                       bool float32 = false);
+
+} // namespace protocol
+} // namespace dase
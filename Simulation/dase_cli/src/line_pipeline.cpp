@@ -0,0 +1,171 @@
+/**
+ * Line Pipeline implementation
+ */
+
+#include "line_pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+
+#include "../../src/cpp/trace_zones.h"
+
+namespace dase {
+
+namespace {
+
+// Blocking FIFO of at most `capacity` items; close() ends it once drained
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return items_.size() < capacity_; });
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+    }
+
+    // False once the queue is closed and empty
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+        if (items_.empty()) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    bool empty() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.empty();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+private:
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<T> items_;
+    bool closed_ = false;
+};
+
+json internalError(const std::string& what) {
+    return {
+        {"status", "error"},
+        {"error", what},
+        {"error_code", "INTERNAL_ERROR"}
+    };
+}
+
+} // namespace
+
+struct LinePipeline::Queues {
+    explicit Queues(size_t depth) : requests(depth), responses(depth) {}
+
+    BoundedQueue<PipelineRequest> requests;
+    BoundedQueue<PipelineResponse> responses;
+};
+
+LinePipeline::LinePipeline(const LinePipelineOptions& options) : options_(options) {}
+
+LinePipeline::~LinePipeline() = default;
+
+void LinePipeline::emit(std::string line) {
+    PipelineResponse response;
+    response.serialized = true;
+    response.text = std::move(line);
+    queues_->responses.push(std::move(response));
+}
+
+void LinePipeline::run(std::istream& in, std::ostream& out, const Execute& execute, const Serialize& serialize) {
+    queues_ = std::make_unique<Queues>(options_.queue_depth);
+    Queues& queues = *queues_;
+
+    std::thread reader([&in, &queues] {
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            PipelineRequest request;
+            const auto parse_start = std::chrono::steady_clock::now();
+            try {
+                DASE_TRACE_ZONE("cli.json_parse");
+                request.command = json::parse(line);
+            } catch (const json::parse_error& e) {
+                request.parse_error = e.what();
+            }
+            request.parse_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - parse_start).count());
+            request.line = std::move(line);
+            queues.requests.push(std::move(request));
+        }
+        queues.requests.close();
+    });
+
+    const size_t flush_bytes = options_.flush_bytes;
+    std::thread writer([&out, &queues, &serialize, flush_bytes] {
+        PipelineResponse response;
+        size_t unflushed = 0;
+        while (queues.responses.pop(response)) {
+            std::string text;
+            if (response.serialized) {
+                text = std::move(response.text);
+            } else {
+                try {
+                    DASE_TRACE_ZONE("cli.json_dump");
+                    text = serialize(response);
+                } catch (const std::exception& e) {
+                    text = internalError(e.what()).dump();
+                }
+            }
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+            out.put('\n');
+            unflushed += text.size() + 1;
+            // Flush before waiting, so a client blocked on its reply gets it
+            if (unflushed >= flush_bytes || queues.responses.empty()) {
+                out.flush();
+                unflushed = 0;
+            }
+        }
+        out.flush();
+    });
+
+    PipelineRequest request;
+    while (queues.requests.pop(request)) {
+        PipelineResponse response;
+        response.bytes_in = request.line.size();
+        response.parse_ns = request.parse_ns;
+        try {
+            execute(request, response);
+        } catch (const std::exception& e) {
+            response = PipelineResponse();
+            response.envelope = internalError(e.what());
+        }
+        queues.responses.push(std::move(response));
+    }
+    queues.responses.close();
+
+    writer.join();
+    reader.join();
+    queues_.reset();
+}
+
+} // namespace dase
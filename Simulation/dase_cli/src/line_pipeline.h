@@ -0,0 +1,99 @@
+/**
+ * Line Pipeline - Overlapped stdin/stdout JSON lines (dase_cli --pipeline)
+ *
+ * The default JSON-lines loop reads, parses, executes, serializes and
+ * writes each command in turn and flushes every line, so engines idle while
+ * a large response is formatted and written, and the output idles while a
+ * mission runs.  LinePipeline runs the same protocol as three stages joined
+ * by bounded queues:
+ *
+ *   reader thread   getline + json::parse of the commands ahead
+ *   executor        the thread calling run(); commands one at a time in
+ *                   arrival order, so commands on one engine keep their
+ *                   order and responses stay matched to requests by
+ *                   position
+ *   writer thread   serializes responses and writes them through the
+ *                   stream's buffer, flushing only once it has caught up
+ *                   with the executor or holds flush_bytes unflushed
+ *
+ * Streamed messages (emit) pass through the writer queue, so they still
+ * precede their command's response.  Each queue holds at most queue_depth
+ * items, which bounds memory when the input runs far ahead of execution.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include "binary_protocol.h"
+#include "json.hpp"
+
+namespace dase {
+
+using json = nlohmann::json;
+
+// One non-empty input line, parsed by the reader thread
+struct PipelineRequest {
+    std::string line;              // Without its newline
+    json command;                  // Valid when parse_error is empty
+    std::string parse_error;       // json::parse_error text
+    uint64_t parse_ns = 0;
+};
+
+// One output line: a response for the writer to serialize, or text
+// already serialized by emit()
+struct PipelineResponse {
+    json envelope;
+    protocol::Segments segments;   // State arrays of the envelope
+    std::string command;           // Router stats key ("" = not recorded)
+    uint64_t parse_ns = 0;
+    uint64_t bytes_in = 0;
+
+    bool serialized = false;
+    std::string text;
+};
+
+struct LinePipelineOptions {
+    size_t queue_depth = 64;            // Items per queue (>= 1)
+    size_t flush_bytes = 1 << 16;       // Flush at least this often
+};
+
+class LinePipeline {
+public:
+    // Executor stage: answer one request (runs on the run() thread)
+    using Execute = std::function<void(PipelineRequest& request, PipelineResponse& response)>;
+
+    // Writer stage: the line for an unserialized response (runs on the
+    // writer thread, concurrently with Execute).  An exception becomes an
+    // INTERNAL_ERROR line.
+    using Serialize = std::function<std::string(PipelineResponse& response)>;
+
+    explicit LinePipeline(const LinePipelineOptions& options = {});
+    ~LinePipeline();
+
+    LinePipeline(const LinePipeline&) = delete;
+    LinePipeline& operator=(const LinePipeline&) = delete;
+
+    /**
+     * Process `in` until it ends; returns once every response is written
+     * and flushed.  Empty lines are skipped.  Execute exceptions become
+     * INTERNAL_ERROR responses.
+     */
+    void run(std::istream& in, std::ostream& out, const Execute& execute, const Serialize& serialize);
+
+    // From Execute: queue a serialized line ahead of the current response
+    void emit(std::string line);
+
+private:
+    struct Queues;
+
+    LinePipelineOptions options_;
+    std::unique_ptr<Queues> queues_;
+};
+
+} // namespace dase
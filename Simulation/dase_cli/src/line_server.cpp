@@ -0,0 +1,377 @@
+/**
+ * Line Server Implementation
+ */
+
+#include "line_server.h"
+
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#pragma comment(lib, "ws2_32.lib")
+using socket_t = SOCKET;
+constexpr socket_t kNoSocket = INVALID_SOCKET;
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+using socket_t = int;
+constexpr socket_t kNoSocket = -1;
+#endif
+
+namespace dase {
+
+namespace {
+
+#ifdef _WIN32
+bool ensureSockets() {
+    static const bool started = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return started;
+}
+void closeSocket(socket_t s) { closesocket(s); }
+std::string lastSocketError() { return "socket error " + std::to_string(WSAGetLastError()); }
+int pollOne(socket_t s, int timeout_ms) {
+    WSAPOLLFD entry{};
+    entry.fd = s;
+    entry.events = POLLRDNORM;
+    return WSAPoll(&entry, 1, timeout_ms);
+}
+#else
+bool ensureSockets() { return true; }
+void closeSocket(socket_t s) { ::close(s); }
+std::string lastSocketError() { return std::strerror(errno); }
+int pollOne(socket_t s, int timeout_ms) {
+    pollfd entry{};
+    entry.fd = s;
+    entry.events = POLLIN;
+    return ::poll(&entry, 1, timeout_ms);
+}
+#endif
+
+socket_t toSocket(intptr_t value) { return static_cast<socket_t>(value); }
+intptr_t fromSocket(socket_t value) { return static_cast<intptr_t>(value); }
+
+bool sendAll(socket_t s, const char* data, size_t size) {
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    flags = MSG_NOSIGNAL;   // A vanished peer is an error, not SIGPIPE
+#endif
+    while (size > 0) {
+        const int chunk = static_cast<int>(size > (1u << 30) ? (1u << 30) : size);
+        const auto sent = ::send(s, data, chunk, flags);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+// Append received bytes to `buffer` until it holds a full line
+bool receiveLine(socket_t s, std::string& buffer, std::string& line) {
+    while (true) {
+        const size_t newline = buffer.find('\n');
+        if (newline != std::string::npos) {
+            line.assign(buffer, 0, newline);
+            buffer.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+        char chunk[65536];
+        const auto received = ::recv(s, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+}
+
+class SocketWriter : public LineWriter {
+public:
+    explicit SocketWriter(socket_t s) : socket_(s) {}
+
+    bool writeLine(const std::string& line) override {
+        std::string framed;
+        framed.reserve(line.size() + 1);
+        framed.append(line);
+        framed.push_back('\n');
+        return sendAll(socket_, framed.data(), framed.size());
+    }
+
+private:
+    socket_t socket_;
+};
+
+// Open a socket of the endpoint's family with `address` filled in
+socket_t openSocket(const LineEndpoint& endpoint, sockaddr_storage& address, socklen_t& length, std::string& error) {
+    std::memset(&address, 0, sizeof(address));
+    if (endpoint.kind == LineEndpoint::Kind::Unix) {
+        auto* un = reinterpret_cast<sockaddr_un*>(&address);
+        if (endpoint.path.size() >= sizeof(un->sun_path)) {
+            error = "Unix socket path too long";
+            return kNoSocket;
+        }
+        un->sun_family = AF_UNIX;
+        std::memcpy(un->sun_path, endpoint.path.c_str(), endpoint.path.size() + 1);
+        length = static_cast<socklen_t>(sizeof(sockaddr_un));
+        const socket_t s = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (s == kNoSocket) error = "socket: " + lastSocketError();
+        return s;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* resolved = nullptr;
+    const std::string port = std::to_string(endpoint.port);
+    if (::getaddrinfo(endpoint.host.c_str(), port.c_str(), &hints, &resolved) != 0 || !resolved) {
+        error = "Cannot resolve host: " + endpoint.host;
+        return kNoSocket;
+    }
+    std::memcpy(&address, resolved->ai_addr, resolved->ai_addrlen);
+    length = static_cast<socklen_t>(resolved->ai_addrlen);
+    const socket_t s = ::socket(resolved->ai_family, SOCK_STREAM, 0);
+    ::freeaddrinfo(resolved);
+    if (s == kNoSocket) {
+        error = "socket: " + lastSocketError();
+        return kNoSocket;
+    }
+    const int one = 1;
+    ::setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&one), sizeof(one));
+    return s;
+}
+
+} // namespace
+
+bool LineEndpoint::parse(const std::string& spec, LineEndpoint& out, std::string& error) {
+    if (spec.compare(0, 5, "unix:") == 0) {
+        out.kind = Kind::Unix;
+        out.path = spec.substr(5);
+        if (out.path.empty()) {
+            error = "unix: endpoint needs a path";
+            return false;
+        }
+        return true;
+    }
+    if (spec.compare(0, 4, "tcp:") == 0) {
+        const std::string rest = spec.substr(4);
+        const size_t colon = rest.rfind(':');
+        if (colon == std::string::npos) {
+            error = "tcp: endpoint needs host:port";
+            return false;
+        }
+        out.kind = Kind::Tcp;
+        out.host = colon == 0 ? "127.0.0.1" : rest.substr(0, colon);
+        try {
+            const unsigned long port = std::stoul(rest.substr(colon + 1));
+            if (port > 65535) throw std::out_of_range("port");
+            out.port = static_cast<uint16_t>(port);
+        } catch (const std::exception&) {
+            error = "Invalid port in endpoint: " + spec;
+            return false;
+        }
+        return true;
+    }
+    error = "Endpoint must be tcp:<host>:<port> or unix:<path>";
+    return false;
+}
+
+std::string LineEndpoint::describe() const {
+    return kind == Kind::Unix ? "unix:" + path : "tcp:" + host + ":" + std::to_string(port);
+}
+
+LineServer::~LineServer() {
+    if (listen_socket_ != -1) {
+        closeSocket(toSocket(listen_socket_));
+    }
+    if (!unix_path_.empty()) {
+        ::remove(unix_path_.c_str());
+    }
+}
+
+bool LineServer::listen(const LineEndpoint& endpoint, std::string& error) {
+    if (!ensureSockets()) {
+        error = "Socket library initialization failed";
+        return false;
+    }
+    sockaddr_storage address;
+    socklen_t length = 0;
+    const socket_t s = openSocket(endpoint, address, length, error);
+    if (s == kNoSocket) {
+        return false;
+    }
+
+    if (endpoint.kind == LineEndpoint::Kind::Unix) {
+        ::remove(endpoint.path.c_str());
+    } else {
+        const int one = 1;
+        ::setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&one), sizeof(one));
+    }
+    if (::bind(s, reinterpret_cast<sockaddr*>(&address), length) != 0 || ::listen(s, 64) != 0) {
+        error = "Cannot listen on " + endpoint.describe() + ": " + lastSocketError();
+        closeSocket(s);
+        return false;
+    }
+
+    listen_socket_ = fromSocket(s);
+    if (endpoint.kind == LineEndpoint::Kind::Unix) {
+        unix_path_ = endpoint.path;
+    } else {
+        sockaddr_storage bound;
+        socklen_t bound_length = sizeof(bound);
+        if (::getsockname(s, reinterpret_cast<sockaddr*>(&bound), &bound_length) == 0) {
+            port_ = ntohs(bound.ss_family == AF_INET6
+                              ? reinterpret_cast<sockaddr_in6*>(&bound)->sin6_port
+                              : reinterpret_cast<sockaddr_in*>(&bound)->sin_port);
+        }
+    }
+    return true;
+}
+
+void LineServer::serve(const LineSessionFactory& factory) {
+    std::mutex clients_mutex;
+    std::set<socket_t> clients;
+    struct SessionThread {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> done;
+    };
+    std::vector<SessionThread> sessions;
+
+    // Join sessions whose client has gone
+    auto reap = [&sessions] {
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            if (it->done->load()) {
+                it->thread.join();
+                it = sessions.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    };
+
+    const socket_t listener = toSocket(listen_socket_);
+    while (!stopping_.load()) {
+        reap();
+        // Poll so stop() is noticed without another connection arriving
+        if (pollOne(listener, 200) <= 0) {
+            continue;
+        }
+        const socket_t client = ::accept(listener, nullptr, nullptr);
+        if (client == kNoSocket) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            clients.insert(client);
+        }
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        std::thread thread([client, done, &factory, &clients, &clients_mutex] {
+            {
+                std::unique_ptr<LineSession> session = factory();
+                SocketWriter writer(client);
+                std::string buffer;
+                std::string line;
+                while (receiveLine(client, buffer, line)) {
+                    if (!line.empty()) {
+                        session->onLine(line, writer);
+                    }
+                }
+            }   // Session state (and its engines) released before the socket closes
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            clients.erase(client);
+            closeSocket(client);
+            done->store(true);
+        });
+        sessions.push_back({std::move(thread), done});
+    }
+
+    // Wake sessions blocked in recv, then wait for them
+    {
+        std::lock_guard<std::mutex> lock(clients_mutex);
+        for (socket_t client : clients) {
+#ifdef _WIN32
+            ::shutdown(client, SD_BOTH);
+#else
+            ::shutdown(client, SHUT_RDWR);
+#endif
+        }
+    }
+    for (auto& session : sessions) {
+        session.thread.join();
+    }
+}
+
+void LineServer::stop() {
+    stopping_.store(true);
+}
+
+LineClient::~LineClient() {
+    close();
+}
+
+bool LineClient::connect(const LineEndpoint& endpoint, std::string& error) {
+    close();
+    if (!ensureSockets()) {
+        error = "Socket library initialization failed";
+        return false;
+    }
+    sockaddr_storage address;
+    socklen_t length = 0;
+    const socket_t s = openSocket(endpoint, address, length, error);
+    if (s == kNoSocket) {
+        return false;
+    }
+    if (::connect(s, reinterpret_cast<sockaddr*>(&address), length) != 0) {
+        error = "Cannot connect to " + endpoint.describe() + ": " + lastSocketError();
+        closeSocket(s);
+        return false;
+    }
+    socket_ = fromSocket(s);
+    buffer_.clear();
+    return true;
+}
+
+bool LineClient::writeLine(const std::string& line) {
+    if (socket_ == -1) {
+        return false;
+    }
+    std::string framed = line;
+    framed.push_back('\n');
+    return sendAll(toSocket(socket_), framed.data(), framed.size());
+}
+
+bool LineClient::readLine(std::string& line) {
+    return socket_ != -1 && receiveLine(toSocket(socket_), buffer_, line);
+}
+
+void LineClient::close() {
+    if (socket_ != -1) {
+        closeSocket(toSocket(socket_));
+        socket_ = -1;
+    }
+}
+
+} // namespace dase
@@ -0,0 +1,117 @@
+/**
+ * Line Server - Newline-delimited command protocol over sockets
+ *
+ * dase_cli and sid_cli normally serve one client on stdin/stdout and exit
+ * at EOF, so every run pays process start-up, DLL load, FFTW wisdom and
+ * engine construction again.  With --serve=<endpoint> they stay up and
+ * speak the same JSON-lines protocol to any number of concurrent socket
+ * clients instead, one LineSession per connection.
+ *
+ * Endpoints:
+ *
+ *   tcp:<host>:<port>     TCP (e.g. tcp:127.0.0.1:7700)
+ *   unix:<path>           Unix-domain socket (AF_UNIX; Windows 10+ as well)
+ *
+ * LineClient is the matching client for step runners and tests.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace dase {
+
+struct LineEndpoint {
+    enum class Kind { Tcp, Unix };
+
+    Kind kind = Kind::Tcp;
+    std::string host = "127.0.0.1";
+    uint16_t port = 0;
+    std::string path;
+
+    // Parse "tcp:host:port" or "unix:path"
+    static bool parse(const std::string& spec, LineEndpoint& out, std::string& error);
+    std::string describe() const;
+};
+
+/**
+ * Writes response lines to one connection
+ */
+class LineWriter {
+public:
+    virtual ~LineWriter() = default;
+
+    // Send `line` followed by '\n'; false once the peer is gone
+    virtual bool writeLine(const std::string& line) = 0;
+};
+
+/**
+ * Per-connection protocol state, created when a client connects and
+ * destroyed when it disconnects
+ */
+class LineSession {
+public:
+    virtual ~LineSession() = default;
+
+    // One request line (without its newline); write any number of replies
+    virtual void onLine(const std::string& line, LineWriter& out) = 0;
+};
+
+using LineSessionFactory = std::function<std::unique_ptr<LineSession>()>;
+
+class LineServer {
+public:
+    LineServer() = default;
+    ~LineServer();
+
+    LineServer(const LineServer&) = delete;
+    LineServer& operator=(const LineServer&) = delete;
+
+    // Bind and listen; a stale Unix socket file at the path is replaced
+    bool listen(const LineEndpoint& endpoint, std::string& error);
+
+    // Bound port (TCP; useful after listening on port 0)
+    uint16_t port() const { return port_; }
+
+    /**
+     * Accept connections until stop(), one thread and session per client;
+     * returns after every session has ended
+     */
+    void serve(const LineSessionFactory& factory);
+
+    // Stop accepting and wake serve(); safe from any thread
+    void stop();
+
+private:
+    intptr_t listen_socket_ = -1;
+    uint16_t port_ = 0;
+    std::string unix_path_;
+    std::atomic<bool> stopping_{false};
+};
+
+class LineClient {
+public:
+    LineClient() = default;
+    ~LineClient();
+
+    LineClient(const LineClient&) = delete;
+    LineClient& operator=(const LineClient&) = delete;
+
+    bool connect(const LineEndpoint& endpoint, std::string& error);
+    bool writeLine(const std::string& line);
+
+    // Next line from the server, without its newline; false at EOF
+    bool readLine(std::string& line);
+
+    void close();
+
+private:
+    intptr_t socket_ = -1;
+    std::string buffer_;
+};
+
+} // namespace dase
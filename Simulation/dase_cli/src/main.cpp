@@ -3,8 +3,14 @@
  * Main entry point for command-line JSON-based engine control
  */
 
+#include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #ifdef _WIN32
 #include <io.h>
@@ -13,9 +19,368 @@
 
 #include "json.hpp"
 #include "command_router.h"
+#include "binary_protocol.h"
+#include "json_text_writer.h"
+#include "line_pipeline.h"
+#include "line_server.h"
+#include "../../src/cpp/kernel_autotuner.h"
+#include "../../src/cpp/trace_zones.h"
 
 using json = nlohmann::json;
 
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+uint64_t nsSince(SteadyClock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - start).count());
+}
+
+// Router stats key of a request ("" if it names no command)
+std::string commandName(const json& command) {
+    if (command.is_object() && command.contains("command") && command["command"].is_string()) {
+        return command["command"].get<std::string>();
+    }
+    return "";
+}
+
+// --router-stats=<path>: the get_router_stats table on exit ("-" = stderr)
+void writeRouterStats(const CommandRouter& router, const std::string& path) {
+    if (path.empty()) {
+        return;
+    }
+    const std::string text = router.routerStats().dump(2);
+    if (path == "-") {
+        std::cerr << text << std::endl;
+        return;
+    }
+    std::ofstream out(path, std::ios::trunc);
+    out << text << '\n';
+    if (!out) {
+        std::cerr << "Failed to write router stats: " << path << std::endl;
+    }
+}
+
+// Binary framed protocol (see binary_protocol.h): one frame in, one frame out
+int runBinaryProtocol(CommandRouter& router) {
+    using namespace dase::protocol;
+
+    // Frames are written whole and flushed once each
+    std::ios::sync_with_stdio(false);
+
+    Frame request;
+    std::string error;
+
+    // Delta-coding state of each direction (see segment_codec.h): encoded
+    // snapshots are coded against the previous frames of this stream
+    SegmentEncoder encoder;
+    SegmentDecoder decoder;
+
+    // Streamed messages go out as frames of their own, in the request's format
+    router.setStreamSink([&request, &encoder](const json& message, Segments& segments) {
+        Frame frame;
+        frame.format = request.format;
+        frame.envelope = message;
+        frame.segments = std::move(segments);
+        writeFrame(std::cout, frame, &encoder);
+        std::cout.flush();
+        segments = std::move(frame.segments);   // Recycled by the router
+    });
+
+    while (true) {
+        const ReadStatus status = readFrame(std::cin, request, error, &decoder);
+        if (status == ReadStatus::EndOfStream) {
+            return 0;
+        }
+
+        Frame response;
+        response.format = request.format;
+        if (status == ReadStatus::Error) {
+            // The stream is no longer frame-aligned, so report and stop
+            router.recordParseError(0);
+            response.envelope = {
+                {"status", "error"},
+                {"error", error},
+                {"error_code", "FRAME_ERROR"}
+            };
+            writeFrame(std::cout, response);
+            std::cout.flush();
+            return 1;
+        }
+
+        // Parse time covers segment expansion only; the envelope is decoded
+        // while readFrame waits on the stream.  Commands that read their
+        // segments in place (typed state arrays) skip the expansion.
+        const std::string name = commandName(request.envelope);
+        const bool in_place = CommandRouter::readsRequestSegments(name);
+        const auto parse_start = SteadyClock::now();
+        const bool expanded = in_place || expandSegments(request.envelope, request.segments, error);
+        const uint64_t parse_ns = nsSince(parse_start);
+        if (!expanded) {
+            router.recordParseError(request.wire_bytes);
+            response.envelope = {
+                {"status", "error"},
+                {"error", error},
+                {"error_code", "FRAME_ERROR"}
+            };
+        } else {
+            if (!in_place) {
+                request.segments.clear();
+            }
+            response.envelope = router.execute(request.envelope, &response.segments,
+                                               in_place ? &request.segments : nullptr);
+            if (response.envelope.value("status", "") == "error") {
+                response.segments.clear();
+            }
+        }
+        const auto serialize_start = SteadyClock::now();
+        const uint64_t bytes_out = writeFrame(std::cout, response, &encoder);
+        const uint64_t serialize_ns = nsSince(serialize_start);
+        std::cout.flush();
+        router.recycleSegments(response.segments);
+        if (expanded) {
+            router.recordTransport(name, parse_ns, serialize_ns, request.wire_bytes, bytes_out);
+        }
+    }
+}
+
+// --pipeline: the JSON-lines protocol with parsing, execution and output
+// overlapped (see line_pipeline.h)
+int runPipelinedLines(CommandRouter& router, int json_digits) {
+    // Output is flushed by the writer stage, not per line
+    std::ios::sync_with_stdio(false);
+
+    dase::LinePipeline pipeline;
+
+    // Streamed messages are one JSON line each, ahead of the response;
+    // their segments go back to the router, so they are formatted here
+    router.setStreamSink([&pipeline, json_digits](const json& message, dase::protocol::Segments& segments) {
+        pipeline.emit(dase::protocol::dumpJsonText(message, segments, json_digits));
+    });
+
+    const auto execute = [&router](dase::PipelineRequest& request, dase::PipelineResponse& response) {
+        if (!request.parse_error.empty()) {
+            router.recordParseError(request.line.size());
+            response.envelope = {
+                {"status", "error"},
+                {"error", "JSON parse error: " + request.parse_error},
+                {"error_code", "PARSE_ERROR"}
+            };
+            return;
+        }
+        response.envelope = router.execute(request.command, &response.segments);
+        response.command = commandName(request.command);
+    };
+
+    // Router stats and the buffer pool are thread-safe, so the writer
+    // records and recycles while the next command runs
+    const auto serialize = [&router, json_digits](dase::PipelineResponse& response) {
+        const auto serialize_start = SteadyClock::now();
+        std::string text = dase::protocol::dumpJsonText(response.envelope, response.segments, json_digits);
+        const uint64_t serialize_ns = nsSince(serialize_start);
+        router.recycleSegments(response.segments);
+        if (!response.command.empty()) {
+            router.recordTransport(response.command, response.parse_ns, serialize_ns,
+                                   response.bytes_in, text.size() + 1);
+        }
+        return text;
+    };
+
+    pipeline.run(std::cin, std::cout, execute, serialize);
+    router.setStreamSink(nullptr);
+    return 0;
+}
+
+// Server mode (--serve): one CommandRouter (EngineManager is a process
+// singleton) shared by every connection.  Commands run one at a time under
+// router_mutex, except job_* commands, which only touch the thread-safe
+// JobManager so that job_wait does not stall other clients, and
+// cancel_mission, which only sets a running mission's cancel flag.
+// Engines and jobs belong to the session that created them; other sessions
+// cannot address them, and a session's engines are destroyed when it
+// disconnects.
+struct ServerState {
+    CommandRouter router;
+    std::mutex router_mutex;
+    int json_digits = 0;            // --json-digits (0 = shortest round-trip)
+
+    std::mutex owners_mutex;
+    std::map<std::string, const void*> engine_owner;
+    std::map<std::string, const void*> job_owner;
+};
+
+class DaseSession : public dase::LineSession {
+public:
+    explicit DaseSession(ServerState& state) : state_(state) {}
+
+    ~DaseSession() override {
+        std::vector<std::string> owned;
+        {
+            std::lock_guard<std::mutex> lock(state_.owners_mutex);
+            for (auto it = state_.engine_owner.begin(); it != state_.engine_owner.end();) {
+                if (it->second == this) {
+                    owned.push_back(it->first);
+                    it = state_.engine_owner.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            for (auto it = state_.job_owner.begin(); it != state_.job_owner.end();) {
+                it = (it->second == this) ? state_.job_owner.erase(it) : std::next(it);
+            }
+        }
+        std::lock_guard<std::mutex> lock(state_.router_mutex);
+        for (const auto& engine_id : owned) {
+            state_.router.execute({{"command", "destroy_engine"}, {"params", {{"engine_id", engine_id}}}});
+        }
+    }
+
+    void onLine(const std::string& line, dase::LineWriter& out) override {
+        json command;
+        const auto parse_start = SteadyClock::now();
+        try {
+            command = json::parse(line);
+        } catch (const json::parse_error& e) {
+            state_.router.recordParseError(line.size());
+            out.writeLine(json({
+                {"status", "error"},
+                {"error", std::string("JSON parse error: ") + e.what()},
+                {"error_code", "PARSE_ERROR"}
+            }).dump());
+            return;
+        }
+
+        const uint64_t parse_ns = nsSince(parse_start);
+        const std::string name = commandName(command);
+        json response;
+        // State arrays of the response (json_text_writer.h); job_* commands
+        // and cancel_mission run outside router_mutex (so they can reach a
+        // mission another session is running) and return plain arrays
+        dase::protocol::Segments segments;
+        if (name.compare(0, 4, "job_") == 0 || name == "cancel_mission") {
+            response = run(command, nullptr);
+        } else {
+            std::lock_guard<std::mutex> lock(state_.router_mutex);
+            state_.router.setStreamSink([this, &out](const json& message, dase::protocol::Segments& message_segments) {
+                out.writeLine(dase::protocol::dumpJsonText(message, message_segments, state_.json_digits));
+            });
+            // Commands inside a batch get the same checks as top-level ones
+            state_.router.setBatchRunner([this](const json& inner, dase::protocol::Segments* inner_segments) {
+                return run(inner, inner_segments);
+            });
+            response = run(command, &segments);
+            state_.router.setBatchRunner(nullptr);
+            state_.router.setStreamSink(nullptr);
+        }
+        const auto serialize_start = SteadyClock::now();
+        const std::string text = dase::protocol::dumpJsonText(response, segments, state_.json_digits);
+        state_.router.recycleSegments(segments);
+        state_.router.recordTransport(name, parse_ns, nsSince(serialize_start), line.size(), text.size() + 1);
+        out.writeLine(text);
+    }
+
+private:
+    // Execute one command on behalf of this session
+    json run(const json& command, dase::protocol::Segments* segments) {
+        const std::string name = command.value("command", "");
+        const json params = command.value("params", json::object());
+        std::string foreign;
+        if (!ownsEverything(params, foreign)) {
+            return {
+                {"status", "error"},
+                {"command", name},
+                {"error", "Not owned by this session: " + foreign},
+                {"error_code", "NOT_IN_SESSION"}
+            };
+        }
+        json response = state_.router.execute(command, segments);
+        if (response.value("status", "") == "success") {
+            track(name, params, response);
+        }
+        return response;
+    }
+
+    // Every engine / job the command names is unowned or this session's
+    bool ownsEverything(const json& params, std::string& foreign) const {
+        std::vector<std::string> engines;
+        if (params.contains("engine_id") && params["engine_id"].is_string()) {
+            engines.push_back(params["engine_id"].get<std::string>());
+        }
+        if (params.contains("engine_ids") && params["engine_ids"].is_array()) {
+            for (const auto& id : params["engine_ids"]) {
+                if (id.is_string()) engines.push_back(id.get<std::string>());
+            }
+        }
+        std::lock_guard<std::mutex> lock(state_.owners_mutex);
+        for (const auto& id : engines) {
+            auto it = state_.engine_owner.find(id);
+            if (it != state_.engine_owner.end() && it->second != this) {
+                foreign = id;
+                return false;
+            }
+        }
+        if (params.contains("job_id") && params["job_id"].is_string()) {
+            auto it = state_.job_owner.find(params["job_id"].get<std::string>());
+            if (it != state_.job_owner.end() && it->second != this) {
+                foreign = it->first;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void track(const std::string& name, const json& params, const json& response) {
+        const json& result = response.contains("result") ? response["result"] : response;
+        std::lock_guard<std::mutex> lock(state_.owners_mutex);
+        if (name == "create_engine" && result.contains("engine_id")) {
+            state_.engine_owner[result["engine_id"].get<std::string>()] = this;
+        } else if (name == "clone_engine" && result.contains("clones")) {
+            for (const auto& id : result["clones"]) {
+                state_.engine_owner[id.get<std::string>()] = this;
+            }
+        } else if (name == "destroy_engine") {
+            state_.engine_owner.erase(params.value("engine_id", ""));
+        } else if (name == "submit_mission" && result.contains("job_id")) {
+            state_.job_owner[result["job_id"].get<std::string>()] = this;
+        }
+    }
+
+    ServerState& state_;
+};
+
+// --memory-budget-mb: applied through the router like any client command
+void applyMemoryBudget(CommandRouter& router, double budget_mb) {
+    if (budget_mb > 0.0) {
+        router.execute({{"command", "set_memory_budget"}, {"params", {{"budget_mb", budget_mb}}}});
+    }
+}
+
+int runServer(const std::string& spec, const std::string& stats_path, int json_digits, double memory_budget_mb,
+              const std::vector<std::string>& warmup_targets) {
+    dase::LineEndpoint endpoint;
+    std::string error;
+    dase::LineServer server;
+    if (!dase::LineEndpoint::parse(spec, endpoint, error) || !server.listen(endpoint, error)) {
+        std::cerr << "FATAL: " << error << std::endl;
+        return 1;
+    }
+    if (endpoint.kind == dase::LineEndpoint::Kind::Tcp) {
+        endpoint.port = server.port();
+    }
+    std::cerr << "dase_cli serving on " << endpoint.describe() << std::endl;
+
+    ServerState state;
+    state.json_digits = json_digits;
+    applyMemoryBudget(state.router, memory_budget_mb);
+    state.router.warmup(warmup_targets);
+    server.serve([&state] { return std::make_unique<DaseSession>(state); });
+    writeRouterStats(state.router, stats_path);
+    return 0;
+}
+
+} // namespace
+
 int main(int argc, char** argv) {
     try {
         // Handle --describe flag for engine introspection
@@ -37,11 +402,135 @@ int main(int argc, char** argv) {
         _setmode(_fileno(stdout), _O_BINARY);
         #endif
 
-        // Disable cout buffering for immediate output
-        std::cout.setf(std::ios::unitbuf);
+        // --protocol=binary selects framed CBOR/MessagePack I/O; JSON lines
+        // stay the default
+        // --serve=<endpoint> keeps the process up for socket clients
+        // --trace=<path> records trace zones for the whole run and writes
+        // them as Chrome trace JSON on exit (DASE_ENABLE_TRACE builds)
+        // --router-stats=<path> writes per-command latency stats on exit
+        // --json-digits=<n> writes JSON-mode state arrays with n significant
+        // digits (default: shortest round-trip)
+        // --memory-budget-mb=<mb> refuses engines that would take the
+        // process past mb MiB of engine memory (set_memory_budget)
+        // --warmup=<a,b,...> initializes phase4b / fftw / analysis in the
+        // background instead of on the first command that needs them
+        // --tuning-db=<path> keeps create_engine autotune choices in path
+        // (default ./cache/kernel_tuning.txt)
+        // --pipeline overlaps JSON-lines parsing and output with command
+        // execution (reader / executor / writer threads)
+        bool binary_protocol = false;
+        bool pipelined = false;
+        int json_digits = 0;
+        double memory_budget_mb = 0.0;
+        std::string serve_spec;
+        std::string trace_path;
+        std::string stats_path;
+        std::vector<std::string> warmup_targets;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg.compare(0, 15, "--router-stats=") == 0) {
+                stats_path = arg.substr(15);
+            } else if (arg.compare(0, 8, "--trace=") == 0) {
+                trace_path = arg.substr(8);
+            } else if (arg.compare(0, 8, "--serve=") == 0) {
+                serve_spec = arg.substr(8);
+            } else if (arg == "--protocol=binary") {
+                binary_protocol = true;
+            } else if (arg == "--protocol=json") {
+                binary_protocol = false;
+            } else if (arg == "--pipeline") {
+                pipelined = true;
+            } else if (arg.compare(0, 14, "--json-digits=") == 0) {
+                try {
+                    json_digits = std::stoi(arg.substr(14));
+                } catch (const std::exception&) {
+                    json_digits = -1;
+                }
+                if (json_digits < 0 || json_digits > 17) {
+                    std::cerr << "FATAL: --json-digits must be in [0, 17]" << std::endl;
+                    return 1;
+                }
+            } else if (arg.compare(0, 19, "--memory-budget-mb=") == 0) {
+                try {
+                    memory_budget_mb = std::stod(arg.substr(19));
+                } catch (const std::exception&) {
+                    memory_budget_mb = -1.0;
+                }
+                if (!(memory_budget_mb >= 0.0) || !std::isfinite(memory_budget_mb)) {
+                    std::cerr << "FATAL: --memory-budget-mb must be a non-negative number" << std::endl;
+                    return 1;
+                }
+            } else if (arg.compare(0, 12, "--tuning-db=") == 0) {
+                if (arg.size() == 12) {
+                    std::cerr << "FATAL: --tuning-db needs a path" << std::endl;
+                    return 1;
+                }
+                dase::KernelAutotuner::initialize(arg.substr(12));
+            } else if (arg.compare(0, 9, "--warmup=") == 0) {
+                const std::string list = arg.substr(9);
+                size_t begin = 0;
+                while (begin <= list.size()) {
+                    size_t end = list.find(',', begin);
+                    if (end == std::string::npos) end = list.size();
+                    const std::string target = list.substr(begin, end - begin);
+                    if (!CommandRouter::isWarmupTarget(target)) {
+                        std::cerr << "FATAL: --warmup takes a comma list of phase4b, fftw, analysis" << std::endl;
+                        return 1;
+                    }
+                    warmup_targets.push_back(target);
+                    begin = end + 1;
+                }
+            }
+        }
+
+        struct TraceSession {
+            std::string path;
+            ~TraceSession() {
+                if (path.empty()) return;
+                auto& recorder = dase::trace::TraceRecorder::instance();
+                recorder.stop();
+                if (!recorder.writeChromeTrace(path)) {
+                    std::cerr << "Failed to write trace: " << path << std::endl;
+                }
+            }
+        } trace_session;
+        if (!trace_path.empty()) {
+            if (dase::trace::kTraceCompiledIn) {
+                trace_session.path = trace_path;
+                dase::trace::TraceRecorder::instance().start();
+            } else {
+                std::cerr << "--trace ignored: built without DASE_ENABLE_TRACE" << std::endl;
+            }
+        }
+
+        if (!serve_spec.empty()) {
+            return runServer(serve_spec, stats_path, json_digits, memory_budget_mb, warmup_targets);
+        }
 
         // Create command router
         CommandRouter router;
+        applyMemoryBudget(router, memory_budget_mb);
+        router.warmup(warmup_targets);
+
+        if (binary_protocol) {
+            const int status = runBinaryProtocol(router);
+            writeRouterStats(router, stats_path);
+            return status;
+        }
+
+        if (pipelined) {
+            const int status = runPipelinedLines(router, json_digits);
+            writeRouterStats(router, stats_path);
+            return status;
+        }
+
+        // Disable cout buffering for immediate output
+        std::cout.setf(std::ios::unitbuf);
+
+        // Streamed messages are one JSON line each, ahead of the response
+        router.setStreamSink([json_digits](const json& message, dase::protocol::Segments& segments) {
+            std::cout << dase::protocol::dumpJsonText(message, segments, json_digits) << std::endl;
+        });
 
         // Read JSON commands from stdin line-by-line
         std::string line;
@@ -53,15 +542,30 @@ int main(int argc, char** argv) {
 
             try {
                 // Parse JSON command
-                json command = json::parse(line);
+                json command;
+                const auto parse_start = SteadyClock::now();
+                {
+                    DASE_TRACE_ZONE("cli.json_parse");
+                    command = json::parse(line);
+                }
+                const uint64_t parse_ns = nsSince(parse_start);
 
-                // Execute command
-                json response = router.execute(command);
+                // Execute command; state arrays come back as segments and
+                // are formatted straight from their buffers
+                dase::protocol::Segments segments;
+                json response = router.execute(command, &segments);
 
                 // Output JSON response
-                std::cout << response.dump() << std::endl;
+                DASE_TRACE_ZONE("cli.json_dump");
+                const auto serialize_start = SteadyClock::now();
+                const std::string text = dase::protocol::dumpJsonText(response, segments, json_digits);
+                const uint64_t serialize_ns = nsSince(serialize_start);
+                router.recycleSegments(segments);
+                std::cout << text << std::endl;
+                router.recordTransport(commandName(command), parse_ns, serialize_ns, line.size(), text.size() + 1);
 
             } catch (const json::parse_error& e) {
+                router.recordParseError(line.size());
                 // JSON parsing error
                 json error_response = {
                     {"status", "error"},
@@ -81,6 +585,7 @@ int main(int argc, char** argv) {
             }
         }
 
+        writeRouterStats(router, stats_path);
         return 0;
 
     } catch (const std::exception& e) {
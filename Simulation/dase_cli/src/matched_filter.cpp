@@ -0,0 +1,288 @@
+/**
+ * Matched Filter Implementation
+ */
+
+#include "matched_filter.h"
+#include "engine_fft_analysis.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef USE_FFTW3
+#include <fftw3.h>
+#include "../../src/cpp/fftw_plan_registry.hpp"
+#endif
+
+namespace dase {
+namespace analysis {
+
+namespace {
+
+#ifdef USE_FFTW3
+// Registry-allocated array (alignment 0, as the plans expect)
+template <typename T>
+struct FFTBuffer {
+    T* data = nullptr;
+    explicit FFTBuffer(T* memory) : data(memory) {
+        if (!data) throw std::bad_alloc();
+    }
+    ~FFTBuffer() { FFTPlanRegistry::release(data); }
+    FFTBuffer(const FFTBuffer&) = delete;
+    FFTBuffer& operator=(const FFTBuffer&) = delete;
+};
+
+fftw_plan forwardPlan(size_t n) {
+    return FFTPlanRegistry::acquire(FFTPlanKey::make(FFTPlanKey::Kind::R2C, {static_cast<int>(n)}),
+                                    FFTPlanRegistry::Planning::Auto);
+}
+
+fftw_plan batchedInversePlan(size_t n, size_t batches) {
+    return FFTPlanRegistry::acquire(FFTPlanKey::make(FFTPlanKey::Kind::C2R, {static_cast<int>(n)}, FFTW_BACKWARD,
+                                                     false, static_cast<int>(batches)),
+                                    FFTPlanRegistry::Planning::Auto);
+}
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+#endif
+
+} // namespace
+
+bool MatchedFilterBank::isAvailable() {
+#ifdef USE_FFTW3
+    return true;
+#else
+    return false;
+#endif
+}
+
+MatchedFilterBank::MatchedFilterBank(const std::vector<std::vector<double>>& templates, size_t block_size)
+    : block_size_(0), bins_(0), max_length_(0)
+{
+#ifndef USE_FFTW3
+    (void)templates;
+    (void)block_size;
+    throw std::runtime_error("FFTW3 not available - matched filtering disabled");
+#else
+    if (templates.empty()) {
+        throw std::invalid_argument("Matched filter needs at least one template");
+    }
+    for (const auto& h : templates) {
+        if (h.empty()) {
+            throw std::invalid_argument("Matched filter templates must not be empty");
+        }
+        max_length_ = (std::max)(max_length_, h.size());
+        lengths_.push_back(h.size());
+    }
+    block_size_ = block_size > 0 ? block_size : (std::max)(nextPowerOfTwo(4 * max_length_), size_t(64));
+    if (block_size_ < max_length_) {
+        throw std::invalid_argument("Matched filter block_size " + std::to_string(block_size_) +
+                                    " is shorter than the longest template (" +
+                                    std::to_string(max_length_) + ")");
+    }
+    bins_ = block_size_ / 2 + 1;
+
+    // Transform every template once: H / (N ||h||)
+    const fftw_plan forward = forwardPlan(block_size_);
+    FFTBuffer<double> padded(FFTPlanRegistry::allocReal(block_size_));
+    FFTBuffer<fftw_complex> spectrum(FFTPlanRegistry::allocComplex(bins_));
+    spectrum_re_.resize(templates.size() * bins_);
+    spectrum_im_.resize(templates.size() * bins_);
+    for (size_t t = 0; t < templates.size(); ++t) {
+        const auto& h = templates[t];
+        double norm_sq = 0.0;
+        for (double v : h) norm_sq += v * v;
+        if (!(norm_sq > 0.0)) {
+            throw std::invalid_argument("Matched filter template " + std::to_string(t) + " is zero");
+        }
+        std::fill(padded.data, padded.data + block_size_, 0.0);
+        std::copy(h.begin(), h.end(), padded.data);
+        fftw_execute_dft_r2c(forward, padded.data, spectrum.data);
+
+        const double scale = 1.0 / (static_cast<double>(block_size_) * std::sqrt(norm_sq));
+        for (size_t k = 0; k < bins_; ++k) {
+            spectrum_re_[t * bins_ + k] = spectrum.data[k][0] * scale;
+            spectrum_im_[t * bins_ + k] = spectrum.data[k][1] * scale;
+        }
+    }
+#endif
+}
+
+MatchedFilterResult MatchedFilterBank::filter(const std::vector<double>& series,
+                                              const MatchedFilterConfig& config) const {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    MatchedFilterResult result;
+    result.block_size = block_size_;
+    const size_t n = series.size();
+    const size_t templates = lengths_.size();
+    result.snr.resize(templates);
+
+#ifdef USE_FFTW3
+    // Mean and σ of the series (two passes)
+    double mean = 0.0;
+    if (config.detrend && n > 0) {
+        for (double v : series) mean += v;
+        mean /= static_cast<double>(n);
+    }
+    double sigma = config.noise_sigma;
+    if (!(sigma > 0.0) && n > 0) {
+        double var = 0.0;
+        for (double v : series) var += (v - mean) * (v - mean);
+        sigma = std::sqrt(var / static_cast<double>(n));
+    }
+    result.noise_sigma = sigma;
+    const double inv_sigma = sigma > 0.0 ? 1.0 / sigma : 0.0;
+
+    size_t min_length = max_length_;
+    for (size_t t = 0; t < templates; ++t) {
+        min_length = (std::min)(min_length, lengths_[t]);
+        if (n >= lengths_[t]) {
+            result.snr[t].assign(n - lengths_[t] + 1, 0.0);
+        }
+    }
+
+    if (n >= min_length) {
+        // Overlap-save: each block yields `step` wrap-free lags
+        const size_t N = block_size_;
+        const size_t K = bins_;
+        const size_t step = N - max_length_ + 1;
+        const size_t lags = n - min_length + 1;
+        const size_t blocks = (lags + step - 1) / step;
+        result.blocks = blocks;
+
+        const fftw_plan forward = forwardPlan(N);
+        const fftw_plan inverse = batchedInversePlan(N, templates);
+        const double* h_re = spectrum_re_.data();
+        const double* h_im = spectrum_im_.data();
+
+        #pragma omp parallel if (blocks > 1)
+        {
+            FFTBuffer<double> block(FFTPlanRegistry::allocReal(N));
+            FFTBuffer<fftw_complex> spectrum(FFTPlanRegistry::allocComplex(K));
+            FFTBuffer<fftw_complex> products(FFTPlanRegistry::allocComplex(K * templates));
+            FFTBuffer<double> correlations(FFTPlanRegistry::allocReal(N * templates));
+            std::vector<double> x_re(K), x_im(K);
+
+            #pragma omp for schedule(static)
+            for (long long b = 0; b < static_cast<long long>(blocks); ++b) {
+                const size_t s = static_cast<size_t>(b) * step;
+                const size_t available = (std::min)(N, n - s);
+                for (size_t i = 0; i < available; ++i) block.data[i] = series[s + i] - mean;
+                std::fill(block.data + available, block.data + N, 0.0);
+                fftw_execute_dft_r2c(forward, block.data, spectrum.data);
+                for (size_t k = 0; k < K; ++k) {
+                    x_re[k] = spectrum.data[k][0];
+                    x_im[k] = spectrum.data[k][1];
+                }
+
+                // X · conj(H_t) for every template into one batch
+                for (size_t t = 0; t < templates; ++t) {
+                    const double* hr = h_re + t * K;
+                    const double* hi = h_im + t * K;
+                    double* out = reinterpret_cast<double*>(products.data + t * K);
+                    const double* xr = x_re.data();
+                    const double* xi = x_im.data();
+                    #pragma omp simd
+                    for (size_t k = 0; k < K; ++k) {
+                        out[2 * k] = xr[k] * hr[k] + xi[k] * hi[k];
+                        out[2 * k + 1] = xi[k] * hr[k] - xr[k] * hi[k];
+                    }
+                }
+                fftw_execute_dft_c2r(inverse, products.data, correlations.data);
+
+                for (size_t t = 0; t < templates; ++t) {
+                    std::vector<double>& snr = result.snr[t];
+                    if (snr.size() <= s) continue;
+                    const size_t count = (std::min)(step, snr.size() - s);
+                    const double* c = correlations.data + t * N;
+                    for (size_t j = 0; j < count; ++j) {
+                        snr[s + j] = c[j] * inv_sigma;
+                    }
+                }
+            }
+        }
+    }
+
+    // Local maxima of |snr| per template, then highest first overall
+    std::vector<double> magnitude;
+    for (size_t t = 0; t < templates; ++t) {
+        const std::vector<double>& snr = result.snr[t];
+        if (snr.empty()) continue;
+        magnitude.resize(snr.size());
+        for (size_t j = 0; j < snr.size(); ++j) magnitude[j] = std::fabs(snr[j]);
+        const auto peaks = EngineFFTAnalysis::findFieldPeaks(magnitude, magnitude.size(), 1, 1,
+                                                             config.n_peaks, 0.0);
+        for (const FieldPeak& peak : peaks) {
+            if (peak.value <= 0.0 || peak.value < config.min_snr) continue;
+            result.candidates.push_back({t, peak.index,
+                                         static_cast<double>(peak.index) * config.sample_interval,
+                                         snr[peak.index]});
+        }
+    }
+    std::stable_sort(result.candidates.begin(), result.candidates.end(),
+        [](const MatchedFilterCandidate& a, const MatchedFilterCandidate& b) {
+            return std::fabs(a.snr) > std::fabs(b.snr);
+        });
+#else
+    (void)n;
+    (void)config;
+    throw std::runtime_error("FFTW3 not available - matched filtering disabled");
+#endif
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    result.execution_time_ms = duration.count() / 1000.0;
+    return result;
+}
+
+nlohmann::json MatchedFilterBank::toJSON(const MatchedFilterResult& result, bool include_series) {
+    nlohmann::json candidates = nlohmann::json::array();
+    for (const auto& c : result.candidates) {
+        candidates.push_back({
+            {"template", c.template_index},
+            {"lag", c.lag},
+            {"time", c.time},
+            {"snr", c.snr}
+        });
+    }
+
+    nlohmann::json templates = nlohmann::json::array();
+    for (size_t t = 0; t < result.snr.size(); ++t) {
+        const auto& snr = result.snr[t];
+        double max_snr = 0.0;
+        size_t argmax = 0;
+        for (size_t j = 0; j < snr.size(); ++j) {
+            if (std::fabs(snr[j]) > std::fabs(max_snr)) {
+                max_snr = snr[j];
+                argmax = j;
+            }
+        }
+        nlohmann::json entry = {
+            {"template", t},
+            {"lags", snr.size()},
+            {"max_snr", max_snr},
+            {"argmax", argmax}
+        };
+        if (include_series) {
+            entry["snr"] = snr;
+        }
+        templates.push_back(entry);
+    }
+
+    return {
+        {"noise_sigma", result.noise_sigma},
+        {"block_size", result.block_size},
+        {"blocks", result.blocks},
+        {"templates", templates},
+        {"candidates", candidates},
+        {"execution_time_ms", result.execution_time_ms}
+    };
+}
+
+} // namespace analysis
+} // namespace dase
@@ -0,0 +1,102 @@
+/**
+ * Matched Filter - FFT correlation of a strain series against a template bank
+ *
+ * Every template h_t of length L_t is zero-padded to the block length N,
+ * transformed once and cached (scaled by 1 / (N ||h_t||), conjugation
+ * folded into the multiply).  A series d is processed in overlap-save
+ * blocks: block b covers d[s, s + N) with s = b (N - L + 1) for the longest
+ * template L, is transformed once, multiplied against every cached
+ * template spectrum (split re / im arrays in one SIMD loop, written into
+ * one contiguous batch) and brought back for all templates by one batched
+ * inverse plan (howmany = templates).  Lags [0, N - L] of each block are
+ * free of wrap-around, so consecutive blocks tile the output exactly:
+ *
+ *   snr_t[j] = Σ_i d[j + i] h_t[i] / (σ ||h_t||),   j = 0 .. n - L_t
+ *
+ * with d mean-subtracted (detrend) and σ its standard deviation (white
+ * noise).  Blocks are independent and run in parallel, each writing its own
+ * lags, so the series do not depend on the thread count.  Candidates are
+ * the local maxima of |snr_t| (EngineFFTAnalysis::findFieldPeaks on the
+ * 1D series).
+ *
+ * Plans come from the process-wide dase::FFTPlanRegistry.  Without
+ * USE_FFTW3 isAvailable() is false and the constructor throws.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+namespace analysis {
+
+struct MatchedFilterConfig {
+    bool detrend = true;              // Subtract the series mean first
+    double noise_sigma = 0.0;         // σ of the noise; 0 = estimate from the series
+    double sample_interval = 1.0;     // Time between samples (candidate times)
+    size_t n_peaks = 10;              // Candidates per template
+    double min_snr = 0.0;             // Minimum |snr| of a candidate
+};
+
+struct MatchedFilterCandidate {
+    size_t template_index;
+    size_t lag;                       // Template start sample in the series
+    double time;                      // lag * sample_interval
+    double snr;                       // Signed SNR at the peak
+};
+
+struct MatchedFilterResult {
+    std::vector<std::vector<double>> snr;       // Per template, n - L_t + 1 lags
+    std::vector<MatchedFilterCandidate> candidates;  // Highest |snr| first
+    double noise_sigma = 0.0;
+    size_t block_size = 0;
+    size_t blocks = 0;
+    double execution_time_ms = 0.0;
+};
+
+class MatchedFilterBank {
+public:
+    /**
+     * Transform and cache the templates
+     *
+     * @param templates One real series per template (non-empty, not all zero)
+     * @param block_size FFT length N >= longest template; 0 picks the
+     *                   power of two >= 4 L (at least 64)
+     * @throws std::invalid_argument for an empty bank, an empty or zero
+     *         template, or a block shorter than the longest template
+     * @throws std::runtime_error without FFTW3
+     */
+    explicit MatchedFilterBank(const std::vector<std::vector<double>>& templates, size_t block_size = 0);
+
+    static bool isAvailable();
+
+    size_t getTemplateCount() const { return lengths_.size(); }
+    size_t getBlockSize() const { return block_size_; }
+    size_t getTemplateLength(size_t t) const { return lengths_[t]; }
+
+    /**
+     * SNR series of every template over the series, plus candidates
+     * (templates longer than the series get an empty series)
+     */
+    MatchedFilterResult filter(const std::vector<double>& series, const MatchedFilterConfig& config) const;
+
+    /**
+     * @param include_series Add every template's SNR series
+     */
+    static nlohmann::json toJSON(const MatchedFilterResult& result, bool include_series = false);
+
+private:
+    size_t block_size_;
+    size_t bins_;                     // N / 2 + 1
+    size_t max_length_;
+    std::vector<size_t> lengths_;
+    // Cached template spectra, template-major [t * bins_ + k]
+    std::vector<double> spectrum_re_;
+    std::vector<double> spectrum_im_;
+};
+
+} // namespace analysis
+} // namespace dase
@@ -0,0 +1,230 @@
+/**
+ * Metric Emitter Implementation
+ */
+
+#include "metric_emitter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dase {
+
+namespace {
+
+const char* metricUnits(const std::string& name) {
+    if (name == "ns_per_op") return "ns";
+    if (name == "ops_per_sec") return "ops/s";
+    if (name == "hw_dram_bandwidth_gbps" || name == "achieved_gbps") return "GB/s";
+    if (name == "achieved_gflops") return "GFLOP/s";
+    if (name == "arithmetic_intensity") return "FLOP/byte";
+    if (name == "step" || name == "total_operations") return "count";
+    return "dimensionless";
+}
+
+class StdoutMetricSink : public MetricSink {
+public:
+    void write(const std::string& engine_id, const MetricBatch& batch) override {
+        const auto& names = *batch.names;
+        std::string out;
+        for (size_t i = 0; i < batch.count; ++i) {
+            for (size_t k = 0; k < names.size(); ++k) {
+                json metric = {
+                    {"name", names[k]},
+                    {"value", batch.values[i * names.size() + k]},
+                    {"units", metricUnits(names[k])},
+                    {"engine_id", engine_id},
+                    {"step", batch.steps[i]}
+                };
+                out += "METRIC:";
+                out += metric.dump();
+                out += '\n';
+            }
+        }
+        std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+        std::cout.flush();
+    }
+
+    json describe() const override { return {{"sink", "stdout"}}; }
+};
+
+class BinaryMetricSink : public MetricSink {
+public:
+    bool open(const std::string& path, const std::vector<std::string>& names, std::string& error) {
+        path_ = path;
+        out_.open(path, std::ios::binary | std::ios::trunc);
+        if (!out_) {
+            error = "Failed to open metric file: " + path;
+            return false;
+        }
+        size_t names_bytes = 0;
+        for (const auto& name : names) names_bytes += sizeof(uint32_t) + name.size();
+
+        MetricFileHeader header{};
+        std::memcpy(header.magic, kMetricFileMagic, sizeof(header.magic));
+        header.version = kMetricFileVersion;
+        header.metric_count = static_cast<uint32_t>(names.size());
+        header.header_bytes = static_cast<uint32_t>(sizeof(header) + names_bytes);
+        header.record_bytes = static_cast<uint32_t>(sizeof(uint64_t) + sizeof(double) * (1 + names.size()));
+        out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const auto& name : names) {
+            const uint32_t length = static_cast<uint32_t>(name.size());
+            out_.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out_.write(name.data(), static_cast<std::streamsize>(name.size()));
+        }
+        out_.flush();
+        if (!out_) {
+            error = "Failed to write metric file: " + path;
+            return false;
+        }
+        return true;
+    }
+
+    void write(const std::string& /*engine_id*/, const MetricBatch& batch) override {
+        const size_t metric_count = batch.names->size();
+        for (size_t i = 0; i < batch.count; ++i) {
+            out_.write(reinterpret_cast<const char*>(&batch.steps[i]), sizeof(uint64_t));
+            out_.write(reinterpret_cast<const char*>(&batch.seconds[i]), sizeof(double));
+            out_.write(reinterpret_cast<const char*>(batch.values + i * metric_count),
+                       static_cast<std::streamsize>(sizeof(double) * metric_count));
+        }
+        out_.flush();
+    }
+
+    json describe() const override { return {{"sink", "binary"}, {"path", path_}}; }
+
+private:
+    std::string path_;
+    std::ofstream out_;
+};
+
+class SharedMemoryMetricSink : public MetricSink {
+public:
+    explicit SharedMemoryMetricSink(std::unique_ptr<SharedStateExport> segment)
+        : segment_(std::move(segment)) {}
+
+    void write(const std::string& /*engine_id*/, const MetricBatch& batch) override {
+        const size_t capacity = segment_->numNodes();
+        const size_t metric_count = batch.names->size();
+        segment_->beginPublish();
+        for (size_t i = 0; i < batch.count; ++i) {
+            const size_t slot = static_cast<size_t>(written_ % capacity);
+            segment_->field(0)[slot] = static_cast<double>(batch.steps[i]);
+            for (size_t k = 0; k < metric_count; ++k) {
+                segment_->field(k + 1)[slot] = batch.values[i * metric_count + k];
+            }
+            ++written_;
+        }
+        segment_->endPublish(written_);
+    }
+
+    json describe() const override {
+        json layout = segment_->describe();
+        layout["sink"] = "shm";
+        return layout;
+    }
+
+private:
+    std::unique_ptr<SharedStateExport> segment_;
+    uint64_t written_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<MetricSink> makeStdoutMetricSink() {
+    return std::make_unique<StdoutMetricSink>();
+}
+
+std::unique_ptr<MetricSink> makeBinaryMetricSink(const std::string& path,
+                                                 const std::vector<std::string>& names,
+                                                 std::string& error) {
+    auto sink = std::make_unique<BinaryMetricSink>();
+    if (!sink->open(path, names, error)) {
+        return nullptr;
+    }
+    return sink;
+}
+
+std::unique_ptr<MetricSink> makeSharedMemoryMetricSink(const std::string& name,
+                                                       const std::vector<std::string>& names,
+                                                       size_t capacity,
+                                                       std::string& error) {
+    if (capacity == 0) {
+        error = "Shared-memory metric ring needs a capacity";
+        return nullptr;
+    }
+    std::vector<std::string> fields;
+    fields.reserve(names.size() + 1);
+    fields.push_back("sample_step");
+    fields.insert(fields.end(), names.begin(), names.end());
+    const uint32_t dims[3] = {static_cast<uint32_t>(capacity), 1, 1};
+    auto segment = SharedStateExport::create(name, fields, capacity, dims, error);
+    if (!segment) {
+        return nullptr;
+    }
+    return std::make_unique<SharedMemoryMetricSink>(std::move(segment));
+}
+
+MetricEmitter::MetricEmitter(std::string engine_id,
+                             std::vector<std::string> names,
+                             const MetricEmitterOptions& options,
+                             std::unique_ptr<MetricSink> sink)
+    : engine_id_(std::move(engine_id)),
+      names_(std::move(names)),
+      options_(options),
+      sink_(std::move(sink)),
+      start_(Clock::now()) {
+    options_.every_steps = std::max<uint64_t>(1, options_.every_steps);
+    options_.buffer_samples = std::max<size_t>(1, options_.buffer_samples);
+    steps_.reserve(options_.buffer_samples);
+    seconds_.reserve(options_.buffer_samples);
+    values_.reserve(options_.buffer_samples * names_.size());
+}
+
+MetricEmitter::~MetricEmitter() {
+    flush();
+}
+
+bool MetricEmitter::due(uint64_t step) const {
+    if (step % options_.every_steps != 0) {
+        return false;
+    }
+    if (options_.every_ms <= 0.0 || !sampled_) {
+        return true;
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - last_sample_).count() >= options_.every_ms;
+}
+
+void MetricEmitter::record(uint64_t step, const double* values) {
+    const Clock::time_point now = Clock::now();
+    last_sample_ = now;
+    sampled_ = true;
+    steps_.push_back(step);
+    seconds_.push_back(std::chrono::duration<double>(now - start_).count());
+    values_.insert(values_.end(), values, values + names_.size());
+    ++recorded_;
+    if (steps_.size() >= options_.buffer_samples) {
+        flush();
+    }
+}
+
+void MetricEmitter::flush() {
+    if (steps_.empty()) {
+        return;
+    }
+    const MetricBatch batch{&names_, steps_.data(), seconds_.data(), values_.data(), steps_.size()};
+    sink_->write(engine_id_, batch);
+    steps_.clear();
+    seconds_.clear();
+    values_.clear();
+}
+
+json MetricEmitter::describe() const {
+    json info = sink_->describe();
+    info["metrics"] = names_;
+    info["every_steps"] = options_.every_steps;
+    info["every_ms"] = options_.every_ms;
+    info["buffer_samples"] = options_.buffer_samples;
+    return info;
+}
+
+} // namespace dase
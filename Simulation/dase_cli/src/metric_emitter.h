@@ -3,13 +3,38 @@
  *
  * Emits metrics in format: METRIC:{"name":"...", "value":..., "units":"..."}
  * which the backend can parse and stream to the frontend via WebSocket.
+ *
+ * emitMetric writes (and flushes) one line per call.  For per-step metrics
+ * use a MetricEmitter instead: it samples every N steps (optionally at most
+ * every T ms), buffers samples in a ring, and hands them to its sink in
+ * batches.  Sinks:
+ *
+ *   stdout   METRIC: lines as above plus "engine_id" and "step", one write
+ *            and one flush per batch (line protocol only; it would corrupt
+ *            --binary frames)
+ *   binary   a file: MetricFileHeader, the metric names (u32 length +
+ *            bytes each), then fixed-size records of u64 step, f64 seconds
+ *            since subscription and one f64 per metric
+ *   shm      a SharedStateExport segment (see state_export.h) whose fields
+ *            are "sample_step" and the metrics, each a ring of `capacity`
+ *            slots; the header's step is the number of samples written, so
+ *            sample i lives in slot i % capacity
+ *
+ * An engine without an emitter pays nothing: no values are computed.
  */
 
 #pragma once
 
-#include <string>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 #include "json.hpp"
+#include "state_export.h"
 
 using json = nlohmann::json;
 
@@ -71,4 +96,89 @@ inline void emitMetrics(const std::map<std::string, double>& metrics,
     }
 }
 
+constexpr char kMetricFileMagic[8] = {'D', 'A', 'S', 'E', 'M', 'E', 'T', '\0'};
+constexpr uint32_t kMetricFileVersion = 1;
+
+struct MetricFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t metric_count;
+    uint32_t header_bytes;     // Offset of the first record
+    uint32_t record_bytes;     // 16 + 8 * metric_count
+};
+
+// A batch of samples: steps[i], seconds[i] and values[i * metric_count + k]
+struct MetricBatch {
+    const std::vector<std::string>* names;
+    const uint64_t* steps;
+    const double* seconds;
+    const double* values;
+    size_t count;
+};
+
+class MetricSink {
+public:
+    virtual ~MetricSink() = default;
+    virtual void write(const std::string& engine_id, const MetricBatch& batch) = 0;
+    // Fields for the subscribe_metrics response
+    virtual nlohmann::json describe() const = 0;
+};
+
+std::unique_ptr<MetricSink> makeStdoutMetricSink();
+std::unique_ptr<MetricSink> makeBinaryMetricSink(const std::string& path,
+                                                 const std::vector<std::string>& names,
+                                                 std::string& error);
+std::unique_ptr<MetricSink> makeSharedMemoryMetricSink(const std::string& name,
+                                                       const std::vector<std::string>& names,
+                                                       size_t capacity,
+                                                       std::string& error);
+
+struct MetricEmitterOptions {
+    uint64_t every_steps = 1;    // Sample at multiples of this many steps (>= 1)
+    double every_ms = 0.0;       // ... but no more often than this (0 = no limit)
+    size_t buffer_samples = 256; // Samples held before a batch goes to the sink
+};
+
+class MetricEmitter {
+public:
+    MetricEmitter(std::string engine_id,
+                  std::vector<std::string> names,
+                  const MetricEmitterOptions& options,
+                  std::unique_ptr<MetricSink> sink);
+    ~MetricEmitter();
+
+    MetricEmitter(const MetricEmitter&) = delete;
+    MetricEmitter& operator=(const MetricEmitter&) = delete;
+
+    const std::vector<std::string>& names() const { return names_; }
+    const MetricEmitterOptions& options() const { return options_; }
+
+    // Whether a sample is wanted at `step`; callers compute values only then
+    bool due(uint64_t step) const;
+
+    // One value per name, in names() order; flushes when the ring fills
+    void record(uint64_t step, const double* values);
+
+    // Hand buffered samples to the sink
+    void flush();
+
+    uint64_t samplesRecorded() const { return recorded_; }
+    nlohmann::json describe() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::string engine_id_;
+    std::vector<std::string> names_;
+    MetricEmitterOptions options_;
+    std::unique_ptr<MetricSink> sink_;
+    Clock::time_point start_;
+    Clock::time_point last_sample_;
+    bool sampled_ = false;
+    uint64_t recorded_ = 0;
+    std::vector<uint64_t> steps_;
+    std::vector<double> seconds_;
+    std::vector<double> values_;
+};
+
 } // namespace dase
@@ -0,0 +1,312 @@
+/**
+ * Mission Graph Implementation
+ */
+
+#include "mission_graph.h"
+#include "batch_references.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace dase {
+
+namespace {
+
+using json = nlohmann::json;
+
+json errorResponse(const std::string& command, const std::string& error, const std::string& error_code) {
+    return {
+        {"status", "error"},
+        {"command", command},
+        {"error", error},
+        {"error_code", error_code}
+    };
+}
+
+} // namespace
+
+bool MissionGraph::build(const json& nodes, const ConcurrentFn& concurrent, std::string& error) {
+    nodes_.clear();
+    order_.clear();
+    if (!nodes.is_array() || nodes.empty()) {
+        error = "'nodes' must be a non-empty array of node objects";
+        return false;
+    }
+    if (nodes.size() > kMaxNodes) {
+        error = "Too many nodes. Max: " + std::to_string(kMaxNodes);
+        return false;
+    }
+
+    std::map<std::string, size_t> index_of;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const json& spec = nodes[i];
+        if (!spec.is_object() || !spec.contains("id") || !spec["id"].is_string()) {
+            error = "Node " + std::to_string(i) + " needs a string 'id'";
+            return false;
+        }
+        MissionGraphNode node;
+        node.id = spec["id"].get<std::string>();
+        if (!isGraphNodeId(node.id)) {
+            error = "Node id '" + node.id + "' must match [A-Za-z_][A-Za-z0-9_-]*";
+            return false;
+        }
+        if (!index_of.emplace(node.id, i).second) {
+            error = "Duplicate node id '" + node.id + "'";
+            return false;
+        }
+        if (!spec.contains("command") || !spec["command"].is_string()) {
+            error = "Node '" + node.id + "' needs a string 'command'";
+            return false;
+        }
+        if (spec.contains("params") && !spec["params"].is_object()) {
+            error = "Node '" + node.id + "': 'params' must be an object";
+            return false;
+        }
+        if (spec.contains("threads") && (!spec["threads"].is_number_integer() || spec["threads"].get<int>() < 0)) {
+            error = "Node '" + node.id + "': 'threads' must be a non-negative integer";
+            return false;
+        }
+        if (spec.contains("memory_mb") && (!spec["memory_mb"].is_number() || spec["memory_mb"].get<double>() < 0.0)) {
+            error = "Node '" + node.id + "': 'memory_mb' must be a non-negative number";
+            return false;
+        }
+        const std::string name = spec["command"].get<std::string>();
+        node.command = {{"command", name}, {"params", spec.value("params", json::object())}};
+        node.threads = spec.value("threads", 0);
+        node.memory_bytes = static_cast<uint64_t>(spec.value("memory_mb", 0.0) * 1024.0 * 1024.0);
+        node.exclusive = !concurrent(name);
+        nodes_.push_back(std::move(node));
+    }
+
+    std::set<std::string> ids;
+    for (const auto& entry : index_of) {
+        ids.insert(entry.first);
+    }
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        MissionGraphNode& node = nodes_[i];
+        std::set<std::string> named;
+        const json& spec = nodes[i];
+        if (spec.contains("depends_on")) {
+            if (!spec["depends_on"].is_array()) {
+                error = "Node '" + node.id + "': 'depends_on' must be an array of node ids";
+                return false;
+            }
+            for (const auto& dep : spec["depends_on"]) {
+                if (!dep.is_string() || !ids.count(dep.get<std::string>())) {
+                    error = "Node '" + node.id + "' depends on unknown node " + dep.dump();
+                    return false;
+                }
+                named.insert(dep.get<std::string>());
+            }
+        }
+        collectGraphReferences(node.command["params"], ids, named);
+        if (named.count(node.id)) {
+            error = "Node '" + node.id + "' depends on itself";
+            return false;
+        }
+        for (const auto& dep : named) {
+            node.depends_on.push_back(index_of[dep]);
+        }
+    }
+
+    // Kahn's algorithm, lowest declaration index first among the ready nodes
+    std::vector<size_t> waiting(nodes_.size());
+    std::vector<std::vector<size_t>> dependents(nodes_.size());
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        waiting[i] = nodes_[i].depends_on.size();
+        for (size_t dep : nodes_[i].depends_on) {
+            dependents[dep].push_back(i);
+        }
+    }
+    std::set<size_t> ready;
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (waiting[i] == 0) ready.insert(i);
+    }
+    while (!ready.empty()) {
+        const size_t i = *ready.begin();
+        ready.erase(ready.begin());
+        order_.push_back(i);
+        for (size_t dependent : dependents[i]) {
+            if (--waiting[dependent] == 0) ready.insert(dependent);
+        }
+    }
+    if (order_.size() != nodes_.size()) {
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            if (waiting[i] > 0) {
+                error = "Dependency cycle through node '" + nodes_[i].id + "'";
+                break;
+            }
+        }
+        nodes_.clear();
+        order_.clear();
+        return false;
+    }
+    return true;
+}
+
+std::vector<json> MissionGraph::run(const Runner& runner, const MissionGraphLimits& limits) {
+    enum class NodeState { Pending, Running, Succeeded, Failed, Skipped };
+
+    const size_t n = nodes_.size();
+    const int capacity = std::max(1, limits.threads);
+    std::vector<json> responses(n);
+    std::vector<NodeState> states(n, NodeState::Pending);
+    stats_ = MissionGraphStats();
+
+    std::mutex mutex;   // Guards states, responses of unfinished nodes and the counters
+    std::condition_variable changed;
+    size_t running = 0;
+    int threads_in_use = 0;
+    uint64_t memory_in_use = 0;
+    bool exclusive_running = false;
+    bool stopped = false;
+    std::vector<std::thread> workers;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto sinceStart = [&t0] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    };
+    const auto skip = [&](size_t i, const std::string& why, const std::string& code) {
+        states[i] = NodeState::Skipped;
+        stats_.skipped++;
+        responses[i] = {
+            {"status", "skipped"},
+            {"command", nodes_[i].command["command"]},
+            {"error", why},
+            {"error_code", code}
+        };
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        // Skip what can no longer run; order_ puts dependencies first, so
+        // one pass reaches every descendant of a failure
+        for (size_t i : order_) {
+            if (states[i] != NodeState::Pending) continue;
+            if (stopped) {
+                skip(i, "Not started: an earlier node failed", "GRAPH_STOPPED");
+                continue;
+            }
+            for (size_t dep : nodes_[i].depends_on) {
+                if (states[dep] == NodeState::Failed || states[dep] == NodeState::Skipped) {
+                    skip(i, "Dependency '" + nodes_[dep].id + "' did not succeed", "DEPENDENCY_FAILED");
+                    break;
+                }
+            }
+        }
+
+        // Start ready nodes in dependency order while they fit
+        for (size_t i : order_) {
+            if (states[i] != NodeState::Pending) continue;
+            const MissionGraphNode& node = nodes_[i];
+            const bool ready = std::all_of(node.depends_on.begin(), node.depends_on.end(),
+                                           [&states](size_t dep) { return states[dep] == NodeState::Succeeded; });
+            if (!ready) continue;
+
+            const int tokens = node.threads > 0 ? std::min(node.threads, capacity) : 1;
+            const uint64_t memory = limits.memory_bytes > 0 ? std::min(node.memory_bytes, limits.memory_bytes)
+                                                            : node.memory_bytes;
+            const bool fits = !exclusive_running && (!node.exclusive || running == 0) &&
+                              (limits.max_concurrent == 0 || running < limits.max_concurrent) &&
+                              threads_in_use + tokens <= capacity &&
+                              (limits.memory_bytes == 0 || memory_in_use + memory <= limits.memory_bytes);
+            if (!fits) break;
+
+            states[i] = NodeState::Running;
+            running++;
+            threads_in_use += tokens;
+            memory_in_use += memory;
+            exclusive_running = node.exclusive;
+            stats_.executed++;
+            stats_.peak_running = std::max(stats_.peak_running, running);
+            stats_.peak_threads = std::max(stats_.peak_threads, threads_in_use);
+            stats_.peak_memory_bytes = std::max(stats_.peak_memory_bytes, memory_in_use);
+
+            // Finished dependencies' responses no longer change
+            std::map<std::string, const json*> inputs;
+            for (size_t dep : node.depends_on) {
+                inputs[nodes_[dep].id] = &responses[dep];
+            }
+            workers.emplace_back([&, i, tokens, memory, inputs = std::move(inputs)] {
+                const MissionGraphNode& self = nodes_[i];
+                const double started = sinceStart();
+                json command = self.command;
+                json response;
+                std::string error;
+                if (!resolveGraphReferences(command["params"], inputs, error)) {
+                    response = errorResponse(command["command"], error, "INVALID_REFERENCE");
+                } else {
+#ifdef _OPENMP
+                    if (self.threads > 0) {
+                        omp_set_num_threads(tokens);   // Per-thread ICV: this node's teams only
+                    }
+#endif
+                    try {
+                        response = runner(self, command);
+                    } catch (const std::exception& e) {
+                        response = errorResponse(command["command"], std::string("Exception: ") + e.what(),
+                                                 "INTERNAL_ERROR");
+                    } catch (...) {
+                        response = errorResponse(command["command"], "Unknown exception", "INTERNAL_ERROR");
+                    }
+                    if (!response.is_object()) {
+                        response = errorResponse(command["command"], "Node returned no response", "INTERNAL_ERROR");
+                    }
+                }
+                const double finished = sinceStart();
+                const bool ok = response.value("status", "") == "success";
+                response["started_ms"] = started;
+                response["wall_ms"] = finished - started;
+
+                std::lock_guard<std::mutex> guard(mutex);
+                responses[i] = std::move(response);
+                states[i] = ok ? NodeState::Succeeded : NodeState::Failed;
+                if (!ok) {
+                    stats_.failed++;
+                    stopped = stopped || limits.stop_on_error;
+                }
+                running--;
+                threads_in_use -= tokens;
+                memory_in_use -= memory;
+                if (self.exclusive) {
+                    exclusive_running = false;
+                }
+                changed.notify_all();
+            });
+        }
+
+        if (running == 0) {
+            // Every node has finished or been skipped: with nothing running,
+            // the first ready node always fits
+            break;
+        }
+        changed.wait(lock);
+    }
+    lock.unlock();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        json depends_on = json::array();
+        for (size_t dep : nodes_[i].depends_on) {
+            depends_on.push_back(nodes_[dep].id);
+        }
+        responses[i]["id"] = nodes_[i].id;
+        responses[i]["index"] = i;
+        responses[i]["depends_on"] = std::move(depends_on);
+    }
+    return responses;
+}
+
+} // namespace dase
@@ -0,0 +1,112 @@
+/**
+ * Mission Graph - Commands with dependencies, run concurrently
+ *
+ * A batch runs its commands one after another.  run_graph takes the
+ * commands as the nodes of a dependency graph instead:
+ *
+ *   {"id": "run_a", "command": "run_mission",
+ *    "params": {"engine_id": "$make_a.engine_id", "num_steps": 1000},
+ *    "depends_on": ["seed_a"], "threads": 4, "memory_mb": 256}
+ *
+ * A node depends on the nodes listed in depends_on and on every node its
+ * params refer to ("$<id>.<key>", see batch_references.h).  Declaration
+ * order does not matter; a cycle rejects the graph.
+ *
+ * run() starts each node once all its dependencies have succeeded, on a
+ * thread of its own, as long as
+ *
+ *   - the thread tokens held stay within the process thread budget: a node
+ *     takes `threads` tokens (1 without the hint) and runs with `threads`
+ *     as its OMP team, so the engine's thread lease asks for that width;
+ *   - the memory hints of the running nodes stay within the memory limit
+ *     (unlimited by default);
+ *   - fewer than max_concurrent nodes run (0 = no limit);
+ *   - no exclusive node runs.  Commands that touch state shared across
+ *     engines (streams, analysis tools, router settings) are exclusive:
+ *     they start once every running node has finished, and nothing starts
+ *     beside them.
+ *
+ * A hint larger than its limit is clamped to it, so the node runs alone
+ * rather than never.  Ready nodes start in dependency order; one that does
+ * not fit holds back the nodes after it, so wide nodes are not starved.
+ *
+ * A node whose dependency failed (or was skipped) is skipped.  With
+ * stop_on_error, a failure also skips every node not yet started.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+
+struct MissionGraphNode {
+    std::string id;
+    nlohmann::json command;          // {"command": ..., "params": {...}}
+    std::vector<size_t> depends_on;  // Explicit and referenced, by index
+    int threads = 0;                 // Team width hint (0: none)
+    uint64_t memory_bytes = 0;       // Memory hint (0: none)
+    bool exclusive = false;          // Runs with no other node
+};
+
+struct MissionGraphLimits {
+    int threads = 1;                 // Thread tokens (the process thread budget)
+    uint64_t memory_bytes = 0;       // Memory hints running at once (0: unlimited)
+    size_t max_concurrent = 0;       // Nodes running at once (0: no limit)
+    bool stop_on_error = true;
+};
+
+struct MissionGraphStats {
+    size_t executed = 0;             // Nodes started
+    size_t failed = 0;
+    size_t skipped = 0;
+    size_t peak_running = 0;
+    int peak_threads = 0;
+    uint64_t peak_memory_bytes = 0;
+};
+
+class MissionGraph {
+public:
+    static constexpr size_t kMaxNodes = 1024;
+
+    // Whether a command may run beside other nodes (false: exclusive)
+    using ConcurrentFn = std::function<bool(const std::string& command)>;
+    // Runs one node's command, references resolved, on the node's thread
+    using Runner = std::function<nlohmann::json(const MissionGraphNode& node, const nlohmann::json& command)>;
+
+    /**
+     * Parse the "nodes" array of a run_graph request
+     *
+     * @return false with `error` set for a malformed node, a duplicate or
+     *         unknown id, or a dependency cycle
+     */
+    bool build(const nlohmann::json& nodes, const ConcurrentFn& concurrent, std::string& error);
+
+    const std::vector<MissionGraphNode>& nodes() const { return nodes_; }
+    // Node indices, every node after its dependencies
+    const std::vector<size_t>& order() const { return order_; }
+
+    /**
+     * Run every node; blocks until all have finished or been skipped
+     *
+     * @return One response per node, in declaration order, each with "id",
+     *         "index", "depends_on" and, for nodes that ran, "started_ms"
+     *         (since the graph started) and "wall_ms".  Skipped nodes have
+     *         status "skipped".
+     */
+    std::vector<nlohmann::json> run(const Runner& runner, const MissionGraphLimits& limits);
+
+    MissionGraphStats lastStats() const { return stats_; }
+
+private:
+    std::vector<MissionGraphNode> nodes_;
+    std::vector<size_t> order_;
+    MissionGraphStats stats_;
+};
+
+} // namespace dase
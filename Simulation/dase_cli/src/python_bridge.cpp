@@ -8,12 +8,18 @@
 #include <fstream>
 #include <sstream>
 #include <array>
+#include <cstdlib>
 
 #ifdef _WIN32
 #include <windows.h>
 #define popen _popen
 #define pclose _pclose
 #else
+#include <csignal>
+#include <cerrno>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #endif
 
@@ -226,6 +232,22 @@ std::string PythonBridge::buildCommandLine(
     return cmd.str();
 }
 
+std::vector<std::string> PythonBridge::buildArguments(const PythonAnalysisConfig& config) {
+    // Same mapping as buildCommandLine, without shell quoting
+    std::vector<std::string> argv;
+    for (const auto& [key, value] : config.args) {
+        if (key == "positional") {
+            argv.push_back(value);
+        } else {
+            argv.push_back("--" + key);
+            if (!value.empty()) {
+                argv.push_back(value);
+            }
+        }
+    }
+    return argv;
+}
+
 std::vector<std::string> PythonBridge::findGeneratedFiles(
     const std::string& output_dir,
     const std::vector<std::string>& extensions
@@ -253,5 +275,272 @@ std::vector<std::string> PythonBridge::findGeneratedFiles(
     return files;
 }
 
+PythonWorker::PythonWorker(std::string python_executable, std::string worker_script)
+    : python_executable_(std::move(python_executable))
+    , worker_script_(std::move(worker_script)) {}
+
+PythonWorker::~PythonWorker() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop();
+}
+
+bool PythonWorker::run(
+    const std::string& state_json_path,
+    const PythonAnalysisConfig& config,
+    PythonAnalysisResult& result
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // A worker that died (or was never started) gets one fresh start
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (!running_ && !start()) {
+            return false;
+        }
+
+        std::vector<std::string> argv = {state_json_path};
+        for (auto& arg : PythonBridge::buildArguments(config)) {
+            argv.push_back(std::move(arg));
+        }
+        const nlohmann::json request = {{"script", config.script_path}, {"argv", argv}};
+
+        std::string line;
+        if (!writeAll(request.dump() + "\n") || !readLine(line)) {
+            stop();
+            continue;
+        }
+        const nlohmann::json response = nlohmann::json::parse(line, nullptr, false);
+        if (response.is_discarded()) {
+            stop();
+            continue;
+        }
+
+        result.exit_code = response.value("exit_code", -1);
+        result.success = (result.exit_code == 0);
+        result.stdout_output = response.value("stdout", "");
+        result.stderr_output = response.value("stderr", "");
+        result.error_message.clear();
+        result.generated_files.clear();
+        if (!config.output_dir.empty() && fs::exists(config.output_dir)) {
+            result.generated_files = PythonBridge::findGeneratedFiles(config.output_dir);
+        }
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.execution_time_ms = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count());
+        return true;
+    }
+    return false;
+}
+
+std::string PythonWorker::findWorkerScript() {
+    if (const char* path = std::getenv("DASE_ANALYSIS_WORKER")) {
+        return fs::exists(path) ? std::string(path) : std::string();
+    }
+    for (const char* candidate : {"analysis_worker.py", "analysis/analysis_worker.py",
+                                  "../analysis/analysis_worker.py", "Simulation/analysis/analysis_worker.py"}) {
+        std::error_code ec;
+        if (fs::exists(candidate, ec)) {
+            return candidate;
+        }
+    }
+    return "";
+}
+
+#ifdef _WIN32
+
+bool PythonWorker::start() {
+    SECURITY_ATTRIBUTES sa{};
+    sa.nLength = sizeof(sa);
+    sa.bInheritHandle = TRUE;
+
+    HANDLE child_in_read = nullptr, child_in_write = nullptr;
+    HANDLE child_out_read = nullptr, child_out_write = nullptr;
+    if (!CreatePipe(&child_in_read, &child_in_write, &sa, 0)) {
+        return false;
+    }
+    if (!CreatePipe(&child_out_read, &child_out_write, &sa, 0)) {
+        CloseHandle(child_in_read);
+        CloseHandle(child_in_write);
+        return false;
+    }
+    SetHandleInformation(child_in_write, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(child_out_read, HANDLE_FLAG_INHERIT, 0);
+
+    STARTUPINFOA si{};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = child_in_read;
+    si.hStdOutput = child_out_write;
+    si.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+
+    PROCESS_INFORMATION pi{};
+    std::string cmd_line = "\"" + python_executable_ + "\" -u \"" + worker_script_ + "\"";
+    const BOOL ok = CreateProcessA(nullptr, cmd_line.data(), nullptr, nullptr, TRUE,
+                                   CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi);
+    CloseHandle(child_in_read);
+    CloseHandle(child_out_write);
+    if (!ok) {
+        CloseHandle(child_in_write);
+        CloseHandle(child_out_read);
+        return false;
+    }
+    CloseHandle(pi.hThread);
+
+    process_ = pi.hProcess;
+    to_child_ = child_in_write;
+    from_child_ = child_out_read;
+    read_buffer_.clear();
+    running_ = true;
+    return true;
+}
+
+void PythonWorker::stop() {
+    if (to_child_) CloseHandle(to_child_);      // EOF ends the worker's loop
+    if (process_) {
+        if (WaitForSingleObject(process_, 2000) != WAIT_OBJECT_0) {
+            TerminateProcess(process_, 1);
+        }
+        CloseHandle(process_);
+    }
+    if (from_child_) CloseHandle(from_child_);
+    process_ = to_child_ = from_child_ = nullptr;
+    running_ = false;
+}
+
+bool PythonWorker::writeAll(const std::string& data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        DWORD written = 0;
+        if (!WriteFile(to_child_, data.data() + offset, static_cast<DWORD>(data.size() - offset), &written, nullptr)) {
+            return false;
+        }
+        offset += written;
+    }
+    return true;
+}
+
+bool PythonWorker::readLine(std::string& line) {
+    while (true) {
+        const size_t newline = read_buffer_.find('\n');
+        if (newline != std::string::npos) {
+            line.assign(read_buffer_, 0, newline);
+            read_buffer_.erase(0, newline + 1);
+            return true;
+        }
+        char buffer[4096];
+        DWORD read = 0;
+        if (!ReadFile(from_child_, buffer, sizeof(buffer), &read, nullptr) || read == 0) {
+            return false;
+        }
+        read_buffer_.append(buffer, read);
+    }
+}
+
+#else
+
+bool PythonWorker::start() {
+    int to_child[2];
+    int from_child[2];
+    if (pipe(to_child) != 0) {
+        return false;
+    }
+    if (pipe(from_child) != 0) {
+        close(to_child[0]);
+        close(to_child[1]);
+        return false;
+    }
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        for (int fd : {to_child[0], to_child[1], from_child[0], from_child[1]}) close(fd);
+        return false;
+    }
+    if (pid == 0) {
+        dup2(to_child[0], STDIN_FILENO);
+        dup2(from_child[1], STDOUT_FILENO);
+        for (int fd : {to_child[0], to_child[1], from_child[0], from_child[1]}) close(fd);
+        execlp(python_executable_.c_str(), python_executable_.c_str(), "-u", worker_script_.c_str(),
+               static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(to_child[0]);
+    close(from_child[1]);
+    fcntl(to_child[1], F_SETFD, FD_CLOEXEC);
+    fcntl(from_child[0], F_SETFD, FD_CLOEXEC);
+    pid_ = pid;
+    to_child_ = to_child[1];
+    from_child_ = from_child[0];
+    read_buffer_.clear();
+    running_ = true;
+    return true;
+}
+
+void PythonWorker::stop() {
+    if (to_child_ >= 0) close(to_child_);       // EOF ends the worker's loop
+    if (from_child_ >= 0) close(from_child_);
+    if (pid_ > 0) {
+        // Give a script in flight 2 s to notice EOF before killing it
+        int status = 0;
+        bool exited = false;
+        for (int i = 0; i < 200 && !exited; ++i) {
+            exited = waitpid(pid_, &status, WNOHANG) != 0;
+            if (!exited) usleep(10000);
+        }
+        if (!exited) {
+            kill(pid_, SIGKILL);
+            waitpid(pid_, &status, 0);
+        }
+    }
+    pid_ = to_child_ = from_child_ = -1;
+    running_ = false;
+}
+
+bool PythonWorker::writeAll(const std::string& data) {
+    // A dead worker must fail the write, not raise SIGPIPE in the CLI
+    sigset_t pipe_set, previous;
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, &previous);
+
+    bool ok = true;
+    size_t offset = 0;
+    while (offset < data.size()) {
+        const ssize_t written = write(to_child_, data.data() + offset, data.size() - offset);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) {
+            ok = false;
+            break;
+        }
+        offset += static_cast<size_t>(written);
+    }
+    if (!ok && errno == EPIPE) {
+        const timespec no_wait = {0, 0};
+        sigtimedwait(&pipe_set, nullptr, &no_wait);
+    }
+    pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+    return ok;
+}
+
+bool PythonWorker::readLine(std::string& line) {
+    while (true) {
+        const size_t newline = read_buffer_.find('\n');
+        if (newline != std::string::npos) {
+            line.assign(read_buffer_, 0, newline);
+            read_buffer_.erase(0, newline + 1);
+            return true;
+        }
+        char buffer[4096];
+        const ssize_t got = read(from_child_, buffer, sizeof(buffer));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) {
+            return false;
+        }
+        read_buffer_.append(buffer, static_cast<size_t>(got));
+    }
+}
+
+#endif
+
 } // namespace python
 } // namespace dase
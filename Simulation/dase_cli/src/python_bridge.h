@@ -6,6 +6,10 @@
  * - analyze_igsoa_2d.py
  * - plot_satp_state.py
  * - compute_autocorrelation.py
+ *
+ * Scripts run either in a fresh interpreter per call (popen) or in a
+ * PythonWorker: one long-lived interpreter running analysis_worker.py,
+ * which keeps numpy / scipy / matplotlib imported between calls.
  */
 
 #pragma once
@@ -13,6 +17,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
 #include "json.hpp"
 
 namespace dase {
@@ -24,6 +29,7 @@ struct PythonAnalysisConfig {
     std::string output_dir = "analysis_output";
     std::map<std::string, std::string> args;  // Command-line arguments
     int timeout_ms = 120000;  // 2 minutes default
+    bool persistent = true;   // Use the shared PythonWorker when it can start
 };
 
 struct PythonAnalysisResult {
@@ -93,6 +99,11 @@ public:
     );
 
 private:
+    friend class PythonWorker;
+
+    // Script arguments after the state file, as argv entries
+    static std::vector<std::string> buildArguments(const PythonAnalysisConfig& config);
+
     static std::string buildCommandLine(
         const std::string& script_path,
         const std::string& state_json_path,
@@ -105,5 +116,58 @@ private:
     );
 };
 
+/**
+ * Long-lived interpreter running analysis_worker.py
+ *
+ * Started on first use and kept until destruction; one script runs at a
+ * time.  If the worker dies it is restarted on the next call.
+ */
+class PythonWorker {
+public:
+    PythonWorker(std::string python_executable, std::string worker_script);
+    ~PythonWorker();
+
+    PythonWorker(const PythonWorker&) = delete;
+    PythonWorker& operator=(const PythonWorker&) = delete;
+
+    /**
+     * Run a script against a state file, like PythonBridge::runAnalysisScript
+     *
+     * @return false (result untouched) if the worker cannot be started or
+     *         dies mid-request; the caller may fall back to popen
+     */
+    bool run(const std::string& state_json_path,
+             const PythonAnalysisConfig& config,
+             PythonAnalysisResult& result);
+
+    /**
+     * Locate analysis_worker.py: $DASE_ANALYSIS_WORKER, then the usual
+     * places relative to the working directory; empty if not found
+     */
+    static std::string findWorkerScript();
+
+private:
+    bool start();
+    void stop();
+    bool writeAll(const std::string& data);
+    bool readLine(std::string& line);
+
+    std::string python_executable_;
+    std::string worker_script_;
+    std::mutex mutex_;
+    bool running_ = false;
+    std::string read_buffer_;
+
+#ifdef _WIN32
+    void* process_ = nullptr;
+    void* to_child_ = nullptr;
+    void* from_child_ = nullptr;
+#else
+    int pid_ = -1;
+    int to_child_ = -1;
+    int from_child_ = -1;
+#endif
+};
+
 } // namespace python
 } // namespace dase
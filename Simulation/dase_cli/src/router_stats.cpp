@@ -0,0 +1,174 @@
+/**
+ * Router Stats Implementation
+ */
+
+#include "router_stats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dase {
+
+namespace {
+
+constexpr unsigned kSubBits = 5;                        // 32 exact values, then 16 per octave
+constexpr uint64_t kSubCount = uint64_t(1) << kSubBits;
+constexpr uint64_t kHalfCount = kSubCount / 2;
+constexpr size_t kBucketCount = kSubCount + (64 - kSubBits) * kHalfCount;
+
+unsigned floorLog2(uint64_t value) {
+    unsigned bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+}
+
+} // namespace
+
+size_t LatencyHistogram::bucketIndex(uint64_t ns) {
+    if (ns < kSubCount) {
+        return static_cast<size_t>(ns);
+    }
+    const unsigned exponent = floorLog2(ns);            // >= kSubBits
+    const unsigned shift = exponent - (kSubBits - 1);
+    const uint64_t sub = ns >> shift;                   // In [kHalfCount, kSubCount)
+    return static_cast<size_t>(kSubCount + (exponent - kSubBits) * kHalfCount + (sub - kHalfCount));
+}
+
+uint64_t LatencyHistogram::bucketValue(size_t index) {
+    if (index < kSubCount) {
+        return index;
+    }
+    const size_t offset = index - kSubCount;
+    const unsigned shift = static_cast<unsigned>(offset / kHalfCount) + 1;
+    const uint64_t sub = kHalfCount + offset % kHalfCount;
+    return (sub << shift) + (uint64_t(1) << (shift - 1));
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    if (buckets_.empty()) {
+        buckets_.assign(kBucketCount, 0);
+        min_ = ns;
+    }
+    ++buckets_[bucketIndex(ns)];
+    ++count_;
+    sum_ += static_cast<double>(ns);
+    min_ = std::min(min_, ns);
+    max_ = std::max(max_, ns);
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    const double clamped = std::min(100.0, std::max(0.0, p));
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * count_)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::min(max_, std::max(min_, bucketValue(i)));
+        }
+    }
+    return max_;
+}
+
+json LatencyHistogram::toJson() const {
+    const auto us = [](double ns) { return ns * 1.0e-3; };
+    if (count_ == 0) {
+        return {{"count", 0}};
+    }
+    return {
+        {"count", count_},
+        {"mean_us", us(sum_ / static_cast<double>(count_))},
+        {"min_us", us(static_cast<double>(min_))},
+        {"p50_us", us(static_cast<double>(percentile(50.0)))},
+        {"p90_us", us(static_cast<double>(percentile(90.0)))},
+        {"p99_us", us(static_cast<double>(percentile(99.0)))},
+        {"p999_us", us(static_cast<double>(percentile(99.9)))},
+        {"max_us", us(static_cast<double>(max_))},
+        {"total_ms", sum_ * 1.0e-6}
+    };
+}
+
+RouterStats::RouterStats() : since_(std::chrono::steady_clock::now()) {}
+
+void RouterStats::recordExecute(const std::string& command, uint64_t execute_ns, bool ok) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CommandStats& stats = commands_[command];
+    ++stats.calls;
+    if (!ok) {
+        ++stats.errors;
+    }
+    stats.execute.record(execute_ns);
+}
+
+void RouterStats::recordTransport(const std::string& command,
+                                  uint64_t parse_ns, uint64_t serialize_ns,
+                                  uint64_t bytes_in, uint64_t bytes_out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = commands_.find(command);
+    if (it == commands_.end()) {
+        return;
+    }
+    CommandStats& stats = it->second;
+    if (parse_ns > 0) stats.parse.record(parse_ns);
+    if (serialize_ns > 0) stats.serialize.record(serialize_ns);
+    stats.bytes_in += bytes_in;
+    stats.bytes_out += bytes_out;
+}
+
+void RouterStats::recordParseError(uint64_t bytes_in) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++parse_errors_;
+    parse_error_bytes_ += bytes_in;
+}
+
+json RouterStats::toJson(const std::string& command) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    json commands = json::object();
+    uint64_t calls = 0;
+    uint64_t errors = 0;
+    uint64_t bytes_in = parse_error_bytes_;
+    uint64_t bytes_out = 0;
+    for (const auto& entry : commands_) {
+        const CommandStats& stats = entry.second;
+        calls += stats.calls;
+        errors += stats.errors;
+        bytes_in += stats.bytes_in;
+        bytes_out += stats.bytes_out;
+        if (!command.empty() && entry.first != command) {
+            continue;
+        }
+        commands[entry.first] = {
+            {"calls", stats.calls},
+            {"errors", stats.errors},
+            {"bytes_in", stats.bytes_in},
+            {"bytes_out", stats.bytes_out},
+            {"parse", stats.parse.toJson()},
+            {"execute", stats.execute.toJson()},
+            {"serialize", stats.serialize.toJson()}
+        };
+    }
+    const double uptime_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - since_).count();
+    return {
+        {"since_reset_s", uptime_s},
+        {"commands", commands},
+        {"totals", {
+            {"calls", calls},
+            {"errors", errors},
+            {"parse_errors", parse_errors_},
+            {"bytes_in", bytes_in},
+            {"bytes_out", bytes_out}
+        }}
+    };
+}
+
+void RouterStats::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    commands_.clear();
+    parse_errors_ = 0;
+    parse_error_bytes_ = 0;
+    since_ = std::chrono::steady_clock::now();
+}
+
+} // namespace dase
@@ -0,0 +1,450 @@
+/**
+ * Segment Codec Implementation
+ */
+
+#include "segment_codec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#ifdef DASE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace dase {
+namespace protocol {
+
+namespace {
+
+constexpr uint8_t kFlagDelta = 1;
+
+size_t wordBytes(Quantization quantization) {
+    switch (quantization) {
+        case Quantization::F32: return 4;
+        case Quantization::F16: return 2;
+        default: return 8;
+    }
+}
+
+template <typename T>
+void putLE(uint8_t* out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<uint8_t>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+    }
+}
+
+template <typename T>
+T getLE(const uint8_t* bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+// IEEE binary16 of a double, round to nearest even (no float detour, so no
+// double rounding)
+uint16_t toHalf(double value) {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 48) & 0x8000);
+    const int exponent = static_cast<int>((bits >> 52) & 0x7FF);
+    const uint64_t mantissa = bits & ((uint64_t(1) << 52) - 1);
+    if (exponent == 0x7FF) {
+        return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+    }
+    const int e = exponent - 1023 + 15;
+    if (e >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00);
+    }
+    if (e <= 0) {
+        if (e < -10) {
+            return sign;
+        }
+        const uint64_t full = mantissa | (uint64_t(1) << 52);
+        const int shift = 43 - e;
+        uint64_t half = full >> shift;
+        const uint64_t rest = full & ((uint64_t(1) << shift) - 1);
+        const uint64_t halfway = uint64_t(1) << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1))) {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t half = sign | (static_cast<uint32_t>(e) << 10) | static_cast<uint32_t>(mantissa >> 42);
+    const uint64_t rest = mantissa & ((uint64_t(1) << 42) - 1);
+    const uint64_t halfway = uint64_t(1) << 41;
+    if (rest > halfway || (rest == halfway && (half & 1))) {
+        half++;   // A carry rolls into the exponent, up to infinity
+    }
+    return static_cast<uint16_t>(half);
+}
+
+double fromHalf(uint16_t half) {
+    const int exponent = (half >> 10) & 0x1F;
+    const int mantissa = half & 0x3FF;
+    double value;
+    if (exponent == 0) {
+        value = std::ldexp(static_cast<double>(mantissa), -24);
+    } else if (exponent == 31) {
+        value = mantissa ? std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::infinity();
+    } else {
+        value = std::ldexp(static_cast<double>(1024 + mantissa), exponent - 25);
+    }
+    return (half & 0x8000) ? -value : value;
+}
+
+void toWords(Quantization quantization, const double* values, size_t count, std::vector<uint8_t>& words) {
+    const size_t width = wordBytes(quantization);
+    words.resize(count * width);
+    uint8_t* out = words.data();
+    for (size_t i = 0; i < count; ++i, out += width) {
+        if (quantization == Quantization::F16) {
+            putLE<uint16_t>(out, toHalf(values[i]));
+        } else if (quantization == Quantization::F32) {
+            const float narrow = static_cast<float>(values[i]);
+            uint32_t bits = 0;
+            std::memcpy(&bits, &narrow, sizeof(bits));
+            putLE<uint32_t>(out, bits);
+        } else {
+            uint64_t bits = 0;
+            std::memcpy(&bits, &values[i], sizeof(bits));
+            putLE<uint64_t>(out, bits);
+        }
+    }
+}
+
+void fromWords(Quantization quantization, const uint8_t* words, size_t count, double* values) {
+    const size_t width = wordBytes(quantization);
+    for (size_t i = 0; i < count; ++i, words += width) {
+        if (quantization == Quantization::F16) {
+            values[i] = fromHalf(getLE<uint16_t>(words));
+        } else if (quantization == Quantization::F32) {
+            const uint32_t bits = getLE<uint32_t>(words);
+            float narrow = 0.0f;
+            std::memcpy(&narrow, &bits, sizeof(narrow));
+            values[i] = narrow;
+        } else {
+            const uint64_t bits = getLE<uint64_t>(words);
+            std::memcpy(&values[i], &bits, sizeof(bits));
+        }
+    }
+}
+
+// Byte plane b of every word together: the sign / exponent bytes of a
+// smooth field (and the zero high bytes of a delta) form long runs
+void shuffle(const std::vector<uint8_t>& words, size_t width, std::vector<uint8_t>& out) {
+    const size_t count = words.size() / width;
+    out.resize(words.size());
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t b = 0; b < width; ++b) {
+            out[b * count + i] = words[i * width + b];
+        }
+    }
+}
+
+void unshuffle(const std::vector<uint8_t>& planes, size_t width, std::vector<uint8_t>& out) {
+    const size_t count = planes.size() / width;
+    out.resize(planes.size());
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t b = 0; b < width; ++b) {
+            out[i * width + b] = planes[b * count + i];
+        }
+    }
+}
+
+void rleEncode(const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+    size_t i = 0;
+    size_t literal_start = 0;
+    auto flushLiterals = [&](size_t end) {
+        while (literal_start < end) {
+            const size_t length = std::min<size_t>(128, end - literal_start);
+            out.push_back(static_cast<uint8_t>(length - 1));
+            out.insert(out.end(), in.begin() + static_cast<std::ptrdiff_t>(literal_start),
+                       in.begin() + static_cast<std::ptrdiff_t>(literal_start + length));
+            literal_start += length;
+        }
+    };
+    while (i < in.size()) {
+        size_t run = 1;
+        while (i + run < in.size() && run < 130 && in[i + run] == in[i]) {
+            run++;
+        }
+        if (run >= 3) {
+            flushLiterals(i);
+            out.push_back(static_cast<uint8_t>(run + 125));
+            out.push_back(in[i]);
+            i += run;
+            literal_start = i;
+        } else {
+            i += run;
+        }
+    }
+    flushLiterals(in.size());
+}
+
+bool rleDecode(const uint8_t* in, size_t bytes, size_t expected, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(expected);
+    size_t i = 0;
+    while (i < bytes) {
+        const uint8_t control = in[i++];
+        if (control < 128) {
+            const size_t length = static_cast<size_t>(control) + 1;
+            if (i + length > bytes || out.size() + length > expected) {
+                return false;
+            }
+            out.insert(out.end(), in + i, in + i + length);
+            i += length;
+        } else {
+            const size_t length = static_cast<size_t>(control) - 125;
+            if (i >= bytes || out.size() + length > expected) {
+                return false;
+            }
+            out.insert(out.end(), length, in[i++]);
+        }
+    }
+    return out.size() == expected;
+}
+
+// Compress `planes` into `out`; false if the stage failed or did not shrink it
+bool compress(Compression compression, const std::vector<uint8_t>& planes, std::vector<uint8_t>& out) {
+    out.clear();
+    if (compression == Compression::Rle) {
+        rleEncode(planes, out);
+        return out.size() < planes.size();
+    }
+#ifdef DASE_HAVE_ZLIB
+    if (compression == Compression::Zlib) {
+        uLongf length = compressBound(static_cast<uLong>(planes.size()));
+        out.resize(static_cast<size_t>(length));
+        if (compress2(out.data(), &length, planes.data(), static_cast<uLong>(planes.size()), Z_DEFAULT_COMPRESSION) != Z_OK) {
+            return false;
+        }
+        out.resize(static_cast<size_t>(length));
+        return out.size() < planes.size();
+    }
+#endif
+    return false;
+}
+
+bool decompress(Compression compression, const uint8_t* in, size_t bytes, size_t expected,
+                std::vector<uint8_t>& out, std::string& error) {
+    if (compression == Compression::Rle) {
+        if (!rleDecode(in, bytes, expected, out)) {
+            error = "Corrupt run-length payload";
+            return false;
+        }
+        return true;
+    }
+#ifdef DASE_HAVE_ZLIB
+    if (compression == Compression::Zlib) {
+        out.resize(expected);
+        uLongf length = static_cast<uLongf>(expected);
+        if (uncompress(out.data(), &length, in, static_cast<uLong>(bytes)) != Z_OK || length != expected) {
+            error = "Corrupt zlib payload";
+            return false;
+        }
+        return true;
+    }
+#endif
+    error = "Compression " + std::to_string(static_cast<int>(compression)) + " is not available in this build";
+    return false;
+}
+
+} // namespace
+
+bool SegmentEncoding::parse(const nlohmann::json& spec, SegmentEncoding& out, std::string& error) {
+    out = SegmentEncoding();
+    if (!spec.is_object()) {
+        error = "'encoding' must be an object";
+        return false;
+    }
+    const std::string quantize = spec.value("quantize", std::string("f64"));
+    if (quantize == "f64") {
+        out.quantization = Quantization::F64;
+    } else if (quantize == "f32") {
+        out.quantization = Quantization::F32;
+    } else if (quantize == "f16") {
+        out.quantization = Quantization::F16;
+    } else {
+        error = "'quantize' must be \"f64\", \"f32\" or \"f16\"";
+        return false;
+    }
+    out.delta = spec.value("delta", false);
+    const std::string compression = spec.value("compression", std::string("none"));
+    if (compression == "none") {
+        out.compression = Compression::None;
+    } else if (compression == "rle") {
+        out.compression = Compression::Rle;
+    } else if (compression == "zlib") {
+        out.compression = Compression::Zlib;
+    } else {
+        error = "'compression' must be \"none\", \"rle\" or \"zlib\"";
+        return false;
+    }
+    if (!compressionAvailable(out.compression)) {
+        error = "Compression '" + compression + "' is not available in this build";
+        return false;
+    }
+    return true;
+}
+
+nlohmann::json SegmentEncoding::describe() const {
+    const char* quantize = quantization == Quantization::F16 ? "f16"
+                         : quantization == Quantization::F32 ? "f32" : "f64";
+    const char* name = compression == Compression::Rle ? "rle"
+                     : compression == Compression::Zlib ? "zlib" : "none";
+    return {{"quantize", quantize}, {"delta", delta}, {"compression", name}};
+}
+
+double quantize(Quantization quantization, double* values, size_t count) {
+    if (quantization == Quantization::F64) {
+        return 0.0;
+    }
+    double max_error = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const double original = values[i];
+        const double rounded = quantization == Quantization::F16
+            ? fromHalf(toHalf(original))
+            : static_cast<double>(static_cast<float>(original));
+        values[i] = rounded;
+        if (std::isfinite(original)) {
+            const double error = std::isfinite(rounded) ? std::fabs(rounded - original)
+                                                        : std::numeric_limits<double>::infinity();
+            if (error > max_error) {
+                max_error = error;
+            }
+        }
+    }
+    return max_error;
+}
+
+bool compressionAvailable(Compression compression) {
+    if (compression == Compression::Zlib) {
+#ifdef DASE_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    }
+    return true;
+}
+
+void SegmentEncoder::encode(uint32_t channel, const SegmentEncoding& encoding,
+                            const double* values, size_t count, std::vector<uint8_t>& out, bool key) {
+    const size_t width = wordBytes(encoding.quantization);
+    toWords(encoding.quantization, values, count, words_);
+
+    bool delta = false;
+    if (encoding.delta) {
+        auto it = previous_.find(channel);
+        delta = !key && it != previous_.end() &&
+                it->second.quantization == encoding.quantization && it->second.words.size() == words_.size();
+        Channel& previous = previous_[channel];
+        if (delta) {
+            // previous ^= current, then swap: words_ holds the XOR, the
+            // channel keeps this block for the next one
+            for (size_t i = 0; i < words_.size(); ++i) {
+                previous.words[i] ^= words_[i];
+            }
+            previous.words.swap(words_);
+        } else {
+            previous.quantization = encoding.quantization;
+            previous.words = words_;
+        }
+    } else {
+        // The decoder keeps every block; a later delta must not reach past
+        // this one to an older block
+        previous_.erase(channel);
+    }
+
+    Compression compression = encoding.compression;
+    const std::vector<uint8_t>* payload = &words_;
+    std::vector<uint8_t> packed;
+    if (compression != Compression::None) {
+        shuffle(words_, width, scratch_);
+        if (compress(compression, scratch_, packed)) {
+            payload = &packed;
+        } else {
+            compression = Compression::None;   // Incompressible: store the words
+        }
+    }
+
+    const size_t start = out.size();
+    out.resize(start + kCodecBlockHeaderBytes + payload->size());
+    uint8_t* header = out.data() + start;
+    header[0] = static_cast<uint8_t>(encoding.quantization);
+    header[1] = delta ? kFlagDelta : 0;
+    header[2] = static_cast<uint8_t>(compression);
+    header[3] = 0;
+    putLE<uint32_t>(header + 4, channel);
+    putLE<uint64_t>(header + 8, count);
+    putLE<uint64_t>(header + 16, payload->size());
+    if (!payload->empty()) {
+        std::memcpy(header + kCodecBlockHeaderBytes, payload->data(), payload->size());
+    }
+}
+
+bool SegmentDecoder::decode(const uint8_t* block, size_t bytes, std::vector<double>& values, std::string& error) {
+    if (bytes < kCodecBlockHeaderBytes) {
+        error = "Truncated codec block";
+        return false;
+    }
+    if (block[0] > static_cast<uint8_t>(Quantization::F16) || (block[1] & ~kFlagDelta) != 0 ||
+        block[2] > static_cast<uint8_t>(Compression::Zlib) || block[3] != 0) {
+        error = "Unknown codec block stage";
+        return false;
+    }
+    const auto quantization = static_cast<Quantization>(block[0]);
+    const bool delta = (block[1] & kFlagDelta) != 0;
+    const auto compression = static_cast<Compression>(block[2]);
+    const uint32_t channel = getLE<uint32_t>(block + 4);
+    const uint64_t count = getLE<uint64_t>(block + 8);
+    const uint64_t payload_bytes = getLE<uint64_t>(block + 16);
+    const size_t width = wordBytes(quantization);
+    if (payload_bytes != bytes - kCodecBlockHeaderBytes || count > (uint64_t(1) << 40)) {
+        error = "Codec block length mismatch";
+        return false;
+    }
+    const size_t expected = static_cast<size_t>(count) * width;
+    const uint8_t* payload = block + kCodecBlockHeaderBytes;
+
+    if (compression == Compression::None) {
+        if (payload_bytes != expected) {
+            error = "Codec block length mismatch";
+            return false;
+        }
+        words_.assign(payload, payload + expected);
+    } else {
+        std::vector<uint8_t> planes;
+        if (!decompress(compression, payload, static_cast<size_t>(payload_bytes), expected, planes, error)) {
+            return false;
+        }
+        unshuffle(planes, width, words_);
+    }
+
+    Channel& previous = previous_[channel];
+    if (delta) {
+        if (previous.quantization != quantization || previous.words.size() != words_.size() ||
+            (previous.words.empty() && !words_.empty())) {
+            error = "Delta block on channel " + std::to_string(channel) + " without its reference block";
+            return false;
+        }
+        for (size_t i = 0; i < words_.size(); ++i) {
+            words_[i] ^= previous.words[i];
+        }
+    }
+    previous.quantization = quantization;
+    previous.words = words_;
+
+    values.resize(static_cast<size_t>(count));
+    fromWords(quantization, words_.data(), values.size(), values.data());
+    return true;
+}
+
+} // namespace protocol
+} // namespace dase
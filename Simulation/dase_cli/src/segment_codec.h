@@ -0,0 +1,142 @@
+/**
+ * Segment Codec - Quantized, delta-coded and compressed float64 segments
+ *
+ * Successive snapshots of a slowly evolving field differ in few bits.  A
+ * SegmentEncoding shrinks each snapshot field before it goes on the wire
+ * (binary protocol frames, see binary_protocol.h) or into a snapshot file
+ * (snapshot_stream.h), in three optional stages:
+ *
+ *   quantize     f64 (lossless), f32 or f16 words; quantize() rounds the
+ *                values onto that grid beforehand and reports the largest
+ *                absolute error, so the encoding itself stays lossless
+ *   delta        XOR of each word with the same word of the previous block
+ *                on the same channel (one channel per snapshot field)
+ *   compression  "rle" (byte-plane shuffle + run-length coding, always
+ *                available) or "zlib" (byte-plane shuffle + deflate, builds
+ *                with DASE_HAVE_ZLIB)
+ *
+ * Block layout (all integers little-endian):
+ *
+ *   u8   quantization     0 = f64, 1 = f32, 2 = f16
+ *   u8   flags            bit 0: XOR-delta against the previous block
+ *   u8   compression      0 = none, 1 = rle, 2 = zlib
+ *   u8   reserved         0
+ *   u32  channel
+ *   u64  value count      n
+ *   u64  payload bytes    P
+ *   P bytes               payload
+ *
+ * A delta block needs the decoder to have seen the channel's previous
+ * block; the encoder writes a key block (no delta) whenever the channel is
+ * new, its count or quantization changed, or a key block is forced.
+ *
+ * Run-length payload: control byte c < 128 is followed by c + 1 literal
+ * bytes; c >= 128 by one byte repeated c - 125 times (3..130).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+namespace protocol {
+
+enum class Quantization : uint8_t {
+    F64 = 0,
+    F32 = 1,
+    F16 = 2
+};
+
+enum class Compression : uint8_t {
+    None = 0,
+    Rle = 1,
+    Zlib = 2
+};
+
+constexpr size_t kCodecBlockHeaderBytes = 24;
+
+struct SegmentEncoding {
+    Quantization quantization = Quantization::F64;
+    bool delta = false;
+    Compression compression = Compression::None;
+
+    // Whether blocks would hold the raw float64 values
+    bool isIdentity() const {
+        return quantization == Quantization::F64 && !delta && compression == Compression::None;
+    }
+
+    /**
+     * Parse {"quantize": "f64"|"f32"|"f16", "delta": bool,
+     *        "compression": "none"|"rle"|"zlib"}
+     *
+     * @return false with `error` set for unknown values or a compression
+     *         this build lacks
+     */
+    static bool parse(const nlohmann::json& spec, SegmentEncoding& out, std::string& error);
+
+    nlohmann::json describe() const;
+};
+
+/**
+ * Round `count` values in place onto the grid of `quantization`
+ *
+ * @return Largest absolute rounding error (infinite if a finite value
+ *         overflows the format)
+ */
+double quantize(Quantization quantization, double* values, size_t count);
+
+// Whether this build can write `compression`
+bool compressionAvailable(Compression compression);
+
+class SegmentEncoder {
+public:
+    /**
+     * Append the block of `count` values (already on the quantization grid)
+     * to `out`
+     *
+     * @param key Write a key block even if a delta block is possible
+     */
+    void encode(uint32_t channel, const SegmentEncoding& encoding,
+                const double* values, size_t count, std::vector<uint8_t>& out, bool key = false);
+
+    // Forget every channel (the next block of each is a key block)
+    void reset() { previous_.clear(); }
+
+private:
+    struct Channel {
+        Quantization quantization = Quantization::F64;
+        std::vector<uint8_t> words;
+    };
+    std::unordered_map<uint32_t, Channel> previous_;
+    std::vector<uint8_t> words_;
+    std::vector<uint8_t> scratch_;
+};
+
+class SegmentDecoder {
+public:
+    /**
+     * Decode one block of `bytes` bytes into `values`
+     *
+     * @return false with `error` set for a malformed block, an unknown
+     *         or unavailable stage, or a delta block without its reference
+     */
+    bool decode(const uint8_t* block, size_t bytes, std::vector<double>& values, std::string& error);
+
+    void reset() { previous_.clear(); }
+
+private:
+    struct Channel {
+        Quantization quantization = Quantization::F64;
+        std::vector<uint8_t> words;
+    };
+    std::unordered_map<uint32_t, Channel> previous_;
+    std::vector<uint8_t> words_;
+};
+
+} // namespace protocol
+} // namespace dase
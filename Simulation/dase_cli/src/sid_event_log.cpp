@@ -0,0 +1,217 @@
+/**
+ * SID Event Log Implementation
+ */
+
+#include "sid_event_log.h"
+
+#include <algorithm>
+
+namespace dase {
+
+uint32_t SidEventLog::StringPool::intern(const std::string& value) {
+    auto it = index.find(value);
+    if (it != index.end()) {
+        return it->second;
+    }
+    const uint32_t id = static_cast<uint32_t>(values.size());
+    values.push_back(value);
+    index.emplace(value, id);
+    return id;
+}
+
+void SidEventLog::configure(const Options& options) {
+    Options applied = options;
+    applied.capacity = std::max<size_t>(applied.capacity, 1);
+    if (applied.capacity != options_.capacity) {
+        // Keep the newest events, oldest first
+        const size_t keep = std::min(count_, applied.capacity);
+        std::vector<Record> ring;
+        ring.reserve(keep);
+        for (uint64_t id = next_id_ - keep; id < next_id_; ++id) {
+            ring.push_back(slot(id));
+        }
+        ring_ = std::move(ring);
+        head_ = 0;
+        count_ = keep;
+    }
+    options_ = applied;
+    compact();
+}
+
+bool SidEventLog::record(const std::string& rule_id, bool applied, const std::string& message,
+                         const nlohmann::json& metadata, double timestamp) {
+    if (options_.applied_only && !applied) {
+        return false;
+    }
+    Record record{};
+    record.rule = rules_.intern(rule_id);
+    record.message = messages_.intern(message);
+    record.metadata = internMetadata(record.rule, metadata);
+    record.applied = applied;
+    record.timestamp = timestamp;
+    push(record);
+    return true;
+}
+
+uint32_t SidEventLog::internMetadata(uint32_t rule, const nlohmann::json& metadata) {
+    // Only the rule's latest few are compared, so per-call metadata (an
+    // epsilon per event, say) costs a bounded search
+    auto& known = metadata_of_rule_[rule];
+    const size_t from = known.size() > kMetadataProbe ? known.size() - kMetadataProbe : 0;
+    for (size_t i = known.size(); i-- > from;) {
+        if (metadata_[known[i]] == metadata) {
+            return known[i];
+        }
+    }
+    const uint32_t id = static_cast<uint32_t>(metadata_.size());
+    metadata_.push_back(metadata);
+    known.push_back(id);
+    return id;
+}
+
+void SidEventLog::push(const Record& record) {
+    if (count_ < options_.capacity) {
+        ring_.push_back(record);   // Not yet wrapped: head_ is 0
+        count_++;
+    } else {
+        ring_[head_] = record;   // Overwrite the oldest
+        head_ = (head_ + 1) % ring_.size();
+    }
+    next_id_++;
+
+    // Compaction is O(retained events); at least a third of that many
+    // pushes pass between two, so it is amortized O(1)
+    if (pooledEntries() > 2 * pooled_after_compact_ + count_ + 1024) {
+        compact();
+    }
+}
+
+void SidEventLog::compact() {
+    StringPool rules;
+    StringPool messages;
+    std::vector<nlohmann::json> metadata;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> metadata_of_rule;
+    std::unordered_map<uint32_t, uint32_t> metadata_map;   // Old pool index -> new
+
+    for (uint64_t id = firstId(); id < next_id_; ++id) {
+        Record& record = ring_[(head_ + static_cast<size_t>(id - firstId())) % ring_.size()];
+        const uint32_t rule = rules.intern(rules_.values[record.rule]);
+        record.message = messages.intern(messages_.values[record.message]);
+        auto mapped = metadata_map.find(record.metadata);
+        if (mapped == metadata_map.end()) {
+            const uint32_t fresh = static_cast<uint32_t>(metadata.size());
+            metadata.push_back(std::move(metadata_[record.metadata]));
+            metadata_of_rule[rule].push_back(fresh);
+            mapped = metadata_map.emplace(record.metadata, fresh).first;
+        }
+        record.metadata = mapped->second;
+        record.rule = rule;
+    }
+
+    rules_ = std::move(rules);
+    messages_ = std::move(messages);
+    metadata_ = std::move(metadata);
+    metadata_of_rule_ = std::move(metadata_of_rule);
+    pooled_after_compact_ = pooledEntries();
+}
+
+SidEventLog::EventRef SidEventLog::at(uint64_t event_id) const {
+    const Record& record = slot(event_id);
+    return EventRef{event_id, rules_.values[record.rule], record.applied,
+                    messages_.values[record.message], metadata_[record.metadata], record.timestamp};
+}
+
+uint64_t SidEventLog::page(uint64_t cursor, size_t limit, std::vector<Event>& out) const {
+    out.clear();
+    cursor = std::max(cursor, firstId());
+    uint64_t end = next_id_;
+    if (cursor > end) {
+        cursor = end;
+    }
+    if (limit > 0 && end - cursor > limit) {
+        end = cursor + limit;
+    }
+    out.reserve(static_cast<size_t>(end - cursor));
+    for (uint64_t id = cursor; id < end; ++id) {
+        const EventRef ev = at(id);
+        out.push_back(Event{ev.event_id, ev.rule_id, ev.applied, ev.message, ev.metadata, ev.timestamp});
+    }
+    return end;
+}
+
+void SidEventLog::clear() {
+    ring_.clear();
+    head_ = 0;
+    count_ = 0;
+    rules_.clear();
+    messages_.clear();
+    metadata_.clear();
+    metadata_of_rule_.clear();
+    pooled_after_compact_ = 0;
+}
+
+nlohmann::json SidEventLog::eventsJson() const {
+    nlohmann::json events = nlohmann::json::array();
+    for (uint64_t id = firstId(); id < next_id_; ++id) {
+        const EventRef ev = at(id);
+        events.push_back({
+            {"event_id", ev.event_id},
+            {"rule_id", ev.rule_id},
+            {"applied", ev.applied},
+            {"message", ev.message},
+            {"metadata", ev.metadata},
+            {"timestamp", ev.timestamp}
+        });
+    }
+    return events;
+}
+
+nlohmann::json SidEventLog::optionsJson() const {
+    return {
+        {"capacity", options_.capacity},
+        {"applied_only", options_.applied_only},
+        {"first_event_id", firstId()},
+        {"next_event_id", next_id_},
+        {"retained", count_}
+    };
+}
+
+void SidEventLog::restore(const nlohmann::json& events) {
+    clear();
+    next_id_ = 0;
+    bool first = true;
+    for (const auto& saved : events) {
+        if (first) {
+            next_id_ = saved.value("event_id", uint64_t(0));
+            first = false;
+        }
+        Record record{};
+        record.rule = rules_.intern(saved.value("rule_id", ""));
+        record.message = messages_.intern(saved.value("message", ""));
+        record.metadata = internMetadata(record.rule, saved.value("metadata", nlohmann::json::object()));
+        record.applied = saved.value("applied", false);
+        record.timestamp = saved.value("timestamp", 0.0);
+        push(record);
+    }
+}
+
+bool SidEventLog::parseOptions(const nlohmann::json& params, Options& options, std::string& error) {
+    if (params.contains("capacity")) {
+        const auto& capacity = params["capacity"];
+        if (!capacity.is_number_integer() || capacity.get<int64_t>() <= 0) {
+            error = "capacity must be a positive integer";
+            return false;
+        }
+        options.capacity = static_cast<size_t>(capacity.get<uint64_t>());
+    }
+    if (params.contains("applied_only")) {
+        if (!params["applied_only"].is_boolean()) {
+            error = "applied_only must be a boolean";
+            return false;
+        }
+        options.applied_only = params["applied_only"].get<bool>();
+    }
+    return true;
+}
+
+} // namespace dase
@@ -0,0 +1,139 @@
+/**
+ * SID Event Log - Bounded per-engine log of rewrite events
+ *
+ * Every SID rewrite attempt (sid_rewrite, each rule of each sid_run_rewrites
+ * pass) may record an event.  Kept as full records in a vector, a long
+ * campaign grew the log without bound, so the log is a ring of the newest
+ * `capacity` events instead, with compact records: the rule ID and message
+ * are indices into interned string tables and the metadata is an index
+ * into a pool of distinct metadata objects (a rule's metadata is stored
+ * once, however many events it appears in).  The pools are compacted to
+ * the retained events when they outgrow them.
+ *
+ * Event IDs count every recorded event from 0 and are never reused, so they
+ * double as paging cursors: events [firstId(), nextId()) are retained, and
+ * a cursor older than firstId() resumes at the oldest one still held.
+ * With applied_only, attempts that applied nothing are not recorded (and
+ * take no ID).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+
+class SidEventLog {
+public:
+    static constexpr size_t kDefaultCapacity = 65536;
+
+    struct Options {
+        size_t capacity = kDefaultCapacity;   // Events retained, > 0
+        bool applied_only = false;
+    };
+
+    struct Event {
+        uint64_t event_id;
+        std::string rule_id;
+        bool applied;
+        std::string message;
+        nlohmann::json metadata;
+        double timestamp;
+    };
+
+    // A retained event in place; valid until the next record / configure
+    struct EventRef {
+        uint64_t event_id;
+        const std::string& rule_id;
+        bool applied;
+        const std::string& message;
+        const nlohmann::json& metadata;
+        double timestamp;
+    };
+
+    SidEventLog() = default;
+    explicit SidEventLog(const Options& options) { configure(options); }
+
+    // Apply options; a smaller capacity drops the oldest events
+    void configure(const Options& options);
+    const Options& options() const { return options_; }
+
+    // false when applied_only filtered the event out
+    bool record(const std::string& rule_id, bool applied, const std::string& message,
+                const nlohmann::json& metadata, double timestamp);
+
+    uint64_t firstId() const { return next_id_ - count_; }
+    uint64_t nextId() const { return next_id_; }
+    size_t size() const { return count_; }
+
+    // Requires firstId() <= event_id < nextId()
+    EventRef at(uint64_t event_id) const;
+
+    /**
+     * Retained events from `cursor` on, at most `limit` of them (0 = all).
+     * Returns the cursor of the following page.
+     */
+    uint64_t page(uint64_t cursor, size_t limit, std::vector<Event>& out) const;
+
+    // Drop every event; IDs continue from nextId()
+    void clear();
+
+    // Retained events, in the layout sid_rewrite_events returns
+    nlohmann::json eventsJson() const;
+    // Options plus first / next event ID and retained count
+    nlohmann::json optionsJson() const;
+    // Replace the log with saved events (consecutive IDs, as eventsJson gave)
+    void restore(const nlohmann::json& events);
+
+    static bool parseOptions(const nlohmann::json& params, Options& options, std::string& error);
+
+private:
+    struct Record {
+        uint32_t rule;
+        uint32_t message;
+        uint32_t metadata;
+        bool applied;
+        double timestamp;
+    };
+
+    struct StringPool {
+        std::vector<std::string> values;
+        std::unordered_map<std::string, uint32_t> index;
+
+        uint32_t intern(const std::string& value);
+        void clear() { values.clear(); index.clear(); }
+    };
+
+    Options options_;
+    std::vector<Record> ring_;    // Grows to options_.capacity
+    size_t head_ = 0;             // Slot of the oldest event
+    size_t count_ = 0;
+    uint64_t next_id_ = 0;
+
+    StringPool rules_;
+    StringPool messages_;
+    std::vector<nlohmann::json> metadata_;
+    // rule -> metadata pool entries recorded with it (usually one)
+    std::unordered_map<uint32_t, std::vector<uint32_t>> metadata_of_rule_;
+    size_t pooled_after_compact_ = 0;
+
+    static constexpr size_t kMetadataProbe = 4;
+
+    size_t pooledEntries() const {
+        return rules_.values.size() + messages_.values.size() + metadata_.size();
+    }
+
+    const Record& slot(uint64_t event_id) const {
+        return ring_[(head_ + static_cast<size_t>(event_id - firstId())) % ring_.size()];
+    }
+    uint32_t internMetadata(uint32_t rule, const nlohmann::json& metadata);
+    void push(const Record& record);
+    void compact();
+};
+
+} // namespace dase
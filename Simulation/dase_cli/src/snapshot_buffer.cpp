@@ -0,0 +1,88 @@
+/**
+ * Snapshot Buffer Implementation
+ */
+
+#include "snapshot_buffer.h"
+
+#include <algorithm>
+
+namespace dase {
+
+SnapshotBuffer::Lease& SnapshotBuffer::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        frame_ = other.frame_;
+        other.frame_ = nullptr;
+    }
+    return *this;
+}
+
+void SnapshotBuffer::Lease::release() {
+    if (frame_) {
+        frame_->readers.fetch_sub(1);
+        frame_ = nullptr;
+    }
+}
+
+SnapshotBuffer::SnapshotBuffer(const SnapshotSelection& selection, size_t frames, int publish_interval)
+    : selection_(selection), publish_interval_(publish_interval) {
+    frames = std::min(std::max(frames, kMinFrames), kMaxFrames);
+    frames_.reserve(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        auto frame = std::make_unique<Frame>();
+        frame->fields.assign(selection_.fields().size(), std::vector<double>(selection_.count()));
+        frames_.push_back(std::move(frame));
+    }
+}
+
+SnapshotBuffer::Frame* SnapshotBuffer::beginPublish() {
+    // Only this thread moves latest_, so it cannot change during the scan
+    const Frame* latest = latest_.load();
+    for (const auto& frame : frames_) {
+        if (frame.get() != latest && frame->readers.load() == 0) {
+            return frame.get();
+        }
+    }
+    skipped_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void SnapshotBuffer::endPublish(Frame* frame, uint64_t step, double simulated_time) {
+    frame->step = step;
+    frame->sequence = ++sequence_;
+    frame->simulated_time = simulated_time;
+    latest_.store(frame);
+    published_.fetch_add(1, std::memory_order_relaxed);
+}
+
+SnapshotBuffer::Lease SnapshotBuffer::lease() {
+    for (;;) {
+        Frame* frame = latest_.load();
+        if (!frame) {
+            return Lease();
+        }
+        frame->readers.fetch_add(1);
+        if (latest_.load() == frame) {
+            return Lease(frame);
+        }
+        // Published meanwhile: the writer may be refilling this frame
+        frame->readers.fetch_sub(1);
+    }
+}
+
+size_t SnapshotBuffer::memoryBytes() const {
+    return frames_.size() * selection_.fields().size() * selection_.count() * sizeof(double);
+}
+
+nlohmann::json SnapshotBuffer::describe() const {
+    return {
+        {"selection", selection_.describe()},
+        {"frames", frames_.size()},
+        {"publish_interval", publish_interval_},
+        {"published", published()},
+        {"skipped", skipped()},
+        {"bytes", memoryBytes()}
+    };
+}
+
+} // namespace dase
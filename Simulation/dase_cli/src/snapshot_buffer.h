@@ -0,0 +1,112 @@
+/**
+ * Snapshot Buffer - Lock-free published state for readers beside a job
+ *
+ * get_state reads the engine in place, so it holds the engine's lock (see
+ * job_manager.h) and waits for a running job's chunk, which then waits for
+ * the extraction and serialization.  With buffer_state, runMission instead
+ * copies the selected fields (a SnapshotSelection) into one of a small
+ * pool of preallocated frames at step boundaries and publishes it with an
+ * atomic pointer swap.  read_snapshot leases the latest complete frame
+ * without taking the engine's lock, so neither side waits for the other.
+ *
+ *   Writer (the stepping thread, one at a time per engine):
+ *     beginPublish()   a frame that is neither the latest nor leased, or
+ *                      nullptr: every other frame is still being read, and
+ *                      the publication is skipped (counted)
+ *     endPublish()     stamp the frame and make it the latest
+ *
+ *   Readers (any thread):
+ *     lease()          the latest frame, pinned until the Lease goes away
+ *
+ * A reader pins a frame by raising its reader count, then checks that the
+ * frame is still the latest; if the writer published meanwhile it unpins
+ * and retries.  The writer only reuses frames with no readers that are not
+ * the latest, so a pinned frame never changes under its reader (the
+ * sequentially consistent increment / swap order rules out both sides
+ * missing each other).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "json.hpp"
+#include "snapshot_stream.h"
+
+namespace dase {
+
+class SnapshotBuffer {
+public:
+    static constexpr size_t kMinFrames = 2;     // The latest frame plus one to write
+    static constexpr size_t kMaxFrames = 16;
+
+    struct Frame {
+        std::vector<std::vector<double>> fields;   // One per selection field, selection.count() values
+        uint64_t step = 0;                         // Mission steps since buffer_state
+        uint64_t sequence = 0;                     // Publications before this one, plus 1
+        double simulated_time = 0.0;               // NaN for engines that do not track one
+        std::atomic<uint32_t> readers{0};
+    };
+
+    // A pinned frame; empty if nothing was published yet
+    class Lease {
+    public:
+        Lease() = default;
+        explicit Lease(Frame* frame) : frame_(frame) {}
+        Lease(Lease&& other) noexcept : frame_(other.frame_) { other.frame_ = nullptr; }
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { release(); }
+
+        explicit operator bool() const { return frame_ != nullptr; }
+        const Frame* operator->() const { return frame_; }
+        const Frame& operator*() const { return *frame_; }
+        void release();
+
+    private:
+        Frame* frame_ = nullptr;
+    };
+
+    /**
+     * `frames` preallocated frames (clamped to [kMinFrames, kMaxFrames]) of
+     * the selection's fields, published every publish_interval mission
+     * steps
+     */
+    SnapshotBuffer(const SnapshotSelection& selection, size_t frames, int publish_interval);
+
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+    const SnapshotSelection& selection() const { return selection_; }
+    int publishInterval() const { return publish_interval_; }
+    size_t frameCount() const { return frames_.size(); }
+
+    // Writer side (one thread at a time)
+    Frame* beginPublish();
+    void endPublish(Frame* frame, uint64_t step, double simulated_time);
+
+    // Reader side (any thread)
+    Lease lease();
+
+    uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+    uint64_t skipped() const { return skipped_.load(std::memory_order_relaxed); }
+    size_t memoryBytes() const;
+
+    // Selection, frame count, publish interval and counters
+    nlohmann::json describe() const;
+
+private:
+    SnapshotSelection selection_;
+    int publish_interval_ = 0;
+    std::vector<std::unique_ptr<Frame>> frames_;
+    std::atomic<Frame*> latest_{nullptr};
+    uint64_t sequence_ = 0;                 // Writer only
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> skipped_{0};
+};
+
+} // namespace dase
@@ -0,0 +1,240 @@
+/**
+ * Snapshot Stream Implementation
+ */
+
+#include "snapshot_stream.h"
+
+#include <algorithm>
+
+namespace dase {
+
+namespace {
+
+constexpr char kSnapshotMagic[8] = {'D', 'A', 'S', 'N', 'A', 'P', '1', '\0'};
+
+const char* const kAxisNames[3] = {"x", "y", "z"};
+
+} // namespace
+
+const std::vector<std::string>& SnapshotSelection::igsoaFields() {
+    static const std::vector<std::string> fields = {"psi_real", "psi_imag", "phi"};
+    return fields;
+}
+
+const std::vector<std::string>& SnapshotSelection::satpFields() {
+    static const std::vector<std::string> fields = {"phi", "phi_dot", "h", "h_dot"};
+    return fields;
+}
+
+bool SnapshotSelection::parse(const nlohmann::json& params, const size_t dims[3],
+                              const std::vector<std::string>& known_fields, std::string& error) {
+    for (int d = 0; d < 3; ++d) {
+        dims_[d] = dims[d];
+        origin_[d] = 0;
+        extent_[d] = dims[d];
+    }
+
+    known_fields_ = known_fields;
+    fields_.clear();
+    if (params.contains("fields")) {
+        if (!params["fields"].is_array() || params["fields"].empty()) {
+            error = "'fields' must be a non-empty array";
+            return false;
+        }
+        for (const auto& field : params["fields"]) {
+            const std::string name = field.is_string() ? field.get<std::string>() : "";
+            if (std::find(known_fields.begin(), known_fields.end(), name) == known_fields.end()) {
+                error = "Unknown snapshot field: " + field.dump();
+                return false;
+            }
+            if (!wants(name)) {
+                fields_.push_back(name);
+            }
+        }
+        // Keep the engine's field order whatever order was asked
+        std::vector<std::string> ordered;
+        for (const auto& name : known_fields) {
+            if (wants(name)) {
+                ordered.push_back(name);
+            }
+        }
+        fields_.swap(ordered);
+    } else {
+        fields_ = known_fields;
+    }
+    all_fields_ = fields_.size() == known_fields.size();
+
+    if (params.contains("region")) {
+        const auto& region = params["region"];
+        const char* origin_keys[3] = {"x0", "y0", "z0"};
+        const char* extent_keys[3] = {"nx", "ny", "nz"};
+        for (int d = 0; d < 3; ++d) {
+            const int64_t o = region.value(origin_keys[d], int64_t(0));
+            const int64_t n = region.value(extent_keys[d], static_cast<int64_t>(dims_[d]) - o);
+            if (o < 0 || n <= 0 || static_cast<size_t>(o + n) > dims_[d]) {
+                error = "Region leaves the lattice along " + std::string(extent_keys[d] + 1);
+                return false;
+            }
+            origin_[d] = static_cast<size_t>(o);
+            extent_[d] = static_cast<size_t>(n);
+        }
+    }
+
+    if (params.contains("slice")) {
+        const auto& slice = params["slice"];
+        int axis = -1;
+        if (slice.is_object() && slice.contains("axis")) {
+            const auto& name = slice["axis"];
+            for (int d = 0; d < 3; ++d) {
+                if ((name.is_string() && name.get<std::string>() == kAxisNames[d]) ||
+                    (name.is_number_integer() && name.get<int64_t>() == d)) {
+                    axis = d;
+                }
+            }
+        }
+        if (axis < 0) {
+            error = "'slice' needs an 'axis' of x, y or z";
+            return false;
+        }
+        const int64_t index = slice.value("index", int64_t(0));
+        if (index < 0 || static_cast<size_t>(index) >= dims_[axis]) {
+            error = "Slice index leaves the lattice along " + std::string(kAxisNames[axis]);
+            return false;
+        }
+        origin_[axis] = static_cast<size_t>(index);
+        extent_[axis] = 1;
+    }
+
+    const std::string dtype = params.value("dtype", std::string("f64"));
+    if (dtype != "f64" && dtype != "f32") {
+        error = "'dtype' must be \"f64\" or \"f32\"";
+        return false;
+    }
+    float32_ = dtype == "f32";
+
+    const int64_t stride = params.value("stride", int64_t(1));
+    if (stride <= 0) {
+        error = "'stride' must be positive";
+        return false;
+    }
+    stride_ = static_cast<size_t>(stride);
+
+    identity_ = stride_ == 1;
+    for (int d = 0; d < 3; ++d) {
+        out_[d] = (extent_[d] + stride_ - 1) / stride_;
+        identity_ = identity_ && origin_[d] == 0 && extent_[d] == dims_[d];
+    }
+    return true;
+}
+
+bool SnapshotSelection::wants(const std::string& field) const {
+    return std::find(fields_.begin(), fields_.end(), field) != fields_.end();
+}
+
+void SnapshotSelection::select(const std::vector<double>& full, std::vector<double>& out) const {
+    if (identity_) {
+        out.assign(full.begin(), full.end());
+        return;
+    }
+    out.resize(count());
+    if (full.size() < dims_[0] * dims_[1] * dims_[2]) {
+        std::fill(out.begin(), out.end(), 0.0);   // Engine left this field empty
+        return;
+    }
+    size_t k = 0;
+    forEachIndex([&](size_t i) { out[k++] = full[i]; });
+}
+
+nlohmann::json SnapshotSelection::describe() const {
+    return {
+        {"fields", fields_},
+        {"dims", {dims_[0], dims_[1], dims_[2]}},
+        {"region", {{"x0", origin_[0]}, {"y0", origin_[1]}, {"z0", origin_[2]},
+                    {"nx", extent_[0]}, {"ny", extent_[1]}, {"nz", extent_[2]}}},
+        {"stride", stride_},
+        {"shape", {out_[0], out_[1], out_[2]}},
+        {"count", count()},
+        {"dtype", float32_ ? "f32" : "f64"}
+    };
+}
+
+SnapshotFileWriter::~SnapshotFileWriter() {
+    close();
+}
+
+bool SnapshotFileWriter::open(const std::string& path, const nlohmann::json& header, std::string& error,
+                              bool float32) {
+    close();
+    float32_ = float32;
+    records_ = 0;
+    encoder_.reset();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        error = "Cannot open snapshot file: " + path;
+        return false;
+    }
+    const std::string text = header.dump();
+    const uint64_t header_bytes = text.size();
+    if (std::fwrite(kSnapshotMagic, 1, sizeof(kSnapshotMagic), file_) != sizeof(kSnapshotMagic) ||
+        std::fwrite(&header_bytes, sizeof(header_bytes), 1, file_) != 1 ||
+        std::fwrite(text.data(), 1, text.size(), file_) != text.size()) {
+        error = "Failed to write snapshot file header: " + path;
+        close();
+        return false;
+    }
+    bytes_written_ = sizeof(kSnapshotMagic) + sizeof(header_bytes) + text.size();
+    return true;
+}
+
+void SnapshotFileWriter::setEncoding(const protocol::SegmentEncoding& encoding, size_t key_interval) {
+    encoded_ = !encoding.isIdentity();
+    encoding_ = encoding;
+    key_interval_ = key_interval;
+}
+
+bool SnapshotFileWriter::append(int64_t timestep, const std::vector<const std::vector<double>*>& fields) {
+    if (!file_ || std::fwrite(&timestep, sizeof(timestep), 1, file_) != 1) {
+        return false;
+    }
+    bytes_written_ += sizeof(timestep);
+    const bool key = records_ == 0 || (key_interval_ > 0 && records_ % key_interval_ == 0);
+    records_++;
+    for (size_t k = 0; k < fields.size(); ++k) {
+        const auto* field = fields[k];
+        if (encoded_) {
+            block_.clear();
+            encoder_.encode(static_cast<uint32_t>(k), encoding_, field->data(), field->size(), block_, key);
+            const uint64_t block_bytes = block_.size();
+            if (std::fwrite(&block_bytes, sizeof(block_bytes), 1, file_) != 1 ||
+                std::fwrite(block_.data(), 1, block_.size(), file_) != block_.size()) {
+                return false;
+            }
+            bytes_written_ += sizeof(block_bytes) + block_.size();
+            continue;
+        }
+        if (float32_) {
+            narrowed_.assign(field->begin(), field->end());
+            if (std::fwrite(narrowed_.data(), sizeof(float), narrowed_.size(), file_) != narrowed_.size()) {
+                return false;
+            }
+            bytes_written_ += narrowed_.size() * sizeof(float);
+            continue;
+        }
+        if (std::fwrite(field->data(), sizeof(double), field->size(), file_) != field->size()) {
+            return false;
+        }
+        bytes_written_ += field->size() * sizeof(double);
+    }
+    return true;
+}
+
+bool SnapshotFileWriter::close() {
+    if (!file_) {
+        return true;
+    }
+    const bool ok = std::fclose(file_) == 0;
+    file_ = nullptr;
+    return ok;
+}
+
+} // namespace dase
@@ -0,0 +1,163 @@
+/**
+ * Snapshot Stream - Field selection and sinks for run_mission_with_snapshots
+ *
+ * run_mission_with_snapshots used to hold every snapshot in one JSON
+ * array until the mission finished.  With "stream": true each snapshot is
+ * sent as its own message as soon as it is captured; with "output_file" it
+ * is appended to a binary snapshot file.  Either way memory stays at one
+ * state's worth whatever the snapshot count.
+ *
+ * A SnapshotSelection narrows what each snapshot (and get_state /
+ * get_satp_state) carries:
+ *
+ *   "fields": ["phi", ...]                         subset of the engine's fields
+ *                                                  (IGSOA: psi_real, psi_imag, phi;
+ *                                                  SATP: phi, phi_dot, h, h_dot)
+ *   "region": {"x0", "y0", "z0", "nx", "ny", "nz"} box of the lattice (default: all)
+ *   "slice": {"axis": "x"|"y"|"z", "index": i}     pin one axis to one plane
+ *   "stride": k                                    keep every k-th node along each axis
+ *   "dtype": "f64" | "f32"                         round values to float32
+ *
+ * EngineManager::getSelectedState gathers only the selected nodes straight
+ * from engine storage, visiting them with forEachIndex().
+ *
+ * Snapshot file layout (native little-endian):
+ *
+ *   8 bytes   magic "DASNAP1\0"
+ *   u64       header bytes H
+ *   H bytes   JSON header (SnapshotSelection::describe plus engine info)
+ *   records   i64 timestep, then per field selected-count values of the
+ *             header's "dtype" (float64, or float32 for "dtype": "f32");
+ *             with an "encoding" header key, per field a u64 byte count
+ *             and one segment_codec.h block instead, channel = field
+ *             position, a key block every "key_interval" records
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "json.hpp"
+#include "segment_codec.h"
+
+namespace dase {
+
+class SnapshotSelection {
+public:
+    // Selectable fields of the IGSOA and SATP+Higgs engine families
+    static const std::vector<std::string>& igsoaFields();
+    static const std::vector<std::string>& satpFields();
+
+    /**
+     * Parse fields / region / slice / stride / dtype from command params
+     * for a lattice of dims[0] x dims[1] x dims[2] nodes whose fields are
+     * `known_fields` (all of them by default)
+     *
+     * @return false with `error` set if a field is unknown or the region
+     *         or slice leaves the lattice
+     */
+    bool parse(const nlohmann::json& params, const size_t dims[3],
+               const std::vector<std::string>& known_fields, std::string& error);
+
+    // parse() against the IGSOA fields
+    bool parse(const nlohmann::json& params, const size_t dims[3], std::string& error) {
+        return parse(params, dims, igsoaFields(), error);
+    }
+
+    const std::vector<std::string>& fields() const { return fields_; }
+    // The field family the selection was parsed against
+    const std::vector<std::string>& knownFields() const { return known_fields_; }
+    bool wants(const std::string& field) const;
+
+    // Nodes per selected field
+    size_t count() const { return out_[0] * out_[1] * out_[2]; }
+
+    // Nodes of the whole lattice the selection was parsed against
+    size_t latticeSize() const { return dims_[0] * dims_[1] * dims_[2]; }
+
+    // Whether select() is the identity (whole lattice, stride 1)
+    bool isIdentity() const { return identity_; }
+
+    // Whether values are rounded to float32 ("dtype": "f32")
+    bool float32() const { return float32_; }
+
+    // Whether the params narrowed nothing (all fields, identity, float64)
+    bool isDefault() const { return identity_ && all_fields_ && !float32_; }
+
+    /**
+     * Call fn(flat_index) for every selected node of the row-major lattice,
+     * in output order (x fastest)
+     */
+    template <typename Fn>
+    void forEachIndex(Fn&& fn) const {
+        for (size_t z = 0; z < out_[2]; ++z) {
+            for (size_t y = 0; y < out_[1]; ++y) {
+                const size_t row = ((origin_[2] + z * stride_) * dims_[1] + origin_[1] + y * stride_) * dims_[0];
+                for (size_t x = 0; x < out_[0]; ++x) {
+                    fn(row + origin_[0] + x * stride_);
+                }
+            }
+        }
+    }
+
+    // Copy the selected nodes of a full row-major field into `out`
+    void select(const std::vector<double>& full, std::vector<double>& out) const;
+
+    nlohmann::json describe() const;
+
+private:
+    std::vector<std::string> fields_;
+    std::vector<std::string> known_fields_;
+    bool all_fields_ = true;
+    bool float32_ = false;
+    size_t dims_[3] = {0, 1, 1};
+    size_t origin_[3] = {0, 0, 0};
+    size_t extent_[3] = {0, 1, 1};
+    size_t out_[3] = {0, 1, 1};
+    size_t stride_ = 1;
+    bool identity_ = true;
+};
+
+class SnapshotFileWriter {
+public:
+    SnapshotFileWriter() = default;
+    ~SnapshotFileWriter();
+
+    SnapshotFileWriter(const SnapshotFileWriter&) = delete;
+    SnapshotFileWriter& operator=(const SnapshotFileWriter&) = delete;
+
+    // `float32` stores record values as float32 (header "dtype": "f32")
+    bool open(const std::string& path, const nlohmann::json& header, std::string& error,
+              bool float32 = false);
+
+    /**
+     * Write records as codec blocks (the header passed to open() should
+     * carry encoding.describe() as "encoding"), with a key block every
+     * `key_interval` records (0: the first record only).  Values must
+     * already be quantized (protocol::quantize).
+     */
+    void setEncoding(const protocol::SegmentEncoding& encoding, size_t key_interval);
+
+    // One record; `fields` in header order, each SnapshotSelection::count() long
+    bool append(int64_t timestep, const std::vector<const std::vector<double>*>& fields);
+
+    bool close();
+
+    uint64_t bytesWritten() const { return bytes_written_; }
+
+private:
+    std::FILE* file_ = nullptr;
+    uint64_t bytes_written_ = 0;
+    bool float32_ = false;
+    std::vector<float> narrowed_;
+    bool encoded_ = false;
+    protocol::SegmentEncoding encoding_;
+    size_t key_interval_ = 0;
+    size_t records_ = 0;
+    protocol::SegmentEncoder encoder_;
+    std::vector<uint8_t> block_;
+};
+
+} // namespace dase
@@ -0,0 +1,151 @@
+/**
+ * Spectral Monitor Implementation
+ */
+
+#include "spectral_monitor.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#ifdef USE_FFTW3
+#include <fftw3.h>
+#include "fft_plan_cache.h"
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace dase {
+namespace analysis {
+
+SpectralMonitor::SpectralMonitor(const SpectralMonitorConfig& config, size_t channels)
+    : config_(config)
+    , channels_(channels) {
+    if (config_.segment < 2 || config_.overlap >= config_.segment || channels_ == 0 ||
+        !(config_.sample_interval > 0.0)) {
+        throw std::invalid_argument("Spectral monitor needs segment >= 2, overlap < segment, "
+                                    "at least one channel and a positive sample interval");
+    }
+#ifndef USE_FFTW3
+    throw std::runtime_error("Spectral monitors require FFTW3 (not available in this build)");
+#else
+    // Plan now, so a shape FFTW cannot handle fails here and not mid-mission
+    FFTPlanCache::acquireR2C({static_cast<int>(config_.segment)});
+
+    const size_t n = config_.segment;
+    window_.assign(n, 1.0);
+    if (config_.hann) {
+        // Periodic Hann, as scipy.signal.get_window("hann", n)
+        for (size_t i = 0; i < n; ++i) {
+            window_[i] = 0.5 - 0.5 * std::cos(2.0 * M_PI * static_cast<double>(i) / static_cast<double>(n));
+        }
+    }
+    double power = 0.0;
+    for (double w : window_) {
+        power += w * w;
+    }
+    window_scale_ = config_.sample_interval / power;
+    history_.assign(channels_ * n, 0.0);
+    psd_sum_.assign(channels_ * bins(), 0.0);
+#endif
+}
+
+void SpectralMonitor::push(const double* frame) {
+    const size_t n = config_.segment;
+    for (size_t c = 0; c < channels_; ++c) {
+        history_[c * n + head_] = frame[c];
+    }
+    head_ = (head_ + 1) % n;
+    filled_ = std::min(filled_ + 1, n);
+    since_window_++;
+    samples_++;
+    if (filled_ == n && since_window_ >= n - config_.overlap) {
+        closeWindow();
+        since_window_ = 0;
+    }
+}
+
+void SpectralMonitor::reset() {
+    std::fill(history_.begin(), history_.end(), 0.0);
+    std::fill(psd_sum_.begin(), psd_sum_.end(), 0.0);
+    head_ = 0;
+    filled_ = 0;
+    since_window_ = 0;
+    segments_ = 0;
+    samples_ = 0;
+}
+
+void SpectralMonitor::closeWindow() {
+#ifdef USE_FFTW3
+    const size_t n = config_.segment;
+    const size_t num_bins = bins();
+    auto lease = FFTPlanCache::acquireR2C({static_cast<int>(n)});
+    double* in = lease.input();
+    const fftw_complex* out = lease.output();
+
+    for (size_t c = 0; c < channels_; ++c) {
+        // The ring is full, so head_ is the oldest sample
+        const double* ring = history_.data() + c * n;
+        double mean = 0.0;
+        if (config_.detrend) {
+            for (size_t i = 0; i < n; ++i) {
+                mean += ring[i];
+            }
+            mean /= static_cast<double>(n);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            in[i] = window_[i] * (ring[(head_ + i) % n] - mean);
+        }
+        lease.execute();
+
+        // One-sided: every bin but DC and (even n) Nyquist counts twice
+        double* psd = psd_sum_.data() + c * num_bins;
+        for (size_t k = 0; k < num_bins; ++k) {
+            const double folded = (k == 0 || (n % 2 == 0 && k == n / 2)) ? 1.0 : 2.0;
+            psd[k] += folded * window_scale_ * (out[k][0] * out[k][0] + out[k][1] * out[k][1]);
+        }
+    }
+    segments_++;
+#endif
+}
+
+FFTResult SpectralMonitor::spectrum(size_t channel, const std::string& name) const {
+    if (channel >= channels_) {
+        throw std::out_of_range("Spectral monitor channel out of range");
+    }
+    const size_t num_bins = bins();
+    const double df = frequencyResolution();
+    const double scale = segments_ > 0 ? 1.0 / static_cast<double>(segments_) : 0.0;
+    const double* sum = psd_sum_.data() + channel * num_bins;
+
+    FFTResult result;
+    result.N = config_.segment;
+    result.N_x = config_.segment;
+    result.N_y = 1;
+    result.N_z = 1;
+    result.field_name = name;
+    result.execution_time_ms = 0.0;
+    result.frequencies.resize(num_bins);
+    result.power_spectrum.resize(num_bins);
+    result.magnitude.resize(num_bins);
+    result.total_power = 0.0;
+    result.peak_frequency = 0.0;
+    result.peak_magnitude = 0.0;
+    for (size_t k = 0; k < num_bins; ++k) {
+        const double psd = sum[k] * scale;
+        result.frequencies[k] = static_cast<double>(k) * df;
+        result.power_spectrum[k] = psd;
+        result.magnitude[k] = std::sqrt(psd);
+        result.total_power += psd * df;
+        if (k > 0 && result.magnitude[k] > result.peak_magnitude) {
+            result.peak_magnitude = result.magnitude[k];
+            result.peak_frequency = result.frequencies[k];
+        }
+    }
+    result.dc_component = result.magnitude[0];
+    return result;
+}
+
+} // namespace analysis
+} // namespace dase
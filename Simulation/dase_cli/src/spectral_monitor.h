@@ -0,0 +1,89 @@
+/**
+ * Spectral Monitor - Streaming Welch PSD of probe signals
+ *
+ * engine_fft transforms one static state on demand; a SpectralMonitor
+ * instead follows time series while the mission runs.  It is fed one
+ * frame per recorded sample (a probe tap, see probe_recorder.h), keeps the
+ * last `segment` samples of every channel, and every `segment - overlap`
+ * samples windows them, transforms them through the shared FFT plan cache
+ * (fft_plan_cache.h) and adds the one-sided periodogram to a running sum.
+ * The averaged PSD (Welch's method) and its peaks (EngineFFTAnalysis::
+ * findPeaks) are available at any time; no raw series leaves the process.
+ *
+ * PSD scaling follows scipy.signal.welch(scaling="density"): units^2 per
+ * unit of frequency, with frequency in cycles per unit of simulated time
+ * when sample_interval is the time between samples.
+ *
+ * Not thread-safe: push and read from the thread driving the engine (the
+ * CLI holds the engine's lock for both).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "engine_fft_analysis.h"
+
+namespace dase {
+namespace analysis {
+
+struct SpectralMonitorConfig {
+    size_t segment = 256;             // Samples per window (FFT length)
+    size_t overlap = 128;             // Samples shared by consecutive windows
+    bool hann = true;                 // Hann window (rectangular otherwise)
+    bool detrend = true;              // Subtract each window's mean
+    double sample_interval = 1.0;     // Time between samples
+};
+
+class SpectralMonitor {
+public:
+    /**
+     * @param channels Values per frame
+     * @throws std::invalid_argument for a segment below 2, overlap >= segment,
+     *         no channels or a non-positive sample interval
+     * @throws std::runtime_error without FFTW3, or if the plan cannot be made
+     */
+    SpectralMonitor(const SpectralMonitorConfig& config, size_t channels);
+
+    // Append one sample of every channel (channels() values)
+    void push(const double* frame);
+
+    // Drop the history and the accumulated spectra
+    void reset();
+
+    const SpectralMonitorConfig& config() const { return config_; }
+    size_t channels() const { return channels_; }
+    size_t bins() const { return config_.segment / 2 + 1; }
+    size_t segments() const { return segments_; }   // Windows averaged
+    uint64_t samples() const { return samples_; }   // Frames pushed
+    double frequencyResolution() const {
+        return 1.0 / (static_cast<double>(config_.segment) * config_.sample_interval);
+    }
+
+    /**
+     * Averaged PSD of a channel (bins() values, zero before the first
+     * window) as an FFTResult: frequencies, power_spectrum = PSD and
+     * magnitude = sqrt(PSD), ready for EngineFFTAnalysis::findPeaks
+     */
+    FFTResult spectrum(size_t channel, const std::string& name) const;
+
+private:
+    void closeWindow();
+
+    SpectralMonitorConfig config_;
+    size_t channels_;
+    std::vector<double> history_;     // Per channel, a ring of `segment` samples
+    std::vector<double> window_;
+    double window_scale_ = 0.0;       // sample_interval / sum(w^2)
+    std::vector<double> psd_sum_;     // Per channel, bins() periodogram sums
+    size_t head_ = 0;                 // Next slot (the oldest once full)
+    size_t filled_ = 0;
+    size_t since_window_ = 0;
+    size_t segments_ = 0;
+    uint64_t samples_ = 0;
+};
+
+} // namespace analysis
+} // namespace dase
@@ -0,0 +1,190 @@
+/**
+ * State Export Implementation
+ */
+
+#include "state_export.h"
+
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace dase {
+
+namespace {
+
+constexpr size_t kFieldAlignment = 64;
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+#ifndef _WIN32
+std::string posixName(const std::string& name) {
+    return name.empty() || name[0] == '/' ? name : "/" + name;
+}
+#endif
+
+} // namespace
+
+std::unique_ptr<SharedStateExport> SharedStateExport::create(const std::string& name,
+                                                             const std::vector<std::string>& fields,
+                                                             size_t num_nodes,
+                                                             const uint32_t dims[3],
+                                                             std::string& error) {
+    if (name.empty() || name.find('/') != std::string::npos || name.find('\\') != std::string::npos) {
+        error = "Segment name must be non-empty and contain no path separators";
+        return nullptr;
+    }
+    if (fields.empty() || fields.size() > kSharedStateMaxFields) {
+        error = "Unsupported field count";
+        return nullptr;
+    }
+    for (const auto& field : fields) {
+        if (field.size() >= sizeof(SharedStateField::name)) {
+            error = "Field name too long: " + field;
+            return nullptr;
+        }
+    }
+
+    const size_t field_bytes = alignUp(num_nodes * sizeof(double), kFieldAlignment);
+    const size_t total = kSharedStateHeaderBytes + field_bytes * fields.size();
+
+    std::unique_ptr<SharedStateExport> segment(new SharedStateExport());
+    segment->name_ = name;
+    segment->field_names_ = fields;
+    segment->num_nodes_ = num_nodes;
+    segment->bytes_ = total;
+
+#ifdef _WIN32
+    const std::string mapping_name = "Local\\" + name;
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(static_cast<uint64_t>(total) >> 32),
+                                        static_cast<DWORD>(total & 0xFFFFFFFFu),
+                                        mapping_name.c_str());
+    if (!mapping) {
+        error = "CreateFileMapping failed (error " + std::to_string(GetLastError()) + ")";
+        return nullptr;
+    }
+    void* base = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, total);
+    if (!base) {
+        error = "MapViewOfFile failed (error " + std::to_string(GetLastError()) + ")";
+        CloseHandle(mapping);
+        return nullptr;
+    }
+    segment->mapping_handle_ = mapping;
+    segment->base_ = base;
+#else
+    const std::string shm_name = posixName(name);
+    shm_unlink(shm_name.c_str());   // Replace a stale segment of the same name
+    const int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        error = "shm_open failed: " + std::string(std::strerror(errno));
+        return nullptr;
+    }
+    if (ftruncate(fd, static_cast<off_t>(total)) != 0) {
+        error = "ftruncate failed: " + std::string(std::strerror(errno));
+        close(fd);
+        shm_unlink(shm_name.c_str());
+        return nullptr;
+    }
+    void* base = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        error = "mmap failed: " + std::string(std::strerror(errno));
+        shm_unlink(shm_name.c_str());
+        return nullptr;
+    }
+    segment->base_ = base;
+#endif
+
+    std::memset(segment->base_, 0, kSharedStateHeaderBytes);
+    SharedStateHeader* header = new (segment->base_) SharedStateHeader();
+    std::memcpy(header->magic, kSharedStateMagic, sizeof(header->magic));
+    header->version = kSharedStateVersion;
+    header->header_bytes = static_cast<uint32_t>(kSharedStateHeaderBytes);
+    header->sequence.store(0, std::memory_order_relaxed);
+    header->step = 0;
+    header->num_nodes = num_nodes;
+    for (int d = 0; d < 3; ++d) {
+        header->dims[d] = dims[d];
+    }
+    header->dtype = kSharedStateDtypeF64;
+    header->field_count = static_cast<uint32_t>(fields.size());
+    header->total_bytes = total;
+    for (size_t k = 0; k < fields.size(); ++k) {
+        std::memset(header->fields[k].name, 0, sizeof(header->fields[k].name));
+        std::memcpy(header->fields[k].name, fields[k].data(), fields[k].size());
+        header->fields[k].offset = kSharedStateHeaderBytes + k * field_bytes;
+        header->fields[k].count = num_nodes;
+    }
+    return segment;
+}
+
+SharedStateExport::~SharedStateExport() {
+    if (!base_) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(base_);
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+#else
+    munmap(base_, bytes_);
+    shm_unlink(posixName(name_).c_str());
+#endif
+}
+
+double* SharedStateExport::field(size_t k) {
+    return reinterpret_cast<double*>(static_cast<char*>(base_) + header()->fields[k].offset);
+}
+
+void SharedStateExport::beginPublish() {
+    auto& sequence = header()->sequence;
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void SharedStateExport::endPublish(uint64_t step) {
+    SharedStateHeader* h = header();
+    h->step = step;
+    h->sequence.store(h->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+nlohmann::json SharedStateExport::describe() const {
+    const SharedStateHeader* h = header();
+    nlohmann::json fields = nlohmann::json::array();
+    for (size_t k = 0; k < field_names_.size(); ++k) {
+        fields.push_back({
+            {"name", field_names_[k]},
+            {"offset", h->fields[k].offset},
+            {"count", h->fields[k].count}
+        });
+    }
+    return {
+        {"name", name_},
+#ifdef _WIN32
+        {"path", "Local\\" + name_},
+#else
+        {"path", "/dev/shm/" + name_},
+#endif
+        {"bytes", bytes_},
+        {"header_bytes", kSharedStateHeaderBytes},
+        {"version", kSharedStateVersion},
+        {"dtype", "f64"},
+        {"num_nodes", num_nodes_},
+        {"dims", {h->dims[0], h->dims[1], h->dims[2]}},
+        {"sequence_offset", 16},
+        {"step_offset", 24},
+        {"fields", fields}
+    };
+}
+
+} // namespace dase
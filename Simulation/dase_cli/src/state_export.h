@@ -0,0 +1,115 @@
+/**
+ * State Export - Engine state arrays in a named shared-memory segment
+ *
+ * get_state copies every array into the response, even in binary mode.  An
+ * orchestrator on the same host can instead map_state an engine: the CLI
+ * creates a named segment (POSIX shm_open / Windows file mapping), and the
+ * engine manager gathers the state straight into it after every
+ * publish_interval steps.  Readers map the same name (numpy.memmap of
+ * /dev/shm/<name> on Linux) and never go through the pipe.
+ *
+ * Segment layout (native byte order, little-endian on every supported
+ * host):
+ *
+ *   SharedStateHeader      (kSharedStateHeaderBytes, fields at fixed offsets)
+ *   field 0                num_nodes float64 values, 64-byte aligned
+ *   field 1 ...
+ *
+ * Readers use the header's sequence number as a seqlock: it is odd while a
+ * publish is in progress.  Read it, skip if odd, copy the fields, and retry
+ * if the sequence changed meanwhile.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+
+constexpr char kSharedStateMagic[8] = {'D', 'A', 'S', 'E', 'S', 'H', 'M', '\0'};
+constexpr uint32_t kSharedStateVersion = 1;
+constexpr uint32_t kSharedStateDtypeF64 = 1;
+constexpr size_t kSharedStateMaxFields = 8;
+constexpr size_t kSharedStateHeaderBytes = 512;
+
+struct SharedStateField {
+    char name[16];        // NUL-terminated
+    uint64_t offset;      // Bytes from the segment start
+    uint64_t count;       // Values
+};
+
+struct SharedStateHeader {
+    char magic[8];                        //   0
+    uint32_t version;                     //   8
+    uint32_t header_bytes;                //  12
+    std::atomic<uint64_t> sequence;       //  16  Odd while publishing
+    uint64_t step;                        //  24  Engine steps at the last publish
+    uint64_t num_nodes;                   //  32
+    uint32_t dims[3];                     //  40
+    uint32_t dtype;                       //  52
+    uint32_t field_count;                 //  56
+    uint32_t reserved;                    //  60
+    uint64_t total_bytes;                 //  64
+    SharedStateField fields[kSharedStateMaxFields];   //  72, 32 bytes each
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock needs a lock-free 64-bit atomic");
+static_assert(sizeof(SharedStateHeader) <= kSharedStateHeaderBytes, "header overflows its reserved bytes");
+
+class SharedStateExport {
+public:
+    /**
+     * Create (or replace) a segment holding `fields` arrays of num_nodes
+     * float64 values
+     *
+     * @return nullptr with `error` set on failure
+     */
+    static std::unique_ptr<SharedStateExport> create(const std::string& name,
+                                                     const std::vector<std::string>& fields,
+                                                     size_t num_nodes,
+                                                     const uint32_t dims[3],
+                                                     std::string& error);
+
+    ~SharedStateExport();
+
+    SharedStateExport(const SharedStateExport&) = delete;
+    SharedStateExport& operator=(const SharedStateExport&) = delete;
+
+    // Destination of field k, valid between beginPublish and endPublish
+    double* field(size_t k);
+    size_t fieldCount() const { return field_names_.size(); }
+    size_t numNodes() const { return num_nodes_; }
+
+    // Seqlock write section
+    void beginPublish();
+    void endPublish(uint64_t step);
+
+    const std::string& name() const { return name_; }
+    size_t bytes() const { return bytes_; }
+
+    // Layout for the map_state response (name, offsets, dtype, ...)
+    nlohmann::json describe() const;
+
+private:
+    SharedStateExport() = default;
+
+    SharedStateHeader* header() { return static_cast<SharedStateHeader*>(base_); }
+    const SharedStateHeader* header() const { return static_cast<const SharedStateHeader*>(base_); }
+
+    std::string name_;
+    std::vector<std::string> field_names_;
+    size_t num_nodes_ = 0;
+    size_t bytes_ = 0;
+    void* base_ = nullptr;
+#ifdef _WIN32
+    void* mapping_handle_ = nullptr;
+#endif
+};
+
+} // namespace dase
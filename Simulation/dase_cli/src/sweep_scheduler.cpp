@@ -0,0 +1,146 @@
+/**
+ * Sweep Scheduler Implementation
+ */
+
+#include "sweep_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <numeric>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace dase {
+
+SweepScheduler::SweepScheduler(int capacity)
+    : capacity_(capacity > 0 ? capacity : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))) {}
+
+int SweepScheduler::threadBudget(uint64_t work, uint64_t work_per_thread) const {
+    if (work_per_thread == 0) {
+        return capacity_;
+    }
+    const uint64_t threads = (work + work_per_thread - 1) / work_per_thread;
+    return static_cast<int>(std::max<uint64_t>(1, std::min<uint64_t>(threads, static_cast<uint64_t>(capacity_))));
+}
+
+void SweepScheduler::run(std::vector<SweepTask> tasks, size_t max_workers) {
+    stats_ = SweepSchedulerStats();
+    if (tasks.empty()) {
+        return;
+    }
+    int min_budget = capacity_;
+    for (auto& task : tasks) {
+        task.threads = std::max(1, std::min(task.threads, capacity_));
+        min_budget = std::min(min_budget, task.threads);
+    }
+
+    // Enough workers to spend every token on the narrowest tasks
+    size_t workers = std::min(tasks.size(), static_cast<size_t>(capacity_ / min_budget));
+    if (max_workers > 0) {
+        workers = std::min(workers, max_workers);
+    }
+    workers = std::max<size_t>(1, workers);
+
+    // Costliest first, dealt round-robin
+    std::vector<size_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&tasks](size_t a, size_t b) { return tasks[a].cost > tasks[b].cost; });
+    queues_.clear();
+    for (size_t w = 0; w < workers; ++w) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+        queues_[i % workers]->tasks.push_back(order[i]);
+    }
+
+    std::atomic<size_t> steals{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    auto worker_loop = [&](size_t worker) {
+        size_t index = 0;
+        bool stolen = false;
+        while (take(worker, index, stolen)) {
+            if (stolen) {
+                steals.fetch_add(1);
+            }
+            SweepTask& task = tasks[index];
+            acquire(task.threads);
+#ifdef _OPENMP
+            omp_set_num_threads(task.threads);   // Per-thread ICV: this worker's teams only
+#endif
+            try {
+                task.body();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            release(task.threads);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back(worker_loop, w);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    queues_.clear();
+
+    stats_.workers = workers;
+    stats_.steals = steals.load();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+bool SweepScheduler::take(size_t worker, size_t& task, bool& stolen) {
+    {
+        WorkerQueue& own = *queues_[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.front();
+            own.tasks.pop_front();
+            stolen = false;
+            return true;
+        }
+    }
+    // Tasks are never added while run() is in flight, so one empty pass
+    // over every victim means the worker is done
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkerQueue& victim = *queues_[(worker + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.back();
+            victim.tasks.pop_back();
+            stolen = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SweepScheduler::acquire(int threads) {
+    std::unique_lock<std::mutex> lock(tokens_mutex_);
+    tokens_available_.wait(lock, [this, threads] { return tokens_in_use_ + threads <= capacity_; });
+    tokens_in_use_ += threads;
+    stats_.peak_threads = std::max(stats_.peak_threads, tokens_in_use_);
+}
+
+void SweepScheduler::release(int threads) {
+    {
+        std::lock_guard<std::mutex> lock(tokens_mutex_);
+        tokens_in_use_ -= threads;
+    }
+    tokens_available_.notify_all();
+}
+
+} // namespace dase
@@ -0,0 +1,92 @@
+/**
+ * Sweep Scheduler - Work-stealing pool for independent runs
+ *
+ * run_sweep executes every point of a parameter grid on an engine of its
+ * own.  Points can differ in cost by orders of magnitude (a 64³ lattice
+ * next to a 1024-node chain), so the scheduler
+ *
+ *   - gives each task a thread budget, the OMP team its engine runs with.
+ *     The pool holds one token per core; a task takes its budget in tokens
+ *     before it starts and hands them back when it ends, so a grid of small
+ *     runs executes many runs at once and a grid of large ones fewer, wider
+ *     runs;
+ *   - deals the tasks, costliest first, round-robin onto per-worker deques.
+ *     A worker pops the front of its own deque and, once that is empty,
+ *     steals from the back of the others, so the cheap runs queued behind a
+ *     long one move to whichever worker is free.
+ *
+ * run() blocks until every task has finished.  Tasks run on the pool's
+ * threads and must be independent of each other (distinct engines).
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace dase {
+
+struct SweepTask {
+    double cost = 1.0;            // Relative cost (ordering only)
+    int threads = 1;              // Budget, clamped to [1, capacity]
+    std::function<void()> body;
+};
+
+struct SweepSchedulerStats {
+    size_t workers = 0;           // Threads of the last run()
+    size_t steals = 0;            // Tasks run by a worker they were not dealt to
+    int peak_threads = 0;         // Most budget tokens held at once
+};
+
+class SweepScheduler {
+public:
+    // @param capacity Budget tokens (cores); 0 = hardware concurrency
+    explicit SweepScheduler(int capacity = 0);
+
+    int capacity() const { return capacity_; }
+
+    /**
+     * Budget for `work` units (e.g. lattice nodes) at `work_per_thread`
+     * units per thread: ceil(work / work_per_thread), clamped to
+     * [1, capacity]
+     */
+    int threadBudget(uint64_t work, uint64_t work_per_thread) const;
+
+    /**
+     * Run every task; the first exception a task throws is rethrown once
+     * all workers have stopped
+     *
+     * @param max_workers Concurrent tasks at most (0 = as many as the
+     *        budgets allow)
+     */
+    void run(std::vector<SweepTask> tasks, size_t max_workers = 0);
+
+    SweepSchedulerStats lastStats() const { return stats_; }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    bool take(size_t worker, size_t& task, bool& stolen);
+    void acquire(int threads);
+    void release(int threads);
+
+    int capacity_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+    std::mutex tokens_mutex_;
+    std::condition_variable tokens_available_;
+    int tokens_in_use_ = 0;
+
+    SweepSchedulerStats stats_;
+};
+
+} // namespace dase
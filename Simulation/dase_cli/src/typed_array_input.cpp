@@ -0,0 +1,392 @@
+/**
+ * Typed Array Input Implementation
+ */
+
+#include "typed_array_input.h"
+#include "state_export.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dase {
+
+namespace {
+
+constexpr char kNpyMagic[6] = {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+
+size_t dtypeBytes(ArrayDtype dtype) {
+    return dtype == ArrayDtype::F64 ? sizeof(double) : sizeof(float);
+}
+
+bool parseDtype(const nlohmann::json& source, ArrayDtype& out, std::string& error) {
+    const std::string dtype = source.value("dtype", std::string("f64"));
+    if (dtype == "f64" || dtype == "float64") {
+        out = ArrayDtype::F64;
+    } else if (dtype == "f32" || dtype == "float32") {
+        out = ArrayDtype::F32;
+    } else {
+        error = "Unsupported dtype '" + dtype + "' (f64 or f32)";
+        return false;
+    }
+    return true;
+}
+
+struct Mapping {
+    const uint8_t* base = nullptr;
+    size_t bytes = 0;
+    std::shared_ptr<const void> owner;
+};
+
+#ifndef _WIN32
+std::string posixName(const std::string& name) {
+    return name.empty() || name[0] == '/' ? name : "/" + name;
+}
+#endif
+
+// Map a file (`shared` false) or a named shared-memory segment read-only
+bool mapReadOnly(const std::string& name, bool shared, Mapping& out, std::string& error) {
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+    size_t bytes = 0;
+    if (shared) {
+        mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, ("Local\\" + name).c_str());
+    } else {
+        file = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            error = "Cannot open " + name + " (error " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            error = "Empty or unreadable file: " + name;
+            CloseHandle(file);
+            return false;
+        }
+        bytes = static_cast<size_t>(size.QuadPart);
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    if (!mapping) {
+        error = "Cannot map " + name + " (error " + std::to_string(GetLastError()) + ")";
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        return false;
+    }
+    void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    if (!base) {
+        error = "MapViewOfFile failed (error " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+    if (shared) {
+        // Segment views are whole pages; the header, if any, bounds the data
+        MEMORY_BASIC_INFORMATION info;
+        VirtualQuery(base, &info, sizeof(info));
+        bytes = info.RegionSize;
+    }
+    out.base = static_cast<const uint8_t*>(base);
+    out.bytes = bytes;
+    out.owner = std::shared_ptr<const void>(base, [](const void* p) { UnmapViewOfFile(p); });
+#else
+    const int fd = shared ? shm_open(posixName(name).c_str(), O_RDONLY, 0) : open(name.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "Cannot open " + name + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        error = "Empty or unreadable " + std::string(shared ? "segment: " : "file: ") + name;
+        close(fd);
+        return false;
+    }
+    const size_t bytes = static_cast<size_t>(info.st_size);
+    void* base = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        error = "mmap failed: " + std::string(std::strerror(errno));
+        return false;
+    }
+    out.base = static_cast<const uint8_t*>(base);
+    out.bytes = bytes;
+    out.owner = std::shared_ptr<const void>(base, [bytes](const void* p) { munmap(const_cast<void*>(p), bytes); });
+#endif
+    return true;
+}
+
+// Value text of `key` in an NPY header dict ("{'descr': '<f8', ...}")
+bool npyValue(const std::string& header, const std::string& key, size_t& pos) {
+    pos = header.find("'" + key + "'");
+    if (pos == std::string::npos) {
+        return false;
+    }
+    pos = header.find(':', pos);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    ++pos;
+    while (pos < header.size() && std::isspace(static_cast<unsigned char>(header[pos]))) ++pos;
+    return pos < header.size();
+}
+
+// Locate the data of an NPY file: descr <f8 / <f4, C order (or a 1-D
+// Fortran array), count = product of the shape
+bool parseNpy(const uint8_t* base, size_t bytes, size_t& data_offset, size_t& count,
+              ArrayDtype& dtype, std::string& error) {
+    if (bytes < 10 || std::memcmp(base, kNpyMagic, sizeof(kNpyMagic)) != 0) {
+        error = "Not an NPY file";
+        return false;
+    }
+    const uint8_t major = base[6];
+    size_t header_bytes = 0;
+    if (major == 1) {
+        header_bytes = static_cast<size_t>(base[8]) | (static_cast<size_t>(base[9]) << 8);
+        data_offset = 10 + header_bytes;
+    } else if ((major == 2 || major == 3) && bytes >= 12) {
+        uint32_t length = 0;
+        for (int b = 0; b < 4; ++b) length |= static_cast<uint32_t>(base[8 + b]) << (8 * b);
+        header_bytes = length;
+        data_offset = 12 + header_bytes;
+    } else {
+        error = "Unsupported NPY version " + std::to_string(major);
+        return false;
+    }
+    if (data_offset > bytes) {
+        error = "Truncated NPY header";
+        return false;
+    }
+    const std::string header(reinterpret_cast<const char*>(base) + (data_offset - header_bytes), header_bytes);
+
+    size_t pos = 0;
+    if (!npyValue(header, "descr", pos) || (header[pos] != '\'' && header[pos] != '"')) {
+        error = "NPY header has no descr";
+        return false;
+    }
+    const size_t end = header.find(header[pos], pos + 1);
+    const std::string descr = end == std::string::npos ? "" : header.substr(pos + 1, end - pos - 1);
+    if (descr == "<f8" || descr == "=f8") {
+        dtype = ArrayDtype::F64;
+    } else if (descr == "<f4" || descr == "=f4") {
+        dtype = ArrayDtype::F32;
+    } else {
+        error = "Unsupported NPY dtype '" + descr + "' (little-endian f8 or f4)";
+        return false;
+    }
+
+    if (!npyValue(header, "shape", pos) || header[pos] != '(') {
+        error = "NPY header has no shape";
+        return false;
+    }
+    count = 1;
+    size_t non_unit_dims = 0;
+    size_t i = pos + 1;
+    while (i < header.size() && header[i] != ')') {
+        if (std::isdigit(static_cast<unsigned char>(header[i]))) {
+            size_t extent = 0;
+            while (i < header.size() && std::isdigit(static_cast<unsigned char>(header[i]))) {
+                extent = extent * 10 + static_cast<size_t>(header[i] - '0');
+                ++i;
+            }
+            count *= extent;
+            non_unit_dims += extent > 1 ? 1 : 0;
+        } else {
+            ++i;
+        }
+    }
+
+    bool fortran = false;
+    if (npyValue(header, "fortran_order", pos)) {
+        fortran = header.compare(pos, 4, "True") == 0;
+    }
+    if (fortran && non_unit_dims > 1) {
+        error = "Fortran-order NPY arrays are not supported (save with C order)";
+        return false;
+    }
+    if (count > (bytes - data_offset) / dtypeBytes(dtype)) {
+        error = "NPY file shorter than its shape";
+        return false;
+    }
+    return true;
+}
+
+// Raw values from `offset` to the end (or "count" values)
+bool rawRange(const nlohmann::json& source, size_t bytes, ArrayDtype dtype,
+              size_t& offset, size_t& count, std::string& error) {
+    offset = source.value("offset", size_t(0));
+    if (offset > bytes) {
+        error = "offset beyond the end of the data";
+        return false;
+    }
+    const size_t available = (bytes - offset) / dtypeBytes(dtype);
+    if (source.contains("count")) {
+        count = source["count"].get<size_t>();
+        if (count > available) {
+            error = "count exceeds the data";
+            return false;
+        }
+    } else {
+        count = available;
+    }
+    return true;
+}
+
+} // namespace
+
+bool decodeBase64(const std::string& text, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(text.size() / 4 * 3);
+    uint32_t group = 0;
+    int bits = 0;
+    bool padded = false;
+    for (const char c : text) {
+        int value;
+        if (c >= 'A' && c <= 'Z') value = c - 'A';
+        else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') value = c - '0' + 52;
+        else if (c == '+') value = 62;
+        else if (c == '/') value = 63;
+        else if (c == '=') { padded = true; continue; }
+        else if (std::isspace(static_cast<unsigned char>(c))) continue;
+        else return false;
+        if (padded) {
+            return false;   // Data after padding
+        }
+        group = (group << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<uint8_t>(group >> bits));
+        }
+    }
+    // A final group of one character cannot hold a byte
+    return bits < 6;
+}
+
+bool TypedArray::resolve(const nlohmann::json& source,
+                         const std::vector<std::vector<double>>* segments,
+                         TypedArray& out, std::string& error) {
+    out = TypedArray();
+
+    if (source.is_array()) {
+        out.owned_.resize(source.size() * sizeof(double));
+        for (size_t i = 0; i < source.size(); ++i) {
+            if (!source[i].is_number()) {
+                error = "Inline arrays must hold numbers only";
+                return false;
+            }
+            const double value = source[i].get<double>();
+            std::memcpy(out.owned_.data() + i * sizeof(double), &value, sizeof(double));
+        }
+        out.data_ = out.owned_.data();
+        out.count_ = source.size();
+        out.origin_ = "inline";
+        return true;
+    }
+    if (!source.is_object()) {
+        error = "Array source must be an array or an object";
+        return false;
+    }
+
+    if (source.contains("$segment")) {
+        const nlohmann::json& index = source["$segment"];
+        if (!segments || !index.is_number_integer() || index.get<int64_t>() < 0 ||
+            index.get<size_t>() >= segments->size()) {
+            error = "Segment reference outside the request frame";
+            return false;
+        }
+        const std::vector<double>& segment = (*segments)[index.get<size_t>()];
+        out.data_ = reinterpret_cast<const uint8_t*>(segment.data());
+        out.count_ = segment.size();
+        out.origin_ = "segment";
+        return true;
+    }
+
+    if (source.contains("base64")) {
+        if (!source["base64"].is_string() || !parseDtype(source, out.dtype_, error)) {
+            if (error.empty()) error = "'base64' must be a string";
+            return false;
+        }
+        if (!decodeBase64(source["base64"].get_ref<const std::string&>(), out.owned_)) {
+            error = "Malformed base64";
+            return false;
+        }
+        if (out.owned_.size() % dtypeBytes(out.dtype_) != 0) {
+            error = "base64 payload is not a whole number of values";
+            return false;
+        }
+        out.data_ = out.owned_.data();
+        out.count_ = out.owned_.size() / dtypeBytes(out.dtype_);
+        out.origin_ = "base64";
+        return true;
+    }
+
+    const bool from_file = source.contains("file");
+    if (!from_file && !source.contains("shm")) {
+        error = "Array source needs one of base64, file, shm or $segment";
+        return false;
+    }
+    const nlohmann::json& name = from_file ? source["file"] : source["shm"];
+    if (!name.is_string() || name.get_ref<const std::string&>().empty()) {
+        error = from_file ? "'file' must be a path" : "'shm' must be a segment name";
+        return false;
+    }
+    Mapping mapping;
+    if (!mapReadOnly(name.get<std::string>(), !from_file, mapping, error)) {
+        return false;
+    }
+
+    size_t offset = 0;
+    size_t count = 0;
+    if (from_file && mapping.bytes >= sizeof(kNpyMagic) &&
+        std::memcmp(mapping.base, kNpyMagic, sizeof(kNpyMagic)) == 0) {
+        if (!parseNpy(mapping.base, mapping.bytes, offset, count, out.dtype_, error)) {
+            return false;
+        }
+        out.origin_ = "npy";
+    } else if (!from_file && source.contains("field")) {
+        // A segment published by map_state: look the field up in its header
+        const std::string field = source["field"].get<std::string>();
+        if (mapping.bytes < kSharedStateHeaderBytes ||
+            std::memcmp(mapping.base, kSharedStateMagic, sizeof(kSharedStateMagic)) != 0) {
+            error = "Segment " + name.get<std::string>() + " is not a map_state export";
+            return false;
+        }
+        const auto* header = reinterpret_cast<const SharedStateHeader*>(mapping.base);
+        const size_t fields = std::min<size_t>(header->field_count, kSharedStateMaxFields);
+        size_t k = 0;
+        while (k < fields && field != header->fields[k].name) ++k;
+        if (k == fields) {
+            error = "Segment " + name.get<std::string>() + " has no field " + field;
+            return false;
+        }
+        offset = header->fields[k].offset;
+        count = header->fields[k].count;
+        if (offset > mapping.bytes || count > (mapping.bytes - offset) / sizeof(double)) {
+            error = "Field " + field + " lies outside the segment";
+            return false;
+        }
+        out.origin_ = "shm";
+    } else {
+        if (!parseDtype(source, out.dtype_, error) ||
+            !rawRange(source, mapping.bytes, out.dtype_, offset, count, error)) {
+            return false;
+        }
+        out.origin_ = from_file ? "file" : "shm";
+    }
+    out.data_ = mapping.base + offset;
+    out.count_ = count;
+    out.mapping_ = std::move(mapping.owner);
+    return true;
+}
+
+} // namespace dase
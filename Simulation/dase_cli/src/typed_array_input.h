@@ -0,0 +1,113 @@
+/**
+ * Typed Array Input - Field arrays for set_igsoa_state / set_satp_state
+ *
+ * The "arrays" profile sets engine fields from whole-lattice arrays.  A
+ * JSON array of numbers costs a DOM node per value; each field may instead
+ * name a typed source that is read in place and decoded straight into node
+ * storage:
+ *
+ *   [v0, v1, ...]                                  inline JSON numbers
+ *   {"base64": "...", "dtype": "f64"|"f32"}        little-endian values
+ *   {"$segment": k}                                binary protocol: segment k
+ *                                                  of the request frame
+ *   {"file": "init.npy"}                           NPY file (<f8 or <f4, C
+ *                                                  order, any shape holding
+ *                                                  num_nodes values)
+ *   {"file": "init.bin", "dtype", "offset"}        raw little-endian file
+ *   {"shm": "name", "field": "phi"}                field of a map_state segment
+ *   {"shm": "name", "dtype", "offset"}             raw shared-memory segment
+ *
+ * Files and shared-memory segments are mapped read-only (mmap / file
+ * mapping) rather than read, so a large NPY input is paged in as it is
+ * copied and never held twice.  Values are in engine order: x fastest,
+ * then y, then z (a numpy array of shape (N_z, N_y, N_x)).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+namespace dase {
+
+enum class ArrayDtype {
+    F64,
+    F32
+};
+
+// Move-only: the view may point into its own buffer
+class TypedArray {
+public:
+    TypedArray() = default;
+    TypedArray(TypedArray&&) = default;
+    TypedArray& operator=(TypedArray&&) = default;
+    TypedArray(const TypedArray&) = delete;
+    TypedArray& operator=(const TypedArray&) = delete;
+
+    /**
+     * Resolve one field source
+     *
+     * @param segments Request segments (binary protocol), or nullptr
+     * @return false with `error` set for a malformed source, an unreadable
+     *         file or segment, or an unsupported dtype / NPY layout
+     */
+    static bool resolve(const nlohmann::json& source,
+                        const std::vector<std::vector<double>>* segments,
+                        TypedArray& out, std::string& error);
+
+    size_t size() const { return count_; }
+    ArrayDtype dtype() const { return dtype_; }
+    // "inline", "base64", "segment", "npy", "file" or "shm"
+    const std::string& origin() const { return origin_; }
+
+    double operator[](size_t i) const {
+        if (dtype_ == ArrayDtype::F64) {
+            double value;
+            std::memcpy(&value, data_ + i * sizeof(double), sizeof(double));
+            return value;
+        }
+        float value;
+        std::memcpy(&value, data_ + i * sizeof(float), sizeof(float));
+        return value;
+    }
+
+    // Call fn(i, value) for every value, branching on the dtype once
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        if (dtype_ == ArrayDtype::F64) {
+            for (size_t i = 0; i < count_; ++i) {
+                double value;
+                std::memcpy(&value, data_ + i * sizeof(double), sizeof(double));
+                fn(i, value);
+            }
+        } else {
+            for (size_t i = 0; i < count_; ++i) {
+                float value;
+                std::memcpy(&value, data_ + i * sizeof(float), sizeof(float));
+                fn(i, static_cast<double>(value));
+            }
+        }
+    }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t count_ = 0;
+    ArrayDtype dtype_ = ArrayDtype::F64;
+    std::string origin_;
+    std::vector<uint8_t> owned_;            // Inline and base64 values
+    std::shared_ptr<const void> mapping_;   // Keeps a file or segment mapped
+};
+
+/**
+ * Decode standard base64 (padding optional, whitespace skipped)
+ *
+ * @return false on any other character or a truncated final group
+ */
+bool decodeBase64(const std::string& text, std::vector<uint8_t>& out);
+
+} // namespace dase
@@ -0,0 +1,144 @@
+/**
+ * Adaptive Timestep Control
+ *
+ * Shared step-size controller for missions that run to a target simulated
+ * time instead of a fixed step count (IGSOA runMissionAdaptive, SATP
+ * evolveAdaptive).  The engines supply the error or stability measure; this
+ * header turns it into the next dt, keeps dt within the user bounds and
+ * lands the last step of each segment exactly on the target time.
+ *
+ * - Error control (IGSOA): a step of dt is compared with two steps of dt/2;
+ *   the step is accepted when the estimated local error is within
+ *   `tolerance` and the next dt is scaled by safety · (tol / err)^(1/(p+1)),
+ *   limited to [max_shrink, max_growth].  A step already at dt_min is
+ *   accepted whatever its error (counted in forced_steps).
+ * - Stability control (SATP): dt = cfl · (largest stable Verlet step of the
+ *   current state), re-evaluated every cfl_check_steps steps; never rejects.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace dase {
+
+struct AdaptiveStepOptions {
+    double dt_min = 1.0e-6;       // Smallest step the controller may take
+    double dt_max = 0.1;          // Largest step the controller may take
+    double dt_initial = 0.0;      // First trial step (0 = engine's configured dt)
+    double tolerance = 1.0e-4;    // Local error per step (max-norm over the lattice)
+    double safety = 0.9;          // Margin on the optimal step
+    double max_growth = 2.0;      // Largest dt ratio between consecutive steps
+    double max_shrink = 0.2;      // Smallest dt ratio after a rejection
+    double cfl = 0.9;             // Fraction of the stable step (stability control)
+    uint32_t cfl_check_steps = 16; // Steps between stability re-evaluations
+
+    bool validate(std::string* error_msg = nullptr) const {
+        const auto fail = [error_msg](const std::string& message) {
+            if (error_msg) *error_msg = message;
+            return false;
+        };
+        if (!(dt_min > 0.0) || !(dt_max >= dt_min)) {
+            return fail("dt bounds must satisfy 0 < dt_min <= dt_max");
+        }
+        if (dt_initial < 0.0) {
+            return fail("dt_initial must be non-negative");
+        }
+        if (!(tolerance > 0.0)) {
+            return fail("tolerance must be positive");
+        }
+        if (!(safety > 0.0 && safety <= 1.0) || !(max_growth >= 1.0) ||
+            !(max_shrink > 0.0 && max_shrink <= 1.0)) {
+            return fail("safety and max_shrink must be in (0, 1], max_growth >= 1");
+        }
+        if (!(cfl > 0.0 && cfl <= 1.0) || cfl_check_steps == 0) {
+            return fail("cfl must be in (0, 1] and cfl_check_steps positive");
+        }
+        return true;
+    }
+};
+
+/**
+ * Outcome of one or more adaptive runs
+ */
+struct AdaptiveStepStats {
+    uint64_t accepted_steps = 0;
+    uint64_t rejected_steps = 0;
+    uint64_t forced_steps = 0;     // Accepted at dt_min above tolerance
+    double simulated_time = 0.0;   // Time advanced by accepted steps
+    double dt_min_used = 0.0;      // Smallest / largest accepted dt (0 before any)
+    double dt_max_used = 0.0;
+    double dt_last = 0.0;          // Last accepted dt
+    double max_error = 0.0;        // Largest accepted error estimate
+
+    void recordAccepted(double dt, double error = 0.0) {
+        dt_min_used = accepted_steps == 0 ? dt : std::min(dt_min_used, dt);
+        dt_max_used = std::max(dt_max_used, dt);
+        dt_last = dt;
+        max_error = std::max(max_error, error);
+        simulated_time += dt;
+        accepted_steps++;
+    }
+
+    void merge(const AdaptiveStepStats& other) {
+        if (other.accepted_steps == 0) {
+            rejected_steps += other.rejected_steps;
+            return;
+        }
+        dt_min_used = accepted_steps == 0 ? other.dt_min_used : std::min(dt_min_used, other.dt_min_used);
+        dt_max_used = std::max(dt_max_used, other.dt_max_used);
+        dt_last = other.dt_last;
+        max_error = std::max(max_error, other.max_error);
+        simulated_time += other.simulated_time;
+        accepted_steps += other.accepted_steps;
+        rejected_steps += other.rejected_steps;
+        forced_steps += other.forced_steps;
+    }
+};
+
+struct AdaptiveStepController {
+    /**
+     * Next trial step after an error estimate `error` for a step of `dt`
+     * with a method of local order `order` (error ~ dt^(order+1))
+     */
+    static double nextStep(double dt, double error, int order, const AdaptiveStepOptions& options) {
+        double factor = options.max_growth;
+        if (error > 0.0) {
+            factor = options.safety * std::pow(options.tolerance / error, 1.0 / (order + 1));
+            factor = std::min(options.max_growth, std::max(options.max_shrink, factor));
+        }
+        return clamp(dt * factor, options);
+    }
+
+    static double clamp(double dt, const AdaptiveStepOptions& options) {
+        return std::min(options.dt_max, std::max(options.dt_min, dt));
+    }
+
+    /**
+     * Trial step from `t` that does not overshoot `t_end`: the last step
+     * lands exactly on it, and a remainder shorter than two steps is split
+     * in half so no sliver step is left over
+     */
+    static double towards(double t, double t_end, double dt) {
+        const double remaining = t_end - t;
+        if (remaining <= dt * (1.0 + 1.0e-12)) {
+            return remaining;
+        }
+        if (remaining < 2.0 * dt) {
+            return 0.5 * remaining;
+        }
+        return dt;
+    }
+
+    /**
+     * True once `t` has reached `t_end` (up to rounding of the summed steps)
+     */
+    static bool reached(double t, double t_end) {
+        return t >= t_end - 1.0e-12 * std::max(1.0, std::abs(t_end));
+    }
+};
+
+} // namespace dase
@@ -0,0 +1,95 @@
+/**
+ * Aligned Allocator
+ *
+ * STL-compatible allocator returning 64-byte (cache-line) aligned storage.
+ * Shared by the DASE node engine and the IGSOA structure-of-arrays state so
+ * hot loops can use aligned SIMD loads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// ============================================================================
+// ALIGNED ALLOCATOR (64-byte cache-line alignment for AVX2 optimization)
+// ============================================================================
+template<typename T, std::size_t Alignment = 64>
+class aligned_allocator {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    template<typename U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() noexcept = default;
+
+    template<typename U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+    pointer allocate(size_type n) {
+        if (n == 0) return nullptr;
+
+        size_type alignment = Alignment;
+        size_type size = n * sizeof(T);
+
+        void* ptr = nullptr;
+
+#ifdef _WIN32
+        ptr = _aligned_malloc(size, alignment);
+#else
+        if (posix_memalign(&ptr, alignment, size) != 0) {
+            ptr = nullptr;
+        }
+#endif
+
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<pointer>(ptr);
+    }
+
+    void deallocate(pointer p, size_type) noexcept {
+        if (p) {
+#ifdef _WIN32
+            _aligned_free(p);
+#else
+            free(p);
+#endif
+        }
+    }
+
+    template<typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        new(p) U(std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    void destroy(U* p) {
+        p->~U();
+    }
+};
+
+template<typename T1, std::size_t A1, typename T2, std::size_t A2>
+bool operator==(const aligned_allocator<T1, A1>&, const aligned_allocator<T2, A2>&) noexcept {
+    return A1 == A2;
+}
+
+template<typename T1, std::size_t A1, typename T2, std::size_t A2>
+bool operator!=(const aligned_allocator<T1, A1>&, const aligned_allocator<T2, A2>&) noexcept {
+    return A1 != A2;
+}
@@ -1,60 +1,178 @@
 #include "analog_universal_node_engine_avx2.h"
+#include "engine_checkpoint.h"
+#include "fftw_plan_registry.hpp"
+#include "state_digest.h"
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 #include <fftw3.h>
 #include <immintrin.h>
 #include <omp.h>
-#include <unordered_map>
+#include <map>
 #include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// Default temporal blocking of the Phase 4B/4C missions: tiles of 4096
+// nodes (128 KB of 4C state, L2-resident) advanced 64 steps at a time
+#ifndef DASE_MISSION_TILE_NODES
+#define DASE_MISSION_TILE_NODES 4096
+#endif
+
+#ifndef DASE_MISSION_STEP_BLOCK
+#define DASE_MISSION_STEP_BLOCK 64
+#endif
+
+// runMission() generates its drive signals this many steps at a time
+#ifndef DASE_MISSION_SIGNAL_BLOCK
+#define DASE_MISSION_SIGNAL_BLOCK 1024
+#endif
+
+// Per-function ISA targets for the runtime-dispatched SIMD paths, so they
+// do not depend on the flags of this translation unit
+#if defined(__GNUC__) || defined(__clang__)
+#define DASE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define DASE_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#else
+#define DASE_TARGET_AVX2
+#define DASE_TARGET_AVX512
+#endif
 
-// FFTW Wisdom Cache (thread-safe plan caching for 20-30% speedup)
+
+// FFTW plan cache (plans owned by the process-wide dase::FFTPlanRegistry)
+//
+// Real signals use r2c/c2r plans (N/2+1 bins, half the work of a complex
+// DFT).  Plans are keyed by (N, number of blocks); callers execute them on
+// per-thread work buffers of the same shape through the new-array
+// interface (fftw_execute_dft_r2c/c2r), which is thread-safe.
 struct FFTWPlanCache {
     struct PlanPair {
-        fftw_plan forward;
-        fftw_plan inverse;
+        fftw_plan forward;           // r2c
+        fftw_plan inverse;           // c2r
+        std::vector<double> gain;    // Per-bin filter gain, 1/N normalization folded in
+    };
+
+    // fftw_malloc'd buffers for one transform shape (SIMD-aligned)
+    struct WorkBuffers {
+        double* real = nullptr;          // blocks × N samples
+        fftw_complex* spectrum = nullptr; // blocks × (N/2+1) bins
+
+        WorkBuffers() = default;
+        WorkBuffers(const WorkBuffers&) = delete;
+        WorkBuffers& operator=(const WorkBuffers&) = delete;
+        ~WorkBuffers() {
+            dase::FFTPlanRegistry::release(real);
+            dase::FFTPlanRegistry::release(spectrum);
+        }
+
+        void allocate(int N, int blocks) {
+            const size_t bins = static_cast<size_t>(N / 2 + 1) * blocks;
+            real = dase::FFTPlanRegistry::allocReal(static_cast<size_t>(N) * blocks);
+            spectrum = dase::FFTPlanRegistry::allocComplex(bins);
+            if (!real || !spectrum) {
+                throw std::bad_alloc();
+            }
+        }
     };
 
-    std::unordered_map<int, PlanPair> plans;
+    std::map<std::pair<int, int>, PlanPair> plans;  // Entries are never erased
     std::mutex cache_mutex;
 
-    PlanPair get_or_create_plans(int N, fftw_complex* in, fftw_complex* out) {
+    const PlanPair& get_or_create_plans(int N, int blocks = 1) {
         std::lock_guard<std::mutex> lock(cache_mutex);
 
-        auto it = plans.find(N);
+        auto it = plans.find(std::make_pair(N, blocks));
         if (it != plans.end()) {
             // Plans exist, return them
             return it->second;
         }
 
-        // Create new plans with FFTW_MEASURE for optimal performance
+        // FFTW_MEASURE for optimal performance; the registry plans on its
+        // own buffers and persists the wisdom
+        using dase::FFTPlanKey;
+        using dase::FFTPlanRegistry;
         PlanPair new_plans;
-        new_plans.forward = fftw_plan_dft_1d(N, in, out, FFTW_FORWARD, FFTW_MEASURE);
-        new_plans.inverse = fftw_plan_dft_1d(N, out, in, FFTW_BACKWARD, FFTW_MEASURE);
+        new_plans.forward = FFTPlanRegistry::acquire(
+            FFTPlanKey::make(FFTPlanKey::Kind::R2C, {N}, FFTW_FORWARD, false, blocks),
+            FFTPlanRegistry::Planning::Measure);
+        new_plans.inverse = FFTPlanRegistry::acquire(
+            FFTPlanKey::make(FFTPlanKey::Kind::C2R, {N}, FFTW_BACKWARD, false, blocks),
+            FFTPlanRegistry::Planning::Measure);
+        new_plans.gain = bandpass_gains(N);
+
+        return plans.emplace(std::make_pair(N, blocks), std::move(new_plans)).first->second;
+    }
 
-        plans[N] = new_plans;
-        return new_plans;
+    // Calling thread's work buffers for (N, blocks), reused across calls
+    static WorkBuffers& get_work_buffers(int N, int blocks = 1) {
+        thread_local std::map<std::pair<int, int>, WorkBuffers> buffers;
+        auto it = buffers.find(std::make_pair(N, blocks));
+        if (it == buffers.end()) {
+            it = buffers.emplace(std::piecewise_construct,
+                                 std::forward_as_tuple(N, blocks), std::forward_as_tuple()).first;
+            it->second.allocate(N, blocks);
+        }
+        return it->second;
     }
 
-    ~FFTWPlanCache() {
-        // FIX C2.2: Lock during destruction to prevent use-after-free
-        std::lock_guard<std::mutex> lock(cache_mutex);
-        for (auto& pair : plans) {
-            if (pair.second.forward) fftw_destroy_plan(pair.second.forward);
-            if (pair.second.inverse) fftw_destroy_plan(pair.second.inverse);
+    // Bandpass of the complex-DFT filter: keep bins [N/4, 3N/4], take the
+    // real part of the inverse.  For a real signal that equals gain
+    // (M(k) + M(N-k)) / 2 on the half spectrum k = 0..N/2.
+    static std::vector<double> bandpass_gains(int N) {
+        const int low_cutoff = N / 4;
+        const int high_cutoff = (N * 3) / 4;
+        auto kept = [&](int k) { return (k >= low_cutoff && k <= high_cutoff) ? 1.0 : 0.0; };
+
+        std::vector<double> gain(N / 2 + 1);
+        for (int k = 0; k <= N / 2; ++k) {
+            gain[k] = 0.5 * (kept(k) + kept((N - k) % N)) / N;
         }
+        return gain;
     }
 };
 
 static FFTWPlanCache g_fftw_cache;
 
+// Bandpass-filter `blocks` contiguous blocks of N samples in place
+static void bandpassBlocks(float* data, int N, int blocks) {
+    const FFTWPlanCache::PlanPair& plans = g_fftw_cache.get_or_create_plans(N, blocks);
+    FFTWPlanCache::WorkBuffers& work = FFTWPlanCache::get_work_buffers(N, blocks);
+    const size_t total = static_cast<size_t>(N) * blocks;
+    const int bins = N / 2 + 1;
+
+    for (size_t i = 0; i < total; ++i) {
+        work.real[i] = static_cast<double>(data[i]);
+    }
+
+    fftw_execute_dft_r2c(plans.forward, work.real, work.spectrum);
+
+    const double* gain = plans.gain.data();
+    for (int b = 0; b < blocks; ++b) {
+        fftw_complex* spectrum = work.spectrum + static_cast<size_t>(b) * bins;
+        for (int k = 0; k < bins; ++k) {
+            spectrum[k][0] *= gain[k];
+            spectrum[k][1] *= gain[k];
+        }
+    }
+
+    // c2r overwrites the spectrum, which is not needed afterwards
+    fftw_execute_dft_c2r(plans.inverse, work.spectrum, work.real);
+
+    for (size_t i = 0; i < total; ++i) {
+        data[i] = static_cast<float>(work.real[i]);
+    }
+}
+
 // High-precision timer class
 class PrecisionTimer {
 private:
@@ -92,6 +210,16 @@ void EngineMetrics::reset() noexcept {
     avx2_operations = 0;
     node_processes = 0;
     harmonic_generations = 0;
+    hw_counters_valid = false;
+    hw_cycles = 0;
+    hw_instructions = 0;
+    hw_llc_misses = 0;
+    hw_ipc = 0.0;
+    hw_dram_bandwidth_gbps = 0.0;
+    energy_valid = false;
+    energy_joules = 0.0;
+    energy_average_watts = 0.0;
+    energy_joules_per_node_update = 0.0;
 }
 
 void EngineMetrics::update_performance() noexcept {
@@ -114,7 +242,17 @@ void EngineMetrics::print_metrics() noexcept {
     std::cout << "🔢 Total Operations:   " << total_operations << std::endl;
     std::cout << "⚙️  AVX2 Operations:    " << avx2_operations << " (" << (100.0 * avx2_operations / total_operations) << "%)" << std::endl;
     std::cout << "🎵 Harmonics Generated: " << harmonic_generations << std::endl;
-    
+    if (hw_counters_valid) {
+        std::cout << "🔬 Cycles / Instr:     " << hw_cycles << " / " << hw_instructions
+                  << " (IPC " << hw_ipc << ")" << std::endl;
+        std::cout << "🧠 LLC Misses:         " << hw_llc_misses
+                  << " (~" << hw_dram_bandwidth_gbps << " GB/s)" << std::endl;
+    }
+    if (energy_valid) {
+        std::cout << "🔋 Energy:             " << energy_joules << " J (" << energy_average_watts << " W, "
+                  << std::scientific << energy_joules_per_node_update << std::fixed << " J/node-update)" << std::endl;
+    }
+
     if (current_ns_per_op <= target_ns_per_op) {
         std::cout << "🎉 TARGET ACHIEVED! Engine ready for production!" << std::endl;
     } else {
@@ -242,9 +380,12 @@ double AnalogUniversalNodeAVX2::processSignalAVX2(double input_signal, double co
     return current_output;
 }
 
-// Phase 4A: Hot-path version without profiling counters for maximum performance
-FORCE_INLINE double AnalogUniversalNodeAVX2::processSignalAVX2_hotpath(
-    double input_signal, double control_signal, double aux_signal)
+// Phase 4A: Hot-path node update without profiling counters, on the state
+// fields passed by reference.  Shared by AnalogUniversalNodeAVX2 and the
+// engine's structure-of-arrays loops.
+static FORCE_INLINE double stepNodeState(
+    double& integrator_state, double& previous_input, double& current_output,
+    double feedback_gain, double input_signal, double control_signal, double aux_signal)
 {
     // NO PROFILING - removed COUNT_OPERATION() and COUNT_NODE()
     // Direct inline of all operations for zero overhead
@@ -271,13 +412,20 @@ FORCE_INLINE double AnalogUniversalNodeAVX2::processSignalAVX2_hotpath(
     double feedback_output = integrator_state + feedback_component;
 
     current_output = feedback_output + static_cast<double>(spectral_boost);
-    current_output = clamp_custom(current_output, -10.0, 10.0);
+    current_output = AnalogUniversalNodeAVX2::clamp_custom(current_output, -10.0, 10.0);
 
     previous_input = input_signal;
 
     return current_output;
 }
 
+FORCE_INLINE double AnalogUniversalNodeAVX2::processSignalAVX2_hotpath(
+    double input_signal, double control_signal, double aux_signal)
+{
+    return stepNodeState(integrator_state, previous_input, current_output, feedback_gain,
+                         input_signal, control_signal, aux_signal);
+}
+
 double AnalogUniversalNodeAVX2::processSignal(double input_signal, double control_signal, double aux_signal) {
     return processSignalAVX2(input_signal, control_signal, aux_signal);
 }
@@ -393,51 +541,12 @@ std::vector<float> AnalogUniversalNodeAVX2::processBlockFrequencyDomain(const st
         return std::vector<float>();
     }
 
-    int N = static_cast<int>(input_block.size());
-
-    // Allocate FFTW arrays
-    fftw_complex* in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    fftw_complex* out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-
-    // Get cached plans (or create new ones if not cached)
-    auto plans = g_fftw_cache.get_or_create_plans(N, in, out);
-
-    // Copy input to complex array (real part only)
-    for (int i = 0; i < N; ++i) {
-        in[i][0] = static_cast<double>(input_block[i]);
-        in[i][1] = 0.0;
-    }
-
-    // Execute forward FFT with cached plan
-    fftw_execute_dft(plans.forward, in, out);
-    COUNT_AVX2();
-
     // Apply frequency domain filter (bandpass: keep middle 50%, zero out edges)
     // This is a simple example - can be customized for different filter types
-    int low_cutoff = N / 4;
-    int high_cutoff = (N * 3) / 4;
-
-    for (int i = 0; i < N; ++i) {
-        if (i < low_cutoff || i > high_cutoff) {
-            out[i][0] = 0.0;
-            out[i][1] = 0.0;
-        }
-    }
-
-    // Execute inverse FFT with cached plan
-    fftw_execute_dft(plans.inverse, out, in);
+    std::vector<float> output(input_block);
+    bandpassBlocks(output.data(), static_cast<int>(output.size()), 1);
     COUNT_AVX2();
 
-    // Copy result back and normalize
-    std::vector<float> output(N);
-    for (int i = 0; i < N; ++i) {
-        output[i] = static_cast<float>(in[i][0] / N);
-    }
-
-    // Clean up (plans are cached, only free buffers)
-    fftw_free(in);
-    fftw_free(out);
-
     return output;
 }
 
@@ -448,52 +557,27 @@ void AnalogUniversalNodeAVX2::processBlockFrequencyDomain_inplace(float* data, i
     PROFILE_TOTAL();
     COUNT_OPERATION();
 
-    if (num_samples == 0) {
+    if (num_samples <= 0) {
         return;
     }
 
-    int N = num_samples;
-
-    // Allocate FFTW arrays
-    fftw_complex* in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    fftw_complex* out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-
-    // Get cached plans (or create new ones if not cached)
-    auto plans = g_fftw_cache.get_or_create_plans(N, in, out);
-
-    // Copy input to complex array (real part only)
-    for (int i = 0; i < N; ++i) {
-        in[i][0] = static_cast<double>(data[i]);
-        in[i][1] = 0.0;
-    }
-
-    // Execute forward FFT with cached plan
-    fftw_execute_dft(plans.forward, in, out);
+    bandpassBlocks(data, num_samples, 1);
     COUNT_AVX2();
+}
 
-    // Apply frequency domain filter (bandpass: keep middle 50%, zero out edges)
-    int low_cutoff = N / 4;
-    int high_cutoff = (N * 3) / 4;
+// -----------------------------------------------------------------------------
+// Batched Filter: many equal-length blocks through one r2c/c2r plan pair
+// -----------------------------------------------------------------------------
+void AnalogUniversalNodeAVX2::processBlocksFrequencyDomain_inplace(float* data, int block_size, int num_blocks) {
+    PROFILE_TOTAL();
+    COUNT_OPERATION();
 
-    for (int i = 0; i < N; ++i) {
-        if (i < low_cutoff || i > high_cutoff) {
-            out[i][0] = 0.0;
-            out[i][1] = 0.0;
-        }
+    if (block_size <= 0 || num_blocks <= 0) {
+        return;
     }
 
-    // Execute inverse FFT with cached plan
-    fftw_execute_dft(plans.inverse, out, in);
+    bandpassBlocks(data, block_size, num_blocks);
     COUNT_AVX2();
-
-    // Copy result back and normalize (in-place)
-    for (int i = 0; i < N; ++i) {
-        data[i] = static_cast<float>(in[i][0] / N);
-    }
-
-    // Clean up (plans are cached, only free buffers)
-    fftw_free(in);
-    fftw_free(out);
 }
 
 // -----------------------------------------------------------------------------
@@ -504,8 +588,6 @@ std::vector<double> AnalogUniversalNodeAVX2::processBatch(
     const std::vector<double>& control_signals,
     const std::vector<double>& aux_signals)
 {
-    PROFILE_TOTAL();
-
     // Validate input sizes
     size_t batch_size = input_signals.size();
     if (control_signals.size() != batch_size || aux_signals.size() != batch_size) {
@@ -513,10 +595,19 @@ std::vector<double> AnalogUniversalNodeAVX2::processBatch(
     }
 
     std::vector<double> results(batch_size);
+    processBatch(input_signals.data(), control_signals.data(), aux_signals.data(),
+                 batch_size, results.data());
+    return results;
+}
+
+void AnalogUniversalNodeAVX2::processBatch(const double* input_signals, const double* control_signals,
+                                           const double* aux_signals, size_t num_samples, double* results)
+{
+    PROFILE_TOTAL();
 
     // Process all samples in a tight loop with minimal overhead
     // MSVC /Ob3 handles loop optimization automatically
-    for (size_t i = 0; i < batch_size; ++i) {
+    for (size_t i = 0; i < num_samples; ++i) {
         COUNT_OPERATION();
         COUNT_NODE();
 
@@ -534,54 +625,221 @@ std::vector<double> AnalogUniversalNodeAVX2::processBatch(
         previous_input = input_signals[i];
         results[i] = current_output;
     }
-
-    return results;
 }
 
 // AnalogCellularEngineAVX2 Implementation
 AnalogCellularEngineAVX2::AnalogCellularEngineAVX2(size_t num_nodes)
-    : nodes(num_nodes), system_frequency(1.0), noise_level(0.001) {
+    : AnalogCellularEngineAVX2(num_nodes, NumaOptions()) {
+}
+
+AnalogCellularEngineAVX2::AnalogCellularEngineAVX2(size_t num_nodes, const NumaOptions& numa)
+    : node_info_(num_nodes)
+    , system_frequency(1.0), noise_level(0.001)
+    , numa_options_(numa)
+    , state_page_bytes_(0)
+    , mission_kernel_isa_(CPUFeatures::bestKernelISA())
+    , mission_tile_nodes_(0), mission_step_block_(1)
+    , thread_limit_(0)
+    , state_precision_(StatePrecision::Float64) {
+    setMissionBlocking(DASE_MISSION_TILE_NODES, DASE_MISSION_STEP_BLOCK);
+
+    // Pin before placing, so first touch lands where the kernels will run
+    NumaPlacement::applyThreadAffinity(numa.thread_affinity);
+    state_page_bytes_ = std::min({NumaPlacement::allocate(integrator_state_, num_nodes, numa, 0.0),
+                                  NumaPlacement::allocate(feedback_gain_, num_nodes, numa, 0.0),
+                                  NumaPlacement::allocate(previous_input_, num_nodes, numa, 0.0),
+                                  NumaPlacement::allocate(current_output_, num_nodes, numa, 0.0)});
+
+    metrics_.mission_kernel = mission_kernel_isa_;
     for (size_t i = 0; i < num_nodes; i++) {
-        nodes[i] = AnalogUniversalNodeAVX2();
-        nodes[i].x = static_cast<int16_t>(i % 10);
-        nodes[i].y = static_cast<int16_t>((i / 10) % 10);
-        nodes[i].z = static_cast<int16_t>(i / 100);
-        nodes[i].node_id = static_cast<uint16_t>(i);
+        node_info_[i].x = static_cast<int16_t>(i % 10);
+        node_info_[i].y = static_cast<int16_t>((i / 10) % 10);
+        node_info_[i].z = static_cast<int16_t>(i / 100);
+        node_info_[i].node_id = static_cast<uint16_t>(i);
     }
 }
 
+// NodeView: per-node access to the structure-of-arrays state
+AnalogCellularEngineAVX2::NodeView AnalogCellularEngineAVX2::getNode(size_t index) {
+    if (index >= node_info_.size()) {
+        throw std::out_of_range("Node index out of range");
+    }
+    return NodeView(this, index);
+}
+
+double* AnalogCellularEngineAVX2::getStateArray(StateArray array) noexcept {
+    switch (array) {
+        case StateArray::IntegratorState: return integrator_state_.data();
+        case StateArray::FeedbackGain: return feedback_gain_.data();
+        case StateArray::PreviousInput: return previous_input_.data();
+        case StateArray::CurrentOutput: return current_output_.data();
+    }
+    return nullptr;
+}
+
+double AnalogCellularEngineAVX2::NodeView::getOutput() const noexcept {
+    return engine_->current_output_[index_];
+}
+
+double AnalogCellularEngineAVX2::NodeView::getIntegratorState() const noexcept {
+    return engine_->integrator_state_[index_];
+}
+
+double AnalogCellularEngineAVX2::NodeView::getFeedback() const noexcept {
+    return engine_->feedback_gain_[index_];
+}
+
+void AnalogCellularEngineAVX2::NodeView::setFeedback(double feedback_coefficient) {
+    engine_->feedback_gain_[index_] = AnalogUniversalNodeAVX2::clamp_custom(feedback_coefficient, -2.0, 2.0);
+}
+
+void AnalogCellularEngineAVX2::NodeView::resetIntegrator() noexcept {
+    engine_->integrator_state_[index_] = 0.0;
+    engine_->previous_input_[index_] = 0.0;
+}
+
+int AnalogCellularEngineAVX2::NodeView::getNodeId() const noexcept {
+    return engine_->node_info_[index_].node_id;
+}
+
+// ============================================================================
+// MISSION SIGNAL SOURCE
+// ============================================================================
+//
+// runMission()'s drive is input = sin(step * 0.01), control = cos(step *
+// 0.01).  Blocks of samples are generated by angle addition from an exact
+// std::sin/std::cos anchor at the block start and a per-source table of
+// sin/cos(k * 0.01):
+//     sin(a + kh) = sin(a) cos(kh) + cos(a) sin(kh)
+//     cos(a + kh) = cos(a) cos(kh) - sin(a) sin(kh)
+// which is two multiply-adds per sample (4 samples per AVX2 vector) and
+// within a few ulp of std::sin/std::cos; errors do not accumulate across
+// blocks.  (AVX2Math::fast_sin_avx2 is a float polynomial good only close
+// to zero, so it is not used here.)
+
+class MissionSignalSource {
+public:
+    MissionSignalSource(double angular_step, std::size_t block_size)
+        : angular_step_(angular_step)
+        , sin_table_(block_size)
+        , cos_table_(block_size)
+        , use_avx2_(CPUFeatures::hasAVX2())
+    {
+        for (std::size_t k = 0; k < block_size; ++k) {
+            sin_table_[k] = std::sin(static_cast<double>(k) * angular_step);
+            cos_table_[k] = std::cos(static_cast<double>(k) * angular_step);
+        }
+    }
+
+    std::size_t blockSize() const noexcept { return sin_table_.size(); }
+
+    // Samples [first_step, first_step + count), count <= blockSize()
+    void fill(std::uint64_t first_step, std::size_t count, double* input, double* control) const {
+        const double angle = static_cast<double>(first_step) * angular_step_;
+        const double s0 = std::sin(angle);
+        const double c0 = std::cos(angle);
+        std::size_t k = use_avx2_ ? fillAVX2(s0, c0, count, input, control) : 0;
+        for (; k < count; ++k) {
+            input[k] = s0 * cos_table_[k] + c0 * sin_table_[k];
+            control[k] = c0 * cos_table_[k] - s0 * sin_table_[k];
+        }
+    }
+
+private:
+    DASE_TARGET_AVX2 std::size_t fillAVX2(double s0, double c0, std::size_t count,
+                                          double* input, double* control) const {
+        const __m256d s0_vec = _mm256_set1_pd(s0);
+        const __m256d c0_vec = _mm256_set1_pd(c0);
+        std::size_t k = 0;
+        for (; k + 4 <= count; k += 4) {
+            const __m256d sk = _mm256_loadu_pd(sin_table_.data() + k);
+            const __m256d ck = _mm256_loadu_pd(cos_table_.data() + k);
+            _mm256_storeu_pd(input + k, _mm256_fmadd_pd(s0_vec, ck, _mm256_mul_pd(c0_vec, sk)));
+            _mm256_storeu_pd(control + k, _mm256_fmsub_pd(c0_vec, ck, _mm256_mul_pd(s0_vec, sk)));
+        }
+        return k;
+    }
+
+    double angular_step_;
+    std::vector<double> sin_table_;
+    std::vector<double> cos_table_;
+    bool use_avx2_;
+};
+
 // New: The mission loop is now in C++ to run at max speed
+// Signals are generated a block ahead (double-buffered): while the team
+// advances its node slices through block b, one thread fills block b + 1,
+// so the mission runs as runMissionOptimized's hot loop with one parallel
+// region per signal block instead of one per step.
 void AnalogCellularEngineAVX2::runMission(uint64_t num_steps) {
     #ifdef _OPENMP
     omp_set_dynamic(0);
-    omp_set_num_threads(omp_get_max_threads());
     #endif
+    const dase::ThreadBudget::Lease threads = acquireThreads();
 
     metrics_.reset();
 
     std::cout << "\n🚀 C++ MISSION LOOP STARTED 🚀" << std::endl;
     std::cout << "===============================" << std::endl;
     std::cout << "Total steps: " << num_steps << std::endl;
-    std::cout << "Total nodes: " << nodes.size() << std::endl;
+    std::cout << "Total nodes: " << node_info_.size() << std::endl;
     std::cout << "Threads: " << omp_get_max_threads() << std::endl;
     std::cout << "===============================" << std::endl;
 
+    constexpr std::uint32_t iterations_per_node = 30;
+    const MissionSignalSource source(0.01, static_cast<std::size_t>(
+        std::min<std::uint64_t>(num_steps, DASE_MISSION_SIGNAL_BLOCK)));
+    const std::size_t block = source.blockSize();
+    std::vector<double> input_buffers[2] = {std::vector<double>(block), std::vector<double>(block)};
+    std::vector<double> control_buffers[2] = {std::vector<double>(block), std::vector<double>(block)};
+
     // Profile ONLY the outer loop, not the inner hot path
     auto mission_start = std::chrono::high_resolution_clock::now();
+    startHardwareCounters();
 
-    for (uint64_t step = 0; step < num_steps; ++step) {
-        double input_signal = std::sin(static_cast<double>(step) * 0.01);
-        double control_pattern = std::cos(static_cast<double>(step) * 0.01);
+    const int num_nodes_int = static_cast<int>(node_info_.size());
+    double* integrator = integrator_state_.data();
+    double* previous = previous_input_.data();
+    double* output = current_output_.data();
+    const double* feedback = feedback_gain_.data();
 
-        #pragma omp parallel for
-        for (int i = 0; i < nodes.size(); i++) {
-            // Process 30 iterations for this node
-            // Compiler /Ob3 flag handles loop optimization automatically
-            for (int j = 0; j < 30; ++j) {
-                nodes[i].processSignalAVX2(input_signal, control_pattern, 0.0);
+    if (num_steps > 0) {
+        source.fill(0, block, input_buffers[0].data(), control_buffers[0].data());
+    }
+    int current = 0;
+    for (uint64_t block_start = 0; block_start < num_steps; block_start += block) {
+        const int64_t block_steps = static_cast<int64_t>(std::min<uint64_t>(block, num_steps - block_start));
+        const uint64_t next_start = block_start + block;
+        const double* input = input_buffers[current].data();
+        const double* control = control_buffers[current].data();
+        double* next_input = input_buffers[1 - current].data();
+        double* next_control = control_buffers[1 - current].data();
+
+        #pragma omp parallel
+        {
+            // Producer: one thread fills the next block, then joins the sweep
+            #pragma omp single nowait
+            {
+                if (next_start < num_steps) {
+                    source.fill(next_start,
+                                static_cast<std::size_t>(std::min<uint64_t>(block, num_steps - next_start)),
+                                next_input, next_control);
+                }
+            }
+
+            // Nodes are independent: whole block per node, no step barriers
+            #pragma omp for schedule(static)
+            for (int i = 0; i < num_nodes_int; ++i) {
+                for (int64_t step = 0; step < block_steps; ++step) {
+                    for (uint32_t j = 0; j < iterations_per_node; ++j) {
+                        stepNodeState(integrator[i], previous[i], output[i], feedback[i],
+                                      input[step], control[step], 0.0);
+                    }
+                }
             }
         }
-        
+        current = 1 - current;
+
         // Removed blocking I/O here to prevent bottlenecks
         // No progress logs to keep the CPU focused on computation
     }
@@ -590,6 +848,11 @@ void AnalogCellularEngineAVX2::runMission(uint64_t num_steps) {
     auto mission_end = std::chrono::high_resolution_clock::now();
     auto mission_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start);
     metrics_.total_execution_time_ns = mission_duration.count();
+    metrics_.total_operations = num_steps * node_info_.size() * iterations_per_node;
+    metrics_.node_processes = metrics_.total_operations;
+    metrics_.mission_kernel = KernelISA::Scalar;
+    stopHardwareCounters(num_steps * node_info_.size());
+    metrics_.update_performance();
 
     metrics_.print_metrics();
     std::cout << "===============================" << std::endl;
@@ -606,20 +869,24 @@ void AnalogCellularEngineAVX2::runMissionOptimized(
 ) {
     #ifdef _OPENMP
     omp_set_dynamic(0);
-    omp_set_num_threads(omp_get_max_threads());
     #endif
+    const dase::ThreadBudget::Lease threads = acquireThreads();
 
     metrics_.reset();
 
     auto mission_start = std::chrono::high_resolution_clock::now();
+    startHardwareCounters();
 
     // Phase 4A optimizations:
-    // 1. Cache pointer for direct access (eliminate vector overhead)
+    // 1. Cache pointers for direct access (eliminate vector overhead)
     // 2. Use hot-path version without profiling counters
     // 3. Force inlining of all trivial functions
     const int64_t num_steps_int = static_cast<int64_t>(num_steps);
-    const int num_nodes_int = static_cast<int>(nodes.size());
-    auto* nodes_ptr = nodes.data();  // Direct pointer access
+    const int num_nodes_int = static_cast<int>(node_info_.size());
+    double* integrator = integrator_state_.data();
+    double* previous = previous_input_.data();
+    double* output = current_output_.data();
+    const double* feedback = feedback_gain_.data();
 
     for (int64_t step = 0; step < num_steps_int; ++step) {
         const double input = input_signals[step];
@@ -627,11 +894,9 @@ void AnalogCellularEngineAVX2::runMissionOptimized(
 
         #pragma omp parallel for schedule(static)
         for (int i = 0; i < num_nodes_int; ++i) {
-            auto& node = nodes_ptr[i];  // Direct pointer dereference
-
             // Inner hot loop: Use hot-path version (no profiling)
             for (uint32_t j = 0; j < iterations_per_node; ++j) {
-                node.processSignalAVX2_hotpath(input, control, 0.0);
+                stepNodeState(integrator[i], previous[i], output[i], feedback[i], input, control, 0.0);
             }
         }
     }
@@ -641,8 +906,10 @@ void AnalogCellularEngineAVX2::runMissionOptimized(
 
     // Calculate metrics in bulk (not per operation) for Phase 4A
     metrics_.total_execution_time_ns = mission_duration.count();
-    metrics_.total_operations = num_steps * nodes.size() * iterations_per_node;
+    metrics_.total_operations = num_steps * node_info_.size() * iterations_per_node;
     metrics_.node_processes = metrics_.total_operations;  // Same count
+    metrics_.mission_kernel = KernelISA::Scalar;
+    stopHardwareCounters(num_steps * node_info_.size());
     metrics_.update_performance();
 
     // Suppress console metrics to keep CLI stdout JSON-only
@@ -658,16 +925,22 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4B(
 ) {
     #ifdef _OPENMP
     omp_set_dynamic(0);
-    omp_set_num_threads(omp_get_max_threads());
     #endif
+    const dase::ThreadBudget::Lease threads = acquireThreads();
 
     metrics_.reset();
 
     auto mission_start = std::chrono::high_resolution_clock::now();
+    startHardwareCounters();
 
     const int64_t num_steps_int = static_cast<int64_t>(num_steps);
-    const int num_nodes_int = static_cast<int>(nodes.size());
-    auto* nodes_ptr = nodes.data();
+    const int num_nodes_int = static_cast<int>(node_info_.size());
+    double* integrator = integrator_state_.data();
+    double* previous = previous_input_.data();
+    double* output = current_output_.data();
+    const double* feedback = feedback_gain_.data();
+    const int tile_nodes = static_cast<int>(mission_tile_nodes_);
+    const int64_t step_block = mission_step_block_;
 
     // Phase 4B: Single parallel region with manual work distribution
     // This eliminates 54,750 implicit barriers (one per step)
@@ -685,18 +958,26 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4B(
                              : num_nodes_int;
 
         // Process all steps for this thread's node slice
-        // No barriers between steps!
-        for (int64_t step = 0; step < num_steps_int; ++step) {
-            const double input = input_signals[step];
-            const double control = control_patterns[step];
-
-            // Each thread processes its assigned nodes
-            for (int i = node_start; i < node_end; ++i) {
-                auto& node = nodes_ptr[i];
-
-                // Hot-path inner loop
-                for (uint32_t j = 0; j < iterations_per_node; ++j) {
-                    node.processSignalAVX2_hotpath(input, control, 0.0);
+        // No barriers between steps!  Temporal blocking: each tile of the
+        // slice runs a block of steps while it is cache-resident
+        const int tile = (tile_nodes > 0) ? tile_nodes : std::max(node_end - node_start, 1);
+        for (int64_t block = 0; block < num_steps_int; block += step_block) {
+            const int64_t block_end = std::min(block + step_block, num_steps_int);
+
+            for (int tile_start = node_start; tile_start < node_end; tile_start += tile) {
+                const int tile_end = std::min(tile_start + tile, node_end);
+
+                for (int64_t step = block; step < block_end; ++step) {
+                    const double input = input_signals[step];
+                    const double control = control_patterns[step];
+
+                    // Each thread processes its assigned nodes
+                    for (int i = tile_start; i < tile_end; ++i) {
+                        // Hot-path inner loop
+                        for (uint32_t j = 0; j < iterations_per_node; ++j) {
+                            stepNodeState(integrator[i], previous[i], output[i], feedback[i], input, control, 0.0);
+                        }
+                    }
                 }
             }
         }
@@ -706,14 +987,553 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4B(
     auto mission_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start);
 
     metrics_.total_execution_time_ns = mission_duration.count();
-    metrics_.total_operations = num_steps * nodes.size() * iterations_per_node;
+    metrics_.total_operations = num_steps * node_info_.size() * iterations_per_node;
     metrics_.node_processes = metrics_.total_operations;
+    metrics_.mission_kernel = KernelISA::Scalar;
+    stopHardwareCounters(num_steps * node_info_.size());
     metrics_.update_performance();
 
     // Suppress console metrics to keep CLI stdout JSON-only
 }
 
 // Phase 4C: AVX2 Spatial Vectorization - Process 4 nodes in parallel
+// ============================================================================
+// PHASE 4C MISSION KERNEL VARIANTS
+// ============================================================================
+//
+// Each variant advances nodes [begin, end) of a thread's slice by one step.
+// Nodes go in groups of four through the vectorised update (spectral boost
+// approximated as 0.01 * amplified); a tail of fewer than four takes the
+// exact stepNodeState.  Every variant groups nodes the same way, so the
+// ISA changes speed, not which nodes are approximated.  The AVX2 and
+// AVX-512 variants are bit-identical (no FMA in the group update); the
+// scalar one may differ in the last bit where the compiler contracts.
+//
+// The SIMD bodies carry DASE_TARGET_* attributes; runtime selection goes
+// through CPUFeatures::bestKernelISA().
+
+struct MissionStateArrays {
+    double* integrator;
+    double* previous;
+    double* output;
+    const double* feedback;
+};
+
+using Phase4CKernel = void (*)(const MissionStateArrays& state, int begin, int end,
+                               double input, double control, std::uint32_t iterations);
+
+static void phase4cTail(const MissionStateArrays& state, int begin, int end,
+                        double input, double control, std::uint32_t iterations) {
+    for (int i = begin; i < end; ++i) {
+        for (std::uint32_t j = 0; j < iterations; ++j) {
+            stepNodeState(state.integrator[i], state.previous[i], state.output[i],
+                          state.feedback[i], input, control, 0.0);
+        }
+    }
+}
+
+// _mm_min_pd / _mm_max_pd semantics (second operand on NaN)
+static FORCE_INLINE double simdMin(double a, double b) { return a < b ? a : b; }
+static FORCE_INLINE double simdMax(double a, double b) { return a > b ? a : b; }
+static FORCE_INLINE float simdMin(float a, float b) { return a < b ? a : b; }
+static FORCE_INLINE float simdMax(float a, float b) { return a > b ? a : b; }
+
+static void phase4cKernelScalar(const MissionStateArrays& state, int begin, int end,
+                                double input, double control, std::uint32_t iterations) {
+    const double amplified = input * control;
+    const int group_end = begin + ((end - begin) / 4) * 4;
+
+    for (int i = begin; i < group_end; ++i) {
+        double integrator = state.integrator[i];
+        const double feedback_gain = state.feedback[i];
+        double output = 0.0;
+        for (std::uint32_t iter = 0; iter < iterations; ++iter) {
+            double increment = amplified * 0.1;
+            increment = increment * (1.0 / 48000.0);
+            integrator = integrator + increment;
+            integrator = integrator * 0.999999;
+            integrator = simdMax(simdMin(integrator, 1e6), -1e6);
+            const double feedback_out = integrator + integrator * feedback_gain;
+            output = feedback_out + amplified * 0.01;
+            output = simdMax(simdMin(output, 10.0), -10.0);
+        }
+        state.integrator[i] = integrator;
+        state.output[i] = output;
+        state.previous[i] = input;
+    }
+    phase4cTail(state, group_end, end, input, control, iterations);
+}
+
+// One group of 4 nodes starting at i (32-byte aligned)
+static DASE_TARGET_AVX2 FORCE_INLINE void phase4cGroupAVX2(
+    const MissionStateArrays& state, int i, __m256d input_vec, __m256d amplified_vec,
+    std::uint32_t iterations) {
+    const __m256d dt_vec = _mm256_set1_pd(1.0 / 48000.0);
+    const __m256d gain_vec = _mm256_set1_pd(0.1);
+    const __m256d decay_vec = _mm256_set1_pd(0.999999);
+    const __m256d max_accum_vec = _mm256_set1_pd(1e6);
+    const __m256d min_accum_vec = _mm256_set1_pd(-1e6);
+    const __m256d max_out_vec = _mm256_set1_pd(10.0);
+    const __m256d min_out_vec = _mm256_set1_pd(-10.0);
+    const __m256d spectral_vec = _mm256_mul_pd(amplified_vec, _mm256_set1_pd(0.01));
+
+    __m256d integrator_vec = _mm256_load_pd(state.integrator + i);
+    const __m256d feedback_gain_vec = _mm256_load_pd(state.feedback + i);
+    __m256d output_vec = _mm256_setzero_pd();
+
+    for (std::uint32_t iter = 0; iter < iterations; ++iter) {
+        // Integrate: integrator += amplified * 0.1 * dt, then decay and clamp
+        __m256d increment = _mm256_mul_pd(amplified_vec, gain_vec);
+        increment = _mm256_mul_pd(increment, dt_vec);
+        integrator_vec = _mm256_add_pd(integrator_vec, increment);
+        integrator_vec = _mm256_mul_pd(integrator_vec, decay_vec);
+        integrator_vec = _mm256_min_pd(integrator_vec, max_accum_vec);
+        integrator_vec = _mm256_max_pd(integrator_vec, min_accum_vec);
+
+        // Feedback, spectral approximation, output clamp
+        __m256d feedback_comp = _mm256_mul_pd(integrator_vec, feedback_gain_vec);
+        __m256d feedback_out = _mm256_add_pd(integrator_vec, feedback_comp);
+        output_vec = _mm256_add_pd(feedback_out, spectral_vec);
+        output_vec = _mm256_min_pd(output_vec, max_out_vec);
+        output_vec = _mm256_max_pd(output_vec, min_out_vec);
+    }
+
+    _mm256_store_pd(state.integrator + i, integrator_vec);
+    _mm256_store_pd(state.output + i, output_vec);
+    _mm256_store_pd(state.previous + i, input_vec);
+}
+
+static DASE_TARGET_AVX2 void phase4cKernelAVX2(const MissionStateArrays& state, int begin, int end,
+                                               double input, double control, std::uint32_t iterations) {
+    const __m256d input_vec = _mm256_set1_pd(input);
+    const __m256d amplified_vec = _mm256_mul_pd(input_vec, _mm256_set1_pd(control));
+    const int group_end = begin + ((end - begin) / 4) * 4;
+
+    for (int i = begin; i < group_end; i += 4) {
+        phase4cGroupAVX2(state, i, input_vec, amplified_vec, iterations);
+    }
+    phase4cTail(state, group_end, end, input, control, iterations);
+}
+
+// GCC 12's avx512fintrin.h trips -Wmaybe-uninitialized on its own
+// _mm512_undefined_pd() placeholders (GCC PR 105593)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+static DASE_TARGET_AVX512 void phase4cKernelAVX512(const MissionStateArrays& state, int begin, int end,
+                                                   double input, double control, std::uint32_t iterations) {
+    const __m512d input_vec = _mm512_set1_pd(input);
+    const __m512d amplified_vec = _mm512_mul_pd(input_vec, _mm512_set1_pd(control));
+    const __m512d dt_vec = _mm512_set1_pd(1.0 / 48000.0);
+    const __m512d gain_vec = _mm512_set1_pd(0.1);
+    const __m512d decay_vec = _mm512_set1_pd(0.999999);
+    const __m512d max_accum_vec = _mm512_set1_pd(1e6);
+    const __m512d min_accum_vec = _mm512_set1_pd(-1e6);
+    const __m512d max_out_vec = _mm512_set1_pd(10.0);
+    const __m512d min_out_vec = _mm512_set1_pd(-10.0);
+    const __m512d spectral_vec = _mm512_mul_pd(amplified_vec, _mm512_set1_pd(0.01));
+    const int group_end = begin + ((end - begin) / 4) * 4;
+    const int wide_end = begin + ((end - begin) / 8) * 8;
+
+    // Slices start on multiples of 8 nodes: these are 64-byte aligned
+    int i = begin;
+    for (; i < wide_end; i += 8) {
+        __m512d integrator_vec = _mm512_load_pd(state.integrator + i);
+        const __m512d feedback_gain_vec = _mm512_load_pd(state.feedback + i);
+        __m512d output_vec = _mm512_setzero_pd();
+
+        for (std::uint32_t iter = 0; iter < iterations; ++iter) {
+            __m512d increment = _mm512_mul_pd(amplified_vec, gain_vec);
+            increment = _mm512_mul_pd(increment, dt_vec);
+            integrator_vec = _mm512_add_pd(integrator_vec, increment);
+            integrator_vec = _mm512_mul_pd(integrator_vec, decay_vec);
+            integrator_vec = _mm512_min_pd(integrator_vec, max_accum_vec);
+            integrator_vec = _mm512_max_pd(integrator_vec, min_accum_vec);
+
+            __m512d feedback_comp = _mm512_mul_pd(integrator_vec, feedback_gain_vec);
+            __m512d feedback_out = _mm512_add_pd(integrator_vec, feedback_comp);
+            output_vec = _mm512_add_pd(feedback_out, spectral_vec);
+            output_vec = _mm512_min_pd(output_vec, max_out_vec);
+            output_vec = _mm512_max_pd(output_vec, min_out_vec);
+        }
+
+        _mm512_store_pd(state.integrator + i, integrator_vec);
+        _mm512_store_pd(state.output + i, output_vec);
+        _mm512_store_pd(state.previous + i, input_vec);
+    }
+
+    // At most one group of 4 left before the scalar tail
+    if (i < group_end) {
+        phase4cGroupAVX2(state, i, _mm512_castpd512_pd256(input_vec),
+                         _mm512_castpd512_pd256(amplified_vec), iterations);
+    }
+    phase4cTail(state, group_end, end, input, control, iterations);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+static Phase4CKernel selectPhase4CKernel(KernelISA isa) noexcept {
+    switch (isa) {
+        case KernelISA::AVX512: return phase4cKernelAVX512;
+        case KernelISA::AVX2:   return phase4cKernelAVX2;
+        case KernelISA::Scalar: break;
+    }
+    return phase4cKernelScalar;
+}
+
+// ============================================================================
+// PHASE 4C FLOAT32 MISSION KERNELS (StatePrecision::Float32)
+// ============================================================================
+//
+// Same update and grouping as the double variants, on float copies of the
+// integrator / feedback / output arrays: 8 nodes per AVX2 vector, 16 per
+// AVX-512 vector, a 4-node SSE group for the remainder and the exact
+// double stepNodeState for the tail.  The step constants (increment and
+// spectral term) are computed in double and rounded once, and the decay
+// is integrator - integrator * 1e-6 (0.999999f itself is off by 1.3e-9,
+// which would compound over every iteration).  AVX2 and AVX-512 are
+// bit-identical; the scalar variant may differ where the compiler
+// contracts.
+
+struct MissionStateArraysF32 {
+    float* integrator;
+    float* output;
+    const float* feedback;
+};
+
+using Phase4CKernelF32 = void (*)(const MissionStateArraysF32& state, int begin, int end,
+                                  double input, double control, std::uint32_t iterations);
+
+static void phase4cTailF32(const MissionStateArraysF32& state, int begin, int end,
+                           double input, double control, std::uint32_t iterations) {
+    for (int i = begin; i < end; ++i) {
+        double integrator = state.integrator[i];
+        double output = state.output[i];
+        double previous = 0.0;
+        for (std::uint32_t j = 0; j < iterations; ++j) {
+            stepNodeState(integrator, previous, output, state.feedback[i], input, control, 0.0);
+        }
+        state.integrator[i] = static_cast<float>(integrator);
+        state.output[i] = static_cast<float>(output);
+    }
+}
+
+static void phase4cKernelScalarF32(const MissionStateArraysF32& state, int begin, int end,
+                                   double input, double control, std::uint32_t iterations) {
+    const double amplified = input * control;
+    const float increment = static_cast<float>(amplified * 0.1 * (1.0 / 48000.0));
+    const float spectral = static_cast<float>(amplified * 0.01);
+    const int group_end = begin + ((end - begin) / 4) * 4;
+
+    for (int i = begin; i < group_end; ++i) {
+        float integrator = state.integrator[i];
+        const float feedback_gain = state.feedback[i];
+        float output = 0.0f;
+        for (std::uint32_t iter = 0; iter < iterations; ++iter) {
+            integrator = integrator + increment;
+            integrator = integrator - integrator * 1e-6f;
+            integrator = simdMax(simdMin(integrator, 1e6f), -1e6f);
+            const float feedback_out = integrator + integrator * feedback_gain;
+            output = simdMax(simdMin(feedback_out + spectral, 10.0f), -10.0f);
+        }
+        state.integrator[i] = integrator;
+        state.output[i] = output;
+    }
+    phase4cTailF32(state, group_end, end, input, control, iterations);
+}
+
+// One group of 4 nodes starting at i (unaligned loads)
+static DASE_TARGET_AVX2 FORCE_INLINE void phase4cGroupF32x4(
+    const MissionStateArraysF32& state, int i, __m128 increment_vec, __m128 spectral_vec,
+    std::uint32_t iterations) {
+    const __m128 decay_vec = _mm_set1_ps(1e-6f);
+    const __m128 max_accum_vec = _mm_set1_ps(1e6f);
+    const __m128 min_accum_vec = _mm_set1_ps(-1e6f);
+    const __m128 max_out_vec = _mm_set1_ps(10.0f);
+    const __m128 min_out_vec = _mm_set1_ps(-10.0f);
+
+    __m128 integrator_vec = _mm_loadu_ps(state.integrator + i);
+    const __m128 feedback_gain_vec = _mm_loadu_ps(state.feedback + i);
+    __m128 output_vec = _mm_setzero_ps();
+
+    for (std::uint32_t iter = 0; iter < iterations; ++iter) {
+        integrator_vec = _mm_add_ps(integrator_vec, increment_vec);
+        integrator_vec = _mm_sub_ps(integrator_vec, _mm_mul_ps(integrator_vec, decay_vec));
+        integrator_vec = _mm_max_ps(_mm_min_ps(integrator_vec, max_accum_vec), min_accum_vec);
+
+        const __m128 feedback_out = _mm_add_ps(integrator_vec, _mm_mul_ps(integrator_vec, feedback_gain_vec));
+        output_vec = _mm_add_ps(feedback_out, spectral_vec);
+        output_vec = _mm_max_ps(_mm_min_ps(output_vec, max_out_vec), min_out_vec);
+    }
+
+    _mm_storeu_ps(state.integrator + i, integrator_vec);
+    _mm_storeu_ps(state.output + i, output_vec);
+}
+
+// One group of 8 nodes starting at i (32-byte aligned)
+static DASE_TARGET_AVX2 FORCE_INLINE void phase4cGroupF32x8(
+    const MissionStateArraysF32& state, int i, __m256 increment_vec, __m256 spectral_vec,
+    std::uint32_t iterations) {
+    const __m256 decay_vec = _mm256_set1_ps(1e-6f);
+    const __m256 max_accum_vec = _mm256_set1_ps(1e6f);
+    const __m256 min_accum_vec = _mm256_set1_ps(-1e6f);
+    const __m256 max_out_vec = _mm256_set1_ps(10.0f);
+    const __m256 min_out_vec = _mm256_set1_ps(-10.0f);
+
+    __m256 integrator_vec = _mm256_load_ps(state.integrator + i);
+    const __m256 feedback_gain_vec = _mm256_load_ps(state.feedback + i);
+    __m256 output_vec = _mm256_setzero_ps();
+
+    for (std::uint32_t iter = 0; iter < iterations; ++iter) {
+        integrator_vec = _mm256_add_ps(integrator_vec, increment_vec);
+        integrator_vec = _mm256_sub_ps(integrator_vec, _mm256_mul_ps(integrator_vec, decay_vec));
+        integrator_vec = _mm256_max_ps(_mm256_min_ps(integrator_vec, max_accum_vec), min_accum_vec);
+
+        const __m256 feedback_out = _mm256_add_ps(integrator_vec, _mm256_mul_ps(integrator_vec, feedback_gain_vec));
+        output_vec = _mm256_add_ps(feedback_out, spectral_vec);
+        output_vec = _mm256_max_ps(_mm256_min_ps(output_vec, max_out_vec), min_out_vec);
+    }
+
+    _mm256_store_ps(state.integrator + i, integrator_vec);
+    _mm256_store_ps(state.output + i, output_vec);
+}
+
+static DASE_TARGET_AVX2 void phase4cKernelAVX2F32(const MissionStateArraysF32& state, int begin, int end,
+                                                  double input, double control, std::uint32_t iterations) {
+    const double amplified = input * control;
+    const float increment = static_cast<float>(amplified * 0.1 * (1.0 / 48000.0));
+    const float spectral = static_cast<float>(amplified * 0.01);
+    const int group_end = begin + ((end - begin) / 4) * 4;
+    const int wide_end = begin + ((end - begin) / 8) * 8;
+
+    // Slices start on multiples of 8 nodes: these are 32-byte aligned
+    int i = begin;
+    for (; i < wide_end; i += 8) {
+        phase4cGroupF32x8(state, i, _mm256_set1_ps(increment), _mm256_set1_ps(spectral), iterations);
+    }
+    if (i < group_end) {
+        phase4cGroupF32x4(state, i, _mm_set1_ps(increment), _mm_set1_ps(spectral), iterations);
+    }
+    phase4cTailF32(state, group_end, end, input, control, iterations);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+static DASE_TARGET_AVX512 void phase4cKernelAVX512F32(const MissionStateArraysF32& state, int begin, int end,
+                                                      double input, double control, std::uint32_t iterations) {
+    const double amplified = input * control;
+    const float increment = static_cast<float>(amplified * 0.1 * (1.0 / 48000.0));
+    const float spectral = static_cast<float>(amplified * 0.01);
+    const __m512 increment_vec = _mm512_set1_ps(increment);
+    const __m512 spectral_vec = _mm512_set1_ps(spectral);
+    const __m512 decay_vec = _mm512_set1_ps(1e-6f);
+    const __m512 max_accum_vec = _mm512_set1_ps(1e6f);
+    const __m512 min_accum_vec = _mm512_set1_ps(-1e6f);
+    const __m512 max_out_vec = _mm512_set1_ps(10.0f);
+    const __m512 min_out_vec = _mm512_set1_ps(-10.0f);
+    const int group_end = begin + ((end - begin) / 4) * 4;
+    const int wide_end = begin + ((end - begin) / 16) * 16;
+
+    // Slices start on multiples of 8 nodes, so 16-node groups may be
+    // only 32-byte aligned
+    int i = begin;
+    for (; i < wide_end; i += 16) {
+        __m512 integrator_vec = _mm512_loadu_ps(state.integrator + i);
+        const __m512 feedback_gain_vec = _mm512_loadu_ps(state.feedback + i);
+        __m512 output_vec = _mm512_setzero_ps();
+
+        for (std::uint32_t iter = 0; iter < iterations; ++iter) {
+            integrator_vec = _mm512_add_ps(integrator_vec, increment_vec);
+            integrator_vec = _mm512_sub_ps(integrator_vec, _mm512_mul_ps(integrator_vec, decay_vec));
+            integrator_vec = _mm512_max_ps(_mm512_min_ps(integrator_vec, max_accum_vec), min_accum_vec);
+
+            const __m512 feedback_out = _mm512_add_ps(integrator_vec, _mm512_mul_ps(integrator_vec, feedback_gain_vec));
+            output_vec = _mm512_add_ps(feedback_out, spectral_vec);
+            output_vec = _mm512_max_ps(_mm512_min_ps(output_vec, max_out_vec), min_out_vec);
+        }
+
+        _mm512_storeu_ps(state.integrator + i, integrator_vec);
+        _mm512_storeu_ps(state.output + i, output_vec);
+    }
+
+    // At most one group of 8 and one of 4 left before the tail
+    if (i + 8 <= group_end) {
+        phase4cGroupF32x8(state, i, _mm256_set1_ps(increment), _mm256_set1_ps(spectral), iterations);
+        i += 8;
+    }
+    if (i < group_end) {
+        phase4cGroupF32x4(state, i, _mm_set1_ps(increment), _mm_set1_ps(spectral), iterations);
+    }
+    phase4cTailF32(state, group_end, end, input, control, iterations);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+static Phase4CKernelF32 selectPhase4CKernelF32(KernelISA isa) noexcept {
+    switch (isa) {
+        case KernelISA::AVX512: return phase4cKernelAVX512F32;
+        case KernelISA::AVX2:   return phase4cKernelAVX2F32;
+        case KernelISA::Scalar: break;
+    }
+    return phase4cKernelScalarF32;
+}
+
+void AnalogCellularEngineAVX2::setMissionKernelISA(KernelISA isa) {
+    if (!CPUFeatures::supportsKernelISA(isa)) {
+        throw std::invalid_argument(std::string("CPU does not support the ") +
+                                    CPUFeatures::kernelISAName(isa) + " mission kernel");
+    }
+    mission_kernel_isa_ = isa;
+    metrics_.mission_kernel = isa;
+}
+
+bool AnalogCellularEngineAVX2::enableHardwareCounters(bool enable) {
+    hw_counters_.reset();
+    if (enable) {
+        auto counters = std::make_unique<HardwareCounters>();
+        if (counters->open()) {
+            hw_counters_ = std::move(counters);
+        }
+    }
+    return hw_counters_ != nullptr;
+}
+
+bool AnalogCellularEngineAVX2::enableEnergyMeter(bool enable) {
+    energy_meter_.reset();
+    if (enable) {
+        auto meter = std::make_unique<EnergyMeter>();
+        if (meter->open()) {
+            energy_meter_ = std::move(meter);
+        }
+    }
+    return energy_meter_ != nullptr;
+}
+
+void AnalogCellularEngineAVX2::startHardwareCounters() noexcept {
+    if (hw_counters_) {
+        hw_counters_->start();
+    }
+    if (energy_meter_) {
+        energy_meter_->start();
+    }
+}
+
+void AnalogCellularEngineAVX2::stopHardwareCounters(std::uint64_t node_updates) noexcept {
+    const EnergySample energy = energy_meter_ ? energy_meter_->stop() : EnergySample();
+    metrics_.energy_valid = energy.valid;
+    metrics_.energy_joules = energy.joules;
+    metrics_.energy_average_watts = energy.averageWatts();
+    metrics_.energy_joules_per_node_update = node_updates > 0 ? energy.joules / static_cast<double>(node_updates) : 0.0;
+
+    const HardwareCounterSample sample = hw_counters_ ? hw_counters_->stop() : HardwareCounterSample();
+    metrics_.hw_counters_valid = sample.valid;
+    metrics_.hw_cycles = sample.cycles;
+    metrics_.hw_instructions = sample.instructions;
+    metrics_.hw_llc_misses = sample.llc_misses;
+    metrics_.hw_ipc = (sample.cycles > 0)
+        ? static_cast<double>(sample.instructions) / static_cast<double>(sample.cycles) : 0.0;
+    metrics_.hw_dram_bandwidth_gbps = (metrics_.total_execution_time_ns > 0)
+        ? static_cast<double>(sample.llc_misses) * 64.0 / static_cast<double>(metrics_.total_execution_time_ns)
+        : 0.0;  // bytes per ns = GB/s
+}
+
+void AnalogCellularEngineAVX2::setStatePrecision(StatePrecision precision) {
+    const std::size_t n = node_info_.size();
+    if (precision == StatePrecision::Float32) {
+        if (integrator_f32_.size() != n) {
+            NumaPlacement::allocate(integrator_f32_, n, numa_options_, 0.0f);
+            NumaPlacement::allocate(feedback_f32_, n, numa_options_, 0.0f);
+            NumaPlacement::allocate(output_f32_, n, numa_options_, 0.0f);
+        }
+    } else {
+        AlignedFloatArray().swap(integrator_f32_);
+        AlignedFloatArray().swap(feedback_f32_);
+        AlignedFloatArray().swap(output_f32_);
+    }
+    state_precision_ = precision;
+}
+
+void AnalogCellularEngineAVX2::setMissionBlocking(std::size_t tile_nodes, std::uint32_t step_block) {
+    if (tile_nodes > 0 && step_block == 0) {
+        throw std::invalid_argument("Mission step block must be positive when tiling is enabled");
+    }
+    constexpr std::size_t MAX_TILE_NODES = 1u << 28;
+    if (tile_nodes > MAX_TILE_NODES) {
+        throw std::invalid_argument("Mission tile exceeds 2^28 nodes");
+    }
+    // Round tiles to whole 8-node (cache line) groups
+    mission_tile_nodes_ = (tile_nodes + 7) & ~static_cast<std::size_t>(7);
+    mission_step_block_ = (tile_nodes > 0) ? step_block : 1;
+}
+
+void AnalogCellularEngineAVX2::setThreadLimit(int threads, const std::vector<int>& cpus) {
+    if (threads < 0) {
+        throw std::invalid_argument("Thread limit must not be negative");
+    }
+    for (int cpu : cpus) {
+        if (cpu < 0) {
+            throw std::invalid_argument("CPU ids must not be negative");
+        }
+    }
+    thread_limit_ = threads;
+    thread_cpus_ = cpus;
+}
+
+dase::ThreadBudget::Lease AnalogCellularEngineAVX2::acquireThreads() const {
+    return dase::ThreadBudget::process().acquire(thread_limit_, &thread_cpus_);
+}
+
+void AnalogCellularEngineAVX2::saveCheckpoint(dase::CheckpointWriter& writer) const {
+    const std::size_t n = node_info_.size();
+    writer.addF64("phase4b.integrator_state", integrator_state_.data(), n);
+    writer.addF64("phase4b.feedback_gain", feedback_gain_.data(), n);
+    writer.addF64("phase4b.previous_input", previous_input_.data(), n);
+    writer.addF64("phase4b.current_output", current_output_.data(), n);
+    writer.addRecords("phase4b.node_info", node_info_);
+    writer.addValues("phase4b.settings", {system_frequency, noise_level});
+}
+
+uint64_t AnalogCellularEngineAVX2::stateDigest(double tolerance) const {
+    const std::size_t n = node_info_.size();
+    const std::vector<std::string> names = {"integrator_state", "feedback_gain", "previous_input", "current_output"};
+    const std::vector<uint64_t> digests = {
+        dase::StateDigest::field(integrator_state_.data(), n, tolerance),
+        dase::StateDigest::field(feedback_gain_.data(), n, tolerance),
+        dase::StateDigest::field(previous_input_.data(), n, tolerance),
+        dase::StateDigest::field(current_output_.data(), n, tolerance)
+    };
+    return dase::StateDigest::combine(names, digests);
+}
+
+void AnalogCellularEngineAVX2::restoreCheckpoint(const dase::CheckpointImage& image) {
+    const std::size_t n = node_info_.size();
+    if (image.count("phase4b.node_info") != n) {
+        throw std::runtime_error("Checkpoint has " + std::to_string(image.count("phase4b.node_info")) +
+                                 " nodes, engine has " + std::to_string(n));
+    }
+    // Check every section before touching the engine
+    for (const char* name : {"phase4b.integrator_state", "phase4b.feedback_gain",
+                             "phase4b.previous_input", "phase4b.current_output"}) {
+        image.data(name, dase::CheckpointType::F64, sizeof(double), n);
+    }
+    image.data("phase4b.node_info", dase::CheckpointType::Bytes, sizeof(NodeInfo), n);
+    double settings[2] = {};
+    image.readF64("phase4b.settings", settings, 2);
+
+    image.readF64("phase4b.integrator_state", integrator_state_.data(), n);
+    image.readF64("phase4b.feedback_gain", feedback_gain_.data(), n);
+    image.readF64("phase4b.previous_input", previous_input_.data(), n);
+    image.readF64("phase4b.current_output", current_output_.data(), n);
+    image.readRecords("phase4b.node_info", node_info_);
+    system_frequency = settings[0];
+    noise_level = settings[1];
+}
+
 void AnalogCellularEngineAVX2::runMissionOptimized_Phase4C(
     const double* input_signals,
     const double* control_patterns,
@@ -722,19 +1542,275 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4C(
 ) {
     #ifdef _OPENMP
     omp_set_dynamic(0);
-    omp_set_num_threads(omp_get_max_threads());
     #endif
+    const dase::ThreadBudget::Lease threads = acquireThreads();
 
     // Suppress console banners to keep CLI stdout JSON-only
 
 
+    auto mission_start = std::chrono::high_resolution_clock::now();
+    startHardwareCounters();
+
+    const int num_nodes_int = static_cast<int>(node_info_.size());
+    const int64_t num_steps_int = static_cast<int64_t>(num_steps);
+    const MissionStateArrays state = {
+        integrator_state_.data(), previous_input_.data(),
+        current_output_.data(), feedback_gain_.data()
+    };
+    const Phase4CKernel kernel = selectPhase4CKernel(mission_kernel_isa_);
+    const int tile_nodes = static_cast<int>(mission_tile_nodes_);
+    const int64_t step_block = mission_step_block_;
+
+    // Float32 state: each thread converts its own slice in, steps the float
+    // copies and converts back, so no extra barriers
+    const bool use_f32 = state_precision_ == StatePrecision::Float32 && num_steps > 0;
+    const MissionStateArraysF32 state_f32 = {
+        integrator_f32_.data(), output_f32_.data(), feedback_f32_.data()
+    };
+    const Phase4CKernelF32 kernel_f32 = selectPhase4CKernelF32(mission_kernel_isa_);
+    float* const integrator_f32 = integrator_f32_.data();
+    float* const feedback_f32 = feedback_f32_.data();
+    const double last_input = num_steps > 0 ? input_signals[num_steps - 1] : 0.0;
+
+    // Single parallel region (Phase 4B optimization retained)
+    #pragma omp parallel
+    {
+        const int tid = omp_get_thread_num();
+        const int nthreads = omp_get_num_threads();
+
+        // Slices start on multiples of 8 nodes: with the 64-byte aligned
+        // state arrays every SIMD load is aligned and no two threads write
+        // the same cache line
+        const int nodes_per_thread = ((num_nodes_int + nthreads - 1) / nthreads + 7) & ~7;
+        const int node_start = std::min(tid * nodes_per_thread, num_nodes_int);
+        const int node_end = std::min(node_start + nodes_per_thread, num_nodes_int);
+
+        if (use_f32) {
+            for (int i = node_start; i < node_end; ++i) {
+                integrator_f32[i] = static_cast<float>(state.integrator[i]);
+                feedback_f32[i] = static_cast<float>(state.feedback[i]);
+            }
+        }
+
+        // Temporal blocking: each tile (a multiple of 8 nodes, so the
+        // 4-node grouping matches the unblocked loop) runs a block of
+        // steps while it is cache-resident
+        const int tile = (tile_nodes > 0) ? tile_nodes : std::max(node_end - node_start, 1);
+        for (int64_t block = 0; block < num_steps_int; block += step_block) {
+            const int64_t block_end = std::min(block + step_block, num_steps_int);
+
+            for (int tile_start = node_start; tile_start < node_end; tile_start += tile) {
+                const int tile_end = std::min(tile_start + tile, node_end);
+
+                for (int64_t step = block; step < block_end; ++step) {
+                    if (use_f32) {
+                        kernel_f32(state_f32, tile_start, tile_end,
+                                   input_signals[step], control_patterns[step], iterations_per_node);
+                    } else {
+                        kernel(state, tile_start, tile_end,
+                               input_signals[step], control_patterns[step], iterations_per_node);
+                    }
+                }
+            }
+        }
+
+        if (use_f32) {
+            for (int i = node_start; i < node_end; ++i) {
+                state.integrator[i] = integrator_f32[i];
+                state.output[i] = state_f32.output[i];
+                state.previous[i] = last_input;
+            }
+        }
+    } // Single barrier at end
+
+    auto mission_end = std::chrono::high_resolution_clock::now();
+    auto mission_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start);
+
+    metrics_.total_execution_time_ns = mission_duration.count();
+    metrics_.total_operations = num_steps * node_info_.size() * iterations_per_node;
+    metrics_.node_processes = metrics_.total_operations;
+    metrics_.mission_kernel = mission_kernel_isa_;
+    stopHardwareCounters(num_steps * node_info_.size());
+    metrics_.update_performance();
+
+    // Suppress console metrics to keep CLI stdout JSON-only
+}
+
+void AnalogCellularEngineAVX2::runStreamBlock(const double* input_signals, const double* control_patterns,
+                                              std::size_t num_steps, std::uint32_t iterations_per_node,
+                                              double* outputs) noexcept {
+    const int num_nodes_int = static_cast<int>(node_info_.size());
+    const MissionStateArrays state = {
+        integrator_state_.data(), previous_input_.data(),
+        current_output_.data(), feedback_gain_.data()
+    };
+    const Phase4CKernel kernel = selectPhase4CKernel(mission_kernel_isa_);
+    const double scale = num_nodes_int > 0 ? 1.0 / num_nodes_int : 0.0;
+    const double* output = current_output_.data();
+
+    for (std::size_t step = 0; step < num_steps; ++step) {
+        kernel(state, 0, num_nodes_int, input_signals[step], control_patterns[step], iterations_per_node);
+        double sum = 0.0;
+        for (int i = 0; i < num_nodes_int; ++i) {
+            sum += output[i];
+        }
+        outputs[step] = sum * scale;
+    }
+}
+
+// Ensemble of small engines: one parallel region over (engine, tile) items.
+// Each item runs the whole mission on its tile; nodes are independent, so
+// only the 4-node grouping matters for the result, and tiles start on
+// multiples of 8 exactly as the per-engine thread slices and tiles do.
+void AnalogCellularEngineAVX2::runEnsemble_Phase4C(
+    AnalogCellularEngineAVX2* const* engines,
+    std::size_t num_engines,
+    const double* const* input_signals,
+    const double* const* control_patterns,
+    std::uint64_t num_steps,
+    std::uint32_t iterations_per_node
+) {
+    if (num_engines == 0) {
+        return;
+    }
+    if (!engines || !input_signals || !control_patterns) {
+        throw std::invalid_argument("Ensemble engine and signal arrays must not be null");
+    }
+    for (std::size_t e = 0; e < num_engines; ++e) {
+        if (!engines[e] || !input_signals[e] || !control_patterns[e]) {
+            throw std::invalid_argument("Ensemble entry " + std::to_string(e) + " is null");
+        }
+    }
+    std::vector<AnalogCellularEngineAVX2*> distinct(engines, engines + num_engines);
+    std::sort(distinct.begin(), distinct.end());
+    if (std::adjacent_find(distinct.begin(), distinct.end()) != distinct.end()) {
+        throw std::invalid_argument("Ensemble lists the same engine more than once");
+    }
+
+    #ifdef _OPENMP
+    omp_set_dynamic(0);
+    #endif
+    const dase::ThreadBudget::Lease threads = engines[0]->acquireThreads();   // The first engine's limit and CPUs
+
     auto mission_start = std::chrono::high_resolution_clock::now();
 
-    const int num_nodes_int = static_cast<int>(nodes.size());
+    struct WorkItem {
+        std::size_t engine;
+        int begin;
+        int end;
+    };
+    std::vector<WorkItem> items;
+    for (std::size_t e = 0; e < num_engines; ++e) {
+        const int num_nodes_int = static_cast<int>(engines[e]->node_info_.size());
+        const int tile = static_cast<int>(engines[e]->mission_tile_nodes_ > 0
+                                          ? engines[e]->mission_tile_nodes_
+                                          : DASE_MISSION_TILE_NODES);
+        for (int begin = 0; begin < num_nodes_int; begin += tile) {
+            items.push_back({e, begin, std::min(begin + tile, num_nodes_int)});
+        }
+    }
+
+    const int64_t num_items = static_cast<int64_t>(items.size());
     const int64_t num_steps_int = static_cast<int64_t>(num_steps);
-    auto* nodes_ptr = nodes.data();
 
-    // AVX2 constants (broadcast to all 4 lanes)
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int64_t item = 0; item < num_items; ++item) {
+        const WorkItem& work = items[static_cast<std::size_t>(item)];
+        AnalogCellularEngineAVX2& engine = *engines[work.engine];
+        const MissionStateArrays state = {
+            engine.integrator_state_.data(), engine.previous_input_.data(),
+            engine.current_output_.data(), engine.feedback_gain_.data()
+        };
+        const Phase4CKernel kernel = selectPhase4CKernel(engine.mission_kernel_isa_);
+        const double* input = input_signals[work.engine];
+        const double* control = control_patterns[work.engine];
+
+        for (int64_t step = 0; step < num_steps_int; ++step) {
+            kernel(state, work.begin, work.end, input[step], control[step], iterations_per_node);
+        }
+    }
+
+    auto mission_end = std::chrono::high_resolution_clock::now();
+    auto mission_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start);
+
+    for (std::size_t e = 0; e < num_engines; ++e) {
+        EngineMetrics& metrics = engines[e]->metrics_;
+        metrics.total_execution_time_ns = mission_duration.count();
+        metrics.total_operations = num_steps * engines[e]->node_info_.size() * iterations_per_node;
+        metrics.node_processes = metrics.total_operations;
+        metrics.mission_kernel = engines[e]->mission_kernel_isa_;
+        metrics.hw_counters_valid = false;  // Counter groups are per engine, not per item
+        metrics.update_performance();
+    }
+}
+
+// ============================================================================
+// MULTI-NODE BATCH KERNEL VARIANTS
+// ============================================================================
+//
+// Each variant advances nodes [begin, end) through every sample of the
+// batch, keeping a node's state in registers across the samples.  The AVX2
+// variant takes groups of 8 nodes: state in two double vectors, and the
+// spectral boost computed vertically - one fast_sin_avx2 per frequency
+// multiplier over the group's 8 blended inputs, summed in
+// process_spectral_avx2's order - instead of one horizontally reduced
+// vector per node.  A tail of fewer than 8 takes stepNodeState.
+
+struct BatchSignals {
+    const double* input;
+    const double* control;
+    const double* aux;       // May be null
+    double* outputs;         // May be null
+    std::size_t stride;      // Nodes per sample
+    std::size_t samples;
+};
+
+using BatchKernel = void (*)(const MissionStateArrays& state, const BatchSignals& signals,
+                             int begin, int end);
+
+static void batchKernelScalar(const MissionStateArrays& state, const BatchSignals& signals,
+                              int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        double integrator = state.integrator[i];
+        double previous = state.previous[i];
+        double output = state.output[i];
+        const double feedback_gain = state.feedback[i];
+        for (std::size_t s = 0; s < signals.samples; ++s) {
+            const std::size_t at = s * signals.stride + static_cast<std::size_t>(i);
+            stepNodeState(integrator, previous, output, feedback_gain,
+                          signals.input[at], signals.control[at], signals.aux ? signals.aux[at] : 0.0);
+            if (signals.outputs) {
+                signals.outputs[at] = output;
+            }
+        }
+        state.integrator[i] = integrator;
+        state.previous[i] = previous;
+        state.output[i] = output;
+    }
+}
+
+// process_spectral_avx2 for 8 inputs at once, lane j from blended[j]
+static DASE_TARGET_AVX2 FORCE_INLINE __m256 spectralBoostVerticalAVX2(__m256 blended) {
+    const __m256 p0 = AVX2Math::fast_sin_avx2(_mm256_mul_ps(blended, _mm256_set1_ps(0.3f)));
+    const __m256 p1 = AVX2Math::fast_sin_avx2(_mm256_mul_ps(blended, _mm256_set1_ps(0.7f)));
+    const __m256 p2 = AVX2Math::fast_sin_avx2(_mm256_mul_ps(blended, _mm256_set1_ps(0.9f)));
+    const __m256 p3 = AVX2Math::fast_sin_avx2(_mm256_mul_ps(blended, _mm256_set1_ps(1.2f)));
+    const __m256 p4 = AVX2Math::fast_sin_avx2(_mm256_mul_ps(blended, _mm256_set1_ps(1.4f)));
+    const __m256 p5 = AVX2Math::fast_sin_avx2(_mm256_mul_ps(blended, _mm256_set1_ps(1.8f)));
+    const __m256 p6 = AVX2Math::fast_sin_avx2(_mm256_mul_ps(blended, _mm256_set1_ps(2.1f)));
+    const __m256 p7 = AVX2Math::fast_sin_avx2(_mm256_mul_ps(blended, _mm256_set1_ps(2.7f)));
+
+    // Halves added, then two pairwise (hadd) rounds
+    const __m256 a0 = _mm256_add_ps(p0, p4);
+    const __m256 a1 = _mm256_add_ps(p1, p5);
+    const __m256 a2 = _mm256_add_ps(p2, p6);
+    const __m256 a3 = _mm256_add_ps(p3, p7);
+    const __m256 sum = _mm256_add_ps(_mm256_add_ps(a0, a1), _mm256_add_ps(a2, a3));
+    return _mm256_mul_ps(sum, _mm256_set1_ps(0.125f));
+}
+
+static DASE_TARGET_AVX2 void batchKernelAVX2(const MissionStateArrays& state, const BatchSignals& signals,
+                                             int begin, int end) {
     const __m256d dt_vec = _mm256_set1_pd(1.0 / 48000.0);
     const __m256d gain_vec = _mm256_set1_pd(0.1);
     const __m256d decay_vec = _mm256_set1_pd(0.999999);
@@ -742,109 +1818,311 @@ void AnalogCellularEngineAVX2::runMissionOptimized_Phase4C(
     const __m256d min_accum_vec = _mm256_set1_pd(-1e6);
     const __m256d max_out_vec = _mm256_set1_pd(10.0);
     const __m256d min_out_vec = _mm256_set1_pd(-10.0);
+    const int group_end = begin + ((end - begin) / 8) * 8;
+
+    // Slices start on multiples of 8 nodes: state loads are aligned, the
+    // caller's signal rows need not be
+    for (int i = begin; i < group_end; i += 8) {
+        __m256d integrator_lo = _mm256_load_pd(state.integrator + i);
+        __m256d integrator_hi = _mm256_load_pd(state.integrator + i + 4);
+        const __m256d feedback_lo = _mm256_load_pd(state.feedback + i);
+        const __m256d feedback_hi = _mm256_load_pd(state.feedback + i + 4);
+        __m256d previous_lo = _mm256_load_pd(state.previous + i);
+        __m256d previous_hi = _mm256_load_pd(state.previous + i + 4);
+        __m256d output_lo = _mm256_load_pd(state.output + i);
+        __m256d output_hi = _mm256_load_pd(state.output + i + 4);
+
+        for (std::size_t s = 0; s < signals.samples; ++s) {
+            const std::size_t at = s * signals.stride + static_cast<std::size_t>(i);
+            previous_lo = _mm256_loadu_pd(signals.input + at);
+            previous_hi = _mm256_loadu_pd(signals.input + at + 4);
+            const __m256d amplified_lo = _mm256_mul_pd(previous_lo, _mm256_loadu_pd(signals.control + at));
+            const __m256d amplified_hi = _mm256_mul_pd(previous_hi, _mm256_loadu_pd(signals.control + at + 4));
+
+            // Integrate: integrator += amplified * 0.1 * dt, then decay and clamp
+            integrator_lo = _mm256_add_pd(integrator_lo,
+                                          _mm256_mul_pd(_mm256_mul_pd(amplified_lo, gain_vec), dt_vec));
+            integrator_hi = _mm256_add_pd(integrator_hi,
+                                          _mm256_mul_pd(_mm256_mul_pd(amplified_hi, gain_vec), dt_vec));
+            integrator_lo = _mm256_mul_pd(integrator_lo, decay_vec);
+            integrator_hi = _mm256_mul_pd(integrator_hi, decay_vec);
+            integrator_lo = _mm256_max_pd(_mm256_min_pd(integrator_lo, max_accum_vec), min_accum_vec);
+            integrator_hi = _mm256_max_pd(_mm256_min_pd(integrator_hi, max_accum_vec), min_accum_vec);
+
+            // Spectral boost of amplified + aux, 8 nodes per float vector
+            const __m256d aux_lo = signals.aux ? _mm256_loadu_pd(signals.aux + at) : _mm256_setzero_pd();
+            const __m256d aux_hi = signals.aux ? _mm256_loadu_pd(signals.aux + at + 4) : _mm256_setzero_pd();
+            const __m256 blended = _mm256_set_m128(_mm256_cvtpd_ps(_mm256_add_pd(amplified_hi, aux_hi)),
+                                                   _mm256_cvtpd_ps(_mm256_add_pd(amplified_lo, aux_lo)));
+            const __m256 spectral = spectralBoostVerticalAVX2(blended);
+
+            // Feedback, spectral boost, output clamp
+            const __m256d feedback_out_lo = _mm256_add_pd(integrator_lo, _mm256_mul_pd(integrator_lo, feedback_lo));
+            const __m256d feedback_out_hi = _mm256_add_pd(integrator_hi, _mm256_mul_pd(integrator_hi, feedback_hi));
+            output_lo = _mm256_add_pd(feedback_out_lo, _mm256_cvtps_pd(_mm256_castps256_ps128(spectral)));
+            output_hi = _mm256_add_pd(feedback_out_hi, _mm256_cvtps_pd(_mm256_extractf128_ps(spectral, 1)));
+            output_lo = _mm256_max_pd(_mm256_min_pd(output_lo, max_out_vec), min_out_vec);
+            output_hi = _mm256_max_pd(_mm256_min_pd(output_hi, max_out_vec), min_out_vec);
+
+            if (signals.outputs) {
+                _mm256_storeu_pd(signals.outputs + at, output_lo);
+                _mm256_storeu_pd(signals.outputs + at + 4, output_hi);
+            }
+        }
+
+        _mm256_store_pd(state.integrator + i, integrator_lo);
+        _mm256_store_pd(state.integrator + i + 4, integrator_hi);
+        _mm256_store_pd(state.previous + i, previous_lo);
+        _mm256_store_pd(state.previous + i + 4, previous_hi);
+        _mm256_store_pd(state.output + i, output_lo);
+        _mm256_store_pd(state.output + i + 4, output_hi);
+    }
+    batchKernelScalar(state, signals, group_end, end);
+}
+
+// AVX-512 CPUs run the AVX2 variant: the spectral boost is float work on
+// 8 lanes either way
+static BatchKernel selectBatchKernel(KernelISA isa) noexcept {
+    return isa == KernelISA::Scalar ? batchKernelScalar : batchKernelAVX2;
+}
+
+void AnalogCellularEngineAVX2::processBatch(const double* input_signals, const double* control_signals,
+                                            const double* aux_signals, std::size_t num_samples,
+                                            double* outputs) {
+    if (num_samples == 0) {
+        return;
+    }
+    if (!input_signals || !control_signals) {
+        throw std::invalid_argument("Batch input and control signals must not be null");
+    }
+
+    #ifdef _OPENMP
+    omp_set_dynamic(0);
+    #endif
+    const dase::ThreadBudget::Lease threads = acquireThreads();
+
+    auto batch_start = std::chrono::high_resolution_clock::now();
+    startHardwareCounters();
+
+    const int num_nodes_int = static_cast<int>(node_info_.size());
+    const MissionStateArrays state = {
+        integrator_state_.data(), previous_input_.data(),
+        current_output_.data(), feedback_gain_.data()
+    };
+    const BatchSignals signals = {
+        input_signals, control_signals, aux_signals, outputs, node_info_.size(), num_samples
+    };
+    const BatchKernel kernel = selectBatchKernel(mission_kernel_isa_);
 
-    // Single parallel region (Phase 4B optimization retained)
     #pragma omp parallel
     {
         const int tid = omp_get_thread_num();
         const int nthreads = omp_get_num_threads();
 
-        const int nodes_per_thread = (num_nodes_int + nthreads - 1) / nthreads;
-        const int node_start = tid * nodes_per_thread;
+        // 8-node slices as in Phase 4C: aligned groups, no shared lines
+        const int nodes_per_thread = ((num_nodes_int + nthreads - 1) / nthreads + 7) & ~7;
+        const int node_start = std::min(tid * nodes_per_thread, num_nodes_int);
         const int node_end = std::min(node_start + nodes_per_thread, num_nodes_int);
+        kernel(state, signals, node_start, node_end);
+    }
 
-        // Process each step
-        for (int64_t step = 0; step < num_steps_int; ++step) {
-            const double input = input_signals[step];
-            const double control = control_patterns[step];
-
-            // Broadcast inputs to AVX2 vectors
-            const __m256d input_vec = _mm256_set1_pd(input);
-            const __m256d control_vec = _mm256_set1_pd(control);
-
-            // Process nodes in batches of 4 using AVX2
-            int i = node_start;
-            const int node_end_avx2 = node_start + ((node_end - node_start) / 4) * 4;
-
-            // AVX2 batch loop: process 4 nodes at once
-            for (; i < node_end_avx2; i += 4) {
-                // Aligned arrays for SIMD operations
-                alignas(32) double integrator_states[4];
-                alignas(32) double feedback_gains[4];
-                alignas(32) double outputs[4] = {0.0, 0.0, 0.0, 0.0};
-
-                // Load state from 4 nodes
-                for (int j = 0; j < 4; ++j) {
-                    integrator_states[j] = nodes_ptr[i + j].integrator_state;
-                    feedback_gains[j] = nodes_ptr[i + j].feedback_gain;
-                }
+    auto batch_end = std::chrono::high_resolution_clock::now();
+    auto batch_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(batch_end - batch_start);
 
-                __m256d integrator_vec = _mm256_load_pd(integrator_states);
-                __m256d feedback_gain_vec = _mm256_load_pd(feedback_gains);
-                __m256d output_vec = _mm256_setzero_pd();
+    metrics_.total_execution_time_ns = batch_duration.count();
+    metrics_.total_operations = num_samples * node_info_.size();
+    metrics_.node_processes = metrics_.total_operations;
+    metrics_.mission_kernel = mission_kernel_isa_;
+    stopHardwareCounters(num_samples * node_info_.size());
+    metrics_.update_performance();
+}
+
+// ============================================================================
+// COUPLED PHASE 4C KERNEL VARIANTS
+// ============================================================================
+//
+// Each variant advances nodes [begin, end) by one coupled step: node i is
+// driven with aux = calculateInterNodeCoupling(i) of `prior` (the outputs
+// at the start of the step) and writes its new output to state.output, a
+// different buffer, so slices may be updated in any order.  Coupling only
+// enters through the spectral boost, so these take the exact update
+// instead of the uncoupled 0.01 * amplified approximation; amplified and
+// aux are constant over a step's iterations, so the boost is computed once
+// per step.
+
+using CoupledKernel = void (*)(const MissionStateArrays& state, const double* prior, int num_nodes,
+                               int begin, int end, double input, double control,
+                               std::uint32_t iterations);
+
+// calculateInterNodeCoupling over `prior`; a missing neighbour adds +0.0,
+// which leaves the sum unchanged
+static FORCE_INLINE double neighbourCoupling(const double* prior, int i, int num_nodes) {
+    const double left = (i > 0) ? prior[i - 1] : 0.0;
+    const double right = (i + 1 < num_nodes) ? prior[i + 1] : 0.0;
+    return (0.0 + left * 0.1) + right * 0.1;
+}
+
+static void coupledKernelScalar(const MissionStateArrays& state, const double* prior, int num_nodes,
+                                int begin, int end, double input, double control,
+                                std::uint32_t iterations) {
+    for (int i = begin; i < end; ++i) {
+        const double coupling = neighbourCoupling(prior, i, num_nodes);
+        state.output[i] = prior[i];
+        for (std::uint32_t j = 0; j < iterations; ++j) {
+            stepNodeState(state.integrator[i], state.previous[i], state.output[i],
+                          state.feedback[i], input, control, coupling);
+        }
+    }
+}
+
+static DASE_TARGET_AVX2 void coupledKernelAVX2(const MissionStateArrays& state, const double* prior,
+                                               int num_nodes, int begin, int end, double input,
+                                               double control, std::uint32_t iterations) {
+    const __m256d input_vec = _mm256_set1_pd(input);
+    const __m256d amplified_vec = _mm256_mul_pd(input_vec, _mm256_set1_pd(control));
+    const __m256d increment = _mm256_mul_pd(_mm256_mul_pd(amplified_vec, _mm256_set1_pd(0.1)),
+                                            _mm256_set1_pd(1.0 / 48000.0));
+    const __m256d coupling_vec = _mm256_set1_pd(0.1);
+    const __m256d decay_vec = _mm256_set1_pd(0.999999);
+    const __m256d max_accum_vec = _mm256_set1_pd(1e6);
+    const __m256d min_accum_vec = _mm256_set1_pd(-1e6);
+    const __m256d max_out_vec = _mm256_set1_pd(10.0);
+    const __m256d min_out_vec = _mm256_set1_pd(-10.0);
+    const int group_end = begin + ((end - begin) / 8) * 8;
+
+    // Slices start on multiples of 8 nodes, so every load below is aligned
+    for (int i = begin; i < group_end; i += 8) {
+        const __m256d centre_lo = _mm256_load_pd(prior + i);
+        const __m256d centre_hi = _mm256_load_pd(prior + i + 4);
+        const double halo_left = (i > 0) ? prior[i - 1] : 0.0;
+        const double halo_right = (i + 8 < num_nodes) ? prior[i + 8] : 0.0;
+
+        // Neighbour shift: rotate each half by one lane, carry the lane
+        // that crosses the 4-lane boundary, fill the ends from the halo
+        const __m256d up_lo = _mm256_permute4x64_pd(centre_lo, _MM_SHUFFLE(2, 1, 0, 3));
+        const __m256d up_hi = _mm256_permute4x64_pd(centre_hi, _MM_SHUFFLE(2, 1, 0, 3));
+        const __m256d down_lo = _mm256_permute4x64_pd(centre_lo, _MM_SHUFFLE(0, 3, 2, 1));
+        const __m256d down_hi = _mm256_permute4x64_pd(centre_hi, _MM_SHUFFLE(0, 3, 2, 1));
+        const __m256d left_lo = _mm256_blend_pd(up_lo, _mm256_set1_pd(halo_left), 0x1);
+        const __m256d left_hi = _mm256_blend_pd(up_hi, up_lo, 0x1);
+        const __m256d right_lo = _mm256_blend_pd(down_lo, down_hi, 0x8);
+        const __m256d right_hi = _mm256_blend_pd(down_hi, _mm256_set1_pd(halo_right), 0x8);
+
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d coupling_lo = _mm256_add_pd(_mm256_add_pd(zero, _mm256_mul_pd(left_lo, coupling_vec)),
+                                                  _mm256_mul_pd(right_lo, coupling_vec));
+        const __m256d coupling_hi = _mm256_add_pd(_mm256_add_pd(zero, _mm256_mul_pd(left_hi, coupling_vec)),
+                                                  _mm256_mul_pd(right_hi, coupling_vec));
+        const __m256 blended = _mm256_set_m128(_mm256_cvtpd_ps(_mm256_add_pd(amplified_vec, coupling_hi)),
+                                               _mm256_cvtpd_ps(_mm256_add_pd(amplified_vec, coupling_lo)));
+        const __m256 spectral = spectralBoostVerticalAVX2(blended);
+        const __m256d spectral_lo = _mm256_cvtps_pd(_mm256_castps256_ps128(spectral));
+        const __m256d spectral_hi = _mm256_cvtps_pd(_mm256_extractf128_ps(spectral, 1));
+
+        __m256d integrator_lo = _mm256_load_pd(state.integrator + i);
+        __m256d integrator_hi = _mm256_load_pd(state.integrator + i + 4);
+        const __m256d feedback_lo = _mm256_load_pd(state.feedback + i);
+        const __m256d feedback_hi = _mm256_load_pd(state.feedback + i + 4);
+        __m256d output_lo = centre_lo;
+        __m256d output_hi = centre_hi;
+
+        for (std::uint32_t iter = 0; iter < iterations; ++iter) {
+            integrator_lo = _mm256_mul_pd(_mm256_add_pd(integrator_lo, increment), decay_vec);
+            integrator_hi = _mm256_mul_pd(_mm256_add_pd(integrator_hi, increment), decay_vec);
+            integrator_lo = _mm256_max_pd(_mm256_min_pd(integrator_lo, max_accum_vec), min_accum_vec);
+            integrator_hi = _mm256_max_pd(_mm256_min_pd(integrator_hi, max_accum_vec), min_accum_vec);
+
+            const __m256d feedback_out_lo = _mm256_add_pd(integrator_lo, _mm256_mul_pd(integrator_lo, feedback_lo));
+            const __m256d feedback_out_hi = _mm256_add_pd(integrator_hi, _mm256_mul_pd(integrator_hi, feedback_hi));
+            output_lo = _mm256_max_pd(_mm256_min_pd(_mm256_add_pd(feedback_out_lo, spectral_lo), max_out_vec),
+                                      min_out_vec);
+            output_hi = _mm256_max_pd(_mm256_min_pd(_mm256_add_pd(feedback_out_hi, spectral_hi), max_out_vec),
+                                      min_out_vec);
+        }
 
-                // Process iterations_per_node times
-                for (uint32_t iter = 0; iter < iterations_per_node; ++iter) {
-                    // 1. Amplify: amplified = input * control
-                    __m256d amplified_vec = _mm256_mul_pd(input_vec, control_vec);
+        _mm256_store_pd(state.integrator + i, integrator_lo);
+        _mm256_store_pd(state.integrator + i + 4, integrator_hi);
+        _mm256_store_pd(state.output + i, output_lo);
+        _mm256_store_pd(state.output + i + 4, output_hi);
+        if (iterations > 0) {
+            _mm256_store_pd(state.previous + i, input_vec);
+            _mm256_store_pd(state.previous + i + 4, input_vec);
+        }
+    }
+    coupledKernelScalar(state, prior, num_nodes, group_end, end, input, control, iterations);
+}
 
-                    // 2. Integrate: integrator += amplified * 0.1 * dt
-                    __m256d increment = _mm256_mul_pd(amplified_vec, gain_vec);
-                    increment = _mm256_mul_pd(increment, dt_vec);
-                    integrator_vec = _mm256_add_pd(integrator_vec, increment);
+// AVX-512 CPUs run the AVX2 variant, as for processBatch
+static CoupledKernel selectCoupledKernel(KernelISA isa) noexcept {
+    return isa == KernelISA::Scalar ? coupledKernelScalar : coupledKernelAVX2;
+}
 
-                    // 3. Decay: integrator *= 0.999999
-                    integrator_vec = _mm256_mul_pd(integrator_vec, decay_vec);
+void AnalogCellularEngineAVX2::runMissionCoupled_Phase4C(
+    const double* input_signals,
+    const double* control_patterns,
+    std::uint64_t num_steps,
+    std::uint32_t iterations_per_node
+) {
+    if (num_steps == 0) {
+        return;
+    }
+    if (!input_signals || !control_patterns) {
+        throw std::invalid_argument("Coupled mission signals must not be null");
+    }
 
-                    // 4. Clamp integrator [-1e6, 1e6]
-                    integrator_vec = _mm256_min_pd(integrator_vec, max_accum_vec);
-                    integrator_vec = _mm256_max_pd(integrator_vec, min_accum_vec);
+    #ifdef _OPENMP
+    omp_set_dynamic(0);
+    #endif
+    const dase::ThreadBudget::Lease threads = acquireThreads();
 
-                    // 5. Apply feedback: output = integrator + integrator * feedback_gain
-                    __m256d feedback_comp = _mm256_mul_pd(integrator_vec, feedback_gain_vec);
-                    __m256d feedback_out = _mm256_add_pd(integrator_vec, feedback_comp);
+    // Second output buffer, placed like the state arrays
+    AlignedDoubleArray next_output;
+    NumaPlacement::allocate(next_output, node_info_.size(), numa_options_, 0.0);
 
-                    // 6. Spectral boost (simplified for vectorization)
-                    // Use a simple approximation: spectral_boost ≈ amplified * 0.01
-                    __m256d spectral_approx = _mm256_mul_pd(amplified_vec, _mm256_set1_pd(0.01));
+    auto mission_start = std::chrono::high_resolution_clock::now();
+    startHardwareCounters();
 
-                    // 7. Final output = feedback + spectral
-                    output_vec = _mm256_add_pd(feedback_out, spectral_approx);
+    const int num_nodes_int = static_cast<int>(node_info_.size());
+    const int64_t num_steps_int = static_cast<int64_t>(num_steps);
+    double* buffers[2] = {current_output_.data(), next_output.data()};
+    const CoupledKernel kernel = selectCoupledKernel(mission_kernel_isa_);
 
-                    // 8. Clamp output [-10.0, 10.0]
-                    output_vec = _mm256_min_pd(output_vec, max_out_vec);
-                    output_vec = _mm256_max_pd(output_vec, min_out_vec);
-                }
+    #pragma omp parallel
+    {
+        const int tid = omp_get_thread_num();
+        const int nthreads = omp_get_num_threads();
 
-                // Store final states back to nodes
-                _mm256_store_pd(integrator_states, integrator_vec);
-                _mm256_store_pd(outputs, output_vec);
-                for (int j = 0; j < 4; ++j) {
-                    nodes_ptr[i + j].integrator_state = integrator_states[j];
-                    nodes_ptr[i + j].current_output = outputs[j];
-                    nodes_ptr[i + j].previous_input = input;
-                }
-            }
+        // 8-node slices as in Phase 4C
+        const int nodes_per_thread = ((num_nodes_int + nthreads - 1) / nthreads + 7) & ~7;
+        const int node_start = std::min(tid * nodes_per_thread, num_nodes_int);
+        const int node_end = std::min(node_start + nodes_per_thread, num_nodes_int);
 
-            // Handle remaining nodes with scalar code
-            for (; i < node_end; ++i) {
-                auto& node = nodes_ptr[i];
-                for (uint32_t j = 0; j < iterations_per_node; ++j) {
-                    node.processSignalAVX2_hotpath(input, control, 0.0);
-                }
-            }
+        for (int64_t step = 0; step < num_steps_int; ++step) {
+            const MissionStateArrays state = {
+                integrator_state_.data(), previous_input_.data(),
+                buffers[(step + 1) & 1], feedback_gain_.data()
+            };
+            kernel(state, buffers[step & 1], num_nodes_int, node_start, node_end,
+                   input_signals[step], control_patterns[step], iterations_per_node);
+            // Neighbours read this step's outputs next step
+            #pragma omp barrier
         }
-    } // Single barrier at end
+    }
+
+    // Odd step count: the latest outputs are in the second buffer
+    if (num_steps_int & 1) {
+        current_output_.swap(next_output);
+    }
 
     auto mission_end = std::chrono::high_resolution_clock::now();
     auto mission_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(mission_end - mission_start);
 
     metrics_.total_execution_time_ns = mission_duration.count();
-    metrics_.total_operations = num_steps * nodes.size() * iterations_per_node;
+    metrics_.total_operations = num_steps * node_info_.size() * iterations_per_node;
     metrics_.node_processes = metrics_.total_operations;
+    metrics_.mission_kernel = mission_kernel_isa_;
+    stopHardwareCounters(num_steps * node_info_.size());
     metrics_.update_performance();
-
-    // Suppress console metrics to keep CLI stdout JSON-only
 }
 
 // New: The massive benchmark function to simulate a continuous heavy load
@@ -924,13 +2202,15 @@ double AnalogCellularEngineAVX2::runDragRaceBenchmark(int num_runs) {
     for (int run = 0; run < num_runs; ++run) {
         auto start_time = std::chrono::high_resolution_clock::now();
         
+        const int num_nodes_int = static_cast<int>(node_info_.size());
         #pragma omp parallel for
-        for (int i = 0; i < nodes.size(); ++i) {
+        for (int i = 0; i < num_nodes_int; ++i) {
             // This is the short-duration, high-intensity workload
             for(int j = 0; j < num_iterations; ++j) {
                 double input_signal = 1.0;
                 double control_pattern = 1.0;
-                nodes[i].processSignalAVX2(input_signal, control_pattern, 0.0);
+                stepNodeState(integrator_state_[i], previous_input_[i], current_output_[i],
+                              feedback_gain_[i], input_signal, control_pattern, 0.0);
             }
         }
         
@@ -958,7 +2238,7 @@ double AnalogCellularEngineAVX2::processSignalWaveAVX2(double input_signal, doub
     #endif
 
     #pragma omp parallel for reduction(+:total_output) schedule(dynamic, 2)
-    for (int i = 0; i < static_cast<int>(nodes.size()); i++) {
+    for (int i = 0; i < static_cast<int>(node_info_.size()); i++) {
         for (int pass = 0; pass < 10; pass++) {
             double control = control_pattern + std::sin(static_cast<double>(i + pass) * 0.1) * 0.3;
             double aux_signal = input_signal * 0.5;
@@ -971,12 +2251,13 @@ double AnalogCellularEngineAVX2::processSignalWaveAVX2(double input_signal, doub
                 aux_signal += static_cast<double>(harmonics_result[h]);
             }
 
-            double output = nodes[i].processSignalAVX2(input_signal, control, aux_signal);
+            double output = stepNodeState(integrator_state_[i], previous_input_[i], current_output_[i],
+                                          feedback_gain_[i], input_signal, control, aux_signal);
             total_output += output;
         }
     }
 
-    return total_output / (static_cast<double>(nodes.size()) * 10.0);
+    return total_output / (static_cast<double>(node_info_.size()) * 10.0);
 }
 
 double AnalogCellularEngineAVX2::performSignalSweepAVX2(double frequency) {
@@ -1046,17 +2327,23 @@ void AnalogCellularEngineAVX2::runBuiltinBenchmark(int iterations) {
 }
 
 void AnalogCellularEngineAVX2::processBlockFrequencyDomain(std::vector<double>& signal_block) {
+    using dase::FFTPlanKey;
+    using dase::FFTPlanRegistry;
     int N = static_cast<int>(signal_block.size());  // Safe cast - validated in bounds
-    fftw_complex* in = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    fftw_complex* out = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * N);
-    fftw_plan p = fftw_plan_dft_1d(N, in, out, FFTW_FORWARD, FFTW_ESTIMATE);
+    fftw_complex* in = FFTPlanRegistry::allocComplex(static_cast<size_t>(N));
+    fftw_complex* out = FFTPlanRegistry::allocComplex(static_cast<size_t>(N));
+    // Shared registry plans (created once per N), executed on this call's buffers
+    fftw_plan p = FFTPlanRegistry::acquire(FFTPlanKey::make(FFTPlanKey::Kind::C2C, {N}, FFTW_FORWARD),
+                                           FFTPlanRegistry::Planning::Auto);
+    fftw_plan p_inv = FFTPlanRegistry::acquire(FFTPlanKey::make(FFTPlanKey::Kind::C2C, {N}, FFTW_BACKWARD),
+                                               FFTPlanRegistry::Planning::Auto);
 
     for (int i = 0; i < N; ++i) {
         in[i][0] = signal_block[i];
         in[i][1] = 0;
     }
 
-    fftw_execute(p);
+    fftw_execute_dft(p, in, out);
 
     // --- MANIPULATE FREQUENCIES HERE (e.g., a simple filter) ---
     for (int i = N / 4; i < (N * 3 / 4); ++i) {
@@ -1064,21 +2351,26 @@ void AnalogCellularEngineAVX2::processBlockFrequencyDomain(std::vector<double>&
          out[i][1] = 0;
     }
 
-    fftw_plan p_inv = fftw_plan_dft_1d(N, out, in, FFTW_BACKWARD, FFTW_ESTIMATE);
-    fftw_execute(p_inv);
+    fftw_execute_dft(p_inv, out, in);
 
     for (int i = 0; i < N; ++i) {
         signal_block[i] = in[i][0] / N;
     }
 
-    fftw_destroy_plan(p);
-    fftw_destroy_plan(p_inv);
-    fftw_free(in);
-    fftw_free(out);
+    FFTPlanRegistry::release(in);
+    FFTPlanRegistry::release(out);
 }
 
 EngineMetrics AnalogCellularEngineAVX2::getMetrics() const noexcept {
-    return metrics_;
+    EngineMetrics metrics = metrics_;
+    metrics.stream_blocks = stream_latency_.blocks();
+    metrics.stream_overruns = stream_latency_.overruns();
+    metrics.stream_latency_max_ns = stream_latency_.maxNs();
+    metrics.stream_latency_mean_ns = stream_latency_.meanNs();
+    for (int k = 0; k < EngineMetrics::kStreamLatencyBuckets; ++k) {
+        metrics.stream_latency_histogram[k] = stream_latency_.bucket(k);
+    }
+    return metrics;
 }
 
 void AnalogCellularEngineAVX2::printLiveMetrics() {
@@ -1087,6 +2379,18 @@ void AnalogCellularEngineAVX2::printLiveMetrics() {
 
 void AnalogCellularEngineAVX2::resetMetrics() {
     metrics_.reset();
+    stream_latency_.reset();
+}
+
+void AnalogCellularEngineAVX2::resetState() {
+    std::fill(integrator_state_.begin(), integrator_state_.end(), 0.0);
+    std::fill(feedback_gain_.begin(), feedback_gain_.end(), 0.0);
+    std::fill(previous_input_.begin(), previous_input_.end(), 0.0);
+    std::fill(current_output_.begin(), current_output_.end(), 0.0);
+    system_frequency = 1.0;
+    noise_level = 0.001;
+    metrics_.reset();
+    metrics_.mission_kernel = mission_kernel_isa_;
 }
 
 double AnalogCellularEngineAVX2::generateNoiseSignal() {
@@ -1097,78 +2401,16 @@ double AnalogCellularEngineAVX2::generateNoiseSignal() {
 }
 
 double AnalogCellularEngineAVX2::calculateInterNodeCoupling(size_t node_index) {
-    if (node_index >= nodes.size()) return 0.0;
+    if (node_index >= node_info_.size()) return 0.0;
     
     // Simple nearest-neighbor coupling
     double coupling = 0.0;
     if (node_index > 0) {
-        coupling += nodes[node_index - 1].getOutput() * 0.1;
+        coupling += current_output_[node_index - 1] * 0.1;
     }
-    if (node_index < nodes.size() - 1) {
-        coupling += nodes[node_index + 1].getOutput() * 0.1;
+    if (node_index < node_info_.size() - 1) {
+        coupling += current_output_[node_index + 1] * 0.1;
     }
     
     return coupling;
 }
-
-// CPU Feature Detection Implementation
-bool CPUFeatures::hasAVX2() noexcept {
-    #ifdef _WIN32
-    int cpui[4];
-    __cpuid(cpui, 7);
-    return (cpui[1] & (1 << 5)) != 0; // EBX bit 5 = AVX2
-    #else
-    unsigned int eax, ebx, ecx, edx;
-    __asm__ __volatile__(
-        "cpuid"
-        : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
-        : "a"(7), "c"(0)
-    );
-    return (ebx & (1 << 5)) != 0;
-    #endif
-}
-
-bool CPUFeatures::hasFMA() noexcept {
-    #ifdef _WIN32
-    int cpui[4];
-    __cpuid(cpui, 1);
-    return (cpui[2] & (1 << 12)) != 0; // ECX bit 12 = FMA
-    #else
-    unsigned int eax, ebx, ecx, edx;
-    __asm__ __volatile__(
-        "cpuid"
-        : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
-        : "a"(1), "c"(0)
-    );
-    return (ecx & (1 << 12)) != 0;
-    #endif
-}
-
-bool CPUFeatures::checkCPUID(int function, int subfunction, int reg, int bit) {
-    #ifdef _WIN32
-    int cpui[4];
-    __cpuidex(cpui, function, subfunction);
-    return (cpui[reg] & (1 << bit)) != 0;
-    #else
-    unsigned int eax, ebx, ecx, edx;
-    __asm__ __volatile__(
-        "cpuid"
-        : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
-        : "a"(function), "c"(subfunction)
-    );
-    unsigned int result = (reg == 0) ? eax : (reg == 1) ? ebx : (reg == 2) ? ecx : edx;
-    return (result & (1U << bit)) != 0;
-    #endif
-}
-
-void CPUFeatures::printCapabilities() noexcept {
-    std::cout << "CPU Features Detected:" << std::endl;
-    std::cout << "  AVX2: " << (hasAVX2() ? "✅ Supported" : "❌ Not Available") << std::endl;
-    std::cout << "  FMA:  " << (hasFMA() ? "✅ Supported" : "❌ Not Available") << std::endl;
-
-    if (hasAVX2()) {
-        std::cout << "🚀 AVX2 acceleration will provide 2-3x speedup!" << std::endl;
-    } else {
-        std::cout << "⚠️  Falling back to scalar operations" << std::endl;
-    }
-}
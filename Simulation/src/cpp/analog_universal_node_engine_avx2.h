@@ -3,93 +3,24 @@
 #include <vector>
 #include <string>
 #include <memory>
-
-// ============================================================================
-// ALIGNED ALLOCATOR (64-byte cache-line alignment for AVX2 optimization)
-// ============================================================================
-template<typename T, std::size_t Alignment = 64>
-class aligned_allocator {
-public:
-    using value_type = T;
-    using size_type = std::size_t;
-    using difference_type = std::ptrdiff_t;
-    using pointer = T*;
-    using const_pointer = const T*;
-    using reference = T&;
-    using const_reference = const T&;
-
-    template<typename U>
-    struct rebind {
-        using other = aligned_allocator<U, Alignment>;
-    };
-
-    aligned_allocator() noexcept = default;
-
-    template<typename U>
-    aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
-
-    pointer allocate(size_type n) {
-        if (n == 0) return nullptr;
-
-        size_type alignment = Alignment;
-        size_type size = n * sizeof(T);
-
-        void* ptr = nullptr;
-
-#ifdef _WIN32
-        ptr = _aligned_malloc(size, alignment);
-#else
-        if (posix_memalign(&ptr, alignment, size) != 0) {
-            ptr = nullptr;
-        }
-#endif
-
-        if (!ptr) {
-            throw std::bad_alloc();
-        }
-
-        return static_cast<pointer>(ptr);
-    }
-
-    void deallocate(pointer p, size_type) noexcept {
-        if (p) {
-#ifdef _WIN32
-            _aligned_free(p);
-#else
-            free(p);
-#endif
-        }
-    }
-
-    template<typename U, typename... Args>
-    void construct(U* p, Args&&... args) {
-        new(p) U(std::forward<Args>(args)...);
-    }
-
-    template<typename U>
-    void destroy(U* p) {
-        p->~U();
-    }
-};
-
-template<typename T1, std::size_t A1, typename T2, std::size_t A2>
-bool operator==(const aligned_allocator<T1, A1>&, const aligned_allocator<T2, A2>&) noexcept {
-    return A1 == A2;
-}
-
-template<typename T1, std::size_t A1, typename T2, std::size_t A2>
-bool operator!=(const aligned_allocator<T1, A1>&, const aligned_allocator<T2, A2>&) noexcept {
-    return A1 != A2;
+#include "aligned_allocator.h"
+#include "cpu_features.h"
+#include "energy_meter.h"
+#include "hardware_counters.h"
+#include "numa_placement.h"
+#include "stream_latency_histogram.h"
+#include "thread_budget.h"
+
+namespace dase {
+class CheckpointWriter;
+class CheckpointImage;
 }
 
-// ============================================================================
-// CPU FEATURES
-// ============================================================================
-struct CPUFeatures {
-    static bool hasAVX2() noexcept;
-    static bool hasFMA() noexcept;
-    static bool checkCPUID(int function, int subfunction, int reg, int bit);
-    static void printCapabilities() noexcept;
+// Precision of the Phase 4C mission state (values are stable: they are
+// passed through the C API)
+enum class StatePrecision : int {
+    Float64 = 0,
+    Float32 = 1
 };
 
 // ============================================================================
@@ -111,6 +42,42 @@ struct EngineMetrics {
     double avg_time_ns             = 0.0;
     double throughput_gflops       = 0.0;
 
+    // Kernel variant that ran the last mission (before any mission: the
+    // engine's selected Phase 4C variant).  Not cleared by reset().
+    KernelISA mission_kernel       = KernelISA::Scalar;
+
+    // Hardware counters of the last mission, summed over the OpenMP team
+    // (AnalogCellularEngineAVX2::enableHardwareCounters).  hw_counters_valid
+    // is false when they were not collected.  Bandwidth is an estimate:
+    // one 64-byte line per LLC miss over the mission's wall time.
+    bool     hw_counters_valid     = false;
+    uint64_t hw_cycles             = 0;
+    uint64_t hw_instructions       = 0;
+    uint64_t hw_llc_misses         = 0;
+    double   hw_ipc                = 0.0;
+    double   hw_dram_bandwidth_gbps = 0.0;
+
+    // Package energy of the last mission (RAPL / EMI, see energy_meter.h;
+    // AnalogCellularEngineAVX2::enableEnergyMeter).  Package-wide, so it
+    // includes anything else running.  energy_valid is false when not
+    // measured.
+    bool     energy_valid          = false;
+    double   energy_joules         = 0.0;
+    double   energy_average_watts  = 0.0;
+    double   energy_joules_per_node_update = 0.0;   // Per node per step
+
+    // Streaming sessions (dase_stream_session.h) since the last session
+    // start or resetMetrics(): blocks processed, input samples refused on a
+    // full ring, and each block's latency from its last input sample being
+    // pushed to its outputs being readable, bucketed as in
+    // dase::StreamLatencyHistogram.  Not cleared by reset().
+    static constexpr int kStreamLatencyBuckets = dase::StreamLatencyHistogram::kBuckets;
+    uint64_t stream_blocks         = 0;
+    uint64_t stream_overruns       = 0;
+    uint64_t stream_latency_max_ns = 0;
+    double   stream_latency_mean_ns = 0.0;
+    uint64_t stream_latency_histogram[kStreamLatencyBuckets] = {};
+
     // legacy method declarations
     void reset() noexcept;
     void update_performance() noexcept;
@@ -163,11 +130,20 @@ public:
     void oscillate_inplace(float* output, int num_samples, double frequency_hz, double sample_rate);
     void processBlockFrequencyDomain_inplace(float* data, int num_samples);
 
+    // Batched filter: num_blocks contiguous blocks of block_size samples,
+    // each filtered like processBlockFrequencyDomain, with one FFT plan call
+    void processBlocksFrequencyDomain_inplace(float* data, int block_size, int num_blocks);
+
     // Batch processing: reduces Python call overhead by 5-10x
     std::vector<double> processBatch(const std::vector<double>& input_signals,
                                       const std::vector<double>& control_signals,
                                       const std::vector<double>& aux_signals);
 
+    // Same over caller-owned arrays of num_samples entries (NumPy buffers),
+    // writing each sample's output to results[i]
+    void processBatch(const double* input_signals, const double* control_signals,
+                      const double* aux_signals, size_t num_samples, double* results);
+
     void setFeedback(double feedback_coefficient);
     double getOutput() const noexcept;
     double getIntegratorState() const noexcept;
@@ -185,19 +161,109 @@ public:
 // ============================================================================
 class AnalogCellularEngineAVX2 {
 private:
-    // Use 64-byte aligned allocator for cache-line optimization
-    std::vector<AnalogUniversalNodeAVX2, aligned_allocator<AnalogUniversalNodeAVX2, 64>> nodes;
+    // Node state as structure-of-arrays (64-byte aligned for cache lines
+    // and AVX2 loads): element i of each array belongs to node i, with the
+    // same meaning as the AnalogUniversalNodeAVX2 member of that name
+    using AlignedDoubleArray = std::vector<double, aligned_allocator<double, 64>>;
+    AlignedDoubleArray integrator_state_;
+    AlignedDoubleArray feedback_gain_;
+    AlignedDoubleArray previous_input_;
+    AlignedDoubleArray current_output_;
+
+    // Per-node identity and grid position (not touched by the kernels)
+    struct NodeInfo {
+        int     node_id;
+        int16_t x, y, z;
+    };
+    std::vector<NodeInfo> node_info_;
+
     double system_frequency;
     double noise_level;
 
+    // Placement of the state arrays and OpenMP threads (fixed at construction)
+    NumaOptions numa_options_;
+    std::size_t state_page_bytes_;   // Smallest page size backing a state array
+
+    // Phase 4C kernel variant, chosen from CPUFeatures at construction
+    KernelISA mission_kernel_isa_;
+
+    // Phase 4B/4C temporal blocking (tile 0 = whole thread slice per step)
+    std::size_t mission_tile_nodes_;
+    std::uint32_t mission_step_block_;
+
+    // Workers a mission leases from dase::ThreadBudget (0 = the current
+    // team width) and the CPUs its team is pinned to (empty = unpinned)
+    int thread_limit_;
+    std::vector<int> thread_cpus_;
+    dase::ThreadBudget::Lease acquireThreads() const;
+
+    // Float32 mission state: float copies of the integrator, feedback and
+    // output arrays that runMissionOptimized_Phase4C steps instead of the
+    // doubles (empty while Float64)
+    StatePrecision state_precision_;
+    using AlignedFloatArray = std::vector<float, aligned_allocator<float, 64>>;
+    AlignedFloatArray integrator_f32_;
+    AlignedFloatArray feedback_f32_;
+    AlignedFloatArray output_f32_;
+
+    // Per-mission cycle / instruction / LLC-miss counts and package energy
+    // (null when disabled)
+    std::unique_ptr<HardwareCounters> hw_counters_;
+    std::unique_ptr<EnergyMeter> energy_meter_;
+    void startHardwareCounters() noexcept;
+    // After total_execution_time_ns is set; node_updates = nodes x steps
+    void stopHardwareCounters(std::uint64_t node_updates) noexcept;
+
     // FIX C2.1: Per-instance metrics instead of global static
     // This prevents data races when multiple engines run concurrently
     EngineMetrics metrics_;
 
+    // Block latencies of streaming sessions, recorded by their processing
+    // thread while other threads read metrics
+    dase::StreamLatencyHistogram stream_latency_;
+
 public:
     explicit AnalogCellularEngineAVX2(std::size_t num_nodes);
 
+    // With NUMA placement: threads are pinned first (if requested), then the
+    // state arrays are first-touched in the kernels' static-schedule order
+    // or interleaved across nodes
+    AnalogCellularEngineAVX2(std::size_t num_nodes, const NumaOptions& numa);
+
+    const NumaOptions& getNumaOptions() const noexcept { return numa_options_; }
+
+    // Page size backing the state arrays (numa.huge_pages, see NumaPlacement::allocate)
+    std::size_t getStatePageSize() const noexcept { return state_page_bytes_; }
+
+    // Lightweight handle onto one node's entries in the state arrays
+    class NodeView {
+    public:
+        double getOutput() const noexcept;
+        double getIntegratorState() const noexcept;
+        double getFeedback() const noexcept;
+        void setFeedback(double feedback_coefficient);  // Clamped like AnalogUniversalNodeAVX2
+        void resetIntegrator() noexcept;
+        int getNodeId() const noexcept;
+
+    private:
+        friend class AnalogCellularEngineAVX2;
+        NodeView(AnalogCellularEngineAVX2* engine, std::size_t index) : engine_(engine), index_(index) {}
+
+        AnalogCellularEngineAVX2* engine_;
+        std::size_t index_;
+    };
+
+    NodeView getNode(std::size_t index);
+    std::size_t getNodeCount() const noexcept { return node_info_.size(); }
+
+    // The state arrays themselves (getNodeCount() doubles each, 64-byte
+    // aligned) for zero-copy views; the storage lives as long as the engine
+    enum class StateArray { IntegratorState, FeedbackGain, PreviousInput, CurrentOutput };
+    double* getStateArray(StateArray array) noexcept;
+
     // Mission and benchmark functions
+    // Drives the nodes with sin/cos(step * 0.01), generated in
+    // double-buffered blocks ahead of the node sweep
     void runMission(std::uint64_t steps);
 
     // Optimized mission with pre-computed signals (for Julia/Rust FFI)
@@ -213,12 +279,137 @@ public:
                                      std::uint64_t num_steps,
                                      std::uint32_t iterations_per_node = 30);
 
-    // Phase 4C: AVX2 spatial vectorization (process 4 nodes in parallel)
+    // Phase 4C: SIMD spatial vectorization (4 nodes per AVX2 vector, 8 per
+    // AVX-512 vector), using the variant from getMissionKernelISA()
     void runMissionOptimized_Phase4C(const double* input_signals,
                                      const double* control_patterns,
                                      std::uint64_t num_steps,
                                      std::uint32_t iterations_per_node = 30);
 
+    // Coupled Phase 4C: at each step node i is driven with aux =
+    // calculateInterNodeCoupling(i) of the outputs at the start of the step
+    // (double-buffered, so slice order does not matter), then takes
+    // iterations_per_node exact per-node updates with the step's signals.
+    // SIMD variants shift neighbours into 8-node groups with lane permutes
+    // plus a one-node halo and compute the spectral boost once per step
+    // (getMissionKernelISA() selects; Scalar runs stepNodeState).  Steps
+    // are separated by a barrier, so temporal blocking does not apply.
+    // @throws std::invalid_argument on null signals
+    void runMissionCoupled_Phase4C(const double* input_signals,
+                                   const double* control_patterns,
+                                   std::uint64_t num_steps,
+                                   std::uint32_t iterations_per_node = 30);
+
+    // Ensemble: run the Phase 4C missions of many independent engines as
+    // one parallel job over (engine, node tile) work items instead of one
+    // fork/join per engine.  engines[e] is driven by input_signals[e] and
+    // control_patterns[e] (num_steps each; entries may alias).  Each engine
+    // keeps its own kernel variant and tile size, so results are
+    // bit-identical to running the engines one by one; every engine's
+    // metrics report the ensemble's wall time.
+    // @throws std::invalid_argument on null or repeated engines / signals
+    static void runEnsemble_Phase4C(AnalogCellularEngineAVX2* const* engines,
+                                    std::size_t num_engines,
+                                    const double* const* input_signals,
+                                    const double* const* control_patterns,
+                                    std::uint64_t num_steps,
+                                    std::uint32_t iterations_per_node = 30);
+
+    // Multi-node batch: advance node i through num_samples samples of its
+    // own drive, input_signals[s * getNodeCount() + i] at sample s (control
+    // and aux alike), with the per-sample update of
+    // AnalogUniversalNodeAVX2::processBatch.  SIMD variants map lanes to
+    // nodes and compute the spectral boost vertically across a group of 8
+    // nodes; getMissionKernelISA() selects the variant (Scalar runs the
+    // per-node update) and results match it up to FMA contraction.
+    // aux_signals may be null (no aux drive); outputs, if not null,
+    // receives every node's output per sample in the same layout.  One
+    // sample for many nodes is num_samples = 1.
+    // @throws std::invalid_argument on null input or control signals
+    void processBatch(const double* input_signals, const double* control_signals,
+                      const double* aux_signals, std::size_t num_samples,
+                      double* outputs = nullptr);
+
+    // Streaming block (dase::StreamSession): num_steps Phase 4C steps on
+    // the calling thread alone, outputs[s] = mean node output after step s.
+    // No OpenMP team, thread lease, counters or allocation, so a pinned
+    // real-time thread can call it; metrics are left to the session.
+    void runStreamBlock(const double* input_signals, const double* control_patterns,
+                        std::size_t num_steps, std::uint32_t iterations_per_node,
+                        double* outputs) noexcept;
+    dase::StreamLatencyHistogram& streamLatency() noexcept { return stream_latency_; }
+    const dase::StreamLatencyHistogram& streamLatency() const noexcept { return stream_latency_; }
+
+    KernelISA getMissionKernelISA() const noexcept { return mission_kernel_isa_; }
+
+    // Float32: runMissionOptimized_Phase4C converts each thread's slice of
+    // the integrator and feedback arrays to float at the start of a
+    // mission, steps it with the float kernel (8 nodes per AVX2 vector, 16
+    // per AVX-512 vector; same 4-node grouping and exact tail) and writes
+    // integrator, output and previous input back at the end.  Per node and
+    // step that moves 16 bytes of state instead of 40.  Views, checkpoints,
+    // digests and every other mission path keep using the double arrays,
+    // whose integrators are then rounded to float by each Phase 4C mission.
+    // Outputs track the double kernel to ~1e-6 over a standard mission
+    // (tests/test_phase4c_float32.cpp).
+    void setStatePrecision(StatePrecision precision);
+    StatePrecision getStatePrecision() const noexcept { return state_precision_; }
+
+    // Override the Phase 4C variant (benchmarks, cross-checks)
+    // @throws std::invalid_argument if this CPU cannot run it
+    void setMissionKernelISA(KernelISA isa);
+
+    // Phase 4B/4C temporal blocking: each thread advances tiles of
+    // tile_nodes nodes (rounded up to a multiple of 8) through step_block
+    // consecutive steps before moving to the next tile.  Results are
+    // bit-identical to the unblocked loop; tile_nodes = 0 disables it.
+    // @throws std::invalid_argument if tile_nodes > 0 and step_block == 0
+    void setMissionBlocking(std::size_t tile_nodes, std::uint32_t step_block);
+    std::size_t getMissionTileNodes() const noexcept { return mission_tile_nodes_; }
+    std::uint32_t getMissionStepBlock() const noexcept { return mission_step_block_; }
+
+    // Missions lease at most `threads` workers from the process thread
+    // budget (thread_budget.h; 0 = as many as the caller's team width) and
+    // pin their team to `cpus` (empty = no pinning).  Results do not depend
+    // on the team width.
+    // @throws std::invalid_argument if threads or a CPU id is negative
+    void setThreadLimit(int threads, const std::vector<int>& cpus = {});
+    int getThreadLimit() const noexcept { return thread_limit_; }
+    const std::vector<int>& getThreadCpus() const noexcept { return thread_cpus_; }
+
+    // Checkpoint sections (engine_checkpoint.h): the four state arrays as
+    // phase4b.integrator_state / feedback_gain / previous_input /
+    // current_output, node identities as phase4b.node_info and
+    // phase4b.settings f64 [system_frequency, noise_level].  The arrays
+    // must outlive writer.write().  Metrics, placement and blocking stay
+    // those of the restoring engine.
+    // @throws std::runtime_error on a node-count mismatch or malformed image
+    void saveCheckpoint(dase::CheckpointWriter& writer) const;
+    void restoreCheckpoint(const dase::CheckpointImage& image);
+
+    // state_digest.h digest of the four state arrays (as fields
+    // integrator_state, feedback_gain, previous_input, current_output),
+    // values quantized to `tolerance` when it is positive
+    uint64_t stateDigest(double tolerance) const;
+
+    // Zero the state arrays, restore the default settings and reset the
+    // metrics: a freshly constructed engine on the same allocation
+    // (placement and blocking are kept)
+    void resetState();
+
+    // Count cycles, instructions and LLC misses around every mission
+    // (Linux perf_event, one group per OpenMP thread); results land in
+    // EngineMetrics::hw_*.  Enable after changing the OpenMP team size.
+    // @return whether counters are now collected (false if unavailable)
+    bool enableHardwareCounters(bool enable);
+    bool hardwareCountersEnabled() const noexcept { return hw_counters_ != nullptr; }
+
+    // Measure package energy around every mission (Linux powercap RAPL,
+    // Windows EMI); results land in EngineMetrics::energy_*.
+    // @return whether energy is now measured (false if unavailable)
+    bool enableEnergyMeter(bool enable);
+    bool energyMeterEnabled() const noexcept { return energy_meter_ != nullptr; }
+
     void runMassiveBenchmark(int iterations);
     double runDragRaceBenchmark(int num_runs);
     void runBuiltinBenchmark(int iterations);
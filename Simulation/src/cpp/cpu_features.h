@@ -0,0 +1,114 @@
+#pragma once
+
+// ============================================================================
+// CPU FEATURES
+// ============================================================================
+//
+// Runtime x86 feature detection shared by the DASE analog engine and the
+// header-only IGSOA kernels (which select AVX2/FMA paths at runtime).
+// bestKernelISA() picks the DASE mission kernel variant for this host.
+
+#include <iostream>
+
+#if defined(_WIN32) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// Instruction-set variants of the DASE mission kernel (values are stable:
+// they are reported through the C API)
+enum class KernelISA : int {
+    Scalar = 0,
+    AVX2   = 1,   // AVX2 + FMA
+    AVX512 = 2    // AVX-512F
+};
+
+struct CPUFeatures {
+    static bool hasAVX2() noexcept {
+        return checkCPUID(7, 0, 1, 5);  // EBX bit 5 = AVX2
+    }
+
+    static bool hasFMA() noexcept {
+        return checkCPUID(1, 0, 2, 12);  // ECX bit 12 = FMA
+    }
+
+    // AVX-512F, and the OS saves the opmask/ZMM register state
+    static bool hasAVX512F() noexcept {
+        return checkCPUID(7, 0, 1, 16) && osSavesAVX512State();  // EBX bit 16 = AVX512F
+    }
+
+    // Best mission kernel this CPU can run
+    static KernelISA bestKernelISA() noexcept {
+        if (hasAVX512F()) return KernelISA::AVX512;
+        if (hasAVX2() && hasFMA()) return KernelISA::AVX2;
+        return KernelISA::Scalar;
+    }
+
+    static bool supportsKernelISA(KernelISA isa) noexcept {
+        switch (isa) {
+            case KernelISA::Scalar: return true;
+            case KernelISA::AVX2:   return hasAVX2() && hasFMA();
+            case KernelISA::AVX512: return hasAVX512F();
+        }
+        return false;
+    }
+
+    static const char* kernelISAName(KernelISA isa) noexcept {
+        switch (isa) {
+            case KernelISA::Scalar: return "scalar";
+            case KernelISA::AVX2:   return "avx2";
+            case KernelISA::AVX512: return "avx512";
+        }
+        return "unknown";
+    }
+
+    static bool checkCPUID(int function, int subfunction, int reg, int bit) noexcept {
+        #if defined(_WIN32) && (defined(_M_X64) || defined(_M_IX86))
+        int cpui[4];
+        __cpuidex(cpui, function, subfunction);
+        return (static_cast<unsigned int>(cpui[reg]) & (1U << bit)) != 0;
+        #elif defined(__x86_64__) || defined(__i386__)
+        unsigned int eax, ebx, ecx, edx;
+        __asm__ __volatile__(
+            "cpuid"
+            : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+            : "a"(function), "c"(subfunction)
+        );
+        unsigned int result = (reg == 0) ? eax : (reg == 1) ? ebx : (reg == 2) ? ecx : edx;
+        return (result & (1U << bit)) != 0;
+        #else
+        (void)function; (void)subfunction; (void)reg; (void)bit;
+        return false;
+        #endif
+    }
+
+    // XCR0 bits 1-2 (SSE/AVX) and 5-7 (opmask, ZMM0-15 upper, ZMM16-31)
+    static bool osSavesAVX512State() noexcept {
+        if (!checkCPUID(1, 0, 2, 27)) {  // ECX bit 27 = OSXSAVE
+            return false;
+        }
+        #if defined(_WIN32) && (defined(_M_X64) || defined(_M_IX86))
+        const unsigned long long xcr0 = _xgetbv(0);
+        #elif defined(__x86_64__) || defined(__i386__)
+        unsigned int lo, hi;
+        __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        const unsigned long long xcr0 = (static_cast<unsigned long long>(hi) << 32) | lo;
+        #else
+        const unsigned long long xcr0 = 0;
+        #endif
+        return (xcr0 & 0xE6) == 0xE6;
+    }
+
+    static void printCapabilities() noexcept {
+        std::cout << "CPU Features Detected:" << std::endl;
+        std::cout << "  AVX2: " << (hasAVX2() ? "✅ Supported" : "❌ Not Available") << std::endl;
+        std::cout << "  FMA:  " << (hasFMA() ? "✅ Supported" : "❌ Not Available") << std::endl;
+        std::cout << "  AVX-512F: " << (hasAVX512F() ? "✅ Supported" : "❌ Not Available") << std::endl;
+        std::cout << "  Mission kernel: " << kernelISAName(bestKernelISA()) << std::endl;
+
+        if (hasAVX2()) {
+            std::cout << "🚀 AVX2 acceleration will provide 2-3x speedup!" << std::endl;
+        } else {
+            std::cout << "⚠️  Falling back to scalar operations" << std::endl;
+        }
+    }
+};
@@ -7,7 +7,15 @@
 
 #include "dase_capi.h"
 #include "analog_universal_node_engine_avx2.h"
+#include "dase_oscillator_bank.h"
+#include "dase_stream_filter.h"
+#include "dase_stream_session.h"
+#include "engine_checkpoint.h"
+#include <cmath>
+#include <cstddef>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 // =============================================================================
 // HELPER: Cast between opaque handle and C++ pointer
@@ -21,6 +29,18 @@ static inline DaseEngineHandle to_c_handle(AnalogCellularEngineAVX2* engine) {
     return reinterpret_cast<DaseEngineHandle>(engine);
 }
 
+static inline dase::StreamFilter* to_cpp_filter(DaseStreamFilterHandle handle) {
+    return reinterpret_cast<dase::StreamFilter*>(handle);
+}
+
+static inline dase::OscillatorBank* to_cpp_bank(DaseOscillatorBankHandle handle) {
+    return reinterpret_cast<dase::OscillatorBank*>(handle);
+}
+
+static inline dase::StreamSession* to_cpp_session(DaseStreamSessionHandle handle) {
+    return reinterpret_cast<dase::StreamSession*>(handle);
+}
+
 // =============================================================================
 // EXTERN "C" IMPLEMENTATIONS
 // =============================================================================
@@ -43,6 +63,8 @@ const char* dase_status_string(DaseStatus status) {
             return "Required pointer argument is null";
         case DASE_ERROR_INVALID_PARAM:
             return "Invalid parameter";
+        case DASE_ERROR_UNSUPPORTED:
+            return "Not supported on this platform";
         case DASE_ERROR_UNKNOWN:
         default:
             return "Unknown error";
@@ -81,6 +103,27 @@ DaseStatus dase_create_engine_ex(
     DaseEngineHandle* out_handle,
     char* error_msg_buffer,
     uint32_t error_msg_size
+) {
+    return dase_create_engine_with_options(num_nodes, nullptr, out_handle,
+                                           error_msg_buffer, error_msg_size);
+}
+
+void dase_engine_options_init(DaseEngineOptions* options) {
+    if (!options) return;
+    options->struct_size = sizeof(DaseEngineOptions);
+    options->numa_first_touch = 0;
+    options->numa_interleave = 0;
+    options->thread_affinity = DASE_AFFINITY_NONE;
+    options->huge_pages = DASE_HUGE_PAGES_NONE;
+    options->state_precision = DASE_STATE_PRECISION_FLOAT64;
+}
+
+DaseStatus dase_create_engine_with_options(
+    uint32_t num_nodes,
+    const DaseEngineOptions* options,
+    DaseEngineHandle* out_handle,
+    char* error_msg_buffer,
+    uint32_t error_msg_size
 ) {
     // Validate output handle pointer
     if (!out_handle) {
@@ -112,10 +155,55 @@ DaseStatus dase_create_engine_ex(
         return DASE_ERROR_INVALID_PARAM;
     }
 
+    // Validate options (every version-1 field must fit in struct_size;
+    // later fields are read only if they fit too)
+    NumaOptions numa;
+    StatePrecision precision = StatePrecision::Float64;
+    if (options) {
+        constexpr size_t kOptionsV1Size = offsetof(DaseEngineOptions, huge_pages);
+        if (options->struct_size < kOptionsV1Size) {
+            copy_error_message(error_msg_buffer, error_msg_size,
+                               "options->struct_size is smaller than DaseEngineOptions version 1");
+            *out_handle = nullptr;
+            return DASE_ERROR_INVALID_PARAM;
+        }
+        if (options->thread_affinity < DASE_AFFINITY_NONE ||
+            options->thread_affinity > DASE_AFFINITY_SPREAD) {
+            copy_error_message(error_msg_buffer, error_msg_size,
+                               "thread_affinity must be a DaseThreadAffinity value");
+            *out_handle = nullptr;
+            return DASE_ERROR_INVALID_PARAM;
+        }
+        numa.first_touch = options->numa_first_touch != 0;
+        numa.interleave = options->numa_interleave != 0;
+        numa.thread_affinity = static_cast<ThreadAffinity>(options->thread_affinity);
+        if (options->struct_size >= offsetof(DaseEngineOptions, huge_pages) + sizeof(options->huge_pages)) {
+            if (options->huge_pages < DASE_HUGE_PAGES_NONE ||
+                options->huge_pages > DASE_HUGE_PAGES_TRANSPARENT) {
+                copy_error_message(error_msg_buffer, error_msg_size,
+                                   "huge_pages must be a DaseHugePages value");
+                *out_handle = nullptr;
+                return DASE_ERROR_INVALID_PARAM;
+            }
+            numa.huge_pages = static_cast<HugePages>(options->huge_pages);
+        }
+        if (options->struct_size >= offsetof(DaseEngineOptions, state_precision) + sizeof(options->state_precision)) {
+            if (options->state_precision < DASE_STATE_PRECISION_FLOAT64 ||
+                options->state_precision > DASE_STATE_PRECISION_FLOAT32) {
+                copy_error_message(error_msg_buffer, error_msg_size,
+                                   "state_precision must be a DaseStatePrecision value");
+                *out_handle = nullptr;
+                return DASE_ERROR_INVALID_PARAM;
+            }
+            precision = static_cast<StatePrecision>(options->state_precision);
+        }
+    }
+
     // Try to create engine
     try {
-        auto* engine = new AnalogCellularEngineAVX2(static_cast<std::size_t>(num_nodes));
-        *out_handle = to_c_handle(engine);
+        auto engine = std::make_unique<AnalogCellularEngineAVX2>(static_cast<std::size_t>(num_nodes), numa);
+        engine->setStatePrecision(precision);
+        *out_handle = to_c_handle(engine.release());
         return DASE_SUCCESS;
     } catch (const std::bad_alloc&) {
         if (error_msg_buffer && error_msg_size > 0) {
@@ -199,6 +287,223 @@ void dase_run_mission_optimized_phase4c(
                                         num_steps, iterations_per_node);
 }
 
+void dase_run_mission_coupled_phase4c(
+    DaseEngineHandle handle,
+    const double* input_signals,
+    const double* control_patterns,
+    uint64_t num_steps,
+    uint32_t iterations_per_node
+) {
+    if (!handle || !input_signals || !control_patterns || num_steps == 0) {
+        return; // Invalid parameters
+    }
+
+    auto* engine = to_cpp_engine(handle);
+    engine->runMissionCoupled_Phase4C(input_signals, control_patterns,
+                                      num_steps, iterations_per_node);
+}
+
+DaseStatus dase_run_ensemble(
+    const DaseEngineHandle* engines,
+    uint32_t num_engines,
+    const double* const* input_signals,
+    const double* const* control_patterns,
+    uint64_t num_steps,
+    uint32_t iterations_per_node
+) {
+    if (!engines || !input_signals || !control_patterns) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    if (num_engines == 0 || num_steps == 0) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+
+    std::vector<AnalogCellularEngineAVX2*> cpp_engines(num_engines);
+    for (uint32_t e = 0; e < num_engines; ++e) {
+        if (!engines[e]) {
+            return DASE_ERROR_NULL_HANDLE;
+        }
+        if (!input_signals[e] || !control_patterns[e]) {
+            return DASE_ERROR_NULL_POINTER;
+        }
+        cpp_engines[e] = to_cpp_engine(engines[e]);
+    }
+
+    try {
+        AnalogCellularEngineAVX2::runEnsemble_Phase4C(cpp_engines.data(), num_engines,
+                                                      input_signals, control_patterns,
+                                                      num_steps, iterations_per_node);
+        return DASE_SUCCESS;
+    } catch (const std::invalid_argument&) {
+        return DASE_ERROR_INVALID_PARAM;
+    } catch (const std::bad_alloc&) {
+        return DASE_ERROR_OUT_OF_MEMORY;
+    }
+}
+
+DaseStatus dase_set_mission_blocking(
+    DaseEngineHandle handle,
+    uint32_t tile_nodes,
+    uint32_t step_block
+) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+
+    try {
+        to_cpp_engine(handle)->setMissionBlocking(tile_nodes, step_block);
+        return DASE_SUCCESS;
+    } catch (const std::invalid_argument&) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+}
+
+DaseStatus dase_set_thread_limit(
+    DaseEngineHandle handle,
+    int32_t threads,
+    const int32_t* cpus,
+    uint32_t num_cpus
+) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (num_cpus > 0 && !cpus) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+
+    try {
+        std::vector<int> cpu_list(cpus, cpus + num_cpus);
+        to_cpp_engine(handle)->setThreadLimit(threads, cpu_list);
+        return DASE_SUCCESS;
+    } catch (const std::invalid_argument&) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+}
+
+DaseStatus dase_set_thread_budget(int32_t threads) {
+    if (threads < 0) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+    dase::ThreadBudget::process().setCapacity(threads);
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_get_thread_budget(int32_t* capacity, int32_t* in_use) {
+    const dase::ThreadBudgetStats stats = dase::ThreadBudget::process().stats();
+    if (capacity) {
+        *capacity = stats.capacity;
+    }
+    if (in_use) {
+        *in_use = stats.in_use;
+    }
+    return DASE_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Checkpoint / Restore
+// -----------------------------------------------------------------------------
+
+DaseStatus dase_checkpoint_engine(
+    DaseEngineHandle handle,
+    const char* path,
+    const char* metadata,
+    char* error_msg_buffer,
+    uint32_t error_msg_size
+) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (!path) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+
+    try {
+        dase::CheckpointWriter writer;
+        to_cpp_engine(handle)->saveCheckpoint(writer);
+        if (metadata) {
+            writer.addText("config", metadata);
+        }
+        writer.write(path);
+        return DASE_SUCCESS;
+    } catch (const std::exception& e) {
+        if (error_msg_buffer && error_msg_size > 0) {
+            copy_error_message(error_msg_buffer, error_msg_size, e.what());
+        }
+        return DASE_ERROR_UNKNOWN;
+    }
+}
+
+DaseStatus dase_restore_engine(
+    DaseEngineHandle handle,
+    const char* path,
+    char* error_msg_buffer,
+    uint32_t error_msg_size
+) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (!path) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+
+    try {
+        const dase::CheckpointImage image(path);
+        to_cpp_engine(handle)->restoreCheckpoint(image);
+        return DASE_SUCCESS;
+    } catch (const std::exception& e) {
+        if (error_msg_buffer && error_msg_size > 0) {
+            copy_error_message(error_msg_buffer, error_msg_size, e.what());
+        }
+        return DASE_ERROR_INVALID_PARAM;
+    }
+}
+
+DaseStatus dase_copy_engine_state(
+    DaseEngineHandle handle,
+    DaseEngineHandle source,
+    char* error_msg_buffer,
+    uint32_t error_msg_size
+) {
+    if (!handle || !source) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+
+    try {
+        dase::CheckpointWriter writer;
+        to_cpp_engine(source)->saveCheckpoint(writer);
+        const auto buffer = writer.writeMemory();
+        to_cpp_engine(handle)->restoreCheckpoint(dase::CheckpointImage(*buffer));
+        return DASE_SUCCESS;
+    } catch (const std::exception& e) {
+        if (error_msg_buffer && error_msg_size > 0) {
+            copy_error_message(error_msg_buffer, error_msg_size, e.what());
+        }
+        return DASE_ERROR_INVALID_PARAM;
+    }
+}
+
+DaseStatus dase_get_state_digest(DaseEngineHandle handle, double tolerance, uint64_t* out_digest) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (!out_digest) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    if (!(tolerance >= 0.0) || !std::isfinite(tolerance)) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+    *out_digest = to_cpp_engine(handle)->stateDigest(tolerance);
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_reset_engine(DaseEngineHandle handle) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    to_cpp_engine(handle)->resetState();
+    return DASE_SUCCESS;
+}
+
 // -----------------------------------------------------------------------------
 // Metrics Retrieval
 // -----------------------------------------------------------------------------
@@ -231,6 +536,408 @@ void dase_get_metrics(
     }
 }
 
+DaseStatus dase_enable_hardware_counters(DaseEngineHandle handle, int32_t enable) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+
+    const bool collecting = to_cpp_engine(handle)->enableHardwareCounters(enable != 0);
+    return (enable != 0 && !collecting) ? DASE_ERROR_UNSUPPORTED : DASE_SUCCESS;
+}
+
+DaseStatus dase_get_hardware_counters(DaseEngineHandle handle, DaseHardwareCounters* out_counters) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (!out_counters) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    if (out_counters->struct_size < sizeof(DaseHardwareCounters)) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+
+    const EngineMetrics metrics = to_cpp_engine(handle)->getMetrics();
+    out_counters->valid = metrics.hw_counters_valid ? 1 : 0;
+    out_counters->cycles = metrics.hw_cycles;
+    out_counters->instructions = metrics.hw_instructions;
+    out_counters->llc_misses = metrics.hw_llc_misses;
+    out_counters->ipc = metrics.hw_ipc;
+    out_counters->dram_bandwidth_gbps = metrics.hw_dram_bandwidth_gbps;
+    return DASE_SUCCESS;
+}
+
+DaseKernelISA dase_get_kernel_isa(DaseEngineHandle handle) {
+    if (!handle) {
+        return DASE_KERNEL_SCALAR;
+    }
+
+    auto* engine = to_cpp_engine(handle);
+    return static_cast<DaseKernelISA>(engine->getMetrics().mission_kernel);
+}
+
+uint64_t dase_get_state_page_size(DaseEngineHandle handle) {
+    if (!handle) {
+        return 0;
+    }
+    return static_cast<uint64_t>(to_cpp_engine(handle)->getStatePageSize());
+}
+
+const char* dase_kernel_isa_string(DaseKernelISA isa) {
+    return CPUFeatures::kernelISAName(static_cast<KernelISA>(isa));
+}
+
+// -----------------------------------------------------------------------------
+// Field Views
+// -----------------------------------------------------------------------------
+
+DaseStatus dase_get_field_view(DaseEngineHandle handle, DaseField field, DaseFieldView* view) {
+    if (!handle) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (!view) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    if (field < DASE_FIELD_INTEGRATOR_STATE || field > DASE_FIELD_CURRENT_OUTPUT) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+    AnalogCellularEngineAVX2* engine = to_cpp_engine(handle);
+    const size_t dims[1] = {engine->getNodeCount()};
+    const auto array = static_cast<AnalogCellularEngineAVX2::StateArray>(field);
+    const bool writable = field == DASE_FIELD_INTEGRATOR_STATE || field == DASE_FIELD_PREVIOUS_INPUT;
+    if (!dase::fillFieldView(view, engine->getStateArray(array), DASE_ELEMENT_FLOAT64, sizeof(double),
+                             sizeof(double), dims, 1, writable)) {
+        return DASE_ERROR_UNSUPPORTED;
+    }
+    return DASE_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Streaming FIR Filter
+// -----------------------------------------------------------------------------
+
+// Helper: construct a filter into *out_handle, mapping exceptions to status
+static DaseStatus create_stream_filter(const std::vector<double>& taps, uint32_t block_size,
+                                       uint32_t channels, DaseStreamFilterHandle* out_handle) {
+    try {
+        auto* filter = new dase::StreamFilter(taps, static_cast<int>(block_size), static_cast<int>(channels));
+        *out_handle = reinterpret_cast<DaseStreamFilterHandle>(filter);
+        return DASE_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return DASE_ERROR_OUT_OF_MEMORY;
+    } catch (const std::invalid_argument&) {
+        return DASE_ERROR_INVALID_PARAM;
+    } catch (...) {
+        return DASE_ERROR_UNKNOWN;
+    }
+}
+
+DaseStatus dase_stream_filter_create(
+    const double* taps,
+    uint32_t num_taps,
+    uint32_t block_size,
+    uint32_t channels,
+    DaseStreamFilterHandle* out_handle
+) {
+    if (!out_handle || (!taps && num_taps > 0)) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    if (block_size > static_cast<uint32_t>(INT32_MAX) || channels > static_cast<uint32_t>(INT32_MAX)) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+    return create_stream_filter(std::vector<double>(taps, taps + num_taps), block_size, channels, out_handle);
+}
+
+DaseStatus dase_stream_filter_create_from_response(
+    const double* gains,
+    uint32_t num_gains,
+    uint32_t num_taps,
+    uint32_t block_size,
+    uint32_t channels,
+    DaseStreamFilterHandle* out_handle
+) {
+    if (!out_handle || (!gains && num_gains > 0)) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    if (num_taps > static_cast<uint32_t>(INT32_MAX) || block_size > static_cast<uint32_t>(INT32_MAX) ||
+        channels > static_cast<uint32_t>(INT32_MAX)) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+    std::vector<double> taps;
+    try {
+        taps = dase::StreamFilter::designFromResponse(std::vector<double>(gains, gains + num_gains),
+                                                      static_cast<int>(num_taps));
+    } catch (const std::invalid_argument&) {
+        return DASE_ERROR_INVALID_PARAM;
+    } catch (const std::bad_alloc&) {
+        return DASE_ERROR_OUT_OF_MEMORY;
+    }
+    return create_stream_filter(taps, block_size, channels, out_handle);
+}
+
+DaseStatus dase_stream_filter_process(
+    DaseStreamFilterHandle filter,
+    const float* input,
+    float* output,
+    uint64_t num_samples
+) {
+    if (!filter) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (num_samples > 0 && (!input || !output)) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    try {
+        to_cpp_filter(filter)->process(input, output, static_cast<size_t>(num_samples));
+        return DASE_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return DASE_ERROR_OUT_OF_MEMORY;
+    } catch (...) {
+        return DASE_ERROR_UNKNOWN;
+    }
+}
+
+DaseStatus dase_stream_filter_reset(DaseStreamFilterHandle filter) {
+    if (!filter) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    to_cpp_filter(filter)->reset();
+    return DASE_SUCCESS;
+}
+
+void dase_stream_filter_destroy(DaseStreamFilterHandle filter) {
+    delete to_cpp_filter(filter);
+}
+
+// -----------------------------------------------------------------------------
+// Oscillator Bank
+// -----------------------------------------------------------------------------
+
+DaseStatus dase_oscillator_bank_create(
+    const double* frequencies_hz,
+    const double* phases,
+    const double* amplitudes,
+    uint32_t count,
+    double sample_rate,
+    DaseOscillatorBankHandle* out_handle
+) {
+    if (!out_handle || (!frequencies_hz && count > 0)) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    try {
+        auto* bank = new dase::OscillatorBank(
+            std::vector<double>(frequencies_hz, frequencies_hz + count), sample_rate,
+            phases ? std::vector<double>(phases, phases + count) : std::vector<double>(),
+            amplitudes ? std::vector<double>(amplitudes, amplitudes + count) : std::vector<double>());
+        *out_handle = reinterpret_cast<DaseOscillatorBankHandle>(bank);
+        return DASE_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return DASE_ERROR_OUT_OF_MEMORY;
+    } catch (const std::invalid_argument&) {
+        return DASE_ERROR_INVALID_PARAM;
+    } catch (...) {
+        return DASE_ERROR_UNKNOWN;
+    }
+}
+
+DaseStatus dase_oscillator_bank_render_sum(
+    DaseOscillatorBankHandle bank,
+    float* output,
+    uint64_t num_samples,
+    int accumulate
+) {
+    if (!bank) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (num_samples > 0 && !output) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    to_cpp_bank(bank)->renderSum(output, static_cast<size_t>(num_samples), accumulate != 0);
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_oscillator_bank_render_channels(
+    DaseOscillatorBankHandle bank,
+    float* output,
+    uint64_t num_samples
+) {
+    if (!bank) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (num_samples > 0 && to_cpp_bank(bank)->size() > 0 && !output) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    to_cpp_bank(bank)->renderChannels(output, static_cast<size_t>(num_samples));
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_oscillator_bank_set(
+    DaseOscillatorBankHandle bank,
+    uint32_t index,
+    double frequency_hz,
+    double amplitude
+) {
+    if (!bank) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    dase::OscillatorBank* cpp_bank = to_cpp_bank(bank);
+    if (index >= cpp_bank->size() || !std::isfinite(frequency_hz) || !std::isfinite(amplitude)) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+    cpp_bank->setFrequency(index, frequency_hz);
+    cpp_bank->setAmplitude(index, amplitude);
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_oscillator_bank_get_phases(
+    DaseOscillatorBankHandle bank,
+    double* phases
+) {
+    if (!bank) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    const dase::OscillatorBank* cpp_bank = to_cpp_bank(bank);
+    if (!phases && cpp_bank->size() > 0) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    for (size_t i = 0; i < cpp_bank->size(); ++i) {
+        phases[i] = cpp_bank->phase(i);
+    }
+    return DASE_SUCCESS;
+}
+
+void dase_oscillator_bank_destroy(DaseOscillatorBankHandle bank) {
+    delete to_cpp_bank(bank);
+}
+
+// -----------------------------------------------------------------------------
+// Streaming Session
+// -----------------------------------------------------------------------------
+
+static_assert(sizeof(DaseStreamStats::latency_histogram) / sizeof(uint64_t) ==
+                  static_cast<size_t>(dase::StreamLatencyHistogram::kBuckets),
+              "DaseStreamStats histogram must match StreamLatencyHistogram");
+
+void dase_stream_options_init(DaseStreamOptions* options) {
+    if (!options) return;
+    const dase::StreamSessionOptions defaults;
+    options->struct_size = sizeof(DaseStreamOptions);
+    options->block_size = static_cast<uint32_t>(defaults.block_size);
+    options->ring_blocks = static_cast<uint32_t>(defaults.ring_blocks);
+    options->iterations_per_node = defaults.iterations_per_node;
+    options->cpu = defaults.cpu;
+    options->lock_memory = defaults.lock_memory ? 1 : 0;
+}
+
+DaseStatus dase_stream_session_create(
+    DaseEngineHandle engine,
+    const DaseStreamOptions* options,
+    DaseStreamSessionHandle* out_handle
+) {
+    if (!engine) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (!out_handle) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    dase::StreamSessionOptions session_options;
+    if (options) {
+        if (options->struct_size < sizeof(DaseStreamOptions)) {
+            return DASE_ERROR_INVALID_PARAM;
+        }
+        session_options.block_size = options->block_size;
+        session_options.ring_blocks = options->ring_blocks;
+        session_options.iterations_per_node = options->iterations_per_node;
+        session_options.cpu = options->cpu;
+        session_options.lock_memory = options->lock_memory != 0;
+    }
+    try {
+        auto* session = new dase::StreamSession(*to_cpp_engine(engine), session_options);
+        *out_handle = reinterpret_cast<DaseStreamSessionHandle>(session);
+        return DASE_SUCCESS;
+    } catch (const std::bad_alloc&) {
+        return DASE_ERROR_OUT_OF_MEMORY;
+    } catch (const std::invalid_argument&) {
+        return DASE_ERROR_INVALID_PARAM;
+    } catch (...) {
+        return DASE_ERROR_UNKNOWN;
+    }
+}
+
+DaseStatus dase_stream_session_push(
+    DaseStreamSessionHandle session,
+    const double* input_signals,
+    const double* control_patterns,
+    uint64_t count,
+    uint64_t* out_accepted
+) {
+    if (!session) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (count > 0 && (!input_signals || !control_patterns)) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    const size_t accepted = to_cpp_session(session)->push(input_signals, control_patterns,
+                                                          static_cast<size_t>(count));
+    if (out_accepted) {
+        *out_accepted = accepted;
+    }
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_stream_session_pop(
+    DaseStreamSessionHandle session,
+    double* outputs,
+    uint64_t max_count,
+    uint64_t* out_count
+) {
+    if (!session) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (!out_count || (max_count > 0 && !outputs)) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    *out_count = to_cpp_session(session)->pop(outputs, static_cast<size_t>(max_count));
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_stream_session_get_stats(DaseStreamSessionHandle session, DaseStreamStats* out_stats) {
+    if (!session) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    if (!out_stats) {
+        return DASE_ERROR_NULL_POINTER;
+    }
+    if (out_stats->struct_size < sizeof(DaseStreamStats)) {
+        return DASE_ERROR_INVALID_PARAM;
+    }
+
+    const dase::StreamSession* cpp_session = to_cpp_session(session);
+    const dase::StreamLatencyHistogram& latency = cpp_session->engine().streamLatency();
+    out_stats->pinned = cpp_session->pinned() ? 1 : 0;
+    out_stats->memory_locked = cpp_session->memoryLocked() ? 1 : 0;
+    out_stats->running = cpp_session->running() ? 1 : 0;
+    out_stats->blocks = latency.blocks();
+    out_stats->overruns = latency.overruns();
+    out_stats->latency_max_ns = latency.maxNs();
+    out_stats->latency_mean_ns = latency.meanNs();
+    for (int k = 0; k < dase::StreamLatencyHistogram::kBuckets; ++k) {
+        out_stats->latency_histogram[k] = latency.bucket(k);
+    }
+    return DASE_SUCCESS;
+}
+
+DaseStatus dase_stream_session_stop(DaseStreamSessionHandle session) {
+    if (!session) {
+        return DASE_ERROR_NULL_HANDLE;
+    }
+    to_cpp_session(session)->stop();
+    return DASE_SUCCESS;
+}
+
+void dase_stream_session_destroy(DaseStreamSessionHandle session) {
+    delete to_cpp_session(session);
+}
+
 // -----------------------------------------------------------------------------
 // CPU Features
 // -----------------------------------------------------------------------------
@@ -243,4 +950,8 @@ int dase_has_fma(void) {
     return CPUFeatures::hasFMA() ? 1 : 0;
 }
 
+int dase_has_avx512f(void) {
+    return CPUFeatures::hasAVX512F() ? 1 : 0;
+}
+
 } // extern "C"
@@ -23,6 +23,8 @@
     #define DASE_API
 #endif
 
+#include "dase_field_view.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,9 +47,22 @@ typedef enum {
     DASE_ERROR_NULL_HANDLE = 200,
     DASE_ERROR_NULL_POINTER = 201,
     DASE_ERROR_INVALID_PARAM = 202,
+    DASE_ERROR_UNSUPPORTED = 300,
     DASE_ERROR_UNKNOWN = 999
 } DaseStatus;
 
+/**
+ * Mission kernel instruction-set variants
+ *
+ * The Phase 4C kernel variant is chosen once per engine, when it is
+ * created, from the host CPU's features.
+ */
+typedef enum {
+    DASE_KERNEL_SCALAR = 0,
+    DASE_KERNEL_AVX2 = 1,      /* AVX2 + FMA */
+    DASE_KERNEL_AVX512 = 2     /* AVX-512F */
+} DaseKernelISA;
+
 /**
  * Get string description of status code
  *
@@ -96,6 +111,80 @@ DASE_API DaseStatus dase_create_engine_ex(
     uint32_t error_msg_size
 );
 
+/**
+ * Thread pinning for the engine's OpenMP team
+ */
+typedef enum {
+    DASE_AFFINITY_NONE = 0,     /* Leave placement to the OS / OMP_PROC_BIND */
+    DASE_AFFINITY_COMPACT = 1,  /* Thread t on the t-th allowed CPU */
+    DASE_AFFINITY_SPREAD = 2    /* Threads spaced evenly over the allowed CPUs */
+} DaseThreadAffinity;
+
+/**
+ * Page size policy of the engine state
+ */
+typedef enum {
+    DASE_HUGE_PAGES_NONE = 0,         /* Base pages */
+    DASE_HUGE_PAGES_TRANSPARENT = 1   /* Transparent huge pages where the kernel allows (Linux) */
+} DaseHugePages;
+
+/**
+ * Precision the Phase 4C mission kernel steps the state in.  The engine
+ * state stays double either way; FLOAT32 rounds integrators to float at
+ * the start of each mission and moves 16 bytes per node and step instead
+ * of 40 (outputs within ~1e-6 of FLOAT64 over a standard mission).
+ */
+typedef enum {
+    DASE_STATE_PRECISION_FLOAT64 = 0,
+    DASE_STATE_PRECISION_FLOAT32 = 1
+} DaseStatePrecision;
+
+/**
+ * Engine creation options (initialise with dase_engine_options_init).
+ *
+ * struct_size lets later versions append fields: the library reads only
+ * the fields that fit in struct_size.
+ */
+typedef struct {
+    uint32_t struct_size;       /* sizeof(DaseEngineOptions) */
+    int32_t numa_first_touch;   /* 1: first-touch state in the kernels' static schedule */
+    int32_t numa_interleave;    /* 1: interleave state pages over all NUMA nodes (Linux) */
+    int32_t thread_affinity;    /* DaseThreadAffinity */
+    int32_t huge_pages;         /* DaseHugePages (version 2) */
+    int32_t state_precision;    /* DaseStatePrecision (version 3) */
+} DaseEngineOptions;
+
+/**
+ * Fill options with the defaults used by dase_create_engine_ex (no
+ * placement, no pinning, double precision).
+ *
+ * @param options Options to initialise (ignored if NULL)
+ */
+DASE_API void dase_engine_options_init(DaseEngineOptions* options);
+
+/**
+ * Create a new DASE engine with placement options.
+ *
+ * Affinity applies to the process-wide OpenMP thread pool, including the
+ * calling thread.  Interleave falls back to first touch (if also requested)
+ * where mbind is unavailable, and huge pages to base pages where THP is
+ * disabled or unavailable (see dase_get_state_page_size).
+ *
+ * @param num_nodes Number of analog nodes to create
+ * @param options Creation options (NULL = defaults)
+ * @param out_handle Output parameter for engine handle (set only on success)
+ * @param error_msg_buffer Optional buffer for error message (can be NULL)
+ * @param error_msg_size Size of error_msg_buffer
+ * @return Status code (DASE_SUCCESS on success)
+ */
+DASE_API DaseStatus dase_create_engine_with_options(
+    uint32_t num_nodes,
+    const DaseEngineOptions* options,
+    DaseEngineHandle* out_handle,
+    char* error_msg_buffer,
+    uint32_t error_msg_size
+);
+
 /**
  * Destroy the engine and free all allocated memory.
  *
@@ -195,6 +284,212 @@ DASE_API void dase_run_mission_optimized_phase4c(
     uint32_t iterations_per_node
 );
 
+/**
+ * Run a nearest-neighbour coupled Phase 4C mission.
+ *
+ * Each step every node is driven with 0.1 * (left + right) of the outputs
+ * at the start of the step (missing neighbours at the ends count as 0),
+ * the coupling of dase's calculateInterNodeCoupling, then takes
+ * iterations_per_node exact node updates.  Outputs are double-buffered, so
+ * node slices still run in parallel and 8 nodes per group vectorise.
+ *
+ * @param engine Handle to the engine
+ * @param input_signals Array of pre-computed input signals (length: num_steps)
+ * @param control_patterns Array of pre-computed control patterns (length: num_steps)
+ * @param num_steps Number of mission steps
+ * @param iterations_per_node Number of iterations to process per node (default: 30)
+ */
+DASE_API void dase_run_mission_coupled_phase4c(
+    DaseEngineHandle engine,
+    const double* input_signals,
+    const double* control_patterns,
+    uint64_t num_steps,
+    uint32_t iterations_per_node
+);
+
+/**
+ * Run the Phase 4C missions of many engines as one parallel job.
+ *
+ * Parameter studies with thousands of small engines spend most of their
+ * time in per-mission OpenMP fork/join; this schedules (engine, node tile)
+ * work items from all engines over one thread team instead.  Each engine
+ * uses its own kernel variant and tile size, and ends in exactly the state
+ * dase_run_mission_optimized_phase4c() would leave it in.  Every engine's
+ * metrics report the ensemble's wall time.
+ *
+ * @param engines Array of num_engines distinct engine handles
+ * @param num_engines Number of engines (replicas)
+ * @param input_signals Per-engine input arrays (length: num_steps each); entries may alias
+ * @param control_patterns Per-engine control arrays (length: num_steps each); entries may alias
+ * @param num_steps Number of mission steps
+ * @param iterations_per_node Number of iterations to process per node (default: 30)
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_POINTER, DASE_ERROR_NULL_HANDLE or
+ *         DASE_ERROR_INVALID_PARAM (no engines or steps, repeated handle)
+ */
+DASE_API DaseStatus dase_run_ensemble(
+    const DaseEngineHandle* engines,
+    uint32_t num_engines,
+    const double* const* input_signals,
+    const double* const* control_patterns,
+    uint64_t num_steps,
+    uint32_t iterations_per_node
+);
+
+/**
+ * Configure temporal blocking of the Phase 4B/4C missions.
+ *
+ * Each thread advances a tile of tile_nodes nodes (rounded up to a
+ * multiple of 8) through step_block consecutive mission steps while the
+ * tile is cache-resident, then moves to the next tile.  This helps once
+ * node state exceeds L2 (e.g. 1M nodes).  Results are bit-identical to the
+ * unblocked loop.  Engines are created with 4096-node tiles and 64-step
+ * blocks; tile_nodes = 0 restores the one-step-at-a-time sweep.
+ *
+ * @param engine Handle to the engine
+ * @param tile_nodes Nodes per tile (0 disables blocking)
+ * @param step_block Steps per block (must be positive when tile_nodes > 0)
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE or DASE_ERROR_INVALID_PARAM
+ */
+DASE_API DaseStatus dase_set_mission_blocking(
+    DaseEngineHandle engine,
+    uint32_t tile_nodes,
+    uint32_t step_block
+);
+
+/**
+ * Limit the engine's missions to a number of OpenMP threads and optionally
+ * pin them to CPUs.
+ *
+ * Missions lease their threads from the library's process thread budget
+ * (see dase_set_thread_budget), so concurrent engines share the cores
+ * instead of each spawning a full-width team.  A limit of 0 requests the
+ * current team width.  With cpus, thread t of a mission's team runs on
+ * cpus[t % num_cpus] (Linux only; ignored elsewhere).
+ *
+ * @param engine Handle to the engine
+ * @param threads Most threads per mission (0 = team width)
+ * @param cpus CPU ids to pin the team to (may be NULL)
+ * @param num_cpus Length of cpus (0 = no pinning)
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER or
+ *         DASE_ERROR_INVALID_PARAM (negative threads or CPU id)
+ */
+DASE_API DaseStatus dase_set_thread_limit(
+    DaseEngineHandle engine,
+    int32_t threads,
+    const int32_t* cpus,
+    uint32_t num_cpus
+);
+
+/**
+ * Set the number of threads shared by all engines of this library.
+ *
+ * A mission is granted min(its limit, free threads, budget / missions
+ * running) threads, and at least one.  Missions already running keep their
+ * grant.
+ *
+ * @param threads Threads in the budget (0 = the processor count)
+ * @return DASE_SUCCESS or DASE_ERROR_INVALID_PARAM (negative threads)
+ */
+DASE_API DaseStatus dase_set_thread_budget(int32_t threads);
+
+/**
+ * Read the thread budget.
+ *
+ * @param capacity Receives the budget's thread count (may be NULL)
+ * @param in_use Receives the threads leased by running missions (may be NULL)
+ * @return DASE_SUCCESS
+ */
+DASE_API DaseStatus dase_get_thread_budget(int32_t* capacity, int32_t* in_use);
+
+// =============================================================================
+// CHECKPOINT / RESTORE
+// =============================================================================
+
+/**
+ * Write the engine's node state to a binary checkpoint file.
+ *
+ * The file is written beside `path` and renamed over it, so an existing
+ * checkpoint is never left half-written.  Metrics, placement and mission
+ * blocking are not saved.
+ *
+ * @param engine Handle to the engine
+ * @param path Checkpoint file path
+ * @param metadata Optional text stored as the image's "config" section (can be NULL)
+ * @param error_msg_buffer Optional buffer for error message (can be NULL)
+ * @param error_msg_size Size of error_msg_buffer
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER or
+ *         DASE_ERROR_UNKNOWN (I/O failure)
+ */
+DASE_API DaseStatus dase_checkpoint_engine(
+    DaseEngineHandle engine,
+    const char* path,
+    const char* metadata,
+    char* error_msg_buffer,
+    uint32_t error_msg_size
+);
+
+/**
+ * Load a checkpoint written by dase_checkpoint_engine into an engine with
+ * the same node count.  The file is memory-mapped and copied into the
+ * state arrays; the engine is unchanged if the image is rejected.
+ *
+ * @param engine Handle to the engine
+ * @param path Checkpoint file path
+ * @param error_msg_buffer Optional buffer for error message (can be NULL)
+ * @param error_msg_size Size of error_msg_buffer
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER or
+ *         DASE_ERROR_INVALID_PARAM (missing, corrupt or mismatched image)
+ */
+DASE_API DaseStatus dase_restore_engine(
+    DaseEngineHandle engine,
+    const char* path,
+    char* error_msg_buffer,
+    uint32_t error_msg_size
+);
+
+/**
+ * Copy the node state of `source` into `engine` (same node count) through
+ * an in-memory checkpoint image: what a restore of a fresh checkpoint of
+ * `source` would do, without the file.  Used to branch clones of an engine.
+ * Metrics, placement and mission blocking of `engine` are kept.
+ *
+ * @param engine Handle to the engine to overwrite
+ * @param source Handle to the engine to copy
+ * @param error_msg_buffer Optional buffer for error message (can be NULL)
+ * @param error_msg_size Size of error_msg_buffer
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE or DASE_ERROR_INVALID_PARAM
+ *         (node counts differ; `engine` is unchanged)
+ */
+DASE_API DaseStatus dase_copy_engine_state(
+    DaseEngineHandle engine,
+    DaseEngineHandle source,
+    char* error_msg_buffer,
+    uint32_t error_msg_size
+);
+
+/**
+ * Fingerprint the engine's node state for determinism checks: an XXH64
+ * digest (state_digest.h) of the four state arrays, cheaper than reading
+ * them out to compare two runs or a run against a golden.
+ *
+ * @param engine Handle to the engine
+ * @param tolerance Quantization step (0 = exact bits, -0 and NaNs folded)
+ * @param out_digest Output digest
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER or
+ *         DASE_ERROR_INVALID_PARAM (negative or non-finite tolerance)
+ */
+DASE_API DaseStatus dase_get_state_digest(DaseEngineHandle engine, double tolerance, uint64_t* out_digest);
+
+/**
+ * Return an engine to its freshly created state in place: node state
+ * zeroed, settings and metrics reset.  Keeps the allocation, placement and
+ * mission blocking, so a caller can reuse it instead of destroying it.
+ *
+ * @param engine Handle to the engine
+ * @return DASE_SUCCESS or DASE_ERROR_NULL_HANDLE
+ */
+DASE_API DaseStatus dase_reset_engine(DaseEngineHandle engine);
+
 // =============================================================================
 // METRICS RETRIEVAL
 // =============================================================================
@@ -207,6 +502,9 @@ DASE_API void dase_run_mission_optimized_phase4c(
  * @param out_ops_per_sec Output: Operations per second
  * @param out_speedup_factor Output: Speedup vs 15,500ns baseline
  * @param out_total_ops Output: Total operations completed
+ *
+ * The kernel variant that produced these numbers is reported by
+ * dase_get_kernel_isa().
  */
 DASE_API void dase_get_metrics(
     DaseEngineHandle engine,
@@ -216,6 +514,398 @@ DASE_API void dase_get_metrics(
     uint64_t* out_total_ops
 );
 
+/**
+ * Hardware counters of the last mission, summed over the engine's OpenMP
+ * threads.  dram_bandwidth_gbps is an estimate (64 bytes per LLC miss over
+ * the mission's wall time).
+ */
+typedef struct {
+    uint32_t struct_size;          /* Set to sizeof(DaseHardwareCounters) */
+    int32_t valid;                 /* 0 if counters were not collected */
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t llc_misses;           /* Last-level cache misses */
+    double ipc;                    /* instructions / cycles */
+    double dram_bandwidth_gbps;
+} DaseHardwareCounters;
+
+/**
+ * Collect hardware counters around every mission of this engine.
+ *
+ * Linux perf_event only (one counter group per OpenMP thread, user-space
+ * events); needs a PMU visible to the process and perf_event_paranoid <= 2.
+ * Re-enable after changing the OpenMP thread count.  Ensemble runs do not
+ * collect counters.
+ *
+ * @param engine Handle to the engine
+ * @param enable Nonzero to collect, 0 to stop
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, or DASE_ERROR_UNSUPPORTED if
+ *         the counters cannot be opened here (collection stays off)
+ */
+DASE_API DaseStatus dase_enable_hardware_counters(DaseEngineHandle engine, int32_t enable);
+
+/**
+ * Get the hardware counters of the last mission.
+ *
+ * @param engine Handle to the engine
+ * @param out_counters Output; set out_counters->struct_size first
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER or
+ *         DASE_ERROR_INVALID_PARAM (struct_size too small)
+ */
+DASE_API DaseStatus dase_get_hardware_counters(DaseEngineHandle engine,
+                                               DaseHardwareCounters* out_counters);
+
+/**
+ * Get the kernel variant that ran the last mission.
+ *
+ * Phase 4C missions report the engine's selected variant; Phase 4A/4B
+ * missions run the scalar per-node kernel and report DASE_KERNEL_SCALAR.
+ * Before any mission this is the selected Phase 4C variant.
+ *
+ * @param engine Handle to the engine
+ * @return Kernel variant (DASE_KERNEL_SCALAR for a null handle)
+ */
+DASE_API DaseKernelISA dase_get_kernel_isa(DaseEngineHandle engine);
+
+/**
+ * Get the page size backing the engine's state arrays: the huge page size
+ * if DaseEngineOptions.huge_pages took effect, the base page size otherwise.
+ *
+ * @param engine Handle to the engine
+ * @return Bytes per page (0 for a null handle)
+ */
+DASE_API uint64_t dase_get_state_page_size(DaseEngineHandle engine);
+
+/**
+ * Get the name of a kernel variant ("scalar", "avx2", "avx512").
+ *
+ * @param isa Kernel variant
+ * @return Null-terminated static string
+ */
+DASE_API const char* dase_kernel_isa_string(DaseKernelISA isa);
+
+// =============================================================================
+// FIELD VIEWS
+// =============================================================================
+
+/**
+ * Node state arrays of a DASE engine (the structure-of-arrays layout of
+ * AnalogCellularEngineAVX2; num_nodes doubles each)
+ */
+typedef enum {
+    DASE_FIELD_INTEGRATOR_STATE = 0,   /* Writable */
+    DASE_FIELD_FEEDBACK_GAIN = 1,      /* Read-only (set through the engine, which clamps it) */
+    DASE_FIELD_PREVIOUS_INPUT = 2,     /* Writable */
+    DASE_FIELD_CURRENT_OUTPUT = 3      /* Read-only */
+} DaseField;
+
+/**
+ * Describe one state array in place (dase_field_view.h): a contiguous
+ * float64 array of num_nodes elements, 64-byte aligned.  The pointer stays
+ * valid until the engine is destroyed; the values change with each mission.
+ *
+ * @param engine Handle to the engine
+ * @param field Array to view
+ * @param view In: version = DASE_FIELD_VIEW_VERSION; out: the view
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER,
+ *         DASE_ERROR_INVALID_PARAM (unknown field) or DASE_ERROR_UNSUPPORTED
+ *         (unknown view version)
+ */
+DASE_API DaseStatus dase_get_field_view(DaseEngineHandle engine, DaseField field, DaseFieldView* view);
+
+// =============================================================================
+// STREAMING FIR FILTER
+// =============================================================================
+
+/**
+ * Opaque pointer to a C++ dase::StreamFilter: overlap-add FFT convolution
+ * of continuous multi-channel streams with an FIR, keeping each channel's
+ * history between calls (dase_stream_filter.h).
+ */
+typedef struct DaseStreamFilter_C* DaseStreamFilterHandle;
+
+/**
+ * Create a streaming filter from FIR taps.
+ *
+ * @param taps Impulse response (length: num_taps)
+ * @param num_taps Number of taps (> 0)
+ * @param block_size Samples per FFT segment (0 = chosen from num_taps)
+ * @param channels Independent streams filtered with the same taps (> 0)
+ * @param out_handle Output parameter for the filter (set only on success)
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_POINTER, DASE_ERROR_INVALID_PARAM
+ *         (no or non-finite taps, no channels) or DASE_ERROR_OUT_OF_MEMORY
+ */
+DASE_API DaseStatus dase_stream_filter_create(
+    const double* taps,
+    uint32_t num_taps,
+    uint32_t block_size,
+    uint32_t channels,
+    DaseStreamFilterHandle* out_handle
+);
+
+/**
+ * Create a linear-phase streaming filter of num_taps (odd) taps from a
+ * magnitude response sampled at num_gains evenly spaced frequencies from 0
+ * to Nyquist inclusive.  Output is delayed by (num_taps - 1) / 2 samples.
+ *
+ * @return As dase_stream_filter_create; DASE_ERROR_INVALID_PARAM also for
+ *         fewer than two gains or an even num_taps
+ */
+DASE_API DaseStatus dase_stream_filter_create_from_response(
+    const double* gains,
+    uint32_t num_gains,
+    uint32_t num_taps,
+    uint32_t block_size,
+    uint32_t channels,
+    DaseStreamFilterHandle* out_handle
+);
+
+/**
+ * Filter the next num_samples samples of every channel.  Arrays are
+ * channels x num_samples, channel-major; output may equal input.
+ *
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER or
+ *         DASE_ERROR_OUT_OF_MEMORY
+ */
+DASE_API DaseStatus dase_stream_filter_process(
+    DaseStreamFilterHandle filter,
+    const float* input,
+    float* output,
+    uint64_t num_samples
+);
+
+/**
+ * Forget the filter's stream history, as if no sample had been seen.
+ *
+ * @return DASE_SUCCESS or DASE_ERROR_NULL_HANDLE
+ */
+DASE_API DaseStatus dase_stream_filter_reset(DaseStreamFilterHandle filter);
+
+/**
+ * Destroy a streaming filter.
+ *
+ * @param filter Handle from dase_stream_filter_create* (NULL is ignored)
+ */
+DASE_API void dase_stream_filter_destroy(DaseStreamFilterHandle filter);
+
+// =============================================================================
+// OSCILLATOR BANK
+// =============================================================================
+
+/**
+ * Opaque pointer to a C++ dase::OscillatorBank: many sine oscillators
+ * rendered per call, phase carried between calls (dase_oscillator_bank.h).
+ */
+typedef struct DaseOscillatorBank_C* DaseOscillatorBankHandle;
+
+/**
+ * Create an oscillator bank.
+ *
+ * @param frequencies_hz Frequency of each oscillator (length: count)
+ * @param phases Initial phases in radians (NULL = all 0)
+ * @param amplitudes Amplitudes (NULL = all 1)
+ * @param count Number of oscillators
+ * @param sample_rate Samples per second (> 0)
+ * @param out_handle Output parameter for the bank (set only on success)
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_POINTER, DASE_ERROR_INVALID_PARAM
+ *         (non-positive sample rate, non-finite value) or
+ *         DASE_ERROR_OUT_OF_MEMORY
+ */
+DASE_API DaseStatus dase_oscillator_bank_create(
+    const double* frequencies_hz,
+    const double* phases,
+    const double* amplitudes,
+    uint32_t count,
+    double sample_rate,
+    DaseOscillatorBankHandle* out_handle
+);
+
+/**
+ * Render the sum of all oscillators over the next num_samples samples
+ * into output (accumulate != 0: added to its contents).
+ *
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE or DASE_ERROR_NULL_POINTER
+ */
+DASE_API DaseStatus dase_oscillator_bank_render_sum(
+    DaseOscillatorBankHandle bank,
+    float* output,
+    uint64_t num_samples,
+    int accumulate
+);
+
+/**
+ * Render each oscillator over the next num_samples samples into its own
+ * row of output (count x num_samples, oscillator-major).
+ *
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE or DASE_ERROR_NULL_POINTER
+ */
+DASE_API DaseStatus dase_oscillator_bank_render_channels(
+    DaseOscillatorBankHandle bank,
+    float* output,
+    uint64_t num_samples
+);
+
+/**
+ * Change one oscillator, from the next sample rendered.
+ *
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE or DASE_ERROR_INVALID_PARAM
+ *         (index out of range, non-finite value)
+ */
+DASE_API DaseStatus dase_oscillator_bank_set(
+    DaseOscillatorBankHandle bank,
+    uint32_t index,
+    double frequency_hz,
+    double amplitude
+);
+
+/**
+ * Copy the phase of each oscillator's next sample (radians, [0, 2 pi))
+ * into phases (length: the bank's count).
+ *
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE or DASE_ERROR_NULL_POINTER
+ */
+DASE_API DaseStatus dase_oscillator_bank_get_phases(
+    DaseOscillatorBankHandle bank,
+    double* phases
+);
+
+/**
+ * Destroy an oscillator bank.
+ *
+ * @param bank Handle from dase_oscillator_bank_create (NULL is ignored)
+ */
+DASE_API void dase_oscillator_bank_destroy(DaseOscillatorBankHandle bank);
+
+// =============================================================================
+// STREAMING SESSION
+// =============================================================================
+
+/**
+ * Opaque pointer to a C++ dase::StreamSession: the engine run block by
+ * block on a dedicated thread fed through lock-free rings
+ * (dase_stream_session.h).
+ */
+typedef struct DaseStreamSession_C* DaseStreamSessionHandle;
+
+/**
+ * Streaming session options (initialise with dase_stream_options_init).
+ * struct_size works as in DaseEngineOptions.
+ */
+typedef struct {
+    uint32_t struct_size;          /* sizeof(DaseStreamOptions) */
+    uint32_t block_size;           /* Samples (mission steps) per block, > 0 */
+    uint32_t ring_blocks;          /* Capacity of each ring in blocks, >= 2 */
+    uint32_t iterations_per_node;
+    int32_t cpu;                   /* CPU to pin the processing thread to (-1 = unpinned) */
+    int32_t lock_memory;           /* 1: lock rings and engine state into RAM (best effort) */
+} DaseStreamOptions;
+
+/**
+ * Fill options with the defaults (64-sample blocks, 8 blocks per ring,
+ * 30 iterations per node, unpinned, memory locked).
+ *
+ * @param options Options to initialise (ignored if NULL)
+ */
+DASE_API void dase_stream_options_init(DaseStreamOptions* options);
+
+/**
+ * Start a streaming session on an engine.
+ *
+ * The session owns the engine until it is destroyed: run no missions,
+ * checkpoints or other sessions on it meanwhile.  The engine's stream
+ * latency histogram is reset.
+ *
+ * @param engine Engine to run (must outlive the session)
+ * @param options Session options (NULL = defaults)
+ * @param out_handle Output parameter for the session (set only on success)
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER,
+ *         DASE_ERROR_INVALID_PARAM (bad option or struct_size) or
+ *         DASE_ERROR_OUT_OF_MEMORY
+ */
+DASE_API DaseStatus dase_stream_session_create(
+    DaseEngineHandle engine,
+    const DaseStreamOptions* options,
+    DaseStreamSessionHandle* out_handle
+);
+
+/**
+ * Queue input samples (one producer thread; never blocks).  Samples that
+ * do not fit in the input ring are dropped and counted as overruns.
+ *
+ * @param input_signals Input per sample (length: count)
+ * @param control_patterns Control per sample (length: count)
+ * @param out_accepted Samples queued (may be NULL)
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE or DASE_ERROR_NULL_POINTER
+ */
+DASE_API DaseStatus dase_stream_session_push(
+    DaseStreamSessionHandle session,
+    const double* input_signals,
+    const double* control_patterns,
+    uint64_t count,
+    uint64_t* out_accepted
+);
+
+/**
+ * Take processed outputs, one per input sample and in order (one consumer
+ * thread; never blocks).  Outputs appear a whole block at a time.
+ *
+ * @param outputs Output buffer (length: max_count)
+ * @param out_count Outputs written (required)
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE or DASE_ERROR_NULL_POINTER
+ */
+DASE_API DaseStatus dase_stream_session_pop(
+    DaseStreamSessionHandle session,
+    double* outputs,
+    uint64_t max_count,
+    uint64_t* out_count
+);
+
+/**
+ * Session state and block latencies since the session started.  Latency is
+ * measured from the push completing a block to its outputs being poppable;
+ * histogram bucket k counts latencies in [2^k, 2^(k+1)) ns.
+ */
+typedef struct {
+    uint32_t struct_size;          /* Set to sizeof(DaseStreamStats) */
+    int32_t pinned;                /* 1 if the processing thread is pinned */
+    int32_t memory_locked;         /* 1 if all session memory is locked */
+    int32_t running;               /* 0 once the session has been stopped */
+    uint64_t blocks;               /* Blocks processed */
+    uint64_t overruns;             /* Input samples dropped */
+    uint64_t latency_max_ns;
+    double latency_mean_ns;
+    uint64_t latency_histogram[40];
+} DaseStreamStats;
+
+/**
+ * Get the session's statistics (also in the engine's metrics).
+ *
+ * @param out_stats Output; set out_stats->struct_size first
+ * @return DASE_SUCCESS, DASE_ERROR_NULL_HANDLE, DASE_ERROR_NULL_POINTER or
+ *         DASE_ERROR_INVALID_PARAM (struct_size too small)
+ */
+DASE_API DaseStatus dase_stream_session_get_stats(
+    DaseStreamSessionHandle session,
+    DaseStreamStats* out_stats
+);
+
+/**
+ * Process the complete blocks already pushed, then stop the processing
+ * thread and unlock memory.  Outputs can still be popped; further pushes
+ * are queued but never processed.  Idempotent.
+ *
+ * @return DASE_SUCCESS or DASE_ERROR_NULL_HANDLE
+ */
+DASE_API DaseStatus dase_stream_session_stop(DaseStreamSessionHandle session);
+
+/**
+ * Stop (as dase_stream_session_stop) and destroy a session.  The engine
+ * can be used again afterwards.
+ *
+ * @param session Handle from dase_stream_session_create (NULL is ignored)
+ */
+DASE_API void dase_stream_session_destroy(DaseStreamSessionHandle session);
+
 // =============================================================================
 // CPU FEATURES
 // =============================================================================
@@ -234,6 +924,13 @@ DASE_API int dase_has_avx2(void);
  */
 DASE_API int dase_has_fma(void);
 
+/**
+ * Check if the CPU and OS support AVX-512F.
+ *
+ * @return 1 if AVX-512F is usable, 0 otherwise
+ */
+DASE_API int dase_has_avx512f(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,90 @@
+#ifndef DASE_FIELD_VIEW_H
+#define DASE_FIELD_VIEW_H
+
+/**
+ * Zero-copy field views (shared by the DASE, IGSOA and SATP C APIs)
+ *
+ * A *_get_field_view(handle, field, &view) call describes one field of an
+ * engine's state in place: a pointer to element (0, ..., 0), the element
+ * type, and dims / byte strides slowest axis first (z, y, x for a lattice),
+ * so Julia (unsafe_wrap of a strided view), Rust (ndarray from_shape_ptr)
+ * or NumPy (as_strided) can wrap the engine's memory without copying.
+ * Fields of node structs come back with the struct size as their
+ * innermost stride; structure-of-arrays fields are contiguous.
+ *
+ * Versioning: set view.version to DASE_FIELD_VIEW_VERSION before the call
+ * (zero the rest).  The library fills the layout of that version and
+ * refuses a version it does not know, so a consumer built against an older
+ * header keeps working when fields are appended to the struct.
+ *
+ * Lifetime: the pointer is valid until the engine is next stepped (any
+ * mission / evolve call), reset, restored, reconfigured or destroyed.
+ * Values read between steps are the engine's current state.  Writes
+ * through a view with `writable` set are seen by the next step; derived
+ * fields (read-only views) are only refreshed by steps.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DASE_FIELD_VIEW_VERSION 1
+#define DASE_FIELD_VIEW_MAX_DIMS 4
+
+typedef enum {
+    DASE_ELEMENT_FLOAT64 = 0,      /* double */
+    DASE_ELEMENT_COMPLEX128 = 1    /* two doubles (re, im): C99 double complex, ComplexF64, Complex<f64> */
+} DaseElementType;
+
+typedef struct {
+    uint32_t version;                          /* In: DASE_FIELD_VIEW_VERSION */
+    uint32_t element_type;                     /* DaseElementType */
+    uint32_t element_size;                     /* Bytes per element */
+    uint32_t ndim;                             /* Used entries of dims / strides */
+    int64_t dims[DASE_FIELD_VIEW_MAX_DIMS];    /* Slowest axis first */
+    int64_t strides[DASE_FIELD_VIEW_MAX_DIMS]; /* Bytes between neighbours along each axis */
+    void* data;                                /* Element (0, ..., 0) */
+    uint32_t writable;                         /* 1: writes reach the next step */
+    uint32_t reserved;
+} DaseFieldView;
+
+#ifdef __cplusplus
+}
+
+#include <cstddef>
+
+namespace dase {
+
+// Fill a view of a lattice field: dims slowest first (z, y, x), one element
+// every elem_stride bytes along x with packed rows and planes.  false (view
+// untouched) for a null view or an unknown version.
+inline bool fillFieldView(DaseFieldView* view, void* data, DaseElementType type, size_t element_size,
+                          size_t elem_stride, const size_t* dims, uint32_t ndim, bool writable) {
+    if (!view || view->version != DASE_FIELD_VIEW_VERSION || ndim == 0 || ndim > DASE_FIELD_VIEW_MAX_DIMS) {
+        return false;
+    }
+    view->element_type = static_cast<uint32_t>(type);
+    view->element_size = static_cast<uint32_t>(element_size);
+    view->ndim = ndim;
+    int64_t stride = static_cast<int64_t>(elem_stride);
+    for (uint32_t d = DASE_FIELD_VIEW_MAX_DIMS; d-- > 0;) {
+        view->dims[d] = 0;
+        view->strides[d] = 0;
+    }
+    for (uint32_t d = ndim; d-- > 0;) {
+        view->dims[d] = static_cast<int64_t>(dims[d]);
+        view->strides[d] = stride;
+        stride *= static_cast<int64_t>(dims[d]);
+    }
+    view->data = data;
+    view->writable = writable ? 1u : 0u;
+    view->reserved = 0;
+    return true;
+}
+
+} // namespace dase
+#endif
+
+#endif // DASE_FIELD_VIEW_H
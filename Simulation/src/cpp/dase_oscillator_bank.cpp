@@ -0,0 +1,255 @@
+/**
+ * DASE Oscillator Bank - implementation (see dase_oscillator_bank.h)
+ */
+
+#include "dase_oscillator_bank.h"
+#include "cpu_features.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DASE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define DASE_TARGET_AVX2
+#endif
+
+namespace dase {
+
+namespace {
+
+constexpr size_t kLanes = OscillatorBank::kLanes;
+constexpr size_t kChunk = OscillatorBank::kAnchorInterval;
+
+// Oscillator-samples below which a call stays on one thread
+constexpr size_t kParallelWork = size_t(1) << 16;
+
+double wrapPhase(double phase) {
+    const double two_pi = 2.0 * M_PI;
+    phase = std::fmod(phase, two_pi);
+    return phase < 0.0 ? phase + two_pi : phase;
+}
+
+// One lane group's samples [0, count): lanes[n * kLanes + l] (+)= a_l s_l[n],
+// where (s, c) start at the anchor and rotate by (rs, rc) each sample
+void renderGroupScalar(const double* amplitude, const double* rs, const double* rc,
+                       double* s, double* c, size_t count, double* lanes, bool accumulate) {
+    for (size_t n = 0; n < count; ++n) {
+        double* out = lanes + n * kLanes;
+        for (size_t l = 0; l < kLanes; ++l) {
+            const double value = amplitude[l] * s[l];
+            out[l] = accumulate ? out[l] + value : value;
+            const double next_s = s[l] * rc[l] + c[l] * rs[l];
+            c[l] = c[l] * rc[l] - s[l] * rs[l];
+            s[l] = next_s;
+        }
+    }
+}
+
+DASE_TARGET_AVX2
+void renderGroupAVX2(const double* amplitude, const double* rs, const double* rc,
+                     double* s, double* c, size_t count, double* lanes, bool accumulate) {
+    const __m256d a = _mm256_loadu_pd(amplitude);
+    const __m256d vrs = _mm256_loadu_pd(rs);
+    const __m256d vrc = _mm256_loadu_pd(rc);
+    __m256d vs = _mm256_loadu_pd(s);
+    __m256d vc = _mm256_loadu_pd(c);
+    for (size_t n = 0; n < count; ++n) {
+        double* out = lanes + n * kLanes;
+        const __m256d base = accumulate ? _mm256_loadu_pd(out) : _mm256_setzero_pd();
+        _mm256_storeu_pd(out, _mm256_fmadd_pd(a, vs, base));
+        const __m256d next_s = _mm256_fmadd_pd(vs, vrc, _mm256_mul_pd(vc, vrs));
+        vc = _mm256_fmsub_pd(vc, vrc, _mm256_mul_pd(vs, vrs));
+        vs = next_s;
+    }
+    _mm256_storeu_pd(s, vs);
+    _mm256_storeu_pd(c, vc);
+}
+
+} // namespace
+
+OscillatorBank::OscillatorBank(const std::vector<double>& frequencies_hz, double sample_rate,
+                               const std::vector<double>& phases, const std::vector<double>& amplitudes)
+    : size_(frequencies_hz.size())
+    , sample_rate_(sample_rate)
+    , samples_rendered_(0) {
+    if (!std::isfinite(sample_rate_) || sample_rate_ <= 0.0) {
+        throw std::invalid_argument("OscillatorBank: sample_rate must be positive");
+    }
+    if (!phases.empty() && phases.size() != size_) {
+        throw std::invalid_argument("OscillatorBank: phases must match the frequencies in size");
+    }
+    if (!amplitudes.empty() && amplitudes.size() != size_) {
+        throw std::invalid_argument("OscillatorBank: amplitudes must match the frequencies in size");
+    }
+
+    const size_t padded = (size_ + kLanes - 1) / kLanes * kLanes;
+    frequency_.assign(padded, 0.0);
+    increment_.assign(padded, 0.0);
+    rotate_sin_.assign(padded, 0.0);
+    rotate_cos_.assign(padded, 1.0);
+    amplitude_.assign(padded, 0.0);
+    phase_.assign(padded, 0.0);
+    for (size_t i = 0; i < size_; ++i) {
+        setFrequency(i, frequencies_hz[i]);
+        setPhase(i, phases.empty() ? 0.0 : phases[i]);
+        setAmplitude(i, amplitudes.empty() ? 1.0 : amplitudes[i]);
+    }
+}
+
+void OscillatorBank::checkIndex(size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("OscillatorBank: oscillator " + std::to_string(index) + " out of range");
+    }
+}
+
+void OscillatorBank::setFrequency(size_t index, double frequency_hz) {
+    checkIndex(index);
+    if (!std::isfinite(frequency_hz)) {
+        throw std::invalid_argument("OscillatorBank: frequency must be finite");
+    }
+    frequency_[index] = frequency_hz;
+    increment_[index] = wrapPhase(2.0 * M_PI * frequency_hz / sample_rate_);
+    rotate_sin_[index] = std::sin(increment_[index]);
+    rotate_cos_[index] = std::cos(increment_[index]);
+}
+
+void OscillatorBank::setAmplitude(size_t index, double amplitude) {
+    checkIndex(index);
+    if (!std::isfinite(amplitude)) {
+        throw std::invalid_argument("OscillatorBank: amplitude must be finite");
+    }
+    amplitude_[index] = amplitude;
+}
+
+void OscillatorBank::setPhase(size_t index, double phase) {
+    checkIndex(index);
+    if (!std::isfinite(phase)) {
+        throw std::invalid_argument("OscillatorBank: phase must be finite");
+    }
+    phase_[index] = wrapPhase(phase);
+}
+
+double OscillatorBank::frequency(size_t index) const {
+    checkIndex(index);
+    return frequency_[index];
+}
+
+double OscillatorBank::amplitude(size_t index) const {
+    checkIndex(index);
+    return amplitude_[index];
+}
+
+double OscillatorBank::phase(size_t index) const {
+    checkIndex(index);
+    return phase_[index];
+}
+
+std::vector<double> OscillatorBank::phases() const {
+    return std::vector<double>(phase_.begin(), phase_.begin() + static_cast<std::ptrdiff_t>(size_));
+}
+
+void OscillatorBank::renderSum(float* output, size_t num_samples, bool accumulate) {
+    if (num_samples == 0) {
+        return;
+    }
+    if (!output) {
+        throw std::invalid_argument("OscillatorBank: null output array");
+    }
+
+    const bool avx2 = CPUFeatures::hasAVX2() && CPUFeatures::hasFMA();
+    const size_t groups = phase_.size() / kLanes;
+    const std::ptrdiff_t chunks = static_cast<std::ptrdiff_t>((num_samples + kChunk - 1) / kChunk);
+
+    // Each chunk anchors every oscillator at its first sample, so chunks
+    // are independent; lane sums are reduced once per sample at the end
+    #pragma omp parallel for schedule(static) if(chunks > 1 && size_ * num_samples >= kParallelWork)
+    for (std::ptrdiff_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t start = static_cast<size_t>(chunk) * kChunk;
+        const size_t count = std::min(kChunk, num_samples - start);
+        alignas(32) double lanes[kChunk * kLanes];
+        std::fill(lanes, lanes + count * kLanes, 0.0);
+
+        for (size_t g = 0; g < groups; ++g) {
+            const size_t o = g * kLanes;
+            double s[kLanes];
+            double c[kLanes];
+            for (size_t l = 0; l < kLanes; ++l) {
+                const double anchor = phase_[o + l] + static_cast<double>(start) * increment_[o + l];
+                s[l] = std::sin(anchor);
+                c[l] = std::cos(anchor);
+            }
+            if (avx2) {
+                renderGroupAVX2(&amplitude_[o], &rotate_sin_[o], &rotate_cos_[o], s, c, count, lanes, true);
+            } else {
+                renderGroupScalar(&amplitude_[o], &rotate_sin_[o], &rotate_cos_[o], s, c, count, lanes, true);
+            }
+        }
+
+        float* out = output + start;
+        for (size_t n = 0; n < count; ++n) {
+            const double* sample = lanes + n * kLanes;
+            const double sum = (sample[0] + sample[1]) + (sample[2] + sample[3]);
+            out[n] = accumulate ? static_cast<float>(out[n] + sum) : static_cast<float>(sum);
+        }
+    }
+    advance(num_samples);
+}
+
+void OscillatorBank::renderChannels(float* output, size_t num_samples) {
+    if (num_samples == 0 || size_ == 0) {
+        advance(num_samples);
+        return;
+    }
+    if (!output) {
+        throw std::invalid_argument("OscillatorBank: null output array");
+    }
+
+    const bool avx2 = CPUFeatures::hasAVX2() && CPUFeatures::hasFMA();
+    const std::ptrdiff_t groups = static_cast<std::ptrdiff_t>(phase_.size() / kLanes);
+
+    #pragma omp parallel for schedule(static) if(groups > 1 && size_ * num_samples >= kParallelWork)
+    for (std::ptrdiff_t g = 0; g < groups; ++g) {
+        const size_t o = static_cast<size_t>(g) * kLanes;
+        const size_t rows = std::min(kLanes, size_ - o);
+        alignas(32) double lanes[kChunk * kLanes];
+        double s[kLanes];
+        double c[kLanes];
+
+        for (size_t start = 0; start < num_samples; start += kChunk) {
+            const size_t count = std::min(kChunk, num_samples - start);
+            for (size_t l = 0; l < kLanes; ++l) {
+                const double anchor = phase_[o + l] + static_cast<double>(start) * increment_[o + l];
+                s[l] = std::sin(anchor);
+                c[l] = std::cos(anchor);
+            }
+            if (avx2) {
+                renderGroupAVX2(&amplitude_[o], &rotate_sin_[o], &rotate_cos_[o], s, c, count, lanes, false);
+            } else {
+                renderGroupScalar(&amplitude_[o], &rotate_sin_[o], &rotate_cos_[o], s, c, count, lanes, false);
+            }
+            for (size_t l = 0; l < rows; ++l) {
+                float* out = output + (o + l) * num_samples + start;
+                for (size_t n = 0; n < count; ++n) {
+                    out[n] = static_cast<float>(lanes[n * kLanes + l]);
+                }
+            }
+        }
+    }
+    advance(num_samples);
+}
+
+void OscillatorBank::advance(size_t num_samples) {
+    for (size_t i = 0; i < size_; ++i) {
+        phase_[i] = wrapPhase(phase_[i] + static_cast<double>(num_samples) * increment_[i]);
+    }
+    samples_rendered_ += num_samples;
+}
+
+} // namespace dase
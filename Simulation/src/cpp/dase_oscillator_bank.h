@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * DASE Oscillator Bank - many sine oscillators rendered per call, with
+ * phase carried between calls
+ *
+ * AnalogUniversalNodeAVX2::oscillate renders one frequency per call from
+ * phase 0 (and allocates its output).  A bank holds K oscillators
+ *
+ *   x_i[n] = a_i sin(phi_i + n w_i),   w_i = 2 pi f_i / sample_rate
+ *
+ * and renders the next num_samples samples of all of them, either summed
+ * into one buffer or one row per oscillator.  phi_i advances by
+ * num_samples w_i (wrapped to [0, 2 pi), in double) after each call, so
+ * consecutive calls continue the same waveforms without drift.
+ *
+ * Samples are generated by rotating (sin, cos) of each oscillator by
+ * (sin w_i, cos w_i) once per sample, two multiply-adds each, re-anchored
+ * with std::sin / std::cos every kAnchorInterval samples so rounding does
+ * not accumulate (errors stay within ~1e-13 of std::sin).  SIMD lanes map
+ * across oscillators (kLanes per AVX2 vector, selected at runtime, with a
+ * scalar fallback); renderSum splits the samples and renderChannels the
+ * oscillators across OpenMP threads.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+
+class OscillatorBank {
+public:
+    // Oscillators per SIMD vector (doubles in an AVX2 register)
+    static constexpr size_t kLanes = 4;
+
+    // Samples between exact re-anchors of each oscillator
+    static constexpr size_t kAnchorInterval = 256;
+
+    /**
+     * @param frequencies_hz Frequency of each oscillator (any finite value)
+     * @param sample_rate Samples per second (> 0)
+     * @param phases Initial phase of each oscillator in radians (empty = 0)
+     * @param amplitudes Amplitude of each oscillator (empty = 1)
+     * @throws std::invalid_argument for a non-positive sample rate, a
+     *         non-finite value, or phases / amplitudes of another size
+     */
+    OscillatorBank(const std::vector<double>& frequencies_hz, double sample_rate,
+                   const std::vector<double>& phases = {},
+                   const std::vector<double>& amplitudes = {});
+
+    /**
+     * output[n] (+)= sum_i x_i[n] for the next num_samples samples
+     * (accumulate adds to the existing contents instead of overwriting)
+     */
+    void renderSum(float* output, size_t num_samples, bool accumulate = false);
+
+    /**
+     * Row i of output (size() x num_samples, oscillator-major) = x_i over
+     * the next num_samples samples
+     */
+    void renderChannels(float* output, size_t num_samples);
+
+    // Changes take effect from the next sample rendered
+    // @throws std::out_of_range / std::invalid_argument (non-finite value)
+    void setFrequency(size_t index, double frequency_hz);
+    void setAmplitude(size_t index, double amplitude);
+    void setPhase(size_t index, double phase);
+
+    size_t size() const { return size_; }
+    double sampleRate() const { return sample_rate_; }
+    double frequency(size_t index) const;
+    double amplitude(size_t index) const;
+    double phase(size_t index) const;        // Phase of the next sample, in [0, 2 pi)
+    std::vector<double> phases() const;
+
+    // Samples rendered since construction
+    uint64_t samplesRendered() const { return samples_rendered_; }
+
+private:
+    size_t size_;
+    double sample_rate_;
+    // Per-oscillator state, padded to a multiple of kLanes (padding is silent)
+    std::vector<double> frequency_;
+    std::vector<double> increment_;      // w_i, radians per sample
+    std::vector<double> rotate_sin_;     // sin(w_i)
+    std::vector<double> rotate_cos_;     // cos(w_i)
+    std::vector<double> amplitude_;
+    std::vector<double> phase_;
+    uint64_t samples_rendered_;
+
+    void checkIndex(size_t index) const;
+    void advance(size_t num_samples);
+};
+
+} // namespace dase
@@ -0,0 +1,232 @@
+/**
+ * DASE Streaming FIR Filter - implementation (see dase_stream_filter.h)
+ */
+
+#include "dase_stream_filter.h"
+#include "fftw_plan_registry.hpp"
+#include <fftw3.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace dase {
+
+namespace {
+
+// fftw_malloc'd buffers for `count` channels of one transform size
+struct FilterBuffers {
+    double* real = nullptr;            // count × N samples
+    fftw_complex* spectrum = nullptr;  // count × (N/2+1) bins
+
+    FilterBuffers() = default;
+    FilterBuffers(const FilterBuffers&) = delete;
+    FilterBuffers& operator=(const FilterBuffers&) = delete;
+    ~FilterBuffers() {
+        FFTPlanRegistry::release(real);
+        FFTPlanRegistry::release(spectrum);
+    }
+};
+
+// Calling thread's buffers for (N, count), reused across calls
+FilterBuffers& filterBuffers(int N, int count) {
+    thread_local std::map<std::pair<int, int>, FilterBuffers> buffers;
+    auto it = buffers.find(std::make_pair(N, count));
+    if (it == buffers.end()) {
+        it = buffers.emplace(std::piecewise_construct,
+                             std::forward_as_tuple(N, count), std::forward_as_tuple()).first;
+        it->second.real = FFTPlanRegistry::allocReal(static_cast<size_t>(N) * count);
+        it->second.spectrum = FFTPlanRegistry::allocComplex(static_cast<size_t>(N / 2 + 1) * count);
+        if (!it->second.real || !it->second.spectrum) {
+            buffers.erase(it);
+            throw std::bad_alloc();
+        }
+    }
+    return it->second;
+}
+
+int nextPowerOfTwo(int n) {
+    int p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+StreamFilter::StreamFilter(const std::vector<double>& taps, int block_size, int channels)
+    : taps_(taps)
+    , block_size_(block_size)
+    , fft_size_(0)
+    , channels_(channels)
+    , forward_{nullptr, nullptr}
+    , inverse_{nullptr, nullptr}
+    , samples_processed_(0) {
+    if (taps_.empty()) {
+        throw std::invalid_argument("StreamFilter: taps must not be empty");
+    }
+    for (double tap : taps_) {
+        if (!std::isfinite(tap)) {
+            throw std::invalid_argument("StreamFilter: taps must be finite");
+        }
+    }
+    if (block_size_ < 0) {
+        throw std::invalid_argument("StreamFilter: block_size must be >= 0");
+    }
+    if (channels_ < 1) {
+        throw std::invalid_argument("StreamFilter: channels must be >= 1");
+    }
+
+    const int M = numTaps();
+    if (block_size_ == 0) {
+        fft_size_ = nextPowerOfTwo(4 * M);
+        block_size_ = fft_size_ - M + 1;
+    } else {
+        fft_size_ = nextPowerOfTwo(block_size_ + M - 1);
+    }
+    const int N = fft_size_;
+    const int bins = N / 2 + 1;
+
+    // Filter spectrum, once: zero-padded taps through an r2c of size N
+    fftw_plan taps_plan = FFTPlanRegistry::acquire(
+        FFTPlanKey::make(FFTPlanKey::Kind::R2C, {N}), FFTPlanRegistry::Planning::Estimate);
+    FilterBuffers& work = filterBuffers(N, 1);
+    std::fill(work.real, work.real + N, 0.0);
+    std::copy(taps_.begin(), taps_.end(), work.real);
+    fftw_execute_dft_r2c(taps_plan, work.real, work.spectrum);
+    spectrum_.resize(2 * static_cast<size_t>(bins));
+    for (int k = 0; k < bins; ++k) {
+        spectrum_[2 * k] = work.spectrum[k][0] / N;
+        spectrum_[2 * k + 1] = work.spectrum[k][1] / N;
+    }
+
+    const int batch = std::min(channels_, kChannelBatch);
+    const int last = channels_ % batch == 0 ? batch : channels_ % batch;
+    const int shapes[2] = {batch, last};
+    for (int s = 0; s < 2; ++s) {
+        forward_[s] = FFTPlanRegistry::acquire(
+            FFTPlanKey::make(FFTPlanKey::Kind::R2C, {N}, FFTW_FORWARD, false, shapes[s]));
+        inverse_[s] = FFTPlanRegistry::acquire(
+            FFTPlanKey::make(FFTPlanKey::Kind::C2R, {N}, FFTW_BACKWARD, false, shapes[s]));
+    }
+
+    tail_.assign(static_cast<size_t>(channels_) * (M - 1), 0.0);
+}
+
+std::vector<double> StreamFilter::designFromResponse(const std::vector<double>& gains, int num_taps) {
+    if (gains.size() < 2) {
+        throw std::invalid_argument("StreamFilter: at least two response gains are needed");
+    }
+    for (double gain : gains) {
+        if (!std::isfinite(gain)) {
+            throw std::invalid_argument("StreamFilter: response gains must be finite");
+        }
+    }
+    if (num_taps < 1 || num_taps % 2 == 0) {
+        throw std::invalid_argument("StreamFilter: num_taps must be odd and positive");
+    }
+
+    // Gain at DFT bin k of num_taps: frequency k / M of the sample rate,
+    // position 2 (k / M) (K - 1) in the gains (Nyquist at K - 1)
+    const int M = num_taps;
+    const double last = static_cast<double>(gains.size() - 1);
+    auto gainAt = [&](int k) {
+        const double position = std::min(2.0 * k / M * last, last);
+        const size_t i = std::min(static_cast<size_t>(position), gains.size() - 2);
+        const double t = position - static_cast<double>(i);
+        return gains[i] + t * (gains[i + 1] - gains[i]);
+    };
+
+    // Inverse DFT of a real, even response delayed to the filter centre
+    const int centre = (M - 1) / 2;
+    std::vector<double> taps(static_cast<size_t>(M));
+    for (int n = 0; n < M; ++n) {
+        double sum = gainAt(0);
+        for (int k = 1; k <= centre; ++k) {
+            sum += 2.0 * gainAt(k) * std::cos(2.0 * M_PI * k * (n - centre) / M);
+        }
+        taps[static_cast<size_t>(n)] = sum / M;
+    }
+    return taps;
+}
+
+void StreamFilter::process(const float* input, float* output, size_t num_samples) {
+    if (num_samples == 0) {
+        return;
+    }
+    if (!input || !output) {
+        throw std::invalid_argument("StreamFilter: null sample array");
+    }
+
+    const int batch = std::min(channels_, kChannelBatch);
+    const int groups = (channels_ + batch - 1) / batch;
+
+    #pragma omp parallel for schedule(dynamic, 1) if(groups > 1)
+    for (int g = 0; g < groups; ++g) {
+        const int first = g * batch;
+        const int count = std::min(batch, channels_ - first);
+        processGroup(first, count, count == batch ? 0 : 1, input, output, num_samples);
+    }
+    samples_processed_ += num_samples;
+}
+
+void StreamFilter::processGroup(int first, int count, int shape, const float* input, float* output,
+                                size_t num_samples) {
+    const int N = fft_size_;
+    const int bins = N / 2 + 1;
+    const size_t M = taps_.size();
+    const size_t tail_length = M - 1;
+    FilterBuffers& work = filterBuffers(N, count);
+
+    for (size_t start = 0; start < num_samples; start += static_cast<size_t>(block_size_)) {
+        const size_t length = std::min(static_cast<size_t>(block_size_), num_samples - start);
+
+        for (int c = 0; c < count; ++c) {
+            const float* x = input + static_cast<size_t>(first + c) * num_samples + start;
+            double* real = work.real + static_cast<size_t>(c) * N;
+            for (size_t i = 0; i < length; ++i) real[i] = static_cast<double>(x[i]);
+            std::fill(real + length, real + N, 0.0);
+        }
+
+        fftw_execute_dft_r2c(forward_[shape], work.real, work.spectrum);
+        const double* h = spectrum_.data();
+        for (int c = 0; c < count; ++c) {
+            fftw_complex* X = work.spectrum + static_cast<size_t>(c) * bins;
+            for (int k = 0; k < bins; ++k) {
+                const double re = X[k][0] * h[2 * k] - X[k][1] * h[2 * k + 1];
+                const double im = X[k][0] * h[2 * k + 1] + X[k][1] * h[2 * k];
+                X[k][0] = re;
+                X[k][1] = im;
+            }
+        }
+        fftw_execute_dft_c2r(inverse_[shape], work.spectrum, work.real);
+
+        // y[0, length + M - 1) is the segment's convolution: the first
+        // `length` samples complete with the tail, the rest become the tail
+        for (int c = 0; c < count; ++c) {
+            const double* y = work.real + static_cast<size_t>(c) * N;
+            double* tail = tail_.data() + static_cast<size_t>(first + c) * tail_length;
+            float* out = output + static_cast<size_t>(first + c) * num_samples + start;
+            for (size_t i = 0; i < length; ++i) {
+                out[i] = static_cast<float>(y[i] + (i < tail_length ? tail[i] : 0.0));
+            }
+            for (size_t j = 0; j < tail_length; ++j) {
+                tail[j] = (j + length < tail_length ? tail[j + length] : 0.0) + y[length + j];
+            }
+        }
+    }
+}
+
+void StreamFilter::reset() {
+    std::fill(tail_.begin(), tail_.end(), 0.0);
+    samples_processed_ = 0;
+}
+
+} // namespace dase
@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * DASE Streaming FIR Filter - overlap-add FFT convolution of continuous
+ * multi-channel sample streams
+ *
+ * processBlockFrequencyDomain filters each block on its own (a fixed
+ * brick-wall band, circular over the block), so a stream cut into blocks
+ * picks up edge artifacts at every cut.  StreamFilter instead computes
+ * the linear convolution of the whole stream with an FIR h of M taps,
+ * however the stream is split into calls:
+ *
+ *   y[n] = Σ_m h[m] x[n - m]     (x = 0 before the first sample)
+ *
+ * The stream is cut into segments of L samples (the hop); each segment is
+ * zero-padded to N = next power of two >= L + M - 1, transformed (r2c),
+ * multiplied by the filter spectrum H (computed once per filter, 1/N
+ * folded in) and transformed back (c2r).  The first L outputs are final
+ * once the previous segment's M - 1 sample tail is added; the last M - 1
+ * become the new tail, kept per channel between calls.  A call may pass
+ * any number of samples: a short final segment uses the same transform.
+ *
+ * Channels are stored channel-major (row c holds num_samples samples of
+ * channel c) and transformed kChannelBatch at a time with one batched
+ * FFTW plan; channel groups run on separate OpenMP threads.  Samples are
+ * float in and out, double inside.
+ *
+ * Plans come from the process-wide dase::FFTPlanRegistry, so copies of
+ * a filter share them and each copy keeps its own stream state.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct fftw_plan_s;
+
+namespace dase {
+
+class StreamFilter {
+public:
+    // Channels per batched transform
+    static constexpr int kChannelBatch = 8;
+
+    /**
+     * @param taps FIR impulse response h[0..M)
+     * @param block_size Hop L in samples (0 = chosen from M: N = the
+     *        next power of two >= 4M, L = N - M + 1)
+     * @param channels Independent streams filtered with the same taps
+     * @throws std::invalid_argument for empty taps, non-finite taps, or a
+     *         negative block_size or channels < 1
+     */
+    StreamFilter(const std::vector<double>& taps, int block_size = 0, int channels = 1);
+
+    /**
+     * Linear-phase filter of num_taps (odd) taps by frequency sampling:
+     * its response is exactly gains at the num_taps-point DFT frequencies,
+     * with a delay of (num_taps - 1) / 2 samples.  gains samples the
+     * magnitude response at evenly spaced frequencies from 0 to Nyquist
+     * (inclusive, at least two), linearly interpolated in between.
+     *
+     * @throws std::invalid_argument for fewer than two gains, a
+     *         non-finite gain, or an even or non-positive num_taps
+     */
+    static std::vector<double> designFromResponse(const std::vector<double>& gains, int num_taps);
+
+    /**
+     * Filter the next num_samples samples of every channel.  input and
+     * output are channels x num_samples, channel-major, and may be the
+     * same array.
+     */
+    void process(const float* input, float* output, size_t num_samples);
+
+    /**
+     * Forget the stream history (the tails), as if no sample had been seen
+     */
+    void reset();
+
+    int numTaps() const { return static_cast<int>(taps_.size()); }
+    int blockSize() const { return block_size_; }
+    int fftSize() const { return fft_size_; }
+    int channels() const { return channels_; }
+    const std::vector<double>& taps() const { return taps_; }
+
+    // Samples of every channel filtered since construction or reset()
+    uint64_t samplesProcessed() const { return samples_processed_; }
+
+private:
+    std::vector<double> taps_;
+    int block_size_;
+    int fft_size_;
+    int channels_;
+    std::vector<double> spectrum_;      // H re / im interleaved, N/2+1 bins, 1/N folded in
+    std::vector<double> tail_;          // channels x (M - 1) pending outputs
+    fftw_plan_s* forward_[2];           // r2c plans for kChannelBatch / the last group's channels
+    fftw_plan_s* inverse_[2];           // c2r plans, same shapes (owned by the registry)
+    uint64_t samples_processed_;
+
+    // Helper: filter channels [first, first + count) with plan slot `shape`
+    void processGroup(int first, int count, int shape, const float* input, float* output,
+                      size_t num_samples);
+};
+
+} // namespace dase
@@ -0,0 +1,222 @@
+/**
+ * DASE Real-Time Streaming Session Implementation
+ */
+
+#include "dase_stream_session.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace dase {
+
+namespace {
+
+int64_t steadyNowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool lockRegion(const void* data, size_t bytes) noexcept {
+    if (bytes == 0) {
+        return true;
+    }
+#ifdef _WIN32
+    return VirtualLock(const_cast<void*>(data), bytes) != 0;
+#else
+    return mlock(data, bytes) == 0;
+#endif
+}
+
+void unlockRegion(const void* data, size_t bytes) noexcept {
+    if (bytes == 0) {
+        return;
+    }
+#ifdef _WIN32
+    VirtualUnlock(const_cast<void*>(data), bytes);
+#else
+    munlock(data, bytes);
+#endif
+}
+
+bool pinCurrentThread(int cpu) noexcept {
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;   // 0 = calling thread
+#elif defined(_WIN32)
+    return cpu < 64 && SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Polls of an empty pipeline before the thread starts yielding its CPU
+constexpr int kSpinPolls = 4096;
+
+} // namespace
+
+StreamSession::StreamSession(AnalogCellularEngineAVX2& engine, const StreamSessionOptions& options)
+    : engine_(engine),
+      options_(options),
+      input_(options.block_size * options.ring_blocks),
+      output_(options.block_size * options.ring_blocks),
+      block_ready_ns_(options.ring_blocks),
+      block_input_(options.block_size),
+      block_control_(options.block_size),
+      block_output_(options.block_size) {
+    if (options.block_size == 0) {
+        throw std::invalid_argument("StreamSession: block_size must be positive");
+    }
+    if (options.ring_blocks < 2) {
+        throw std::invalid_argument("StreamSession: ring_blocks must be at least 2");
+    }
+    if (options.cpu < -1) {
+        throw std::invalid_argument("StreamSession: cpu must be -1 (unpinned) or a CPU id");
+    }
+
+    if (options_.lock_memory) {
+        lockMemory();
+    }
+    engine_.streamLatency().reset();
+    thread_ = std::thread([this] { run(); });
+}
+
+StreamSession::~StreamSession() {
+    stop();
+}
+
+std::size_t StreamSession::push(const double* input_signals, const double* control_patterns,
+                                std::size_t count) noexcept {
+    const size_t block = options_.block_size;
+    const size_t n = std::min(count, input_.writeAvailable());
+    if (n < count) {
+        engine_.streamLatency().recordOverrun(count - n);
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    // Stamp the blocks this push completes before publishing them
+    const uint64_t before = input_.written();
+    const uint64_t after = before + n;
+    const int64_t now = steadyNowNs();
+    for (uint64_t b = before / block; (b + 1) * block <= after; ++b) {
+        block_ready_ns_[b % options_.ring_blocks].store(now, std::memory_order_relaxed);
+    }
+
+    return input_.write(n, [&](Sample* slot, size_t offset, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            slot[i].input = input_signals[offset + i];
+            slot[i].control = control_patterns[offset + i];
+        }
+    });
+}
+
+std::size_t StreamSession::pop(double* outputs, std::size_t max_count) noexcept {
+    return output_.read(outputs, max_count);
+}
+
+void StreamSession::stop() {
+    if (thread_.joinable()) {
+        stop_.store(true, std::memory_order_release);
+        thread_.join();
+    }
+    unlockMemory();
+}
+
+void StreamSession::run() noexcept {
+    if (options_.cpu >= 0) {
+        pinned_.store(pinCurrentThread(options_.cpu), std::memory_order_release);
+    }
+
+    int idle_polls = 0;
+    while (true) {
+        if (processBlock()) {
+            idle_polls = 0;
+            continue;
+        }
+        // Nothing to do: everything pushed before stop() has been seen
+        if (stop_.load(std::memory_order_acquire)) {
+            while (processBlock()) {
+            }
+            return;
+        }
+        if (++idle_polls >= kSpinPolls) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool StreamSession::processBlock() noexcept {
+    const size_t block = options_.block_size;
+    if (input_.readAvailable() < block || output_.writeAvailable() < block) {
+        return false;
+    }
+
+    // The stamp slot is reused only once this block's samples are freed
+    const int64_t ready_ns = block_ready_ns_[blocks_done_ % options_.ring_blocks].load(std::memory_order_relaxed);
+    input_.read(block, [&](const Sample* slot, size_t offset, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            block_input_[offset + i] = slot[i].input;
+            block_control_[offset + i] = slot[i].control;
+        }
+    });
+
+    engine_.runStreamBlock(block_input_.data(), block_control_.data(), block,
+                           options_.iterations_per_node, block_output_.data());
+    output_.write(block_output_.data(), block);
+
+    const int64_t latency = steadyNowNs() - ready_ns;
+    engine_.streamLatency().record(latency > 0 ? static_cast<uint64_t>(latency) : 0);
+    blocks_done_++;
+    return true;
+}
+
+void StreamSession::lockMemory() {
+    const size_t nodes = engine_.getNodeCount();
+    const std::pair<const void*, size_t> regions[] = {
+        {input_.data(), input_.bytes()},
+        {output_.data(), output_.bytes()},
+        {block_ready_ns_.data(), block_ready_ns_.size() * sizeof(std::atomic<int64_t>)},
+        {block_input_.data(), block_input_.size() * sizeof(double)},
+        {block_control_.data(), block_control_.size() * sizeof(double)},
+        {block_output_.data(), block_output_.size() * sizeof(double)},
+        {engine_.getStateArray(AnalogCellularEngineAVX2::StateArray::IntegratorState), nodes * sizeof(double)},
+        {engine_.getStateArray(AnalogCellularEngineAVX2::StateArray::FeedbackGain), nodes * sizeof(double)},
+        {engine_.getStateArray(AnalogCellularEngineAVX2::StateArray::PreviousInput), nodes * sizeof(double)},
+        {engine_.getStateArray(AnalogCellularEngineAVX2::StateArray::CurrentOutput), nodes * sizeof(double)},
+    };
+    memory_locked_ = true;
+    for (const auto& region : regions) {
+        if (lockRegion(region.first, region.second)) {
+            locked_.push_back(region);
+        } else {
+            memory_locked_ = false;
+        }
+    }
+}
+
+void StreamSession::unlockMemory() noexcept {
+    for (const auto& region : locked_) {
+        unlockRegion(region.first, region.second);
+    }
+    locked_.clear();
+    memory_locked_ = false;
+}
+
+} // namespace dase
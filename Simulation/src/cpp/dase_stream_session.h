@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * DASE Real-Time Streaming Session - block-by-block mission processing with
+ * bounded latency
+ *
+ * runMissionOptimized* take a whole precomputed signal and return when every
+ * step is done.  A StreamSession instead runs the engine continuously on a
+ * dedicated processing thread fed through lock-free SPSC rings (spsc_ring.h):
+ *
+ *   producer --push(input, control)--> [input ring]  --> processing thread
+ *   consumer <--pop(outputs)---------- [output ring] <--      (per block)
+ *
+ * Whenever a full block of block_size samples is waiting and the output
+ * ring has room for its outputs, the thread runs it through
+ * AnalogCellularEngineAVX2::runStreamBlock (one Phase 4C step per sample,
+ * output = mean node output after the step) and publishes the outputs.
+ * Input that does not fit in the ring is refused, not queued: push()
+ * reports how much it took and the rest counts as an overrun.  A full
+ * output ring holds the thread back (the consumer sets the pace).
+ *
+ * Everything the hot path touches is allocated in the constructor: the
+ * rings, one block of scratch per direction and the block timestamps.
+ * With lock_memory those and the engine's state arrays are also locked
+ * into RAM (mlock / VirtualLock, best effort) so no page fault lands on
+ * the hot path.  With cpu >= 0 the thread pins itself to that CPU (Linux,
+ * Windows).  The thread spins, then yields, while it waits.
+ *
+ * Each block's latency - from push() completing its last input sample to
+ * its outputs being readable - is recorded in the engine's
+ * StreamLatencyHistogram and reported by getMetrics() (stream_* fields of
+ * EngineMetrics).  The histogram is reset when a session starts.
+ *
+ * While a session runs it owns the engine: no missions, checkpoints or
+ * other sessions on it until stop().  push() may be called from one thread
+ * and pop() from one (possibly different) thread.
+ */
+
+#include "analog_universal_node_engine_avx2.h"
+#include "spsc_ring.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dase {
+
+struct StreamSessionOptions {
+    std::size_t block_size = 64;            // Samples (mission steps) per block
+    std::size_t ring_blocks = 8;            // Capacity of each ring, in blocks
+    std::uint32_t iterations_per_node = 30;
+    int cpu = -1;                           // CPU to pin the processing thread to (-1 = unpinned)
+    bool lock_memory = true;                // Lock rings, scratch and engine state into RAM
+};
+
+class StreamSession {
+public:
+    /**
+     * Allocate (and lock) the session's memory and start its thread
+     * @throws std::invalid_argument for block_size 0, fewer than 2
+     *         ring_blocks, or cpu < -1
+     */
+    StreamSession(AnalogCellularEngineAVX2& engine, const StreamSessionOptions& options = {});
+    ~StreamSession();
+
+    StreamSession(const StreamSession&) = delete;
+    StreamSession& operator=(const StreamSession&) = delete;
+
+    /**
+     * Producer: queue up to count samples (input_signals[i],
+     * control_patterns[i]); never blocks
+     * @return samples taken (the rest are overruns)
+     */
+    std::size_t push(const double* input_signals, const double* control_patterns, std::size_t count) noexcept;
+
+    /**
+     * Consumer: take up to max_count processed outputs, in order; never
+     * blocks
+     * @return outputs written to `outputs`
+     */
+    std::size_t pop(double* outputs, std::size_t max_count) noexcept;
+
+    /**
+     * Process the complete blocks already pushed, then stop the thread and
+     * unlock memory.  A trailing partial block is discarded.  Outputs can
+     * still be popped afterwards.  Idempotent.
+     */
+    void stop();
+
+    bool running() const noexcept { return thread_.joinable(); }
+    bool pinned() const noexcept { return pinned_.load(std::memory_order_acquire); }
+    // Whether every region was locked (until stop())
+    bool memoryLocked() const noexcept { return memory_locked_; }
+    std::size_t blockSize() const noexcept { return options_.block_size; }
+    const AnalogCellularEngineAVX2& engine() const noexcept { return engine_; }
+
+private:
+    struct Sample {
+        double input;
+        double control;
+    };
+
+    void run() noexcept;
+    // Process one block if a full one is queued and its outputs fit
+    bool processBlock() noexcept;
+    void lockMemory();
+    void unlockMemory() noexcept;
+
+    AnalogCellularEngineAVX2& engine_;
+    StreamSessionOptions options_;
+
+    SpscRing<Sample> input_;
+    SpscRing<double> output_;
+
+    // Per block of the input ring (indexed by block number mod
+    // ring_blocks): when push() completed it, in steady-clock ns
+    std::vector<std::atomic<int64_t>> block_ready_ns_;
+
+    // Processing-thread scratch, one block each
+    std::vector<double> block_input_;
+    std::vector<double> block_control_;
+    std::vector<double> block_output_;
+    uint64_t blocks_done_ = 0;
+
+    std::vector<std::pair<const void*, std::size_t>> locked_;
+    bool memory_locked_ = false;
+    std::atomic<bool> pinned_{false};
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+} // namespace dase
@@ -0,0 +1,378 @@
+#pragma once
+
+// ============================================================================
+// ENERGY METER
+// ============================================================================
+//
+// Optional energy accounting around missions, so kernel variants (ISA,
+// precision, team width) can be compared by joules per simulated step
+// rather than wall time alone.
+//
+// Linux: the powercap RAPL zones under /sys/class/powercap.  The meter sums
+// every package zone (intel-rapl:N, also used for AMD) and the DRAM
+// subzones inside them; core / uncore subzones are part of their package
+// and are skipped.  It falls back to the psys (platform) zone when no
+// package zone is present.  Counters are microjoules that wrap at
+// max_energy_range_uj, and one wrap per interval is undone.  Recent kernels
+// restrict energy_uj to root, in which case open() fails.
+//
+// Windows: the Energy Meter Interface (EMI, Windows 10 1809+) devices.  The
+// meter sums the *_PKG and *_DRAM channels of each meter, or every channel
+// of a meter that has neither.  Energy is in picowatt-hours.
+//
+// The counters are package-wide, not per process: missions running at the
+// same time, or anything else busy on the machine, are charged to every
+// interval that overlaps them.  Elsewhere open() reports failure.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <cstdio>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <initguid.h>
+#include <setupapi.h>
+#include <emi.h>
+#include <cstddef>
+#ifdef _MSC_VER
+#pragma comment(lib, "setupapi.lib")
+#endif
+#endif
+
+struct EnergySample {
+    bool valid = false;
+    double joules = 0.0;
+    double seconds = 0.0;    // Wall time between start() and stop()
+
+    double averageWatts() const { return seconds > 0.0 ? joules / seconds : 0.0; }
+};
+
+class EnergyMeter {
+public:
+    // `powercap_root` is the sysfs powercap directory (Linux; tests point it
+    // at a fake tree)
+    explicit EnergyMeter(std::string powercap_root = "/sys/class/powercap")
+        : powercap_root_(std::move(powercap_root)) {}
+    EnergyMeter(const EnergyMeter&) = delete;
+    EnergyMeter& operator=(const EnergyMeter&) = delete;
+    ~EnergyMeter() { close(); }
+
+    /**
+     * Find and open the energy counters
+     * @return false if there are none or none can be read (nothing is kept open)
+     */
+    bool open() {
+        close();
+#ifdef __linux__
+        openPowercap();
+#elif defined(_WIN32)
+        openEmi();
+#endif
+        return isOpen();
+    }
+
+    bool isOpen() const noexcept { return !domains_.empty(); }
+
+    // Counters summed, and where they come from ("rapl" / "emi")
+    size_t domains() const noexcept { return domains_.size(); }
+    const char* source() const noexcept {
+#ifdef _WIN32
+        return "emi";
+#else
+        return "rapl";
+#endif
+    }
+
+    // Names of the summed counters (zone or channel names)
+    std::vector<std::string> domainNames() const {
+        std::vector<std::string> names;
+        for (const Domain& domain : domains_) {
+            names.push_back(domain.name);
+        }
+        return names;
+    }
+
+    void start() noexcept {
+        for (Domain& domain : domains_) {
+            domain.start = read(domain);
+        }
+        start_time_ = std::chrono::steady_clock::now();
+    }
+
+    // Energy since start(); invalid if a counter could not be read
+    EnergySample stop() noexcept {
+        EnergySample sample;
+        sample.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+        if (domains_.empty()) {
+            return sample;
+        }
+        sample.valid = true;
+        for (Domain& domain : domains_) {
+            const std::uint64_t now = read(domain);
+            if (now == kUnreadable || domain.start == kUnreadable) {
+                sample.valid = false;
+                continue;
+            }
+            std::uint64_t delta = now - domain.start;
+            if (now < domain.start) {
+                delta = domain.range > domain.start ? domain.range - domain.start + now : 0;
+            }
+            sample.joules += static_cast<double>(delta) * domain.joules_per_unit;
+        }
+        if (!sample.valid) {
+            sample.joules = 0.0;
+        }
+        return sample;
+    }
+
+    void close() noexcept {
+#ifdef _WIN32
+        for (Domain& domain : domains_) {
+            if (domain.device != INVALID_HANDLE_VALUE && domain.owns_device) {
+                CloseHandle(domain.device);
+            }
+        }
+#endif
+        domains_.clear();
+    }
+
+private:
+    static constexpr std::uint64_t kUnreadable = ~std::uint64_t(0);
+
+    struct Domain {
+        std::string name;
+        double joules_per_unit = 1.0e-6;
+        std::uint64_t range = 0;     // Counter wraps here (0: unknown)
+        std::uint64_t start = 0;
+#ifdef __linux__
+        std::string energy_path;
+#endif
+#ifdef _WIN32
+        HANDLE device = INVALID_HANDLE_VALUE;
+        bool owns_device = false;    // One domain per meter closes the handle
+        ULONG channels = 1;          // Channels in the meter's measurement
+        std::vector<ULONG> summed;   // Channels this domain adds up
+#endif
+    };
+
+#ifdef __linux__
+    static bool readText(const std::string& path, std::string& out) {
+        std::FILE* f = std::fopen(path.c_str(), "r");
+        if (!f) {
+            return false;
+        }
+        char buffer[256];
+        const size_t n = std::fread(buffer, 1, sizeof(buffer) - 1, f);
+        std::fclose(f);
+        buffer[n] = '\0';
+        out = buffer;
+        while (!out.empty() && (out.back() == '\n' || out.back() == ' ')) {
+            out.pop_back();
+        }
+        return true;
+    }
+
+    static std::uint64_t readCounter(const std::string& path) {
+        std::string text;
+        if (!readText(path, text) || text.empty()) {
+            return kUnreadable;
+        }
+        try {
+            return std::stoull(text);
+        } catch (...) {
+            return kUnreadable;
+        }
+    }
+
+    static std::vector<std::string> listDir(const std::string& path) {
+        std::vector<std::string> entries;
+        if (DIR* dir = opendir(path.c_str())) {
+            while (dirent* entry = readdir(dir)) {
+                entries.emplace_back(entry->d_name);
+            }
+            closedir(dir);
+        }
+        return entries;
+    }
+
+    // Add the zone at `dir` if its counter is readable
+    void addZone(const std::string& dir, const std::string& name) {
+        Domain domain;
+        domain.name = name;
+        domain.energy_path = dir + "/energy_uj";
+        const std::uint64_t range = readCounter(dir + "/max_energy_range_uj");
+        domain.range = range == kUnreadable ? 0 : range;
+        if (readCounter(domain.energy_path) != kUnreadable) {
+            domains_.push_back(domain);
+        }
+    }
+
+    void openPowercap() {
+        std::vector<std::string> packages;
+        std::string psys;
+        for (const std::string& entry : listDir(powercap_root_)) {
+            // Top-level RAPL zones: intel-rapl:N (intel-rapl-mmio duplicates them)
+            if (entry.compare(0, 11, "intel-rapl:") != 0 || entry.find(':', 11) != std::string::npos) {
+                continue;
+            }
+            std::string name;
+            if (!readText(powercap_root_ + "/" + entry + "/name", name)) {
+                continue;
+            }
+            if (name.compare(0, 7, "package") == 0) {
+                packages.push_back(entry);
+            } else if (name == "psys") {
+                psys = entry;
+            }
+        }
+        std::sort(packages.begin(), packages.end());
+        for (const std::string& package : packages) {
+            const std::string dir = powercap_root_ + "/" + package;
+            std::string name;
+            readText(dir + "/name", name);
+            addZone(dir, name);
+            for (const std::string& sub : listDir(dir)) {
+                std::string sub_name;
+                if (sub.compare(0, package.size() + 1, package + ":") == 0 &&
+                    readText(dir + "/" + sub + "/name", sub_name) && sub_name == "dram") {
+                    addZone(dir + "/" + sub, name + "/dram");
+                }
+            }
+        }
+        if (domains_.empty() && !psys.empty()) {
+            addZone(powercap_root_ + "/" + psys, "psys");
+        }
+    }
+
+    static std::uint64_t read(const Domain& domain) noexcept {
+        try {
+            return readCounter(domain.energy_path);
+        } catch (...) {
+            return kUnreadable;
+        }
+    }
+#elif defined(_WIN32)
+    static bool channelSummed(const std::wstring& name) {
+        const auto endsWith = [&name](const wchar_t* suffix) {
+            const std::wstring s(suffix);
+            return name.size() >= s.size() && name.compare(name.size() - s.size(), s.size(), s) == 0;
+        };
+        return endsWith(L"_PKG") || endsWith(L"_DRAM");
+    }
+
+    void openEmi() {
+        HDEVINFO info = SetupDiGetClassDevsW(&GUID_DEVICE_ENERGY_METER, nullptr, nullptr,
+                                             DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+        if (info == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        SP_DEVICE_INTERFACE_DATA interface_data;
+        interface_data.cbSize = sizeof(interface_data);
+        for (DWORD i = 0; SetupDiEnumDeviceInterfaces(info, nullptr, &GUID_DEVICE_ENERGY_METER, i, &interface_data); ++i) {
+            DWORD size = 0;
+            SetupDiGetDeviceInterfaceDetailW(info, &interface_data, nullptr, 0, &size, nullptr);
+            if (size == 0) {
+                continue;
+            }
+            std::vector<BYTE> detail_buffer(size);
+            auto* detail = reinterpret_cast<PSP_DEVICE_INTERFACE_DETAIL_DATA_W>(detail_buffer.data());
+            detail->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W);
+            if (!SetupDiGetDeviceInterfaceDetailW(info, &interface_data, detail, size, nullptr, nullptr)) {
+                continue;
+            }
+            HANDLE device = CreateFileW(detail->DevicePath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (device != INVALID_HANDLE_VALUE && !addMeter(device, i)) {
+                CloseHandle(device);
+            }
+        }
+        SetupDiDestroyDeviceInfoList(info);
+    }
+
+    // One domain per meter; false if it could not be queried
+    bool addMeter(HANDLE device, DWORD index) {
+        DWORD bytes = 0;
+        EMI_VERSION version = {};
+        if (!DeviceIoControl(device, IOCTL_EMI_GET_VERSION, nullptr, 0, &version, sizeof(version), &bytes, nullptr)) {
+            return false;
+        }
+        Domain domain;
+        domain.device = device;
+        domain.owns_device = true;
+        domain.joules_per_unit = 3.6e-9;   // pWh
+        domain.name = "emi" + std::to_string(index);
+        if (version.EmiVersion == EMI_VERSION_V2) {
+            EMI_METADATA_SIZE metadata_size = {};
+            if (!DeviceIoControl(device, IOCTL_EMI_GET_METADATA_SIZE, nullptr, 0, &metadata_size,
+                                 sizeof(metadata_size), &bytes, nullptr) ||
+                metadata_size.MetadataSize < sizeof(EMI_METADATA_V2)) {
+                return false;
+            }
+            std::vector<BYTE> metadata(metadata_size.MetadataSize);
+            if (!DeviceIoControl(device, IOCTL_EMI_GET_METADATA, nullptr, 0, metadata.data(),
+                                 static_cast<DWORD>(metadata.size()), &bytes, nullptr)) {
+                return false;
+            }
+            const auto* header = reinterpret_cast<const EMI_METADATA_V2*>(metadata.data());
+            domain.channels = header->ChannelCount;
+            const BYTE* channel = reinterpret_cast<const BYTE*>(&header->Channels[0]);
+            const BYTE* end = metadata.data() + metadata.size();
+            for (ULONG c = 0; c < header->ChannelCount && channel < end; ++c) {
+                const auto* info = reinterpret_cast<const EMI_CHANNEL_V2*>(channel);
+                const std::wstring name(info->ChannelName, info->ChannelNameSize / sizeof(WCHAR));
+                if (channelSummed(name)) {
+                    domain.summed.push_back(c);
+                }
+                channel += offsetof(EMI_CHANNEL_V2, ChannelName) + info->ChannelNameSize;
+            }
+            if (domain.summed.empty()) {
+                for (ULONG c = 0; c < domain.channels; ++c) {
+                    domain.summed.push_back(c);
+                }
+            }
+        } else if (version.EmiVersion == EMI_VERSION_V1) {
+            domain.summed.push_back(0);
+        } else {
+            return false;
+        }
+        if (domain.channels == 0) {
+            return false;
+        }
+        domains_.push_back(domain);
+        return true;
+    }
+
+    // Summed AbsoluteEnergy of the domain's channels (V1 data is one channel
+    // with the same layout)
+    static std::uint64_t read(const Domain& domain) noexcept {
+        std::vector<EMI_CHANNEL_MEASUREMENT_DATA> data(domain.channels);
+        DWORD bytes = 0;
+        if (!DeviceIoControl(domain.device, IOCTL_EMI_GET_MEASUREMENT, nullptr, 0, data.data(),
+                             static_cast<DWORD>(data.size() * sizeof(data[0])), &bytes, nullptr)) {
+            return kUnreadable;
+        }
+        std::uint64_t energy = 0;
+        for (ULONG c : domain.summed) {
+            energy += data[c].AbsoluteEnergy;
+        }
+        return energy;
+    }
+#else
+    static std::uint64_t read(const Domain&) noexcept { return kUnreadable; }
+#endif
+
+    std::string powercap_root_;
+    std::vector<Domain> domains_;
+    std::chrono::steady_clock::time_point start_time_ = std::chrono::steady_clock::now();
+};
@@ -0,0 +1,498 @@
+#pragma once
+
+// ============================================================================
+// ENGINE CHECKPOINT IMAGE
+// ============================================================================
+//
+// Versioned binary image of an engine's complete state, shared by the CLI's
+// checkpoint_engine / restore_engine and the C APIs' *_checkpoint_engine /
+// *_restore_engine.  Each engine writes its arrays as named sections; the
+// CLI adds a "config" text section with the create_engine parameters so a
+// checkpoint can be restored into a fresh process.
+//
+// File layout (native byte order; the endian tag rejects a foreign one):
+//
+//   CheckpointFileHeader                 64 bytes
+//   CheckpointSectionEntry[count]        directory, 80 bytes each
+//   section data                         each 64-byte aligned
+//
+// Restores map the file (POSIX mmap / Windows file mapping) and copy each
+// array straight from the mapped pages, so large images are never read
+// into an intermediate buffer.  Arrays are aligned in the file, so a
+// (CheckpointImage::data) pointer can also be used in place.
+//
+// Writes go to "<path>.tmp" and are renamed over <path> once complete: a
+// job killed mid-checkpoint leaves the previous checkpoint intact.
+//
+// The same image can be built in memory (CheckpointWriter::writeMemory) and
+// read back from there: clone_engine copies an engine into fresh ones that
+// way, with one copy per state array and no file or JSON round trip.
+//
+// Errors throw std::runtime_error; the C APIs and the CLI translate them.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dase {
+
+constexpr char kCheckpointMagic[8] = {'D', 'A', 'S', 'E', 'C', 'K', 'P', 'T'};
+constexpr uint32_t kCheckpointVersion = 1;
+constexpr uint32_t kCheckpointEndianTag = 0x01020304u;
+constexpr size_t kCheckpointAlignment = 64;
+
+enum class CheckpointType : uint32_t {
+    Bytes  = 0,   // Opaque records (elem_size bytes each, e.g. node structs)
+    Text   = 1,   // UTF-8 text (JSON)
+    F64    = 2,
+    F32    = 3,
+    U64    = 4,
+    C128   = 5    // std::complex<double>
+};
+
+struct CheckpointFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;
+    uint64_t section_count;
+    uint64_t file_size;
+    uint8_t reserved[32];
+};
+static_assert(sizeof(CheckpointFileHeader) == 64, "checkpoint header is 64 bytes");
+
+struct CheckpointSectionEntry {
+    char name[48];
+    uint32_t type;        // CheckpointType
+    uint32_t elem_size;   // Bytes per element
+    uint64_t count;       // Elements
+    uint64_t offset;      // From the start of the file, kCheckpointAlignment aligned
+    uint64_t reserved;
+};
+static_assert(sizeof(CheckpointSectionEntry) == 80, "checkpoint directory entry is 80 bytes");
+
+/**
+ * kCheckpointAlignment-aligned bytes of an image built in memory
+ */
+class CheckpointBuffer {
+public:
+    explicit CheckpointBuffer(size_t size)
+        : data_(static_cast<char*>(::operator new(std::max<size_t>(size, 1), std::align_val_t(kCheckpointAlignment))))
+        , size_(size) {}
+
+    ~CheckpointBuffer() { ::operator delete(data_, std::align_val_t(kCheckpointAlignment)); }
+
+    CheckpointBuffer(const CheckpointBuffer&) = delete;
+    CheckpointBuffer& operator=(const CheckpointBuffer&) = delete;
+
+    char* data() { return data_; }
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    char* data_;
+    size_t size_;
+};
+
+/**
+ * Collects sections and writes the image.  Sections reference the caller's
+ * memory, which must stay valid until write().
+ */
+class CheckpointWriter {
+public:
+    void add(const std::string& name, CheckpointType type, const void* data,
+             size_t elem_size, size_t count) {
+        if (name.empty() || name.size() >= sizeof(CheckpointSectionEntry::name)) {
+            throw std::runtime_error("Invalid checkpoint section name: " + name);
+        }
+        for (const auto& section : sections_) {
+            if (section.name == name) {
+                throw std::runtime_error("Duplicate checkpoint section: " + name);
+            }
+        }
+        sections_.push_back({name, type, data, elem_size, count});
+    }
+
+    void addF64(const std::string& name, const double* data, size_t count) {
+        add(name, CheckpointType::F64, data, sizeof(double), count);
+    }
+    void addU64(const std::string& name, const uint64_t* data, size_t count) {
+        add(name, CheckpointType::U64, data, sizeof(uint64_t), count);
+    }
+    template <typename Record>
+    void addRecords(const std::string& name, const std::vector<Record>& records) {
+        add(name, CheckpointType::Bytes, records.data(), sizeof(Record), records.size());
+    }
+    // Small sections that are copied (need not outlive the call)
+    void addText(const std::string& name, const std::string& text) {
+        addOwned(name, CheckpointType::Text, text.data(), 1, text.size());
+    }
+    void addBytes(const std::string& name, const std::string& bytes) {
+        addOwned(name, CheckpointType::Bytes, bytes.data(), 1, bytes.size());
+    }
+    void addValues(const std::string& name, std::initializer_list<double> values) {
+        addOwned(name, CheckpointType::F64, values.begin(), sizeof(double), values.size());
+    }
+    void addValues(const std::string& name, std::initializer_list<uint64_t> values) {
+        addOwned(name, CheckpointType::U64, values.begin(), sizeof(uint64_t), values.size());
+    }
+    template <typename Record>
+    void addRecord(const std::string& name, const Record& record) {
+        addOwned(name, CheckpointType::Bytes, &record, sizeof(Record), 1);
+    }
+
+    // Bytes of section data added so far (what the image would hold,
+    // without directory or alignment padding)
+    uint64_t payloadBytes() const {
+        uint64_t bytes = 0;
+        for (const auto& section : sections_) {
+            bytes += section.elem_size * section.count;
+        }
+        return bytes;
+    }
+
+    void write(const std::string& path) const {
+        CheckpointFileHeader header;
+        std::vector<CheckpointSectionEntry> directory;
+        layout(header, directory);
+
+        const std::string tmp_path = path + ".tmp";
+        std::FILE* file = std::fopen(tmp_path.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("Cannot open checkpoint for writing: " + tmp_path);
+        }
+        bool ok = emit(header, directory, [file](const void* data, size_t bytes) {
+            return std::fwrite(data, 1, bytes, file) == bytes;
+        });
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok) {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("Failed writing checkpoint: " + tmp_path);
+        }
+#ifdef _WIN32
+        const bool renamed = MoveFileExA(tmp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        const bool renamed = std::rename(tmp_path.c_str(), path.c_str()) == 0;
+#endif
+        if (!renamed) {
+            std::remove(tmp_path.c_str());
+            throw std::runtime_error("Cannot replace checkpoint: " + path);
+        }
+    }
+
+    // The image write() would produce, in an aligned buffer
+    std::unique_ptr<CheckpointBuffer> writeMemory() const {
+        CheckpointFileHeader header;
+        std::vector<CheckpointSectionEntry> directory;
+        layout(header, directory);
+
+        auto buffer = std::make_unique<CheckpointBuffer>(static_cast<size_t>(header.file_size));
+        char* out = buffer->data();
+        emit(header, directory, [&out](const void* data, size_t bytes) {
+            std::memcpy(out, data, bytes);
+            out += bytes;
+            return true;
+        });
+        return buffer;
+    }
+
+private:
+    struct Section {
+        std::string name;
+        CheckpointType type;
+        const void* data;
+        size_t elem_size;
+        size_t count;
+        size_t owned_index = 0;   // 1-based into owned_ (0 = data)
+    };
+
+    void addOwned(const std::string& name, CheckpointType type, const void* data,
+                  size_t elem_size, size_t count) {
+        add(name, type, nullptr, elem_size, count);
+        owned_.emplace_back(static_cast<const char*>(data), elem_size * count);
+        sections_.back().owned_index = owned_.size();
+    }
+
+    static uint64_t alignUp(uint64_t value) {
+        return (value + kCheckpointAlignment - 1) / kCheckpointAlignment * kCheckpointAlignment;
+    }
+
+    // Header and directory of the image: offsets and total size
+    void layout(CheckpointFileHeader& header, std::vector<CheckpointSectionEntry>& directory) const {
+        directory.assign(sections_.size(), CheckpointSectionEntry());
+        uint64_t offset = alignUp(sizeof(CheckpointFileHeader) +
+                                  directory.size() * sizeof(CheckpointSectionEntry));
+        for (size_t i = 0; i < sections_.size(); ++i) {
+            const Section& section = sections_[i];
+            CheckpointSectionEntry& entry = directory[i];
+            std::memset(&entry, 0, sizeof(entry));
+            std::memcpy(entry.name, section.name.data(), section.name.size());
+            entry.type = static_cast<uint32_t>(section.type);
+            entry.elem_size = static_cast<uint32_t>(section.elem_size);
+            entry.count = section.count;
+            entry.offset = offset;
+            offset = alignUp(offset + section.elem_size * section.count);
+        }
+
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kCheckpointMagic, sizeof(header.magic));
+        header.version = kCheckpointVersion;
+        header.endian_tag = kCheckpointEndianTag;
+        header.section_count = directory.size();
+        header.file_size = offset;
+    }
+
+    // Stream the image through put(data, bytes), padding included
+    template <typename Put>
+    bool emit(const CheckpointFileHeader& header, const std::vector<CheckpointSectionEntry>& directory,
+              Put&& put) const {
+        uint64_t position = 0;
+        auto append = [&](const void* data, size_t bytes) {
+            if (bytes > 0 && !put(data, bytes)) {
+                return false;
+            }
+            position += bytes;
+            return true;
+        };
+        auto pad = [&](uint64_t target) {
+            static const char zeros[kCheckpointAlignment] = {};
+            while (position < target) {
+                const size_t chunk = static_cast<size_t>(
+                    std::min<uint64_t>(target - position, sizeof(zeros)));
+                if (!append(zeros, chunk)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        bool ok = append(&header, sizeof(header)) &&
+                  append(directory.data(), directory.size() * sizeof(CheckpointSectionEntry));
+        for (size_t i = 0; ok && i < sections_.size(); ++i) {
+            const Section& section = sections_[i];
+            const void* data = section.owned_index ? owned_[section.owned_index - 1].data() : section.data;
+            ok = pad(directory[i].offset) && append(data, section.elem_size * section.count);
+        }
+        return ok && pad(header.file_size);
+    }
+
+    std::vector<Section> sections_;
+    std::vector<std::string> owned_;   // Bytes of the copied sections
+};
+
+/**
+ * Read-only mapping of a checkpoint image; every accessor validates the
+ * section against the file before handing out a pointer.
+ */
+class CheckpointImage {
+public:
+    explicit CheckpointImage(const std::string& path) {
+        map(path);
+        try {
+            validate(path);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    // Image in a buffer (CheckpointWriter::writeMemory), which must outlive it
+    explicit CheckpointImage(const CheckpointBuffer& buffer)
+        : base_(buffer.data()), size_(buffer.size()), mapped_(false) {
+        validate("<memory>");
+    }
+
+    ~CheckpointImage() { unmap(); }
+
+    CheckpointImage(const CheckpointImage&) = delete;
+    CheckpointImage& operator=(const CheckpointImage&) = delete;
+
+    bool has(const std::string& name) const { return find(name) != nullptr; }
+
+    /**
+     * Section `name` as `count` elements of `elem_size` bytes and `type`
+     * @throws std::runtime_error if it is missing or has another shape
+     */
+    const void* data(const std::string& name, CheckpointType type, size_t elem_size, size_t count) const {
+        const CheckpointSectionEntry* entry = require(name);
+        if (entry->type != static_cast<uint32_t>(type) || entry->elem_size != elem_size ||
+            entry->count != count) {
+            throw std::runtime_error("Checkpoint section '" + name + "' does not match this engine");
+        }
+        return base_ + entry->offset;
+    }
+
+    size_t count(const std::string& name) const { return static_cast<size_t>(require(name)->count); }
+
+    void readF64(const std::string& name, double* out, size_t count) const {
+        copy(data(name, CheckpointType::F64, sizeof(double), count), out, count * sizeof(double));
+    }
+    void readU64(const std::string& name, uint64_t* out, size_t count) const {
+        copy(data(name, CheckpointType::U64, sizeof(uint64_t), count), out, count * sizeof(uint64_t));
+    }
+    template <typename Record>
+    void readRecords(const std::string& name, std::vector<Record>& records) const {
+        copy(data(name, CheckpointType::Bytes, sizeof(Record), records.size()),
+             records.data(), records.size() * sizeof(Record));
+    }
+    template <typename Record>
+    Record readRecord(const std::string& name) const {
+        Record record;
+        copy(data(name, CheckpointType::Bytes, sizeof(Record), 1), &record, sizeof(Record));
+        return record;
+    }
+    std::string text(const std::string& name) const {
+        const size_t length = count(name);
+        const char* chars = static_cast<const char*>(data(name, CheckpointType::Text, 1, length));
+        return std::string(chars, length);
+    }
+    // Byte section in place (valid while the image is open)
+    const char* bytes(const std::string& name, size_t& length) const {
+        length = count(name);
+        return static_cast<const char*>(data(name, CheckpointType::Bytes, 1, length));
+    }
+
+private:
+    static void copy(const void* from, void* to, size_t bytes) {
+        if (bytes > 0) {
+            std::memcpy(to, from, bytes);
+        }
+    }
+
+    const CheckpointSectionEntry* find(const std::string& name) const {
+        for (uint64_t i = 0; i < header().section_count; ++i) {
+            const CheckpointSectionEntry& entry = directory()[i];
+            if (std::strncmp(entry.name, name.c_str(), sizeof(entry.name)) == 0) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    const CheckpointSectionEntry* require(const std::string& name) const {
+        const CheckpointSectionEntry* entry = find(name);
+        if (!entry) {
+            throw std::runtime_error("Checkpoint has no section '" + name + "'");
+        }
+        return entry;
+    }
+
+    const CheckpointFileHeader& header() const {
+        return *reinterpret_cast<const CheckpointFileHeader*>(base_);
+    }
+    const CheckpointSectionEntry* directory() const {
+        return reinterpret_cast<const CheckpointSectionEntry*>(base_ + sizeof(CheckpointFileHeader));
+    }
+
+    void validate(const std::string& path) const {
+        if (size_ < sizeof(CheckpointFileHeader) ||
+            std::memcmp(header().magic, kCheckpointMagic, sizeof(kCheckpointMagic)) != 0) {
+            throw std::runtime_error("Not a DASE checkpoint: " + path);
+        }
+        if (header().endian_tag != kCheckpointEndianTag) {
+            throw std::runtime_error("Checkpoint was written with another byte order: " + path);
+        }
+        if (header().version != kCheckpointVersion) {
+            throw std::runtime_error("Unsupported checkpoint version " + std::to_string(header().version));
+        }
+        const uint64_t sections = header().section_count;
+        if (header().file_size != size_ ||
+            sections > (size_ - sizeof(CheckpointFileHeader)) / sizeof(CheckpointSectionEntry)) {
+            throw std::runtime_error("Truncated checkpoint: " + path);
+        }
+        for (uint64_t i = 0; i < sections; ++i) {
+            const CheckpointSectionEntry& entry = directory()[i];
+            if (std::memchr(entry.name, '\0', sizeof(entry.name)) == nullptr ||
+                entry.offset % kCheckpointAlignment != 0 || entry.offset > size_ ||
+                (entry.elem_size > 0 && entry.count > (size_ - entry.offset) / entry.elem_size)) {
+                throw std::runtime_error("Corrupt checkpoint directory: " + path);
+            }
+        }
+    }
+
+    void map(const std::string& path) {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open checkpoint: " + path);
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            throw std::runtime_error("Empty checkpoint: " + path);
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+        mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping_) {
+            throw std::runtime_error("Cannot map checkpoint: " + path);
+        }
+        base_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (!base_) {
+            CloseHandle(mapping_);
+            mapping_ = nullptr;
+            throw std::runtime_error("Cannot map checkpoint: " + path);
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open checkpoint: " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            throw std::runtime_error("Empty checkpoint: " + path);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        void* base = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            throw std::runtime_error("Cannot map checkpoint: " + path);
+        }
+        ::madvise(base, size_, MADV_SEQUENTIAL);
+        base_ = static_cast<const char*>(base);
+#endif
+    }
+
+    void unmap() {
+        if (!base_ || !mapped_) {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(base_);
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        ::munmap(const_cast<char*>(base_), size_);
+#endif
+        base_ = nullptr;
+    }
+
+    const char* base_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = true;    // false: base_ is a caller's buffer
+#ifdef _WIN32
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+} // namespace dase
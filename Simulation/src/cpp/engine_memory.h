@@ -0,0 +1,50 @@
+/**
+ * Engine Memory Footprint
+ *
+ * Every engine reports what it holds (memoryFootprint()) and what a
+ * configuration will hold once it has stepped (static estimateMemory()),
+ * split into:
+ *
+ *   state    node fields and their packed mirrors (what a checkpoint holds)
+ *   caches   coupling stencils / graphs, FFT plans and buffers
+ *   history  fractional-memory history, probe and step-doubling copies
+ *   scratch  integrator stages and per-step temporaries
+ *
+ * Estimates count the buffers a default mission allocates (lazily built
+ * stages and coupling tables included), so the engine manager can refuse
+ * an engine before its constructor runs out of memory.  Optional features
+ * enabled later (probes, sparse masks, temporal blocking) show up in the
+ * measured footprint only.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dase {
+
+struct MemoryFootprint {
+    uint64_t state = 0;
+    uint64_t caches = 0;
+    uint64_t history = 0;
+    uint64_t scratch = 0;
+
+    uint64_t total() const { return state + caches + history + scratch; }
+
+    MemoryFootprint& operator+=(const MemoryFootprint& other) {
+        state += other.state;
+        caches += other.caches;
+        history += other.history;
+        scratch += other.scratch;
+        return *this;
+    }
+};
+
+// Heap bytes reserved by a vector-like container
+template <typename Container>
+inline uint64_t capacityBytes(const Container& c) {
+    return static_cast<uint64_t>(c.capacity()) * sizeof(typename Container::value_type);
+}
+
+} // namespace dase
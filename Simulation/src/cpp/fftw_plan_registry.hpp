@@ -0,0 +1,339 @@
+/**
+ * @file fftw_plan_registry.hpp
+ * @brief Process-wide FFTW plan registry
+ *
+ * FFTW's planner (and plan destruction, fftw_malloc / fftw_free and the
+ * threads setup) must not run on two threads at once; only the execute
+ * functions are thread-safe.  Every component that plans goes through
+ * this registry, which
+ *
+ * - owns one plan per FFTPlanKey (rank, extents, batch count, transform
+ *   kind and direction, in-place, input alignment, planner threads),
+ * - plans on its own scratch arrays behind plannerMutex(), so callers
+ *   execute with the new-array functions (fftw_execute_dft, _r2c, _c2r)
+ *   on their own buffers, from any thread,
+ * - initializes FFTW's threads once (DASE_FFTW_THREADS) and sets
+ *   fftw_plan_with_nthreads per plan,
+ * - loads and saves wisdom through FFTWWisdomCache.
+ *
+ * Buffers passed to a plan must match its key: same in-place-ness and
+ * fftw_alignment_of() (0 for fftw_malloc / allocReal / allocComplex
+ * arrays).  Plans live until clear() or process exit.
+ *
+ * Layout: row-major extents, slowest axis first, batches contiguous.  Real
+ * transforms use FFTW's conventions: the complex side has n_last / 2 + 1
+ * entries along the last axis, and in-place real arrays pad the last axis
+ * to 2 (n_last / 2 + 1) doubles.
+ */
+
+#ifndef FFTW_PLAN_REGISTRY_HPP
+#define FFTW_PLAN_REGISTRY_HPP
+
+#include "fftw_wisdom_cache.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+
+namespace dase {
+
+struct FFTPlanKey {
+    enum class Kind { C2C, R2C, C2R };
+
+    int rank = 1;
+    std::array<int, 3> n = {0, 0, 0};   // Extents, slowest axis first
+    int howmany = 1;                    // Contiguous batch count
+    Kind kind = Kind::C2C;
+    int sign = FFTW_FORWARD;            // C2C only (R2C forward, C2R backward)
+    bool in_place = false;
+    int alignment = 0;                  // fftw_alignment_of() of the input array
+    int nthreads = 1;
+
+    static FFTPlanKey make(Kind kind, std::initializer_list<int> extents, int sign = FFTW_FORWARD,
+                           bool in_place = false, int howmany = 1, int nthreads = 1) {
+        FFTPlanKey key;
+        key.kind = kind;
+        key.rank = static_cast<int>(extents.size());
+        std::copy(extents.begin(), extents.begin() + std::min<size_t>(extents.size(), 3), key.n.begin());
+        key.sign = kind == Kind::R2C ? FFTW_FORWARD : (kind == Kind::C2R ? FFTW_BACKWARD : sign);
+        key.in_place = in_place;
+        key.howmany = howmany;
+        key.nthreads = nthreads;
+        return key;
+    }
+
+    // Points of one transform
+    size_t points() const {
+        size_t total = 1;
+        for (int a = 0; a < rank; ++a) total *= static_cast<size_t>(n[a]);
+        return total;
+    }
+
+    // Complex entries of one transform (half spectrum for real kinds)
+    size_t complexPoints() const {
+        if (kind == Kind::C2C) return points();
+        return points() / static_cast<size_t>(n[rank - 1]) * (static_cast<size_t>(n[rank - 1]) / 2 + 1);
+    }
+
+    // Doubles of one real array (padded last axis when in place)
+    size_t realPoints() const {
+        return in_place ? 2 * complexPoints() : points();
+    }
+
+    // Wisdom file stem (FFTWWisdomCache)
+    std::string wisdomKey() const {
+        static const char* const kinds[] = {"c2c", "r2c", "c2r"};
+        std::string key = std::string("plan_") + kinds[static_cast<int>(kind)] + "_" + std::to_string(rank) + "d_";
+        for (int a = 0; a < rank; ++a) {
+            if (a > 0) key += "x";
+            key += std::to_string(n[a]);
+        }
+        if (howmany > 1) key += "_b" + std::to_string(howmany);
+        if (kind == Kind::C2C) key += sign == FFTW_FORWARD ? "_fwd" : "_bwd";
+        if (in_place) key += "_ip";
+        if (alignment != 0) key += "_a" + std::to_string(alignment);
+        if (nthreads > 1) key += "_t" + std::to_string(nthreads);
+        return key;
+    }
+
+    bool operator<(const FFTPlanKey& other) const {
+        return std::tie(rank, n, howmany, kind, sign, in_place, alignment, nthreads) <
+               std::tie(other.rank, other.n, other.howmany, other.kind, other.sign, other.in_place,
+                        other.alignment, other.nthreads);
+    }
+};
+
+class FFTPlanRegistry {
+public:
+    // Planning rigor: Auto measures once wisdom for the key exists on disk
+    enum class Planning { Auto, Estimate, Measure };
+
+    // Transforms of at least this many points plan threaded (see plannerThreads)
+    static constexpr size_t kThreadedMinSize = size_t(1) << 16;
+
+    /**
+     * Plan for key, created on first use (thread-safe)
+     *
+     * @throws std::invalid_argument for a malformed key
+     * @throws std::runtime_error if FFTW cannot plan the transform
+     */
+    static fftw_plan acquire(const FFTPlanKey& key, Planning planning = Planning::Measure) {
+        validate(key);
+        State& registry = state();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        initializeLocked(registry);
+
+        auto it = registry.plans.find(key);
+        if (it != registry.plans.end()) {
+            return it->second;
+        }
+
+        const std::string wisdom_key = key.wisdomKey();
+        unsigned flags = FFTW_ESTIMATE;
+        if (planning == Planning::Measure ||
+            (planning == Planning::Auto && FFTWWisdomCache::has_wisdom(wisdom_key))) {
+            flags = FFTW_MEASURE;
+        }
+
+        fftw_plan plan = nullptr;
+        {
+            std::lock_guard<std::mutex> planner(plannerMutex());
+            plan = planLocked(key, wisdom_key, flags);
+        }
+        if (!plan) {
+            throw std::runtime_error("FFTW could not plan " + wisdom_key);
+        }
+        registry.plans.emplace(key, plan);
+        return plan;
+    }
+
+    /**
+     * Load wisdom and start FFTW's threads now instead of on the first
+     * acquire() (CLI --warmup); a no-op once done
+     */
+    static void initialize() {
+        State& registry = state();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        initializeLocked(registry);
+    }
+
+    /**
+     * Planner threads for a transform of `points` points (1 without
+     * DASE_FFTW_THREADS or below kThreadedMinSize)
+     */
+    static int plannerThreads(size_t points) {
+#ifdef DASE_FFTW_THREADS
+        if (points >= kThreadedMinSize) {
+            return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+#else
+        (void)points;
+#endif
+        return 1;
+    }
+
+    // Serialized FFTW memory management (alignment 0)
+    static double* allocReal(size_t count) {
+        std::lock_guard<std::mutex> planner(plannerMutex());
+        return fftw_alloc_real(count);
+    }
+
+    static fftw_complex* allocComplex(size_t count) {
+        std::lock_guard<std::mutex> planner(plannerMutex());
+        return fftw_alloc_complex(count);
+    }
+
+    static void release(void* memory) {
+        if (!memory) return;
+        std::lock_guard<std::mutex> planner(plannerMutex());
+        fftw_free(memory);
+    }
+
+    /**
+     * Held by every call into FFTW other than the execute functions
+     */
+    static std::mutex& plannerMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    static size_t size() {
+        State& registry = state();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        return registry.plans.size();
+    }
+
+    /**
+     * Destroy every plan (no plan from acquire() may be executing or used
+     * afterwards)
+     */
+    static void clear() {
+        State& registry = state();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        std::lock_guard<std::mutex> planner(plannerMutex());
+        for (auto& entry : registry.plans) {
+            fftw_destroy_plan(entry.second);
+        }
+        registry.plans.clear();
+    }
+
+private:
+    struct State {
+        std::mutex mutex;   // Guards plans; taken before plannerMutex
+        std::map<FFTPlanKey, fftw_plan> plans;
+        bool initialized = false;
+
+        ~State() {
+            std::lock_guard<std::mutex> planner(plannerMutex());
+            for (auto& entry : plans) {
+                fftw_destroy_plan(entry.second);
+            }
+        }
+    };
+
+    static State& state() {
+        plannerMutex();   // Constructed first so it outlives the plans at exit
+        static State registry;
+        return registry;
+    }
+
+    static void validate(const FFTPlanKey& key) {
+        bool valid = key.rank >= 1 && key.rank <= 3 && key.howmany >= 1 && key.nthreads >= 1 &&
+                     (key.sign == FFTW_FORWARD || key.sign == FFTW_BACKWARD);
+        for (int a = 0; valid && a < key.rank; ++a) {
+            valid = key.n[a] > 0;
+        }
+        if (!valid) {
+            throw std::invalid_argument("FFT plan key needs rank 1-3, positive extents and batch count");
+        }
+    }
+
+    // Load wisdom and start FFTW's threads once; registry.mutex held
+    static void initializeLocked(State& registry) {
+        if (registry.initialized) {
+            return;
+        }
+        registry.initialized = true;
+        std::lock_guard<std::mutex> planner(plannerMutex());
+        FFTWWisdomCache::initialize();
+#ifdef DASE_FFTW_THREADS
+        fftw_init_threads();
+#endif
+    }
+
+    // Plan on scratch arrays of the key's layout; plannerMutex held
+    static fftw_plan planLocked(const FFTPlanKey& key, const std::string& wisdom_key, unsigned flags) {
+        const int rank = key.rank;
+        const int* n = key.n.data();
+        const size_t batches = static_cast<size_t>(key.howmany);
+        const size_t real_dist = key.realPoints();
+        const size_t complex_dist = key.complexPoints();
+        const size_t complex_bytes = complex_dist * batches * sizeof(fftw_complex);
+        const size_t input_bytes = key.kind == FFTPlanKey::Kind::R2C
+            ? real_dist * batches * sizeof(double) : complex_bytes;
+        const size_t output_bytes = key.kind == FFTPlanKey::Kind::C2R
+            ? real_dist * batches * sizeof(double) : complex_bytes;
+
+        // Offset the scratch input so its alignment class matches the key
+        const size_t offset = static_cast<size_t>(key.alignment);
+        char* in_base = static_cast<char*>(fftw_malloc(std::max(input_bytes, output_bytes) + offset));
+        char* out_base = key.in_place ? nullptr : static_cast<char*>(fftw_malloc(output_bytes + offset));
+        if (!in_base || (!key.in_place && !out_base)) {
+            fftw_free(in_base);
+            fftw_free(out_base);
+            return nullptr;
+        }
+        char* in = in_base + offset;
+        char* out = key.in_place ? in : out_base + offset;
+
+        // In-place real arrays pad the last axis to 2 (n_last / 2 + 1)
+        std::array<int, 3> real_embed = key.n;
+        std::array<int, 3> complex_embed = key.n;
+        if (key.kind != FFTPlanKey::Kind::C2C) {
+            complex_embed[rank - 1] = key.n[rank - 1] / 2 + 1;
+            if (key.in_place) real_embed[rank - 1] = 2 * complex_embed[rank - 1];
+        }
+
+#ifdef DASE_FFTW_THREADS
+        fftw_plan_with_nthreads(key.nthreads);
+#endif
+        fftw_plan plan = FFTWWisdomCache::create_plan_keyed(wisdom_key, flags, [&]() {
+            switch (key.kind) {
+                case FFTPlanKey::Kind::R2C:
+                    return fftw_plan_many_dft_r2c(
+                        rank, n, key.howmany,
+                        reinterpret_cast<double*>(in), real_embed.data(), 1, static_cast<int>(real_dist),
+                        reinterpret_cast<fftw_complex*>(out), complex_embed.data(), 1, static_cast<int>(complex_dist),
+                        flags);
+                case FFTPlanKey::Kind::C2R:
+                    return fftw_plan_many_dft_c2r(
+                        rank, n, key.howmany,
+                        reinterpret_cast<fftw_complex*>(in), complex_embed.data(), 1, static_cast<int>(complex_dist),
+                        reinterpret_cast<double*>(out), real_embed.data(), 1, static_cast<int>(real_dist),
+                        flags);
+                case FFTPlanKey::Kind::C2C:
+                default:
+                    return fftw_plan_many_dft(
+                        rank, n, key.howmany,
+                        reinterpret_cast<fftw_complex*>(in), nullptr, 1, static_cast<int>(complex_dist),
+                        reinterpret_cast<fftw_complex*>(out), nullptr, 1, static_cast<int>(complex_dist),
+                        key.sign, flags);
+            }
+        });
+#ifdef DASE_FFTW_THREADS
+        fftw_plan_with_nthreads(1);   // Leave direct planner calls single-threaded
+#endif
+        fftw_free(in_base);
+        fftw_free(out_base);
+        return plan;
+    }
+};
+
+} // namespace dase
+
+#endif // FFTW_PLAN_REGISTRY_HPP
@@ -26,11 +26,11 @@
 #define FFTW_WISDOM_CACHE_HPP
 
 #include <fftw3.h>
+#include <filesystem>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
-#include <sys/stat.h>
 
 namespace dase {
 
@@ -127,6 +127,77 @@ public:
         });
     }
 
+    /**
+     * Create real-to-complex plan (rank 1-3) with caching.
+     *
+     * Unlike the complex creators, wisdom is re-exported after every plan
+     * that was not FFTW_ESTIMATE, so measured wisdom replaces a file
+     * written after an estimate.
+     *
+     * @param rank Number of dimensions
+     * @param n Extents, slowest axis first
+     * @param in Real input array
+     * @param out Complex output array (n[0] * ... * (n[rank-1] / 2 + 1))
+     * @param flags Planning flags
+     * @param nthreads Threads the plan was made for (part of the key; the
+     *        caller sets fftw_plan_with_nthreads)
+     * @return FFTW plan
+     */
+    static fftw_plan create_plan_r2c(
+        int rank, const int* n,
+        double* in,
+        fftw_complex* out,
+        unsigned flags = FFTW_MEASURE,
+        int nthreads = 1
+    ) {
+        const std::string key = wisdom_key_r2c(rank, n, nthreads);
+        const std::string wisdom_file = cache_directory_ + "/" + key + ".dat";
+        const bool wisdom_loaded = import_wisdom(wisdom_file);
+        fftw_plan plan = fftw_plan_dft_r2c(rank, n, in, out, flags);
+        if (plan && (!wisdom_loaded || !(flags & FFTW_ESTIMATE))) {
+            export_wisdom(wisdom_file);
+        }
+        return plan;
+    }
+
+    /**
+     * Whether wisdom for a real-to-complex shape was saved before.
+     */
+    static bool has_wisdom_r2c(int rank, const int* n, int nthreads = 1) {
+        std::error_code ec;
+        return std::filesystem::exists(cache_directory_ + "/" + wisdom_key_r2c(rank, n, nthreads) + ".dat", ec);
+    }
+
+    /**
+     * Create a plan under a caller-supplied key with caching.
+     *
+     * Used by FFTPlanRegistry for layouts the shape creators above don't
+     * cover; wisdom is exported on the same terms as create_plan_r2c.
+     *
+     * @param key Wisdom file stem
+     * @param flags Planning flags the plan function passes to FFTW
+     * @param plan_func Function creating the plan
+     * @return FFTW plan
+     */
+    template<typename PlanFunc>
+    static fftw_plan create_plan_keyed(const std::string& key, unsigned flags, PlanFunc plan_func) {
+        const std::string wisdom_file = cache_directory_ + "/" + key + ".dat";
+        const bool wisdom_loaded = import_wisdom(wisdom_file);
+        fftw_plan plan = plan_func();
+        if (plan && (!wisdom_loaded || !(flags & FFTW_ESTIMATE))) {
+            export_wisdom(wisdom_file);
+        }
+        return plan;
+    }
+
+    /**
+     * Whether wisdom under a create_plan_keyed key was saved before.
+     */
+    static bool has_wisdom(const std::string& key) {
+        std::error_code ec;
+        return std::filesystem::exists(cache_directory_ + "/" + key + ".dat", ec);
+    }
+
     /**
      * Export wisdom to specific file.
      *
@@ -167,17 +238,14 @@ public:
     }
 
 private:
-    static std::string cache_directory_;
+    static inline std::string cache_directory_ = "./cache/fftw_wisdom";
 
     /**
      * Create cache directory if it doesn't exist.
      */
     static void create_cache_directory() {
-#ifdef _WIN32
-        _mkdir(cache_directory_.c_str());
-#else
-        mkdir(cache_directory_.c_str(), 0755);
-#endif
+        std::error_code ec;
+        std::filesystem::create_directories(cache_directory_, ec);
     }
 
     /**
@@ -186,7 +254,7 @@ private:
     static void load_global_wisdom() {
         std::string global_wisdom = cache_directory_ + "/global_wisdom.dat";
         if (import_wisdom(global_wisdom)) {
-            std::cout << "[FFTW Cache] Loaded global wisdom from: " << global_wisdom << std::endl;
+            std::cerr << "[FFTW Cache] Loaded global wisdom from: " << global_wisdom << std::endl;
         }
     }
 
@@ -196,7 +264,7 @@ private:
     static void save_global_wisdom() {
         std::string global_wisdom = cache_directory_ + "/global_wisdom.dat";
         if (export_wisdom(global_wisdom)) {
-            std::cout << "[FFTW Cache] Saved global wisdom to: " << global_wisdom << std::endl;
+            std::cerr << "[FFTW Cache] Saved global wisdom to: " << global_wisdom << std::endl;
         }
     }
 
@@ -221,6 +289,21 @@ private:
         return "fft_3d_" + std::to_string(nx) + "x" + std::to_string(ny) + "x" + std::to_string(nz);
     }
 
+    /**
+     * Generate wisdom cache key for real-to-complex transform.
+     */
+    static std::string wisdom_key_r2c(int rank, const int* n, int nthreads) {
+        std::string key = "rfft_" + std::to_string(rank) + "d_";
+        for (int i = 0; i < rank; ++i) {
+            if (i > 0) key += "x";
+            key += std::to_string(n[i]);
+        }
+        if (nthreads > 1) {
+            key += "_t" + std::to_string(nthreads);
+        }
+        return key;
+    }
+
     /**
      * Create plan with caching logic.
      *
@@ -249,18 +332,15 @@ private:
         if (plan && !wisdom_loaded) {
             // Save wisdom for future use
             export_wisdom(wisdom_file);
-            std::cout << "[FFTW Cache] Saved wisdom: " << key << std::endl;
+            std::cerr << "[FFTW Cache] Saved wisdom: " << key << std::endl;
         } else if (plan && wisdom_loaded) {
-            std::cout << "[FFTW Cache] Used cached wisdom: " << key << std::endl;
+            std::cerr << "[FFTW Cache] Used cached wisdom: " << key << std::endl;
         }
 
         return plan;
     }
 };
 
-// Static member initialization
-std::string FFTWWisdomCache::cache_directory_ = "./cache/fftw_wisdom";
-
 } // namespace dase
 
 #endif // FFTW_WISDOM_CACHE_HPP
@@ -0,0 +1,26 @@
+/**
+ * GPU device queries (gpu_device.h) for CUDA / HIP builds
+ */
+
+#include "../gpu_device.h"
+#include "gpu_runtime.h"
+
+int GpuDevice::deviceCount() noexcept {
+    int count = 0;
+    if (gpuGetDeviceCount(&count) != gpuSuccess) {
+        gpuGetLastError();  // Clear the sticky "no driver / no device" error
+        return 0;
+    }
+    return count;
+}
+
+std::string GpuDevice::deviceName() {
+    if (deviceCount() == 0) {
+        return std::string();
+    }
+    gpuDeviceProp properties;
+    if (gpuGetDeviceProperties(&properties, 0) != gpuSuccess) {
+        return std::string();
+    }
+    return properties.name;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+// ============================================================================
+// GPU RUNTIME
+// ============================================================================
+//
+// The few runtime calls the device backends use, spelled once for CUDA and
+// HIP so the kernels compile unchanged under nvcc (ENABLE_CUDA) and hipcc
+// (ENABLE_HIP).  Device code only; included by the .cu files in this
+// directory.
+
+#include <stdexcept>
+#include <string>
+
+#if defined(DASE_ENABLE_HIP)
+#include <hip/hip_runtime.h>
+#define gpuError_t hipError_t
+#define gpuSuccess hipSuccess
+#define gpuGetErrorString hipGetErrorString
+#define gpuGetLastError hipGetLastError
+#define gpuGetDeviceCount hipGetDeviceCount
+#define gpuGetDeviceProperties hipGetDeviceProperties
+#define gpuDeviceProp hipDeviceProp_t
+#define gpuMalloc hipMalloc
+#define gpuFree hipFree
+#define gpuMemcpy hipMemcpy
+#define gpuMemcpyHostToDevice hipMemcpyHostToDevice
+#define gpuMemcpyDeviceToHost hipMemcpyDeviceToHost
+#define gpuDeviceSynchronize hipDeviceSynchronize
+#else
+#include <cuda_runtime.h>
+#define gpuError_t cudaError_t
+#define gpuSuccess cudaSuccess
+#define gpuGetErrorString cudaGetErrorString
+#define gpuGetLastError cudaGetLastError
+#define gpuGetDeviceCount cudaGetDeviceCount
+#define gpuGetDeviceProperties cudaGetDeviceProperties
+#define gpuDeviceProp cudaDeviceProp
+#define gpuMalloc cudaMalloc
+#define gpuFree cudaFree
+#define gpuMemcpy cudaMemcpy
+#define gpuMemcpyHostToDevice cudaMemcpyHostToDevice
+#define gpuMemcpyDeviceToHost cudaMemcpyDeviceToHost
+#define gpuDeviceSynchronize cudaDeviceSynchronize
+#endif
+
+namespace dase {
+namespace gpu {
+
+// Threads per block for the element-wise and reduction kernels (a power
+// of two: the reductions halve it)
+constexpr int kBlockSize = 256;
+
+inline void check(gpuError_t status, const char* what) {
+    if (status != gpuSuccess) {
+        throw std::runtime_error(std::string("GPU ") + what + ": " + gpuGetErrorString(status));
+    }
+}
+
+// Blocks covering n elements
+inline unsigned int blocksFor(size_t n) {
+    return static_cast<unsigned int>((n + kBlockSize - 1) / kBlockSize);
+}
+
+/**
+ * Device array of T (allocated with gpuMalloc, freed on destruction)
+ */
+template <typename T>
+class DeviceArray {
+public:
+    DeviceArray() = default;
+    ~DeviceArray() { release(); }
+
+    DeviceArray(const DeviceArray&) = delete;
+    DeviceArray& operator=(const DeviceArray&) = delete;
+
+    void allocate(size_t n) {
+        if (n == size_) {
+            return;
+        }
+        release();
+        if (n > 0) {
+            check(gpuMalloc(reinterpret_cast<void**>(&data_), n * sizeof(T)), "allocation");
+        }
+        size_ = n;
+    }
+
+    void release() {
+        if (data_) {
+            gpuFree(data_);
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void upload(const T* host, size_t n) {
+        allocate(n);
+        if (n > 0) {
+            check(gpuMemcpy(data_, host, n * sizeof(T), gpuMemcpyHostToDevice), "upload");
+        }
+    }
+
+    void download(T* host, size_t n) const {
+        if (n > 0) {
+            check(gpuMemcpy(host, data_, n * sizeof(T), gpuMemcpyDeviceToHost), "download");
+        }
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_t size() const { return size_; }
+    size_t bytes() const { return size_ * sizeof(T); }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * Block-sum of K values per thread into partial[blockIdx.x * K + k]
+ * (blockDim.x == kBlockSize)
+ */
+template <int K>
+__device__ inline void blockSum(double (&value)[K], double* partial) {
+    __shared__ double shared[K][kBlockSize];
+    for (int k = 0; k < K; ++k) {
+        shared[k][threadIdx.x] = value[k];
+    }
+    __syncthreads();
+    for (int stride = kBlockSize / 2; stride > 0; stride >>= 1) {
+        if (threadIdx.x < stride) {
+            for (int k = 0; k < K; ++k) {
+                shared[k][threadIdx.x] += shared[k][threadIdx.x + stride];
+            }
+        }
+        __syncthreads();
+    }
+    if (threadIdx.x == 0) {
+        for (int k = 0; k < K; ++k) {
+            partial[blockIdx.x * K + k] = shared[k][0];
+        }
+    }
+}
+
+} // namespace gpu
+} // namespace dase
@@ -0,0 +1,347 @@
+/**
+ * IGSOA GPU Backend (3D) - device kernels
+ *
+ * See igsoa_gpu_backend_3d.h.  Per step:
+ *
+ *   evolveKernel    driving, Ψ coupling (Jacobi read of the Ψ buffer),
+ *                   Euler update of Ψ and Φ, F / phase / Ṡ
+ *   gradientKernel  |∇F| by central differences, then the normalization
+ *
+ * Driving is folded into evolveKernel: every neighbour read adds the step's
+ * signal, which rounds exactly as the host's separate applyDriving pass.
+ */
+
+#include "../igsoa_gpu_backend_3d.h"
+#include "gpu_runtime.h"
+
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+namespace {
+
+__device__ inline int wrapIndex(int coord, int offset, int N) {
+    int wrapped = (coord + offset) % N;
+    return wrapped < 0 ? wrapped + N : wrapped;
+}
+
+__global__ void evolveKernel(
+    const double* __restrict__ psi_re, const double* __restrict__ psi_im,
+    double* __restrict__ next_re, double* __restrict__ next_im,
+    double* __restrict__ psi_dot_re, double* __restrict__ psi_dot_im,
+    double* __restrict__ phi, double* __restrict__ phi_dot,
+    const double* __restrict__ kappa, const double* __restrict__ gamma,
+    double* __restrict__ F, double* __restrict__ phase, double* __restrict__ entropy_rate,
+    const int* __restrict__ offset_x, const int* __restrict__ offset_y, const int* __restrict__ offset_z,
+    const double* __restrict__ weight, int stencil_size,
+    int N_x, int N_y, int N_z, double dt, double R_c, double signal, double control)
+{
+    const size_t plane = static_cast<size_t>(N_x) * N_y;
+    const size_t index = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (index >= plane * N_z) {
+        return;
+    }
+    const int x = static_cast<int>(index % N_x);
+    const int y = static_cast<int>((index / N_x) % N_y);
+    const int z = static_cast<int>(index / plane);
+
+    const double self_re = psi_re[index] + signal;
+    const double self_im = psi_im[index] + control;
+    double coupling_re = 0.0;
+    double coupling_im = 0.0;
+    for (int k = 0; k < stencil_size; ++k) {
+        const size_t j = static_cast<size_t>(wrapIndex(z, offset_z[k], N_z)) * plane +
+                         static_cast<size_t>(wrapIndex(y, offset_y[k], N_y)) * N_x +
+                         static_cast<size_t>(wrapIndex(x, offset_x[k], N_x));
+        coupling_re += weight[k] * ((psi_re[j] + signal) - self_re);
+        coupling_im += weight[k] * ((psi_im[j] + control) - self_im);
+    }
+
+    // H Ψ = -𝒦[Ψ] + κΦ Ψ + iγ Ψ and Ψ̇ = -i H Ψ (ħ = 1), as IGSOAPhysics3D
+    double phi_i = phi[index] + signal;
+    const double kappa_i = kappa[index];
+    const double gamma_i = gamma[index];
+    const double V_eff = kappa_i * phi_i;
+    const double H_re = (-coupling_re + V_eff * self_re) - gamma_i * self_im;
+    const double H_im = (-coupling_im + V_eff * self_im) + gamma_i * self_re;
+    const double new_re = self_re + H_im * dt;
+    const double new_im = self_im - H_re * dt;
+    psi_dot_re[index] = H_im;
+    psi_dot_im[index] = -H_re;
+    next_re[index] = new_re;
+    next_im[index] = new_im;
+
+    // ∂Φ/∂t = -κ(Φ - Re[Ψ]) - γΦ with the updated Ψ
+    const double phi_rate = -kappa_i * (phi_i - new_re) - gamma_i * phi_i;
+    phi_i += phi_rate * dt;
+    phi[index] = phi_i;
+    phi_dot[index] = phi_rate;
+
+    // Derived quantities (before the normalization, as on the host)
+    F[index] = new_re * new_re + new_im * new_im;
+    phase[index] = atan2(new_im, new_re);
+    const double coupling_diff = phi_i - new_re;
+    entropy_rate[index] = R_c * coupling_diff * coupling_diff;
+}
+
+__global__ void gradientKernel(
+    const double* __restrict__ F, double* __restrict__ F_gradient,
+    double* __restrict__ psi_re, double* __restrict__ psi_im,
+    int N_x, int N_y, int N_z, bool normalize)
+{
+    const size_t plane = static_cast<size_t>(N_x) * N_y;
+    const size_t index = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (index >= plane * N_z) {
+        return;
+    }
+    const int x = static_cast<int>(index % N_x);
+    const int y = static_cast<int>((index / N_x) % N_y);
+    const int z = static_cast<int>(index / plane);
+    const size_t row = static_cast<size_t>(z) * plane + static_cast<size_t>(y) * N_x;
+
+    const double dF_dx = (F[row + wrapIndex(x, 1, N_x)] - F[row + wrapIndex(x, -1, N_x)]) * 0.5;
+    const double dF_dy = (F[static_cast<size_t>(z) * plane + static_cast<size_t>(wrapIndex(y, 1, N_y)) * N_x + x] -
+                          F[static_cast<size_t>(z) * plane + static_cast<size_t>(wrapIndex(y, -1, N_y)) * N_x + x]) * 0.5;
+    const double dF_dz = (F[static_cast<size_t>(wrapIndex(z, 1, N_z)) * plane + static_cast<size_t>(y) * N_x + x] -
+                          F[static_cast<size_t>(wrapIndex(z, -1, N_z)) * plane + static_cast<size_t>(y) * N_x + x]) * 0.5;
+    F_gradient[index] = sqrt(dF_dx * dF_dx + dF_dy * dF_dy + dF_dz * dF_dz);
+
+    if (normalize) {
+        const double magnitude = hypot(psi_re[index], psi_im[index]);
+        if (magnitude > 1e-15) {
+            psi_re[index] /= magnitude;
+            psi_im[index] /= magnitude;
+        }
+    }
+}
+
+// Partials per block: energy, Ṡ, ∑F, then (cos, sin) per axis
+constexpr int kTotals = 9;
+
+__global__ void totalsKernel(
+    const double* __restrict__ F, const double* __restrict__ phi, const double* __restrict__ entropy_rate,
+    int N_x, int N_y, int N_z, double* __restrict__ partial)
+{
+    const size_t plane = static_cast<size_t>(N_x) * N_y;
+    const size_t index = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    double value[kTotals] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    if (index < plane * N_z) {
+        const double coord[3] = {
+            static_cast<double>(index % N_x),
+            static_cast<double>((index / N_x) % N_y),
+            static_cast<double>(index / plane)
+        };
+        const double extent[3] = {static_cast<double>(N_x), static_cast<double>(N_y), static_cast<double>(N_z)};
+        const double F_i = F[index];
+        value[0] = F_i + phi[index] * phi[index];
+        value[1] = entropy_rate[index];
+        value[2] = F_i;
+        for (int axis = 0; axis < 3; ++axis) {
+            const double theta = 2.0 * M_PI * coord[axis] / extent[axis];
+            value[3 + 2 * axis] = F_i * cos(theta);
+            value[4 + 2 * axis] = F_i * sin(theta);
+        }
+    }
+    gpu::blockSum<kTotals>(value, partial);
+}
+
+} // namespace
+
+struct IGSOAGpuBackend3D::DeviceState {
+    size_t N_x = 0, N_y = 0, N_z = 0;
+    double R_c = 0.0;
+    int parity = 0;   // Ψ buffer holding the current state
+
+    gpu::DeviceArray<double> psi_re[2];
+    gpu::DeviceArray<double> psi_im[2];
+    gpu::DeviceArray<double> psi_dot_re, psi_dot_im;
+    gpu::DeviceArray<double> phi, phi_dot;
+    gpu::DeviceArray<double> kappa, gamma;
+    gpu::DeviceArray<double> F, phase, entropy_rate, F_gradient;
+
+    gpu::DeviceArray<int> offset_x, offset_y, offset_z;
+    gpu::DeviceArray<double> weight;
+
+    mutable gpu::DeviceArray<double> partial;   // totalsKernel output
+    mutable std::vector<double> staging;
+
+    size_t size() const { return N_x * N_y * N_z; }
+
+    template <typename Read>
+    void put(gpu::DeviceArray<double>& array, const std::vector<IGSOAComplexNode>& nodes, Read read) {
+        staging.resize(nodes.size());
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            staging[i] = read(nodes[i]);
+        }
+        array.upload(staging.data(), staging.size());
+    }
+
+    const double* get(const gpu::DeviceArray<double>& array) const {
+        staging.resize(array.size());
+        array.download(staging.data(), staging.size());
+        return staging.data();
+    }
+};
+
+IGSOAGpuBackend3D::IGSOAGpuBackend3D() = default;
+IGSOAGpuBackend3D::~IGSOAGpuBackend3D() = default;
+
+bool IGSOAGpuBackend3D::upload(const std::vector<IGSOAComplexNode>& nodes,
+                               size_t N_x, size_t N_y, size_t N_z,
+                               const NeighborStencil3D& stencil) {
+    if (!GpuDevice::isAvailable() || nodes.size() != N_x * N_y * N_z || nodes.empty()) {
+        return false;
+    }
+    if (!state_) {
+        state_ = std::make_unique<DeviceState>();
+    }
+    DeviceState& s = *state_;
+    s.N_x = N_x;
+    s.N_y = N_y;
+    s.N_z = N_z;
+    s.R_c = nodes[0].R_c;
+    s.parity = 0;
+
+    s.put(s.psi_re[0], nodes, [](const IGSOAComplexNode& n) { return n.psi.real(); });
+    s.put(s.psi_im[0], nodes, [](const IGSOAComplexNode& n) { return n.psi.imag(); });
+    s.put(s.psi_dot_re, nodes, [](const IGSOAComplexNode& n) { return n.psi_dot.real(); });
+    s.put(s.psi_dot_im, nodes, [](const IGSOAComplexNode& n) { return n.psi_dot.imag(); });
+    s.put(s.phi, nodes, [](const IGSOAComplexNode& n) { return n.phi; });
+    s.put(s.phi_dot, nodes, [](const IGSOAComplexNode& n) { return n.phi_dot; });
+    s.put(s.kappa, nodes, [](const IGSOAComplexNode& n) { return n.kappa; });
+    s.put(s.gamma, nodes, [](const IGSOAComplexNode& n) { return n.gamma; });
+    s.put(s.F, nodes, [](const IGSOAComplexNode& n) { return n.F; });
+    s.put(s.phase, nodes, [](const IGSOAComplexNode& n) { return n.phase; });
+    s.put(s.entropy_rate, nodes, [](const IGSOAComplexNode& n) { return n.entropy_rate; });
+    s.put(s.F_gradient, nodes, [](const IGSOAComplexNode& n) { return n.F_gradient; });
+    s.psi_re[1].allocate(nodes.size());
+    s.psi_im[1].allocate(nodes.size());
+
+    s.offset_x.upload(stencil.dx(), stencil.size());
+    s.offset_y.upload(stencil.dy(), stencil.size());
+    s.offset_z.upload(stencil.dz(), stencil.size());
+    s.weight.upload(stencil.weight(), stencil.size());
+    s.partial.allocate(static_cast<size_t>(gpu::blocksFor(nodes.size())) * kTotals);
+    return true;
+}
+
+uint64_t IGSOAGpuBackend3D::run(const IGSOAComplexConfig& config,
+                                uint64_t num_steps,
+                                const double* input_signals,
+                                const double* control_patterns) {
+    if (!isResident()) {
+        return 0;
+    }
+    DeviceState& s = *state_;
+    const size_t N_total = s.size();
+    const unsigned int blocks = gpu::blocksFor(N_total);
+    const int N_x = static_cast<int>(s.N_x);
+    const int N_y = static_cast<int>(s.N_y);
+    const int N_z = static_cast<int>(s.N_z);
+    const int stencil_size = static_cast<int>(s.weight.size());
+    const bool driven = input_signals && control_patterns;
+
+    for (uint64_t step = 0; step < num_steps; ++step) {
+        const int cur = s.parity;
+        evolveKernel<<<blocks, gpu::kBlockSize>>>(
+            s.psi_re[cur].data(), s.psi_im[cur].data(),
+            s.psi_re[cur ^ 1].data(), s.psi_im[cur ^ 1].data(),
+            s.psi_dot_re.data(), s.psi_dot_im.data(),
+            s.phi.data(), s.phi_dot.data(), s.kappa.data(), s.gamma.data(),
+            s.F.data(), s.phase.data(), s.entropy_rate.data(),
+            s.offset_x.data(), s.offset_y.data(), s.offset_z.data(), s.weight.data(), stencil_size,
+            N_x, N_y, N_z, config.dt, s.R_c,
+            driven ? input_signals[step] : 0.0, driven ? control_patterns[step] : 0.0);
+        gradientKernel<<<blocks, gpu::kBlockSize>>>(
+            s.F.data(), s.F_gradient.data(), s.psi_re[cur ^ 1].data(), s.psi_im[cur ^ 1].data(),
+            N_x, N_y, N_z, config.normalize_psi);
+        s.parity ^= 1;
+    }
+    gpu::check(gpuGetLastError(), "IGSOA kernel launch");
+    gpu::check(gpuDeviceSynchronize(), "IGSOA mission");
+
+    // Operations as IGSOAPhysics3D::timeStep and runMission count them
+    const uint64_t per_step = static_cast<uint64_t>(N_total) * (1 + static_cast<uint64_t>(stencil_size)) +
+                              static_cast<uint64_t>(N_total) * (config.normalize_psi ? 4 : 3) +
+                              (driven ? static_cast<uint64_t>(N_total) : 0);
+    return per_step * num_steps;
+}
+
+void IGSOAGpuBackend3D::download(std::vector<IGSOAComplexNode>& nodes) const {
+    if (!isResident() || nodes.size() != state_->size()) {
+        return;
+    }
+    const DeviceState& s = *state_;
+    const size_t n = nodes.size();
+    auto take = [&](const gpu::DeviceArray<double>& array, auto write) {
+        const double* values = s.get(array);
+        for (size_t i = 0; i < n; ++i) {
+            write(nodes[i], values[i]);
+        }
+    };
+    take(s.psi_re[s.parity], [](IGSOAComplexNode& node, double v) { node.psi.real(v); });
+    take(s.psi_im[s.parity], [](IGSOAComplexNode& node, double v) { node.psi.imag(v); });
+    take(s.psi_dot_re, [](IGSOAComplexNode& node, double v) { node.psi_dot.real(v); });
+    take(s.psi_dot_im, [](IGSOAComplexNode& node, double v) { node.psi_dot.imag(v); });
+    take(s.phi, [](IGSOAComplexNode& node, double v) { node.phi = v; });
+    take(s.phi_dot, [](IGSOAComplexNode& node, double v) { node.phi_dot = v; });
+    take(s.F, [](IGSOAComplexNode& node, double v) { node.F = v; node.T_IGS = v; });
+    take(s.phase, [](IGSOAComplexNode& node, double v) { node.phase = v; });
+    take(s.entropy_rate, [](IGSOAComplexNode& node, double v) { node.entropy_rate = v; });
+    take(s.F_gradient, [](IGSOAComplexNode& node, double v) { node.F_gradient = v; });
+}
+
+IGSOADeviceTotals IGSOAGpuBackend3D::reduce() const {
+    IGSOADeviceTotals totals;
+    if (!isResident()) {
+        return totals;
+    }
+    const DeviceState& s = *state_;
+    const unsigned int blocks = gpu::blocksFor(s.size());
+    totalsKernel<<<blocks, gpu::kBlockSize>>>(
+        s.F.data(), s.phi.data(), s.entropy_rate.data(),
+        static_cast<int>(s.N_x), static_cast<int>(s.N_y), static_cast<int>(s.N_z),
+        s.partial.data());
+    gpu::check(gpuGetLastError(), "IGSOA reduction launch");
+
+    const double* partial = s.get(s.partial);
+    for (unsigned int b = 0; b < blocks; ++b) {
+        const double* block = partial + static_cast<size_t>(b) * kTotals;
+        totals.energy += block[0];
+        totals.entropy_rate += block[1];
+        totals.sum_F += block[2];
+        for (int axis = 0; axis < 3; ++axis) {
+            totals.sum_cos[axis] += block[3 + 2 * axis];
+            totals.sum_sin[axis] += block[4 + 2 * axis];
+        }
+    }
+    return totals;
+}
+
+bool IGSOAGpuBackend3D::isResident() const {
+    return state_ && state_->size() > 0;
+}
+
+void IGSOAGpuBackend3D::release() {
+    state_.reset();
+}
+
+size_t IGSOAGpuBackend3D::memoryBytes() const {
+    if (!state_) {
+        return 0;
+    }
+    const DeviceState& s = *state_;
+    size_t bytes = s.psi_dot_re.bytes() + s.psi_dot_im.bytes() + s.phi.bytes() + s.phi_dot.bytes() +
+                   s.kappa.bytes() + s.gamma.bytes() + s.F.bytes() + s.phase.bytes() +
+                   s.entropy_rate.bytes() + s.F_gradient.bytes() +
+                   s.offset_x.bytes() + s.offset_y.bytes() + s.offset_z.bytes() + s.weight.bytes() +
+                   s.partial.bytes();
+    for (int b = 0; b < 2; ++b) {
+        bytes += s.psi_re[b].bytes() + s.psi_im[b].bytes();
+    }
+    return bytes;
+}
+
+} // namespace igsoa
+} // namespace dase
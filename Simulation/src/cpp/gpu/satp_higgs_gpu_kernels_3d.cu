@@ -0,0 +1,330 @@
+/**
+ * SATP+Higgs GPU Backend (3D) - device kernels
+ *
+ * See satp_higgs_gpu_backend_3d.h.  Per step:
+ *
+ *   driftKernel  x(t+dt) = x + v dt + ½ a dt², v += ½ a dt (cell-local)
+ *   forceKernel  a(t+dt) from the 7-point Laplacian of the drifted fields;
+ *                with `kick`, v(t+dt) = v + ½ a(t+dt) dt and the damping is
+ *                carried to v(t+dt) (SATPHiggsEngine3D::evolve, steps 3-4)
+ *
+ * forceKernel without `kick` is the a(t) evaluation at the start of a call.
+ * Only positions of neighbours are read, so both kernels update in place.
+ */
+
+#include "../satp_higgs_gpu_backend_3d.h"
+#include "gpu_runtime.h"
+
+#include <vector>
+
+namespace dase {
+namespace satp_higgs {
+
+namespace {
+
+struct ForceParams {
+    double c_sq;
+    double dx_sq;
+    double gamma_phi;
+    double gamma_h;
+    double lambda;
+    double mu_sq;
+    double lambda_h;
+};
+
+__device__ inline size_t cellIndex(int x, int y, int z, int N_x, int N_y) {
+    return (static_cast<size_t>(z) * N_y + y) * N_x + x;
+}
+
+__global__ void driftKernel(
+    double* __restrict__ phi, double* __restrict__ phi_dot,
+    double* __restrict__ h, double* __restrict__ h_dot,
+    const double* __restrict__ phi_accel, const double* __restrict__ h_accel,
+    size_t N_total, double dt)
+{
+    const size_t i = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (i >= N_total) {
+        return;
+    }
+    phi[i] = phi[i] + phi_dot[i] * dt + 0.5 * phi_accel[i] * dt * dt;
+    h[i] = h[i] + h_dot[i] * dt + 0.5 * h_accel[i] * dt * dt;
+    phi_dot[i] = phi_dot[i] + 0.5 * phi_accel[i] * dt;
+    h_dot[i] = h_dot[i] + 0.5 * h_accel[i] * dt;
+}
+
+__global__ void forceKernel(
+    const double* __restrict__ phi, double* __restrict__ phi_dot,
+    const double* __restrict__ h, double* __restrict__ h_dot,
+    double* __restrict__ phi_accel, double* __restrict__ h_accel,
+    const double* __restrict__ source_profile, double source_gain,
+    int N_x, int N_y, int N_z, ForceParams p, double dt, bool kick)
+{
+    const size_t plane = static_cast<size_t>(N_x) * N_y;
+    const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (idx >= plane * N_z) {
+        return;
+    }
+    const int x = static_cast<int>(idx % N_x);
+    const int y = static_cast<int>((idx / N_x) % N_y);
+    const int z = static_cast<int>(idx / plane);
+    const int x_prev = (x == 0) ? N_x - 1 : x - 1;
+    const int x_next = (x + 1 == N_x) ? 0 : x + 1;
+    const int y_prev = (y == 0) ? N_y - 1 : y - 1;
+    const int y_next = (y + 1 == N_y) ? 0 : y + 1;
+    const int z_prev = (z == 0) ? N_z - 1 : z - 1;
+    const int z_next = (z + 1 == N_z) ? 0 : z + 1;
+    const size_t n[6] = {
+        cellIndex(x_prev, y, z, N_x, N_y), cellIndex(x_next, y, z, N_x, N_y),
+        cellIndex(x, y_prev, z, N_x, N_y), cellIndex(x, y_next, z, N_x, N_y),
+        cellIndex(x, y, z_prev, N_x, N_y), cellIndex(x, y, z_next, N_x, N_y)
+    };
+
+    const double phi_i = phi[idx];
+    const double h_i = h[idx];
+    const double laplacian_phi = (phi[n[0]] + phi[n[1]] + phi[n[2]] + phi[n[3]] +
+                                  phi[n[4]] + phi[n[5]] - 6.0 * phi_i) / p.dx_sq;
+    const double laplacian_h = (h[n[0]] + h[n[1]] + h[n[2]] + h[n[3]] +
+                                h[n[4]] + h[n[5]] - 6.0 * h_i) / p.dx_sq;
+    const double source_term = source_profile ? source_gain * source_profile[idx] : 0.0;
+
+    const double a_phi = p.c_sq * laplacian_phi
+                       - p.gamma_phi * phi_dot[idx]
+                       - 2.0 * p.lambda * phi_i * h_i * h_i
+                       + source_term;
+    const double a_h = p.c_sq * laplacian_h
+                     - p.gamma_h * h_dot[idx]
+                     - 2.0 * p.mu_sq * h_i
+                     - 4.0 * p.lambda_h * h_i * h_i * h_i
+                     - 2.0 * p.lambda * phi_i * phi_i * h_i;
+
+    if (!kick) {
+        phi_accel[idx] = a_phi;
+        h_accel[idx] = a_h;
+        return;
+    }
+    const double phi_kick = 0.5 * a_phi * dt;
+    const double h_kick = 0.5 * a_h * dt;
+    phi_dot[idx] = phi_dot[idx] + phi_kick;
+    h_dot[idx] = h_dot[idx] + h_kick;
+    phi_accel[idx] = a_phi - p.gamma_phi * phi_kick;
+    h_accel[idx] = a_h - p.gamma_h * h_kick;
+}
+
+// Partials per block: energy, ∑φ², ∑(h - h_vev)², ∑|φ|, then (cos, sin) per axis
+constexpr int kTotals = 10;
+
+__global__ void totalsKernel(
+    const double* __restrict__ phi, const double* __restrict__ phi_dot,
+    const double* __restrict__ h, const double* __restrict__ h_dot,
+    int N_x, int N_y, int N_z, double dx, double c, double mu_sq, double lambda_h,
+    double lambda, double h_vev, double* __restrict__ partial)
+{
+    const size_t plane = static_cast<size_t>(N_x) * N_y;
+    const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    double value[kTotals] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    if (idx < plane * N_z) {
+        const int x = static_cast<int>(idx % N_x);
+        const int y = static_cast<int>((idx / N_x) % N_y);
+        const int z = static_cast<int>(idx / plane);
+        const size_t idx_xnext = cellIndex((x + 1) % N_x, y, z, N_x, N_y);
+        const size_t idx_ynext = cellIndex(x, (y + 1) % N_y, z, N_x, N_y);
+        const size_t idx_znext = cellIndex(x, y, (z + 1) % N_z, N_x, N_y);
+
+        // Energy density as computeTotalEnergy: kinetic, gradient, potentials
+        const double phi_i = phi[idx];
+        const double h_i = h[idx];
+        const double E_kin = 0.5 * (phi_dot[idx] * phi_dot[idx] + h_dot[idx] * h_dot[idx]);
+        const double dphi_dx = (phi[idx_xnext] - phi_i) / dx;
+        const double dphi_dy = (phi[idx_ynext] - phi_i) / dx;
+        const double dphi_dz = (phi[idx_znext] - phi_i) / dx;
+        const double dh_dx = (h[idx_xnext] - h_i) / dx;
+        const double dh_dy = (h[idx_ynext] - h_i) / dx;
+        const double dh_dz = (h[idx_znext] - h_i) / dx;
+        const double E_grad = 0.5 * c * c * (
+            dphi_dx * dphi_dx + dphi_dy * dphi_dy + dphi_dz * dphi_dz +
+            dh_dx * dh_dx + dh_dy * dh_dy + dh_dz * dh_dz);
+        const double V_higgs = mu_sq * h_i * h_i + lambda_h * h_i * h_i * h_i * h_i;
+        const double V_coupling = lambda * phi_i * phi_i * h_i * h_i;
+        value[0] = (E_kin + E_grad + V_higgs + V_coupling) * (dx * dx * dx);
+
+        value[1] = phi_i * phi_i;
+        const double h_deviation = h_i - h_vev;
+        value[2] = h_deviation * h_deviation;
+
+        const double weight = fabs(phi_i);
+        const double coord[3] = {static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)};
+        const double extent[3] = {static_cast<double>(N_x), static_cast<double>(N_y), static_cast<double>(N_z)};
+        value[3] = weight;
+        for (int axis = 0; axis < 3; ++axis) {
+            const double theta = 2.0 * M_PI * coord[axis] / extent[axis];
+            value[4 + 2 * axis] = weight * cos(theta);
+            value[5 + 2 * axis] = weight * sin(theta);
+        }
+    }
+    gpu::blockSum<kTotals>(value, partial);
+}
+
+} // namespace
+
+struct SATPHiggsGpuBackend3D::DeviceState {
+    size_t N_x = 0, N_y = 0, N_z = 0;
+    gpu::DeviceArray<double> phi, phi_dot, h, h_dot;
+    gpu::DeviceArray<double> phi_accel, h_accel;
+    gpu::DeviceArray<double> source_profile;   // Empty without a Separable source
+    mutable gpu::DeviceArray<double> partial;  // totalsKernel output
+    mutable std::vector<double> staging;
+
+    size_t size() const { return N_x * N_y * N_z; }
+};
+
+SATPHiggsGpuBackend3D::SATPHiggsGpuBackend3D() = default;
+SATPHiggsGpuBackend3D::~SATPHiggsGpuBackend3D() = default;
+
+bool SATPHiggsGpuBackend3D::upload(const std::vector<SATPHiggsNode>& nodes,
+                                   size_t N_x, size_t N_y, size_t N_z,
+                                   const double* source_profile) {
+    if (!GpuDevice::isAvailable() || nodes.size() != N_x * N_y * N_z || nodes.empty()) {
+        return false;
+    }
+    if (!state_) {
+        state_ = std::make_unique<DeviceState>();
+    }
+    DeviceState& s = *state_;
+    s.N_x = N_x;
+    s.N_y = N_y;
+    s.N_z = N_z;
+    const size_t n = nodes.size();
+
+    auto put = [&](gpu::DeviceArray<double>& array, double SATPHiggsNode::*field) {
+        s.staging.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            s.staging[i] = nodes[i].*field;
+        }
+        array.upload(s.staging.data(), n);
+    };
+    put(s.phi, &SATPHiggsNode::phi);
+    put(s.phi_dot, &SATPHiggsNode::phi_dot);
+    put(s.h, &SATPHiggsNode::h);
+    put(s.h_dot, &SATPHiggsNode::h_dot);
+    s.phi_accel.allocate(n);
+    s.h_accel.allocate(n);
+    if (source_profile) {
+        s.source_profile.upload(source_profile, n);
+    } else {
+        s.source_profile.release();
+    }
+    s.partial.allocate(static_cast<size_t>(gpu::blocksFor(n)) * kTotals);
+    return true;
+}
+
+void SATPHiggsGpuBackend3D::run(const SATPHiggsParams& params, double dx, double dt, double& current_time,
+                                size_t num_steps, const SATPSourceEnvelope& envelope) {
+    if (!isResident() || num_steps == 0) {
+        return;
+    }
+    DeviceState& s = *state_;
+    const size_t N_total = s.size();
+    const unsigned int blocks = gpu::blocksFor(N_total);
+    const int N_x = static_cast<int>(s.N_x);
+    const int N_y = static_cast<int>(s.N_y);
+    const int N_z = static_cast<int>(s.N_z);
+    const double* profile = s.source_profile.size() == N_total ? s.source_profile.data() : nullptr;
+
+    ForceParams p;
+    p.c_sq = params.c * params.c;
+    p.dx_sq = dx * dx;
+    p.gamma_phi = params.gamma_phi;
+    p.gamma_h = params.gamma_h;
+    p.lambda = params.lambda;
+    p.mu_sq = params.mu_squared;
+    p.lambda_h = params.lambda_h;
+
+    // a(t), once per call as on the host
+    forceKernel<<<blocks, gpu::kBlockSize>>>(
+        s.phi.data(), s.phi_dot.data(), s.h.data(), s.h_dot.data(), s.phi_accel.data(), s.h_accel.data(),
+        profile, profile ? envelope(current_time) : 0.0, N_x, N_y, N_z, p, dt, false);
+
+    for (size_t step = 0; step < num_steps; ++step) {
+        driftKernel<<<blocks, gpu::kBlockSize>>>(
+            s.phi.data(), s.phi_dot.data(), s.h.data(), s.h_dot.data(),
+            s.phi_accel.data(), s.h_accel.data(), N_total, dt);
+        forceKernel<<<blocks, gpu::kBlockSize>>>(
+            s.phi.data(), s.phi_dot.data(), s.h.data(), s.h_dot.data(), s.phi_accel.data(), s.h_accel.data(),
+            profile, profile ? envelope(current_time + dt) : 0.0, N_x, N_y, N_z, p, dt, true);
+        current_time += dt;
+    }
+    gpu::check(gpuGetLastError(), "SATP kernel launch");
+    gpu::check(gpuDeviceSynchronize(), "SATP evolve");
+}
+
+void SATPHiggsGpuBackend3D::download(std::vector<SATPHiggsNode>& nodes) const {
+    if (!isResident() || nodes.size() != state_->size()) {
+        return;
+    }
+    const DeviceState& s = *state_;
+    const size_t n = nodes.size();
+    auto take = [&](const gpu::DeviceArray<double>& array, double SATPHiggsNode::*field) {
+        s.staging.resize(n);
+        array.download(s.staging.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            nodes[i].*field = s.staging[i];
+        }
+    };
+    take(s.phi, &SATPHiggsNode::phi);
+    take(s.phi_dot, &SATPHiggsNode::phi_dot);
+    take(s.h, &SATPHiggsNode::h);
+    take(s.h_dot, &SATPHiggsNode::h_dot);
+    for (auto& node : nodes) {
+        node.updateDerived();
+    }
+}
+
+SATPDeviceTotals SATPHiggsGpuBackend3D::reduce(const SATPHiggsParams& params, double dx) const {
+    SATPDeviceTotals totals;
+    if (!isResident()) {
+        return totals;
+    }
+    const DeviceState& s = *state_;
+    const unsigned int blocks = gpu::blocksFor(s.size());
+    totalsKernel<<<blocks, gpu::kBlockSize>>>(
+        s.phi.data(), s.phi_dot.data(), s.h.data(), s.h_dot.data(),
+        static_cast<int>(s.N_x), static_cast<int>(s.N_y), static_cast<int>(s.N_z),
+        dx, params.c, params.mu_squared, params.lambda_h, params.lambda, params.h_vev,
+        s.partial.data());
+    gpu::check(gpuGetLastError(), "SATP reduction launch");
+
+    s.staging.resize(s.partial.size());
+    s.partial.download(s.staging.data(), s.staging.size());
+    for (unsigned int b = 0; b < blocks; ++b) {
+        const double* block = s.staging.data() + static_cast<size_t>(b) * kTotals;
+        totals.energy += block[0];
+        totals.phi_sq += block[1];
+        totals.h_deviation_sq += block[2];
+        totals.weight += block[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            totals.sum_cos[axis] += block[4 + 2 * axis];
+            totals.sum_sin[axis] += block[5 + 2 * axis];
+        }
+    }
+    return totals;
+}
+
+bool SATPHiggsGpuBackend3D::isResident() const {
+    return state_ && state_->size() > 0;
+}
+
+void SATPHiggsGpuBackend3D::release() {
+    state_.reset();
+}
+
+size_t SATPHiggsGpuBackend3D::memoryBytes() const {
+    if (!state_) {
+        return 0;
+    }
+    const DeviceState& s = *state_;
+    return s.phi.bytes() + s.phi_dot.bytes() + s.h.bytes() + s.h_dot.bytes() +
+           s.phi_accel.bytes() + s.h_accel.bytes() + s.source_profile.bytes() + s.partial.bytes();
+}
+
+} // namespace satp_higgs
+} // namespace dase
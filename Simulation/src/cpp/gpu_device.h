@@ -0,0 +1,77 @@
+#pragma once
+
+// ============================================================================
+// GPU DEVICE
+// ============================================================================
+//
+// Compute-device selection shared by the GPU-capable engines
+// (IGSOAComplexEngine3D, SATPHiggsEngine3D).  The device backends live in
+// src/cpp/gpu/ and are built into the dase_gpu library when CMake is
+// configured with ENABLE_CUDA or ENABLE_HIP, which defines DASE_ENABLE_CUDA
+// or DASE_ENABLE_HIP (and so DASE_ENABLE_GPU) for every target linking it.
+//
+// Without a GPU build deviceCount() is 0, the engines refuse
+// ComputeDevice::GPU and everything runs on the host as before.
+
+#include <string>
+
+#if defined(DASE_ENABLE_CUDA) || defined(DASE_ENABLE_HIP)
+#define DASE_ENABLE_GPU 1
+#endif
+
+// Where an engine keeps its state and runs its steps (values are stable:
+// they are reported through the CLI)
+enum class ComputeDevice : int {
+    CPU = 0,
+    GPU = 1    // CUDA or HIP device 0, state resident across missions
+};
+
+struct GpuDevice {
+    // True if this build has a device backend
+    static constexpr bool isCompiled() noexcept {
+#ifdef DASE_ENABLE_GPU
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static constexpr const char* runtimeName() noexcept {
+#if defined(DASE_ENABLE_CUDA)
+        return "cuda";
+#elif defined(DASE_ENABLE_HIP)
+        return "hip";
+#else
+        return "none";
+#endif
+    }
+
+#ifdef DASE_ENABLE_GPU
+    // Visible devices (0 if the driver has none); gpu/gpu_runtime.cu
+    static int deviceCount() noexcept;
+
+    // Name of the device the engines use, or "" if there is none
+    static std::string deviceName();
+#else
+    static int deviceCount() noexcept { return 0; }
+    static std::string deviceName() { return std::string(); }
+#endif
+
+    static bool isAvailable() noexcept { return deviceCount() > 0; }
+
+    static bool parse(const std::string& name, ComputeDevice& out) noexcept {
+        if (name == "cpu") {
+            out = ComputeDevice::CPU;
+            return true;
+        }
+        if (name == "gpu" || name == "cuda" || name == "hip") {
+            out = ComputeDevice::GPU;
+            return true;
+        }
+        return false;
+    }
+
+    static const char* name(ComputeDevice device) noexcept {
+        return device == ComputeDevice::GPU ? "gpu" : "cpu";
+    }
+};
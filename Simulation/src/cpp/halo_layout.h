@@ -0,0 +1,136 @@
+/**
+ * Ghost-Cell Padded Lattice Layout
+ *
+ * Stores a periodic N_x × N_y × N_z lattice row-major (x-fastest) inside a
+ * larger array with g_x / g_y / g_z ghost cells on both sides of each axis:
+ *
+ *   slot(x, y, z) = ((z + g_z) · P_y + (y + g_y)) · P_x + (x + g_x)
+ *   P_x = N_x + 2 g_x,  P_y = N_y + 2 g_y
+ *
+ * valid for -g ≤ x < N + g on every axis.  refreshHalo() copies the
+ * periodic image of the lattice into the ghost cells, after which a stencil
+ * of reach ≤ g reads every neighbour of an interior cell at a constant
+ * offset (±1, ±strideY(), ±strideZ()) with no wrap arithmetic; only the
+ * halo copy itself resolves the wrap, once per ghost cell.
+ *
+ * Ghosts are filled x first, then whole padded rows in y, then whole padded
+ * planes in z, so edge and corner ghosts are exact as well (stencils with
+ * diagonal reach).  A width larger than its extent wraps several times.
+ * Like BrickLayout3D, the layout only maps indices: engines gather into /
+ * scatter out of a padded mirror through forEachRow().  A decomposed
+ * lattice would fill the same ghost slots from its neighbours instead.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace dase {
+
+class HaloLayout3D {
+public:
+    HaloLayout3D() = default;
+
+    HaloLayout3D(size_t N_x, size_t N_y, size_t N_z,
+                 size_t ghost_x, size_t ghost_y, size_t ghost_z)
+        : N_x_(N_x), N_y_(N_y), N_z_(N_z),
+          ghost_x_(ghost_x), ghost_y_(ghost_y), ghost_z_(ghost_z),
+          padded_x_(N_x + 2 * ghost_x), padded_y_(N_y + 2 * ghost_y), padded_z_(N_z + 2 * ghost_z) {}
+
+    size_t ghostX() const { return ghost_x_; }
+    size_t ghostY() const { return ghost_y_; }
+    size_t ghostZ() const { return ghost_z_; }
+
+    // Slot distance between y / z neighbours
+    size_t strideY() const { return padded_x_; }
+    size_t strideZ() const { return padded_x_ * padded_y_; }
+
+    // Slots held by the layout, ghosts included
+    size_t storageSize() const { return padded_x_ * padded_y_ * padded_z_; }
+
+    // Storage slot of logical (x, y, z) in the interior
+    size_t index(size_t x, size_t y, size_t z) const {
+        return ((z + ghost_z_) * padded_y_ + (y + ghost_y_)) * padded_x_ + (x + ghost_x_);
+    }
+
+    /**
+     * row(logical, slot, length) for every x-row of the interior, in
+     * logical order (same contract as BrickLayout3D::forEachRow)
+     */
+    template <typename Row>
+    void forEachRow(Row&& row) const {
+        for (size_t z = 0; z < N_z_; ++z) {
+            for (size_t y = 0; y < N_y_; ++y) {
+                row((z * N_y_ + y) * N_x_, index(0, y, z), N_x_);
+            }
+        }
+    }
+
+    /**
+     * Fill the ghost cells of `field` (storageSize() slots) from the
+     * interior.  Orphaned worksharing: split across the team when called
+     * inside a parallel region, serial otherwise.
+     */
+    template <typename T>
+    void refreshHalo(T* field) const {
+        if (N_x_ == 0 || N_y_ == 0 || N_z_ == 0) return;
+
+        // x ghosts of every interior row
+        if (ghost_x_ > 0) {
+            const int64_t rows = static_cast<int64_t>(N_y_ * N_z_);
+            #pragma omp for schedule(static)
+            for (int64_t r = 0; r < rows; ++r) {
+                T* row = field + index(0, static_cast<size_t>(r) % N_y_, static_cast<size_t>(r) / N_y_);
+                for (size_t k = 1; k <= ghost_x_; ++k) {
+                    row[-static_cast<ptrdiff_t>(k)] = row[wrap(N_x_ - k % N_x_, N_x_)];
+                    row[N_x_ - 1 + k] = row[wrap(k - 1, N_x_)];
+                }
+            }
+        }
+
+        // y ghost rows (padded width) of every interior plane
+        if (ghost_y_ > 0) {
+            const int64_t rows = static_cast<int64_t>(2 * ghost_y_ * N_z_);
+            #pragma omp for schedule(static)
+            for (int64_t r = 0; r < rows; ++r) {
+                const size_t z = static_cast<size_t>(r) / (2 * ghost_y_);
+                const size_t g = static_cast<size_t>(r) % (2 * ghost_y_);
+                // Padded row g < ghost_y sits below the lattice, the rest above
+                const size_t dst = g < ghost_y_ ? g : N_y_ + g;
+                const size_t src = ghost_y_ + wrap(dst + N_y_ * ghost_y_ - ghost_y_, N_y_);
+                const size_t plane = (z + ghost_z_) * padded_y_;
+                std::copy_n(field + (plane + src) * padded_x_, padded_x_, field + (plane + dst) * padded_x_);
+            }
+        }
+
+        // z ghost planes (padded size)
+        if (ghost_z_ > 0) {
+            const int64_t planes = static_cast<int64_t>(2 * ghost_z_);
+            const size_t plane_size = strideZ();
+            #pragma omp for schedule(static)
+            for (int64_t p = 0; p < planes; ++p) {
+                const size_t g = static_cast<size_t>(p);
+                const size_t dst = g < ghost_z_ ? g : N_z_ + g;
+                const size_t src = ghost_z_ + wrap(dst + N_z_ * ghost_z_ - ghost_z_, N_z_);
+                std::copy_n(field + src * plane_size, plane_size, field + dst * plane_size);
+            }
+        }
+    }
+
+private:
+    static size_t wrap(size_t i, size_t n) { return i % n; }
+
+    size_t N_x_ = 0;
+    size_t N_y_ = 0;
+    size_t N_z_ = 0;
+    size_t ghost_x_ = 0;
+    size_t ghost_y_ = 0;
+    size_t ghost_z_ = 0;
+    size_t padded_x_ = 0;
+    size_t padded_y_ = 0;
+    size_t padded_z_ = 0;
+};
+
+} // namespace dase
@@ -0,0 +1,169 @@
+#pragma once
+
+// ============================================================================
+// HARDWARE COUNTERS
+// ============================================================================
+//
+// Optional cycle / instruction / last-level-cache-miss counts around the DASE
+// mission kernels, so a run can be classified as compute- or memory-bound
+// instead of inferring it from wall time and hand-counted operations.
+//
+// Linux only (perf_event_open).  Counters are per thread, so open() opens
+// one event group on every thread of the OpenMP team (omp_get_max_threads()
+// threads, the team size the missions use) and stop() sums the groups.
+// Threads created after open() are not counted.  User-space events only,
+// which perf_event_paranoid <= 2 permits for the calling process.  Elsewhere
+// open() reports failure.
+
+#include <cstdint>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+struct HardwareCounterSample {
+    bool valid = false;
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t llc_misses = 0;   // PERF_COUNT_HW_CACHE_MISSES (last-level cache)
+};
+
+class HardwareCounters {
+public:
+    HardwareCounters() = default;
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+    ~HardwareCounters() { close(); }
+
+    /**
+     * Open the counter groups for the OpenMP team
+     * @return false if any thread's group could not be opened (nothing is kept open)
+     */
+    bool open() {
+        close();
+#ifdef __linux__
+        int team = 1;
+#ifdef _OPENMP
+        team = omp_get_max_threads();
+#endif
+        std::vector<Group> groups(static_cast<size_t>(team));
+        bool ok = true;
+        #pragma omp parallel num_threads(team) reduction(&&:ok)
+        {
+            int tid = 0;
+#ifdef _OPENMP
+            tid = omp_get_thread_num();
+#endif
+            ok = openGroup(groups[static_cast<size_t>(tid)]);
+        }
+        groups_.swap(groups);
+        if (!ok) {
+            close();
+            return false;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool isOpen() const noexcept { return !groups_.empty(); }
+
+    // Zero and start every group
+    void start() noexcept {
+#ifdef __linux__
+        for (const Group& group : groups_) {
+            ioctl(group.leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(group.leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    // Stop every group and sum them, scaled up if the PMU was multiplexed
+    HardwareCounterSample stop() noexcept {
+        HardwareCounterSample sample;
+#ifdef __linux__
+        if (groups_.empty()) {
+            return sample;
+        }
+        sample.valid = true;
+        for (const Group& group : groups_) {
+            ioctl(group.leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+            // PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING layout
+            std::uint64_t data[3 + kEventsPerGroup] = {};
+            if (read(group.leader, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) ||
+                data[0] != kEventsPerGroup) {
+                sample.valid = false;
+                continue;
+            }
+            const std::uint64_t enabled = data[1];
+            const std::uint64_t running = data[2];
+            const double scale = (running > 0 && running < enabled)
+                ? static_cast<double>(enabled) / static_cast<double>(running) : 1.0;
+            sample.cycles += static_cast<std::uint64_t>(static_cast<double>(data[3]) * scale);
+            sample.instructions += static_cast<std::uint64_t>(static_cast<double>(data[4]) * scale);
+            sample.llc_misses += static_cast<std::uint64_t>(static_cast<double>(data[5]) * scale);
+        }
+#endif
+        return sample;
+    }
+
+    void close() noexcept {
+#ifdef __linux__
+        for (const Group& group : groups_) {
+            for (int fd : {group.llc_misses, group.instructions, group.leader}) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+        }
+#endif
+        groups_.clear();
+    }
+
+private:
+    static constexpr std::uint64_t kEventsPerGroup = 3;
+
+    struct Group {
+        int leader = -1;        // Cycles
+        int instructions = -1;
+        int llc_misses = -1;
+    };
+
+    std::vector<Group> groups_;
+
+#ifdef __linux__
+    // Counts the calling thread on any CPU
+    static int openEvent(std::uint64_t config, int group_fd) noexcept {
+        perf_event_attr attr = {};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = (group_fd == -1) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0UL));
+    }
+
+    static bool openGroup(Group& group) noexcept {
+        group.leader = openEvent(PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (group.leader < 0) {
+            return false;
+        }
+        group.instructions = openEvent(PERF_COUNT_HW_INSTRUCTIONS, group.leader);
+        group.llc_misses = openEvent(PERF_COUNT_HW_CACHE_MISSES, group.leader);
+        return group.instructions >= 0 && group.llc_misses >= 0;
+    }
+#endif
+};
@@ -0,0 +1,175 @@
+/**
+ * IGSOA Activity Mask (sparse 2D/3D evolution)
+ *
+ * Opt-in (config.sparse_threshold > 0) block mask for lattices where most
+ * nodes sit at |Ψ| ≈ 0, e.g. a localized IGSOAStateInit2D/3D packet.  Before
+ * each Euler step the lattice is tiled into sparse_block^d blocks:
+ *
+ *   1. a block is hot if any node has |Ψ| or |Φ| at/above the threshold
+ *   2. the hot set is dilated (periodically) by the coupling reach
+ *      ceil(max R_c), so every node whose R_c sphere touches a hot node is
+ *      active
+ *   3. the Ψ update skips the nodes of inactive blocks (Ψ kept, Ψ̇ = 0)
+ *
+ * A skipped node and all its neighbours are below the threshold, so the
+ * skipped update is O(threshold · dt) per step.  Φ, the derived fields and
+ * the gradients stay dense (a few operations per node against the
+ * coupling sum's one per neighbour).  RK stages ignore the mask, and so do
+ * normalize_psi lattices: per-node normalization lifts any sub-threshold
+ * amplitude to |Ψ| = 1.
+ *
+ * The dilation is a box over blocks (a superset of the sphere); a partial
+ * last block per axis adds one block of reach across the periodic wrap.
+ */
+
+#pragma once
+
+#include "igsoa_complex_node.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+class IGSOAActivityMask {
+public:
+    static bool enabled(const IGSOAComplexConfig& config) {
+        return config.sparse_threshold > 0.0 && config.integrator == IGSOAIntegrator::Euler &&
+               !config.normalize_psi;
+    }
+
+    /**
+     * Rebuild the mask from the current state (call outside a parallel
+     * region) and add this step to the skip counters
+     */
+    void update(const std::vector<IGSOAComplexNode>& nodes,
+                size_t N_x, size_t N_y, size_t N_z,
+                const IGSOAComplexConfig& config) {
+        block_ = std::max<size_t>(config.sparse_block, 1);
+        blocks_[0] = (N_x + block_ - 1) / block_;
+        blocks_[1] = (N_y + block_ - 1) / block_;
+        blocks_[2] = (N_z + block_ - 1) / block_;
+        const size_t num_blocks = blocks_[0] * blocks_[1] * blocks_[2];
+        hot_.assign(num_blocks, 0);
+        active_.resize(num_blocks);
+
+        // 1. Hot blocks (threads own whole block rows) and the largest R_c
+        const double threshold_sq = config.sparse_threshold * config.sparse_threshold;
+        const int64_t block_rows = static_cast<int64_t>(blocks_[1] * blocks_[2]);
+        double max_R_c = 0.0;
+        #pragma omp parallel for schedule(static) reduction(max:max_R_c) if(nodes.size() >= config.omp_min_nodes)
+        for (int64_t r = 0; r < block_rows; ++r) {
+            const size_t by = static_cast<size_t>(r) % blocks_[1];
+            const size_t bz = static_cast<size_t>(r) / blocks_[1];
+            uint8_t* hot = hot_.data() + static_cast<size_t>(r) * blocks_[0];
+            const size_t z_end = std::min(N_z, (bz + 1) * block_);
+            const size_t y_end = std::min(N_y, (by + 1) * block_);
+            for (size_t z = bz * block_; z < z_end; ++z) {
+                for (size_t y = by * block_; y < y_end; ++y) {
+                    const IGSOAComplexNode* row = nodes.data() + (z * N_y + y) * N_x;
+                    for (size_t x = 0; x < N_x; ++x) {
+                        const IGSOAComplexNode& node = row[x];
+                        max_R_c = std::max(max_R_c, node.R_c);
+                        if (std::norm(node.psi) >= threshold_sq || node.phi * node.phi >= threshold_sq) {
+                            hot[x / block_] = 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        // 2. Separable periodic box dilation by the reach in blocks
+        const size_t reach = static_cast<size_t>(std::ceil(std::max(max_R_c, 0.0)));
+        active_ = hot_;
+        const size_t extent[3] = {N_x, N_y, N_z};
+        for (int axis = 0; axis < 3; ++axis) {
+            size_t radius = (reach + block_ - 1) / block_ + (extent[axis] % block_ != 0 ? 1 : 0);
+            if (blocks_[axis] == 1) {
+                continue;
+            }
+            radius = std::min(radius, blocks_[axis] / 2);   // 2·radius + 1 >= blocks: whole ring
+            dilate(axis, radius);
+        }
+
+        // 3. Skip counters
+        size_t skipped = 0;
+        for (size_t bz = 0; bz < blocks_[2]; ++bz) {
+            for (size_t by = 0; by < blocks_[1]; ++by) {
+                for (size_t bx = 0; bx < blocks_[0]; ++bx) {
+                    if (!active_[(bz * blocks_[1] + by) * blocks_[0] + bx]) {
+                        skipped += blockExtent(bx, N_x) * blockExtent(by, N_y) * blockExtent(bz, N_z);
+                    }
+                }
+            }
+        }
+        step_skipped_ = skipped;
+        skipped_nodes_ += skipped;
+        evaluated_nodes_ += nodes.size();
+    }
+
+    /**
+     * Block flags of the row (y, z), indexed by x / blockEdge()
+     */
+    const uint8_t* row(size_t y, size_t z) const {
+        return active_.data() + ((z / block_) * blocks_[1] + y / block_) * blocks_[0];
+    }
+
+    size_t blockEdge() const { return block_; }
+
+    // Nodes skipped by the last update
+    uint64_t stepSkippedNodes() const { return step_skipped_; }
+
+    // Skipped share of the node updates since beginMission()
+    double skippedFraction() const {
+        return evaluated_nodes_ > 0
+            ? static_cast<double>(skipped_nodes_) / static_cast<double>(evaluated_nodes_)
+            : 0.0;
+    }
+
+    void beginMission() {
+        skipped_nodes_ = 0;
+        evaluated_nodes_ = 0;
+    }
+
+    size_t memoryBytes() const {
+        return (hot_.capacity() + active_.capacity() + scratch_.capacity()) * sizeof(uint8_t);
+    }
+
+private:
+    size_t blockExtent(size_t b, size_t N) const {
+        return std::min(N, (b + 1) * block_) - b * block_;
+    }
+
+    // active_ |= active_ shifted by -radius..radius blocks along axis
+    void dilate(int axis, size_t radius) {
+        const size_t stride = axis == 0 ? 1 : (axis == 1 ? blocks_[0] : blocks_[0] * blocks_[1]);
+        const size_t length = blocks_[axis];
+        scratch_ = active_;
+        for (size_t cell = 0; cell < active_.size(); ++cell) {
+            if (!scratch_[cell]) {
+                continue;
+            }
+            const size_t position = (cell / stride) % length;
+            const size_t base = cell - position * stride;
+            for (size_t d = 1; d <= radius; ++d) {
+                active_[base + ((position + d) % length) * stride] = 1;
+                active_[base + ((position + length - d) % length) * stride] = 1;
+            }
+        }
+    }
+
+    size_t block_ = 8;
+    size_t blocks_[3] = {0, 0, 0};
+    std::vector<uint8_t> hot_;
+    std::vector<uint8_t> active_;
+    std::vector<uint8_t> scratch_;
+    uint64_t step_skipped_ = 0;
+    uint64_t skipped_nodes_ = 0;
+    uint64_t evaluated_nodes_ = 0;
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,178 @@
+/**
+ * IGSOA Adaptive Mission
+ *
+ * Runs an IGSOA engine to a target simulated time with step-doubling error
+ * control (adaptive_timestep.h), shared by the 1D/2D/3D engines'
+ * runMissionAdaptive.  Every trial step of dt is taken once with dt (coarse)
+ * and twice with dt/2 (fine) from the same start state; the error estimate
+ * is the largest |ΔΨ| or |ΔΦ| between the two.  An accepted step keeps the
+ * fine state.  Φ is always forward Euler, so the estimate is treated as
+ * first order whatever the Ψ integrator (conservative for RK2/RK4).
+ *
+ * An embedded Runge-Kutta pair would only see the Ψ equation; step
+ * doubling covers the whole engine step (Ψ, Φ, normalization) with the
+ * existing kernels, at three timeSteps per trial.
+ *
+ * Driving is scheduled in simulated time: sample k lands at
+ * t_start + k · interval.  The samples falling inside a step are summed into
+ * one kick at its start (the fine pair splits them between its halves), so
+ * the total impulse does not depend on the step sizes, and a run whose
+ * steps equal the interval applies one sample per step like runMission.
+ */
+
+#pragma once
+
+#include "adaptive_timestep.h"
+#include "igsoa_complex_node.h"
+#include "igsoa_physics.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+/**
+ * Driving samples on a simulated-time grid
+ */
+struct IGSOADrivingSchedule {
+    const double* input_signals = nullptr;     // Length `count`
+    const double* control_patterns = nullptr;  // Length `count`
+    size_t count = 0;
+    double start_time = 0.0;                   // Time of sample 0
+    double interval = 0.0;                     // Spacing of the samples
+
+    bool active() const {
+        return input_signals != nullptr && control_patterns != nullptr && count > 0 && interval > 0.0;
+    }
+
+    /**
+     * Sum of the samples in [t0, t1); false if there are none
+     */
+    bool sum(double t0, double t1, double& signal, double& control) const {
+        signal = 0.0;
+        control = 0.0;
+        if (!active() || t1 <= start_time) return false;
+        const double first = std::ceil((t0 - start_time) / interval - 1.0e-9);
+        const double last = std::ceil((t1 - start_time) / interval - 1.0e-9);   // Exclusive
+        const size_t begin = static_cast<size_t>(std::max(0.0, first));
+        const size_t end = static_cast<size_t>(std::min(static_cast<double>(count), std::max(0.0, last)));
+        for (size_t k = begin; k < end; ++k) {
+            signal += input_signals[k];
+            control += control_patterns[k];
+        }
+        return end > begin;
+    }
+};
+
+class IGSOAAdaptiveMission {
+public:
+    /**
+     * Advance `nodes` by `duration` of simulated time
+     *
+     * @param config Engine config; config.dt is set to each step taken and
+     *               restored on return
+     * @param step Runs one engine timeStep with config.dt, returns operations
+     * @param current_time Engine clock (advanced by accepted steps)
+     * @param total_steps Engine step counter (+1 per accepted step)
+     * @param operations Adds every timeStep and kick performed, rejected
+     *                   trials included
+     */
+    template <typename Step>
+    AdaptiveStepStats run(
+        std::vector<IGSOAComplexNode>& nodes,
+        IGSOAComplexConfig& config,
+        double duration,
+        const AdaptiveStepOptions& options,
+        const IGSOADrivingSchedule& driving,
+        double& current_time,
+        uint64_t& total_steps,
+        uint64_t& operations,
+        Step&& step
+    ) {
+        AdaptiveStepStats stats;
+        const double configured_dt = config.dt;
+        const double t_end = current_time + duration;
+        double trial = AdaptiveStepController::clamp(
+            options.dt_initial > 0.0 ? options.dt_initial : configured_dt, options);
+
+        while (!AdaptiveStepController::reached(current_time, t_end)) {
+            const double dt = AdaptiveStepController::towards(current_time, t_end, trial);
+            start_ = nodes;
+
+            // Coarse: one step of dt
+            operations += kick(nodes, driving, current_time, current_time + dt);
+            config.dt = dt;
+            operations += step();
+            coarse_ = nodes;
+
+            // Fine: two steps of dt/2 from the same start
+            nodes = start_;
+            const double t_mid = current_time + 0.5 * dt;
+            config.dt = 0.5 * dt;
+            operations += kick(nodes, driving, current_time, t_mid);
+            operations += step();
+            operations += kick(nodes, driving, t_mid, current_time + dt);
+            operations += step();
+
+            const double error = difference(nodes, coarse_);
+            const bool at_floor = dt <= options.dt_min * (1.0 + 1.0e-12);
+            if (error <= options.tolerance || at_floor) {
+                if (error > options.tolerance) {
+                    stats.forced_steps++;
+                }
+                stats.recordAccepted(dt, error);
+                current_time += dt;
+                total_steps++;
+                // A step shortened to land on t_end says little about the
+                // step the dynamics allow: keep the longer trial
+                trial = std::max(dt < trial ? trial : options.dt_min,
+                                 AdaptiveStepController::nextStep(dt, error, 1, options));
+            } else {
+                nodes = start_;
+                stats.rejected_steps++;
+                trial = AdaptiveStepController::nextStep(dt, error, 1, options);
+            }
+        }
+
+        config.dt = configured_dt;
+        return stats;
+    }
+
+    /**
+     * Bytes held by the start / coarse copies of the lattice
+     */
+    size_t memoryBytes() const {
+        return (start_.capacity() + coarse_.capacity()) * sizeof(IGSOAComplexNode);
+    }
+
+private:
+    // Start state and coarse result of the current trial (reused across steps)
+    std::vector<IGSOAComplexNode> start_;
+    std::vector<IGSOAComplexNode> coarse_;
+
+    static uint64_t kick(std::vector<IGSOAComplexNode>& nodes, const IGSOADrivingSchedule& driving,
+                         double t0, double t1) {
+        double signal = 0.0, control = 0.0;
+        if (!driving.sum(t0, t1, signal, control)) {
+            return 0;
+        }
+        IGSOAPhysics::applyDriving(nodes, signal, control);
+        return static_cast<uint64_t>(nodes.size());
+    }
+
+    static double difference(const std::vector<IGSOAComplexNode>& a, const std::vector<IGSOAComplexNode>& b) {
+        double error = 0.0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            error = std::max(error, std::abs(a[i].psi - b[i].psi));
+            error = std::max(error, std::abs(a[i].phi - b[i].phi));
+        }
+        // NaN never compares greater: report it as an unbounded error
+        return std::isfinite(error) ? error : HUGE_VAL;
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
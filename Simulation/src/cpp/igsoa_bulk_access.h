@@ -0,0 +1,241 @@
+/**
+ * IGSOA Bulk Node Access
+ *
+ * Whole-lattice and sub-block copies of Ψ, Φ and F between an IGSOA node
+ * vector and caller-provided buffers.  Meant for the C API and the CLI:
+ * initializing or reading a large engine one node per call costs one FFI
+ * round trip per node; these copy a field, or a box of it, per call.
+ *
+ * Lattices are row-major with x fastest (index = (z*N_y + y)*N_x + x), as in
+ * the 2D/3D engines; a 1D engine is an N_x * 1 * 1 lattice.
+ *
+ * Buffer layout: element (x, y, z) of a region (relative to its corner)
+ * lives at buffer[z*slice_stride + y*row_stride + x*elem_stride], strides in
+ * doubles.  Zero row/slice strides mean packed rows/slices, so the default
+ * layout is a dense C-order block.  elem_stride = 2 with a one-double offset
+ * makes split fields interleaved (Re, Im, Re, Im, ...).
+ */
+
+#pragma once
+
+#include "dase_field_view.h"
+#include "igsoa_complex_node.h"
+#include <cstddef>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+enum class IGSOANodeField : int {
+    PsiReal = 0,   // Re[Ψ]
+    PsiImag = 1,   // Im[Ψ]
+    Phi     = 2,   // Φ
+    F       = 3    // |Ψ|² (read-only: derived from Ψ)
+};
+
+/**
+ * Box [x0, x0+nx) x [y0, y0+ny) x [z0, z0+nz) of a lattice
+ */
+struct IGSOANodeRegion {
+    size_t x0 = 0, y0 = 0, z0 = 0;
+    size_t nx = 0, ny = 1, nz = 1;
+
+    size_t count() const { return nx * ny * nz; }
+};
+
+struct IGSOABufferLayout {
+    size_t elem_stride = 1;
+    size_t row_stride = 0;     // 0 = nx * elem_stride
+    size_t slice_stride = 0;   // 0 = ny * row_stride
+};
+
+struct IGSOABulkAccess {
+    // Field ids of IGSOANodeField (probe_recorder.h range-checks against it)
+    static constexpr int kNumFields = 4;
+
+    /**
+     * One field of one node (0 for an unknown field)
+     */
+    static double value(const IGSOAComplexNode& node, IGSOANodeField field) {
+        switch (field) {
+            case IGSOANodeField::PsiReal: return node.psi.real();
+            case IGSOANodeField::PsiImag: return node.psi.imag();
+            case IGSOANodeField::Phi: return node.phi;
+            case IGSOANodeField::F: return node.F;
+            default: return 0.0;
+        }
+    }
+
+    static IGSOANodeRegion whole(size_t N_x, size_t N_y = 1, size_t N_z = 1) {
+        IGSOANodeRegion region;
+        region.nx = N_x;
+        region.ny = N_y;
+        region.nz = N_z;
+        return region;
+    }
+
+    /**
+     * Copy one field of a region into `out`
+     * @return false if the region leaves the lattice, the node vector is not
+     *         N_x*N_y*N_z, out is null, or elem_stride is 0
+     */
+    static bool gather(const std::vector<IGSOAComplexNode>& nodes,
+                       size_t N_x, size_t N_y, size_t N_z,
+                       const IGSOANodeRegion& region, IGSOANodeField field,
+                       double* out, IGSOABufferLayout layout = IGSOABufferLayout()) {
+        if (!out || !valid(nodes.size(), N_x, N_y, N_z, region, layout)) {
+            return false;
+        }
+        resolve(region, layout);
+        for (size_t z = 0; z < region.nz; z++) {
+            for (size_t y = 0; y < region.ny; y++) {
+                const IGSOAComplexNode* row =
+                    &nodes[((region.z0 + z) * N_y + region.y0 + y) * N_x + region.x0];
+                double* dst = out + z * layout.slice_stride + y * layout.row_stride;
+                switch (field) {
+                    case IGSOANodeField::PsiReal:
+                        for (size_t x = 0; x < region.nx; x++) dst[x * layout.elem_stride] = row[x].psi.real();
+                        break;
+                    case IGSOANodeField::PsiImag:
+                        for (size_t x = 0; x < region.nx; x++) dst[x * layout.elem_stride] = row[x].psi.imag();
+                        break;
+                    case IGSOANodeField::Phi:
+                        for (size_t x = 0; x < region.nx; x++) dst[x * layout.elem_stride] = row[x].phi;
+                        break;
+                    case IGSOANodeField::F:
+                        for (size_t x = 0; x < region.nx; x++) dst[x * layout.elem_stride] = row[x].F;
+                        break;
+                    default:
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Copy `in` into one field of a region.  Writing a Ψ component refreshes
+     * F and the phase of each node, as setNodePsi does.
+     * @return false as for gather(), or for the read-only F field
+     */
+    static bool scatter(std::vector<IGSOAComplexNode>& nodes,
+                        size_t N_x, size_t N_y, size_t N_z,
+                        const IGSOANodeRegion& region, IGSOANodeField field,
+                        const double* in, IGSOABufferLayout layout = IGSOABufferLayout()) {
+        if (!in || !valid(nodes.size(), N_x, N_y, N_z, region, layout) ||
+            field == IGSOANodeField::F) {
+            return false;
+        }
+        resolve(region, layout);
+        for (size_t z = 0; z < region.nz; z++) {
+            for (size_t y = 0; y < region.ny; y++) {
+                IGSOAComplexNode* row =
+                    &nodes[((region.z0 + z) * N_y + region.y0 + y) * N_x + region.x0];
+                const double* src = in + z * layout.slice_stride + y * layout.row_stride;
+                switch (field) {
+                    case IGSOANodeField::PsiReal:
+                        for (size_t x = 0; x < region.nx; x++) {
+                            row[x].psi.real(src[x * layout.elem_stride]);
+                            row[x].updateInformationalDensity();
+                            row[x].updatePhase();
+                        }
+                        break;
+                    case IGSOANodeField::PsiImag:
+                        for (size_t x = 0; x < region.nx; x++) {
+                            row[x].psi.imag(src[x * layout.elem_stride]);
+                            row[x].updateInformationalDensity();
+                            row[x].updatePhase();
+                        }
+                        break;
+                    case IGSOANodeField::Phi:
+                        for (size_t x = 0; x < region.nx; x++) row[x].phi = src[x * layout.elem_stride];
+                        break;
+                    default:
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Write Ψ from split (re, im) buffers in one pass, so F and the phase
+     * are refreshed once per node
+     */
+    static bool scatterPsi(std::vector<IGSOAComplexNode>& nodes,
+                           size_t N_x, size_t N_y, size_t N_z,
+                           const IGSOANodeRegion& region,
+                           const double* re, const double* im,
+                           IGSOABufferLayout layout = IGSOABufferLayout()) {
+        if (!re || !im || !valid(nodes.size(), N_x, N_y, N_z, region, layout)) {
+            return false;
+        }
+        resolve(region, layout);
+        for (size_t z = 0; z < region.nz; z++) {
+            for (size_t y = 0; y < region.ny; y++) {
+                IGSOAComplexNode* row =
+                    &nodes[((region.z0 + z) * N_y + region.y0 + y) * N_x + region.x0];
+                const size_t offset = z * layout.slice_stride + y * layout.row_stride;
+                for (size_t x = 0; x < region.nx; x++) {
+                    const size_t i = offset + x * layout.elem_stride;
+                    row[x].psi = std::complex<double>(re[i], im[i]);
+                    row[x].updateInformationalDensity();
+                    row[x].updatePhase();
+                }
+            }
+        }
+        return true;
+    }
+
+    // Field id of Ψ as one complex128 element in view() (IGSOA_FIELD_PSI)
+    static constexpr int kPsiView = kNumFields;
+
+    /**
+     * Zero-copy view (dase_field_view.h) of one field of a N_z x N_y x N_x
+     * node vector: ndim 1 (x), 2 (y, x) or 3 (z, y, x) axes, one element per
+     * sizeof(IGSOAComplexNode) bytes.  F is read-only.
+     * @return false for an unknown field, a size mismatch or view version
+     */
+    static bool view(std::vector<IGSOAComplexNode>& nodes, int field, size_t N_x, size_t N_y, size_t N_z,
+                     uint32_t ndim, DaseFieldView* out) {
+        if (nodes.size() != N_x * N_y * N_z || ndim == 0 || ndim > 3 || field < 0 || field > kPsiView) {
+            return false;
+        }
+        IGSOAComplexNode* first = nodes.data();
+        void* data = nullptr;
+        switch (nodes.empty() ? -1 : field) {
+            case static_cast<int>(IGSOANodeField::PsiReal): data = reinterpret_cast<double*>(&first->psi); break;
+            case static_cast<int>(IGSOANodeField::PsiImag): data = reinterpret_cast<double*>(&first->psi) + 1; break;
+            case static_cast<int>(IGSOANodeField::Phi): data = &first->phi; break;
+            case static_cast<int>(IGSOANodeField::F): data = &first->F; break;
+            case kPsiView: data = &first->psi; break;
+            default: break;   // No nodes
+        }
+        const size_t all_dims[3] = {N_z, N_y, N_x};
+        const bool complex = field == kPsiView;
+        return fillFieldView(out, data, complex ? DASE_ELEMENT_COMPLEX128 : DASE_ELEMENT_FLOAT64,
+                             complex ? sizeof(std::complex<double>) : sizeof(double), sizeof(IGSOAComplexNode),
+                             all_dims + (3 - ndim), ndim, field != static_cast<int>(IGSOANodeField::F));
+    }
+
+private:
+    static bool valid(size_t num_nodes, size_t N_x, size_t N_y, size_t N_z,
+                      const IGSOANodeRegion& region, const IGSOABufferLayout& layout) {
+        return num_nodes == N_x * N_y * N_z && layout.elem_stride > 0 &&
+               region.x0 <= N_x && region.nx <= N_x - region.x0 &&
+               region.y0 <= N_y && region.ny <= N_y - region.y0 &&
+               region.z0 <= N_z && region.nz <= N_z - region.z0;
+    }
+
+    static void resolve(const IGSOANodeRegion& region, IGSOABufferLayout& layout) {
+        if (layout.row_stride == 0) {
+            layout.row_stride = region.nx * layout.elem_stride;
+        }
+        if (layout.slice_stride == 0) {
+            layout.slice_stride = region.ny * layout.row_stride;
+        }
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
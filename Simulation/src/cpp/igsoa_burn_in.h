@@ -0,0 +1,241 @@
+/**
+ * IGSOA Coarse-to-Fine Burn-In (2D / 3D)
+ *
+ * The opening steps of a mission mostly shed the transient of the initial
+ * state.  A burn-in runs them on a lattice `factor` (2 or 4) times coarser
+ * per axis and hands the result back to the full lattice:
+ *
+ *   1. restrict   block-average Ψ, Ψ̇, Φ, Φ̇, κ, γ and R_c over each
+ *                 factor^d block; R_c is divided by factor so the coupling
+ *                 radius keeps its physical extent in coarse lattice units
+ *   2. evolve     an engine of the same type and configuration (R_c_default
+ *                 scaled alike, coupling_gain matched below) runs the
+ *                 burn-in steps with the mission's driving; each coarse step
+ *                 is factor^d times cheaper, more with the coupling sum
+ *                 shrinking as R_c does
+ *   3. prolong    Ψ, Ψ̇, Φ, Φ̇ are interpolated back (periodic trilinear,
+ *                 bilinear in 2D, at cell-centred coordinates); the fine
+ *                 lattice keeps its own R_c, κ and γ, and normalize_psi
+ *                 lattices renormalize every node
+ *
+ * The fine engine's clock advances by the burn-in steps, so the mission
+ * continues from step `steps` as if they had run at full resolution.
+ *
+ * The coarse coupling sum runs over factor^d fewer neighbours whose weights
+ * (K = exp(-r/R_c)/R_c by default) are only about factor times larger, so
+ * left alone 𝒦[Ψ] would be about factor^(d-1) weaker than on the fine
+ * lattice.  For a field smooth on the coarse spacing 𝒦[Ψ] ≈ M₂/(2d) ∇²Ψ
+ * with M₂ = ∑ K(|r|) |r|² over the lattice offsets within R_c, so the coarse
+ * engine's coupling_gain is the ratio of the fine and coarse M₂ (the coarse
+ * one in fine units, i.e. times factor²): factor^(d-1) in the continuum
+ * limit, and still exact in ∇² when R_c / factor leaves only a few coarse
+ * neighbours.  d counts the coarsened axes (a single-plane 3D lattice is
+ * 2); the gain is matched at R_c_default.  Features below factor lattice
+ * units are smoothed away, so a burn-in suits a smooth initial transient,
+ * not a sharp one.  Probes and observables do not sample burn-in steps.
+ */
+
+#pragma once
+
+#include "igsoa_complex_node.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+struct IGSOABurnInOptions {
+    uint64_t steps = 0;    // Steps run on the coarse lattice
+    uint32_t factor = 2;   // Coarsening per axis: 2 or 4
+
+    /**
+     * Check the options against a fine lattice (N_z = 1 for 2D)
+     */
+    bool validate(const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t N_z,
+                  std::string* error_msg = nullptr) const {
+        if (factor != 2 && factor != 4) {
+            if (error_msg) *error_msg = "burn-in factor must be 2 or 4";
+            return false;
+        }
+        if (N_x % factor != 0 || N_y % factor != 0 || (N_z > 1 && N_z % factor != 0)) {
+            if (error_msg) {
+                *error_msg = "burn-in factor " + std::to_string(factor) +
+                             " must divide every lattice dimension";
+            }
+            return false;
+        }
+        if (config.R_c_default / factor < 1.0) {
+            if (error_msg) {
+                *error_msg = "R_c / burn-in factor must be at least one coarse lattice spacing";
+            }
+            return false;
+        }
+        return true;
+    }
+};
+
+class IGSOABurnIn {
+public:
+    /**
+     * Configuration of the coarse engine for a fine configuration
+     * (dims: coarsened axes, 2 or 3)
+     */
+    static IGSOAComplexConfig coarseConfig(const IGSOAComplexConfig& fine, uint32_t factor,
+                                           size_t coarse_nodes, int dims) {
+        IGSOAComplexConfig coarse = fine;
+        coarse.num_nodes = static_cast<uint32_t>(coarse_nodes);
+        coarse.R_c_default = fine.R_c_default / factor;
+        coarse.coupling_gain = fine.coupling_gain *
+            secondMoment(fine.kernel_policy, fine.R_c_default, dims) /
+            (static_cast<double>(factor) * factor * secondMoment(fine.kernel_policy, coarse.R_c_default, dims));
+        coarse.numa = NumaOptions();   // Short-lived: default placement, no re-pinning
+        return coarse;
+    }
+
+    /**
+     * Block-average the fine lattice onto the coarse one (dims of the fine
+     * lattice; N_z = 1 for 2D)
+     */
+    static void restrictState(const std::vector<IGSOAComplexNode>& fine,
+                              size_t N_x, size_t N_y, size_t N_z, uint32_t factor,
+                              std::vector<IGSOAComplexNode>& coarse) {
+        const size_t fz = N_z > 1 ? factor : 1;
+        const size_t c_x = N_x / factor;
+        const size_t c_y = N_y / factor;
+        const size_t c_z = N_z / fz;
+        const double weight = 1.0 / static_cast<double>(factor * factor * fz);
+        const int64_t total = static_cast<int64_t>(c_x * c_y * c_z);
+        #pragma omp parallel for schedule(static) if(fine.size() >= 4096)
+        for (int64_t c = 0; c < total; ++c) {
+            const size_t cx = static_cast<size_t>(c) % c_x;
+            const size_t cy = (static_cast<size_t>(c) / c_x) % c_y;
+            const size_t cz = static_cast<size_t>(c) / (c_x * c_y);
+            std::complex<double> psi, psi_dot;
+            double phi = 0.0, phi_dot = 0.0, R_c = 0.0, kappa = 0.0, gamma = 0.0;
+            for (size_t z = cz * fz; z < (cz + 1) * fz; ++z) {
+                for (size_t y = cy * factor; y < (cy + 1) * factor; ++y) {
+                    const IGSOAComplexNode* row = fine.data() + (z * N_y + y) * N_x;
+                    for (size_t x = cx * factor; x < (cx + 1) * factor; ++x) {
+                        psi += row[x].psi;
+                        psi_dot += row[x].psi_dot;
+                        phi += row[x].phi;
+                        phi_dot += row[x].phi_dot;
+                        R_c += row[x].R_c;
+                        kappa += row[x].kappa;
+                        gamma += row[x].gamma;
+                    }
+                }
+            }
+            IGSOAComplexNode& node = coarse[static_cast<size_t>(c)];
+            node.psi = psi * weight;
+            node.psi_dot = psi_dot * weight;
+            node.phi = phi * weight;
+            node.phi_dot = phi_dot * weight;
+            node.R_c = R_c * weight / factor;
+            node.kappa = kappa * weight;
+            node.gamma = gamma * weight;
+            node.updateInformationalDensity();
+            node.updatePhase();
+            node.updateEntropyRate();
+        }
+    }
+
+    /**
+     * Interpolate Ψ, Ψ̇, Φ, Φ̇ of the coarse lattice onto the fine one
+     * (periodic trilinear at cell centres; dims of the fine lattice)
+     */
+    static void prolongState(const std::vector<IGSOAComplexNode>& coarse,
+                             size_t N_x, size_t N_y, size_t N_z, uint32_t factor, bool normalize,
+                             std::vector<IGSOAComplexNode>& fine) {
+        const size_t fz = N_z > 1 ? factor : 1;
+        const size_t c_x = N_x / factor;
+        const size_t c_y = N_y / factor;
+        const size_t c_z = N_z / fz;
+        const int64_t total = static_cast<int64_t>(N_x * N_y * N_z);
+        #pragma omp parallel for schedule(static) if(fine.size() >= 4096)
+        for (int64_t i = 0; i < total; ++i) {
+            const size_t x = static_cast<size_t>(i) % N_x;
+            const size_t y = (static_cast<size_t>(i) / N_x) % N_y;
+            const size_t z = static_cast<size_t>(i) / (N_x * N_y);
+            size_t x0, x1, y0, y1, z0, z1;
+            const double tx = axisWeight(x, factor, c_x, x0, x1);
+            const double ty = axisWeight(y, factor, c_y, y0, y1);
+            const double tz = axisWeight(z, fz, c_z, z0, z1);
+
+            std::complex<double> psi, psi_dot;
+            double phi = 0.0, phi_dot = 0.0;
+            const size_t zs[2] = {z0, z1};
+            const size_t ys[2] = {y0, y1};
+            const size_t xs[2] = {x0, x1};
+            const double wz[2] = {1.0 - tz, tz};
+            const double wy[2] = {1.0 - ty, ty};
+            const double wx[2] = {1.0 - tx, tx};
+            for (int a = 0; a < 2; ++a) {
+                for (int b = 0; b < 2; ++b) {
+                    const IGSOAComplexNode* row = coarse.data() + (zs[a] * c_y + ys[b]) * c_x;
+                    for (int c = 0; c < 2; ++c) {
+                        const double w = wz[a] * wy[b] * wx[c];
+                        const IGSOAComplexNode& node = row[xs[c]];
+                        psi += w * node.psi;
+                        psi_dot += w * node.psi_dot;
+                        phi += w * node.phi;
+                        phi_dot += w * node.phi_dot;
+                    }
+                }
+            }
+
+            IGSOAComplexNode& node = fine[static_cast<size_t>(i)];
+            node.psi = psi;
+            node.psi_dot = psi_dot;
+            node.phi = phi;
+            node.phi_dot = phi_dot;
+            if (normalize) {
+                node.normalize();
+            }
+            node.updateInformationalDensity();
+            node.updatePhase();
+            node.updateEntropyRate();
+        }
+    }
+
+private:
+    // M₂ = ∑ K(|r|, R_c) |r|² over the offsets the lattice paths couple
+    // (|r| <= R_c; dims 2 or 3)
+    static double secondMoment(IGSOAKernelPolicy policy, double R_c, int dims) {
+        const int reach = static_cast<int>(std::ceil(R_c));
+        const int reach_z = dims == 3 ? reach : 0;
+        double moment = 0.0;
+        for (int dz = -reach_z; dz <= reach_z; ++dz) {
+            for (int dy = -reach; dy <= reach; ++dy) {
+                for (int dx = -reach; dx <= reach; ++dx) {
+                    const double r2 = static_cast<double>(dx * dx + dy * dy + dz * dz);
+                    const double r = std::sqrt(r2);
+                    if (r <= R_c) {
+                        moment += kernelWeight(policy, r, R_c) * r2;
+                    }
+                }
+            }
+        }
+        return moment;
+    }
+
+    // Coarse neighbours and weight of fine index i along one axis: fine cell
+    // centre i + 1/2 sits at coarse coordinate (i + 1/2) / factor - 1/2
+    static double axisWeight(size_t i, size_t factor, size_t coarse_n, size_t& lo, size_t& hi) {
+        const double u = (static_cast<double>(i) + 0.5) / static_cast<double>(factor) - 0.5;
+        const double base = std::floor(u);
+        const int64_t n = static_cast<int64_t>(coarse_n);
+        const int64_t k = static_cast<int64_t>(base);
+        lo = static_cast<size_t>(((k % n) + n) % n);
+        hi = static_cast<size_t>((((k + 1) % n) + n) % n);
+        return u - base;
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
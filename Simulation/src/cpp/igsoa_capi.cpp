@@ -4,6 +4,8 @@
 
 #include "igsoa_capi.h"
 #include "igsoa_complex_engine.h"
+#include "igsoa_bulk_access.h"
+#include "engine_checkpoint.h"
 #include <memory>
 
 using namespace dase::igsoa;
@@ -13,6 +15,61 @@ struct IGSOAComplexEngine_C {
     std::unique_ptr<IGSOAComplexEngine> engine;
 };
 
+namespace {
+
+IGSOAComplexEngine* bulkEngine(IGSOAEngineHandle engine) {
+    return (engine && engine->engine) ? engine->engine.get() : nullptr;
+}
+
+bool gatherRange(IGSOAEngineHandle handle, IGSOANodeField field, size_t first, size_t count,
+                 double* out, size_t stride) {
+    IGSOAComplexEngine* engine = bulkEngine(handle);
+    if (!engine) {
+        return false;
+    }
+    const auto& nodes = engine->getNodes();
+    IGSOANodeRegion region;
+    region.x0 = first;
+    region.nx = count;
+    IGSOABufferLayout layout;
+    layout.elem_stride = stride;
+    return IGSOABulkAccess::gather(nodes, nodes.size(), 1, 1, region, field, out, layout);
+}
+
+bool scatterRange(IGSOAEngineHandle handle, IGSOANodeField field, size_t first, size_t count,
+                  const double* in, size_t stride) {
+    IGSOAComplexEngine* engine = bulkEngine(handle);
+    if (!engine) {
+        return false;
+    }
+    auto& nodes = engine->getNodesMutable();
+    IGSOANodeRegion region;
+    region.x0 = first;
+    region.nx = count;
+    IGSOABufferLayout layout;
+    layout.elem_stride = stride;
+    return IGSOABulkAccess::scatter(nodes, nodes.size(), 1, 1, region, field, in, layout);
+}
+
+bool scatterAllPsi(IGSOAEngineHandle handle, const double* re, const double* im, size_t stride) {
+    IGSOAComplexEngine* engine = bulkEngine(handle);
+    if (!engine) {
+        return false;
+    }
+    auto& nodes = engine->getNodesMutable();
+    IGSOABufferLayout layout;
+    layout.elem_stride = stride;
+    return IGSOABulkAccess::scatterPsi(nodes, nodes.size(), 1, 1,
+                                       IGSOABulkAccess::whole(nodes.size()), re, im, layout);
+}
+
+size_t numNodes(IGSOAEngineHandle handle) {
+    IGSOAComplexEngine* engine = bulkEngine(handle);
+    return engine ? engine->getNumNodes() : 0;
+}
+
+} // namespace
+
 extern "C" {
 
 IGSOA_API IGSOAEngineHandle igsoa_create_engine(
@@ -98,6 +155,97 @@ IGSOA_API double igsoa_get_node_F(
     return 0.0;
 }
 
+IGSOA_API bool igsoa_get_all_psi(
+    IGSOAEngineHandle engine,
+    double* psi_real_out,
+    double* psi_imag_out
+) {
+    const size_t n = numNodes(engine);
+    return gatherRange(engine, IGSOANodeField::PsiReal, 0, n, psi_real_out, 1) &&
+           gatherRange(engine, IGSOANodeField::PsiImag, 0, n, psi_imag_out, 1);
+}
+
+IGSOA_API bool igsoa_set_all_psi(
+    IGSOAEngineHandle engine,
+    const double* psi_real,
+    const double* psi_imag
+) {
+    return scatterAllPsi(engine, psi_real, psi_imag, 1);
+}
+
+IGSOA_API bool igsoa_get_all_psi_interleaved(
+    IGSOAEngineHandle engine,
+    double* psi_out
+) {
+    const size_t n = numNodes(engine);
+    return psi_out &&
+           gatherRange(engine, IGSOANodeField::PsiReal, 0, n, psi_out, 2) &&
+           gatherRange(engine, IGSOANodeField::PsiImag, 0, n, psi_out + 1, 2);
+}
+
+IGSOA_API bool igsoa_set_all_psi_interleaved(
+    IGSOAEngineHandle engine,
+    const double* psi
+) {
+    return psi && scatterAllPsi(engine, psi, psi + 1, 2);
+}
+
+IGSOA_API bool igsoa_get_all_phi(
+    IGSOAEngineHandle engine,
+    double* phi_out
+) {
+    return gatherRange(engine, IGSOANodeField::Phi, 0, numNodes(engine), phi_out, 1);
+}
+
+IGSOA_API bool igsoa_set_all_phi(
+    IGSOAEngineHandle engine,
+    const double* phi
+) {
+    return scatterRange(engine, IGSOANodeField::Phi, 0, numNodes(engine), phi, 1);
+}
+
+IGSOA_API bool igsoa_get_all_F(
+    IGSOAEngineHandle engine,
+    double* F_out
+) {
+    return gatherRange(engine, IGSOANodeField::F, 0, numNodes(engine), F_out, 1);
+}
+
+IGSOA_API bool igsoa_get_field_range(
+    IGSOAEngineHandle engine,
+    IGSOAField field,
+    uint32_t first,
+    uint32_t count,
+    double* out,
+    size_t stride
+) {
+    return gatherRange(engine, static_cast<IGSOANodeField>(field), first, count, out, stride);
+}
+
+IGSOA_API bool igsoa_set_field_range(
+    IGSOAEngineHandle engine,
+    IGSOAField field,
+    uint32_t first,
+    uint32_t count,
+    const double* in,
+    size_t stride
+) {
+    return scatterRange(engine, static_cast<IGSOANodeField>(field), first, count, in, stride);
+}
+
+IGSOA_API bool igsoa_get_field_view(
+    IGSOAEngineHandle engine,
+    IGSOAField field,
+    DaseFieldView* view
+) {
+    IGSOAComplexEngine* cpp = bulkEngine(engine);
+    if (!cpp) {
+        return false;
+    }
+    auto& nodes = cpp->getNodesMutable();
+    return IGSOABulkAccess::view(nodes, static_cast<int>(field), nodes.size(), 1, 1, 1, view);
+}
+
 IGSOA_API void igsoa_run_mission(
     IGSOAEngineHandle engine,
     const double* input_signals,
@@ -174,4 +322,96 @@ IGSOA_API double igsoa_get_current_time(IGSOAEngineHandle engine) {
     return 0.0;
 }
 
+IGSOA_API bool igsoa_set_precision(IGSOAEngineHandle engine, IGSOAPrecisionMode precision) {
+    if (!engine || !engine->engine ||
+        precision < IGSOA_PRECISION_DOUBLE || precision > IGSOA_PRECISION_FLOAT) {
+        return false;
+    }
+    engine->engine->setPrecision(static_cast<IGSOAPrecision>(precision));
+    return true;
+}
+
+IGSOA_API IGSOAPrecisionMode igsoa_get_precision(IGSOAEngineHandle engine) {
+    if (engine && engine->engine) {
+        return static_cast<IGSOAPrecisionMode>(engine->engine->getPrecision());
+    }
+    return IGSOA_PRECISION_DOUBLE;
+}
+
+IGSOA_API int32_t igsoa_add_probe(
+    IGSOAEngineHandle engine,
+    const uint32_t* nodes,
+    uint32_t num_nodes,
+    const IGSOAField* fields,
+    uint32_t num_fields,
+    uint32_t decimation,
+    uint32_t capacity
+) {
+    IGSOAComplexEngine* target = bulkEngine(engine);
+    if (!target || !nodes || !fields) {
+        return -1;
+    }
+    try {
+        dase::ProbeSpec spec;
+        spec.points.assign(nodes, nodes + num_nodes);
+        for (uint32_t f = 0; f < num_fields; ++f) {
+            spec.fields.push_back(static_cast<int>(fields[f]));
+        }
+        spec.decimation = decimation;
+        spec.capacity = capacity;
+        return target->probes().add(spec, target->getNodes().size(), IGSOABulkAccess::kNumFields);
+    } catch (...) {
+        return -1;
+    }
+}
+
+IGSOA_API size_t igsoa_probe_pending(IGSOAEngineHandle engine, int32_t probe_id) {
+    IGSOAComplexEngine* target = bulkEngine(engine);
+    return target ? target->probes().pending(probe_id) : 0;
+}
+
+IGSOA_API size_t igsoa_drain_probe(
+    IGSOAEngineHandle engine,
+    int32_t probe_id,
+    uint64_t* steps_out,
+    double* values_out,
+    size_t max_samples,
+    uint64_t* dropped_out
+) {
+    IGSOAComplexEngine* target = bulkEngine(engine);
+    return target ? target->probes().drain(probe_id, steps_out, values_out, max_samples, dropped_out) : 0;
+}
+
+IGSOA_API bool igsoa_remove_probe(IGSOAEngineHandle engine, int32_t probe_id) {
+    IGSOAComplexEngine* target = bulkEngine(engine);
+    return target && target->probes().remove(probe_id);
+}
+
+IGSOA_API bool igsoa_checkpoint_engine(IGSOAEngineHandle engine, const char* path) {
+    if (!engine || !engine->engine || !path) {
+        return false;
+    }
+    try {
+        dase::CheckpointWriter writer;
+        engine->engine->saveCheckpoint(writer);
+        writer.write(path);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+IGSOA_API bool igsoa_restore_engine(IGSOAEngineHandle engine, const char* path) {
+    if (!engine || !engine->engine || !path) {
+        return false;
+    }
+    try {
+        const dase::CheckpointImage image(path);
+        engine->engine->restoreCheckpoint(image);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 } // extern "C"
@@ -18,11 +18,15 @@
     #define IGSOA_API
 #endif
 
+#include "dase_field_view.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 // =============================================================================
 // OPAQUE ENGINE HANDLE
@@ -33,6 +37,32 @@ extern "C" {
  */
 typedef struct IGSOAComplexEngine_C* IGSOAEngineHandle;
 
+#ifndef IGSOA_FIELD_DEFINED
+#define IGSOA_FIELD_DEFINED
+/**
+ * Per-node field selector for the bulk access functions (shared with igsoa_capi_2d.h)
+ */
+typedef enum IGSOAField {
+    IGSOA_FIELD_PSI_REAL = 0,   // Re[Ψ]
+    IGSOA_FIELD_PSI_IMAG = 1,   // Im[Ψ]
+    IGSOA_FIELD_PHI = 2,        // Φ
+    IGSOA_FIELD_F = 3,          // F = |Ψ|² (read-only)
+    IGSOA_FIELD_PSI = 4         // Ψ as one complex128 (field views only)
+} IGSOAField;
+#endif
+
+#ifndef IGSOA_PRECISION_DEFINED
+#define IGSOA_PRECISION_DEFINED
+/**
+ * Ψ mirror / coupling-sum precision (IGSOAPrecision; shared with igsoa_capi_2d.h)
+ */
+typedef enum IGSOAPrecisionMode {
+    IGSOA_PRECISION_DOUBLE = 0,       // Double mirror, double sums (default)
+    IGSOA_PRECISION_MIXED_FLOAT = 1,  // Float mirror, double sums
+    IGSOA_PRECISION_FLOAT = 2         // Float mirror, float span sums
+} IGSOAPrecisionMode;
+#endif
+
 // =============================================================================
 // ENGINE LIFECYCLE
 // =============================================================================
@@ -133,6 +163,116 @@ IGSOA_API double igsoa_get_node_F(
     uint32_t node_index
 );
 
+// =============================================================================
+// BULK NODE ACCESS
+// =============================================================================
+//
+// One call per field instead of one per node.  Buffers are caller-allocated
+// with igsoa_get_num_nodes() elements (2x for interleaved Ψ); all functions
+// return false on a null handle or buffer, or an out-of-range request.
+// Writing Ψ refreshes F = |Ψ|² as igsoa_set_node_psi does.
+
+/**
+ * Get Ψ of all nodes as split real / imaginary arrays
+ */
+IGSOA_API bool igsoa_get_all_psi(
+    IGSOAEngineHandle engine,
+    double* psi_real_out,
+    double* psi_imag_out
+);
+
+/**
+ * Set Ψ of all nodes from split real / imaginary arrays
+ */
+IGSOA_API bool igsoa_set_all_psi(
+    IGSOAEngineHandle engine,
+    const double* psi_real,
+    const double* psi_imag
+);
+
+/**
+ * Get Ψ of all nodes interleaved (Re0, Im0, Re1, Im1, ...; 2*num_nodes doubles),
+ * the memory layout of a complex128 / ComplexF64 array
+ */
+IGSOA_API bool igsoa_get_all_psi_interleaved(
+    IGSOAEngineHandle engine,
+    double* psi_out
+);
+
+/**
+ * Set Ψ of all nodes from an interleaved array (2*num_nodes doubles)
+ */
+IGSOA_API bool igsoa_set_all_psi_interleaved(
+    IGSOAEngineHandle engine,
+    const double* psi
+);
+
+/**
+ * Get Φ of all nodes
+ */
+IGSOA_API bool igsoa_get_all_phi(
+    IGSOAEngineHandle engine,
+    double* phi_out
+);
+
+/**
+ * Set Φ of all nodes
+ */
+IGSOA_API bool igsoa_set_all_phi(
+    IGSOAEngineHandle engine,
+    const double* phi
+);
+
+/**
+ * Get F = |Ψ|² of all nodes
+ */
+IGSOA_API bool igsoa_get_all_F(
+    IGSOAEngineHandle engine,
+    double* F_out
+);
+
+/**
+ * Get one field of nodes [first, first + count)
+ *
+ * @param out Node first + i goes to out[i * stride]
+ * @param stride Element stride in doubles (1 = packed)
+ */
+IGSOA_API bool igsoa_get_field_range(
+    IGSOAEngineHandle engine,
+    IGSOAField field,
+    uint32_t first,
+    uint32_t count,
+    double* out,
+    size_t stride
+);
+
+/**
+ * Set one field (not F) of nodes [first, first + count) from in[i * stride]
+ */
+IGSOA_API bool igsoa_set_field_range(
+    IGSOAEngineHandle engine,
+    IGSOAField field,
+    uint32_t first,
+    uint32_t count,
+    const double* in,
+    size_t stride
+);
+
+/**
+ * Describe one field of every node in place (dase_field_view.h): a 1-D
+ * view of num_nodes elements strided by the node struct size.
+ * IGSOA_FIELD_PSI gives Ψ as complex128; F is read-only.  Ψ written
+ * through a view leaves F and the phase stale until the next mission.
+ *
+ * @param view In: version = DASE_FIELD_VIEW_VERSION; out: the view
+ * @return false for a null handle or view, an unknown field or version
+ */
+IGSOA_API bool igsoa_get_field_view(
+    IGSOAEngineHandle engine,
+    IGSOAField field,
+    DaseFieldView* view
+);
+
 // =============================================================================
 // MISSION EXECUTION
 // =============================================================================
@@ -232,6 +372,104 @@ IGSOA_API uint32_t igsoa_get_num_nodes(IGSOAEngineHandle engine);
  */
 IGSOA_API double igsoa_get_current_time(IGSOAEngineHandle engine);
 
+/**
+ * Set the Ψ mirror precision of the coupling sums
+ *
+ * @param engine Engine handle
+ * @param precision IGSOA_PRECISION_* mode
+ * @return false for a null handle or an unknown mode
+ */
+IGSOA_API bool igsoa_set_precision(IGSOAEngineHandle engine, IGSOAPrecisionMode precision);
+
+/**
+ * Get the Ψ mirror precision (IGSOA_PRECISION_DOUBLE for a null handle)
+ */
+IGSOA_API IGSOAPrecisionMode igsoa_get_precision(IGSOAEngineHandle engine);
+
+// =============================================================================
+// PROBE RECORDERS
+// =============================================================================
+//
+// A probe samples fields at a few nodes inside the mission step loop, every
+// `decimation` steps, into a ring of `capacity` samples preallocated when it
+// is added (a full ring overwrites its oldest sample).  Draining copies
+// samples oldest first: steps_out[s] and
+// values_out[(s * num_fields + f) * num_nodes + p].
+
+/**
+ * Register a probe
+ *
+ * @param engine Engine handle
+ * @param nodes Node indices (0 to num_nodes - 1)
+ * @param num_nodes Number of node indices
+ * @param fields Fields to record (IGSOA_FIELD_*)
+ * @param num_fields Number of fields
+ * @param decimation Sample when the step count is a multiple of this (>= 1)
+ * @param capacity Ring size in samples (>= 1)
+ * @return Probe id (> 0), or -1 for a null handle or an invalid request
+ */
+IGSOA_API int32_t igsoa_add_probe(
+    IGSOAEngineHandle engine,
+    const uint32_t* nodes,
+    uint32_t num_nodes,
+    const IGSOAField* fields,
+    uint32_t num_fields,
+    uint32_t decimation,
+    uint32_t capacity
+);
+
+/**
+ * Samples waiting in a probe's ring (0 for an unknown probe)
+ */
+IGSOA_API size_t igsoa_probe_pending(IGSOAEngineHandle engine, int32_t probe_id);
+
+/**
+ * Move up to max_samples pending samples into caller buffers
+ * (max_samples step stamps, max_samples * num_nodes * num_fields values)
+ *
+ * @param dropped_out Optional: samples overwritten since the last drain
+ * @return Samples copied (0 for an unknown probe or null buffers)
+ */
+IGSOA_API size_t igsoa_drain_probe(
+    IGSOAEngineHandle engine,
+    int32_t probe_id,
+    uint64_t* steps_out,
+    double* values_out,
+    size_t max_samples,
+    uint64_t* dropped_out
+);
+
+/**
+ * Unregister a probe and free its ring
+ *
+ * @return false for a null handle or an unknown probe
+ */
+IGSOA_API bool igsoa_remove_probe(IGSOAEngineHandle engine, int32_t probe_id);
+
+// =============================================================================
+// CHECKPOINT / RESTORE
+// =============================================================================
+
+/**
+ * Write nodes, configuration and clock to a binary checkpoint file
+ * (written beside path, then renamed over it)
+ *
+ * @param engine Engine handle
+ * @param path Checkpoint file path
+ * @return true on success
+ */
+IGSOA_API bool igsoa_checkpoint_engine(IGSOAEngineHandle engine, const char* path);
+
+/**
+ * Load a checkpoint into an engine with the same number of nodes; the
+ * engine is unchanged if the file is missing, corrupt or mismatched
+ *
+ * @param engine Engine handle
+ * @param path Checkpoint file path
+ * @return true on success
+ */
+IGSOA_API bool igsoa_restore_engine(IGSOAEngineHandle engine, const char* path);
+
 #ifdef __cplusplus
 }
 #endif
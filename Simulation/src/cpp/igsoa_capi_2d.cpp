@@ -3,8 +3,10 @@
  */
 
 #include "igsoa_capi_2d.h"
+#include "igsoa_bulk_access.h"
 #include "igsoa_complex_engine_2d.h"
 #include "igsoa_state_init_2d.h"
+#include "engine_checkpoint.h"
 #include <cstring>
 #include <string>
 
@@ -150,21 +152,148 @@ bool igsoa2d_get_all_states(
 ) {
     if (!handle || !psi_real_out || !psi_imag_out || !phi_out) return false;
 
-    try {
-        auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
-        const auto& nodes = engine->getNodes();
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    const auto& nodes = engine->getNodes();
+    const IGSOANodeRegion all = IGSOABulkAccess::whole(engine->getNx(), engine->getNy());
+    return IGSOABulkAccess::gather(nodes, engine->getNx(), engine->getNy(), 1, all,
+                                   IGSOANodeField::PsiReal, psi_real_out) &&
+           IGSOABulkAccess::gather(nodes, engine->getNx(), engine->getNy(), 1, all,
+                                   IGSOANodeField::PsiImag, psi_imag_out) &&
+           IGSOABulkAccess::gather(nodes, engine->getNx(), engine->getNy(), 1, all,
+                                   IGSOANodeField::Phi, phi_out);
+}
 
-        size_t N_total = engine->getTotalNodes();
-        for (size_t i = 0; i < N_total; i++) {
-            psi_real_out[i] = nodes[i].psi.real();
-            psi_imag_out[i] = nodes[i].psi.imag();
-            phi_out[i] = nodes[i].phi;
-        }
+// Set all states
+bool igsoa2d_set_all_states(
+    IGSOA2DEngineHandle handle,
+    const double* psi_real,
+    const double* psi_imag,
+    const double* phi
+) {
+    if (!handle || !psi_real || !psi_imag) return false;
 
-        return true;
-    } catch (...) {
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    auto& nodes = engine->getNodesMutable();
+    const IGSOANodeRegion all = IGSOABulkAccess::whole(engine->getNx(), engine->getNy());
+    if (!IGSOABulkAccess::scatterPsi(nodes, engine->getNx(), engine->getNy(), 1, all,
+                                     psi_real, psi_imag)) {
         return false;
     }
+    return !phi || IGSOABulkAccess::scatter(nodes, engine->getNx(), engine->getNy(), 1, all,
+                                            IGSOANodeField::Phi, phi);
+}
+
+// Get all Ψ, interleaved
+bool igsoa2d_get_all_psi_interleaved(
+    IGSOA2DEngineHandle handle,
+    double* psi_out
+) {
+    if (!handle || !psi_out) return false;
+
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    const auto& nodes = engine->getNodes();
+    const IGSOANodeRegion all = IGSOABulkAccess::whole(engine->getNx(), engine->getNy());
+    IGSOABufferLayout interleaved;
+    interleaved.elem_stride = 2;
+    return IGSOABulkAccess::gather(nodes, engine->getNx(), engine->getNy(), 1, all,
+                                   IGSOANodeField::PsiReal, psi_out, interleaved) &&
+           IGSOABulkAccess::gather(nodes, engine->getNx(), engine->getNy(), 1, all,
+                                   IGSOANodeField::PsiImag, psi_out + 1, interleaved);
+}
+
+// Set all Ψ, interleaved
+bool igsoa2d_set_all_psi_interleaved(
+    IGSOA2DEngineHandle handle,
+    const double* psi
+) {
+    if (!handle || !psi) return false;
+
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    IGSOABufferLayout interleaved;
+    interleaved.elem_stride = 2;
+    return IGSOABulkAccess::scatterPsi(engine->getNodesMutable(), engine->getNx(), engine->getNy(), 1,
+                                       IGSOABulkAccess::whole(engine->getNx(), engine->getNy()),
+                                       psi, psi + 1, interleaved);
+}
+
+// Get all F
+bool igsoa2d_get_all_F(
+    IGSOA2DEngineHandle handle,
+    double* F_out
+) {
+    if (!handle) return false;
+
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return IGSOABulkAccess::gather(engine->getNodes(), engine->getNx(), engine->getNy(), 1,
+                                   IGSOABulkAccess::whole(engine->getNx(), engine->getNy()),
+                                   IGSOANodeField::F, F_out);
+}
+
+// Get one field of a sub-block
+bool igsoa2d_get_field_region(
+    IGSOA2DEngineHandle handle,
+    IGSOAField field,
+    size_t x0,
+    size_t y0,
+    size_t nx,
+    size_t ny,
+    double* out,
+    size_t elem_stride,
+    size_t row_stride
+) {
+    if (!handle) return false;
+
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    IGSOANodeRegion region;
+    region.x0 = x0;
+    region.y0 = y0;
+    region.nx = nx;
+    region.ny = ny;
+    IGSOABufferLayout layout;
+    layout.elem_stride = elem_stride;
+    layout.row_stride = row_stride;
+    return IGSOABulkAccess::gather(engine->getNodes(), engine->getNx(), engine->getNy(), 1,
+                                   region, static_cast<IGSOANodeField>(field), out, layout);
+}
+
+// Set one field of a sub-block
+bool igsoa2d_set_field_region(
+    IGSOA2DEngineHandle handle,
+    IGSOAField field,
+    size_t x0,
+    size_t y0,
+    size_t nx,
+    size_t ny,
+    const double* in,
+    size_t elem_stride,
+    size_t row_stride
+) {
+    if (!handle) return false;
+
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    IGSOANodeRegion region;
+    region.x0 = x0;
+    region.y0 = y0;
+    region.nx = nx;
+    region.ny = ny;
+    IGSOABufferLayout layout;
+    layout.elem_stride = elem_stride;
+    layout.row_stride = row_stride;
+    return IGSOABulkAccess::scatter(engine->getNodesMutable(), engine->getNx(), engine->getNy(), 1,
+                                    region, static_cast<IGSOANodeField>(field), in, layout);
+}
+
+// Zero-copy view of one field
+bool igsoa2d_get_field_view(
+    IGSOA2DEngineHandle handle,
+    IGSOAField field,
+    DaseFieldView* view
+) {
+    if (!handle) return false;
+
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return IGSOABulkAccess::view(engine->getNodesMutable(), static_cast<int>(field), engine->getNx(),
+                                 engine->getNy(), 1, 2, view);
 }
 
 // Initialize circular Gaussian
@@ -273,3 +402,95 @@ double igsoa2d_get_entropy_rate(IGSOA2DEngineHandle handle) {
     auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
     return engine->getTotalEntropyRate();
 }
+
+// Set the Ψ mirror precision
+bool igsoa2d_set_precision(IGSOA2DEngineHandle handle, IGSOAPrecisionMode precision) {
+    if (!handle || precision < IGSOA_PRECISION_DOUBLE || precision > IGSOA_PRECISION_FLOAT) {
+        return false;
+    }
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    engine->setPrecision(static_cast<IGSOAPrecision>(precision));
+    return true;
+}
+
+// Get the Ψ mirror precision
+IGSOAPrecisionMode igsoa2d_get_precision(IGSOA2DEngineHandle handle) {
+    if (!handle) return IGSOA_PRECISION_DOUBLE;
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return static_cast<IGSOAPrecisionMode>(engine->getPrecision());
+}
+
+// Probe recorders
+int32_t igsoa2d_add_probe(
+    IGSOA2DEngineHandle handle,
+    const uint32_t* nodes,
+    uint32_t num_nodes,
+    const IGSOAField* fields,
+    uint32_t num_fields,
+    uint32_t decimation,
+    uint32_t capacity
+) {
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    if (!engine || !nodes || !fields) {
+        return -1;
+    }
+    try {
+        dase::ProbeSpec spec;
+        spec.points.assign(nodes, nodes + num_nodes);
+        for (uint32_t f = 0; f < num_fields; ++f) {
+            spec.fields.push_back(static_cast<int>(fields[f]));
+        }
+        spec.decimation = decimation;
+        spec.capacity = capacity;
+        return engine->probes().add(spec, engine->getNodes().size(), IGSOABulkAccess::kNumFields);
+    } catch (...) {
+        return -1;
+    }
+}
+
+size_t igsoa2d_probe_pending(IGSOA2DEngineHandle handle, int32_t probe_id) {
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine ? engine->probes().pending(probe_id) : 0;
+}
+
+size_t igsoa2d_drain_probe(
+    IGSOA2DEngineHandle handle,
+    int32_t probe_id,
+    uint64_t* steps_out,
+    double* values_out,
+    size_t max_samples,
+    uint64_t* dropped_out
+) {
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine ? engine->probes().drain(probe_id, steps_out, values_out, max_samples, dropped_out) : 0;
+}
+
+bool igsoa2d_remove_probe(IGSOA2DEngineHandle handle, int32_t probe_id) {
+    auto* engine = static_cast<IGSOAComplexEngine2D*>(handle);
+    return engine && engine->probes().remove(probe_id);
+}
+
+// Write a checkpoint
+bool igsoa2d_checkpoint_engine(IGSOA2DEngineHandle handle, const char* path) {
+    if (!handle || !path) return false;
+    try {
+        dase::CheckpointWriter writer;
+        static_cast<const IGSOAComplexEngine2D*>(handle)->saveCheckpoint(writer);
+        writer.write(path);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Restore a checkpoint
+bool igsoa2d_restore_engine(IGSOA2DEngineHandle handle, const char* path) {
+    if (!handle || !path) return false;
+    try {
+        const dase::CheckpointImage image(path);
+        static_cast<IGSOAComplexEngine2D*>(handle)->restoreCheckpoint(image);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
@@ -7,16 +7,45 @@
 
 #pragma once
 
+#include "dase_field_view.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // Opaque handle to 2D engine instance
 typedef void* IGSOA2DEngineHandle;
 
+#ifndef IGSOA_FIELD_DEFINED
+#define IGSOA_FIELD_DEFINED
+/**
+ * Per-node field selector for the bulk access functions (shared with igsoa_capi.h)
+ */
+typedef enum IGSOAField {
+    IGSOA_FIELD_PSI_REAL = 0,   // Re[Ψ]
+    IGSOA_FIELD_PSI_IMAG = 1,   // Im[Ψ]
+    IGSOA_FIELD_PHI = 2,        // Φ
+    IGSOA_FIELD_F = 3,          // F = |Ψ|² (read-only)
+    IGSOA_FIELD_PSI = 4         // Ψ as one complex128 (field views only)
+} IGSOAField;
+#endif
+
+#ifndef IGSOA_PRECISION_DEFINED
+#define IGSOA_PRECISION_DEFINED
+/**
+ * Ψ mirror / coupling-sum precision (IGSOAPrecision; shared with igsoa_capi.h)
+ */
+typedef enum IGSOAPrecisionMode {
+    IGSOA_PRECISION_DOUBLE = 0,       // Double mirror, double sums (default)
+    IGSOA_PRECISION_MIXED_FLOAT = 1,  // Float mirror, double sums
+    IGSOA_PRECISION_FLOAT = 2         // Float mirror, float span sums
+} IGSOAPrecisionMode;
+#endif
+
 /**
  * Create a 2D IGSOA engine
  *
@@ -176,6 +205,99 @@ bool igsoa2d_get_all_states(
     double* phi_out
 );
 
+/**
+ * Set full state (all nodes), row-major like igsoa2d_get_all_states
+ *
+ * @param handle Engine handle
+ * @param psi_real Real parts of Ψ (size: N_x*N_y)
+ * @param psi_imag Imaginary parts of Ψ (size: N_x*N_y)
+ * @param phi Φ values (size: N_x*N_y), or NULL to leave Φ unchanged
+ * @return true on success
+ */
+bool igsoa2d_set_all_states(
+    IGSOA2DEngineHandle handle,
+    const double* psi_real,
+    const double* psi_imag,
+    const double* phi
+);
+
+/**
+ * Get Ψ of all nodes interleaved (Re, Im pairs; size: 2*N_x*N_y), row-major
+ */
+bool igsoa2d_get_all_psi_interleaved(
+    IGSOA2DEngineHandle handle,
+    double* psi_out
+);
+
+/**
+ * Set Ψ of all nodes from an interleaved array (size: 2*N_x*N_y)
+ */
+bool igsoa2d_set_all_psi_interleaved(
+    IGSOA2DEngineHandle handle,
+    const double* psi
+);
+
+/**
+ * Get F = |Ψ|² of all nodes (size: N_x*N_y), row-major
+ */
+bool igsoa2d_get_all_F(
+    IGSOA2DEngineHandle handle,
+    double* F_out
+);
+
+/**
+ * Copy one field of the sub-block [x0, x0+nx) x [y0, y0+ny) out of the engine
+ *
+ * Node (x0+i, y0+j) goes to out[j*row_stride + i*elem_stride].  Strides are
+ * in doubles; row_stride = 0 means packed rows (nx*elem_stride), so
+ * elem_stride = 1, row_stride = 0 is a dense [ny][nx] block.  A row_stride
+ * larger than that writes the block into a wider caller array.
+ *
+ * @return false if the block leaves the lattice or elem_stride is 0
+ */
+bool igsoa2d_get_field_region(
+    IGSOA2DEngineHandle handle,
+    IGSOAField field,
+    size_t x0,
+    size_t y0,
+    size_t nx,
+    size_t ny,
+    double* out,
+    size_t elem_stride,
+    size_t row_stride
+);
+
+/**
+ * Copy one field (not F) of a sub-block into the engine; layout as for
+ * igsoa2d_get_field_region.  Writing Ψ refreshes F.
+ */
+bool igsoa2d_set_field_region(
+    IGSOA2DEngineHandle handle,
+    IGSOAField field,
+    size_t x0,
+    size_t y0,
+    size_t nx,
+    size_t ny,
+    const double* in,
+    size_t elem_stride,
+    size_t row_stride
+);
+
+/**
+ * Describe one field of the lattice in place (dase_field_view.h): dims
+ * (N_y, N_x), strided by the node struct size.  IGSOA_FIELD_PSI gives Ψ as
+ * complex128; F is read-only.  Ψ written through a view leaves F and the
+ * phase stale until the next mission.
+ *
+ * @param view In: version = DASE_FIELD_VIEW_VERSION; out: the view
+ * @return false for a null handle or view, an unknown field or version
+ */
+bool igsoa2d_get_field_view(
+    IGSOA2DEngineHandle handle,
+    IGSOAField field,
+    DaseFieldView* view
+);
+
 /**
  * Initialize 2D circular Gaussian profile
  *
@@ -263,6 +385,91 @@ double igsoa2d_get_total_energy(IGSOA2DEngineHandle handle);
  */
 double igsoa2d_get_entropy_rate(IGSOA2DEngineHandle handle);
 
+/**
+ * Set the Ψ mirror precision of the coupling sums
+ *
+ * @param handle Engine handle
+ * @param precision IGSOA_PRECISION_* mode
+ * @return false for a null handle or an unknown mode
+ */
+bool igsoa2d_set_precision(IGSOA2DEngineHandle handle, IGSOAPrecisionMode precision);
+
+/**
+ * Get the Ψ mirror precision (IGSOA_PRECISION_DOUBLE for a null handle)
+ */
+IGSOAPrecisionMode igsoa2d_get_precision(IGSOA2DEngineHandle handle);
+
+/**
+ * Register a probe sampled inside igsoa2d_run_mission's step loop (see
+ * igsoa_capi.h PROBE RECORDERS for the ring and drain layout)
+ *
+ * @param handle Engine handle
+ * @param nodes Node indices (y * N_x + x)
+ * @param num_nodes Number of node indices
+ * @param fields Fields to record (IGSOA_FIELD_*)
+ * @param num_fields Number of fields
+ * @param decimation Sample when the step count is a multiple of this (>= 1)
+ * @param capacity Ring size in samples (>= 1)
+ * @return Probe id (> 0), or -1 for a null handle or an invalid request
+ */
+int32_t igsoa2d_add_probe(
+    IGSOA2DEngineHandle handle,
+    const uint32_t* nodes,
+    uint32_t num_nodes,
+    const IGSOAField* fields,
+    uint32_t num_fields,
+    uint32_t decimation,
+    uint32_t capacity
+);
+
+/**
+ * Samples waiting in a probe's ring (0 for an unknown probe)
+ */
+size_t igsoa2d_probe_pending(IGSOA2DEngineHandle handle, int32_t probe_id);
+
+/**
+ * Move up to max_samples pending samples into caller buffers
+ * (max_samples step stamps, max_samples * num_nodes * num_fields values)
+ *
+ * @param dropped_out Optional: samples overwritten since the last drain
+ * @return Samples copied (0 for an unknown probe or null buffers)
+ */
+size_t igsoa2d_drain_probe(
+    IGSOA2DEngineHandle handle,
+    int32_t probe_id,
+    uint64_t* steps_out,
+    double* values_out,
+    size_t max_samples,
+    uint64_t* dropped_out
+);
+
+/**
+ * Unregister a probe and free its ring
+ *
+ * @return false for a null handle or an unknown probe
+ */
+bool igsoa2d_remove_probe(IGSOA2DEngineHandle handle, int32_t probe_id);
+
+/**
+ * Write nodes, configuration and clock to a binary checkpoint file
+ * (written beside path, then renamed over it)
+ *
+ * @param handle Engine handle
+ * @param path Checkpoint file path
+ * @return true on success
+ */
+bool igsoa2d_checkpoint_engine(IGSOA2DEngineHandle handle, const char* path);
+
+/**
+ * Load a checkpoint into an engine with the same lattice; the engine is
+ * unchanged if the file is missing, corrupt or mismatched
+ *
+ * @param handle Engine handle
+ * @param path Checkpoint file path
+ * @return true on success
+ */
+bool igsoa2d_restore_engine(IGSOA2DEngineHandle handle, const char* path);
+
 #ifdef __cplusplus
 }
 #endif
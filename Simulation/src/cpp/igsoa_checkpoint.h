@@ -0,0 +1,138 @@
+/**
+ * IGSOA Checkpoint Sections
+ *
+ * Shared by the 1D/2D/3D IGSOA engines' saveCheckpoint / restoreCheckpoint
+ * (engine_checkpoint.h).  A checkpoint holds the node array verbatim
+ * (every field, including psi_dot, phi_dot and the derived diagnostics),
+ * the tunable configuration, the lattice shape and the clock:
+ *
+ *   igsoa.nodes      IGSOAComplexNode records
+ *   igsoa.config     f64 [R_c_default, kappa, gamma, dt, normalize_psi,
+ *                         update_mode, coupling_mode, fft_min_R_c,
+ *                         simd_coupling, omp_min_nodes]
+ *   igsoa.dims       u64 [N_x, N_y, N_z]
+ *   igsoa.clock      f64 [current_time]
+ *   igsoa.counters   u64 [total_steps, total_operations]
+ *   igsoa.integrator f64 [integrator]  (absent in older images: Euler)
+ *   igsoa.precision  f64 [precision]   (absent in older images: Double)
+ *   igsoa.sparse     f64 [sparse_threshold, sparse_block]  (absent: dense)
+ *
+ * num_nodes and NUMA placement stay those of the restoring engine.
+ */
+
+#pragma once
+
+#include "engine_checkpoint.h"
+#include "igsoa_complex_node.h"
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+static_assert(std::is_trivially_copyable<IGSOAComplexNode>::value,
+              "IGSOA nodes are checkpointed as raw records");
+
+struct IGSOACheckpoint {
+    static constexpr size_t kConfigValues = 10;
+
+    // Add the sections of an engine (nodes must outlive writer.write())
+    static void save(CheckpointWriter& writer,
+                     const IGSOAComplexConfig& config,
+                     const std::vector<IGSOAComplexNode>& nodes,
+                     uint64_t N_x, uint64_t N_y, uint64_t N_z,
+                     double current_time,
+                     uint64_t total_steps,
+                     uint64_t total_operations) {
+        writer.addRecords("igsoa.nodes", nodes);
+        writer.addValues("igsoa.config", {
+            config.R_c_default,
+            config.kappa,
+            config.gamma,
+            config.dt,
+            config.normalize_psi ? 1.0 : 0.0,
+            static_cast<double>(config.update_mode),
+            static_cast<double>(config.coupling_mode),
+            config.fft_min_R_c,
+            config.simd_coupling ? 1.0 : 0.0,
+            static_cast<double>(config.omp_min_nodes)
+        });
+        writer.addValues("igsoa.dims", {N_x, N_y, N_z});
+        writer.addValues("igsoa.clock", {current_time});
+        writer.addValues("igsoa.counters", {total_steps, total_operations});
+        writer.addValues("igsoa.integrator", {static_cast<double>(config.integrator)});
+        writer.addValues("igsoa.precision", {static_cast<double>(config.precision)});
+        writer.addValues("igsoa.sparse", {config.sparse_threshold, static_cast<double>(config.sparse_block)});
+    }
+
+    /**
+     * Load an image into an engine of the same shape
+     * @throws std::runtime_error on a shape mismatch or a malformed image
+     */
+    static void restore(const CheckpointImage& image,
+                        IGSOAComplexConfig& config,
+                        std::vector<IGSOAComplexNode>& nodes,
+                        uint64_t N_x, uint64_t N_y, uint64_t N_z,
+                        double& current_time,
+                        uint64_t& total_steps,
+                        uint64_t& total_operations) {
+        uint64_t saved_dims[3] = {};
+        image.readU64("igsoa.dims", saved_dims, 3);
+        if (saved_dims[0] != N_x || saved_dims[1] != N_y || saved_dims[2] != N_z) {
+            throw std::runtime_error("Checkpoint lattice is " + std::to_string(saved_dims[0]) + "x" +
+                                     std::to_string(saved_dims[1]) + "x" + std::to_string(saved_dims[2]) +
+                                     ", engine lattice differs");
+        }
+
+        double values[kConfigValues] = {};
+        uint64_t counters[2] = {};
+        double clock = 0.0;
+        image.readF64("igsoa.config", values, kConfigValues);
+        image.readF64("igsoa.clock", &clock, 1);
+        image.readU64("igsoa.counters", counters, 2);
+        image.readRecords("igsoa.nodes", nodes);
+
+        config.R_c_default = values[0];
+        config.kappa = values[1];
+        config.gamma = values[2];
+        config.dt = values[3];
+        config.normalize_psi = values[4] != 0.0;
+        config.update_mode = static_cast<IGSOAUpdateMode>(static_cast<int>(values[5]));
+        config.coupling_mode = static_cast<IGSOACouplingMode>(static_cast<int>(values[6]));
+        config.fft_min_R_c = values[7];
+        config.simd_coupling = values[8] != 0.0;
+        config.omp_min_nodes = static_cast<size_t>(values[9]);
+        double integrator = 0.0;
+        if (image.has("igsoa.integrator")) {
+            image.readF64("igsoa.integrator", &integrator, 1);
+            if (integrator != 0.0 && integrator != 1.0 && integrator != 2.0) {
+                throw std::runtime_error("Checkpoint integrator " + std::to_string(integrator) + " is unknown");
+            }
+        }
+        config.integrator = static_cast<IGSOAIntegrator>(static_cast<int>(integrator));
+        double precision = 0.0;
+        if (image.has("igsoa.precision")) {
+            image.readF64("igsoa.precision", &precision, 1);
+            if (precision != 0.0 && precision != 1.0 && precision != 2.0) {
+                throw std::runtime_error("Checkpoint precision " + std::to_string(precision) + " is unknown");
+            }
+        }
+        config.precision = static_cast<IGSOAPrecision>(static_cast<int>(precision));
+        double sparse[2] = {0.0, 8.0};
+        if (image.has("igsoa.sparse")) {
+            image.readF64("igsoa.sparse", sparse, 2);
+            if (sparse[0] < 0.0 || sparse[1] < 1.0) {
+                throw std::runtime_error("Checkpoint sparse settings are invalid");
+            }
+        }
+        config.sparse_threshold = sparse[0];
+        config.sparse_block = static_cast<uint32_t>(sparse[1]);
+        current_time = clock;
+        total_steps = counters[0];
+        total_operations = counters[1];
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -15,6 +15,15 @@
 
 #include "igsoa_complex_node.h"
 #include "igsoa_physics.h"
+#include "igsoa_state_soa.h"
+#include "igsoa_checkpoint.h"
+#include "igsoa_step_traffic.h"
+#include "igsoa_adaptive_mission.h"
+#include "igsoa_bulk_access.h"
+#include "observable_recorder.h"
+#include "probe_recorder.h"
+#include "step_loop.h"
+#include <algorithm>
 #include <vector>
 #include <memory>
 #include <chrono>
@@ -37,17 +46,19 @@ public:
      */
     explicit IGSOAComplexEngine(const IGSOAComplexConfig& config)
         : config_(config)
-        , nodes_(config.num_nodes)
         , current_time_(0.0)
         , total_steps_(0)
         , total_operations_(0)
     {
-        // Initialize all nodes with configuration
-        for (auto& node : nodes_) {
-            node.R_c = config.R_c_default;
-            node.kappa = config.kappa;
-            node.gamma = config.gamma;
-        }
+        // Initialize all nodes with configuration (pin threads first so
+        // first-touch placement matches the kernels)
+        IGSOAComplexNode prototype;
+        prototype.R_c = config.R_c_default;
+        prototype.kappa = config.kappa;
+        prototype.gamma = config.gamma;
+        NumaPlacement::applyThreadAffinity(config.numa.thread_affinity);
+        state_page_bytes_ = NumaPlacement::allocate(nodes_, config.num_nodes, config.numa, prototype);
+        soa_.allocate(config.num_nodes, config.numa);
     }
 
     /**
@@ -78,6 +89,67 @@ public:
         return total_operations_;
     }
 
+    /**
+     * Select Ψ update ordering (InPlace = legacy, DoubleBuffered = Jacobi)
+     */
+    void setUpdateMode(IGSOAUpdateMode mode) { config_.update_mode = mode; }
+    IGSOAUpdateMode getUpdateMode() const { return config_.update_mode; }
+
+    /**
+     * Select the Ψ time integrator (Euler = legacy, RK2/RK4 = larger stable dt)
+     */
+    void setIntegrator(IGSOAIntegrator integrator) { config_.integrator = integrator; }
+    IGSOAIntegrator getIntegrator() const { return config_.integrator; }
+
+    /**
+     * Select the Ψ mirror precision of the coupling sums (see IGSOAPrecision)
+     */
+    void setPrecision(IGSOAPrecision precision) { config_.precision = precision; }
+    IGSOAPrecision getPrecision() const { return config_.precision; }
+
+    /**
+     * Select the coupling law K(r, R_c) (see igsoa_kernel_policy.h); the
+     * coupling tables are rebuilt from it by the next mission
+     */
+    void setKernelPolicy(IGSOAKernelPolicy policy) { config_.kernel_policy = policy; }
+    IGSOAKernelPolicy getKernelPolicy() const { return config_.kernel_policy; }
+
+    /**
+     * Probes sampled inside runMission's step loop (probe_recorder.h; field
+     * ids are IGSOANodeField, points are node indices)
+     */
+    ProbeRecorder& probes() { return probes_; }
+    const ProbeRecorder& probes() const { return probes_; }
+
+    /**
+     * Reductions evaluated inside runMission's step loop like the probes
+     * (observable_recorder.h; field ids are IGSOANodeField)
+     */
+    ObservableRecorder& observables() { return observables_; }
+    const ObservableRecorder& observables() const { return observables_; }
+
+    /**
+     * Bytes held by node storage and the SoA mirror (state), the integrator
+     * stages (scratch) and the step-doubling and probe buffers (history)
+     */
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint bytes = soa_.footprint();
+        bytes.state += capacityBytes(nodes_);
+        bytes.history += adaptive_.memoryBytes() + probes_.memoryBytes() + observables_.memoryBytes();
+        return bytes;
+    }
+
+    size_t getMemoryUsage() const { return static_cast<size_t>(memoryFootprint().total()); }
+
+    /**
+     * memoryFootprint() of an engine built from `config` once it has stepped
+     */
+    static MemoryFootprint estimateMemory(const IGSOAComplexConfig& config) {
+        MemoryFootprint bytes = IGSOAStateSoA::estimate(config.num_nodes, config.integrator, config.precision);
+        bytes.state += static_cast<uint64_t>(config.num_nodes) * sizeof(IGSOAComplexNode);
+        return bytes;
+    }
+
     /**
      * Set quantum state for a specific node
      *
@@ -143,6 +215,7 @@ public:
      */
     double getNodeF(size_t index) const {
         if (index < nodes_.size()) {
+            ensureDerived();
             return nodes_[index].F;
         }
         return 0.0;
@@ -154,8 +227,10 @@ public:
      * @param num_steps Number of time steps to execute
      * @param input_signals Optional driving signals (length: num_steps)
      * @param control_patterns Optional control patterns (length: num_steps)
+     * @return Steps run: num_steps, or fewer when a trigger interrupts
+     *         (ObservableRecorder::interrupted) after its step
      */
-    void runMission(
+    uint64_t runMission(
         uint64_t num_steps,
         const double* input_signals = nullptr,
         const double* control_patterns = nullptr
@@ -163,23 +238,52 @@ public:
         auto start_time = std::chrono::high_resolution_clock::now();
         uint64_t operations_this_run = 0;
 
-        for (uint64_t step = 0; step < num_steps; step++) {
-            // Apply driving signals if provided
-            if (input_signals && control_patterns) {
-                IGSOAPhysics::applyDriving(
-                    nodes_,
-                    input_signals[step],
-                    control_patterns[step]
-                );
-                operations_this_run += static_cast<uint64_t>(nodes_.size());
+        const bool driven = input_signals && control_patterns;
+        if (!probes_.active() && !observables_.active()) {
+            // Nothing to sample between steps: one team for the whole mission
+            // (step_loop.h) instead of a parallel region per step
+            IGSOAPhysics::prepareStep(nodes_, soa_, config_);
+            StepLoop::run(num_steps, nodes_.size() >= config_.omp_min_nodes,
+                [&](uint64_t step) {
+                    // Driving signals, if provided, are applied by the step's Ψ gather
+                    std::complex<double> drive;
+                    if (driven) {
+                        drive = std::complex<double>(input_signals[step], control_patterns[step]);
+                    }
+                    return IGSOAPhysics::stepPhases(nodes_, soa_, config_, false, driven ? &drive : nullptr);
+                },
+                [&](uint64_t) {
+                    if (driven) {
+                        operations_this_run += static_cast<uint64_t>(nodes_.size());
+                    }
+                    state_epoch_++;
+                    current_time_ += config_.dt;
+                    total_steps_++;
+                    return true;
+                },
+                operations_this_run);
+        } else {
+            for (uint64_t step = 0; step < num_steps; step++) {
+                // Driving signals, if provided, are applied by the step's Ψ gather
+                std::complex<double> drive;
+                if (driven) {
+                    drive = std::complex<double>(input_signals[step], control_patterns[step]);
+                    operations_this_run += static_cast<uint64_t>(nodes_.size());
+                }
+
+                // Execute one time step
+                operations_this_run += IGSOAPhysics::timeStep(nodes_, soa_, config_, false, driven ? &drive : nullptr);
+                state_epoch_++;
+
+                // Update counters
+                current_time_ += config_.dt;
+                total_steps_++;
+                recordProbes();
+                if (observables_.interrupted()) {
+                    num_steps = step + 1;
+                    break;
+                }
             }
-
-            // Execute one time step
-            operations_this_run += IGSOAPhysics::timeStep(nodes_, config_);
-
-            // Update counters
-            current_time_ += config_.dt;
-            total_steps_++;
         }
 
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -188,11 +292,57 @@ public:
         // Update performance metrics
         total_operations_ += operations_this_run;
         last_execution_time_ns_ = duration.count();
+        last_mission_steps_ = num_steps;
+        last_step_traffic_ = IGSOAStepTraffic::model(
+            config_, nodes_.size(), 1,
+            IGSOAStepTraffic::couplingTerms1D(nodes_.empty() ? 0.0 : nodes_[0].R_c, nodes_.size()),
+            false, driven, true, true);
 
         if (operations_this_run > 0) {
             ns_per_op_ = static_cast<double>(duration.count()) / operations_this_run;
             ops_per_sec_ = 1.0e9 / ns_per_op_;
         }
+        return num_steps;
+    }
+
+    /**
+     * Run mission to a simulated time with adaptive dt (igsoa_adaptive_mission.h)
+     *
+     * @param duration Simulated time to advance
+     * @param options dt bounds and error tolerance
+     * @param driving Optional driving samples on a simulated-time grid
+     * @return Accepted/rejected step counts of this run
+     */
+    AdaptiveStepStats runMissionAdaptive(
+        double duration,
+        const AdaptiveStepOptions& options,
+        const IGSOADrivingSchedule& driving = IGSOADrivingSchedule()
+    ) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        uint64_t operations_this_run = 0;
+        const AdaptiveStepStats stats = adaptive_.run(
+            nodes_, config_, duration, options, driving, current_time_, total_steps_, operations_this_run,
+            [this]() {
+                state_epoch_++;
+                return IGSOAPhysics::timeStep(nodes_, soa_, config_, false);
+            });
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+
+        total_operations_ += operations_this_run;
+        last_execution_time_ns_ = elapsed.count();
+        last_mission_steps_ = stats.accepted_steps;
+        last_step_traffic_ = IGSOAStepTraffic::model(
+            config_, nodes_.size(), 1,
+            IGSOAStepTraffic::couplingTerms1D(nodes_.empty() ? 0.0 : nodes_[0].R_c, nodes_.size()),
+            false, driving.active(), true);
+
+        if (operations_this_run > 0) {
+            ns_per_op_ = static_cast<double>(elapsed.count()) / operations_this_run;
+            ops_per_sec_ = 1.0e9 / ns_per_op_;
+        }
+        return stats;
     }
 
     /**
@@ -215,11 +365,29 @@ public:
         out_total_ops = total_operations_;
     }
 
+    /**
+     * Page size backing the node state (config.numa.huge_pages, see
+     * NumaPlacement::allocate)
+     */
+    size_t getStatePageSize() const {
+        return state_page_bytes_;
+    }
+
+    /**
+     * Modelled bytes / FLOPs per step of the last mission and the rates
+     * it achieved (igsoa_step_traffic.h); invalid before the first mission
+     */
+    KernelRoofline getRoofline() const {
+        return kernelRoofline(last_step_traffic_, last_mission_steps_,
+                              static_cast<double>(last_execution_time_ns_) * 1.0e-9);
+    }
+
     /**
      * Compute total system energy
      * E = ∑_i [|Ψ_i|² + Φ_i²]
      */
     double getTotalEnergy() const {
+        ensureDerived();
         return IGSOAPhysics::computeTotalEnergy(nodes_);
     }
 
@@ -228,6 +396,7 @@ public:
      * Ṡ_total = ∑_i Ṡ_i
      */
     double getTotalEntropyRate() const {
+        ensureDerived();
         return IGSOAPhysics::computeTotalEntropyRate(nodes_);
     }
 
@@ -236,10 +405,10 @@ public:
      * <F> = (1/N) ∑_i |Ψ_i|²
      */
     double getAverageInformationalDensity() const {
-        double sum = 0.0;
-        for (const auto& node : nodes_) {
-            sum += node.F;
-        }
+        ensureDerived();
+        const double sum = reproducibleSum(static_cast<int64_t>(nodes_.size()),
+                                           [this](int64_t i) { return nodes_[static_cast<size_t>(i)].F; },
+                                           nodes_.size() >= config_.omp_min_nodes);
         return sum / nodes_.size();
     }
 
@@ -248,10 +417,10 @@ public:
      * <θ> = (1/N) ∑_i arg(Ψ_i)
      */
     double getAveragePhase() const {
-        double sum = 0.0;
-        for (const auto& node : nodes_) {
-            sum += node.phase;
-        }
+        ensureDerived();
+        const double sum = reproducibleSum(static_cast<int64_t>(nodes_.size()),
+                                           [this](int64_t i) { return nodes_[static_cast<size_t>(i)].phase; },
+                                           nodes_.size() >= config_.omp_min_nodes);
         return sum / nodes_.size();
     }
 
@@ -272,18 +441,42 @@ public:
             node.harmonic_count = 0;
         }
 
+        derived_epoch_ = state_epoch_;
         current_time_ = 0.0;
         total_steps_ = 0;
         total_operations_ = 0;
         ns_per_op_ = 0.0;
         ops_per_sec_ = 0.0;
         last_execution_time_ns_ = 0;
+        last_mission_steps_ = 0;
+        last_step_traffic_ = KernelTraffic();
+    }
+
+    /**
+     * Reset to the state of a freshly constructed engine with new scalar
+     * parameters on the same lattice
+     *
+     * Keeps the node allocation (and its page placement) and the coupling
+     * caches, which rebuild on their own when the uniform R_c changes.
+     */
+    void reconfigure(double R_c, double kappa, double gamma, double dt) {
+        config_.R_c_default = R_c;
+        config_.kappa = kappa;
+        config_.gamma = gamma;
+        config_.dt = dt;
+        IGSOAComplexNode prototype;
+        prototype.R_c = R_c;
+        prototype.kappa = kappa;
+        prototype.gamma = gamma;
+        std::fill(nodes_.begin(), nodes_.end(), prototype);
+        reset();
     }
 
     /**
      * Get direct access to nodes (for advanced use)
      */
     const std::vector<IGSOAComplexNode>& getNodes() const {
+        ensureDerived();
         return nodes_;
     }
 
@@ -291,12 +484,68 @@ public:
      * Get mutable access to nodes (for advanced use)
      */
     std::vector<IGSOAComplexNode>& getNodesMutable() {
+        ensureDerived();
         return nodes_;
     }
 
+    /**
+     * Bring the derived fields (F, T_IGS, phase, Ṡ, F_gradient) up to date
+     *
+     * runMission steps skip them (IGSOAPhysics::timeStep with derived =
+     * false): nothing in the dynamics reads them, and the per-node atan2 of
+     * the phase was a large share of a 1D step.  Every reader above calls
+     * this; the first read after a mission pays one parallel pass.
+     */
+    void ensureDerived() const {
+        if (derived_epoch_ == state_epoch_) {
+            return;
+        }
+        IGSOAPhysics::refreshDerived(nodes_, soa_, config_);
+        derived_epoch_ = state_epoch_;
+    }
+
+    /**
+     * Add this engine's state to a checkpoint (igsoa_checkpoint.h); the
+     * engine must not step until writer.write() returns
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        ensureDerived();
+        IGSOACheckpoint::save(writer, config_, nodes_, nodes_.size(), 1, 1,
+                              current_time_, total_steps_, total_operations_);
+    }
+
+    /**
+     * Restore a checkpoint of an engine with the same lattice
+     * @throws std::runtime_error if the image does not fit this engine
+     */
+    void restoreCheckpoint(const CheckpointImage& image) {
+        IGSOACheckpoint::restore(image, config_, nodes_, nodes_.size(), 1, 1,
+                                 current_time_, total_steps_, total_operations_);
+        derived_epoch_ = state_epoch_;
+    }
+
 private:
+    // Sample the probes and observables due at the current step count
+    void recordProbes() {
+        if (!probes_.active() && !observables_.active()) return;
+        const int derived = static_cast<int>(IGSOANodeField::F);
+        if (probes_.due(total_steps_, derived) || observables_.due(total_steps_, derived)) ensureDerived();
+        auto sample = [this](uint64_t i, int field) {
+            return IGSOABulkAccess::value(nodes_[i], static_cast<IGSOANodeField>(field));
+        };
+        probes_.record(total_steps_, sample);
+        observables_.record(total_steps_, sample);
+    }
+
     IGSOAComplexConfig config_;
-    std::vector<IGSOAComplexNode> nodes_;
+    mutable std::vector<IGSOAComplexNode> nodes_;  // Derived fields refreshed by const reads
+    mutable IGSOAStateSoA soa_;  // Packed neighbour-read mirror of nodes_ (hot path)
+    size_t state_page_bytes_ = 0;  // Page size backing nodes_
+    IGSOAAdaptiveMission adaptive_;  // Step-doubling buffers for runMissionAdaptive
+    ProbeRecorder probes_;  // Per-step samples of selected nodes
+    ObservableRecorder observables_;  // Per-step reductions of the lattice
+    uint64_t state_epoch_ = 0;              // Lazy steps taken
+    mutable uint64_t derived_epoch_ = 0;    // state_epoch_ of the derived fields
 
     // Simulation state
     double current_time_;
@@ -307,6 +556,8 @@ private:
     double ns_per_op_ = 0.0;
     double ops_per_sec_ = 0.0;
     int64_t last_execution_time_ns_ = 0;
+    uint64_t last_mission_steps_ = 0;
+    KernelTraffic last_step_traffic_;  // Model of one step of the last mission
 };
 
 } // namespace igsoa
@@ -20,6 +20,20 @@
 
 #include "igsoa_complex_node.h"
 #include "igsoa_physics_2d.h"
+#include "igsoa_state_soa.h"
+#include "igsoa_checkpoint.h"
+#include "igsoa_step_traffic.h"
+#include "igsoa_adaptive_mission.h"
+#include "igsoa_burn_in.h"
+#include "igsoa_bulk_access.h"
+#include "observable_recorder.h"
+#include "probe_recorder.h"
+#include "igsoa_temporal_blocking.h"
+#include "igsoa_activity_mask.h"
+#include "igsoa_fft_coupling.h"
+#include "igsoa_neighbor_graph.h"
+#include "neighbor_cache.h"
+#include <algorithm>
 #include <vector>
 #include <stdexcept>
 #include <memory>
@@ -48,7 +62,6 @@ public:
         : config_(config)
         , N_x_(N_x)
         , N_y_(N_y)
-        , nodes_(N_x * N_y)
         , current_time_(0.0)
         , total_steps_(0)
         , total_operations_(0)
@@ -65,12 +78,15 @@ public:
             throw std::invalid_argument("Total nodes exceeds limit (100M max)");
         }
 
-        // Initialize all nodes with configuration
-        for (auto& node : nodes_) {
-            node.R_c = config.R_c_default;
-            node.kappa = config.kappa;
-            node.gamma = config.gamma;
-        }
+        // Initialize all nodes with configuration (pin threads first so
+        // first-touch placement matches the kernels)
+        IGSOAComplexNode prototype;
+        prototype.R_c = config.R_c_default;
+        prototype.kappa = config.kappa;
+        prototype.gamma = config.gamma;
+        NumaPlacement::applyThreadAffinity(config.numa.thread_affinity);
+        state_page_bytes_ = NumaPlacement::allocate(nodes_, total, config.numa, prototype);
+        soa_.allocate(total, config.numa);
     }
 
     /**
@@ -123,6 +139,113 @@ public:
         return total_operations_;
     }
 
+    /**
+     * Select Ψ update ordering (InPlace = legacy, DoubleBuffered = Jacobi)
+     */
+    void setUpdateMode(IGSOAUpdateMode mode) { config_.update_mode = mode; }
+    IGSOAUpdateMode getUpdateMode() const { return config_.update_mode; }
+
+    /**
+     * Select the Ψ time integrator (Euler = legacy, RK2/RK4 = larger stable dt)
+     */
+    void setIntegrator(IGSOAIntegrator integrator) { config_.integrator = integrator; }
+    IGSOAIntegrator getIntegrator() const { return config_.integrator; }
+
+    /**
+     * Select the Ψ mirror precision of the coupling sums (see IGSOAPrecision)
+     */
+    void setPrecision(IGSOAPrecision precision) { config_.precision = precision; }
+    IGSOAPrecision getPrecision() const { return config_.precision; }
+
+    /**
+     * Select the coupling law K(r, R_c) (see igsoa_kernel_policy.h); the
+     * coupling tables are rebuilt from it by the next mission
+     */
+    void setKernelPolicy(IGSOAKernelPolicy policy) { config_.kernel_policy = policy; }
+    IGSOAKernelPolicy getKernelPolicy() const { return config_.kernel_policy; }
+
+    /**
+     * Probes sampled inside runMission's step loop (probe_recorder.h; field
+     * ids are IGSOANodeField, points are node indices).  While any probe is
+     * registered, missions step one step at a time (no temporal blocking).
+     */
+    ProbeRecorder& probes() { return probes_; }
+    const ProbeRecorder& probes() const { return probes_; }
+
+    /**
+     * Reductions evaluated inside runMission's step loop like the probes
+     * (observable_recorder.h; field ids are IGSOANodeField)
+     */
+    ObservableRecorder& observables() { return observables_; }
+    const ObservableRecorder& observables() const { return observables_; }
+
+    /**
+     * Steps per temporally blocked pass (1 = per-step; igsoa_temporal_blocking.h)
+     */
+    void setTemporalBlockSteps(uint32_t steps) { config_.temporal_block_steps = steps; }
+    uint32_t getTemporalBlockSteps() const { return config_.temporal_block_steps; }
+
+    /**
+     * Sparse Euler evolution (igsoa_activity_mask.h): skip the Ψ updates of
+     * sparse_block-sized blocks whose neighbourhood is below threshold
+     * (0 = dense).  Disables temporal blocking and the GPU backend.
+     */
+    void setSparseEvolution(double threshold, uint32_t block = 8) {
+        config_.sparse_threshold = threshold;
+        config_.sparse_block = block;
+    }
+    double getSparseThreshold() const { return config_.sparse_threshold; }
+    uint32_t getSparseBlock() const { return config_.sparse_block; }
+
+    // Share of the node updates the last mission skipped (0 when dense)
+    double getSparseSkippedFraction() const { return sparse_.skippedFraction(); }
+
+    /**
+     * Select coupling evaluation (Stencil = precomputed table for uniform R_c)
+     */
+    void setCouplingMode(IGSOACouplingMode mode) { config_.coupling_mode = mode; }
+    IGSOACouplingMode getCouplingMode() const { return config_.coupling_mode; }
+
+    /**
+     * Bytes held by node storage and the SoA mirror (state), the coupling
+     * stencil, graph and FFT buffers (caches), the step-doubling and probe
+     * buffers (history) and the stage, tile and activity buffers (scratch).
+     * Device memory is excluded.
+     */
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint bytes = soa_.footprint();
+        bytes.state += capacityBytes(nodes_);
+        bytes.caches += stencil_.getMemoryUsage() + graph_.getMemoryUsage() + spectral_.getMemoryUsage();
+        bytes.history += adaptive_.memoryBytes() + probes_.memoryBytes() + observables_.memoryBytes();
+        bytes.scratch += blocking_.memoryBytes() + sparse_.memoryBytes();
+        return bytes;
+    }
+
+    size_t getMemoryUsage() const { return static_cast<size_t>(memoryFootprint().total()); }
+
+    /**
+     * memoryFootprint() of an engine built from `config` once it has stepped
+     * (uniform R_c_default: the Stencil-mode table or the FFT backend it
+     * would select, no per-node graph)
+     */
+    static MemoryFootprint estimateMemory(const IGSOAComplexConfig& config, size_t N_x, size_t N_y) {
+        const size_t total = N_x * N_y;
+        MemoryFootprint bytes = IGSOAStateSoA::estimate(total, config.integrator, config.precision);
+        bytes.state += static_cast<uint64_t>(total) * sizeof(IGSOAComplexNode);
+        const bool spectral = IGSOASpectralCoupling::isAvailable() &&
+                              config.update_mode == IGSOAUpdateMode::DoubleBuffered &&
+                              config.R_c_default >= config.fft_min_R_c;
+        if (spectral || config.coupling_mode == IGSOACouplingMode::Stencil) {
+            NeighborStencil2D probe;
+            probe.build(N_x, N_y, config.R_c_default);
+            bytes.caches += probe.getMemoryUsage();
+        }
+        if (spectral) {
+            bytes.caches += IGSOASpectralCoupling::estimateBytes(total);
+        }
+        return bytes;
+    }
+
     /**
      * Set quantum state for a specific node (2D coordinates)
      *
@@ -181,6 +304,7 @@ public:
     double getNodeF(size_t x, size_t y) const {
         size_t index = coordToIndex(x, y);
         if (index < nodes_.size()) {
+            ensureDerived();
             return nodes_[index].F;
         }
         return 0.0;
@@ -192,32 +316,57 @@ public:
      * @param num_steps Number of time steps to execute
      * @param input_signals Optional driving signals (length: num_steps)
      * @param control_patterns Optional control patterns (length: num_steps)
+     * @return Steps run: num_steps, or fewer when a trigger interrupts
+     *         (ObservableRecorder::interrupted) after its step
      */
-    void runMission(
+    uint64_t runMission(
         uint64_t num_steps,
         const double* input_signals = nullptr,
         const double* control_patterns = nullptr
     ) {
         auto start_time = std::chrono::high_resolution_clock::now();
         uint64_t operations_this_run = 0;
+        sparse_.beginMission();
+        const NeighborStencil2D* stencil = prepareStencil();
+        const IGSOANeighborGraph2D* graph = prepareGraph(stencil);
+        IGSOASpectralCoupling* spectral = prepareSpectral();
+        uint64_t first_step = 0;
+
+        // Temporally blocked head; the last step runs per-step so the
+        // (lazily refreshed) derived fields are exact (igsoa_temporal_blocking.h)
+        if (num_steps > 2 && !probes_.active() && !observables_.active() && IGSOATemporalBlocking::supported(
+                config_, stencil ? stencil->size() : 0, spectral != nullptr)) {
+            first_step = num_steps - 1;
+            operations_this_run += blocking_.run<2>(
+                nodes_, config_, N_x_, N_y_, 1, *stencil, first_step, input_signals, control_patterns);
+            for (uint64_t step = 0; step < first_step; step++) {
+                current_time_ += config_.dt;
+            }
+            total_steps_ += first_step;
+        }
 
-        for (uint64_t step = 0; step < num_steps; step++) {
-            // Apply driving signals if provided
-            if (input_signals && control_patterns) {
-                IGSOAPhysics2D::applyDriving(
-                    nodes_,
-                    input_signals[step],
-                    control_patterns[step]
-                );
+        const bool driven = input_signals && control_patterns;
+        for (uint64_t step = first_step; step < num_steps; step++) {
+            // Driving signals, if provided, are applied by the step's Ψ gather
+            std::complex<double> drive;
+            if (driven) {
+                drive = std::complex<double>(input_signals[step], control_patterns[step]);
                 operations_this_run += static_cast<uint64_t>(nodes_.size());
             }
 
             // Execute one time step (2D version)
-            operations_this_run += IGSOAPhysics2D::timeStep(nodes_, config_, N_x_, N_y_);
+            operations_this_run += IGSOAPhysics2D::timeStep(nodes_, soa_, config_, N_x_, N_y_, stencil, spectral, &sparse_, graph, false,
+                                                            driven ? &drive : nullptr);
+            state_epoch_++;
 
             // Update counters
             current_time_ += config_.dt;
             total_steps_++;
+            recordProbes();
+            if (observables_.interrupted()) {
+                num_steps = step + 1;
+                break;
+            }
         }
 
         auto end_time = std::chrono::high_resolution_clock::now();
@@ -226,11 +375,102 @@ public:
         // Update performance metrics
         total_operations_ += operations_this_run;
         last_execution_time_ns_ = duration.count();
+        last_mission_steps_ = num_steps;
+        last_step_traffic_ = IGSOAStepTraffic::model(
+            config_, nodes_.size(), 2, spectral ? 0.0 : sparseCouplingTerms(couplingTermsPerNode(stencil, graph)),
+            spectral != nullptr, driven, true, !IGSOAActivityMask::enabled(config_));
 
         if (operations_this_run > 0) {
             ns_per_op_ = static_cast<double>(duration.count()) / operations_this_run;
             ops_per_sec_ = 1.0e9 / ns_per_op_;
         }
+        return num_steps;
+    }
+
+    /**
+     * Coarse-to-fine burn-in (igsoa_burn_in.h): run options.steps on a
+     * lattice options.factor times coarser per axis, then prolong Ψ/Φ back
+     *
+     * @param input_signals Optional driving signals (length: options.steps)
+     * @param control_patterns Optional control patterns (length: options.steps)
+     * @return Steps run; the clock advances as if they ran on this lattice
+     * @throws std::invalid_argument if the options do not fit this lattice
+     */
+    uint64_t runBurnIn(
+        const IGSOABurnInOptions& options,
+        const double* input_signals = nullptr,
+        const double* control_patterns = nullptr
+    ) {
+        std::string error;
+        if (!options.validate(config_, N_x_, N_y_, 1, &error)) {
+            throw std::invalid_argument(error);
+        }
+        if (options.steps == 0) {
+            return 0;
+        }
+        auto start_time = std::chrono::high_resolution_clock::now();
+        const size_t c_x = N_x_ / options.factor;
+        const size_t c_y = N_y_ / options.factor;
+        IGSOAComplexEngine2D coarse(IGSOABurnIn::coarseConfig(config_, options.factor, c_x * c_y, 2), c_x, c_y);
+        IGSOABurnIn::restrictState(nodes_, N_x_, N_y_, 1, options.factor, coarse.nodes_);
+        const uint64_t steps = coarse.runMission(options.steps, input_signals, control_patterns);
+        IGSOABurnIn::prolongState(coarse.nodes_, N_x_, N_y_, 1, options.factor, config_.normalize_psi, nodes_);
+        state_epoch_++;   // Gradients refresh on the first read
+
+        for (uint64_t step = 0; step < steps; step++) {
+            current_time_ += config_.dt;
+        }
+        total_steps_ += steps;
+        total_operations_ += coarse.total_operations_;
+        last_execution_time_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - start_time).count();
+        last_mission_steps_ = steps;
+        last_step_traffic_ = coarse.last_step_traffic_;
+        ns_per_op_ = coarse.ns_per_op_;
+        ops_per_sec_ = coarse.ops_per_sec_;
+        return steps;
+    }
+
+    /**
+     * Run mission to a simulated time with adaptive dt (igsoa_adaptive_mission.h)
+     *
+     * @param duration Simulated time to advance
+     * @param options dt bounds and error tolerance
+     * @param driving Optional driving samples on a simulated-time grid
+     * @return Accepted/rejected step counts of this run
+     */
+    AdaptiveStepStats runMissionAdaptive(
+        double duration,
+        const AdaptiveStepOptions& options,
+        const IGSOADrivingSchedule& driving = IGSOADrivingSchedule()
+    ) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        uint64_t operations_this_run = 0;
+        sparse_.beginMission();
+        const NeighborStencil2D* stencil = prepareStencil();
+        const IGSOANeighborGraph2D* graph = prepareGraph(stencil);
+        IGSOASpectralCoupling* spectral = prepareSpectral();
+        const AdaptiveStepStats stats = adaptive_.run(
+            nodes_, config_, duration, options, driving, current_time_, total_steps_, operations_this_run,
+            [&]() {
+                state_epoch_++;
+                return IGSOAPhysics2D::timeStep(nodes_, soa_, config_, N_x_, N_y_, stencil, spectral, &sparse_, graph, false);
+            });
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+
+        total_operations_ += operations_this_run;
+        last_execution_time_ns_ = elapsed.count();
+        last_mission_steps_ = stats.accepted_steps;
+        last_step_traffic_ = IGSOAStepTraffic::model(
+            config_, nodes_.size(), 2, spectral ? 0.0 : sparseCouplingTerms(couplingTermsPerNode(stencil, graph)),
+            spectral != nullptr, driving.active(), true);
+        if (operations_this_run > 0) {
+            ns_per_op_ = static_cast<double>(elapsed.count()) / operations_this_run;
+            ops_per_sec_ = 1.0e9 / ns_per_op_;
+        }
+        return stats;
     }
 
     /**
@@ -248,11 +488,29 @@ public:
         out_total_ops = total_operations_;
     }
 
+    /**
+     * Page size backing the node state (config.numa.huge_pages, see
+     * NumaPlacement::allocate)
+     */
+    size_t getStatePageSize() const {
+        return state_page_bytes_;
+    }
+
+    /**
+     * Modelled bytes / FLOPs per step of the last mission and the rates
+     * it achieved (igsoa_step_traffic.h); invalid before the first mission
+     */
+    KernelRoofline getRoofline() const {
+        return kernelRoofline(last_step_traffic_, last_mission_steps_,
+                              static_cast<double>(last_execution_time_ns_) * 1.0e-9);
+    }
+
     /**
      * Compute total system energy
      * E = ∑_i [|Ψ_i|² + Φ_i²]
      */
     double getTotalEnergy() const {
+        ensureDerived();
         return IGSOAPhysics2D::computeTotalEnergy(nodes_);
     }
 
@@ -261,6 +519,7 @@ public:
      * Ṡ_total = ∑_i Ṡ_i
      */
     double getTotalEntropyRate() const {
+        ensureDerived();
         return IGSOAPhysics2D::computeTotalEntropyRate(nodes_);
     }
 
@@ -269,10 +528,10 @@ public:
      * <F> = (1/N) ∑_i |Ψ_i|²
      */
     double getAverageInformationalDensity() const {
-        double sum = 0.0;
-        for (const auto& node : nodes_) {
-            sum += node.F;
-        }
+        ensureDerived();
+        const double sum = reproducibleSum(static_cast<int64_t>(nodes_.size()),
+                                           [this](int64_t i) { return nodes_[static_cast<size_t>(i)].F; },
+                                           nodes_.size() >= config_.omp_min_nodes);
         return sum / nodes_.size();
     }
 
@@ -292,6 +551,7 @@ public:
             node.phase = 0.0;
             node.harmonic_count = 0;
         }
+        derived_epoch_ = state_epoch_;
 
         current_time_ = 0.0;
         total_steps_ = 0;
@@ -299,12 +559,36 @@ public:
         ns_per_op_ = 0.0;
         ops_per_sec_ = 0.0;
         last_execution_time_ns_ = 0;
+        last_mission_steps_ = 0;
+        last_step_traffic_ = KernelTraffic();
+        sparse_.beginMission();
+    }
+
+    /**
+     * Reset to the state of a freshly constructed engine with new scalar
+     * parameters on the same lattice
+     *
+     * Keeps the node allocation (and its page placement) and the coupling
+     * caches, which rebuild on their own when the uniform R_c changes.
+     */
+    void reconfigure(double R_c, double kappa, double gamma, double dt) {
+        config_.R_c_default = R_c;
+        config_.kappa = kappa;
+        config_.gamma = gamma;
+        config_.dt = dt;
+        IGSOAComplexNode prototype;
+        prototype.R_c = R_c;
+        prototype.kappa = kappa;
+        prototype.gamma = gamma;
+        std::fill(nodes_.begin(), nodes_.end(), prototype);
+        reset();
     }
 
     /**
      * Get direct access to nodes (for advanced use)
      */
     const std::vector<IGSOAComplexNode>& getNodes() const {
+        ensureDerived();
         return nodes_;
     }
 
@@ -312,14 +596,169 @@ public:
      * Get mutable access to nodes (for advanced use)
      */
     std::vector<IGSOAComplexNode>& getNodesMutable() {
+        ensureDerived();
         return nodes_;
     }
 
+    /**
+     * Bring the derived fields (F, T_IGS, phase, Ṡ, F_gradient) up to date;
+     * missions defer them to the first read (see IGSOAComplexEngine)
+     */
+    void ensureDerived() const {
+        if (derived_epoch_ == state_epoch_) {
+            return;
+        }
+        IGSOAPhysics2D::refreshDerived(nodes_, soa_, config_, N_x_, N_y_);
+        derived_epoch_ = state_epoch_;
+    }
+
+    /**
+     * Add this engine's state to a checkpoint (igsoa_checkpoint.h); the
+     * engine must not step until writer.write() returns
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        ensureDerived();
+        IGSOACheckpoint::save(writer, config_, nodes_, N_x_, N_y_, 1,
+                              current_time_, total_steps_, total_operations_);
+    }
+
+    /**
+     * Restore a checkpoint of an engine with the same lattice
+     * @throws std::runtime_error if the image does not fit this engine
+     */
+    void restoreCheckpoint(const CheckpointImage& image) {
+        IGSOACheckpoint::restore(image, config_, nodes_, N_x_, N_y_, 1,
+                                 current_time_, total_steps_, total_operations_);
+        derived_epoch_ = state_epoch_;
+    }
+
 private:
+    // Sample the probes and observables due at the current step count
+    void recordProbes() {
+        if (!probes_.active() && !observables_.active()) return;
+        const int derived = static_cast<int>(IGSOANodeField::F);
+        if (probes_.due(total_steps_, derived) || observables_.due(total_steps_, derived)) ensureDerived();
+        auto sample = [this](uint64_t i, int field) {
+            return IGSOABulkAccess::value(nodes_[i], static_cast<IGSOANodeField>(field));
+        };
+        probes_.record(total_steps_, sample);
+        observables_.record(total_steps_, sample);
+    }
+
+    /**
+     * Stencil for this mission, or nullptr to use direct coupling
+     *
+     * The table is rebuilt only when the (uniform) R_c changes; a lattice
+     * with per-node R_c variation uses the CSR graph (prepareGraph()).
+     */
+    const NeighborStencil2D* prepareStencil() {
+        double R_c = 0.0;
+        if (config_.coupling_mode != IGSOACouplingMode::Stencil || !uniformRc(R_c)) {
+            return nullptr;
+        }
+        if (!stencil_.matches(N_x_, N_y_, R_c, config_.kernel_policy)) {
+            stencil_.build(N_x_, N_y_, R_c, config_.kernel_policy);
+        }
+        return &stencil_;
+    }
+
+    /**
+     * Per-node R_c coupling rows for a Stencil-mode mission without a
+     * uniform-R_c table, or nullptr to use direct coupling
+     *
+     * Only the rows whose R_c changed since the last mission are rebuilt.
+     */
+    const IGSOANeighborGraph2D* prepareGraph(const NeighborStencil2D* stencil) {
+        if (stencil != nullptr || config_.coupling_mode != IGSOACouplingMode::Stencil ||
+            !graph_.refresh(nodes_, N_x_, N_y_, 1, config_.omp_min_nodes, config_.kernel_policy)) {
+            return nullptr;
+        }
+        return &graph_;
+    }
+
+    /**
+     * FFT coupling backend for this mission, or nullptr
+     *
+     * Selected automatically for DoubleBuffered stepping when the uniform
+     * R_c reaches config_.fft_min_R_c; the kernel spectrum is cached per R_c.
+     */
+    IGSOASpectralCoupling* prepareSpectral() {
+        double R_c = 0.0;
+        if (!IGSOASpectralCoupling::isAvailable() ||
+            config_.update_mode != IGSOAUpdateMode::DoubleBuffered ||
+            !uniformRc(R_c) || R_c < config_.fft_min_R_c) {
+            return nullptr;
+        }
+        if (!spectral_.matches(N_x_, N_y_, 1, R_c, config_.kernel_policy)) {
+            if (!stencil_.matches(N_x_, N_y_, R_c, config_.kernel_policy)) {
+                stencil_.build(N_x_, N_y_, R_c, config_.kernel_policy);
+            }
+            if (!spectral_.build(stencil_, N_x_, N_y_)) {
+                return nullptr;
+            }
+        }
+        return &spectral_;
+    }
+
+    /**
+     * Neighbours summed per node by the mission's coupling path (the graph's
+     * mean row length; the direct path is counted for the first node's R_c)
+     */
+    double couplingTermsPerNode(const NeighborStencil2D* stencil, const IGSOANeighborGraph2D* graph) const {
+        if (stencil != nullptr) {
+            return static_cast<double>(stencil->size());
+        }
+        if (graph != nullptr) {
+            return graph->averageDegree();
+        }
+        if (nodes_.empty()) {
+            return 0.0;
+        }
+        NeighborStencil2D probe;
+        probe.build(N_x_, N_y_, nodes_[0].R_c);
+        return static_cast<double>(probe.size());
+    }
+
+    /**
+     * Coupling terms per node averaged over the last mission's active nodes
+     * (the traffic model's coupling share skips masked blocks)
+     */
+    double sparseCouplingTerms(double terms) const {
+        return terms * (1.0 - sparse_.skippedFraction());
+    }
+
+    /**
+     * True (and R_c_out set) if every node shares the same R_c
+     */
+    bool uniformRc(double& R_c_out) const {
+        if (nodes_.empty()) {
+            return false;
+        }
+        R_c_out = nodes_[0].R_c;
+        for (const auto& node : nodes_) {
+            if (node.R_c != R_c_out) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     IGSOAComplexConfig config_;
     size_t N_x_;  // Lattice width
     size_t N_y_;  // Lattice height
-    std::vector<IGSOAComplexNode> nodes_;  // Row-major layout
+    mutable std::vector<IGSOAComplexNode> nodes_;  // Row-major layout; derived fields refreshed by const reads
+    mutable IGSOAStateSoA soa_;  // Packed neighbour-read mirror of nodes_ (hot path)
+    size_t state_page_bytes_ = 0;  // Page size backing nodes_
+    IGSOAAdaptiveMission adaptive_;  // Step-doubling buffers for runMissionAdaptive
+    IGSOATemporalBlocking blocking_;  // Tile buffers for temporally blocked missions
+    IGSOAActivityMask sparse_;  // Block activity mask for sparse evolution
+    ProbeRecorder probes_;  // Per-step samples of selected nodes
+    ObservableRecorder observables_;  // Per-step reductions of the lattice
+    uint64_t state_epoch_ = 0;              // Lazy steps taken
+    mutable uint64_t derived_epoch_ = 0;    // state_epoch_ of the derived fields
+    NeighborStencil2D stencil_;  // Uniform-R_c coupling table (Stencil mode)
+    IGSOANeighborGraph2D graph_;  // Per-node R_c coupling rows (Stencil mode)
+    IGSOASpectralCoupling spectral_;  // FFT coupling for large uniform R_c
 
     // Simulation state
     double current_time_;
@@ -330,6 +769,8 @@ private:
     double ns_per_op_ = 0.0;
     double ops_per_sec_ = 0.0;
     int64_t last_execution_time_ns_ = 0;
+    uint64_t last_mission_steps_ = 0;
+    KernelTraffic last_step_traffic_;  // Model of one step of the last mission
 };
 
 } // namespace igsoa
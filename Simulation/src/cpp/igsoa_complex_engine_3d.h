@@ -4,12 +4,32 @@
  * Three-dimensional extension of the IGSOA lattice simulator.  The engine
  * mirrors the 2D implementation while expanding the topology to a toroidal
  * volume of size N_x × N_y × N_z.
+ *
+ * With setDevice(ComputeDevice::GPU) the lattice stays in device memory
+ * across missions (igsoa_gpu_backend_3d.h); host reads download it on
+ * demand and host edits re-upload it before the next mission.
  */
 
 #pragma once
 
+#include "circular_statistics.h"
 #include "igsoa_complex_node.h"
 #include "igsoa_physics_3d.h"
+#include "igsoa_state_soa.h"
+#include "igsoa_checkpoint.h"
+#include "igsoa_step_traffic.h"
+#include "igsoa_adaptive_mission.h"
+#include "igsoa_burn_in.h"
+#include "igsoa_bulk_access.h"
+#include "observable_recorder.h"
+#include "probe_recorder.h"
+#include "igsoa_temporal_blocking.h"
+#include "igsoa_activity_mask.h"
+#include "igsoa_fft_coupling.h"
+#include "igsoa_gpu_backend_3d.h"
+#include "igsoa_neighbor_graph.h"
+#include "neighbor_cache.h"
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -29,7 +49,7 @@ public:
         , N_x_(N_x)
         , N_y_(N_y)
         , N_z_(N_z)
-        , nodes_(N_x * N_y * N_z)
+        , com_axis_{CircularAxis(N_x), CircularAxis(N_y), CircularAxis(N_z)}
         , current_time_(0.0)
         , total_steps_(0)
         , total_operations_(0)
@@ -46,11 +66,14 @@ public:
             throw std::invalid_argument("Total nodes exceeds limit (100M max)");
         }
 
-        for (auto& node : nodes_) {
-            node.R_c = config.R_c_default;
-            node.kappa = config.kappa;
-            node.gamma = config.gamma;
-        }
+        // Pin threads first so first-touch placement matches the kernels
+        IGSOAComplexNode prototype;
+        prototype.R_c = config.R_c_default;
+        prototype.kappa = config.kappa;
+        prototype.gamma = config.gamma;
+        NumaPlacement::applyThreadAffinity(config.numa.thread_affinity);
+        state_page_bytes_ = NumaPlacement::allocate(nodes_, total, config.numa, prototype);
+        soa_.allocate(total, config.numa);
     }
 
     size_t getNx() const { return N_x_; }
@@ -77,8 +100,142 @@ public:
     uint64_t getTotalSteps() const { return total_steps_; }
     uint64_t getTotalOperations() const { return total_operations_; }
 
+    // Ψ update ordering (InPlace = legacy, DoubleBuffered = Jacobi)
+    void setUpdateMode(IGSOAUpdateMode mode) { config_.update_mode = mode; }
+    IGSOAUpdateMode getUpdateMode() const { return config_.update_mode; }
+
+    /**
+     * Select the Ψ time integrator (Euler = legacy, RK2/RK4 = larger stable dt)
+     */
+    void setIntegrator(IGSOAIntegrator integrator) { config_.integrator = integrator; }
+    IGSOAIntegrator getIntegrator() const { return config_.integrator; }
+
+    /**
+     * Select the Ψ mirror precision of the coupling sums (see IGSOAPrecision)
+     */
+    void setPrecision(IGSOAPrecision precision) { config_.precision = precision; }
+    IGSOAPrecision getPrecision() const { return config_.precision; }
+
+    /**
+     * Select the coupling law K(r, R_c) (see igsoa_kernel_policy.h); the
+     * coupling tables are rebuilt from it by the next mission
+     */
+    void setKernelPolicy(IGSOAKernelPolicy policy) { config_.kernel_policy = policy; }
+    IGSOAKernelPolicy getKernelPolicy() const { return config_.kernel_policy; }
+
+    /**
+     * Probes sampled inside runMission's step loop (probe_recorder.h; field
+     * ids are IGSOANodeField, points are node indices).  While any probe is
+     * registered, missions step one step at a time on the host (no temporal blocking or device residency).
+     */
+    ProbeRecorder& probes() { return probes_; }
+    const ProbeRecorder& probes() const { return probes_; }
+
+    /**
+     * Reductions evaluated inside runMission's step loop like the probes
+     * (observable_recorder.h; field ids are IGSOANodeField)
+     */
+    ObservableRecorder& observables() { return observables_; }
+    const ObservableRecorder& observables() const { return observables_; }
+
+    /**
+     * Steps per temporally blocked pass (1 = per-step; igsoa_temporal_blocking.h)
+     */
+    void setTemporalBlockSteps(uint32_t steps) { config_.temporal_block_steps = steps; }
+    uint32_t getTemporalBlockSteps() const { return config_.temporal_block_steps; }
+
+    /**
+     * Sparse Euler evolution (igsoa_activity_mask.h): skip the Ψ updates of
+     * sparse_block-sized blocks whose neighbourhood is below threshold
+     * (0 = dense).  Disables temporal blocking and the GPU backend.
+     */
+    void setSparseEvolution(double threshold, uint32_t block = 8) {
+        config_.sparse_threshold = threshold;
+        config_.sparse_block = block;
+    }
+    double getSparseThreshold() const { return config_.sparse_threshold; }
+    uint32_t getSparseBlock() const { return config_.sparse_block; }
+
+    // Share of the node updates the last mission skipped (0 when dense)
+    double getSparseSkippedFraction() const { return sparse_.skippedFraction(); }
+
+    // Coupling evaluation (Stencil = precomputed table for uniform R_c)
+    void setCouplingMode(IGSOACouplingMode mode) { config_.coupling_mode = mode; }
+    IGSOACouplingMode getCouplingMode() const { return config_.coupling_mode; }
+
+    /**
+     * Select where missions run (gpu_device.h)
+     *
+     * GPU missions the backend supports (IGSOAGpuBackend3D::supported) keep
+     * the lattice resident on the device; others step on the host.
+     * Switching back to CPU downloads the lattice and frees the device copy.
+     *
+     * @return false (device unchanged) if GPU is requested and no device is
+     *         available
+     */
+    bool setDevice(ComputeDevice device) {
+        if (device == ComputeDevice::GPU && !GpuDevice::isAvailable()) {
+            return false;
+        }
+        if (device == ComputeDevice::CPU) {
+            syncHost();
+            gpu_.release();
+            device_current_ = false;
+        }
+        device_ = device;
+        return true;
+    }
+    ComputeDevice getDevice() const { return device_; }
+
+    // True if the last mission stepped on the device
+    bool lastMissionOnDevice() const { return last_mission_on_device_; }
+
+    /**
+     * Bytes held by node storage and the SoA mirror (state), the coupling
+     * stencil, graph and FFT buffers (caches), the step-doubling and probe
+     * buffers (history) and the stage, tile and activity buffers (scratch).
+     * Device memory is excluded.
+     */
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint bytes = soa_.footprint();
+        bytes.state += capacityBytes(nodes_);
+        bytes.caches += stencil_.getMemoryUsage() + graph_.getMemoryUsage() + spectral_.getMemoryUsage();
+        bytes.history += adaptive_.memoryBytes() + probes_.memoryBytes() + observables_.memoryBytes();
+        bytes.scratch += blocking_.memoryBytes() + sparse_.memoryBytes();
+        return bytes;
+    }
+
+    size_t getMemoryUsage() const { return static_cast<size_t>(memoryFootprint().total()); }
+
+    /**
+     * memoryFootprint() of an engine built from `config` once it has stepped
+     * (uniform R_c_default: the Stencil-mode table or the FFT backend it
+     * would select, no per-node graph)
+     */
+    static MemoryFootprint estimateMemory(const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t N_z) {
+        const size_t total = N_x * N_y * N_z;
+        MemoryFootprint bytes = IGSOAStateSoA::estimate(total, config.integrator, config.precision);
+        bytes.state += static_cast<uint64_t>(total) * sizeof(IGSOAComplexNode);
+        const bool spectral = IGSOASpectralCoupling::isAvailable() &&
+                              config.update_mode == IGSOAUpdateMode::DoubleBuffered &&
+                              config.R_c_default >= config.fft_min_R_c;
+        if (spectral || config.coupling_mode == IGSOACouplingMode::Stencil) {
+            NeighborStencil3D probe;
+            probe.build(N_x, N_y, N_z, config.R_c_default);
+            bytes.caches += probe.getMemoryUsage();
+        }
+        if (spectral) {
+            bytes.caches += IGSOASpectralCoupling::estimateBytes(total);
+        }
+        return bytes;
+    }
+
+    // Bytes of device memory held by the GPU backend
+    size_t getDeviceMemoryUsage() const { return gpu_.memoryBytes(); }
+
     void setNodePsi(size_t x, size_t y, size_t z, double real, double imag) {
         size_t index = coordToIndex(x, y, z);
+        invalidateDevice();
         if (index < nodes_.size()) {
             nodes_[index].psi = std::complex<double>(real, imag);
             nodes_[index].updateInformationalDensity();
@@ -88,6 +245,7 @@ public:
 
     void getNodePsi(size_t x, size_t y, size_t z, double& real_out, double& imag_out) const {
         size_t index = coordToIndex(x, y, z);
+        syncHost();
         if (index < nodes_.size()) {
             real_out = nodes_[index].psi.real();
             imag_out = nodes_[index].psi.imag();
@@ -99,6 +257,7 @@ public:
 
     void setNodePhi(size_t x, size_t y, size_t z, double value) {
         size_t index = coordToIndex(x, y, z);
+        invalidateDevice();
         if (index < nodes_.size()) {
             nodes_[index].phi = value;
         }
@@ -106,6 +265,7 @@ public:
 
     double getNodePhi(size_t x, size_t y, size_t z) const {
         size_t index = coordToIndex(x, y, z);
+        syncHost();
         if (index < nodes_.size()) {
             return nodes_[index].phi;
         }
@@ -114,44 +274,238 @@ public:
 
     double getNodeF(size_t x, size_t y, size_t z) const {
         size_t index = coordToIndex(x, y, z);
+        ensureDerived();
         if (index < nodes_.size()) {
             return nodes_[index].F;
         }
         return 0.0;
     }
 
-    void runMission(uint64_t num_steps,
-                    const double* input_signals = nullptr,
-                    const double* control_patterns = nullptr) {
+    // Steps run, as in the 1D / 2D engines
+    uint64_t runMission(uint64_t num_steps,
+                        const double* input_signals = nullptr,
+                        const double* control_patterns = nullptr) {
         auto start_time = std::chrono::high_resolution_clock::now();
         uint64_t operations_this_run = 0;
+        sparse_.beginMission();
+        const NeighborStencil3D* stencil = prepareStencil();
+        const IGSOANeighborGraph3D* graph = prepareGraph(stencil);
+
+        // Device-resident mission: upload only if the host copy changed
+        last_mission_on_device_ = false;
+        if (device_ == ComputeDevice::GPU && !probes_.active() && !observables_.active() && IGSOAGpuBackend3D::supported(config_, stencil)) {
+            if (!device_current_) {
+                device_current_ = gpu_.upload(nodes_, N_x_, N_y_, N_z_, *stencil);
+            }
+            last_mission_on_device_ = device_current_;
+        }
+        if (last_mission_on_device_) {
+            operations_this_run += gpu_.run(config_, num_steps, input_signals, control_patterns);
+            host_stale_ = true;
+            derived_epoch_ = state_epoch_;   // The device steps compute every field
+            for (uint64_t step = 0; step < num_steps; ++step) {
+                current_time_ += config_.dt;
+            }
+            total_steps_ += num_steps;
+            finishMission(start_time, operations_this_run, num_steps,
+                          IGSOAStepTraffic::model(config_, nodes_.size(), 3, couplingTermsPerNode(stencil, graph),
+                                                  false, input_signals && control_patterns));
+            return num_steps;
+        }
+        invalidateDevice();
+
+        IGSOASpectralCoupling* spectral = prepareSpectral();
+        uint64_t first_step = 0;
+
+        // Temporally blocked head; the last step runs per-step (see 2D)
+        if (num_steps > 2 && !probes_.active() && !observables_.active() && IGSOATemporalBlocking::supported(
+                config_, stencil ? stencil->size() : 0, spectral != nullptr)) {
+            first_step = num_steps - 1;
+            operations_this_run += blocking_.run<3>(
+                nodes_, config_, N_x_, N_y_, N_z_, *stencil, first_step, input_signals, control_patterns);
+            for (uint64_t step = 0; step < first_step; ++step) {
+                current_time_ += config_.dt;
+            }
+            total_steps_ += first_step;
+        }
 
-        for (uint64_t step = 0; step < num_steps; ++step) {
-            if (input_signals && control_patterns) {
-                IGSOAPhysics3D::applyDriving(nodes_, input_signals[step], control_patterns[step]);
+        const bool driven = input_signals && control_patterns;
+        for (uint64_t step = first_step; step < num_steps; ++step) {
+            // Driving, if any, rides on the step's Ψ gather
+            std::complex<double> drive;
+            if (driven) {
+                drive = std::complex<double>(input_signals[step], control_patterns[step]);
                 operations_this_run += static_cast<uint64_t>(nodes_.size());
             }
 
-            operations_this_run += IGSOAPhysics3D::timeStep(nodes_, config_, N_x_, N_y_, N_z_);
+            operations_this_run += IGSOAPhysics3D::timeStep(nodes_, soa_, config_, N_x_, N_y_, N_z_, stencil, spectral, &sparse_, graph, false,
+                                                            driven ? &drive : nullptr);
+            state_epoch_++;
             current_time_ += config_.dt;
             total_steps_++;
+            recordProbes();
+            if (observables_.interrupted()) {
+                num_steps = step + 1;
+                break;
+            }
+        }
+
+        finishMission(start_time, operations_this_run, num_steps,
+                      IGSOAStepTraffic::model(config_, nodes_.size(), 3,
+                                              spectral ? 0.0 : sparseCouplingTerms(couplingTermsPerNode(stencil, graph)),
+                                              spectral != nullptr, driven, true,
+                                              !IGSOAActivityMask::enabled(config_)));
+        return num_steps;
+    }
+
+    // Coarse-to-fine burn-in (igsoa_burn_in.h), as in the 2D engine; the
+    // coarse lattice steps on the host
+    uint64_t runBurnIn(const IGSOABurnInOptions& options,
+                       const double* input_signals = nullptr,
+                       const double* control_patterns = nullptr) {
+        std::string error;
+        if (!options.validate(config_, N_x_, N_y_, N_z_, &error)) {
+            throw std::invalid_argument(error);
+        }
+        if (options.steps == 0) {
+            return 0;
         }
+        auto start_time = std::chrono::high_resolution_clock::now();
+        invalidateDevice();
+        last_mission_on_device_ = false;
+        const size_t c_x = N_x_ / options.factor;
+        const size_t c_y = N_y_ / options.factor;
+        const size_t c_z = N_z_ > 1 ? N_z_ / options.factor : 1;   // A single plane stays one
+        const int dims = N_z_ > 1 ? 3 : 2;
+        IGSOAComplexEngine3D coarse(IGSOABurnIn::coarseConfig(config_, options.factor, c_x * c_y * c_z, dims),
+                                    c_x, c_y, c_z);
+        IGSOABurnIn::restrictState(nodes_, N_x_, N_y_, N_z_, options.factor, coarse.nodes_);
+        const uint64_t steps = coarse.runMission(options.steps, input_signals, control_patterns);
+        IGSOABurnIn::prolongState(coarse.nodes_, N_x_, N_y_, N_z_, options.factor, config_.normalize_psi, nodes_);
+        state_epoch_++;   // Gradients refresh on the first read
+
+        for (uint64_t step = 0; step < steps; ++step) {
+            current_time_ += config_.dt;
+        }
+        total_steps_ += steps;
+        finishMission(start_time, coarse.total_operations_, steps, coarse.last_step_traffic_);
+        return steps;
+    }
+
+    // Run to a simulated time with adaptive dt (igsoa_adaptive_mission.h)
+    AdaptiveStepStats runMissionAdaptive(
+        double duration,
+        const AdaptiveStepOptions& options,
+        const IGSOADrivingSchedule& driving = IGSOADrivingSchedule()
+    ) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        uint64_t operations_this_run = 0;
+        sparse_.beginMission();
+        invalidateDevice();   // Step-doubling runs on the host
+        last_mission_on_device_ = false;
+        const NeighborStencil3D* stencil = prepareStencil();
+        const IGSOANeighborGraph3D* graph = prepareGraph(stencil);
+        IGSOASpectralCoupling* spectral = prepareSpectral();
+        const AdaptiveStepStats stats = adaptive_.run(
+            nodes_, config_, duration, options, driving, current_time_, total_steps_, operations_this_run,
+            [&]() {
+                state_epoch_++;
+                return IGSOAPhysics3D::timeStep(nodes_, soa_, config_, N_x_, N_y_, N_z_, stencil, spectral, &sparse_, graph, false);
+            });
 
         auto end_time = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
 
         total_operations_ += operations_this_run;
-        last_execution_time_ns_ = duration.count();
+        last_execution_time_ns_ = elapsed.count();
+        last_mission_steps_ = stats.accepted_steps;
+        last_step_traffic_ = IGSOAStepTraffic::model(
+            config_, nodes_.size(), 3, spectral ? 0.0 : sparseCouplingTerms(couplingTermsPerNode(stencil, graph)),
+            spectral != nullptr, driving.active(), true);
         if (operations_this_run > 0) {
-            ns_per_op_ = static_cast<double>(duration.count()) / operations_this_run;
+            ns_per_op_ = static_cast<double>(elapsed.count()) / operations_this_run;
             ops_per_sec_ = 1.0e9 / ns_per_op_;
         }
+        return stats;
     }
 
-    const std::vector<IGSOAComplexNode>& getNodes() const { return nodes_; }
-    std::vector<IGSOAComplexNode>& getNodesMutable() { return nodes_; }
+    // Host lattice (downloaded first if the device holds a newer one)
+    const std::vector<IGSOAComplexNode>& getNodes() const {
+        ensureDerived();
+        return nodes_;
+    }
+
+    // Host lattice for editing; the next GPU mission re-uploads it
+    std::vector<IGSOAComplexNode>& getNodesMutable() {
+        invalidateDevice();
+        ensureDerived();
+        return nodes_;
+    }
+
+    /**
+     * Host lattice with its derived fields (F, T_IGS, phase, Ṡ, F_gradient)
+     * up to date; host missions defer them to the first read (see
+     * IGSOAComplexEngine), device missions compute them on the device
+     */
+    void ensureDerived() const {
+        syncHost();
+        if (derived_epoch_ == state_epoch_) {
+            return;
+        }
+        IGSOAPhysics3D::refreshDerived(nodes_, soa_, config_, N_x_, N_y_, N_z_);
+        derived_epoch_ = state_epoch_;
+    }
+
+    /**
+     * Lattice totals E = ∑ |Ψ|² + Φ² and Ṡ_total = ∑ Ṡ (reduced on the device
+     * while the lattice is resident)
+     */
+    double getTotalEnergy() const {
+        if (device_current_) {
+            return gpu_.reduce().energy;
+        }
+        ensureDerived();
+        double energy = 0.0;
+        double entropy_rate = 0.0;
+        IGSOAPhysics::computeTotals(nodes_, energy, entropy_rate, config_.omp_min_nodes);
+        return energy;
+    }
+
+    double getTotalEntropyRate() const {
+        if (device_current_) {
+            return gpu_.reduce().entropy_rate;
+        }
+        ensureDerived();
+        double energy = 0.0;
+        double entropy_rate = 0.0;
+        IGSOAPhysics::computeTotals(nodes_, energy, entropy_rate, config_.omp_min_nodes);
+        return entropy_rate;
+    }
+
+    /**
+     * F-weighted centre of mass with circular statistics per axis (toroidal
+     * lattice); reduced on the device while the lattice is resident
+     */
+    void getCenterOfMass(double& x_cm_out, double& y_cm_out, double& z_cm_out) const {
+        if (device_current_) {
+            IGSOAGpuBackend3D::centerOfMass(gpu_.reduce(), N_x_, N_y_, N_z_, x_cm_out, y_cm_out, z_cm_out);
+            return;
+        }
+        ensureDerived();
+        const CircularTotals circular = circularTotals(
+            com_axis_[0], com_axis_[1], com_axis_[2], 0, N_z_,
+            [this](size_t i) { return nodes_[i].F; }, nodes_.size() >= config_.omp_min_nodes);
+        IGSOADeviceTotals totals;
+        totals.sum_F = circular.weight;
+        for (int axis = 0; axis < 3; ++axis) {
+            totals.sum_cos[axis] = circular.sum_cos[axis];
+            totals.sum_sin[axis] = circular.sum_sin[axis];
+        }
+        IGSOAGpuBackend3D::centerOfMass(totals, N_x_, N_y_, N_z_, x_cm_out, y_cm_out, z_cm_out);
+    }
 
     void reset() {
+        invalidateDevice();
         for (auto& node : nodes_) {
             node.psi = std::complex<double>(0.0, 0.0);
             node.phi = 0.0;
@@ -159,14 +513,38 @@ public:
             node.phase = 0.0;
             node.psi_dot = std::complex<double>(0.0, 0.0);
         }
+        derived_epoch_ = state_epoch_;
         current_time_ = 0.0;
         total_steps_ = 0;
         total_operations_ = 0;
         last_execution_time_ns_ = 0;
+        last_mission_steps_ = 0;
+        last_step_traffic_ = KernelTraffic();
+        sparse_.beginMission();
         ns_per_op_ = 0.0;
         ops_per_sec_ = 0.0;
     }
 
+    /**
+     * Reset to the state of a freshly constructed engine with new scalar
+     * parameters on the same lattice
+     *
+     * Keeps the node allocation (and its page placement) and the coupling
+     * caches, which rebuild on their own when the uniform R_c changes.
+     */
+    void reconfigure(double R_c, double kappa, double gamma, double dt) {
+        config_.R_c_default = R_c;
+        config_.kappa = kappa;
+        config_.gamma = gamma;
+        config_.dt = dt;
+        IGSOAComplexNode prototype;
+        prototype.R_c = R_c;
+        prototype.kappa = kappa;
+        prototype.gamma = gamma;
+        std::fill(nodes_.begin(), nodes_.end(), prototype);
+        reset();
+    }
+
     void getMetrics(double& ns_per_op_out,
                     double& ops_per_sec_out,
                     double& speedup_factor_out,
@@ -177,14 +555,186 @@ public:
         total_operations_out = total_operations_;
     }
 
+    // Page size backing the node state (config.numa.huge_pages)
+    size_t getStatePageSize() const { return state_page_bytes_; }
+
+    // Modelled bytes / FLOPs per step of the last mission and the rates it
+    // achieved (igsoa_step_traffic.h); invalid before the first mission
+    KernelRoofline getRoofline() const {
+        return kernelRoofline(last_step_traffic_, last_mission_steps_,
+                              static_cast<double>(last_execution_time_ns_) * 1.0e-9);
+    }
+
     void setSpeedupFactor(double factor) { speedup_factor_ = factor; }
 
+    /**
+     * Add this engine's state to a checkpoint (igsoa_checkpoint.h); the
+     * engine must not step until writer.write() returns
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        ensureDerived();
+        IGSOACheckpoint::save(writer, config_, nodes_, N_x_, N_y_, N_z_,
+                              current_time_, total_steps_, total_operations_);
+    }
+
+    /**
+     * Restore a checkpoint of an engine with the same lattice
+     * @throws std::runtime_error if the image does not fit this engine
+     */
+    void restoreCheckpoint(const CheckpointImage& image) {
+        invalidateDevice();
+        IGSOACheckpoint::restore(image, config_, nodes_, N_x_, N_y_, N_z_,
+                                 current_time_, total_steps_, total_operations_);
+        derived_epoch_ = state_epoch_;
+    }
+
 private:
+    // Sample the probes and observables due at the current step count
+    void recordProbes() {
+        if (!probes_.active() && !observables_.active()) return;
+        const int derived = static_cast<int>(IGSOANodeField::F);
+        if (probes_.due(total_steps_, derived) || observables_.due(total_steps_, derived)) ensureDerived();
+        auto sample = [this](uint64_t i, int field) {
+            return IGSOABulkAccess::value(nodes_[i], static_cast<IGSOANodeField>(field));
+        };
+        probes_.record(total_steps_, sample);
+        observables_.record(total_steps_, sample);
+    }
+
+    // Download the lattice if the device holds a newer one
+    void syncHost() const {
+        if (host_stale_) {
+            gpu_.download(nodes_);
+            host_stale_ = false;
+        }
+    }
+
+    // Host copy is about to change: the device copy must be re-uploaded
+    void invalidateDevice() {
+        syncHost();
+        device_current_ = false;
+    }
+
+    // Timing, rates and the traffic model of a finished mission
+    void finishMission(std::chrono::high_resolution_clock::time_point start_time,
+                       uint64_t operations_this_run, uint64_t num_steps, const KernelTraffic& traffic) {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+
+        total_operations_ += operations_this_run;
+        last_execution_time_ns_ = duration.count();
+        last_mission_steps_ = num_steps;
+        last_step_traffic_ = traffic;
+        if (operations_this_run > 0) {
+            ns_per_op_ = static_cast<double>(duration.count()) / operations_this_run;
+            ops_per_sec_ = 1.0e9 / ns_per_op_;
+        }
+    }
+
+    // Stencil for this mission, or nullptr to use the graph or direct
+    // coupling (rebuilt only when the uniform R_c changes)
+    const NeighborStencil3D* prepareStencil() {
+        double R_c = 0.0;
+        if (config_.coupling_mode != IGSOACouplingMode::Stencil || !uniformRc(R_c)) {
+            return nullptr;
+        }
+        if (!stencil_.matches(N_x_, N_y_, N_z_, R_c, config_.kernel_policy)) {
+            stencil_.build(N_x_, N_y_, N_z_, R_c, config_.kernel_policy);
+        }
+        return &stencil_;
+    }
+
+    // Per-node R_c coupling rows for a Stencil-mode mission without a
+    // uniform-R_c table, or nullptr (only rows whose R_c changed are rebuilt)
+    const IGSOANeighborGraph3D* prepareGraph(const NeighborStencil3D* stencil) {
+        if (stencil != nullptr || config_.coupling_mode != IGSOACouplingMode::Stencil ||
+            !graph_.refresh(nodes_, N_x_, N_y_, N_z_, config_.omp_min_nodes, config_.kernel_policy)) {
+            return nullptr;
+        }
+        return &graph_;
+    }
+
+    // FFT coupling backend for this mission, or nullptr (auto-selected for
+    // DoubleBuffered stepping once the uniform R_c reaches fft_min_R_c)
+    IGSOASpectralCoupling* prepareSpectral() {
+        double R_c = 0.0;
+        if (!IGSOASpectralCoupling::isAvailable() ||
+            config_.update_mode != IGSOAUpdateMode::DoubleBuffered ||
+            !uniformRc(R_c) || R_c < config_.fft_min_R_c) {
+            return nullptr;
+        }
+        if (!spectral_.matches(N_x_, N_y_, N_z_, R_c, config_.kernel_policy)) {
+            if (!stencil_.matches(N_x_, N_y_, N_z_, R_c, config_.kernel_policy)) {
+                stencil_.build(N_x_, N_y_, N_z_, R_c, config_.kernel_policy);
+            }
+            if (!spectral_.build(stencil_, N_x_, N_y_, N_z_)) {
+                return nullptr;
+            }
+        }
+        return &spectral_;
+    }
+
+    // Neighbours summed per node by the mission's coupling path (the graph's
+    // mean row length; the direct path is counted for the first node's R_c)
+    double couplingTermsPerNode(const NeighborStencil3D* stencil, const IGSOANeighborGraph3D* graph) const {
+        if (stencil != nullptr) {
+            return static_cast<double>(stencil->size());
+        }
+        if (graph != nullptr) {
+            return graph->averageDegree();
+        }
+        if (nodes_.empty()) {
+            return 0.0;
+        }
+        NeighborStencil3D probe;
+        probe.build(N_x_, N_y_, N_z_, nodes_[0].R_c);
+        return static_cast<double>(probe.size());
+    }
+
+    // Coupling terms per node averaged over the last mission's active nodes
+    double sparseCouplingTerms(double terms) const {
+        return terms * (1.0 - sparse_.skippedFraction());
+    }
+
+    bool uniformRc(double& R_c_out) const {
+        if (nodes_.empty()) {
+            return false;
+        }
+        R_c_out = nodes_[0].R_c;
+        for (const auto& node : nodes_) {
+            if (node.R_c != R_c_out) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     IGSOAComplexConfig config_;
     size_t N_x_;
     size_t N_y_;
     size_t N_z_;
-    std::vector<IGSOAComplexNode> nodes_;
+    CircularAxis com_axis_[3];  // Centre-of-mass angle tables per axis
+    mutable std::vector<IGSOAComplexNode> nodes_;  // Refreshed from the device by host reads
+    mutable IGSOAStateSoA soa_;  // Packed neighbour-read mirror of nodes_ (hot path)
+    size_t state_page_bytes_ = 0;  // Page size backing nodes_
+    IGSOAAdaptiveMission adaptive_;  // Step-doubling buffers for runMissionAdaptive
+    IGSOATemporalBlocking blocking_;  // Tile buffers for temporally blocked missions
+    IGSOAActivityMask sparse_;  // Block activity mask for sparse evolution
+    ProbeRecorder probes_;  // Per-step samples of selected nodes
+    ObservableRecorder observables_;  // Per-step reductions of the lattice
+    uint64_t state_epoch_ = 0;              // Lazy host steps taken
+    mutable uint64_t derived_epoch_ = 0;    // state_epoch_ of the derived fields
+    NeighborStencil3D stencil_;  // Uniform-R_c coupling table (Stencil mode)
+    IGSOANeighborGraph3D graph_;  // Per-node R_c coupling rows (Stencil mode)
+    IGSOASpectralCoupling spectral_;  // FFT coupling for large uniform R_c
+
+    // Device residency: device_current_ while the device copy is valid,
+    // host_stale_ while it is newer than nodes_
+    ComputeDevice device_ = ComputeDevice::CPU;
+    mutable IGSOAGpuBackend3D gpu_;
+    mutable bool host_stale_ = false;
+    bool device_current_ = false;
+    bool last_mission_on_device_ = false;
 
     double current_time_;
     uint64_t total_steps_;
@@ -194,6 +744,8 @@ private:
     double ops_per_sec_ = 0.0;
     double speedup_factor_ = 1.0;
     uint64_t last_execution_time_ns_ = 0;
+    uint64_t last_mission_steps_ = 0;
+    KernelTraffic last_step_traffic_;  // Model of one step of the last mission
 };
 
 } // namespace igsoa
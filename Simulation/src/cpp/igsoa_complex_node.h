@@ -15,7 +15,11 @@
 
 #pragma once
 
+#include "igsoa_kernel_policy.h"
+#include "numa_placement.h"
+#include <cmath>
 #include <complex>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <stdexcept>
@@ -122,6 +126,74 @@ struct IGSOAComplexNode {
     }
 };
 
+/**
+ * Ψ update ordering for the coupling pass
+ *
+ * - InPlace: nodes are updated in index order and later nodes read the
+ *   already-updated Ψ of earlier neighbours (Gauss-Seidel-like; legacy
+ *   behaviour, matches recorded goldens).
+ * - DoubleBuffered: every node reads the previous step's Ψ and the new Ψ is
+ *   written to a separate buffer (Jacobi).  Results are independent of the
+ *   traversal order, which is required for race-free parallel stepping.
+ */
+enum class IGSOAUpdateMode : uint8_t {
+    InPlace,
+    DoubleBuffered
+};
+
+/**
+ * How the 2D/3D engines evaluate the non-local coupling sum
+ *
+ * - Direct: per-node bounding-box loop using each node's own R_c.
+ * - Stencil: one precomputed offset/weight table shared by all nodes
+ *   (NeighborStencil2D/3D) when every node has the same R_c, otherwise
+ *   packed per-node rows (IGSOANeighborGraph2D/3D).  Results match Direct.
+ */
+enum class IGSOACouplingMode : uint8_t {
+    Direct,
+    Stencil
+};
+
+/**
+ * Time integrator for the Ψ equation
+ *
+ * - Euler: forward Euler, one coupling pass per step (legacy; honours
+ *   IGSOAUpdateMode and matches recorded goldens).
+ * - RK2: explicit midpoint, two coupling passes per step.
+ * - RK4: classical fourth-order Runge-Kutta, four coupling passes per step.
+ *
+ * The Runge-Kutta stages always read a complete stage input (Jacobi) and run
+ * in parallel whatever the update mode; Φ is held at its start-of-step value
+ * across the stages (see igsoa_runge_kutta.h).
+ */
+enum class IGSOAIntegrator : uint8_t {
+    Euler,
+    RK2,
+    RK4
+};
+
+/**
+ * Precision of the Ψ mirror the coupling sums stream (IGSOAStateSoA)
+ *
+ * - Double: double mirror, double sums (default; bit-exact with goldens).
+ * - MixedFloat: float mirror, every term promoted and summed in double.
+ *   Halves the neighbour-read bytes of the coupling sweep.
+ * - Float: float mirror and float weights, each contiguous neighbour span
+ *   summed in float (8 AVX2 lanes) before joining the double total.
+ *
+ * Ψ then departs from the Double path by about 1e-7 per 100 steps at
+ * dt = 0.01 (bounds in tests/test_igsoa_precision.cpp).
+ *
+ * Node state (AoS), Φ and the Ψ update stay double in every mode.  The
+ * float modes apply to Euler steps with table/direct coupling; RK stages
+ * and the FFT backend always read the double mirror.
+ */
+enum class IGSOAPrecision : uint8_t {
+    Double,
+    MixedFloat,
+    Float
+};
+
 /**
  * Engine configuration for IGSOA Complex simulation
  */
@@ -132,6 +204,19 @@ struct IGSOAComplexConfig {
     double gamma;                  // Dissipation coefficient
     double dt;                     // Time step for integration
     bool normalize_psi;            // Whether to normalize |Ψ⟩ (unitary evolution)
+    IGSOAUpdateMode update_mode;   // Ψ update ordering (see IGSOAUpdateMode)
+    size_t omp_min_nodes;          // Lattices below this size step on one thread
+    IGSOACouplingMode coupling_mode;  // 2D/3D coupling evaluation (see IGSOACouplingMode)
+    double fft_min_R_c;            // Uniform R_c at/above which DoubleBuffered 2D/3D steps use FFT coupling
+    bool simd_coupling;            // Allow runtime-selected AVX2/FMA coupling kernels (false = bit-exact scalar)
+    IGSOAIntegrator integrator;    // Ψ time integrator (see IGSOAIntegrator)
+    uint32_t temporal_block_steps; // 2D/3D steps per temporally blocked pass (1 = off; igsoa_temporal_blocking.h)
+    IGSOAPrecision precision;      // Ψ mirror / coupling-sum precision (see IGSOAPrecision)
+    double sparse_threshold;       // 2D/3D unnormalized Euler: skip Ψ updates of blocks below this |Ψ|, |Φ| (0 = dense; igsoa_activity_mask.h)
+    uint32_t sparse_block;         // Activity mask block edge (nodes)
+    NumaOptions numa;              // Node state page placement and thread pinning (numa_placement.h)
+    IGSOAKernelPolicy kernel_policy;  // Coupling law K(r, R_c) (igsoa_kernel_policy.h)
+    double coupling_gain;          // 2D/3D factor on 𝒦[Ψ] (1 = the lattice law; coarse burn-in lattices, igsoa_burn_in.h)
 
     IGSOAComplexConfig()
         : num_nodes(1024)
@@ -140,6 +225,18 @@ struct IGSOAComplexConfig {
         , gamma(0.1)
         , dt(0.01)
         , normalize_psi(true)
+        , update_mode(IGSOAUpdateMode::InPlace)
+        , omp_min_nodes(4096)
+        , coupling_mode(IGSOACouplingMode::Direct)
+        , fft_min_R_c(8.0)
+        , simd_coupling(true)
+        , integrator(IGSOAIntegrator::Euler)
+        , temporal_block_steps(1)
+        , precision(IGSOAPrecision::Double)
+        , sparse_threshold(0.0)
+        , sparse_block(8)
+        , kernel_policy(IGSOAKernelPolicy::Exponential)
+        , coupling_gain(1.0)
     {}
 
     /**
@@ -217,6 +314,40 @@ struct IGSOAComplexConfig {
             return false;
         }
 
+        // Check integrator is a known scheme (configs may come from checkpoints)
+        if (integrator != IGSOAIntegrator::Euler && integrator != IGSOAIntegrator::RK2 &&
+            integrator != IGSOAIntegrator::RK4) {
+            if (error_msg) {
+                *error_msg = "integrator must be Euler, RK2 or RK4 (got " +
+                            std::to_string(static_cast<int>(integrator)) + ")";
+            }
+            return false;
+        }
+
+        if (!(coupling_gain > 0.0) || !std::isfinite(coupling_gain)) {
+            if (error_msg) {
+                *error_msg = "coupling_gain must be positive and finite (got " + std::to_string(coupling_gain) + ")";
+            }
+            return false;
+        }
+
+        if (precision != IGSOAPrecision::Double && precision != IGSOAPrecision::MixedFloat &&
+            precision != IGSOAPrecision::Float) {
+            if (error_msg) {
+                *error_msg = "precision must be Double, MixedFloat or Float (got " +
+                            std::to_string(static_cast<int>(precision)) + ")";
+            }
+            return false;
+        }
+
+        if (sparse_threshold < 0.0 || sparse_block == 0) {
+            if (error_msg) {
+                *error_msg = "sparse_threshold must be non-negative and sparse_block positive (got " +
+                            std::to_string(sparse_threshold) + ", " + std::to_string(sparse_block) + ")";
+            }
+            return false;
+        }
+
         // All checks passed
         return true;
     }
@@ -0,0 +1,643 @@
+/**
+ * IGSOA Distributed Engine (3D)
+ *
+ * IGSOAComplexEngine3D's lattice split over MPI ranks in z-slabs
+ * (igsoa_slab_decomposition_3d.h), so one run is no longer bounded by one
+ * node's memory.  Each rank stores only its owned planes; the Ψ mirror
+ * carries ceil(R_c) ghost planes per side, and F one ghost plane for the
+ * gradients.
+ *
+ * One step is IGSOAPhysics3D::timeStep on the slab:
+ *
+ *   1. driving (every rank applies the same signal)
+ *   2. gather Ψ, post the non-blocking halo exchange
+ *   3. couple the planes at least R_c away from the slab edges (owned data
+ *      only) while the halos are in flight
+ *   4. wait, couple the edge planes against the ghosts
+ *   5. Φ, F / phase / Ṡ, then the F gradients after a one-plane exchange,
+ *      and the per-node normalization
+ *
+ * Coupling uses the NeighborStencil3D table of the global lattice: rows with
+ * x and y at least the reach from the edges take the contiguous runs (or the
+ * compile-time FixedStencilKernels), the rest wrap x/y per neighbour and
+ * read z from the ghosts.  Results match the single-process engine to
+ * rounding (the host may pick a different summation kernel per node).
+ *
+ * Supported: DoubleBuffered updates, the Euler integrator, double precision,
+ * dense steps (sparse_threshold = 0) and a uniform R_c (config.R_c_default);
+ * the constructor throws std::invalid_argument otherwise.  Energy, entropy production and the
+ * centre of mass are global reductions.
+ *
+ * Every member that touches more than the local slab is collective: all
+ * ranks must call it in the same order.  IGSOADistributedCoordinator3D
+ * lets a single coordinator rank (the CLI / harness process) drive the
+ * engine while the other ranks serve its commands.
+ */
+
+#pragma once
+
+#include "circular_statistics.h"
+#include "igsoa_complex_node.h"
+#include "igsoa_physics.h"
+#include "igsoa_physics_3d.h"
+#include "igsoa_simd_coupling.h"
+#include "igsoa_fixed_stencil.h"
+#include "igsoa_slab_decomposition_3d.h"
+#include "igsoa_step_traffic.h"
+#include "kernel_traffic.h"
+#include "neighbor_cache.h"
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace dase {
+namespace igsoa {
+
+class IGSOADistributedEngine3D {
+public:
+    // Single-rank engine (whole lattice local; same stepping as N ranks)
+    IGSOADistributedEngine3D(const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t N_z)
+        : config_(checked(config)), N_x_(N_x), N_y_(N_y), N_z_(N_z), plane_(N_x * N_y),
+          com_axis_{CircularAxis(N_x), CircularAxis(N_y), CircularAxis(N_z)},
+          decomposition_(N_z, haloFor(config)) {
+        allocate();
+    }
+
+#ifdef IGSOA_USE_MPI
+    /**
+     * Collective: distribute the lattice over the ranks of comm
+     * @throws std::invalid_argument for unsupported configurations or if a
+     *         rank would own fewer than ceil(R_c) planes
+     */
+    IGSOADistributedEngine3D(const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t N_z,
+                             MPI_Comm comm)
+        : config_(checked(config)), N_x_(N_x), N_y_(N_y), N_z_(N_z), plane_(N_x * N_y),
+          com_axis_{CircularAxis(N_x), CircularAxis(N_y), CircularAxis(N_z)},
+          decomposition_(N_z, haloFor(config), comm) {
+        allocate();
+    }
+#endif
+
+    /**
+     * Collective: advance by num_steps (input_signals / control_patterns
+     * must be identical on every rank)
+     */
+    void runMission(uint64_t num_steps,
+                    const double* input_signals = nullptr,
+                    const double* control_patterns = nullptr) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        uint64_t operations = 0;
+        const bool driven = input_signals && control_patterns;
+
+        for (uint64_t step = 0; step < num_steps; ++step) {
+            if (driven) {
+                IGSOAPhysics3D::applyDriving(nodes_, input_signals[step], control_patterns[step]);
+                operations += static_cast<uint64_t>(nodes_.size());
+            }
+            operations += timeStep();
+            current_time_ += config_.dt;
+            total_steps_++;
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        const double elapsed_ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+
+        // Rates of the whole lattice: all ranks' operations over the slowest rank
+        const uint64_t global_operations = decomposition_.sum(operations);
+        const double slowest_ns = decomposition_.max(elapsed_ns);
+        total_operations_ += global_operations;
+        last_execution_time_ns_ = static_cast<uint64_t>(slowest_ns);
+        last_mission_steps_ = num_steps;
+        last_step_traffic_ = IGSOAStepTraffic::model(config_, getNumNodes(), 3,
+                                                     static_cast<double>(stencil_.size()), false, driven);
+        if (global_operations > 0) {
+            ns_per_op_ = slowest_ns / static_cast<double>(global_operations);
+            ops_per_sec_ = 1.0e9 / ns_per_op_;
+        }
+    }
+
+    void getMetrics(double& ns_per_op_out,
+                    double& ops_per_sec_out,
+                    double& speedup_factor_out,
+                    uint64_t& total_operations_out) const {
+        ns_per_op_out = ns_per_op_;
+        ops_per_sec_out = ops_per_sec_;
+        speedup_factor_out = speedup_factor_;
+        total_operations_out = total_operations_;
+    }
+
+    // Modelled traffic of the whole lattice per step (halo messages not
+    // counted) against the slowest rank's time
+    KernelRoofline getRoofline() const {
+        return kernelRoofline(last_step_traffic_, last_mission_steps_,
+                              static_cast<double>(last_execution_time_ns_) * 1.0e-9);
+    }
+
+    void setSpeedupFactor(double factor) { speedup_factor_ = factor; }
+
+    // Collective: E = ∑ |Ψ|² + Φ² over the whole lattice
+    double getTotalEnergy() const {
+        double totals[2];
+        localTotals(totals);
+        decomposition_.sum(totals, 2);
+        return totals[0];
+    }
+
+    // Collective: Ṡ_total = ∑ Ṡ over the whole lattice
+    double getTotalEntropyRate() const {
+        double totals[2];
+        localTotals(totals);
+        decomposition_.sum(totals, 2);
+        return totals[1];
+    }
+
+    /**
+     * Collective: F-weighted centre of mass with circular statistics per axis
+     * (as IGSOAComplexEngine3D::getCenterOfMass)
+     */
+    void getCenterOfMass(double& x_cm_out, double& y_cm_out, double& z_cm_out) const {
+        // sum_F, then cos / sin per axis
+        const CircularTotals circular = circularTotals(
+            com_axis_[0], com_axis_[1], com_axis_[2], decomposition_.getOwnedBegin(),
+            decomposition_.getOwnedPlanes(), [this](size_t i) { return nodes_[i].F; },
+            nodes_.size() >= config_.omp_min_nodes);
+        double sums[7] = {circular.weight,
+                          circular.sum_cos[0], circular.sum_cos[1], circular.sum_cos[2],
+                          circular.sum_sin[0], circular.sum_sin[1], circular.sum_sin[2]};
+        decomposition_.sum(sums, 7);
+
+        const double extent[3] = {static_cast<double>(N_x_), static_cast<double>(N_y_), static_cast<double>(N_z_)};
+        double* out[3] = {&x_cm_out, &y_cm_out, &z_cm_out};
+        for (int axis = 0; axis < 3; ++axis) {
+            double cm = 0.0;
+            if (sums[0] > 0.0) {
+                cm = extent[axis] * std::atan2(sums[4 + axis], sums[1 + axis]) / (2.0 * M_PI);
+                if (cm < 0.0) {
+                    cm += extent[axis];
+                }
+            }
+            *out[axis] = cm;
+        }
+    }
+
+    /**
+     * Collective: the whole lattice on the root rank (other ranks' `out`
+     * is left empty)
+     */
+    void gatherNodes(std::vector<IGSOAComplexNode>& out) const {
+        out.clear();
+        if (decomposition_.isRoot()) {
+            out.resize(getNumNodes());
+        }
+        decomposition_.gatherPlanes(nodes_.data(), plane_ * sizeof(IGSOAComplexNode),
+                                    decomposition_.isRoot() ? out.data() : nullptr);
+    }
+
+    /**
+     * Collective: replace the lattice with the root's `nodes` (N_x·N_y·N_z
+     * entries on the root; ignored elsewhere)
+     * @throws std::invalid_argument on the root if the size does not match
+     */
+    void scatterNodes(const std::vector<IGSOAComplexNode>& nodes) {
+        if (decomposition_.isRoot() && nodes.size() != getNumNodes()) {
+            throw std::invalid_argument("scatterNodes expects the whole lattice on the root");
+        }
+        decomposition_.scatterPlanes(decomposition_.isRoot() ? nodes.data() : nullptr,
+                                     plane_ * sizeof(IGSOAComplexNode), nodes_.data());
+        for (auto& node : nodes_) {
+            node.R_c = config_.R_c_default;   // The stencil is built for the uniform R_c
+        }
+    }
+
+    // Owner-only edits: every rank may call, the rank owning z applies it
+    void setNodePsi(size_t x, size_t y, size_t z, double real, double imag) {
+        IGSOAComplexNode* node = localNode(x, y, z);
+        if (node != nullptr) {
+            node->psi = std::complex<double>(real, imag);
+            node->updateInformationalDensity();
+            node->updatePhase();
+        }
+    }
+
+    void setNodePhi(size_t x, size_t y, size_t z, double value) {
+        IGSOAComplexNode* node = localNode(x, y, z);
+        if (node != nullptr) {
+            node->phi = value;
+        }
+    }
+
+    // Owned planes of this rank ([getOwnedBegin(), getOwnedEnd()) in z)
+    const std::vector<IGSOAComplexNode>& getLocalNodes() const { return nodes_; }
+    std::vector<IGSOAComplexNode>& getLocalNodesMutable() { return nodes_; }
+
+    void reset() {
+        for (auto& node : nodes_) {
+            node.psi = std::complex<double>(0.0, 0.0);
+            node.phi = 0.0;
+            node.F = 0.0;
+            node.phase = 0.0;
+            node.psi_dot = std::complex<double>(0.0, 0.0);
+        }
+        current_time_ = 0.0;
+        total_steps_ = 0;
+        total_operations_ = 0;
+        last_execution_time_ns_ = 0;
+        last_mission_steps_ = 0;
+        last_step_traffic_ = KernelTraffic();
+        ns_per_op_ = 0.0;
+        ops_per_sec_ = 0.0;
+    }
+
+    const IGSOASlabDecomposition3D& getDecomposition() const { return decomposition_; }
+    const IGSOAComplexConfig& getConfig() const { return config_; }
+    size_t getNumNodes() const { return plane_ * N_z_; }
+    size_t getNx() const { return N_x_; }
+    size_t getNy() const { return N_y_; }
+    size_t getNz() const { return N_z_; }
+    double getCurrentTime() const { return current_time_; }
+    uint64_t getTotalSteps() const { return total_steps_; }
+
+    // Bytes held by this rank (slab, ghost mirrors and coupling table)
+    size_t getMemoryUsage() const {
+        return nodes_.capacity() * sizeof(IGSOAComplexNode) +
+               (psi_re_.capacity() + psi_im_.capacity() + F_.capacity()) * sizeof(double) +
+               stencil_.getMemoryUsage();
+    }
+
+private:
+    static const IGSOAComplexConfig& checked(const IGSOAComplexConfig& config) {
+        if (config.update_mode != IGSOAUpdateMode::DoubleBuffered ||
+            config.integrator != IGSOAIntegrator::Euler ||
+            config.precision != IGSOAPrecision::Double ||
+            config.sparse_threshold > 0.0) {
+            throw std::invalid_argument(
+                "Distributed IGSOA 3D engine supports dense DoubleBuffered Euler steps in double precision only");
+        }
+        if (!(config.R_c_default > 0.0) || !std::isfinite(config.R_c_default)) {
+            throw std::invalid_argument("Distributed IGSOA 3D engine needs a positive finite R_c_default");
+        }
+        return config;
+    }
+
+    // Ghost planes per side: the coupling reach, at least one for ∇F
+    static int haloFor(const IGSOAComplexConfig& config) {
+        const int reach = static_cast<int>(std::ceil(config.R_c_default));
+        return reach > 1 ? reach : 1;
+    }
+
+    void allocate() {
+        if (plane_ == 0 || N_z_ == 0) {
+            throw std::invalid_argument("Distributed IGSOA 3D engine needs a non-empty lattice");
+        }
+        stencil_.build(N_x_, N_y_, N_z_, config_.R_c_default, config_.kernel_policy);
+        halo_ = decomposition_.getHalo();
+        IGSOAComplexNode prototype;
+        prototype.R_c = config_.R_c_default;
+        prototype.kappa = config_.kappa;
+        prototype.gamma = config_.gamma;
+        nodes_.assign(decomposition_.getOwnedPlanes() * plane_, prototype);
+        const size_t local = decomposition_.getLocalPlanes() * plane_;
+        psi_re_.assign(local, 0.0);
+        psi_im_.assign(local, 0.0);
+        F_.assign(local, 0.0);
+    }
+
+    IGSOAComplexNode* localNode(size_t x, size_t y, size_t z) {
+        if (x >= N_x_ || y >= N_y_ || !decomposition_.owns(z)) {
+            return nullptr;
+        }
+        return &nodes_[(z - decomposition_.getOwnedBegin()) * plane_ + y * N_x_ + x];
+    }
+
+    void localTotals(double totals[2]) const {
+        IGSOAPhysics::computeTotals(nodes_, totals[0], totals[1], config_.omp_min_nodes);
+    }
+
+    // One step of the slab; returns this rank's operations
+    uint64_t timeStep() {
+        const size_t owned = decomposition_.getOwnedPlanes();
+        const size_t halo = static_cast<size_t>(halo_);
+        const int reach = stencil_.reach();
+
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            psi_re_[halo * plane_ + i] = nodes_[i].psi.real();
+            psi_im_[halo * plane_ + i] = nodes_[i].psi.imag();
+        }
+        double* psi[2] = {psi_re_.data(), psi_im_.data()};
+        decomposition_.beginHaloExchange(psi, 2, plane_, reach);
+
+        // Planes whose reach stays inside the slab overlap the exchange
+        const int64_t inner_begin = static_cast<int64_t>(reach);
+        const int64_t inner_end = static_cast<int64_t>(owned) - reach;
+        uint64_t operations = 0;
+        if (inner_end > inner_begin) {
+            operations += couplePlanes(inner_begin, inner_end);
+        }
+        decomposition_.finishHaloExchange();
+        if (inner_end > inner_begin) {
+            operations += couplePlanes(0, inner_begin);
+            operations += couplePlanes(inner_end, static_cast<int64_t>(owned));
+        } else {
+            operations += couplePlanes(0, static_cast<int64_t>(owned));
+        }
+
+        const bool parallel = nodes_.size() >= config_.omp_min_nodes;
+        #pragma omp parallel if(parallel) reduction(+:operations)
+        {
+            operations += IGSOAPhysics3D::evolveCausalField(nodes_, config_.dt);
+            operations += IGSOAPhysics3D::updateDerivedQuantities(nodes_);
+        }
+
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            F_[halo * plane_ + i] = nodes_[i].F;
+        }
+        double* F[1] = {F_.data()};
+        decomposition_.exchangeHalos(F, 1, plane_, 1);
+        operations += computeGradients();
+
+        if (config_.normalize_psi) {
+            #pragma omp parallel if(parallel) reduction(+:operations)
+            operations += IGSOAPhysics::normalizeStates(nodes_);
+        }
+        return operations;
+    }
+
+    // Ψ update of owned planes [p_begin, p_end) from the Jacobi mirror
+    uint64_t couplePlanes(int64_t p_begin, int64_t p_end) {
+        const int N_x_int = static_cast<int>(N_x_);
+        const int N_y_int = static_cast<int>(N_y_);
+        const int reach = stencil_.reach();
+        const size_t count = stencil_.size();
+        const double* weight = stencil_.weight();
+        const int* offset_x = stencil_.dx();
+        const int* offset_y = stencil_.dy();
+        const int* offset_z = stencil_.dz();
+        const std::ptrdiff_t* offset = stencil_.linearOffset();
+        const size_t* run_begin = stencil_.runBegin();
+        const size_t* run_length = stencil_.runLength();
+        const size_t num_runs = stencil_.numRuns();
+        const int fixed_radius = stencil_.fixedRadius();
+        const bool simd = config_.simd_coupling && IGSOACouplingKernels::avx2Available();
+        const std::ptrdiff_t row_stride = static_cast<std::ptrdiff_t>(N_x_);
+        const std::ptrdiff_t plane_stride = static_cast<std::ptrdiff_t>(plane_);
+        const double* src_re = psi_re_.data();
+        const double* src_im = psi_im_.data();
+        const double dt = config_.dt;
+        const size_t halo = static_cast<size_t>(halo_);
+        uint64_t operations = 0;
+
+        const bool parallel = static_cast<size_t>(p_end - p_begin) * plane_ >= config_.omp_min_nodes;
+        #pragma omp parallel for schedule(static) if(parallel) reduction(+:operations)
+        for (int64_t p = p_begin; p < p_end; ++p) {
+            const int z_local = static_cast<int>(static_cast<size_t>(p) + halo);
+            for (int y_i = 0; y_i < N_y_int; ++y_i) {
+                for (int x_i = 0; x_i < N_x_int; ++x_i) {
+                    const size_t index = static_cast<size_t>(z_local) * plane_ +
+                                         static_cast<size_t>(y_i) * N_x_ + static_cast<size_t>(x_i);
+                    auto& node = nodes_[index - halo * plane_];
+                    const double self_re = src_re[index];
+                    const double self_im = src_im[index];
+                    double coupling_re = 0.0;
+                    double coupling_im = 0.0;
+
+                    if (x_i >= reach && x_i < N_x_int - reach && y_i >= reach && y_i < N_y_int - reach) {
+                        // z always resolves inside the ghosted mirror
+                        if (!FixedStencilKernels::accumulateInterior<3>(
+                                fixed_radius, simd, src_re + index, src_im + index, row_stride, plane_stride,
+                                weight, self_re, self_im, coupling_re, coupling_im)) {
+                            for (size_t r = 0; r < num_runs; ++r) {
+                                const size_t k0 = run_begin[r];
+                                const size_t j0 = static_cast<size_t>(static_cast<std::ptrdiff_t>(index) + offset[k0]);
+                                IGSOACouplingKernels::accumulateContiguous(
+                                    simd, src_re + j0, src_im + j0, weight + k0, run_length[r],
+                                    self_re, self_im, coupling_re, coupling_im);
+                            }
+                        }
+                    } else {
+                        for (size_t k = 0; k < count; ++k) {
+                            int x_j = (x_i + offset_x[k]) % N_x_int;
+                            if (x_j < 0) x_j += N_x_int;
+                            int y_j = (y_i + offset_y[k]) % N_y_int;
+                            if (y_j < 0) y_j += N_y_int;
+                            const size_t neighbor_index =
+                                static_cast<size_t>(z_local + offset_z[k]) * plane_ +
+                                static_cast<size_t>(y_j) * N_x_ +
+                                static_cast<size_t>(x_j);
+                            coupling_re += weight[k] * (src_re[neighbor_index] - self_re);
+                            coupling_im += weight[k] * (src_im[neighbor_index] - self_im);
+                        }
+                    }
+
+                    // Same update as IGSOAPhysics3D::evolveQuantumState
+                    const std::complex<double> nonlocal_coupling(coupling_re, coupling_im);
+                    const std::complex<double> V_eff = node.kappa * node.phi;
+                    const std::complex<double> i_gamma(0.0, node.gamma);
+                    const std::complex<double> H_psi = -nonlocal_coupling + V_eff * node.psi + i_gamma * node.psi;
+                    const std::complex<double> i_unit(0.0, 1.0);
+                    node.psi_dot = -i_unit * H_psi;
+                    node.psi += node.psi_dot * dt;
+                    operations += 1 + count;
+                }
+            }
+        }
+        return operations;
+    }
+
+    // Central-difference |∇F| of the owned planes (F ghosts refreshed)
+    uint64_t computeGradients() {
+        const int64_t owned = static_cast<int64_t>(decomposition_.getOwnedPlanes());
+        const size_t halo = static_cast<size_t>(halo_);
+        const double* F = F_.data();
+        const bool parallel = nodes_.size() >= config_.omp_min_nodes;
+
+        #pragma omp parallel for schedule(static) if(parallel)
+        for (int64_t p = 0; p < owned; ++p) {
+            const size_t z_local = static_cast<size_t>(p) + halo;
+            for (size_t y = 0; y < N_y_; ++y) {
+                const size_t y_up = (y == N_y_ - 1) ? 0 : y + 1;
+                const size_t y_down = (y == 0) ? N_y_ - 1 : y - 1;
+                for (size_t x = 0; x < N_x_; ++x) {
+                    const size_t x_right = (x == N_x_ - 1) ? 0 : x + 1;
+                    const size_t x_left = (x == 0) ? N_x_ - 1 : x - 1;
+                    const size_t row = z_local * plane_ + y * N_x_;
+
+                    const double dF_dx = (F[row + x_right] - F[row + x_left]) * 0.5;
+                    const double dF_dy = (F[z_local * plane_ + y_up * N_x_ + x] -
+                                          F[z_local * plane_ + y_down * N_x_ + x]) * 0.5;
+                    const double dF_dz = (F[row + plane_ + x] - F[row - plane_ + x]) * 0.5;
+                    nodes_[static_cast<size_t>(p) * plane_ + y * N_x_ + x].F_gradient =
+                        std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy + dF_dz * dF_dz);
+                }
+            }
+        }
+        return static_cast<uint64_t>(nodes_.size());
+    }
+
+    IGSOAComplexConfig config_;
+    size_t N_x_;
+    size_t N_y_;
+    size_t N_z_;
+    size_t plane_;
+    CircularAxis com_axis_[3];  // Centre-of-mass angle tables per axis
+    IGSOASlabDecomposition3D decomposition_;
+    int halo_ = 0;
+    NeighborStencil3D stencil_;  // Global-lattice table (uniform R_c)
+
+    std::vector<IGSOAComplexNode> nodes_;  // Owned planes only
+    std::vector<double> psi_re_;  // Jacobi Ψ mirror with ghost planes
+    std::vector<double> psi_im_;
+    std::vector<double> F_;  // F with ghost planes (gradient pass)
+
+    double current_time_ = 0.0;
+    uint64_t total_steps_ = 0;
+    uint64_t total_operations_ = 0;
+
+    double ns_per_op_ = 0.0;
+    double ops_per_sec_ = 0.0;
+    double speedup_factor_ = 1.0;
+    uint64_t last_execution_time_ns_ = 0;
+    uint64_t last_mission_steps_ = 0;
+    KernelTraffic last_step_traffic_;
+};
+
+/**
+ * Drives an IGSOADistributedEngine3D from one rank
+ *
+ * The root rank (the CLI / harness process) calls the members below; each
+ * broadcasts a command so the other ranks, blocked in serve(), join the
+ * same collective.  The root calls shutdown() to release them.  On a single
+ * rank every call runs directly and serve() returns at once.
+ */
+class IGSOADistributedCoordinator3D {
+public:
+    explicit IGSOADistributedCoordinator3D(IGSOADistributedEngine3D& engine) : engine_(engine) {}
+
+    bool isRoot() const { return engine_.getDecomposition().isRoot(); }
+
+    // Root: run a mission on all ranks (signals broadcast from the root)
+    void runMission(uint64_t num_steps,
+                    const double* input_signals = nullptr,
+                    const double* control_patterns = nullptr) {
+        Header header{Command::RunMission, num_steps, (input_signals && control_patterns) ? 1u : 0u};
+        send(header);
+        std::vector<double> signals;
+        if (header.driven) {
+            signals.assign(input_signals, input_signals + num_steps);
+            signals.insert(signals.end(), control_patterns, control_patterns + num_steps);
+        }
+        execute(header, signals);
+    }
+
+    double getTotalEnergy() {
+        send(Header{Command::TotalEnergy, 0, 0});
+        return engine_.getTotalEnergy();
+    }
+
+    double getTotalEntropyRate() {
+        send(Header{Command::TotalEntropyRate, 0, 0});
+        return engine_.getTotalEntropyRate();
+    }
+
+    void getCenterOfMass(double& x_cm_out, double& y_cm_out, double& z_cm_out) {
+        send(Header{Command::CenterOfMass, 0, 0});
+        engine_.getCenterOfMass(x_cm_out, y_cm_out, z_cm_out);
+    }
+
+    // Root: the whole lattice
+    void gatherNodes(std::vector<IGSOAComplexNode>& out) {
+        send(Header{Command::GatherNodes, 0, 0});
+        engine_.gatherNodes(out);
+    }
+
+    // Root: replace the whole lattice
+    void scatterNodes(const std::vector<IGSOAComplexNode>& nodes) {
+        send(Header{Command::ScatterNodes, 0, 0});
+        engine_.scatterNodes(nodes);
+    }
+
+    void reset() {
+        send(Header{Command::Reset, 0, 0});
+        engine_.reset();
+    }
+
+    // Root: release the ranks in serve()
+    void shutdown() { send(Header{Command::Shutdown, 0, 0}); }
+
+    // Non-root ranks: execute the root's commands until shutdown()
+    void serve() {
+        if (isRoot()) {
+            return;
+        }
+        for (;;) {
+            Header header{Command::Shutdown, 0, 0};
+            engine_.getDecomposition().broadcast(&header, sizeof(header));
+            if (header.command == Command::Shutdown) {
+                return;
+            }
+            if (header.command == Command::RunMission) {
+                execute(header, std::vector<double>());
+            } else if (header.command == Command::TotalEnergy) {
+                engine_.getTotalEnergy();
+            } else if (header.command == Command::TotalEntropyRate) {
+                engine_.getTotalEntropyRate();
+            } else if (header.command == Command::CenterOfMass) {
+                double x, y, z;
+                engine_.getCenterOfMass(x, y, z);
+            } else if (header.command == Command::GatherNodes) {
+                std::vector<IGSOAComplexNode> unused;
+                engine_.gatherNodes(unused);
+            } else if (header.command == Command::ScatterNodes) {
+                engine_.scatterNodes(std::vector<IGSOAComplexNode>());
+            } else if (header.command == Command::Reset) {
+                engine_.reset();
+            }
+        }
+    }
+
+private:
+    enum class Command : uint32_t {
+        Shutdown = 0,
+        RunMission,
+        TotalEnergy,
+        TotalEntropyRate,
+        CenterOfMass,
+        GatherNodes,
+        ScatterNodes,
+        Reset
+    };
+
+    struct Header {
+        Command command;
+        uint64_t num_steps;
+        uint32_t driven;   // Signals for num_steps follow
+    };
+
+    void send(Header header) {
+        engine_.getDecomposition().broadcast(&header, sizeof(header));
+    }
+
+    // All ranks: receive the mission's signals (root: already in `signals`)
+    void execute(const Header& header, std::vector<double> signals) {
+        if (header.driven) {
+            signals.resize(2 * header.num_steps);
+            engine_.getDecomposition().broadcast(signals.data(), signals.size() * sizeof(double));
+            engine_.runMission(header.num_steps, signals.data(), signals.data() + header.num_steps);
+        } else {
+            engine_.runMission(header.num_steps);
+        }
+    }
+
+    IGSOADistributedEngine3D& engine_;
+};
+
+} // namespace igsoa
+} // namespace dase
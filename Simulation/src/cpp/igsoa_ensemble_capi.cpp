@@ -0,0 +1,141 @@
+/**
+ * IGSOA C API Implementation - 1D Ensemble Engine
+ */
+
+#include "igsoa_ensemble_capi.h"
+#include "igsoa_ensemble_engine.h"
+
+using namespace dase::igsoa;
+
+// Create ensemble
+IGSOAEnsembleHandle igsoa_ensemble_create(
+    size_t num_nodes,
+    size_t num_replicas,
+    double R_c,
+    double kappa,
+    double gamma,
+    double dt
+) {
+    try {
+        IGSOAComplexConfig config;
+        config.num_nodes = num_nodes;
+        config.R_c_default = R_c;
+        config.kappa = kappa;
+        config.gamma = gamma;
+        config.dt = dt;
+
+        auto* engine = new IGSOAEnsembleEngine1D(config, num_replicas);
+        return static_cast<IGSOAEnsembleHandle>(engine);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+// Destroy ensemble
+void igsoa_ensemble_destroy(IGSOAEnsembleHandle handle) {
+    if (handle) {
+        auto* engine = static_cast<IGSOAEnsembleEngine1D*>(handle);
+        delete engine;
+    }
+}
+
+// Get nodes per replica
+size_t igsoa_ensemble_get_num_nodes(IGSOAEnsembleHandle handle) {
+    if (!handle) return 0;
+    return static_cast<IGSOAEnsembleEngine1D*>(handle)->getNumNodes();
+}
+
+// Get replicas
+size_t igsoa_ensemble_get_num_replicas(IGSOAEnsembleHandle handle) {
+    if (!handle) return 0;
+    return static_cast<IGSOAEnsembleEngine1D*>(handle)->getNumReplicas();
+}
+
+// Set κ / γ of one replica
+bool igsoa_ensemble_set_replica_coupling(
+    IGSOAEnsembleHandle handle,
+    size_t replica,
+    double kappa,
+    double gamma
+) {
+    if (!handle) return false;
+    return static_cast<IGSOAEnsembleEngine1D*>(handle)->setReplicaCoupling(replica, kappa, gamma);
+}
+
+// Get one field of a replica range
+bool igsoa_ensemble_get_field(
+    IGSOAEnsembleHandle handle,
+    IGSOAField field,
+    size_t first_replica,
+    size_t count,
+    double* out
+) {
+    if (!handle) return false;
+    auto* engine = static_cast<IGSOAEnsembleEngine1D*>(handle);
+    return engine->getField(static_cast<IGSOANodeField>(field), first_replica, count, out);
+}
+
+// Set one field of a replica range
+bool igsoa_ensemble_set_field(
+    IGSOAEnsembleHandle handle,
+    IGSOAField field,
+    size_t first_replica,
+    size_t count,
+    const double* in
+) {
+    if (!handle) return false;
+    auto* engine = static_cast<IGSOAEnsembleEngine1D*>(handle);
+    return engine->setField(static_cast<IGSOANodeField>(field), first_replica, count, in);
+}
+
+// Run mission
+bool igsoa_ensemble_run_mission(
+    IGSOAEnsembleHandle handle,
+    uint64_t num_steps
+) {
+    if (!handle) return false;
+    try {
+        static_cast<IGSOAEnsembleEngine1D*>(handle)->runMission(num_steps);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Get metrics
+void igsoa_ensemble_get_metrics(
+    IGSOAEnsembleHandle handle,
+    double* ns_per_op_out,
+    double* ops_per_sec_out,
+    double* speedup_out,
+    uint64_t* total_ops_out
+) {
+    if (!handle || !ns_per_op_out || !ops_per_sec_out || !speedup_out || !total_ops_out) return;
+    static_cast<IGSOAEnsembleEngine1D*>(handle)->getMetrics(
+        *ns_per_op_out, *ops_per_sec_out, *speedup_out, *total_ops_out);
+}
+
+// Get total energy of one replica
+double igsoa_ensemble_get_total_energy(IGSOAEnsembleHandle handle, size_t replica) {
+    if (!handle) return 0.0;
+    return static_cast<IGSOAEnsembleEngine1D*>(handle)->getTotalEnergy(replica);
+}
+
+// Get entropy rate of one replica
+double igsoa_ensemble_get_entropy_rate(IGSOAEnsembleHandle handle, size_t replica) {
+    if (!handle) return 0.0;
+    return static_cast<IGSOAEnsembleEngine1D*>(handle)->getTotalEntropyRate(replica);
+}
+
+// Get simulated time
+double igsoa_ensemble_get_current_time(IGSOAEnsembleHandle handle) {
+    if (!handle) return 0.0;
+    return static_cast<IGSOAEnsembleEngine1D*>(handle)->getCurrentTime();
+}
+
+// Reset
+void igsoa_ensemble_reset(IGSOAEnsembleHandle handle) {
+    if (handle) {
+        static_cast<IGSOAEnsembleEngine1D*>(handle)->reset();
+    }
+}
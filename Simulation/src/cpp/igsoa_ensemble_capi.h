@@ -0,0 +1,164 @@
+/**
+ * IGSOA C API - 1D Ensemble Engine Interface
+ *
+ * C-compatible API for the replica ensemble (IGSOAEnsembleEngine1D): many
+ * 1D lattices with shared N, R_c and dt stepped together.  Follows the
+ * pattern of the 2D C API (igsoa_capi_2d.h).
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Opaque handle to ensemble instance
+typedef void* IGSOAEnsembleHandle;
+
+#ifndef IGSOA_FIELD_DEFINED
+#define IGSOA_FIELD_DEFINED
+/**
+ * Per-node field selector for the bulk access functions (shared with igsoa_capi.h)
+ */
+typedef enum IGSOAField {
+    IGSOA_FIELD_PSI_REAL = 0,   // Re[Ψ]
+    IGSOA_FIELD_PSI_IMAG = 1,   // Im[Ψ]
+    IGSOA_FIELD_PHI = 2,        // Φ
+    IGSOA_FIELD_F = 3           // F = |Ψ|² (read-only)
+} IGSOAField;
+#endif
+
+/**
+ * Create an ensemble of 1D IGSOA lattices
+ *
+ * @param num_nodes Nodes per replica
+ * @param num_replicas Number of replicas (>= 1)
+ * @param R_c Causal radius shared by every replica
+ * @param kappa Initial coupling strength of every replica
+ * @param gamma Initial dissipation rate of every replica
+ * @param dt Time step
+ * @return Handle to ensemble instance (NULL on failure)
+ */
+IGSOAEnsembleHandle igsoa_ensemble_create(
+    size_t num_nodes,
+    size_t num_replicas,
+    double R_c,
+    double kappa,
+    double gamma,
+    double dt
+);
+
+/**
+ * Destroy an ensemble
+ *
+ * @param handle Ensemble handle
+ */
+void igsoa_ensemble_destroy(IGSOAEnsembleHandle handle);
+
+/**
+ * Get nodes per replica
+ */
+size_t igsoa_ensemble_get_num_nodes(IGSOAEnsembleHandle handle);
+
+/**
+ * Get number of replicas
+ */
+size_t igsoa_ensemble_get_num_replicas(IGSOAEnsembleHandle handle);
+
+/**
+ * Set κ and γ of one replica
+ *
+ * @return false for a null handle or a replica out of range
+ */
+bool igsoa_ensemble_set_replica_coupling(
+    IGSOAEnsembleHandle handle,
+    size_t replica,
+    double kappa,
+    double gamma
+);
+
+/**
+ * Copy one field of replicas [first_replica, first_replica + count) out of
+ * the ensemble, replica-major: node i of replica first_replica + r goes to
+ * out[r*num_nodes + i]
+ *
+ * @return false if the replicas leave the ensemble or out is NULL
+ */
+bool igsoa_ensemble_get_field(
+    IGSOAEnsembleHandle handle,
+    IGSOAField field,
+    size_t first_replica,
+    size_t count,
+    double* out
+);
+
+/**
+ * Copy one field (not F) of replicas into the ensemble; layout as for
+ * igsoa_ensemble_get_field.  Writing Ψ refreshes F.
+ */
+bool igsoa_ensemble_set_field(
+    IGSOAEnsembleHandle handle,
+    IGSOAField field,
+    size_t first_replica,
+    size_t count,
+    const double* in
+);
+
+/**
+ * Run time evolution mission on every replica
+ *
+ * @param handle Ensemble handle
+ * @param num_steps Number of time steps
+ * @return true on success
+ */
+bool igsoa_ensemble_run_mission(
+    IGSOAEnsembleHandle handle,
+    uint64_t num_steps
+);
+
+/**
+ * Get performance metrics
+ *
+ * @param handle Ensemble handle
+ * @param ns_per_op_out Output: nanoseconds per operation
+ * @param ops_per_sec_out Output: operations per second
+ * @param speedup_out Output: speedup factor vs baseline
+ * @param total_ops_out Output: total operations completed
+ */
+void igsoa_ensemble_get_metrics(
+    IGSOAEnsembleHandle handle,
+    double* ns_per_op_out,
+    double* ops_per_sec_out,
+    double* speedup_out,
+    uint64_t* total_ops_out
+);
+
+/**
+ * Get total energy E = ∑[|Ψ|² + Φ²] of one replica
+ */
+double igsoa_ensemble_get_total_energy(IGSOAEnsembleHandle handle, size_t replica);
+
+/**
+ * Get total entropy production rate Ṡ_total of one replica
+ */
+double igsoa_ensemble_get_entropy_rate(IGSOAEnsembleHandle handle, size_t replica);
+
+/**
+ * Get simulated time
+ */
+double igsoa_ensemble_get_current_time(IGSOAEnsembleHandle handle);
+
+/**
+ * Reset every replica to the zero state (replica couplings are kept)
+ *
+ * @param handle Ensemble handle
+ */
+void igsoa_ensemble_reset(IGSOAEnsembleHandle handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,564 @@
+/**
+ * IGSOA Ensemble Engine (1D)
+ *
+ * E replicas of a 1D IGSOA lattice that share N, R_c and dt but carry their
+ * own initial state and per-replica κ / γ (uncertainty sweeps).  State is
+ * stored node-major with the replica index fastest:
+ *
+ *   psi_re[i * E + r]   Re Ψ of node i in replica r  (likewise Im Ψ, Φ, F, Ṡ)
+ *
+ * so every coupling term w_k · (Ψ_{i+k} - Ψ_i) is one unit-stride sweep over
+ * the replicas with a single neighbour index and weight: the E scalar loops
+ * of E separate IGSOAComplexEngine instances become one `omp simd` loop of
+ * length E.
+ *
+ * Each replica evolves exactly as an IGSOAComplexEngine with the same
+ * config (Euler, double precision, uniform R_c = config.R_c_default) to
+ * round-off: the coupling sum adds neighbours in offset order, the replicas
+ * never mix.  DoubleBuffered steps split nodes across threads; InPlace steps
+ * keep the node order per replica and split replica blocks instead.
+ *
+ * Derived per-node fields are F = |Ψ|² and Ṡ (for the energy / entropy
+ * totals); phase is recomputed on demand and F_gradient is not tracked.
+ */
+
+#pragma once
+
+#include "aligned_allocator.h"
+#include "engine_memory.h"
+#include "igsoa_bulk_access.h"
+#include "igsoa_complex_node.h"
+#include "igsoa_physics.h"
+#include "kernel_traffic.h"
+#include "reproducible_sum.h"
+#include "trace_zones.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+class IGSOAEnsembleEngine1D {
+public:
+    using Array = std::vector<double, aligned_allocator<double, 64>>;
+
+    /**
+     * @param config Shared lattice configuration (num_nodes, R_c_default,
+     *               dt, update_mode, normalize_psi); kappa / gamma seed
+     *               every replica
+     * @param num_replicas Replicas E (>= 1)
+     * @throws std::invalid_argument for an invalid config, zero replicas,
+     *         a non-Euler integrator or a float precision mode
+     */
+    IGSOAEnsembleEngine1D(const IGSOAComplexConfig& config, size_t num_replicas)
+        : config_(config)
+        , N_(config.num_nodes)
+        , E_(num_replicas) {
+        config_.validateOrThrow();
+        if (num_replicas == 0) {
+            throw std::invalid_argument("IGSOA ensemble needs at least one replica");
+        }
+        if (config.integrator != IGSOAIntegrator::Euler || config.precision != IGSOAPrecision::Double) {
+            throw std::invalid_argument("IGSOA ensemble supports Euler steps in double precision only");
+        }
+        const size_t states = N_ * E_;
+        psi_re_.assign(states, 0.0);
+        psi_im_.assign(states, 0.0);
+        phi_.assign(states, 0.0);
+        F_.assign(states, 0.0);
+        entropy_.assign(states, 0.0);
+        if (config_.update_mode == IGSOAUpdateMode::DoubleBuffered) {
+            next_re_.assign(states, 0.0);
+            next_im_.assign(states, 0.0);
+        } else {
+            scratch_re_.assign(E_, 0.0);
+            scratch_im_.assign(E_, 0.0);
+        }
+        kappa_.assign(E_, config.kappa);
+        gamma_.assign(E_, config.gamma);
+        buildStencil();
+    }
+
+    size_t getNumNodes() const { return N_; }
+    size_t getNumReplicas() const { return E_; }
+    double getCurrentTime() const { return current_time_; }
+    uint64_t getTotalSteps() const { return total_steps_; }
+    uint64_t getTotalOperations() const { return total_operations_; }
+    const IGSOAComplexConfig& getConfig() const { return config_; }
+
+    // Neighbours summed per node (the 1D engine's terms for R_c_default)
+    size_t getStencilSize() const { return offsets_.size(); }
+
+    /**
+     * Per-replica Φ-Ψ coupling and dissipation
+     * @return false if replica is out of range
+     */
+    bool setReplicaCoupling(size_t replica, double kappa, double gamma) {
+        if (replica >= E_) {
+            return false;
+        }
+        kappa_[replica] = kappa;
+        gamma_[replica] = gamma;
+        return true;
+    }
+    double getReplicaKappa(size_t replica) const { return replica < E_ ? kappa_[replica] : 0.0; }
+    double getReplicaGamma(size_t replica) const { return replica < E_ ? gamma_[replica] : 0.0; }
+
+    void setNodePsi(size_t replica, size_t index, double real, double imag) {
+        if (replica < E_ && index < N_) {
+            const size_t k = index * E_ + replica;
+            psi_re_[k] = real;
+            psi_im_[k] = imag;
+            F_[k] = real * real + imag * imag;
+        }
+    }
+
+    void getNodePsi(size_t replica, size_t index, double& real_out, double& imag_out) const {
+        const bool valid = replica < E_ && index < N_;
+        real_out = valid ? psi_re_[index * E_ + replica] : 0.0;
+        imag_out = valid ? psi_im_[index * E_ + replica] : 0.0;
+    }
+
+    void setNodePhi(size_t replica, size_t index, double value) {
+        if (replica < E_ && index < N_) {
+            phi_[index * E_ + replica] = value;
+        }
+    }
+
+    double getNodePhi(size_t replica, size_t index) const {
+        return replica < E_ && index < N_ ? phi_[index * E_ + replica] : 0.0;
+    }
+
+    double getNodeF(size_t replica, size_t index) const {
+        return replica < E_ && index < N_ ? F_[index * E_ + replica] : 0.0;
+    }
+
+    /**
+     * Copy one field of replicas [first, first + count) from a
+     * replica-major buffer: node i of replica first + r is in[r * N + i].
+     * Writing Ψ refreshes F = |Ψ|².
+     *
+     * @return false for F (read-only), a null buffer or replicas out of range
+     */
+    bool setField(IGSOANodeField field, size_t first, size_t count, const double* in) {
+        if (!in || field == IGSOANodeField::F || first > E_ || count > E_ - first) {
+            return false;
+        }
+        Array& target = fieldArray(field);
+        for (size_t r = 0; r < count; ++r) {
+            const double* src = in + r * N_;
+            for (size_t i = 0; i < N_; ++i) {
+                const size_t k = i * E_ + first + r;
+                target[k] = src[i];
+                if (field != IGSOANodeField::Phi) {
+                    F_[k] = psi_re_[k] * psi_re_[k] + psi_im_[k] * psi_im_[k];
+                }
+            }
+        }
+        return true;
+    }
+
+    // Replica-major copy of one field of replicas [first, first + count)
+    bool getField(IGSOANodeField field, size_t first, size_t count, double* out) const {
+        if (!out || first > E_ || count > E_ - first) {
+            return false;
+        }
+        const Array& source = const_cast<IGSOAEnsembleEngine1D*>(this)->fieldArray(field);
+        for (size_t r = 0; r < count; ++r) {
+            double* dst = out + r * N_;
+            for (size_t i = 0; i < N_; ++i) {
+                dst[i] = source[i * E_ + first + r];
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Run mission - every replica takes num_steps steps
+     *
+     * @param input_signals Optional driving signals (length: num_steps),
+     *                      applied to every replica as IGSOAPhysics::applyDriving
+     * @param control_patterns Optional control patterns (length: num_steps)
+     */
+    void runMission(uint64_t num_steps,
+                    const double* input_signals = nullptr,
+                    const double* control_patterns = nullptr) {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        uint64_t operations_this_run = 0;
+        const bool driven = input_signals && control_patterns;
+
+        for (uint64_t step = 0; step < num_steps; ++step) {
+            if (driven) {
+                applyDriving(input_signals[step], control_patterns[step]);
+                operations_this_run += static_cast<uint64_t>(N_ * E_);
+            }
+            operations_this_run += timeStep();
+            current_time_ += config_.dt;
+            total_steps_++;
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+        total_operations_ += operations_this_run;
+        last_execution_time_ns_ = duration.count();
+        last_mission_steps_ = num_steps;
+        last_step_traffic_ = stepTraffic(driven);
+        if (operations_this_run > 0) {
+            ns_per_op_ = static_cast<double>(duration.count()) / operations_this_run;
+            ops_per_sec_ = 1.0e9 / ns_per_op_;
+        }
+    }
+
+    /**
+     * Performance metrics (operations counted per replica as the 1D engine
+     * counts them, without its gradient pass)
+     */
+    void getMetrics(double& out_ns_per_op,
+                    double& out_ops_per_sec,
+                    double& out_speedup_factor,
+                    uint64_t& out_total_ops) const {
+        out_ns_per_op = ns_per_op_;
+        out_ops_per_sec = ops_per_sec_;
+        out_speedup_factor = (ns_per_op_ > 0.0) ? (15500.0 / ns_per_op_) : 0.0;  // vs baseline
+        out_total_ops = total_operations_;
+    }
+
+    // Modelled bytes / FLOPs per step of the last mission and its rates
+    KernelRoofline getRoofline() const {
+        return kernelRoofline(last_step_traffic_, last_mission_steps_,
+                              static_cast<double>(last_execution_time_ns_) * 1.0e-9);
+    }
+
+    // E = ∑_i [|Ψ_i|² + Φ_i²] of one replica (F as of the last step)
+    double getTotalEnergy(size_t replica) const {
+        if (replica >= E_) {
+            return 0.0;
+        }
+        // Same association as IGSOAPhysics::computeTotals
+        return reproducibleSums<1>(static_cast<int64_t>(N_), [&](int64_t i, double* acc) {
+            const size_t k = static_cast<size_t>(i) * E_ + replica;
+            acc[0] += F_[k];
+            acc[0] += phi_[k] * phi_[k];
+        }, N_ >= config_.omp_min_nodes)[0];
+    }
+
+    // Ṡ_total = ∑_i Ṡ_i of one replica
+    double getTotalEntropyRate(size_t replica) const {
+        return replicaSum(replica, [this](size_t k) { return entropy_[k]; });
+    }
+
+    // <F> of one replica
+    double getAverageInformationalDensity(size_t replica) const {
+        const double sum = replicaSum(replica, [this](size_t k) { return F_[k]; });
+        return N_ > 0 ? sum / static_cast<double>(N_) : 0.0;
+    }
+
+    // <θ> = (1/N) ∑_i arg(Ψ_i) of one replica
+    double getAveragePhase(size_t replica) const {
+        const double sum = replicaSum(replica, [this](size_t k) { return std::atan2(psi_im_[k], psi_re_[k]); });
+        return N_ > 0 ? sum / static_cast<double>(N_) : 0.0;
+    }
+
+    // Zero every replica's state and the counters (couplings are kept)
+    void reset() {
+        std::fill(psi_re_.begin(), psi_re_.end(), 0.0);
+        std::fill(psi_im_.begin(), psi_im_.end(), 0.0);
+        std::fill(phi_.begin(), phi_.end(), 0.0);
+        std::fill(F_.begin(), F_.end(), 0.0);
+        std::fill(entropy_.begin(), entropy_.end(), 0.0);
+        current_time_ = 0.0;
+        total_steps_ = 0;
+        total_operations_ = 0;
+        ns_per_op_ = 0.0;
+        ops_per_sec_ = 0.0;
+        last_execution_time_ns_ = 0;
+        last_mission_steps_ = 0;
+        last_step_traffic_ = KernelTraffic();
+    }
+
+    /**
+     * Bytes held by the replica-interleaved fields and parameters (state),
+     * the shared coupling stencil (caches) and the next-step or per-node
+     * replica buffers (scratch)
+     */
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint bytes;
+        bytes.state = capacityBytes(psi_re_) + capacityBytes(psi_im_) + capacityBytes(phi_) + capacityBytes(F_) +
+                      capacityBytes(entropy_) + capacityBytes(kappa_) + capacityBytes(gamma_);
+        bytes.caches = capacityBytes(weights_) + capacityBytes(offsets_);
+        bytes.scratch = capacityBytes(next_re_) + capacityBytes(next_im_) +
+                        capacityBytes(scratch_re_) + capacityBytes(scratch_im_);
+        return bytes;
+    }
+
+    size_t getMemoryUsage() const { return static_cast<size_t>(memoryFootprint().total()); }
+
+    /**
+     * memoryFootprint() of an ensemble built from `config`
+     */
+    static MemoryFootprint estimateMemory(const IGSOAComplexConfig& config, size_t num_replicas) {
+        const uint64_t states = static_cast<uint64_t>(config.num_nodes) * num_replicas;
+        MemoryFootprint bytes;
+        bytes.state = (5 * states + 2 * num_replicas) * sizeof(double);
+        uint64_t stencil = 0;
+        const double radius = std::max(config.R_c_default, 0.0);
+        const int64_t N = static_cast<int64_t>(config.num_nodes);
+        if (N >= 2 && radius > 0.0) {
+            const int reach = static_cast<int>(std::ceil(radius));
+            for (int offset = -reach; offset <= reach; ++offset) {
+                const size_t shift = static_cast<size_t>(((offset % N) + N) % N);
+                if (offset != 0 && IGSOAPhysics::wrappedDistance(0, shift, config.num_nodes) <= radius) {
+                    stencil++;
+                }
+            }
+        }
+        bytes.caches = stencil * (sizeof(double) + sizeof(size_t));
+        bytes.scratch = (config.update_mode == IGSOAUpdateMode::DoubleBuffered ? 2 * states : 2 * num_replicas) *
+                        sizeof(double);
+        return bytes;
+    }
+
+private:
+    // Replicas per InPlace work item (a multiple of the widest vector)
+    static constexpr size_t kReplicaBlock = 16;
+
+    Array& fieldArray(IGSOANodeField field) {
+        switch (field) {
+            case IGSOANodeField::PsiReal: return psi_re_;
+            case IGSOANodeField::PsiImag: return psi_im_;
+            case IGSOANodeField::Phi:     return phi_;
+            case IGSOANodeField::F:
+            default:                      return F_;
+        }
+    }
+
+    // ∑_i term(i * E + replica) over the replica's nodes (reproducible_sum.h;
+    // 0 for a replica out of range)
+    template <typename TermFn>
+    double replicaSum(size_t replica, TermFn&& term) const {
+        if (replica >= E_) {
+            return 0.0;
+        }
+        return reproducibleSum(static_cast<int64_t>(N_), [&](int64_t i) {
+            return term(static_cast<size_t>(i) * E_ + replica);
+        }, N_ >= config_.omp_min_nodes);
+    }
+
+    /**
+     * Neighbour offsets (mod N) and weights of the 1D engine for the shared
+     * R_c and coupling law: offsets -R..R except 0, kept when the wrapped
+     * distance is within R_c (aliased offsets on short rings are summed
+     * twice, as there)
+     */
+    void buildStencil() {
+        offsets_.clear();
+        weights_.clear();
+        const double radius = std::max(config_.R_c_default, 0.0);
+        if (N_ < 2 || radius <= 0.0) {
+            return;
+        }
+        const int reach = static_cast<int>(std::ceil(radius));
+        const int64_t N = static_cast<int64_t>(N_);
+        for (int offset = -reach; offset <= reach; ++offset) {
+            if (offset == 0) {
+                continue;
+            }
+            const size_t shift = static_cast<size_t>(((offset % N) + N) % N);
+            const double distance = IGSOAPhysics::wrappedDistance(0, shift, N_);
+            if (distance <= radius) {
+                offsets_.push_back(shift);
+                weights_.push_back(kernelWeight(config_.kernel_policy, distance, radius));
+            }
+        }
+    }
+
+    void applyDriving(double signal_real, double signal_imag) {
+        const size_t states = N_ * E_;
+        double* psi_re = psi_re_.data();
+        double* psi_im = psi_im_.data();
+        double* phi = phi_.data();
+        #pragma omp simd
+        for (size_t k = 0; k < states; ++k) {
+            phi[k] += signal_real;
+            psi_re[k] += signal_real;
+            psi_im[k] += signal_imag;
+        }
+    }
+
+    /**
+     * Ψ of node i for replicas [r0, r1): acc = Σ_k w_k (Ψ_{i+k} - Ψ_i), then
+     * the Euler update of the 1D engine into out (acc and out indexed by r)
+     */
+    void evolveNode(size_t i, size_t r0, size_t r1,
+                    double* acc_re, double* acc_im,
+                    double* out_re, double* out_im) const {
+        const double* psi_re = psi_re_.data();
+        const double* psi_im = psi_im_.data();
+        const double* self_re = psi_re + i * E_;
+        const double* self_im = psi_im + i * E_;
+        const double* phi = phi_.data() + i * E_;
+        const double* kappa = kappa_.data();
+        const double* gamma = gamma_.data();
+        const double dt = config_.dt;
+
+        #pragma omp simd
+        for (size_t r = r0; r < r1; ++r) {
+            acc_re[r] = 0.0;
+            acc_im[r] = 0.0;
+        }
+        for (size_t k = 0; k < offsets_.size(); ++k) {
+            size_t j = i + offsets_[k];
+            if (j >= N_) {
+                j -= N_;
+            }
+            const double w = weights_[k];
+            const double* nb_re = psi_re + j * E_;
+            const double* nb_im = psi_im + j * E_;
+            #pragma omp simd
+            for (size_t r = r0; r < r1; ++r) {
+                acc_re[r] += w * (nb_re[r] - self_re[r]);
+                acc_im[r] += w * (nb_im[r] - self_im[r]);
+            }
+        }
+        // Ĥ Ψ = -𝒦[Ψ] + κΦ Ψ + iγ Ψ;  Ψ̇ = -i Ĥ Ψ
+        #pragma omp simd
+        for (size_t r = r0; r < r1; ++r) {
+            const double p_re = self_re[r];
+            const double p_im = self_im[r];
+            const double V = kappa[r] * phi[r];
+            const double H_re = (-acc_re[r] + V * p_re) - gamma[r] * p_im;
+            const double H_im = (-acc_im[r] + V * p_im) + gamma[r] * p_re;
+            out_re[r] = p_re + H_im * dt;
+            out_im[r] = p_im - H_re * dt;
+        }
+    }
+
+    uint64_t timeStep() {
+        const size_t states = N_ * E_;
+        const bool in_place = config_.update_mode == IGSOAUpdateMode::InPlace;
+        const int64_t N_int = static_cast<int64_t>(N_);
+        const int64_t blocks = static_cast<int64_t>((E_ + kReplicaBlock - 1) / kReplicaBlock);
+        const double R_c = config_.R_c_default;
+        const bool normalize = config_.normalize_psi;
+
+        #pragma omp parallel if(states >= config_.omp_min_nodes)
+        {
+            // 1. Ψ coupling + Euler update
+            {
+                DASE_TRACE_ZONE("igsoa.coupling");
+                if (in_place) {
+                    // Node order matters within a replica, not across them
+                    #pragma omp for schedule(static)
+                    for (int64_t b = 0; b < blocks; ++b) {
+                        const size_t r0 = static_cast<size_t>(b) * kReplicaBlock;
+                        const size_t r1 = std::min(E_, r0 + kReplicaBlock);
+                        for (size_t i = 0; i < N_; ++i) {
+                            evolveNode(i, r0, r1, scratch_re_.data(), scratch_im_.data(),
+                                       psi_re_.data() + i * E_, psi_im_.data() + i * E_);
+                        }
+                    }
+                } else {
+                    #pragma omp for schedule(static)
+                    for (int64_t ii = 0; ii < N_int; ++ii) {
+                        const size_t i = static_cast<size_t>(ii);
+                        double* out_re = next_re_.data() + i * E_;
+                        double* out_im = next_im_.data() + i * E_;
+                        evolveNode(i, 0, E_, out_re, out_im, out_re, out_im);
+                    }
+                    #pragma omp single
+                    {
+                        psi_re_.swap(next_re_);
+                        psi_im_.swap(next_im_);
+                    }
+                }
+            }
+
+            // 2-5. Φ, F, Ṡ and per-node normalization in one pass
+            {
+                DASE_TRACE_ZONE("igsoa.causal_field");
+                double* psi_re = psi_re_.data();
+                double* psi_im = psi_im_.data();
+                double* phi = phi_.data();
+                double* F = F_.data();
+                double* entropy = entropy_.data();
+                const double* kappa = kappa_.data();
+                const double* gamma = gamma_.data();
+                const double dt = config_.dt;
+                #pragma omp for schedule(static)
+                for (int64_t ii = 0; ii < N_int; ++ii) {
+                    const size_t base = static_cast<size_t>(ii) * E_;
+                    #pragma omp simd
+                    for (size_t r = 0; r < E_; ++r) {
+                        const size_t k = base + r;
+                        const double re = psi_re[k];
+                        const double im = psi_im[k];
+                        const double phi_dot = -kappa[r] * (phi[k] - re) - gamma[r] * phi[k];
+                        const double phi_new = phi[k] + phi_dot * dt;
+                        const double diff = phi_new - re;
+                        const double density = re * re + im * im;
+                        phi[k] = phi_new;
+                        F[k] = density;
+                        entropy[k] = R_c * diff * diff;
+                        if (normalize) {
+                            const double magnitude = std::sqrt(density);
+                            const double scale = magnitude > 1e-15 ? 1.0 / magnitude : 1.0;
+                            psi_re[k] = re * scale;
+                            psi_im[k] = im * scale;
+                        }
+                    }
+                }
+            }
+        }
+
+        const uint64_t per_replica_node = 1 + offsets_.size() + 2 + (normalize ? 1 : 0);
+        return static_cast<uint64_t>(states) * per_replica_node;
+    }
+
+    // Traffic of one step per replica-node (neighbours assumed cached)
+    KernelTraffic stepTraffic(bool driven) const {
+        const double n = static_cast<double>(N_ * E_);
+        const double value = static_cast<double>(sizeof(double));
+        KernelTraffic step;
+        if (driven) {
+            step += kernelPass(n, 3.0 * value, 3.0 * value, 3.0);
+        }
+        step += kernelPass(n, 3.0 * value, 2.0 * value, 10.0 + 6.0 * static_cast<double>(offsets_.size()));
+        step += kernelPass(n, 3.0 * value, (config_.normalize_psi ? 5.0 : 3.0) * value,
+                           13.0 + (config_.normalize_psi ? 4.0 : 0.0));
+        return step;
+    }
+
+    IGSOAComplexConfig config_;
+    size_t N_;   // Nodes per replica
+    size_t E_;   // Replicas
+
+    // Node-major, replica-fastest state (index i * E + r)
+    Array psi_re_, psi_im_;
+    Array next_re_, next_im_;         // DoubleBuffered output
+    Array scratch_re_, scratch_im_;   // InPlace coupling sums (per replica)
+    Array phi_, F_, entropy_;
+    Array kappa_, gamma_;             // Per replica
+
+    // Shared coupling stencil (neighbour = (i + offset) mod N)
+    std::vector<size_t> offsets_;
+    Array weights_;
+
+    double current_time_ = 0.0;
+    uint64_t total_steps_ = 0;
+    uint64_t total_operations_ = 0;
+
+    double ns_per_op_ = 0.0;
+    double ops_per_sec_ = 0.0;
+    int64_t last_execution_time_ns_ = 0;
+    uint64_t last_mission_steps_ = 0;
+    KernelTraffic last_step_traffic_;
+};
+
+} // namespace igsoa
+} // namespace dase
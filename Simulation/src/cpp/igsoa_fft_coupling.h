@@ -0,0 +1,266 @@
+/**
+ * IGSOA Spectral (FFT) Coupling Backend
+ *
+ * For a uniform causal radius the non-local coupling sum
+ *
+ *   𝒦[Ψ]_i = ∑_k w_k (Ψ_{i+k} - Ψ_i)
+ *
+ * is a fixed periodic correlation of Ψ with the NeighborStencil2D/3D table,
+ * so the whole lattice can be evaluated as IFFT(FFT(K) · FFT(Ψ)) - W Ψ with
+ * W = ∑_k w_k.  Cost is O(N log N) per step instead of O(N (2R_c+1)^d), which
+ * dominates once R_c ≳ 8 in 3D.
+ *
+ * - Plans come from the process-wide FFTPlanRegistry (in-place c2c, one per
+ *   lattice shape and direction, shared by every instance) and run on this
+ *   instance's buffer through fftw_execute_dft.
+ * - The kernel spectrum is cached per R_c and coupling law (rebuilt only
+ *   when either changes).
+ * - The whole field is computed from one Ψ snapshot, so the result matches
+ *   the direct sum only in IGSOAUpdateMode::DoubleBuffered (to FFT
+ *   round-off); the engines never select it for InPlace stepping.
+ *
+ * The FFTW-backed implementation is compiled when USE_FFTW3 is defined;
+ * otherwise isAvailable() is false, build() fails and the engines keep using
+ * the direct/stencil path.
+ */
+
+#pragma once
+
+#include "neighbor_cache.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef USE_FFTW3
+#include "fftw_plan_registry.hpp"
+#include <stdexcept>
+#endif
+
+namespace dase {
+namespace igsoa {
+
+class IGSOASpectralCoupling {
+public:
+    IGSOASpectralCoupling() = default;
+    ~IGSOASpectralCoupling() { releasePlans(); }
+
+    IGSOASpectralCoupling(const IGSOASpectralCoupling&) = delete;
+    IGSOASpectralCoupling& operator=(const IGSOASpectralCoupling&) = delete;
+
+    /**
+     * True if this build has an FFT library
+     */
+    static constexpr bool isAvailable() {
+#ifdef USE_FFTW3
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * True if the cached kernel spectrum is valid for this lattice, radius
+     * and coupling law
+     */
+    bool matches(size_t N_x, size_t N_y, size_t N_z, double R_c,
+                 IGSOAKernelPolicy kernel = IGSOAKernelPolicy::Exponential) const {
+        return is_built_ && N_x == N_x_ && N_y == N_y_ && N_z == N_z_ && R_c == R_c_ && kernel == kernel_;
+    }
+
+    /**
+     * Build kernel spectrum from a 2D stencil
+     *
+     * @return false if no FFT backend is available
+     */
+    bool build(const NeighborStencil2D& stencil, size_t N_x, size_t N_y) {
+        return buildFromStencil(stencil.size(), stencil.dx(), stencil.dy(), nullptr,
+                                stencil.weight(), stencil.getRc(), stencil.kernelPolicy(), N_x, N_y, 1);
+    }
+
+    /**
+     * Build kernel spectrum from a 3D stencil
+     *
+     * @return false if no FFT backend is available
+     */
+    bool build(const NeighborStencil3D& stencil, size_t N_x, size_t N_y, size_t N_z) {
+        return buildFromStencil(stencil.size(), stencil.dx(), stencil.dy(), stencil.dz(),
+                                stencil.weight(), stencil.getRc(), stencil.kernelPolicy(), N_x, N_y, N_z);
+    }
+
+    /**
+     * Evaluate 𝒦[Ψ] for every node from a packed Ψ snapshot
+     *
+     * Not thread-safe: call from one thread (the physics kernels wrap it in
+     * `omp single`).
+     */
+    void apply(const double* psi_re, const double* psi_im) {
+#ifdef USE_FFTW3
+        if (!is_built_) return;
+        const size_t N = coupling_re_.size();
+        for (size_t i = 0; i < N; ++i) {
+            work_[i][0] = psi_re[i];
+            work_[i][1] = psi_im[i];
+        }
+        fftw_execute_dft(forward_, work_, work_);
+        for (size_t i = 0; i < N; ++i) {
+            work_[i][0] *= kernel_hat_[i];
+            work_[i][1] *= kernel_hat_[i];
+        }
+        fftw_execute_dft(backward_, work_, work_);
+
+        // FFTW transforms are unnormalized: scale by 1/N
+        const double scale = 1.0 / static_cast<double>(N);
+        for (size_t i = 0; i < N; ++i) {
+            coupling_re_[i] = work_[i][0] * scale - weight_sum_ * psi_re[i];
+            coupling_im_[i] = work_[i][1] * scale - weight_sum_ * psi_im[i];
+        }
+#else
+        (void)psi_re;
+        (void)psi_im;
+#endif
+    }
+
+    const double* couplingRe() const { return coupling_re_.data(); }
+    const double* couplingIm() const { return coupling_im_.data(); }
+
+    /**
+     * Direct-sum neighbour operations each node's coupling stands in for
+     * (keeps operation metrics comparable across backends)
+     */
+    uint64_t opsPerNode() const { return ops_per_node_; }
+
+    bool isBuilt() const { return is_built_; }
+
+    size_t getMemoryUsage() const {
+        size_t bytes = (kernel_hat_.capacity() + coupling_re_.capacity() + coupling_im_.capacity()) * sizeof(double);
+#ifdef USE_FFTW3
+        if (work_) bytes += plan_size_ * sizeof(fftw_complex);
+#endif
+        return bytes;
+    }
+
+    // getMemoryUsage() once built for a lattice of `num_points` (0 without FFTW)
+    static size_t estimateBytes(size_t num_points) {
+#ifdef USE_FFTW3
+        return num_points * (3 * sizeof(double) + sizeof(fftw_complex));
+#else
+        (void)num_points;
+        return 0;
+#endif
+    }
+
+private:
+    bool buildFromStencil(
+        size_t count,
+        const int* dx, const int* dy, const int* dz,
+        const double* weight,
+        double R_c,
+        IGSOAKernelPolicy kernel,
+        size_t N_x, size_t N_y, size_t N_z
+    ) {
+#ifdef USE_FFTW3
+        const size_t N = N_x * N_y * N_z;
+        if (N == 0) return false;
+
+        if (!work_ || plan_size_ != N || N_x != N_x_ || N_y != N_y_ || N_z != N_z_) {
+            releasePlans();
+            work_ = FFTPlanRegistry::allocComplex(N);
+            plan_size_ = N;
+            if (!work_) {
+                releasePlans();
+                return false;
+            }
+            // Row-major (z, y, x) with x fastest
+            const int nx = static_cast<int>(N_x);
+            const int ny = static_cast<int>(N_y);
+            const int nz = static_cast<int>(N_z);
+            const FFTPlanKey::Kind c2c = FFTPlanKey::Kind::C2C;
+            try {
+                forward_ = FFTPlanRegistry::acquire(
+                    N_z == 1 ? FFTPlanKey::make(c2c, {ny, nx}, FFTW_FORWARD, true)
+                             : FFTPlanKey::make(c2c, {nz, ny, nx}, FFTW_FORWARD, true));
+                backward_ = FFTPlanRegistry::acquire(
+                    N_z == 1 ? FFTPlanKey::make(c2c, {ny, nx}, FFTW_BACKWARD, true)
+                             : FFTPlanKey::make(c2c, {nz, ny, nx}, FFTW_BACKWARD, true));
+            } catch (const std::runtime_error&) {
+                releasePlans();
+                return false;
+            }
+        }
+
+        N_x_ = N_x;
+        N_y_ = N_y;
+        N_z_ = N_z;
+        R_c_ = R_c;
+        kernel_ = kernel;
+
+        // Scatter weights at the negated offsets: correlation as convolution
+        // (aliased offsets on small lattices accumulate, as in the direct sum)
+        const int nx = static_cast<int>(N_x);
+        const int ny = static_cast<int>(N_y);
+        const int nz = static_cast<int>(N_z);
+        for (size_t i = 0; i < N; ++i) {
+            work_[i][0] = 0.0;
+            work_[i][1] = 0.0;
+        }
+        weight_sum_ = 0.0;
+        for (size_t k = 0; k < count; ++k) {
+            int x = (-dx[k]) % nx; if (x < 0) x += nx;
+            int y = (-dy[k]) % ny; if (y < 0) y += ny;
+            int z = dz ? (-dz[k]) % nz : 0; if (z < 0) z += nz;
+            const size_t idx = (static_cast<size_t>(z) * N_y + static_cast<size_t>(y)) * N_x + static_cast<size_t>(x);
+            work_[idx][0] += weight[k];
+            weight_sum_ += weight[k];
+        }
+        fftw_execute_dft(forward_, work_, work_);
+
+        // The stencil is point-symmetric, so its spectrum is real
+        kernel_hat_.resize(N);
+        for (size_t i = 0; i < N; ++i) {
+            kernel_hat_[i] = work_[i][0];
+        }
+        coupling_re_.assign(N, 0.0);
+        coupling_im_.assign(N, 0.0);
+        ops_per_node_ = static_cast<uint64_t>(count);
+        is_built_ = true;
+        return true;
+#else
+        (void)count; (void)dx; (void)dy; (void)dz; (void)weight;
+        (void)R_c; (void)kernel; (void)N_x; (void)N_y; (void)N_z;
+        return false;
+#endif
+    }
+
+    void releasePlans() {
+#ifdef USE_FFTW3
+        // Plans belong to the registry
+        FFTPlanRegistry::release(work_);
+        forward_ = nullptr;
+        backward_ = nullptr;
+        work_ = nullptr;
+        plan_size_ = 0;
+#endif
+        is_built_ = false;
+    }
+
+#ifdef USE_FFTW3
+    fftw_plan forward_ = nullptr;    // Registry-owned
+    fftw_plan backward_ = nullptr;
+    fftw_complex* work_ = nullptr;
+    size_t plan_size_ = 0;
+#endif
+
+    std::vector<double> kernel_hat_;   // Real spectrum of the stencil kernel
+    std::vector<double> coupling_re_;  // Re[𝒦[Ψ]] per node
+    std::vector<double> coupling_im_;  // Im[𝒦[Ψ]] per node
+    double weight_sum_ = 0.0;
+    uint64_t ops_per_node_ = 0;
+
+    size_t N_x_ = 0, N_y_ = 0, N_z_ = 0;
+    double R_c_ = 0.0;
+    IGSOAKernelPolicy kernel_ = IGSOAKernelPolicy::Exponential;
+    bool is_built_ = false;
+};
+
+} // namespace igsoa
+} // namespace dase
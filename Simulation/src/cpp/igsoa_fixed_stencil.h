@@ -0,0 +1,280 @@
+/**
+ * IGSOA Fixed-Radius Stencil Kernels
+ *
+ * Interior coupling sums of IGSOAPhysics, IGSOAPhysics2D and IGSOAPhysics3D
+ * for the common integer radii R_c = 1..4, specialized at compile time on
+ * (Dim, R).  The offset set { d : |d|² <= R², d != 0 } is enumerated in
+ * constexpr code in the same order as NeighborStencil2D/3D (dz, dy, dx) and
+ * grouped into the same contiguous x-runs, so every run length, run start and
+ * weight index is a constant and each run is a fully unrolled straight-line
+ * sum: no runtime radius test, no run table walk, no loop control.
+ *
+ *   Dim   R=1   R=2   R=3   R=4    (neighbours / runs)
+ *   1     2/1   4/1   6/1   8/1    one span of 2R+1 (zero-weight centre)
+ *   2     4/4   12/6  28/8   48/10
+ *   3     6/6   32/14 122/30 256/50
+ *
+ * Weights are still read from the stencil's table (exp is not constexpr),
+ * at fixed indices.  Any other radius, or a lattice too small for the runs
+ * to match the runtime table (every side >= 2R + 2), takes the generic path.
+ *
+ * Numerics: each run is accumulated exactly as IGSOACouplingKernels does it
+ * (scalar: index order into the sum; AVX2: four lanes, FMA, horizontal sum,
+ * scalar tail), so a fixed-radius sum is bit-identical to the generic one in
+ * the same SIMD mode.
+ */
+
+#pragma once
+
+#include "igsoa_simd_coupling.h"
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace dase {
+namespace igsoa {
+
+/**
+ * One contiguous x-run of a fixed stencil
+ */
+struct FixedStencilRun {
+    int dx = 0;              // Offset of the first entry
+    int dy = 0;
+    int dz = 0;
+    size_t begin = 0;        // Index of the first entry's weight
+    size_t length = 0;
+
+    constexpr std::ptrdiff_t linearOffset(std::ptrdiff_t row, std::ptrdiff_t plane) const {
+        return static_cast<std::ptrdiff_t>(dz) * plane + static_cast<std::ptrdiff_t>(dy) * row + dx;
+    }
+};
+
+template <int Dim, int R>
+struct FixedStencilShape {
+    static_assert(Dim >= 1 && Dim <= 3, "IGSOA lattices are 1D, 2D or 3D");
+    static_assert(R >= 1, "fixed stencils need a positive radius");
+
+    // Largest |dx| with dx² <= R² - rest
+    static constexpr int halfWidth(int rest) {
+        int w = 0;
+        while ((w + 1) * (w + 1) <= R * R - rest) ++w;
+        return w;
+    }
+
+    template <typename Visit>
+    static constexpr void forEachRow(Visit&& visit) {
+        const int z_reach = Dim == 3 ? R : 0;
+        const int y_reach = Dim >= 2 ? R : 0;
+        for (int dz = -z_reach; dz <= z_reach; ++dz) {
+            for (int dy = -y_reach; dy <= y_reach; ++dy) {
+                if (dy * dy + dz * dz <= R * R) {
+                    visit(dy, dz, halfWidth(dy * dy + dz * dz));
+                }
+            }
+        }
+    }
+
+    static constexpr size_t countRuns() {
+        if (Dim == 1) return 1;
+        size_t runs = 0;
+        forEachRow([&runs](int dy, int dz, int w) {
+            // The centre row splits around the excluded self entry
+            runs += (dy == 0 && dz == 0) ? (w > 0 ? 2 : 0) : 1;
+        });
+        return runs;
+    }
+
+    static constexpr size_t kNumRuns = countRuns();
+
+    static constexpr std::array<FixedStencilRun, kNumRuns> makeRuns() {
+        std::array<FixedStencilRun, kNumRuns> runs{};
+        if (Dim == 1) {
+            // The 1D interior span includes the centre with weight 0
+            runs[0] = {-R, 0, 0, 0, static_cast<size_t>(2 * R + 1)};
+            return runs;
+        }
+        size_t r = 0;
+        size_t entry = 0;
+        forEachRow([&](int dy, int dz, int w) {
+            if (dy == 0 && dz == 0) {
+                if (w == 0) return;
+                runs[r++] = {-w, dy, dz, entry, static_cast<size_t>(w)};
+                entry += static_cast<size_t>(w);
+                runs[r++] = {1, dy, dz, entry, static_cast<size_t>(w)};
+                entry += static_cast<size_t>(w);
+            } else {
+                runs[r++] = {-w, dy, dz, entry, static_cast<size_t>(2 * w + 1)};
+                entry += static_cast<size_t>(2 * w + 1);
+            }
+        });
+        return runs;
+    }
+
+    static constexpr std::array<FixedStencilRun, kNumRuns> kRuns = makeRuns();
+
+    static constexpr size_t countNeighbors() {
+        size_t count = 0;
+        for (size_t r = 0; r < kNumRuns; ++r) count += kRuns[r].length;
+        return Dim == 1 ? count - 1 : count;
+    }
+
+    // Neighbours actually coupled (excludes the 1D zero-weight centre)
+    static constexpr size_t kNeighbors = countNeighbors();
+};
+
+struct FixedStencilKernels {
+    static constexpr int kMaxRadius = 4;
+
+    /**
+     * R if `R_c` is one of the specialized radii and every lattice side is
+     * large enough for the fixed runs to equal the runtime ones, else 0
+     */
+    static int fixedRadius(double R_c, size_t N_x, size_t N_y = 0, size_t N_z = 0) {
+        for (int R = 1; R <= kMaxRadius; ++R) {
+            if (R_c == static_cast<double>(R)) {
+                const size_t side = static_cast<size_t>(2 * R + 2);
+                const bool fits = N_x >= side && (N_y == 0 || N_y >= side) && (N_z == 0 || N_z >= side);
+                return fits ? R : 0;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * acc += Σ_{m} w[m] (Ψ[i + offset_r + m] - Ψ_i) over all runs of the
+     * (Dim, R) stencil.  `centre` points at Ψ_i in both arrays, `row` and
+     * `plane` are the lattice strides (unused below Dim 2 / 3).  Returns
+     * false for a radius without a specialization (no terms added).
+     */
+    template <int Dim>
+    static bool accumulateInterior(
+        int R, bool simd,
+        const double* re_centre, const double* im_centre,
+        std::ptrdiff_t row, std::ptrdiff_t plane, const double* w,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        switch (R) {
+            case 1: interior<Dim, 1>(simd, re_centre, im_centre, row, plane, w, self_re, self_im, acc_re, acc_im); return true;
+            case 2: interior<Dim, 2>(simd, re_centre, im_centre, row, plane, w, self_re, self_im, acc_re, acc_im); return true;
+            case 3: interior<Dim, 3>(simd, re_centre, im_centre, row, plane, w, self_re, self_im, acc_re, acc_im); return true;
+            case 4: interior<Dim, 4>(simd, re_centre, im_centre, row, plane, w, self_re, self_im, acc_re, acc_im); return true;
+            default: return false;
+        }
+    }
+
+private:
+    template <int Dim, int R>
+    static inline void interior(
+        bool simd,
+        const double* re_centre, const double* im_centre,
+        std::ptrdiff_t row, std::ptrdiff_t plane, const double* w,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        using Runs = std::make_index_sequence<FixedStencilShape<Dim, R>::kNumRuns>;
+#ifdef IGSOA_HAVE_AVX2_KERNELS
+        if (simd) {
+            interiorAVX2<Dim, R>(Runs{}, re_centre, im_centre, row, plane, w, self_re, self_im, acc_re, acc_im);
+            return;
+        }
+#else
+        (void)simd;
+#endif
+        interiorScalar<Dim, R>(Runs{}, re_centre, im_centre, row, plane, w, self_re, self_im, acc_re, acc_im);
+    }
+
+    // ---- Scalar: index order, straight into the sum ------------------------
+
+    template <size_t... M>
+    static inline void runScalar(
+        std::index_sequence<M...>,
+        const double* re, const double* im, const double* w,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        ((acc_re += w[M] * (re[M] - self_re), acc_im += w[M] * (im[M] - self_im)), ...);
+    }
+
+    template <int Dim, int R, size_t... Rs>
+    static inline void interiorScalar(
+        std::index_sequence<Rs...>,
+        const double* re_centre, const double* im_centre,
+        std::ptrdiff_t row, std::ptrdiff_t plane, const double* w,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        using Shape = FixedStencilShape<Dim, R>;
+        (runScalar(std::make_index_sequence<Shape::kRuns[Rs].length>{},
+                   re_centre + Shape::kRuns[Rs].linearOffset(row, plane),
+                   im_centre + Shape::kRuns[Rs].linearOffset(row, plane),
+                   w + Shape::kRuns[Rs].begin,
+                   self_re, self_im, acc_re, acc_im), ...);
+    }
+
+#ifdef IGSOA_HAVE_AVX2_KERNELS
+    // ---- AVX2: IGSOACouplingKernels::accumulateContiguousAVX2, unrolled ----
+
+    template <size_t... B>
+    static IGSOA_TARGET_AVX2 inline void blocksAVX2(
+        std::index_sequence<B...>,
+        const double* re, const double* im, const double* w,
+        [[maybe_unused]] __m256d self_re_vec, [[maybe_unused]] __m256d self_im_vec,   // Unused by runs shorter than 4
+        __m256d& sum_re, __m256d& sum_im
+    ) {
+        ((sum_re = _mm256_fmadd_pd(_mm256_loadu_pd(w + 4 * B),
+                                   _mm256_sub_pd(_mm256_loadu_pd(re + 4 * B), self_re_vec), sum_re),
+          sum_im = _mm256_fmadd_pd(_mm256_loadu_pd(w + 4 * B),
+                                   _mm256_sub_pd(_mm256_loadu_pd(im + 4 * B), self_im_vec), sum_im)), ...);
+    }
+
+    template <size_t... M>
+    static IGSOA_TARGET_AVX2 inline void tailAVX2(
+        std::index_sequence<M...>,
+        const double* re, const double* im, const double* w,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        ((acc_re += w[M] * (re[M] - self_re), acc_im += w[M] * (im[M] - self_im)), ...);
+    }
+
+    template <size_t L>
+    static IGSOA_TARGET_AVX2 inline void runAVX2(
+        const double* re, const double* im, const double* w,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        constexpr size_t kVector = (L / 4) * 4;
+        const __m256d self_re_vec = _mm256_set1_pd(self_re);
+        const __m256d self_im_vec = _mm256_set1_pd(self_im);
+        __m256d sum_re = _mm256_setzero_pd();
+        __m256d sum_im = _mm256_setzero_pd();
+        blocksAVX2(std::make_index_sequence<L / 4>{}, re, im, w, self_re_vec, self_im_vec, sum_re, sum_im);
+
+        double tail_re = IGSOACouplingKernels::horizontalSum(sum_re);
+        double tail_im = IGSOACouplingKernels::horizontalSum(sum_im);
+        tailAVX2(std::make_index_sequence<L - kVector>{}, re + kVector, im + kVector, w + kVector,
+                 self_re, self_im, tail_re, tail_im);
+        acc_re += tail_re;
+        acc_im += tail_im;
+    }
+
+    template <int Dim, int R, size_t... Rs>
+    static IGSOA_TARGET_AVX2 void interiorAVX2(
+        std::index_sequence<Rs...>,
+        const double* re_centre, const double* im_centre,
+        std::ptrdiff_t row, std::ptrdiff_t plane, const double* w,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        using Shape = FixedStencilShape<Dim, R>;
+        (runAVX2<Shape::kRuns[Rs].length>(re_centre + Shape::kRuns[Rs].linearOffset(row, plane),
+                                          im_centre + Shape::kRuns[Rs].linearOffset(row, plane),
+                                          w + Shape::kRuns[Rs].begin,
+                                          self_re, self_im, acc_re, acc_im), ...);
+    }
+#endif
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,162 @@
+/**
+ * IGSOA GPU Backend (3D)
+ *
+ * Device-resident stepping for IGSOAComplexEngine3D (setDevice(GPU)).  The
+ * lattice is uploaded once as SoA arrays (Ψ double-buffered, Φ, κ, γ and the
+ * derived fields) and stays on the device across missions; the engine only
+ * downloads it when the host state is read (getNodes, get_state, snapshots,
+ * checkpoints) and re-uploads after host edits.
+ *
+ * One step is the per-step host update (IGSOAPhysics3D::timeStep) as four
+ * kernels: driving, Ψ coupling over the NeighborStencil3D table (periodic
+ * wrap per neighbour, terms summed in table order), Φ plus F / phase / Ṡ,
+ * and the F gradients with the optional normalization.  Energy, entropy
+ * production and the circular centre-of-mass sums are block reductions on
+ * the device; only the per-block partials cross the bus.
+ *
+ * Results agree with the host path to rounding (the device compiler
+ * contracts multiply-adds).
+ *
+ * Supported: DoubleBuffered updates, the Euler integrator, double precision
+ * and Stencil coupling (uniform R_c).  Other configurations step on the host.
+ * The kernels are in gpu/igsoa_gpu_kernels_3d.cu, built when DASE_ENABLE_GPU
+ * is defined; otherwise upload() fails and the engine stays on the host.
+ */
+
+#pragma once
+
+#include "gpu_device.h"
+#include "igsoa_complex_node.h"
+#include "neighbor_cache.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace dase {
+namespace igsoa {
+
+/**
+ * Lattice totals reduced on the device
+ *
+ * sum_cos / sum_sin are the F-weighted circular sums per axis that
+ * IGSOAStateInit3D::computeCenterOfMass evaluates on the host.
+ */
+struct IGSOADeviceTotals {
+    double energy = 0.0;         // ∑ |Ψ|² + Φ² (F of the last step)
+    double entropy_rate = 0.0;   // ∑ Ṡ
+    double sum_F = 0.0;
+    double sum_cos[3] = {0.0, 0.0, 0.0};
+    double sum_sin[3] = {0.0, 0.0, 0.0};
+};
+
+class IGSOAGpuBackend3D {
+public:
+    IGSOAGpuBackend3D();
+    ~IGSOAGpuBackend3D();
+
+    IGSOAGpuBackend3D(const IGSOAGpuBackend3D&) = delete;
+    IGSOAGpuBackend3D& operator=(const IGSOAGpuBackend3D&) = delete;
+
+    /**
+     * True if a mission with this configuration and coupling table can run
+     * on the device
+     */
+    static bool supported(const IGSOAComplexConfig& config, const NeighborStencil3D* stencil) {
+        return config.update_mode == IGSOAUpdateMode::DoubleBuffered &&
+               config.integrator == IGSOAIntegrator::Euler &&
+               config.precision == IGSOAPrecision::Double &&
+               config.sparse_threshold <= 0.0 &&
+               config.coupling_gain == 1.0 &&
+               stencil != nullptr && stencil->size() > 0;
+    }
+
+    /**
+     * Copy the lattice and coupling table to the device (allocating on the
+     * first call or when the shape changes)
+     *
+     * @return false if there is no device backend or no device
+     * @throws std::runtime_error if a device allocation or copy fails
+     */
+    bool upload(const std::vector<IGSOAComplexNode>& nodes,
+                size_t N_x, size_t N_y, size_t N_z,
+                const NeighborStencil3D& stencil);
+
+    /**
+     * Advance the resident lattice by num_steps
+     *
+     * @param input_signals Optional driving signals (length: num_steps)
+     * @param control_patterns Optional control patterns (length: num_steps)
+     * @return Operations, counted as the host path counts them
+     * @throws std::runtime_error if a kernel launch fails
+     */
+    uint64_t run(const IGSOAComplexConfig& config,
+                 uint64_t num_steps,
+                 const double* input_signals = nullptr,
+                 const double* control_patterns = nullptr);
+
+    // Copy the resident lattice into `nodes` (same size as uploaded)
+    void download(std::vector<IGSOAComplexNode>& nodes) const;
+
+    // Energy, entropy and centre-of-mass sums of the resident lattice
+    IGSOADeviceTotals reduce() const;
+
+    // True while a lattice is resident
+    bool isResident() const;
+
+    // Free the device arrays
+    void release();
+
+    // Device bytes held
+    size_t memoryBytes() const;
+
+    /**
+     * Centre of mass in lattice units from the circular sums (matches
+     * IGSOAStateInit3D::computeCenterOfMass)
+     */
+    static void centerOfMass(const IGSOADeviceTotals& totals,
+                             size_t N_x, size_t N_y, size_t N_z,
+                             double& x_cm_out, double& y_cm_out, double& z_cm_out) {
+        const double extent[3] = {static_cast<double>(N_x), static_cast<double>(N_y), static_cast<double>(N_z)};
+        double* out[3] = {&x_cm_out, &y_cm_out, &z_cm_out};
+        for (int axis = 0; axis < 3; ++axis) {
+            double cm = 0.0;
+            if (totals.sum_F > 0.0) {
+                const double mean_theta = std::atan2(totals.sum_sin[axis], totals.sum_cos[axis]);
+                cm = extent[axis] * mean_theta / (2.0 * M_PI);
+                if (cm < 0.0) {
+                    cm += extent[axis];
+                }
+            }
+            *out[axis] = cm;
+        }
+    }
+
+private:
+#ifdef DASE_ENABLE_GPU
+    struct DeviceState;   // gpu/igsoa_gpu_kernels_3d.cu
+    std::unique_ptr<DeviceState> state_;
+#endif
+};
+
+#ifndef DASE_ENABLE_GPU
+// Host-only build: nothing is ever resident
+inline IGSOAGpuBackend3D::IGSOAGpuBackend3D() = default;
+inline IGSOAGpuBackend3D::~IGSOAGpuBackend3D() = default;
+inline bool IGSOAGpuBackend3D::upload(const std::vector<IGSOAComplexNode>&, size_t, size_t, size_t,
+                                      const NeighborStencil3D&) { return false; }
+inline uint64_t IGSOAGpuBackend3D::run(const IGSOAComplexConfig&, uint64_t, const double*, const double*) { return 0; }
+inline void IGSOAGpuBackend3D::download(std::vector<IGSOAComplexNode>&) const {}
+inline IGSOADeviceTotals IGSOAGpuBackend3D::reduce() const { return IGSOADeviceTotals(); }
+inline bool IGSOAGpuBackend3D::isResident() const { return false; }
+inline void IGSOAGpuBackend3D::release() {}
+inline size_t IGSOAGpuBackend3D::memoryBytes() const { return 0; }
+#endif
+
+} // namespace igsoa
+} // namespace dase
@@ -28,6 +28,11 @@ EchoGenerator::EchoGenerator(const EchoConfig& config)
     : config_(config)
     , merger_detected_(false)
     , last_field_energy_(0.0)
+    , window_begin_(0)
+    , window_end_(0)
+    , window_time_(0.0)
+    , window_sigma_(0.0)
+    , window_valid_(false)
 {
     // Validate configuration before initialization
     validateConfig();
@@ -140,6 +145,7 @@ void EchoGenerator::initialize() {
 
     // Generate echo schedule
     echo_schedule_ = generateEchoSchedule();
+    rebuildEchoIndex();
 
     LOG_INFO("EchoGenerator initialized: " + std::to_string(primes_.size()) +
              " primes, " + std::to_string(prime_gaps_.size()) + " gaps, " +
@@ -277,6 +283,7 @@ void EchoGenerator::setMergerTime(double t) {
 
     // Regenerate schedule with new merger time
     echo_schedule_ = generateEchoSchedule();
+    rebuildEchoIndex();
 
     LOG_INFO("Merger time set to " + std::to_string(t) + " s, " +
              std::to_string(echo_schedule_.size()) + " echoes scheduled");
@@ -296,9 +303,11 @@ std::complex<double> EchoGenerator::computeEchoSource(
     }
 
     // Get active echoes at time t
-    std::vector<EchoEvent> active = getActiveEchoes(t, 3.0);
+    size_t begin = 0;
+    size_t end = 0;
+    findActiveRange(t, 3.0, begin, end);
 
-    if (active.empty()) {
+    if (begin == end) {
         return std::complex<double>(0.0, 0.0);
     }
 
@@ -310,7 +319,9 @@ std::complex<double> EchoGenerator::computeEchoSource(
     // Sum contributions from all active echoes
     std::complex<double> total_source(0.0, 0.0);
 
-    for (const auto& echo : active) {
+    for (size_t n = begin; n < end; n++) {
+        const EchoEvent& echo = echo_schedule_[n];
+
         // Temporal Gaussian pulse
         double dt = t - echo.time;
         double pulse_width = config_.fundamental_timescale * 2.0; // 2τ₀ width
@@ -333,6 +344,67 @@ std::complex<double> EchoGenerator::computeEchoSource(
     return total_source;
 }
 
+void EchoGenerator::computeEchoSourceField(
+    double t,
+    const SymmetryField& field,
+    const Vector3D& source_center,
+    std::vector<std::complex<double>>& sources_out)
+{
+    const int total = field.getTotalPoints();
+    sources_out.assign(total, std::complex<double>(0.0, 0.0));
+
+    if (!merger_detected_ || echo_schedule_.empty()) {
+        return;
+    }
+
+    advanceActiveWindow(t, 3.0);
+    if (window_begin_ == window_end_) {
+        return;
+    }
+
+    // Temporal factors, once per active echo (same expressions as
+    // computeEchoSource so the per-point sums round identically)
+    const size_t num_active = window_end_ - window_begin_;
+    echo_temporal_.resize(num_active);
+    echo_cos_.resize(num_active);
+    echo_sin_.resize(num_active);
+    for (size_t m = 0; m < num_active; m++) {
+        const EchoEvent& echo = echo_schedule_[window_begin_ + m];
+        double dt = t - echo.time;
+        double pulse_width = config_.fundamental_timescale * 2.0; // 2τ₀ width
+        double temporal_gaussian = std::exp(-(dt * dt) / (2.0 * pulse_width * pulse_width));
+        double phase = 2.0 * M_PI * echo.frequency * dt;
+
+        echo_temporal_[m] = echo.amplitude * temporal_gaussian;
+        echo_cos_[m] = std::cos(phase);
+        echo_sin_[m] = std::sin(phase);
+    }
+
+    const SymmetryFieldConfig& grid = field.getConfig();
+    double sigma_sq = config_.echo_gaussian_width * config_.echo_gaussian_width;
+
+    // Spatial profile, once per point, shared by every active echo
+    for (int k = 0; k < grid.nz; k++) {
+        for (int j = 0; j < grid.ny; j++) {
+            for (int i = 0; i < grid.nx; i++) {
+                Vector3D r = field.toPosition(i, j, k) - source_center;
+                double distance_sq = r.x * r.x + r.y * r.y + r.z * r.z;
+                double spatial_gaussian = std::exp(-distance_sq / (2.0 * sigma_sq));
+
+                std::complex<double> total_source(0.0, 0.0);
+                for (size_t m = 0; m < num_active; m++) {
+                    double amplitude = echo_temporal_[m] * spatial_gaussian;
+                    total_source += std::complex<double>(
+                        amplitude * echo_cos_[m],
+                        amplitude * echo_sin_[m]
+                    );
+                }
+                sources_out[field.toFlatIndex(i, j, k)] = total_source;
+            }
+        }
+    }
+}
+
 double EchoGenerator::getEchoAmplitude(const EchoEvent& echo, double t) const {
     double dt = t - echo.time;
     double pulse_width = config_.fundamental_timescale * 2.0;
@@ -350,7 +422,7 @@ bool EchoGenerator::detectMerger(const SymmetryField& field, double current_time
         return false;
     }
 
-    // Compute current field energy
+    // Current field energy (totals of the last evolveStep sweep; no grid pass)
     double current_energy = field.computeTotalEnergy();
 
     // Detect sudden drop or peak (merger signature)
@@ -378,31 +450,92 @@ bool EchoGenerator::detectMerger(const SymmetryField& field, double current_time
 // ============================================================================
 
 EchoEvent EchoGenerator::getNextEcho(double t) const {
-    for (const auto& echo : echo_schedule_) {
-        if (echo.time > t) {
-            return echo;
-        }
+    auto it = std::upper_bound(echo_times_.begin(), echo_times_.end(), t);
+    if (it != echo_times_.end()) {
+        return echo_schedule_[it - echo_times_.begin()];
     }
     return EchoEvent(); // Empty event if none remaining
 }
 
 bool EchoGenerator::isEchoActive(double t) const {
-    return !getActiveEchoes(t, 3.0).empty();
+    size_t begin = 0;
+    size_t end = 0;
+    findActiveRange(t, 3.0, begin, end);
+    return begin != end;
 }
 
 std::vector<EchoEvent> EchoGenerator::getActiveEchoes(double t, double pulse_width_sigma) const {
-    std::vector<EchoEvent> active;
+    size_t begin = 0;
+    size_t end = 0;
+    findActiveRange(t, pulse_width_sigma, begin, end);
+
+    return std::vector<EchoEvent>(echo_schedule_.begin() + begin,
+                                  echo_schedule_.begin() + end);
+}
 
-    double pulse_width = config_.fundamental_timescale * pulse_width_sigma;
+// ============================================================================
+// Echo Index
+// ============================================================================
 
-    for (const auto& echo : echo_schedule_) {
-        double dt = std::abs(t - echo.time);
-        if (dt < pulse_width) {
-            active.push_back(echo);
+void EchoGenerator::rebuildEchoIndex() {
+    // generateEchoSchedule accumulates positive gaps, so times are ascending
+    echo_times_.resize(echo_schedule_.size());
+    for (size_t n = 0; n < echo_schedule_.size(); n++) {
+        echo_times_[n] = echo_schedule_[n].time;
+    }
+    window_valid_ = false;
+}
+
+// An echo is active when |t - t_n| < w.  Over ascending t_n the echoes that
+// ended before t, the active ones and those still ahead form three contiguous
+// runs, so both window edges are partition points of the same predicate.
+namespace {
+
+inline bool echoEndedBefore(double t, double w, double echo_time) {
+    return echo_time < t && !(std::abs(t - echo_time) < w);
+}
+
+inline bool echoStartedBy(double t, double w, double echo_time) {
+    return echo_time <= t || std::abs(t - echo_time) < w;
+}
+
+} // namespace
+
+void EchoGenerator::findActiveRange(double t, double pulse_width_sigma,
+                                    size_t& begin, size_t& end) const {
+    const double w = config_.fundamental_timescale * pulse_width_sigma;
+    if (!(w > 0.0)) {
+        begin = end = 0;
+        return;
+    }
+
+    auto first = std::partition_point(echo_times_.begin(), echo_times_.end(),
+        [t, w](double echo_time) { return echoEndedBefore(t, w, echo_time); });
+    auto last = std::partition_point(first, echo_times_.end(),
+        [t, w](double echo_time) { return echoStartedBy(t, w, echo_time); });
+
+    begin = static_cast<size_t>(first - echo_times_.begin());
+    end = static_cast<size_t>(last - echo_times_.begin());
+}
+
+void EchoGenerator::advanceActiveWindow(double t, double pulse_width_sigma) {
+    const double w = config_.fundamental_timescale * pulse_width_sigma;
+    if (!window_valid_ || t < window_time_ || pulse_width_sigma != window_sigma_ || !(w > 0.0)) {
+        findActiveRange(t, pulse_width_sigma, window_begin_, window_end_);
+    } else {
+        const size_t n = echo_times_.size();
+        while (window_begin_ < n && echoEndedBefore(t, w, echo_times_[window_begin_])) {
+            window_begin_++;
+        }
+        window_end_ = std::max(window_end_, window_begin_);
+        while (window_end_ < n && echoStartedBy(t, w, echo_times_[window_end_])) {
+            window_end_++;
         }
     }
 
-    return active;
+    window_time_ = t;
+    window_sigma_ = pulse_width_sigma;
+    window_valid_ = true;
 }
 
 // ============================================================================
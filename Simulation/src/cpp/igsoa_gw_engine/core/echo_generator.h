@@ -17,6 +17,7 @@
 #include "symmetry_field.h"
 #include <vector>
 #include <complex>
+#include <cstddef>
 
 namespace dase {
 namespace igsoa {
@@ -187,6 +188,25 @@ public:
      */
     double getEchoAmplitude(const EchoEvent& echo, double t) const;
 
+    /**
+     * Compute echo source for every grid point in one pass
+     *
+     * Same values as computeEchoSource at each grid position.  The temporal
+     * amplitude and phase are computed once per active echo and the spatial
+     * profile once per point.  Active echoes come from a sliding window over
+     * the time-sorted schedule, amortized O(1) per call for non-decreasing t.
+     *
+     * @param t Current simulation time (s)
+     * @param field Symmetry field (provides grid information)
+     * @param source_center Center of echo source (merger location)
+     * @param sources_out Resized to the grid and overwritten
+     */
+    void computeEchoSourceField(
+        double t,
+        const SymmetryField& field,
+        const Vector3D& source_center,
+        std::vector<std::complex<double>>& sources_out);
+
     // === Merger Detection ===
 
     /**
@@ -280,6 +300,19 @@ private:
     bool merger_detected_;                // Whether merger has occurred
     double last_field_energy_;            // For merger detection
 
+    // Time-sorted index over echo_schedule_ (rebuilt with the schedule)
+    std::vector<double> echo_times_;      // echo_schedule_[n].time, ascending
+    size_t window_begin_;                 // Sliding active window [begin, end)
+    size_t window_end_;
+    double window_time_;                  // t of the last window update
+    double window_sigma_;                 // Pulse width (τ₀ units) of the window
+    bool window_valid_;
+
+    // Per-echo scratch for computeEchoSourceField
+    std::vector<double> echo_temporal_;   // A_n × temporal Gaussian
+    std::vector<double> echo_cos_;
+    std::vector<double> echo_sin_;
+
     /**
      * Initialize: generate primes and compute gaps
      */
@@ -302,6 +335,24 @@ private:
         int echo_number,
         double cumulative_time,
         int prime_index) const;
+
+    /**
+     * Rebuild echo_times_ and invalidate the sliding window
+     */
+    void rebuildEchoIndex();
+
+    /**
+     * Range [begin, end) of echoes with |t - t_n| < pulse_width_sigma × τ₀
+     * (binary search; the schedule is chronological)
+     */
+    void findActiveRange(double t, double pulse_width_sigma,
+                         size_t& begin, size_t& end) const;
+
+    /**
+     * Slide the cached window to t (falls back to findActiveRange when t
+     * moves backwards or the pulse width changes)
+     */
+    void advanceActiveWindow(double t, double pulse_width_sigma);
 };
 
 } // namespace gw
@@ -0,0 +1,287 @@
+/**
+ * IGSOA Gravitational Wave Engine - Binary Field Snapshots Implementation
+ */
+
+#include "field_snapshot.h"
+#include "utils/logger.h"
+#include "trace_zones.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+namespace {
+
+const char kSnapshotMagic[8] = {'I', 'G', 'S', 'O', 'A', 'S', 'F', '1'};
+const uint32_t kSnapshotVersion = 1;
+const uint32_t kSnapshotHeaderBytes = 64;
+
+bool hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+void requireLittleEndian() {
+    // The arrays are written as raw host doubles
+    if (!hostIsLittleEndian()) {
+        throw std::runtime_error("Binary field snapshots require a little-endian host");
+    }
+}
+
+struct FileCloser {
+    void operator()(std::FILE* f) const { if (f) std::fclose(f); }
+};
+using FileHandle = std::unique_ptr<std::FILE, FileCloser>;
+
+void writeBlock(std::FILE* f, const void* data, size_t bytes, const std::string& filename) {
+    if (bytes > 0 && std::fwrite(data, 1, bytes, f) != bytes) {
+        throw std::runtime_error("Failed writing field snapshot: " + filename);
+    }
+}
+
+void readBlock(std::FILE* f, void* data, size_t bytes, const std::string& filename) {
+    if (bytes > 0 && std::fread(data, 1, bytes, f) != bytes) {
+        throw std::runtime_error("Truncated field snapshot: " + filename);
+    }
+}
+
+void writeSnapshot(const std::string& filename,
+                   int nx, int ny, int nz, int k_offset,
+                   double dx, double dy, double dz, double time,
+                   const std::complex<double>* delta_phi,
+                   const double* alpha,
+                   const double* gradient_magnitude,
+                   const double* potential)
+{
+    requireLittleEndian();
+
+    unsigned char header[kSnapshotHeaderBytes] = {};
+    const int32_t dims[4] = {nx, ny, nz, k_offset};
+    const double geometry[4] = {dx, dy, dz, time};
+    std::memcpy(header, kSnapshotMagic, sizeof(kSnapshotMagic));
+    std::memcpy(header + 8, &kSnapshotVersion, 4);
+    std::memcpy(header + 12, &kSnapshotHeaderBytes, 4);
+    std::memcpy(header + 16, dims, sizeof(dims));
+    std::memcpy(header + 32, geometry, sizeof(geometry));
+
+    FileHandle file(std::fopen(filename.c_str(), "wb"));
+    if (!file) {
+        throw std::runtime_error("Cannot open file for export: " + filename);
+    }
+
+    const size_t total = static_cast<size_t>(nx) * ny * nz;
+    writeBlock(file.get(), header, sizeof(header), filename);
+    writeBlock(file.get(), delta_phi, total * sizeof(std::complex<double>), filename);
+    writeBlock(file.get(), alpha, total * sizeof(double), filename);
+    writeBlock(file.get(), gradient_magnitude, total * sizeof(double), filename);
+    writeBlock(file.get(), potential, total * sizeof(double), filename);
+
+    if (std::fclose(file.release()) != 0) {
+        throw std::runtime_error("Failed writing field snapshot: " + filename);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// FieldSnapshot
+// ============================================================================
+
+void FieldSnapshot::capture(const SymmetryField& field) {
+    DASE_TRACE_ZONE("gw.snapshot_capture");
+    const SymmetryFieldConfig& config = field.getConfig();
+    nx = config.nx;
+    ny = config.ny;
+    nz = config.nz;
+    k_offset = config.k_offset;
+    dx = config.dx;
+    dy = config.dy;
+    dz = config.dz;
+    time = field.getCurrentTime();
+
+    const auto& phi = field.getDeltaPhiFlat();
+    const auto& alpha_values = field.getAlphaFlat();
+    const auto& grad_values = field.getGradientMagnitudeFlat();
+    const auto& potential_values = field.getPotentialFlat();
+    delta_phi.assign(phi.begin(), phi.end());
+    alpha.assign(alpha_values.begin(), alpha_values.end());
+    gradient_magnitude.assign(grad_values.begin(), grad_values.end());
+    potential.assign(potential_values.begin(), potential_values.end());
+}
+
+void FieldSnapshot::write(const std::string& filename) const {
+    DASE_TRACE_ZONE("gw.snapshot_write");
+    const size_t total = static_cast<size_t>(nx) * ny * nz;
+    if (delta_phi.size() != total || alpha.size() != total ||
+        gradient_magnitude.size() != total || potential.size() != total) {
+        throw std::runtime_error("FieldSnapshot array sizes do not match grid dimensions");
+    }
+    writeSnapshot(filename, nx, ny, nz, k_offset, dx, dy, dz, time,
+                  delta_phi.data(), alpha.data(),
+                  gradient_magnitude.data(), potential.data());
+}
+
+void FieldSnapshot::writeField(const SymmetryField& field, const std::string& filename) {
+    const SymmetryFieldConfig& config = field.getConfig();
+    writeSnapshot(filename, config.nx, config.ny, config.nz, config.k_offset,
+                  config.dx, config.dy, config.dz, field.getCurrentTime(),
+                  field.getDeltaPhiFlat().data(), field.getAlphaFlat().data(),
+                  field.getGradientMagnitudeFlat().data(), field.getPotentialFlat().data());
+}
+
+FieldSnapshot FieldSnapshot::read(const std::string& filename) {
+    requireLittleEndian();
+
+    FileHandle file(std::fopen(filename.c_str(), "rb"));
+    if (!file) {
+        throw std::runtime_error("Cannot open field snapshot: " + filename);
+    }
+
+    unsigned char header[kSnapshotHeaderBytes];
+    readBlock(file.get(), header, sizeof(header), filename);
+
+    uint32_t version = 0;
+    uint32_t header_bytes = 0;
+    std::memcpy(&version, header + 8, 4);
+    std::memcpy(&header_bytes, header + 12, 4);
+    if (std::memcmp(header, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+        version != kSnapshotVersion || header_bytes != kSnapshotHeaderBytes) {
+        throw std::runtime_error("Not a version 1 field snapshot: " + filename);
+    }
+
+    FieldSnapshot snapshot;
+    int32_t dims[4];
+    double geometry[4];
+    std::memcpy(dims, header + 16, sizeof(dims));
+    std::memcpy(geometry, header + 32, sizeof(geometry));
+    if (dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0 || dims[3] < 0) {
+        throw std::runtime_error("Invalid grid dimensions in field snapshot: " + filename);
+    }
+    snapshot.nx = dims[0];
+    snapshot.ny = dims[1];
+    snapshot.nz = dims[2];
+    snapshot.k_offset = dims[3];
+    snapshot.dx = geometry[0];
+    snapshot.dy = geometry[1];
+    snapshot.dz = geometry[2];
+    snapshot.time = geometry[3];
+
+    const size_t total = static_cast<size_t>(snapshot.nx) * snapshot.ny * snapshot.nz;
+    snapshot.delta_phi.resize(total);
+    snapshot.alpha.resize(total);
+    snapshot.gradient_magnitude.resize(total);
+    snapshot.potential.resize(total);
+    readBlock(file.get(), snapshot.delta_phi.data(), total * sizeof(std::complex<double>), filename);
+    readBlock(file.get(), snapshot.alpha.data(), total * sizeof(double), filename);
+    readBlock(file.get(), snapshot.gradient_magnitude.data(), total * sizeof(double), filename);
+    readBlock(file.get(), snapshot.potential.data(), total * sizeof(double), filename);
+
+    return snapshot;
+}
+
+// ============================================================================
+// FieldSnapshotWriter
+// ============================================================================
+
+FieldSnapshotWriter::FieldSnapshotWriter()
+    : has_pending_(false)
+    , busy_(false)
+    , stop_(false)
+    , written_count_(0)
+{
+    worker_ = std::thread(&FieldSnapshotWriter::run, this);
+}
+
+FieldSnapshotWriter::~FieldSnapshotWriter() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !has_pending_ && !busy_; });
+        stop_ = true;
+        if (error_) {
+            LOG_ERROR("FieldSnapshotWriter destroyed with an unreported write error");
+        }
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+void FieldSnapshotWriter::submit(const SymmetryField& field, const std::string& filename) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !has_pending_; });
+        rethrowPendingError();
+    }
+
+    // The worker leaves pending_ alone until has_pending_ is set
+    pending_.capture(field);
+    pending_filename_ = filename;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        has_pending_ = true;
+    }
+    cv_.notify_all();
+}
+
+void FieldSnapshotWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !has_pending_ && !busy_; });
+    rethrowPendingError();
+}
+
+uint64_t FieldSnapshotWriter::getWrittenCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_count_;
+}
+
+void FieldSnapshotWriter::rethrowPendingError() {
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void FieldSnapshotWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return has_pending_ || stop_; });
+        if (!has_pending_) {
+            return;
+        }
+
+        // Take the staged snapshot; its buffers return to submit() for reuse
+        std::swap(pending_, writing_);
+        std::swap(pending_filename_, writing_filename_);
+        has_pending_ = false;
+        busy_ = true;
+        lock.unlock();
+        cv_.notify_all();
+
+        std::exception_ptr error;
+        try {
+            writing_.write(writing_filename_);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        busy_ = false;
+        if (error) {
+            error_ = error;
+        } else {
+            written_count_++;
+        }
+        cv_.notify_all();
+    }
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
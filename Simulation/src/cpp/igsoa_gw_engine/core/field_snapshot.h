@@ -0,0 +1,143 @@
+/**
+ * IGSOA Gravitational Wave Engine - Binary Field Snapshots
+ *
+ * Binary replacement for the SymmetryField CSV export.  A snapshot file is a
+ * fixed little-endian header followed by the four field arrays in flat grid
+ * order (idx = i + nx*(j + ny*k)), each written as one block:
+ *
+ *   offset  size        content
+ *   0       8           magic "IGSOASF1"
+ *   8       4           uint32 format version (1)
+ *   12      4           uint32 header size in bytes (64)
+ *   16      12          int32 nx, ny, nz
+ *   28      4           int32 k_offset (global z-index of plane 0, see
+ *                       slab_decomposition.h; 0 for a whole grid)
+ *   32      32          float64 dx, dy, dz, time
+ *   64      16·N        complex128 delta_phi (Re, Im interleaved)
+ *   ...     8·N         float64 alpha
+ *   ...     8·N         float64 gradient_magnitude
+ *   ...     8·N         float64 potential
+ *
+ * Each array section can be mapped directly, e.g. with numpy.fromfile at
+ * the offsets above.
+ *
+ * FieldSnapshotWriter moves the disk write onto a background thread, so
+ * the simulation only pays for an in-memory copy of the arrays.
+ */
+
+#pragma once
+
+#include "symmetry_field.h"
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+/**
+ * In-memory copy of a SymmetryField's arrays
+ */
+struct FieldSnapshot {
+    int nx, ny, nz;
+    int k_offset;
+    double dx, dy, dz;
+    double time;
+
+    std::vector<std::complex<double>> delta_phi;
+    std::vector<double> alpha;
+    std::vector<double> gradient_magnitude;
+    std::vector<double> potential;
+
+    FieldSnapshot() : nx(0), ny(0), nz(0), k_offset(0), dx(0.0), dy(0.0), dz(0.0), time(0.0) {}
+
+    /**
+     * Copy the field's grid, time and arrays (reuses existing capacity)
+     */
+    void capture(const SymmetryField& field);
+
+    /**
+     * Write this snapshot in the binary format
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& filename) const;
+
+    /**
+     * Write a field directly, without an intermediate copy
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void writeField(const SymmetryField& field, const std::string& filename);
+
+    /**
+     * Read a snapshot written by write/writeField
+     * @throws std::runtime_error on I/O errors or malformed files
+     */
+    static FieldSnapshot read(const std::string& filename);
+};
+
+/**
+ * Asynchronous snapshot writer
+ *
+ * submit() copies the field into a staging snapshot and returns; a single
+ * worker thread writes it out.  At most one snapshot waits behind the one
+ * being written, so submit() blocks only when the disk falls two snapshots
+ * behind.  Write errors are rethrown by the next submit() or flush().
+ */
+class FieldSnapshotWriter {
+public:
+    FieldSnapshotWriter();
+
+    /**
+     * Waits for outstanding writes, then stops the worker
+     */
+    ~FieldSnapshotWriter();
+
+    FieldSnapshotWriter(const FieldSnapshotWriter&) = delete;
+    FieldSnapshotWriter& operator=(const FieldSnapshotWriter&) = delete;
+
+    /**
+     * Queue a snapshot of the field's current state
+     * @param field Field to capture (read synchronously)
+     * @param filename Output file
+     */
+    void submit(const SymmetryField& field, const std::string& filename);
+
+    /**
+     * Block until every submitted snapshot is on disk
+     */
+    void flush();
+
+    /**
+     * Number of snapshots written so far
+     */
+    uint64_t getWrittenCount() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+
+    FieldSnapshot pending_;           // Owned by submit() while !has_pending_
+    std::string pending_filename_;
+    FieldSnapshot writing_;           // Owned by the worker
+    std::string writing_filename_;
+
+    bool has_pending_;
+    bool busy_;
+    bool stop_;
+    uint64_t written_count_;
+    std::exception_ptr error_;
+
+    void run();
+    void rethrowPendingError();       // Requires mutex_ held
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
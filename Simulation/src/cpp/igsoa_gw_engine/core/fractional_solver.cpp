@@ -3,11 +3,39 @@
  */
 
 #include "fractional_solver.h"
+#include "soe_kernel_cache.h"
 #include "utils/logger.h"
+#include "engine_checkpoint.h"
+#include "trace_zones.h"
 #include <cmath>
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
 #include <stdexcept>
 
+// Below this many grid points the history pass stays single-threaded
+#ifndef FRACTIONAL_OMP_MIN_POINTS
+#define FRACTIONAL_OMP_MIN_POINTS 4096
+#endif
+
+// Log-spaced samples of [t_min, T_max] used to fit and check SOE kernels
+#ifndef SOE_FIT_SAMPLES
+#define SOE_FIT_SAMPLES 160
+#endif
+
+// Mittag-Leffler table cache: z range, resolution and number of (α,β)
+// pairs kept (see MittagLefflerFunction::evaluate_real_tabulated)
+#ifndef ML_TABLE_Z_LIMIT
+#define ML_TABLE_Z_LIMIT 8.0
+#endif
+#ifndef ML_TABLE_INTERVALS
+#define ML_TABLE_INTERVALS 2048
+#endif
+#ifndef ML_TABLE_CACHE_ENTRIES
+#define ML_TABLE_CACHE_ENTRIES 16
+#endif
+
 namespace dase {
 namespace igsoa {
 namespace gw {
@@ -16,7 +44,18 @@ namespace gw {
 // SOEKernel Implementation
 // ============================================================================
 
-SOEKernel::SOEKernel() : rank(0) {}
+SOEKernel::SOEKernel() : rank(0), decay_dt(std::numeric_limits<double>::quiet_NaN()) {}
+
+void SOEKernel::prepareDecay(double dt) {
+    if (dt == decay_dt && static_cast<int>(decay.size()) == rank) {
+        return;
+    }
+    decay.resize(rank);
+    for (int r = 0; r < rank; r++) {
+        decay[r] = std::exp(-exponents[r] * dt);
+    }
+    decay_dt = dt;
+}
 
 void SOEKernel::initialize(double alpha, double T_max, int target_rank) {
     // SOE approximation for fractional memory kernel
@@ -29,6 +68,8 @@ void SOEKernel::initialize(double alpha, double T_max, int target_rank) {
     rank = target_rank;
     weights.resize(rank);
     exponents.resize(rank);
+    decay.clear();
+    decay_dt = std::numeric_limits<double>::quiet_NaN();
 
     // Clamp alpha to valid range
     if (alpha < 1.0) alpha = 1.0;
@@ -67,6 +108,183 @@ void SOEKernel::initialize(double alpha, double T_max, int target_rank) {
     }
 }
 
+namespace {
+
+// Least squares min ||A x - b|| by Householder QR; A is M×N column-major
+// (M >= N) and is overwritten.  Returns false if A is rank deficient.
+bool solveLeastSquares(std::vector<double>& A, int M, int N,
+                       std::vector<double>& b, std::vector<double>& x)
+{
+    for (int j = 0; j < N; j++) {
+        double* col = &A[static_cast<size_t>(j) * M];
+        double norm = 0.0;
+        for (int m = j; m < M; m++) {
+            norm += col[m] * col[m];
+        }
+        norm = std::sqrt(norm);
+        if (norm == 0.0) {
+            return false;
+        }
+
+        // v = a_j - alpha e_j with alpha = -sign(a_jj) ||a_j||
+        const double alpha = (col[j] > 0.0) ? -norm : norm;
+        col[j] -= alpha;
+        double v_norm_sq = 0.0;
+        for (int m = j; m < M; m++) {
+            v_norm_sq += col[m] * col[m];
+        }
+
+        for (int c = j + 1; c < N; c++) {
+            double* other = &A[static_cast<size_t>(c) * M];
+            double dot = 0.0;
+            for (int m = j; m < M; m++) {
+                dot += col[m] * other[m];
+            }
+            const double f = 2.0 * dot / v_norm_sq;
+            for (int m = j; m < M; m++) {
+                other[m] -= f * col[m];
+            }
+        }
+        double dot = 0.0;
+        for (int m = j; m < M; m++) {
+            dot += col[m] * b[m];
+        }
+        const double f = 2.0 * dot / v_norm_sq;
+        for (int m = j; m < M; m++) {
+            b[m] -= f * col[m];
+        }
+
+        col[j] = alpha;  // R diagonal (the reflector is no longer needed)
+    }
+
+    // Back substitution on R (upper triangle of A)
+    x.assign(N, 0.0);
+    for (int j = N - 1; j >= 0; j--) {
+        double sum = b[j];
+        for (int c = j + 1; c < N; c++) {
+            sum -= A[static_cast<size_t>(c) * M + j] * x[c];
+        }
+        x[j] = sum / A[static_cast<size_t>(j) * M + j];
+    }
+    return true;
+}
+
+std::vector<double> logSpacedTimes(double t_min, double T_max) {
+    std::vector<double> times(SOE_FIT_SAMPLES);
+    const double log_ratio = std::log(T_max / t_min);
+    for (int m = 0; m < SOE_FIT_SAMPLES; m++) {
+        times[m] = t_min * std::exp(log_ratio * m / (SOE_FIT_SAMPLES - 1));
+    }
+    times.back() = T_max;
+    return times;
+}
+
+} // namespace
+
+bool SOEKernel::fit(double alpha, double T_max, double t_min, double tolerance, int max_rank) {
+    if (!(t_min > 0.0) || !(T_max > t_min) || !(tolerance > 0.0) || max_rank < 1) {
+        throw std::invalid_argument("SOE fit requires 0 < t_min < T_max, tolerance > 0, max_rank >= 1");
+    }
+
+    decay.clear();
+    decay_dt = std::numeric_limits<double>::quiet_NaN();
+
+    // Same α range as initialize()
+    if (alpha < 1.0) alpha = 1.0;
+    if (alpha > 2.0) alpha = 2.0;
+
+    const double gamma_value = gamma_functions::gamma(2.0 - 2.0 * alpha);
+    if (!std::isfinite(gamma_value)) {
+        // 1/Γ(2-2α) = 0: the exact kernel vanishes
+        rank = 0;
+        weights.clear();
+        exponents.clear();
+        return true;
+    }
+
+    // Fit t^(-p) = Σ w̃ᵣ exp(-sᵣ t) in relative error, then scale by 1/Γ.
+    // Scaling row m by t_m^p makes the target 1 at every sample.
+    const double p = 2.0 * alpha - 1.0;
+    const std::vector<double> times = logSpacedTimes(t_min, T_max);
+    const int M = static_cast<int>(times.size());
+    std::vector<double> row_scale(M);
+    for (int m = 0; m < M; m++) {
+        row_scale[m] = std::pow(times[m], p);
+    }
+
+    // Exponent range: from below 1/T_max to beyond 1/t_min, with the ends
+    // chosen per rank from a small grid of offsets (in e-folds)
+    const double lo_offsets[] = {-3.0, -2.0, -1.0, 0.0};
+    const double hi_offsets[] = {0.0, 1.0, 2.0, 3.0, 4.0};
+    const double log_s_lo = std::log(1.0 / T_max);
+    const double log_s_hi = std::log(1.0 / t_min);
+
+    double best_error = std::numeric_limits<double>::infinity();
+    std::vector<double> best_weights, best_exponents;
+    std::vector<double> A, b, x, s(max_rank);
+
+    for (int R = 1; R <= max_rank && best_error > tolerance; R++) {
+        for (double lo : lo_offsets) {
+            for (double hi : hi_offsets) {
+                const double x_lo = log_s_lo + lo;
+                const double x_hi = log_s_hi + hi;
+                for (int r = 0; r < R; r++) {
+                    const double frac = (R > 1) ? r / double(R - 1) : 0.5;
+                    s[r] = std::exp(x_lo + frac * (x_hi - x_lo));
+                }
+
+                A.resize(static_cast<size_t>(M) * R);
+                for (int r = 0; r < R; r++) {
+                    for (int m = 0; m < M; m++) {
+                        A[static_cast<size_t>(r) * M + m] = std::exp(-s[r] * times[m]) * row_scale[m];
+                    }
+                }
+                b.assign(M, 1.0);
+                if (!solveLeastSquares(A, M, R, b, x)) {
+                    continue;
+                }
+
+                double error = 0.0;
+                for (int m = 0; m < M; m++) {
+                    double fit_value = 0.0;
+                    for (int r = 0; r < R; r++) {
+                        fit_value += x[r] * std::exp(-s[r] * times[m]);
+                    }
+                    error = std::max(error, std::abs(fit_value * row_scale[m] - 1.0));
+                }
+                if (std::isfinite(error) && error < best_error) {
+                    best_error = error;
+                    best_weights.assign(x.begin(), x.end());
+                    best_exponents.assign(s.begin(), s.begin() + R);
+                }
+            }
+        }
+    }
+
+    if (best_weights.empty()) {
+        throw std::runtime_error("SOE fit failed for alpha=" + std::to_string(alpha));
+    }
+
+    rank = static_cast<int>(best_weights.size());
+    weights.resize(rank);
+    exponents = best_exponents;
+    for (int r = 0; r < rank; r++) {
+        weights[r] = best_weights[r] / gamma_value;
+    }
+    return maxRelativeError(alpha, t_min, T_max) <= tolerance;
+}
+
+double SOEKernel::maxRelativeError(double alpha, double t_min, double T_max) const {
+    const double gamma_value = gamma_functions::gamma(2.0 - 2.0 * alpha);
+    double max_error = 0.0;
+    for (double t : logSpacedTimes(t_min, T_max)) {
+        const double exact = std::isfinite(gamma_value) ? std::pow(t, 1.0 - 2.0 * alpha) / gamma_value : 0.0;
+        const double error = std::abs(exact - evaluate(t)) / (std::abs(exact) + 1e-15);
+        max_error = std::max(max_error, error);
+    }
+    return max_error;
+}
+
 double SOEKernel::evaluate(double t) const {
     double result = 0.0;
     for (int r = 0; r < rank; r++) {
@@ -162,9 +380,89 @@ FractionalSolverConfig::FractionalSolverConfig()
     , dt(0.001)            // 1 ms timestep
     , alpha_min(1.0)       // Maximum memory
     , alpha_max(2.0)       // No memory
+    , alpha_table_size(65) // Δα = 1/64 over [1, 2]
+    , history_layout(HistoryLayout::PointMajor)
+    , history_precision(HistoryPrecision::Double)
+    , soe_tolerance(0.0)   // Fixed-rank kernels
 {
 }
 
+// ============================================================================
+// Flat History Kernels (templated on storage type; arithmetic in double)
+// ============================================================================
+
+namespace {
+
+template <typename T>
+void advanceStates(
+    HistoryLayout layout, int N, int R,
+    const double* W, const double* D, const int* kernel_index,
+    const std::complex<double>* second_derivatives, double dt,
+    T* zr, T* zi, std::complex<double>* derivatives_out)
+{
+    if (layout == HistoryLayout::PointMajor) {
+        #pragma omp parallel for schedule(static) if(N >= FRACTIONAL_OMP_MIN_POINTS)
+        for (int i = 0; i < N; i++) {
+            const double* w = W + static_cast<size_t>(kernel_index[i]) * R;
+            const double* d = D + static_cast<size_t>(kernel_index[i]) * R;
+            T* zr_i = zr + static_cast<size_t>(i) * R;
+            T* zi_i = zi + static_cast<size_t>(i) * R;
+            const double s_re = second_derivatives[i].real();
+            const double s_im = second_derivatives[i].imag();
+
+            #pragma omp simd
+            for (int r = 0; r < R; r++) {
+                zr_i[r] = static_cast<T>(d[r] * static_cast<double>(zr_i[r]) + (w[r] * s_re) * dt);
+                zi_i[r] = static_cast<T>(d[r] * static_cast<double>(zi_i[r]) + (w[r] * s_im) * dt);
+            }
+
+            if (derivatives_out) {
+                double sum_re = 0.0;
+                double sum_im = 0.0;
+                for (int r = 0; r < R; r++) {
+                    sum_re += zr_i[r];
+                    sum_im += zi_i[r];
+                }
+                derivatives_out[i] = std::complex<double>(sum_re, sum_im);
+            }
+        }
+        return;
+    }
+
+    // RankMajor: sweep one SOE term across all points at a time
+    #pragma omp parallel if(N >= FRACTIONAL_OMP_MIN_POINTS)
+    {
+        for (int r = 0; r < R; r++) {
+            T* zr_r = zr + static_cast<size_t>(r) * N;
+            T* zi_r = zi + static_cast<size_t>(r) * N;
+
+            #pragma omp for simd schedule(static)
+            for (int i = 0; i < N; i++) {
+                const size_t k = static_cast<size_t>(kernel_index[i]) * R + r;
+                zr_r[i] = static_cast<T>(D[k] * static_cast<double>(zr_r[i]) +
+                                         (W[k] * second_derivatives[i].real()) * dt);
+                zi_r[i] = static_cast<T>(D[k] * static_cast<double>(zi_r[i]) +
+                                         (W[k] * second_derivatives[i].imag()) * dt);
+            }
+        }
+
+        if (derivatives_out) {
+            #pragma omp for schedule(static)
+            for (int i = 0; i < N; i++) {
+                double sum_re = 0.0;
+                double sum_im = 0.0;
+                for (int r = 0; r < R; r++) {
+                    sum_re += zr[static_cast<size_t>(r) * N + i];
+                    sum_im += zi[static_cast<size_t>(r) * N + i];
+                }
+                derivatives_out[i] = std::complex<double>(sum_re, sum_im);
+            }
+        }
+    }
+}
+
+} // namespace
+
 // ============================================================================
 // FractionalSolver Implementation
 // ============================================================================
@@ -172,28 +470,66 @@ FractionalSolverConfig::FractionalSolverConfig()
 FractionalSolver::FractionalSolver(const FractionalSolverConfig& config, int num_points)
     : config_(config)
     , num_points_(num_points)
+    , history_rank_(0)
+    , table_inv_step_(0.0)
+    , table_decay_dt_(std::numeric_limits<double>::quiet_NaN())
+{
+    if (config_.soe_tolerance < 0.0 || (config_.soe_tolerance > 0.0 && config_.soe_rank < 1)) {
+        throw std::invalid_argument("Fitted SOE kernels need soe_tolerance > 0 and soe_rank >= 1");
+    }
+
+    // Kernels first: with fitted kernels they decide the history rank
+    precomputeKernels(config.alpha_table_size);
+
+    LOG_INFO("FractionalSolver created: " + std::to_string(num_points) +
+             " points, SOE rank " + std::to_string(history_rank_) +
+             " (memory usage: " + std::to_string(getMemoryUsage() / (1024 * 1024)) + " MB)");
+}
+
+FractionalSolver::FractionalSolver(const FractionalSolver& kernel_source, int num_points)
+    : config_(kernel_source.config_)
+    , num_points_(num_points)
+    , history_rank_(kernel_source.history_rank_)
+    , cached_alphas_(kernel_source.cached_alphas_)
+    , cached_kernels_(kernel_source.cached_kernels_)
+    , table_inv_step_(kernel_source.table_inv_step_)
+    , table_weights_(kernel_source.table_weights_)
+    , table_decay_(kernel_source.table_decay_)
+    , table_decay_dt_(kernel_source.table_decay_dt_)
 {
+    allocateHistory();
+}
+
+void FractionalSolver::allocateHistory() {
     // Calculate memory requirements
-    size_t history_size_per_point = config.soe_rank * sizeof(std::complex<double>);
-    size_t total_history_mb = (num_points * history_size_per_point) / (1024 * 1024);
+    const size_t state_bytes = (config_.history_precision == HistoryPrecision::Single)
+        ? 2 * sizeof(float) : sizeof(std::complex<double>);
+    size_t history_size_per_point = history_rank_ * state_bytes;
+    size_t total_history_mb = (num_points_ * history_size_per_point) / (1024 * 1024);
 
     LOG_DEBUG("Allocating FractionalSolver memory: " + std::to_string(total_history_mb) +
-              " MB for " + std::to_string(num_points) + " points (SOE rank " +
-              std::to_string(config.soe_rank) + ")");
+              " MB for " + std::to_string(num_points_) + " points (SOE rank " +
+              std::to_string(history_rank_) + ")");
 
     try {
-        // Allocate history states for each grid point
-        history_states_.resize(num_points, HistoryState(config.soe_rank));
-
-        LOG_INFO("FractionalSolver created: " + std::to_string(num_points) +
-                 " points, SOE rank " + std::to_string(config.soe_rank) +
-                 " (memory usage: " + std::to_string(total_history_mb) + " MB)");
-
+        // Allocate one flat history buffer for all grid points
+        const size_t history_len = static_cast<size_t>(num_points_) * history_rank_;
+        AlignedArray().swap(z_re_);
+        AlignedArray().swap(z_im_);
+        AlignedFloatArray().swap(z_re_f_);
+        AlignedFloatArray().swap(z_im_f_);
+        if (config_.history_precision == HistoryPrecision::Single) {
+            z_re_f_.assign(history_len, 0.0f);
+            z_im_f_.assign(history_len, 0.0f);
+        } else {
+            z_re_.assign(history_len, 0.0);
+            z_im_.assign(history_len, 0.0);
+        }
     } catch (const std::bad_alloc& e) {
         std::string error_msg = "Failed to allocate memory for FractionalSolver: " +
                                std::to_string(total_history_mb) + " MB required for " +
-                               std::to_string(num_points) + " points with SOE rank " +
-                               std::to_string(config.soe_rank) + ". " +
+                               std::to_string(num_points_) + " points with SOE rank " +
+                               std::to_string(history_rank_) + ". " +
                                "Reduce grid size or SOE rank.";
         LOG_ERROR(error_msg);
         throw std::runtime_error(error_msg);
@@ -205,41 +541,93 @@ FractionalSolver::~FractionalSolver() {
 }
 
 const SOEKernel& FractionalSolver::getKernel(double alpha) {
-    int idx = findKernelIndex(alpha);
-    if (idx >= 0) {
-        return cached_kernels_[idx];
+    return cached_kernels_[getKernelIndex(alpha)];
+}
+
+int FractionalSolver::getKernelIndex(double alpha) const {
+    const int last = static_cast<int>(cached_kernels_.size()) - 1;
+    if (last <= 0 || !(alpha > config_.alpha_min)) {
+        return 0;  // single-sample table, α ≤ alpha_min or NaN
+    }
+    const int idx = static_cast<int>(std::lround((alpha - config_.alpha_min) * table_inv_step_));
+    return std::min(idx, last);
+}
+
+void FractionalSolver::precomputeKernels(int num_alpha_samples) {
+    const int samples = std::max(num_alpha_samples, 1);
+    const double span = config_.alpha_max - config_.alpha_min;
+
+    cached_alphas_.resize(samples);
+    cached_kernels_.resize(samples);
+    table_inv_step_ = (samples > 1 && span > 0.0) ? (samples - 1) / span : 0.0;
+
+    const bool fitted = config_.soe_tolerance > 0.0;
+    std::unique_ptr<SOEKernelCache> disk_cache;
+    if (fitted && !config_.soe_cache_path.empty()) {
+        disk_cache.reset(new SOEKernelCache(config_.soe_cache_path));
     }
 
-    if (cached_kernels_.size() >= 2) {
-        SOEKernel kernel = interpolateKernels(alpha);
-        cached_alphas_.push_back(alpha);
-        cached_kernels_.push_back(kernel);
-        return cached_kernels_.back();
+    int max_rank = 0;
+    int unmet = 0;
+    for (int i = 0; i < samples; i++) {
+        double alpha = (samples > 1)
+            ? config_.alpha_min + span * i / (samples - 1)
+            : config_.alpha_min;
+        cached_alphas_[i] = alpha;
+        SOEKernel& kernel = cached_kernels_[i];
+        if (!fitted) {
+            kernel.initialize(alpha, config_.T_max, config_.soe_rank);
+        } else if (!disk_cache || !disk_cache->lookup(alpha, config_.T_max, config_.dt,
+                                                      config_.soe_tolerance, kernel)) {
+            if (!kernel.fit(alpha, config_.T_max, config_.dt, config_.soe_tolerance, config_.soe_rank)) {
+                unmet++;
+            }
+            if (disk_cache) {
+                disk_cache->store(alpha, config_.T_max, config_.dt, config_.soe_tolerance, kernel);
+            }
+        }
+        max_rank = std::max(max_rank, kernel.rank);
     }
+    table_decay_dt_ = std::numeric_limits<double>::quiet_NaN();
 
-    SOEKernel kernel;
-    kernel.initialize(alpha, config_.T_max, config_.soe_rank);
+    if (unmet > 0) {
+        LOG_WARNING(std::to_string(unmet) + " SOE kernel(s) miss soe_tolerance " +
+                    std::to_string(config_.soe_tolerance) + " at the rank limit " +
+                    std::to_string(config_.soe_rank) + "; using the closest fit");
+    }
+    if (disk_cache && disk_cache->isDirty()) {
+        try {
+            disk_cache->save();
+        } catch (const std::runtime_error& e) {
+            LOG_WARNING(std::string("SOE kernel cache not saved: ") + e.what());
+        }
+    }
 
-    cached_alphas_.push_back(alpha);
-    cached_kernels_.push_back(kernel);
+    // History holds the largest kernel's terms (at least one, so buffers
+    // and layouts stay well-formed when every kernel vanishes)
+    const int rank = fitted ? std::max(max_rank, 1) : config_.soe_rank;
+    if (rank != history_rank_) {
+        history_rank_ = rank;
+        allocateHistory();
+    }
 
-    return cached_kernels_.back();
+    // Table spacing changed: remap the bound α field
+    if (!point_alphas_.empty()) {
+        for (int i = 0; i < num_points_; i++) {
+            point_kernel_index_[i] = getKernelIndex(point_alphas_[i]);
+        }
+    }
 }
 
-void FractionalSolver::precomputeKernels(int num_alpha_samples) {
-    cached_alphas_.clear();
-    cached_kernels_.clear();
-
-    if (num_alpha_samples <= 1) {
-        getKernel(config_.alpha_min);
-        return;
+void FractionalSolver::setPointAlphas(const std::vector<double>& alpha_values) {
+    if (static_cast<int>(alpha_values.size()) != num_points_) {
+        throw std::runtime_error("FractionalSolver::setPointAlphas input size mismatch");
     }
 
-    double span = config_.alpha_max - config_.alpha_min;
-    for (int i = 0; i < num_alpha_samples; i++) {
-        double alpha = config_.alpha_min + span * i / (num_alpha_samples - 1);
-        const SOEKernel& kernel = getKernel(alpha);
-        (void)kernel;
+    point_alphas_ = alpha_values;
+    point_kernel_index_.resize(num_points_);
+    for (int i = 0; i < num_points_; i++) {
+        point_kernel_index_[i] = getKernelIndex(alpha_values[i]);
     }
 }
 
@@ -255,9 +643,91 @@ void FractionalSolver::updateHistory(
         throw std::runtime_error("FractionalSolver::updateHistory input size mismatch");
     }
 
+    scratch_kernel_index_.resize(num_points_);
     for (int i = 0; i < num_points_; i++) {
-        const SOEKernel& kernel = getKernel(alpha_values[i]);
-        history_states_[i].update(kernel, field_second_time_derivatives[i], dt);
+        scratch_kernel_index_[i] = getKernelIndex(alpha_values[i]);
+    }
+    advanceHistory(field_second_time_derivatives.data(), scratch_kernel_index_.data(), dt, nullptr);
+}
+
+void FractionalSolver::updateHistory(
+    const std::vector<std::complex<double>>& field_second_time_derivatives,
+    double dt)
+{
+    if (static_cast<int>(field_second_time_derivatives.size()) != num_points_) {
+        throw std::runtime_error("FractionalSolver::updateHistory input size mismatch");
+    }
+    if (!hasPointAlphas()) {
+        throw std::runtime_error("FractionalSolver::updateHistory called before setPointAlphas");
+    }
+
+    advanceHistory(field_second_time_derivatives.data(), point_kernel_index_.data(), dt, nullptr);
+}
+
+void FractionalSolver::updateHistoryAndDerivatives(
+    const std::vector<std::complex<double>>& field_second_time_derivatives,
+    double dt,
+    std::vector<std::complex<double>>& derivatives_out)
+{
+    if (static_cast<int>(field_second_time_derivatives.size()) != num_points_) {
+        throw std::runtime_error("FractionalSolver::updateHistoryAndDerivatives input size mismatch");
+    }
+    if (!hasPointAlphas()) {
+        throw std::runtime_error("FractionalSolver::updateHistoryAndDerivatives called before setPointAlphas");
+    }
+
+    if (static_cast<int>(derivatives_out.size()) != num_points_) {
+        derivatives_out.resize(num_points_);
+    }
+    advanceHistory(field_second_time_derivatives.data(), point_kernel_index_.data(), dt,
+                   derivatives_out.data());
+}
+
+void FractionalSolver::prepareKernelTables(double dt) {
+    const int R = history_rank_;
+    const size_t table_len = cached_kernels_.size() * static_cast<size_t>(R);
+    if (dt == table_decay_dt_ && table_weights_.size() == table_len) {
+        return;
+    }
+
+    table_weights_.resize(table_len);
+    table_decay_.resize(table_len);
+    for (size_t k = 0; k < cached_kernels_.size(); k++) {
+        SOEKernel& kernel = cached_kernels_[k];
+        if (kernel.rank > R) {
+            throw std::runtime_error("FractionalSolver kernel rank exceeds history rank");
+        }
+        kernel.prepareDecay(dt);
+        for (int r = 0; r < R; r++) {
+            table_weights_[k * R + r] = (r < kernel.rank) ? kernel.weights[r] : 0.0;
+            table_decay_[k * R + r] = (r < kernel.rank) ? kernel.decay[r] : 0.0;
+        }
+    }
+    table_decay_dt_ = dt;
+}
+
+void FractionalSolver::advanceHistory(
+    const std::complex<double>* second_derivatives,
+    const int* kernel_index,
+    double dt,
+    std::complex<double>* derivatives_out)
+{
+    DASE_TRACE_ZONE("gw.fractional_history");
+    // Recursive SOE update, per point and term (Diethelm et al. 2005, §3.2):
+    //   zᵣ(t+dt) = exp(-sᵣ dt) zᵣ(t) + wᵣ ∂²_t f(t) dt
+    // evaluated on split Re/Im arrays with the decay factors cached per dt.
+    // Term order and arithmetic match HistoryState::update/computeDerivative
+    // (with Single storage only the stored states are rounded).
+    prepareKernelTables(dt);
+
+    if (config_.history_precision == HistoryPrecision::Single) {
+        advanceStates(config_.history_layout, num_points_, history_rank_,
+                      table_weights_.data(), table_decay_.data(), kernel_index,
+                      second_derivatives, dt, z_re_f_.data(), z_im_f_.data(), derivatives_out);
+    } else {
+        advanceStates(config_.history_layout, num_points_, history_rank_,
+                      table_weights_.data(), table_decay_.data(), kernel_index,
+                      second_derivatives, dt, z_re_.data(), z_im_.data(), derivatives_out);
     }
 }
 
@@ -269,12 +739,22 @@ std::vector<std::complex<double>> FractionalSolver::computeDerivatives(
     }
 
     std::vector<std::complex<double>> derivatives(num_points_);
+    computeDerivatives(derivatives);
+    return derivatives;
+}
 
-    for (int i = 0; i < num_points_; i++) {
-        derivatives[i] = history_states_[i].computeDerivative();
+void FractionalSolver::computeDerivatives(std::vector<std::complex<double>>& derivatives_out) const {
+    if (static_cast<int>(derivatives_out.size()) != num_points_) {
+        derivatives_out.resize(num_points_);
     }
 
-    return derivatives;
+    const int N = num_points_;
+    const bool single = (config_.history_precision == HistoryPrecision::Single);
+    #pragma omp parallel for schedule(static) if(N >= FRACTIONAL_OMP_MIN_POINTS)
+    for (int i = 0; i < N; i++) {
+        derivatives_out[i] = single ? sumStates(z_re_f_.data(), z_im_f_.data(), i)
+                                    : sumStates(z_re_.data(), z_im_.data(), i);
+    }
 }
 
 std::complex<double> FractionalSolver::computeDerivativeAt(int point_index, double alpha) const {
@@ -282,7 +762,10 @@ std::complex<double> FractionalSolver::computeDerivativeAt(int point_index, doub
         throw std::out_of_range("Point index out of bounds");
     }
 
-    return history_states_[point_index].computeDerivative();
+    (void)alpha;  // History already encodes the point's kernel
+    return (config_.history_precision == HistoryPrecision::Single)
+        ? sumStates(z_re_f_.data(), z_im_f_.data(), point_index)
+        : sumStates(z_re_.data(), z_im_.data(), point_index);
 }
 
 int FractionalSolver::getNumCachedKernels() const {
@@ -290,14 +773,95 @@ int FractionalSolver::getNumCachedKernels() const {
 }
 
 void FractionalSolver::resetHistory() {
-    for (auto& state : history_states_) {
-        state.reset();
+    std::fill(z_re_.begin(), z_re_.end(), 0.0);
+    std::fill(z_im_.begin(), z_im_.end(), 0.0);
+    std::fill(z_re_f_.begin(), z_re_f_.end(), 0.0f);
+    std::fill(z_im_f_.begin(), z_im_f_.end(), 0.0f);
+}
+
+void FractionalSolver::setPointHistory(int point, const FractionalSolver& source,
+                                       const int* source_points, const double* weights, int count) {
+    if (source.history_rank_ != history_rank_ ||
+        source.config_.history_precision != config_.history_precision) {
+        throw std::invalid_argument("setPointHistory: source history rank or precision differs");
+    }
+    const bool single = config_.history_precision == HistoryPrecision::Single;
+    for (int r = 0; r < history_rank_; r++) {
+        double re = 0.0;
+        double im = 0.0;
+        for (int n = 0; n < count; n++) {
+            const size_t from = source.historyIndex(source_points[n], r);
+            re += weights[n] * (single ? source.z_re_f_[from] : source.z_re_[from]);
+            im += weights[n] * (single ? source.z_im_f_[from] : source.z_im_[from]);
+        }
+        const size_t to = historyIndex(point, r);
+        if (single) {
+            z_re_f_[to] = static_cast<float>(re);
+            z_im_f_[to] = static_cast<float>(im);
+        } else {
+            z_re_[to] = re;
+            z_im_[to] = im;
+        }
+    }
+}
+
+void FractionalSolver::saveCheckpoint(CheckpointWriter& writer) const {
+    const size_t history_len = static_cast<size_t>(num_points_) * history_rank_;
+    writer.addValues("gw.history_shape", {
+        static_cast<uint64_t>(num_points_),
+        static_cast<uint64_t>(history_rank_),
+        static_cast<uint64_t>(config_.history_layout),
+        static_cast<uint64_t>(config_.history_precision)
+    });
+    if (config_.history_precision == HistoryPrecision::Single) {
+        writer.add("gw.history_re", CheckpointType::F32, z_re_f_.data(), sizeof(float), history_len);
+        writer.add("gw.history_im", CheckpointType::F32, z_im_f_.data(), sizeof(float), history_len);
+    } else {
+        writer.addF64("gw.history_re", z_re_.data(), history_len);
+        writer.addF64("gw.history_im", z_im_.data(), history_len);
+    }
+}
+
+void FractionalSolver::restoreCheckpoint(const CheckpointImage& image) {
+    uint64_t shape[4] = {};
+    image.readU64("gw.history_shape", shape, 4);
+    if (shape[0] != static_cast<uint64_t>(num_points_) ||
+        shape[1] != static_cast<uint64_t>(history_rank_) ||
+        shape[2] != static_cast<uint64_t>(config_.history_layout) ||
+        shape[3] != static_cast<uint64_t>(config_.history_precision)) {
+        throw std::runtime_error("Checkpoint history (" + std::to_string(shape[0]) + " points, rank " +
+                                 std::to_string(shape[1]) + ") does not match this solver");
+    }
+
+    const size_t history_len = static_cast<size_t>(num_points_) * history_rank_;
+    if (config_.history_precision == HistoryPrecision::Single) {
+        const size_t bytes = history_len * sizeof(float);
+        std::memcpy(z_re_f_.data(), image.data("gw.history_re", CheckpointType::F32, sizeof(float), history_len), bytes);
+        std::memcpy(z_im_f_.data(), image.data("gw.history_im", CheckpointType::F32, sizeof(float), history_len), bytes);
+    } else {
+        image.readF64("gw.history_re", z_re_.data(), history_len);
+        image.readF64("gw.history_im", z_im_.data(), history_len);
     }
 }
 
 size_t FractionalSolver::getMemoryUsage() const {
-    // Estimate: num_points * soe_rank * sizeof(complex<double>)
-    return num_points_ * config_.soe_rank * sizeof(std::complex<double>);
+    // Flat history buffer (at its storage precision), kernel tables and the
+    // bound α field
+    return (z_re_.capacity() + z_im_.capacity()) * sizeof(double)
+         + (z_re_f_.capacity() + z_im_f_.capacity()) * sizeof(float)
+         + (table_weights_.capacity() + table_decay_.capacity()) * sizeof(double)
+         + point_alphas_.capacity() * sizeof(double)
+         + (point_kernel_index_.capacity() + scratch_kernel_index_.capacity()) * sizeof(int);
+}
+
+size_t FractionalSolver::estimateMemoryUsage(const FractionalSolverConfig& config, int num_points) {
+    const size_t points = static_cast<size_t>(std::max(num_points, 0));
+    const size_t rank = static_cast<size_t>(std::max(config.soe_rank, 1));
+    const size_t state_bytes = (config.history_precision == HistoryPrecision::Single)
+        ? 2 * sizeof(float) : 2 * sizeof(double);
+    return points * rank * state_bytes
+         + 2 * static_cast<size_t>(std::max(config.alpha_table_size, 1)) * rank * sizeof(double)
+         + points * (sizeof(double) + 2 * sizeof(int));
 }
 
 double FractionalSolver::computeExactCaputo(double alpha, double beta, double t) const {
@@ -331,10 +895,10 @@ FractionalSolver::ValidationResult FractionalSolver::validateSOEApproximation(
         throw std::invalid_argument("Validation tolerance must be positive");
     }
 
+    // Validate the exact (unquantized) kernel for α
     SOEKernel kernel;
-    int idx = findKernelIndex(alpha);
-    if (idx >= 0) {
-        kernel = cached_kernels_[idx];
+    if (config_.soe_tolerance > 0.0) {
+        kernel.fit(alpha, config_.T_max, config_.dt, config_.soe_tolerance, config_.soe_rank);
     } else {
         kernel.initialize(alpha, config_.T_max, config_.soe_rank);
     }
@@ -346,12 +910,21 @@ FractionalSolver::ValidationResult FractionalSolver::validateSOEApproximation(
         throw std::runtime_error("Exact kernel undefined for given alpha");
     }
 
-    const int samples = 80;
+    // Fixed-rank kernels: uniform samples of (0, T_max].  Fitted kernels:
+    // the log-spaced [dt, T_max] samples their fit was checked on.
+    std::vector<double> times;
+    if (config_.soe_tolerance > 0.0) {
+        times = logSpacedTimes(config_.dt, config_.T_max);
+    } else {
+        for (int i = 1; i <= 80; ++i) {
+            times.push_back((config_.T_max * i) / 80.0);
+        }
+    }
+    const int samples = static_cast<int>(times.size());
     double sum_error = 0.0;
     double sum_sq_error = 0.0;
 
-    for (int i = 1; i <= samples; ++i) {
-        double t = (config_.T_max * i) / static_cast<double>(samples);
+    for (double t : times) {
         double t_power = std::pow(t, 1.0 - 2.0 * alpha);
         double exact = t_power / gamma_value;
         double approx = kernel.evaluate(t);
@@ -372,68 +945,6 @@ FractionalSolver::ValidationResult FractionalSolver::validateSOEApproximation(
 }
 
 
-int FractionalSolver::findKernelIndex(double alpha, double tolerance) const {
-    for (size_t i = 0; i < cached_alphas_.size(); i++) {
-        if (std::abs(cached_alphas_[i] - alpha) < tolerance) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-SOEKernel FractionalSolver::interpolateKernels(double alpha) const {
-    SOEKernel kernel;
-
-    if (cached_kernels_.size() < 2) {
-        kernel.initialize(alpha, config_.T_max, config_.soe_rank);
-        return kernel;
-    }
-
-    int lower_idx = -1;
-    int upper_idx = -1;
-    for (size_t i = 0; i < cached_alphas_.size(); ++i) {
-        double a = cached_alphas_[i];
-        if (a <= alpha && (lower_idx < 0 || a > cached_alphas_[lower_idx])) {
-            lower_idx = static_cast<int>(i);
-        }
-        if (a >= alpha && (upper_idx < 0 || a < cached_alphas_[upper_idx])) {
-            upper_idx = static_cast<int>(i);
-        }
-    }
-
-    if (lower_idx < 0 || upper_idx < 0 || lower_idx == upper_idx) {
-        kernel.initialize(alpha, config_.T_max, config_.soe_rank);
-        return kernel;
-    }
-
-    const SOEKernel& lower = cached_kernels_[lower_idx];
-    const SOEKernel& upper = cached_kernels_[upper_idx];
-    if (lower.rank != upper.rank || lower.rank <= 0) {
-        kernel.initialize(alpha, config_.T_max, config_.soe_rank);
-        return kernel;
-    }
-
-    double a0 = cached_alphas_[lower_idx];
-    double a1 = cached_alphas_[upper_idx];
-    double denom = a1 - a0;
-    if (std::abs(denom) < 1e-12) {
-        kernel = lower;
-        return kernel;
-    }
-
-    double t = (alpha - a0) / denom;
-    kernel.rank = lower.rank;
-    kernel.weights.resize(kernel.rank);
-    kernel.exponents.resize(kernel.rank);
-    for (int i = 0; i < kernel.rank; ++i) {
-        kernel.weights[i] = (1.0 - t) * lower.weights[i] + t * upper.weights[i];
-        kernel.exponents[i] = (1.0 - t) * lower.exponents[i] + t * upper.exponents[i];
-    }
-
-    return kernel;
-}
-
-
 // ============================================================================
 // MittagLefflerFunction Implementation
 // ============================================================================
@@ -476,6 +987,130 @@ double MittagLefflerFunction::evaluate_real(double alpha, double beta, double z)
     return evaluate(alpha, beta, std::complex<double>(z, 0.0), 100, 1e-12).real();
 }
 
+namespace {
+
+// dE_α,β/dz = Σ_{k≥1} k z^(k-1) / Γ(αk + β), with evaluate's stopping rule
+double mittagLefflerSlope(double alpha, double beta, double z,
+                          int max_terms = 100, double tolerance = 1e-12)
+{
+    double sum = 0.0;
+    double z_power = 1.0;
+    for (int k = 1; k < max_terms; k++) {
+        double term = k * z_power / gamma_functions::gamma(alpha * k + beta);
+        sum += term;
+        if (std::abs(term) < tolerance * std::abs(sum)) {
+            break;
+        }
+        z_power *= z;
+    }
+    return sum;
+}
+
+struct MittagLefflerTableCache {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<const MittagLefflerTable>> tables;  // Most recent first
+};
+
+MittagLefflerTableCache& tableCache() {
+    static MittagLefflerTableCache cache;
+    return cache;
+}
+
+} // namespace
+
+MittagLefflerTable::MittagLefflerTable(double alpha, double beta,
+                                       double z_min, double z_max, int intervals)
+    : alpha_(alpha)
+    , beta_(beta)
+    , z_min_(z_min)
+    , z_max_(z_max)
+    , intervals_(intervals)
+{
+    if (intervals <= 0 || !(z_max > z_min)) {
+        throw std::invalid_argument("Mittag-Leffler table needs z_max > z_min and at least one interval");
+    }
+
+    h_ = (z_max - z_min) / intervals;
+    inv_h_ = 1.0 / h_;
+    values_.resize(intervals + 1);
+    slopes_.resize(intervals + 1);
+    for (int n = 0; n <= intervals; n++) {
+        double z = (n == intervals) ? z_max : z_min + n * h_;
+        values_[n] = MittagLefflerFunction::evaluate_real(alpha, beta, z);
+        slopes_[n] = h_ * mittagLefflerSlope(alpha, beta, z);
+    }
+}
+
+double MittagLefflerTable::evaluate(double z) const {
+    double t = (z - z_min_) * inv_h_;
+    int n = std::min(static_cast<int>(t), intervals_ - 1);
+    double s = t - n;
+    double s2 = s * s;
+    double one_minus = 1.0 - s;
+
+    // Cubic Hermite basis on [z_n, z_n+1]
+    double h00 = (1.0 + 2.0 * s) * one_minus * one_minus;
+    double h10 = s * one_minus * one_minus;
+    double h01 = s2 * (3.0 - 2.0 * s);
+    double h11 = s2 * (s - 1.0);
+
+    return h00 * values_[n] + h10 * slopes_[n] + h01 * values_[n + 1] + h11 * slopes_[n + 1];
+}
+
+size_t MittagLefflerTable::getMemoryUsage() const {
+    return (values_.size() + slopes_.size()) * sizeof(double);
+}
+
+double MittagLefflerFunction::evaluate_real_tabulated(double alpha, double beta, double z) {
+    if (!(std::abs(z) <= ML_TABLE_Z_LIMIT)) {
+        return evaluate_real(alpha, beta, z);
+    }
+    return get_table(alpha, beta)->evaluate(z);
+}
+
+std::shared_ptr<const MittagLefflerTable> MittagLefflerFunction::get_table(double alpha, double beta) {
+    MittagLefflerTableCache& cache = tableCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (size_t n = 0; n < cache.tables.size(); n++) {
+            if (cache.tables[n]->getAlpha() == alpha && cache.tables[n]->getBeta() == beta) {
+                std::rotate(cache.tables.begin(), cache.tables.begin() + n, cache.tables.begin() + n + 1);
+                return cache.tables.front();
+            }
+        }
+    }
+
+    // Build outside the lock; if two threads race, the first insert wins
+    auto table = std::make_shared<const MittagLefflerTable>(
+        alpha, beta, -ML_TABLE_Z_LIMIT, ML_TABLE_Z_LIMIT, ML_TABLE_INTERVALS);
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    for (const auto& existing : cache.tables) {
+        if (existing->getAlpha() == alpha && existing->getBeta() == beta) {
+            return existing;
+        }
+    }
+    cache.tables.insert(cache.tables.begin(), table);
+    if (cache.tables.size() > static_cast<size_t>(ML_TABLE_CACHE_ENTRIES)) {
+        cache.tables.pop_back();
+    }
+    LOG_DEBUG("Built Mittag-Leffler table for alpha=" + std::to_string(alpha) +
+              ", beta=" + std::to_string(beta));
+    return table;
+}
+
+void MittagLefflerFunction::clear_table_cache() {
+    MittagLefflerTableCache& cache = tableCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.tables.clear();
+}
+
+size_t MittagLefflerFunction::get_table_cache_size() {
+    MittagLefflerTableCache& cache = tableCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.tables.size();
+}
+
 std::complex<double> MittagLefflerFunction::asymptotic_expansion(
     double alpha, double beta, std::complex<double> z, int num_terms)
 {
@@ -18,11 +18,15 @@
 
 #pragma once
 
+#include "aligned_allocator.h"
 #include <vector>
 #include <complex>
 #include <memory>
+#include <string>
 
 namespace dase {
+class CheckpointWriter;
+class CheckpointImage;
 namespace igsoa {
 namespace gw {
 
@@ -40,8 +44,17 @@ struct SOEKernel {
     std::vector<double> exponents;   // sᵣ decay rates
     int rank;                        // R = number of exponential terms
 
+    // Per-step decay factors exp(-sᵣ dt) for decay_dt (see prepareDecay)
+    std::vector<double> decay;
+    double decay_dt;
+
     SOEKernel();
 
+    /**
+     * Cache exp(-sᵣ dt) for the given timestep (no-op if already cached)
+     */
+    void prepareDecay(double dt);
+
     /**
      * Initialize SOE approximation for given α
      * @param alpha Fractional order ∈ [1.0, 2.0]
@@ -50,6 +63,26 @@ struct SOEKernel {
      */
     void initialize(double alpha, double T_max, int target_rank = 12);
 
+    /**
+     * Accuracy-targeted alternative to initialize()
+     *
+     * Fits K_α(t) = t^(1-2α) / Γ(2-2α) on [t_min, T_max] with the fewest
+     * terms (at most max_rank) whose maximum relative error, as reported by
+     * maxRelativeError(), is within tolerance.  Exponents are log-spaced;
+     * weights solve a relative least-squares problem.  Where 1/Γ(2-2α) = 0
+     * (α = 1, 1.5, 2) the kernel vanishes and rank is 0.
+     *
+     * @return true if tolerance was met; otherwise the most accurate fit
+     *         found is kept
+     */
+    bool fit(double alpha, double T_max, double t_min, double tolerance, int max_rank);
+
+    /**
+     * Maximum relative error vs the exact kernel over log-spaced samples of
+     * [t_min, T_max] (the check used by fit)
+     */
+    double maxRelativeError(double alpha, double t_min, double T_max) const;
+
     /**
      * Evaluate kernel at time t
      */
@@ -66,6 +99,9 @@ struct SOEKernel {
  *
  * Stores internal states zᵣ(t) for each SOE term, enabling
  * recursive update without storing full history.
+ *
+ * Standalone single-point form; FractionalSolver keeps all points in one
+ * flat buffer instead (see HistoryLayout).
  */
 struct HistoryState {
     std::vector<std::complex<double>> z_states;  // Internal states zᵣ
@@ -91,6 +127,32 @@ struct HistoryState {
     void reset();
 };
 
+/**
+ * Memory layout of FractionalSolver's flat history buffer
+ *
+ * PointMajor: z[i·R + r]  (one point's R states contiguous; default)
+ * RankMajor:  z[r·N + i]  (one SOE term across all points contiguous;
+ *                          vectorizes across points)
+ */
+enum class HistoryLayout {
+    PointMajor,
+    RankMajor
+};
+
+/**
+ * Storage precision of FractionalSolver's history buffer
+ *
+ * Double: float64 states (default; bit-identical to HistoryState)
+ * Single: float32 states, halving the soe_rank × N buffer.  Every update
+ *         and derivative sum is still evaluated in double; only the stored
+ *         zᵣ are rounded (relative error ~1e-7 per state, damped by the
+ *         exponential decay of each term).
+ */
+enum class HistoryPrecision {
+    Double,
+    Single
+};
+
 /**
  * Configuration for fractional solver
  */
@@ -103,6 +165,25 @@ struct FractionalSolverConfig {
     double alpha_min;       // Minimum α (maximum memory)
     double alpha_max;       // Maximum α (minimum memory)
 
+    // Kernel table: α is quantized to this many uniform samples on
+    // [alpha_min, alpha_max] (nearest sample, O(1) lookup)
+    int alpha_table_size;
+
+    // History buffer layout (results are identical; only speed differs)
+    HistoryLayout history_layout;
+
+    // History storage precision (Single halves history memory)
+    HistoryPrecision history_precision;
+
+    // Kernel construction: 0 keeps the fixed-rank initialize() kernels;
+    // > 0 fits every kernel to this relative error over [dt, T_max] with
+    // at most soe_rank terms (SOEKernel::fit), and the history is sized by
+    // the largest fitted rank
+    double soe_tolerance;
+
+    // On-disk cache of fitted kernels (see SOEKernelCache); empty disables
+    std::string soe_cache_path;
+
     FractionalSolverConfig();
 };
 
@@ -121,6 +202,15 @@ public:
      */
     explicit FractionalSolver(const FractionalSolverConfig& config, int num_points);
 
+    /**
+     * Constructor reusing kernel_source's configuration and kernel table
+     * (no kernel construction or cache lookup); the history is new and
+     * zeroed, and no α field is bound
+     * @param kernel_source Solver whose kernels are copied
+     * @param num_points Total number of field grid points
+     */
+    FractionalSolver(const FractionalSolver& kernel_source, int num_points);
+
     /**
      * Destructor
      */
@@ -133,16 +223,37 @@ public:
     // === Kernel Management ===
 
     /**
-     * Get or create SOE kernel for given α
-     * (Kernels are cached for efficiency)
+     * Get SOE kernel for given α
+     * (α is quantized to the nearest sample of the precomputed table;
+     *  values outside [alpha_min, alpha_max] clamp to the end samples)
      */
     const SOEKernel& getKernel(double alpha);
 
     /**
-     * Precompute kernels for range of α values
+     * Rebuild the kernel table with num_alpha_samples uniform α samples
+     * (the constructor builds it with config.alpha_table_size).  Fitted
+     * kernels are looked up in / added to config.soe_cache_path; if the
+     * largest fitted rank changes, the history is reallocated and zeroed.
      */
     void precomputeKernels(int num_alpha_samples = 20);
 
+    /**
+     * Table index of the kernel used for α (O(1), no search)
+     */
+    int getKernelIndex(double alpha) const;
+
+    /**
+     * Bind the per-point α field: maps every grid point to its kernel
+     * index once, so updateHistory(second_derivatives, dt) does no lookups.
+     * Call again whenever α(x) changes (see SymmetryField::getAlphaRevision).
+     */
+    void setPointAlphas(const std::vector<double>& alpha_values);
+
+    /**
+     * True once setPointAlphas() has been called
+     */
+    bool hasPointAlphas() const { return !point_kernel_index_.empty(); }
+
     // === Fractional Derivative Computation ===
 
     /**
@@ -160,6 +271,30 @@ public:
         double dt
     );
 
+    /**
+     * Update history states using the α field bound by setPointAlphas()
+     *
+     * @param field_second_time_derivatives ∂²_t δΦ(x,t)
+     * @param dt Timestep
+     */
+    void updateHistory(
+        const std::vector<std::complex<double>>& field_second_time_derivatives,
+        double dt
+    );
+
+    /**
+     * Fused update + derivative pass (α field bound by setPointAlphas)
+     *
+     * Advances every history state by dt and writes the resulting
+     * ₀D^α_t δΦ into derivatives_out (resized to getNumPoints() if needed),
+     * i.e. the value the next computeDerivatives() call would return.
+     */
+    void updateHistoryAndDerivatives(
+        const std::vector<std::complex<double>>& field_second_time_derivatives,
+        double dt,
+        std::vector<std::complex<double>>& derivatives_out
+    );
+
     /**
      * Compute fractional derivatives for all grid points
      *
@@ -170,6 +305,12 @@ public:
         const std::vector<double>& alpha_values
     ) const;
 
+    /**
+     * Compute fractional derivatives into a caller-provided buffer
+     * (resized to getNumPoints() if needed)
+     */
+    void computeDerivatives(std::vector<std::complex<double>>& derivatives_out) const;
+
     /**
      * Compute fractional derivative for single grid point
      */
@@ -198,16 +339,52 @@ public:
      */
     int getNumCachedKernels() const;
 
+    /**
+     * SOE terms stored per point: soe_rank, or the largest fitted kernel
+     * rank when soe_tolerance > 0
+     */
+    int getHistoryRank() const { return history_rank_; }
+
     /**
      * Reset all history states (for new simulation)
      */
     void resetHistory();
 
+    /**
+     * Set the history of `point` to Σₙ weights[n]·(history of
+     * source_points[n] in `source`).  The SOE states are the continuous-time
+     * memory integrals, so a mesh refinement patch built from `source` by
+     * the kernel-sharing constructor inherits its parent's history by the
+     * same interpolation as the field (or copies a point, count 1, on
+     * regrid).  Source and target must share the history rank and precision;
+     * layouts may differ.
+     * @throws std::invalid_argument on a rank or precision mismatch
+     */
+    void setPointHistory(int point, const FractionalSolver& source,
+                         const int* source_points, const double* weights, int count);
+
+    /**
+     * Checkpoint the history states zᵣ (engine_checkpoint.h), stored in
+     * the configured precision and layout:
+     *   gw.history_shape  u64 [num_points, rank, layout, precision]
+     *   gw.history_re/im  f64 or f32 [num_points · rank]
+     * Restoring needs the same kernels (config and bound α field) and
+     * throws std::runtime_error on any shape difference.
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const;
+    void restoreCheckpoint(const CheckpointImage& image);
+
     /**
      * Get memory usage estimate (bytes)
      */
     size_t getMemoryUsage() const;
 
+    /**
+     * getMemoryUsage() of a solver for `num_points` once its α field is
+     * bound and it has stepped (fitted kernels counted at the soe_rank limit)
+     */
+    static size_t estimateMemoryUsage(const FractionalSolverConfig& config, int num_points);
+
     // === Analytical Tests ===
 
     /**
@@ -230,19 +407,102 @@ public:
 private:
     FractionalSolverConfig config_;
     int num_points_;
+    int history_rank_;                    // R of the flat history buffers
 
-    // SOE kernel cache (map: α → kernel)
+    // SOE kernel table: uniform α samples (fixed size; references stay valid
+    // until the next precomputeKernels call)
     std::vector<double> cached_alphas_;
     std::vector<SOEKernel> cached_kernels_;
+    double table_inv_step_;               // 1 / α sample spacing (0 for one sample)
+
+    // Per-point kernel indices for the bound α field
+    std::vector<double> point_alphas_;
+    std::vector<int> point_kernel_index_;
+    std::vector<int> scratch_kernel_index_;   // per-call α path (reused)
+
+    // Flattened kernel table for the hot loop: [kernel · R + r]
+    using AlignedArray = std::vector<double, aligned_allocator<double, 64>>;
+    using AlignedFloatArray = std::vector<float, aligned_allocator<float, 64>>;
+    AlignedArray table_weights_;
+    AlignedArray table_decay_;
+    double table_decay_dt_;
+
+    // History states zᵣ for all points (layout per config_.history_layout);
+    // only the pair matching config_.history_precision is allocated
+    AlignedArray z_re_;
+    AlignedArray z_im_;
+    AlignedFloatArray z_re_f_;
+    AlignedFloatArray z_im_f_;
+
+    // Helper: index of state (point i, term r) in the history arrays
+    size_t historyIndex(int i, int r) const {
+        return (config_.history_layout == HistoryLayout::RankMajor)
+            ? static_cast<size_t>(r) * num_points_ + i
+            : static_cast<size_t>(i) * history_rank_ + r;
+    }
+
+    // Helper: Σᵣ zᵣ for point i, accumulated in double
+    template <typename T>
+    std::complex<double> sumStates(const T* zr, const T* zi, int i) const {
+        double sum_re = 0.0;
+        double sum_im = 0.0;
+        for (int r = 0; r < history_rank_; r++) {
+            const size_t idx = historyIndex(i, r);
+            sum_re += zr[idx];
+            sum_im += zi[idx];
+        }
+        return std::complex<double>(sum_re, sum_im);
+    }
 
-    // History states for each grid point
-    std::vector<HistoryState> history_states_;
+    // Helper: (re)build table_weights_/table_decay_ for dt; kernels below
+    // history_rank_ are padded with zero-weight, zero-decay terms
+    void prepareKernelTables(double dt);
 
-    // Helper: find or create kernel for α
-    int findKernelIndex(double alpha, double tolerance = 1e-6) const;
+    // Helper: (re)allocate zeroed history buffers for history_rank_
+    void allocateHistory();
 
-    // Helper: interpolate between two kernels if needed
-    SOEKernel interpolateKernels(double alpha) const;
+    // Helper: advance all states by dt; optionally write derivatives
+    void advanceHistory(const std::complex<double>* second_derivatives,
+                        const int* kernel_index,
+                        double dt,
+                        std::complex<double>* derivatives_out);
+};
+
+/**
+ * Tabulated E_α,β(z) for real z on a fixed interval
+ *
+ * Nodes hold the series values and first derivatives, and lookups use
+ * cubic Hermite interpolation (C¹ spline, O(h⁴) error).  Immutable once
+ * built, so a table can be shared across threads.
+ */
+class MittagLefflerTable {
+public:
+    /**
+     * @param z_min, z_max Tabulated interval
+     * @param intervals Number of spline intervals (>= 1)
+     * @throws std::invalid_argument for an empty interval or no intervals
+     */
+    MittagLefflerTable(double alpha, double beta, double z_min, double z_max, int intervals);
+
+    double getAlpha() const { return alpha_; }
+    double getBeta() const { return beta_; }
+
+    bool contains(double z) const { return z >= z_min_ && z <= z_max_; }
+
+    /**
+     * Interpolated E_α,β(z); z must satisfy contains(z)
+     */
+    double evaluate(double z) const;
+
+    size_t getMemoryUsage() const;
+
+private:
+    double alpha_, beta_;
+    double z_min_, z_max_;
+    double h_, inv_h_;
+    int intervals_;
+    std::vector<double> values_;       // E(z_n)
+    std::vector<double> slopes_;       // h · E'(z_n)
 };
 
 /**
@@ -281,6 +541,28 @@ public:
      */
     static double evaluate_real(double alpha, double beta, double z);
 
+    /**
+     * evaluate_real through a cached per-(α,β) table
+     *
+     * Tables cover z ∈ [-ML_TABLE_Z_LIMIT, ML_TABLE_Z_LIMIT], are built on
+     * first use and kept for at most ML_TABLE_CACHE_ENTRIES distinct
+     * pairs (least recently used is dropped).  Arguments outside the
+     * table use the series.  Thread-safe.
+     */
+    static double evaluate_real_tabulated(double alpha, double beta, double z);
+
+    /**
+     * Shared table for (α,β), building it if needed
+     */
+    static std::shared_ptr<const MittagLefflerTable> get_table(double alpha, double beta);
+
+    /**
+     * Drop all cached tables
+     */
+    static void clear_table_cache();
+
+    static size_t get_table_cache_size();
+
     /**
      * Asymptotic expansion for large |z|
      */
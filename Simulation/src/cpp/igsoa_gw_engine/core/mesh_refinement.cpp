@@ -0,0 +1,500 @@
+/**
+ * IGSOA Gravitational Wave Engine - Block-Structured Mesh Refinement Implementation
+ */
+
+#include "mesh_refinement.h"
+#include "engine_memory.h"
+#include "trace_zones.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+MeshRefinementConfig::MeshRefinementConfig()
+    : levels(1)
+    , ratio(2)
+    , margin(4)
+    , regrid_margin(2)
+{
+}
+
+bool RefinementBox::operator==(const RefinementBox& other) const {
+    for (int axis = 0; axis < 3; axis++) {
+        if (lo[axis] != other.lo[axis] || hi[axis] != other.hi[axis]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Levels
+// ============================================================================
+
+struct MeshHierarchy::Level {
+    RefinementBox box;                              // Parent vertices covered
+    std::unique_ptr<SymmetryField> field;
+    std::unique_ptr<FractionalSolver> solver;       // This level's history
+    std::vector<std::complex<double>> frac_derivs;  // ₀D^α_t δΦ for the next substep
+    std::vector<std::complex<double>> second_derivs;
+    std::vector<std::complex<double>> sources;
+    uint64_t bound_alpha_revision = 0;              // Own α revision bound to the solver
+    uint64_t parent_alpha_revision = 0;             // Parent α revision last prolonged
+
+    // Boundary layer: patch points, and 8 taps each into parent_points
+    std::vector<int> boundary_points;
+    std::vector<int> boundary_taps;
+    std::vector<double> boundary_weights;
+    std::vector<int> parent_points;
+    std::vector<std::complex<double>> parent_old;   // Parent samples before its step
+    std::vector<std::complex<double>> parent_new;   // ... and after it
+    std::vector<std::complex<double>> boundary_values;
+
+    // Restriction scratch
+    std::vector<int> restrict_indices;
+    std::vector<std::complex<double>> restrict_values;
+};
+
+namespace {
+
+void gather(const SymmetryField& field, const std::vector<int>& points,
+            std::vector<std::complex<double>>& out) {
+    const auto& phi = field.getDeltaPhiFlat();
+    out.resize(points.size());
+    for (size_t n = 0; n < points.size(); n++) {
+        out[n] = phi[points[n]];
+    }
+}
+
+// Grid coordinate of a position along one axis of a field
+double gridCoordinate(const SymmetryField& field, const Vector3D& pos, int axis) {
+    const SymmetryFieldConfig& config = field.getConfig();
+    switch (axis) {
+        case 0: return (pos.x - config.origin_x) / config.dx;
+        case 1: return (pos.y - config.origin_y) / config.dy;
+        default: return (pos.z - config.origin_z) / config.dz - config.k_offset;
+    }
+}
+
+int extent(const SymmetryField& field, int axis) {
+    return axis == 0 ? field.getNx() : (axis == 1 ? field.getNy() : field.getNz());
+}
+
+} // namespace
+
+// ============================================================================
+// MeshHierarchy
+// ============================================================================
+
+MeshHierarchy::MeshHierarchy(const SymmetryField& base, const MeshRefinementConfig& config)
+    : config_(config)
+    , regrid_count_(0)
+{
+    if (config_.levels < 0 || config_.ratio < 2 || config_.margin < 1 ||
+        config_.regrid_margin < 0 || config_.regrid_margin >= config_.margin) {
+        throw std::invalid_argument("MeshRefinementConfig: need levels >= 0, ratio >= 2 and "
+                                    "0 <= regrid_margin < margin");
+    }
+    if (base.getDecomposition() != nullptr) {
+        throw std::invalid_argument("Mesh refinement needs a whole (undecomposed) base grid");
+    }
+    if (base.getNx() < 3 || base.getNy() < 3 || base.getNz() < 3) {
+        throw std::invalid_argument("Mesh refinement needs a base grid of at least 3 points per axis");
+    }
+}
+
+MeshHierarchy::~MeshHierarchy() = default;
+
+const SymmetryField& MeshHierarchy::getLevelField(int level) const {
+    return *levels_.at(static_cast<size_t>(level - 1))->field;
+}
+
+const FractionalSolver& MeshHierarchy::getLevelSolver(int level) const {
+    return *levels_.at(static_cast<size_t>(level - 1))->solver;
+}
+
+const RefinementBox& MeshHierarchy::getLevelBox(int level) const {
+    return levels_.at(static_cast<size_t>(level - 1))->box;
+}
+
+uint64_t MeshHierarchy::getPointUpdatesPerStep() const {
+    uint64_t updates = 0;
+    uint64_t substeps = 1;
+    for (const auto& level : levels_) {
+        substeps *= static_cast<uint64_t>(config_.ratio);
+        updates += static_cast<uint64_t>(level->field->getTotalPoints()) * substeps;
+    }
+    return updates;
+}
+
+size_t MeshHierarchy::getFieldMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& level : levels_) {
+        bytes += level->field->getMemoryUsage() +
+                 capacityBytes(level->frac_derivs) + capacityBytes(level->second_derivs) +
+                 capacityBytes(level->sources) + capacityBytes(level->boundary_points) +
+                 capacityBytes(level->boundary_taps) + capacityBytes(level->boundary_weights) +
+                 capacityBytes(level->parent_points) + capacityBytes(level->parent_old) +
+                 capacityBytes(level->parent_new) + capacityBytes(level->boundary_values);
+    }
+    return bytes;
+}
+
+size_t MeshHierarchy::getHistoryMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& level : levels_) {
+        bytes += level->solver->getMemoryUsage();
+    }
+    return bytes;
+}
+
+// === Transfer operators ===
+
+void MeshHierarchy::parentStencil(const SymmetryField& parent, const RefinementBox& box, int ratio,
+                                  int a, int b, int c, int taps[8], double weights[8]) {
+    const int fine[3] = {a, b, c};
+    int lo[3];
+    int hi[3];
+    double w[3];
+    for (int axis = 0; axis < 3; axis++) {
+        lo[axis] = box.lo[axis] + fine[axis] / ratio;
+        w[axis] = static_cast<double>(fine[axis] % ratio) / ratio;
+        hi[axis] = w[axis] > 0.0 ? lo[axis] + 1 : lo[axis];
+    }
+    for (int n = 0; n < 8; n++) {
+        const int i = (n & 1) ? hi[0] : lo[0];
+        const int j = (n & 2) ? hi[1] : lo[1];
+        const int k = (n & 4) ? hi[2] : lo[2];
+        taps[n] = parent.toFlatIndex(i, j, k);
+        weights[n] = ((n & 1) ? w[0] : 1.0 - w[0]) *
+                     ((n & 2) ? w[1] : 1.0 - w[1]) *
+                     ((n & 4) ? w[2] : 1.0 - w[2]);
+    }
+}
+
+void MeshHierarchy::restrictInto(const SymmetryField& patch, const SymmetryField& parent,
+                                 const RefinementBox& box, int ratio,
+                                 std::vector<int>& parent_indices,
+                                 std::vector<std::complex<double>>& values) {
+    // Full weighting: (r - |d|)/r² per axis over offsets |d| < r
+    std::vector<double> w(2 * ratio - 1);
+    for (int d = -(ratio - 1); d <= ratio - 1; d++) {
+        w[d + ratio - 1] = static_cast<double>(ratio - std::abs(d)) / (ratio * ratio);
+    }
+    const auto& phi = patch.getDeltaPhiFlat();
+    for (int K = box.lo[2] + 1; K < box.hi[2]; K++) {
+        for (int J = box.lo[1] + 1; J < box.hi[1]; J++) {
+            for (int I = box.lo[0] + 1; I < box.hi[0]; I++) {
+                const int a = ratio * (I - box.lo[0]);
+                const int b = ratio * (J - box.lo[1]);
+                const int c = ratio * (K - box.lo[2]);
+                std::complex<double> sum(0.0, 0.0);
+                for (int dz = -(ratio - 1); dz <= ratio - 1; dz++) {
+                    for (int dy = -(ratio - 1); dy <= ratio - 1; dy++) {
+                        const double wyz = w[dy + ratio - 1] * w[dz + ratio - 1];
+                        const int row = patch.toFlatIndex(a, b + dy, c + dz);
+                        for (int dx = -(ratio - 1); dx <= ratio - 1; dx++) {
+                            sum += (wyz * w[dx + ratio - 1]) * phi[row + dx];
+                        }
+                    }
+                }
+                parent_indices.push_back(parent.toFlatIndex(I, J, K));
+                values.push_back(sum);
+            }
+        }
+    }
+}
+
+// === Regridding ===
+
+RefinementBox MeshHierarchy::boxAround(const SymmetryField& parent, const std::vector<Vector3D>& tags) const {
+    RefinementBox box;
+    for (int axis = 0; axis < 3; axis++) {
+        const int n = extent(parent, axis);
+        double lo_f = 0.5 * (n - 1);
+        double hi_f = lo_f;
+        if (!tags.empty()) {
+            lo_f = hi_f = gridCoordinate(parent, tags.front(), axis);
+            for (const Vector3D& tag : tags) {
+                const double u = gridCoordinate(parent, tag, axis);
+                lo_f = std::min(lo_f, u);
+                hi_f = std::max(hi_f, u);
+            }
+        }
+        // Clamp in floating point first so far off-grid tags cannot overflow
+        const double last = static_cast<double>(n - 1);
+        int lo = static_cast<int>(std::min(std::max(std::floor(lo_f) - config_.margin, 0.0), last));
+        int hi = static_cast<int>(std::min(std::max(std::ceil(hi_f) + config_.margin, 0.0), last));
+        // At least two parent cells, so the patch has an interior
+        while (hi - lo < 2) {
+            if (hi < n - 1) hi++;
+            if (hi - lo < 2 && lo > 0) lo--;
+        }
+        box.lo[axis] = lo;
+        box.hi[axis] = hi;
+    }
+    return box;
+}
+
+bool MeshHierarchy::nearEdge(const SymmetryField& parent, const Level& level,
+                             const std::vector<Vector3D>& tags) const {
+    for (const Vector3D& tag : tags) {
+        for (int axis = 0; axis < 3; axis++) {
+            const double u = gridCoordinate(parent, tag, axis);
+            if ((level.box.lo[axis] > 0 && u < level.box.lo[axis] + config_.regrid_margin) ||
+                (level.box.hi[axis] < extent(parent, axis) - 1 &&
+                 u > level.box.hi[axis] - config_.regrid_margin)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::unique_ptr<MeshHierarchy::Level> MeshHierarchy::buildLevel(
+    const SymmetryField& parent, const FractionalSolver& parent_solver,
+    const RefinementBox& box, const Level* old_level) const
+{
+    const int r = config_.ratio;
+    SymmetryFieldConfig config = parent.getConfig();
+    config.nx = r * (box.hi[0] - box.lo[0]) + 1;
+    config.ny = r * (box.hi[1] - box.lo[1]) + 1;
+    config.nz = r * (box.hi[2] - box.lo[2]) + 1;
+    config.dx /= r;
+    config.dy /= r;
+    config.dz /= r;
+    config.dt /= r;
+    const Vector3D origin = parent.toPosition(box.lo[0], box.lo[1], box.lo[2]);
+    config.origin_x = origin.x;
+    config.origin_y = origin.y;
+    config.origin_z = origin.z;
+    config.k_offset = 0;
+
+    std::unique_ptr<Level> level(new Level());
+    level->box = box;
+    level->field.reset(new SymmetryField(config));
+    const int points = level->field->getTotalPoints();
+    level->solver.reset(new FractionalSolver(parent_solver, points));
+
+    // Offset of this patch in the old patch's indices (both lie on the
+    // level's lattice, so the origins differ by whole fine cells)
+    int shift[3] = {0, 0, 0};
+    if (old_level) {
+        const SymmetryFieldConfig& old = old_level->field->getConfig();
+        shift[0] = static_cast<int>(std::lround((config.origin_x - old.origin_x) / config.dx));
+        shift[1] = static_cast<int>(std::lround((config.origin_y - old.origin_y) / config.dy));
+        shift[2] = static_cast<int>(std::lround((config.origin_z - old.origin_z) / config.dz));
+    }
+
+    // δΦ, α and history: copied where the old patch overlaps, else prolonged
+    const auto& parent_phi = parent.getDeltaPhiFlat();
+    const auto& parent_alpha = parent.getAlphaFlat();
+    std::vector<int> indices(points);
+    std::vector<std::complex<double>> values(points);
+    const double one = 1.0;
+    int taps[8];
+    double weights[8];
+    for (int idx = 0; idx < points; idx++) {
+        int a, b, c;
+        level->field->fromFlatIndex(idx, a, b, c);
+        indices[idx] = idx;
+        const int oa = a + shift[0];
+        const int ob = b + shift[1];
+        const int oc = c + shift[2];
+        if (old_level && oa >= 0 && oa < old_level->field->getNx() &&
+            ob >= 0 && ob < old_level->field->getNy() && oc >= 0 && oc < old_level->field->getNz()) {
+            const int old_idx = old_level->field->toFlatIndex(oa, ob, oc);
+            values[idx] = old_level->field->getDeltaPhiFlat()[old_idx];
+            level->field->setAlpha(a, b, c, old_level->field->getAlphaFlat()[old_idx]);
+            level->solver->setPointHistory(idx, *old_level->solver, &old_idx, &one, 1);
+            continue;
+        }
+        parentStencil(parent, box, r, a, b, c, taps, weights);
+        std::complex<double> phi(0.0, 0.0);
+        double alpha = 0.0;
+        for (int n = 0; n < 8; n++) {
+            phi += weights[n] * parent_phi[taps[n]];
+            alpha += weights[n] * parent_alpha[taps[n]];
+        }
+        values[idx] = phi;
+        level->field->setAlpha(a, b, c, std::min(std::max(alpha, config.alpha_min), config.alpha_max));
+        level->solver->setPointHistory(idx, parent_solver, taps, weights, 8);
+    }
+    level->field->assignDeltaPhi(indices, values.data());
+    level->field->updateGradientCache();
+    level->field->setCurrentTime(parent.getCurrentTime());
+
+    level->solver->setPointAlphas(level->field->getAlphaFlat());
+    level->bound_alpha_revision = level->field->getAlphaRevision();
+    level->parent_alpha_revision = parent.getAlphaRevision();
+    level->solver->computeDerivatives(level->frac_derivs);
+    level->second_derivs.assign(points, std::complex<double>(0.0, 0.0));
+
+    // Boundary layer stencils, reading each parent vertex once
+    std::unordered_map<int, int> slot;
+    const int nx = config.nx;
+    const int ny = config.ny;
+    const int nz = config.nz;
+    for (int idx = 0; idx < points; idx++) {
+        int a, b, c;
+        level->field->fromFlatIndex(idx, a, b, c);
+        if (a != 0 && a != nx - 1 && b != 0 && b != ny - 1 && c != 0 && c != nz - 1) {
+            continue;
+        }
+        parentStencil(parent, box, r, a, b, c, taps, weights);
+        level->boundary_points.push_back(idx);
+        for (int n = 0; n < 8; n++) {
+            auto inserted = slot.emplace(taps[n], static_cast<int>(level->parent_points.size()));
+            if (inserted.second) {
+                level->parent_points.push_back(taps[n]);
+            }
+            level->boundary_taps.push_back(inserted.first->second);
+            level->boundary_weights.push_back(weights[n]);
+        }
+    }
+    level->boundary_values.resize(level->boundary_points.size());
+    gather(parent, level->parent_points, level->parent_old);
+    return level;
+}
+
+void MeshHierarchy::regrid(const SymmetryField& base, const FractionalSolver& base_solver,
+                           const std::vector<Vector3D>& tags) {
+    DASE_TRACE_ZONE("gw.regrid");
+    std::vector<std::unique_ptr<Level>> rebuilt;
+    const SymmetryField* parent = &base;
+    const FractionalSolver* parent_solver = &base_solver;
+    for (int l = 0; l < config_.levels; l++) {
+        const Level* old_level = static_cast<size_t>(l) < levels_.size() ? levels_[l].get() : nullptr;
+        rebuilt.push_back(buildLevel(*parent, *parent_solver, boxAround(*parent, tags), old_level));
+        parent = rebuilt.back()->field.get();
+        parent_solver = rebuilt.back()->solver.get();
+    }
+    levels_.swap(rebuilt);
+    regrid_count_++;
+}
+
+bool MeshHierarchy::regridIfNeeded(const SymmetryField& base, const FractionalSolver& base_solver,
+                                   const std::vector<Vector3D>& tags) {
+    bool needed = static_cast<int>(levels_.size()) != config_.levels;
+    const SymmetryField* parent = &base;
+    for (size_t l = 0; l < levels_.size() && !needed; l++) {
+        needed = nearEdge(*parent, *levels_[l], tags);
+        parent = levels_[l]->field.get();
+    }
+    if (!needed) {
+        return false;
+    }
+    // Rebuild only if some box moves (a tag against a clamped box does not)
+    if (static_cast<int>(levels_.size()) == config_.levels) {
+        bool moved = false;
+        parent = &base;
+        for (size_t l = 0; l < levels_.size() && !moved; l++) {
+            moved = boxAround(*parent, tags) != levels_[l]->box;
+            parent = levels_[l]->field.get();
+        }
+        if (!moved) {
+            return false;
+        }
+    }
+    regrid(base, base_solver, tags);
+    return true;
+}
+
+// === Stepping ===
+
+void MeshHierarchy::refreshAlpha(Level& level, const SymmetryField& parent) const {
+    if (parent.getAlphaRevision() == level.parent_alpha_revision) {
+        return;
+    }
+    const auto& parent_alpha = parent.getAlphaFlat();
+    const SymmetryFieldConfig& config = level.field->getConfig();
+    int taps[8];
+    double weights[8];
+    for (int idx = 0; idx < level.field->getTotalPoints(); idx++) {
+        int a, b, c;
+        level.field->fromFlatIndex(idx, a, b, c);
+        parentStencil(parent, level.box, config_.ratio, a, b, c, taps, weights);
+        double alpha = 0.0;
+        for (int n = 0; n < 8; n++) {
+            alpha += weights[n] * parent_alpha[taps[n]];
+        }
+        level.field->setAlpha(a, b, c, std::min(std::max(alpha, config.alpha_min), config.alpha_max));
+    }
+    level.parent_alpha_revision = parent.getAlphaRevision();
+}
+
+void MeshHierarchy::setBoundary(Level& level, double theta) const {
+    const size_t count = level.boundary_points.size();
+    for (size_t n = 0; n < count; n++) {
+        std::complex<double> value(0.0, 0.0);
+        for (int t = 0; t < 8; t++) {
+            const int p = level.boundary_taps[8 * n + t];
+            value += level.boundary_weights[8 * n + t] *
+                     ((1.0 - theta) * level.parent_old[p] + theta * level.parent_new[p]);
+        }
+        level.boundary_values[n] = value;
+    }
+    level.field->assignDeltaPhi(level.boundary_points, level.boundary_values.data());
+}
+
+void MeshHierarchy::beginStep(const SymmetryField& base) {
+    if (!levels_.empty()) {
+        gather(base, levels_.front()->parent_points, levels_.front()->parent_old);
+    }
+}
+
+void MeshHierarchy::endStep(SymmetryField& base, const SourceFunction& sources) {
+    if (!levels_.empty()) {
+        advanceLevel(0, base, sources);
+    }
+}
+
+void MeshHierarchy::advanceLevel(size_t index, SymmetryField& parent, const SourceFunction& sources) {
+    DASE_TRACE_ZONE("gw.refined_level");
+    Level& level = *levels_[index];
+    Level* child = index + 1 < levels_.size() ? levels_[index + 1].get() : nullptr;
+    const int r = config_.ratio;
+    const double dt = level.field->getTimestep();
+
+    gather(parent, level.parent_points, level.parent_new);
+    refreshAlpha(level, parent);
+
+    for (int s = 0; s < r; s++) {
+        setBoundary(level, static_cast<double>(s) / r);
+        if (child) {
+            gather(*level.field, child->parent_points, child->parent_old);
+        }
+        const double t = level.field->getCurrentTime();
+        sources(*level.field, t, level.sources);
+        if (level.field->getAlphaRevision() != level.bound_alpha_revision) {
+            level.solver->setPointAlphas(level.field->getAlphaFlat());
+            level.bound_alpha_revision = level.field->getAlphaRevision();
+        }
+        level.field->evolveStep(level.frac_derivs, level.sources);
+        level.solver->updateHistoryAndDerivatives(level.second_derivs, dt, level.frac_derivs);
+        level.field->setCurrentTime(t + dt);
+        if (child) {
+            advanceLevel(index + 1, *level.field, sources);
+        }
+    }
+    setBoundary(level, 1.0);
+    level.field->setCurrentTime(parent.getCurrentTime());
+
+    level.restrict_indices.clear();
+    level.restrict_values.clear();
+    restrictInto(*level.field, parent, level.box, r, level.restrict_indices, level.restrict_values);
+    parent.assignDeltaPhi(level.restrict_indices, level.restrict_values.data());
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,209 @@
+/**
+ * IGSOA Gravitational Wave Engine - Block-Structured Mesh Refinement
+ *
+ * Sub-wavelength resolution is only needed near the sources, so instead of
+ * a fine uniform grid the base SymmetryField carries a stack of refined
+ * patches.  Level ℓ (1..levels) is one box of its parent (level ℓ-1, the
+ * base grid for ℓ = 1) refined by `ratio` in space and time: its own
+ * SymmetryField with spacing dx/ratio and timestep dt/ratio, and its own
+ * FractionalSolver, so fractional history is stored per level.
+ *
+ * Boxes are in parent vertex indices and the grids are vertex-centred, so
+ * every parent vertex inside a box is also a patch vertex:
+ *
+ *   parent:  lo         lo+1        lo+2   ...   hi
+ *   patch:   0    1     r     r+1   2r     ...   r·(hi-lo)
+ *
+ * Each level is the bounding box of the tagged points (the BinaryMerger
+ * positions, an echo source) plus `margin` parent cells, clamped to the
+ * parent.  It is rebuilt once a tagged point comes within regrid_margin
+ * cells of an edge: points shared with the old patch keep their δΦ, α and
+ * history, new points are prolonged from the parent (history included, see
+ * FractionalSolver::setPointHistory).
+ *
+ * One parent step advances a level `ratio` substeps (Berger-Oliger time
+ * subcycling, recursively for deeper levels).  The patch's outer vertex
+ * layer is its Dirichlet boundary (evolveStep carries it over): before
+ * every substep it is set from the parent, trilinear in space and linear
+ * in time between the parent's states before and after its step.  After
+ * the substeps the patch is restricted into the parent vertices strictly
+ * inside the box.
+ *
+ * Transfer operators (per axis, ratio r; applied axis by axis in 3D):
+ *
+ *   prolongation  linear interpolation; each parent vertex spreads with
+ *                 weights (r - |d|)/r over fine offsets |d| < r, which sum
+ *                 to r
+ *   restriction   full weighting, the adjoint of prolongation divided by r:
+ *                 weights (r - |d|)/r² (1/4, 1/2, 1/4 for r = 2)
+ *
+ * Both preserve the discrete integral Σ δΦ dV of data supported inside the
+ * box (prolongation because its columns sum to r per axis, restriction
+ * because prolongation's rows sum to one), and both are exact for fields
+ * linear in space.
+ *
+ * Limits: one patch per level (the tags share a bounding box), the base
+ * grid must be whole (no slab decomposition), and sources on a patch hold
+ * the orbit of the parent step's start (the merger advances per base step).
+ */
+
+#pragma once
+
+#include "symmetry_field.h"
+#include "fractional_solver.h"
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+/**
+ * Configuration of the refinement hierarchy
+ */
+struct MeshRefinementConfig {
+    int levels;          // Refined levels above the base grid (0 = none)
+    int ratio;           // Space and time refinement between levels (>= 2)
+    int margin;          // Parent cells between a tagged point and the patch edge
+    int regrid_margin;   // Rebuild once a tagged point is closer than this (< margin)
+
+    MeshRefinementConfig();
+};
+
+/**
+ * Parent vertex box (inclusive) covered by a patch
+ */
+struct RefinementBox {
+    int lo[3];
+    int hi[3];
+
+    RefinementBox() : lo{0, 0, 0}, hi{-1, -1, -1} {}
+    bool operator==(const RefinementBox& other) const;
+    bool operator!=(const RefinementBox& other) const { return !(*this == other); }
+};
+
+class MeshHierarchy {
+public:
+    /**
+     * Source terms of a grid at time t, one per point (resized by the callee)
+     */
+    using SourceFunction = std::function<void(const SymmetryField& field, double t,
+                                              std::vector<std::complex<double>>& out)>;
+
+    /**
+     * @throws std::invalid_argument for an invalid configuration or a
+     *         decomposed base field
+     */
+    MeshHierarchy(const SymmetryField& base, const MeshRefinementConfig& config);
+    ~MeshHierarchy();
+
+    MeshHierarchy(const MeshHierarchy&) = delete;
+    MeshHierarchy& operator=(const MeshHierarchy&) = delete;
+
+    const MeshRefinementConfig& getConfig() const { return config_; }
+
+    /**
+     * Rebuild every level around the tagged points (forced, e.g. after the
+     * base was reset or restored)
+     */
+    void regrid(const SymmetryField& base, const FractionalSolver& base_solver,
+                const std::vector<Vector3D>& tags);
+
+    /**
+     * Rebuild if a tagged point came within regrid_margin of a patch edge
+     * (and the new boxes differ); returns whether it did
+     */
+    bool regridIfNeeded(const SymmetryField& base, const FractionalSolver& base_solver,
+                        const std::vector<Vector3D>& tags);
+
+    /**
+     * Bracket one base step: beginStep before the base evolves (records the
+     * base boundary samples), endStep after it has advanced by its dt
+     * (subcycles every level and restricts back into the base)
+     */
+    void beginStep(const SymmetryField& base);
+    void endStep(SymmetryField& base, const SourceFunction& sources);
+
+    /**
+     * Refined levels built (0 before the first regrid)
+     */
+    int getNumLevels() const { return static_cast<int>(levels_.size()); }
+
+    /**
+     * Field, solver and box of refined level 1..getNumLevels()
+     */
+    const SymmetryField& getLevelField(int level) const;
+    const FractionalSolver& getLevelSolver(int level) const;
+    const RefinementBox& getLevelBox(int level) const;
+
+    /**
+     * Patch point updates per base step: Σ points · ratio^level
+     */
+    uint64_t getPointUpdatesPerStep() const;
+
+    /**
+     * Regrids so far (including the first)
+     */
+    uint64_t getRegridCount() const { return regrid_count_; }
+
+    /**
+     * Bytes held by the patch fields (and their step buffers) and by the
+     * patch histories
+     */
+    size_t getFieldMemoryUsage() const;
+    size_t getHistoryMemoryUsage() const;
+
+    // === Transfer operators (exposed for tests) ===
+
+    /**
+     * Parent vertices and trilinear weights of patch vertex (a, b, c) of a
+     * patch at `box` (8 taps, zero-weight taps repeat a vertex)
+     */
+    static void parentStencil(const SymmetryField& parent, const RefinementBox& box, int ratio,
+                              int a, int b, int c, int taps[8], double weights[8]);
+
+    /**
+     * Full-weighting restriction of `patch` into the parent vertices
+     * strictly inside `box`; indices and values are appended
+     */
+    static void restrictInto(const SymmetryField& patch, const SymmetryField& parent,
+                             const RefinementBox& box, int ratio,
+                             std::vector<int>& parent_indices,
+                             std::vector<std::complex<double>>& values);
+
+private:
+    struct Level;
+
+    MeshRefinementConfig config_;
+    std::vector<std::unique_ptr<Level>> levels_;
+    uint64_t regrid_count_;
+
+    // Helper: box of level `level` around the tags in `parent` indices
+    RefinementBox boxAround(const SymmetryField& parent, const std::vector<Vector3D>& tags) const;
+
+    // Helper: whether a tag is within regrid_margin of an edge of `level`
+    // (edges clamped to the parent boundary do not count)
+    bool nearEdge(const SymmetryField& parent, const Level& level,
+                  const std::vector<Vector3D>& tags) const;
+
+    // Helper: build a level at `box` of `parent`, reusing an old level's
+    // points where the patches overlap
+    std::unique_ptr<Level> buildLevel(const SymmetryField& parent, const FractionalSolver& parent_solver,
+                                      const RefinementBox& box, const Level* old_level) const;
+
+    // Helper: re-prolong α after the parent's changed
+    void refreshAlpha(Level& level, const SymmetryField& parent) const;
+
+    // Helper: set a level's boundary layer at fraction theta of the parent step
+    void setBoundary(Level& level, double theta) const;
+
+    // Helper: advance level index `index` through one step of its parent
+    void advanceLevel(size_t index, SymmetryField& parent, const SourceFunction& sources);
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
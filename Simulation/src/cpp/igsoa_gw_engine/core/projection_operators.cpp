@@ -6,6 +6,11 @@
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <stdexcept>
+
+#ifndef PROJECTION_OMP_MIN_POINTS
+#define PROJECTION_OMP_MIN_POINTS 4096
+#endif
 
 namespace dase {
 namespace igsoa {
@@ -16,12 +21,21 @@ ProjectionConfig::ProjectionConfig()
     , detector_normal(0, 0, -1)      // Looking toward source
     , detector_distance(1e6)
     , gauge(Gauge::TransverseTraceless)
+    , observer_history_capacity(4096)
 {
 }
 
 ProjectionOperators::ProjectionOperators(const ProjectionConfig& config)
     : config_(config)
+    , observer_nx_(0)
+    , observer_ny_(0)
+    , observer_nz_(0)
+    , history_head_(0)
+    , history_count_(0)
 {
+    if (config_.observer_history_capacity == 0) {
+        throw std::invalid_argument("observer_history_capacity must be positive");
+    }
 }
 
 double ProjectionOperators::compute_phi_mode(std::complex<double> delta_phi) const {
@@ -139,6 +153,214 @@ ProjectionOperators::StrainComponents ProjectionOperators::compute_strain_at_obs
     return result;
 }
 
+// ============================================================================
+// Registered Observers
+// ============================================================================
+
+ProjectionOperators::PointStencil ProjectionOperators::makePointStencil(
+    const SymmetryField& field, int i, int j, int k) const
+{
+    const SymmetryFieldConfig& grid = field.getConfig();
+    const int extent[3] = {grid.nx, grid.ny, grid.nz};
+    const int index[3] = {i, j, k};
+    const int stride[3] = {1, grid.nx, grid.nx * grid.ny};
+    const double spacing[3] = {grid.dx, grid.dy, grid.dz};
+
+    PointStencil point;
+    point.idx = field.toFlatIndex(i, j, k);
+    for (int d = 0; d < 3; d++) {
+        AxisStencil& axis = point.axis[d];
+        if (index[d] == 0) {
+            axis.plus = point.idx + stride[d];
+            axis.minus = point.idx;
+            axis.divisor = spacing[d];
+        } else if (index[d] == extent[d] - 1) {
+            axis.plus = point.idx;
+            axis.minus = point.idx - stride[d];
+            axis.divisor = spacing[d];
+        } else {
+            axis.plus = point.idx + stride[d];
+            axis.minus = point.idx - stride[d];
+            axis.divisor = 2.0 * spacing[d];
+        }
+    }
+    return point;
+}
+
+ProjectionOperators::StrainComponents ProjectionOperators::evaluatePointStrain(
+    const PointStencil& point,
+    const std::complex<double>* phi,
+    const double* potential) const
+{
+    // compute_stress_energy_tensor + apply_TT_projection + compute_strain,
+    // reduced to the spatial components the strain reads (same operation
+    // order, so results match the full path exactly)
+    const double gx = std::abs((phi[point.axis[0].plus] - phi[point.axis[0].minus]) / point.axis[0].divisor);
+    const double gy = std::abs((phi[point.axis[1].plus] - phi[point.axis[1].minus]) / point.axis[1].divisor);
+    const double gz = std::abs((phi[point.axis[2].plus] - phi[point.axis[2].minus]) / point.axis[2].divisor);
+
+    const double grad_sq = gx * gx + gy * gy + gz * gz;
+    const double lagrangian = grad_sq - potential[point.idx];
+
+    const double O_xx = gx * gx - lagrangian / 3.0;
+    const double O_yy = gy * gy - lagrangian / 3.0;
+    const double O_zz = gz * gz - lagrangian / 3.0;
+    const double trace = O_xx + O_yy + O_zz;
+
+    StrainComponents strain;
+    strain.h_plus = (O_xx - trace / 3.0) - (O_yy - trace / 3.0);
+    strain.h_cross = 2.0 * (gx * gy);
+    strain.amplitude = std::sqrt(strain.h_plus * strain.h_plus + strain.h_cross * strain.h_cross);
+    strain.phase = std::atan2(strain.h_cross, strain.h_plus);
+    return strain;
+}
+
+int ProjectionOperators::registerObserver(const SymmetryField& field,
+                                          const Vector3D& position,
+                                          ObserverSampling sampling)
+{
+    const SymmetryFieldConfig& grid = field.getConfig();
+    if (grid.nx < 2 || grid.ny < 2 || grid.nz < 2) {
+        throw std::invalid_argument("Registered observers need at least 2 points along each axis");
+    }
+    if (!observers_.empty() &&
+        (grid.nx != observer_nx_ || grid.ny != observer_ny_ || grid.nz != observer_nz_)) {
+        throw std::invalid_argument("All observers must be registered on the same grid");
+    }
+
+    RegisteredObserver observer;
+    observer.first_point = static_cast<int>(observer_points_.size());
+
+    if (sampling == ObserverSampling::NearestPoint) {
+        // Same point selection as compute_strain_at_observer
+        int i, j, k;
+        field.toIndices(position, i, j, k);
+        i = std::max(0, std::min(i, grid.nx - 1));
+        j = std::max(0, std::min(j, grid.ny - 1));
+        k = std::max(0, std::min(k, grid.nz - 1));
+
+        observer.num_points = 1;
+        observer.weights[0] = 1.0;
+        observer_points_.push_back(makePointStencil(field, i, j, k));
+    } else {
+        // Cell and weights as in SymmetryField::interpolateDeltaPhi
+        const double fx = position.x / grid.dx;
+        const double fy = position.y / grid.dy;
+        const double fz = position.z / grid.dz - grid.k_offset;
+        const int i0 = static_cast<int>(std::floor(fx));
+        const int j0 = static_cast<int>(std::floor(fy));
+        const int k0 = static_cast<int>(std::floor(fz));
+        if (i0 < 0 || i0 + 1 >= grid.nx ||
+            j0 < 0 || j0 + 1 >= grid.ny ||
+            k0 < 0 || k0 + 1 >= grid.nz) {
+            throw std::invalid_argument("Trilinear observer position lies outside the grid");
+        }
+
+        const double wx[2] = {1.0 - (fx - i0), fx - i0};
+        const double wy[2] = {1.0 - (fy - j0), fy - j0};
+        const double wz[2] = {1.0 - (fz - k0), fz - k0};
+
+        observer.num_points = 8;
+        int corner = 0;
+        for (int di = 0; di < 2; di++) {
+            for (int dj = 0; dj < 2; dj++) {
+                for (int dk = 0; dk < 2; dk++) {
+                    observer.weights[corner++] = wx[di] * wy[dj] * wz[dk];
+                    observer_points_.push_back(makePointStencil(field, i0 + di, j0 + dj, k0 + dk));
+                }
+            }
+        }
+    }
+
+    observer_nx_ = grid.nx;
+    observer_ny_ = grid.ny;
+    observer_nz_ = grid.nz;
+    observers_.push_back(observer);
+    resetObserverHistory();
+    return static_cast<int>(observers_.size()) - 1;
+}
+
+void ProjectionOperators::clearObservers() {
+    observers_.clear();
+    observer_points_.clear();
+    observer_nx_ = observer_ny_ = observer_nz_ = 0;
+    resetObserverHistory();
+}
+
+void ProjectionOperators::resetObserverHistory() {
+    history_.assign(config_.observer_history_capacity * observers_.size(), StrainSample());
+    history_head_ = 0;
+    history_count_ = 0;
+}
+
+void ProjectionOperators::sampleObservers(const SymmetryField& field) {
+    if (observers_.empty()) {
+        return;
+    }
+    if (field.getNx() != observer_nx_ || field.getNy() != observer_ny_ ||
+        field.getNz() != observer_nz_) {
+        throw std::invalid_argument("Field grid differs from the one observers were registered on");
+    }
+
+    const std::complex<double>* phi = field.getDeltaPhiFlat().data();
+    const double* potential = field.getPotentialFlat().data();
+    const double time = field.getCurrentTime();
+    StrainSample* slot = &history_[history_head_ * observers_.size()];
+
+    for (size_t n = 0; n < observers_.size(); n++) {
+        const RegisteredObserver& observer = observers_[n];
+        const PointStencil* points = &observer_points_[observer.first_point];
+
+        StrainComponents strain;
+        if (observer.num_points == 1) {
+            strain = evaluatePointStrain(points[0], phi, potential);
+        } else {
+            double h_plus = 0.0;
+            double h_cross = 0.0;
+            for (int c = 0; c < observer.num_points; c++) {
+                const StrainComponents corner = evaluatePointStrain(points[c], phi, potential);
+                h_plus += observer.weights[c] * corner.h_plus;
+                h_cross += observer.weights[c] * corner.h_cross;
+            }
+            strain.h_plus = h_plus;
+            strain.h_cross = h_cross;
+            strain.amplitude = std::sqrt(h_plus * h_plus + h_cross * h_cross);
+            strain.phase = std::atan2(h_cross, h_plus);
+        }
+
+        slot[n].time = time;
+        slot[n].strain = strain;
+    }
+
+    history_head_ = (history_head_ + 1) % config_.observer_history_capacity;
+    history_count_ = std::min(history_count_ + 1, config_.observer_history_capacity);
+}
+
+const ProjectionOperators::StrainSample& ProjectionOperators::getObserverSample(
+    int observer, size_t age) const
+{
+    if (observer < 0 || observer >= getObserverCount()) {
+        throw std::out_of_range("Observer id out of range");
+    }
+    if (age >= history_count_) {
+        throw std::out_of_range("Observer sample not recorded");
+    }
+    const size_t capacity = config_.observer_history_capacity;
+    const size_t slot = (history_head_ + capacity - 1 - age) % capacity;
+    return history_[slot * observers_.size() + observer];
+}
+
+void ProjectionOperators::copyObserverHistory(int observer, std::vector<StrainSample>& out) const {
+    if (observer < 0 || observer >= getObserverCount()) {
+        throw std::out_of_range("Observer id out of range");
+    }
+    out.clear();
+    out.reserve(history_count_);
+    for (size_t age = history_count_; age-- > 0; ) {
+        out.push_back(getObserverSample(observer, age));
+    }
+}
+
 ProjectionOperators::CausalFlowVector ProjectionOperators::compute_causal_flow(
     const SymmetryField& field, int i, int j, int k) const
 {
@@ -179,6 +401,111 @@ ProjectionOperators::CausalFlowVector ProjectionOperators::compute_causal_flow(
     return B_vec;
 }
 
+void ProjectionOperators::compute_projection_fields(
+    const SymmetryField& field, unsigned components, ProjectionFields& out) const
+{
+    const SymmetryFieldConfig& grid = field.getConfig();
+    if (grid.nx < 2 || grid.ny < 2 || grid.nz < 2) {
+        throw std::invalid_argument("Field projections need at least 2 points along each axis");
+    }
+    const size_t total = static_cast<size_t>(field.getTotalPoints());
+
+    out.components = components;
+    const auto prepare = [&](std::vector<double>& values, unsigned flag) -> double* {
+        if (!(components & flag)) {
+            std::vector<double>().swap(values);
+            return nullptr;
+        }
+        values.resize(total);
+        return values.data();
+    };
+    double* const O00 = prepare(out.O00, FIELD_O00);
+    double* const O11 = prepare(out.O11, FIELD_O11);
+    double* const O22 = prepare(out.O22, FIELD_O22);
+    double* const O33 = prepare(out.O33, FIELD_O33);
+    double* const O12 = prepare(out.O12, FIELD_O12);
+    double* const O13 = prepare(out.O13, FIELD_O13);
+    double* const O23 = prepare(out.O23, FIELD_O23);
+    double* const B1 = prepare(out.B1, FIELD_B1);
+    double* const B2 = prepare(out.B2, FIELD_B2);
+    double* const B3 = prepare(out.B3, FIELD_B3);
+    double* const B_magnitude = prepare(out.B_magnitude, FIELD_B_MAGNITUDE);
+    double* const h_plus = prepare(out.h_plus, FIELD_H_PLUS);
+    double* const h_cross = prepare(out.h_cross, FIELD_H_CROSS);
+    const bool want_causal = (components & FIELD_B_ALL) != 0;
+
+    const std::complex<double>* phi = field.getDeltaPhiFlat().data();
+    const double* potential = field.getPotentialFlat().data();
+    const int nx = grid.nx;
+    const int ny = grid.ny;
+    const int nz = grid.nz;
+    const int plane = nx * ny;
+
+    // Same differences as SymmetryField::computeGradient (one-sided at the
+    // boundaries); y / z offsets are fixed per row, x per point
+    #pragma omp parallel for schedule(static) if(total >= PROJECTION_OMP_MIN_POINTS)
+    for (int k = 0; k < nz; k++) {
+        const int z_plus = (k == nz - 1) ? 0 : plane;
+        const int z_minus = (k == 0) ? 0 : plane;
+        const double z_div = (k == 0 || k == nz - 1) ? grid.dz : 2.0 * grid.dz;
+
+        for (int j = 0; j < ny; j++) {
+            const int y_plus = (j == ny - 1) ? 0 : nx;
+            const int y_minus = (j == 0) ? 0 : nx;
+            const double y_div = (j == 0 || j == ny - 1) ? grid.dy : 2.0 * grid.dy;
+            const int row = k * plane + j * nx;
+
+            for (int i = 0; i < nx; i++) {
+                const int idx = row + i;
+                const int x_plus = (i == nx - 1) ? 0 : 1;
+                const int x_minus = (i == 0) ? 0 : 1;
+                const double x_div = (i == 0 || i == nx - 1) ? grid.dx : 2.0 * grid.dx;
+
+                const double gx = std::abs((phi[idx + x_plus] - phi[idx - x_minus]) / x_div);
+                const double gy = std::abs((phi[idx + y_plus] - phi[idx - y_minus]) / y_div);
+                const double gz = std::abs((phi[idx + z_plus] - phi[idx - z_minus]) / z_div);
+                const double grad_sq = gx * gx + gy * gy + gz * gz;
+                const double V = potential[idx];
+                const double lagrangian = grad_sq - V;
+
+                // compute_stress_energy_tensor
+                const double O_xx = gx * gx - lagrangian / 3.0;
+                const double O_yy = gy * gy - lagrangian / 3.0;
+                if (O00) O00[idx] = std::norm(phi[idx]) + grad_sq + V;
+                if (O11) O11[idx] = O_xx;
+                if (O22) O22[idx] = O_yy;
+                if (O33) O33[idx] = gz * gz - lagrangian / 3.0;
+                if (O12) O12[idx] = gx * gy;
+                if (O13) O13[idx] = gx * gz;
+                if (O23) O23[idx] = gy * gz;
+
+                // compute_strain (the traceless part of the spatial block)
+                if (h_plus) {
+                    const double O_zz = gz * gz - lagrangian / 3.0;
+                    const double trace = O_xx + O_yy + O_zz;
+                    h_plus[idx] = (O_xx - trace / 3.0) - (O_yy - trace / 3.0);
+                }
+                if (h_cross) h_cross[idx] = 2.0 * (gx * gy);
+
+                // compute_causal_flow
+                if (want_causal) {
+                    const double phi_norm_sq = std::norm(phi[idx]);
+                    double b1 = 0.0, b2 = 0.0, b3 = 0.0;
+                    if (phi_norm_sq > 1e-20) {
+                        b1 = gx / std::sqrt(phi_norm_sq);
+                        b2 = gy / std::sqrt(phi_norm_sq);
+                        b3 = gz / std::sqrt(phi_norm_sq);
+                    }
+                    if (B1) B1[idx] = b1;
+                    if (B2) B2[idx] = b2;
+                    if (B3) B3[idx] = b3;
+                    if (B_magnitude) B_magnitude[idx] = std::sqrt(b1 * b1 + b2 * b2 + b3 * b3);
+                }
+            }
+        }
+    }
+}
+
 ProjectionOperators::FullProjection ProjectionOperators::compute_full_projection(
     const SymmetryField& field, int i, int j, int k) const
 {
@@ -7,12 +7,24 @@
  * - B_μ-mode: Causal exchange flow
  *
  * The gravitational wave strain h(t) is extracted from O_μν.
+ *
+ * For waveform-only runs, detectors can be registered once with
+ * registerObserver(); sampleObservers() then evaluates the strain from
+ * precomputed stencils at just those points and appends it to a
+ * fixed-capacity ring buffer per detector.
+ *
+ * For whole-field diagnostics, compute_projection_fields() evaluates the
+ * requested O_μν / B_μ / strain components at every grid point in one
+ * parallel sweep over the flat field storage, writing one array per
+ * component.
  */
 
 #pragma once
 
 #include "symmetry_field.h"
 #include <complex>
+#include <cstddef>
+#include <vector>
 
 namespace dase {
 namespace igsoa {
@@ -35,6 +47,9 @@ struct ProjectionConfig {
     };
     Gauge gauge;
 
+    // Samples kept per registered observer (oldest are overwritten)
+    size_t observer_history_capacity;
+
     ProjectionConfig();
 };
 
@@ -92,6 +107,67 @@ public:
         const SymmetryField& field
     ) const;
 
+    // === Registered Observers ===
+
+    /**
+     * How a registered observer samples the grid
+     */
+    enum class ObserverSampling {
+        NearestPoint,  // Same point as compute_strain_at_observer
+        Trilinear      // Strain interpolated from the 8 surrounding points
+    };
+
+    struct StrainSample {
+        double time;
+        StrainComponents strain;
+    };
+
+    /**
+     * Register a detector location on the field's grid
+     *
+     * Stencil indices, divisors and interpolation weights are fixed here;
+     * the field must keep the same grid for later sampleObservers() calls.
+     * Registering clears any recorded history.
+     *
+     * @return Observer id (registration order)
+     * @throws std::invalid_argument if a grid extent is below 2, or a
+     *         Trilinear position lies outside the grid
+     */
+    int registerObserver(const SymmetryField& field,
+                         const Vector3D& position,
+                         ObserverSampling sampling = ObserverSampling::NearestPoint);
+
+    /**
+     * Remove all registered observers and their history
+     */
+    void clearObservers();
+
+    /**
+     * Evaluate every registered observer on the current field state and
+     * record one sample each, stamped with field.getCurrentTime().
+     * Uses the field's gradient stencil and cached potential.
+     *
+     * @throws std::invalid_argument if the grid differs from registration
+     */
+    void sampleObservers(const SymmetryField& field);
+
+    int getObserverCount() const { return static_cast<int>(observers_.size()); }
+
+    /**
+     * Samples currently held per observer (<= observer_history_capacity)
+     */
+    size_t getObserverSampleCount() const { return history_count_; }
+
+    /**
+     * Recorded sample, age 0 being the most recent
+     */
+    const StrainSample& getObserverSample(int observer, size_t age) const;
+
+    /**
+     * Copy an observer's history, oldest first
+     */
+    void copyObserverHistory(int observer, std::vector<StrainSample>& out) const;
+
     // === B_μ-mode: Causal Exchange ===
 
     /**
@@ -107,6 +183,57 @@ public:
         int i, int j, int k
     ) const;
 
+    // === Field-wide Projections ===
+
+    /**
+     * Components compute_projection_fields can fill (bit flags).  O_0i and
+     * B_0 are constant (0 and 1) and have no array.
+     */
+    enum FieldComponent : unsigned {
+        FIELD_O00 = 1u << 0,
+        FIELD_O11 = 1u << 1,
+        FIELD_O22 = 1u << 2,
+        FIELD_O33 = 1u << 3,
+        FIELD_O12 = 1u << 4,
+        FIELD_O13 = 1u << 5,
+        FIELD_O23 = 1u << 6,
+        FIELD_B1 = 1u << 7,
+        FIELD_B2 = 1u << 8,
+        FIELD_B3 = 1u << 9,
+        FIELD_B_MAGNITUDE = 1u << 10,
+        FIELD_H_PLUS = 1u << 11,
+        FIELD_H_CROSS = 1u << 12,
+
+        FIELD_O_SPATIAL = FIELD_O11 | FIELD_O22 | FIELD_O33 | FIELD_O12 | FIELD_O13 | FIELD_O23,
+        FIELD_O_ALL = FIELD_O00 | FIELD_O_SPATIAL,
+        FIELD_B_ALL = FIELD_B1 | FIELD_B2 | FIELD_B3 | FIELD_B_MAGNITUDE,
+        FIELD_STRAIN = FIELD_H_PLUS | FIELD_H_CROSS
+    };
+
+    /**
+     * Per-point components, indexed like the field's flat storage.  Arrays
+     * of components not requested are left empty.
+     */
+    struct ProjectionFields {
+        unsigned components = 0;
+        std::vector<double> O00, O11, O22, O33, O12, O13, O23;
+        std::vector<double> B1, B2, B3, B_magnitude;
+        std::vector<double> h_plus, h_cross;
+    };
+
+    /**
+     * Evaluate the requested components over the whole field.  Values equal
+     * compute_stress_energy_tensor / compute_causal_flow / compute_strain at
+     * each point; the gradient is taken once per point from the flat δΦ
+     * storage and V(δΦ) is read from the potential cache.
+     *
+     * @param components FieldComponent flags
+     * @throws std::invalid_argument if a grid extent is below 2
+     */
+    void compute_projection_fields(const SymmetryField& field,
+                                   unsigned components,
+                                   ProjectionFields& out) const;
+
     // === Combined Projection ===
 
     /**
@@ -141,6 +268,40 @@ public:
 private:
     ProjectionConfig config_;
 
+    // One-axis derivative: (phi[plus] - phi[minus]) / divisor, matching
+    // SymmetryField::computeGradient including its one-sided boundaries
+    struct AxisStencil {
+        int plus;
+        int minus;
+        double divisor;
+    };
+
+    struct PointStencil {
+        int idx;
+        AxisStencil axis[3];
+    };
+
+    struct RegisteredObserver {
+        int first_point;          // Into observer_points_
+        int num_points;           // 1 (nearest) or 8 (trilinear)
+        double weights[8];
+    };
+
+    std::vector<RegisteredObserver> observers_;
+    std::vector<PointStencil> observer_points_;
+    int observer_nx_, observer_ny_, observer_nz_;
+
+    // Ring buffer, slot-major: history_[slot * observers + observer]
+    std::vector<StrainSample> history_;
+    size_t history_head_;     // Next slot to write
+    size_t history_count_;
+
+    PointStencil makePointStencil(const SymmetryField& field, int i, int j, int k) const;
+    StrainComponents evaluatePointStrain(const PointStencil& point,
+                                         const std::complex<double>* phi,
+                                         const double* potential) const;
+    void resetObserverHistory();
+
     // Helper: metric tensor g_μν (Minkowski for now)
     double metric(int mu, int nu) const;
 };
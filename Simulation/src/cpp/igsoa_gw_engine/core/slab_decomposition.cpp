@@ -0,0 +1,128 @@
+/**
+ * IGSOA Gravitational Wave Engine - Slab Domain Decomposition Implementation
+ */
+
+#include "slab_decomposition.h"
+#include "utils/logger.h"
+#include <stdexcept>
+#include <string>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+SlabDecomposition::SlabDecomposition(int global_nz)
+    : global_nz_(global_nz)
+    , rank_(0)
+    , num_ranks_(1)
+    , owned_begin_(0)
+    , owned_end_(0)
+    , lower_ghosts_(0)
+    , upper_ghosts_(0)
+#ifdef IGSOA_GW_USE_MPI
+    , comm_(MPI_COMM_SELF)
+#endif
+{
+    assignSlab();
+}
+
+#ifdef IGSOA_GW_USE_MPI
+SlabDecomposition::SlabDecomposition(int global_nz, MPI_Comm comm)
+    : global_nz_(global_nz)
+    , rank_(0)
+    , num_ranks_(1)
+    , owned_begin_(0)
+    , owned_end_(0)
+    , lower_ghosts_(0)
+    , upper_ghosts_(0)
+    , comm_(comm)
+{
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &num_ranks_);
+    assignSlab();
+}
+#endif
+
+void SlabDecomposition::assignSlab() {
+    if (global_nz_ <= 0 || global_nz_ < num_ranks_) {
+        std::string error_msg = "Slab decomposition needs at least one z-plane per rank, got nz=" +
+                               std::to_string(global_nz_) + " for " +
+                               std::to_string(num_ranks_) + " ranks";
+        LOG_ERROR(error_msg);
+        throw std::invalid_argument(error_msg);
+    }
+
+    // Balanced split: the first (nz % ranks) ranks take one extra plane
+    const int base = global_nz_ / num_ranks_;
+    const int extra = global_nz_ % num_ranks_;
+    owned_begin_ = rank_ * base + (rank_ < extra ? rank_ : extra);
+    owned_end_ = owned_begin_ + base + (rank_ < extra ? 1 : 0);
+
+    lower_ghosts_ = (rank_ > 0) ? 1 : 0;
+    upper_ghosts_ = (rank_ < num_ranks_ - 1) ? 1 : 0;
+}
+
+SymmetryFieldConfig SlabDecomposition::makeLocalConfig(const SymmetryFieldConfig& global) const {
+    if (global.nz != global_nz_ || global.k_offset != 0) {
+        throw std::invalid_argument("makeLocalConfig expects the global grid configuration");
+    }
+    SymmetryFieldConfig local = global;
+    local.nz = getLocalNz();
+    local.k_offset = getLocalOffset();
+    return local;
+}
+
+void SlabDecomposition::exchangeHalos(std::complex<double>* data, int plane_size) const {
+#ifdef IGSOA_GW_USE_MPI
+    if (num_ranks_ == 1) {
+        return;
+    }
+
+    const int local_nz = getLocalNz();
+    const int count = 2 * plane_size;  // Re/Im as doubles
+    const int below = lower_ghosts_ ? rank_ - 1 : MPI_PROC_NULL;
+    const int above = upper_ghosts_ ? rank_ + 1 : MPI_PROC_NULL;
+    double* planes = reinterpret_cast<double*>(data);
+
+    // Upward: top owned plane -> neighbour's lower ghost
+    MPI_Sendrecv(planes + static_cast<size_t>(local_nz - 1 - upper_ghosts_) * count, count,
+                 MPI_DOUBLE, above, 0,
+                 planes, count, MPI_DOUBLE, below, 0,
+                 comm_, MPI_STATUS_IGNORE);
+
+    // Downward: bottom owned plane -> neighbour's upper ghost
+    MPI_Sendrecv(planes + static_cast<size_t>(lower_ghosts_) * count, count,
+                 MPI_DOUBLE, below, 1,
+                 planes + static_cast<size_t>(local_nz - 1) * count, count, MPI_DOUBLE, above, 1,
+                 comm_, MPI_STATUS_IGNORE);
+#else
+    (void)data;
+    (void)plane_size;
+#endif
+}
+
+double SlabDecomposition::sum(double local_value) const {
+#ifdef IGSOA_GW_USE_MPI
+    if (num_ranks_ > 1) {
+        double global_value = 0.0;
+        MPI_Allreduce(&local_value, &global_value, 1, MPI_DOUBLE, MPI_SUM, comm_);
+        return global_value;
+    }
+#endif
+    return local_value;
+}
+
+double SlabDecomposition::max(double local_value) const {
+#ifdef IGSOA_GW_USE_MPI
+    if (num_ranks_ > 1) {
+        double global_value = 0.0;
+        MPI_Allreduce(&local_value, &global_value, 1, MPI_DOUBLE, MPI_MAX, comm_);
+        return global_value;
+    }
+#endif
+    return local_value;
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
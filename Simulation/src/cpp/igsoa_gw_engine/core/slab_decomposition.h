@@ -0,0 +1,112 @@
+/**
+ * IGSOA Gravitational Wave Engine - Slab Domain Decomposition
+ *
+ * Splits the global grid into contiguous z-slabs, one per MPI rank.  Flat
+ * storage is k-slowest, so a slab is one contiguous block of every field
+ * array.  Each rank's local SymmetryField holds its owned planes plus one
+ * ghost (halo) plane towards each neighbouring rank:
+ *
+ *   global k:   [ owned_begin - 1 | owned_begin ... owned_end - 1 | owned_end ]
+ *   local k:    [ 0 (ghost)       | 1 ...                         | nz-1 (ghost) ]
+ *
+ * Ghost planes sit on the local field's z-boundary, which evolveStep never
+ * advances, and are refreshed from the neighbours after every step.  The
+ * true global boundary planes are ordinary owned planes of the first and
+ * last rank, so local updates reproduce the global stencil exactly.
+ *
+ * Everything sized from the local field (FractionalSolver history, source
+ * buffers) is therefore per-slab.  Build with IGSOA_GW_USE_MPI (CMake
+ * ENABLE_MPI) for the MPI constructor; without it only the single-rank
+ * decomposition exists and all exchanges are no-ops.
+ */
+
+#pragma once
+
+#include "symmetry_field.h"
+#include <complex>
+
+#ifdef IGSOA_GW_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+class SlabDecomposition {
+public:
+    /**
+     * Single-rank decomposition (the whole grid is local)
+     * @param global_nz Number of z-planes in the global grid
+     */
+    explicit SlabDecomposition(int global_nz);
+
+#ifdef IGSOA_GW_USE_MPI
+    /**
+     * Distribute global_nz planes over the ranks of comm (balanced to
+     * within one plane).  Requires global_nz >= number of ranks.
+     */
+    SlabDecomposition(int global_nz, MPI_Comm comm);
+#endif
+
+    int getRank() const { return rank_; }
+    int getNumRanks() const { return num_ranks_; }
+    int getGlobalNz() const { return global_nz_; }
+
+    /**
+     * Owned global planes [begin, end)
+     */
+    int getOwnedBegin() const { return owned_begin_; }
+    int getOwnedEnd() const { return owned_end_; }
+
+    /**
+     * Ghost planes below/above the owned range (0 or 1)
+     */
+    int getLowerGhosts() const { return lower_ghosts_; }
+    int getUpperGhosts() const { return upper_ghosts_; }
+
+    /**
+     * Local grid: global index of local plane 0 and number of local planes
+     */
+    int getLocalOffset() const { return owned_begin_ - lower_ghosts_; }
+    int getLocalNz() const { return owned_end_ - owned_begin_ + lower_ghosts_ + upper_ghosts_; }
+
+    /**
+     * Local field configuration for this rank (nz and k_offset replaced)
+     * @param global Configuration of the whole grid
+     */
+    SymmetryFieldConfig makeLocalConfig(const SymmetryFieldConfig& global) const;
+
+    /**
+     * Collective: send owned edge planes to the neighbours and receive the
+     * ghost planes of a local plane-major array
+     * @param data Local array of getLocalNz() planes
+     * @param plane_size Points per z-plane (nx * ny)
+     */
+    void exchangeHalos(std::complex<double>* data, int plane_size) const;
+
+    /**
+     * Collective reductions over all ranks
+     */
+    double sum(double local_value) const;
+    double max(double local_value) const;
+
+private:
+    int global_nz_;
+    int rank_;
+    int num_ranks_;
+    int owned_begin_;
+    int owned_end_;
+    int lower_ghosts_;
+    int upper_ghosts_;
+
+#ifdef IGSOA_GW_USE_MPI
+    MPI_Comm comm_;
+#endif
+
+    void assignSlab();
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
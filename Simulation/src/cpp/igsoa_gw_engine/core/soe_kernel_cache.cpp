@@ -0,0 +1,156 @@
+/**
+ * IGSOA Gravitational Wave Engine - Fitted SOE Kernel Cache Implementation
+ */
+
+#include "soe_kernel_cache.h"
+#include "utils/logger.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+namespace {
+
+const char kCacheHeader[] = "# IGSOA SOE kernel cache v1";
+
+// Parse the next double of a line; hex floats are accepted by strtod
+bool nextDouble(const char*& cursor, double& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtod(cursor, &end);
+    if (end == cursor || errno == ERANGE) {
+        return false;
+    }
+    cursor = end;
+    return true;
+}
+
+} // namespace
+
+SOEKernelCache::SOEKernelCache(const std::string& path)
+    : path_(path)
+    , dirty_(false)
+{
+    load();
+}
+
+void SOEKernelCache::load() {
+    std::ifstream file(path_);
+    if (!file) {
+        return;
+    }
+
+    std::string line;
+    int skipped = 0;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        const char* cursor = line.c_str();
+        Key key;
+        double rank_value = 0.0;
+        bool ok = nextDouble(cursor, key[0]) && nextDouble(cursor, key[1]) &&
+                  nextDouble(cursor, key[2]) && nextDouble(cursor, key[3]) &&
+                  nextDouble(cursor, rank_value) &&
+                  rank_value >= 0.0 && rank_value <= 4096.0 &&
+                  rank_value == static_cast<int>(rank_value);
+
+        Entry entry;
+        if (ok) {
+            const int rank = static_cast<int>(rank_value);
+            entry.weights.resize(rank);
+            entry.exponents.resize(rank);
+            for (int r = 0; ok && r < rank; r++) {
+                ok = nextDouble(cursor, entry.weights[r]);
+            }
+            for (int r = 0; ok && r < rank; r++) {
+                ok = nextDouble(cursor, entry.exponents[r]);
+            }
+        }
+        if (!ok) {
+            skipped++;
+            continue;
+        }
+        entries_[key] = std::move(entry);
+    }
+
+    if (skipped > 0) {
+        LOG_WARNING("Skipped " + std::to_string(skipped) + " malformed line(s) in SOE kernel cache " +
+                    path_);
+    }
+    LOG_DEBUG("Loaded " + std::to_string(entries_.size()) + " SOE kernel(s) from " + path_);
+}
+
+bool SOEKernelCache::lookup(double alpha, double T_max, double t_min, double tolerance,
+                            SOEKernel& kernel) const
+{
+    auto it = entries_.find(Key{alpha, T_max, t_min, tolerance});
+    if (it == entries_.end()) {
+        return false;
+    }
+    kernel.rank = static_cast<int>(it->second.weights.size());
+    kernel.weights = it->second.weights;
+    kernel.exponents = it->second.exponents;
+    kernel.decay.clear();
+    kernel.decay_dt = std::numeric_limits<double>::quiet_NaN();
+    return true;
+}
+
+void SOEKernelCache::store(double alpha, double T_max, double t_min, double tolerance,
+                           const SOEKernel& kernel)
+{
+    Entry& entry = entries_[Key{alpha, T_max, t_min, tolerance}];
+    entry.weights.assign(kernel.weights.begin(), kernel.weights.begin() + kernel.rank);
+    entry.exponents.assign(kernel.exponents.begin(), kernel.exponents.begin() + kernel.rank);
+    dirty_ = true;
+}
+
+void SOEKernelCache::save() const {
+    const std::string tmp_path = path_ + ".tmp";
+    std::FILE* file = std::fopen(tmp_path.c_str(), "w");
+    if (!file) {
+        throw std::runtime_error("Cannot open SOE kernel cache for writing: " + tmp_path);
+    }
+
+    bool ok = std::fprintf(file, "%s\n", kCacheHeader) > 0;
+    for (const auto& item : entries_) {
+        const Key& key = item.first;
+        const Entry& entry = item.second;
+        ok = ok && std::fprintf(file, "%a %a %a %a %d", key[0], key[1], key[2], key[3],
+                                static_cast<int>(entry.weights.size())) > 0;
+        for (double w : entry.weights) {
+            ok = ok && std::fprintf(file, " %a", w) > 0;
+        }
+        for (double s : entry.exponents) {
+            ok = ok && std::fprintf(file, " %a", s) > 0;
+        }
+        ok = ok && std::fputc('\n', file) != EOF;
+    }
+    ok = (std::fclose(file) == 0) && ok;
+
+    if (ok) {
+        // rename() does not replace an existing file on every platform
+        if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+            std::remove(path_.c_str());
+            ok = std::rename(tmp_path.c_str(), path_.c_str()) == 0;
+        }
+    }
+    if (!ok) {
+        std::remove(tmp_path.c_str());
+        throw std::runtime_error("Failed writing SOE kernel cache: " + path_);
+    }
+
+    dirty_ = false;
+    LOG_DEBUG("Saved " + std::to_string(entries_.size()) + " SOE kernel(s) to " + path_);
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
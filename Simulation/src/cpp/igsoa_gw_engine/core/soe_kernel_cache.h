@@ -0,0 +1,77 @@
+/**
+ * IGSOA Gravitational Wave Engine - Fitted SOE Kernel Cache
+ *
+ * Persists SOEKernel::fit results so the fit runs once per host, in the
+ * spirit of FFTWWisdomCache.  Entries are keyed by (α, T_max, t_min,
+ * tolerance) and stored as text, one kernel per line, with every double
+ * written as a hex float so a reloaded kernel is bit-identical:
+ *
+ *   alpha T_max t_min tolerance rank w_0 ... w_{R-1} s_0 ... s_{R-1}
+ *
+ * Lines starting with '#' are comments; malformed lines are skipped.
+ */
+
+#pragma once
+
+#include "fractional_solver.h"
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+class SOEKernelCache {
+public:
+    /**
+     * Load the cache file at path (a missing file gives an empty cache)
+     */
+    explicit SOEKernelCache(const std::string& path);
+
+    /**
+     * Copy a cached kernel into kernel
+     * @return false if no entry has exactly this key
+     */
+    bool lookup(double alpha, double T_max, double t_min, double tolerance,
+                SOEKernel& kernel) const;
+
+    /**
+     * Add or replace an entry (kept in memory until save())
+     */
+    void store(double alpha, double T_max, double t_min, double tolerance,
+               const SOEKernel& kernel);
+
+    /**
+     * Write all entries (to a temporary file, then renamed over path)
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save() const;
+
+    size_t size() const { return entries_.size(); }
+
+    /**
+     * True if store() was called since loading or the last save()
+     */
+    bool isDirty() const { return dirty_; }
+
+    const std::string& getPath() const { return path_; }
+
+private:
+    using Key = std::array<double, 4>;
+    struct Entry {
+        std::vector<double> weights;
+        std::vector<double> exponents;
+    };
+
+    std::string path_;
+    std::map<Key, Entry> entries_;
+    mutable bool dirty_;
+
+    void load();
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
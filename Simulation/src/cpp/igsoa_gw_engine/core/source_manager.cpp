@@ -5,8 +5,12 @@
 #define _USE_MATH_DEFINES  // Enable M_PI on MSVC
 #include <cmath>
 #include "source_manager.h"
+#include "engine_checkpoint.h"
+#include "trace_zones.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <stdexcept>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -35,6 +39,9 @@ BinaryMerger::BinaryMerger(const BinaryMergerConfig& config)
     , merger_radius_(0.0)
     , total_energy_radiated_(0.0)
     , has_merged_(false)
+    , buffer_nx_(0)
+    , buffer_ny_(0)
+    , buffer_nz_(0)
 {
     initialize();
 }
@@ -132,6 +139,26 @@ void BinaryMerger::reset() {
     initialize();
 }
 
+void BinaryMerger::saveCheckpoint(CheckpointWriter& writer) const {
+    writer.addValues("gw.orbit", {current_separation_, current_phase_, current_omega_,
+                                  total_energy_radiated_, has_merged_ ? 1.0 : 0.0});
+}
+
+void BinaryMerger::restoreCheckpoint(const CheckpointImage& image) {
+    double orbit[5] = {};
+    image.readF64("gw.orbit", orbit, 5);
+    current_separation_ = orbit[0];
+    current_phase_ = orbit[1];
+    current_omega_ = orbit[2];
+    total_energy_radiated_ = orbit[3];
+    has_merged_ = orbit[4] != 0.0;
+
+    const double mass_ratio = config_.mass2 / (config_.mass1 + config_.mass2);
+    r1_ = mass_ratio * current_separation_;
+    r2_ = (1.0 - mass_ratio) * current_separation_;
+    updatePositions();
+}
+
 // ============================================================================
 // Source Term Generation
 // ============================================================================
@@ -140,6 +167,8 @@ std::vector<std::complex<double>> BinaryMerger::computeSourceTerms(
     const SymmetryField& field,
     double t) const
 {
+    DASE_TRACE_ZONE("gw.sources");
+    (void)t;
     int total_points = field.getTotalPoints();
     std::vector<std::complex<double>> sources(total_points, std::complex<double>(0.0, 0.0));
 
@@ -148,32 +177,145 @@ std::vector<std::complex<double>> BinaryMerger::computeSourceTerms(
         return sources;
     }
 
-    // Get grid configuration
     const SymmetryFieldConfig& grid_config = field.getConfig();
+    writeSourceBoxes(field,
+                     computeSourceBox(grid_config, position1_),
+                     computeSourceBox(grid_config, position2_),
+                     sources.data());
+
+    return sources;
+}
 
-    // Compute sources for each grid point
-    for (int i = 0; i < grid_config.nx; i++) {
-        for (int j = 0; j < grid_config.ny; j++) {
-            for (int k = 0; k < grid_config.nz; k++) {
-                // Get position of this grid point
-                Vector3D pos = field.toPosition(i, j, k);
+const std::vector<std::complex<double>>& BinaryMerger::updateSourceTerms(
+    const SymmetryField& field,
+    double t)
+{
+    DASE_TRACE_ZONE("gw.sources");
+    (void)t;
+    const SymmetryFieldConfig& grid_config = field.getConfig();
 
-                // Compute contribution from BH 1
-                std::complex<double> S1 = computeGaussianSource(
-                    pos, position1_, config_.mass1);
+    // (Re)initialise the buffer when first used or the grid changes
+    if (buffer_nx_ != grid_config.nx || buffer_ny_ != grid_config.ny ||
+        buffer_nz_ != grid_config.nz ||
+        static_cast<int>(source_buffer_.size()) != field.getTotalPoints()) {
+        source_buffer_.assign(field.getTotalPoints(), std::complex<double>(0.0, 0.0));
+        buffer_nx_ = grid_config.nx;
+        buffer_ny_ = grid_config.ny;
+        buffer_nz_ = grid_config.nz;
+        written_box1_ = SourceBox();
+        written_box2_ = SourceBox();
+    }
 
-                // Compute contribution from BH 2
-                std::complex<double> S2 = computeGaussianSource(
-                    pos, position2_, config_.mass2);
+    // If merged, no more source terms (empty boxes)
+    SourceBox box1;
+    SourceBox box2;
+    if (!has_merged_) {
+        box1 = computeSourceBox(grid_config, position1_);
+        box2 = computeSourceBox(grid_config, position2_);
+    }
 
-                // Total source
-                int idx = field.toFlatIndex(i, j, k);
-                sources[idx] = (S1 + S2) * config_.source_amplitude;
+    // Zero only what the previous call wrote and this call will not overwrite
+    std::complex<double>* sources = source_buffer_.data();
+    for (const SourceBox* old_box : {&written_box1_, &written_box2_}) {
+        if (old_box->empty()) continue;
+        for (int k = old_box->k0; k <= old_box->k1; k++) {
+            for (int j = old_box->j0; j <= old_box->j1; j++) {
+                for (int i = old_box->i0; i <= old_box->i1; i++) {
+                    if (!box1.contains(i, j, k) && !box2.contains(i, j, k)) {
+                        sources[field.toFlatIndex(i, j, k)] = std::complex<double>(0.0, 0.0);
+                    }
+                }
             }
         }
     }
 
-    return sources;
+    writeSourceBoxes(field, box1, box2, sources);
+    written_box1_ = box1;
+    written_box2_ = box2;
+
+    return source_buffer_;
+}
+
+SourceBox truncatedSourceBox(const SymmetryFieldConfig& grid, const Vector3D& position, double radius) {
+    SourceBox box;
+
+    // Grid points x = origin + (i + offset)·dx with |x - x_source| <= radius, clamped to
+    // the local grid (clamp in floating point first so far off-grid sources
+    // cannot overflow)
+    auto axisRange = [radius](double centre, double spacing, int offset, int n, int& lo, int& hi) {
+        const double lo_f = std::ceil((centre - radius) / spacing) - offset;
+        const double hi_f = std::floor((centre + radius) / spacing) - offset;
+        lo = static_cast<int>(std::max(lo_f, 0.0));
+        hi = static_cast<int>(std::min(hi_f, static_cast<double>(n - 1)));
+        if (lo_f > static_cast<double>(n - 1) || hi_f < 0.0) {
+            lo = 0;
+            hi = -1;
+        }
+    };
+    axisRange(position.x - grid.origin_x, grid.dx, 0, grid.nx, box.i0, box.i1);
+    axisRange(position.y - grid.origin_y, grid.dy, 0, grid.ny, box.j0, box.j1);
+    axisRange(position.z - grid.origin_z, grid.dz, grid.k_offset, grid.nz, box.k0, box.k1);
+    return box;
+}
+
+SourceBox BinaryMerger::computeSourceBox(
+    const SymmetryFieldConfig& grid,
+    const Vector3D& bh_position) const
+{
+    if (config_.source_cutoff_sigmas <= 0.0) {
+        SourceBox box;
+        box.i0 = 0; box.i1 = grid.nx - 1;
+        box.j0 = 0; box.j1 = grid.ny - 1;
+        box.k0 = 0; box.k1 = grid.nz - 1;
+        return box;
+    }
+    return truncatedSourceBox(grid, bh_position, config_.source_cutoff_sigmas * config_.gaussian_width);
+}
+
+void BinaryMerger::writeSourceBoxes(
+    const SymmetryField& field,
+    const SourceBox& box1,
+    const SourceBox& box2,
+    std::complex<double>* sources) const
+{
+    const std::complex<double> zero(0.0, 0.0);
+
+    // Box 1, including any overlap with box 2
+    if (!box1.empty()) {
+        for (int k = box1.k0; k <= box1.k1; k++) {
+            for (int j = box1.j0; j <= box1.j1; j++) {
+                for (int i = box1.i0; i <= box1.i1; i++) {
+                    // Get position of this grid point
+                    Vector3D pos = field.toPosition(i, j, k);
+
+                    std::complex<double> S1 = computeGaussianSource(
+                        pos, position1_, config_.mass1);
+                    std::complex<double> S2 = box2.contains(i, j, k)
+                        ? computeGaussianSource(pos, position2_, config_.mass2)
+                        : zero;
+
+                    sources[field.toFlatIndex(i, j, k)] = (S1 + S2) * config_.source_amplitude;
+                }
+            }
+        }
+    }
+
+    // Remainder of box 2
+    if (!box2.empty()) {
+        for (int k = box2.k0; k <= box2.k1; k++) {
+            for (int j = box2.j0; j <= box2.j1; j++) {
+                for (int i = box2.i0; i <= box2.i1; i++) {
+                    if (box1.contains(i, j, k)) continue;
+
+                    Vector3D pos = field.toPosition(i, j, k);
+                    std::complex<double> S2 = computeGaussianSource(
+                        pos, position2_, config_.mass2);
+
+                    sources[field.toFlatIndex(i, j, k)] = (zero + S2) * config_.source_amplitude;
+                }
+            }
+        }
+    }
 }
 
 // ============================================================================
@@ -319,6 +461,201 @@ std::complex<double> BinaryMerger::computeGaussianSource(
     return std::complex<double>(gaussian, 0.0);
 }
 
+// ============================================================================
+// Source Catalog
+// ============================================================================
+
+SourceCatalog::SourceCatalog(const SourceCatalogConfig& config)
+    : config_(config)
+    , buffer_nx_(0)
+    , buffer_ny_(0)
+    , buffer_nz_(0)
+    , tiles_x_(0)
+    , tiles_y_(0)
+    , tiles_z_(0)
+    , last_pairs_(0)
+{
+    if (config_.cutoff_sigmas <= 0.0) {
+        throw std::invalid_argument("SourceCatalog: cutoff_sigmas must be positive");
+    }
+    if (config_.tile_size < 1) {
+        throw std::invalid_argument("SourceCatalog: tile_size must be positive");
+    }
+}
+
+size_t SourceCatalog::addBinary(const BinaryMergerConfig& config) {
+    binaries_.emplace_back(config);
+    return binaries_.size() - 1;
+}
+
+void SourceCatalog::evolveOrbits(double dt) {
+    for (BinaryMerger& binary : binaries_) {
+        binary.evolveOrbit(dt);
+    }
+}
+
+void SourceCatalog::reset() {
+    for (BinaryMerger& binary : binaries_) {
+        binary.reset();
+    }
+}
+
+void SourceCatalog::buildIndex(const SymmetryFieldConfig& grid) {
+    const int tile = config_.tile_size;
+    sources_.clear();
+    source_bin_.clear();
+    for (const BinaryMerger& binary : binaries_) {
+        if (binary.hasMerged()) continue;
+        const BinaryMergerConfig& bc = binary.getConfig();
+        const double sigmas = bc.source_cutoff_sigmas > 0.0 ? bc.source_cutoff_sigmas : config_.cutoff_sigmas;
+        const Vector3D positions[2] = {binary.getPosition1(), binary.getPosition2()};
+        const double masses[2] = {bc.mass1, bc.mass2};
+        for (int s = 0; s < 2; s++) {
+            Source source;
+            source.position = positions[s];
+            source.amplitude = masses[s] / bc.mass1 * bc.source_amplitude;   // As computeGaussianSource
+            source.inv_two_sigma_sq = 1.0 / (2.0 * bc.gaussian_width * bc.gaussian_width);
+            source.radius = sigmas * bc.gaussian_width;
+            source.box = truncatedSourceBox(grid, source.position, source.radius);
+            if (source.box.empty()) continue;
+
+            // Bin of the position, clamped to the grid (a clamped source is
+            // only closer to every tile)
+            auto binOf = [tile](double offset, double spacing, int shift, int tiles) {
+                const double index = std::floor(offset / spacing) - shift;
+                const double bin = std::floor(index / tile);
+                return static_cast<int>(std::min(std::max(bin, 0.0), static_cast<double>(tiles - 1)));
+            };
+            const int bx = binOf(source.position.x - grid.origin_x, grid.dx, 0, tiles_x_);
+            const int by = binOf(source.position.y - grid.origin_y, grid.dy, 0, tiles_y_);
+            const int bz = binOf(source.position.z - grid.origin_z, grid.dz, grid.k_offset, tiles_z_);
+            sources_.push_back(source);
+            source_bin_.push_back(bx + tiles_x_ * (by + tiles_y_ * bz));
+        }
+    }
+
+    // Counting sort into bins; sources stay in catalog order within a bin
+    const size_t num_bins = static_cast<size_t>(tiles_x_) * tiles_y_ * tiles_z_;
+    bin_start_.assign(num_bins + 1, 0);
+    for (int bin : source_bin_) {
+        bin_start_[bin + 1]++;
+    }
+    for (size_t b = 0; b < num_bins; b++) {
+        bin_start_[b + 1] += bin_start_[b];
+    }
+    bin_sources_.resize(sources_.size());
+    std::vector<int> fill(bin_start_.begin(), bin_start_.end() - 1);
+    for (size_t s = 0; s < sources_.size(); s++) {
+        bin_sources_[fill[source_bin_[s]]++] = static_cast<int>(s);
+    }
+}
+
+const std::vector<std::complex<double>>& SourceCatalog::updateSourceTerms(
+    const SymmetryField& field,
+    double t)
+{
+    DASE_TRACE_ZONE("gw.sources");
+    (void)t;
+    const SymmetryFieldConfig& grid = field.getConfig();
+    const int tile = config_.tile_size;
+
+    // (Re)initialise the buffer and tiling when first used or the grid changes
+    if (buffer_nx_ != grid.nx || buffer_ny_ != grid.ny || buffer_nz_ != grid.nz ||
+        static_cast<int>(source_buffer_.size()) != field.getTotalPoints()) {
+        source_buffer_.assign(field.getTotalPoints(), std::complex<double>(0.0, 0.0));
+        buffer_nx_ = grid.nx;
+        buffer_ny_ = grid.ny;
+        buffer_nz_ = grid.nz;
+        tiles_x_ = (grid.nx + tile - 1) / tile;
+        tiles_y_ = (grid.ny + tile - 1) / tile;
+        tiles_z_ = (grid.nz + tile - 1) / tile;
+        tile_active_.assign(static_cast<size_t>(tiles_x_) * tiles_y_ * tiles_z_, 0);
+    }
+
+    buildIndex(grid);
+
+    // Bins a tile must scan: a source reaches at most ceil(radius / tile
+    // extent) tiles from its own bin along each axis
+    double max_radius = 0.0;
+    for (const Source& source : sources_) {
+        max_radius = std::max(max_radius, source.radius);
+    }
+    const int reach_x = static_cast<int>(std::ceil(max_radius / (tile * grid.dx)));
+    const int reach_y = static_cast<int>(std::ceil(max_radius / (tile * grid.dy)));
+    const int reach_z = static_cast<int>(std::ceil(max_radius / (tile * grid.dz)));
+
+    std::complex<double>* sources = source_buffer_.data();
+    const int64_t num_tiles = static_cast<int64_t>(tile_active_.size());
+    uint64_t pairs = 0;
+
+    #pragma omp parallel reduction(+:pairs) if(!sources_.empty() && field.getTotalPoints() >= 32768)
+    {
+        std::vector<int> candidates;
+        #pragma omp for schedule(dynamic, 16)
+        for (int64_t index = 0; index < num_tiles; index++) {
+            const int tx = static_cast<int>(index % tiles_x_);
+            const int ty = static_cast<int>((index / tiles_x_) % tiles_y_);
+            const int tz = static_cast<int>(index / (static_cast<int64_t>(tiles_x_) * tiles_y_));
+            SourceBox box;
+            box.i0 = tx * tile; box.i1 = std::min(box.i0 + tile, grid.nx) - 1;
+            box.j0 = ty * tile; box.j1 = std::min(box.j0 + tile, grid.ny) - 1;
+            box.k0 = tz * tile; box.k1 = std::min(box.k0 + tile, grid.nz) - 1;
+
+            // Sources of the neighbouring bins whose support overlaps this tile
+            candidates.clear();
+            for (int bz = std::max(tz - reach_z, 0); bz <= std::min(tz + reach_z, tiles_z_ - 1); bz++) {
+                for (int by = std::max(ty - reach_y, 0); by <= std::min(ty + reach_y, tiles_y_ - 1); by++) {
+                    for (int bx = std::max(tx - reach_x, 0); bx <= std::min(tx + reach_x, tiles_x_ - 1); bx++) {
+                        const int bin = bx + tiles_x_ * (by + tiles_y_ * bz);
+                        for (int n = bin_start_[bin]; n < bin_start_[bin + 1]; n++) {
+                            if (sources_[bin_sources_[n]].box.overlaps(box)) {
+                                candidates.push_back(bin_sources_[n]);
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (candidates.empty()) {
+                if (tile_active_[index]) {
+                    for (int k = box.k0; k <= box.k1; k++) {
+                        for (int j = box.j0; j <= box.j1; j++) {
+                            std::complex<double>* row = sources + field.toFlatIndex(box.i0, j, k);
+                            std::fill(row, row + (box.i1 - box.i0 + 1), std::complex<double>(0.0, 0.0));
+                        }
+                    }
+                    tile_active_[index] = 0;
+                }
+                continue;
+            }
+            std::sort(candidates.begin(), candidates.end());   // Catalog order: thread-count independent sums
+
+            for (int k = box.k0; k <= box.k1; k++) {
+                for (int j = box.j0; j <= box.j1; j++) {
+                    for (int i = box.i0; i <= box.i1; i++) {
+                        const Vector3D pos = field.toPosition(i, j, k);
+                        double value = 0.0;
+                        for (int s : candidates) {
+                            const Source& source = sources_[s];
+                            if (!source.box.contains(i, j, k)) continue;
+                            const double dx = pos.x - source.position.x;
+                            const double dy = pos.y - source.position.y;
+                            const double dz = pos.z - source.position.z;
+                            value += source.amplitude * std::exp(-(dx * dx + dy * dy + dz * dz) * source.inv_two_sigma_sq);
+                            pairs++;
+                        }
+                        sources[field.toFlatIndex(i, j, k)] = std::complex<double>(value, 0.0);
+                    }
+                }
+            }
+            tile_active_[index] = 1;
+        }
+    }
+    last_pairs_ = pairs;
+
+    return source_buffer_;
+}
+
 } // namespace gw
 } // namespace igsoa
 } // namespace dase
@@ -9,6 +9,8 @@
  * - Gaussian asymmetry concentrations at each BH location
  * - Source term S(x,t) = S₁(x,t) + S₂(x,t)
  * - Optional inspiral dynamics (GW radiation backreaction)
+ * - SourceCatalog: many binaries in one domain, binned by position so each
+ *   grid tile evaluates only the sources reaching it
  *
  * Coordinate System:
  * - Center of mass at configurable position
@@ -21,6 +23,7 @@
 
 #include "symmetry_field.h"
 #include <complex>
+#include <cstdint>
 #include <vector>
 
 namespace dase {
@@ -45,6 +48,7 @@ struct BinaryMergerConfig {
     // Source amplitude parameters
     double gaussian_width;          // σ for asymmetry concentration (meters)
     double source_amplitude;        // Overall amplitude factor
+    double source_cutoff_sigmas;    // Evaluate only within this many σ of each BH (0 = whole grid)
 
     // Physics flags
     bool enable_inspiral;           // Enable GW radiation backreaction
@@ -59,11 +63,34 @@ struct BinaryMergerConfig {
         , center(0, 0, 0)
         , gaussian_width(5e3)           // 5 km
         , source_amplitude(1.0)
+        , source_cutoff_sigmas(0.0)     // Exact: every grid point
         , enable_inspiral(false)        // Start with circular orbit
         , merger_threshold(3.0)         // Merge at 3 R_s
     {}
 };
 
+/**
+ * Grid index box (inclusive) covered by one truncated source
+ */
+struct SourceBox {
+    int i0, i1, j0, j1, k0, k1;
+    SourceBox() : i0(0), i1(-1), j0(0), j1(-1), k0(0), k1(-1) {}
+    bool empty() const { return i0 > i1 || j0 > j1 || k0 > k1; }
+    bool contains(int i, int j, int k) const {
+        return i >= i0 && i <= i1 && j >= j0 && j <= j1 && k >= k0 && k <= k1;
+    }
+    bool overlaps(const SourceBox& other) const {
+        return i0 <= other.i1 && other.i0 <= i1 && j0 <= other.j1 && other.j0 <= j1 &&
+               k0 <= other.k1 && other.k0 <= k1;
+    }
+};
+
+/**
+ * Local grid points within `radius` of `position`, clamped to the local grid
+ * (empty if the ball misses it)
+ */
+SourceBox truncatedSourceBox(const SymmetryFieldConfig& grid, const Vector3D& position, double radius);
+
 /**
  * Binary Merger Source Manager
  *
@@ -101,6 +128,14 @@ public:
      */
     void reset();
 
+    /**
+     * Checkpoint the orbit (engine_checkpoint.h):
+     *   gw.orbit  f64 [separation, phase, omega, energy_radiated, merged]
+     * Positions and reduced radii are recomputed on restore.
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const;
+    void restoreCheckpoint(const CheckpointImage& image);
+
     // ========================================================================
     // Source Term Generation
     // ========================================================================
@@ -119,6 +154,22 @@ public:
         const SymmetryField& field,
         double t) const;
 
+    /**
+     * Compute source terms into the merger's reusable buffer
+     *
+     * Same values as computeSourceTerms.  With source_cutoff_sigmas > 0 only
+     * the bounding box of each source is evaluated, and only cells of the
+     * previous call's boxes that fell out of the current ones are re-zeroed,
+     * so the per-step cost scales with the source support, not the grid.
+     *
+     * @param field Symmetry field (provides grid information)
+     * @param t Current simulation time (seconds)
+     * @return Buffer of complex source terms, valid until the next call
+     */
+    const std::vector<std::complex<double>>& updateSourceTerms(
+        const SymmetryField& field,
+        double t);
+
     // ========================================================================
     // Query Methods
     // ========================================================================
@@ -187,6 +238,11 @@ public:
     // Diagnostics
     // ========================================================================
 
+    /**
+     * Configuration the merger was created with
+     */
+    const BinaryMergerConfig& getConfig() const { return config_; }
+
     /**
      * Get total energy radiated in GWs (if inspiral enabled)
      * @return Energy (Joules)
@@ -225,6 +281,12 @@ private:
     double total_energy_radiated_;  // E_GW (Joules)
     bool has_merged_;
 
+    // Reusable source buffer and the boxes written into it last call
+    std::vector<std::complex<double>> source_buffer_;
+    SourceBox written_box1_;
+    SourceBox written_box2_;
+    int buffer_nx_, buffer_ny_, buffer_nz_;
+
     // Physical constants (CGS → SI conversions handled internally)
     static constexpr double G = 6.67430e-11;        // m³/(kg·s²)
     static constexpr double c = 299792458.0;        // m/s
@@ -270,6 +332,141 @@ private:
         const Vector3D& position,
         const Vector3D& bh_position,
         double mass) const;
+
+    /**
+     * Index box within source_cutoff_sigmas·σ of a BH (whole grid if the
+     * cutoff is disabled, empty if merged or off-grid)
+     */
+    SourceBox computeSourceBox(const SymmetryFieldConfig& grid,
+                               const Vector3D& bh_position) const;
+
+    /**
+     * Write (S₁ + S₂)·A over box1 ∪ box2; a source contributes only inside
+     * its own box
+     */
+    void writeSourceBoxes(const SymmetryField& field,
+                          const SourceBox& box1,
+                          const SourceBox& box2,
+                          std::complex<double>* sources) const;
+};
+
+/**
+ * Configuration for a many-source catalog
+ */
+struct SourceCatalogConfig {
+    double cutoff_sigmas;   // Support radius in σ of binaries without their own source_cutoff_sigmas
+    int tile_size;          // Grid points per tile edge; tiles double as the position bins
+
+    SourceCatalogConfig()
+        : cutoff_sigmas(6.0)
+        , tile_size(8)
+    {}
+};
+
+/**
+ * Source Catalog
+ *
+ * Many binaries in one domain (population studies).  Evaluating every
+ * source over the whole grid costs sources × points; the catalog instead
+ * tiles the grid into tile_size³ blocks and keeps a uniform bin index of
+ * the source positions with one bin per tile:
+ *
+ *   1. each step the sources of the unmerged binaries (two per binary, at
+ *      their current orbital positions) are counting-sorted into the bin
+ *      holding their position, clamped to the grid
+ *   2. each tile scans the bins within the largest support radius, keeps
+ *      the sources whose σ-truncated box overlaps it, and evaluates only
+ *      those at its points
+ *
+ * Tiles run in parallel and write disjoint points; each point sums its
+ * sources in catalog order, so the result is independent of the thread
+ * count.  Tiles without sources are zeroed only if they had some on the
+ * previous call, so the per-step cost scales with the overlapping
+ * source-point pairs plus the tile and bin counts, not sources × points.
+ *
+ * Every source is truncated: binaries use their own source_cutoff_sigmas,
+ * or the catalog's cutoff_sigmas when it is 0.  Within the boxes the
+ * values match each binary's BinaryMerger::updateSourceTerms summed (up to
+ * rounding of the sum).
+ */
+class SourceCatalog {
+public:
+    explicit SourceCatalog(const SourceCatalogConfig& config = SourceCatalogConfig());
+
+    /**
+     * Add a binary to the catalog
+     * @return Its index
+     */
+    size_t addBinary(const BinaryMergerConfig& config);
+
+    size_t size() const { return binaries_.size(); }
+    BinaryMerger& getBinary(size_t index) { return binaries_[index]; }
+    const BinaryMerger& getBinary(size_t index) const { return binaries_[index]; }
+
+    /**
+     * Evolve every orbit by one timestep; the bin index follows on the
+     * next updateSourceTerms
+     */
+    void evolveOrbits(double dt);
+
+    /**
+     * Reset every binary to its initial conditions
+     */
+    void reset();
+
+    /**
+     * Compute the summed source terms of all binaries into the catalog's
+     * reusable buffer
+     *
+     * @param field Symmetry field (provides grid information)
+     * @param t Current simulation time (seconds)
+     * @return Buffer of complex source terms, valid until the next call
+     */
+    const std::vector<std::complex<double>>& updateSourceTerms(
+        const SymmetryField& field,
+        double t);
+
+    /**
+     * Sources that touched the grid on the last update
+     */
+    size_t getActiveSourceCount() const { return sources_.size(); }
+
+    /**
+     * Source-point pairs the last update evaluated
+     */
+    uint64_t getLastPairCount() const { return last_pairs_; }
+
+private:
+    // One truncated Gaussian: A exp(-|x - x_s|² / (2σ²)) inside box
+    struct Source {
+        Vector3D position;
+        double amplitude;
+        double inv_two_sigma_sq;
+        double radius;
+        SourceBox box;
+    };
+
+    SourceCatalogConfig config_;
+    std::vector<BinaryMerger> binaries_;
+
+    // Sources of this update and the bin index over them (CSR: bin b holds
+    // bin_sources_[bin_start_[b] .. bin_start_[b + 1]))
+    std::vector<Source> sources_;
+    std::vector<int> source_bin_;
+    std::vector<int> bin_start_;
+    std::vector<int> bin_sources_;
+
+    // Reusable source buffer, its grid and the tiles written last call
+    std::vector<std::complex<double>> source_buffer_;
+    std::vector<uint8_t> tile_active_;
+    int buffer_nx_, buffer_ny_, buffer_nz_;
+    int tiles_x_, tiles_y_, tiles_z_;
+    uint64_t last_pairs_;
+
+    /**
+     * Collect the sources touching the grid and bin them by position
+     */
+    void buildIndex(const SymmetryFieldConfig& grid);
 };
 
 } // namespace gw
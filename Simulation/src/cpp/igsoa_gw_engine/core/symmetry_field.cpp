@@ -3,17 +3,128 @@
  */
 
 #include "symmetry_field.h"
+#include "field_snapshot.h"
+#include "slab_decomposition.h"
 #include "utils/logger.h"
+#include "engine_checkpoint.h"
+#include "trace_zones.h"
 #include <cmath>
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include <fstream>
 #include <sstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Below this many grid points evolveStep stays single-threaded
+#ifndef SYMMETRY_FIELD_OMP_MIN_POINTS
+#define SYMMETRY_FIELD_OMP_MIN_POINTS 4096
+#endif
+
 namespace dase {
 namespace igsoa {
 namespace gw {
 
+namespace {
+
+// Batched interpolation: points per block (cell indices and weights of a
+// block are computed in one vectorizable pass, then the corners gathered)
+// and the prefetch distance of the gather, in points
+constexpr size_t kInterpolationBlock = 64;
+constexpr size_t kInterpolationPrefetch = 8;
+
+// Trilinear interpolation of `data` at count <= kInterpolationBlock
+// positions (0 <= fx < nx - 1 etc., else `outside`); also the single-point
+// path of interpolateDeltaPhi / interpolateAlpha
+template <typename T>
+void interpolateBlock(const SymmetryFieldConfig& config, const T* data, T outside,
+                      const double* x, const double* y, const double* z, size_t count,
+                      bool prefetch, T* out) {
+    alignas(64) double wx[kInterpolationBlock];
+    alignas(64) double wy[kInterpolationBlock];
+    alignas(64) double wz[kInterpolationBlock];
+    alignas(64) int corner[kInterpolationBlock];   // Flat index of (i0, j0, k0); -1 outside
+
+    const int nx = config.nx;
+    const int plane = config.nx * config.ny;
+    const double last_x = config.nx - 1;
+    const double last_y = config.ny - 1;
+    const double last_z = config.nz - 1;
+    const double k_offset = config.k_offset;
+
+    #pragma omp simd
+    for (size_t n = 0; n < count; n++) {
+        const double fx = (x[n] - config.origin_x) / config.dx;
+        const double fy = (y[n] - config.origin_y) / config.dy;
+        const double fz = (z[n] - config.origin_z) / config.dz - k_offset;
+        // i0 >= 0 and i0 + 1 < nx  <=>  0 <= fx < nx - 1 (NaN is outside)
+        const bool inside = fx >= 0.0 && fx < last_x &&
+                            fy >= 0.0 && fy < last_y &&
+                            fz >= 0.0 && fz < last_z;
+        const double fx0 = inside ? std::floor(fx) : 0.0;
+        const double fy0 = inside ? std::floor(fy) : 0.0;
+        const double fz0 = inside ? std::floor(fz) : 0.0;
+        wx[n] = fx - fx0;
+        wy[n] = fy - fy0;
+        wz[n] = fz - fz0;
+        corner[n] = inside ? static_cast<int>(fx0) + nx * static_cast<int>(fy0) +
+                             plane * static_cast<int>(fz0)
+                           : -1;
+    }
+
+    for (size_t n = 0; n < count; n++) {
+#if defined(__GNUC__) || defined(__clang__)
+        if (prefetch && n + kInterpolationPrefetch < count && corner[n + kInterpolationPrefetch] >= 0) {
+            const T* ahead = data + corner[n + kInterpolationPrefetch];
+            __builtin_prefetch(ahead);
+            __builtin_prefetch(ahead + nx);
+            __builtin_prefetch(ahead + plane);
+            __builtin_prefetch(ahead + plane + nx);
+        }
+#else
+        (void)prefetch;
+#endif
+        if (corner[n] < 0) {
+            out[n] = outside;
+            continue;
+        }
+        const T* c = data + corner[n];
+        const double wx1 = wx[n];
+        const double wy1 = wy[n];
+        const double wz1 = wz[n];
+        const double wx0 = 1.0 - wx1;
+        const double wy0 = 1.0 - wy1;
+        const double wz0 = 1.0 - wz1;
+        out[n] =
+            c[0] * wx0 * wy0 * wz0 +
+            c[plane] * wx0 * wy0 * wz1 +
+            c[nx] * wx0 * wy1 * wz0 +
+            c[nx + plane] * wx0 * wy1 * wz1 +
+            c[1] * wx1 * wy0 * wz0 +
+            c[1 + plane] * wx1 * wy0 * wz1 +
+            c[1 + nx] * wx1 * wy1 * wz0 +
+            c[1 + nx + plane] * wx1 * wy1 * wz1;
+    }
+}
+
+template <typename T>
+void interpolateBatch(const SymmetryFieldConfig& config, const T* data, T outside,
+                      const double* x, const double* y, const double* z, size_t count,
+                      bool prefetch, T* out) {
+    const int64_t blocks = static_cast<int64_t>((count + kInterpolationBlock - 1) / kInterpolationBlock);
+    #pragma omp parallel for schedule(static) if(count >= SYMMETRY_FIELD_OMP_MIN_POINTS)
+    for (int64_t b = 0; b < blocks; b++) {
+        const size_t begin = static_cast<size_t>(b) * kInterpolationBlock;
+        const size_t n = std::min(kInterpolationBlock, count - begin);
+        interpolateBlock(config, data, outside, x + begin, y + begin, z + begin, n, prefetch, out + begin);
+    }
+}
+
+} // namespace
+
 // ============================================================================
 // Vector3D Implementation
 // ============================================================================
@@ -93,12 +204,14 @@ Tensor4x4 Tensor4x4::transpose() const {
 SymmetryFieldConfig::SymmetryFieldConfig()
     : nx(64), ny(64), nz(64)
     , dx(1000.0), dy(1000.0), dz(1000.0)  // 1 km grid spacing
+    , origin_x(0.0), origin_y(0.0), origin_z(0.0)
     , R_c_default(0.5)
     , kappa(1.0)
     , lambda(0.1)
     , alpha_min(1.0)   // Maximum memory (near horizon)
     , alpha_max(2.0)   // No memory (flat spacetime)
     , dt(0.001)        // 1 ms timestep
+    , k_offset(0)
 {
 }
 
@@ -108,7 +221,10 @@ SymmetryFieldConfig::SymmetryFieldConfig()
 
 SymmetryField::SymmetryField(const SymmetryFieldConfig& config)
     : config_(config)
+    , alpha_revision_(0)
     , current_time_(0.0)
+    , decomposition_(nullptr)
+    , plane_stats_valid_(true)
 {
     // Validate configuration before allocation
     validateConfig();
@@ -121,9 +237,11 @@ SymmetryField::SymmetryField(const SymmetryFieldConfig& config)
     try {
         // Allocate 3D grids (flattened)
         delta_phi_.resize(total, std::complex<double>(0.0, 0.0));
+        delta_phi_next_.resize(total, std::complex<double>(0.0, 0.0));
         alpha_.resize(total, config_.alpha_max);  // Start with no memory
         gradient_magnitude_.resize(total, 0.0);
         potential_.resize(total, 0.0);
+        plane_stats_.resize(config_.nz);
 
     } catch (const std::bad_alloc& e) {
         std::string error_msg = "Failed to allocate memory for SymmetryField: " +
@@ -177,6 +295,13 @@ void SymmetryField::validateConfig() const {
         throw std::invalid_argument(error_msg);
     }
 
+    if (config_.k_offset < 0) {
+        std::string error_msg = "k_offset must be non-negative, got: " +
+                               std::to_string(config_.k_offset);
+        LOG_ERROR(error_msg);
+        throw std::invalid_argument(error_msg);
+    }
+
     // CFL condition check (stability for wave equation)
     double min_dx = std::min({config_.dx, config_.dy, config_.dz});
     double cfl_limit = 0.5 * min_dx;  // Speed of light assumed = 1 in natural units
@@ -248,12 +373,37 @@ void SymmetryField::setDeltaPhi(int i, int j, int k, std::complex<double> value)
     }
     int idx = toFlatIndex(i, j, k);
     delta_phi_[idx] = value;
+    plane_stats_valid_ = false;
+}
+
+void SymmetryField::assignDeltaPhi(const std::vector<int>& indices, const std::complex<double>* values) {
+    const double lambda = config_.lambda;
+    const double kappa = config_.kappa;
+    for (size_t n = 0; n < indices.size(); n++) {
+        const int idx = indices[n];
+        const double abs_phi_sq = std::norm(values[n]);
+        delta_phi_[idx] = values[n];
+        potential_[idx] = lambda * abs_phi_sq + kappa * abs_phi_sq * abs_phi_sq;
+    }
+    plane_stats_valid_ = false;
 }
 
 std::complex<double> SymmetryField::getDeltaPhiAt(const Vector3D& position) const {
     return interpolateDeltaPhi(position);
 }
 
+void SymmetryField::getDeltaPhiAt(const double* x, const double* y, const double* z, size_t count,
+                                  std::complex<double>* out, bool prefetch) const {
+    DASE_TRACE_ZONE("gw.interpolate");
+    interpolateBatch(config_, delta_phi_.data(), std::complex<double>(0.0, 0.0), x, y, z, count, prefetch, out);
+}
+
+void SymmetryField::getAlphaAt(const double* x, const double* y, const double* z, size_t count,
+                               double* out, bool prefetch) const {
+    DASE_TRACE_ZONE("gw.interpolate");
+    interpolateBatch(config_, alpha_.data(), config_.alpha_max, x, y, z, count, prefetch, out);
+}
+
 double SymmetryField::getAlpha(int i, int j, int k) const {
     if (!isValidIndex(i, j, k)) {
         throw std::out_of_range("Grid index out of bounds");
@@ -271,12 +421,63 @@ void SymmetryField::setAlpha(int i, int j, int k, double alpha) {
     }
     int idx = toFlatIndex(i, j, k);
     alpha_[idx] = alpha;
+    alpha_revision_++;
+}
+
+void SymmetryField::reset(double alpha, double R_c_default, double kappa) {
+    if (alpha < config_.alpha_min || alpha > config_.alpha_max) {
+        throw std::invalid_argument("Alpha out of valid range [alpha_min, alpha_max]");
+    }
+    if (R_c_default < 0.0) {
+        throw std::invalid_argument("R_c_default must be non-negative, got " +
+                                    std::to_string(R_c_default));
+    }
+    config_.R_c_default = R_c_default;
+    config_.kappa = kappa;
+    std::fill(delta_phi_.begin(), delta_phi_.end(), std::complex<double>(0.0, 0.0));
+    std::fill(delta_phi_next_.begin(), delta_phi_next_.end(), std::complex<double>(0.0, 0.0));
+    std::fill(alpha_.begin(), alpha_.end(), alpha);
+    std::fill(gradient_magnitude_.begin(), gradient_magnitude_.end(), 0.0);
+    std::fill(potential_.begin(), potential_.end(), 0.0);
+    std::fill(plane_stats_.begin(), plane_stats_.end(), PlaneStats());
+    plane_stats_valid_ = true;
+    alpha_revision_++;
+    current_time_ = 0.0;
+}
+
+void SymmetryField::saveCheckpoint(CheckpointWriter& writer) const {
+    writer.add("gw.delta_phi", CheckpointType::C128, delta_phi_.data(),
+               sizeof(std::complex<double>), delta_phi_.size());
+    writer.addF64("gw.alpha", alpha_.data(), alpha_.size());
+    writer.addValues("gw.field_clock", {current_time_});
+}
+
+void SymmetryField::restoreCheckpoint(const CheckpointImage& image) {
+    const void* delta_phi = image.data("gw.delta_phi", CheckpointType::C128,
+                                       sizeof(std::complex<double>), delta_phi_.size());
+    image.readF64("gw.alpha", alpha_.data(), alpha_.size());
+    image.readF64("gw.field_clock", &current_time_, 1);
+    std::memcpy(delta_phi_.data(), delta_phi, delta_phi_.size() * sizeof(std::complex<double>));
+    alpha_revision_++;
+    updateGradientCache();
+    updatePotentialCache();
 }
 
 double SymmetryField::getAlphaAt(const Vector3D& position) const {
     return interpolateAlpha(position);
 }
 
+size_t SymmetryField::getMemoryUsage() const {
+    return (delta_phi_.capacity() + delta_phi_next_.capacity()) * sizeof(std::complex<double>)
+         + (alpha_.capacity() + gradient_magnitude_.capacity() + potential_.capacity()) * sizeof(double);
+}
+
+size_t SymmetryField::estimateMemoryUsage(const SymmetryFieldConfig& config) {
+    const size_t total = static_cast<size_t>(std::max(config.nx, 0)) * static_cast<size_t>(std::max(config.ny, 0)) *
+                         static_cast<size_t>(std::max(config.nz, 0));
+    return total * (2 * sizeof(std::complex<double>) + 3 * sizeof(double));
+}
+
 const std::vector<std::complex<double>>& SymmetryField::getDeltaPhiFlat() const {
     return delta_phi_;
 }
@@ -396,6 +597,7 @@ void SymmetryField::updateGradientCache() {
             }
         }
     }
+    plane_stats_valid_ = false;
 }
 
 // === Effective Potential ===
@@ -447,6 +649,7 @@ void SymmetryField::evolveStep(
     const std::vector<std::complex<double>>& fractional_derivatives,
     const std::vector<std::complex<double>>& source_terms)
 {
+    DASE_TRACE_ZONE("gw.evolve_step");
     // Implement fractional wave equation evolution
     // ∂²ₓψ - ₀D^α_t ψ - V(δΦ)ψ = S
     //
@@ -459,60 +662,263 @@ void SymmetryField::evolveStep(
     // - V(δΦ)ψ = potential term
     // - S = source_terms (binary merger)
 
-    int total = getTotalPoints();
-    std::vector<std::complex<double>> new_field(total);
+    const int total = getTotalPoints();
+    if (static_cast<int>(fractional_derivatives.size()) != total ||
+        static_cast<int>(source_terms.size()) != total) {
+        throw std::runtime_error("SymmetryField::evolveStep input size mismatch");
+    }
 
-    // Evolve each grid point
-    for (int i = 1; i < config_.nx - 1; i++) {
-        for (int j = 1; j < config_.ny - 1; j++) {
-            for (int k = 1; k < config_.nz - 1; k++) {
-                int idx = toFlatIndex(i, j, k);
+    // Degenerate grids (an extent of 1) have no interior and cannot take the
+    // one-sided gradient; keep the original per-point cache refresh for them
+    if (config_.nx < 2 || config_.ny < 2 || config_.nz < 2) {
+        updateGradientCache();
+        updatePotentialCache();
+        exchangeHalos();
+        current_time_ += config_.dt;
+        return;
+    }
 
-                // Get current field value
-                std::complex<double> psi = getDeltaPhi(i, j, k);
+    const std::complex<double>* frac = fractional_derivatives.data();
+    const std::complex<double>* src = source_terms.data();
+    const int nz = config_.nz;
+
+    // Each thread owns a contiguous slab of z-planes.  A plane's gradient
+    // needs the new field on both neighbouring planes, so interior planes of
+    // the slab are finished as soon as the next plane is written and the two
+    // slab faces wait for the barrier.
+    #pragma omp parallel if(total >= SYMMETRY_FIELD_OMP_MIN_POINTS)
+    {
+#ifdef _OPENMP
+        const int tid = omp_get_thread_num();
+        const int nthreads = omp_get_num_threads();
+#else
+        const int tid = 0;
+        const int nthreads = 1;
+#endif
+        const int k0 = static_cast<int>(static_cast<long long>(nz) * tid / nthreads);
+        const int k1 = static_cast<int>(static_cast<long long>(nz) * (tid + 1) / nthreads);
+
+        for (int k = k0; k < k1; k++) {
+            evolvePlane(k, frac, src);
+            if (k - 1 > k0) {
+                updateGradientPlane(k - 1, delta_phi_next_.data());
+            }
+        }
 
-                // Compute spatial derivatives (Laplacian)
-                std::complex<double> laplacian = computeLaplacian(i, j, k);
+        #pragma omp barrier
 
-                // Get fractional time derivative
-                std::complex<double> frac_deriv = fractional_derivatives[idx];
+        if (k1 > k0) {
+            updateGradientPlane(k0, delta_phi_next_.data());
+            if (k1 - 1 > k0) {
+                updateGradientPlane(k1 - 1, delta_phi_next_.data());
+            }
+        }
+    }
+
+    // Boundary conditions: boundary values are carried over unchanged
+    // (Zero-gradient boundary condition implicit)
+    delta_phi_.swap(delta_phi_next_);
+    plane_stats_valid_ = true;   // Every plane's totals came from this sweep
 
-                // Get potential
-                double V = getPotential(i, j, k);
+    // Ghost planes were carried over like a boundary; refresh them
+    exchangeHalos();
 
-                // Get source term
-                std::complex<double> source = source_terms[idx];
+    // Advance time
+    current_time_ += config_.dt;
+}
 
-                // Fractional wave equation right-hand side:
-                // RHS = ∂²ₓψ - ₀D^α_t ψ - V·ψ + S
-                std::complex<double> rhs = laplacian - frac_deriv - V * psi + source;
+void SymmetryField::evolvePlane(
+    int k,
+    const std::complex<double>* fractional_derivatives,
+    const std::complex<double>* source_terms)
+{
+    const int nx = config_.nx;
+    const int ny = config_.ny;
+    const int plane = nx * ny;
+    const std::complex<double>* phi = delta_phi_.data();
+    std::complex<double>* next = delta_phi_next_.data();
+    double* V = potential_.data();
+
+    const double dx2 = config_.dx * config_.dx;
+    const double dy2 = config_.dy * config_.dy;
+    const double dz2 = config_.dz * config_.dz;
+    const double lambda = config_.lambda;
+    const double kappa = config_.kappa;
+    const double dt = config_.dt;
+
+    // Potential of the new value, and its share of the plane totals (same
+    // arithmetic as computePlaneStats)
+    const double dV = config_.dx * config_.dy * config_.dz;
+    double energy = 0.0;
+    double amplitude = 0.0;
+    double max_norm = 0.0;
+    auto potentialOf = [lambda, kappa, dV, &energy, &amplitude, &max_norm](std::complex<double> value) {
+        const double abs_phi_sq = std::norm(value);
+        energy += abs_phi_sq * dV;
+        amplitude += std::sqrt(abs_phi_sq);
+        max_norm = std::max(max_norm, abs_phi_sq);
+        return lambda * abs_phi_sq + kappa * abs_phi_sq * abs_phi_sq;
+    };
+    auto storeTotals = [&]() {
+        PlaneStats& stats = plane_stats_[k];
+        stats.energy = energy;
+        stats.amplitude = amplitude;
+        stats.max_norm = max_norm;
+    };
+
+    const int base = k * plane;
+    if (k == 0 || k == config_.nz - 1) {
+        for (int idx = base; idx < base + plane; idx++) {
+            next[idx] = phi[idx];
+            V[idx] = potentialOf(next[idx]);
+        }
+        storeTotals();
+        return;
+    }
 
-                // Forward Euler step (simple first-order time integration)
-                // For production, use RK4 or other higher-order method
-                new_field[idx] = psi + config_.dt * rhs;
+    for (int j = 0; j < ny; j++) {
+        const int row = base + j * nx;
+        if (j == 0 || j == ny - 1) {
+            for (int idx = row; idx < row + nx; idx++) {
+                next[idx] = phi[idx];
+                V[idx] = potentialOf(next[idx]);
             }
+            continue;
         }
+
+        next[row] = phi[row];
+        V[row] = potentialOf(next[row]);
+
+        for (int idx = row + 1; idx < row + nx - 1; idx++) {
+            // Same term order as computeLaplacian / getPotential; V[idx]
+            // still holds the potential of the current field here
+            const std::complex<double> psi = phi[idx];
+            const std::complex<double> d2phidx2 = (phi[idx + 1] - 2.0*psi + phi[idx - 1]) / dx2;
+            const std::complex<double> d2phidy2 = (phi[idx + nx] - 2.0*psi + phi[idx - nx]) / dy2;
+            const std::complex<double> d2phidz2 = (phi[idx + plane] - 2.0*psi + phi[idx - plane]) / dz2;
+            const std::complex<double> laplacian = d2phidx2 + d2phidy2 + d2phidz2;
+
+            const std::complex<double> rhs = laplacian - fractional_derivatives[idx]
+                                           - V[idx] * psi + source_terms[idx];
+            next[idx] = psi + dt * rhs;
+            V[idx] = potentialOf(next[idx]);
+        }
+
+        const int last = row + nx - 1;
+        next[last] = phi[last];
+        V[last] = potentialOf(next[last]);
     }
+    storeTotals();
+}
 
-    // Update field with new values (interior points only)
-    for (int i = 1; i < config_.nx - 1; i++) {
-        for (int j = 1; j < config_.ny - 1; j++) {
-            for (int k = 1; k < config_.nz - 1; k++) {
-                int idx = toFlatIndex(i, j, k);
-                delta_phi_[idx] = new_field[idx];
+void SymmetryField::updateGradientPlane(int k, const std::complex<double>* phi) {
+    // Mirrors computeGradient, evaluated on the given field (evolveStep
+    // passes the freshly written back buffer)
+    const int nx = config_.nx;
+    const int ny = config_.ny;
+    const int nz = config_.nz;
+    const int plane = nx * ny;
+    const double dx = config_.dx;
+    const double dy = config_.dy;
+    const double dz = config_.dz;
+    double gradient_sum = 0.0;
+    double gradient_max = 0.0;
+
+    for (int j = 0; j < ny; j++) {
+        for (int i = 0; i < nx; i++) {
+            const int idx = i + nx * (j + ny * k);
+            const std::complex<double> phi_center = phi[idx];
+
+            std::complex<double> dphidx;
+            if (i == 0) {
+                dphidx = (phi[idx + 1] - phi_center) / dx;
+            } else if (i == nx - 1) {
+                dphidx = (phi_center - phi[idx - 1]) / dx;
+            } else {
+                dphidx = (phi[idx + 1] - phi[idx - 1]) / (2.0 * dx);
+            }
+
+            std::complex<double> dphidy;
+            if (j == 0) {
+                dphidy = (phi[idx + nx] - phi_center) / dy;
+            } else if (j == ny - 1) {
+                dphidy = (phi_center - phi[idx - nx]) / dy;
+            } else {
+                dphidy = (phi[idx + nx] - phi[idx - nx]) / (2.0 * dy);
             }
+
+            std::complex<double> dphidz;
+            if (k == 0) {
+                dphidz = (phi[idx + plane] - phi_center) / dz;
+            } else if (k == nz - 1) {
+                dphidz = (phi_center - phi[idx - plane]) / dz;
+            } else {
+                dphidz = (phi[idx + plane] - phi[idx - plane]) / (2.0 * dz);
+            }
+
+            const Vector3D grad(std::abs(dphidx), std::abs(dphidy), std::abs(dphidz));
+            const double magnitude = grad.magnitude();
+            gradient_magnitude_[idx] = magnitude;
+            gradient_sum += magnitude;
+            gradient_max = std::max(gradient_max, magnitude);
         }
     }
+    plane_stats_[k].gradient = gradient_sum;
+    plane_stats_[k].max_gradient = gradient_max;
+}
 
-    // Boundary conditions: maintain current values at boundaries
-    // (Zero-gradient boundary condition implicit)
+// === Domain Decomposition ===
+
+void SymmetryField::setDecomposition(const SlabDecomposition* decomposition) {
+    if (decomposition &&
+        (decomposition->getLocalNz() != config_.nz ||
+         decomposition->getLocalOffset() != config_.k_offset)) {
+        std::string error_msg = "SymmetryField does not match its slab: local nz=" +
+                               std::to_string(config_.nz) + ", k_offset=" +
+                               std::to_string(config_.k_offset) + " (expected " +
+                               std::to_string(decomposition->getLocalNz()) + ", " +
+                               std::to_string(decomposition->getLocalOffset()) + ")";
+        LOG_ERROR(error_msg);
+        throw std::invalid_argument(error_msg);
+    }
+    decomposition_ = decomposition;
+}
 
-    // Update gradient and potential caches
-    updateGradientCache();
-    updatePotentialCache();
+void SymmetryField::exchangeHalos() {
+    if (!decomposition_ || decomposition_->getNumRanks() == 1) {
+        return;
+    }
 
-    // Advance time
-    current_time_ += config_.dt;
+    const int plane = config_.nx * config_.ny;
+    decomposition_->exchangeHalos(delta_phi_.data(), plane);
+
+    // Potential of the received planes, and centred gradients of the owned
+    // planes that read them
+    auto refreshPotential = [this, plane](int k) {
+        for (int idx = k * plane; idx < (k + 1) * plane; idx++) {
+            const double abs_phi_sq = std::norm(delta_phi_[idx]);
+            potential_[idx] = config_.lambda * abs_phi_sq
+                            + config_.kappa * abs_phi_sq * abs_phi_sq;
+        }
+    };
+    const bool gradients = config_.nx >= 2 && config_.ny >= 2;
+    if (decomposition_->getLowerGhosts() > 0) {
+        refreshPotential(0);
+        if (gradients) updateGradientPlane(1, delta_phi_.data());
+    }
+    if (decomposition_->getUpperGhosts() > 0) {
+        refreshPotential(config_.nz - 1);
+        if (gradients) updateGradientPlane(config_.nz - 2, delta_phi_.data());
+    }
+}
+
+void SymmetryField::ownedPlanes(int& k_begin, int& k_end) const {
+    k_begin = 0;
+    k_end = config_.nz;
+    if (decomposition_) {
+        k_begin += decomposition_->getLowerGhosts();
+        k_end -= decomposition_->getUpperGhosts();
+    }
 }
 
 // === Grid Info ===
@@ -530,74 +936,97 @@ void SymmetryField::fromFlatIndex(int idx, int& i, int& j, int& k) const {
 
 Vector3D SymmetryField::toPosition(int i, int j, int k) const {
     return Vector3D(
-        i * config_.dx,
-        j * config_.dy,
-        k * config_.dz
+        config_.origin_x + i * config_.dx,
+        config_.origin_y + j * config_.dy,
+        config_.origin_z + (k + config_.k_offset) * config_.dz
     );
 }
 
 void SymmetryField::toIndices(const Vector3D& pos, int& i, int& j, int& k) const {
-    i = static_cast<int>(pos.x / config_.dx + 0.5);
-    j = static_cast<int>(pos.y / config_.dy + 0.5);
-    k = static_cast<int>(pos.z / config_.dz + 0.5);
+    i = static_cast<int>((pos.x - config_.origin_x) / config_.dx + 0.5);
+    j = static_cast<int>((pos.y - config_.origin_y) / config_.dy + 0.5);
+    k = static_cast<int>((pos.z - config_.origin_z) / config_.dz + 0.5) - config_.k_offset;
 }
 
 // === Diagnostics ===
 
-double SymmetryField::computeTotalEnergy() const {
-    double energy = 0.0;
-    double dV = config_.dx * config_.dy * config_.dz;
-
-    for (const auto& phi : delta_phi_) {
-        energy += std::norm(phi) * dV;
+void SymmetryField::computePlaneStats(int k, PlaneStats& stats) const {
+    // Index order, as evolvePlane / updateGradientPlane accumulate
+    const double dV = config_.dx * config_.dy * config_.dz;
+    const int plane = config_.nx * config_.ny;
+    stats = PlaneStats();
+    for (int idx = k * plane; idx < (k + 1) * plane; idx++) {
+        const double abs_phi_sq = std::norm(delta_phi_[idx]);
+        stats.energy += abs_phi_sq * dV;
+        stats.amplitude += std::sqrt(abs_phi_sq);
+        stats.max_norm = std::max(stats.max_norm, abs_phi_sq);
+        stats.gradient += gradient_magnitude_[idx];
+        stats.max_gradient = std::max(stats.max_gradient, gradient_magnitude_[idx]);
     }
-
-    return energy;
 }
 
-double SymmetryField::computeMaxAmplitude() const {
-    double max_amp = 0.0;
-
-    for (const auto& phi : delta_phi_) {
-        double amp = std::abs(phi);
-        if (amp > max_amp) {
-            max_amp = amp;
+SymmetryField::PlaneStats SymmetryField::ownedTotals() const {
+    int k_begin, k_end;
+    ownedPlanes(k_begin, k_end);
+
+    // Stale totals are recomputed into a copy (diagnostics stay const)
+    const PlaneStats* planes = plane_stats_.data();
+    std::vector<PlaneStats> fresh;
+    if (!plane_stats_valid_) {
+        fresh.resize(plane_stats_.size());
+        const int64_t total = static_cast<int64_t>(getTotalPoints());
+        #pragma omp parallel for schedule(static) if(total >= SYMMETRY_FIELD_OMP_MIN_POINTS)
+        for (int k = k_begin; k < k_end; k++) {
+            computePlaneStats(k, fresh[k]);
         }
+        planes = fresh.data();
     }
 
-    return max_amp;
+    // Plane order: bit-identical for any thread count
+    PlaneStats totals;
+    for (int k = k_begin; k < k_end; k++) {
+        totals.energy += planes[k].energy;
+        totals.amplitude += planes[k].amplitude;
+        totals.max_norm = std::max(totals.max_norm, planes[k].max_norm);
+        totals.gradient += planes[k].gradient;
+        totals.max_gradient = std::max(totals.max_gradient, planes[k].max_gradient);
+    }
+    return totals;
 }
 
-SymmetryField::FieldStats SymmetryField::getStatistics() const {
-    FieldStats stats;
+double SymmetryField::computeTotalEnergy() const {
+    const double energy = ownedTotals().energy;
+    return decomposition_ ? decomposition_->sum(energy) : energy;
+}
 
-    stats.max_amplitude = 0.0;
-    stats.total_energy = 0.0;
-    double sum_amplitude = 0.0;
-    double sum_gradient = 0.0;
-    stats.max_gradient = 0.0;
-
-    double dV = config_.dx * config_.dy * config_.dz;
-    int total_points = getTotalPoints();
-
-    // Compute all statistics in one pass
-    for (int idx = 0; idx < total_points; idx++) {
-        // Amplitude statistics
-        double amp = std::abs(delta_phi_[idx]);
-        sum_amplitude += amp;
-        if (amp > stats.max_amplitude) {
-            stats.max_amplitude = amp;
-        }
+double SymmetryField::computeMaxAmplitude() const {
+    const double max_amp = std::sqrt(ownedTotals().max_norm);
+    return decomposition_ ? decomposition_->max(max_amp) : max_amp;
+}
 
-        // Energy
-        stats.total_energy += std::norm(delta_phi_[idx]) * dV;
+SymmetryField::FieldStats SymmetryField::getStatistics() const {
+    FieldStats stats;
 
-        // Gradient statistics
-        double grad = gradient_magnitude_[idx];
-        sum_gradient += grad;
-        if (grad > stats.max_gradient) {
-            stats.max_gradient = grad;
-        }
+    // Owned planes only; ghost planes belong to the neighbouring ranks
+    int k_begin, k_end;
+    ownedPlanes(k_begin, k_end);
+    const int plane = config_.nx * config_.ny;
+    double total_points = static_cast<double>((k_end - k_begin) * plane);
+
+    const PlaneStats totals = ownedTotals();
+    stats.total_energy = totals.energy;
+    stats.max_amplitude = std::sqrt(totals.max_norm);
+    stats.max_gradient = totals.max_gradient;
+    double sum_amplitude = totals.amplitude;
+    double sum_gradient = totals.gradient;
+
+    if (decomposition_) {
+        stats.max_amplitude = decomposition_->max(stats.max_amplitude);
+        stats.max_gradient = decomposition_->max(stats.max_gradient);
+        stats.total_energy = decomposition_->sum(stats.total_energy);
+        sum_amplitude = decomposition_->sum(sum_amplitude);
+        sum_gradient = decomposition_->sum(sum_gradient);
+        total_points = decomposition_->sum(total_points);
     }
 
     // Compute means
@@ -636,6 +1065,10 @@ void SymmetryField::exportToFile(const std::string& filename) const {
     file.close();
 }
 
+void SymmetryField::exportBinary(const std::string& filename) const {
+    FieldSnapshot::writeField(*this, filename);
+}
+
 // === Private Helpers ===
 
 bool SymmetryField::isValidIndex(int i, int j, int k) const {
@@ -645,112 +1078,18 @@ bool SymmetryField::isValidIndex(int i, int j, int k) const {
 }
 
 std::complex<double> SymmetryField::interpolateDeltaPhi(const Vector3D& pos) const {
-    // Trilinear interpolation of δΦ at arbitrary position
-
-    // Find grid cell containing position
-    double fx = pos.x / config_.dx;
-    double fy = pos.y / config_.dy;
-    double fz = pos.z / config_.dz;
-
-    int i0 = static_cast<int>(std::floor(fx));
-    int j0 = static_cast<int>(std::floor(fy));
-    int k0 = static_cast<int>(std::floor(fz));
-
-    int i1 = i0 + 1;
-    int j1 = j0 + 1;
-    int k1 = k0 + 1;
-
-    // Check bounds
-    if (i0 < 0 || i1 >= config_.nx ||
-        j0 < 0 || j1 >= config_.ny ||
-        k0 < 0 || k1 >= config_.nz) {
-        return std::complex<double>(0.0, 0.0);
-    }
-
-    // Interpolation weights
-    double wx1 = fx - i0;
-    double wy1 = fy - j0;
-    double wz1 = fz - k0;
-    double wx0 = 1.0 - wx1;
-    double wy0 = 1.0 - wy1;
-    double wz0 = 1.0 - wz1;
-
-    // Get 8 corner values
-    std::complex<double> c000 = getDeltaPhi(i0, j0, k0);
-    std::complex<double> c001 = getDeltaPhi(i0, j0, k1);
-    std::complex<double> c010 = getDeltaPhi(i0, j1, k0);
-    std::complex<double> c011 = getDeltaPhi(i0, j1, k1);
-    std::complex<double> c100 = getDeltaPhi(i1, j0, k0);
-    std::complex<double> c101 = getDeltaPhi(i1, j0, k1);
-    std::complex<double> c110 = getDeltaPhi(i1, j1, k0);
-    std::complex<double> c111 = getDeltaPhi(i1, j1, k1);
-
-    // Trilinear interpolation
-    std::complex<double> result =
-        c000 * wx0 * wy0 * wz0 +
-        c001 * wx0 * wy0 * wz1 +
-        c010 * wx0 * wy1 * wz0 +
-        c011 * wx0 * wy1 * wz1 +
-        c100 * wx1 * wy0 * wz0 +
-        c101 * wx1 * wy0 * wz1 +
-        c110 * wx1 * wy1 * wz0 +
-        c111 * wx1 * wy1 * wz1;
-
+    // Trilinear interpolation of δΦ at an arbitrary position (the batched
+    // path with one point, so both give the same bits)
+    std::complex<double> result;
+    interpolateBlock(config_, delta_phi_.data(), std::complex<double>(0.0, 0.0),
+                     &pos.x, &pos.y, &pos.z, 1, false, &result);
     return result;
 }
 
 double SymmetryField::interpolateAlpha(const Vector3D& pos) const {
-    // Trilinear interpolation of α at arbitrary position
-
-    // Find grid cell containing position
-    double fx = pos.x / config_.dx;
-    double fy = pos.y / config_.dy;
-    double fz = pos.z / config_.dz;
-
-    int i0 = static_cast<int>(std::floor(fx));
-    int j0 = static_cast<int>(std::floor(fy));
-    int k0 = static_cast<int>(std::floor(fz));
-
-    int i1 = i0 + 1;
-    int j1 = j0 + 1;
-    int k1 = k0 + 1;
-
-    // Check bounds
-    if (i0 < 0 || i1 >= config_.nx ||
-        j0 < 0 || j1 >= config_.ny ||
-        k0 < 0 || k1 >= config_.nz) {
-        return config_.alpha_max;
-    }
-
-    // Interpolation weights
-    double wx1 = fx - i0;
-    double wy1 = fy - j0;
-    double wz1 = fz - k0;
-    double wx0 = 1.0 - wx1;
-    double wy0 = 1.0 - wy1;
-    double wz0 = 1.0 - wz1;
-
-    // Get 8 corner values
-    double a000 = getAlpha(i0, j0, k0);
-    double a001 = getAlpha(i0, j0, k1);
-    double a010 = getAlpha(i0, j1, k0);
-    double a011 = getAlpha(i0, j1, k1);
-    double a100 = getAlpha(i1, j0, k0);
-    double a101 = getAlpha(i1, j0, k1);
-    double a110 = getAlpha(i1, j1, k0);
-    double a111 = getAlpha(i1, j1, k1);
-
-    // Trilinear interpolation
-    double result =
-        a000 * wx0 * wy0 * wz0 +
-        a001 * wx0 * wy0 * wz1 +
-        a010 * wx0 * wy1 * wz0 +
-        a011 * wx0 * wy1 * wz1 +
-        a100 * wx1 * wy0 * wz0 +
-        a101 * wx1 * wy0 * wz1 +
-        a110 * wx1 * wy1 * wz0 +
-        a111 * wx1 * wy1 * wz1;
-
+    // Trilinear interpolation of α at an arbitrary position
+    double result;
+    interpolateBlock(config_, alpha_.data(), config_.alpha_max, &pos.x, &pos.y, &pos.z, 1, false, &result);
     return result;
 }
 
@@ -12,13 +12,18 @@
 #pragma once
 
 #include <complex>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
 namespace dase {
+class CheckpointWriter;
+class CheckpointImage;
 namespace igsoa {
 namespace gw {
 
+class SlabDecomposition;
+
 /**
  * 3D Vector for spatial coordinates
  */
@@ -60,6 +65,8 @@ struct SymmetryFieldConfig {
     // Grid dimensions
     int nx, ny, nz;          // Number of grid points in each dimension
     double dx, dy, dz;       // Grid spacing in meters
+    double origin_x, origin_y, origin_z;  // Position of global point (0,0,0) (0 = domain corner;
+                                          // mesh refinement patches sit inside the domain)
 
     // Physical parameters
     double R_c_default;      // Default coupling constant
@@ -73,6 +80,9 @@ struct SymmetryFieldConfig {
     // Time evolution
     double dt;               // Timestep in seconds
 
+    // Domain decomposition
+    int k_offset;            // Global z-index of local plane 0 (0 = whole grid)
+
     SymmetryFieldConfig();
 };
 
@@ -131,6 +141,29 @@ public:
      */
     double getAlphaAt(const Vector3D& position) const;
 
+    /**
+     * Overwrite δΦ at flat indices (values[n] at indices[n]) and refresh the
+     * cached potential there, so the next evolveStep sees it; the gradient
+     * cache is refreshed by that step.  Used by mesh refinement to write
+     * patch boundaries and restricted values.
+     */
+    void assignDeltaPhi(const std::vector<int>& indices, const std::complex<double>* values);
+
+    /**
+     * Batched getDeltaPhiAt / getAlphaAt: out[n] at (x[n], y[n], z[n]) for
+     * n < count, computed by the same kernel as the single-point calls (0 /
+     * alpha_max outside the grid).  Positions are processed in blocks whose cell
+     * indices and weights are computed in one vectorized pass before the
+     * corner gather, and large batches run in parallel.  prefetch issues
+     * software prefetches for the corners of points a few ahead; it pays
+     * on grids much larger than cache when consecutive positions are
+     * spatially coherent (sorted along a path or by cell).
+     */
+    void getDeltaPhiAt(const double* x, const double* y, const double* z, size_t count,
+                       std::complex<double>* out, bool prefetch = false) const;
+    void getAlphaAt(const double* x, const double* y, const double* z, size_t count,
+                    double* out, bool prefetch = false) const;
+
     /**
      * Get flat array of all δΦ values (for FractionalSolver)
      * @return Reference to internal storage
@@ -143,6 +176,35 @@ public:
      */
     std::vector<double> getAlphaValues() const;
 
+    /**
+     * Get flat array of all α values without copying
+     * @return Reference to internal storage
+     */
+    const std::vector<double>& getAlphaFlat() const { return alpha_; }
+
+    /**
+     * Get cached |∇δΦ| and V(δΦ) arrays (flat storage)
+     */
+    const std::vector<double>& getGradientMagnitudeFlat() const { return gradient_magnitude_; }
+    const std::vector<double>& getPotentialFlat() const { return potential_; }
+
+    /**
+     * Counter bumped on every α change; callers compare it to decide when to
+     * rebind FractionalSolver::setPointAlphas
+     */
+    uint64_t getAlphaRevision() const { return alpha_revision_; }
+
+    /**
+     * Bytes held by the field grids (δΦ and its back buffer, α, and the
+     * cached |∇δΦ| and V(δΦ))
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * getMemoryUsage() of a field built from `config`
+     */
+    static size_t estimateMemoryUsage(const SymmetryFieldConfig& config);
+
     // === Spatial Derivatives ===
 
     /**
@@ -196,6 +258,11 @@ public:
      *
      * @param fractional_derivatives Computed by FractionalSolver
      * @param source_terms Source S(x,t) from binary system
+     *
+     * Writes into a persistent back buffer and refreshes the gradient and
+     * potential caches in the same sweep (parallel over z-slabs with OpenMP);
+     * results are bit-identical to the per-point helpers.  The same sweep
+     * accumulates the per-plane totals the diagnostics below read.
      */
     void evolveStep(
         const std::vector<std::complex<double>>& fractional_derivatives,
@@ -207,11 +274,47 @@ public:
      */
     double getCurrentTime() const { return current_time_; }
 
+    // === Domain Decomposition ===
+
+    /**
+     * Attach the slab decomposition this (local) field belongs to
+     *
+     * The field must have been built from decomposition->makeLocalConfig.
+     * evolveStep then refreshes the ghost planes after every step, and the
+     * diagnostics reduce over owned planes of all ranks (collective calls).
+     * Pass nullptr to detach.  The decomposition must outlive the field.
+     */
+    void setDecomposition(const SlabDecomposition* decomposition);
+    const SlabDecomposition* getDecomposition() const { return decomposition_; }
+
+    /**
+     * Collective: refresh ghost planes (field, potential) from neighbouring
+     * ranks and the gradient cache of the owned planes next to them.  No-op
+     * without a multi-rank decomposition.  Call after changing δΦ directly.
+     */
+    void exchangeHalos();
+
     /**
      * Set current simulation time
      */
     void setCurrentTime(double t) { current_time_ = t; }
 
+    /**
+     * Return to the constructed state with new couplings: δΦ, the caches
+     * and the clock cleared and α uniform.  Grid and dt are unchanged (the
+     * solver kernels depend on dt); bumps the α revision.
+     */
+    void reset(double alpha, double R_c_default, double kappa);
+
+    /**
+     * Checkpoint δΦ, α and the clock (engine_checkpoint.h):
+     *   gw.delta_phi  c128, gw.alpha  f64, gw.field_clock  f64 [time]
+     * The gradient / potential caches are rebuilt on restore, which bumps
+     * the α revision; throws std::runtime_error on a grid mismatch.
+     */
+    void saveCheckpoint(CheckpointWriter& writer) const;
+    void restoreCheckpoint(const CheckpointImage& image);
+
     /**
      * Get timestep
      */
@@ -239,16 +342,23 @@ public:
     void fromFlatIndex(int idx, int& i, int& j, int& k) const;
 
     /**
-     * Convert grid indices to physical position
+     * Convert local grid indices to physical position (global coordinates)
      */
     Vector3D toPosition(int i, int j, int k) const;
 
     /**
-     * Convert physical position to grid indices (nearest)
+     * Convert physical position to local grid indices (nearest)
      */
     void toIndices(const Vector3D& pos, int& i, int& j, int& k) const;
 
     // === Diagnostics ===
+    //
+    // Reduced from per-plane totals (Σ|δΦ|² dV, Σ|δΦ|, max |δΦ|², Σ|∇δΦ|,
+    // max |∇δΦ|), each summed in index order and combined in plane order:
+    // bit-identical for any thread count.  After evolveStep the totals come
+    // from its sweep at no extra grid pass; setDeltaPhi, updateGradientCache,
+    // reset and restoreCheckpoint make the next call recompute them with the
+    // same arithmetic.
 
     /**
      * Compute total energy ∫ |δΦ|² dV
@@ -277,17 +387,38 @@ public:
      */
     void exportToFile(const std::string& filename) const;
 
+    /**
+     * Export field as a binary snapshot (see field_snapshot.h for the
+     * format; use FieldSnapshotWriter to write in the background)
+     */
+    void exportBinary(const std::string& filename) const;
+
 private:
     SymmetryFieldConfig config_;
 
     // 3D grids (flattened storage: [nx * ny * nz])
     std::vector<std::complex<double>> delta_phi_;     // δΦ(x,y,z)
+    std::vector<std::complex<double>> delta_phi_next_; // evolveStep back buffer
     std::vector<double> alpha_;                       // α(x,y,z) memory order
+    uint64_t alpha_revision_;                         // Bumped by setAlpha
     std::vector<double> gradient_magnitude_;          // |∇δΦ| (cached)
     std::vector<double> potential_;                   // V(δΦ) (cached)
 
     double current_time_;
 
+    const SlabDecomposition* decomposition_;         // Not owned; nullptr = whole grid
+
+    // Per-plane diagnostics totals (see Diagnostics)
+    struct PlaneStats {
+        double energy = 0.0;        // Σ |δΦ|² dV
+        double amplitude = 0.0;     // Σ |δΦ|
+        double max_norm = 0.0;      // max |δΦ|²
+        double gradient = 0.0;      // Σ |∇δΦ|
+        double max_gradient = 0.0;  // max |∇δΦ|
+    };
+    std::vector<PlaneStats> plane_stats_;
+    bool plane_stats_valid_;         // plane_stats_ describe δΦ and the gradient cache
+
     // Helper: check if indices are valid
     bool isValidIndex(int i, int j, int k) const;
 
@@ -297,6 +428,23 @@ private:
 
     // Helper: validate configuration parameters
     void validateConfig() const;
+
+    // Helpers for evolveStep: advance plane k into delta_phi_next_ (and its
+    // potential), then refresh the gradient cache of plane k from a field
+    void evolvePlane(int k,
+                     const std::complex<double>* fractional_derivatives,
+                     const std::complex<double>* source_terms);
+    void updateGradientPlane(int k, const std::complex<double>* phi);
+
+    // Helper: local planes [k_begin, k_end) owned by this rank
+    void ownedPlanes(int& k_begin, int& k_end) const;
+
+    // Helper: field / gradient totals of plane k, recomputed from the grids
+    void computePlaneStats(int k, PlaneStats& stats) const;
+
+    // Helper: totals over the owned planes of this rank (not reduced across
+    // ranks); maxima in the max fields
+    PlaneStats ownedTotals() const;
 };
 
 } // namespace gw
@@ -0,0 +1,260 @@
+/**
+ * IGSOA Gravitational Wave Engine - Waveform Template Banks Implementation
+ */
+
+#include "template_bank.h"
+#include "utils/logger.h"
+#include "trace_zones.h"
+#include <algorithm>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+namespace {
+
+const char kBankMagic[8] = {'I', 'G', 'S', 'O', 'A', 'T', 'B', '1'};
+const uint32_t kBankVersion = 1;
+const uint32_t kBankHeaderBytes = 64;
+
+bool hostIsLittleEndian() {
+    const uint16_t probe = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+struct FileCloser {
+    void operator()(std::FILE* f) const { if (f) std::fclose(f); }
+};
+using FileHandle = std::unique_ptr<std::FILE, FileCloser>;
+
+void writeBlock(std::FILE* f, const void* data, size_t bytes, const std::string& filename) {
+    if (bytes > 0 && std::fwrite(data, 1, bytes, f) != bytes) {
+        throw std::runtime_error("Failed writing template bank: " + filename);
+    }
+}
+
+// Bytes of the per-step buffers of one member (second derivatives,
+// fractional derivatives, combined and echo sources)
+size_t memberScratchBytes(int points) {
+    return 4 * static_cast<size_t>(points) * sizeof(std::complex<double>);
+}
+
+} // namespace
+
+TemplateBankConfig::TemplateBankConfig()
+    : enable_echoes(true)
+    , sampling(ProjectionOperators::ObserverSampling::NearestPoint)
+    , num_steps(1000)
+    , sample_interval(1)
+    , threads_per_member(1)
+    , concurrent_members(0)
+{
+}
+
+TemplateBank::TemplateBank(const TemplateBankConfig& config, const std::vector<TemplateParameters>& members)
+    : config_(config)
+    , members_(members)
+    , samples_(0)
+{
+    if (members_.empty()) {
+        throw std::invalid_argument("TemplateBank needs at least one member");
+    }
+    if (config_.observers.empty()) {
+        throw std::invalid_argument("TemplateBank needs at least one observer");
+    }
+    if (config_.sample_interval < 1 || config_.num_steps < config_.sample_interval) {
+        throw std::invalid_argument("TemplateBank needs sample_interval >= 1 and num_steps >= sample_interval");
+    }
+    if (config_.threads_per_member < 1) {
+        throw std::invalid_argument("TemplateBank needs threads_per_member >= 1");
+    }
+    samples_ = config_.num_steps / config_.sample_interval;
+
+    // One α span for fields and kernels
+    double alpha_min = members_[0].alpha;
+    double alpha_max = members_[0].alpha;
+    for (const TemplateParameters& member : members_) {
+        alpha_min = std::min(alpha_min, member.alpha);
+        alpha_max = std::max(alpha_max, member.alpha);
+    }
+    config_.field.alpha_min = config_.solver.alpha_min = alpha_min;
+    config_.field.alpha_max = config_.solver.alpha_max = alpha_max;
+    config_.solver.dt = config_.field.dt;
+    config_.projection.observer_history_capacity = static_cast<size_t>(samples_);
+
+    // Kernel table for every member; its own history is a single point
+    kernels_.reset(new FractionalSolver(config_.solver, 1));
+
+    LOG_INFO("TemplateBank created: " + std::to_string(members_.size()) + " members, " +
+             std::to_string(config_.observers.size()) + " observers, " +
+             std::to_string(samples_) + " samples");
+}
+
+TemplateBank::~TemplateBank() {
+}
+
+void TemplateBank::generate() {
+    DASE_TRACE_ZONE("gw.template_bank");
+    const int members = getMemberCount();
+    const size_t member_values = static_cast<size_t>(getObserverCount()) * samples_ * 2;
+    strains_.assign(member_values * members, 0.0);
+
+#ifdef _OPENMP
+    int concurrent = config_.concurrent_members;
+    if (concurrent < 1) {
+        concurrent = std::max(1, omp_get_max_threads() / config_.threads_per_member);
+    }
+    concurrent = std::min(concurrent, members);
+
+    // Members in the outer team, each with threads_per_member inner threads
+    const int saved_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(std::max(saved_levels, 2));
+    #pragma omp parallel for num_threads(concurrent) schedule(dynamic, 1)
+    for (int m = 0; m < members; m++) {
+        omp_set_num_threads(config_.threads_per_member);
+        runMember(m, strains_.data() + member_values * m);
+    }
+    omp_set_max_active_levels(saved_levels);
+#else
+    for (int m = 0; m < members; m++) {
+        runMember(m, strains_.data() + member_values * m);
+    }
+#endif
+}
+
+std::vector<double> TemplateBank::generateMember(int m) const {
+    if (m < 0 || m >= getMemberCount()) {
+        throw std::out_of_range("TemplateBank member index out of range");
+    }
+    std::vector<double> out(static_cast<size_t>(getObserverCount()) * samples_ * 2);
+    runMember(m, out.data());
+    return out;
+}
+
+void TemplateBank::runMember(int m, double* out) const {
+    const TemplateParameters& params = members_[m];
+
+    SymmetryField field(config_.field);
+    field.reset(params.alpha, config_.field.R_c_default, config_.field.kappa);
+    FractionalSolver solver(*kernels_, field.getTotalPoints());
+    solver.setPointAlphas(field.getAlphaFlat());
+
+    BinaryMergerConfig merger_config = config_.merger;
+    merger_config.mass1 = params.mass1;
+    merger_config.mass2 = params.mass2;
+    BinaryMerger merger(merger_config);
+
+    EchoConfig echo_config = config_.echo;
+    echo_config.fundamental_timescale = params.tau0;
+    EchoGenerator echo(echo_config);
+
+    ProjectionOperators projection(config_.projection);
+    for (const Vector3D& position : config_.observers) {
+        projection.registerObserver(field, position, config_.sampling);
+    }
+
+    // Same step as the CLI GW mission, plus echo sources after detection
+    const int total_points = field.getTotalPoints();
+    const double dt = field.getTimestep();
+    std::vector<std::complex<double>> second_derivs(total_points, std::complex<double>(0.0, 0.0));
+    std::vector<std::complex<double>> frac_derivs;
+    std::vector<std::complex<double>> combined;
+    std::vector<std::complex<double>> echo_sources;
+    solver.computeDerivatives(frac_derivs);
+    bool merged = false;
+    for (int step = 1; step <= config_.num_steps; step++) {
+        const double t = field.getCurrentTime();
+        const std::vector<std::complex<double>>* sources = &merger.updateSourceTerms(field, t);
+        if (config_.enable_echoes) {
+            if (!merged) {
+                merged = echo.detectMerger(field, t);
+            }
+            if (merged) {
+                echo.computeEchoSourceField(t, field, merger_config.center, echo_sources);
+                combined.assign(sources->begin(), sources->end());
+                for (int i = 0; i < total_points; i++) {
+                    combined[i] += echo_sources[i];
+                }
+                sources = &combined;
+            }
+        }
+        field.evolveStep(frac_derivs, *sources);
+        solver.updateHistoryAndDerivatives(second_derivs, dt, frac_derivs);
+        merger.evolveOrbit(dt);
+        field.setCurrentTime(t + dt);
+        if (step % config_.sample_interval == 0) {
+            projection.sampleObservers(field);
+        }
+    }
+
+    std::vector<ProjectionOperators::StrainSample> history;
+    for (int o = 0; o < getObserverCount(); o++) {
+        projection.copyObserverHistory(o, history);
+        double* series = out + static_cast<size_t>(o) * samples_ * 2;
+        for (int s = 0; s < samples_; s++) {
+            series[2 * s] = history[s].strain.h_plus;
+            series[2 * s + 1] = history[s].strain.h_cross;
+        }
+    }
+}
+
+void TemplateBank::write(const std::string& filename) const {
+    DASE_TRACE_ZONE("gw.template_bank_write");
+    if (!hostIsLittleEndian()) {
+        throw std::runtime_error("Template bank files require a little-endian host");
+    }
+    if (strains_.empty()) {
+        throw std::runtime_error("TemplateBank::write called before generate");
+    }
+
+    unsigned char header[kBankHeaderBytes] = {};
+    const int32_t dims[4] = {getMemberCount(), getObserverCount(), samples_, 0};
+    const double timing[2] = {getSampleInterval(), getSampleInterval()};
+    std::memcpy(header, kBankMagic, sizeof(kBankMagic));
+    std::memcpy(header + 8, &kBankVersion, 4);
+    std::memcpy(header + 12, &kBankHeaderBytes, 4);
+    std::memcpy(header + 16, dims, sizeof(dims));
+    std::memcpy(header + 32, timing, sizeof(timing));
+
+    std::vector<double> table;
+    table.reserve(members_.size() * 4);
+    for (const TemplateParameters& member : members_) {
+        table.push_back(member.mass1);
+        table.push_back(member.mass2);
+        table.push_back(member.alpha);
+        table.push_back(member.tau0);
+    }
+
+    FileHandle file(std::fopen(filename.c_str(), "wb"));
+    if (!file) {
+        throw std::runtime_error("Cannot open file for export: " + filename);
+    }
+    writeBlock(file.get(), header, sizeof(header), filename);
+    writeBlock(file.get(), table.data(), table.size() * sizeof(double), filename);
+    writeBlock(file.get(), strains_.data(), strains_.size() * sizeof(double), filename);
+    if (std::fclose(file.release()) != 0) {
+        throw std::runtime_error("Failed writing template bank: " + filename);
+    }
+}
+
+size_t TemplateBank::getMemoryUsage() const {
+    const int points = config_.field.nx * config_.field.ny * config_.field.nz;
+    return strains_.capacity() * sizeof(double) +
+           SymmetryField::estimateMemoryUsage(config_.field) +
+           FractionalSolver::estimateMemoryUsage(config_.solver, points) +
+           memberScratchBytes(points);
+}
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,159 @@
+/**
+ * IGSOA Gravitational Wave Engine - Waveform Template Banks
+ *
+ * Generates detector strains for a bank of (m₁, m₂, α, τ₀) members on one
+ * grid.  What does not depend on the member is built once:
+ *
+ *   - the SOE kernel table over the bank's α span (one FractionalSolver,
+ *     copied into every member solver without refitting),
+ *   - the grid and the observer stencils (fixed by SymmetryFieldConfig and
+ *     the detector positions).
+ *
+ * Members run concurrently, each on its own field, solver, orbit and echo
+ * generator with a fixed OpenMP thread budget (nested parallelism), and
+ * record only the registered observers' (h₊, h×) every sample_interval
+ * steps, straight into their slice of one contiguous strain array.  Every
+ * member's strain is bit-identical to running it alone, whatever the
+ * concurrency.
+ *
+ * Bank files are a fixed little-endian header, the member table and the
+ * strain array, each written as one block:
+ *
+ *   offset  size        content
+ *   0       8           magic "IGSOATB1"
+ *   8       4           uint32 format version (1)
+ *   12      4           uint32 header size in bytes (64)
+ *   16      12          int32 members M, observers O, samples S
+ *   28      4           int32 reserved (0)
+ *   32      16          float64 sample_dt, first sample time
+ *   48      16          reserved (0)
+ *   64      32·M        float64 mass1, mass2, alpha, tau0 per member
+ *   ...     16·M·O·S    float64 (h₊, h×) pairs, index ((m·O + o)·S + s)
+ */
+
+#pragma once
+
+#include "echo_generator.h"
+#include "fractional_solver.h"
+#include "projection_operators.h"
+#include "source_manager.h"
+#include "symmetry_field.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+namespace gw {
+
+/**
+ * Parameters that vary across the bank
+ */
+struct TemplateParameters {
+    double mass1;            // Solar masses
+    double mass2;
+    double alpha;            // Uniform fractional order of the member's field
+    double tau0;             // Echo fundamental timescale τ₀ (s)
+
+    TemplateParameters() : mass1(30.0), mass2(30.0), alpha(1.5), tau0(0.001) {}
+    TemplateParameters(double m1, double m2, double a, double t)
+        : mass1(m1), mass2(m2), alpha(a), tau0(t) {}
+};
+
+/**
+ * Shared configuration of a template bank
+ *
+ * field.alpha_min / alpha_max and solver.alpha_min / alpha_max are replaced
+ * by the bank's α span, merger.mass1 / mass2 and echo.fundamental_timescale
+ * by each member's parameters.  Member α is quantized to the solver's
+ * kernel table like any FractionalSolver (exact when the member α values
+ * are solver.alpha_table_size uniform samples of the span).
+ */
+struct TemplateBankConfig {
+    SymmetryFieldConfig field;
+    FractionalSolverConfig solver;
+    BinaryMergerConfig merger;
+    EchoConfig echo;
+    bool enable_echoes;                 // Add echo sources after merger detection
+
+    ProjectionConfig projection;
+    std::vector<Vector3D> observers;    // Detector positions
+    ProjectionOperators::ObserverSampling sampling;
+
+    int num_steps;
+    int sample_interval;                // Steps between recorded samples
+
+    int threads_per_member;             // OpenMP threads inside each member
+    int concurrent_members;             // 0 = max_threads / threads_per_member
+
+    TemplateBankConfig();
+};
+
+/**
+ * Batched waveform template generator
+ */
+class TemplateBank {
+public:
+    /**
+     * Build the shared kernel table for the members' α span
+     * @throws std::invalid_argument on an empty bank, no observers,
+     *         sample_interval < 1, num_steps < sample_interval or
+     *         threads_per_member < 1
+     */
+    TemplateBank(const TemplateBankConfig& config, const std::vector<TemplateParameters>& members);
+
+    ~TemplateBank();
+
+    TemplateBank(const TemplateBank&) = delete;
+    TemplateBank& operator=(const TemplateBank&) = delete;
+
+    /**
+     * Run every member (results replace any earlier generate())
+     */
+    void generate();
+
+    /**
+     * Run member m alone on the calling thread's OpenMP settings and
+     * return its (h₊, h×) pairs in bank order ((o·S + s)·2); the bank's
+     * strain array is not touched
+     */
+    std::vector<double> generateMember(int m) const;
+
+    int getMemberCount() const { return static_cast<int>(members_.size()); }
+    int getObserverCount() const { return static_cast<int>(config_.observers.size()); }
+    int getSampleCount() const { return samples_; }
+    double getSampleInterval() const { return config_.field.dt * config_.sample_interval; }
+
+    const TemplateParameters& getMember(int m) const { return members_[m]; }
+
+    /**
+     * Contiguous (h₊, h×) array of the last generate(), index
+     * ((m·O + o)·S + s)·2 (+1 for h×)
+     */
+    const std::vector<double>& getStrains() const { return strains_; }
+
+    /**
+     * Write the bank in the binary format above
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void write(const std::string& filename) const;
+
+    /**
+     * Strain array plus the per-member working set of one running member
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    TemplateBankConfig config_;
+    std::vector<TemplateParameters> members_;
+    int samples_;
+    std::unique_ptr<FractionalSolver> kernels_;   // Shared kernel table (no history used)
+    std::vector<double> strains_;
+
+    // Helper: evolve member m, writing its strains to out (O·S·2 doubles)
+    void runMember(int m, double* out) const;
+};
+
+} // namespace gw
+} // namespace igsoa
+} // namespace dase
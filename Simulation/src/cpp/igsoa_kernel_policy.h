@@ -0,0 +1,140 @@
+/**
+ * IGSOA Coupling Kernel Policies
+ *
+ * The non-local coupling sum 𝒦[Ψ]_i = ∑_j K(|r_j - r_i|, R_c) (Ψ_j - Ψ_i)
+ * runs over the neighbours within R_c.  K is a policy type, so the physics
+ * templates inline it into their direct loops and the stencil / graph
+ * builders precompute their weight tables from it:
+ *
+ *   struct Kernel {
+ *       static constexpr IGSOAKernelPolicy id;
+ *       static constexpr double support;               // K = 0 beyond support · R_c
+ *       static double evaluate(double r, double R_c);  // 0 for r <= 0 or R_c <= 0
+ *   };
+ *
+ * evaluate() is a single select over straight-line arithmetic (no early
+ * return), so loops filling a weight table vectorize.
+ *
+ * Built-in laws (q = r / R_c):
+ *
+ *   Exponential  exp(-q) / R_c           default; bit-exact with the goldens
+ *   Gaussian     exp(-2 q²) / R_c        σ = R_c / 2, cut off at 2σ
+ *   Wendland     (1 - q)⁴ (4q + 1) / R_c  C² Wendland ψ₃,₁; zero at q = 1
+ *
+ * support <= 1 for every law: the lattice paths enumerate offsets within
+ * ceil(R_c), and the halos, temporal blocks, slab ghost planes and fixed
+ * stencil shapes are all sized from it.  A law may vanish inside R_c but
+ * never reaches beyond it.
+ *
+ * Engines keep the law as a runtime IGSOAKernelPolicy
+ * (IGSOAComplexConfig::kernel_policy) and step through withKernelPolicy(),
+ * which calls its functor with the matching policy object: each law is its
+ * own instantiation of the step, with no indirect call per term.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace dase {
+namespace igsoa {
+
+/**
+ * Coupling law of an engine, selected by name through the CLI
+ */
+enum class IGSOAKernelPolicy : uint8_t {
+    Exponential = 0,
+    Gaussian = 1,
+    Wendland = 2
+};
+
+struct ExponentialKernel {
+    static constexpr IGSOAKernelPolicy id = IGSOAKernelPolicy::Exponential;
+    static constexpr double support = 1.0;
+
+    static inline double evaluate(double distance, double R_c) {
+        return (distance > 0.0 && R_c > 0.0) ? std::exp(-distance / R_c) / R_c : 0.0;
+    }
+};
+
+struct GaussianKernel {
+    static constexpr IGSOAKernelPolicy id = IGSOAKernelPolicy::Gaussian;
+    static constexpr double support = 1.0;
+
+    static inline double evaluate(double distance, double R_c) {
+        const double q = distance / R_c;
+        return (distance > 0.0 && R_c > 0.0) ? std::exp(-2.0 * q * q) / R_c : 0.0;
+    }
+};
+
+struct WendlandKernel {
+    static constexpr IGSOAKernelPolicy id = IGSOAKernelPolicy::Wendland;
+    static constexpr double support = 1.0;
+
+    static inline double evaluate(double distance, double R_c) {
+        const double q = distance / R_c;
+        const double t = std::max(1.0 - q, 0.0);
+        const double t2 = t * t;
+        return (distance > 0.0 && R_c > 0.0) ? t2 * t2 * (4.0 * q + 1.0) / R_c : 0.0;
+    }
+};
+
+static_assert(ExponentialKernel::support <= 1.0 && GaussianKernel::support <= 1.0 &&
+              WendlandKernel::support <= 1.0,
+              "coupling kernels must vanish beyond R_c (lattice reach is ceil(R_c))");
+
+/**
+ * Call f(Kernel{}) with the policy type of `policy` and return its result
+ */
+template <typename F>
+inline decltype(auto) withKernelPolicy(IGSOAKernelPolicy policy, F&& f) {
+    switch (policy) {
+        case IGSOAKernelPolicy::Gaussian:
+            return f(GaussianKernel{});
+        case IGSOAKernelPolicy::Wendland:
+            return f(WendlandKernel{});
+        case IGSOAKernelPolicy::Exponential:
+        default:
+            return f(ExponentialKernel{});
+    }
+}
+
+/**
+ * K(distance, R_c) under `policy`, for table builders outside the step
+ */
+inline double kernelWeight(IGSOAKernelPolicy policy, double distance, double R_c) {
+    return withKernelPolicy(policy, [&](auto kernel) {
+        return decltype(kernel)::evaluate(distance, R_c);
+    });
+}
+
+inline bool parseKernelPolicy(const std::string& name, IGSOAKernelPolicy& out) noexcept {
+    if (name == "exponential") {
+        out = IGSOAKernelPolicy::Exponential;
+        return true;
+    }
+    if (name == "gaussian") {
+        out = IGSOAKernelPolicy::Gaussian;
+        return true;
+    }
+    if (name == "wendland") {
+        out = IGSOAKernelPolicy::Wendland;
+        return true;
+    }
+    return false;
+}
+
+inline const char* kernelPolicyName(IGSOAKernelPolicy policy) noexcept {
+    switch (policy) {
+        case IGSOAKernelPolicy::Gaussian: return "gaussian";
+        case IGSOAKernelPolicy::Wendland: return "wendland";
+        case IGSOAKernelPolicy::Exponential:
+        default: return "exponential";
+    }
+}
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,370 @@
+/**
+ * IGSOA Neighbor Graph (CSR coupling rows for per-node R_c)
+ *
+ * A lattice whose R_c varies per node cannot share one translation-invariant
+ * NeighborStencil2D/3D table, so the direct path re-enumerates every node's
+ * R_c box each step (wrapped distances, cutoff test and exp() per
+ * candidate).  IGSOANeighborGraph packs those rows once in compressed
+ * sparse row form:
+ *
+ *   row_offsets_[i] .. row_offsets_[i + 1]   entries of node i
+ *   index_[k]    neighbour node id (uint32)
+ *   weight_[k]   K(d, R_c_i) under the engine's coupling law
+ *                (igsoa_kernel_policy.h; default exp(-d/R_c_i) / R_c_i)
+ *   weight32_[k] weight_ rounded to float (IGSOAPrecision::Float sums)
+ *
+ * Rows hold the direct loop's terms in its order (dy outer, dx inner in 2D;
+ * dz, dy, dx in 3D, periodic aliases included) with the same cutoff test,
+ * so double sums are bit-identical to the direct path.
+ *
+ * build() runs two parallel passes over the rows (count, then fill into
+ * the exclusive scan of the counts).  refresh() compares each node's R_c
+ * with the value its row was built for and rebuilds only the changed rows:
+ * in place when their lengths are kept, otherwise the unchanged rows are
+ * copied around them into a repacked graph.  A new coupling law is a full
+ * build().
+ */
+
+#pragma once
+
+#include "igsoa_complex_node.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+template <int Dim>
+class IGSOANeighborGraph {
+    static_assert(Dim == 2 || Dim == 3, "IGSOANeighborGraph is 2D or 3D");
+
+public:
+    /**
+     * Pack the rows of every node (call outside a parallel region)
+     *
+     * @return false (graph cleared) if the lattice does not match nodes or
+     *         its node ids do not fit the uint32 index
+     */
+    bool build(const std::vector<IGSOAComplexNode>& nodes,
+               size_t N_x, size_t N_y, size_t N_z,
+               size_t min_parallel_nodes,
+               IGSOAKernelPolicy kernel = IGSOAKernelPolicy::Exponential) {
+        clear();
+        kernel_ = kernel;
+        const size_t num_rows = N_x * N_y * N_z;
+        if (num_rows == 0 || num_rows != nodes.size() ||
+            num_rows > std::numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+        extent_[0] = N_x;
+        extent_[1] = N_y;
+        extent_[2] = N_z;
+        row_R_c_.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            row_R_c_[i] = nodes[i].R_c;
+        }
+
+        // 1. Count
+        std::vector<uint64_t> counts(num_rows);
+        const int64_t rows = static_cast<int64_t>(num_rows);
+        #pragma omp parallel for schedule(static) if(num_rows >= min_parallel_nodes)
+        for (int64_t r = 0; r < rows; ++r) {
+            counts[static_cast<size_t>(r)] = countRow(static_cast<size_t>(r), row_R_c_[static_cast<size_t>(r)]);
+        }
+
+        // 2. Exclusive scan, then fill each row at its offset
+        row_offsets_ = scan(counts);
+        allocate(row_offsets_.back());
+        #pragma omp parallel for schedule(static) if(num_rows >= min_parallel_nodes)
+        for (int64_t r = 0; r < rows; ++r) {
+            fillRow(static_cast<size_t>(r), row_R_c_[static_cast<size_t>(r)], row_offsets_[static_cast<size_t>(r)]);
+        }
+        rebuilt_rows_ = num_rows;
+        return true;
+    }
+
+    /**
+     * Bring the graph up to date with the nodes' R_c (call outside a
+     * parallel region); a new lattice shape is a full build()
+     *
+     * @return false if no usable graph exists (see build())
+     */
+    bool refresh(const std::vector<IGSOAComplexNode>& nodes,
+                 size_t N_x, size_t N_y, size_t N_z,
+                 size_t min_parallel_nodes,
+                 IGSOAKernelPolicy kernel = IGSOAKernelPolicy::Exponential) {
+        if (!matches(N_x, N_y, N_z) || row_R_c_.size() != nodes.size() || kernel != kernel_) {
+            return build(nodes, N_x, N_y, N_z, min_parallel_nodes, kernel);
+        }
+        const size_t num_rows = row_R_c_.size();
+        const int64_t rows = static_cast<int64_t>(num_rows);
+        changed_.resize(num_rows);
+
+        // New lengths of the changed rows (unchanged rows keep theirs)
+        std::vector<uint64_t> counts(num_rows);
+        size_t changed_rows = 0;
+        bool lengths_kept = true;
+        #pragma omp parallel for schedule(static) reduction(+:changed_rows) reduction(&&:lengths_kept) \
+            if(num_rows >= min_parallel_nodes)
+        for (int64_t r = 0; r < rows; ++r) {
+            const size_t i = static_cast<size_t>(r);
+            const uint64_t length = row_offsets_[i + 1] - row_offsets_[i];
+            changed_[i] = nodes[i].R_c != row_R_c_[i];
+            counts[i] = changed_[i] ? countRow(i, nodes[i].R_c) : length;
+            changed_rows += changed_[i];
+            lengths_kept = lengths_kept && counts[i] == length;
+        }
+        rebuilt_rows_ = changed_rows;
+        if (changed_rows == 0) {
+            return true;
+        }
+
+        if (lengths_kept) {
+            #pragma omp parallel for schedule(static) if(num_rows >= min_parallel_nodes)
+            for (int64_t r = 0; r < rows; ++r) {
+                const size_t i = static_cast<size_t>(r);
+                if (changed_[i]) {
+                    row_R_c_[i] = nodes[i].R_c;
+                    fillRow(i, row_R_c_[i], row_offsets_[i]);
+                }
+            }
+            return true;
+        }
+
+        // Repack: changed rows are refilled, unchanged rows copied over
+        std::vector<uint64_t> old_offsets = scan(counts);
+        old_offsets.swap(row_offsets_);
+        std::vector<uint32_t> old_index;
+        std::vector<double> old_weight;
+        std::vector<float> old_weight32;
+        old_index.swap(index_);
+        old_weight.swap(weight_);
+        old_weight32.swap(weight32_);
+        allocate(row_offsets_.back());
+        #pragma omp parallel for schedule(static) if(num_rows >= min_parallel_nodes)
+        for (int64_t r = 0; r < rows; ++r) {
+            const size_t i = static_cast<size_t>(r);
+            const uint64_t begin = row_offsets_[i];
+            if (changed_[i]) {
+                row_R_c_[i] = nodes[i].R_c;
+                fillRow(i, row_R_c_[i], begin);
+                continue;
+            }
+            const uint64_t old_begin = old_offsets[i];
+            const uint64_t old_end = old_offsets[i + 1];
+            std::copy(old_index.begin() + old_begin, old_index.begin() + old_end, index_.begin() + begin);
+            std::copy(old_weight.begin() + old_begin, old_weight.begin() + old_end, weight_.begin() + begin);
+            std::copy(old_weight32.begin() + old_begin, old_weight32.begin() + old_end, weight32_.begin() + begin);
+        }
+        return true;
+    }
+
+    /**
+     * Add row i's weighted differences Σ w (src[j] - src[i]) to acc and
+     * return its term count (float_sums: float weights and partial sums,
+     * as IGSOACouplingKernels::accumulateContiguousFloat)
+     */
+    template <typename T>
+    inline uint64_t accumulate(size_t i, const T* src_re, const T* src_im, bool float_sums,
+                               double& acc_re, double& acc_im) const {
+        const uint64_t begin = row_offsets_[i];
+        const uint64_t end = row_offsets_[i + 1];
+        const uint32_t* index = index_.data();
+        if constexpr (std::is_same<T, float>::value) {
+            if (float_sums) {
+                const float* weight = weight32_.data();
+                const float self_re = src_re[i];
+                const float self_im = src_im[i];
+                float sum_re = 0.0f;
+                float sum_im = 0.0f;
+                for (uint64_t k = begin; k < end; ++k) {
+                    sum_re += weight[k] * (src_re[index[k]] - self_re);
+                    sum_im += weight[k] * (src_im[index[k]] - self_im);
+                }
+                acc_re += static_cast<double>(sum_re);
+                acc_im += static_cast<double>(sum_im);
+                return end - begin;
+            }
+        }
+        const double* weight = weight_.data();
+        const double self_re = src_re[i];
+        const double self_im = src_im[i];
+        for (uint64_t k = begin; k < end; ++k) {
+            acc_re += weight[k] * (src_re[index[k]] - self_re);
+            acc_im += weight[k] * (src_im[index[k]] - self_im);
+        }
+        return end - begin;
+    }
+
+    bool matches(size_t N_x, size_t N_y, size_t N_z) const {
+        return !row_offsets_.empty() && extent_[0] == N_x && extent_[1] == N_y && extent_[2] == N_z;
+    }
+
+    size_t numRows() const { return row_R_c_.size(); }
+    uint64_t numEntries() const { return row_offsets_.empty() ? 0 : row_offsets_.back(); }
+    uint64_t rowBegin(size_t i) const { return row_offsets_[i]; }
+    uint64_t rowEnd(size_t i) const { return row_offsets_[i + 1]; }
+    const uint32_t* index() const { return index_.data(); }
+    const double* weight() const { return weight_.data(); }
+    const float* weight32() const { return weight32_.data(); }
+
+    // Mean terms per row
+    double averageDegree() const {
+        return numRows() > 0 ? static_cast<double>(numEntries()) / static_cast<double>(numRows()) : 0.0;
+    }
+
+    // Rows (re)built by the last build() or refresh()
+    size_t lastRebuiltRows() const { return rebuilt_rows_; }
+
+    void clear() {
+        row_offsets_.clear();
+        index_.clear();
+        weight_.clear();
+        weight32_.clear();
+        row_R_c_.clear();
+        extent_[0] = extent_[1] = extent_[2] = 0;
+        rebuilt_rows_ = 0;
+    }
+
+    size_t getMemoryUsage() const {
+        return row_offsets_.capacity() * sizeof(uint64_t) +
+               index_.capacity() * sizeof(uint32_t) +
+               weight_.capacity() * sizeof(double) +
+               weight32_.capacity() * sizeof(float) +
+               row_R_c_.capacity() * sizeof(double) +
+               changed_.capacity() * sizeof(uint8_t);
+    }
+
+private:
+    // Same as IGSOAPhysics2D/3D::couplingKernel<Kernel> for the built law
+    inline double kernel(double distance, double R_c) const {
+        return kernelWeight(kernel_, distance, R_c);
+    }
+
+    // Same as IGSOAPhysics2D/3D::wrappedDistance1D
+    static inline double wrapped1D(int coord1, int coord2, size_t N) {
+        const int raw_dist = std::abs(coord1 - coord2);
+        return static_cast<double>(std::min(raw_dist, static_cast<int>(N) - raw_dist));
+    }
+
+    static std::vector<uint64_t> scan(const std::vector<uint64_t>& counts) {
+        std::vector<uint64_t> offsets(counts.size() + 1);
+        offsets[0] = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            offsets[i + 1] = offsets[i] + counts[i];
+        }
+        return offsets;
+    }
+
+    void allocate(uint64_t entries) {
+        index_.resize(entries);
+        weight_.resize(entries);
+        weight32_.resize(entries);
+    }
+
+    /**
+     * Call visit(j, weight) for each term of row i at radius R_c, in the
+     * direct loop's order and with its cutoff test
+     */
+    template <typename Visit>
+    void visitRow(size_t i, double R_c, Visit&& visit) const {
+        const size_t N_x = extent_[0];
+        const size_t N_y = extent_[1];
+        const size_t N_z = extent_[2];
+        if (N_x * N_y * N_z <= 1) {
+            return;
+        }
+        const int N_x_int = static_cast<int>(N_x);
+        const int N_y_int = static_cast<int>(N_y);
+        const int N_z_int = static_cast<int>(N_z);
+        const int x_i = static_cast<int>(i % N_x);
+        const int y_i = static_cast<int>((i / N_x) % N_y);
+        const int z_i = static_cast<int>(i / (N_x * N_y));
+        const double radius = std::max(R_c, 0.0);
+        const int R_c_int = static_cast<int>(std::ceil(radius));
+
+        if constexpr (Dim == 2) {
+            for (int dy = -R_c_int; dy <= R_c_int; dy++) {
+                for (int dx = -R_c_int; dx <= R_c_int; dx++) {
+                    if (dx == 0 && dy == 0) continue;
+                    int x_j = (x_i + dx) % N_x_int;
+                    if (x_j < 0) x_j += N_x_int;
+                    int y_j = (y_i + dy) % N_y_int;
+                    if (y_j < 0) y_j += N_y_int;
+                    const double wx = wrapped1D(x_i, x_j, N_x);
+                    const double wy = wrapped1D(y_i, y_j, N_y);
+                    const double distance = std::sqrt(wx * wx + wy * wy);
+                    if (distance <= radius && radius > 0.0) {
+                        visit(static_cast<size_t>(y_j) * N_x + static_cast<size_t>(x_j),
+                              kernel(distance, radius));
+                    }
+                }
+            }
+        } else {
+            if (radius <= 0.0) {
+                return;
+            }
+            const double radius_sq = radius * radius;
+            for (int dz = -R_c_int; dz <= R_c_int; ++dz) {
+                for (int dy = -R_c_int; dy <= R_c_int; ++dy) {
+                    for (int dx = -R_c_int; dx <= R_c_int; ++dx) {
+                        if (dx == 0 && dy == 0 && dz == 0) continue;
+                        int x_j = (x_i + dx) % N_x_int;
+                        if (x_j < 0) x_j += N_x_int;
+                        int y_j = (y_i + dy) % N_y_int;
+                        if (y_j < 0) y_j += N_y_int;
+                        int z_j = (z_i + dz) % N_z_int;
+                        if (z_j < 0) z_j += N_z_int;
+                        const double wx = wrapped1D(x_i, x_j, N_x);
+                        const double wy = wrapped1D(y_i, y_j, N_y);
+                        const double wz = wrapped1D(z_i, z_j, N_z);
+                        const double dist_sq = wx * wx + wy * wy + wz * wz;
+                        if (dist_sq <= radius_sq) {
+                            visit((static_cast<size_t>(z_j) * N_y + static_cast<size_t>(y_j)) * N_x +
+                                      static_cast<size_t>(x_j),
+                                  kernel(std::sqrt(dist_sq), radius));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    uint64_t countRow(size_t i, double R_c) const {
+        uint64_t count = 0;
+        visitRow(i, R_c, [&](size_t, double) { ++count; });
+        return count;
+    }
+
+    void fillRow(size_t i, double R_c, uint64_t begin) {
+        uint64_t k = begin;
+        visitRow(i, R_c, [&](size_t j, double w) {
+            index_[k] = static_cast<uint32_t>(j);
+            weight_[k] = w;
+            weight32_[k] = static_cast<float>(w);
+            ++k;
+        });
+    }
+
+    size_t extent_[3] = {0, 0, 0};
+    IGSOAKernelPolicy kernel_ = IGSOAKernelPolicy::Exponential;
+    std::vector<uint64_t> row_offsets_;  // num_rows + 1 (empty = no graph)
+    std::vector<uint32_t> index_;
+    std::vector<double> weight_;
+    std::vector<float> weight32_;
+    std::vector<double> row_R_c_;        // R_c each row was built for
+    std::vector<uint8_t> changed_;       // refresh() scratch
+    size_t rebuilt_rows_ = 0;
+};
+
+using IGSOANeighborGraph2D = IGSOANeighborGraph<2>;
+using IGSOANeighborGraph3D = IGSOANeighborGraph<3>;
+
+} // namespace igsoa
+} // namespace dase
@@ -21,9 +21,18 @@
 #pragma once
 
 #include "igsoa_complex_node.h"
+#include "igsoa_simd_coupling.h"
+#include "igsoa_fixed_stencil.h"
+#include "igsoa_runge_kutta.h"
+#include "reproducible_sum.h"
+#include "igsoa_state_soa.h"
+#include "trace_zones.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 
 namespace dase {
@@ -33,24 +42,31 @@ namespace igsoa {
  * IGSOA Physics Engine
  *
  * Implements time evolution of the IGSOA system
+ *
+ * Threading: the per-node kernels use orphaned `omp for` worksharing, so they
+ * run serially when called on their own and split across the team when
+ * called from inside the single parallel region opened by timeStep().  Each
+ * kernel returns the operation count of the calling thread's share; timeStep
+ * reduces the partial counts.
  */
 class IGSOAPhysics {
 public:
     /**
      * Compute non-local coupling kernel
      *
-     * K(r, R_c) = exp(-r/R_c) / R_c
+     * K(r, R_c) = exp(-r/R_c) / R_c  (default ExponentialKernel)
      *
      * This provides exponential decay of coupling strength with distance,
-     * normalized by the causal radius R_c.
+     * normalized by the causal radius R_c.  Other laws are policy types
+     * (igsoa_kernel_policy.h).
      *
      * @param distance Spatial distance between nodes
      * @param R_c Causal coupling radius
      * @return Coupling strength
      */
+    template <typename Kernel = ExponentialKernel>
     static inline double couplingKernel(double distance, double R_c) {
-        if (distance <= 0.0 || R_c <= 0.0) return 0.0;
-        return std::exp(-distance / R_c) / R_c;
+        return Kernel::evaluate(distance, R_c);
     }
 
     /**
@@ -75,71 +91,183 @@ public:
      *
      * Where:
      * - 𝒦[Ψ] = ∑_{j: |j-i| ≤ R_c} K(|j-i|, R_c) Ψ_j  (causal derivative)
-     * - K(r, R_c) = exp(-r/R_c) / R_c  (coupling kernel)
+     * - K(r, R_c) = exp(-r/R_c) / R_c  (coupling kernel; the Kernel policy)
      * - V_eff(Φ) = κΦ is coupling to realized field
      * - iΓ is non-Hermitian term (dissipation)
      *
      * Computational complexity: O(N × R_c) per time step
      *
+     * Neighbour Ψ values are streamed from the packed SoA arrays.  In
+     * InPlace mode each updated Ψ is written through to both layouts so the
+     * legacy update order is unchanged; in DoubleBuffered mode the SoA arrays
+     * keep the previous step's Ψ and only the nodes receive the new value.
+     *
      * @param nodes Network of IGSOA nodes
+     * @param soa Packed neighbour-read state (refreshed from nodes here)
      * @param dt Time step
      * @param hbar Reduced Planck constant (default: 1.0 in natural units)
+     * @param mode Ψ update ordering
+     * @param use_simd Allow the AVX2/FMA accumulation kernel when the CPU has it
+     * @param integrator Time integrator (RK2/RK4 need soa.reserveStages())
+     * @param precision Ψ mirror precision for Euler steps (float modes need
+     *                  soa.reservePrecision())
+     * @param drive Optional uniform drive applied to the nodes by the Ψ
+     *              gather (applyDriving fused into the step's first pass)
      */
+    template <typename Kernel = ExponentialKernel>
     static uint64_t evolveQuantumState(
         std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
         double dt,
-        double hbar = 1.0
+        double hbar = 1.0,
+        IGSOAUpdateMode mode = IGSOAUpdateMode::InPlace,
+        bool use_simd = true,
+        IGSOAIntegrator integrator = IGSOAIntegrator::Euler,
+        IGSOAPrecision precision = IGSOAPrecision::Double,
+        const std::complex<double>* drive = nullptr
     ) {
         const size_t N = nodes.size();
         uint64_t neighbor_operations = 0;
 
-        // Evolve each node with non-local coupling
-        for (size_t i = 0; i < N; i++) {
-            auto& node = nodes[i];
-
-            // Compute effective potential from realized field
-            std::complex<double> V_eff = node.kappa * node.phi;
-
-            // NON-LOCAL SPATIAL COUPLING (Causal Derivative Operator 𝒦)
-            // Sum over all neighbors within causal radius R_c
-            std::complex<double> nonlocal_coupling(0.0, 0.0);
-
-            // DIAGNOSTIC: Print once to verify this code path is active
-            static bool diagnostic_printed = false;
-            if (!diagnostic_printed && i == 0) {
-                std::cerr << "[IGSOA DIAGNOSTIC] Using CORRECTED non-local coupling (Oct 26 2025, R_c="
-                          << node.R_c << ")" << std::endl;
-                diagnostic_printed = true;
+        // Euler steps may stream a float Ψ mirror (RK stages stay double)
+        const bool float_mirror = precision != IGSOAPrecision::Double && integrator == IGSOAIntegrator::Euler;
+        const bool float_sums = float_mirror && precision == IGSOAPrecision::Float;
+        if (drive != nullptr) {
+            if (float_mirror) {
+                soa.driveAndGatherPsi32(nodes, *drive);
+            } else {
+                soa.driveAndGatherPsi(nodes, *drive);
             }
+        } else if (float_mirror) {
+            soa.gatherPsi32(nodes);
+        } else {
+            soa.gatherPsi(nodes);
+        }
+        double* psi_re = soa.psi_re.data();
+        double* psi_im = soa.psi_im.data();
+        float* psi32_re = soa.psi32_re.data();
+        float* psi32_im = soa.psi32_im.data();
+        const bool write_through = (mode == IGSOAUpdateMode::InPlace);
+        const bool simd = use_simd && IGSOACouplingKernels::avx2Available();
+
+        // Interior weight span for the current R_c (per thread: this frame is
+        // private to each team member).  Index m covers offset m - reach.
+        std::vector<double> span_weights;
+        std::vector<float> span_weights32;
+        double span_R_c = -1.0;
+        uint64_t span_neighbors = 0;
+        int span_fixed_radius = 0;   // Compile-time span for R_c = 1..4
+
+        // DIAGNOSTIC: Print once to verify this code path is active (thread-safe)
+        static std::once_flag diagnostic_flag;
+        if (N > 0) {
+            std::call_once(diagnostic_flag, [&]() {
+                std::cerr << "[IGSOA DIAGNOSTIC] Using CORRECTED non-local coupling (Oct 26 2025, R_c="
+                          << nodes[0].R_c << ")" << std::endl;
+            });
+        }
+
+        // NON-LOCAL SPATIAL COUPLING (Causal Derivative Operator 𝒦)
+        // Sum over all neighbors within causal radius R_c of the Ψ arrays
+        // src_re/src_im (double, or the float mirror) into coupling_re/im;
+        // returns the terms summed
+        auto accumulate_coupling = [&](size_t i, const auto* src_re, const auto* src_im,
+                                       double& coupling_re, double& coupling_im) -> uint64_t {
+            constexpr bool kFloatMirror = std::is_same<std::decay_t<decltype(*src_re)>, float>::value;
+            uint64_t terms = 0;
+            const double self_re = src_re[i];
+            const double self_im = src_im[i];
 
             if (N > 1) {
                 // Determine coupling range based on R_c
-                double radius = std::max(node.R_c, 0.0);
+                double radius = std::max(nodes[i].R_c, 0.0);
                 int R_c_int = static_cast<int>(std::ceil(radius));
+                const size_t reach = static_cast<size_t>(R_c_int);
+
+                if (radius > 0.0 && 2 * reach + 1 <= N && i >= reach && i + reach < N) {
+                    // Interior, no aliasing: distance == |offset|, so the
+                    // weights depend only on R_c and neighbours are contiguous
+                    if (radius != span_R_c) {
+                        span_weights.assign(2 * reach + 1, 0.0);
+                        span_neighbors = 0;
+                        for (int offset = -R_c_int; offset <= R_c_int; offset++) {
+                            const double distance = static_cast<double>(std::abs(offset));
+                            if (offset != 0 && distance <= radius) {
+                                span_weights[static_cast<size_t>(offset + R_c_int)] = couplingKernel<Kernel>(distance, radius);
+                                span_neighbors++;
+                            }
+                        }
+                        span_weights32.assign(span_weights.begin(), span_weights.end());
+                        span_R_c = radius;
+                        span_fixed_radius = FixedStencilKernels::fixedRadius(radius, N);
+                    }
+                    if constexpr (kFloatMirror) {
+                        // Float mirror: generic span kernels (fixed kernels are double)
+                        if (float_sums) {
+                            IGSOACouplingKernels::accumulateContiguousFloat(
+                                simd, src_re + (i - reach), src_im + (i - reach),
+                                span_weights32.data(), span_weights32.size(),
+                                src_re[i], src_im[i], coupling_re, coupling_im);
+                        } else {
+                            IGSOACouplingKernels::accumulateContiguous(
+                                simd, src_re + (i - reach), src_im + (i - reach),
+                                span_weights.data(), span_weights.size(),
+                                self_re, self_im, coupling_re, coupling_im);
+                        }
+                    } else if (!FixedStencilKernels::accumulateInterior<1>(
+                            span_fixed_radius, simd, src_re + i, src_im + i, 0, 0, span_weights.data(),
+                            self_re, self_im, coupling_re, coupling_im)) {
+                        IGSOACouplingKernels::accumulateContiguous(
+                            simd, src_re + (i - reach), src_im + (i - reach),
+                            span_weights.data(), span_weights.size(),
+                            self_re, self_im, coupling_re, coupling_im);
+                    }
+                    terms += span_neighbors;
+                } else {
+                    // Loop over all neighbors within R_c
+                    for (int offset = -R_c_int; offset <= R_c_int; offset++) {
+                        if (offset == 0) continue;  // Skip self-coupling
+
+                        // Periodic boundary conditions (lattice wrapping)
+                        int j = static_cast<int>(i) + offset;
+                        while (j < 0) j += static_cast<int>(N);
+                        while (j >= static_cast<int>(N)) j -= static_cast<int>(N);
+
+                        // Compute spatial distance
+                        double distance = wrappedDistance(i, static_cast<size_t>(j), N);
+
+                        // Only couple if within causal radius
+                        if (distance <= radius && radius > 0.0) {
+                            // Compute coupling strength using the kernel policy
+                            double coupling_strength = couplingKernel<Kernel>(distance, radius);
+
+                            // Accumulate weighted contribution from neighbor
+                            coupling_re += coupling_strength * (src_re[j] - self_re);
+                            coupling_im += coupling_strength * (src_im[j] - self_im);
+                            terms++;
+                        }
+                    }
+                }
+            }
+            return terms;
+        };
 
-                // Loop over all neighbors within R_c
-                for (int offset = -R_c_int; offset <= R_c_int; offset++) {
-                    if (offset == 0) continue;  // Skip self-coupling
-
-                    // Periodic boundary conditions (lattice wrapping)
-                    int j = static_cast<int>(i) + offset;
-                    while (j < 0) j += static_cast<int>(N);
-                    while (j >= static_cast<int>(N)) j -= static_cast<int>(N);
+        if (integrator != IGSOAIntegrator::Euler) {
+            return IGSOARungeKutta::integrate(
+                integrator, nodes, soa, dt, hbar, [](const double*, const double*) {}, accumulate_coupling);
+        }
 
-                    // Compute spatial distance
-                    double distance = wrappedDistance(i, static_cast<size_t>(j), N);
+        // Evolve one node with non-local coupling; returns operations performed
+        auto evolve_node = [&](size_t i, auto* src_re, auto* src_im) -> uint64_t {
+            auto& node = nodes[i];
 
-                    // Only couple if within causal radius
-                    if (distance <= radius && radius > 0.0) {
-                        // Compute coupling strength using exponential kernel
-                        double coupling_strength = couplingKernel(distance, radius);
+            // Compute effective potential from realized field
+            std::complex<double> V_eff = node.kappa * node.phi;
 
-                        // Accumulate weighted contribution from neighbor
-                        nonlocal_coupling += coupling_strength * (nodes[j].psi - node.psi);
-                        neighbor_operations++;
-                    }
-                }
-            }
+            double coupling_re = 0.0;
+            double coupling_im = 0.0;
+            const uint64_t node_operations = 1 + accumulate_coupling(i, src_re, src_im, coupling_re, coupling_im);
+            const std::complex<double> nonlocal_coupling(coupling_re, coupling_im);
 
             // Non-Hermitian dissipation term
             std::complex<double> i_gamma(0.0, node.gamma);
@@ -151,12 +279,42 @@ public:
             std::complex<double> i_unit(0.0, 1.0);
             node.psi_dot = (-i_unit / hbar) * H_psi;
 
-            // Update Ψ using Euler integration
-            // TODO: Upgrade to RK4 for better accuracy
+            // Update Ψ using Euler integration (RK2/RK4: IGSOARungeKutta)
             node.psi += node.psi_dot * dt;
+            if (write_through) {
+                src_re[i] = static_cast<std::decay_t<decltype(*src_re)>>(node.psi.real());
+                src_im[i] = static_cast<std::decay_t<decltype(*src_im)>>(node.psi.imag());
+            }
+            return node_operations;
+        };
+        auto evolve = [&](size_t i) -> uint64_t {
+            return float_mirror ? evolve_node(i, psi32_re, psi32_im) : evolve_node(i, psi_re, psi_im);
+        };
+
+        const int64_t N_int = static_cast<int64_t>(N);
+        if (write_through) {
+            // In-place sweep depends on traversal order: keep it on one thread
+            #pragma omp single
+            for (int64_t i = 0; i < N_int; i++) {
+                neighbor_operations += evolve(static_cast<size_t>(i));
+            }
+        } else {
+            #pragma omp for schedule(static)
+            for (int64_t i = 0; i < N_int; i++) {
+                neighbor_operations += evolve(static_cast<size_t>(i));
+            }
         }
 
-        return neighbor_operations + static_cast<uint64_t>(N);
+        return neighbor_operations;
+    }
+
+    static uint64_t evolveQuantumState(
+        std::vector<IGSOAComplexNode>& nodes,
+        double dt,
+        double hbar = 1.0
+    ) {
+        IGSOAStateSoA soa;
+        return evolveQuantumState(nodes, soa, dt, hbar);
     }
 
     /**
@@ -175,7 +333,10 @@ public:
         double dt
     ) {
         uint64_t operations = 0;
-        for (auto& node : nodes) {
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            auto& node = nodes[static_cast<size_t>(i)];
             // Coupling difference: Φ - Re[Ψ]
             double coupling_diff = node.phi - node.psi.real();
 
@@ -201,7 +362,10 @@ public:
         std::vector<IGSOAComplexNode>& nodes
     ) {
         uint64_t operations = 0;
-        for (auto& node : nodes) {
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            auto& node = nodes[static_cast<size_t>(i)];
             node.updateInformationalDensity();  // F = |Ψ|²
             node.updatePhase();                  // phase = arg(Ψ)
             node.updateEntropyRate();            // Ṡ = R_c(Φ - Re[Ψ])²
@@ -210,21 +374,64 @@ public:
         return operations;
     }
 
+    /**
+     * The derived quantities that read Ψ before normalization: F, T_IGS and
+     * Ṡ.  A lazy timeStep (derived = false) still runs this when it
+     * normalizes; the phase (arg Ψ survives normalization) and ∇F can wait.
+     */
+    static uint64_t updateDensityAndEntropy(
+        std::vector<IGSOAComplexNode>& nodes
+    ) {
+        uint64_t operations = 0;
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            auto& node = nodes[static_cast<size_t>(i)];
+            node.updateInformationalDensity();
+            node.updateEntropyRate();
+            operations++;
+        }
+        return operations;
+    }
+
+    /**
+     * phase = arg(Ψ) for every node
+     */
+    static uint64_t updatePhases(
+        std::vector<IGSOAComplexNode>& nodes
+    ) {
+        uint64_t operations = 0;
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            nodes[static_cast<size_t>(i)].updatePhase();
+            operations++;
+        }
+        return operations;
+    }
+
     /**
      * Compute spatial gradients of F (informational density)
      * ∇F approximated as finite difference
      */
     static uint64_t computeGradients(
-        std::vector<IGSOAComplexNode>& nodes
+        std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa
     ) {
         const size_t N = nodes.size();
         uint64_t operations = 0;
 
-        for (size_t i = 0; i < N; i++) {
+        soa.gatherF(nodes);
+        const double* F = soa.F.data();
+
+        const int64_t N_int = static_cast<int64_t>(N);
+        #pragma omp for schedule(static)
+        for (int64_t ii = 0; ii < N_int; ii++) {
+            const size_t i = static_cast<size_t>(ii);
             if (N > 1) {
                 size_t right = (i == N - 1) ? 0 : i + 1;
                 // Simple forward difference: ∇F ≈ (F[i+1] - F[i])
-                nodes[i].F_gradient = nodes[right].F - nodes[i].F;
+                nodes[i].F_gradient = F[right] - F[i];
             } else {
                 nodes[i].F_gradient = 0.0;
             }
@@ -233,6 +440,13 @@ public:
         return operations;
     }
 
+    static uint64_t computeGradients(
+        std::vector<IGSOAComplexNode>& nodes
+    ) {
+        IGSOAStateSoA soa;
+        return computeGradients(nodes, soa);
+    }
+
     /**
      * Normalize all quantum states (unitary evolution)
      * |Ψ⟩ → |Ψ⟩ / ||Ψ||
@@ -241,8 +455,10 @@ public:
         std::vector<IGSOAComplexNode>& nodes
     ) {
         uint64_t operations = 0;
-        for (auto& node : nodes) {
-            node.normalize();
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            nodes[static_cast<size_t>(i)].normalize();
             operations++;
         }
         return operations;
@@ -257,31 +473,126 @@ public:
      * 3. Update derived quantities (F, T_IGS, phase, Ṡ)
      * 4. Compute gradients
      * 5. Optionally normalize states
+     *
+     * All phases share one OpenMP parallel region (static schedule; the
+     * implicit barrier after each worksharing loop orders the phases).
+     * Lattices smaller than config.omp_min_nodes run on the calling thread.
+     *
+     * @param derived false skips 3 and 4 but for what normalization would
+     *        lose (updateDensityAndEntropy when config.normalize_psi); the
+     *        caller runs refreshDerived before the fields are read.  Nothing
+     *        derived feeds back into Ψ or Φ.
+     * @param drive Optional driving sample (Re: input signal, Im: control
+     *        pattern), bit-identical to applyDriving before the step but
+     *        applied by step 1's Ψ gather instead of a pass of its own
      */
     static uint64_t timeStep(
         std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
+        const IGSOAComplexConfig& config,
+        bool derived = true,
+        const std::complex<double>* drive = nullptr
+    ) {
+        prepareStep(nodes, soa, config);
+
+        uint64_t operations = 0;
+        #pragma omp parallel if(nodes.size() >= config.omp_min_nodes) reduction(+:operations)
+        operations += stepPhases(nodes, soa, config, derived, drive);
+        return operations;
+    }
+
+    /**
+     * Size the SoA mirror and integrator stages for config (never inside
+     * the parallel region); timeStep does this before every step, a
+     * StepLoop mission once before its stepPhases calls
+     */
+    static void prepareStep(
+        std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
         const IGSOAComplexConfig& config
+    ) {
+        if (soa.size() != nodes.size()) {
+            soa.resize(nodes.size());
+        }
+        soa.reserveStages(config.integrator);
+        soa.reservePrecision(config.precision);
+    }
+
+    /**
+     * The phases of timeStep, called by every thread of an enclosing team
+     * (or alone); returns the calling thread's operations.  Ends with a
+     * worksharing loop's barrier, as StepLoop requires.
+     */
+    static uint64_t stepPhases(
+        std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
+        const IGSOAComplexConfig& config,
+        bool derived,
+        const std::complex<double>* drive
     ) {
         uint64_t operations = 0;
-        // 1. Evolve quantum state
-        operations += evolveQuantumState(nodes, config.dt);
+
+        // 1. Evolve quantum state (one instantiation per coupling law)
+        {
+            DASE_TRACE_ZONE("igsoa.coupling");
+            operations += withKernelPolicy(config.kernel_policy, [&](auto kernel) {
+                return evolveQuantumState<decltype(kernel)>(nodes, soa, config.dt, 1.0, config.update_mode, config.simd_coupling, config.integrator, config.precision, drive);
+            });
+        }
 
         // 2. Evolve causal field
-        operations += evolveCausalField(nodes, config.dt);
+        { DASE_TRACE_ZONE("igsoa.causal_field"); operations += evolveCausalField(nodes, config.dt); }
 
         // 3. Update derived quantities
-        operations += updateDerivedQuantities(nodes);
-
-        // 4. Compute gradients
-        operations += computeGradients(nodes);
+        if (derived) {
+            { DASE_TRACE_ZONE("igsoa.derived"); operations += updateDerivedQuantities(nodes); }
+
+            // 4. Compute gradients
+            { DASE_TRACE_ZONE("igsoa.gradients"); operations += computeGradients(nodes, soa); }
+        } else if (config.normalize_psi) {
+            DASE_TRACE_ZONE("igsoa.derived");
+            operations += updateDensityAndEntropy(nodes);
+        }
 
         // 5. Normalize if requested
         if (config.normalize_psi) {
+            DASE_TRACE_ZONE("igsoa.normalize");
             operations += normalizeStates(nodes);
         }
         return operations;
     }
 
+    /**
+     * Complete the derived fields skipped by timeStep(..., derived = false):
+     * the phase and ∇F, plus F / T_IGS / Ṡ when the step did not normalize
+     * (normalizing steps computed those already)
+     */
+    static uint64_t refreshDerived(
+        std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
+        const IGSOAComplexConfig& config
+    ) {
+        if (soa.size() != nodes.size()) {
+            soa.resize(nodes.size());
+        }
+        uint64_t operations = 0;
+        #pragma omp parallel if(nodes.size() >= config.omp_min_nodes) reduction(+:operations)
+        {
+            DASE_TRACE_ZONE("igsoa.derived");
+            operations += config.normalize_psi ? updatePhases(nodes) : updateDerivedQuantities(nodes);
+            operations += computeGradients(nodes, soa);
+        }
+        return operations;
+    }
+
+    static uint64_t timeStep(
+        std::vector<IGSOAComplexNode>& nodes,
+        const IGSOAComplexConfig& config
+    ) {
+        IGSOAStateSoA soa(nodes.size());
+        return timeStep(nodes, soa, config);
+    }
+
     /**
      * Apply external driving signal to nodes
      *
@@ -303,6 +614,28 @@ public:
         }
     }
 
+    /**
+     * Compute total energy and entropy production rate in one fused pass
+     *
+     * E = ∑_i [|Ψ_i|² + Φ_i²],  Ṡ_total = ∑_i Ṡ_i
+     */
+    static void computeTotals(
+        const std::vector<IGSOAComplexNode>& nodes,
+        double& energy_out,
+        double& entropy_rate_out,
+        size_t omp_min_nodes = IGSOAComplexConfig().omp_min_nodes
+    ) {
+        // Fixed-block sums: bit-identical for any thread count
+        const auto totals = reproducibleSums<2>(static_cast<int64_t>(nodes.size()), [&](int64_t i, double* acc) {
+            const auto& node = nodes[static_cast<size_t>(i)];
+            acc[0] += node.F;               // Quantum energy: |Ψ|²
+            acc[0] += node.phi * node.phi;  // Classical energy: Φ²
+            acc[1] += node.entropy_rate;
+        }, nodes.size() >= omp_min_nodes);
+        energy_out = totals[0];
+        entropy_rate_out = totals[1];
+    }
+
     /**
      * Compute total system energy
      * E = ∑_i [|Ψ_i|² + Φ_i²]
@@ -311,10 +644,8 @@ public:
         const std::vector<IGSOAComplexNode>& nodes
     ) {
         double energy = 0.0;
-        for (const auto& node : nodes) {
-            energy += node.F;           // Quantum energy: |Ψ|²
-            energy += node.phi * node.phi;  // Classical energy: Φ²
-        }
+        double entropy_rate = 0.0;
+        computeTotals(nodes, energy, entropy_rate);
         return energy;
     }
 
@@ -325,11 +656,10 @@ public:
     static double computeTotalEntropyRate(
         const std::vector<IGSOAComplexNode>& nodes
     ) {
-        double total_entropy = 0.0;
-        for (const auto& node : nodes) {
-            total_entropy += node.entropy_rate;
-        }
-        return total_entropy;
+        double energy = 0.0;
+        double entropy_rate = 0.0;
+        computeTotals(nodes, energy, entropy_rate);
+        return entropy_rate;
     }
 };
 
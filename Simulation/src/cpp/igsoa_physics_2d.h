@@ -17,13 +17,24 @@
 
 #pragma once
 
+#include "igsoa_activity_mask.h"
 #include "igsoa_complex_node.h"
+#include "igsoa_state_soa.h"
+#include "igsoa_fft_coupling.h"
+#include "igsoa_simd_coupling.h"
+#include "igsoa_fixed_stencil.h"
+#include "igsoa_neighbor_graph.h"
+#include "igsoa_runge_kutta.h"
+#include "reproducible_sum.h"
+#include "neighbor_cache.h"
+#include "trace_zones.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <vector>
 #include <iostream>
 #include <mutex>
+#include <type_traits>
 
 namespace dase {
 namespace igsoa {
@@ -32,17 +43,21 @@ namespace igsoa {
  * IGSOA Physics Engine - 2D
  *
  * Implements time evolution of the IGSOA system on a 2D lattice
+ *
+ * Threading follows IGSOAPhysics: orphaned `omp for` loops (statically
+ * scheduled over rows for the stencil kernels) inside the single parallel
+ * region opened by timeStep().
  */
 class IGSOAPhysics2D {
 public:
     /**
      * Compute non-local coupling kernel (reused from 1D)
      *
-     * K(r, R_c) = exp(-r/R_c) / R_c
+     * K(r, R_c) = exp(-r/R_c) / R_c  (default ExponentialKernel)
      */
+    template <typename Kernel = ExponentialKernel>
     static inline double couplingKernel(double distance, double R_c) {
-        if (distance <= 0.0 || R_c <= 0.0) return 0.0;
-        return std::exp(-distance / R_c) / R_c;
+        return Kernel::evaluate(distance, R_c);
     }
 
     /**
@@ -92,57 +107,170 @@ public:
      *
      * Where:
      * - 𝒦[Ψ] = ∑_{j: |r_j - r_i| ≤ R_c} K(|r_j - r_i|, R_c) Ψ_j  (causal derivative)
-     * - K(r, R_c) = exp(-r/R_c) / R_c  (coupling kernel)
+     * - K(r, R_c) = exp(-r/R_c) / R_c  (coupling kernel; the Kernel policy,
+     *   which stencil and graph must have been built with)
      * - V_eff(Φ) = κΦ is coupling to realized field
      * - iΓ is non-Hermitian term (dissipation)
      *
      * Computational complexity: O(N × πR_c²) per time step
      *
      * @param nodes Network of IGSOA nodes (row-major layout)
+     * @param soa Packed neighbour-read state (refreshed from nodes here)
      * @param dt Time step
      * @param N_x Number of nodes in x-direction
      * @param N_y Number of nodes in y-direction
      * @param hbar Reduced Planck constant (default: 1.0 in natural units)
+     * @param mode Ψ update ordering (DoubleBuffered reads only previous-step Ψ)
+     * @param stencil Precomputed offset/weight table for a uniform R_c
+     *                (nullptr = evaluate each node's own R_c directly)
+     * @param spectral FFT coupling backend (used only in DoubleBuffered mode)
+     * @param use_simd Allow the AVX2/FMA stencil accumulation when the CPU has it
+     * @param integrator Time integrator (RK2/RK4 need soa.reserveStages();
+     *                   the FFT backend then transforms every stage input)
+     * @param precision Ψ mirror precision for Euler table/direct steps
+     *                  (float modes need soa.reservePrecision())
+     * @param mask Euler only: skip the nodes of inactive blocks (Ψ̇ = 0)
+     * @param graph Packed per-node R_c rows (igsoa_neighbor_graph.h), used
+     *              when stencil is nullptr (nullptr = direct loop)
+     * @param drive Optional uniform drive applied by the Ψ gather (see
+     *              IGSOAPhysics::evolveQuantumState)
+     * @param coupling_gain Factor on 𝒦[Ψ] (config.coupling_gain; 1 is exact)
      */
+    template <typename Kernel = ExponentialKernel>
     static uint64_t evolveQuantumState(
         std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
         double dt,
         size_t N_x,
         size_t N_y,
-        double hbar = 1.0
+        double hbar = 1.0,
+        IGSOAUpdateMode mode = IGSOAUpdateMode::InPlace,
+        const NeighborStencil2D* stencil = nullptr,
+        IGSOASpectralCoupling* spectral = nullptr,
+        bool use_simd = true,
+        IGSOAIntegrator integrator = IGSOAIntegrator::Euler,
+        IGSOAPrecision precision = IGSOAPrecision::Double,
+        const IGSOAActivityMask* mask = nullptr,
+        const IGSOANeighborGraph2D* graph = nullptr,
+        const std::complex<double>* drive = nullptr,
+        double coupling_gain = 1.0
     ) {
         const size_t N_total = N_x * N_y;
         const int N_x_int = static_cast<int>(N_x);
         const int N_y_int = static_cast<int>(N_y);
         uint64_t neighbor_operations = 0;
 
-        // Evolve each node with non-local coupling
-        for (size_t i = 0; i < N_total; i++) {
-            auto& node = nodes[i];
-
-            // Convert 1D index to 2D coordinates
-            const int x_i = static_cast<int>(i % N_x);
-            const int y_i = static_cast<int>(i / N_x);
-
-            // Compute effective potential from realized field
-            std::complex<double> V_eff = node.kappa * node.phi;
-
-            // NON-LOCAL SPATIAL COUPLING (Causal Derivative Operator 𝒦)
-            // Sum over all neighbors within circular region of radius R_c
-            std::complex<double> nonlocal_coupling(0.0, 0.0);
-
-            // DIAGNOSTIC: Print once to verify this code path is active (thread-safe)
-            static std::once_flag diagnostic_flag;
-            if (i == 0) {
-                std::call_once(diagnostic_flag, [&]() {
-                    std::cerr << "[IGSOA 2D DIAGNOSTIC] Using 2D non-local coupling (Nov 3 2025, R_c="
-                              << node.R_c << ", lattice=" << N_x << "x" << N_y << ")" << std::endl;
-                });
+        const bool write_through = (mode == IGSOAUpdateMode::InPlace);
+        const bool simd = use_simd && IGSOACouplingKernels::avx2Available();
+
+        // Whole-lattice FFT coupling needs a fixed Ψ snapshot (Jacobi only)
+        const bool use_spectral = (spectral != nullptr) && !write_through;
+
+        // Euler table/direct steps may stream a float Ψ mirror (RK stages
+        // and the FFT backend stay double)
+        const bool float_mirror = precision != IGSOAPrecision::Double &&
+                                  integrator == IGSOAIntegrator::Euler && !use_spectral;
+        const bool float_sums = float_mirror && precision == IGSOAPrecision::Float;
+        if (drive != nullptr) {
+            if (float_mirror) {
+                soa.driveAndGatherPsi32(nodes, *drive);
+            } else {
+                soa.driveAndGatherPsi(nodes, *drive);
             }
+        } else if (float_mirror) {
+            soa.gatherPsi32(nodes);
+        } else {
+            soa.gatherPsi(nodes);
+        }
+        double* psi_re = soa.psi_re.data();
+        double* psi_im = soa.psi_im.data();
+        float* psi32_re = soa.psi32_re.data();
+        float* psi32_im = soa.psi32_im.data();
+
+        // DIAGNOSTIC: Print once to verify this code path is active (thread-safe)
+        static std::once_flag diagnostic_flag;
+        if (N_total > 0) {
+            std::call_once(diagnostic_flag, [&]() {
+                std::cerr << "[IGSOA 2D DIAGNOSTIC] Using 2D non-local coupling (Nov 3 2025, R_c="
+                          << nodes[0].R_c << ", lattice=" << N_x << "x" << N_y << ")" << std::endl;
+            });
+        }
 
-            if (N_total > 1) {
+        // Compile-time interior stencil radius (0 = walk the run table)
+        const int fixed_radius = stencil != nullptr ? stencil->fixedRadius() : 0;
+        const std::ptrdiff_t row_stride = static_cast<std::ptrdiff_t>(N_x);
+
+        // NON-LOCAL SPATIAL COUPLING (Causal Derivative Operator 𝒦)
+        // Sum over all neighbors within circular region of radius R_c of the Ψ
+        // arrays src_re/src_im into coupling_re/im; returns the terms summed
+        auto accumulate_coupling = [&](int x_i, int y_i, const auto* src_re, const auto* src_im,
+                                       double& coupling_re, double& coupling_im) -> uint64_t {
+            const size_t i = static_cast<size_t>(y_i) * N_x + static_cast<size_t>(x_i);
+            constexpr bool kFloatMirror = std::is_same<std::decay_t<decltype(*src_re)>, float>::value;
+            uint64_t terms = 0;
+            const double self_re = src_re[i];
+            const double self_im = src_im[i];
+
+            if (use_spectral) {
+                coupling_re = spectral->couplingRe()[i];
+                coupling_im = spectral->couplingIm()[i];
+                terms += spectral->opsPerNode();
+            } else if (stencil != nullptr) {
+                // Precomputed stencil: same offsets/weights as the direct loop
+                const size_t count = stencil->size();
+                const int reach = stencil->reach();
+                const double* weight = stencil->weight();
+                if (x_i >= reach && x_i < N_x_int - reach &&
+                    y_i >= reach && y_i < N_y_int - reach) {
+                    // Interior: no wrap, each run of offsets is a contiguous span
+                    // (compile-time runs for the common radii)
+                    const std::ptrdiff_t* offset = stencil->linearOffset();
+                    const size_t* run_begin = stencil->runBegin();
+                    const size_t* run_length = stencil->runLength();
+                    // (the fixed kernels are double-only: a float mirror walks the runs)
+                    size_t num_runs = stencil->numRuns();
+                    if constexpr (!kFloatMirror) {
+                        if (FixedStencilKernels::accumulateInterior<2>(
+                                fixed_radius, simd, src_re + i, src_im + i, row_stride, 0, weight,
+                                self_re, self_im, coupling_re, coupling_im)) {
+                            num_runs = 0;
+                        }
+                    }
+                    for (size_t r = 0; r < num_runs; ++r) {
+                        const size_t k0 = run_begin[r];
+                        const size_t j0 = static_cast<size_t>(static_cast<std::ptrdiff_t>(i) + offset[k0]);
+                        if constexpr (kFloatMirror) {
+                            if (float_sums) {
+                                IGSOACouplingKernels::accumulateContiguousFloat(
+                                    simd, src_re + j0, src_im + j0, stencil->weight32() + k0, run_length[r],
+                                    src_re[i], src_im[i], coupling_re, coupling_im);
+                                continue;
+                            }
+                        }
+                        IGSOACouplingKernels::accumulateContiguous(
+                            simd, src_re + j0, src_im + j0, weight + k0, run_length[r],
+                            self_re, self_im, coupling_re, coupling_im);
+                    }
+                } else {
+                    const int* offset_x = stencil->dx();
+                    const int* offset_y = stencil->dy();
+                    for (size_t k = 0; k < count; k++) {
+                        int x_temp = (x_i + offset_x[k]) % N_x_int;
+                        int x_j = (x_temp < 0) ? (x_temp + N_x_int) : x_temp;
+                        int y_temp = (y_i + offset_y[k]) % N_y_int;
+                        int y_j = (y_temp < 0) ? (y_temp + N_y_int) : y_temp;
+                        const size_t j = static_cast<size_t>(y_j) * N_x + static_cast<size_t>(x_j);
+                        coupling_re += weight[k] * (src_re[j] - self_re);
+                        coupling_im += weight[k] * (src_im[j] - self_im);
+                    }
+                }
+                terms += count;
+            } else if (graph != nullptr) {
+                // Packed per-node R_c rows: the direct loop's terms and weights
+                terms += graph->accumulate(i, src_re, src_im, float_sums, coupling_re, coupling_im);
+            } else if (N_total > 1) {
                 // Determine coupling range based on R_c
-                const double radius = std::max(node.R_c, 0.0);
+                const double radius = std::max(nodes[i].R_c, 0.0);
                 const int R_c_int = static_cast<int>(std::ceil(radius));
 
                 // Loop over square bounding box, then filter by circular distance
@@ -162,19 +290,59 @@ public:
 
                         // Only couple if within causal radius (circular cutoff)
                         if (distance <= radius && radius > 0.0) {
-                            // Compute coupling strength using exponential kernel
-                            double coupling_strength = couplingKernel(distance, radius);
+                            // Compute coupling strength using the kernel policy
+                            double coupling_strength = couplingKernel<Kernel>(distance, radius);
 
                             // Convert 2D coords to 1D index
                             size_t j = static_cast<size_t>(y_j) * N_x + static_cast<size_t>(x_j);
 
                             // Accumulate weighted contribution from neighbor
-                            nonlocal_coupling += coupling_strength * (nodes[j].psi - node.psi);
-                            neighbor_operations++;
+                            coupling_re += coupling_strength * (src_re[j] - self_re);
+                            coupling_im += coupling_strength * (src_im[j] - self_im);
+                            terms++;
                         }
                     }
                 }
             }
+            return terms;
+        };
+
+        if (integrator != IGSOAIntegrator::Euler) {
+            return IGSOARungeKutta::integrate(
+                integrator, nodes, soa, dt, hbar,
+                [&](const double* in_re, const double* in_im) {
+                    if (use_spectral) {
+                        #pragma omp single
+                        spectral->apply(in_re, in_im);
+                    }
+                },
+                [&](size_t i, const double* src_re, const double* src_im,
+                    double& coupling_re, double& coupling_im) {
+                    const uint64_t terms = accumulate_coupling(static_cast<int>(i % N_x), static_cast<int>(i / N_x),
+                                                               src_re, src_im, coupling_re, coupling_im);
+                    coupling_re *= coupling_gain;
+                    coupling_im *= coupling_gain;
+                    return terms;
+                });
+        }
+
+        if (use_spectral) {
+            #pragma omp single
+            spectral->apply(psi_re, psi_im);
+        }
+
+        // Evolve one node with non-local coupling; returns operations performed
+        auto evolve_node = [&](int x_i, int y_i, auto* src_re, auto* src_im) -> uint64_t {
+            const size_t i = static_cast<size_t>(y_i) * N_x + static_cast<size_t>(x_i);
+            auto& node = nodes[i];
+
+            // Compute effective potential from realized field
+            std::complex<double> V_eff = node.kappa * node.phi;
+
+            double coupling_re = 0.0;
+            double coupling_im = 0.0;
+            const uint64_t node_operations = 1 + accumulate_coupling(x_i, y_i, src_re, src_im, coupling_re, coupling_im);
+            const std::complex<double> nonlocal_coupling(coupling_gain * coupling_re, coupling_gain * coupling_im);
 
             // Non-Hermitian dissipation term
             std::complex<double> i_gamma(0.0, node.gamma);
@@ -188,9 +356,56 @@ public:
 
             // Update Ψ using Euler integration
             node.psi += node.psi_dot * dt;
+            if (write_through) {
+                src_re[i] = static_cast<std::decay_t<decltype(*src_re)>>(node.psi.real());
+                src_im[i] = static_cast<std::decay_t<decltype(*src_im)>>(node.psi.imag());
+            }
+            return node_operations;
+        };
+        auto evolve = [&](int x_i, int y_i) -> uint64_t {
+            return float_mirror ? evolve_node(x_i, y_i, psi32_re, psi32_im) : evolve_node(x_i, y_i, psi_re, psi_im);
+        };
+
+        // One row; nodes of inactive mask blocks keep Ψ and report Ψ̇ = 0
+        auto evolve_row = [&](int y) -> uint64_t {
+            uint64_t row_operations = 0;
+            const uint8_t* active = mask != nullptr ? mask->row(static_cast<size_t>(y), 0) : nullptr;
+            const size_t block = mask != nullptr ? mask->blockEdge() : 1;
+            for (int x = 0; x < N_x_int; x++) {
+                if (active != nullptr && !active[static_cast<size_t>(x) / block]) {
+                    nodes[static_cast<size_t>(y) * N_x + static_cast<size_t>(x)].psi_dot = 0.0;
+                    continue;
+                }
+                row_operations += evolve(x, y);
+            }
+            return row_operations;
+        };
+
+        if (write_through) {
+            // In-place sweep depends on traversal order: keep it on one thread
+            #pragma omp single
+            for (int y = 0; y < N_y_int; y++) {
+                neighbor_operations += evolve_row(y);
+            }
+        } else {
+            #pragma omp for schedule(static)
+            for (int y = 0; y < N_y_int; y++) {
+                neighbor_operations += evolve_row(y);
+            }
         }
 
-        return neighbor_operations + static_cast<uint64_t>(N_total);
+        return neighbor_operations;
+    }
+
+    static uint64_t evolveQuantumState(
+        std::vector<IGSOAComplexNode>& nodes,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        double hbar = 1.0
+    ) {
+        IGSOAStateSoA soa;
+        return evolveQuantumState(nodes, soa, dt, N_x, N_y, hbar);
     }
 
     /**
@@ -203,7 +418,10 @@ public:
         double dt
     ) {
         uint64_t operations = 0;
-        for (auto& node : nodes) {
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            auto& node = nodes[static_cast<size_t>(i)];
             // Coupling difference: Φ - Re[Ψ]
             double coupling_diff = node.phi - node.psi.real();
 
@@ -225,7 +443,10 @@ public:
         std::vector<IGSOAComplexNode>& nodes
     ) {
         uint64_t operations = 0;
-        for (auto& node : nodes) {
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            auto& node = nodes[static_cast<size_t>(i)];
             node.updateInformationalDensity();  // F = |Ψ|²
             node.updatePhase();                  // phase = arg(Ψ)
             node.updateEntropyRate();            // Ṡ = R_c(Φ - Re[Ψ])²
@@ -234,6 +455,41 @@ public:
         return operations;
     }
 
+    /**
+     * F, T_IGS and Ṡ only: what a lazy step must not defer past
+     * normalization (identical to 1D)
+     */
+    static uint64_t updateDensityAndEntropy(
+        std::vector<IGSOAComplexNode>& nodes
+    ) {
+        uint64_t operations = 0;
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            auto& node = nodes[static_cast<size_t>(i)];
+            node.updateInformationalDensity();
+            node.updateEntropyRate();
+            operations++;
+        }
+        return operations;
+    }
+
+    /**
+     * phase = arg(Ψ) for every node (identical to 1D)
+     */
+    static uint64_t updatePhases(
+        std::vector<IGSOAComplexNode>& nodes
+    ) {
+        uint64_t operations = 0;
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            nodes[static_cast<size_t>(i)].updatePhase();
+            operations++;
+        }
+        return operations;
+    }
+
     /**
      * Compute 2D spatial gradients of F (informational density)
      *
@@ -244,23 +500,27 @@ public:
      */
     static uint64_t computeGradients(
         std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
         size_t N_x,
         size_t N_y
     ) {
-        const size_t N_total = N_x * N_y;
         const int N_x_int = static_cast<int>(N_x);
         const int N_y_int = static_cast<int>(N_y);
         uint64_t operations = 0;
 
-        for (size_t i = 0; i < N_total; i++) {
-            const int x_i = static_cast<int>(i % N_x);
-            const int y_i = static_cast<int>(i / N_x);
+        soa.gatherF(nodes);
+        const double* F = soa.F.data();
+
+        #pragma omp for schedule(static)
+        for (int y_i = 0; y_i < N_y_int; y_i++) {
+          const int y_up = (y_i == N_y_int - 1) ? 0 : y_i + 1;
+          const int y_down = (y_i == 0) ? N_y_int - 1 : y_i - 1;
+          for (int x_i = 0; x_i < N_x_int; x_i++) {
+            const size_t i = static_cast<size_t>(y_i) * N_x + static_cast<size_t>(x_i);
 
             // Neighbor indices with wrapping
             const int x_right = (x_i == N_x_int - 1) ? 0 : x_i + 1;
             const int x_left = (x_i == 0) ? N_x_int - 1 : x_i - 1;
-            const int y_up = (y_i == N_y_int - 1) ? 0 : y_i + 1;
-            const int y_down = (y_i == 0) ? N_y_int - 1 : y_i - 1;
 
             // Convert to 1D indices
             size_t idx_right = static_cast<size_t>(y_i) * N_x + static_cast<size_t>(x_right);
@@ -269,16 +529,26 @@ public:
             size_t idx_down = static_cast<size_t>(y_down) * N_x + static_cast<size_t>(x_i);
 
             // Central difference: ∂F/∂x ≈ (F[x+1] - F[x-1]) / 2
-            double dF_dx = (nodes[idx_right].F - nodes[idx_left].F) * 0.5;
-            double dF_dy = (nodes[idx_up].F - nodes[idx_down].F) * 0.5;
+            double dF_dx = (F[idx_right] - F[idx_left]) * 0.5;
+            double dF_dy = (F[idx_up] - F[idx_down]) * 0.5;
 
             // Store gradient magnitude (for now)
             nodes[i].F_gradient = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy);
             operations++;
+          }
         }
         return operations;
     }
 
+    static uint64_t computeGradients(
+        std::vector<IGSOAComplexNode>& nodes,
+        size_t N_x,
+        size_t N_y
+    ) {
+        IGSOAStateSoA soa;
+        return computeGradients(nodes, soa, N_x, N_y);
+    }
+
     /**
      * Normalize all quantum states (identical to 1D)
      */
@@ -286,8 +556,10 @@ public:
         std::vector<IGSOAComplexNode>& nodes
     ) {
         uint64_t operations = 0;
-        for (auto& node : nodes) {
-            node.normalize();
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; i++) {
+            nodes[static_cast<size_t>(i)].normalize();
             operations++;
         }
         return operations;
@@ -302,35 +574,119 @@ public:
      * 3. Update derived quantities (F, T_IGS, phase, Ṡ)
      * 4. Compute 2D gradients
      * 5. Optionally normalize states
+     *
+     * @param stencil Optional uniform-R_c coupling table (see evolveQuantumState)
+     * @param spectral Optional FFT coupling backend (see evolveQuantumState)
+     * @param mask Activity mask, rebuilt here when config.sparse_threshold
+     *             enables sparse evolution (nullptr = dense)
+     * @param graph Optional per-node R_c coupling rows (see evolveQuantumState)
+     * @param derived false defers 3 and 4 to refreshDerived (see
+     *        IGSOAPhysics::timeStep)
+     * @param drive Optional driving sample fused into step 1 (see
+     *        IGSOAPhysics::timeStep)
      */
     static uint64_t timeStep(
         std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
         const IGSOAComplexConfig& config,
         size_t N_x,
-        size_t N_y
+        size_t N_y,
+        const NeighborStencil2D* stencil = nullptr,
+        IGSOASpectralCoupling* spectral = nullptr,
+        IGSOAActivityMask* mask = nullptr,
+        const IGSOANeighborGraph2D* graph = nullptr,
+        bool derived = true,
+        const std::complex<double>* drive = nullptr
     ) {
+        const size_t N_total = N_x * N_y;
+        if (soa.size() != nodes.size()) {
+            soa.resize(nodes.size());  // Never resize inside the parallel region
+        }
+        soa.reserveStages(config.integrator);
+        soa.reservePrecision(config.precision);
+        if (mask != nullptr && IGSOAActivityMask::enabled(config)) {
+            // The mask must see the driven state, so drive ahead of it
+            if (drive != nullptr) {
+                applyDriving(nodes, drive->real(), drive->imag());
+                drive = nullptr;
+            }
+            DASE_TRACE_ZONE("igsoa.activity_mask");
+            mask->update(nodes, N_x, N_y, 1, config);
+        } else {
+            mask = nullptr;
+        }
+
         uint64_t operations = 0;
 
-        // 1. Evolve quantum state (2D coupling)
-        operations += evolveQuantumState(nodes, config.dt, N_x, N_y);
+        // Single parallel region for the whole step (see IGSOAPhysics::timeStep)
+        #pragma omp parallel if(N_total >= config.omp_min_nodes) reduction(+:operations)
+        {
+            // 1. Evolve quantum state (2D coupling)
+            {
+                DASE_TRACE_ZONE("igsoa.coupling");
+                operations += withKernelPolicy(config.kernel_policy, [&](auto kernel) {
+                    return evolveQuantumState<decltype(kernel)>(nodes, soa, config.dt, N_x, N_y, 1.0, config.update_mode, stencil, spectral, config.simd_coupling, config.integrator, config.precision, mask, graph, drive, config.coupling_gain);
+                });
+            }
 
-        // 2. Evolve causal field
-        operations += evolveCausalField(nodes, config.dt);
+            // 2. Evolve causal field
+            { DASE_TRACE_ZONE("igsoa.causal_field"); operations += evolveCausalField(nodes, config.dt); }
 
-        // 3. Update derived quantities
-        operations += updateDerivedQuantities(nodes);
+            // 3. Update derived quantities
+            if (derived) {
+                { DASE_TRACE_ZONE("igsoa.derived"); operations += updateDerivedQuantities(nodes); }
 
-        // 4. Compute 2D gradients
-        operations += computeGradients(nodes, N_x, N_y);
+                // 4. Compute 2D gradients
+                { DASE_TRACE_ZONE("igsoa.gradients"); operations += computeGradients(nodes, soa, N_x, N_y); }
+            } else if (config.normalize_psi) {
+                DASE_TRACE_ZONE("igsoa.derived");
+                operations += updateDensityAndEntropy(nodes);
+            }
 
-        // 5. Normalize if requested
-        if (config.normalize_psi) {
-            operations += normalizeStates(nodes);
+            // 5. Normalize if requested
+            if (config.normalize_psi) {
+                DASE_TRACE_ZONE("igsoa.normalize");
+                operations += normalizeStates(nodes);
+            }
         }
 
         return operations;
     }
 
+    /**
+     * Complete the derived fields of a timeStep(..., derived = false)
+     * (see IGSOAPhysics::refreshDerived)
+     */
+    static uint64_t refreshDerived(
+        std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
+        const IGSOAComplexConfig& config,
+        size_t N_x,
+        size_t N_y
+    ) {
+        if (soa.size() != nodes.size()) {
+            soa.resize(nodes.size());
+        }
+        uint64_t operations = 0;
+        #pragma omp parallel if(N_x * N_y >= config.omp_min_nodes) reduction(+:operations)
+        {
+            DASE_TRACE_ZONE("igsoa.derived");
+            operations += config.normalize_psi ? updatePhases(nodes) : updateDerivedQuantities(nodes);
+            operations += computeGradients(nodes, soa, N_x, N_y);
+        }
+        return operations;
+    }
+
+    static uint64_t timeStep(
+        std::vector<IGSOAComplexNode>& nodes,
+        const IGSOAComplexConfig& config,
+        size_t N_x,
+        size_t N_y
+    ) {
+        IGSOAStateSoA soa(nodes.size());
+        return timeStep(nodes, soa, config, N_x, N_y);
+    }
+
     /**
      * Apply external driving signal to nodes (identical to 1D)
      */
@@ -348,6 +704,27 @@ public:
         }
     }
 
+    /**
+     * Compute total energy and entropy production rate in one fused pass
+     * (identical to 1D)
+     */
+    static void computeTotals(
+        const std::vector<IGSOAComplexNode>& nodes,
+        double& energy_out,
+        double& entropy_rate_out,
+        size_t omp_min_nodes = IGSOAComplexConfig().omp_min_nodes
+    ) {
+        // Fixed-block sums: bit-identical for any thread count
+        const auto totals = reproducibleSums<2>(static_cast<int64_t>(nodes.size()), [&](int64_t i, double* acc) {
+            const auto& node = nodes[static_cast<size_t>(i)];
+            acc[0] += node.F;               // Quantum energy: |Ψ|²
+            acc[0] += node.phi * node.phi;  // Classical energy: Φ²
+            acc[1] += node.entropy_rate;
+        }, nodes.size() >= omp_min_nodes);
+        energy_out = totals[0];
+        entropy_rate_out = totals[1];
+    }
+
     /**
      * Compute total system energy (identical to 1D)
      * E = ∑_i [|Ψ_i|² + Φ_i²]
@@ -356,10 +733,8 @@ public:
         const std::vector<IGSOAComplexNode>& nodes
     ) {
         double energy = 0.0;
-        for (const auto& node : nodes) {
-            energy += node.F;           // Quantum energy: |Ψ|²
-            energy += node.phi * node.phi;  // Classical energy: Φ²
-        }
+        double entropy_rate = 0.0;
+        computeTotals(nodes, energy, entropy_rate);
         return energy;
     }
 
@@ -370,11 +745,10 @@ public:
     static double computeTotalEntropyRate(
         const std::vector<IGSOAComplexNode>& nodes
     ) {
-        double total_entropy = 0.0;
-        for (const auto& node : nodes) {
-            total_entropy += node.entropy_rate;
-        }
-        return total_entropy;
+        double energy = 0.0;
+        double entropy_rate = 0.0;
+        computeTotals(nodes, energy, entropy_rate);
+        return entropy_rate;
     }
 };
 
@@ -8,22 +8,38 @@
 
 #pragma once
 
+#include "igsoa_activity_mask.h"
 #include "igsoa_complex_node.h"
+#include "igsoa_physics.h"
+#include "igsoa_state_soa.h"
+#include "igsoa_fft_coupling.h"
+#include "igsoa_simd_coupling.h"
+#include "igsoa_fixed_stencil.h"
+#include "igsoa_neighbor_graph.h"
+#include "igsoa_runge_kutta.h"
+#include "neighbor_cache.h"
+#include "trace_zones.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <iostream>
 #include <mutex>
+#include <type_traits>
 #include <vector>
 
 namespace dase {
 namespace igsoa {
 
+/**
+ * Threading follows IGSOAPhysics: orphaned `omp for` loops (statically
+ * scheduled over z-planes for the stencil kernels) inside the single
+ * parallel region opened by timeStep().
+ */
 class IGSOAPhysics3D {
 public:
+    template <typename Kernel = ExponentialKernel>
     static inline double couplingKernel(double distance, double R_c) {
-        if (distance <= 0.0 || R_c <= 0.0) return 0.0;
-        return std::exp(-distance / R_c) / R_c;
+        return Kernel::evaluate(distance, R_c);
     }
 
     static inline double wrappedDistance1D(int coord1, int coord2, size_t N) {
@@ -43,13 +59,27 @@ public:
         return std::sqrt(dx * dx + dy * dy + dz * dz);
     }
 
+    // Kernel: coupling law of the direct loop; stencil and graph carry the
+    // weights of the law they were built with
+    template <typename Kernel = ExponentialKernel>
     static uint64_t evolveQuantumState(
         std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
         double dt,
         size_t N_x,
         size_t N_y,
         size_t N_z,
-        double hbar = 1.0
+        double hbar = 1.0,
+        IGSOAUpdateMode mode = IGSOAUpdateMode::InPlace,
+        const NeighborStencil3D* stencil = nullptr,
+        IGSOASpectralCoupling* spectral = nullptr,
+        bool use_simd = true,
+        IGSOAIntegrator integrator = IGSOAIntegrator::Euler,
+        IGSOAPrecision precision = IGSOAPrecision::Double,
+        const IGSOAActivityMask* mask = nullptr,
+        const IGSOANeighborGraph3D* graph = nullptr,
+        const std::complex<double>* drive = nullptr,  // Applied by the Ψ gather (see IGSOAPhysics::evolveQuantumState)
+        double coupling_gain = 1.0                    // Factor on 𝒦[Ψ] (config.coupling_gain; 1 is exact)
     ) {
         const size_t N_total = N_x * N_y * N_z;
         const size_t plane_size = N_x * N_y;
@@ -59,27 +89,128 @@ public:
 
         uint64_t neighbor_operations = 0;
 
-        for (size_t index = 0; index < N_total; ++index) {
-            auto& node = nodes[index];
-
-            const int x_i = static_cast<int>(index % N_x);
-            const int y_i = static_cast<int>((index / N_x) % N_y);
-            const int z_i = static_cast<int>(index / plane_size);
-
-            std::complex<double> V_eff = node.kappa * node.phi;
-            std::complex<double> nonlocal_coupling(0.0, 0.0);
-
-            // DIAGNOSTIC: Print once to verify this code path is active (thread-safe)
-            static std::once_flag diagnostic_flag;
-            if (index == 0) {
-                std::call_once(diagnostic_flag, [&]() {
-                    std::cerr << "[IGSOA 3D DIAGNOSTIC] Using 3D non-local coupling (" << N_x
-                              << "x" << N_y << "x" << N_z << ", R_c=" << node.R_c << ")" << std::endl;
-                });
+        const bool write_through = (mode == IGSOAUpdateMode::InPlace);
+        const bool simd = use_simd && IGSOACouplingKernels::avx2Available();
+
+        // Whole-lattice FFT coupling needs a fixed Ψ snapshot (Jacobi only)
+        const bool use_spectral = (spectral != nullptr) && !write_through;
+
+        // Euler table/direct steps may stream a float Ψ mirror (RK stages
+        // and the FFT backend stay double)
+        const bool float_mirror = precision != IGSOAPrecision::Double &&
+                                  integrator == IGSOAIntegrator::Euler && !use_spectral;
+        const bool float_sums = float_mirror && precision == IGSOAPrecision::Float;
+        if (drive != nullptr) {
+            if (float_mirror) {
+                soa.driveAndGatherPsi32(nodes, *drive);
+            } else {
+                soa.driveAndGatherPsi(nodes, *drive);
             }
+        } else if (float_mirror) {
+            soa.gatherPsi32(nodes);
+        } else {
+            soa.gatherPsi(nodes);
+        }
+        double* psi_re = soa.psi_re.data();
+        double* psi_im = soa.psi_im.data();
+        float* psi32_re = soa.psi32_re.data();
+        float* psi32_im = soa.psi32_im.data();
+
+        // DIAGNOSTIC: Print once to verify this code path is active (thread-safe)
+        static std::once_flag diagnostic_flag;
+        if (N_total > 0) {
+            std::call_once(diagnostic_flag, [&]() {
+                std::cerr << "[IGSOA 3D DIAGNOSTIC] Using 3D non-local coupling (" << N_x
+                          << "x" << N_y << "x" << N_z << ", R_c=" << nodes[0].R_c << ")" << std::endl;
+            });
+        }
 
-            if (N_total > 1) {
-                const double radius = std::max(node.R_c, 0.0);
+        // Compile-time interior stencil radius (0 = walk the run table)
+        const int fixed_radius = stencil != nullptr ? stencil->fixedRadius() : 0;
+        const std::ptrdiff_t row_stride = static_cast<std::ptrdiff_t>(N_x);
+        const std::ptrdiff_t plane_stride = static_cast<std::ptrdiff_t>(plane_size);
+
+        // NON-LOCAL SPATIAL COUPLING (Causal Derivative Operator 𝒦)
+        // Sum over all neighbors within the sphere of radius R_c of the Ψ
+        // arrays src_re/src_im into coupling_re/im; returns the terms summed
+        auto accumulate_coupling = [&](int x_i, int y_i, int z_i, const auto* src_re, const auto* src_im,
+                                       double& coupling_re, double& coupling_im) -> uint64_t {
+            const size_t index =
+                static_cast<size_t>(z_i) * plane_size +
+                static_cast<size_t>(y_i) * N_x +
+                static_cast<size_t>(x_i);
+            constexpr bool kFloatMirror = std::is_same<std::decay_t<decltype(*src_re)>, float>::value;
+            uint64_t terms = 0;
+            const double self_re = src_re[index];
+            const double self_im = src_im[index];
+
+            if (use_spectral) {
+                coupling_re = spectral->couplingRe()[index];
+                coupling_im = spectral->couplingIm()[index];
+                terms += spectral->opsPerNode();
+            } else if (stencil != nullptr) {
+                // Precomputed stencil: same offsets/weights as the direct loop
+                const size_t count = stencil->size();
+                const int reach = stencil->reach();
+                const double* weight = stencil->weight();
+                if (x_i >= reach && x_i < N_x_int - reach &&
+                    y_i >= reach && y_i < N_y_int - reach &&
+                    z_i >= reach && z_i < N_z_int - reach) {
+                    // Interior: no wrap, each run of offsets is a contiguous span
+                    // (compile-time runs for the common radii)
+                    const std::ptrdiff_t* offset = stencil->linearOffset();
+                    const size_t* run_begin = stencil->runBegin();
+                    const size_t* run_length = stencil->runLength();
+                    // (the fixed kernels are double-only: a float mirror walks the runs)
+                    size_t num_runs = stencil->numRuns();
+                    if constexpr (!kFloatMirror) {
+                        if (FixedStencilKernels::accumulateInterior<3>(
+                                fixed_radius, simd, src_re + index, src_im + index, row_stride, plane_stride, weight,
+                                self_re, self_im, coupling_re, coupling_im)) {
+                            num_runs = 0;
+                        }
+                    }
+                    for (size_t r = 0; r < num_runs; ++r) {
+                        const size_t k0 = run_begin[r];
+                        const size_t j0 = static_cast<size_t>(static_cast<std::ptrdiff_t>(index) + offset[k0]);
+                        if constexpr (kFloatMirror) {
+                            if (float_sums) {
+                                IGSOACouplingKernels::accumulateContiguousFloat(
+                                    simd, src_re + j0, src_im + j0, stencil->weight32() + k0, run_length[r],
+                                    src_re[index], src_im[index], coupling_re, coupling_im);
+                                continue;
+                            }
+                        }
+                        IGSOACouplingKernels::accumulateContiguous(
+                            simd, src_re + j0, src_im + j0, weight + k0, run_length[r],
+                            self_re, self_im, coupling_re, coupling_im);
+                    }
+                } else {
+                    const int* offset_x = stencil->dx();
+                    const int* offset_y = stencil->dy();
+                    const int* offset_z = stencil->dz();
+                    for (size_t k = 0; k < count; ++k) {
+                        int x_j = (x_i + offset_x[k]) % N_x_int;
+                        if (x_j < 0) x_j += N_x_int;
+                        int y_j = (y_i + offset_y[k]) % N_y_int;
+                        if (y_j < 0) y_j += N_y_int;
+                        int z_j = (z_i + offset_z[k]) % N_z_int;
+                        if (z_j < 0) z_j += N_z_int;
+
+                        const size_t neighbor_index =
+                            static_cast<size_t>(z_j) * plane_size +
+                            static_cast<size_t>(y_j) * N_x +
+                            static_cast<size_t>(x_j);
+                        coupling_re += weight[k] * (src_re[neighbor_index] - self_re);
+                        coupling_im += weight[k] * (src_im[neighbor_index] - self_im);
+                    }
+                }
+                terms += count;
+            } else if (graph != nullptr) {
+                // Packed per-node R_c rows: the direct loop's terms and weights
+                terms += graph->accumulate(index, src_re, src_im, float_sums, coupling_re, coupling_im);
+            } else if (N_total > 1) {
+                const double radius = std::max(nodes[index].R_c, 0.0);
                 if (radius > 0.0) {
                     const int R_c_int = static_cast<int>(std::ceil(radius));
                     const double radius_sq = radius * radius;
@@ -107,30 +238,124 @@ public:
 
                                 if (dist_sq <= radius_sq) {
                                     const double distance = std::sqrt(dist_sq);
-                                    const double coupling_strength = couplingKernel(distance, radius);
+                                    const double coupling_strength = couplingKernel<Kernel>(distance, radius);
 
                                     const size_t neighbor_index =
                                         static_cast<size_t>(z_j) * plane_size +
                                         static_cast<size_t>(y_j) * N_x +
                                         static_cast<size_t>(x_j);
 
-                                    nonlocal_coupling += coupling_strength * (nodes[neighbor_index].psi - node.psi);
-                                    neighbor_operations++;
+                                    coupling_re += coupling_strength * (src_re[neighbor_index] - self_re);
+                                    coupling_im += coupling_strength * (src_im[neighbor_index] - self_im);
+                                    terms++;
                                 }
                             }
                         }
                     }
                 }
             }
+            return terms;
+        };
+
+        if (integrator != IGSOAIntegrator::Euler) {
+            return IGSOARungeKutta::integrate(
+                integrator, nodes, soa, dt, hbar,
+                [&](const double* in_re, const double* in_im) {
+                    if (use_spectral) {
+                        #pragma omp single
+                        spectral->apply(in_re, in_im);
+                    }
+                },
+                [&](size_t i, const double* src_re, const double* src_im,
+                    double& coupling_re, double& coupling_im) {
+                    const uint64_t terms = accumulate_coupling(
+                        static_cast<int>(i % N_x), static_cast<int>((i / N_x) % N_y), static_cast<int>(i / plane_size),
+                        src_re, src_im, coupling_re, coupling_im);
+                    coupling_re *= coupling_gain;
+                    coupling_im *= coupling_gain;
+                    return terms;
+                });
+        }
+
+        if (use_spectral) {
+            #pragma omp single
+            spectral->apply(psi_re, psi_im);
+        }
+
+        // Evolve one node with non-local coupling; returns operations performed
+        auto evolve_node = [&](int x_i, int y_i, int z_i, auto* src_re, auto* src_im) -> uint64_t {
+            const size_t index =
+                static_cast<size_t>(z_i) * plane_size +
+                static_cast<size_t>(y_i) * N_x +
+                static_cast<size_t>(x_i);
+            auto& node = nodes[index];
+
+            std::complex<double> V_eff = node.kappa * node.phi;
+            double coupling_re = 0.0;
+            double coupling_im = 0.0;
+            const uint64_t node_operations = 1 + accumulate_coupling(x_i, y_i, z_i, src_re, src_im, coupling_re, coupling_im);
+            const std::complex<double> nonlocal_coupling(coupling_gain * coupling_re, coupling_gain * coupling_im);
 
             std::complex<double> i_gamma(0.0, node.gamma);
             std::complex<double> H_psi = -nonlocal_coupling + V_eff * node.psi + i_gamma * node.psi;
             std::complex<double> i_unit(0.0, 1.0);
             node.psi_dot = (-i_unit / hbar) * H_psi;
             node.psi += node.psi_dot * dt;
+            if (write_through) {
+                src_re[index] = static_cast<std::decay_t<decltype(*src_re)>>(node.psi.real());
+                src_im[index] = static_cast<std::decay_t<decltype(*src_im)>>(node.psi.imag());
+            }
+            return node_operations;
+        };
+        auto evolve = [&](int x_i, int y_i, int z_i) -> uint64_t {
+            return float_mirror ? evolve_node(x_i, y_i, z_i, psi32_re, psi32_im) : evolve_node(x_i, y_i, z_i, psi_re, psi_im);
+        };
+
+        // One plane; nodes of inactive mask blocks keep Ψ and report Ψ̇ = 0
+        auto evolve_plane = [&](int z) -> uint64_t {
+            uint64_t plane_operations = 0;
+            const size_t block = mask != nullptr ? mask->blockEdge() : 1;
+            for (int y = 0; y < N_y_int; ++y) {
+                const uint8_t* active = mask != nullptr
+                    ? mask->row(static_cast<size_t>(y), static_cast<size_t>(z)) : nullptr;
+                for (int x = 0; x < N_x_int; ++x) {
+                    if (active != nullptr && !active[static_cast<size_t>(x) / block]) {
+                        nodes[static_cast<size_t>(z) * plane_size + static_cast<size_t>(y) * N_x +
+                              static_cast<size_t>(x)].psi_dot = 0.0;
+                        continue;
+                    }
+                    plane_operations += evolve(x, y, z);
+                }
+            }
+            return plane_operations;
+        };
+
+        if (write_through) {
+            // In-place sweep depends on traversal order: keep it on one thread
+            #pragma omp single
+            for (int z = 0; z < N_z_int; ++z) {
+                neighbor_operations += evolve_plane(z);
+            }
+        } else {
+            #pragma omp for schedule(static)
+            for (int z = 0; z < N_z_int; ++z) {
+                neighbor_operations += evolve_plane(z);
+            }
         }
 
-        return neighbor_operations + static_cast<uint64_t>(N_total);
+        return neighbor_operations;
+    }
+
+    static uint64_t evolveQuantumState(
+        std::vector<IGSOAComplexNode>& nodes,
+        double dt,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z,
+        double hbar = 1.0
+    ) {
+        IGSOAStateSoA soa;
+        return evolveQuantumState(nodes, soa, dt, N_x, N_y, N_z, hbar);
     }
 
     static uint64_t evolveCausalField(
@@ -139,7 +364,10 @@ public:
     ) {
         uint64_t operations = 0;
 
-        for (auto& node : nodes) {
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; ++i) {
+            auto& node = nodes[static_cast<size_t>(i)];
             const double coupling_diff = node.phi - node.psi.real();
             node.phi_dot = -node.kappa * coupling_diff - node.gamma * node.phi;
             node.phi += node.phi_dot * dt;
@@ -151,7 +379,10 @@ public:
 
     static uint64_t updateDerivedQuantities(std::vector<IGSOAComplexNode>& nodes) {
         uint64_t operations = 0;
-        for (auto& node : nodes) {
+        const int64_t N_int = static_cast<int64_t>(nodes.size());
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N_int; ++i) {
+            auto& node = nodes[static_cast<size_t>(i)];
             node.updateInformationalDensity();
             node.updatePhase();
             node.updateEntropyRate();
@@ -167,18 +398,25 @@ public:
      */
     static uint64_t computeGradients(
         std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
         size_t N_x,
         size_t N_y,
         size_t N_z
     ) {
-        const size_t N_total = N_x * N_y * N_z;
         const size_t plane_size = N_x * N_y;
+        const int N_y_int = static_cast<int>(N_y);
+        const int N_z_int = static_cast<int>(N_z);
+        const int N_x_int = static_cast<int>(N_x);
         uint64_t operations = 0;
 
-        for (size_t index = 0; index < N_total; ++index) {
-            const int x_i = static_cast<int>(index % N_x);
-            const int y_i = static_cast<int>((index / N_x) % N_y);
-            const int z_i = static_cast<int>(index / plane_size);
+        soa.gatherF(nodes);
+        const double* F = soa.F.data();
+
+        #pragma omp for schedule(static)
+        for (int z_i = 0; z_i < N_z_int; ++z_i) {
+          for (int y_i = 0; y_i < N_y_int; ++y_i) {
+            for (int x_i = 0; x_i < N_x_int; ++x_i) {
+            const size_t index = static_cast<size_t>(z_i) * plane_size + static_cast<size_t>(y_i) * N_x + static_cast<size_t>(x_i);
 
             // Neighbor indices with wrapping
             const int x_right = (x_i == static_cast<int>(N_x) - 1) ? 0 : x_i + 1;
@@ -197,38 +435,139 @@ public:
             const size_t idx_back = static_cast<size_t>(z_back) * plane_size + static_cast<size_t>(y_i) * N_x + static_cast<size_t>(x_i);
 
             // Central differences: ∂F/∂x ≈ (F[x+1] - F[x-1]) / 2
-            const double dF_dx = (nodes[idx_right].F - nodes[idx_left].F) * 0.5;
-            const double dF_dy = (nodes[idx_up].F - nodes[idx_down].F) * 0.5;
-            const double dF_dz = (nodes[idx_front].F - nodes[idx_back].F) * 0.5;
+            const double dF_dx = (F[idx_right] - F[idx_left]) * 0.5;
+            const double dF_dy = (F[idx_up] - F[idx_down]) * 0.5;
+            const double dF_dz = (F[idx_front] - F[idx_back]) * 0.5;
 
             // Store gradient magnitude
             nodes[index].F_gradient = std::sqrt(dF_dx * dF_dx + dF_dy * dF_dy + dF_dz * dF_dz);
             operations++;
+            }
+          }
         }
         return operations;
     }
 
+    static uint64_t computeGradients(
+        std::vector<IGSOAComplexNode>& nodes,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z
+    ) {
+        IGSOAStateSoA soa;
+        return computeGradients(nodes, soa, N_x, N_y, N_z);
+    }
+
     static uint64_t timeStep(
         std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
         const IGSOAComplexConfig& config,
         size_t N_x,
         size_t N_y,
-        size_t N_z
+        size_t N_z,
+        const NeighborStencil3D* stencil = nullptr,
+        IGSOASpectralCoupling* spectral = nullptr,
+        IGSOAActivityMask* mask = nullptr,
+        const IGSOANeighborGraph3D* graph = nullptr,
+        bool derived = true,   // false defers derived fields to refreshDerived (see IGSOAPhysics::timeStep)
+        const std::complex<double>* drive = nullptr   // Driving sample fused into the Ψ gather (ditto)
     ) {
+        const size_t N_total = N_x * N_y * N_z;
+        if (soa.size() != nodes.size()) {
+            soa.resize(nodes.size());  // Never resize inside the parallel region
+        }
+        soa.reserveStages(config.integrator);
+        soa.reservePrecision(config.precision);
+        // Sparse evolution: rebuild the activity mask (igsoa_activity_mask.h)
+        if (mask != nullptr && IGSOAActivityMask::enabled(config)) {
+            // The mask must see the driven state, so drive ahead of it
+            if (drive != nullptr) {
+                applyDriving(nodes, drive->real(), drive->imag());
+                drive = nullptr;
+            }
+            DASE_TRACE_ZONE("igsoa.activity_mask");
+            mask->update(nodes, N_x, N_y, N_z, config);
+        } else {
+            mask = nullptr;
+        }
+
         uint64_t operations = 0;
-        operations += evolveQuantumState(nodes, config.dt, N_x, N_y, N_z);
-        operations += evolveCausalField(nodes, config.dt);
-        operations += updateDerivedQuantities(nodes);  // Fixed: now returns operation count
-        operations += computeGradients(nodes, N_x, N_y, N_z);
-
-        // Normalize if requested (matches 1D/2D behavior)
-        if (config.normalize_psi) {
-            operations += IGSOAPhysics::normalizeStates(nodes);
+
+        // Single parallel region for the whole step (see IGSOAPhysics::timeStep)
+        #pragma omp parallel if(N_total >= config.omp_min_nodes) reduction(+:operations)
+        {
+            {
+                DASE_TRACE_ZONE("igsoa.coupling");
+                operations += withKernelPolicy(config.kernel_policy, [&](auto kernel) {
+                    return evolveQuantumState<decltype(kernel)>(nodes, soa, config.dt, N_x, N_y, N_z, 1.0, config.update_mode, stencil, spectral, config.simd_coupling, config.integrator, config.precision, mask, graph, drive, config.coupling_gain);
+                });
+            }
+            { DASE_TRACE_ZONE("igsoa.causal_field"); operations += evolveCausalField(nodes, config.dt); }
+            if (derived) {
+                { DASE_TRACE_ZONE("igsoa.derived"); operations += updateDerivedQuantities(nodes); }
+                { DASE_TRACE_ZONE("igsoa.gradients"); operations += computeGradients(nodes, soa, N_x, N_y, N_z); }
+            } else if (config.normalize_psi) {
+                DASE_TRACE_ZONE("igsoa.derived");
+                operations += IGSOAPhysics::updateDensityAndEntropy(nodes);
+            }
+
+            // Normalize if requested (matches 1D/2D behavior)
+            if (config.normalize_psi) {
+                DASE_TRACE_ZONE("igsoa.normalize");
+                operations += IGSOAPhysics::normalizeStates(nodes);
+            }
         }
 
         return operations;
     }
 
+    /**
+     * Complete the derived fields of a timeStep(..., derived = false)
+     * (see IGSOAPhysics::refreshDerived)
+     */
+    static uint64_t refreshDerived(
+        std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
+        const IGSOAComplexConfig& config,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z
+    ) {
+        if (soa.size() != nodes.size()) {
+            soa.resize(nodes.size());
+        }
+        uint64_t operations = 0;
+        #pragma omp parallel if(N_x * N_y * N_z >= config.omp_min_nodes) reduction(+:operations)
+        {
+            DASE_TRACE_ZONE("igsoa.derived");
+            operations += config.normalize_psi ? IGSOAPhysics::updatePhases(nodes) : updateDerivedQuantities(nodes);
+            operations += computeGradients(nodes, soa, N_x, N_y, N_z);
+        }
+        return operations;
+    }
+
+    static uint64_t timeStep(
+        std::vector<IGSOAComplexNode>& nodes,
+        const IGSOAComplexConfig& config,
+        size_t N_x,
+        size_t N_y,
+        size_t N_z
+    ) {
+        IGSOAStateSoA soa(nodes.size());
+        return timeStep(nodes, soa, config, N_x, N_y, N_z);
+    }
+
+    /**
+     * Fused energy / entropy-rate reduction (shared with 1D)
+     */
+    static void computeTotals(
+        const std::vector<IGSOAComplexNode>& nodes,
+        double& energy_out,
+        double& entropy_rate_out
+    ) {
+        IGSOAPhysics::computeTotals(nodes, energy_out, entropy_rate_out);
+    }
+
     static void applyDriving(
         std::vector<IGSOAComplexNode>& nodes,
         double signal_real,
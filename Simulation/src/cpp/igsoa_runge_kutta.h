@@ -0,0 +1,143 @@
+/**
+ * IGSOA Runge-Kutta Integrators
+ *
+ * Explicit RK2 (midpoint) and classical RK4 for the Ψ equation
+ *
+ *   ∂Ψ/∂t = f(Ψ) = -i/ℏ (-𝒦[Ψ] + V_eff Ψ + iΓ Ψ)
+ *
+ * shared by IGSOAPhysics, IGSOAPhysics2D and IGSOAPhysics3D.  Each engine
+ * supplies its coupling sum 𝒦 for an arbitrary Ψ array; V_eff = κΦ uses the
+ * start-of-step Φ in every stage (Φ is integrated after Ψ, as with Euler).
+ *
+ * Every stage is a single pass over the lattice: the coupling sum of the
+ * stage input, the derivative k_s and the stage combination are fused per
+ * node, so a stage reads the input array once and writes the next input
+ * (and, for RK4, the running slope sum) in the same sweep:
+ *
+ *   RK2  in₁ = Ψ₀ + dt/2 k₀                      Ψ = Ψ₀ + dt k₁
+ *   RK4  in₁ = Ψ₀ + dt/2 k₀   in₂ = Ψ₀ + dt/2 k₁  in₃ = Ψ₀ + dt k₂
+ *        Ψ = Ψ₀ + dt/6 (k₀ + 2k₁ + 2k₂ + k₃)
+ *
+ * Ψ₀ is the gathered SoA copy of the nodes; the inputs alternate between the
+ * two IGSOAStateSoA stage buffers (a stage must not overwrite the Ψ its
+ * neighbours are still reading), sized once by reserveStages() outside the
+ * parallel region.  The last stage writes Ψ and psi_dot (the step's
+ * effective slope) to the nodes.
+ *
+ * Threading: orphaned `omp for` per stage; the implicit barrier at its end
+ * publishes the stage input to every thread before the next stage reads it.
+ */
+
+#pragma once
+
+#include "igsoa_complex_node.h"
+#include "igsoa_state_soa.h"
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+struct IGSOARungeKutta {
+    /**
+     * Coupling passes per step
+     */
+    static constexpr int stages(IGSOAIntegrator integrator) {
+        return integrator == IGSOAIntegrator::RK4 ? 4 : integrator == IGSOAIntegrator::RK2 ? 2 : 1;
+    }
+
+    /**
+     * f(Ψ) at one node, given its coupling sum 𝒦[Ψ]_i (same expression as
+     * the engines' Euler update)
+     */
+    static inline std::complex<double> derivative(
+        const IGSOAComplexNode& node,
+        std::complex<double> psi,
+        std::complex<double> nonlocal_coupling,
+        double hbar
+    ) {
+        const std::complex<double> V_eff = node.kappa * node.phi;
+        const std::complex<double> i_gamma(0.0, node.gamma);
+        const std::complex<double> H_psi = -nonlocal_coupling + V_eff * psi + i_gamma * psi;
+        const std::complex<double> i_unit(0.0, 1.0);
+        return (-i_unit / hbar) * H_psi;
+    }
+
+    /**
+     * Advance Ψ by one RK2/RK4 step
+     *
+     * @param soa Ψ₀ in psi_re/psi_im (already gathered), stage buffers reserved
+     * @param prepare Called on every thread with each stage input before its
+     *                pass (e.g. an `omp single` FFT of the input)
+     * @param coupling uint64_t(size_t i, const double* re, const double* im,
+     *                 double& coupling_re, double& coupling_im): adds 𝒦[in]_i
+     *                 and returns the neighbour terms summed
+     * @return Operations of the calling thread's share (1 + terms per node
+     *         per stage)
+     */
+    template <typename Prepare, typename Coupling>
+    static uint64_t integrate(
+        IGSOAIntegrator integrator,
+        std::vector<IGSOAComplexNode>& nodes,
+        IGSOAStateSoA& soa,
+        double dt,
+        double hbar,
+        Prepare&& prepare,
+        Coupling&& coupling
+    ) {
+        const int num_stages = stages(integrator);
+        const bool rk4 = (integrator == IGSOAIntegrator::RK4);
+        const int64_t N = static_cast<int64_t>(nodes.size());
+        const double* psi0_re = soa.psi_re.data();
+        const double* psi0_im = soa.psi_im.data();
+        double* slope_re = soa.slope_re.data();
+        double* slope_im = soa.slope_im.data();
+        uint64_t operations = 0;
+
+        for (int s = 0; s < num_stages; ++s) {
+            const double* in_re = s == 0 ? psi0_re : soa.stage_re[(s - 1) & 1].data();
+            const double* in_im = s == 0 ? psi0_im : soa.stage_im[(s - 1) & 1].data();
+            double* out_re = soa.stage_re[s & 1].data();
+            double* out_im = soa.stage_im[s & 1].data();
+            const bool last = (s + 1 == num_stages);
+            // Offset of the next stage input: dt/2 except RK4's third stage
+            const double next_dt = (rk4 && s == 2) ? dt : 0.5 * dt;
+            // RK4 slope weights 1, 2, 2 (the last stage's k enters directly)
+            const double slope_weight = (s == 0) ? 1.0 : 2.0;
+
+            prepare(in_re, in_im);
+
+            #pragma omp for schedule(static)
+            for (int64_t ii = 0; ii < N; ++ii) {
+                const size_t i = static_cast<size_t>(ii);
+                auto& node = nodes[i];
+                double coupling_re = 0.0;
+                double coupling_im = 0.0;
+                operations += 1 + coupling(i, in_re, in_im, coupling_re, coupling_im);
+
+                const std::complex<double> k = derivative(
+                    node, {in_re[i], in_im[i]}, {coupling_re, coupling_im}, hbar);
+                const std::complex<double> psi0(psi0_re[i], psi0_im[i]);
+                if (last) {
+                    const std::complex<double> slope =
+                        rk4 ? (std::complex<double>(slope_re[i], slope_im[i]) + k) / 6.0 : k;
+                    node.psi_dot = slope;
+                    node.psi = psi0 + slope * dt;
+                } else {
+                    const std::complex<double> next = psi0 + k * next_dt;
+                    out_re[i] = next.real();
+                    out_im[i] = next.imag();
+                    if (rk4) {
+                        slope_re[i] = (s == 0 ? 0.0 : slope_re[i]) + slope_weight * k.real();
+                        slope_im[i] = (s == 0 ? 0.0 : slope_im[i]) + slope_weight * k.imag();
+                    }
+                }
+            }
+        }
+        return operations;
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,266 @@
+/**
+ * IGSOA Coupling Accumulation Kernels (scalar + AVX2/FMA)
+ *
+ * The inner loop of every IGSOA coupling sum is
+ *
+ *   acc += w_k * (Ψ_{j_k} - Ψ_i)
+ *
+ * over packed Re/Im arrays (IGSOAStateSoA).  These kernels evaluate it over a
+ * contiguous span of neighbours (1D interior nodes, and each x-run of a
+ * NeighborStencil2D/3D for interior nodes), four neighbours per AVX2 vector.
+ *
+ * Dispatch mirrors the DASE analog engine: AVX2+FMA is chosen at runtime via
+ * CPUFeatures, with a scalar fallback.  The AVX2 bodies carry a per-function
+ * target attribute so the header works in translation units built without
+ * -mavx2.
+ *
+ * Numerics: the scalar kernels add terms in index order (bit-identical to the
+ * original loops).  The AVX2 kernels reorder the sum into four lanes and
+ * use FMA, so results agree to round-off only; pass use_simd = false through
+ * the physics kernels (IGSOAComplexConfig::simd_coupling) for bit-exact
+ * reproduction across machines.
+ *
+ * Float mirror (IGSOAPrecision): the MixedFloat kernels read float Ψ and
+ * widen each term to double (four lanes, as above); the Float kernels read
+ * float Ψ and float weights and sum the span in float, eight lanes per
+ * __m256, then add the span total to the double accumulator.
+ */
+
+#pragma once
+
+#include "cpu_features.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define IGSOA_HAVE_AVX2_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#if defined(IGSOA_HAVE_AVX2_KERNELS) && (defined(__GNUC__) || defined(__clang__))
+#define IGSOA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define IGSOA_TARGET_AVX2
+#endif
+
+namespace dase {
+namespace igsoa {
+
+struct IGSOACouplingKernels {
+    /**
+     * True if the AVX2/FMA kernels can run on this CPU (checked once)
+     */
+    static bool avx2Available() {
+#ifdef IGSOA_HAVE_AVX2_KERNELS
+        static const bool available = CPUFeatures::hasAVX2() && CPUFeatures::hasFMA();
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * acc += Σ_{m<n} w[m] (re[m] - self_re), likewise for Im
+     */
+    static inline void accumulateContiguousScalar(
+        const double* re, const double* im, const double* w, size_t n,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        for (size_t m = 0; m < n; ++m) {
+            acc_re += w[m] * (re[m] - self_re);
+            acc_im += w[m] * (im[m] - self_im);
+        }
+    }
+
+#ifdef IGSOA_HAVE_AVX2_KERNELS
+    static IGSOA_TARGET_AVX2 inline double horizontalSum(__m256d v) {
+        const __m128d lo = _mm256_castpd256_pd128(v);
+        const __m128d hi = _mm256_extractf128_pd(v, 1);
+        const __m128d pair = _mm_add_pd(lo, hi);
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+
+    static IGSOA_TARGET_AVX2 void accumulateContiguousAVX2(
+        const double* re, const double* im, const double* w, size_t n,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        const __m256d self_re_vec = _mm256_set1_pd(self_re);
+        const __m256d self_im_vec = _mm256_set1_pd(self_im);
+        __m256d sum_re = _mm256_setzero_pd();
+        __m256d sum_im = _mm256_setzero_pd();
+
+        size_t m = 0;
+        const size_t n_avx2 = (n / 4) * 4;
+        for (; m < n_avx2; m += 4) {
+            const __m256d w_vec = _mm256_loadu_pd(w + m);
+            const __m256d d_re = _mm256_sub_pd(_mm256_loadu_pd(re + m), self_re_vec);
+            const __m256d d_im = _mm256_sub_pd(_mm256_loadu_pd(im + m), self_im_vec);
+            sum_re = _mm256_fmadd_pd(w_vec, d_re, sum_re);
+            sum_im = _mm256_fmadd_pd(w_vec, d_im, sum_im);
+        }
+
+        double tail_re = horizontalSum(sum_re);
+        double tail_im = horizontalSum(sum_im);
+        accumulateContiguousScalar(re + m, im + m, w + m, n - m, self_re, self_im, tail_re, tail_im);
+        acc_re += tail_re;
+        acc_im += tail_im;
+    }
+#endif
+
+    /**
+     * Float mirror, double sums: acc += Σ_{m<n} w[m] (double(re[m]) - self_re)
+     */
+    static inline void accumulateContiguousScalar(
+        const float* re, const float* im, const double* w, size_t n,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        for (size_t m = 0; m < n; ++m) {
+            acc_re += w[m] * (static_cast<double>(re[m]) - self_re);
+            acc_im += w[m] * (static_cast<double>(im[m]) - self_im);
+        }
+    }
+
+    /**
+     * Float mirror, float span sum: acc += Σ_{m<n} w[m] (re[m] - self_re)
+     * evaluated in float
+     */
+    static inline void accumulateContiguousFloatScalar(
+        const float* re, const float* im, const float* w, size_t n,
+        float self_re, float self_im,
+        double& acc_re, double& acc_im
+    ) {
+        float sum_re = 0.0f;
+        float sum_im = 0.0f;
+        for (size_t m = 0; m < n; ++m) {
+            sum_re += w[m] * (re[m] - self_re);
+            sum_im += w[m] * (im[m] - self_im);
+        }
+        acc_re += static_cast<double>(sum_re);
+        acc_im += static_cast<double>(sum_im);
+    }
+
+#ifdef IGSOA_HAVE_AVX2_KERNELS
+    static IGSOA_TARGET_AVX2 inline float horizontalSum(__m256 v) {
+        const __m128 lo = _mm256_castps256_ps128(v);
+        const __m128 hi = _mm256_extractf128_ps(v, 1);
+        __m128 quad = _mm_add_ps(lo, hi);
+        quad = _mm_add_ps(quad, _mm_movehl_ps(quad, quad));
+        return _mm_cvtss_f32(_mm_add_ss(quad, _mm_movehdup_ps(quad)));
+    }
+
+    static IGSOA_TARGET_AVX2 void accumulateContiguousAVX2(
+        const float* re, const float* im, const double* w, size_t n,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+        const __m256d self_re_vec = _mm256_set1_pd(self_re);
+        const __m256d self_im_vec = _mm256_set1_pd(self_im);
+        __m256d sum_re = _mm256_setzero_pd();
+        __m256d sum_im = _mm256_setzero_pd();
+
+        size_t m = 0;
+        const size_t n_avx2 = (n / 4) * 4;
+        for (; m < n_avx2; m += 4) {
+            const __m256d w_vec = _mm256_loadu_pd(w + m);
+            const __m256d d_re = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(re + m)), self_re_vec);
+            const __m256d d_im = _mm256_sub_pd(_mm256_cvtps_pd(_mm_loadu_ps(im + m)), self_im_vec);
+            sum_re = _mm256_fmadd_pd(w_vec, d_re, sum_re);
+            sum_im = _mm256_fmadd_pd(w_vec, d_im, sum_im);
+        }
+
+        double tail_re = horizontalSum(sum_re);
+        double tail_im = horizontalSum(sum_im);
+        accumulateContiguousScalar(re + m, im + m, w + m, n - m, self_re, self_im, tail_re, tail_im);
+        acc_re += tail_re;
+        acc_im += tail_im;
+    }
+
+    static IGSOA_TARGET_AVX2 void accumulateContiguousFloatAVX2(
+        const float* re, const float* im, const float* w, size_t n,
+        float self_re, float self_im,
+        double& acc_re, double& acc_im
+    ) {
+        const __m256 self_re_vec = _mm256_set1_ps(self_re);
+        const __m256 self_im_vec = _mm256_set1_ps(self_im);
+        __m256 sum_re = _mm256_setzero_ps();
+        __m256 sum_im = _mm256_setzero_ps();
+
+        size_t m = 0;
+        const size_t n_avx2 = (n / 8) * 8;
+        for (; m < n_avx2; m += 8) {
+            const __m256 w_vec = _mm256_loadu_ps(w + m);
+            sum_re = _mm256_fmadd_ps(w_vec, _mm256_sub_ps(_mm256_loadu_ps(re + m), self_re_vec), sum_re);
+            sum_im = _mm256_fmadd_ps(w_vec, _mm256_sub_ps(_mm256_loadu_ps(im + m), self_im_vec), sum_im);
+        }
+
+        float tail_re = horizontalSum(sum_re);
+        float tail_im = horizontalSum(sum_im);
+        for (; m < n; ++m) {
+            tail_re += w[m] * (re[m] - self_re);
+            tail_im += w[m] * (im[m] - self_im);
+        }
+        acc_re += static_cast<double>(tail_re);
+        acc_im += static_cast<double>(tail_im);
+    }
+#endif
+
+    /**
+     * Dispatching front end (simd = caller's permission to use AVX2)
+     */
+    static inline void accumulateContiguous(
+        bool simd,
+        const double* re, const double* im, const double* w, size_t n,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+#ifdef IGSOA_HAVE_AVX2_KERNELS
+        if (simd) {
+            accumulateContiguousAVX2(re, im, w, n, self_re, self_im, acc_re, acc_im);
+            return;
+        }
+#else
+        (void)simd;
+#endif
+        accumulateContiguousScalar(re, im, w, n, self_re, self_im, acc_re, acc_im);
+    }
+
+    static inline void accumulateContiguous(
+        bool simd,
+        const float* re, const float* im, const double* w, size_t n,
+        double self_re, double self_im,
+        double& acc_re, double& acc_im
+    ) {
+#ifdef IGSOA_HAVE_AVX2_KERNELS
+        if (simd) {
+            accumulateContiguousAVX2(re, im, w, n, self_re, self_im, acc_re, acc_im);
+            return;
+        }
+#else
+        (void)simd;
+#endif
+        accumulateContiguousScalar(re, im, w, n, self_re, self_im, acc_re, acc_im);
+    }
+
+    static inline void accumulateContiguousFloat(
+        bool simd,
+        const float* re, const float* im, const float* w, size_t n,
+        float self_re, float self_im,
+        double& acc_re, double& acc_im
+    ) {
+#ifdef IGSOA_HAVE_AVX2_KERNELS
+        if (simd) {
+            accumulateContiguousFloatAVX2(re, im, w, n, self_re, self_im, acc_re, acc_im);
+            return;
+        }
+#else
+        (void)simd;
+#endif
+        accumulateContiguousFloatScalar(re, im, w, n, self_re, self_im, acc_re, acc_im);
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,281 @@
+/**
+ * IGSOA Slab Decomposition (3D)
+ *
+ * Splits the periodic N_z planes of an IGSOA 3D lattice into contiguous
+ * z-slabs, one per MPI rank (balanced to within one plane).  Storage is
+ * z-slowest, so a slab is one contiguous block.  Local plane-major arrays
+ * hold the owned planes between `halo` ghost planes on each side:
+ *
+ *   local plane:  [ 0 .. halo-1 | halo .. halo+owned-1 | halo+owned .. ]
+ *                   lower ghosts   owned                  upper ghosts
+ *
+ * Unlike the GW engine's SlabDecomposition (gw/slab_decomposition.h, open
+ * z-boundary, one ghost plane) the IGSOA lattice is a torus: rank 0's lower
+ * ghosts are the last rank's top planes, and the halo is as wide as the
+ * coupling reach ceil(R_c).  Each rank must own at least `halo` planes so a
+ * ghost block comes from one neighbour.
+ *
+ * Build with IGSOA_USE_MPI (CMake ENABLE_MPI) for the MPI constructor;
+ * without it only the single-rank decomposition exists, whose halo
+ * exchange copies its own planes across the periodic wrap.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef IGSOA_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace dase {
+namespace igsoa {
+
+class IGSOASlabDecomposition3D {
+public:
+    /**
+     * Single-rank decomposition (the whole lattice is local)
+     * @param halo Ghost planes on each side (coupling reach)
+     */
+    IGSOASlabDecomposition3D(size_t N_z, int halo)
+        : N_z_(N_z), halo_(halo) {
+        assignSlab();
+    }
+
+#ifdef IGSOA_USE_MPI
+    /**
+     * Distribute N_z planes over the ranks of comm
+     * @throws std::invalid_argument if a rank would own fewer than
+     *         max(halo, 1) planes
+     */
+    IGSOASlabDecomposition3D(size_t N_z, int halo, MPI_Comm comm)
+        : N_z_(N_z), halo_(halo), comm_(comm) {
+        MPI_Comm_rank(comm_, &rank_);
+        MPI_Comm_size(comm_, &num_ranks_);
+        assignSlab();
+    }
+#endif
+
+    int getRank() const { return rank_; }
+    int getNumRanks() const { return num_ranks_; }
+    bool isRoot() const { return rank_ == 0; }
+    int getHalo() const { return halo_; }
+    size_t getGlobalNz() const { return N_z_; }
+
+    // Owned global planes [begin, end)
+    size_t getOwnedBegin() const { return owned_begin_; }
+    size_t getOwnedEnd() const { return owned_end_; }
+    size_t getOwnedPlanes() const { return owned_end_ - owned_begin_; }
+    bool owns(size_t z) const { return z >= owned_begin_ && z < owned_end_; }
+
+    // Planes of a local array (owned plus both ghost blocks)
+    size_t getLocalPlanes() const { return getOwnedPlanes() + 2 * static_cast<size_t>(halo_); }
+
+    /**
+     * Start refreshing `width` (<= halo) ghost planes on each side of
+     * num_arrays local plane-major arrays.  The owned planes may be read
+     * but not written until finishHaloExchange().
+     */
+    void beginHaloExchange(double* const* arrays, int num_arrays, size_t plane_size, int width) {
+        if (width <= 0) {
+            return;
+        }
+        if (width > halo_) {
+            throw std::invalid_argument("Halo exchange wider than the decomposition halo");
+        }
+        const size_t owned = getOwnedPlanes();
+        const size_t lower_ghost = static_cast<size_t>(halo_ - width);
+        const size_t upper_ghost = static_cast<size_t>(halo_) + owned;
+        const size_t block = static_cast<size_t>(width) * plane_size;
+
+        if (num_ranks_ == 1) {
+            // Periodic wrap onto the own planes (any N_z, even below width)
+            for (int a = 0; a < num_arrays; ++a) {
+                double* data = arrays[a];
+                for (int g = 0; g < width; ++g) {
+                    const size_t below = (N_z_ - (static_cast<size_t>(width - g) % N_z_)) % N_z_;
+                    const size_t above = static_cast<size_t>(g) % N_z_;
+                    std::memcpy(data + (lower_ghost + g) * plane_size,
+                                data + (static_cast<size_t>(halo_) + below) * plane_size,
+                                plane_size * sizeof(double));
+                    std::memcpy(data + (upper_ghost + g) * plane_size,
+                                data + (static_cast<size_t>(halo_) + above) * plane_size,
+                                plane_size * sizeof(double));
+                }
+            }
+            return;
+        }
+
+#ifdef IGSOA_USE_MPI
+        const int below = (rank_ + num_ranks_ - 1) % num_ranks_;
+        const int above = (rank_ + 1) % num_ranks_;
+        const int count = static_cast<int>(block);
+        requests_.resize(static_cast<size_t>(4 * num_arrays));
+        for (int a = 0; a < num_arrays; ++a) {
+            double* data = arrays[a];
+            MPI_Request* request = requests_.data() + 4 * a;
+            // Lower ghosts <- top owned planes of the rank below; upper
+            // ghosts <- bottom owned planes of the rank above
+            MPI_Irecv(data + lower_ghost * plane_size, count, MPI_DOUBLE, below, 2 * a, comm_, &request[0]);
+            MPI_Irecv(data + upper_ghost * plane_size, count, MPI_DOUBLE, above, 2 * a + 1, comm_, &request[1]);
+            MPI_Isend(data + (upper_ghost - static_cast<size_t>(width)) * plane_size, count, MPI_DOUBLE,
+                      above, 2 * a, comm_, &request[2]);
+            MPI_Isend(data + static_cast<size_t>(halo_) * plane_size, count, MPI_DOUBLE,
+                      below, 2 * a + 1, comm_, &request[3]);
+        }
+#else
+        (void)block;
+#endif
+    }
+
+    // Wait for the ghost planes of the last beginHaloExchange()
+    void finishHaloExchange() {
+#ifdef IGSOA_USE_MPI
+        if (!requests_.empty()) {
+            MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+            requests_.clear();
+        }
+#endif
+    }
+
+    void exchangeHalos(double* const* arrays, int num_arrays, size_t plane_size, int width) {
+        beginHaloExchange(arrays, num_arrays, plane_size, width);
+        finishHaloExchange();
+    }
+
+    // Collective: sum `values` over all ranks in place
+    void sum(double* values, int count) const {
+#ifdef IGSOA_USE_MPI
+        if (num_ranks_ > 1) {
+            MPI_Allreduce(MPI_IN_PLACE, values, count, MPI_DOUBLE, MPI_SUM, comm_);
+        }
+#else
+        (void)values;
+        (void)count;
+#endif
+    }
+
+    uint64_t sum(uint64_t value) const {
+#ifdef IGSOA_USE_MPI
+        if (num_ranks_ > 1) {
+            unsigned long long global_value = 0;
+            unsigned long long local_value = value;
+            MPI_Allreduce(&local_value, &global_value, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm_);
+            return static_cast<uint64_t>(global_value);
+        }
+#endif
+        return value;
+    }
+
+    double max(double value) const {
+#ifdef IGSOA_USE_MPI
+        if (num_ranks_ > 1) {
+            double global_value = 0.0;
+            MPI_Allreduce(&value, &global_value, 1, MPI_DOUBLE, MPI_MAX, comm_);
+            return global_value;
+        }
+#endif
+        return value;
+    }
+
+    // Collective: copy `bytes` from the root to every rank
+    void broadcast(void* data, size_t bytes) const {
+#ifdef IGSOA_USE_MPI
+        if (num_ranks_ > 1 && bytes > 0) {
+            MPI_Bcast(data, static_cast<int>(bytes), MPI_BYTE, 0, comm_);
+        }
+#else
+        (void)data;
+        (void)bytes;
+#endif
+    }
+
+    /**
+     * Collective: concatenate every rank's owned planes on the root
+     * @param global Root only: N_z planes of bytes_per_plane
+     */
+    void gatherPlanes(const void* owned, size_t bytes_per_plane, void* global) const {
+        if (num_ranks_ == 1) {
+            std::memcpy(global, owned, getOwnedPlanes() * bytes_per_plane);
+            return;
+        }
+#ifdef IGSOA_USE_MPI
+        std::vector<int> counts, displacements;
+        planeCounts(bytes_per_plane, counts, displacements);
+        MPI_Gatherv(owned, static_cast<int>(getOwnedPlanes() * bytes_per_plane), MPI_BYTE,
+                    global, counts.data(), displacements.data(), MPI_BYTE, 0, comm_);
+#endif
+    }
+
+    // Collective: hand each rank its owned planes of the root's `global`
+    void scatterPlanes(const void* global, size_t bytes_per_plane, void* owned) const {
+        if (num_ranks_ == 1) {
+            std::memcpy(owned, global, getOwnedPlanes() * bytes_per_plane);
+            return;
+        }
+#ifdef IGSOA_USE_MPI
+        std::vector<int> counts, displacements;
+        planeCounts(bytes_per_plane, counts, displacements);
+        MPI_Scatterv(global, counts.data(), displacements.data(), MPI_BYTE,
+                     owned, static_cast<int>(getOwnedPlanes() * bytes_per_plane), MPI_BYTE, 0, comm_);
+#endif
+    }
+
+private:
+    size_t N_z_;
+    int halo_;
+    int rank_ = 0;
+    int num_ranks_ = 1;
+    size_t owned_begin_ = 0;
+    size_t owned_end_ = 0;
+
+#ifdef IGSOA_USE_MPI
+    MPI_Comm comm_ = MPI_COMM_SELF;
+    std::vector<MPI_Request> requests_;
+#endif
+
+    // Owned range of any rank (the first N_z % ranks take one extra plane)
+    void slabOf(int rank, size_t& begin, size_t& end) const {
+        const size_t ranks = static_cast<size_t>(num_ranks_);
+        const size_t r = static_cast<size_t>(rank);
+        const size_t base = N_z_ / ranks;
+        const size_t extra = N_z_ % ranks;
+        begin = r * base + (r < extra ? r : extra);
+        end = begin + base + (r < extra ? 1 : 0);
+    }
+
+    void assignSlab() {
+        if (halo_ < 0) {
+            throw std::invalid_argument("Slab halo must be non-negative");
+        }
+        const size_t min_planes = num_ranks_ > 1 ? static_cast<size_t>(halo_ > 0 ? halo_ : 1) : 1;
+        if (N_z_ < min_planes * static_cast<size_t>(num_ranks_)) {
+            throw std::invalid_argument(
+                "IGSOA slab decomposition needs at least " + std::to_string(min_planes) +
+                " z-plane(s) per rank, got N_z=" + std::to_string(N_z_) + " for " +
+                std::to_string(num_ranks_) + " ranks");
+        }
+        slabOf(rank_, owned_begin_, owned_end_);
+    }
+
+#ifdef IGSOA_USE_MPI
+    void planeCounts(size_t bytes_per_plane, std::vector<int>& counts, std::vector<int>& displacements) const {
+        counts.resize(static_cast<size_t>(num_ranks_));
+        displacements.resize(static_cast<size_t>(num_ranks_));
+        for (int r = 0; r < num_ranks_; ++r) {
+            size_t begin = 0, end = 0;
+            slabOf(r, begin, end);
+            counts[static_cast<size_t>(r)] = static_cast<int>((end - begin) * bytes_per_plane);
+            displacements[static_cast<size_t>(r)] = static_cast<int>(begin * bytes_per_plane);
+        }
+    }
+#endif
+};
+
+} // namespace igsoa
+} // namespace dase
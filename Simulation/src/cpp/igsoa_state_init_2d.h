@@ -3,15 +3,20 @@
  *
  * Provides state initialization functions for 2D IGSOA simulations.
  * Supports Gaussian packets, plane waves, and custom profiles.
+ *
+ * Gaussian and plane-wave fills use per-axis factor tables and split rows
+ * across OpenMP threads (igsoa_separable_profile.h).
  */
 
 #pragma once
 
 #include "igsoa_complex_node.h"
 #include "igsoa_complex_engine_2d.h"
+#include "igsoa_separable_profile.h"
 #include <vector>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 
 // Define M_PI for MSVC
 #ifndef M_PI
@@ -72,48 +77,28 @@ public:
         IGSOAComplexEngine2D& engine,
         const Gaussian2DParams& params
     ) {
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
+        const size_t N_x = engine.getNx();
+        const size_t N_y = engine.getNy();
 
         auto& nodes = engine.getNodesMutable();
 
-        for (size_t y = 0; y < N_y; y++) {
+        // Separable envelope: A · g_x(x) · g_y(y)
+        const std::vector<double> g_x = IGSOASeparableProfile::gaussianAxis(
+            N_x, params.center_x, 1.0 / (2.0 * params.sigma_x * params.sigma_x));
+        const std::vector<double> g_y = IGSOASeparableProfile::gaussianAxis(
+            N_y, params.center_y, 1.0 / (2.0 * params.sigma_y * params.sigma_y));
+        const IGSOAProfileMode mode = IGSOASeparableProfile::parseMode(params.mode, IGSOAProfileMode::Keep);
+        const double baseline_phi = params.baseline_phi;
+        const double beta = params.beta;
+
+        const int64_t rows = static_cast<int64_t>(N_y);
+        #pragma omp parallel for schedule(static) if(nodes.size() >= IGSOASeparableProfile::ompMinNodes())
+        for (int64_t yy = 0; yy < rows; yy++) {
+            const size_t y = static_cast<size_t>(yy);
+            const double row_value = params.amplitude * g_y[y];
+            IGSOAComplexNode* row = nodes.data() + y * N_x;
             for (size_t x = 0; x < N_x; x++) {
-                size_t index = y * N_x + x;
-
-                // Compute distance from center
-                double dx = static_cast<double>(x) - params.center_x;
-                double dy = static_cast<double>(y) - params.center_y;
-
-                // Gaussian envelope
-                double exponent = -(dx * dx) / (2.0 * params.sigma_x * params.sigma_x)
-                                  -(dy * dy) / (2.0 * params.sigma_y * params.sigma_y);
-                double gaussian_value = params.amplitude * std::exp(exponent);
-
-                // New quantum state (real-valued Gaussian for now)
-                std::complex<double> psi_new(gaussian_value, 0.0);
-
-                // Apply mode
-                if (params.mode == "overwrite") {
-                    // Replace existing state
-                    nodes[index].psi = psi_new;
-                    nodes[index].phi = params.baseline_phi;
-                }
-                else if (params.mode == "add") {
-                    // Add to existing state (perturbation)
-                    nodes[index].psi += psi_new;
-                    // Φ unchanged
-                }
-                else if (params.mode == "blend") {
-                    // Interpolate: Ψ_final = β*Ψ_new + (1-β)*Ψ_old
-                    double beta = params.beta;
-                    nodes[index].psi = beta * psi_new + (1.0 - beta) * nodes[index].psi;
-                    nodes[index].phi = beta * params.baseline_phi + (1.0 - beta) * nodes[index].phi;
-                }
-
-                // Update derived quantities
-                nodes[index].updateInformationalDensity();
-                nodes[index].updatePhase();
+                IGSOASeparableProfile::applyReal(row[x], row_value * g_x[x], mode, baseline_phi, beta);
             }
         }
     }
@@ -130,26 +115,25 @@ public:
         IGSOAComplexEngine2D& engine,
         const PlaneWave2DParams& params
     ) {
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
+        const size_t N_x = engine.getNx();
+        const size_t N_y = engine.getNy();
 
         auto& nodes = engine.getNodesMutable();
 
-        for (size_t y = 0; y < N_y; y++) {
-            for (size_t x = 0; x < N_x; x++) {
-                size_t index = y * N_x + x;
-
-                // Compute phase: φ = k_x*x + k_y*y + φ₀
-                double phase = params.k_x * static_cast<double>(x)
-                             + params.k_y * static_cast<double>(y)
-                             + params.phase_offset;
+        // Separable phase: A · e^{i k_x x} · e^{i(k_y y + φ₀)}
+        const auto w_x = IGSOASeparableProfile::phaseAxis(N_x, params.k_x, 0.0);
+        const auto w_y = IGSOASeparableProfile::phaseAxis(N_y, params.k_y, params.phase_offset);
 
-                // Ψ = A * exp(iφ)
-                nodes[index].psi = params.amplitude * std::exp(std::complex<double>(0.0, phase));
-
-                // Update derived quantities
-                nodes[index].updateInformationalDensity();
-                nodes[index].updatePhase();
+        const int64_t rows = static_cast<int64_t>(N_y);
+        #pragma omp parallel for schedule(static) if(nodes.size() >= IGSOASeparableProfile::ompMinNodes())
+        for (int64_t yy = 0; yy < rows; yy++) {
+            const size_t y = static_cast<size_t>(yy);
+            const std::complex<double> row_value = params.amplitude * w_y[y];
+            IGSOAComplexNode* row = nodes.data() + y * N_x;
+            for (size_t x = 0; x < N_x; x++) {
+                row[x].psi = row_value * w_x[x];
+                row[x].updateInformationalDensity();
+                row[x].updatePhase();
             }
         }
     }
@@ -172,7 +156,10 @@ public:
     ) {
         auto& nodes = engine.getNodesMutable();
 
-        for (auto& node : nodes) {
+        const int64_t N = static_cast<int64_t>(nodes.size());
+        #pragma omp parallel for schedule(static) if(nodes.size() >= IGSOASeparableProfile::ompMinNodes())
+        for (int64_t i = 0; i < N; i++) {
+            auto& node = nodes[static_cast<size_t>(i)];
             node.psi = std::complex<double>(psi_real, psi_imag);
             node.phi = phi;
             node.updateInformationalDensity();
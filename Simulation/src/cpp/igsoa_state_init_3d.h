@@ -1,10 +1,14 @@
 /**
  * IGSOA State Initialization - 3D Profiles
+ *
+ * Gaussian and plane-wave fills use per-axis factor tables and split rows
+ * across OpenMP threads (igsoa_separable_profile.h).
  */
 
 #pragma once
 
 #include "igsoa_complex_engine_3d.h"
+#include "igsoa_separable_profile.h"
 #include <algorithm>
 #include <cmath>
 #include <complex>
@@ -12,6 +16,7 @@
 #include <ctime>
 #include <random>
 #include <string>
+#include <vector>
 
 // Define M_PI for MSVC
 #ifndef M_PI
@@ -62,44 +67,27 @@ public:
         const double sigma_x = std::max(params.sigma_x, MIN_SIGMA_3D);
         const double sigma_y = std::max(params.sigma_y, MIN_SIGMA_3D);
         const double sigma_z = std::max(params.sigma_z, MIN_SIGMA_3D);
-        const double inv_two_sigma_x_sq = 1.0 / (2.0 * sigma_x * sigma_x);
-        const double inv_two_sigma_y_sq = 1.0 / (2.0 * sigma_y * sigma_y);
-        const double inv_two_sigma_z_sq = 1.0 / (2.0 * sigma_z * sigma_z);
+
+        // Separable envelope: A · g_x(x) · g_y(y) · g_z(z)
+        const std::vector<double> g_x = IGSOASeparableProfile::gaussianAxis(
+            N_x, params.center_x, 1.0 / (2.0 * sigma_x * sigma_x));
+        const std::vector<double> g_y = IGSOASeparableProfile::gaussianAxis(
+            N_y, params.center_y, 1.0 / (2.0 * sigma_y * sigma_y));
+        const std::vector<double> g_z = IGSOASeparableProfile::gaussianAxis(
+            N_z, params.center_z, 1.0 / (2.0 * sigma_z * sigma_z));
+        const IGSOAProfileMode mode = IGSOASeparableProfile::parseMode(params.mode, IGSOAProfileMode::Overwrite);
         const double baseline_phi = params.baseline_phi;
-        const std::string& mode = params.mode;
         const double beta_clamped = std::clamp(params.beta, 0.0, 1.0);
 
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t index = z * N_x * N_y + y * N_x + x;
-
-                    const double dx = static_cast<double>(x) - params.center_x;
-                    const double dy = static_cast<double>(y) - params.center_y;
-                    const double dz = static_cast<double>(z) - params.center_z;
-
-                    const double exponent = -(
-                        (dx * dx) * inv_two_sigma_x_sq +
-                        (dy * dy) * inv_two_sigma_y_sq +
-                        (dz * dz) * inv_two_sigma_z_sq
-                    );
-
-                    const double gaussian_value = params.amplitude * std::exp(exponent);
-                    const std::complex<double> psi_new(gaussian_value, 0.0);
-
-                    if (mode == "add") {
-                        nodes[index].psi += psi_new;
-                    } else if (mode == "blend") {
-                        nodes[index].psi = beta_clamped * psi_new + (1.0 - beta_clamped) * nodes[index].psi;
-                        nodes[index].phi = beta_clamped * baseline_phi + (1.0 - beta_clamped) * nodes[index].phi;
-                    } else {
-                        nodes[index].psi = psi_new;
-                        nodes[index].phi = baseline_phi;
-                    }
-
-                    nodes[index].updateInformationalDensity();
-                    nodes[index].updatePhase();
-                }
+        const int64_t rows = static_cast<int64_t>(N_y * N_z);
+        #pragma omp parallel for schedule(static) if(nodes.size() >= IGSOASeparableProfile::ompMinNodes())
+        for (int64_t r = 0; r < rows; ++r) {
+            const size_t y = static_cast<size_t>(r) % N_y;
+            const size_t z = static_cast<size_t>(r) / N_y;
+            const double row_value = params.amplitude * g_z[z] * g_y[y];
+            IGSOAComplexNode* row = nodes.data() + static_cast<size_t>(r) * N_x;
+            for (size_t x = 0; x < N_x; ++x) {
+                IGSOASeparableProfile::applyReal(row[x], row_value * g_x[x], mode, baseline_phi, beta_clamped);
             }
         }
     }
@@ -139,18 +127,22 @@ public:
 
         auto& nodes = engine.getNodesMutable();
 
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t index = z * N_x * N_y + y * N_x + x;
-                    double phase = params.k_x * static_cast<double>(x)
-                                   + params.k_y * static_cast<double>(y)
-                                   + params.k_z * static_cast<double>(z)
-                                   + params.phase_offset;
-                    nodes[index].psi = params.amplitude * std::exp(std::complex<double>(0.0, phase));
-                    nodes[index].updateInformationalDensity();
-                    nodes[index].updatePhase();
-                }
+        // Separable phase: A · e^{i k_x x} · e^{i k_y y} · e^{i(k_z z + φ₀)}
+        const auto w_x = IGSOASeparableProfile::phaseAxis(N_x, params.k_x, 0.0);
+        const auto w_y = IGSOASeparableProfile::phaseAxis(N_y, params.k_y, 0.0);
+        const auto w_z = IGSOASeparableProfile::phaseAxis(N_z, params.k_z, params.phase_offset);
+
+        const int64_t rows = static_cast<int64_t>(N_y * N_z);
+        #pragma omp parallel for schedule(static) if(nodes.size() >= IGSOASeparableProfile::ompMinNodes())
+        for (int64_t r = 0; r < rows; ++r) {
+            const size_t y = static_cast<size_t>(r) % N_y;
+            const size_t z = static_cast<size_t>(r) / N_y;
+            const std::complex<double> row_value = params.amplitude * w_z[z] * w_y[y];
+            IGSOAComplexNode* row = nodes.data() + static_cast<size_t>(r) * N_x;
+            for (size_t x = 0; x < N_x; ++x) {
+                row[x].psi = row_value * w_x[x];
+                row[x].updateInformationalDensity();
+                row[x].updatePhase();
             }
         }
     }
@@ -162,7 +154,10 @@ public:
         double phi
     ) {
         auto& nodes = engine.getNodesMutable();
-        for (auto& node : nodes) {
+        const int64_t N = static_cast<int64_t>(nodes.size());
+        #pragma omp parallel for schedule(static) if(nodes.size() >= IGSOASeparableProfile::ompMinNodes())
+        for (int64_t i = 0; i < N; ++i) {
+            auto& node = nodes[static_cast<size_t>(i)];
             node.psi = std::complex<double>(psi_real, psi_imag);
             node.phi = phi;
             node.updateInformationalDensity();
@@ -202,63 +197,9 @@ public:
         double& y_cm_out,
         double& z_cm_out
     ) {
-        size_t N_x = engine.getNx();
-        size_t N_y = engine.getNy();
-        size_t N_z = engine.getNz();
-
-        const auto& nodes = engine.getNodes();
-
-        double sum_F = 0.0;
-        // Use circular statistics for toroidal topology
-        double sum_cos_x = 0.0;
-        double sum_sin_x = 0.0;
-        double sum_cos_y = 0.0;
-        double sum_sin_y = 0.0;
-        double sum_cos_z = 0.0;
-        double sum_sin_z = 0.0;
-
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t index = z * N_x * N_y + y * N_x + x;
-                    double F = nodes[index].F;
-
-                    // Convert coordinates to angles on unit circle
-                    double theta_x = 2.0 * M_PI * static_cast<double>(x) / static_cast<double>(N_x);
-                    double theta_y = 2.0 * M_PI * static_cast<double>(y) / static_cast<double>(N_y);
-                    double theta_z = 2.0 * M_PI * static_cast<double>(z) / static_cast<double>(N_z);
-
-                    sum_F += F;
-                    sum_cos_x += F * std::cos(theta_x);
-                    sum_sin_x += F * std::sin(theta_x);
-                    sum_cos_y += F * std::cos(theta_y);
-                    sum_sin_y += F * std::sin(theta_y);
-                    sum_cos_z += F * std::cos(theta_z);
-                    sum_sin_z += F * std::sin(theta_z);
-                }
-            }
-        }
-
-        if (sum_F > 0.0) {
-            // Compute mean angle using atan2
-            double mean_theta_x = std::atan2(sum_sin_x, sum_cos_x);
-            double mean_theta_y = std::atan2(sum_sin_y, sum_cos_y);
-            double mean_theta_z = std::atan2(sum_sin_z, sum_cos_z);
-
-            // Convert back to coordinates (ensure positive result)
-            x_cm_out = static_cast<double>(N_x) * mean_theta_x / (2.0 * M_PI);
-            if (x_cm_out < 0.0) x_cm_out += static_cast<double>(N_x);
-
-            y_cm_out = static_cast<double>(N_y) * mean_theta_y / (2.0 * M_PI);
-            if (y_cm_out < 0.0) y_cm_out += static_cast<double>(N_y);
-
-            z_cm_out = static_cast<double>(N_z) * mean_theta_z / (2.0 * M_PI);
-            if (z_cm_out < 0.0) z_cm_out += static_cast<double>(N_z);
-        } else {
-            x_cm_out = 0.0;
-            y_cm_out = 0.0;
-            z_cm_out = 0.0;
-        }
+        // Circular statistics per axis (toroidal topology); reduced on the
+        // device while a GPU engine holds the lattice
+        engine.getCenterOfMass(x_cm_out, y_cm_out, z_cm_out);
     }
 };
 
@@ -0,0 +1,256 @@
+/**
+ * IGSOA Structure-of-Arrays State
+ *
+ * Cache-friendly mirror of the fields that the IGSOA physics kernels read
+ * from *neighbouring* nodes.  IGSOAComplexNode is a ~120-byte AoS record, so a
+ * neighbour read of psi in the coupling loop drags a full cache line for 16
+ * useful bytes.  The engines keep one of these containers alongside their
+ * node vector and the kernels stream neighbour data from the packed arrays.
+ *
+ * Ownership model:
+ * - The AoS node vector remains the authoritative, public representation
+ *   (getNodes/getNodesMutable, getNodePsi/setNodePsi and the C API are
+ *   unchanged).
+ * - The SoA arrays are a mirror, not a second owner: they are refreshed
+ *   from the AoS vector at the start of each kernel that needs them and
+ *   written through as nodes are updated, so external edits to the nodes
+ *   are always picked up on the next step.
+ * - The refresh is an O(N) gather (16 bytes written per node) against the
+ *   (1 + terms) neighbour reads per node it serves, which would otherwise
+ *   each pull a node record and rule out vector loads.  On the 2D interior
+ *   run path (benchmarks/cpp/bench_engines.cpp BM_IGSOA2D_NeighbourReads,
+ *   1024², one thread, gather included) the AVX2 pass over the mirror
+ *   takes 19 / 36 / 126 ms at R_c 1 / 3 / 8 against 39 / 107 / 467 ms
+ *   reading the nodes.
+ *
+ * Under IGSOAPrecision::MixedFloat / Float the Euler coupling pass gathers
+ * Ψ into the float psi32 arrays instead (half the neighbour-read bytes).
+ *
+ * In IGSOAUpdateMode::DoubleBuffered the write-through is skipped: the SoA
+ * arrays act as the read-only "previous step" buffer and the node vector as
+ * the "next step" buffer, so the gather at the start of the following step
+ * is the buffer swap.
+ *
+ * The gather loops use orphaned `omp for` worksharing so they split across
+ * the team when called from inside an IGSOA timeStep parallel region.  The
+ * container must already be sized (resize() is not thread-safe) before a
+ * parallel region calls them.
+ */
+
+#pragma once
+
+#include "aligned_allocator.h"
+#include "engine_memory.h"
+#include "igsoa_complex_node.h"
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+namespace igsoa {
+
+/**
+ * Packed neighbour-read fields for an IGSOA lattice (64-byte aligned)
+ */
+struct IGSOAStateSoA {
+    using AlignedArray = std::vector<double, aligned_allocator<double, 64>>;
+    using AlignedFloatArray = std::vector<float, aligned_allocator<float, 64>>;
+
+    AlignedArray psi_re;   // Re[Ψ]
+    AlignedArray psi_im;   // Im[Ψ]
+    AlignedArray F;        // |Ψ|² (read by the gradient stencil)
+
+    // Runge-Kutta stage inputs (ping-pong) and the RK4 weighted slope sum;
+    // empty under Euler (see reserveStages)
+    AlignedArray stage_re[2];
+    AlignedArray stage_im[2];
+    AlignedArray slope_re;
+    AlignedArray slope_im;
+
+    // Float Ψ mirror; empty under IGSOAPrecision::Double (see reservePrecision)
+    AlignedFloatArray psi32_re;
+    AlignedFloatArray psi32_im;
+
+    IGSOAStateSoA() = default;
+    explicit IGSOAStateSoA(size_t num_nodes) { resize(num_nodes); }
+
+    size_t size() const { return psi_re.size(); }
+
+    void resize(size_t num_nodes) {
+        psi_re.resize(num_nodes, 0.0);
+        psi_im.resize(num_nodes, 0.0);
+        F.resize(num_nodes, 0.0);
+    }
+
+    /**
+     * (Re)allocate zeroed arrays with NUMA-aware page placement
+     */
+    void allocate(size_t num_nodes, const NumaOptions& numa) {
+        NumaPlacement::allocate(psi_re, num_nodes, numa, 0.0);
+        NumaPlacement::allocate(psi_im, num_nodes, numa, 0.0);
+        NumaPlacement::allocate(F, num_nodes, numa, 0.0);
+    }
+
+    /**
+     * Size the stage buffers `integrator` needs (no-op once sized, so the
+     * engines allocate them on the first step, never per step).  Not
+     * thread-safe: call before the step's parallel region.
+     */
+    void reserveStages(IGSOAIntegrator integrator) {
+        const size_t n = size();
+        const size_t inputs = integrator == IGSOAIntegrator::RK4 ? 2 : integrator == IGSOAIntegrator::RK2 ? 1 : 0;
+        for (size_t s = 0; s < inputs; ++s) {
+            stage_re[s].resize(n, 0.0);
+            stage_im[s].resize(n, 0.0);
+        }
+        if (integrator == IGSOAIntegrator::RK4) {
+            slope_re.resize(n, 0.0);
+            slope_im.resize(n, 0.0);
+        }
+    }
+
+    /**
+     * Size the float Ψ mirror when `precision` needs it (no-op once sized).
+     * Not thread-safe: call before the step's parallel region.
+     */
+    void reservePrecision(IGSOAPrecision precision) {
+        if (precision != IGSOAPrecision::Double) {
+            psi32_re.resize(size(), 0.0f);
+            psi32_im.resize(size(), 0.0f);
+        }
+    }
+
+    /**
+     * Refresh Ψ arrays from the authoritative node vector
+     */
+    void gatherPsi(const std::vector<IGSOAComplexNode>& nodes) {
+        if (size() != nodes.size()) {
+            resize(nodes.size());
+        }
+        const int64_t N = static_cast<int64_t>(nodes.size());
+        double* re = psi_re.data();
+        double* im = psi_im.data();
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N; ++i) {
+            re[i] = nodes[static_cast<size_t>(i)].psi.real();
+            im[i] = nodes[static_cast<size_t>(i)].psi.imag();
+        }
+    }
+
+    /**
+     * Refresh the float Ψ mirror (rounded to nearest) from the node vector
+     */
+    void gatherPsi32(const std::vector<IGSOAComplexNode>& nodes) {
+        if (psi32_re.size() != nodes.size()) {
+            psi32_re.resize(nodes.size());
+            psi32_im.resize(nodes.size());
+        }
+        const int64_t N = static_cast<int64_t>(nodes.size());
+        float* re = psi32_re.data();
+        float* im = psi32_im.data();
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N; ++i) {
+            re[i] = static_cast<float>(nodes[static_cast<size_t>(i)].psi.real());
+            im[i] = static_cast<float>(nodes[static_cast<size_t>(i)].psi.imag());
+        }
+    }
+
+    /**
+     * Apply a uniform drive (Φ += Re, Ψ += drive, as IGSOAPhysics::
+     * applyDriving) while refreshing the Ψ arrays: one node pass for both
+     */
+    void driveAndGatherPsi(std::vector<IGSOAComplexNode>& nodes, std::complex<double> drive) {
+        if (size() != nodes.size()) {
+            resize(nodes.size());
+        }
+        const int64_t N = static_cast<int64_t>(nodes.size());
+        double* re = psi_re.data();
+        double* im = psi_im.data();
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N; ++i) {
+            IGSOAComplexNode& node = nodes[static_cast<size_t>(i)];
+            node.phi += drive.real();
+            node.psi += drive;
+            re[i] = node.psi.real();
+            im[i] = node.psi.imag();
+        }
+    }
+
+    /**
+     * Float-mirror variant of driveAndGatherPsi
+     */
+    void driveAndGatherPsi32(std::vector<IGSOAComplexNode>& nodes, std::complex<double> drive) {
+        if (psi32_re.size() != nodes.size()) {
+            psi32_re.resize(nodes.size());
+            psi32_im.resize(nodes.size());
+        }
+        const int64_t N = static_cast<int64_t>(nodes.size());
+        float* re = psi32_re.data();
+        float* im = psi32_im.data();
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N; ++i) {
+            IGSOAComplexNode& node = nodes[static_cast<size_t>(i)];
+            node.phi += drive.real();
+            node.psi += drive;
+            re[i] = static_cast<float>(node.psi.real());
+            im[i] = static_cast<float>(node.psi.imag());
+        }
+    }
+
+    /**
+     * Refresh F array from the authoritative node vector
+     */
+    void gatherF(const std::vector<IGSOAComplexNode>& nodes) {
+        if (size() != nodes.size()) {
+            resize(nodes.size());
+        }
+        const int64_t N = static_cast<int64_t>(nodes.size());
+        double* f = F.data();
+        #pragma omp for schedule(static)
+        for (int64_t i = 0; i < N; ++i) {
+            f[i] = nodes[static_cast<size_t>(i)].F;
+        }
+    }
+
+    /**
+     * Bytes held by the packed arrays
+     */
+    size_t memoryBytes() const {
+        size_t values = psi_re.capacity() + psi_im.capacity() + F.capacity() +
+                        slope_re.capacity() + slope_im.capacity();
+        for (size_t s = 0; s < 2; ++s) {
+            values += stage_re[s].capacity() + stage_im[s].capacity();
+        }
+        return values * sizeof(double) + (psi32_re.capacity() + psi32_im.capacity()) * sizeof(float);
+    }
+
+    /**
+     * memoryBytes() split into the Ψ/F mirror (state) and stage buffers (scratch)
+     */
+    MemoryFootprint footprint() const {
+        MemoryFootprint bytes;
+        bytes.state = capacityBytes(psi_re) + capacityBytes(psi_im) + capacityBytes(F) +
+                      capacityBytes(psi32_re) + capacityBytes(psi32_im);
+        bytes.scratch = capacityBytes(slope_re) + capacityBytes(slope_im);
+        for (size_t s = 0; s < 2; ++s) {
+            bytes.scratch += capacityBytes(stage_re[s]) + capacityBytes(stage_im[s]);
+        }
+        return bytes;
+    }
+
+    /**
+     * footprint() of `num_nodes` after reserveStages / reservePrecision
+     */
+    static MemoryFootprint estimate(size_t num_nodes, IGSOAIntegrator integrator, IGSOAPrecision precision) {
+        const uint64_t n = num_nodes;
+        MemoryFootprint bytes;
+        bytes.state = 3 * n * sizeof(double) + (precision != IGSOAPrecision::Double ? 2 * n * sizeof(float) : 0);
+        const uint64_t arrays = integrator == IGSOAIntegrator::RK4 ? 6 : integrator == IGSOAIntegrator::RK2 ? 2 : 0;
+        bytes.scratch = arrays * n * sizeof(double);
+        return bytes;
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,130 @@
+/**
+ * IGSOA Step Traffic - Bytes / FLOPs model of one IGSOA time step
+ *
+ * Mirrors the phases of IGSOAPhysics{,2D,3D}::timeStep (see
+ * kernel_traffic.h for what the model counts).  Node passes move the whole
+ * IGSOAComplexNode (AoS); the coupling and gradient sweeps read their
+ * neighbours from the packed IGSOAStateSoA mirror, which is streamed once.
+ *
+ *   gather Ψ     node -> psi_re / psi_im (float mirror: psi32)  0 FLOP
+ *   coupling     node r/w + Ψ mirror (+ write-through in place)  16 + 6 per coupling term
+ *                or, spectral: 2 complex FFTs + pointwise product
+ *                (RK2 / RK4: 2 / 4 fused stage passes + Ψ₀ and slope buffers)
+ *   causal Φ     node r/w                                        6
+ *   derived      node r/w (F, T_IGS, phase, entropy rate)        7
+ *   gather F     node -> F                                       0
+ *   gradients    F mirror + node r/w                             1 (1D) or 4 per axis
+ *   normalize    node r/w (optional)                             6
+ *   driving      node r/w (when the mission is driven)           4
+ *                or, fused into gather Ψ: node r/w, 4 FLOP, no extra pass
+ *
+ * Engine missions defer the derived / gather F / gradient passes to the
+ * first read (IGSOAPhysics::timeStep with derived = false); a normalizing
+ * step still runs F, T_IGS and Ṡ (node r/w, 5 FLOP).
+ */
+
+#pragma once
+
+#include "igsoa_complex_node.h"
+#include "igsoa_runge_kutta.h"
+#include "kernel_traffic.h"
+#include <cmath>
+#include <cstddef>
+
+namespace dase {
+namespace igsoa {
+
+struct IGSOAStepTraffic {
+    /**
+     * @param num_nodes Lattice nodes
+     * @param dims Lattice dimensionality (1, 2 or 3)
+     * @param coupling_terms Neighbours summed per node (stencil size)
+     * @param spectral Coupling evaluated by IGSOASpectralCoupling
+     * @param driven Mission applies driving signals each step
+     * @param deferred_derived Steps leave the derived fields to refreshDerived
+     * @param fused_driving The Ψ gather applies the drive (timeStep's drive)
+     */
+    static KernelTraffic model(const IGSOAComplexConfig& config,
+                               size_t num_nodes,
+                               int dims,
+                               double coupling_terms,
+                               bool spectral,
+                               bool driven,
+                               bool deferred_derived = false,
+                               bool fused_driving = false) {
+        const double n = static_cast<double>(num_nodes);
+        const double node = static_cast<double>(sizeof(IGSOAComplexNode));
+        const double value = static_cast<double>(sizeof(double));
+        const double complex_value = 2.0 * value;
+        const bool in_place = (config.update_mode == IGSOAUpdateMode::InPlace);
+        const int stages = IGSOARungeKutta::stages(config.integrator);
+        // Ψ mirror entry (IGSOAPrecision: float under Euler table/direct steps)
+        const bool float_mirror = config.precision != IGSOAPrecision::Double && stages == 1 && !spectral;
+        const double mirror_value = float_mirror ? 2.0 * sizeof(float) : complex_value;
+
+        KernelTraffic step;
+        if (driven && fused_driving) {
+            step += kernelPass(n, node, node + mirror_value, 4.0);
+        } else {
+            if (driven) {
+                step += kernelPass(n, node, node, 4.0);
+            }
+            step += kernelPass(n, node, mirror_value, 0.0);
+        }
+        for (int s = 0; s < stages; ++s) {
+            // Coupling sum of the stage input (side reads per node: FFT output
+            // or the neighbours' Ψ)
+            double coupling_read = mirror_value;
+            double coupling_flops = 6.0 * coupling_terms;
+            if (spectral) {
+                // Forward + backward complex FFT (5 N log2 N each) over the work
+                // array, a real kernel spectrum multiply and the 1/N scale
+                const double log_n = n > 1.0 ? std::log2(n) : 0.0;
+                KernelTraffic fft;
+                fft.bytes_read = n * (complex_value * 3.0 + value);
+                fft.bytes_written = n * complex_value * 3.0;
+                fft.flops = 10.0 * n * log_n + 4.0 * n;
+                step += fft;
+                coupling_read = 2.0 * complex_value;
+                coupling_flops = 0.0;
+            }
+            if (stages == 1) {
+                step += kernelPass(n, node + coupling_read,
+                                   spectral ? node : node + (in_place ? mirror_value : 0.0),
+                                   16.0 + coupling_flops);
+            } else {
+                // Fused RK stage: + Ψ₀ and the slope sum, writes the next
+                // stage input and slope (the last stage writes the node)
+                step += kernelPass(n, node + coupling_read + 2.0 * complex_value, 2.0 * complex_value,
+                                   24.0 + coupling_flops);
+            }
+        }
+        step += kernelPass(n, node, node, 6.0);
+        if (!deferred_derived) {
+            step += kernelPass(n, node, node, 7.0);
+            step += kernelPass(n, node, value, 0.0);
+            step += kernelPass(n, node + value, node, dims == 1 ? 1.0 : 4.0 * dims);
+        } else if (config.normalize_psi) {
+            step += kernelPass(n, node, node, 5.0);
+        }
+        if (config.normalize_psi) {
+            step += kernelPass(n, node, node, 6.0);
+        }
+        return step;
+    }
+
+    /**
+     * Neighbours within R_c of a 1D node (offsets 1..floor(R_c) each side,
+     * at most N - 1)
+     */
+    static double couplingTerms1D(double R_c, size_t num_nodes) {
+        if (num_nodes < 2 || R_c <= 0.0) {
+            return 0.0;
+        }
+        const double per_side = std::floor(R_c);
+        return std::fmin(2.0 * per_side, static_cast<double>(num_nodes - 1));
+    }
+};
+
+} // namespace igsoa
+} // namespace dase
@@ -0,0 +1,234 @@
+#pragma once
+
+// ============================================================================
+// KERNEL AUTOTUNER
+// ============================================================================
+//
+// The fastest kernel variant (IGSOA coupling mode, SATP stencil layout),
+// temporal block and thread count depend on the lattice shape, R_c and the
+// host.  Like FFTWWisdomCache for FFT plans, KernelAutotuner::tune times
+// each candidate configuration once per (engine type, dims, R_c, host) key
+// and persists the fastest in a tuning database; later engines with the
+// same key take the stored choice without timing anything.
+//
+// The database is a text file, one entry per line:
+//
+//     <key> <variant> <temporal_block_steps> <threads> <ns_per_step>
+//
+// loaded on first use and rewritten (through a temporary file) when an
+// entry is stored.  The host fingerprint in every key - best kernel ISA,
+// processor count and a hash of the CPU model - keeps a database copied
+// to another machine from applying there.
+//
+// What a variant means, and how a candidate is timed, is up to the caller
+// (EngineManager::autotuneEngine); candidates must agree to rounding
+// (temporal blocking reorders sums), so tuning only changes speed.
+
+#include "cpu_features.h"
+#include "thread_budget.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dase {
+
+struct KernelTuning {
+    int variant = 0;                    // Engine-specific kernel variant
+    uint32_t temporal_block_steps = 1;  // Steps per temporally blocked pass (1 = off)
+    int threads = 0;                    // Thread limit (0 = team width)
+    double ns_per_step = 0.0;           // Measured time of this configuration
+};
+
+class KernelAutotuner {
+public:
+    /**
+     * Use the database at `path` (loaded now; entries stored so far in
+     * this process are kept and merged into it)
+     */
+    static void initialize(const std::string& path = "./cache/kernel_tuning.txt") {
+        std::lock_guard<std::mutex> lock(mutex());
+        state().path = path;
+        state().loaded = false;
+        loadLocked();
+    }
+
+    static std::string path() {
+        std::lock_guard<std::mutex> lock(mutex());
+        return state().path;
+    }
+
+    /**
+     * <isa>-<processors>t-<hash of the CPU model name>
+     */
+    static std::string hostFingerprint() {
+        std::string model;
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        for (std::string line; std::getline(cpuinfo, line);) {
+            if (line.compare(0, 10, "model name") == 0) {
+                model = line.substr(line.find(':') + 1);
+                break;
+            }
+        }
+        uint32_t hash = 2166136261u;    // FNV-1a
+        for (unsigned char c : model) {
+            hash = (hash ^ c) * 16777619u;
+        }
+        std::ostringstream fingerprint;
+        fingerprint << CPUFeatures::kernelISAName(CPUFeatures::bestKernelISA()) << '-'
+                    << ThreadBudget::hardwareThreads() << "t-" << std::hex << std::setw(8)
+                    << std::setfill('0') << hash;
+        return fingerprint.str();
+    }
+
+    /**
+     * Database key of an engine: <type>:<Nx>x<Ny>x<Nz>:rc=<R_c>:<host>
+     */
+    static std::string key(const std::string& engine_type, const size_t dims[3], double R_c) {
+        std::ostringstream key;
+        key << engine_type << ':' << dims[0] << 'x' << dims[1] << 'x' << dims[2]
+            << ":rc=" << std::setprecision(17) << R_c << ':' << hostFingerprint();
+        return key.str();
+    }
+
+    static bool lookup(const std::string& key, KernelTuning& out) {
+        std::lock_guard<std::mutex> lock(mutex());
+        loadLocked();
+        const auto it = state().entries.find(key);
+        if (it == state().entries.end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+
+    /**
+     * Record a choice and rewrite the database; false if it could not be
+     * written (the choice is still used by this process)
+     */
+    static bool store(const std::string& key, const KernelTuning& tuning) {
+        std::lock_guard<std::mutex> lock(mutex());
+        loadLocked();
+        state().entries[key] = tuning;
+        return saveLocked();
+    }
+
+    /**
+     * The stored choice for `key`, or (force, or nothing stored) the
+     * fastest of `candidates` by measure(candidate) -> ns per step, which
+     * is then stored.  measured_out is true when candidates were timed.
+     * Measurement runs without the database lock.
+     */
+    template <typename Measure>
+    static KernelTuning tune(const std::string& key,
+                             const std::vector<KernelTuning>& candidates,
+                             Measure&& measure,
+                             bool force,
+                             bool& measured_out) {
+        KernelTuning best;
+        measured_out = false;
+        if (!force && lookup(key, best)) {
+            return best;
+        }
+        best.ns_per_step = std::numeric_limits<double>::infinity();
+        for (const KernelTuning& candidate : candidates) {
+            const double ns = measure(candidate);
+            if (ns < best.ns_per_step) {
+                best = candidate;
+                best.ns_per_step = ns;
+            }
+        }
+        measured_out = true;
+        if (!candidates.empty()) {
+            store(key, best);
+        }
+        return best;
+    }
+
+    // Entries loaded or stored in this process
+    static size_t size() {
+        std::lock_guard<std::mutex> lock(mutex());
+        loadLocked();
+        return state().entries.size();
+    }
+
+private:
+    struct State {
+        std::string path = "./cache/kernel_tuning.txt";
+        bool loaded = false;
+        std::map<std::string, KernelTuning> entries;
+    };
+
+    static std::mutex& mutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    static State& state() {
+        static State s;
+        return s;
+    }
+
+    // Stored entries win over the file's
+    static void loadLocked() {
+        State& s = state();
+        if (s.loaded) {
+            return;
+        }
+        s.loaded = true;
+        std::ifstream file(s.path);
+        for (std::string line; std::getline(file, line);) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream fields(line);
+            std::string key;
+            KernelTuning tuning;
+            if (fields >> key >> tuning.variant >> tuning.temporal_block_steps >> tuning.threads >> tuning.ns_per_step) {
+                s.entries.emplace(key, tuning);
+            }
+        }
+    }
+
+    static bool saveLocked() {
+        const State& s = state();
+        const size_t slash = s.path.find_last_of("/\\");
+        if (slash != std::string::npos && slash > 0) {
+            std::error_code ec;
+            std::filesystem::create_directories(s.path.substr(0, slash), ec);
+        }
+        const std::string temp = s.path + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::trunc);
+            if (!file) {
+                return false;
+            }
+            file << "# dase kernel tuning: key variant temporal_block_steps threads ns_per_step\n";
+            file << std::setprecision(17);
+            for (const auto& entry : s.entries) {
+                const KernelTuning& t = entry.second;
+                file << entry.first << ' ' << t.variant << ' ' << t.temporal_block_steps << ' '
+                     << t.threads << ' ' << t.ns_per_step << '\n';
+            }
+            if (!file) {
+                return false;
+            }
+        }
+        if (std::rename(temp.c_str(), s.path.c_str()) == 0) {
+            return true;
+        }
+        // Windows does not rename over an existing file
+        std::remove(s.path.c_str());
+        return std::rename(temp.c_str(), s.path.c_str()) == 0;
+    }
+};
+
+} // namespace dase
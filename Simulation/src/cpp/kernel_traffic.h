@@ -0,0 +1,80 @@
+#pragma once
+
+// ============================================================================
+// KERNEL TRAFFIC MODEL
+// ============================================================================
+//
+// Bytes moved and floating-point work of one engine step, built from the
+// lattice size, coupling reach and storage layout rather than measured.
+// Achieved GB/s and GFLOP/s from a timed run then say how far a kernel is
+// from the memory and compute roofs of the host.
+//
+// The model counts compulsory traffic: every array a pass touches is
+// streamed once (stencil neighbours are assumed to hit in cache), an AoS
+// pass moves the whole struct per element (a field read pulls in its cache
+// lines), and write-allocate reads are not counted.  It is a lower bound on
+// DRAM traffic, so achieved GB/s is a lower bound too.  FLOPs count adds,
+// multiplies, divides and square roots as one each; a transcendental
+// (exp, atan2) counts as one.
+
+#include <cstdint>
+
+namespace dase {
+
+struct KernelTraffic {
+    double bytes_read = 0.0;
+    double bytes_written = 0.0;
+    double flops = 0.0;
+
+    double bytes() const { return bytes_read + bytes_written; }
+
+    // FLOPs per byte (arithmetic intensity); 0 when no bytes move
+    double intensity() const { return bytes() > 0.0 ? flops / bytes() : 0.0; }
+
+    KernelTraffic& operator+=(const KernelTraffic& other) {
+        bytes_read += other.bytes_read;
+        bytes_written += other.bytes_written;
+        flops += other.flops;
+        return *this;
+    }
+};
+
+/**
+ * One pass over `elements`, each reading `read_bytes`, writing
+ * `written_bytes` and doing `flops`
+ */
+inline KernelTraffic kernelPass(double elements, double read_bytes, double written_bytes, double flops) {
+    KernelTraffic pass;
+    pass.bytes_read = elements * read_bytes;
+    pass.bytes_written = elements * written_bytes;
+    pass.flops = elements * flops;
+    return pass;
+}
+
+/**
+ * Achieved rates of a timed run of `steps` modelled steps
+ */
+struct KernelRoofline {
+    bool valid = false;            // A timed run with a non-empty model
+    double bytes_per_step = 0.0;
+    double flops_per_step = 0.0;
+    double arithmetic_intensity = 0.0;   // FLOP/byte
+    double achieved_gbps = 0.0;
+    double achieved_gflops = 0.0;
+};
+
+inline KernelRoofline kernelRoofline(const KernelTraffic& per_step, uint64_t steps, double seconds) {
+    KernelRoofline roofline;
+    roofline.bytes_per_step = per_step.bytes();
+    roofline.flops_per_step = per_step.flops;
+    roofline.arithmetic_intensity = per_step.intensity();
+    if (steps > 0 && seconds > 0.0 && per_step.bytes() > 0.0) {
+        const double steps_per_second = static_cast<double>(steps) / seconds;
+        roofline.valid = true;
+        roofline.achieved_gbps = per_step.bytes() * steps_per_second * 1.0e-9;
+        roofline.achieved_gflops = per_step.flops * steps_per_second * 1.0e-9;
+    }
+    return roofline;
+}
+
+} // namespace dase
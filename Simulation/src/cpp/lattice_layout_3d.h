@@ -0,0 +1,103 @@
+/**
+ * Bricked 3D Lattice Layout
+ *
+ * Maps logical (x, y, z) lattice coordinates to storage slots in cubic
+ * bricks of B³ cells (B a power of two, 8 by default).  Bricks are stored
+ * x-fastest, and so are the cells inside a brick:
+ *
+ *   slot = brick(x / B, y / B, z / B) · B³ + ((z % B) · B + y % B) · B + x % B
+ *
+ * With row-major (x-fastest) indexing, the z neighbours of a cell are a
+ * full plane apart, so a 3D stencil streams 2R+1 planes per sweep.  Inside
+ * a brick they are B² slots apart, so a brick and its face halos stay in
+ * cache while the brick is swept.  Each brick row (fixed y, z; x over a
+ * brick) is still unit-stride, in storage and in the logical array.
+ *
+ * Extents that are not multiples of B are padded to whole bricks: slots of
+ * padding cells are never mapped by index() or forEachRow().
+ * The layout only maps indices; engines keep their external APIs logical
+ * and gather into / scatter out of a bricked mirror (see
+ * SATPStencilMode::Bricked).
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace dase {
+
+class BrickLayout3D {
+public:
+    BrickLayout3D() = default;
+
+    /**
+     * @param brick_edge Cells per brick edge, rounded up to a power of two
+     */
+    BrickLayout3D(size_t N_x, size_t N_y, size_t N_z, size_t brick_edge = 8)
+        : N_x_(N_x), N_y_(N_y), N_z_(N_z) {
+        while ((size_t(1) << shift_) < brick_edge) {
+            shift_++;
+        }
+        edge_ = size_t(1) << shift_;
+        bricks_x_ = (N_x + edge_ - 1) >> shift_;
+        bricks_y_ = (N_y + edge_ - 1) >> shift_;
+        bricks_z_ = (N_z + edge_ - 1) >> shift_;
+    }
+
+    size_t edge() const { return edge_; }
+    size_t cellsPerBrick() const { return edge_ * edge_ * edge_; }
+    size_t numBricks() const { return bricks_x_ * bricks_y_ * bricks_z_; }
+
+    // Slots held by the layout (padded to whole bricks)
+    size_t storageSize() const { return numBricks() * cellsPerBrick(); }
+
+    // Storage slot of logical (x, y, z)
+    size_t index(size_t x, size_t y, size_t z) const {
+        const size_t mask = edge_ - 1;
+        const size_t brick = ((z >> shift_) * bricks_y_ + (y >> shift_)) * bricks_x_ + (x >> shift_);
+        return (brick << (3 * shift_)) + ((((z & mask) << shift_) + (y & mask)) << shift_) + (x & mask);
+    }
+
+    /**
+     * Origin and in-lattice extent of brick b (extents are below edge()
+     * only in the last brick of an axis that is not a multiple of it)
+     */
+    void brickBounds(size_t b, size_t& x0, size_t& y0, size_t& z0,
+                     size_t& extent_x, size_t& extent_y, size_t& extent_z) const {
+        x0 = (b % bricks_x_) << shift_;
+        y0 = ((b / bricks_x_) % bricks_y_) << shift_;
+        z0 = (b / (bricks_x_ * bricks_y_)) << shift_;
+        extent_x = (x0 + edge_ <= N_x_) ? edge_ : N_x_ - x0;
+        extent_y = (y0 + edge_ <= N_y_) ? edge_ : N_y_ - y0;
+        extent_z = (z0 + edge_ <= N_z_) ? edge_ : N_z_ - z0;
+    }
+
+    /**
+     * row(logical, slot, length) for every brick row of the lattice, in
+     * logical order: `length` cells that are contiguous both at row-major
+     * index `logical` and at storage slot `slot` (gather / scatter loops)
+     */
+    template <typename Row>
+    void forEachRow(Row&& row) const {
+        for (size_t z = 0; z < N_z_; ++z) {
+            for (size_t y = 0; y < N_y_; ++y) {
+                for (size_t x0 = 0; x0 < N_x_; x0 += edge_) {
+                    const size_t length = (x0 + edge_ <= N_x_) ? edge_ : N_x_ - x0;
+                    row((z * N_y_ + y) * N_x_ + x0, index(x0, y, z), length);
+                }
+            }
+        }
+    }
+
+private:
+    size_t N_x_ = 0;
+    size_t N_y_ = 0;
+    size_t N_z_ = 0;
+    size_t shift_ = 0;
+    size_t edge_ = 1;
+    size_t bricks_x_ = 0;
+    size_t bricks_y_ = 0;
+    size_t bricks_z_ = 0;
+};
+
+} // namespace dase
@@ -0,0 +1,234 @@
+#pragma once
+
+// ============================================================================
+// MAPPED FIELD STORE
+// ============================================================================
+//
+// File-backed storage for lattice fields too large for node memory.  The
+// fields of an N_z-plane lattice live in one memory-mapped file, blocked
+// in z-slabs of `slab_planes` planes:
+//
+//   slab 0:  field 0 planes [0, P) | field 1 planes [0, P) | ... | pad
+//   slab 1:  field 0 planes [P, 2P) | ...
+//
+// Each slab is one page-aligned byte range, so a stencil sweep in z can
+// stream the lattice with one hint per slab:
+//
+//   prefetch(k)  start reading slab k ahead of its use (MADV_WILLNEED)
+//   evict(k)     start writing slab k back (sync_file_range on Linux,
+//                msync(MS_ASYNC) elsewhere) and drop it from the process
+//                (MADV_DONTNEED; the dirty pages stay in the page cache
+//                until written, so no data is lost)
+//
+// Pages are also reachable without hints (plane() pointers are valid for
+// the whole file); the hints only bound the resident set.  The file is
+// created sparse at `path` and removed when the store is destroyed unless
+// keepFile() is set.  On Windows the file is mapped the same way and the
+// hints reduce to FlushViewOfFile.
+//
+// Errors throw std::runtime_error (as engine_checkpoint.h does).
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dase {
+
+class MappedFieldStore {
+public:
+    MappedFieldStore(const std::string& path, size_t num_fields, size_t plane_points, size_t num_planes,
+                     size_t slab_planes)
+        : path_(path), num_fields_(num_fields), plane_points_(plane_points), num_planes_(num_planes),
+          slab_planes_(slab_planes == 0 ? 1 : std::min(slab_planes, num_planes)) {
+        if (num_fields_ == 0 || plane_points_ == 0 || num_planes_ == 0) {
+            throw std::invalid_argument("MappedFieldStore: empty lattice");
+        }
+        num_slabs_ = (num_planes_ + slab_planes_ - 1) / slab_planes_;
+        const uint64_t page = pageSize();
+        const uint64_t field_bytes = static_cast<uint64_t>(slab_planes_) * plane_points_ * sizeof(double);
+        slab_bytes_ = (field_bytes * num_fields_ + page - 1) / page * page;
+        size_ = slab_bytes_ * num_slabs_;
+        map();
+    }
+
+    ~MappedFieldStore() {
+        unmap();
+        if (!keep_file_) {
+            std::remove(path_.c_str());
+        }
+    }
+
+    MappedFieldStore(const MappedFieldStore&) = delete;
+    MappedFieldStore& operator=(const MappedFieldStore&) = delete;
+
+    const std::string& path() const { return path_; }
+    size_t numFields() const { return num_fields_; }
+    size_t planePoints() const { return plane_points_; }
+    size_t numPlanes() const { return num_planes_; }
+    size_t numSlabs() const { return num_slabs_; }
+    uint64_t fileBytes() const { return size_; }
+    uint64_t slabBytes() const { return slab_bytes_; }
+
+    // Planes [firstPlane(k), firstPlane(k) + slabPlanes(k)) form slab k
+    size_t firstPlane(size_t slab) const { return slab * slab_planes_; }
+    size_t slabPlanes(size_t slab) const {
+        return std::min(slab_planes_, num_planes_ - firstPlane(slab));
+    }
+    size_t slabOf(size_t plane) const { return plane / slab_planes_; }
+
+    // plane_points doubles of `field` at z-plane `plane`
+    double* plane(size_t field, size_t plane) {
+        const size_t slab = plane / slab_planes_;
+        return slabField(slab, field) + (plane - slab * slab_planes_) * plane_points_;
+    }
+    const double* plane(size_t field, size_t plane) const {
+        return const_cast<MappedFieldStore*>(this)->plane(field, plane);
+    }
+
+    // The slabPlanes(slab) contiguous planes of `field` in slab `slab`
+    double* slabField(size_t slab, size_t field) {
+        return reinterpret_cast<double*>(base_ + slab * slab_bytes_) +
+               field * slab_planes_ * plane_points_;
+    }
+
+    void prefetch(size_t slab) {
+        if (slab >= num_slabs_) return;
+        prefetches_++;
+#ifndef _WIN32
+        ::madvise(base_ + slab * slab_bytes_, slab_bytes_, MADV_WILLNEED);
+#endif
+    }
+
+    void evict(size_t slab) {
+        if (slab >= num_slabs_) return;
+        evictions_++;
+        char* begin = base_ + slab * slab_bytes_;
+#ifdef _WIN32
+        FlushViewOfFile(begin, slab_bytes_);
+#else
+#ifdef __linux__
+        ::sync_file_range(fd_, static_cast<off_t>(slab * slab_bytes_), static_cast<off_t>(slab_bytes_),
+                          SYNC_FILE_RANGE_WRITE);
+#else
+        ::msync(begin, slab_bytes_, MS_ASYNC);
+#endif
+        ::madvise(begin, slab_bytes_, MADV_DONTNEED);
+#endif
+    }
+
+    // Write every dirty page to the file and wait for it
+    void flush() {
+#ifdef _WIN32
+        FlushViewOfFile(base_, 0);
+#else
+        ::msync(base_, size_, MS_SYNC);
+#endif
+    }
+
+    uint64_t prefetches() const { return prefetches_; }
+    uint64_t evictions() const { return evictions_; }
+
+    // Leave the file in place when the store is destroyed
+    void keepFile(bool keep) { keep_file_ = keep; }
+
+private:
+    static uint64_t pageSize() {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwAllocationGranularity;
+#else
+        const long page = ::sysconf(_SC_PAGESIZE);
+        return page > 0 ? static_cast<uint64_t>(page) : 4096;
+#endif
+    }
+
+    void map() {
+#ifdef _WIN32
+        file_ = CreateFileA(path_.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot create field store: " + path_);
+        }
+        const DWORD high = static_cast<DWORD>(size_ >> 32);
+        const DWORD low = static_cast<DWORD>(size_ & 0xFFFFFFFFu);
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE, high, low, nullptr);
+        if (!mapping_) {
+            CloseHandle(file_);
+            throw std::runtime_error("Cannot size field store: " + path_);
+        }
+        base_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+        if (!base_) {
+            CloseHandle(mapping_);
+            CloseHandle(file_);
+            throw std::runtime_error("Cannot map field store: " + path_);
+        }
+#else
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Cannot create field store: " + path_);
+        }
+        if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+            ::close(fd_);
+            std::remove(path_.c_str());
+            throw std::runtime_error("Cannot size field store: " + path_);
+        }
+        void* base = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (base == MAP_FAILED) {
+            ::close(fd_);
+            std::remove(path_.c_str());
+            throw std::runtime_error("Cannot map field store: " + path_);
+        }
+        base_ = static_cast<char*>(base);
+#endif
+    }
+
+    void unmap() {
+        if (!base_) return;
+#ifdef _WIN32
+        UnmapViewOfFile(base_);
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+#else
+        ::munmap(base_, size_);
+        ::close(fd_);
+#endif
+        base_ = nullptr;
+    }
+
+    std::string path_;
+    size_t num_fields_;
+    size_t plane_points_;
+    size_t num_planes_;
+    size_t slab_planes_;
+    size_t num_slabs_ = 0;
+    uint64_t slab_bytes_ = 0;
+    uint64_t size_ = 0;
+    char* base_ = nullptr;
+    bool keep_file_ = false;
+    uint64_t prefetches_ = 0;
+    uint64_t evictions_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+} // namespace dase
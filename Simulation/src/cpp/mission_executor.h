@@ -0,0 +1,345 @@
+#pragma once
+
+// ============================================================================
+// MISSION EXECUTOR
+// ============================================================================
+//
+// Worker pool for missions that run in the background (the Python bindings'
+// run_mission_async / evolve_async).  An AsyncMission runs its steps in
+// chunks of chunk_steps.  Between chunks it checks a cancellation flag and
+// reports progress, so cancel() stops a running mission within one chunk,
+// and a mission cancelled while still queued never starts.
+//
+// Every mission runs under a ThreadBudget lease for its worker thread, so
+// missions running at once share the cores the way CLI jobs do instead of
+// each opening a full-width OpenMP team.  Workers start with the first
+// submission.  The pool is one per module, like the budget.
+//
+// Hooks (progress, onFinish) run on the worker thread.  onFinish runs once
+// per mission, after the final state is set: on the worker, or on the thread
+// that cancelled a queued mission or shut the pool down.
+
+#include "thread_budget.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dase {
+
+enum class MissionState {
+    Queued,
+    Running,
+    Completed,
+    Cancelled,
+    Failed
+};
+
+inline const char* missionStateName(MissionState state) {
+    switch (state) {
+        case MissionState::Queued: return "queued";
+        case MissionState::Running: return "running";
+        case MissionState::Completed: return "completed";
+        case MissionState::Cancelled: return "cancelled";
+        case MissionState::Failed: return "failed";
+    }
+    return "unknown";
+}
+
+class AsyncMission {
+public:
+    // Run steps [first_step, first_step + steps); returns the steps run
+    // (fewer ends the mission early, e.g. an observable trigger)
+    using StepFn = std::function<uint64_t(uint64_t first_step, uint64_t steps)>;
+    // Called with the steps done every progress_every steps and at the
+    // end; false cancels the mission
+    using ProgressFn = std::function<bool(uint64_t steps_done)>;
+    using FinishFn = std::function<void(AsyncMission&)>;
+
+    /**
+     * @param num_steps Steps to run
+     * @param chunk_steps Steps per StepFn call (0 = all at once); the
+     *        cancellation and progress granularity
+     * @param step Runs one chunk; exceptions fail the mission
+     */
+    AsyncMission(uint64_t num_steps, uint64_t chunk_steps, StepFn step)
+        : num_steps_(num_steps),
+          chunk_steps_(chunk_steps == 0 ? std::max<uint64_t>(num_steps, 1) : chunk_steps),
+          step_(std::move(step)) {}
+
+    AsyncMission(const AsyncMission&) = delete;
+    AsyncMission& operator=(const AsyncMission&) = delete;
+
+    // Set before submission.  every = 0: at the end only.
+    void setProgress(uint64_t every, ProgressFn progress) {
+        progress_every_ = every;
+        progress_ = std::move(progress);
+    }
+    void setOnFinish(FinishFn on_finish) { on_finish_ = std::move(on_finish); }
+
+    /**
+     * Request cancellation: a queued mission is cancelled now, a running
+     * one after its current chunk
+     *
+     * @return false if the mission had already finished
+     */
+    bool cancel() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (finished(state_)) {
+                return false;
+            }
+            cancel_requested_.store(true);
+            if (state_ != MissionState::Queued) {
+                return true;
+            }
+            state_ = MissionState::Cancelled;
+        }
+        finish();
+        return true;
+    }
+
+    bool cancelRequested() const { return cancel_requested_.load(); }
+
+    /**
+     * Block until the mission finishes or timeout_seconds elapse (negative:
+     * no timeout)
+     *
+     * @return true once finished
+     */
+    bool wait(double timeout_seconds = -1.0) const {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto done = [this] { return finished(state_) && finish_called_; };
+        if (timeout_seconds < 0.0) {
+            finished_cv_.wait(lock, done);
+            return true;
+        }
+        return finished_cv_.wait_for(lock, std::chrono::duration<double>(timeout_seconds), done);
+    }
+
+    MissionState state() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return state_;
+    }
+    bool done() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return finished(state_);
+    }
+    uint64_t stepsDone() const { return steps_done_.load(); }
+    uint64_t numSteps() const { return num_steps_; }
+    std::string error() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+
+    // Run on the calling thread (a pool worker); no-op once finished
+    void run() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (state_ != MissionState::Queued) {
+                return;
+            }
+            state_ = MissionState::Running;
+        }
+        const ThreadBudget::Lease threads = ThreadBudget::process().acquire(0);
+
+        MissionState final_state = MissionState::Completed;
+        std::string error;
+        try {
+            uint64_t done = 0;
+            uint64_t next_report = progress_every_ > 0 ? progress_every_ : num_steps_;
+            while (done < num_steps_) {
+                if (cancel_requested_.load()) {
+                    final_state = MissionState::Cancelled;
+                    break;
+                }
+                const uint64_t steps = std::min(chunk_steps_, num_steps_ - done);
+                const uint64_t ran = std::min(step_(done, steps), steps);
+                done += ran;
+                steps_done_.store(done);
+                const bool short_chunk = ran < steps;
+                if (progress_ && (done >= next_report || done == num_steps_ || short_chunk)) {
+                    while (next_report <= done && progress_every_ > 0) {
+                        next_report += progress_every_;
+                    }
+                    if (!progress_(done)) {
+                        cancel_requested_.store(true);
+                    }
+                }
+                if (short_chunk) {
+                    break;
+                }
+            }
+            if (final_state == MissionState::Completed && cancel_requested_.load() && done < num_steps_) {
+                final_state = MissionState::Cancelled;
+            }
+        } catch (const std::exception& e) {
+            final_state = MissionState::Failed;
+            error = e.what();
+        } catch (...) {
+            final_state = MissionState::Failed;
+            error = "unknown error";
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            state_ = final_state;
+            error_ = error;
+        }
+        finish();
+    }
+
+private:
+    static bool finished(MissionState state) {
+        return state == MissionState::Completed || state == MissionState::Cancelled ||
+               state == MissionState::Failed;
+    }
+
+    // Run onFinish, drop the hooks (they may own foreign references), wake waiters
+    void finish() {
+        FinishFn on_finish = std::move(on_finish_);
+        step_ = nullptr;
+        progress_ = nullptr;
+        if (on_finish) {
+            on_finish(*this);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finish_called_ = true;
+        }
+        finished_cv_.notify_all();
+    }
+
+    const uint64_t num_steps_;
+    const uint64_t chunk_steps_;
+    StepFn step_;
+    ProgressFn progress_;
+    FinishFn on_finish_;
+    uint64_t progress_every_ = 0;
+
+    std::atomic<bool> cancel_requested_{false};
+    std::atomic<uint64_t> steps_done_{0};
+    mutable std::mutex mutex_;
+    mutable std::condition_variable finished_cv_;
+    MissionState state_ = MissionState::Queued;
+    std::string error_;
+    bool finish_called_ = false;
+};
+
+class MissionExecutor {
+public:
+    // The pool of this module
+    static MissionExecutor& process() {
+        static MissionExecutor executor;
+        return executor;
+    }
+
+    /**
+     * @param num_workers Worker threads; 0 = ThreadBudget::hardwareThreads()
+     */
+    explicit MissionExecutor(size_t num_workers = 0)
+        : num_workers_(num_workers > 0 ? num_workers : static_cast<size_t>(ThreadBudget::hardwareThreads())) {}
+
+    ~MissionExecutor() { shutdown(); }
+
+    MissionExecutor(const MissionExecutor&) = delete;
+    MissionExecutor& operator=(const MissionExecutor&) = delete;
+
+    size_t workers() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_workers_;
+    }
+
+    // Worker count for pools not yet started (0 = hardware threads)
+    void setWorkers(size_t num_workers) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (workers_.empty()) {
+            num_workers_ = num_workers > 0 ? num_workers : static_cast<size_t>(ThreadBudget::hardwareThreads());
+        }
+    }
+
+    // Queue a mission; after shutdown() it is cancelled instead
+    void submit(const std::shared_ptr<AsyncMission>& mission) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!stopping_) {
+                queue_.push_back(mission);
+                if (workers_.empty()) {
+                    for (size_t i = 0; i < num_workers_; ++i) {
+                        workers_.emplace_back([this] { workerLoop(); });
+                    }
+                }
+                work_available_.notify_one();
+                return;
+            }
+        }
+        mission->cancel();
+    }
+
+    // Missions queued or running
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size() + running_.size();
+    }
+
+    // Cancel every mission and join the workers.  Later submissions are
+    // cancelled on arrival.
+    void shutdown() {
+        std::deque<std::shared_ptr<AsyncMission>> queued;
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            queued.swap(queue_);
+            workers.swap(workers_);
+            for (const auto& mission : running_) {
+                mission->cancel();
+            }
+        }
+        work_available_.notify_all();
+        for (const auto& mission : queued) {
+            mission->cancel();
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::shared_ptr<AsyncMission> mission;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_available_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (queue_.empty()) {
+                    return;
+                }
+                mission = queue_.front();
+                queue_.pop_front();
+                running_.push_back(mission);
+            }
+            mission->run();
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_.erase(std::find(running_.begin(), running_.end(), mission));
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::deque<std::shared_ptr<AsyncMission>> queue_;
+    std::vector<std::shared_ptr<AsyncMission>> running_;
+    std::vector<std::thread> workers_;
+    size_t num_workers_;
+    bool stopping_ = false;
+};
+
+} // namespace dase
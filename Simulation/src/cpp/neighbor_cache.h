@@ -3,11 +3,14 @@
  *
  * Pre-computes and caches neighbor lists with coupling weights
  * Combines:
- * - Spatial hashing for fast neighbor discovery
+ * - Uniform-grid binning for fast neighbor discovery (SpatialGrid2D/3D)
  * - Kernel cache for fast weight computation
  * - Amplitude amplification tiering
  *
  * Expected speedup: 5-20x over naive neighbor search
+ *
+ * NeighborStencil2D/3D are the translation-invariant variants used by the
+ * IGSOA 2D/3D engines' stencil coupling mode (one offset table per R_c).
  */
 
 #pragma once
@@ -15,8 +18,12 @@
 #include "spatial_hash.h"
 #include "kernel_cache.h"
 #include "igsoa_complex_node.h"
-#include <vector>
+#include "igsoa_fixed_stencil.h"
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <cstddef>
+#include <vector>
 
 namespace dase {
 namespace igsoa {
@@ -26,7 +33,7 @@ namespace igsoa {
  */
 struct NeighborInfo {
     int node_id;           // Index of neighbor node
-    double weight;         // Pre-computed coupling weight K(distance, R_c)
+    double weight;         // Pre-computed coupling weight K(distance, R_c) (KernelCache::evaluateBatch)
     double distance;       // Distance (for debugging/analysis)
 };
 
@@ -37,7 +44,9 @@ class NeighborCache2D {
 private:
     std::vector<std::vector<NeighborInfo>> neighbor_lists_;
     KernelCache kernel_cache_;
-    SpatialHash2D spatial_hash_;
+    SpatialGrid2D spatial_grid_;
+    std::vector<double> distance_scratch_;  // Row distances / weights for KernelCache::evaluateBatch
+    std::vector<double> weight_scratch_;
 
     size_t N_x_, N_y_;
     double R_c_;
@@ -54,11 +63,24 @@ private:
         return std::sqrt(static_cast<double>(dx * dx + dy * dy));
     }
 
+    // Fill the row's weights with one KernelCache::evaluateBatch call
+    void evaluateWeights(std::vector<NeighborInfo>& row) {
+        distance_scratch_.resize(row.size());
+        weight_scratch_.resize(row.size());
+        for (size_t k = 0; k < row.size(); ++k) {
+            distance_scratch_[k] = row[k].distance;
+        }
+        kernel_cache_.evaluateBatch(distance_scratch_.data(), weight_scratch_.data(), row.size());
+        for (size_t k = 0; k < row.size(); ++k) {
+            row[k].weight = weight_scratch_[k];
+        }
+    }
+
 public:
     NeighborCache2D(size_t N_x, size_t N_y, double R_c)
         : neighbor_lists_(N_x * N_y)
         , kernel_cache_(R_c, 1024)
-        , spatial_hash_(N_x, N_y, R_c)
+        , spatial_grid_(N_x, N_y, R_c)
         , N_x_(N_x)
         , N_y_(N_y)
         , R_c_(R_c)
@@ -73,31 +95,23 @@ public:
         const size_t N_total = N_x_ * N_y_;
 
         // Clear previous data
-        spatial_hash_.clear();
         for (auto& list : neighbor_lists_) {
             list.clear();
         }
 
-        // Step 1: Populate spatial hash
-        for (size_t i = 0; i < N_total; ++i) {
-            int x = static_cast<int>(i % N_x_);
-            int y = static_cast<int>(i / N_x_);
-            spatial_hash_.insert(static_cast<int>(i), x, y);
-        }
+        // Step 1: Bin the lattice sites (counting sort)
+        spatial_grid_.buildLattice();
 
-        // Step 2: Build neighbor lists using spatial hash
+        // Step 2: Build neighbor lists from the grid candidates
         const int R_c_int = static_cast<int>(std::ceil(R_c_));
 
         for (size_t i = 0; i < N_total; ++i) {
             int x_i = static_cast<int>(i % N_x_);
             int y_i = static_cast<int>(i / N_x_);
 
-            // Query spatial hash for candidates
-            auto candidates = spatial_hash_.query(x_i, y_i, R_c_int);
-
-            // Filter by actual distance and pre-compute weights
-            for (int j : candidates) {
-                if (j == static_cast<int>(i)) continue;  // Skip self
+            // Filter candidates by actual distance and pre-compute weights
+            spatial_grid_.forEachInRange(x_i, y_i, R_c_int, [&](int j) {
+                if (j == static_cast<int>(i)) return;  // Skip self
 
                 int x_j = static_cast<int>(j % N_x_);
                 int y_j = static_cast<int>(j / N_x_);
@@ -108,11 +122,12 @@ public:
                     NeighborInfo info;
                     info.node_id = j;
                     info.distance = dist;
-                    info.weight = kernel_cache_.evaluateTiered(dist);
+                    info.weight = 0.0;  // Batch-evaluated below
 
                     neighbor_lists_[i].push_back(info);
                 }
-            }
+            });
+            evaluateWeights(neighbor_lists_[i]);
         }
 
         is_built_ = true;
@@ -126,7 +141,7 @@ public:
 
         R_c_ = new_R_c;
         kernel_cache_.rebuild(new_R_c);
-        spatial_hash_ = SpatialHash2D(N_x_, N_y_, R_c_);
+        spatial_grid_ = SpatialGrid2D(N_x_, N_y_, R_c_);
         build();
     }
 
@@ -175,7 +190,7 @@ public:
      */
     size_t getMemoryUsage() const {
         size_t total = kernel_cache_.getMemoryUsage();
-        total += spatial_hash_.getMemoryUsage();
+        total += spatial_grid_.getMemoryUsage();
 
         for (const auto& list : neighbor_lists_) {
             total += list.capacity() * sizeof(NeighborInfo);
@@ -194,7 +209,9 @@ class NeighborCache3D {
 private:
     std::vector<std::vector<NeighborInfo>> neighbor_lists_;
     KernelCache kernel_cache_;
-    SpatialHash3D spatial_hash_;
+    SpatialGrid3D spatial_grid_;
+    std::vector<double> distance_scratch_;  // Row distances / weights for KernelCache::evaluateBatch
+    std::vector<double> weight_scratch_;
 
     size_t N_x_, N_y_, N_z_;
     double R_c_;
@@ -213,11 +230,24 @@ private:
         return std::sqrt(static_cast<double>(dx * dx + dy * dy + dz * dz));
     }
 
+    // Fill the row's weights with one KernelCache::evaluateBatch call
+    void evaluateWeights(std::vector<NeighborInfo>& row) {
+        distance_scratch_.resize(row.size());
+        weight_scratch_.resize(row.size());
+        for (size_t k = 0; k < row.size(); ++k) {
+            distance_scratch_[k] = row[k].distance;
+        }
+        kernel_cache_.evaluateBatch(distance_scratch_.data(), weight_scratch_.data(), row.size());
+        for (size_t k = 0; k < row.size(); ++k) {
+            row[k].weight = weight_scratch_[k];
+        }
+    }
+
 public:
     NeighborCache3D(size_t N_x, size_t N_y, size_t N_z, double R_c)
         : neighbor_lists_(N_x * N_y * N_z)
         , kernel_cache_(R_c, 1024)
-        , spatial_hash_(N_x, N_y, N_z, R_c)
+        , spatial_grid_(N_x, N_y, N_z, R_c)
         , N_x_(N_x)
         , N_y_(N_y)
         , N_z_(N_z)
@@ -233,18 +263,12 @@ public:
         const size_t plane_size = N_x_ * N_y_;
 
         // Clear previous data
-        spatial_hash_.clear();
         for (auto& list : neighbor_lists_) {
             list.clear();
         }
 
-        // Step 1: Populate spatial hash
-        for (size_t i = 0; i < N_total; ++i) {
-            int x = static_cast<int>(i % N_x_);
-            int y = static_cast<int>((i / N_x_) % N_y_);
-            int z = static_cast<int>(i / plane_size);
-            spatial_hash_.insert(static_cast<int>(i), x, y, z);
-        }
+        // Step 1: Bin the lattice sites (counting sort)
+        spatial_grid_.buildLattice();
 
         // Step 2: Build neighbor lists
         const int R_c_int = static_cast<int>(std::ceil(R_c_));
@@ -254,12 +278,9 @@ public:
             int y_i = static_cast<int>((i / N_x_) % N_y_);
             int z_i = static_cast<int>(i / plane_size);
 
-            // Query spatial hash
-            auto candidates = spatial_hash_.query(x_i, y_i, z_i, R_c_int);
-
-            // Filter and compute weights
-            for (int j : candidates) {
-                if (j == static_cast<int>(i)) continue;
+            // Filter grid candidates and compute weights
+            spatial_grid_.forEachInRange(x_i, y_i, z_i, R_c_int, [&](int j) {
+                if (j == static_cast<int>(i)) return;
 
                 int x_j = static_cast<int>(j % N_x_);
                 int y_j = static_cast<int>((j / N_x_) % N_y_);
@@ -271,11 +292,12 @@ public:
                     NeighborInfo info;
                     info.node_id = j;
                     info.distance = dist;
-                    info.weight = kernel_cache_.evaluateTiered(dist);
+                    info.weight = 0.0;  // Batch-evaluated below
 
                     neighbor_lists_[i].push_back(info);
                 }
-            }
+            });
+            evaluateWeights(neighbor_lists_[i]);
         }
 
         is_built_ = true;
@@ -289,7 +311,7 @@ public:
 
         R_c_ = new_R_c;
         kernel_cache_.rebuild(new_R_c);
-        spatial_hash_ = SpatialHash3D(N_x_, N_y_, N_z_, R_c_);
+        spatial_grid_ = SpatialGrid3D(N_x_, N_y_, N_z_, R_c_);
         build();
     }
 
@@ -327,7 +349,7 @@ public:
 
     size_t getMemoryUsage() const {
         size_t total = kernel_cache_.getMemoryUsage();
-        total += spatial_hash_.getMemoryUsage();
+        total += spatial_grid_.getMemoryUsage();
 
         for (const auto& list : neighbor_lists_) {
             total += list.capacity() * sizeof(NeighborInfo);
@@ -339,5 +361,286 @@ public:
     bool isBuilt() const { return is_built_; }
 };
 
+/**
+ * Translation-Invariant Coupling Stencil (2D)
+ *
+ * On a uniform-R_c torus every node sees the same set of (dx, dy) offsets
+ * with the same weights, so one table per R_c replaces the per-node lists
+ * of NeighborCache2D.  Offsets are enumerated in the same order as the
+ * direct loop in IGSOAPhysics2D::evolveQuantumState (dy outer, dx inner) and
+ * weights use the exact kernel of the engine's coupling law
+ * (igsoa_kernel_policy.h; default exp(-r/R_c)/R_c), so stencil and direct
+ * modes produce the same sums.  Wrapped distances are used, which makes the table
+ * valid even when 2R_c+1 exceeds a lattice dimension.
+ *
+ * Storage is SoA; linear_offset = dy * N_x + dx is valid for interior nodes
+ * (no wrap needed within `reach` of every edge).  Entries whose linear
+ * offsets are consecutive are grouped into runs so interior nodes can stream
+ * each run as one contiguous span.
+ */
+class NeighborStencil2D {
+private:
+    std::vector<int> dx_;
+    std::vector<int> dy_;
+    std::vector<std::ptrdiff_t> linear_offset_;
+    std::vector<double> weight_;
+    std::vector<float> weight32_;   // weight_ rounded to float (IGSOAPrecision::Float)
+
+    // Contiguous runs: entries [run_begin_[r], run_begin_[r] + run_length_[r])
+    std::vector<size_t> run_begin_;
+    std::vector<size_t> run_length_;
+
+    size_t N_x_ = 0, N_y_ = 0;
+    double R_c_ = 0.0;
+    IGSOAKernelPolicy kernel_ = IGSOAKernelPolicy::Exponential;
+    int reach_ = 0;
+    int fixed_radius_ = 0;   // FixedStencilShape<2, R> radius matching this table, or 0
+    bool is_built_ = false;
+
+    static inline int wrapped1D(int d, size_t N) {
+        int raw = std::abs(d) % static_cast<int>(N);
+        return std::min(raw, static_cast<int>(N) - raw);
+    }
+
+    void buildRuns() {
+        for (size_t k = 0; k < linear_offset_.size(); ++k) {
+            if (k > 0 && linear_offset_[k] == linear_offset_[k - 1] + 1) {
+                run_length_.back()++;
+            } else {
+                run_begin_.push_back(k);
+                run_length_.push_back(1);
+            }
+        }
+    }
+
+public:
+    NeighborStencil2D() = default;
+
+    /**
+     * True if the table is valid for this lattice, radius and coupling law
+     */
+    bool matches(size_t N_x, size_t N_y, double R_c,
+                 IGSOAKernelPolicy kernel = IGSOAKernelPolicy::Exponential) const {
+        return is_built_ && N_x == N_x_ && N_y == N_y_ && R_c == R_c_ && kernel == kernel_;
+    }
+
+    /**
+     * Build the offset/weight table (call once, or when R_c or the law changes)
+     */
+    void build(size_t N_x, size_t N_y, double R_c,
+               IGSOAKernelPolicy kernel = IGSOAKernelPolicy::Exponential) {
+        dx_.clear();
+        dy_.clear();
+        linear_offset_.clear();
+        weight_.clear();
+        weight32_.clear();
+        run_begin_.clear();
+        run_length_.clear();
+
+        N_x_ = N_x;
+        N_y_ = N_y;
+        R_c_ = R_c;
+        kernel_ = kernel;
+        const double radius = std::max(R_c, 0.0);
+        reach_ = static_cast<int>(std::ceil(radius));
+
+        if (N_x * N_y > 1 && radius > 0.0) {
+            for (int dy = -reach_; dy <= reach_; ++dy) {
+                for (int dx = -reach_; dx <= reach_; ++dx) {
+                    if (dx == 0 && dy == 0) continue;
+
+                    const double wdx = static_cast<double>(wrapped1D(dx, N_x));
+                    const double wdy = static_cast<double>(wrapped1D(dy, N_y));
+                    const double dist = std::sqrt(wdx * wdx + wdy * wdy);
+                    if (dist > radius) continue;
+
+                    dx_.push_back(dx);
+                    dy_.push_back(dy);
+                    linear_offset_.push_back(static_cast<std::ptrdiff_t>(dy) * static_cast<std::ptrdiff_t>(N_x) + dx);
+                    weight_.push_back(kernelWeight(kernel, dist, radius));
+                }
+            }
+        }
+
+        weight32_.assign(weight_.begin(), weight_.end());
+        buildRuns();
+        fixed_radius_ = FixedStencilKernels::fixedRadius(R_c, N_x, N_y);
+        is_built_ = true;
+    }
+
+    /**
+     * Rebuild only if the radius changed
+     */
+    void rebuild(double new_R_c) {
+        if (!matches(N_x_, N_y_, new_R_c, kernel_)) {
+            build(N_x_, N_y_, new_R_c, kernel_);
+        }
+    }
+
+    size_t size() const { return weight_.size(); }
+    int reach() const { return reach_; }
+    double getRc() const { return R_c_; }
+    IGSOAKernelPolicy kernelPolicy() const { return kernel_; }
+    bool isBuilt() const { return is_built_; }
+
+    // Radius of the compile-time interior kernel for this table (0 = none)
+    int fixedRadius() const { return fixed_radius_; }
+
+    const int* dx() const { return dx_.data(); }
+    const int* dy() const { return dy_.data(); }
+    const std::ptrdiff_t* linearOffset() const { return linear_offset_.data(); }
+    const double* weight() const { return weight_.data(); }
+    const float* weight32() const { return weight32_.data(); }
+
+    size_t numRuns() const { return run_begin_.size(); }
+    const size_t* runBegin() const { return run_begin_.data(); }
+    const size_t* runLength() const { return run_length_.data(); }
+
+    size_t getMemoryUsage() const {
+        return dx_.capacity() * sizeof(int) +
+               dy_.capacity() * sizeof(int) +
+               linear_offset_.capacity() * sizeof(std::ptrdiff_t) +
+               weight_.capacity() * sizeof(double) +
+               weight32_.capacity() * sizeof(float) +
+               (run_begin_.capacity() + run_length_.capacity()) * sizeof(size_t);
+    }
+};
+
+/**
+ * Translation-Invariant Coupling Stencil (3D)
+ *
+ * 3D counterpart of NeighborStencil2D (enumeration order dz, dy, dx to match
+ * IGSOAPhysics3D::evolveQuantumState).
+ */
+class NeighborStencil3D {
+private:
+    std::vector<int> dx_;
+    std::vector<int> dy_;
+    std::vector<int> dz_;
+    std::vector<std::ptrdiff_t> linear_offset_;
+    std::vector<double> weight_;
+    std::vector<float> weight32_;   // weight_ rounded to float (IGSOAPrecision::Float)
+
+    // Contiguous runs: entries [run_begin_[r], run_begin_[r] + run_length_[r])
+    std::vector<size_t> run_begin_;
+    std::vector<size_t> run_length_;
+
+    size_t N_x_ = 0, N_y_ = 0, N_z_ = 0;
+    double R_c_ = 0.0;
+    IGSOAKernelPolicy kernel_ = IGSOAKernelPolicy::Exponential;
+    int reach_ = 0;
+    int fixed_radius_ = 0;   // FixedStencilShape<3, R> radius matching this table, or 0
+    bool is_built_ = false;
+
+    static inline int wrapped1D(int d, size_t N) {
+        int raw = std::abs(d) % static_cast<int>(N);
+        return std::min(raw, static_cast<int>(N) - raw);
+    }
+
+    void buildRuns() {
+        for (size_t k = 0; k < linear_offset_.size(); ++k) {
+            if (k > 0 && linear_offset_[k] == linear_offset_[k - 1] + 1) {
+                run_length_.back()++;
+            } else {
+                run_begin_.push_back(k);
+                run_length_.push_back(1);
+            }
+        }
+    }
+
+public:
+    NeighborStencil3D() = default;
+
+    bool matches(size_t N_x, size_t N_y, size_t N_z, double R_c,
+                 IGSOAKernelPolicy kernel = IGSOAKernelPolicy::Exponential) const {
+        return is_built_ && N_x == N_x_ && N_y == N_y_ && N_z == N_z_ && R_c == R_c_ && kernel == kernel_;
+    }
+
+    void build(size_t N_x, size_t N_y, size_t N_z, double R_c,
+               IGSOAKernelPolicy kernel = IGSOAKernelPolicy::Exponential) {
+        dx_.clear();
+        dy_.clear();
+        dz_.clear();
+        linear_offset_.clear();
+        weight_.clear();
+        weight32_.clear();
+        run_begin_.clear();
+        run_length_.clear();
+
+        N_x_ = N_x;
+        N_y_ = N_y;
+        N_z_ = N_z;
+        R_c_ = R_c;
+        kernel_ = kernel;
+        const double radius = std::max(R_c, 0.0);
+        reach_ = static_cast<int>(std::ceil(radius));
+        const double radius_sq = radius * radius;
+        const std::ptrdiff_t plane = static_cast<std::ptrdiff_t>(N_x * N_y);
+
+        if (N_x * N_y * N_z > 1 && radius > 0.0) {
+            for (int dz = -reach_; dz <= reach_; ++dz) {
+                for (int dy = -reach_; dy <= reach_; ++dy) {
+                    for (int dx = -reach_; dx <= reach_; ++dx) {
+                        if (dx == 0 && dy == 0 && dz == 0) continue;
+
+                        const double wdx = static_cast<double>(wrapped1D(dx, N_x));
+                        const double wdy = static_cast<double>(wrapped1D(dy, N_y));
+                        const double wdz = static_cast<double>(wrapped1D(dz, N_z));
+                        const double dist_sq = wdx * wdx + wdy * wdy + wdz * wdz;
+                        if (dist_sq > radius_sq) continue;
+
+                        const double dist = std::sqrt(dist_sq);
+                        dx_.push_back(dx);
+                        dy_.push_back(dy);
+                        dz_.push_back(dz);
+                        linear_offset_.push_back(static_cast<std::ptrdiff_t>(dz) * plane +
+                                                 static_cast<std::ptrdiff_t>(dy) * static_cast<std::ptrdiff_t>(N_x) + dx);
+                        weight_.push_back(kernelWeight(kernel, dist, radius));
+                    }
+                }
+            }
+        }
+
+        weight32_.assign(weight_.begin(), weight_.end());
+        buildRuns();
+        fixed_radius_ = FixedStencilKernels::fixedRadius(R_c, N_x, N_y, N_z);
+        is_built_ = true;
+    }
+
+    void rebuild(double new_R_c) {
+        if (!matches(N_x_, N_y_, N_z_, new_R_c, kernel_)) {
+            build(N_x_, N_y_, N_z_, new_R_c, kernel_);
+        }
+    }
+
+    size_t size() const { return weight_.size(); }
+    int reach() const { return reach_; }
+    double getRc() const { return R_c_; }
+    IGSOAKernelPolicy kernelPolicy() const { return kernel_; }
+    bool isBuilt() const { return is_built_; }
+
+    // Radius of the compile-time interior kernel for this table (0 = none)
+    int fixedRadius() const { return fixed_radius_; }
+
+    const int* dx() const { return dx_.data(); }
+    const int* dy() const { return dy_.data(); }
+    const int* dz() const { return dz_.data(); }
+    const std::ptrdiff_t* linearOffset() const { return linear_offset_.data(); }
+    const double* weight() const { return weight_.data(); }
+    const float* weight32() const { return weight32_.data(); }
+
+    size_t numRuns() const { return run_begin_.size(); }
+    const size_t* runBegin() const { return run_begin_.data(); }
+    const size_t* runLength() const { return run_length_.data(); }
+
+    size_t getMemoryUsage() const {
+        return (dx_.capacity() + dy_.capacity() + dz_.capacity()) * sizeof(int) +
+               linear_offset_.capacity() * sizeof(std::ptrdiff_t) +
+               weight_.capacity() * sizeof(double) +
+               weight32_.capacity() * sizeof(float) +
+               (run_begin_.capacity() + run_length_.capacity()) * sizeof(size_t);
+    }
+};
+
 } // namespace igsoa
 } // namespace dase
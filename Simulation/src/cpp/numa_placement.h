@@ -0,0 +1,272 @@
+#pragma once
+
+// ============================================================================
+// NUMA PLACEMENT
+// ============================================================================
+//
+// Page placement and OpenMP thread pinning shared by the DASE analog engine
+// and the header-only IGSOA engines.
+//
+// Linux places a page on the NUMA node of the thread that first writes it,
+// so state allocated and zeroed by the constructing thread all lands on one
+// socket.  allocate() instead touches the fresh storage under the same
+// `omp for schedule(static)` split the kernels use, so each thread's slice
+// is local to it, or interleaves the pages across nodes with mbind().
+// Either is only meaningful when the OpenMP threads stay put, hence
+// applyThreadAffinity().
+//
+// HugePages::Transparent advises the kernel to back the storage with
+// transparent huge pages (madvise(MADV_HUGEPAGE), before any placement
+// write), so neighbour sweeps over large lattices take far fewer TLB
+// misses.  Only the 2 MB-aligned interior of a block can be covered.
+// allocate() reports the page size it obtained advice for, or the base
+// page size when THP is disabled or unavailable.
+//
+// Interleave, affinity and huge pages are Linux-only; elsewhere they
+// report failure and allocate() falls back to first touch (or a plain
+// fill) on base pages.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <fstream>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum class ThreadAffinity : int {
+    None    = 0,   // Leave placement to the OS / OMP_PROC_BIND
+    Compact = 1,   // Thread t on the t-th allowed CPU
+    Spread  = 2    // Threads spaced evenly over the allowed CPUs
+};
+
+enum class HugePages : int {
+    None        = 0,   // Base pages
+    Transparent = 1    // Transparent huge pages where the kernel allows them
+};
+
+struct NumaOptions {
+    bool first_touch = false;                        // Parallel first-touch of engine state
+    bool interleave = false;                         // Interleave state pages over all nodes
+    ThreadAffinity thread_affinity = ThreadAffinity::None;
+    HugePages huge_pages = HugePages::None;          // Page size policy of engine state
+};
+
+struct NumaPlacement {
+    /**
+     * Pin every thread of the OpenMP team (omp_get_max_threads() threads,
+     * the team size the kernels use) to one CPU of the process's allowed
+     * set.  This includes the calling thread, as OMP_PROC_BIND would.
+     * @return false if nothing was pinned (None, no OpenMP, non-Linux)
+     */
+    static bool applyThreadAffinity(ThreadAffinity affinity) {
+        if (affinity == ThreadAffinity::None) {
+            return false;
+        }
+#if defined(__linux__) && defined(_OPENMP)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+            return false;
+        }
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (cpus.empty()) {
+            return false;
+        }
+
+        const int num_cpus = static_cast<int>(cpus.size());
+        int failures = 0;
+        #pragma omp parallel num_threads(omp_get_max_threads()) reduction(+:failures)
+        {
+            const int tid = omp_get_thread_num();
+            const int nthreads = omp_get_num_threads();
+            const int slot = (affinity == ThreadAffinity::Spread)
+                ? static_cast<int>((static_cast<int64_t>(tid) * num_cpus) / nthreads)
+                : tid % num_cpus;
+
+            cpu_set_t mask;
+            CPU_ZERO(&mask);
+            CPU_SET(cpus[static_cast<size_t>(slot)], &mask);
+            if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {  // 0 = calling thread
+                failures++;
+            }
+        }
+        return failures == 0;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Set an interleave policy over all allowed NUMA nodes on the whole
+     * pages of [data, data + bytes).  Must precede the first write.
+     * @return false if unsupported or the kernel refused
+     */
+    static bool interleavePages(void* data, size_t bytes) {
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+        constexpr int kMpolInterleave = 3;          // MPOL_INTERLEAVE
+        constexpr unsigned long kMpolFMemsAllowed = 1UL << 2;  // MPOL_F_MEMS_ALLOWED
+        constexpr unsigned long kMaxNodes = 1024;
+        unsigned long nodemask[kMaxNodes / (8 * sizeof(unsigned long))] = {};
+        if (syscall(SYS_get_mempolicy, nullptr, nodemask, kMaxNodes, nullptr, kMpolFMemsAllowed) != 0) {
+            return false;
+        }
+
+        const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + page - 1) & ~(page - 1);
+        const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + bytes) & ~(page - 1);
+        if (end <= begin) {
+            return false;
+        }
+        return syscall(SYS_mbind, begin, end - begin, kMpolInterleave,
+                       nodemask, kMaxNodes, 0UL) == 0;
+#else
+        (void)data; (void)bytes;
+        return false;
+#endif
+    }
+
+    // Base page size in bytes
+    static size_t basePageSize() noexcept {
+#ifdef __linux__
+        const long page = sysconf(_SC_PAGESIZE);
+        return page > 0 ? static_cast<size_t>(page) : 4096;
+#else
+        return 4096;
+#endif
+    }
+
+    /**
+     * Transparent huge page size in bytes, or 0 if THP is unavailable or
+     * disabled ("[never]")
+     */
+    static size_t transparentHugePageSize() {
+#ifdef __linux__
+        std::ifstream enabled("/sys/kernel/mm/transparent_hugepage/enabled");
+        std::string mode;
+        if (!std::getline(enabled, mode) || mode.find("[never]") != std::string::npos) {
+            return 0;
+        }
+        std::ifstream pmd("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+        size_t bytes = 0;
+        return (pmd >> bytes && bytes > 0) ? bytes : size_t(2) << 20;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * Advise transparent huge pages on the huge-page-aligned interior of
+     * [data, data + bytes).  Must precede the first write.
+     * @return Huge page size, or 0 if unsupported, refused or the block
+     *         holds no whole huge page
+     */
+    static size_t adviseHugePages(void* data, size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        const size_t huge = transparentHugePageSize();
+        if (huge == 0) {
+            return 0;
+        }
+        const uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + huge - 1) & ~(uintptr_t(huge) - 1);
+        const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + bytes) & ~(uintptr_t(huge) - 1);
+        if (end <= begin) {
+            return 0;
+        }
+        return madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) == 0 ? huge : 0;
+#else
+        (void)data; (void)bytes;
+        return 0;
+#endif
+    }
+
+    /**
+     * Size `v` to n copies of `value` with its pages placed per `options`.
+     *
+     * The storage is reserved, placed (huge page advice, then interleaved
+     * or first-touched by the OpenMP team in static-schedule order), and
+     * only then constructed in place; construction writes pages that
+     * already have a home.
+     *
+     * @return Page size backing the bulk of the storage (huge page size if
+     *         the advice was taken, the base page size otherwise)
+     */
+    template<typename T, typename Alloc>
+    static size_t allocate(std::vector<T, Alloc>& v, size_t n, const NumaOptions& options,
+                           const T& value = T()) {
+        if (!options.first_touch && !options.interleave && options.huge_pages == HugePages::None) {
+            v.assign(n, value);
+            return basePageSize();
+        }
+
+        std::vector<T, Alloc> fresh;
+        fresh.reserve(n);
+        // Raw capacity, no objects yet: only placement writes happen here
+        unsigned char* storage = reinterpret_cast<unsigned char*>(fresh.data());
+        const size_t huge = (options.huge_pages == HugePages::Transparent && n > 0)
+            ? adviseHugePages(storage, n * sizeof(T)) : 0;
+        const bool interleaved = options.interleave && n > 0 &&
+                                 interleavePages(storage, n * sizeof(T));
+        if (!interleaved && options.first_touch) {
+            const int64_t count = static_cast<int64_t>(n);
+            #pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < count; ++i) {
+                storage[static_cast<size_t>(i) * sizeof(T)] = 0;
+            }
+        }
+        fresh.resize(n, value);  // Within capacity: no reallocation
+        v.swap(fresh);
+        return huge > 0 ? huge : basePageSize();
+    }
+
+    static const char* hugePagesName(HugePages pages) noexcept {
+        switch (pages) {
+            case HugePages::None:        return "none";
+            case HugePages::Transparent: return "transparent";
+        }
+        return "unknown";
+    }
+
+    /**
+     * Parse "none" / "transparent"
+     * @return false for any other string
+     */
+    static bool parseHugePages(const std::string& name, HugePages& out) noexcept {
+        if (name == "none") { out = HugePages::None; return true; }
+        if (name == "transparent") { out = HugePages::Transparent; return true; }
+        return false;
+    }
+
+    static const char* threadAffinityName(ThreadAffinity affinity) noexcept {
+        switch (affinity) {
+            case ThreadAffinity::None:    return "none";
+            case ThreadAffinity::Compact: return "compact";
+            case ThreadAffinity::Spread:  return "spread";
+        }
+        return "unknown";
+    }
+
+    /**
+     * Parse "none" / "compact" / "spread"
+     * @return false for any other string
+     */
+    static bool parseThreadAffinity(const std::string& name, ThreadAffinity& out) noexcept {
+        if (name == "none") { out = ThreadAffinity::None; return true; }
+        if (name == "compact") { out = ThreadAffinity::Compact; return true; }
+        if (name == "spread") { out = ThreadAffinity::Spread; return true; }
+        return false;
+    }
+};
@@ -0,0 +1,596 @@
+/**
+ * Observable Recorder (in-engine scalar reductions of the lattice)
+ *
+ * Most state reads only feed a few scalars computed client-side: total
+ * |Ψ|², the energy in a sub-box, max |Φ|, the correlation of two regions.
+ * An observable is such a reduction, registered once: a kind, an engine
+ * field, a box of the lattice (default: all of it) and a decimation.  The
+ * engine calls record() after every step of its step loop, next to the
+ * probes (probe_recorder.h); each observable whose decimation divides the
+ * step count reduces its box in one pass and appends its values to a ring
+ * buffer preallocated by add().  drain() returns the time series, a few
+ * doubles per sample instead of the whole state.
+ *
+ * Kinds and their values per sample:
+ *
+ *   Sum, Mean            Σv, Σv / count                         1
+ *   Min, Max, MaxAbs     min v, max v, max |v|                  1
+ *   Moments              mean, variance (population)            2
+ *   Correlation          Pearson r of v (box) against w (other  1
+ *                        box, other field), element by element
+ *   CenterOfMass         circular centre of mass per axis        3
+ *                        (circular_statistics.h), weighted by v
+ *
+ * Sums go through reproducibleSums() and extrema are exact, so every value
+ * is bit-identical for any thread count.  Moments and Correlation sum
+ * values shifted by the box's first element, keeping the variance terms
+ * free of cancellation for fields with a large offset.  CenterOfMass
+ * always spans the whole lattice (the axes wrap).
+ *
+ * Field ids belong to the engine (IGSOANodeField for the IGSOA lattices);
+ * the recorder only range-checks them.  Lattices are x fastest (index =
+ * (z*N_y + y)*N_x + x); a 1D engine is N_x * 1 * 1.  Sample layout, per
+ * observable: values[sample * width + k], samples oldest first.  A full
+ * ring overwrites its oldest sample and counts it as dropped.
+ *
+ * Triggers watch one value of an observable's samples and fire, as the
+ * sample is recorded, when a condition holds for `hold` consecutive samples
+ * (once per run of such samples):
+ *
+ *   Above, Below         v > threshold, v < threshold
+ *   CrossesUp/Down       the previous sample was on the other side (hold 1)
+ *   Settles              |v - previous| < threshold (StabilityAnalyzer's
+ *                        convergence test)
+ *
+ * A fired trigger queues a TriggerEvent; every action but Emit also raises
+ * interrupted(), which the engines check after each step to end their step
+ * loop there, so the driver (the CLI's runMission) can stop the mission,
+ * write a snapshot or change the drive gain exactly at the event.  A
+ * trigger without `repeat` disarms after firing.
+ *
+ * Not thread-safe: add / record / drain from the thread driving the engine.
+ */
+
+#pragma once
+
+#include "circular_statistics.h"
+#include "reproducible_sum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dase {
+
+enum class ObservableKind : int {
+    Sum = 0,
+    Mean = 1,
+    Min = 2,
+    Max = 3,
+    MaxAbs = 4,
+    Moments = 5,
+    Correlation = 6,
+    CenterOfMass = 7
+};
+
+/**
+ * Box [x0, x0+nx) x [y0, y0+ny) x [z0, z0+nz); nx == 0 means the whole
+ * lattice
+ */
+struct ObservableBox {
+    size_t x0 = 0, y0 = 0, z0 = 0;
+    size_t nx = 0, ny = 1, nz = 1;
+
+    bool whole() const { return nx == 0; }
+    size_t count() const { return nx * ny * nz; }
+};
+
+struct ObservableSpec {
+    ObservableKind kind = ObservableKind::Sum;
+    int field = 0;                  // Engine field id
+    ObservableBox box;              // Reduced region
+    int other_field = -1;           // Correlation: second field (-1 = field)
+    ObservableBox other_box;        // Correlation: second region (whole = box), same shape
+    uint32_t decimation = 1;        // Sample when step % decimation == 0
+    size_t capacity = 4096;         // Ring size in samples
+};
+
+enum class TriggerCondition : int {
+    Above = 0,
+    Below = 1,
+    CrossesUp = 2,
+    CrossesDown = 3,
+    Settles = 4
+};
+
+enum class TriggerAction : int {
+    Stop = 0,       // End the mission
+    Snapshot = 1,   // Checkpoint the engine to `path`
+    Emit = 2,       // Only report the event
+    Drive = 3       // Scale the mission's drive by `drive_gain` from here on
+};
+
+struct TriggerSpec {
+    int observable = 0;             // Observable id
+    size_t component = 0;           // Value of its samples (< width)
+    TriggerCondition condition = TriggerCondition::Above;
+    double threshold = 0.0;         // Level, or the |Δ| bound of Settles
+    uint32_t hold = 1;              // Consecutive samples the condition must hold
+    TriggerAction action = TriggerAction::Stop;
+    double drive_gain = 1.0;        // Drive: new gain of the drive signals
+    std::string path;               // Snapshot: checkpoint file ("{step}" expanded by the driver)
+    bool repeat = false;            // Fire again on each new run (false: disarm after firing)
+};
+
+struct TriggerEvent {
+    int trigger = 0;
+    int observable = 0;
+    uint64_t step = 0;              // Engine step count of the sample
+    double value = 0.0;             // Watched value
+    TriggerAction action = TriggerAction::Emit;
+};
+
+class ObservableRecorder {
+public:
+    static constexpr size_t kMaxTriggerEvents = 4096;   // Queued events kept (oldest dropped)
+
+    // Values per sample of a kind
+    static size_t width(ObservableKind kind) {
+        switch (kind) {
+            case ObservableKind::Moments: return 2;
+            case ObservableKind::CenterOfMass: return 3;
+            default: return 1;
+        }
+    }
+
+    /**
+     * Register an observable on an N_x * N_y * N_z lattice
+     *
+     * @param num_fields Field ids of the engine (fields in [0, num_fields))
+     * @return Observable id (> 0), or -1 for an unknown kind or field, a box
+     *         that is empty or leaves the lattice, a second box of another
+     *         shape, or zero decimation / capacity
+     */
+    int add(const ObservableSpec& spec, size_t N_x, size_t N_y, size_t N_z, int num_fields) {
+        if (spec.decimation == 0 || spec.capacity == 0 || N_x == 0 || N_y == 0 || N_z == 0 ||
+            spec.kind < ObservableKind::Sum || spec.kind > ObservableKind::CenterOfMass) {
+            return -1;
+        }
+        Observable observable;
+        observable.spec = spec;
+        observable.spec.box = resolve(spec.box, N_x, N_y, N_z);
+        if (spec.kind == ObservableKind::CenterOfMass) {
+            if (!spec.box.whole() && !sameBox(observable.spec.box, resolve(ObservableBox(), N_x, N_y, N_z))) {
+                return -1;
+            }
+            observable.axes[0] = CircularAxis(N_x);
+            observable.axes[1] = CircularAxis(N_y);
+            observable.axes[2] = CircularAxis(N_z);
+        }
+        if (spec.kind == ObservableKind::Correlation) {
+            if (observable.spec.other_field < 0) observable.spec.other_field = spec.field;
+            observable.spec.other_box = spec.other_box.whole() ? observable.spec.box
+                                                               : resolve(spec.other_box, N_x, N_y, N_z);
+            const ObservableBox& a = observable.spec.box;
+            const ObservableBox& b = observable.spec.other_box;
+            if (a.nx != b.nx || a.ny != b.ny || a.nz != b.nz ||
+                !inside(b, N_x, N_y, N_z) || observable.spec.other_field >= num_fields) {
+                return -1;
+            }
+        } else {
+            observable.spec.other_field = -1;
+            observable.spec.other_box = ObservableBox();
+        }
+        if (spec.field < 0 || spec.field >= num_fields || !inside(observable.spec.box, N_x, N_y, N_z)) {
+            return -1;
+        }
+        observable.width = width(spec.kind);
+        observable.steps.assign(spec.capacity, 0);
+        observable.values.assign(spec.capacity * observable.width, 0.0);
+        observable.N_x = N_x;
+        observable.N_y = N_y;
+        const int id = next_id_++;
+        observables_.emplace(id, std::move(observable));
+        return id;
+    }
+
+    // Removing an observable removes its triggers
+    bool remove(int id) {
+        if (observables_.erase(id) == 0) {
+            return false;
+        }
+        for (auto it = triggers_.begin(); it != triggers_.end();) {
+            it = it->second.spec.observable == id ? triggers_.erase(it) : std::next(it);
+        }
+        return true;
+    }
+
+    void clear() {
+        observables_.clear();
+        triggers_.clear();
+        events_.clear();
+        events_dropped_ = 0;
+        interrupted_ = false;
+        drive_gain_ = 1.0;
+    }
+
+    // True if any observable is registered (engines then step one step at a time)
+    bool active() const { return !observables_.empty(); }
+
+    // True if an observable samples at `step` (and reads `field`, if >= 0)
+    bool due(uint64_t step, int field = -1) const {
+        for (const auto& entry : observables_) {
+            const ObservableSpec& spec = entry.second.spec;
+            if (step % spec.decimation == 0 &&
+                (field < 0 || spec.field == field || spec.other_field == field)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Evaluate the observables due at `step` (the engine's step count after
+     * the step); sample(index, field) returns one value of the flat lattice
+     * index
+     */
+    template <typename Sample>
+    void record(uint64_t step, Sample&& sample) {
+        for (auto& entry : observables_) {
+            Observable& observable = entry.second;
+            if (step % observable.spec.decimation != 0) {
+                continue;
+            }
+            const size_t capacity = observable.spec.capacity;
+            const size_t slot = (observable.head + observable.count) % capacity;
+            if (observable.count == capacity) {
+                observable.head = (observable.head + 1) % capacity;   // Overwrite the oldest
+                observable.dropped++;
+            } else {
+                observable.count++;
+            }
+            observable.steps[slot] = step;
+            double* values = observable.values.data() + slot * observable.width;
+            evaluate(observable, sample, values);
+            if (!triggers_.empty()) {
+                checkTriggers(entry.first, step, values);
+            }
+        }
+    }
+
+    /**
+     * Move every pending sample of an observable into steps / values
+     * (layout above) and report those overwritten since the last drain
+     *
+     * @return false for an unknown id
+     */
+    bool drain(int id, std::vector<uint64_t>& steps, std::vector<double>& values, uint64_t* dropped = nullptr) {
+        auto it = observables_.find(id);
+        if (it == observables_.end()) {
+            return false;
+        }
+        Observable& observable = it->second;
+        const size_t capacity = observable.spec.capacity;
+        steps.resize(observable.count);
+        values.resize(observable.count * observable.width);
+        for (size_t s = 0; s < observable.count; ++s) {
+            const size_t slot = (observable.head + s) % capacity;
+            steps[s] = observable.steps[slot];
+            std::copy_n(observable.values.begin() + slot * observable.width, observable.width,
+                        values.begin() + s * observable.width);
+        }
+        if (dropped) *dropped = observable.dropped;
+        observable.head = (observable.head + observable.count) % capacity;
+        observable.count = 0;
+        observable.dropped = 0;
+        return true;
+    }
+
+    // Samples waiting in an observable's ring (0 for an unknown id)
+    size_t pending(int id) const {
+        auto it = observables_.find(id);
+        return it == observables_.end() ? 0 : it->second.count;
+    }
+
+    // Registered spec with its boxes resolved, or nullptr for an unknown id
+    const ObservableSpec* spec(int id) const {
+        auto it = observables_.find(id);
+        return it == observables_.end() ? nullptr : &it->second.spec;
+    }
+
+    std::vector<int> ids() const {
+        std::vector<int> out;
+        for (const auto& entry : observables_) out.push_back(entry.first);
+        return out;
+    }
+
+    /**
+     * Register a trigger on an observable
+     *
+     * @return Trigger id (> 0), or -1 for an unknown observable, a component
+     *         past its width, zero hold, a crossing with hold > 1, a
+     *         non-finite threshold (Settles: not positive), a non-finite
+     *         drive gain or a snapshot without a path
+     */
+    int addTrigger(const TriggerSpec& spec) {
+        auto it = observables_.find(spec.observable);
+        if (it == observables_.end() || spec.component >= it->second.width || spec.hold == 0 ||
+            spec.condition < TriggerCondition::Above || spec.condition > TriggerCondition::Settles ||
+            spec.action < TriggerAction::Stop || spec.action > TriggerAction::Drive ||
+            !std::isfinite(spec.threshold) || !std::isfinite(spec.drive_gain) ||
+            (spec.condition == TriggerCondition::Settles && !(spec.threshold > 0.0)) ||
+            ((spec.condition == TriggerCondition::CrossesUp || spec.condition == TriggerCondition::CrossesDown) &&
+             spec.hold != 1) ||
+            (spec.action == TriggerAction::Snapshot && spec.path.empty())) {
+            return -1;
+        }
+        Trigger trigger;
+        trigger.spec = spec;
+        const int id = next_trigger_id_++;
+        triggers_.emplace(id, std::move(trigger));
+        return id;
+    }
+
+    bool removeTrigger(int id) { return triggers_.erase(id) > 0; }
+
+    // Registered trigger, or nullptr for an unknown id
+    const TriggerSpec* trigger(int id) const {
+        auto it = triggers_.find(id);
+        return it == triggers_.end() ? nullptr : &it->second.spec;
+    }
+
+    // Times a trigger fired and whether it is still armed
+    bool triggerState(int id, uint64_t& fired, bool& armed) const {
+        auto it = triggers_.find(id);
+        if (it == triggers_.end()) {
+            return false;
+        }
+        fired = it->second.fired;
+        armed = it->second.armed;
+        return true;
+    }
+
+    std::vector<int> triggerIds() const {
+        std::vector<int> out;
+        for (const auto& entry : triggers_) out.push_back(entry.first);
+        return out;
+    }
+
+    // True once a trigger whose action is not Emit fired, until takeEvents()
+    bool interrupted() const { return interrupted_; }
+
+    /**
+     * Append the queued events (oldest first) to `out`, clear them and the
+     * interruption
+     *
+     * @return Events dropped from the full queue since the last call
+     */
+    uint64_t takeEvents(std::vector<TriggerEvent>& out) {
+        out.insert(out.end(), events_.begin(), events_.end());
+        events_.clear();
+        interrupted_ = false;
+        const uint64_t dropped = events_dropped_;
+        events_dropped_ = 0;
+        return dropped;
+    }
+
+    // Drive gain of the last Drive trigger that fired (1 until then)
+    double driveGain() const { return drive_gain_; }
+
+    size_t memoryBytes() const {
+        size_t bytes = 0;
+        for (const auto& entry : observables_) {
+            const Observable& observable = entry.second;
+            bytes += observable.steps.capacity() * sizeof(uint64_t) +
+                     observable.values.capacity() * sizeof(double);
+            for (const CircularAxis& axis : observable.axes) {
+                bytes += (axis.cos_theta.capacity() + axis.sin_theta.capacity()) * sizeof(double);
+            }
+        }
+        return bytes;
+    }
+
+private:
+    struct Trigger {
+        TriggerSpec spec;
+        bool armed = true;
+        bool has_previous = false;
+        double previous = 0.0;          // Watched value of the previous sample
+        uint32_t run = 0;               // Consecutive samples meeting the condition
+        uint64_t fired = 0;
+    };
+
+    struct Observable {
+        ObservableSpec spec;
+        size_t width = 1;               // Values per sample
+        std::vector<uint64_t> steps;    // Ring of step stamps
+        std::vector<double> values;     // Ring of samples
+        size_t head = 0;                // Oldest slot
+        size_t count = 0;               // Pending samples
+        uint64_t dropped = 0;
+        size_t N_x = 1, N_y = 1;        // Lattice rows and planes (flat index)
+        CircularAxis axes[3];           // CenterOfMass angle tables
+    };
+
+    void checkTriggers(int observable, uint64_t step, const double* values) {
+        for (auto& entry : triggers_) {
+            Trigger& trigger = entry.second;
+            const TriggerSpec& spec = trigger.spec;
+            if (spec.observable != observable) {
+                continue;
+            }
+            const double v = values[spec.component];
+            bool met = false;
+            switch (spec.condition) {
+                case TriggerCondition::Above: met = v > spec.threshold; break;
+                case TriggerCondition::Below: met = v < spec.threshold; break;
+                case TriggerCondition::CrossesUp:
+                    met = trigger.has_previous && trigger.previous <= spec.threshold && v > spec.threshold;
+                    break;
+                case TriggerCondition::CrossesDown:
+                    met = trigger.has_previous && trigger.previous >= spec.threshold && v < spec.threshold;
+                    break;
+                case TriggerCondition::Settles:
+                    met = trigger.has_previous && std::fabs(v - trigger.previous) < spec.threshold;
+                    break;
+            }
+            trigger.previous = v;
+            trigger.has_previous = true;
+            trigger.run = met ? trigger.run + 1 : 0;
+            if (!trigger.armed || trigger.run != spec.hold) {
+                continue;
+            }
+
+            trigger.fired++;
+            trigger.armed = spec.repeat;
+            if (events_.size() == kMaxTriggerEvents) {
+                events_.pop_front();
+                events_dropped_++;
+            }
+            TriggerEvent event;
+            event.trigger = entry.first;
+            event.observable = observable;
+            event.step = step;
+            event.value = v;
+            event.action = spec.action;
+            events_.push_back(event);
+            if (spec.action == TriggerAction::Drive) {
+                drive_gain_ = spec.drive_gain;
+            }
+            if (spec.action != TriggerAction::Emit) {
+                interrupted_ = true;
+            }
+        }
+    }
+
+    static ObservableBox resolve(const ObservableBox& box, size_t N_x, size_t N_y, size_t N_z) {
+        if (!box.whole()) {
+            return box;
+        }
+        ObservableBox all;
+        all.nx = N_x;
+        all.ny = N_y;
+        all.nz = N_z;
+        return all;
+    }
+
+    static bool inside(const ObservableBox& box, size_t N_x, size_t N_y, size_t N_z) {
+        return box.count() > 0 &&
+               box.x0 <= N_x && box.nx <= N_x - box.x0 &&
+               box.y0 <= N_y && box.ny <= N_y - box.y0 &&
+               box.z0 <= N_z && box.nz <= N_z - box.z0;
+    }
+
+    static bool sameBox(const ObservableBox& a, const ObservableBox& b) {
+        return a.x0 == b.x0 && a.y0 == b.y0 && a.z0 == b.z0 && a.nx == b.nx && a.ny == b.ny && a.nz == b.nz;
+    }
+
+    // Flat lattice index of element k of a box (x fastest)
+    static uint64_t flatIndex(const Observable& observable, const ObservableBox& box, int64_t k) {
+        const size_t i = static_cast<size_t>(k);
+        const size_t x = i % box.nx;
+        const size_t t = i / box.nx;
+        const size_t y = t % box.ny;
+        const size_t z = t / box.ny;
+        return static_cast<uint64_t>(((box.z0 + z) * observable.N_y + box.y0 + y) * observable.N_x + box.x0 + x);
+    }
+
+    template <typename Sample>
+    void evaluate(const Observable& observable, Sample& sample, double* out) const {
+        const ObservableSpec& spec = observable.spec;
+        const ObservableBox& box = spec.box;
+        const int field = spec.field;
+        const int64_t n = static_cast<int64_t>(box.count());
+        const double count = static_cast<double>(n);
+        auto value = [&](int64_t k) { return sample(flatIndex(observable, box, k), field); };
+
+        switch (spec.kind) {
+            case ObservableKind::Sum:
+            case ObservableKind::Mean: {
+                const double sum = reproducibleSum(n, value);
+                out[0] = spec.kind == ObservableKind::Sum ? sum : sum / count;
+                break;
+            }
+            case ObservableKind::Min:
+            case ObservableKind::Max:
+            case ObservableKind::MaxAbs: {
+                double lo = std::numeric_limits<double>::infinity();
+                double hi = -std::numeric_limits<double>::infinity();
+                double top = 0.0;
+                #pragma omp parallel for schedule(static) reduction(min:lo) reduction(max:hi, top) if(n >= kSumBlock)
+                for (int64_t k = 0; k < n; ++k) {
+                    const double v = value(k);
+                    lo = std::min(lo, v);
+                    hi = std::max(hi, v);
+                    top = std::max(top, std::fabs(v));
+                }
+                out[0] = spec.kind == ObservableKind::Min ? lo : spec.kind == ObservableKind::Max ? hi : top;
+                break;
+            }
+            case ObservableKind::Moments: {
+                const double shift = value(0);
+                const auto sums = reproducibleSums<2>(n, [&](int64_t k, double* acc) {
+                    const double d = value(k) - shift;
+                    acc[0] += d;
+                    acc[1] += d * d;
+                });
+                const double mean = sums[0] / count;
+                out[0] = shift + mean;
+                out[1] = std::max(sums[1] / count - mean * mean, 0.0);
+                break;
+            }
+            case ObservableKind::Correlation: {
+                const ObservableBox& other = spec.other_box;
+                const int other_field = spec.other_field;
+                auto second = [&](int64_t k) { return sample(flatIndex(observable, other, k), other_field); };
+                const double shift_a = value(0);
+                const double shift_b = second(0);
+                const auto sums = reproducibleSums<5>(n, [&](int64_t k, double* acc) {
+                    const double a = value(k) - shift_a;
+                    const double b = second(k) - shift_b;
+                    acc[0] += a;
+                    acc[1] += b;
+                    acc[2] += a * a;
+                    acc[3] += b * b;
+                    acc[4] += a * b;
+                });
+                const double mean_a = sums[0] / count;
+                const double mean_b = sums[1] / count;
+                const double var_a = sums[2] / count - mean_a * mean_a;
+                const double var_b = sums[3] / count - mean_b * mean_b;
+                const double cov = sums[4] / count - mean_a * mean_b;
+                out[0] = var_a > 0.0 && var_b > 0.0 ? cov / std::sqrt(var_a * var_b) : 0.0;
+                break;
+            }
+            case ObservableKind::CenterOfMass: {
+                const CircularTotals totals = circularTotals(
+                    observable.axes[0], observable.axes[1], observable.axes[2], 0, box.nz,
+                    [&](size_t i) { return sample(static_cast<uint64_t>(i), field); });
+                for (int axis = 0; axis < 3; ++axis) {
+                    out[axis] = circularMean(totals.sum_cos[axis], totals.sum_sin[axis],
+                                             observable.axes[axis].size());
+                }
+                break;
+            }
+        }
+    }
+
+    std::map<int, Observable> observables_;
+    int next_id_ = 1;
+    std::map<int, Trigger> triggers_;
+    int next_trigger_id_ = 1;
+    std::deque<TriggerEvent> events_;
+    uint64_t events_dropped_ = 0;
+    bool interrupted_ = false;
+    double drive_gain_ = 1.0;
+};
+
+} // namespace dase
@@ -0,0 +1,255 @@
+/**
+ * Probe Recorder (in-engine time series of selected points)
+ *
+ * A probe is a fixed set of lattice points (flat node indices, or detector
+ * cells of the GW grid), the fields to read at them and a decimation
+ * factor.  The engine calls record() after every step of its step loop;
+ * each probe whose decimation divides the engine's step count copies its
+ * fields into a ring buffer preallocated by add().  drain() hands back
+ * every pending sample in one call, so a time series at a few points no
+ * longer costs a run_steps / get_node_state round trip per step.
+ *
+ * Field ids belong to the engine (IGSOANodeField for the IGSOA lattices);
+ * the recorder only range-checks them.  Sample layout, per probe:
+ *
+ *   values[(sample * fields + f) * points + p]
+ *
+ * with samples oldest first.  A full ring overwrites its oldest sample and
+ * counts it as dropped.
+ *
+ * Taps (addTap) see every sample of a probe as it is recorded, in the same
+ * layout, so streaming consumers (the CLI's spectral monitors) run inside
+ * the step loop without draining the ring.
+ *
+ * Not thread-safe: add / record / drain from the thread driving the engine.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace dase {
+
+// Consumer of one sample: step stamp and points * fields values
+using ProbeTap = std::function<void(uint64_t step, const double* sample)>;
+
+struct ProbeSpec {
+    std::vector<uint64_t> points;   // Flat point indices
+    std::vector<int> fields;        // Engine field ids
+    uint32_t decimation = 1;        // Sample when step % decimation == 0
+    size_t capacity = 4096;         // Ring size in samples
+};
+
+class ProbeRecorder {
+public:
+    /**
+     * Register a probe
+     *
+     * @param num_points Points of the engine (every index must be below it)
+     * @param num_fields Field ids of the engine (every id in [0, num_fields))
+     * @return Probe id (> 0), or -1 for an empty, out-of-range or
+     *         zero-decimation / zero-capacity spec
+     */
+    int add(const ProbeSpec& spec, uint64_t num_points, int num_fields) {
+        if (spec.points.empty() || spec.fields.empty() || spec.decimation == 0 || spec.capacity == 0) {
+            return -1;
+        }
+        for (uint64_t point : spec.points) {
+            if (point >= num_points) return -1;
+        }
+        for (int field : spec.fields) {
+            if (field < 0 || field >= num_fields) return -1;
+        }
+        Probe probe;
+        probe.spec = spec;
+        probe.stride = spec.points.size() * spec.fields.size();
+        probe.steps.assign(spec.capacity, 0);
+        probe.values.assign(spec.capacity * probe.stride, 0.0);
+        const int id = next_id_++;
+        probes_.emplace(id, std::move(probe));
+        return id;
+    }
+
+    bool remove(int id) { return probes_.erase(id) > 0; }
+    void clear() { probes_.clear(); }
+
+    // True if any probe is registered (engines then step one step at a time)
+    bool active() const { return !probes_.empty(); }
+
+    // True if a probe samples at `step` (and records `field`, if >= 0)
+    bool due(uint64_t step, int field = -1) const {
+        for (const auto& entry : probes_) {
+            const ProbeSpec& spec = entry.second.spec;
+            if (step % spec.decimation == 0 &&
+                (field < 0 || std::find(spec.fields.begin(), spec.fields.end(), field) != spec.fields.end())) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Sample the probes due at `step` (the engine's step count after the
+     * step); sample(point, field) returns one value
+     */
+    template <typename Sample>
+    void record(uint64_t step, Sample&& sample) {
+        for (auto& entry : probes_) {
+            Probe& probe = entry.second;
+            if (step % probe.spec.decimation != 0) {
+                continue;
+            }
+            const size_t capacity = probe.spec.capacity;
+            const size_t slot = (probe.head + probe.count) % capacity;
+            if (probe.count == capacity) {
+                probe.head = (probe.head + 1) % capacity;   // Overwrite the oldest
+                probe.dropped++;
+            } else {
+                probe.count++;
+            }
+            probe.steps[slot] = step;
+            double* const first = probe.values.data() + slot * probe.stride;
+            double* out = first;
+            for (int field : probe.spec.fields) {
+                for (uint64_t point : probe.spec.points) {
+                    *out++ = sample(point, field);
+                }
+            }
+            for (auto& tap : probe.taps) {
+                tap.second(step, first);
+            }
+        }
+    }
+
+    /**
+     * Attach a consumer called with every sample recorded from now on
+     *
+     * @return Tap id (> 0), or -1 for an unknown probe
+     */
+    int addTap(int id, ProbeTap tap) {
+        auto it = probes_.find(id);
+        if (it == probes_.end() || !tap) {
+            return -1;
+        }
+        const int tap_id = next_tap_id_++;
+        it->second.taps.emplace_back(tap_id, std::move(tap));
+        return tap_id;
+    }
+
+    bool removeTap(int id, int tap_id) {
+        auto it = probes_.find(id);
+        if (it == probes_.end()) {
+            return false;
+        }
+        auto& taps = it->second.taps;
+        const auto match = std::find_if(taps.begin(), taps.end(),
+                                        [tap_id](const auto& tap) { return tap.first == tap_id; });
+        if (match == taps.end()) {
+            return false;
+        }
+        taps.erase(match);
+        return true;
+    }
+
+    /**
+     * Move up to max_samples pending samples of a probe (oldest first,
+     * layout above) into caller buffers of max_samples step stamps and
+     * max_samples * points * fields values; the rest stay pending
+     *
+     * @param dropped Optional: samples overwritten since the last drain
+     * @return Samples copied (0 for an unknown id)
+     */
+    size_t drain(int id, uint64_t* steps, double* values, size_t max_samples, uint64_t* dropped = nullptr) {
+        auto it = probes_.find(id);
+        if (it == probes_.end() || !steps || !values) {
+            return 0;
+        }
+        Probe& probe = it->second;
+        const size_t capacity = probe.spec.capacity;
+        const size_t n = std::min(probe.count, max_samples);
+        for (size_t s = 0; s < n; ++s) {
+            const size_t slot = (probe.head + s) % capacity;
+            steps[s] = probe.steps[slot];
+            std::copy_n(probe.values.begin() + slot * probe.stride, probe.stride, values + s * probe.stride);
+        }
+        if (dropped) *dropped = probe.dropped;
+        probe.head = (probe.head + n) % capacity;
+        probe.count -= n;
+        probe.dropped = 0;
+        return n;
+    }
+
+    /**
+     * Move every pending sample of a probe into steps / values
+     *
+     * @return false for an unknown id
+     */
+    bool drain(int id, std::vector<uint64_t>& steps, std::vector<double>& values, uint64_t* dropped = nullptr) {
+        auto it = probes_.find(id);
+        if (it == probes_.end()) {
+            return false;
+        }
+        const size_t n = it->second.count;
+        steps.resize(n);
+        values.resize(n * it->second.stride);
+        if (n == 0) {
+            if (dropped) *dropped = it->second.dropped;
+            it->second.dropped = 0;
+            return true;
+        }
+        drain(id, steps.data(), values.data(), n, dropped);
+        return true;
+    }
+
+    // Samples waiting in a probe's ring (0 for an unknown id)
+    size_t pending(int id) const {
+        auto it = probes_.find(id);
+        return it == probes_.end() ? 0 : it->second.count;
+    }
+
+    // Registered spec, or nullptr for an unknown id
+    const ProbeSpec* spec(int id) const {
+        auto it = probes_.find(id);
+        return it == probes_.end() ? nullptr : &it->second.spec;
+    }
+
+    std::vector<int> ids() const {
+        std::vector<int> out;
+        for (const auto& entry : probes_) out.push_back(entry.first);
+        return out;
+    }
+
+    size_t memoryBytes() const {
+        size_t bytes = 0;
+        for (const auto& entry : probes_) {
+            const Probe& probe = entry.second;
+            bytes += probe.steps.capacity() * sizeof(uint64_t) + probe.values.capacity() * sizeof(double) +
+                     probe.spec.points.capacity() * sizeof(uint64_t) + probe.spec.fields.capacity() * sizeof(int);
+        }
+        return bytes;
+    }
+
+private:
+    struct Probe {
+        ProbeSpec spec;
+        size_t stride = 0;              // points * fields values per sample
+        std::vector<uint64_t> steps;    // Ring of step stamps
+        std::vector<double> values;     // Ring of samples
+        size_t head = 0;                // Oldest slot
+        size_t count = 0;               // Pending samples
+        uint64_t dropped = 0;
+        std::vector<std::pair<int, ProbeTap>> taps;
+    };
+
+    std::map<int, Probe> probes_;
+    int next_id_ = 1;
+    int next_tap_id_ = 1;
+};
+
+} // namespace dase
@@ -3,19 +3,376 @@
 #include <pybind11/numpy.h>
 
 #include "analog_universal_node_engine_avx2.h"
+#include "dase_oscillator_bank.h"
+#include "dase_stream_filter.h"
+#include "igsoa_complex_engine.h"
+#include "igsoa_complex_engine_2d.h"
+#include "igsoa_complex_engine_3d.h"
+#include "mission_executor.h"
+#include "satp_higgs_engine_1d.h"
+#include "satp_higgs_physics_1d.h"
+#include "satp_higgs_engine_2d.h"
+#include "satp_higgs_physics_2d.h"
+#include "satp_higgs_engine_3d.h"
+#include "satp_higgs_physics_3d.h"
+#include "sid_ternary_engine.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
 
 namespace py = pybind11;
 
+using dase::AsyncMission;
+using dase::MissionExecutor;
+using dase::MissionState;
+using dase::igsoa::IGSOAComplexConfig;
+using dase::igsoa::IGSOAComplexEngine;
+using dase::igsoa::IGSOAComplexEngine2D;
+using dase::igsoa::IGSOAComplexEngine3D;
+using dase::igsoa::IGSOAComplexNode;
+using dase::satp_higgs::SATPHiggsEngine1D;
+using dase::satp_higgs::SATPHiggsEngine2D;
+using dase::satp_higgs::SATPHiggsEngine3D;
+using dase::satp_higgs::SATPHiggsNode;
+using dase::satp_higgs::SATPHiggsParams;
+
+namespace {
+
+using SignalArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+// Zero-copy view of one member of every node: a strided array straight over
+// the engine's node records, in C order for `shape` (x fastest, matching the
+// engines' row-major lattices).  `owner` (the Python engine) stays alive as
+// long as the view does.
+template<typename Node, typename T>
+py::array nodeFieldView(py::handle owner, const std::vector<Node>& nodes, T Node::*member,
+                        std::vector<py::ssize_t> shape, bool writeable = true) {
+    std::vector<py::ssize_t> strides(shape.size());
+    py::ssize_t stride = static_cast<py::ssize_t>(sizeof(Node));
+    for (size_t d = shape.size(); d-- > 0;) {
+        strides[d] = stride;
+        stride *= shape[d];
+    }
+    const T* data = nodes.empty() ? nullptr : &(nodes.data()->*member);
+    py::array view(py::dtype::of<T>(), shape, strides, data, owner);
+    if (!writeable) {
+        view.attr("setflags")(py::arg("write") = false);
+    }
+    return view;
+}
+
+// Copy of one member of every node, shaped like nodeFieldView
+template<typename Node, typename T>
+py::array_t<T> nodeFieldCopy(const std::vector<Node>& nodes, T Node::*member, std::vector<py::ssize_t> shape) {
+    py::array_t<T> copy(shape);
+    T* out = copy.mutable_data();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        out[i] = nodes[i].*member;
+    }
+    return copy;
+}
+
+// Write an array of the field's shape into one member of every node
+template<typename Node, typename T>
+void setNodeField(std::vector<Node>& nodes, T Node::*member, const std::vector<py::ssize_t>& shape,
+                  const py::array_t<T, py::array::c_style | py::array::forcecast>& values) {
+    if (values.ndim() != static_cast<py::ssize_t>(shape.size()) ||
+        !std::equal(shape.begin(), shape.end(), values.shape())) {
+        throw std::invalid_argument("field assignment must match the lattice shape");
+    }
+    const T* in = values.data();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].*member = in[i];
+    }
+}
+
+// Read-only zero-copy view of a contiguous field
+py::array fieldView(py::handle owner, const std::vector<double>& field) {
+    py::array view(py::dtype::of<double>(), {static_cast<py::ssize_t>(field.size())},
+                   {static_cast<py::ssize_t>(sizeof(double))}, field.data(), owner);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+}
+
+const double* signalData(const std::optional<SignalArray>& signal, uint64_t num_steps, const char* name) {
+    if (!signal) {
+        return nullptr;
+    }
+    if (signal->ndim() != 1 || static_cast<uint64_t>(signal->shape(0)) < num_steps) {
+        throw std::invalid_argument(std::string(name) + " must be a 1-D array of at least num_steps samples");
+    }
+    return signal->data();
+}
+
+// ---------------------------------------------------------------------------
+// Async missions (mission_executor.h)
+// ---------------------------------------------------------------------------
+
+// Chunk (cancellation granularity) of an async mission without progress_every
+constexpr uint64_t kAsyncChunkSteps = 64;
+
+// Python references of one async mission.  Workers touch them only with the
+// GIL held, and onFinish drops them, so no Python object outlives the mission
+// in a std::function released without the GIL.
+struct MissionHooks {
+    py::object owner;                    // The engine, alive while the mission runs
+    py::object future;                   // The MissionFuture, for done callbacks
+    py::object progress;                 // progress(steps_done, num_steps) or null
+    std::vector<py::object> callbacks;   // add_done_callback functions
+    bool finished = false;               // Final state set (GIL-guarded)
+};
+
+struct MissionFuture {
+    std::shared_ptr<AsyncMission> mission;
+    std::shared_ptr<MissionHooks> hooks;
+};
+
+// Engines with an async mission in flight (GIL-guarded)
+std::set<const void*>& busyEngines() {
+    static std::set<const void*> engines;
+    return engines;
+}
+
+void raiseMissionOutcome(const AsyncMission& mission) {
+    switch (mission.state()) {
+        case MissionState::Cancelled: {
+            py::object cancelled = py::module_::import("concurrent.futures").attr("CancelledError");
+            PyErr_SetString(cancelled.ptr(), "mission cancelled");
+            throw py::error_already_set();
+        }
+        case MissionState::Failed:
+            throw std::runtime_error("mission failed: " + mission.error());
+        default:
+            return;
+    }
+}
+
+// Steps run, once the mission has finished (GIL released while waiting)
+uint64_t missionResult(const MissionFuture& future, std::optional<double> timeout) {
+    if (!future.hooks->finished) {
+        bool finished = false;
+        {
+            py::gil_scoped_release release;
+            finished = future.mission->wait(timeout ? *timeout : -1.0);
+        }
+        if (!finished) {
+            py::object timeout_error = py::module_::import("concurrent.futures").attr("TimeoutError");
+            PyErr_SetString(timeout_error.ptr(), "mission still running");
+            throw py::error_already_set();
+        }
+    }
+    raiseMissionOutcome(*future.mission);
+    return future.mission->stepsDone();
+}
+
+/**
+ * Queue `step` on the module's MissionExecutor and return its MissionFuture.
+ * progress(steps_done, num_steps) runs on the worker (GIL held) every
+ * progress_every steps and at the end; returning False cancels.
+ */
+py::object submitMission(py::object owner, const void* engine, uint64_t num_steps, uint64_t chunk_steps,
+                         AsyncMission::StepFn step, py::object progress, uint64_t progress_every) {
+    if (!busyEngines().insert(engine).second) {
+        throw std::runtime_error("engine already has an async mission in flight");
+    }
+    auto mission = std::make_shared<AsyncMission>(num_steps, chunk_steps, std::move(step));
+    auto hooks = std::make_shared<MissionHooks>();
+    hooks->owner = owner;
+    if (!progress.is_none()) {
+        hooks->progress = progress;
+    }
+    py::object future = py::cast(MissionFuture{mission, hooks});
+    hooks->future = future;
+
+    if (hooks->progress) {
+        mission->setProgress(progress_every, [hooks, num_steps](uint64_t steps_done) {
+            py::gil_scoped_acquire gil;
+            try {
+                return hooks->progress(steps_done, num_steps).ptr() != Py_False;
+            } catch (const py::error_already_set& e) {
+                throw std::runtime_error(std::string("progress callback: ") + e.what());
+            }
+        });
+    }
+    mission->setOnFinish([hooks, engine](AsyncMission&) {
+        py::gil_scoped_acquire gil;
+        hooks->finished = true;
+        busyEngines().erase(engine);
+        std::vector<py::object> callbacks;
+        callbacks.swap(hooks->callbacks);
+        for (const py::object& callback : callbacks) {
+            try {
+                callback(hooks->future);
+            } catch (py::error_already_set& e) {
+                e.discard_as_unraisable("MissionFuture done callback");
+            }
+        }
+        hooks->progress = py::object();
+        hooks->future = py::object();
+        hooks->owner = py::object();
+    });
+    MissionExecutor::process().submit(mission);
+    return future;
+}
+
+uint64_t asyncChunkSteps(uint64_t progress_every) {
+    return progress_every > 0 ? progress_every : kAsyncChunkSteps;
+}
+
+// IGSOA runMission with optional NumPy drive signals; the GIL is released
+// for the mission itself
+template<typename Engine>
+void runIgsoaMission(Engine& engine, uint64_t num_steps,
+                     const std::optional<SignalArray>& input_signals,
+                     const std::optional<SignalArray>& control_patterns) {
+    const double* input = signalData(input_signals, num_steps, "input_signals");
+    const double* control = signalData(control_patterns, num_steps, "control_patterns");
+    if ((input == nullptr) != (control == nullptr)) {
+        throw std::invalid_argument("input_signals and control_patterns must be given together");
+    }
+    py::gil_scoped_release release;
+    engine.runMission(num_steps, input, control);
+}
+
+// runMission on the executor in chunks; the signals are copied so the
+// arrays may be released while the mission runs
+template<typename Engine>
+py::object runIgsoaMissionAsync(py::object self, uint64_t num_steps,
+                                const std::optional<SignalArray>& input_signals,
+                                const std::optional<SignalArray>& control_patterns,
+                                py::object progress, uint64_t progress_every) {
+    Engine& engine = self.cast<Engine&>();
+    const double* input = signalData(input_signals, num_steps, "input_signals");
+    const double* control = signalData(control_patterns, num_steps, "control_patterns");
+    if ((input == nullptr) != (control == nullptr)) {
+        throw std::invalid_argument("input_signals and control_patterns must be given together");
+    }
+    auto signals = std::make_shared<std::vector<double>>();
+    if (input) {
+        signals->assign(input, input + num_steps);
+        signals->insert(signals->end(), control, control + num_steps);
+    }
+    Engine* target = &engine;
+    return submitMission(self, target, num_steps, asyncChunkSteps(progress_every),
+        [target, signals, num_steps](uint64_t first_step, uint64_t steps) {
+            if (signals->empty()) {
+                return target->runMission(steps);
+            }
+            return target->runMission(steps, signals->data() + first_step,
+                                      signals->data() + num_steps + first_step);
+        }, progress, progress_every);
+}
+
+template<typename Engine>
+py::dict igsoaMetrics(const Engine& engine) {
+    double ns_per_op = 0.0;
+    double ops_per_sec = 0.0;
+    double speedup_factor = 0.0;
+    uint64_t total_operations = 0;
+    engine.getMetrics(ns_per_op, ops_per_sec, speedup_factor, total_operations);
+    py::dict metrics;
+    metrics["ns_per_op"] = ns_per_op;
+    metrics["ops_per_sec"] = ops_per_sec;
+    metrics["speedup_factor"] = speedup_factor;
+    metrics["total_operations"] = total_operations;
+    return metrics;
+}
+
+// psi / phi / F views shared by the three IGSOA engines
+template<typename Engine, typename... Options>
+void bindIgsoaState(py::class_<Engine, Options...>& cls, std::vector<py::ssize_t> (*shape)(const Engine&)) {
+    // The node vector is never reallocated, so psi / phi views stay live
+    // across missions; they come from getNodesMutable() so a device-resident
+    // 3D lattice re-uploads the edits
+    cls.def_property_readonly("psi", [shape](py::object self) {
+            Engine& engine = self.cast<Engine&>();
+            return nodeFieldView(self, engine.getNodesMutable(), &IGSOAComplexNode::psi, shape(engine));
+        }, "Live complex128 view of psi (no copy; writes go to the engine)")
+       .def_property_readonly("phi", [shape](py::object self) {
+            Engine& engine = self.cast<Engine&>();
+            return nodeFieldView(self, engine.getNodesMutable(), &IGSOAComplexNode::phi, shape(engine));
+        }, "Live float64 view of phi (no copy; writes go to the engine)")
+       .def_property_readonly("F", [shape](py::object self) {
+            const Engine& engine = self.cast<const Engine&>();
+            return nodeFieldView(self, engine.getNodes(), &IGSOAComplexNode::F, shape(engine), false);
+        }, "Read-only view of the informational density |psi|^2 (as of the last step)")
+       .def("run_mission", &runIgsoaMission<Engine>,
+            py::arg("num_steps"), py::arg("input_signals") = py::none(),
+            py::arg("control_patterns") = py::none(),
+            "Advance num_steps steps (releases the GIL)")
+       .def("run_mission_async", &runIgsoaMissionAsync<Engine>,
+            py::arg("num_steps"), py::arg("input_signals") = py::none(),
+            py::arg("control_patterns") = py::none(), py::arg("progress") = py::none(),
+            py::arg("progress_every") = 0,
+            "run_mission on the mission executor; returns a MissionFuture.  Leave the "
+            "engine alone until it is done.")
+       .def("get_metrics", &igsoaMetrics<Engine>)
+       .def("reset", &Engine::reset)
+       .def_property_readonly("current_time", &Engine::getCurrentTime)
+       .def_property_readonly("total_steps", &Engine::getTotalSteps);
+}
+
+// phi / phi_dot / h / h_dot of the three SATP engines.  evolve() swaps the
+// engines' node buffers, so a view would dangle after it: reads return
+// copies and assigning a whole array writes the field.
+template<typename Engine, typename... Options>
+void bindSatpState(py::class_<Engine, Options...>& cls, std::vector<py::ssize_t> (*shape)(const Engine&)) {
+    auto field = [&cls, shape](const char* name, double SATPHiggsNode::*member, const char* doc) {
+        cls.def_property(name,
+            [shape, member](const Engine& engine) {
+                return nodeFieldCopy(engine.getNodes(), member, shape(engine));
+            },
+            [shape, member](Engine& engine,
+                            const py::array_t<double, py::array::c_style | py::array::forcecast>& values) {
+                setNodeField(engine.getNodesMutable(), member, shape(engine), values);
+            }, doc);
+    };
+    field("phi", &SATPHiggsNode::phi, "Copy of the scale field phi (assign an array to write it)");
+    field("phi_dot", &SATPHiggsNode::phi_dot, "Copy of dphi/dt (assign an array to write it)");
+    field("h", &SATPHiggsNode::h, "Copy of the Higgs field h (assign an array to write it)");
+    field("h_dot", &SATPHiggsNode::h_dot, "Copy of dh/dt (assign an array to write it)");
+    cls.def("evolve", &Engine::evolve, py::arg("num_steps"),
+            py::call_guard<py::gil_scoped_release>(), "Advance num_steps steps (releases the GIL)")
+       .def("evolve_async", [](py::object self, uint64_t num_steps, py::object progress, uint64_t progress_every) {
+            Engine* engine = &self.cast<Engine&>();
+            return submitMission(self, engine, num_steps, asyncChunkSteps(progress_every),
+                [engine](uint64_t, uint64_t steps) {
+                    engine->evolve(static_cast<size_t>(steps));
+                    return steps;
+                }, progress, progress_every);
+        }, py::arg("num_steps"), py::arg("progress") = py::none(), py::arg("progress_every") = 0,
+            "evolve on the mission executor; returns a MissionFuture.  Leave the engine "
+            "alone until it is done.")
+       .def("compute_total_energy", &Engine::computeTotalEnergy)
+       .def("compute_phi_rms", &Engine::computePhiRMS)
+       .def("compute_higgs_rms", &Engine::computeHiggsRMS)
+       .def_property_readonly("time", &Engine::getTime)
+       .def_property_readonly("step_count", &Engine::getStepCount);
+}
+
+} // namespace
+
 PYBIND11_MODULE(dase_engine, m) {
     m.doc() = "DASE Analog Engine AVX2 Python Bindings";
 
     // ------------------------------------------------------------------------
     //  CPU Feature Access Layer
     // ------------------------------------------------------------------------
+    py::enum_<KernelISA>(m, "KernelISA")
+        .value("Scalar", KernelISA::Scalar)
+        .value("AVX2", KernelISA::AVX2)
+        .value("AVX512", KernelISA::AVX512);
+
     py::class_<CPUFeatures>(m, "CPUFeatures")
         .def(py::init<>())
         .def_static("has_avx2", &CPUFeatures::hasAVX2)
         .def_static("has_fma", &CPUFeatures::hasFMA)
+        .def_static("has_avx512f", &CPUFeatures::hasAVX512F)
+        .def_static("best_kernel_isa", &CPUFeatures::bestKernelISA)
         .def_static("print_capabilities", &CPUFeatures::printCapabilities);
 
     m.def("cpu_has_avx2", []() { return CPUFeatures::hasAVX2(); });
@@ -36,6 +393,17 @@ PYBIND11_MODULE(dase_engine, m) {
         .def_readwrite("current_ns_per_op", &EngineMetrics::current_ns_per_op)
         .def_readwrite("current_ops_per_second", &EngineMetrics::current_ops_per_second)
         .def_readwrite("speedup_factor", &EngineMetrics::speedup_factor)
+        .def_readwrite("mission_kernel", &EngineMetrics::mission_kernel)
+        .def_readwrite("hw_counters_valid", &EngineMetrics::hw_counters_valid)
+        .def_readwrite("hw_cycles", &EngineMetrics::hw_cycles)
+        .def_readwrite("hw_instructions", &EngineMetrics::hw_instructions)
+        .def_readwrite("hw_llc_misses", &EngineMetrics::hw_llc_misses)
+        .def_readwrite("hw_ipc", &EngineMetrics::hw_ipc)
+        .def_readwrite("hw_dram_bandwidth_gbps", &EngineMetrics::hw_dram_bandwidth_gbps)
+        .def_readwrite("energy_valid", &EngineMetrics::energy_valid)
+        .def_readwrite("energy_joules", &EngineMetrics::energy_joules)
+        .def_readwrite("energy_average_watts", &EngineMetrics::energy_average_watts)
+        .def_readwrite("energy_joules_per_node_update", &EngineMetrics::energy_joules_per_node_update)
         .def("update_performance", &EngineMetrics::update_performance)
         .def("print_metrics", &EngineMetrics::print_metrics)
         .def("reset", &EngineMetrics::reset);
@@ -83,10 +451,40 @@ PYBIND11_MODULE(dase_engine, m) {
             return data;
         }, py::arg("data"),
            "Process signal block with NumPy zero-copy (in-place, faster)")
+        .def("process_blocks_frequency_domain_np", [](AnalogUniversalNodeAVX2& self, py::array_t<float> data) {
+            py::buffer_info buf = data.request();
+            if (buf.ndim != 2) {
+                throw std::runtime_error("Input must be a 2-dimensional (blocks x samples) array");
+            }
+            if (buf.strides[1] != static_cast<py::ssize_t>(sizeof(float)) ||
+                buf.strides[0] != static_cast<py::ssize_t>(buf.shape[1] * sizeof(float))) {
+                throw std::runtime_error("Input must be C-contiguous");
+            }
+            float* ptr = static_cast<float*>(buf.ptr);
+            int num_blocks = static_cast<int>(buf.shape[0]);
+            int block_size = static_cast<int>(buf.shape[1]);
+            self.processBlocksFrequencyDomain_inplace(ptr, block_size, num_blocks);
+            return data;
+        }, py::arg("data"),
+           "Filter every row of a (blocks x samples) array in place with one batched FFT")
         // --- Batch processing ---
-        .def("process_batch", &AnalogUniversalNodeAVX2::processBatch,
-             py::arg("input_signals"), py::arg("control_signals"), py::arg("aux_signals"),
-             "Process multiple samples in one call (5-10x faster than individual calls)")
+        .def("process_batch", [](AnalogUniversalNodeAVX2& self, SignalArray input_signals,
+                                 SignalArray control_signals, SignalArray aux_signals) {
+            const py::ssize_t n = input_signals.size();
+            if (input_signals.ndim() != 1 || control_signals.ndim() != 1 || aux_signals.ndim() != 1 ||
+                control_signals.size() != n || aux_signals.size() != n) {
+                throw std::runtime_error("Batch processing: all input vectors must have same size");
+            }
+            py::array_t<double> results(n);
+            double* out = results.mutable_data();
+            {
+                py::gil_scoped_release release;
+                self.processBatch(input_signals.data(), control_signals.data(), aux_signals.data(),
+                                  static_cast<size_t>(n), out);
+            }
+            return results;
+        }, py::arg("input_signals"), py::arg("control_signals"), py::arg("aux_signals"),
+           "Process multiple samples in one call straight from NumPy buffers (lists are converted)")
         // --- Public state access ---
         .def_readwrite("x", &AnalogUniversalNodeAVX2::x)
         .def_readwrite("y", &AnalogUniversalNodeAVX2::y)
@@ -97,24 +495,415 @@ PYBIND11_MODULE(dase_engine, m) {
         .def_readwrite("current_output", &AnalogUniversalNodeAVX2::current_output)
         .def_readwrite("feedback_gain", &AnalogUniversalNodeAVX2::feedback_gain);
 
+    // ------------------------------------------------------------------------
+    //  Streaming FIR Filter (overlap-add, per-channel state across calls)
+    // ------------------------------------------------------------------------
+    py::class_<dase::StreamFilter>(m, "StreamFilter")
+        .def(py::init<const std::vector<double>&, int, int>(),
+             py::arg("taps"), py::arg("block_size") = 0, py::arg("channels") = 1)
+        .def_static("from_response", [](const std::vector<double>& gains, int num_taps, int block_size, int channels) {
+            return dase::StreamFilter(dase::StreamFilter::designFromResponse(gains, num_taps), block_size, channels);
+        }, py::arg("gains"), py::arg("num_taps"), py::arg("block_size") = 0, py::arg("channels") = 1,
+           "Linear-phase filter from a magnitude response sampled evenly from 0 to Nyquist")
+        .def_static("design_from_response", &dase::StreamFilter::designFromResponse,
+                    py::arg("gains"), py::arg("num_taps"))
+        .def("process", [](dase::StreamFilter& self,
+                           py::array_t<float, py::array::c_style | py::array::forcecast> data) {
+            py::buffer_info buf = data.request();
+            const bool single = buf.ndim == 1;
+            if (!(single && self.channels() == 1) && !(buf.ndim == 2 && buf.shape[0] == self.channels())) {
+                throw std::runtime_error("Input must be (channels x samples), or 1-dimensional for one channel");
+            }
+            const size_t num_samples = static_cast<size_t>(buf.shape[buf.ndim - 1]);
+            py::array_t<float> output(buf.shape);
+            const float* in = static_cast<const float*>(buf.ptr);
+            float* out = static_cast<float*>(output.request().ptr);
+            {
+                py::gil_scoped_release release;
+                self.process(in, out, num_samples);
+            }
+            return output;
+        }, py::arg("data"),
+           "Filter the next samples of every channel; history carries over between calls (releases the GIL)")
+        .def("reset", &dase::StreamFilter::reset)
+        .def_property_readonly("taps", &dase::StreamFilter::taps)
+        .def_property_readonly("num_taps", &dase::StreamFilter::numTaps)
+        .def_property_readonly("block_size", &dase::StreamFilter::blockSize)
+        .def_property_readonly("fft_size", &dase::StreamFilter::fftSize)
+        .def_property_readonly("channels", &dase::StreamFilter::channels)
+        .def_property_readonly("samples_processed", &dase::StreamFilter::samplesProcessed);
+
+    // ------------------------------------------------------------------------
+    //  Oscillator Bank (many tones per call, phase carried across calls)
+    // ------------------------------------------------------------------------
+    py::class_<dase::OscillatorBank>(m, "OscillatorBank")
+        .def(py::init<const std::vector<double>&, double, const std::vector<double>&, const std::vector<double>&>(),
+             py::arg("frequencies_hz"), py::arg("sample_rate") = 48000.0,
+             py::arg("phases") = std::vector<double>(), py::arg("amplitudes") = std::vector<double>())
+        .def("render_sum", [](dase::OscillatorBank& self, size_t num_samples) {
+            py::array_t<float> output(static_cast<py::ssize_t>(num_samples));
+            float* out = static_cast<float*>(output.request().ptr);
+            {
+                py::gil_scoped_release release;
+                self.renderSum(out, num_samples);
+            }
+            return output;
+        }, py::arg("num_samples"),
+           "Sum of all oscillators over the next num_samples samples (releases the GIL)")
+        .def("render_sum_into", [](dase::OscillatorBank& self, py::array_t<float> data, bool accumulate) {
+            py::buffer_info buf = data.request(true);
+            if (buf.ndim != 1 || buf.strides[0] != static_cast<py::ssize_t>(sizeof(float))) {
+                throw std::runtime_error("Output must be a contiguous 1-dimensional float32 array");
+            }
+            float* out = static_cast<float*>(buf.ptr);
+            const size_t num_samples = static_cast<size_t>(buf.shape[0]);
+            {
+                py::gil_scoped_release release;
+                self.renderSum(out, num_samples, accumulate);
+            }
+        }, py::arg("output"), py::arg("accumulate") = true,
+           "Render the sum into an existing buffer (added to its contents by default)")
+        .def("render_channels", [](dase::OscillatorBank& self, size_t num_samples) {
+            py::array_t<float> output({static_cast<py::ssize_t>(self.size()), static_cast<py::ssize_t>(num_samples)});
+            float* out = static_cast<float*>(output.request().ptr);
+            {
+                py::gil_scoped_release release;
+                self.renderChannels(out, num_samples);
+            }
+            return output;
+        }, py::arg("num_samples"),
+           "(oscillators x num_samples) array of each oscillator's next samples (releases the GIL)")
+        .def("set_frequency", &dase::OscillatorBank::setFrequency, py::arg("index"), py::arg("frequency_hz"))
+        .def("set_amplitude", &dase::OscillatorBank::setAmplitude, py::arg("index"), py::arg("amplitude"))
+        .def("set_phase", &dase::OscillatorBank::setPhase, py::arg("index"), py::arg("phase"))
+        .def("__len__", &dase::OscillatorBank::size)
+        .def_property_readonly("sample_rate", &dase::OscillatorBank::sampleRate)
+        .def_property_readonly("phases", &dase::OscillatorBank::phases)
+        .def_property_readonly("samples_rendered", &dase::OscillatorBank::samplesRendered);
+
+    // ------------------------------------------------------------------------
+    //  Async Missions
+    // ------------------------------------------------------------------------
+    // run_mission_async / evolve_async queue a mission on the module's
+    // MissionExecutor (one worker per core; each mission leases its OpenMP
+    // team from the thread budget) and return at once.
+    py::class_<MissionFuture>(m, "MissionFuture")
+        .def("done", [](const MissionFuture& self) { return self.hooks->finished; })
+        .def("running", [](const MissionFuture& self) {
+            return self.mission->state() == MissionState::Running;
+        })
+        .def("cancelled", [](const MissionFuture& self) {
+            return self.hooks->finished && self.mission->state() == MissionState::Cancelled;
+        })
+        .def("cancel", [](const MissionFuture& self) { return self.mission->cancel(); },
+             "Stop the mission (a running one after its current chunk); False once finished")
+        .def("result", &missionResult, py::arg("timeout") = py::none(),
+             "Steps run, once finished (releases the GIL while waiting).  Raises "
+             "concurrent.futures.CancelledError / TimeoutError, or RuntimeError if the mission failed.")
+        .def("add_done_callback", [](py::object self, py::object callback) {
+            const MissionFuture& future = self.cast<const MissionFuture&>();
+            if (future.hooks->finished) {
+                callback(self);
+            } else {
+                future.hooks->callbacks.push_back(callback);
+            }
+        }, py::arg("fn"), "fn(future) once finished, on the thread that finished it")
+        .def("__await__", [](py::object self) {
+            // Settle an asyncio future from the loop thread; cancelling the
+            // awaiting task cancels the mission
+            const MissionFuture& future = self.cast<const MissionFuture&>();
+            py::object loop = py::module_::import("asyncio").attr("get_running_loop")();
+            py::object waiter = loop.attr("create_future")();
+            py::object settle = py::cpp_function([self, waiter]() {
+                if (waiter.attr("done")().cast<bool>()) {
+                    return;
+                }
+                const MissionFuture& f = self.cast<const MissionFuture&>();
+                if (f.mission->state() == MissionState::Cancelled) {
+                    waiter.attr("cancel")();
+                    return;
+                }
+                try {
+                    waiter.attr("set_result")(missionResult(f, std::nullopt));
+                } catch (py::error_already_set& e) {
+                    waiter.attr("set_exception")(e.value());
+                } catch (const std::exception& e) {
+                    waiter.attr("set_exception")(py::module_::import("builtins").attr("RuntimeError")(e.what()));
+                }
+            });
+            std::shared_ptr<AsyncMission> mission = future.mission;
+            waiter.attr("add_done_callback")(py::cpp_function([mission](py::object w) {
+                if (w.attr("cancelled")().cast<bool>()) {
+                    mission->cancel();
+                }
+            }));
+            self.attr("add_done_callback")(py::cpp_function([loop, settle](py::object) {
+                loop.attr("call_soon_threadsafe")(settle);
+            }));
+            return waiter.attr("__await__")();
+        })
+        .def_property_readonly("steps_done", [](const MissionFuture& self) { return self.mission->stepsDone(); })
+        .def_property_readonly("num_steps", [](const MissionFuture& self) { return self.mission->numSteps(); })
+        .def_property_readonly("state", [](const MissionFuture& self) {
+            return std::string(dase::missionStateName(self.mission->state()));
+        });
+
+    m.def("async_workers", []() { return MissionExecutor::process().workers(); });
+    m.def("set_async_workers", [](size_t workers) { MissionExecutor::process().setWorkers(workers); },
+          py::arg("workers"), "Executor width before the first async mission (0 = one per core)");
+    m.def("pending_missions", []() { return MissionExecutor::process().pending(); });
+    // Stop the workers before the interpreter goes away (they take the GIL)
+    py::module_::import("atexit").attr("register")(py::cpp_function([]() {
+        py::gil_scoped_release release;
+        MissionExecutor::process().shutdown();
+    }));
+
     // ------------------------------------------------------------------------
     //  Analog Cellular Engine
     // ------------------------------------------------------------------------
     py::class_<AnalogCellularEngineAVX2>(m, "AnalogCellularEngineAVX2")
         .def(py::init<std::size_t>(), py::arg("num_nodes") = 1024)
-        .def("run_mission", &AnalogCellularEngineAVX2::runMission)
-        .def("run_builtin_benchmark", &AnalogCellularEngineAVX2::runBuiltinBenchmark)
-        .def("run_massive_benchmark", &AnalogCellularEngineAVX2::runMassiveBenchmark)
-        .def("run_drag_race_benchmark", &AnalogCellularEngineAVX2::runDragRaceBenchmark)
+        .def("run_mission", &AnalogCellularEngineAVX2::runMission,
+             py::call_guard<py::gil_scoped_release>())
+        .def("run_mission_async", [](py::object self, uint64_t num_steps, py::object progress) {
+            // runMission restarts its drive signal on every call, so the
+            // mission is one chunk: cancellable only while queued
+            AnalogCellularEngineAVX2* engine = &self.cast<AnalogCellularEngineAVX2&>();
+            return submitMission(self, engine, num_steps, 0, [engine](uint64_t, uint64_t steps) {
+                engine->runMission(steps);
+                return steps;
+            }, progress, 0);
+        }, py::arg("num_steps"), py::arg("progress") = py::none(),
+           "run_mission on the mission executor; returns a MissionFuture")
+        .def("run_mission_phase4c", [](AnalogCellularEngineAVX2& self, SignalArray input_signals,
+                                       SignalArray control_patterns, uint32_t iterations_per_node) {
+            const uint64_t num_steps = static_cast<uint64_t>(input_signals.size());
+            if (input_signals.ndim() != 1 || control_patterns.ndim() != 1 ||
+                static_cast<uint64_t>(control_patterns.size()) != num_steps) {
+                throw std::invalid_argument("input_signals and control_patterns must be 1-D arrays of equal length");
+            }
+            py::gil_scoped_release release;
+            self.runMissionOptimized_Phase4C(input_signals.data(), control_patterns.data(),
+                                             num_steps, iterations_per_node);
+        }, py::arg("input_signals"), py::arg("control_patterns"), py::arg("iterations_per_node") = 30,
+           "Phase 4C mission over pre-computed signals (releases the GIL)")
+        .def("run_mission_coupled_phase4c", [](AnalogCellularEngineAVX2& self, SignalArray input_signals,
+                                               SignalArray control_patterns, uint32_t iterations_per_node) {
+            const uint64_t num_steps = static_cast<uint64_t>(input_signals.size());
+            if (input_signals.ndim() != 1 || control_patterns.ndim() != 1 ||
+                static_cast<uint64_t>(control_patterns.size()) != num_steps) {
+                throw std::invalid_argument("input_signals and control_patterns must be 1-D arrays of equal length");
+            }
+            py::gil_scoped_release release;
+            self.runMissionCoupled_Phase4C(input_signals.data(), control_patterns.data(),
+                                           num_steps, iterations_per_node);
+        }, py::arg("input_signals"), py::arg("control_patterns"), py::arg("iterations_per_node") = 30,
+           "Phase 4C mission with nearest-neighbour coupling (releases the GIL)")
+        .def("process_batch", [](AnalogCellularEngineAVX2& self, SignalArray input_signals,
+                                 SignalArray control_signals, std::optional<SignalArray> aux_signals,
+                                 bool return_outputs) -> py::object {
+            // (samples, nodes) per sample row, or (nodes,) for one sample
+            const py::ssize_t nodes = static_cast<py::ssize_t>(self.getNodeCount());
+            const py::ssize_t ndim = input_signals.ndim();
+            auto sameShape = [&](const SignalArray& other) {
+                if (other.ndim() != ndim) return false;
+                for (py::ssize_t d = 0; d < ndim; ++d) {
+                    if (other.shape(d) != input_signals.shape(d)) return false;
+                }
+                return true;
+            };
+            if ((ndim != 1 && ndim != 2) || input_signals.shape(ndim - 1) != nodes ||
+                !sameShape(control_signals) || (aux_signals && !sameShape(*aux_signals))) {
+                throw std::invalid_argument("Batch signals must share a (samples, num_nodes) or (num_nodes,) shape");
+            }
+            const size_t num_samples = (ndim == 2) ? static_cast<size_t>(input_signals.shape(0)) : 1;
+            const double* aux = aux_signals ? aux_signals->data() : nullptr;
+
+            py::array_t<double> outputs;
+            double* out = nullptr;
+            if (return_outputs) {
+                outputs = py::array_t<double>(std::vector<py::ssize_t>(input_signals.shape(),
+                                                                       input_signals.shape() + ndim));
+                out = outputs.mutable_data();
+            }
+            {
+                py::gil_scoped_release release;
+                self.processBatch(input_signals.data(), control_signals.data(), aux, num_samples, out);
+            }
+            return return_outputs ? py::object(outputs) : py::object(py::none());
+        }, py::arg("input_signals"), py::arg("control_signals"), py::arg("aux_signals") = py::none(),
+           py::arg("return_outputs") = true,
+           "Advance every node through per-node drive samples, lanes mapped to nodes (releases the GIL)")
+        .def("run_builtin_benchmark", &AnalogCellularEngineAVX2::runBuiltinBenchmark,
+             py::call_guard<py::gil_scoped_release>())
+        .def("run_massive_benchmark", &AnalogCellularEngineAVX2::runMassiveBenchmark,
+             py::call_guard<py::gil_scoped_release>())
+        .def("run_drag_race_benchmark", &AnalogCellularEngineAVX2::runDragRaceBenchmark,
+             py::call_guard<py::gil_scoped_release>())
         .def("process_signal_wave_avx2", &AnalogCellularEngineAVX2::processSignalWaveAVX2)
         .def("perform_signal_sweep_avx2", &AnalogCellularEngineAVX2::performSignalSweepAVX2)
         .def("process_block_frequency_domain", &AnalogCellularEngineAVX2::processBlockFrequencyDomain)
         .def("calculate_inter_node_coupling", &AnalogCellularEngineAVX2::calculateInterNodeCoupling)
         .def("generate_noise_signal", &AnalogCellularEngineAVX2::generateNoiseSignal)
         .def("get_metrics", &AnalogCellularEngineAVX2::getMetrics)
+        .def("get_mission_kernel_isa", &AnalogCellularEngineAVX2::getMissionKernelISA)
+        .def("set_mission_kernel_isa", &AnalogCellularEngineAVX2::setMissionKernelISA, py::arg("isa"))
+        .def("set_mission_blocking", &AnalogCellularEngineAVX2::setMissionBlocking,
+             py::arg("tile_nodes"), py::arg("step_block"),
+             "Phase 4B/4C temporal blocking (tile_nodes=0 disables; results unchanged)")
+        .def("get_mission_tile_nodes", &AnalogCellularEngineAVX2::getMissionTileNodes)
+        .def("get_mission_step_block", &AnalogCellularEngineAVX2::getMissionStepBlock)
+        .def("enable_hardware_counters", &AnalogCellularEngineAVX2::enableHardwareCounters,
+             py::arg("enable") = true,
+             "Collect cycles/instructions/LLC misses per mission (Linux perf_event); returns availability")
+        .def("hardware_counters_enabled", &AnalogCellularEngineAVX2::hardwareCountersEnabled)
+        .def("enable_energy_meter", &AnalogCellularEngineAVX2::enableEnergyMeter,
+             py::arg("enable") = true, "Measure package energy (RAPL / EMI) around every mission")
+        .def("energy_meter_enabled", &AnalogCellularEngineAVX2::energyMeterEnabled)
         .def("print_live_metrics", &AnalogCellularEngineAVX2::printLiveMetrics)
         .def("reset_metrics", &AnalogCellularEngineAVX2::resetMetrics);
 
+    // ------------------------------------------------------------------------
+    //  IGSOA Complex Engines (1D ring, 2D / 3D lattices)
+    // ------------------------------------------------------------------------
+    py::enum_<dase::igsoa::IGSOAUpdateMode>(m, "IGSOAUpdateMode")
+        .value("InPlace", dase::igsoa::IGSOAUpdateMode::InPlace)
+        .value("DoubleBuffered", dase::igsoa::IGSOAUpdateMode::DoubleBuffered);
+
+    py::enum_<dase::igsoa::IGSOACouplingMode>(m, "IGSOACouplingMode")
+        .value("Direct", dase::igsoa::IGSOACouplingMode::Direct)
+        .value("Stencil", dase::igsoa::IGSOACouplingMode::Stencil);
+
+    py::enum_<dase::igsoa::IGSOAIntegrator>(m, "IGSOAIntegrator")
+        .value("Euler", dase::igsoa::IGSOAIntegrator::Euler)
+        .value("RK2", dase::igsoa::IGSOAIntegrator::RK2)
+        .value("RK4", dase::igsoa::IGSOAIntegrator::RK4);
+
+    py::enum_<dase::igsoa::IGSOAPrecision>(m, "IGSOAPrecision")
+        .value("Double", dase::igsoa::IGSOAPrecision::Double)
+        .value("MixedFloat", dase::igsoa::IGSOAPrecision::MixedFloat)
+        .value("Float", dase::igsoa::IGSOAPrecision::Float);
+
+    py::class_<IGSOAComplexConfig>(m, "IGSOAComplexConfig")
+        .def(py::init<>())
+        .def_readwrite("num_nodes", &IGSOAComplexConfig::num_nodes)
+        .def_readwrite("R_c_default", &IGSOAComplexConfig::R_c_default)
+        .def_readwrite("kappa", &IGSOAComplexConfig::kappa)
+        .def_readwrite("gamma", &IGSOAComplexConfig::gamma)
+        .def_readwrite("dt", &IGSOAComplexConfig::dt)
+        .def_readwrite("normalize_psi", &IGSOAComplexConfig::normalize_psi)
+        .def_readwrite("update_mode", &IGSOAComplexConfig::update_mode)
+        .def_readwrite("omp_min_nodes", &IGSOAComplexConfig::omp_min_nodes)
+        .def_readwrite("coupling_mode", &IGSOAComplexConfig::coupling_mode)
+        .def_readwrite("fft_min_R_c", &IGSOAComplexConfig::fft_min_R_c)
+        .def_readwrite("simd_coupling", &IGSOAComplexConfig::simd_coupling)
+        .def_readwrite("integrator", &IGSOAComplexConfig::integrator)
+        .def_readwrite("temporal_block_steps", &IGSOAComplexConfig::temporal_block_steps)
+        .def_readwrite("precision", &IGSOAComplexConfig::precision)
+        .def_readwrite("sparse_threshold", &IGSOAComplexConfig::sparse_threshold)
+        .def_readwrite("sparse_block", &IGSOAComplexConfig::sparse_block);
+
+    py::class_<IGSOAComplexEngine> igsoa_1d(m, "IGSOAComplexEngine");
+    igsoa_1d.def(py::init<const IGSOAComplexConfig&>(), py::arg("config"))
+        .def_property_readonly("num_nodes", &IGSOAComplexEngine::getNumNodes)
+        .def("total_energy", &IGSOAComplexEngine::getTotalEnergy);
+    bindIgsoaState(igsoa_1d, +[](const IGSOAComplexEngine& e) {
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNumNodes())};
+    });
+
+    py::class_<IGSOAComplexEngine2D> igsoa_2d(m, "IGSOAComplexEngine2D");
+    igsoa_2d.def(py::init<const IGSOAComplexConfig&, size_t, size_t>(),
+                 py::arg("config"), py::arg("N_x"), py::arg("N_y"))
+        .def_property_readonly("N_x", &IGSOAComplexEngine2D::getNx)
+        .def_property_readonly("N_y", &IGSOAComplexEngine2D::getNy)
+        .def("total_energy", &IGSOAComplexEngine2D::getTotalEnergy);
+    bindIgsoaState(igsoa_2d, +[](const IGSOAComplexEngine2D& e) {  // (N_y, N_x)
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNy()),
+                                        static_cast<py::ssize_t>(e.getNx())};
+    });
+
+    py::class_<IGSOAComplexEngine3D> igsoa_3d(m, "IGSOAComplexEngine3D");
+    igsoa_3d.def(py::init<const IGSOAComplexConfig&, size_t, size_t, size_t>(),
+                 py::arg("config"), py::arg("N_x"), py::arg("N_y"), py::arg("N_z"))
+        .def_property_readonly("N_x", &IGSOAComplexEngine3D::getNx)
+        .def_property_readonly("N_y", &IGSOAComplexEngine3D::getNy)
+        .def_property_readonly("N_z", &IGSOAComplexEngine3D::getNz);
+    bindIgsoaState(igsoa_3d, +[](const IGSOAComplexEngine3D& e) {  // (N_z, N_y, N_x)
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNz()),
+                                        static_cast<py::ssize_t>(e.getNy()),
+                                        static_cast<py::ssize_t>(e.getNx())};
+    });
+
+    // ------------------------------------------------------------------------
+    //  SATP+Higgs Engines
+    // ------------------------------------------------------------------------
+    py::class_<SATPHiggsParams>(m, "SATPHiggsParams")
+        .def(py::init<>())
+        .def_readwrite("c", &SATPHiggsParams::c)
+        .def_readwrite("gamma_phi", &SATPHiggsParams::gamma_phi)
+        .def_readwrite("gamma_h", &SATPHiggsParams::gamma_h)
+        .def_readwrite("lambda_", &SATPHiggsParams::lambda)
+        .def_readwrite("mu_squared", &SATPHiggsParams::mu_squared)
+        .def_readwrite("lambda_h", &SATPHiggsParams::lambda_h)
+        .def_readonly("h_vev", &SATPHiggsParams::h_vev)
+        .def("update_vev", &SATPHiggsParams::updateVEV);
+
+    py::class_<SATPHiggsEngine1D> satp_1d(m, "SATPHiggsEngine1D");
+    satp_1d.def(py::init<size_t, double, double, const SATPHiggsParams&>(),
+                py::arg("num_nodes"), py::arg("dx"), py::arg("dt"), py::arg("params") = SATPHiggsParams())
+        .def_property_readonly("num_nodes", &SATPHiggsEngine1D::getN);
+    bindSatpState(satp_1d, +[](const SATPHiggsEngine1D& e) {
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getN())};
+    });
+
+    py::class_<SATPHiggsEngine2D> satp_2d(m, "SATPHiggsEngine2D");
+    satp_2d.def(py::init<size_t, size_t, double, double, const SATPHiggsParams&>(),
+                py::arg("N_x"), py::arg("N_y"), py::arg("dx"), py::arg("dt"),
+                py::arg("params") = SATPHiggsParams())
+        .def_property_readonly("N_x", &SATPHiggsEngine2D::getNx)
+        .def_property_readonly("N_y", &SATPHiggsEngine2D::getNy);
+    bindSatpState(satp_2d, +[](const SATPHiggsEngine2D& e) {  // (N_y, N_x)
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNy()),
+                                        static_cast<py::ssize_t>(e.getNx())};
+    });
+
+    py::class_<SATPHiggsEngine3D> satp_3d(m, "SATPHiggsEngine3D");
+    satp_3d.def(py::init<size_t, size_t, size_t, double, double, const SATPHiggsParams&>(),
+                py::arg("N_x"), py::arg("N_y"), py::arg("N_z"), py::arg("dx"), py::arg("dt"),
+                py::arg("params") = SATPHiggsParams())
+        .def_property_readonly("N_x", &SATPHiggsEngine3D::getNx)
+        .def_property_readonly("N_y", &SATPHiggsEngine3D::getNy)
+        .def_property_readonly("N_z", &SATPHiggsEngine3D::getNz);
+    bindSatpState(satp_3d, +[](const SATPHiggsEngine3D& e) {  // (N_z, N_y, N_x)
+        return std::vector<py::ssize_t>{static_cast<py::ssize_t>(e.getNz()),
+                                        static_cast<py::ssize_t>(e.getNy()),
+                                        static_cast<py::ssize_t>(e.getNx())};
+    });
+
+    // ------------------------------------------------------------------------
+    //  SID Ternary Engine
+    // ------------------------------------------------------------------------
+    py::class_<sid::SidTernaryEngine>(m, "SidTernaryEngine")
+        .def(py::init<size_t, double>(), py::arg("num_nodes"), py::arg("total_mass"))
+        .def("step", &sid::SidTernaryEngine::step, py::arg("alpha") = 1.0,
+             py::call_guard<py::gil_scoped_release>(), "One mixer step (releases the GIL)")
+        .def("collapse", &sid::SidTernaryEngine::collapse, py::arg("alpha") = 1.0,
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("I", [](py::object self) {
+            return fieldView(self, self.cast<const sid::SidTernaryEngine&>().getIField());
+        }, "Read-only live view of the I field (no copy)")
+        .def_property_readonly("N", [](py::object self) {
+            return fieldView(self, self.cast<const sid::SidTernaryEngine&>().getNField());
+        }, "Read-only live view of the N field (no copy)")
+        .def_property_readonly("U", [](py::object self) {
+            return fieldView(self, self.cast<const sid::SidTernaryEngine&>().getUField());
+        }, "Read-only live view of the U field (no copy)")
+        .def("I_mass", &sid::SidTernaryEngine::getIMass)
+        .def("N_mass", &sid::SidTernaryEngine::getNMass)
+        .def("U_mass", &sid::SidTernaryEngine::getUMass)
+        .def("is_conserved", &sid::SidTernaryEngine::isConserved, py::arg("tolerance") = 1e-6)
+        .def_property_readonly("step_count", &sid::SidTernaryEngine::getStepCount);
+
     // ------------------------------------------------------------------------
     //  Benchmark Helper
     // ------------------------------------------------------------------------
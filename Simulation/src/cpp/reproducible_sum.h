@@ -0,0 +1,82 @@
+/**
+ * Reproducible Parallel Sums
+ *
+ * An OpenMP `reduction(+:...)` adds per-thread partial sums whose
+ * boundaries move with the team size, so engine totals (energy, entropy
+ * rate, RMS, GW field statistics) would differ in the last bits between
+ * 1 and N threads and break the validation goldens.
+ *
+ * reproducibleSums() fixes the association instead: terms are summed in
+ * index order within blocks of kSumBlock indices, and the block sums are
+ * combined pairwise in a tree that depends only on the term count.  The
+ * team only decides which thread sums which block, so the result is
+ * bit-identical for any thread count (and with OpenMP off).  A total of at
+ * most kSumBlock terms is the plain sequential sum; larger totals also gain
+ * the pairwise error bound (O(log n) blocks deep instead of O(n)).
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+
+// Indices per block: fixed, so block boundaries depend on the count only
+constexpr int64_t kSumBlock = 4096;
+
+/**
+ * K sums over indices [0, n)
+ *
+ * @param add fn(int64_t i, double* acc) adding index i's terms to acc[0..K)
+ * @param parallel Spread blocks over the OpenMP team (never changes the result)
+ */
+template <size_t K, typename AddFn>
+std::array<double, K> reproducibleSums(int64_t n, AddFn&& add, bool parallel = true) {
+    std::array<double, K> total{};
+    if (n <= 0) {
+        return total;
+    }
+    const int64_t blocks = (n + kSumBlock - 1) / kSumBlock;
+    if (blocks == 1) {
+        for (int64_t i = 0; i < n; ++i) {
+            add(i, total.data());
+        }
+        return total;
+    }
+
+    std::vector<std::array<double, K>> partial(static_cast<size_t>(blocks));
+    #pragma omp parallel for schedule(static) if(parallel)
+    for (int64_t b = 0; b < blocks; ++b) {
+        std::array<double, K> acc{};
+        const int64_t end = b + 1 == blocks ? n : (b + 1) * kSumBlock;
+        for (int64_t i = b * kSumBlock; i < end; ++i) {
+            add(i, acc.data());
+        }
+        partial[static_cast<size_t>(b)] = acc;
+    }
+
+    // Pairwise: (0+1)+(2+3), then ((0+1)+(2+3))+((4+5)+(6+7)), ...
+    for (int64_t stride = 1; stride < blocks; stride *= 2) {
+        for (int64_t b = 0; b + stride < blocks; b += 2 * stride) {
+            auto& into = partial[static_cast<size_t>(b)];
+            const auto& from = partial[static_cast<size_t>(b + stride)];
+            for (size_t k = 0; k < K; ++k) {
+                into[k] += from[k];
+            }
+        }
+    }
+    return partial[0];
+}
+
+/**
+ * One sum over [0, n) of term(i)
+ */
+template <typename TermFn>
+double reproducibleSum(int64_t n, TermFn&& term, bool parallel = true) {
+    return reproducibleSums<1>(n, [&](int64_t i, double* acc) { acc[0] += term(i); }, parallel)[0];
+}
+
+} // namespace dase
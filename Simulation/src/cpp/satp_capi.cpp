@@ -0,0 +1,178 @@
+/**
+ * SATP+Higgs C API Implementation
+ */
+
+#include "satp_capi.h"
+#include "satp_higgs_physics_1d.h"
+#include "satp_higgs_physics_2d.h"
+#include "satp_higgs_physics_3d.h"
+#include <memory>
+
+using namespace dase::satp_higgs;
+
+// Opaque struct wrapping exactly one of the engines
+struct SATPEngine_C {
+    std::unique_ptr<SATPHiggsEngine1D> engine_1d;
+    std::unique_ptr<SATPHiggsEngine2D> engine_2d;
+    std::unique_ptr<SATPHiggsEngine3D> engine_3d;
+};
+
+namespace {
+
+SATPHiggsParams toParams(const SATPParams* params) {
+    SATPHiggsParams p;
+    if (params) {
+        p.c = params->c;
+        p.gamma_phi = params->gamma_phi;
+        p.gamma_h = params->gamma_h;
+        p.lambda = params->lambda;
+        p.mu_squared = params->mu_squared;
+        p.lambda_h = params->lambda_h;
+    }
+    p.updateVEV();
+    return p;
+}
+
+void* fieldOf(SATPHiggsNode& node, SATPField field) {
+    switch (field) {
+        case SATP_FIELD_PHI: return &node.phi;
+        case SATP_FIELD_PHI_DOT: return &node.phi_dot;
+        case SATP_FIELD_H: return &node.h;
+        case SATP_FIELD_H_DOT: return &node.h_dot;
+        case SATP_FIELD_ENERGY_DENSITY: return &node.energy_density;
+        case SATP_FIELD_CONFORMAL_FACTOR: return &node.conformal_factor;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+SATP_API void satp_params_init(SATPParams* params) {
+    if (!params) {
+        return;
+    }
+    const SATPHiggsParams defaults;
+    params->c = defaults.c;
+    params->gamma_phi = defaults.gamma_phi;
+    params->gamma_h = defaults.gamma_h;
+    params->lambda = defaults.lambda;
+    params->mu_squared = defaults.mu_squared;
+    params->lambda_h = defaults.lambda_h;
+}
+
+SATP_API SATPEngineHandle satp_create_engine(
+    uint32_t dims,
+    size_t N_x,
+    size_t N_y,
+    size_t N_z,
+    double dx,
+    double dt,
+    const SATPParams* params
+) {
+    if (dims < 1 || dims > 3 || N_x == 0 || (dims >= 2 && N_y == 0) || (dims == 3 && N_z == 0) ||
+        !(dx > 0.0) || !(dt > 0.0)) {
+        return nullptr;
+    }
+    try {
+        std::unique_ptr<SATPEngine_C> handle(new SATPEngine_C());
+        const SATPHiggsParams p = toParams(params);
+        if (dims == 1) {
+            handle->engine_1d.reset(new SATPHiggsEngine1D(N_x, dx, dt, p));
+        } else if (dims == 2) {
+            handle->engine_2d.reset(new SATPHiggsEngine2D(N_x, N_y, dx, dt, p));
+        } else {
+            handle->engine_3d.reset(new SATPHiggsEngine3D(N_x, N_y, N_z, dx, dt, p));
+        }
+        return handle.release();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+SATP_API void satp_destroy_engine(SATPEngineHandle engine) {
+    delete engine;
+}
+
+SATP_API bool satp_get_dimensions(SATPEngineHandle engine, size_t* N_x, size_t* N_y, size_t* N_z) {
+    if (!engine || !N_x || !N_y || !N_z) {
+        return false;
+    }
+    if (engine->engine_1d) {
+        *N_x = engine->engine_1d->getN();
+        *N_y = 1;
+        *N_z = 1;
+    } else if (engine->engine_2d) {
+        *N_x = engine->engine_2d->getNx();
+        *N_y = engine->engine_2d->getNy();
+        *N_z = 1;
+    } else {
+        *N_x = engine->engine_3d->getNx();
+        *N_y = engine->engine_3d->getNy();
+        *N_z = engine->engine_3d->getNz();
+    }
+    return true;
+}
+
+SATP_API bool satp_evolve(SATPEngineHandle engine, uint64_t num_steps) {
+    if (!engine) {
+        return false;
+    }
+    try {
+        if (engine->engine_1d) {
+            engine->engine_1d->evolve(static_cast<size_t>(num_steps));
+        } else if (engine->engine_2d) {
+            engine->engine_2d->evolve(static_cast<size_t>(num_steps));
+        } else {
+            engine->engine_3d->evolve(static_cast<size_t>(num_steps));
+        }
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+SATP_API double satp_get_time(SATPEngineHandle engine) {
+    if (!engine) return 0.0;
+    if (engine->engine_1d) return engine->engine_1d->getTime();
+    if (engine->engine_2d) return engine->engine_2d->getTime();
+    return engine->engine_3d->getTime();
+}
+
+SATP_API uint64_t satp_get_step_count(SATPEngineHandle engine) {
+    if (!engine) return 0;
+    if (engine->engine_1d) return engine->engine_1d->getStepCount();
+    if (engine->engine_2d) return engine->engine_2d->getStepCount();
+    return engine->engine_3d->getStepCount();
+}
+
+SATP_API bool satp_get_field_view(
+    SATPEngineHandle engine,
+    SATPField field,
+    DaseFieldView* view
+) {
+    if (!engine || field < SATP_FIELD_PHI || field > SATP_FIELD_CONFORMAL_FACTOR) {
+        return false;
+    }
+    size_t dims[3];
+    uint32_t ndim = 0;
+    std::vector<SATPHiggsNode>* nodes = nullptr;
+    if (engine->engine_1d) {
+        nodes = &engine->engine_1d->getNodesMutable();
+        dims[0] = engine->engine_1d->getN();
+        ndim = 1;
+    } else if (engine->engine_2d) {
+        nodes = &engine->engine_2d->getNodesMutable();
+        dims[0] = engine->engine_2d->getNy();
+        dims[1] = engine->engine_2d->getNx();
+        ndim = 2;
+    } else {
+        nodes = &engine->engine_3d->getNodesMutable();
+        dims[0] = engine->engine_3d->getNz();
+        dims[1] = engine->engine_3d->getNy();
+        dims[2] = engine->engine_3d->getNx();
+        ndim = 3;
+    }
+    const bool writable = field <= SATP_FIELD_H_DOT;
+    return dase::fillFieldView(view, fieldOf(nodes->front(), field), DASE_ELEMENT_FLOAT64, sizeof(double),
+                               sizeof(SATPHiggsNode), dims, ndim, writable);
+}
@@ -0,0 +1,126 @@
+/**
+ * SATP+Higgs C API
+ *
+ * C-compatible interface to the 1D, 2D and 3D SATP+Higgs engines for FFI
+ * consumers (Julia, Rust), which otherwise reach them only through the
+ * CLI's EngineManager.  Follows the pattern of igsoa_capi.h: an opaque
+ * handle, bool results, state read and written in place through field
+ * views (dase_field_view.h).
+ */
+
+#ifndef SATP_CAPI_H
+#define SATP_CAPI_H
+
+#ifdef _WIN32
+    #ifdef SATP_BUILD_DLL
+        #define SATP_API __declspec(dllexport)
+    #else
+        #define SATP_API __declspec(dllimport)
+    #endif
+#else
+    #define SATP_API
+#endif
+
+#include "dase_field_view.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Opaque pointer to a 1D, 2D or 3D SATPHiggsEngine
+ */
+typedef struct SATPEngine_C* SATPEngineHandle;
+
+/**
+ * Couplings (SATPHiggsParams; the Higgs VEV follows from mu_squared and
+ * lambda_h)
+ */
+typedef struct {
+    double c;            // Wave speed
+    double gamma_phi;    // φ dissipation
+    double gamma_h;      // h dissipation
+    double lambda;       // φ-h coupling
+    double mu_squared;   // Higgs mass² (negative for symmetry breaking)
+    double lambda_h;     // Higgs self-coupling
+} SATPParams;
+
+/**
+ * Per-node fields for satp_get_field_view
+ */
+typedef enum {
+    SATP_FIELD_PHI = 0,               // φ
+    SATP_FIELD_PHI_DOT = 1,           // ∂φ/∂t
+    SATP_FIELD_H = 2,                 // h
+    SATP_FIELD_H_DOT = 3,             // ∂h/∂t
+    SATP_FIELD_ENERGY_DENSITY = 4,    // Kinetic energy density (read-only)
+    SATP_FIELD_CONFORMAL_FACTOR = 5   // exp(φ) (read-only)
+} SATPField;
+
+/**
+ * Fill params with the engine defaults (c = 1, no damping, λ = 0.1,
+ * μ² = -1, λ_h = 0.5)
+ */
+SATP_API void satp_params_init(SATPParams* params);
+
+/**
+ * Create an engine on an N_x (x N_y (x N_z)) periodic lattice
+ *
+ * @param dims 1, 2 or 3 (unused trailing sizes are ignored)
+ * @param dx Lattice spacing
+ * @param dt Time step
+ * @param params Couplings (NULL = defaults)
+ * @return Handle (free with satp_destroy_engine), NULL on invalid sizes or
+ *         allocation failure
+ */
+SATP_API SATPEngineHandle satp_create_engine(
+    uint32_t dims,
+    size_t N_x,
+    size_t N_y,
+    size_t N_z,
+    double dx,
+    double dt,
+    const SATPParams* params
+);
+
+SATP_API void satp_destroy_engine(SATPEngineHandle engine);
+
+/**
+ * Lattice sizes (1 for the axes an engine does not have)
+ */
+SATP_API bool satp_get_dimensions(SATPEngineHandle engine, size_t* N_x, size_t* N_y, size_t* N_z);
+
+/**
+ * Advance the fields num_steps velocity Verlet steps
+ */
+SATP_API bool satp_evolve(SATPEngineHandle engine, uint64_t num_steps);
+
+SATP_API double satp_get_time(SATPEngineHandle engine);
+SATP_API uint64_t satp_get_step_count(SATPEngineHandle engine);
+
+/**
+ * Describe one field of every node in place (dase_field_view.h): dims
+ * (N_z, N_y, N_x) for a 3D engine, (N_y, N_x) for 2D, (N_x) for 1D,
+ * strided by the node struct size.  φ, φ̇, h, ḣ are writable; the derived
+ * fields are refreshed by steps only.  The engines double-buffer their
+ * nodes, so a view is invalid after the next satp_evolve: take a new one.
+ * A 3D engine running on a GPU downloads its fields first.
+ *
+ * @param view In: version = DASE_FIELD_VIEW_VERSION; out: the view
+ * @return false for a null handle or view, an unknown field or version
+ */
+SATP_API bool satp_get_field_view(
+    SATPEngineHandle engine,
+    SATPField field,
+    DaseFieldView* view
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SATP_CAPI_H
@@ -0,0 +1,83 @@
+/**
+ * SATP+Higgs Checkpoint Sections
+ *
+ * Shared by the 1D/2D/3D SATP+Higgs engines' saveCheckpoint /
+ * restoreCheckpoint (engine_checkpoint.h):
+ *
+ *   satp.nodes      SATPHiggsNode records (φ, φ̇, h, ḣ and derived values)
+ *   satp.params     SATPHiggsParams record
+ *   satp.dims       u64 [N_x, N_y, N_z]
+ *   satp.clock      f64 [current_time, dx, dt]
+ *   satp.counters   u64 [step_count, total_updates]
+ *
+ * Velocity Verlet recomputes a(t) at the start of every evolve call, so the
+ * acceleration scratch is not part of the state.  Sources are functions
+ * and are not saved: set them again after restoring.
+ */
+
+#pragma once
+
+#include "engine_checkpoint.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dase {
+namespace satp_higgs {
+
+struct SATPCheckpoint {
+    template <typename Node, typename Params>
+    static void save(CheckpointWriter& writer,
+                     const std::vector<Node>& nodes,
+                     const Params& params,
+                     uint64_t N_x, uint64_t N_y, uint64_t N_z,
+                     double dx, double dt, double current_time,
+                     uint64_t step_count, uint64_t total_updates) {
+        static_assert(std::is_trivially_copyable<Node>::value &&
+                      std::is_trivially_copyable<Params>::value,
+                      "SATP state is checkpointed as raw records");
+        writer.addRecords("satp.nodes", nodes);
+        writer.addRecord("satp.params", params);
+        writer.addValues("satp.dims", {N_x, N_y, N_z});
+        writer.addValues("satp.clock", {current_time, dx, dt});
+        writer.addValues("satp.counters", {step_count, total_updates});
+    }
+
+    /**
+     * @throws std::runtime_error on a lattice mismatch or a malformed image
+     */
+    template <typename Node, typename Params>
+    static void restore(const CheckpointImage& image,
+                        std::vector<Node>& nodes,
+                        Params& params,
+                        uint64_t N_x, uint64_t N_y, uint64_t N_z,
+                        double& dx, double& dt, double& current_time,
+                        uint64_t& step_count, uint64_t& total_updates) {
+        uint64_t dims[3] = {};
+        image.readU64("satp.dims", dims, 3);
+        if (dims[0] != N_x || dims[1] != N_y || dims[2] != N_z) {
+            throw std::runtime_error("Checkpoint lattice is " + std::to_string(dims[0]) + "x" +
+                                     std::to_string(dims[1]) + "x" + std::to_string(dims[2]) +
+                                     ", engine lattice differs");
+        }
+
+        double clock[3] = {};
+        uint64_t counters[2] = {};
+        image.readF64("satp.clock", clock, 3);
+        image.readU64("satp.counters", counters, 2);
+        const Params saved_params = image.readRecord<Params>("satp.params");
+        image.readRecords("satp.nodes", nodes);
+
+        params = saved_params;
+        current_time = clock[0];
+        dx = clock[1];
+        dt = clock[2];
+        step_count = counters[0];
+        total_updates = counters[1];
+    }
+};
+
+} // namespace satp_higgs
+} // namespace dase
@@ -12,11 +12,20 @@
 
 #pragma once
 
+#include "aligned_allocator.h"
+#include "circular_statistics.h"
+#include "engine_memory.h"
+#include "satp_higgs_checkpoint.h"
+#include "kernel_traffic.h"
+#include "reproducible_sum.h"
+
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <complex>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -79,6 +88,86 @@ struct SATPHiggsParams {
 // Source function callback type
 using SourceFunction = std::function<double(double t, double x, int index)>;
 
+// Batch source callback: fill out[0..num_points) with S(t, ·) in lattice
+// index order (one call per force evaluation instead of one per point)
+using BatchSourceFunction = std::function<void(double t, double* out, size_t num_points)>;
+
+// Time envelope g(t) of a separable source S(t, x) = g(t) · P(x)
+struct SATPSourceEnvelope {
+    enum class Shape {
+        Constant,       // g = 1
+        Sinusoid,       // g = sin(2π f t + phase)
+        GaussianPulse   // g = exp(-(t - t_center)² / 2 t_width²)
+    };
+
+    Shape shape;
+    double frequency;
+    double phase;
+    double t_center;
+    double t_width;
+    double t_start;    // Source off before t_start
+    double t_end;      // Source off after t_end (-1 = never stop)
+
+    SATPSourceEnvelope()
+        : shape(Shape::Constant), frequency(0.0), phase(0.0),
+          t_center(0.0), t_width(1.0), t_start(0.0), t_end(-1.0) {}
+
+    double operator()(double t) const {
+        if (t < t_start) return 0.0;
+        if (t_end > 0.0 && t > t_end) return 0.0;
+        switch (shape) {
+            case Shape::Sinusoid:
+                return std::sin(2.0 * M_PI * frequency * t + phase);
+            case Shape::GaussianPulse: {
+                const double u = (t - t_center) / t_width;
+                return std::exp(-0.5 * u * u);
+            }
+            case Shape::Constant:
+            default:
+                return 1.0;
+        }
+    }
+};
+
+// How the engine obtains the φ source term
+enum class SATPSourceKind {
+    None,
+    PointWise,  // SourceFunction called per lattice point
+    Batch,      // BatchSourceFunction fills the whole field
+    Separable   // Precomputed spatial profile × SATPSourceEnvelope
+};
+
+// Bytes / FLOPs model of one velocity Verlet step (see kernel_traffic.h):
+// drift pass, one force evaluation (2·dims+1 point Laplacian of φ and h,
+// neighbours from cache) and kick pass.  `cell_bytes` is the state a pass
+// moves per cell: the whole SATPHiggsNode on the AoS paths, the four SoA
+// fields on the 3D tiled path (which also skips the per-step derived
+// update and always reads its source buffer).  PointWise source calls are
+// opaque and not counted.
+inline KernelTraffic satpStepTraffic(size_t cells, int dims, double cell_bytes,
+                                     SATPSourceKind source, bool tiled) {
+    const double n = static_cast<double>(cells);
+    const double value = static_cast<double>(sizeof(double));
+    const double accel = 2.0 * value;
+    const bool source_field = tiled || source == SATPSourceKind::Batch || source == SATPSourceKind::Separable;
+
+    KernelTraffic step;
+    step += kernelPass(n, cell_bytes + accel, cell_bytes, 18.0);
+    if (source == SATPSourceKind::Separable) {
+        step += kernelPass(n, value, value, 1.0);
+    } else if (source == SATPSourceKind::Batch) {
+        step += kernelPass(n, 0.0, value, 0.0);
+    }
+    step += kernelPass(n, cell_bytes + (source_field ? value : 0.0), accel,
+                       2.0 * (2.0 * dims + 3.0) + 27.0);
+    if (tiled) {
+        step += kernelPass(n, 2.0 * value + accel, 2.0 * value + accel, 10.0);
+    } else {
+        step += kernelPass(n, cell_bytes + accel, cell_bytes + accel, 15.0);
+    }
+    return step;
+}
+
 class SATPHiggsEngine1D {
 private:
     // Lattice configuration
@@ -90,17 +179,57 @@ private:
     std::vector<SATPHiggsNode> nodes;
     std::vector<SATPHiggsNode> nodes_temp;  // Temporary storage for updates
 
+    // Velocity Verlet scratch (64-byte aligned, sized at construction).
+    // Holds a(t) on entry to each step and a(t+dt) after it.
+    using ScratchArray = std::vector<double, aligned_allocator<double, 64>>;
+    ScratchArray phi_accel;
+    ScratchArray h_accel;
+
     // Physics parameters
     SATPHiggsParams params;
 
     // Source term
     SourceFunction source_phi;  // External source for φ field
     bool has_source;
+    SATPSourceKind source_kind;
+    BatchSourceFunction batch_source;
+    SATPSourceEnvelope source_envelope;
+    ScratchArray source_profile;  // P(x) of a Separable source
+    ScratchArray source_buf;      // S(t, ·) for the current force evaluation
 
     // Simulation state
     double current_time;
     uint64_t step_count;
 
+    // Centre-of-mass angle table
+    CircularAxis com_axis;
+
+    // Fill source_buf with S(t, ·) for Batch / Separable sources; returns
+    // nullptr for PointWise / None (the caller evaluates those per point)
+    const double* prepareSourceField(double t) {
+        switch (source_kind) {
+            case SATPSourceKind::Batch:
+                batch_source(t, source_buf.data(), source_buf.size());
+                return source_buf.data();
+            case SATPSourceKind::Separable: {
+                const double g = source_envelope(t);
+                const double* profile = source_profile.data();
+                double* out = source_buf.data();
+                const size_t n = source_buf.size();
+                for (size_t i = 0; i < n; ++i) {
+                    out[i] = g * profile[i];
+                }
+                return out;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    // Accelerations of a state at time t into phi_accel / h_accel
+    // (implemented in the matching satp_higgs_physics header)
+    void computeAccelerations(const std::vector<SATPHiggsNode>& state, double t);
+
     // Thread safety
     mutable std::mutex state_mutex;
     std::atomic<bool> is_running;
@@ -108,13 +237,24 @@ private:
     // Diagnostics
     std::atomic<uint64_t> total_updates;
 
+    // Wall time of the last evolve call (roofline rates)
+    uint64_t last_evolve_steps = 0;
+    double last_evolve_seconds = 0.0;
+
+    void recordEvolve(size_t num_steps, std::chrono::steady_clock::time_point start) {
+        last_evolve_steps = num_steps;
+        last_evolve_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
 public:
     SATPHiggsEngine1D(size_t num_nodes, double spatial_step, double time_step,
                       const SATPHiggsParams& physics_params)
         : N(num_nodes), dx(spatial_step), dt(time_step),
           nodes(num_nodes), nodes_temp(num_nodes),
-          params(physics_params), has_source(false),
+          phi_accel(num_nodes), h_accel(num_nodes),
+          params(physics_params), has_source(false), source_kind(SATPSourceKind::None),
           current_time(0.0), step_count(0),
+          com_axis(num_nodes),
           is_running(false), total_updates(0) {
 
         params.updateVEV();
@@ -130,22 +270,70 @@ public:
     size_t getN() const { return N; }
     double getDx() const { return dx; }
     double getDt() const { return dt; }
+    // Step used by the next evolve call (satp_higgs_adaptive.h); not while evolving
+    void setDt(double time_step) { dt = time_step; }
     double getTime() const { return current_time; }
     uint64_t getStepCount() const { return step_count; }
     uint64_t getTotalUpdates() const { return total_updates.load(std::memory_order_relaxed); }
     const SATPHiggsParams& getParams() const { return params; }
+    // Couplings used by the next evolve call; reset() re-seeds h at their VEV
+    void setParams(const SATPHiggsParams& p) { params = p; }
     const std::vector<SATPHiggsNode>& getNodes() const { return nodes; }
     std::vector<SATPHiggsNode>& getNodesMutable() { return nodes; }
 
+    // Bytes held by the node fields (state) and the Verlet, source
+    // buffers (scratch)
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint bytes;
+        bytes.state = capacityBytes(nodes);
+        bytes.scratch = capacityBytes(nodes_temp) + capacityBytes(phi_accel) + capacityBytes(h_accel) +
+                        capacityBytes(source_profile) + capacityBytes(source_buf);
+        return bytes;
+    }
+
+    // memoryFootprint() of a new engine (Reference stepping, no source)
+    static MemoryFootprint estimateMemory(size_t num_nodes) {
+        const uint64_t n = num_nodes;
+        MemoryFootprint bytes;
+        bytes.state = n * sizeof(SATPHiggsNode);
+        bytes.scratch = n * (sizeof(SATPHiggsNode) + 2 * sizeof(double));
+        return bytes;
+    }
+
     // Source term management
     void setSource(SourceFunction func) {
         source_phi = func;
         has_source = true;
+        source_kind = SATPSourceKind::PointWise;
     }
 
+    // Batch source: func fills S(t, ·) for all getN() points per force evaluation
+    void setBatchSource(BatchSourceFunction func) {
+        batch_source = std::move(func);
+        source_buf.resize(getN());
+        has_source = true;
+        source_kind = SATPSourceKind::Batch;
+    }
+
+    // Separable source S(t, ·) = envelope(t) · profile[index]
+    // Returns false (source unchanged) if profile.size() != getN()
+    bool setSeparableSource(const std::vector<double>& profile, const SATPSourceEnvelope& envelope) {
+        if (profile.size() != getN()) return false;
+        source_profile.assign(profile.begin(), profile.end());
+        source_envelope = envelope;
+        source_buf.resize(getN());
+        has_source = true;
+        source_kind = SATPSourceKind::Separable;
+        return true;
+    }
+
+    SATPSourceKind getSourceKind() const { return source_kind; }
+
     void clearSource() {
         has_source = false;
+        source_kind = SATPSourceKind::None;
         source_phi = nullptr;
+        batch_source = nullptr;
     }
 
     // State management
@@ -163,9 +351,32 @@ public:
         }
     }
 
+    // Checkpoint sections (satp_higgs_checkpoint.h); the engine must not
+    // evolve until writer.write() returns
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        SATPCheckpoint::save(writer, nodes, params, N, 1, 1, dx, dt, current_time,
+                             step_count, total_updates.load(std::memory_order_relaxed));
+    }
+
+    // @throws std::runtime_error if the image does not fit this lattice
+    void restoreCheckpoint(const CheckpointImage& image) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        uint64_t updates = 0;
+        SATPCheckpoint::restore(image, nodes, params, N, 1, 1, dx, dt, current_time,
+                                step_count, updates);
+        total_updates.store(updates);
+    }
+
     // Physics evolution (implemented in satp_higgs_physics_1d.h)
     void evolve(size_t num_steps);
 
+    // Modelled bytes / FLOPs per step (satpStepTraffic) and the rates the
+    // last evolve call achieved
+    KernelRoofline getRoofline() const {
+        return kernelRoofline(satpStepTraffic(getN(), 1, static_cast<double>(sizeof(SATPHiggsNode)), source_kind, false),
+                              last_evolve_steps, last_evolve_seconds);
+    }
+
     // Metrics helper
     void getMetrics(double& ns_per_op, double& ops_per_sec, uint64_t& total_operations) const {
         total_operations = total_updates.load(std::memory_order_relaxed);
@@ -179,10 +390,10 @@ public:
         }
     }
 
-    // Diagnostics
+    // Diagnostics (reproducible_sum.h: bit-identical for any thread count)
     double computeTotalEnergy() const {
-        double total_E = 0.0;
-        for (size_t i = 0; i < N; ++i) {
+        return reproducibleSum(static_cast<int64_t>(N), [this](int64_t idx) {
+            const size_t i = static_cast<size_t>(idx);
             const auto& node = nodes[i];
 
             // Kinetic energy
@@ -202,46 +413,43 @@ public:
             // Coupling energy
             double V_coupling = params.lambda * node.phi * node.phi * h_val * h_val;
 
-            total_E += (E_kin + E_grad + V_higgs + V_coupling) * dx;
-        }
-        return total_E;
+            return (E_kin + E_grad + V_higgs + V_coupling) * dx;
+        });
     }
 
     double computePhiRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            sum += node.phi * node.phi;
-        }
+        const double sum = reproducibleSum(static_cast<int64_t>(N), [this](int64_t i) {
+            const double phi = nodes[static_cast<size_t>(i)].phi;
+            return phi * phi;
+        });
         return std::sqrt(sum / static_cast<double>(N));
     }
 
     double computeHiggsRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            double h_deviation = node.h - params.h_vev;
-            sum += h_deviation * h_deviation;
-        }
+        const double sum = reproducibleSum(static_cast<int64_t>(N), [this](int64_t i) {
+            const double h_deviation = nodes[static_cast<size_t>(i)].h - params.h_vev;
+            return h_deviation * h_deviation;
+        });
         return std::sqrt(sum / static_cast<double>(N));
     }
 
     void getCenterOfMass(double& x_cm_phi, double& x_cm_h) const {
         // Use circular statistics for toroidal topology
-        double sum_phi = 0.0, sum_cos_phi = 0.0, sum_sin_phi = 0.0;
-        double sum_h = 0.0, sum_cos_h = 0.0, sum_sin_h = 0.0;
-
-        for (size_t i = 0; i < N; ++i) {
-            double theta = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(N);
-            double weight_phi = std::abs(nodes[i].phi);
-            double weight_h = std::abs(nodes[i].h - params.h_vev);
-
-            sum_phi += weight_phi;
-            sum_cos_phi += weight_phi * std::cos(theta);
-            sum_sin_phi += weight_phi * std::sin(theta);
-
-            sum_h += weight_h;
-            sum_cos_h += weight_h * std::cos(theta);
-            sum_sin_h += weight_h * std::sin(theta);
-        }
+        const double* cos_theta = com_axis.cos_theta.data();
+        const double* sin_theta = com_axis.sin_theta.data();
+        const auto sums = reproducibleSums<6>(static_cast<int64_t>(N), [&](int64_t i, double* acc) {
+            const size_t k = static_cast<size_t>(i);
+            const double weight_phi = std::abs(nodes[k].phi);
+            const double weight_h = std::abs(nodes[k].h - params.h_vev);
+            acc[0] += weight_phi;
+            acc[1] += weight_phi * cos_theta[k];
+            acc[2] += weight_phi * sin_theta[k];
+            acc[3] += weight_h;
+            acc[4] += weight_h * cos_theta[k];
+            acc[5] += weight_h * sin_theta[k];
+        });
+        const double sum_phi = sums[0], sum_cos_phi = sums[1], sum_sin_phi = sums[2];
+        const double sum_h = sums[3], sum_cos_h = sums[4], sum_sin_h = sums[5];
 
         if (sum_phi > 1e-12) {
             double mean_theta_phi = std::atan2(sum_sin_phi, sum_cos_phi);
@@ -12,8 +12,18 @@
 
 #pragma once
 
+#include "aligned_allocator.h"
+#include "circular_statistics.h"
+#include "engine_memory.h"
+#include "satp_higgs_checkpoint.h"
+#include "kernel_traffic.h"
+#include "reproducible_sum.h"
+#include "satp_higgs_spectral.h"
+#include "satp_higgs_temporal_blocking.h"
+
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <complex>
 #include <cstdint>
@@ -46,17 +56,76 @@ private:
     std::vector<SATPHiggsNode> nodes;
     std::vector<SATPHiggsNode> nodes_temp;
 
+    // Velocity Verlet scratch (64-byte aligned, sized at construction).
+    // Holds a(t) on entry to each step and a(t+dt) after it.
+    using ScratchArray = std::vector<double, aligned_allocator<double, 64>>;
+    ScratchArray phi_accel;
+    ScratchArray h_accel;
+
     // Physics parameters
     SATPHiggsParams params;
 
     // Source term
     SourceFunction2D source_phi;
     bool has_source;
+    SATPSourceKind source_kind;
+    BatchSourceFunction batch_source;
+    SATPSourceEnvelope source_envelope;
+    ScratchArray source_profile;  // P(x) of a Separable source
+    ScratchArray source_buf;      // S(t, ·) for the current force evaluation
 
     // Simulation state
     double current_time;
     uint64_t step_count;
 
+    // Centre-of-mass angle tables per axis
+    CircularAxis com_axis_x;
+    CircularAxis com_axis_y;
+
+    // Fill source_buf with S(t, ·) for Batch / Separable sources; returns
+    // nullptr for PointWise / None (the caller evaluates those per point)
+    const double* prepareSourceField(double t) {
+        switch (source_kind) {
+            case SATPSourceKind::Batch:
+                batch_source(t, source_buf.data(), source_buf.size());
+                return source_buf.data();
+            case SATPSourceKind::Separable: {
+                const double g = source_envelope(t);
+                const double* profile = source_profile.data();
+                double* out = source_buf.data();
+                const size_t n = source_buf.size();
+                for (size_t i = 0; i < n; ++i) {
+                    out[i] = g * profile[i];
+                }
+                return out;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    // Accelerations of a state at time t into phi_accel / h_accel
+    // (implemented in the matching satp_higgs_physics header)
+    void computeAccelerations(const std::vector<SATPHiggsNode>& state, double t);
+
+    // Temporal blocking (satp_higgs_temporal_blocking.h; buffers allocated
+    // on the first blocked evolve)
+    size_t temporal_block_steps = 1;
+    bool last_evolve_blocked = false;
+    SATPTemporalBlocking blocking;
+
+    // Blocked evolve (implemented in satp_higgs_physics_2d.h)
+    void evolveBlocked(size_t num_steps);
+
+    // Pseudo-spectral path (satp_higgs_spectral.h; plans built by
+    // setLaplacianMode)
+    SATPLaplacianMode laplacian_mode = SATPLaplacianMode::FiniteDifference;
+    bool last_evolve_spectral = false;
+    SATPSpectralSolver spectral;
+
+    // Spectral evolve (implemented in satp_higgs_physics_2d.h)
+    void evolveSpectral(size_t num_steps);
+
     // Thread safety
     mutable std::mutex state_mutex;
     std::atomic<bool> is_running;
@@ -64,13 +133,24 @@ private:
     // Diagnostics
     std::atomic<uint64_t> total_updates;
 
+    // Wall time of the last evolve call (roofline rates)
+    uint64_t last_evolve_steps = 0;
+    double last_evolve_seconds = 0.0;
+
+    void recordEvolve(size_t num_steps, std::chrono::steady_clock::time_point start) {
+        last_evolve_steps = num_steps;
+        last_evolve_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
 public:
     SATPHiggsEngine2D(size_t nx, size_t ny, double spatial_step, double time_step,
                       const SATPHiggsParams& physics_params)
         : N_x(nx), N_y(ny), dx(spatial_step), dt(time_step),
           nodes(nx * ny), nodes_temp(nx * ny),
-          params(physics_params), has_source(false),
+          phi_accel(nx * ny), h_accel(nx * ny),
+          params(physics_params), has_source(false), source_kind(SATPSourceKind::None),
           current_time(0.0), step_count(0),
+          com_axis_x(nx), com_axis_y(ny),
           is_running(false), total_updates(0) {
 
         params.updateVEV();
@@ -88,13 +168,37 @@ public:
     size_t getN() const { return N_x * N_y; }
     double getDx() const { return dx; }
     double getDt() const { return dt; }
+    // Step used by the next evolve call (satp_higgs_adaptive.h); not while evolving
+    void setDt(double time_step) { dt = time_step; }
     double getTime() const { return current_time; }
     uint64_t getStepCount() const { return step_count; }
     uint64_t getTotalUpdates() const { return total_updates.load(std::memory_order_relaxed); }
     const SATPHiggsParams& getParams() const { return params; }
+    // Couplings used by the next evolve call; reset() re-seeds h at their VEV
+    void setParams(const SATPHiggsParams& p) { params = p; }
     const std::vector<SATPHiggsNode>& getNodes() const { return nodes; }
     std::vector<SATPHiggsNode>& getNodesMutable() { return nodes; }
 
+    // Bytes held by the node fields (state) and the Verlet, source, temporal-blocking
+    // and spectral buffers (scratch)
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint bytes;
+        bytes.state = capacityBytes(nodes);
+        bytes.scratch = capacityBytes(nodes_temp) + capacityBytes(phi_accel) + capacityBytes(h_accel) +
+                        capacityBytes(source_profile) + capacityBytes(source_buf);
+        bytes.scratch += blocking.memoryBytes() + spectral.memoryBytes();
+        return bytes;
+    }
+
+    // memoryFootprint() of a new engine (Reference stepping, no source)
+    static MemoryFootprint estimateMemory(size_t nx, size_t ny) {
+        const uint64_t n = nx * ny;
+        MemoryFootprint bytes;
+        bytes.state = n * sizeof(SATPHiggsNode);
+        bytes.scratch = n * (sizeof(SATPHiggsNode) + 2 * sizeof(double));
+        return bytes;
+    }
+
     // Index conversion
     size_t getIndex(size_t x, size_t y) const {
         return y * N_x + x;
@@ -109,11 +213,36 @@ public:
     void setSource(SourceFunction2D func) {
         source_phi = func;
         has_source = true;
+        source_kind = SATPSourceKind::PointWise;
+    }
+
+    // Batch source: func fills S(t, ·) for all getN() points per force evaluation
+    void setBatchSource(BatchSourceFunction func) {
+        batch_source = std::move(func);
+        source_buf.resize(getN());
+        has_source = true;
+        source_kind = SATPSourceKind::Batch;
     }
 
+    // Separable source S(t, ·) = envelope(t) · profile[index]
+    // Returns false (source unchanged) if profile.size() != getN()
+    bool setSeparableSource(const std::vector<double>& profile, const SATPSourceEnvelope& envelope) {
+        if (profile.size() != getN()) return false;
+        source_profile.assign(profile.begin(), profile.end());
+        source_envelope = envelope;
+        source_buf.resize(getN());
+        has_source = true;
+        source_kind = SATPSourceKind::Separable;
+        return true;
+    }
+
+    SATPSourceKind getSourceKind() const { return source_kind; }
+
     void clearSource() {
         has_source = false;
+        source_kind = SATPSourceKind::None;
         source_phi = nullptr;
+        batch_source = nullptr;
     }
 
     // State management
@@ -131,9 +260,64 @@ public:
         }
     }
 
+    // Checkpoint sections (satp_higgs_checkpoint.h); the engine must not
+    // evolve until writer.write() returns
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        SATPCheckpoint::save(writer, nodes, params, N_x, N_y, 1, dx, dt, current_time,
+                             step_count, total_updates.load(std::memory_order_relaxed));
+    }
+
+    // @throws std::runtime_error if the image does not fit this lattice
+    void restoreCheckpoint(const CheckpointImage& image) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        uint64_t updates = 0;
+        SATPCheckpoint::restore(image, nodes, params, N_x, N_y, 1, dx, dt, current_time,
+                                step_count, updates);
+        total_updates.store(updates);
+    }
+
+    // Steps advanced per pass over the lattice on space-time tiles (<= 1 =
+    // off).  Applies with no source or a Separable source; other sources
+    // keep the per-step path.  Results match the per-step path.
+    void setTemporalBlockSteps(size_t steps) { temporal_block_steps = steps; }
+    size_t getTemporalBlockSteps() const { return temporal_block_steps; }
+
+    /**
+     * Laplacian discretisation (satp_higgs_spectral.h; FiniteDifference by
+     * default).  Spectral modes take precedence over temporal blocking and
+     * accept every source kind.
+     *
+     * @return false (mode unchanged) if a spectral mode is requested and no
+     *         FFT backend is available
+     */
+    bool setLaplacianMode(SATPLaplacianMode mode) {
+        if (mode != SATPLaplacianMode::FiniteDifference && !spectral.configure(N_x, N_y, 1, dx)) {
+            return false;
+        }
+        laplacian_mode = mode;
+        return true;
+    }
+    SATPLaplacianMode getLaplacianMode() const { return laplacian_mode; }
+
     // Physics evolution (implemented in satp_higgs_physics_2d.h)
     void evolve(size_t num_steps);
 
+    // Modelled bytes / FLOPs per step (satpStepTraffic) and the rates the
+    // last evolve call achieved
+    KernelRoofline getRoofline() const {
+        if (last_evolve_spectral) {
+            return kernelRoofline(satpSpectralStepTraffic(getN(), laplacian_mode, source_kind),
+                                  last_evolve_steps, last_evolve_seconds);
+        }
+        if (last_evolve_blocked) {
+            return kernelRoofline(satpBlockedStepTraffic(getN(), 2, source_kind, temporal_block_steps,
+                                                         blocking.lastOverlap()),
+                                  last_evolve_steps, last_evolve_seconds);
+        }
+        return kernelRoofline(satpStepTraffic(getN(), 2, static_cast<double>(sizeof(SATPHiggsNode)), source_kind, false),
+                              last_evolve_steps, last_evolve_seconds);
+    }
+
     // Metrics helper
     void getMetrics(double& ns_per_op, double& ops_per_sec, uint64_t& total_operations) const {
         total_operations = total_updates.load(std::memory_order_relaxed);
@@ -147,97 +331,71 @@ public:
         }
     }
 
-    // Diagnostics
+    // Diagnostics (reproducible_sum.h: bit-identical for any thread count)
     double computeTotalEnergy() const {
-        double total_E = 0.0;
         const double dx_sq = dx * dx;  // Area element
 
-        for (size_t y = 0; y < N_y; ++y) {
-            for (size_t x = 0; x < N_x; ++x) {
-                size_t idx = getIndex(x, y);
-                const auto& node = nodes[idx];
-
-                // Kinetic energy
-                double E_kin = 0.5 * (node.phi_dot * node.phi_dot + node.h_dot * node.h_dot);
-
-                // Gradient energy (2D finite difference)
-                size_t x_next = (x + 1) % N_x;
-                size_t y_next = (y + 1) % N_y;
-                size_t idx_xnext = getIndex(x_next, y);
-                size_t idx_ynext = getIndex(x, y_next);
-
-                double dphi_dx = (nodes[idx_xnext].phi - node.phi) / dx;
-                double dphi_dy = (nodes[idx_ynext].phi - node.phi) / dx;
-                double dh_dx = (nodes[idx_xnext].h - node.h) / dx;
-                double dh_dy = (nodes[idx_ynext].h - node.h) / dx;
-
-                double E_grad = 0.5 * params.c * params.c * (
-                    dphi_dx * dphi_dx + dphi_dy * dphi_dy +
-                    dh_dx * dh_dx + dh_dy * dh_dy
-                );
-
-                // Higgs potential
-                double h_val = node.h;
-                double V_higgs = params.mu_squared * h_val * h_val
-                               + params.lambda_h * h_val * h_val * h_val * h_val;
-
-                // Coupling energy
-                double V_coupling = params.lambda * node.phi * node.phi * h_val * h_val;
-
-                total_E += (E_kin + E_grad + V_higgs + V_coupling) * dx_sq;
-            }
-        }
-        return total_E;
+        return reproducibleSum(static_cast<int64_t>(N_x * N_y), [&](int64_t i) {
+            const size_t idx = static_cast<size_t>(i);
+            const size_t x = idx % N_x;
+            const size_t y = idx / N_x;
+            const auto& node = nodes[idx];
+
+            // Kinetic energy
+            double E_kin = 0.5 * (node.phi_dot * node.phi_dot + node.h_dot * node.h_dot);
+
+            // Gradient energy (2D finite difference)
+            size_t x_next = (x + 1) % N_x;
+            size_t y_next = (y + 1) % N_y;
+            size_t idx_xnext = getIndex(x_next, y);
+            size_t idx_ynext = getIndex(x, y_next);
+
+            double dphi_dx = (nodes[idx_xnext].phi - node.phi) / dx;
+            double dphi_dy = (nodes[idx_ynext].phi - node.phi) / dx;
+            double dh_dx = (nodes[idx_xnext].h - node.h) / dx;
+            double dh_dy = (nodes[idx_ynext].h - node.h) / dx;
+
+            double E_grad = 0.5 * params.c * params.c * (
+                dphi_dx * dphi_dx + dphi_dy * dphi_dy +
+                dh_dx * dh_dx + dh_dy * dh_dy
+            );
+
+            // Higgs potential
+            double h_val = node.h;
+            double V_higgs = params.mu_squared * h_val * h_val
+                           + params.lambda_h * h_val * h_val * h_val * h_val;
+
+            // Coupling energy
+            double V_coupling = params.lambda * node.phi * node.phi * h_val * h_val;
+
+            return (E_kin + E_grad + V_higgs + V_coupling) * dx_sq;
+        });
     }
 
     double computePhiRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            sum += node.phi * node.phi;
-        }
+        const double sum = reproducibleSum(static_cast<int64_t>(nodes.size()), [this](int64_t i) {
+            const double phi = nodes[static_cast<size_t>(i)].phi;
+            return phi * phi;
+        });
         return std::sqrt(sum / static_cast<double>(nodes.size()));
     }
 
     double computeHiggsRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            double h_deviation = node.h - params.h_vev;
-            sum += h_deviation * h_deviation;
-        }
+        const double sum = reproducibleSum(static_cast<int64_t>(nodes.size()), [this](int64_t i) {
+            const double h_deviation = nodes[static_cast<size_t>(i)].h - params.h_vev;
+            return h_deviation * h_deviation;
+        });
         return std::sqrt(sum / static_cast<double>(nodes.size()));
     }
 
     void getCenterOfMass(double& x_cm, double& y_cm) const {
         // Use circular statistics for toroidal topology
-        double sum_phi = 0.0;
-        double sum_cos_x = 0.0, sum_sin_x = 0.0;
-        double sum_cos_y = 0.0, sum_sin_y = 0.0;
-
-        for (size_t y = 0; y < N_y; ++y) {
-            for (size_t x = 0; x < N_x; ++x) {
-                size_t idx = getIndex(x, y);
-                double weight = std::abs(nodes[idx].phi);
-
-                double theta_x = 2.0 * M_PI * static_cast<double>(x) / static_cast<double>(N_x);
-                double theta_y = 2.0 * M_PI * static_cast<double>(y) / static_cast<double>(N_y);
-
-                sum_phi += weight;
-                sum_cos_x += weight * std::cos(theta_x);
-                sum_sin_x += weight * std::sin(theta_x);
-                sum_cos_y += weight * std::cos(theta_y);
-                sum_sin_y += weight * std::sin(theta_y);
-            }
-        }
-
-        if (sum_phi > 1e-12) {
-            double mean_theta_x = std::atan2(sum_sin_x, sum_cos_x);
-            double mean_theta_y = std::atan2(sum_sin_y, sum_cos_y);
-
-            x_cm = static_cast<double>(N_x) * mean_theta_x / (2.0 * M_PI);
-            y_cm = static_cast<double>(N_y) * mean_theta_y / (2.0 * M_PI);
+        const CircularTotals totals = circularTotals(com_axis_x, com_axis_y, circularUnitAxis(), 0, 1,
+                                                     [this](size_t i) { return std::abs(nodes[i].phi); });
 
-            if (x_cm < 0.0) x_cm += static_cast<double>(N_x);
-            if (y_cm < 0.0) y_cm += static_cast<double>(N_y);
+        if (totals.weight > 1e-12) {
+            x_cm = circularMean(totals.sum_cos[0], totals.sum_sin[0], N_x);
+            y_cm = circularMean(totals.sum_cos[1], totals.sum_sin[1], N_y);
         } else {
             x_cm = 0.0;
             y_cm = 0.0;
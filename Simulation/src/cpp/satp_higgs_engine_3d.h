@@ -8,12 +8,29 @@
  * Physics:
  * ∂²φ/∂t² = c²∇²φ - γ_φ ∂φ/∂t - 2λφh² + S(t,x,y,z)
  * ∂²h/∂t² = c²∇²h - γ_h ∂h/∂t - 2μ²h - 4λ_h h³ - 2λφ²h
+ *
+ * With setDevice(ComputeDevice::GPU) the fields stay in device memory
+ * across evolve calls (satp_higgs_gpu_backend_3d.h); host reads download
+ * them on demand and host edits re-upload them before the next evolve.
  */
 
 #pragma once
 
+#include "aligned_allocator.h"
+#include "circular_statistics.h"
+#include "engine_memory.h"
+#include "satp_higgs_checkpoint.h"
+#include "satp_higgs_spectral.h"
+#include "kernel_traffic.h"
+#include "reproducible_sum.h"
+#include "lattice_layout_3d.h"
+#include "halo_layout.h"
+#include "satp_higgs_temporal_blocking.h"
+#include "satp_higgs_gpu_backend_3d.h"
+
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <complex>
 #include <cstdint>
@@ -36,6 +53,14 @@ struct SATPHiggsParams;
 // 3D source function: S(t, x, y, z, ix, iy, iz)
 using SourceFunction3D = std::function<double(double t, double x, double y, double z, int ix, int iy, int iz)>;
 
+// Laplacian/evolve implementation selector
+enum class SATPStencilMode {
+    Reference,  // AoS nodes, per-cell periodic wrap (original path)
+    Tiled,      // SoA fields, row tiles in parallel, wrap only at row ends
+    Bricked,    // SoA fields in B³ bricks (lattice_layout_3d.h), bricks in parallel
+    Padded      // SoA fields with 1-wide periodic ghost layers (halo_layout.h), no wrap at all
+};
+
 class SATPHiggsEngine3D {
 private:
     // Lattice configuration
@@ -43,21 +68,126 @@ private:
     double dx;               // Spatial step size
     double dt;               // Time step size
 
-    // Field storage (flattened 3D array: index = z * N_x * N_y + y * N_x + x)
-    std::vector<SATPHiggsNode> nodes;
+    // Field storage (flattened 3D array: index = z * N_x * N_y + y * N_x + x);
+    // mutable: host reads refresh it from the device
+    mutable std::vector<SATPHiggsNode> nodes;
     std::vector<SATPHiggsNode> nodes_temp;
 
+    // Velocity Verlet scratch (64-byte aligned, sized at construction).
+    // Holds a(t) on entry to each step and a(t+dt) after it.
+    using ScratchArray = std::vector<double, aligned_allocator<double, 64>>;
+    ScratchArray phi_accel;
+    ScratchArray h_accel;
+
+    // Tiled / Bricked / Padded paths: SoA field mirror (gathered/scattered
+    // once per evolve call), allocated on first use; Bricked stores it (and
+    // a(t)) in brick_layout order, Padded in halo_layout order
+    SATPStencilMode stencil_mode;
+    BrickLayout3D brick_layout;
+    HaloLayout3D halo_layout;
+    ScratchArray soa_phi;
+    ScratchArray soa_phi_dot;
+    ScratchArray soa_h;
+    ScratchArray soa_h_dot;
+
     // Physics parameters
     SATPHiggsParams params;
 
     // Source term
     SourceFunction3D source_phi;
     bool has_source;
+    SATPSourceKind source_kind;
+    BatchSourceFunction batch_source;
+    SATPSourceEnvelope source_envelope;
+    ScratchArray source_profile;  // P(x) of a Separable source
+    ScratchArray source_buf;      // S(t, ·) for the current force evaluation
 
     // Simulation state
     double current_time;
     uint64_t step_count;
 
+    // Centre-of-mass angle tables per axis
+    CircularAxis com_axis_x;
+    CircularAxis com_axis_y;
+    CircularAxis com_axis_z;
+
+    // Fill source_buf with S(t, ·) for Batch / Separable sources; returns
+    // nullptr for PointWise / None (the caller evaluates those per point)
+    const double* prepareSourceField(double t) {
+        switch (source_kind) {
+            case SATPSourceKind::Batch:
+                batch_source(t, source_buf.data(), source_buf.size());
+                return source_buf.data();
+            case SATPSourceKind::Separable: {
+                const double g = source_envelope(t);
+                const double* profile = source_profile.data();
+                double* out = source_buf.data();
+                const size_t n = source_buf.size();
+                for (size_t i = 0; i < n; ++i) {
+                    out[i] = g * profile[i];
+                }
+                return out;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    // Accelerations of a state at time t into phi_accel / h_accel
+    // (implemented in the matching satp_higgs_physics header)
+    void computeAccelerations(const std::vector<SATPHiggsNode>& state, double t);
+
+    // Temporal blocking (satp_higgs_temporal_blocking.h; buffers allocated
+    // on the first blocked evolve)
+    size_t temporal_block_steps = 1;
+    bool last_evolve_blocked = false;
+    SATPTemporalBlocking blocking;
+
+    // Blocked evolve (implemented in satp_higgs_physics_3d.h)
+    void evolveBlocked(size_t num_steps);
+
+    // Pseudo-spectral path (satp_higgs_spectral.h; plans built by
+    // setLaplacianMode)
+    SATPLaplacianMode laplacian_mode = SATPLaplacianMode::FiniteDifference;
+    bool last_evolve_spectral = false;
+    SATPSpectralSolver spectral;
+
+    // Spectral evolve (implemented in satp_higgs_physics_3d.h)
+    void evolveSpectral(size_t num_steps);
+
+    // Device residency (satp_higgs_gpu_backend_3d.h): device_current while
+    // the device copy is valid, host_stale while it is newer than nodes
+    ComputeDevice device = ComputeDevice::CPU;
+    mutable SATPHiggsGpuBackend3D gpu;
+    mutable bool host_stale = false;
+    bool device_current = false;
+    bool last_evolve_device = false;
+
+    // Download the fields if the device holds newer ones
+    void syncHost() const {
+        if (host_stale) {
+            gpu.download(nodes);
+            host_stale = false;
+        }
+    }
+
+    // Host copy (or the source profile) is about to change
+    void invalidateDevice() {
+        syncHost();
+        device_current = false;
+    }
+
+    // Device evolve (implemented in satp_higgs_physics_3d.h); false if this
+    // call cannot run on the device
+    bool evolveDevice(size_t num_steps);
+
+    // Tiled / Bricked paths (implemented in satp_higgs_physics_3d.h)
+    void evolveTiled(size_t num_steps);
+    void computeAccelerationsTiled(double t);
+    void computeAccelerationsBricked(double t);
+    void computeAccelerationsPadded(double t);
+    void fillSourceBuffer(double t);
+
     // Thread safety
     mutable std::mutex state_mutex;
     std::atomic<bool> is_running;
@@ -65,13 +195,25 @@ private:
     // Diagnostics
     std::atomic<uint64_t> total_updates;
 
+    // Wall time of the last evolve call (roofline rates)
+    uint64_t last_evolve_steps = 0;
+    double last_evolve_seconds = 0.0;
+
+    void recordEvolve(size_t num_steps, std::chrono::steady_clock::time_point start) {
+        last_evolve_steps = num_steps;
+        last_evolve_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
 public:
     SATPHiggsEngine3D(size_t nx, size_t ny, size_t nz, double spatial_step, double time_step,
                       const SATPHiggsParams& physics_params)
         : N_x(nx), N_y(ny), N_z(nz), dx(spatial_step), dt(time_step),
           nodes(nx * ny * nz), nodes_temp(nx * ny * nz),
-          params(physics_params), has_source(false),
+          phi_accel(nx * ny * nz), h_accel(nx * ny * nz),
+          stencil_mode(SATPStencilMode::Reference),
+          params(physics_params), has_source(false), source_kind(SATPSourceKind::None),
           current_time(0.0), step_count(0),
+          com_axis_x(nx), com_axis_y(ny), com_axis_z(nz),
           is_running(false), total_updates(0) {
 
         params.updateVEV();
@@ -90,12 +232,45 @@ public:
     size_t getN() const { return N_x * N_y * N_z; }
     double getDx() const { return dx; }
     double getDt() const { return dt; }
+    // Step used by the next evolve call (satp_higgs_adaptive.h); not while evolving
+    void setDt(double time_step) { dt = time_step; }
     double getTime() const { return current_time; }
     uint64_t getStepCount() const { return step_count; }
     uint64_t getTotalUpdates() const { return total_updates.load(std::memory_order_relaxed); }
     const SATPHiggsParams& getParams() const { return params; }
-    const std::vector<SATPHiggsNode>& getNodes() const { return nodes; }
-    std::vector<SATPHiggsNode>& getNodesMutable() { return nodes; }
+    // Couplings used by the next evolve call; reset() re-seeds h at their VEV
+    void setParams(const SATPHiggsParams& p) { params = p; }
+    // Host fields (downloaded first if the device holds newer ones)
+    const std::vector<SATPHiggsNode>& getNodes() const {
+        syncHost();
+        return nodes;
+    }
+    // Host fields for editing; the next GPU evolve re-uploads them
+    std::vector<SATPHiggsNode>& getNodesMutable() {
+        invalidateDevice();
+        return nodes;
+    }
+
+    // Bytes held by the node fields (state) and the Verlet, source, SoA-mirror, temporal-blocking
+    // and spectral buffers (scratch); device memory excluded
+    MemoryFootprint memoryFootprint() const {
+        MemoryFootprint bytes;
+        bytes.state = capacityBytes(nodes);
+        bytes.scratch = capacityBytes(nodes_temp) + capacityBytes(phi_accel) + capacityBytes(h_accel) +
+                        capacityBytes(source_profile) + capacityBytes(source_buf);
+        bytes.scratch += blocking.memoryBytes() + capacityBytes(soa_phi) + capacityBytes(soa_phi_dot) +
+                         capacityBytes(soa_h) + capacityBytes(soa_h_dot) + spectral.memoryBytes();
+        return bytes;
+    }
+
+    // memoryFootprint() of a new engine (Reference stepping, no source)
+    static MemoryFootprint estimateMemory(size_t nx, size_t ny, size_t nz) {
+        const uint64_t n = nx * ny * nz;
+        MemoryFootprint bytes;
+        bytes.state = n * sizeof(SATPHiggsNode);
+        bytes.scratch = n * (sizeof(SATPHiggsNode) + 2 * sizeof(double));
+        return bytes;
+    }
 
     // Index conversion
     size_t getIndex(size_t x, size_t y, size_t z) const {
@@ -109,20 +284,50 @@ public:
         x = remainder % N_x;
     }
 
-    // Source term management
+    // Source term management (a new source re-uploads the device copy)
     void setSource(SourceFunction3D func) {
+        invalidateDevice();
         source_phi = func;
         has_source = true;
+        source_kind = SATPSourceKind::PointWise;
     }
 
+    // Batch source: func fills S(t, ·) for all getN() points per force evaluation
+    void setBatchSource(BatchSourceFunction func) {
+        invalidateDevice();
+        batch_source = std::move(func);
+        source_buf.resize(getN());
+        has_source = true;
+        source_kind = SATPSourceKind::Batch;
+    }
+
+    // Separable source S(t, ·) = envelope(t) · profile[index]
+    // Returns false (source unchanged) if profile.size() != getN()
+    bool setSeparableSource(const std::vector<double>& profile, const SATPSourceEnvelope& envelope) {
+        if (profile.size() != getN()) return false;
+        invalidateDevice();
+        source_profile.assign(profile.begin(), profile.end());
+        source_envelope = envelope;
+        source_buf.resize(getN());
+        has_source = true;
+        source_kind = SATPSourceKind::Separable;
+        return true;
+    }
+
+    SATPSourceKind getSourceKind() const { return source_kind; }
+
     void clearSource() {
+        invalidateDevice();
         has_source = false;
+        source_kind = SATPSourceKind::None;
         source_phi = nullptr;
+        batch_source = nullptr;
     }
 
     // State management
     void reset() {
         std::lock_guard<std::mutex> lock(state_mutex);
+        invalidateDevice();
         current_time = 0.0;
         step_count = 0;
         total_updates.store(0);
@@ -135,9 +340,109 @@ public:
         }
     }
 
+    // Checkpoint sections (satp_higgs_checkpoint.h); the engine must not
+    // evolve until writer.write() returns
+    void saveCheckpoint(CheckpointWriter& writer) const {
+        syncHost();
+        SATPCheckpoint::save(writer, nodes, params, N_x, N_y, N_z, dx, dt, current_time,
+                             step_count, total_updates.load(std::memory_order_relaxed));
+    }
+
+    // @throws std::runtime_error if the image does not fit this lattice
+    void restoreCheckpoint(const CheckpointImage& image) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        invalidateDevice();
+        uint64_t updates = 0;
+        SATPCheckpoint::restore(image, nodes, params, N_x, N_y, N_z, dx, dt, current_time,
+                                step_count, updates);
+        total_updates.store(updates);
+    }
+
+    // Stencil implementation (Reference by default; Tiled and Bricked reproduce
+    // it with the same arithmetic).  The layout is internal: nodes, getIndex
+    // and every other API stay row-major.
+    void setStencilMode(SATPStencilMode mode) { stencil_mode = mode; }
+    SATPStencilMode getStencilMode() const { return stencil_mode; }
+
+    /**
+     * Laplacian discretisation (satp_higgs_spectral.h; FiniteDifference by
+     * default).  Spectral modes step on the host, take precedence over the
+     * stencil mode and temporal blocking, and accept every source kind.
+     *
+     * @return false (mode unchanged) if a spectral mode is requested and no
+     *         FFT backend is available
+     */
+    bool setLaplacianMode(SATPLaplacianMode mode) {
+        if (mode != SATPLaplacianMode::FiniteDifference && !spectral.configure(N_x, N_y, N_z, dx)) {
+            return false;
+        }
+        laplacian_mode = mode;
+        return true;
+    }
+    SATPLaplacianMode getLaplacianMode() const { return laplacian_mode; }
+
+    // Steps advanced per pass over the lattice on space-time tiles (<= 1 =
+    // off).  Applies with no source or a Separable source; other sources
+    // keep the per-step path.  Results match the per-step path.
+    void setTemporalBlockSteps(size_t steps) { temporal_block_steps = steps; }
+    size_t getTemporalBlockSteps() const { return temporal_block_steps; }
+
+    /**
+     * Select where evolve calls run (gpu_device.h)
+     *
+     * GPU calls with no source or a Separable source keep the fields
+     * resident on the device; other sources evolve on the host.  Switching
+     * back to CPU downloads the fields and frees the device copy.
+     *
+     * @return false (device unchanged) if GPU is requested and no device is
+     *         available
+     */
+    bool setDevice(ComputeDevice compute_device) {
+        if (compute_device == ComputeDevice::GPU && !GpuDevice::isAvailable()) {
+            return false;
+        }
+        if (compute_device == ComputeDevice::CPU) {
+            syncHost();
+            gpu.release();
+            device_current = false;
+        }
+        device = compute_device;
+        return true;
+    }
+    ComputeDevice getDevice() const { return device; }
+
+    // True if the last evolve call stepped on the device
+    bool lastEvolveOnDevice() const { return last_evolve_device; }
+
+    // Bytes of device memory held by the GPU backend
+    size_t getDeviceMemoryUsage() const { return gpu.memoryBytes(); }
+
     // Physics evolution (implemented in satp_higgs_physics_3d.h)
     void evolve(size_t num_steps);
 
+    // Modelled bytes / FLOPs per step (satpStepTraffic) and the rates the
+    // last evolve call achieved
+    KernelRoofline getRoofline() const {
+        if (last_evolve_spectral) {
+            return kernelRoofline(satpSpectralStepTraffic(getN(), laplacian_mode, source_kind),
+                                  last_evolve_steps, last_evolve_seconds);
+        }
+        if (last_evolve_device) {
+            // SoA fields streamed as on the tiled path
+            return kernelRoofline(satpStepTraffic(getN(), 3, 4.0 * sizeof(double), source_kind, true),
+                                  last_evolve_steps, last_evolve_seconds);
+        }
+        if (last_evolve_blocked) {
+            return kernelRoofline(satpBlockedStepTraffic(getN(), 3, source_kind, temporal_block_steps,
+                                                         blocking.lastOverlap()),
+                                  last_evolve_steps, last_evolve_seconds);
+        }
+        const bool tiled = (stencil_mode != SATPStencilMode::Reference);
+        const double cell_bytes = tiled ? 4.0 * sizeof(double) : static_cast<double>(sizeof(SATPHiggsNode));
+        return kernelRoofline(satpStepTraffic(getN(), 3, cell_bytes, source_kind, tiled),
+                              last_evolve_steps, last_evolve_seconds);
+    }
+
     // Metrics helper
     void getMetrics(double& ns_per_op, double& ops_per_sec, uint64_t& total_operations) const {
         total_operations = total_updates.load(std::memory_order_relaxed);
@@ -151,69 +456,75 @@ public:
         }
     }
 
-    // Diagnostics
+    // Diagnostics reduce on the device while the fields are resident, and
+    // otherwise through reproducible_sum.h (bit-identical for any thread count)
     double computeTotalEnergy() const {
-        double total_E = 0.0;
+        if (device_current) {
+            return gpu.reduce(params, dx).energy;
+        }
         const double dx_cube = dx * dx * dx;  // Volume element
 
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t idx = getIndex(x, y, z);
-                    const auto& node = nodes[idx];
-
-                    // Kinetic energy
-                    double E_kin = 0.5 * (node.phi_dot * node.phi_dot + node.h_dot * node.h_dot);
-
-                    // Gradient energy (3D finite difference)
-                    size_t x_next = (x + 1) % N_x;
-                    size_t y_next = (y + 1) % N_y;
-                    size_t z_next = (z + 1) % N_z;
-                    size_t idx_xnext = getIndex(x_next, y, z);
-                    size_t idx_ynext = getIndex(x, y_next, z);
-                    size_t idx_znext = getIndex(x, y, z_next);
-
-                    double dphi_dx = (nodes[idx_xnext].phi - node.phi) / dx;
-                    double dphi_dy = (nodes[idx_ynext].phi - node.phi) / dx;
-                    double dphi_dz = (nodes[idx_znext].phi - node.phi) / dx;
-                    double dh_dx = (nodes[idx_xnext].h - node.h) / dx;
-                    double dh_dy = (nodes[idx_ynext].h - node.h) / dx;
-                    double dh_dz = (nodes[idx_znext].h - node.h) / dx;
-
-                    double E_grad = 0.5 * params.c * params.c * (
-                        dphi_dx * dphi_dx + dphi_dy * dphi_dy + dphi_dz * dphi_dz +
-                        dh_dx * dh_dx + dh_dy * dh_dy + dh_dz * dh_dz
-                    );
-
-                    // Higgs potential
-                    double h_val = node.h;
-                    double V_higgs = params.mu_squared * h_val * h_val
-                                   + params.lambda_h * h_val * h_val * h_val * h_val;
-
-                    // Coupling energy
-                    double V_coupling = params.lambda * node.phi * node.phi * h_val * h_val;
-
-                    total_E += (E_kin + E_grad + V_higgs + V_coupling) * dx_cube;
-                }
-            }
-        }
-        return total_E;
+        return reproducibleSum(static_cast<int64_t>(nodes.size()), [&](int64_t i) {
+            const size_t idx = static_cast<size_t>(i);
+            const size_t x = idx % N_x;
+            const size_t y = (idx / N_x) % N_y;
+            const size_t z = idx / (N_x * N_y);
+            const auto& node = nodes[idx];
+
+            // Kinetic energy
+            double E_kin = 0.5 * (node.phi_dot * node.phi_dot + node.h_dot * node.h_dot);
+
+            // Gradient energy (3D finite difference)
+            size_t x_next = (x + 1) % N_x;
+            size_t y_next = (y + 1) % N_y;
+            size_t z_next = (z + 1) % N_z;
+            size_t idx_xnext = getIndex(x_next, y, z);
+            size_t idx_ynext = getIndex(x, y_next, z);
+            size_t idx_znext = getIndex(x, y, z_next);
+
+            double dphi_dx = (nodes[idx_xnext].phi - node.phi) / dx;
+            double dphi_dy = (nodes[idx_ynext].phi - node.phi) / dx;
+            double dphi_dz = (nodes[idx_znext].phi - node.phi) / dx;
+            double dh_dx = (nodes[idx_xnext].h - node.h) / dx;
+            double dh_dy = (nodes[idx_ynext].h - node.h) / dx;
+            double dh_dz = (nodes[idx_znext].h - node.h) / dx;
+
+            double E_grad = 0.5 * params.c * params.c * (
+                dphi_dx * dphi_dx + dphi_dy * dphi_dy + dphi_dz * dphi_dz +
+                dh_dx * dh_dx + dh_dy * dh_dy + dh_dz * dh_dz
+            );
+
+            // Higgs potential
+            double h_val = node.h;
+            double V_higgs = params.mu_squared * h_val * h_val
+                           + params.lambda_h * h_val * h_val * h_val * h_val;
+
+            // Coupling energy
+            double V_coupling = params.lambda * node.phi * node.phi * h_val * h_val;
+
+            return (E_kin + E_grad + V_higgs + V_coupling) * dx_cube;
+        });
     }
 
     double computePhiRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            sum += node.phi * node.phi;
+        if (device_current) {
+            return std::sqrt(gpu.reduce(params, dx).phi_sq / static_cast<double>(nodes.size()));
         }
+        const double sum = reproducibleSum(static_cast<int64_t>(nodes.size()), [this](int64_t i) {
+            const double phi = nodes[static_cast<size_t>(i)].phi;
+            return phi * phi;
+        });
         return std::sqrt(sum / static_cast<double>(nodes.size()));
     }
 
     double computeHiggsRMS() const {
-        double sum = 0.0;
-        for (const auto& node : nodes) {
-            double h_deviation = node.h - params.h_vev;
-            sum += h_deviation * h_deviation;
+        if (device_current) {
+            return std::sqrt(gpu.reduce(params, dx).h_deviation_sq / static_cast<double>(nodes.size()));
         }
+        const double sum = reproducibleSum(static_cast<int64_t>(nodes.size()), [this](int64_t i) {
+            const double h_deviation = nodes[static_cast<size_t>(i)].h - params.h_vev;
+            return h_deviation * h_deviation;
+        });
         return std::sqrt(sum / static_cast<double>(nodes.size()));
     }
 
@@ -224,25 +535,25 @@ public:
         double sum_cos_y = 0.0, sum_sin_y = 0.0;
         double sum_cos_z = 0.0, sum_sin_z = 0.0;
 
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t idx = getIndex(x, y, z);
-                    double weight = std::abs(nodes[idx].phi);
-
-                    double theta_x = 2.0 * M_PI * static_cast<double>(x) / static_cast<double>(N_x);
-                    double theta_y = 2.0 * M_PI * static_cast<double>(y) / static_cast<double>(N_y);
-                    double theta_z = 2.0 * M_PI * static_cast<double>(z) / static_cast<double>(N_z);
-
-                    sum_phi += weight;
-                    sum_cos_x += weight * std::cos(theta_x);
-                    sum_sin_x += weight * std::sin(theta_x);
-                    sum_cos_y += weight * std::cos(theta_y);
-                    sum_sin_y += weight * std::sin(theta_y);
-                    sum_cos_z += weight * std::cos(theta_z);
-                    sum_sin_z += weight * std::sin(theta_z);
-                }
-            }
+        if (device_current) {
+            const SATPDeviceTotals totals = gpu.reduce(params, dx);
+            sum_phi = totals.weight;
+            sum_cos_x = totals.sum_cos[0];
+            sum_sin_x = totals.sum_sin[0];
+            sum_cos_y = totals.sum_cos[1];
+            sum_sin_y = totals.sum_sin[1];
+            sum_cos_z = totals.sum_cos[2];
+            sum_sin_z = totals.sum_sin[2];
+        } else {
+            const CircularTotals totals = circularTotals(com_axis_x, com_axis_y, com_axis_z, 0, N_z,
+                                                         [this](size_t i) { return std::abs(nodes[i].phi); });
+            sum_phi = totals.weight;
+            sum_cos_x = totals.sum_cos[0];
+            sum_sin_x = totals.sum_sin[0];
+            sum_cos_y = totals.sum_cos[1];
+            sum_sin_y = totals.sum_sin[1];
+            sum_cos_z = totals.sum_cos[2];
+            sum_sin_z = totals.sum_sin[2];
         }
 
         if (sum_phi > 1e-12) {
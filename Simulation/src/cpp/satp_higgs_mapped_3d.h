@@ -0,0 +1,323 @@
+/**
+ * SATP+Higgs 3D Engine - Out-of-Core (File-Backed) Storage
+ *
+ * Same equations, integrator and arithmetic as SATPHiggsEngine3D's
+ * reference path, for lattices whose state exceeds node memory (a 1024³
+ * lattice is 48 GB here).  φ, φ̇, h, ḣ and the carried accelerations a_φ,
+ * a_h live in a MappedFieldStore (mapped_field_store.h): one file on local
+ * SSD, blocked in z-slabs.  Only a window of slabs is resident at a time.
+ *
+ * Each step is a single streamed sweep over the slabs:
+ *
+ *   drift(k)   x += v dt + a dt²/2,  v += a dt/2         (slab k only)
+ *   force(k)   a = F(x, v, t + dt) for slab k, then the closing kick
+ *              v += a dt/2 and the damping shift a -= γ a dt/2
+ *
+ * force(k) needs the drifted planes on both sides of slab k, so it trails
+ * drift by one slab: drift(0), drift(1), [drift(k+1), force(k)] for
+ * k = 1 .. S-1, and force(0) last (its lower neighbour is slab S-1).
+ * force(k) reads only x of neighbouring slabs, which their own force
+ * leaves untouched, so the sweep works in place.  While slab k drifts,
+ * slab k + prefetch_slabs is prefetched; once force(k) is done slab k-1 is
+ * written behind and evicted.  Slabs 0, 1 and S-1 stay until force(0), so
+ * the resident set is about prefetch_slabs + 5 slabs.
+ *
+ * Every evolve call starts with one force sweep for a(t) from the current
+ * state, as the in-memory engine does.  Point-wise sources are evaluated
+ * on one thread per slab (callbacks need not be thread-safe); stencil work
+ * within a slab is spread over OpenMP threads.  State is set and read per
+ * node or per z-plane, so initial conditions larger than RAM can be
+ * written plane by plane.
+ */
+
+#pragma once
+
+#include "mapped_field_store.h"
+#include "satp_higgs_engine_1d.h"
+#include "satp_higgs_engine_3d.h"
+#include "trace_zones.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dase {
+namespace satp_higgs {
+
+struct SATPMappedOptions {
+    std::string path;            // Backing file (created, removed on destruction unless keep_file)
+    size_t slab_planes = 4;      // z-planes per slab
+    size_t prefetch_slabs = 2;   // Slabs read ahead of the drift
+    bool keep_file = false;
+};
+
+class SATPHiggsMappedEngine3D {
+public:
+    // Fields of the store, in slab order
+    enum Field : size_t { Phi = 0, PhiDot, H, HDot, PhiAccel, HAccel, kNumFields };
+
+    SATPHiggsMappedEngine3D(size_t nx, size_t ny, size_t nz, double spatial_step, double time_step,
+                            const SATPHiggsParams& physics_params, const SATPMappedOptions& options)
+        : N_x(nx), N_y(ny), N_z(nz), dx(spatial_step), dt(time_step), params(physics_params),
+          prefetch_slabs(options.prefetch_slabs) {
+        if (nx < 3 || ny < 3 || nz < 3) {
+            throw std::invalid_argument("SATPHiggsMappedEngine3D: each dimension needs at least 3 points");
+        }
+        if (options.path.empty()) {
+            throw std::invalid_argument("SATPHiggsMappedEngine3D: a backing file path is required");
+        }
+        store.reset(new MappedFieldStore(options.path, kNumFields, nx * ny, nz, options.slab_planes));
+        store->keepFile(options.keep_file);
+        params.updateVEV();
+
+        // Higgs VEV everywhere (the file starts zeroed), written slab by slab
+        for (size_t k = 0; k < store->numSlabs(); ++k) {
+            std::fill_n(store->slabField(k, H), store->slabPlanes(k) * planePoints(), params.h_vev);
+            store->evict(k);
+        }
+    }
+
+    size_t getNx() const { return N_x; }
+    size_t getNy() const { return N_y; }
+    size_t getNz() const { return N_z; }
+    size_t getN() const { return N_x * N_y * N_z; }
+    double getDx() const { return dx; }
+    double getDt() const { return dt; }
+    void setDt(double time_step) { dt = time_step; }
+    double getTime() const { return current_time; }
+    uint64_t getStepCount() const { return step_count; }
+    uint64_t getTotalUpdates() const { return total_updates; }
+    const SATPHiggsParams& getParams() const { return params; }
+    double getLastEvolveSeconds() const { return last_evolve_seconds; }
+    const MappedFieldStore& getStore() const { return *store; }
+    size_t getIndex(size_t x, size_t y, size_t z) const { return z * N_x * N_y + y * N_x + x; }
+
+    void setSource(SourceFunction3D func) {
+        source_phi = std::move(func);
+        has_source = static_cast<bool>(source_phi);
+    }
+    void clearSource() {
+        source_phi = nullptr;
+        has_source = false;
+    }
+
+    // One node (derived quantities refreshed)
+    SATPHiggsNode getNode(size_t x, size_t y, size_t z) const {
+        const size_t i = y * N_x + x;
+        SATPHiggsNode node;
+        node.phi = store->plane(Phi, z)[i];
+        node.phi_dot = store->plane(PhiDot, z)[i];
+        node.h = store->plane(H, z)[i];
+        node.h_dot = store->plane(HDot, z)[i];
+        node.updateDerived();
+        return node;
+    }
+
+    void setNode(size_t x, size_t y, size_t z, const SATPHiggsNode& node) {
+        const size_t i = y * N_x + x;
+        store->plane(Phi, z)[i] = node.phi;
+        store->plane(PhiDot, z)[i] = node.phi_dot;
+        store->plane(H, z)[i] = node.h;
+        store->plane(HDot, z)[i] = node.h_dot;
+    }
+
+    // z-plane `z` (N_x * N_y values in y-major order) of each non-null field
+    void readPlane(size_t z, double* phi, double* phi_dot, double* h, double* h_dot) const {
+        double* out[] = {phi, phi_dot, h, h_dot};
+        for (size_t f = 0; f < 4; ++f) {
+            if (out[f]) std::copy_n(store->plane(f, z), planePoints(), out[f]);
+        }
+    }
+
+    void writePlane(size_t z, const double* phi, const double* phi_dot, const double* h, const double* h_dot) {
+        const double* in[] = {phi, phi_dot, h, h_dot};
+        for (size_t f = 0; f < 4; ++f) {
+            if (in[f]) std::copy_n(in[f], planePoints(), store->plane(f, z));
+        }
+    }
+
+    // Write every resident change to the backing file
+    void flush() { store->flush(); }
+
+    void evolve(size_t num_steps) {
+        DASE_TRACE_ZONE("satp.mapped_evolve");
+        if (num_steps == 0) return;
+        const auto wall_start = std::chrono::steady_clock::now();
+        const size_t S = store->numSlabs();
+
+        // a(t) from the current state
+        for (size_t k = 0; k < std::min(S, prefetch_slabs + 1); ++k) store->prefetch(k);
+        for (size_t k = 0; k < S; ++k) {
+            store->prefetch(k + prefetch_slabs + 1);
+            force(k, current_time, false);
+            if (k >= 2) store->evict(k - 1);
+        }
+        store->evict(S - 1);
+        store->evict(0);
+
+        for (size_t step = 0; step < num_steps; ++step) {
+            DASE_TRACE_ZONE("satp.mapped_step");
+            const double t_next = current_time + dt;
+            for (size_t k = 0; k < std::min(S, prefetch_slabs + 1); ++k) store->prefetch(k);
+            drift(0);
+            if (S > 1) drift(1);
+            for (size_t k = 1; k < S; ++k) {
+                store->prefetch(k + prefetch_slabs + 1);
+                if (k + 1 < S) drift(k + 1);
+                force(k, t_next, true);
+                if (k >= 3) store->evict(k - 1);   // Slabs 0, 1 and S-1 wait for force(0)
+            }
+            force(0, t_next, true);
+            store->evict(0);
+            if (S > 1) store->evict(1);
+            if (S > 2) store->evict(S - 1);
+
+            current_time = t_next;
+            step_count++;
+            total_updates += getN();
+        }
+        last_evolve_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+    }
+
+private:
+    size_t N_x, N_y, N_z;
+    double dx;
+    double dt;
+    SATPHiggsParams params;
+    size_t prefetch_slabs;
+    std::unique_ptr<MappedFieldStore> store;
+
+    SourceFunction3D source_phi;
+    bool has_source = false;
+    std::vector<double> source_buf;   // S(t, ·) of one slab
+
+    double current_time = 0.0;
+    uint64_t step_count = 0;
+    uint64_t total_updates = 0;
+    double last_evolve_seconds = 0.0;
+
+    size_t planePoints() const { return N_x * N_y; }
+
+    // x(t+dt) and the half-step velocities of slab k
+    void drift(size_t k) {
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(store->slabPlanes(k) * planePoints());
+        double* phi = store->slabField(k, Phi);
+        double* phi_dot = store->slabField(k, PhiDot);
+        double* h = store->slabField(k, H);
+        double* h_dot = store->slabField(k, HDot);
+        const double* a_phi = store->slabField(k, PhiAccel);
+        const double* a_h = store->slabField(k, HAccel);
+        const double step = dt;
+        #pragma omp parallel for schedule(static) if(n >= 65536)
+        for (std::ptrdiff_t i = 0; i < n; ++i) {
+            phi[i] = phi[i] + phi_dot[i] * step + 0.5 * a_phi[i] * step * step;
+            h[i] = h[i] + h_dot[i] * step + 0.5 * a_h[i] * step * step;
+            phi_dot[i] = phi_dot[i] + 0.5 * a_phi[i] * step;
+            h_dot[i] = h_dot[i] + 0.5 * a_h[i] * step;
+        }
+    }
+
+    // Accelerations of slab k at time t; with kick, also the closing half
+    // kick and the damping shift of the in-memory engine's step 4
+    void force(size_t k, double t, bool kick) {
+        const size_t first = store->firstPlane(k);
+        const size_t planes = store->slabPlanes(k);
+        const size_t P = planePoints();
+        const double* source = nullptr;
+        if (has_source) {
+            source_buf.resize(planes * P);
+            for (size_t pz = 0; pz < planes; ++pz) {
+                const size_t z = first + pz;
+                for (size_t y = 0; y < N_y; ++y) {
+                    for (size_t x = 0; x < N_x; ++x) {
+                        source_buf[pz * P + y * N_x + x] =
+                            source_phi(t, static_cast<double>(x) * dx, static_cast<double>(y) * dx,
+                                       static_cast<double>(z) * dx, static_cast<int>(x), static_cast<int>(y),
+                                       static_cast<int>(z));
+                    }
+                }
+            }
+            source = source_buf.data();
+        }
+
+        const double c_sq = params.c * params.c;
+        const double dx_sq = dx * dx;
+        const double gamma_phi = params.gamma_phi;
+        const double gamma_h = params.gamma_h;
+        const double lambda = params.lambda;
+        const double mu_sq = params.mu_squared;
+        const double lambda_h = params.lambda_h;
+        const double step = dt;
+        const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(planes * N_y);
+
+        #pragma omp parallel for schedule(static) if(rows * static_cast<std::ptrdiff_t>(N_x) >= 65536)
+        for (std::ptrdiff_t row = 0; row < rows; ++row) {
+            const size_t pz = static_cast<size_t>(row) / N_y;
+            const size_t y = static_cast<size_t>(row) % N_y;
+            const size_t z = first + pz;
+            const size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
+            const size_t z_next = (z + 1) % N_z;
+            const size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
+            const size_t y_next = (y + 1) % N_y;
+
+            const double* phi = store->plane(Phi, z);
+            const double* h = store->plane(H, z);
+            const double* phi_zp = store->plane(Phi, z_prev) + y * N_x;
+            const double* phi_zn = store->plane(Phi, z_next) + y * N_x;
+            const double* h_zp = store->plane(H, z_prev) + y * N_x;
+            const double* h_zn = store->plane(H, z_next) + y * N_x;
+            double* phi_dot = store->plane(PhiDot, z) + y * N_x;
+            double* h_dot = store->plane(HDot, z) + y * N_x;
+            double* a_phi = store->plane(PhiAccel, z) + y * N_x;
+            double* a_h = store->plane(HAccel, z) + y * N_x;
+            const double* row_source = source ? source + pz * P + y * N_x : nullptr;
+
+            for (size_t x = 0; x < N_x; ++x) {
+                const size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
+                const size_t x_next = (x + 1) % N_x;
+                const size_t c = y * N_x + x;
+                const double node_phi = phi[c];
+                const double node_h = h[c];
+
+                const double laplacian_phi = (phi[y * N_x + x_prev] + phi[y * N_x + x_next] +
+                                              phi[y_prev * N_x + x] + phi[y_next * N_x + x] +
+                                              phi_zp[x] + phi_zn[x] -
+                                              6.0 * node_phi) / dx_sq;
+                const double laplacian_h = (h[y * N_x + x_prev] + h[y * N_x + x_next] +
+                                            h[y_prev * N_x + x] + h[y_next * N_x + x] +
+                                            h_zp[x] + h_zn[x] -
+                                            6.0 * node_h) / dx_sq;
+                const double source_term = row_source ? row_source[x] : 0.0;
+
+                double phi_accel = c_sq * laplacian_phi
+                                 - gamma_phi * phi_dot[x]
+                                 - 2.0 * lambda * node_phi * node_h * node_h
+                                 + source_term;
+                double h_accel = c_sq * laplacian_h
+                               - gamma_h * h_dot[x]
+                               - 2.0 * mu_sq * node_h
+                               - 4.0 * lambda_h * node_h * node_h * node_h
+                               - 2.0 * lambda * node_phi * node_phi * node_h;
+
+                if (kick) {
+                    const double phi_kick = 0.5 * phi_accel * step;
+                    const double h_kick = 0.5 * h_accel * step;
+                    phi_dot[x] = phi_dot[x] + phi_kick;
+                    h_dot[x] = h_dot[x] + h_kick;
+                    phi_accel -= gamma_phi * phi_kick;
+                    h_accel -= gamma_h * h_kick;
+                }
+                a_phi[x] = phi_accel;
+                a_h[x] = h_accel;
+            }
+        }
+    }
+};
+
+} // namespace satp_higgs
+} // namespace dase
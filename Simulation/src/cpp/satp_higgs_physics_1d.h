@@ -9,15 +9,15 @@
 #pragma once
 
 #include "satp_higgs_engine_1d.h"
+#include "trace_zones.h"
+#include <chrono>
 #include <cmath>
 
 namespace dase {
 namespace satp_higgs {
 
-// Velocity Verlet implementation for wave equations
-inline void SATPHiggsEngine1D::evolve(size_t num_steps) {
-    is_running.store(true);
-
+// Accelerations for a field state at time t (fills phi_accel / h_accel)
+inline void SATPHiggsEngine1D::computeAccelerations(const std::vector<SATPHiggsNode>& state, double t) {
     const double c_sq = params.c * params.c;
     const double dx_sq = dx * dx;
     const double gamma_phi = params.gamma_phi;
@@ -25,50 +25,71 @@ inline void SATPHiggsEngine1D::evolve(size_t num_steps) {
     const double lambda = params.lambda;
     const double mu_sq = params.mu_squared;
     const double lambda_h = params.lambda_h;
+    const double* source_field = prepareSourceField(t);
+
+    for (size_t i = 0; i < N; ++i) {
+        size_t i_prev = (i == 0) ? N - 1 : i - 1;
+        size_t i_next = (i + 1) % N;
+
+        const auto& node_prev = state[i_prev];
+        const auto& node = state[i];
+        const auto& node_next = state[i_next];
+
+        // Laplacian using second-order finite differences
+        double laplacian_phi = (node_prev.phi - 2.0 * node.phi + node_next.phi) / dx_sq;
+        double laplacian_h = (node_prev.h - 2.0 * node.h + node_next.h) / dx_sq;
+
+        // Source term for φ field
+        double source_term = 0.0;
+        if (source_field) {
+            source_term = source_field[i];
+        } else if (has_source) {
+            double x_pos = static_cast<double>(i) * dx;
+            source_term = source_phi(t, x_pos, static_cast<int>(i));
+        }
+
+        // φ equation: ∂²φ/∂t² = c²∇²φ - γ_φ ∂φ/∂t - 2λφh² + S(t,x)
+        phi_accel[i] = c_sq * laplacian_phi
+                     - gamma_phi * node.phi_dot
+                     - 2.0 * lambda * node.phi * node.h * node.h
+                     + source_term;
+
+        // h equation: ∂²h/∂t² = c²∇²h - γ_h ∂h/∂t - 2μ²h - 4λ_h h³ - 2λφ²h
+        h_accel[i] = c_sq * laplacian_h
+                   - gamma_h * node.h_dot
+                   - 2.0 * mu_sq * node.h
+                   - 4.0 * lambda_h * node.h * node.h * node.h
+                   - 2.0 * lambda * node.phi * node.phi * node.h;
+    }
+}
+
+// Velocity Verlet implementation for wave equations
+//
+// One force evaluation per step: a(t+dt) from step 3 is carried into the
+// next step as its a(t).  It was evaluated with the half-step velocity, so
+// the (linear) damping term is shifted to v(t+dt) when the kick completes.
+inline void SATPHiggsEngine1D::evolve(size_t num_steps) {
+    DASE_TRACE_ZONE("satp.evolve");
+    const auto wall_start = std::chrono::steady_clock::now();
+    is_running.store(true);
+
+    const size_t N_total = N;
+    const double gamma_phi = params.gamma_phi;
+    const double gamma_h = params.gamma_h;
+
+    // Step 1: Compute accelerations at t (once per call; then reused)
+    if (num_steps > 0) {
+        computeAccelerations(nodes, current_time);
+    }
 
     for (size_t step = 0; step < num_steps; ++step) {
+        DASE_TRACE_ZONE("satp.step");
+
         // Velocity Verlet: x(t+dt) = x(t) + v(t)*dt + 0.5*a(t)*dt²
         //                  v(t+dt) = v(t) + 0.5*[a(t) + a(t+dt)]*dt
 
-        // Step 1: Compute accelerations at t
-        std::vector<double> phi_accel(N);
-        std::vector<double> h_accel(N);
-
-        for (size_t i = 0; i < N; ++i) {
-            size_t i_prev = (i == 0) ? N - 1 : i - 1;
-            size_t i_next = (i + 1) % N;
-
-            const auto& node_prev = nodes[i_prev];
-            const auto& node = nodes[i];
-            const auto& node_next = nodes[i_next];
-
-            // Laplacian using second-order finite differences
-            double laplacian_phi = (node_prev.phi - 2.0 * node.phi + node_next.phi) / dx_sq;
-            double laplacian_h = (node_prev.h - 2.0 * node.h + node_next.h) / dx_sq;
-
-            // Source term for φ field
-            double source_term = 0.0;
-            if (has_source) {
-                double x_pos = static_cast<double>(i) * dx;
-                source_term = source_phi(current_time, x_pos, static_cast<int>(i));
-            }
-
-            // φ equation: ∂²φ/∂t² = c²∇²φ - γ_φ ∂φ/∂t - 2λφh² + S(t,x)
-            phi_accel[i] = c_sq * laplacian_phi
-                         - gamma_phi * node.phi_dot
-                         - 2.0 * lambda * node.phi * node.h * node.h
-                         + source_term;
-
-            // h equation: ∂²h/∂t² = c²∇²h - γ_h ∂h/∂t - 2μ²h - 4λ_h h³ - 2λφ²h
-            h_accel[i] = c_sq * laplacian_h
-                       - gamma_h * node.h_dot
-                       - 2.0 * mu_sq * node.h
-                       - 4.0 * lambda_h * node.h * node.h * node.h
-                       - 2.0 * lambda * node.phi * node.phi * node.h;
-        }
-
         // Step 2: Update positions and half-step velocities
-        for (size_t i = 0; i < N; ++i) {
+        for (size_t i = 0; i < N_total; ++i) {
             auto& node = nodes_temp[i];
             node = nodes[i];
 
@@ -81,50 +102,25 @@ inline void SATPHiggsEngine1D::evolve(size_t num_steps) {
             node.h_dot = node.h_dot + 0.5 * h_accel[i] * dt;
         }
 
-        // Step 3: Compute accelerations at t+dt
-        std::vector<double> phi_accel_new(N);
-        std::vector<double> h_accel_new(N);
-
-        for (size_t i = 0; i < N; ++i) {
-            size_t i_prev = (i == 0) ? N - 1 : i - 1;
-            size_t i_next = (i + 1) % N;
-
-            const auto& node_prev = nodes_temp[i_prev];
-            const auto& node = nodes_temp[i];
-            const auto& node_next = nodes_temp[i_next];
-
-            // Laplacian at t+dt
-            double laplacian_phi = (node_prev.phi - 2.0 * node.phi + node_next.phi) / dx_sq;
-            double laplacian_h = (node_prev.h - 2.0 * node.h + node_next.h) / dx_sq;
-
-            // Source term at t+dt
-            double source_term = 0.0;
-            if (has_source) {
-                double x_pos = static_cast<double>(i) * dx;
-                double t_new = current_time + dt;
-                source_term = source_phi(t_new, x_pos, static_cast<int>(i));
-            }
-
-            // Accelerations at t+dt
-            phi_accel_new[i] = c_sq * laplacian_phi
-                             - gamma_phi * node.phi_dot
-                             - 2.0 * lambda * node.phi * node.h * node.h
-                             + source_term;
-
-            h_accel_new[i] = c_sq * laplacian_h
-                           - gamma_h * node.h_dot
-                           - 2.0 * mu_sq * node.h
-                           - 4.0 * lambda_h * node.h * node.h * node.h
-                           - 2.0 * lambda * node.phi * node.phi * node.h;
+        // Step 3: Compute accelerations at t+dt (a(t) is no longer needed)
+        {
+            DASE_TRACE_ZONE("satp.accelerations");
+            computeAccelerations(nodes_temp, current_time + dt);
         }
 
         // Step 4: Complete velocity update using average acceleration
-        for (size_t i = 0; i < N; ++i) {
-            nodes_temp[i].phi_dot = nodes_temp[i].phi_dot + 0.5 * phi_accel_new[i] * dt;
-            nodes_temp[i].h_dot = nodes_temp[i].h_dot + 0.5 * h_accel_new[i] * dt;
+        for (size_t i = 0; i < N_total; ++i) {
+            const double phi_kick = 0.5 * phi_accel[i] * dt;
+            const double h_kick = 0.5 * h_accel[i] * dt;
+            nodes_temp[i].phi_dot = nodes_temp[i].phi_dot + phi_kick;
+            nodes_temp[i].h_dot = nodes_temp[i].h_dot + h_kick;
 
             // Update derived quantities
             nodes_temp[i].updateDerived();
+
+            // Carry a(t+dt) forward as the next a(t), with damping at v(t+dt)
+            phi_accel[i] -= gamma_phi * phi_kick;
+            h_accel[i] -= gamma_h * h_kick;
         }
 
         // Step 5: Swap buffers
@@ -133,9 +129,10 @@ inline void SATPHiggsEngine1D::evolve(size_t num_steps) {
         // Update simulation state
         current_time += dt;
         step_count++;
-        total_updates.fetch_add(N, std::memory_order_relaxed);
+        total_updates.fetch_add(N_total, std::memory_order_relaxed);
     }
 
+    recordEvolve(num_steps, wall_start);
     is_running.store(false);
 }
 
@@ -11,15 +11,15 @@
 #pragma once
 
 #include "satp_higgs_engine_2d.h"
+#include "trace_zones.h"
+#include <chrono>
 #include <cmath>
 
 namespace dase {
 namespace satp_higgs {
 
-// Velocity Verlet implementation for 2D wave equations
-inline void SATPHiggsEngine2D::evolve(size_t num_steps) {
-    is_running.store(true);
-
+// Accelerations for a field state at time t (fills phi_accel / h_accel)
+inline void SATPHiggsEngine2D::computeAccelerations(const std::vector<SATPHiggsNode>& state, double t) {
     const double c_sq = params.c * params.c;
     const double dx_sq = dx * dx;
     const double gamma_phi = params.gamma_phi;
@@ -27,72 +27,106 @@ inline void SATPHiggsEngine2D::evolve(size_t num_steps) {
     const double lambda = params.lambda;
     const double mu_sq = params.mu_squared;
     const double lambda_h = params.lambda_h;
+    const double* source_field = prepareSourceField(t);
+
+    for (size_t y = 0; y < N_y; ++y) {
+        for (size_t x = 0; x < N_x; ++x) {
+            size_t idx = getIndex(x, y);
+
+            // Neighbor indices (periodic boundaries)
+            size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
+            size_t x_next = (x + 1) % N_x;
+            size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
+            size_t y_next = (y + 1) % N_y;
+
+            size_t idx_xprev = getIndex(x_prev, y);
+            size_t idx_xnext = getIndex(x_next, y);
+            size_t idx_yprev = getIndex(x, y_prev);
+            size_t idx_ynext = getIndex(x, y_next);
+
+            const auto& node = state[idx];
+            const auto& node_xprev = state[idx_xprev];
+            const auto& node_xnext = state[idx_xnext];
+            const auto& node_yprev = state[idx_yprev];
+            const auto& node_ynext = state[idx_ynext];
+
+            // 2D Laplacian using 5-point stencil
+            // ∇²f = (f_{i-1,j} + f_{i+1,j} + f_{i,j-1} + f_{i,j+1} - 4f_{i,j}) / dx²
+            double laplacian_phi = (node_xprev.phi + node_xnext.phi +
+                                   node_yprev.phi + node_ynext.phi -
+                                   4.0 * node.phi) / dx_sq;
+
+            double laplacian_h = (node_xprev.h + node_xnext.h +
+                                 node_yprev.h + node_ynext.h -
+                                 4.0 * node.h) / dx_sq;
+
+            // Source term for φ field
+            double source_term = 0.0;
+            if (source_field) {
+                source_term = source_field[idx];
+            } else if (has_source) {
+                double x_pos = static_cast<double>(x) * dx;
+                double y_pos = static_cast<double>(y) * dx;
+                source_term = source_phi(t, x_pos, y_pos,
+                                        static_cast<int>(x), static_cast<int>(y));
+            }
+
+            // φ equation: ∂²φ/∂t² = c²∇²φ - γ_φ ∂φ/∂t - 2λφh² + S(t,x,y)
+            phi_accel[idx] = c_sq * laplacian_phi
+                           - gamma_phi * node.phi_dot
+                           - 2.0 * lambda * node.phi * node.h * node.h
+                           + source_term;
+
+            // h equation: ∂²h/∂t² = c²∇²h - γ_h ∂h/∂t - 2μ²h - 4λ_h h³ - 2λφ²h
+            h_accel[idx] = c_sq * laplacian_h
+                         - gamma_h * node.h_dot
+                         - 2.0 * mu_sq * node.h
+                         - 4.0 * lambda_h * node.h * node.h * node.h
+                         - 2.0 * lambda * node.phi * node.phi * node.h;
+        }
+    }
+}
+
+// Velocity Verlet implementation for 2D wave equations
+//
+// One force evaluation per step: a(t+dt) from step 3 is carried into the
+// next step as its a(t).  It was evaluated with the half-step velocity, so
+// the (linear) damping term is shifted to v(t+dt) when the kick completes.
+inline void SATPHiggsEngine2D::evolve(size_t num_steps) {
+    DASE_TRACE_ZONE("satp.evolve");
+    const auto wall_start = std::chrono::steady_clock::now();
+    if (laplacian_mode != SATPLaplacianMode::FiniteDifference) {
+        evolveSpectral(num_steps);
+        recordEvolve(num_steps, wall_start);
+        return;
+    }
+    last_evolve_spectral = false;
+    if (temporal_block_steps > 1 && num_steps > 1 &&
+        (source_kind == SATPSourceKind::None || source_kind == SATPSourceKind::Separable)) {
+        evolveBlocked(num_steps);
+        recordEvolve(num_steps, wall_start);
+        return;
+    }
+    last_evolve_blocked = false;
+    is_running.store(true);
+
+    const size_t N_total = N_x * N_y;
+    const double gamma_phi = params.gamma_phi;
+    const double gamma_h = params.gamma_h;
+
+    // Step 1: Compute accelerations at t (once per call; then reused)
+    if (num_steps > 0) {
+        computeAccelerations(nodes, current_time);
+    }
 
     for (size_t step = 0; step < num_steps; ++step) {
+        DASE_TRACE_ZONE("satp.step");
+
         // Velocity Verlet: x(t+dt) = x(t) + v(t)*dt + 0.5*a(t)*dt²
         //                  v(t+dt) = v(t) + 0.5*[a(t) + a(t+dt)]*dt
 
-        // Step 1: Compute accelerations at t
-        std::vector<double> phi_accel(N_x * N_y);
-        std::vector<double> h_accel(N_x * N_y);
-
-        for (size_t y = 0; y < N_y; ++y) {
-            for (size_t x = 0; x < N_x; ++x) {
-                size_t idx = getIndex(x, y);
-
-                // Neighbor indices (periodic boundaries)
-                size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
-                size_t x_next = (x + 1) % N_x;
-                size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
-                size_t y_next = (y + 1) % N_y;
-
-                size_t idx_xprev = getIndex(x_prev, y);
-                size_t idx_xnext = getIndex(x_next, y);
-                size_t idx_yprev = getIndex(x, y_prev);
-                size_t idx_ynext = getIndex(x, y_next);
-
-                const auto& node = nodes[idx];
-                const auto& node_xprev = nodes[idx_xprev];
-                const auto& node_xnext = nodes[idx_xnext];
-                const auto& node_yprev = nodes[idx_yprev];
-                const auto& node_ynext = nodes[idx_ynext];
-
-                // 2D Laplacian using 5-point stencil
-                // ∇²f = (f_{i-1,j} + f_{i+1,j} + f_{i,j-1} + f_{i,j+1} - 4f_{i,j}) / dx²
-                double laplacian_phi = (node_xprev.phi + node_xnext.phi +
-                                       node_yprev.phi + node_ynext.phi -
-                                       4.0 * node.phi) / dx_sq;
-
-                double laplacian_h = (node_xprev.h + node_xnext.h +
-                                     node_yprev.h + node_ynext.h -
-                                     4.0 * node.h) / dx_sq;
-
-                // Source term for φ field
-                double source_term = 0.0;
-                if (has_source) {
-                    double x_pos = static_cast<double>(x) * dx;
-                    double y_pos = static_cast<double>(y) * dx;
-                    source_term = source_phi(current_time, x_pos, y_pos,
-                                            static_cast<int>(x), static_cast<int>(y));
-                }
-
-                // φ equation: ∂²φ/∂t² = c²∇²φ - γ_φ ∂φ/∂t - 2λφh² + S(t,x,y)
-                phi_accel[idx] = c_sq * laplacian_phi
-                               - gamma_phi * node.phi_dot
-                               - 2.0 * lambda * node.phi * node.h * node.h
-                               + source_term;
-
-                // h equation: ∂²h/∂t² = c²∇²h - γ_h ∂h/∂t - 2μ²h - 4λ_h h³ - 2λφ²h
-                h_accel[idx] = c_sq * laplacian_h
-                             - gamma_h * node.h_dot
-                             - 2.0 * mu_sq * node.h
-                             - 4.0 * lambda_h * node.h * node.h * node.h
-                             - 2.0 * lambda * node.phi * node.phi * node.h;
-            }
-        }
-
         // Step 2: Update positions and half-step velocities
-        for (size_t i = 0; i < N_x * N_y; ++i) {
+        for (size_t i = 0; i < N_total; ++i) {
             auto& node = nodes_temp[i];
             node = nodes[i];
 
@@ -105,71 +139,25 @@ inline void SATPHiggsEngine2D::evolve(size_t num_steps) {
             node.h_dot = node.h_dot + 0.5 * h_accel[i] * dt;
         }
 
-        // Step 3: Compute accelerations at t+dt
-        std::vector<double> phi_accel_new(N_x * N_y);
-        std::vector<double> h_accel_new(N_x * N_y);
-
-        for (size_t y = 0; y < N_y; ++y) {
-            for (size_t x = 0; x < N_x; ++x) {
-                size_t idx = getIndex(x, y);
-
-                // Neighbor indices
-                size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
-                size_t x_next = (x + 1) % N_x;
-                size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
-                size_t y_next = (y + 1) % N_y;
-
-                size_t idx_xprev = getIndex(x_prev, y);
-                size_t idx_xnext = getIndex(x_next, y);
-                size_t idx_yprev = getIndex(x, y_prev);
-                size_t idx_ynext = getIndex(x, y_next);
-
-                const auto& node = nodes_temp[idx];
-                const auto& node_xprev = nodes_temp[idx_xprev];
-                const auto& node_xnext = nodes_temp[idx_xnext];
-                const auto& node_yprev = nodes_temp[idx_yprev];
-                const auto& node_ynext = nodes_temp[idx_ynext];
-
-                // 2D Laplacian at t+dt
-                double laplacian_phi = (node_xprev.phi + node_xnext.phi +
-                                       node_yprev.phi + node_ynext.phi -
-                                       4.0 * node.phi) / dx_sq;
-
-                double laplacian_h = (node_xprev.h + node_xnext.h +
-                                     node_yprev.h + node_ynext.h -
-                                     4.0 * node.h) / dx_sq;
-
-                // Source term at t+dt
-                double source_term = 0.0;
-                if (has_source) {
-                    double x_pos = static_cast<double>(x) * dx;
-                    double y_pos = static_cast<double>(y) * dx;
-                    double t_new = current_time + dt;
-                    source_term = source_phi(t_new, x_pos, y_pos,
-                                            static_cast<int>(x), static_cast<int>(y));
-                }
-
-                // Accelerations at t+dt
-                phi_accel_new[idx] = c_sq * laplacian_phi
-                                   - gamma_phi * node.phi_dot
-                                   - 2.0 * lambda * node.phi * node.h * node.h
-                                   + source_term;
-
-                h_accel_new[idx] = c_sq * laplacian_h
-                                 - gamma_h * node.h_dot
-                                 - 2.0 * mu_sq * node.h
-                                 - 4.0 * lambda_h * node.h * node.h * node.h
-                                 - 2.0 * lambda * node.phi * node.phi * node.h;
-            }
+        // Step 3: Compute accelerations at t+dt (a(t) is no longer needed)
+        {
+            DASE_TRACE_ZONE("satp.accelerations");
+            computeAccelerations(nodes_temp, current_time + dt);
         }
 
         // Step 4: Complete velocity update using average acceleration
-        for (size_t i = 0; i < N_x * N_y; ++i) {
-            nodes_temp[i].phi_dot = nodes_temp[i].phi_dot + 0.5 * phi_accel_new[i] * dt;
-            nodes_temp[i].h_dot = nodes_temp[i].h_dot + 0.5 * h_accel_new[i] * dt;
+        for (size_t i = 0; i < N_total; ++i) {
+            const double phi_kick = 0.5 * phi_accel[i] * dt;
+            const double h_kick = 0.5 * h_accel[i] * dt;
+            nodes_temp[i].phi_dot = nodes_temp[i].phi_dot + phi_kick;
+            nodes_temp[i].h_dot = nodes_temp[i].h_dot + h_kick;
 
             // Update derived quantities
             nodes_temp[i].updateDerived();
+
+            // Carry a(t+dt) forward as the next a(t), with damping at v(t+dt)
+            phi_accel[i] -= gamma_phi * phi_kick;
+            h_accel[i] -= gamma_h * h_kick;
         }
 
         // Step 5: Swap buffers
@@ -178,9 +166,61 @@ inline void SATPHiggsEngine2D::evolve(size_t num_steps) {
         // Update simulation state
         current_time += dt;
         step_count++;
-        total_updates.fetch_add(N_x * N_y, std::memory_order_relaxed);
+        total_updates.fetch_add(N_total, std::memory_order_relaxed);
+    }
+
+    recordEvolve(num_steps, wall_start);
+    is_running.store(false);
+}
+
+// Temporally blocked path (satp_higgs_temporal_blocking.h): a(t) from the
+// reference force evaluation, then blocks of temporal_block_steps steps
+inline void SATPHiggsEngine2D::evolveBlocked(size_t num_steps) {
+    is_running.store(true);
+    const size_t N_total = N_x * N_y;
+
+    computeAccelerations(nodes, current_time);
+    blocking.evolve<2>(nodes, phi_accel, h_accel, params, N_x, N_y, 1, dx, dt, current_time,
+                        num_steps, temporal_block_steps,
+                        source_kind == SATPSourceKind::Separable ? source_profile.data() : nullptr,
+                        source_envelope);
+
+    step_count += num_steps;
+    total_updates.fetch_add(N_total * num_steps, std::memory_order_relaxed);
+    last_evolve_blocked = true;
+    is_running.store(false);
+}
+
+// Pseudo-spectral path (satp_higgs_spectral.h); sources of every kind are
+// evaluated into source_buf on the calling thread
+inline void SATPHiggsEngine2D::evolveSpectral(size_t num_steps) {
+    is_running.store(true);
+    const size_t N_total = N_x * N_y;
+    spectral.configure(N_x, N_y, 1, dx);   // No-op unless a checkpoint changed dx
+
+    SpectralSourceField source;
+    if (has_source) {
+        source_buf.resize(N_total);
+        source = [this](double t) -> const double* {
+            if (const double* field = prepareSourceField(t)) {
+                return field;
+            }
+            for (size_t y = 0; y < N_y; ++y) {
+                for (size_t x = 0; x < N_x; ++x) {
+                    source_buf[getIndex(x, y)] = source_phi(t, static_cast<double>(x) * dx,
+                                                            static_cast<double>(y) * dx,
+                                                            static_cast<int>(x), static_cast<int>(y));
+                }
+            }
+            return source_buf.data();
+        };
     }
+    spectral.evolve(nodes, params, laplacian_mode, dt, current_time, num_steps, source);
 
+    step_count += num_steps;
+    total_updates.fetch_add(N_total * num_steps, std::memory_order_relaxed);
+    last_evolve_blocked = false;
+    last_evolve_spectral = true;
     is_running.store(false);
 }
 
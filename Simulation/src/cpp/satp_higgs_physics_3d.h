@@ -11,15 +11,18 @@
 #pragma once
 
 #include "satp_higgs_engine_3d.h"
+#include "step_loop.h"
+#include "trace_zones.h"
+#include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace dase {
 namespace satp_higgs {
 
-// Velocity Verlet implementation for 3D wave equations
-inline void SATPHiggsEngine3D::evolve(size_t num_steps) {
-    is_running.store(true);
-
+// Accelerations for a field state at time t (fills phi_accel / h_accel)
+inline void SATPHiggsEngine3D::computeAccelerations(const std::vector<SATPHiggsNode>& state, double t) {
     const double c_sq = params.c * params.c;
     const double dx_sq = dx * dx;
     const double gamma_phi = params.gamma_phi;
@@ -27,83 +30,129 @@ inline void SATPHiggsEngine3D::evolve(size_t num_steps) {
     const double lambda = params.lambda;
     const double mu_sq = params.mu_squared;
     const double lambda_h = params.lambda_h;
+    const double* source_field = prepareSourceField(t);
+
+    for (size_t z = 0; z < N_z; ++z) {
+        for (size_t y = 0; y < N_y; ++y) {
+            for (size_t x = 0; x < N_x; ++x) {
+                size_t idx = getIndex(x, y, z);
+
+                // Neighbor indices (periodic boundaries)
+                size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
+                size_t x_next = (x + 1) % N_x;
+                size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
+                size_t y_next = (y + 1) % N_y;
+                size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
+                size_t z_next = (z + 1) % N_z;
+
+                size_t idx_xprev = getIndex(x_prev, y, z);
+                size_t idx_xnext = getIndex(x_next, y, z);
+                size_t idx_yprev = getIndex(x, y_prev, z);
+                size_t idx_ynext = getIndex(x, y_next, z);
+                size_t idx_zprev = getIndex(x, y, z_prev);
+                size_t idx_znext = getIndex(x, y, z_next);
+
+                const auto& node = state[idx];
+                const auto& node_xprev = state[idx_xprev];
+                const auto& node_xnext = state[idx_xnext];
+                const auto& node_yprev = state[idx_yprev];
+                const auto& node_ynext = state[idx_ynext];
+                const auto& node_zprev = state[idx_zprev];
+                const auto& node_znext = state[idx_znext];
+
+                // 3D Laplacian using 7-point stencil
+                // ∇²f = (f_{i-1,j,k} + f_{i+1,j,k} + f_{i,j-1,k} + f_{i,j+1,k} + f_{i,j,k-1} + f_{i,j,k+1} - 6f_{i,j,k}) / dx²
+                double laplacian_phi = (node_xprev.phi + node_xnext.phi +
+                                       node_yprev.phi + node_ynext.phi +
+                                       node_zprev.phi + node_znext.phi -
+                                       6.0 * node.phi) / dx_sq;
+
+                double laplacian_h = (node_xprev.h + node_xnext.h +
+                                     node_yprev.h + node_ynext.h +
+                                     node_zprev.h + node_znext.h -
+                                     6.0 * node.h) / dx_sq;
+
+                // Source term for φ field
+                double source_term = 0.0;
+                if (source_field) {
+                    source_term = source_field[idx];
+                } else if (has_source) {
+                    double x_pos = static_cast<double>(x) * dx;
+                    double y_pos = static_cast<double>(y) * dx;
+                    double z_pos = static_cast<double>(z) * dx;
+                    source_term = source_phi(t, x_pos, y_pos, z_pos,
+                                            static_cast<int>(x), static_cast<int>(y), static_cast<int>(z));
+                }
+
+                // φ equation: ∂²φ/∂t² = c²∇²φ - γ_φ ∂φ/∂t - 2λφh² + S(t,x,y,z)
+                phi_accel[idx] = c_sq * laplacian_phi
+                               - gamma_phi * node.phi_dot
+                               - 2.0 * lambda * node.phi * node.h * node.h
+                               + source_term;
+
+                // h equation: ∂²h/∂t² = c²∇²h - γ_h ∂h/∂t - 2μ²h - 4λ_h h³ - 2λφ²h
+                h_accel[idx] = c_sq * laplacian_h
+                             - gamma_h * node.h_dot
+                             - 2.0 * mu_sq * node.h
+                             - 4.0 * lambda_h * node.h * node.h * node.h
+                             - 2.0 * lambda * node.phi * node.phi * node.h;
+            }
+        }
+    }
+}
+
+// Velocity Verlet implementation for 3D wave equations
+//
+// One force evaluation per step: a(t+dt) from step 3 is carried into the
+// next step as its a(t).  It was evaluated with the half-step velocity, so
+// the (linear) damping term is shifted to v(t+dt) when the kick completes.
+inline void SATPHiggsEngine3D::evolve(size_t num_steps) {
+    DASE_TRACE_ZONE("satp.evolve");
+    const auto wall_start = std::chrono::steady_clock::now();
+    if (laplacian_mode != SATPLaplacianMode::FiniteDifference) {
+        evolveSpectral(num_steps);
+        recordEvolve(num_steps, wall_start);
+        return;
+    }
+    last_evolve_spectral = false;
+    if (device == ComputeDevice::GPU && evolveDevice(num_steps)) {
+        recordEvolve(num_steps, wall_start);
+        return;
+    }
+    last_evolve_device = false;
+    invalidateDevice();   // The host path writes nodes
+    if (temporal_block_steps > 1 && num_steps > 1 &&
+        (source_kind == SATPSourceKind::None || source_kind == SATPSourceKind::Separable)) {
+        evolveBlocked(num_steps);
+        recordEvolve(num_steps, wall_start);
+        return;
+    }
+    last_evolve_blocked = false;
+    if (stencil_mode != SATPStencilMode::Reference) {
+        evolveTiled(num_steps);
+        recordEvolve(num_steps, wall_start);
+        return;
+    }
+
+    is_running.store(true);
+
+    const size_t N_total = N_x * N_y * N_z;
+    const double gamma_phi = params.gamma_phi;
+    const double gamma_h = params.gamma_h;
+
+    // Step 1: Compute accelerations at t (once per call; then reused)
+    if (num_steps > 0) {
+        computeAccelerations(nodes, current_time);
+    }
 
     for (size_t step = 0; step < num_steps; ++step) {
+        DASE_TRACE_ZONE("satp.step");
+
         // Velocity Verlet: x(t+dt) = x(t) + v(t)*dt + 0.5*a(t)*dt²
         //                  v(t+dt) = v(t) + 0.5*[a(t) + a(t+dt)]*dt
 
-        // Step 1: Compute accelerations at t
-        std::vector<double> phi_accel(N_x * N_y * N_z);
-        std::vector<double> h_accel(N_x * N_y * N_z);
-
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t idx = getIndex(x, y, z);
-
-                    // Neighbor indices (periodic boundaries)
-                    size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
-                    size_t x_next = (x + 1) % N_x;
-                    size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
-                    size_t y_next = (y + 1) % N_y;
-                    size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
-                    size_t z_next = (z + 1) % N_z;
-
-                    size_t idx_xprev = getIndex(x_prev, y, z);
-                    size_t idx_xnext = getIndex(x_next, y, z);
-                    size_t idx_yprev = getIndex(x, y_prev, z);
-                    size_t idx_ynext = getIndex(x, y_next, z);
-                    size_t idx_zprev = getIndex(x, y, z_prev);
-                    size_t idx_znext = getIndex(x, y, z_next);
-
-                    const auto& node = nodes[idx];
-                    const auto& node_xprev = nodes[idx_xprev];
-                    const auto& node_xnext = nodes[idx_xnext];
-                    const auto& node_yprev = nodes[idx_yprev];
-                    const auto& node_ynext = nodes[idx_ynext];
-                    const auto& node_zprev = nodes[idx_zprev];
-                    const auto& node_znext = nodes[idx_znext];
-
-                    // 3D Laplacian using 7-point stencil
-                    // ∇²f = (f_{i-1,j,k} + f_{i+1,j,k} + f_{i,j-1,k} + f_{i,j+1,k} + f_{i,j,k-1} + f_{i,j,k+1} - 6f_{i,j,k}) / dx²
-                    double laplacian_phi = (node_xprev.phi + node_xnext.phi +
-                                           node_yprev.phi + node_ynext.phi +
-                                           node_zprev.phi + node_znext.phi -
-                                           6.0 * node.phi) / dx_sq;
-
-                    double laplacian_h = (node_xprev.h + node_xnext.h +
-                                         node_yprev.h + node_ynext.h +
-                                         node_zprev.h + node_znext.h -
-                                         6.0 * node.h) / dx_sq;
-
-                    // Source term for φ field
-                    double source_term = 0.0;
-                    if (has_source) {
-                        double x_pos = static_cast<double>(x) * dx;
-                        double y_pos = static_cast<double>(y) * dx;
-                        double z_pos = static_cast<double>(z) * dx;
-                        source_term = source_phi(current_time, x_pos, y_pos, z_pos,
-                                                static_cast<int>(x), static_cast<int>(y), static_cast<int>(z));
-                    }
-
-                    // φ equation: ∂²φ/∂t² = c²∇²φ - γ_φ ∂φ/∂t - 2λφh² + S(t,x,y,z)
-                    phi_accel[idx] = c_sq * laplacian_phi
-                                   - gamma_phi * node.phi_dot
-                                   - 2.0 * lambda * node.phi * node.h * node.h
-                                   + source_term;
-
-                    // h equation: ∂²h/∂t² = c²∇²h - γ_h ∂h/∂t - 2μ²h - 4λ_h h³ - 2λφ²h
-                    h_accel[idx] = c_sq * laplacian_h
-                                 - gamma_h * node.h_dot
-                                 - 2.0 * mu_sq * node.h
-                                 - 4.0 * lambda_h * node.h * node.h * node.h
-                                 - 2.0 * lambda * node.phi * node.phi * node.h;
-                }
-            }
-        }
-
         // Step 2: Update positions and half-step velocities
-        for (size_t i = 0; i < N_x * N_y * N_z; ++i) {
+        for (size_t i = 0; i < N_total; ++i) {
             auto& node = nodes_temp[i];
             node = nodes[i];
 
@@ -116,82 +165,25 @@ inline void SATPHiggsEngine3D::evolve(size_t num_steps) {
             node.h_dot = node.h_dot + 0.5 * h_accel[i] * dt;
         }
 
-        // Step 3: Compute accelerations at t+dt
-        std::vector<double> phi_accel_new(N_x * N_y * N_z);
-        std::vector<double> h_accel_new(N_x * N_y * N_z);
-
-        for (size_t z = 0; z < N_z; ++z) {
-            for (size_t y = 0; y < N_y; ++y) {
-                for (size_t x = 0; x < N_x; ++x) {
-                    size_t idx = getIndex(x, y, z);
-
-                    // Neighbor indices
-                    size_t x_prev = (x == 0) ? N_x - 1 : x - 1;
-                    size_t x_next = (x + 1) % N_x;
-                    size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
-                    size_t y_next = (y + 1) % N_y;
-                    size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
-                    size_t z_next = (z + 1) % N_z;
-
-                    size_t idx_xprev = getIndex(x_prev, y, z);
-                    size_t idx_xnext = getIndex(x_next, y, z);
-                    size_t idx_yprev = getIndex(x, y_prev, z);
-                    size_t idx_ynext = getIndex(x, y_next, z);
-                    size_t idx_zprev = getIndex(x, y, z_prev);
-                    size_t idx_znext = getIndex(x, y, z_next);
-
-                    const auto& node = nodes_temp[idx];
-                    const auto& node_xprev = nodes_temp[idx_xprev];
-                    const auto& node_xnext = nodes_temp[idx_xnext];
-                    const auto& node_yprev = nodes_temp[idx_yprev];
-                    const auto& node_ynext = nodes_temp[idx_ynext];
-                    const auto& node_zprev = nodes_temp[idx_zprev];
-                    const auto& node_znext = nodes_temp[idx_znext];
-
-                    // 3D Laplacian at t+dt
-                    double laplacian_phi = (node_xprev.phi + node_xnext.phi +
-                                           node_yprev.phi + node_ynext.phi +
-                                           node_zprev.phi + node_znext.phi -
-                                           6.0 * node.phi) / dx_sq;
-
-                    double laplacian_h = (node_xprev.h + node_xnext.h +
-                                         node_yprev.h + node_ynext.h +
-                                         node_zprev.h + node_znext.h -
-                                         6.0 * node.h) / dx_sq;
-
-                    // Source term at t+dt
-                    double source_term = 0.0;
-                    if (has_source) {
-                        double x_pos = static_cast<double>(x) * dx;
-                        double y_pos = static_cast<double>(y) * dx;
-                        double z_pos = static_cast<double>(z) * dx;
-                        double t_new = current_time + dt;
-                        source_term = source_phi(t_new, x_pos, y_pos, z_pos,
-                                                static_cast<int>(x), static_cast<int>(y), static_cast<int>(z));
-                    }
-
-                    // Accelerations at t+dt
-                    phi_accel_new[idx] = c_sq * laplacian_phi
-                                       - gamma_phi * node.phi_dot
-                                       - 2.0 * lambda * node.phi * node.h * node.h
-                                       + source_term;
-
-                    h_accel_new[idx] = c_sq * laplacian_h
-                                     - gamma_h * node.h_dot
-                                     - 2.0 * mu_sq * node.h
-                                     - 4.0 * lambda_h * node.h * node.h * node.h
-                                     - 2.0 * lambda * node.phi * node.phi * node.h;
-                }
-            }
+        // Step 3: Compute accelerations at t+dt (a(t) is no longer needed)
+        {
+            DASE_TRACE_ZONE("satp.accelerations");
+            computeAccelerations(nodes_temp, current_time + dt);
         }
 
         // Step 4: Complete velocity update using average acceleration
-        for (size_t i = 0; i < N_x * N_y * N_z; ++i) {
-            nodes_temp[i].phi_dot = nodes_temp[i].phi_dot + 0.5 * phi_accel_new[i] * dt;
-            nodes_temp[i].h_dot = nodes_temp[i].h_dot + 0.5 * h_accel_new[i] * dt;
+        for (size_t i = 0; i < N_total; ++i) {
+            const double phi_kick = 0.5 * phi_accel[i] * dt;
+            const double h_kick = 0.5 * h_accel[i] * dt;
+            nodes_temp[i].phi_dot = nodes_temp[i].phi_dot + phi_kick;
+            nodes_temp[i].h_dot = nodes_temp[i].h_dot + h_kick;
 
             // Update derived quantities
             nodes_temp[i].updateDerived();
+
+            // Carry a(t+dt) forward as the next a(t), with damping at v(t+dt)
+            phi_accel[i] -= gamma_phi * phi_kick;
+            h_accel[i] -= gamma_h * h_kick;
         }
 
         // Step 5: Swap buffers
@@ -200,10 +192,598 @@ inline void SATPHiggsEngine3D::evolve(size_t num_steps) {
         // Update simulation state
         current_time += dt;
         step_count++;
-        total_updates.fetch_add(N_x * N_y * N_z, std::memory_order_relaxed);
+        total_updates.fetch_add(N_total, std::memory_order_relaxed);
+    }
+
+    recordEvolve(num_steps, wall_start);
+    is_running.store(false);
+}
+
+// ----------------------------------------------------------------------------
+// Tiled path
+//
+// Same integrator and arithmetic as the reference path above, restructured
+// for throughput:
+// - φ, φ̇, h, ḣ live in packed SoA arrays for the whole evolve() call (nodes
+//   are gathered on entry and scattered, with updateDerived(), on exit).
+// - The Laplacian runs per x-row.  The four y/z neighbour rows are resolved
+//   with one periodic wrap per row, so the row interior (1 ≤ x ≤ N_x-2) is
+//   a branch-free, modulo-free unit-stride loop; only the two row-end cells
+//   wrap in x.
+// - Rows are grouped into tiles of SATP_TILE_ROWS consecutive y-rows of one
+//   z-plane (≈ 5 rows × N_x × 2 fields in cache) and tiles are shared across
+//   OpenMP threads.
+//
+// Each cell sums its terms in the reference order, so results are
+// bit-identical to SATPStencilMode::Reference (provided the compiler does
+// not contract the two paths into FMAs differently, e.g. -ffp-contract=off).
+// Sources are evaluated on one thread into source_buf: point-wise callbacks
+// need not be thread-safe, and Batch / Separable sources fill it in one pass.
+// ----------------------------------------------------------------------------
+
+#ifndef SATP_TILE_ROWS
+#define SATP_TILE_ROWS 8
+#endif
+
+#ifndef SATP_BRICK_EDGE
+#define SATP_BRICK_EDGE 8
+#endif
+
+#ifndef SATP_OMP_MIN_CELLS
+#define SATP_OMP_MIN_CELLS 4096
+#endif
+
+// S(t, ·) into source_buf (row-major) on one thread of the team
+inline void SATPHiggsEngine3D::fillSourceBuffer(double t) {
+    if (has_source) {
+        #pragma omp single
+        {
+            // Batch / Separable sources fill source_buf directly
+            if (!prepareSourceField(t)) {
+                for (size_t z = 0; z < N_z; ++z) {
+                    for (size_t y = 0; y < N_y; ++y) {
+                        for (size_t x = 0; x < N_x; ++x) {
+                            double x_pos = static_cast<double>(x) * dx;
+                            double y_pos = static_cast<double>(y) * dx;
+                            double z_pos = static_cast<double>(z) * dx;
+                            source_buf[getIndex(x, y, z)] = source_phi(t, x_pos, y_pos, z_pos,
+                                static_cast<int>(x), static_cast<int>(y), static_cast<int>(z));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Accelerations from the SoA state at time t (orphaned worksharing)
+inline void SATPHiggsEngine3D::computeAccelerationsTiled(double t) {
+    const double c_sq = params.c * params.c;
+    const double dx_sq = dx * dx;
+    const double gamma_phi = params.gamma_phi;
+    const double gamma_h = params.gamma_h;
+    const double lambda = params.lambda;
+    const double mu_sq = params.mu_squared;
+    const double lambda_h = params.lambda_h;
+
+    const size_t plane = N_x * N_y;
+    const double* phi = soa_phi.data();
+    const double* phi_dot = soa_phi_dot.data();
+    const double* h = soa_h.data();
+    const double* h_dot = soa_h_dot.data();
+    const double* src = source_buf.data();
+    double* a_phi = phi_accel.data();
+    double* a_h = h_accel.data();
+
+    fillSourceBuffer(t);
+
+    // One cell: i = centre, the six neighbour indices are given explicitly
+    auto cell = [&](size_t i, size_t ixp, size_t ixn, size_t iyp, size_t iyn, size_t izp, size_t izn) {
+        double laplacian_phi = (phi[ixp] + phi[ixn] +
+                                phi[iyp] + phi[iyn] +
+                                phi[izp] + phi[izn] -
+                                6.0 * phi[i]) / dx_sq;
+        double laplacian_h = (h[ixp] + h[ixn] +
+                              h[iyp] + h[iyn] +
+                              h[izp] + h[izn] -
+                              6.0 * h[i]) / dx_sq;
+        a_phi[i] = c_sq * laplacian_phi
+                 - gamma_phi * phi_dot[i]
+                 - 2.0 * lambda * phi[i] * h[i] * h[i]
+                 + src[i];
+        a_h[i] = c_sq * laplacian_h
+               - gamma_h * h_dot[i]
+               - 2.0 * mu_sq * h[i]
+               - 4.0 * lambda_h * h[i] * h[i] * h[i]
+               - 2.0 * lambda * phi[i] * phi[i] * h[i];
+    };
+
+    const size_t tiles_y = (N_y + SATP_TILE_ROWS - 1) / SATP_TILE_ROWS;
+    const int64_t num_tiles = static_cast<int64_t>(N_z * tiles_y);
+
+    #pragma omp for schedule(static)
+    for (int64_t tile = 0; tile < num_tiles; ++tile) {
+        const size_t z = static_cast<size_t>(tile) / tiles_y;
+        const size_t y_begin = (static_cast<size_t>(tile) % tiles_y) * SATP_TILE_ROWS;
+        const size_t y_end = std::min(y_begin + SATP_TILE_ROWS, N_y);
+
+        const size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
+        const size_t z_next = (z + 1 == N_z) ? 0 : z + 1;
+
+        for (size_t y = y_begin; y < y_end; ++y) {
+            const size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
+            const size_t y_next = (y + 1 == N_y) ? 0 : y + 1;
+
+            // Row base indices (x = 0) of the centre row and its neighbours
+            const size_t row = z * plane + y * N_x;
+            const size_t row_yp = z * plane + y_prev * N_x;
+            const size_t row_yn = z * plane + y_next * N_x;
+            const size_t row_zp = z_prev * plane + y * N_x;
+            const size_t row_zn = z_next * plane + y * N_x;
+
+            // Row-end halo cells (periodic wrap in x)
+            cell(row, row + N_x - 1, row + (N_x > 1 ? 1 : 0), row_yp, row_yn, row_zp, row_zn);
+            if (N_x < 2) continue;
+            const size_t last = N_x - 1;
+            cell(row + last, row + last - 1, row,
+                 row_yp + last, row_yn + last, row_zp + last, row_zn + last);
+
+            // Row interior: unit-stride, no wrap
+            const double* pc = phi + row;
+            const double* pyp = phi + row_yp;
+            const double* pyn = phi + row_yn;
+            const double* pzp = phi + row_zp;
+            const double* pzn = phi + row_zn;
+            const double* hc = h + row;
+            const double* hyp = h + row_yp;
+            const double* hyn = h + row_yn;
+            const double* hzp = h + row_zp;
+            const double* hzn = h + row_zn;
+            const double* pd = phi_dot + row;
+            const double* hd = h_dot + row;
+            const double* sr = src + row;
+            double* ap = a_phi + row;
+            double* ah = a_h + row;
+
+            #pragma omp simd
+            for (size_t x = 1; x < last; ++x) {
+                double laplacian_phi = (pc[x - 1] + pc[x + 1] +
+                                        pyp[x] + pyn[x] +
+                                        pzp[x] + pzn[x] -
+                                        6.0 * pc[x]) / dx_sq;
+                double laplacian_h = (hc[x - 1] + hc[x + 1] +
+                                      hyp[x] + hyn[x] +
+                                      hzp[x] + hzn[x] -
+                                      6.0 * hc[x]) / dx_sq;
+                ap[x] = c_sq * laplacian_phi
+                      - gamma_phi * pd[x]
+                      - 2.0 * lambda * pc[x] * hc[x] * hc[x]
+                      + sr[x];
+                ah[x] = c_sq * laplacian_h
+                      - gamma_h * hd[x]
+                      - 2.0 * mu_sq * hc[x]
+                      - 4.0 * lambda_h * hc[x] * hc[x] * hc[x]
+                      - 2.0 * lambda * pc[x] * pc[x] * hc[x];
+            }
+        }
     }
+}
 
+// Bricked variant (SATPStencilMode::Bricked): the SoA state and a(t) are in
+// brick_layout order, source_buf stays row-major.  Bricks are shared across
+// threads; each brick row is unit-stride in both orders, and its y / z
+// neighbour rows are brick rows too (of this brick, or of the face
+// neighbour's), so only the two row-end cells resolve their x neighbour
+// through the layout.  Same per-cell arithmetic as the tiled kernel.
+inline void SATPHiggsEngine3D::computeAccelerationsBricked(double t) {
+    const double c_sq = params.c * params.c;
+    const double dx_sq = dx * dx;
+    const double gamma_phi = params.gamma_phi;
+    const double gamma_h = params.gamma_h;
+    const double lambda = params.lambda;
+    const double mu_sq = params.mu_squared;
+    const double lambda_h = params.lambda_h;
+
+    const BrickLayout3D& layout = brick_layout;
+    const double* phi = soa_phi.data();
+    const double* phi_dot = soa_phi_dot.data();
+    const double* h = soa_h.data();
+    const double* h_dot = soa_h_dot.data();
+    const double* src = source_buf.data();
+    double* a_phi = phi_accel.data();
+    double* a_h = h_accel.data();
+
+    fillSourceBuffer(t);
+
+    // One cell: slot i, row-major source index s, six neighbour slots
+    auto cell = [&](size_t i, size_t s, size_t ixp, size_t ixn, size_t iyp, size_t iyn, size_t izp, size_t izn) {
+        double laplacian_phi = (phi[ixp] + phi[ixn] +
+                                phi[iyp] + phi[iyn] +
+                                phi[izp] + phi[izn] -
+                                6.0 * phi[i]) / dx_sq;
+        double laplacian_h = (h[ixp] + h[ixn] +
+                              h[iyp] + h[iyn] +
+                              h[izp] + h[izn] -
+                              6.0 * h[i]) / dx_sq;
+        a_phi[i] = c_sq * laplacian_phi
+                 - gamma_phi * phi_dot[i]
+                 - 2.0 * lambda * phi[i] * h[i] * h[i]
+                 + src[s];
+        a_h[i] = c_sq * laplacian_h
+               - gamma_h * h_dot[i]
+               - 2.0 * mu_sq * h[i]
+               - 4.0 * lambda_h * h[i] * h[i] * h[i]
+               - 2.0 * lambda * phi[i] * phi[i] * h[i];
+    };
+
+    const int64_t num_bricks = static_cast<int64_t>(layout.numBricks());
+
+    #pragma omp for schedule(static)
+    for (int64_t b = 0; b < num_bricks; ++b) {
+        size_t x0, y0, z0, extent_x, extent_y, extent_z;
+        layout.brickBounds(static_cast<size_t>(b), x0, y0, z0, extent_x, extent_y, extent_z);
+        const size_t x_prev = (x0 == 0) ? N_x - 1 : x0 - 1;
+        const size_t x_next = (x0 + extent_x == N_x) ? 0 : x0 + extent_x;
+        const size_t last = extent_x - 1;
+
+        for (size_t z = z0; z < z0 + extent_z; ++z) {
+            const size_t z_prev = (z == 0) ? N_z - 1 : z - 1;
+            const size_t z_next = (z + 1 == N_z) ? 0 : z + 1;
+
+            for (size_t y = y0; y < y0 + extent_y; ++y) {
+                const size_t y_prev = (y == 0) ? N_y - 1 : y - 1;
+                const size_t y_next = (y + 1 == N_y) ? 0 : y + 1;
+
+                // Brick-row base slots (x = x0) of the centre row and its neighbours
+                const size_t row = layout.index(x0, y, z);
+                const size_t row_yp = layout.index(x0, y_prev, z);
+                const size_t row_yn = layout.index(x0, y_next, z);
+                const size_t row_zp = layout.index(x0, y, z_prev);
+                const size_t row_zn = layout.index(x0, y, z_next);
+                const size_t src_row = getIndex(x0, y, z);
+
+                // Row-end cells: x neighbours across the brick face (or the wrap)
+                const size_t halo_xp = layout.index(x_prev, y, z);
+                const size_t halo_xn = layout.index(x_next, y, z);
+                if (last == 0) {
+                    cell(row, src_row, halo_xp, halo_xn, row_yp, row_yn, row_zp, row_zn);
+                    continue;
+                }
+                cell(row, src_row, halo_xp, row + 1, row_yp, row_yn, row_zp, row_zn);
+                cell(row + last, src_row + last, row + last - 1, halo_xn,
+                     row_yp + last, row_yn + last, row_zp + last, row_zn + last);
+
+                // Row interior: unit-stride, no wrap
+                const double* pc = phi + row;
+                const double* pyp = phi + row_yp;
+                const double* pyn = phi + row_yn;
+                const double* pzp = phi + row_zp;
+                const double* pzn = phi + row_zn;
+                const double* hc = h + row;
+                const double* hyp = h + row_yp;
+                const double* hyn = h + row_yn;
+                const double* hzp = h + row_zp;
+                const double* hzn = h + row_zn;
+                const double* pd = phi_dot + row;
+                const double* hd = h_dot + row;
+                const double* sr = src + src_row;
+                double* ap = a_phi + row;
+                double* ah = a_h + row;
+
+                #pragma omp simd
+                for (size_t x = 1; x < last; ++x) {
+                    double laplacian_phi = (pc[x - 1] + pc[x + 1] +
+                                            pyp[x] + pyn[x] +
+                                            pzp[x] + pzn[x] -
+                                            6.0 * pc[x]) / dx_sq;
+                    double laplacian_h = (hc[x - 1] + hc[x + 1] +
+                                          hyp[x] + hyn[x] +
+                                          hzp[x] + hzn[x] -
+                                          6.0 * hc[x]) / dx_sq;
+                    ap[x] = c_sq * laplacian_phi
+                          - gamma_phi * pd[x]
+                          - 2.0 * lambda * pc[x] * hc[x] * hc[x]
+                          + sr[x];
+                    ah[x] = c_sq * laplacian_h
+                          - gamma_h * hd[x]
+                          - 2.0 * mu_sq * hc[x]
+                          - 4.0 * lambda_h * hc[x] * hc[x] * hc[x]
+                          - 2.0 * lambda * pc[x] * pc[x] * hc[x];
+                }
+            }
+        }
+    }
+}
+
+// Padded variant (SATPStencilMode::Padded): the SoA state and a(t) are in
+// halo_layout order with one ghost layer per side, source_buf stays
+// row-major.  The φ / h halos are refreshed from the periodic image first
+// (φ̇ / ḣ are only read at the cell itself), after which every cell of every
+// row - the row ends included - reads its six neighbours at constant
+// offsets.  Same per-cell arithmetic as the tiled kernel.
+inline void SATPHiggsEngine3D::computeAccelerationsPadded(double t) {
+    const double c_sq = params.c * params.c;
+    const double dx_sq = dx * dx;
+    const double gamma_phi = params.gamma_phi;
+    const double gamma_h = params.gamma_h;
+    const double lambda = params.lambda;
+    const double mu_sq = params.mu_squared;
+    const double lambda_h = params.lambda_h;
+
+    const HaloLayout3D& layout = halo_layout;
+    const size_t stride_y = layout.strideY();
+    const size_t stride_z = layout.strideZ();
+    const double* phi = soa_phi.data();
+    const double* phi_dot = soa_phi_dot.data();
+    const double* h = soa_h.data();
+    const double* h_dot = soa_h_dot.data();
+    const double* src = source_buf.data();
+    double* a_phi = phi_accel.data();
+    double* a_h = h_accel.data();
+
+    fillSourceBuffer(t);
+    layout.refreshHalo(soa_phi.data());
+    layout.refreshHalo(soa_h.data());
+
+    const int64_t num_rows = static_cast<int64_t>(N_y * N_z);
+
+    #pragma omp for schedule(static)
+    for (int64_t r = 0; r < num_rows; ++r) {
+        const size_t y = static_cast<size_t>(r) % N_y;
+        const size_t z = static_cast<size_t>(r) / N_y;
+        const size_t row = layout.index(0, y, z);
+
+        const double* pc = phi + row;
+        const double* pxp = pc - 1;
+        const double* pxn = pc + 1;
+        const double* pyp = pc - stride_y;
+        const double* pyn = pc + stride_y;
+        const double* pzp = pc - stride_z;
+        const double* pzn = pc + stride_z;
+        const double* hc = h + row;
+        const double* hxp = hc - 1;
+        const double* hxn = hc + 1;
+        const double* hyp = hc - stride_y;
+        const double* hyn = hc + stride_y;
+        const double* hzp = hc - stride_z;
+        const double* hzn = hc + stride_z;
+        const double* pd = phi_dot + row;
+        const double* hd = h_dot + row;
+        const double* sr = src + getIndex(0, y, z);
+        double* ap = a_phi + row;
+        double* ah = a_h + row;
+
+        #pragma omp simd
+        for (size_t x = 0; x < N_x; ++x) {
+            double laplacian_phi = (pxp[x] + pxn[x] +
+                                    pyp[x] + pyn[x] +
+                                    pzp[x] + pzn[x] -
+                                    6.0 * pc[x]) / dx_sq;
+            double laplacian_h = (hxp[x] + hxn[x] +
+                                  hyp[x] + hyn[x] +
+                                  hzp[x] + hzn[x] -
+                                  6.0 * hc[x]) / dx_sq;
+            ap[x] = c_sq * laplacian_phi
+                  - gamma_phi * pd[x]
+                  - 2.0 * lambda * pc[x] * hc[x] * hc[x]
+                  + sr[x];
+            ah[x] = c_sq * laplacian_h
+                  - gamma_h * hd[x]
+                  - 2.0 * mu_sq * hc[x]
+                  - 4.0 * lambda_h * hc[x] * hc[x] * hc[x]
+                  - 2.0 * lambda * pc[x] * pc[x] * hc[x];
+        }
+    }
+}
+
+inline void SATPHiggsEngine3D::evolveTiled(size_t num_steps) {
+    if (num_steps == 0) return;
+    is_running.store(true);
+
+    const size_t N_total = N_x * N_y * N_z;
+    const double gamma_phi = params.gamma_phi;
+    const double gamma_h = params.gamma_h;
+
+    // Bricked storage is padded to whole bricks, Padded storage carries
+    // ghost layers (neither kind of extra slot is mapped; the local steps
+    // below update them harmlessly, and halos are refreshed before use)
+    const bool bricked = (stencil_mode == SATPStencilMode::Bricked);
+    const bool padded = (stencil_mode == SATPStencilMode::Padded);
+    if (bricked) {
+        brick_layout = BrickLayout3D(N_x, N_y, N_z, SATP_BRICK_EDGE);
+    }
+    if (padded) {
+        halo_layout = HaloLayout3D(N_x, N_y, N_z, 1, 1, 1);
+    }
+    const size_t N_store = bricked ? brick_layout.storageSize()
+                         : padded  ? halo_layout.storageSize()
+                                   : N_total;
+    if (soa_phi.size() != N_store) {
+        soa_phi.assign(N_store, 0.0);
+        soa_phi_dot.assign(N_store, 0.0);
+        soa_h.assign(N_store, 0.0);
+        soa_h_dot.assign(N_store, 0.0);
+    }
+    if (phi_accel.size() < N_store) {
+        phi_accel.resize(N_store, 0.0);
+        h_accel.resize(N_store, 0.0);
+    }
+    source_buf.resize(N_total);
+    if (!has_source) {
+        // The reference path adds a 0.0 source term; keep the same arithmetic
+        std::fill(source_buf.begin(), source_buf.end(), 0.0);
+    }
+
+    // Rows that are contiguous both in nodes and in the SoA mirror (the
+    // whole lattice for the row-major layout)
+    auto for_each_row = [&](auto&& row) {
+        if (bricked) {
+            brick_layout.forEachRow(row);
+        } else if (padded) {
+            halo_layout.forEachRow(row);
+        } else {
+            row(size_t(0), size_t(0), N_total);
+        }
+    };
+
+    // Gather nodes into the SoA mirror (picks up external edits)
+    for_each_row([&](size_t logical, size_t slot, size_t length) {
+        for (size_t x = 0; x < length; ++x) {
+            soa_phi[slot + x] = nodes[logical + x].phi;
+            soa_phi_dot[slot + x] = nodes[logical + x].phi_dot;
+            soa_h[slot + x] = nodes[logical + x].h;
+            soa_h_dot[slot + x] = nodes[logical + x].h_dot;
+        }
+    });
+
+    double* phi = soa_phi.data();
+    double* phi_dot = soa_phi_dot.data();
+    double* h = soa_h.data();
+    double* h_dot = soa_h_dot.data();
+    double* a_phi = phi_accel.data();
+    double* a_h = h_accel.data();
+    const int64_t N_loop = static_cast<int64_t>(N_store);
+    auto accelerations = [&](double t) {
+        if (bricked) {
+            computeAccelerationsBricked(t);
+        } else if (padded) {
+            computeAccelerationsPadded(t);
+        } else {
+            computeAccelerationsTiled(t);
+        }
+    };
+
+    // Step 1: Compute accelerations at t (once per call; then reused)
+    #pragma omp parallel if(N_total >= SATP_OMP_MIN_CELLS)
+    accelerations(current_time);
+
+    // One team for every step (step_loop.h); the clock advances between steps
+    uint64_t unused_operations = 0;
+    StepLoop::run(num_steps, N_total >= SATP_OMP_MIN_CELLS,
+        [&](uint64_t) -> uint64_t {
+            DASE_TRACE_ZONE("satp.step");
+            const double t_next = current_time + dt;
+
+            // Step 2: Update positions and half-step velocities (in place:
+            // purely local, and a(t) is not needed after this loop)
+            #pragma omp for simd schedule(static)
+            for (int64_t i = 0; i < N_loop; ++i) {
+                phi[i] = phi[i] + phi_dot[i] * dt + 0.5 * a_phi[i] * dt * dt;
+                h[i] = h[i] + h_dot[i] * dt + 0.5 * a_h[i] * dt * dt;
+                phi_dot[i] = phi_dot[i] + 0.5 * a_phi[i] * dt;
+                h_dot[i] = h_dot[i] + 0.5 * a_h[i] * dt;
+            }
+
+            // Step 3: Compute accelerations at t+dt (zone per team thread)
+            {
+                DASE_TRACE_ZONE("satp.accelerations");
+                accelerations(t_next);
+            }
+
+            // Step 4: Complete velocity update; carry a(t+dt) forward
+            #pragma omp for simd schedule(static)
+            for (int64_t i = 0; i < N_loop; ++i) {
+                const double phi_kick = 0.5 * a_phi[i] * dt;
+                const double h_kick = 0.5 * a_h[i] * dt;
+                phi_dot[i] = phi_dot[i] + phi_kick;
+                h_dot[i] = h_dot[i] + h_kick;
+                a_phi[i] -= gamma_phi * phi_kick;
+                a_h[i] -= gamma_h * h_kick;
+            }
+            return 0;
+        },
+        [&](uint64_t) {
+            // Update simulation state
+            current_time += dt;
+            step_count++;
+            total_updates.fetch_add(N_total, std::memory_order_relaxed);
+            return true;
+        },
+        unused_operations);
+
+    // Scatter back to the authoritative nodes
+    for_each_row([&](size_t logical, size_t slot, size_t length) {
+        for (size_t x = 0; x < length; ++x) {
+            auto& node = nodes[logical + x];
+            node.phi = soa_phi[slot + x];
+            node.phi_dot = soa_phi_dot[slot + x];
+            node.h = soa_h[slot + x];
+            node.h_dot = soa_h_dot[slot + x];
+            node.updateDerived();
+        }
+    });
+
+    is_running.store(false);
+}
+
+// Temporally blocked path (satp_higgs_temporal_blocking.h): a(t) from the
+// reference force evaluation, then blocks of temporal_block_steps steps
+inline void SATPHiggsEngine3D::evolveBlocked(size_t num_steps) {
+    is_running.store(true);
+    const size_t N_total = N_x * N_y * N_z;
+
+    computeAccelerations(nodes, current_time);
+    blocking.evolve<3>(nodes, phi_accel, h_accel, params, N_x, N_y, N_z, dx, dt, current_time,
+                        num_steps, temporal_block_steps,
+                        source_kind == SATPSourceKind::Separable ? source_profile.data() : nullptr,
+                        source_envelope);
+
+    step_count += num_steps;
+    total_updates.fetch_add(N_total * num_steps, std::memory_order_relaxed);
+    last_evolve_blocked = true;
+    is_running.store(false);
+}
+
+// Pseudo-spectral path (satp_higgs_spectral.h), on the host; sources of
+// every kind are evaluated into source_buf on the calling thread
+inline void SATPHiggsEngine3D::evolveSpectral(size_t num_steps) {
+    last_evolve_device = false;
+    invalidateDevice();   // The host path writes nodes
+    is_running.store(true);
+    const size_t N_total = N_x * N_y * N_z;
+    spectral.configure(N_x, N_y, N_z, dx);   // No-op unless a checkpoint changed dx
+
+    SpectralSourceField source;
+    if (has_source) {
+        source_buf.resize(N_total);
+        source = [this](double t) -> const double* {
+            fillSourceBuffer(t);
+            return source_buf.data();
+        };
+    }
+    spectral.evolve(nodes, params, laplacian_mode, dt, current_time, num_steps, source);
+
+    step_count += num_steps;
+    total_updates.fetch_add(N_total * num_steps, std::memory_order_relaxed);
+    last_evolve_blocked = false;
+    last_evolve_spectral = true;
+    is_running.store(false);
+}
+
+// Device path (satp_higgs_gpu_backend_3d.h): upload if the host copy
+// changed, then step the resident fields
+inline bool SATPHiggsEngine3D::evolveDevice(size_t num_steps) {
+    if (!SATPHiggsGpuBackend3D::supported(source_kind)) {
+        return false;
+    }
+    if (!device_current) {
+        device_current = gpu.upload(nodes, N_x, N_y, N_z,
+                                    source_kind == SATPSourceKind::Separable ? source_profile.data() : nullptr);
+        if (!device_current) {
+            return false;
+        }
+    }
+    is_running.store(true);
+    gpu.run(params, dx, dt, current_time, num_steps, source_envelope);
+    if (num_steps > 0) {
+        host_stale = true;
+    }
+    step_count += num_steps;
+    total_updates.fetch_add(getN() * num_steps, std::memory_order_relaxed);
+    last_evolve_blocked = false;
+    last_evolve_device = true;
     is_running.store(false);
+    return true;
 }
 
 // CFL stability check for 3D
@@ -0,0 +1,494 @@
+/**
+ * SATP+Higgs Pseudo-Spectral Evolution
+ *
+ * Alternative spatial discretisation for SATPHiggsEngine2D/3D
+ * (setLaplacianMode): ∇² is applied exactly on the periodic lattice as
+ * IFFT(-|k|² FFT(f)), k_a = 2π m_a / (N_a dx), instead of the second-order
+ * 5- / 7-point stencil.  Smooth fields converge spectrally, so the same
+ * accuracy needs several times fewer cells per axis.
+ *
+ * Two integrators share the spectral operator:
+ *
+ * - Spectral: the reference velocity Verlet (a(t+dt) carried forward,
+ *   damping shifted to v(t+dt)) with the FFT Laplacian.  Explicit, so dt
+ *   is bounded by the highest mode: c·dt ≤ 2 dx / (π √d)
+ *   (maxStableTimestepSpectral).
+ * - SpectralETD: exponential time differencing for the linear wave part.
+ *   Each Fourier mode of u_tt = c²∇²u is a harmonic oscillator at
+ *   ω = c|k| and is advanced exactly (a rotation of (û, v̂) by ω·dt); the
+ *   local terms (damping, Higgs potential, φ-h coupling, source) are
+ *   Strang-split around it as half kicks.  Second order, symplectic for
+ *   γ = 0, and free of the wave CFL limit: dt is set by the local terms.
+ *
+ * Plans are R2C / C2R (out of place, one per lattice shape) from the
+ * process-wide FFTPlanRegistry and run on this solver's SoA state through
+ * fftw_execute_dft_r2c / _c2r.  The state is gathered from the nodes on
+ * entry to evolve() and scattered (with updateDerived()) on exit.
+ *
+ * The FFTW-backed implementation is compiled when USE_FFTW3 is defined;
+ * otherwise isAvailable() is false, configure() fails and the engines keep
+ * the finite-difference path.
+ */
+
+#pragma once
+
+#include "aligned_allocator.h"
+#include "engine_memory.h"
+#include "kernel_traffic.h"
+#include "satp_higgs_engine_1d.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#ifdef USE_FFTW3
+#include "fftw_plan_registry.hpp"
+#include <stdexcept>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#ifndef SATP_OMP_MIN_CELLS
+#define SATP_OMP_MIN_CELLS 4096
+#endif
+
+namespace dase {
+namespace satp_higgs {
+
+// Spatial discretisation of ∇² (and the integrator that goes with it)
+enum class SATPLaplacianMode {
+    FiniteDifference,  // 5-point (2D) / 7-point (3D) stencil, velocity Verlet
+    Spectral,          // FFT ∇², velocity Verlet
+    SpectralETD        // FFT ∇², linear wave part advanced exactly per mode
+};
+
+// S(t, ·) row-major for the whole lattice, or nullptr for no source
+using SpectralSourceField = std::function<const double*(double t)>;
+
+/**
+ * Largest stable dt of the Spectral (Verlet) mode, with the 0.95 safety
+ * factor of computeMaxStableTimestep2D/3D: the top mode |k| = π√d/dx must
+ * satisfy ω·dt ≤ 2
+ */
+inline double maxStableTimestepSpectral(double c, double dx, int dims) {
+    constexpr double safety_factor = 0.95;
+    return safety_factor * 2.0 * dx / (c * M_PI * std::sqrt(static_cast<double>(dims)));
+}
+
+/**
+ * Modelled traffic of one spectral step: the SoA update / force passes of
+ * the tiled path plus 4 (Spectral) or 8 (SpectralETD) real transforms,
+ * each streaming its input and output once at 2.5 n log₂ n FLOPs
+ */
+inline KernelTraffic satpSpectralStepTraffic(size_t cells, SATPLaplacianMode mode, SATPSourceKind source) {
+    const double n = static_cast<double>(cells);
+    const double value = static_cast<double>(sizeof(double));
+    const double transforms = mode == SATPLaplacianMode::SpectralETD ? 8.0 : 4.0;
+    const double fft_flops = 2.5 * std::log2(std::max(n, 2.0));
+
+    KernelTraffic step;
+    step += kernelPass(n, 6.0 * value, 4.0 * value, 10.0);
+    step += kernelPass(n, (4.0 + (source != SATPSourceKind::None ? 1.0 : 0.0)) * value, 2.0 * value, 25.0);
+    step += kernelPass(n, 4.0 * value, 4.0 * value, 10.0);
+    for (int i = 0; i < static_cast<int>(transforms); ++i) {
+        step += kernelPass(n, value, value, fft_flops);
+    }
+    return step;
+}
+
+class SATPSpectralSolver {
+public:
+    using ScratchArray = std::vector<double, aligned_allocator<double, 64>>;
+
+    SATPSpectralSolver() = default;
+    ~SATPSpectralSolver() { releasePlans(); }
+
+    SATPSpectralSolver(const SATPSpectralSolver&) = delete;
+    SATPSpectralSolver& operator=(const SATPSpectralSolver&) = delete;
+
+    /**
+     * True if this build has an FFT library
+     */
+    static constexpr bool isAvailable() {
+#ifdef USE_FFTW3
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Plans, buffers and |k|² for an N_x × N_y × N_z lattice (N_z = 1 in
+     * 2D) of spacing dx; a no-op if already configured for it
+     *
+     * @return false if no FFT backend is available or planning fails
+     */
+    bool configure(size_t N_x, size_t N_y, size_t N_z, double dx) {
+#ifdef USE_FFTW3
+        if (is_built_ && N_x == N_x_ && N_y == N_y_ && N_z == N_z_ && dx == dx_) {
+            return true;
+        }
+        const size_t N = N_x * N_y * N_z;
+        if (N == 0) return false;
+
+        if (!spectrum_[0] || N_x != N_x_ || N_y != N_y_ || N_z != N_z_) {
+            releasePlans();
+            const size_t M = (N_x / 2 + 1) * N_y * N_z;
+            real_ = FFTPlanRegistry::allocReal(N);
+            spectrum_[0] = FFTPlanRegistry::allocComplex(M);
+            spectrum_[1] = FFTPlanRegistry::allocComplex(M);
+            if (!real_ || !spectrum_[0] || !spectrum_[1]) {
+                releasePlans();
+                return false;
+            }
+            // Row-major (z, y, x) with x fastest
+            const int nx = static_cast<int>(N_x);
+            const int ny = static_cast<int>(N_y);
+            const int nz = static_cast<int>(N_z);
+            const int threads = FFTPlanRegistry::plannerThreads(N);
+            try {
+                forward_ = FFTPlanRegistry::acquire(
+                    N_z == 1 ? FFTPlanKey::make(FFTPlanKey::Kind::R2C, {ny, nx}, FFTW_FORWARD, false, 1, threads)
+                             : FFTPlanKey::make(FFTPlanKey::Kind::R2C, {nz, ny, nx}, FFTW_FORWARD, false, 1, threads));
+                backward_ = FFTPlanRegistry::acquire(
+                    N_z == 1 ? FFTPlanKey::make(FFTPlanKey::Kind::C2R, {ny, nx}, FFTW_BACKWARD, false, 1, threads)
+                             : FFTPlanKey::make(FFTPlanKey::Kind::C2R, {nz, ny, nx}, FFTW_BACKWARD, false, 1, threads));
+            } catch (const std::runtime_error&) {
+                releasePlans();
+                return false;
+            }
+        }
+
+        N_x_ = N_x;
+        N_y_ = N_y;
+        N_z_ = N_z;
+        dx_ = dx;
+
+        // |k|² on the half spectrum (kx = 0 … N_x/2), signed ky / kz
+        const size_t half_x = N_x / 2 + 1;
+        k_sq_.resize(half_x * N_y * N_z);
+        auto wavenumber = [dx](size_t m, size_t n) {
+            const double signed_m = m <= n / 2 ? static_cast<double>(m)
+                                               : static_cast<double>(m) - static_cast<double>(n);
+            return 2.0 * M_PI * signed_m / (static_cast<double>(n) * dx);
+        };
+        for (size_t z = 0; z < N_z; ++z) {
+            const double kz = wavenumber(z, N_z);
+            for (size_t y = 0; y < N_y; ++y) {
+                const double ky = wavenumber(y, N_y);
+                for (size_t x = 0; x < half_x; ++x) {
+                    const double kx = wavenumber(x, N_x);
+                    k_sq_[(z * N_y + y) * half_x + x] = kx * kx + ky * ky + kz * kz;
+                }
+            }
+        }
+        propagator_c_ = -1.0;   // Rebuild the ETD tables on next use
+        is_built_ = true;
+        return true;
+#else
+        (void)N_x; (void)N_y; (void)N_z; (void)dx;
+        return false;
+#endif
+    }
+
+    bool isConfigured() const { return is_built_; }
+
+    /**
+     * out = ∇²f (N doubles each; may alias)
+     *
+     * Not thread-safe: call from one thread (the FFTs themselves run on
+     * the plan's threads).
+     */
+    void laplacian(const double* f, double* out) {
+#ifdef USE_FFTW3
+        if (!is_built_) return;
+        forward(f, spectrum_[0]);
+        const size_t M = k_sq_.size();
+        const double scale = -1.0 / static_cast<double>(N_x_ * N_y_ * N_z_);
+        fftw_complex* s = spectrum_[0];
+        for (size_t i = 0; i < M; ++i) {
+            const double factor = scale * k_sq_[i];
+            s[i][0] *= factor;
+            s[i][1] *= factor;
+        }
+        backward(spectrum_[0], out);
+#else
+        (void)f;
+        (void)out;
+#endif
+    }
+
+    /**
+     * Advance (u, u̇) in place by the exact flow of u_tt = c²∇²u over dt
+     *
+     * Per mode (ω = c|k|): û ← cos(ωdt) û + sin(ωdt)/ω v̂,
+     *                      v̂ ← -ω sin(ωdt) û + cos(ωdt) v̂
+     * (the k = 0 mode drifts: û ← û + dt v̂).  Not thread-safe.
+     */
+    void propagateWave(double* u, double* v, double c, double dt) {
+#ifdef USE_FFTW3
+        if (!is_built_) return;
+        buildPropagator(c, dt);
+        forward(u, spectrum_[0]);
+        forward(v, spectrum_[1]);
+        const size_t M = k_sq_.size();
+        const double inv_n = 1.0 / static_cast<double>(N_x_ * N_y_ * N_z_);
+        fftw_complex* su = spectrum_[0];
+        fftw_complex* sv = spectrum_[1];
+        for (size_t i = 0; i < M; ++i) {
+            const double cc = cos_wdt_[i] * inv_n;
+            const double sw = sin_over_w_[i] * inv_n;
+            const double ws = w_sin_[i] * inv_n;
+            for (int part = 0; part < 2; ++part) {
+                const double uu = su[i][part];
+                const double vv = sv[i][part];
+                su[i][part] = cc * uu + sw * vv;
+                sv[i][part] = cc * vv - ws * uu;
+            }
+        }
+        backward(spectrum_[0], u);
+        backward(spectrum_[1], v);
+#else
+        (void)u; (void)v; (void)c; (void)dt;
+#endif
+    }
+
+    /**
+     * Advance `nodes` by num_steps with a spectral integrator
+     *
+     * @param mode Spectral or SpectralETD (configure() must have succeeded)
+     * @param source S(t, ·) per force evaluation (empty = no source)
+     * @param current_time Advanced by dt per step
+     */
+    void evolve(
+        std::vector<SATPHiggsNode>& nodes,
+        const SATPHiggsParams& params,
+        SATPLaplacianMode mode,
+        double dt,
+        double& current_time,
+        size_t num_steps,
+        const SpectralSourceField& source
+    ) {
+        if (!is_built_ || num_steps == 0) return;
+        const size_t N_total = N_x_ * N_y_ * N_z_;
+        if (phi_.size() != N_total) {
+            phi_.assign(N_total, 0.0);
+            phi_dot_.assign(N_total, 0.0);
+            h_.assign(N_total, 0.0);
+            h_dot_.assign(N_total, 0.0);
+            a_phi_.assign(N_total, 0.0);
+            a_h_.assign(N_total, 0.0);
+        }
+
+        // Gather nodes into the SoA state (picks up external edits)
+        for (size_t i = 0; i < N_total; ++i) {
+            phi_[i] = nodes[i].phi;
+            phi_dot_[i] = nodes[i].phi_dot;
+            h_[i] = nodes[i].h;
+            h_dot_[i] = nodes[i].h_dot;
+        }
+
+        const bool etd = (mode == SATPLaplacianMode::SpectralETD);
+        const double gamma_phi = params.gamma_phi;
+        const double gamma_h = params.gamma_h;
+        double* phi = phi_.data();
+        double* phi_dot = phi_dot_.data();
+        double* h = h_.data();
+        double* h_dot = h_dot_.data();
+        double* a_phi = a_phi_.data();
+        double* a_h = a_h_.data();
+        const int64_t N_loop = static_cast<int64_t>(N_total);
+
+        // Step 1: a(t) (local terms only for ETD; the wave part is in the flow)
+        accelerations(params, !etd, source ? source(current_time) : nullptr);
+
+        for (size_t step = 0; step < num_steps; ++step) {
+            const double t_next = current_time + dt;
+
+            if (etd) {
+                // Step 2: half kick with the local terms, then the exact
+                // linear wave flow over dt
+                #pragma omp parallel for simd schedule(static) if(N_total >= SATP_OMP_MIN_CELLS)
+                for (int64_t i = 0; i < N_loop; ++i) {
+                    phi_dot[i] = phi_dot[i] + 0.5 * a_phi[i] * dt;
+                    h_dot[i] = h_dot[i] + 0.5 * a_h[i] * dt;
+                }
+                propagateWave(phi, phi_dot, params.c, dt);
+                propagateWave(h, h_dot, params.c, dt);
+            } else {
+                // Step 2: positions and half-step velocities
+                #pragma omp parallel for simd schedule(static) if(N_total >= SATP_OMP_MIN_CELLS)
+                for (int64_t i = 0; i < N_loop; ++i) {
+                    phi[i] = phi[i] + phi_dot[i] * dt + 0.5 * a_phi[i] * dt * dt;
+                    h[i] = h[i] + h_dot[i] * dt + 0.5 * a_h[i] * dt * dt;
+                    phi_dot[i] = phi_dot[i] + 0.5 * a_phi[i] * dt;
+                    h_dot[i] = h_dot[i] + 0.5 * a_h[i] * dt;
+                }
+            }
+
+            // Step 3: a(t+dt) with the half-step velocities
+            accelerations(params, !etd, source ? source(t_next) : nullptr);
+
+            // Step 4: closing half kick; carry a(t+dt) forward with the
+            // damping at v(t+dt)
+            #pragma omp parallel for simd schedule(static) if(N_total >= SATP_OMP_MIN_CELLS)
+            for (int64_t i = 0; i < N_loop; ++i) {
+                const double phi_kick = 0.5 * a_phi[i] * dt;
+                const double h_kick = 0.5 * a_h[i] * dt;
+                phi_dot[i] = phi_dot[i] + phi_kick;
+                h_dot[i] = h_dot[i] + h_kick;
+                a_phi[i] -= gamma_phi * phi_kick;
+                a_h[i] -= gamma_h * h_kick;
+            }
+
+            current_time = t_next;
+        }
+
+        // Scatter back to the authoritative nodes
+        for (size_t i = 0; i < N_total; ++i) {
+            nodes[i].phi = phi_[i];
+            nodes[i].phi_dot = phi_dot_[i];
+            nodes[i].h = h_[i];
+            nodes[i].h_dot = h_dot_[i];
+            nodes[i].updateDerived();
+        }
+    }
+
+    uint64_t memoryBytes() const {
+        uint64_t bytes = capacityBytes(phi_) + capacityBytes(phi_dot_) + capacityBytes(h_) +
+                       capacityBytes(h_dot_) + capacityBytes(a_phi_) + capacityBytes(a_h_) +
+                       capacityBytes(k_sq_) + capacityBytes(cos_wdt_) + capacityBytes(sin_over_w_) +
+                       capacityBytes(w_sin_);
+#ifdef USE_FFTW3
+        if (real_) bytes += N_x_ * N_y_ * N_z_ * sizeof(double);
+        if (spectrum_[0]) bytes += 2 * k_sq_.size() * sizeof(fftw_complex);
+#endif
+        return bytes;
+    }
+
+private:
+    // a_phi / a_h of the SoA state: local terms, plus c²∇² unless the
+    // wave part is integrated exactly
+    void accelerations(const SATPHiggsParams& params, bool with_wave, const double* source_field) {
+        const size_t N_total = N_x_ * N_y_ * N_z_;
+        const double c_sq = params.c * params.c;
+        const double gamma_phi = params.gamma_phi;
+        const double gamma_h = params.gamma_h;
+        const double lambda = params.lambda;
+        const double mu_sq = params.mu_squared;
+        const double lambda_h = params.lambda_h;
+        const double* phi = phi_.data();
+        const double* phi_dot = phi_dot_.data();
+        const double* h = h_.data();
+        const double* h_dot = h_dot_.data();
+        double* a_phi = a_phi_.data();
+        double* a_h = a_h_.data();
+        const int64_t N_loop = static_cast<int64_t>(N_total);
+
+        if (with_wave) {
+            laplacian(phi, a_phi);
+            laplacian(h, a_h);
+        }
+        const double wave = with_wave ? c_sq : 0.0;
+
+        #pragma omp parallel for simd schedule(static) if(N_total >= SATP_OMP_MIN_CELLS)
+        for (int64_t i = 0; i < N_loop; ++i) {
+            const double lap_phi = with_wave ? a_phi[i] : 0.0;
+            const double lap_h = with_wave ? a_h[i] : 0.0;
+            const double source_term = source_field ? source_field[i] : 0.0;
+            a_phi[i] = wave * lap_phi
+                     - gamma_phi * phi_dot[i]
+                     - 2.0 * lambda * phi[i] * h[i] * h[i]
+                     + source_term;
+            a_h[i] = wave * lap_h
+                   - gamma_h * h_dot[i]
+                   - 2.0 * mu_sq * h[i]
+                   - 4.0 * lambda_h * h[i] * h[i] * h[i]
+                   - 2.0 * lambda * phi[i] * phi[i] * h[i];
+        }
+    }
+
+#ifdef USE_FFTW3
+    // Plans expect fftw_malloc alignment; other arrays go through real_
+    void forward(const double* f, fftw_complex* spectrum) {
+        double* in = const_cast<double*>(f);   // Out-of-place r2c leaves its input intact
+        if (fftw_alignment_of(in) != 0) {
+            std::copy(f, f + N_x_ * N_y_ * N_z_, real_);
+            in = real_;
+        }
+        fftw_execute_dft_r2c(forward_, in, spectrum);
+    }
+
+    // spectrum is overwritten (c2r destroys its input)
+    void backward(fftw_complex* spectrum, double* out) {
+        if (fftw_alignment_of(out) != 0) {
+            fftw_execute_dft_c2r(backward_, spectrum, real_);
+            std::copy(real_, real_ + N_x_ * N_y_ * N_z_, out);
+        } else {
+            fftw_execute_dft_c2r(backward_, spectrum, out);
+        }
+    }
+
+    // cos(ωdt), sin(ωdt)/ω and ω sin(ωdt) per mode, cached per (c, dt)
+    void buildPropagator(double c, double dt) {
+        if (c == propagator_c_ && dt == propagator_dt_) return;
+        const size_t M = k_sq_.size();
+        cos_wdt_.resize(M);
+        sin_over_w_.resize(M);
+        w_sin_.resize(M);
+        for (size_t i = 0; i < M; ++i) {
+            const double w = c * std::sqrt(k_sq_[i]);
+            const double phase = w * dt;
+            cos_wdt_[i] = std::cos(phase);
+            sin_over_w_[i] = w > 0.0 ? std::sin(phase) / w : dt;
+            w_sin_[i] = w * std::sin(phase);
+        }
+        propagator_c_ = c;
+        propagator_dt_ = dt;
+    }
+#endif
+
+    void releasePlans() {
+#ifdef USE_FFTW3
+        // Plans belong to the registry
+        FFTPlanRegistry::release(real_);
+        FFTPlanRegistry::release(spectrum_[0]);
+        FFTPlanRegistry::release(spectrum_[1]);
+        real_ = nullptr;
+        spectrum_[0] = nullptr;
+        spectrum_[1] = nullptr;
+        forward_ = nullptr;
+        backward_ = nullptr;
+#endif
+        is_built_ = false;
+    }
+
+#ifdef USE_FFTW3
+    fftw_plan forward_ = nullptr;     // Registry-owned
+    fftw_plan backward_ = nullptr;
+    double* real_ = nullptr;          // Staging for unaligned arrays
+    fftw_complex* spectrum_[2] = {nullptr, nullptr};
+#endif
+
+    // SoA state and accelerations (a(t) on entry to each step)
+    ScratchArray phi_, phi_dot_, h_, h_dot_;
+    ScratchArray a_phi_, a_h_;
+
+    std::vector<double> k_sq_;        // |k|² on the half spectrum
+    std::vector<double> cos_wdt_;     // ETD propagator tables
+    std::vector<double> sin_over_w_;
+    std::vector<double> w_sin_;
+    double propagator_c_ = -1.0;
+    double propagator_dt_ = 0.0;
+
+    size_t N_x_ = 0, N_y_ = 0, N_z_ = 0;
+    double dx_ = 0.0;
+    bool is_built_ = false;
+};
+
+} // namespace satp_higgs
+} // namespace dase
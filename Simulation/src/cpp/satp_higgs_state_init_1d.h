@@ -15,6 +15,7 @@
 #include <cmath>
 #include <random>
 #include <string>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -196,6 +197,37 @@ public:
         };
     }
 
+    // Spatial profile A·exp(-d²/2σ²) for a separable source (periodic distance)
+    static std::vector<double> createGaussianSourceProfile(const SATPHiggsEngine1D& engine,
+                                                           double amplitude,
+                                                           double center,
+                                                           double sigma) {
+        const size_t N = engine.getN();
+        const double dx = engine.getDx();
+        const double L = static_cast<double>(N) * dx;
+        const double s = std::max(sigma, MIN_SIGMA_SATP);
+        const double inv_two_sigma_sq = 1.0 / (2.0 * s * s);
+
+        std::vector<double> profile(N);
+        for (size_t i = 0; i < N; ++i) {
+            double dx_val = static_cast<double>(i) * dx - center;
+            if (dx_val > L / 2.0) dx_val -= L;
+            if (dx_val < -L / 2.0) dx_val += L;
+            profile[i] = amplitude * std::exp(-(dx_val * dx_val) * inv_two_sigma_sq);
+        }
+        return profile;
+    }
+
+    // Gaussian source in space × time envelope; the profile is computed once
+    static void setGaussianPulseSource(SATPHiggsEngine1D& engine,
+                                       double amplitude,
+                                       double center,
+                                       double sigma,
+                                       const SATPSourceEnvelope& envelope) {
+        engine.setSeparableSource(
+            createGaussianSourceProfile(engine, amplitude, center, sigma), envelope);
+    }
+
     // Initialize uniform state
     static void initUniform(SATPHiggsEngine1D& engine,
                            double phi_val, double phi_dot_val,
@@ -15,6 +15,7 @@
 #include <cmath>
 #include <random>
 #include <string>
+#include <vector>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -235,6 +236,56 @@ public:
         }
     }
 
+    // Spatial profile A·exp(-r²/2σ²) for a separable source (periodic distance)
+    static std::vector<double> createGaussianSourceProfile(const SATPHiggsEngine3D& engine,
+                                                           double amplitude,
+                                                           double center_x,
+                                                           double center_y,
+                                                           double center_z,
+                                                           double sigma) {
+        const size_t N_x = engine.getNx();
+        const size_t N_y = engine.getNy();
+        const size_t N_z = engine.getNz();
+        const double dx = engine.getDx();
+        const double L_x = static_cast<double>(N_x) * dx;
+        const double L_y = static_cast<double>(N_y) * dx;
+        const double L_z = static_cast<double>(N_z) * dx;
+        const double s = std::max(sigma, MIN_SIGMA_SATP_3D);
+        const double inv_two_sigma_sq = 1.0 / (2.0 * s * s);
+
+        std::vector<double> profile(engine.getN());
+        for (size_t z = 0; z < N_z; ++z) {
+            double dz_val = static_cast<double>(z) * dx - center_z;
+            if (dz_val > L_z / 2.0) dz_val -= L_z;
+            if (dz_val < -L_z / 2.0) dz_val += L_z;
+            for (size_t y = 0; y < N_y; ++y) {
+                double dy_val = static_cast<double>(y) * dx - center_y;
+                if (dy_val > L_y / 2.0) dy_val -= L_y;
+                if (dy_val < -L_y / 2.0) dy_val += L_y;
+                for (size_t x = 0; x < N_x; ++x) {
+                    double dx_val = static_cast<double>(x) * dx - center_x;
+                    if (dx_val > L_x / 2.0) dx_val -= L_x;
+                    if (dx_val < -L_x / 2.0) dx_val += L_x;
+                    const double r_sq = dx_val * dx_val + dy_val * dy_val + dz_val * dz_val;
+                    profile[engine.getIndex(x, y, z)] = amplitude * std::exp(-r_sq * inv_two_sigma_sq);
+                }
+            }
+        }
+        return profile;
+    }
+
+    // Gaussian source in space × time envelope; the profile is computed once
+    static void setGaussianPulseSource(SATPHiggsEngine3D& engine,
+                                       double amplitude,
+                                       double center_x,
+                                       double center_y,
+                                       double center_z,
+                                       double sigma,
+                                       const SATPSourceEnvelope& envelope) {
+        engine.setSeparableSource(
+            createGaussianSourceProfile(engine, amplitude, center_x, center_y, center_z, sigma), envelope);
+    }
+
     // Initialize uniform state
     static void initUniform(SATPHiggsEngine3D& engine,
                            double phi_val, double phi_dot_val,
@@ -0,0 +1,290 @@
+/**
+ * SATP+Higgs Temporal Blocking
+ *
+ * Blocked Velocity Verlet for SATPHiggsEngine2D/3D (setTemporalBlockSteps):
+ * T steps per pass over the lattice on overlapped space-time tiles
+ * (temporal_blocking.h).  The Laplacian has radius 1, so a block of T steps
+ * needs a halo of T cells.
+ *
+ * Per cell a step is exactly the reference integrator (position and half
+ * kick on the cells still valid, forces one cell further in, closing kick
+ * with the damping carried to v(t+dt)), with the same operand order, so
+ * results are bit-identical to SATPStencilMode::Reference under the same
+ * floating-point contraction (see satp_higgs_physics_3d.h).
+ *
+ * Sources: a Separable source S = g(t) · P(x) is blocked (g is evaluated
+ * once per step, P is gathered with the tile).  Batch and point-wise sources
+ * need the whole field per force evaluation; the engines keep the per-step
+ * path for them.
+ */
+
+#pragma once
+
+#include "aligned_allocator.h"
+#include "kernel_traffic.h"
+#include "satp_higgs_engine_1d.h"
+#include "temporal_blocking.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifndef SATP_OMP_MIN_CELLS
+#define SATP_OMP_MIN_CELLS 4096
+#endif
+
+namespace dase {
+namespace satp_higgs {
+
+/**
+ * Modelled traffic of one blocked step: the block streams the six state
+ * arrays (and a Separable profile) in once, with the halo overlap, and out
+ * once; every computed cell does the tiled-path arithmetic
+ */
+inline KernelTraffic satpBlockedStepTraffic(size_t cells, int dims, SATPSourceKind source,
+                                            size_t block_steps, double overlap) {
+    const double n = static_cast<double>(cells);
+    const double value = static_cast<double>(sizeof(double));
+    const double steps = static_cast<double>(std::max<size_t>(block_steps, 1));
+    const double in = (6.0 + (source == SATPSourceKind::Separable ? 1.0 : 0.0)) * value * overlap;
+    const double flops = 18.0 + 2.0 * (2.0 * dims + 3.0) + 27.0 + 10.0 +
+                         (source == SATPSourceKind::Separable ? 1.0 : 0.0);
+    return kernelPass(n, in / steps, 6.0 * value / steps, flops * overlap);
+}
+
+class SATPTemporalBlocking {
+public:
+    using ScratchArray = std::vector<double, aligned_allocator<double, 64>>;
+
+    /**
+     * Advance `nodes` by num_steps in blocks of block_steps
+     *
+     * @param phi_accel / h_accel a(t) of the current state (engine scratch)
+     * @param profile Separable source profile (nullptr = no source)
+     * @param envelope Separable source envelope (used with profile)
+     * @param current_time Advanced by dt per step
+     */
+    template <int Dims>
+    void evolve(
+        std::vector<SATPHiggsNode>& nodes,
+        const ScratchArray& phi_accel,
+        const ScratchArray& h_accel,
+        const SATPHiggsParams& params,
+        size_t N_x, size_t N_y, size_t N_z,
+        double dx, double dt,
+        double& current_time,
+        size_t num_steps,
+        size_t block_steps,
+        const double* profile,
+        const SATPSourceEnvelope& envelope
+    ) {
+        static_assert(Dims == 2 || Dims == 3, "temporal blocking covers the 2D/3D engines");
+        const size_t N_total = nodes.size();
+        block_steps = std::max<size_t>(block_steps, 1);
+        for (int b = 0; b < 2; ++b) {
+            for (int f = 0; f < kFields; ++f) {
+                fields_[b][f].resize(N_total);
+            }
+        }
+
+        // Gather the state and a(t) (picks up external edits)
+        double* const* in = current();
+        for (size_t i = 0; i < N_total; ++i) {
+            in[Phi][i] = nodes[i].phi;
+            in[PhiDot][i] = nodes[i].phi_dot;
+            in[H][i] = nodes[i].h;
+            in[HDot][i] = nodes[i].h_dot;
+            in[APhi][i] = phi_accel[i];
+            in[AH][i] = h_accel[i];
+        }
+
+        std::vector<double> times;
+        std::vector<double> envelope_at;
+        for (size_t done = 0; done < num_steps; ) {
+            const size_t T = std::min(block_steps, num_steps - done);
+
+            // Step times by repeated addition, as the per-step path does
+            times.assign(T + 1, current_time);
+            envelope_at.assign(T + 1, 0.0);
+            for (size_t k = 1; k <= T; ++k) {
+                times[k] = times[k - 1] + dt;
+                envelope_at[k] = profile ? envelope(times[k]) : 0.0;
+            }
+
+            const TemporalBlockingGrid grid(Dims, N_x, N_y, N_z, T);
+            last_overlap_ = grid.overlap();
+            block<Dims>(grid, params, dx, dt, T, profile, envelope_at.data());
+
+            parity_ ^= 1;
+            current_time = times[T];
+            done += T;
+        }
+
+        // Scatter back to the authoritative nodes
+        double* const* out = current();
+        for (size_t i = 0; i < N_total; ++i) {
+            nodes[i].phi = out[Phi][i];
+            nodes[i].phi_dot = out[PhiDot][i];
+            nodes[i].h = out[H][i];
+            nodes[i].h_dot = out[HDot][i];
+            nodes[i].updateDerived();
+        }
+    }
+
+    // Halo overhead of the last block (TemporalBlockingGrid::overlap)
+    double lastOverlap() const { return last_overlap_; }
+
+    size_t memoryBytes() const {
+        size_t values = 0;
+        for (int b = 0; b < 2; ++b) {
+            for (int f = 0; f < kFields; ++f) {
+                values += fields_[b][f].capacity();
+            }
+        }
+        return values * sizeof(double);
+    }
+
+private:
+    enum Field { Phi, PhiDot, H, HDot, APhi, AH, kFields };
+
+    // Global double buffer: blocks read fields_[parity_] and write the other
+    ScratchArray fields_[2][kFields];
+    int parity_ = 0;
+    double last_overlap_ = 1.0;
+    double* in_[kFields] = {};
+    double* out_[kFields] = {};
+
+    double* const* current() {
+        for (int f = 0; f < kFields; ++f) {
+            in_[f] = fields_[parity_][f].data();
+            out_[f] = fields_[parity_ ^ 1][f].data();
+        }
+        return in_;
+    }
+
+    template <int Dims>
+    void block(const TemporalBlockingGrid& grid, const SATPHiggsParams& params,
+               double dx, double dt, size_t T, const double* profile, const double* envelope_at) {
+        current();
+        const double* const* in = in_;
+        double* const* out = out_;
+        const double c_sq = params.c * params.c;
+        const double dx_sq = dx * dx;
+        const double gamma_phi = params.gamma_phi;
+        const double gamma_h = params.gamma_h;
+        const double lambda = params.lambda;
+        const double mu_sq = params.mu_squared;
+        const double lambda_h = params.lambda_h;
+        const int64_t num_tiles = static_cast<int64_t>(grid.numTiles());
+        const size_t cells = grid.n[0] * grid.n[1] * grid.n[2];
+
+        #pragma omp parallel if(cells >= SATP_OMP_MIN_CELLS)
+        {
+            ScratchArray local;   // kFields (+ profile) arrays of one tile
+
+            #pragma omp for schedule(dynamic)
+            for (int64_t tile = 0; tile < num_tiles; ++tile) {
+                const TemporalBlockingGrid::Box box = grid.box(static_cast<size_t>(tile));
+                const size_t V = box.volume();
+                const int arrays = kFields + (profile ? 1 : 0);
+                if (local.size() < V * arrays) {
+                    local.resize(V * arrays);
+                }
+                double* f[kFields + 1];
+                for (int a = 0; a < arrays; ++a) {
+                    f[a] = local.data() + a * V;
+                }
+                grid.forEachLocal(box, [&](size_t l, size_t g) {
+                    for (int a = 0; a < kFields; ++a) {
+                        f[a][l] = in[a][g];
+                    }
+                    if (profile) {
+                        f[kFields][l] = profile[g];
+                    }
+                });
+
+                double* phi = f[Phi];
+                double* phi_dot = f[PhiDot];
+                double* h = f[H];
+                double* h_dot = f[HDot];
+                double* a_phi = f[APhi];
+                double* a_h = f[AH];
+                const double* P = profile ? f[kFields] : nullptr;
+                const std::ptrdiff_t row = static_cast<std::ptrdiff_t>(box.row());
+                const std::ptrdiff_t plane = static_cast<std::ptrdiff_t>(box.plane());
+
+                for (size_t k = 1; k <= T; ++k) {
+                    // Position and half-step velocity on the still-valid cells
+                    grid.forEachRow(box, k - 1, [&](size_t x0, size_t x1, size_t base) {
+                        #pragma omp simd
+                        for (size_t x = base + x0; x < base + x1; ++x) {
+                            phi[x] = phi[x] + phi_dot[x] * dt + 0.5 * a_phi[x] * dt * dt;
+                            h[x] = h[x] + h_dot[x] * dt + 0.5 * a_h[x] * dt * dt;
+                            phi_dot[x] = phi_dot[x] + 0.5 * a_phi[x] * dt;
+                            h_dot[x] = h_dot[x] + 0.5 * a_h[x] * dt;
+                        }
+                    });
+
+                    // a(t+dt) one cell further in, then the closing kick
+                    const double g = envelope_at[k];
+                    grid.forEachRow(box, k, [&](size_t x0, size_t x1, size_t base) {
+                        #pragma omp simd
+                        for (size_t x = base + x0; x < base + x1; ++x) {
+                            double laplacian_phi;
+                            double laplacian_h;
+                            if constexpr (Dims == 3) {
+                                laplacian_phi = (phi[x - 1] + phi[x + 1] +
+                                                 phi[x - row] + phi[x + row] +
+                                                 phi[x - plane] + phi[x + plane] -
+                                                 6.0 * phi[x]) / dx_sq;
+                                laplacian_h = (h[x - 1] + h[x + 1] +
+                                               h[x - row] + h[x + row] +
+                                               h[x - plane] + h[x + plane] -
+                                               6.0 * h[x]) / dx_sq;
+                            } else {
+                                laplacian_phi = (phi[x - 1] + phi[x + 1] +
+                                                 phi[x - row] + phi[x + row] -
+                                                 4.0 * phi[x]) / dx_sq;
+                                laplacian_h = (h[x - 1] + h[x + 1] +
+                                               h[x - row] + h[x + row] -
+                                               4.0 * h[x]) / dx_sq;
+                            }
+                            const double source_term = P ? g * P[x] : 0.0;
+                            const double ap = c_sq * laplacian_phi
+                                            - gamma_phi * phi_dot[x]
+                                            - 2.0 * lambda * phi[x] * h[x] * h[x]
+                                            + source_term;
+                            const double ah = c_sq * laplacian_h
+                                            - gamma_h * h_dot[x]
+                                            - 2.0 * mu_sq * h[x]
+                                            - 4.0 * lambda_h * h[x] * h[x] * h[x]
+                                            - 2.0 * lambda * phi[x] * phi[x] * h[x];
+                            a_phi[x] = ap;
+                            a_h[x] = ah;
+                        }
+                    });
+                    grid.forEachRow(box, k, [&](size_t x0, size_t x1, size_t base) {
+                        #pragma omp simd
+                        for (size_t x = base + x0; x < base + x1; ++x) {
+                            const double phi_kick = 0.5 * a_phi[x] * dt;
+                            const double h_kick = 0.5 * a_h[x] * dt;
+                            phi_dot[x] = phi_dot[x] + phi_kick;
+                            h_dot[x] = h_dot[x] + h_kick;
+                            a_phi[x] -= gamma_phi * phi_kick;
+                            a_h[x] -= gamma_h * h_kick;
+                        }
+                    });
+                }
+
+                grid.forEachCore(box, [&](size_t l, size_t g) {
+                    for (int a = 0; a < kFields; ++a) {
+                        out[a][g] = f[a][l];
+                    }
+                });
+            }
+        }
+    }
+};
+
+} // namespace satp_higgs
+} // namespace dase
@@ -0,0 +1,158 @@
+/**
+ * SID AST Arena - Flat, index-linked expression trees
+ *
+ * ASTNode owns its names and children by value, so building or copying a
+ * tree allocates per node.  An AstArena stores the nodes of any number of
+ * trees in one vector instead: a node is a (kind, symbol, child span)
+ * record, names are interned once per arena and handed out as string_view,
+ * and each operator's children are a contiguous slice of a shared index
+ * array.  Nodes are appended children first, so an AstRef never points
+ * forward.
+ *
+ * Trees are addressed by AstRef (index into the arena) and stay valid until
+ * clear().  toASTNode() converts a tree for code that takes ASTNode.
+ */
+
+#pragma once
+
+#include "sid_ast.hpp"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sid {
+
+using AstRef = uint32_t;
+constexpr AstRef kNoAstRef = 0xFFFFFFFFu;
+
+/**
+ * Child slice of one arena node
+ */
+struct AstChildRange {
+    const AstRef* first = nullptr;
+    const AstRef* last = nullptr;
+
+    const AstRef* begin() const { return first; }
+    const AstRef* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+    AstRef operator[](size_t i) const { return first[i]; }
+};
+
+class AstArena {
+public:
+    struct Node {
+        ASTKind kind = ASTKind::Atom;
+        uint32_t symbol = 0;        // Atom name or operator name
+        uint32_t first_child = 0;   // Into the child index array
+        uint32_t child_count = 0;
+    };
+
+    // Intern a name; the view stays valid until clear()
+    uint32_t intern(std::string_view name) {
+        auto it = symbols_.find(name);
+        if (it != symbols_.end()) return it->second;
+        const uint32_t symbol = static_cast<uint32_t>(names_.size());
+        names_.emplace_back(name);
+        symbols_.emplace(std::string_view(names_.back()), symbol);
+        return symbol;
+    }
+
+    std::string_view symbolName(uint32_t symbol) const { return names_[symbol]; }
+    size_t symbolCount() const { return names_.size(); }
+
+    AstRef addAtom(std::string_view name) {
+        Node node;
+        node.kind = ASTKind::Atom;
+        node.symbol = intern(name);
+        nodes_.push_back(node);
+        return static_cast<AstRef>(nodes_.size() - 1);
+    }
+
+    // Children must already be in the arena
+    AstRef addOp(std::string_view op, const AstRef* children, size_t count) {
+        Node node;
+        node.kind = ASTKind::Op;
+        node.symbol = intern(op);
+        node.first_child = static_cast<uint32_t>(children_.size());
+        node.child_count = static_cast<uint32_t>(count);
+        children_.insert(children_.end(), children, children + count);
+        nodes_.push_back(node);
+        return static_cast<AstRef>(nodes_.size() - 1);
+    }
+
+    const Node& node(AstRef ref) const { return nodes_[ref]; }
+    ASTKind kind(AstRef ref) const { return nodes_[ref].kind; }
+
+    // Atom name or operator name
+    std::string_view name(AstRef ref) const { return names_[nodes_[ref].symbol]; }
+
+    AstChildRange children(AstRef ref) const {
+        const Node& n = nodes_[ref];
+        AstChildRange range;
+        range.first = children_.data() + n.first_child;
+        range.last = range.first + n.child_count;
+        return range;
+    }
+
+    size_t size() const { return nodes_.size(); }
+    bool empty() const { return nodes_.empty(); }
+
+    // Drop every tree and symbol, keeping node and child capacity
+    void clear() {
+        nodes_.clear();
+        children_.clear();
+        symbols_.clear();
+        names_.clear();
+    }
+
+    void reserve(size_t num_nodes) {
+        nodes_.reserve(num_nodes);
+        children_.reserve(num_nodes);
+    }
+
+    /**
+     * Deep copy of one tree as an owning ASTNode
+     */
+    ASTNode toASTNode(AstRef ref) const {
+        const Node& n = nodes_[ref];
+        ASTNode out;
+        out.kind = n.kind;
+        if (n.kind == ASTKind::Atom) {
+            out.atom_name = names_[n.symbol];
+            return out;
+        }
+        out.op_name = names_[n.symbol];
+        out.args.reserve(n.child_count);
+        for (AstRef child : children(ref)) {
+            out.args.push_back(toASTNode(child));
+        }
+        return out;
+    }
+
+    /**
+     * Copy an ASTNode tree into the arena
+     */
+    AstRef fromASTNode(const ASTNode& expr) {
+        if (expr.kind == ASTKind::Atom) {
+            return addAtom(expr.atom_name);
+        }
+        std::vector<AstRef> args;
+        args.reserve(expr.args.size());
+        for (const auto& arg : expr.args) {
+            args.push_back(fromASTNode(arg));
+        }
+        return addOp(expr.op_name, args.data(), args.size());
+    }
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<AstRef> children_;
+    std::deque<std::string> names_;   // Deque: interned views stay valid as it grows
+    std::unordered_map<std::string_view, uint32_t> symbols_;
+};
+
+} // namespace sid
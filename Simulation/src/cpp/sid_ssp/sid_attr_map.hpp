@@ -0,0 +1,155 @@
+/**
+ * SID Attribute Map - Flat storage for Node / Edge attributes and metadata
+ *
+ * Attribute keys are interned process-wide to small integers (AttrKey), and
+ * each map is a vector of (key, value) pairs sorted by key.  Copying a node
+ * or an edge, which rewrites do for whole diagrams, then copies one
+ * contiguous array per non-empty map instead of a red-black tree, and an
+ * empty map (the common case) costs nothing to copy.
+ *
+ * Keys the library itself reads have constants in attr_keys, so hot paths
+ * look them up without touching the intern table.  Lookup by string never
+ * interns: an unknown name simply is not found.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sid {
+
+using AttrKey = uint32_t;
+constexpr AttrKey kNoAttrKey = 0xFFFFFFFFu;
+
+/**
+ * Process-wide attribute key interning (thread-safe)
+ */
+class AttrKeys {
+public:
+    static AttrKey intern(const std::string& name) {
+        Table& table = instance();
+        {
+            std::shared_lock<std::shared_mutex> lock(table.mutex);
+            auto it = table.index.find(name);
+            if (it != table.index.end()) return it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(table.mutex);
+        auto it = table.index.find(name);
+        if (it != table.index.end()) return it->second;
+        const AttrKey key = static_cast<AttrKey>(table.names.size());
+        table.names.push_back(name);
+        table.index.emplace(name, key);
+        return key;
+    }
+
+    // kNoAttrKey if never interned
+    static AttrKey find(const std::string& name) {
+        Table& table = instance();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        auto it = table.index.find(name);
+        return it != table.index.end() ? it->second : kNoAttrKey;
+    }
+
+    static const std::string& name(AttrKey key) {
+        Table& table = instance();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        return table.names[key];   // Deque: references stay valid as it grows
+    }
+
+private:
+    struct Table {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, AttrKey> index;
+        std::deque<std::string> names;
+    };
+
+    static Table& instance() {
+        static Table table;
+        return table;
+    }
+};
+
+namespace attr_keys {
+inline const AttrKey kAtomArgs = AttrKeys::intern("atom_args");   // Node::meta, vector of atoms
+inline const AttrKey kAtomOnly = AttrKeys::intern("atom_only");   // Node::meta, bool
+inline const AttrKey kCollapseState = AttrKeys::intern("collapse_state");     // Node::attributes, Ternary
+inline const AttrKey kCollapseCell = AttrKeys::intern("collapse_cell");       // Node::attributes, int
+inline const AttrKey kCollapseWeight = AttrKeys::intern("collapse_weight");   // Node::attributes, double
+}  // namespace attr_keys
+
+/**
+ * Sorted (AttrKey, V) vector with a std::map-like subset of operations
+ */
+template <typename V>
+class FlatAttrMap {
+public:
+    using value_type = std::pair<AttrKey, V>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    iterator begin() { return items_.begin(); }
+    iterator end() { return items_.end(); }
+    const_iterator begin() const { return items_.begin(); }
+    const_iterator end() const { return items_.end(); }
+
+    size_t size() const { return items_.size(); }
+    bool empty() const { return items_.empty(); }
+    void clear() { items_.clear(); }
+
+    V& operator[](AttrKey key) {
+        auto it = lowerBound(key);
+        if (it == items_.end() || it->first != key) {
+            it = items_.emplace(it, key, V());
+        }
+        return it->second;
+    }
+
+    V& operator[](const std::string& name) { return (*this)[AttrKeys::intern(name)]; }
+
+    iterator find(AttrKey key) {
+        auto it = lowerBound(key);
+        return (it != items_.end() && it->first == key) ? it : items_.end();
+    }
+
+    const_iterator find(AttrKey key) const {
+        auto it = std::lower_bound(items_.begin(), items_.end(), key,
+                                   [](const value_type& item, AttrKey k) { return item.first < k; });
+        return (it != items_.end() && it->first == key) ? it : items_.end();
+    }
+
+    iterator find(const std::string& name) { return find(AttrKeys::find(name)); }
+    const_iterator find(const std::string& name) const { return find(AttrKeys::find(name)); }
+
+    size_t count(AttrKey key) const { return find(key) != end() ? 1 : 0; }
+    size_t count(const std::string& name) const { return find(name) != end() ? 1 : 0; }
+
+    size_t erase(AttrKey key) {
+        auto it = find(key);
+        if (it == items_.end()) return 0;
+        items_.erase(it);
+        return 1;
+    }
+
+    size_t erase(const std::string& name) { return erase(AttrKeys::find(name)); }
+
+    bool operator==(const FlatAttrMap& other) const { return items_ == other.items_; }
+    bool operator!=(const FlatAttrMap& other) const { return items_ != other.items_; }
+
+private:
+    std::vector<value_type> items_;
+
+    iterator lowerBound(AttrKey key) {
+        return std::lower_bound(items_.begin(), items_.end(), key,
+                                [](const value_type& item, AttrKey k) { return item.first < k; });
+    }
+};
+
+} // namespace sid
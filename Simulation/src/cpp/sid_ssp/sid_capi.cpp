@@ -7,14 +7,54 @@
 #include "sid_mixer.hpp"
 #include "sid_semantic_processor.hpp"
 #include "../sid_ternary_engine.hpp"
+#include "../engine_checkpoint.h"
+#include <algorithm>
 #include <string>
 #include <memory>
+#include <vector>
 
 // Engine handle structure
 struct sid_engine {
     std::unique_ptr<sid::SidTernaryEngine> engine;
 };
 
+namespace {
+
+// Shared argument handling of sid_run_fixpoint / sid_run_parallel_rewrites /
+// sid_run_network_rewrites
+template <typename Run>
+int64_t runRewriteLoop(sid_engine* eng, const int64_t* rule_handles, uint64_t rule_count,
+                       const char* policy, uint64_t horizon_cap, uint64_t seed,
+                       uint64_t* trace_out, uint64_t trace_capacity, bool* horizon_hit_out, Run run) {
+    if (!eng || !eng->engine || (!rule_handles && rule_count > 0)) {
+        return -1;
+    }
+    sid::FixpointOptions options;
+    if (policy) {
+        options.policy = policy;
+    }
+    options.horizon_cap = horizon_cap;
+    options.seed = seed;
+
+    std::vector<int64_t> handles(rule_handles, rule_handles + rule_count);
+    sid::FixpointResult result;
+    if (!run(*eng->engine, handles, options, result)) {
+        return -1;
+    }
+    if (trace_out) {
+        const size_t n = std::min<size_t>(result.applied_trace.size(), static_cast<size_t>(trace_capacity));
+        for (size_t i = 0; i < n; ++i) {
+            trace_out[i] = static_cast<uint64_t>(result.applied_trace[i]);
+        }
+    }
+    if (horizon_hit_out) {
+        *horizon_hit_out = result.horizon_hit;
+    }
+    return static_cast<int64_t>(result.steps);
+}
+
+}  // namespace
+
 extern "C" {
 
 /* Diagram operations */
@@ -66,6 +106,16 @@ void sid_ssp_commit_step(sid_ssp_t* ssp) {
     reinterpret_cast<sid::SemanticProcessor*>(ssp)->commit_step();
 }
 
+uint64_t sid_ssp_step(sid_ssp_t* ssp) {
+    return ssp ? reinterpret_cast<sid::SemanticProcessor*>(ssp)->step() : 0;
+}
+
+void sid_ssp_restore_step(sid_ssp_t* ssp, uint64_t step) {
+    if (ssp) {
+        reinterpret_cast<sid::SemanticProcessor*>(ssp)->restore_step(step);
+    }
+}
+
 /* Engine operations */
 sid_engine* sid_create_engine(uint64_t num_nodes, double total_mass) {
     try {
@@ -100,6 +150,20 @@ void sid_collapse(sid_engine* eng, double alpha) {
     }
 }
 
+bool sid_label_collapse_node(sid_engine* eng, const char* node_id, char state, uint64_t cell, double weight) {
+    if (!eng || !eng->engine || !node_id) {
+        return false;
+    }
+    sid::Ternary ternary;
+    switch (state) {
+        case 'I': ternary = sid::Ternary::I; break;
+        case 'N': ternary = sid::Ternary::N; break;
+        case 'U': ternary = sid::Ternary::U; break;
+        default: return false;
+    }
+    return eng->engine->labelCollapseNode(node_id, ternary, cell, weight);
+}
+
 double sid_get_I_mass(sid_engine* eng) {
     return (eng && eng->engine) ? eng->engine->getIMass() : 0.0;
 }
@@ -120,6 +184,51 @@ bool sid_is_conserved(sid_engine* eng, double tolerance) {
     return (eng && eng->engine) ? eng->engine->isConserved(tolerance) : false;
 }
 
+bool sid_batch_run(sid_engine* const* engines, uint64_t count, uint32_t ops, double alpha,
+                   uint64_t steps, double tolerance, sid_batch_result* results_out) {
+    if (count == 0) {
+        return true;
+    }
+    if (!engines || !results_out) {
+        return false;
+    }
+    // Engines run concurrently, so each may appear only once
+    std::vector<sid_engine*> sorted(engines, engines + count);
+    sorted.erase(std::remove(sorted.begin(), sorted.end(), nullptr), sorted.end());
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        return false;
+    }
+
+    const int64_t n = static_cast<int64_t>(count);
+    #pragma omp parallel for schedule(dynamic, 1) if(n > 1)
+    for (int64_t i = 0; i < n; ++i) {
+        sid_engine* eng = engines[i];
+        sid_batch_result& out = results_out[i];
+        out = sid_batch_result{};
+        if (!eng || !eng->engine) {
+            continue;
+        }
+        sid::SidTernaryEngine& engine = *eng->engine;
+        for (uint64_t round = 0; round < steps; ++round) {
+            if (ops & SID_BATCH_STEP) {
+                engine.step(alpha);
+            }
+            if (ops & SID_BATCH_COLLAPSE) {
+                engine.collapse(alpha);
+            }
+        }
+        out.I_mass = engine.getIMass();
+        out.N_mass = engine.getNMass();
+        out.U_mass = engine.getUMass();
+        out.instantaneous_gain = engine.getInstantaneousGain();
+        out.step_count = engine.getStepCount();
+        out.is_conserved = engine.isConserved(tolerance);
+        out.ok = true;
+    }
+    return true;
+}
+
 bool sid_last_rewrite_applied(sid_engine* eng) {
     return (eng && eng->engine) ? eng->engine->lastRewriteApplied() : false;
 }
@@ -141,6 +250,61 @@ bool sid_apply_rewrite(sid_engine* eng, const char* pattern,
     return false;
 }
 
+int64_t sid_compile_rule(sid_engine* eng, const char* pattern,
+                         const char* replacement, const char* rule_id) {
+    if (eng && eng->engine && pattern && replacement && rule_id) {
+        return eng->engine->compileRule(pattern, replacement, rule_id);
+    }
+    return -1;
+}
+
+bool sid_apply_compiled_rule(sid_engine* eng, int64_t rule_handle) {
+    return (eng && eng->engine) ? eng->engine->applyCompiledRule(rule_handle) : false;
+}
+
+uint64_t sid_compiled_rule_count(sid_engine* eng) {
+    return (eng && eng->engine) ? static_cast<uint64_t>(eng->engine->compiledRuleCount()) : 0;
+}
+
+int64_t sid_run_fixpoint(sid_engine* eng, const int64_t* rule_handles, uint64_t rule_count,
+                         const char* policy, uint64_t horizon_cap, uint64_t seed,
+                         uint64_t* trace_out, uint64_t trace_capacity, bool* horizon_hit_out) {
+    return runRewriteLoop(eng, rule_handles, rule_count, policy, horizon_cap, seed,
+                          trace_out, trace_capacity, horizon_hit_out,
+                          [](sid::SidTernaryEngine& engine, const std::vector<int64_t>& handles,
+                             const sid::FixpointOptions& options, sid::FixpointResult& result) {
+                              return engine.runFixpoint(handles, options, result);
+                          });
+}
+
+int64_t sid_run_parallel_rewrites(sid_engine* eng, const int64_t* rule_handles, uint64_t rule_count,
+                                  const char* policy, uint64_t horizon_cap, uint64_t seed, bool batch,
+                                  uint64_t* trace_out, uint64_t trace_capacity, bool* horizon_hit_out) {
+    return runRewriteLoop(eng, rule_handles, rule_count, policy, horizon_cap, seed,
+                          trace_out, trace_capacity, horizon_hit_out,
+                          [batch](sid::SidTernaryEngine& engine, const std::vector<int64_t>& handles,
+                                  const sid::FixpointOptions& options, sid::FixpointResult& result) {
+                              return engine.runParallelRewrites(handles, options, batch, result);
+                          });
+}
+
+int64_t sid_run_network_rewrites(sid_engine* eng, const int64_t* rule_handles, uint64_t rule_count,
+                                 const char* policy, uint64_t horizon_cap, uint64_t seed,
+                                 uint64_t* trace_out, uint64_t trace_capacity, bool* horizon_hit_out) {
+    return runRewriteLoop(eng, rule_handles, rule_count, policy, horizon_cap, seed,
+                          trace_out, trace_capacity, horizon_hit_out,
+                          [](sid::SidTernaryEngine& engine, const std::vector<int64_t>& handles,
+                             const sid::FixpointOptions& options, sid::FixpointResult& result) {
+                              return engine.runNetworkRewrites(handles, options, result);
+                          });
+}
+
+void sid_clear_rule_cache(sid_engine* eng) {
+    if (eng && eng->engine) {
+        eng->engine->clearRuleCache();
+    }
+}
+
 bool sid_set_diagram_expr(sid_engine* eng, const char* expr, const char* rule_id) {
     if (eng && eng->engine && expr && rule_id) {
         return eng->engine->setDiagramExpr(expr, rule_id);
@@ -164,4 +328,72 @@ const char* sid_get_diagram_json(sid_engine* eng) {
     return "{}";
 }
 
+bool sid_set_diagram_binary(sid_engine* eng, const uint8_t* data, uint64_t size) {
+    if (eng && eng->engine && (data || size == 0)) {
+        return eng->engine->setDiagramBinary(data, static_cast<size_t>(size));
+    }
+    return false;
+}
+
+const uint8_t* sid_get_diagram_binary(sid_engine* eng, uint64_t* size_out) {
+    static std::string binary_buffer;
+    binary_buffer.clear();
+    if (eng && eng->engine) {
+        binary_buffer = eng->engine->getDiagramBinary();
+    }
+    if (size_out) {
+        *size_out = binary_buffer.size();
+    }
+    return reinterpret_cast<const uint8_t*>(binary_buffer.data());
+}
+
+uint64_t sid_diagram_hash(sid_engine* eng) {
+    return (eng && eng->engine) ? eng->engine->diagramHash() : 0;
+}
+
+bool sid_checkpoint_engine(sid_engine* eng, const char* path, const char* metadata) {
+    if (!eng || !eng->engine || !path) {
+        return false;
+    }
+    try {
+        dase::CheckpointWriter writer;
+        eng->engine->saveCheckpoint(writer);
+        if (metadata) {
+            writer.addText("config", metadata);
+        }
+        writer.write(path);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool sid_restore_engine(sid_engine* eng, const char* path) {
+    if (!eng || !eng->engine || !path) {
+        return false;
+    }
+    try {
+        const dase::CheckpointImage image(path);
+        eng->engine->restoreCheckpoint(image);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool sid_copy_engine_state(sid_engine* dst, sid_engine* src) {
+    if (!dst || !dst->engine || !src || !src->engine) {
+        return false;
+    }
+    try {
+        dase::CheckpointWriter writer;
+        src->engine->saveCheckpoint(writer);
+        const auto buffer = writer.writeMemory();
+        dst->engine->restoreCheckpoint(dase::CheckpointImage(*buffer));
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 }  // extern "C"
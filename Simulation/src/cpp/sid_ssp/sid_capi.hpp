@@ -30,6 +30,8 @@ sid_ssp_t* sid_ssp_create(int role, unsigned long field_len, double capacity);
 void sid_ssp_destroy(sid_ssp_t* ssp);
 double* sid_ssp_field(sid_ssp_t* ssp);
 void sid_ssp_commit_step(sid_ssp_t* ssp);
+uint64_t sid_ssp_step(sid_ssp_t* ssp);
+void sid_ssp_restore_step(sid_ssp_t* ssp, uint64_t step);
 
 /* Engine lifecycle */
 sid_engine* sid_create_engine(uint64_t num_nodes, double total_mass);
@@ -39,6 +41,10 @@ void sid_destroy_engine(sid_engine* eng);
 void sid_step(sid_engine* eng, double alpha);
 uint64_t sid_get_step_count(sid_engine* eng);
 void sid_collapse(sid_engine* eng, double alpha);
+/* Collapse label on a diagram node (sid_collapse_mask.hpp): state 'I' / 'N'
+   routes weight of cell's U to I / N at each sid_collapse, 'U' marks the
+   cell undecided.  Labelled diagrams collapse only their labelled cells. */
+bool sid_label_collapse_node(sid_engine* eng, const char* node_id, char state, uint64_t cell, double weight);
 
 /* Metrics and queries */
 double sid_get_I_mass(sid_engine* eng);
@@ -47,9 +53,64 @@ double sid_get_U_mass(sid_engine* eng);
 double sid_get_instantaneous_gain(sid_engine* eng);
 bool sid_is_conserved(sid_engine* eng, double tolerance);
 
+/* Batched evolution for ensembles of engines.  sid_batch_run runs `steps`
+   rounds on each of `count` distinct engines (in parallel across engines,
+   OpenMP), a round being sid_step and / or sid_collapse with `alpha` as
+   `ops` selects, then writes each engine's state to results_out[i]
+   (ops = 0 or steps = 0 only reads it).  A NULL engine is skipped and
+   gets ok = false.  Returns false, doing nothing, if an engine appears
+   twice or results_out is NULL with count > 0. */
+#define SID_BATCH_STEP 1u
+#define SID_BATCH_COLLAPSE 2u
+
+typedef struct sid_batch_result {
+    double I_mass;
+    double N_mass;
+    double U_mass;
+    double instantaneous_gain;
+    uint64_t step_count;
+    bool is_conserved;   /* sid_is_conserved(eng, tolerance) */
+    bool ok;
+} sid_batch_result;
+
+bool sid_batch_run(sid_engine* const* engines, uint64_t count, uint32_t ops, double alpha,
+                   uint64_t steps, double tolerance, sid_batch_result* results_out);
+
 /* Rewrite system */
 bool sid_apply_rewrite(sid_engine* eng, const char* pattern,
                        const char* replacement, const char* rule_id);
+/* Compiled rules: parse once, apply by handle.  Compiling the same
+ * (pattern, replacement, rule_id) again returns the cached handle; a rule
+ * that does not parse still compiles, and applying it reports the error.
+ * sid_compile_rule returns -1 on a null argument. */
+int64_t sid_compile_rule(sid_engine* eng, const char* pattern,
+                         const char* replacement, const char* rule_id);
+bool sid_apply_compiled_rule(sid_engine* eng, int64_t rule_handle);
+uint64_t sid_compiled_rule_count(sid_engine* eng);
+void sid_clear_rule_cache(sid_engine* eng);  /* Invalidates all handles */
+/* Worklist fixpoint: rewrite with the compiled rules until none applies or
+ * horizon_cap rewrites ran.  policy orders the rules of each pass as in
+ * the CLI's sid_run_rewrites (P1 lexicographic, P2 reversed, P3 shuffled
+ * from seed; NULL = P1).  trace_out (may be NULL) receives the index into
+ * rule_handles of each rewrite, up to trace_capacity entries.  Returns the
+ * number of rewrites, or -1 on a bad argument, unknown handle or rewrite
+ * error (see sid_last_rewrite_message); *horizon_hit_out (may be NULL)
+ * tells a horizon stop from a fixed point. */
+int64_t sid_run_fixpoint(sid_engine* eng, const int64_t* rule_handles, uint64_t rule_count,
+                         const char* policy, uint64_t horizon_cap, uint64_t seed,
+                         uint64_t* trace_out, uint64_t trace_capacity, bool* horizon_hit_out);
+/* As sid_run_fixpoint, but each round searches every rule concurrently
+ * (OpenMP) and applies the highest-priority match, or with batch a maximal
+ * set of non-overlapping matches. */
+int64_t sid_run_parallel_rewrites(sid_engine* eng, const int64_t* rule_handles, uint64_t rule_count,
+                                  const char* policy, uint64_t horizon_cap, uint64_t seed, bool batch,
+                                  uint64_t* trace_out, uint64_t trace_capacity, bool* horizon_hit_out);
+/* Same rewrites as sid_run_parallel_rewrites without batch, with each
+ * round's match taken from a match network compiled from the rules and
+ * updated only where a rewrite changed the diagram. */
+int64_t sid_run_network_rewrites(sid_engine* eng, const int64_t* rule_handles, uint64_t rule_count,
+                                 const char* policy, uint64_t horizon_cap, uint64_t seed,
+                                 uint64_t* trace_out, uint64_t trace_capacity, bool* horizon_hit_out);
 bool sid_last_rewrite_applied(sid_engine* eng);
 const char* sid_last_rewrite_message(sid_engine* eng);
 
@@ -57,6 +118,23 @@ const char* sid_last_rewrite_message(sid_engine* eng);
 bool sid_set_diagram_expr(sid_engine* eng, const char* expr, const char* rule_id);
 bool sid_set_diagram_json(sid_engine* eng, const char* json);
 const char* sid_get_diagram_json(sid_engine* eng);
+/* Compact binary diagram (sid_diagram_io.hpp), e.g. for binary transports.
+   The returned bytes (*size_out of them) stay valid until the next call. */
+bool sid_set_diagram_binary(sid_engine* eng, const uint8_t* data, uint64_t size);
+const uint8_t* sid_get_diagram_binary(sid_engine* eng, uint64_t* size_out);
+/* Canonical structural hash (sid_diagram_hash.hpp): equal for diagrams that
+   differ only in node / edge IDs and order; 0 on a NULL engine. */
+uint64_t sid_diagram_hash(sid_engine* eng);
+
+/* Checkpoint / restore (binary image, engine_checkpoint.h).  metadata, if
+   not NULL, is stored as the image's "config" text section for the host.
+   Compiled rules are not saved; restoring needs the same node count and
+   leaves the engine unchanged on failure. */
+bool sid_checkpoint_engine(sid_engine* eng, const char* path, const char* metadata);
+bool sid_restore_engine(sid_engine* eng, const char* path);
+/* Copy src's checkpointed state (diagram included) into dst through an
+   in-memory image, e.g. to branch a clone; same rules as a restore. */
+bool sid_copy_engine_state(sid_engine* dst, sid_engine* src);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,283 @@
+/**
+ * SID Collapse Masks - Sparse dual masks built from diagram node labels
+ *
+ * CollapseMask (sid_semantic_processor.hpp) holds M_I / M_N densely, one
+ * double each per field cell.  A diagram usually labels a handful of cells,
+ * so a dense mask is mostly zeros and a dense collapse mostly multiplies by
+ * them.  SparseCollapseMask keeps only the labelled cells, in the cheapest
+ * of three forms:
+ *
+ *   Indexed  sorted cell list with per-cell M_I / M_N weights
+ *   Bitset   binary masks (every cell wholly I or wholly N): one bit per
+ *            cell and role, weights implied
+ *   Dense    M_I / M_N over the whole field, once the mask covers at least
+ *            kDenseDensity of it (a streaming pass then beats scattered
+ *            updates)
+ *
+ * Collapse per spec 03_COLLAPSE_MASKS.md: ΔI = α·M_I·U, ΔN = α·M_N·U,
+ * U loses both; cells outside the mask are not touched.
+ *
+ * Labels: a node with a Ternary attribute collapse_state and an int
+ * attribute collapse_cell (0 <= cell < field length) labels that cell, and
+ * collapse_weight (double or int in [0,1], default 1) scales it.  I adds
+ * the weight to M_I, N to M_N; U marks the cell undecided (no transfer).
+ * Weights of a cell labelled more than once add up, scaled down to
+ * M_I + M_N = 1 if they exceed it.  Malformed labels are ignored.
+ */
+
+#pragma once
+
+#include "sid_diagram.hpp"
+#include "sid_field_kernels.hpp"
+#include "sid_semantic_processor.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+namespace sid {
+
+class SparseCollapseMask {
+public:
+    enum class Form { Indexed, Bitset, Dense };
+
+    // Mask cells / field cells from which the Dense form is used
+    static constexpr double kDenseDensity = 0.25;
+
+    struct Cell {
+        uint32_t cell;
+        double weight_I;
+        double weight_N;
+    };
+
+    SparseCollapseMask() = default;
+
+    /**
+     * Mask of the cells `diagram` labels (see file comment); labelled()
+     * tells whether any node carried a well-formed label, U included
+     */
+    static SparseCollapseMask fromDiagram(const Diagram& diagram, size_t field_len) {
+        std::vector<Cell> cells;
+        bool labelled = false;
+        for (const Node& node : diagram.nodes()) {
+            Ternary state;
+            uint32_t cell;
+            double weight;
+            if (!readLabel(node, field_len, state, cell, weight)) continue;
+            labelled = true;
+            if (state == Ternary::I) {
+                cells.push_back(Cell{cell, weight, 0.0});
+            } else if (state == Ternary::N) {
+                cells.push_back(Cell{cell, 0.0, weight});
+            }
+        }
+        SparseCollapseMask mask = fromCells(field_len, std::move(cells));
+        mask.labelled_ = labelled;
+        return mask;
+    }
+
+    /**
+     * Non-zero cells of a dense mask
+     * @throws std::logic_error if the mask is not valid
+     */
+    static SparseCollapseMask fromDense(const CollapseMask& dense) {
+        if (!dense.is_valid()) {
+            throw std::logic_error("SparseCollapseMask requires a valid CollapseMask");
+        }
+        std::vector<Cell> cells;
+        for (size_t i = 0; i < dense.mask_I.size(); ++i) {
+            if (dense.mask_I[i] != 0.0 || dense.mask_N[i] != 0.0) {
+                cells.push_back(Cell{static_cast<uint32_t>(i), dense.mask_I[i], dense.mask_N[i]});
+            }
+        }
+        SparseCollapseMask mask = fromCells(dense.mask_I.size(), std::move(cells));
+        mask.labelled_ = !mask.empty();
+        return mask;
+    }
+
+    /**
+     * Merge `cells` (any order, repeats add up, weights clamped to [0,1] and
+     * scaled to M_I + M_N <= 1; cells >= field_len dropped) and pick a form
+     */
+    static SparseCollapseMask fromCells(size_t field_len, std::vector<Cell> cells) {
+        SparseCollapseMask mask;
+        mask.field_len_ = field_len;
+        std::sort(cells.begin(), cells.end(), [](const Cell& a, const Cell& b) { return a.cell < b.cell; });
+
+        bool binary = true;
+        for (size_t k = 0; k < cells.size();) {
+            Cell merged{cells[k].cell, 0.0, 0.0};
+            for (; k < cells.size() && cells[k].cell == merged.cell; ++k) {
+                merged.weight_I += clamp01(cells[k].weight_I);
+                merged.weight_N += clamp01(cells[k].weight_N);
+            }
+            const double total = merged.weight_I + merged.weight_N;
+            if (merged.cell >= field_len || total == 0.0) continue;
+            if (total > 1.0) {
+                merged.weight_I /= total;
+                merged.weight_N = std::min(merged.weight_N / total, 1.0 - merged.weight_I);   // Round-off
+            }
+            binary = binary && (merged.weight_I == 1.0 || merged.weight_N == 1.0);
+            mask.cells_.push_back(merged.cell);
+            mask.weight_I_.push_back(merged.weight_I);
+            mask.weight_N_.push_back(merged.weight_N);
+        }
+
+        const size_t count = mask.cells_.size();
+        if (count > 0 && static_cast<double>(count) >= kDenseDensity * static_cast<double>(field_len)) {
+            mask.form_ = Form::Dense;
+            mask.dense_I_.assign(field_len, 0.0);
+            mask.dense_N_.assign(field_len, 0.0);
+            for (size_t k = 0; k < count; ++k) {
+                mask.dense_I_[mask.cells_[k]] = mask.weight_I_[k];
+                mask.dense_N_[mask.cells_[k]] = mask.weight_N_[k];
+            }
+            mask.releaseList();
+        } else if (count > 0 && binary && count * 64 >= field_len) {
+            // At least one cell per bitset word on average: the two bitsets
+            // are smaller than the list and scan in a few field_len / 64 steps
+            mask.form_ = Form::Bitset;
+            const size_t words = (field_len + 63) / 64;
+            mask.bits_I_.assign(words, 0);
+            mask.bits_N_.assign(words, 0);
+            for (size_t k = 0; k < count; ++k) {
+                const uint32_t cell = mask.cells_[k];
+                auto& bits = mask.weight_I_[k] == 1.0 ? mask.bits_I_ : mask.bits_N_;
+                bits[cell / 64] |= uint64_t(1) << (cell % 64);
+            }
+            mask.releaseList();
+        }
+        mask.count_ = count;
+        return mask;
+    }
+
+    Form form() const { return form_; }
+    size_t fieldLength() const { return field_len_; }
+    size_t size() const { return count_; }   // Cells with a non-zero weight
+    bool empty() const { return count_ == 0; }
+    bool labelled() const { return labelled_; }
+    double density() const {
+        return field_len_ > 0 ? static_cast<double>(count_) / static_cast<double>(field_len_) : 0.0;
+    }
+
+    /**
+     * Collapse U into I / N over the masked cells of fields of
+     * fieldLength() cells (alpha in [0,1]); adds the mass I and N gained
+     * to moved_I / moved_N
+     */
+    void apply(bool simd, double* field_I, double* field_N, double* field_U, double alpha,
+               CompensatedSum& moved_I, CompensatedSum& moved_N) const {
+        switch (form_) {
+            case Form::Dense:
+                FieldKernels::maskTransfer(simd, field_I, field_N, field_U, dense_I_.data(), dense_N_.data(),
+                                           field_len_, alpha, moved_I, moved_N);
+                return;
+            case Form::Bitset:
+                for (size_t w = 0; w < bits_I_.size(); w += kFieldBlock / 64) {
+                    const size_t end = std::min(bits_I_.size(), w + kFieldBlock / 64);
+                    moved_I.add(FieldKernels::bitsTransfer(field_I, field_U, bits_I_.data(), w, end, alpha));
+                    moved_N.add(FieldKernels::bitsTransfer(field_N, field_U, bits_N_.data(), w, end, alpha));
+                }
+                return;
+            case Form::Indexed:
+            default:
+                for (size_t k = 0; k < cells_.size(); k += kFieldBlock) {
+                    const size_t len = std::min(kFieldBlock, cells_.size() - k);
+                    double block_I = 0.0;
+                    double block_N = 0.0;
+                    FieldKernels::maskTransferIndexed(field_I, field_N, field_U, cells_.data() + k,
+                                                      weight_I_.data() + k, weight_N_.data() + k, len, alpha,
+                                                      block_I, block_N);
+                    moved_I.add(block_I);
+                    moved_N.add(block_N);
+                }
+                return;
+        }
+    }
+
+    /**
+     * The same mask as a dense CollapseMask
+     */
+    CollapseMask toDense() const {
+        CollapseMask dense(field_len_);
+        switch (form_) {
+            case Form::Dense:
+                dense.mask_I = dense_I_;
+                dense.mask_N = dense_N_;
+                break;
+            case Form::Bitset:
+                for (size_t i = 0; i < field_len_; ++i) {
+                    if (bits_I_[i / 64] >> (i % 64) & 1) dense.mask_I[i] = 1.0;
+                    if (bits_N_[i / 64] >> (i % 64) & 1) dense.mask_N[i] = 1.0;
+                }
+                break;
+            case Form::Indexed:
+            default:
+                for (size_t k = 0; k < cells_.size(); ++k) {
+                    dense.mask_I[cells_[k]] = weight_I_[k];
+                    dense.mask_N[cells_[k]] = weight_N_[k];
+                }
+                break;
+        }
+        return dense;
+    }
+
+    /**
+     * Read the collapse label of `node`; false if it has none or it is
+     * malformed (missing / mistyped state or cell, cell out of range,
+     * weight outside [0,1])
+     */
+    static bool readLabel(const Node& node, size_t field_len, Ternary& state, uint32_t& cell, double& weight) {
+        auto state_it = node.attributes.find(attr_keys::kCollapseState);
+        auto cell_it = node.attributes.find(attr_keys::kCollapseCell);
+        if (state_it == node.attributes.end() || cell_it == node.attributes.end() ||
+            !std::holds_alternative<Ternary>(state_it->second) || !std::holds_alternative<int>(cell_it->second)) {
+            return false;
+        }
+        const int index = std::get<int>(cell_it->second);
+        if (index < 0 || static_cast<size_t>(index) >= field_len) return false;
+
+        weight = 1.0;
+        auto weight_it = node.attributes.find(attr_keys::kCollapseWeight);
+        if (weight_it != node.attributes.end()) {
+            if (std::holds_alternative<double>(weight_it->second)) {
+                weight = std::get<double>(weight_it->second);
+            } else if (std::holds_alternative<int>(weight_it->second)) {
+                weight = std::get<int>(weight_it->second);
+            } else {
+                return false;
+            }
+            if (!(weight >= 0.0 && weight <= 1.0)) return false;
+        }
+        state = std::get<Ternary>(state_it->second);
+        cell = static_cast<uint32_t>(index);
+        return true;
+    }
+
+private:
+    Form form_ = Form::Indexed;
+    size_t field_len_ = 0;
+    size_t count_ = 0;
+    bool labelled_ = false;
+    std::vector<uint32_t> cells_;   // Indexed: sorted, distinct
+    std::vector<double> weight_I_;
+    std::vector<double> weight_N_;
+    std::vector<uint64_t> bits_I_;  // Bitset: cell i = bit i % 64 of word i / 64
+    std::vector<uint64_t> bits_N_;
+    std::vector<double> dense_I_;   // Dense: field_len_ each
+    std::vector<double> dense_N_;
+
+    static double clamp01(double x) {
+        return x < 0.0 ? 0.0 : (x > 1.0 ? 1.0 : x);
+    }
+
+    void releaseList() {
+        cells_ = std::vector<uint32_t>();
+        weight_I_ = std::vector<double>();
+        weight_N_ = std::vector<double>();
+    }
+};
+
+} // namespace sid
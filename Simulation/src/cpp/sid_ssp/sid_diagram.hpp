@@ -7,11 +7,16 @@
 
 #pragma once
 
+#include "sid_attr_map.hpp"
+#include "sid_graph_index.hpp"
+
 #include <algorithm>
+#include <cstdint>
 #include <map>
-#include <set>
-#include <stack>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -48,8 +53,8 @@ struct Node {
     std::string op;  // Operator: P, S+, S-, O, C, T
     std::vector<std::string> inputs;  // Input node IDs
     std::vector<std::string> dof_refs;  // DOF references
-    std::map<std::string, AttrValue> attributes;
-    std::map<std::string, std::variant<bool, std::vector<std::string>>> meta;  // Metadata storage
+    FlatAttrMap<AttrValue> attributes;
+    FlatAttrMap<std::variant<bool, std::vector<std::string>>> meta;  // Metadata storage
     bool irreversible = false;  // For O (Collapse) operators
 
     Node() = default;
@@ -66,7 +71,7 @@ struct Edge {
     std::string to;
     std::string label;  // Edge type/label
     int port = 0;  // Port number for ordering
-    std::map<std::string, AttrValue> attributes;
+    FlatAttrMap<AttrValue> attributes;
 
     Edge() = default;
     Edge(const std::string& edge_id, const std::string& from_id,
@@ -78,6 +83,20 @@ struct Edge {
  * Diagram - Directed graph of nodes and edges
  *
  * Implements iterative cycle detection (fixes CRITICAL bug from Python version)
+ *
+ * Lookups and traversals go through an index of interned node IDs (see
+ * sid_graph_index.hpp): id -> node and id -> edge hash maps plus forward /
+ * reverse CSR adjacency.  add_node / add_edge / remove_edge and the
+ * take / put / set_edge_target primitives patch the index in place.  The
+ * mutable nodes() / edges() accessors and mark_dirty() invalidate it, and
+ * the next query rebuilds it in O(nodes + edges).  An
+ * operator / atom label index serves rewrite matching.  IDs and labels
+ * must not be changed through find_node / find_edge pointers.
+ *
+ * The patching operations also maintain a topological order of the symbols
+ * (TopologicalOrder), so has_cycle() is O(1) between rebuilds and
+ * try_add_edge() rejects an edge that would close a cycle after searching
+ * only the part of the order the edge affects.
  */
 class Diagram {
 private:
@@ -86,23 +105,105 @@ private:
     std::vector<Node> nodes_;
     std::vector<Edge> edges_;
 
-    // Cached adjacency lists (rebuilt when diagram changes)
-    mutable std::map<std::string, std::vector<std::string>> adjacency_list_;
-    mutable std::map<std::string, std::vector<std::string>> reverse_adjacency_list_;
-    mutable bool adjacency_dirty_ = true;
+    // Index over nodes_ / edges_ (rebuilt when dirty, otherwise patched)
+    mutable SymbolTable symbols_;                    // Node IDs, incl. edge-only endpoints
+    mutable std::vector<uint32_t> node_of_symbol_;   // Position in nodes_, or kNoSymbol
+    mutable std::unordered_map<std::string, uint32_t> edge_index_;
+    mutable CsrAdjacency forward_;                   // from -> to
+    mutable CsrAdjacency reverse_;                   // to -> from
+    mutable std::unordered_map<std::string, std::vector<uint32_t>> op_index_;    // op -> positions
+    mutable std::unordered_map<std::string, std::vector<uint32_t>> atom_index_;  // atom -> positions
+    mutable bool index_dirty_ = true;
+    mutable TopologicalOrder order_;                 // Sorted lazily after a rebuild
+
+    // Next index to try per generated-ID prefix (see id_counter)
+    mutable std::unordered_map<std::string, int> id_counters_;
+
+    // Calls fn(positions) for the op bucket and each atom bucket of a node
+    template <typename Fn>
+    void visit_label_buckets(const Node& node, Fn fn) const {
+        fn(op_index_[node.op]);
+        if (node.op == "P") {
+            for (const auto& dof : node.dof_refs) fn(atom_index_[dof]);
+        }
+        auto meta_it = node.meta.find(attr_keys::kAtomArgs);
+        if (meta_it != node.meta.end() &&
+            std::holds_alternative<std::vector<std::string>>(meta_it->second)) {
+            for (const auto& arg : std::get<std::vector<std::string>>(meta_it->second)) fn(atom_index_[arg]);
+        }
+    }
+
+    // Label index entries for the node at `position` (buckets stay sorted;
+    // appends are O(1) since positions only grow between rebuilds)
+    void index_labels(const Node& node, uint32_t position) const {
+        visit_label_buckets(node, [position](std::vector<uint32_t>& positions) {
+            auto it = std::lower_bound(positions.begin(), positions.end(), position);
+            if (it == positions.end() || *it != position) positions.insert(it, position);
+        });
+    }
+
+    void unindex_labels(const Node& node, uint32_t position) const {
+        visit_label_buckets(node, [position](std::vector<uint32_t>& positions) {
+            auto it = std::lower_bound(positions.begin(), positions.end(), position);
+            if (it != positions.end() && *it == position) positions.erase(it);
+        });
+    }
+
+    void rebuild_index() const {
+        if (!index_dirty_) return;
+
+        symbols_.clear();
+        symbols_.reserve(nodes_.size());
+        node_of_symbol_.clear();
+        op_index_.clear();
+        atom_index_.clear();
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            const uint32_t symbol = symbols_.intern(nodes_[i].id);
+            if (symbol == node_of_symbol_.size()) {
+                node_of_symbol_.push_back(static_cast<uint32_t>(i));  // First node wins
+            }
+            index_labels(nodes_[i], static_cast<uint32_t>(i));
+        }
 
-    void rebuild_adjacency() const {
-        if (!adjacency_dirty_) return;
+        edge_index_.clear();
+        edge_index_.reserve(edges_.size());
+        std::vector<std::pair<uint32_t, uint32_t>> forward_edges;
+        std::vector<std::pair<uint32_t, uint32_t>> reverse_edges;
+        forward_edges.reserve(edges_.size());
+        reverse_edges.reserve(edges_.size());
+        for (size_t e = 0; e < edges_.size(); ++e) {
+            const uint32_t from = symbols_.intern(edges_[e].from);
+            const uint32_t to = symbols_.intern(edges_[e].to);
+            edge_index_.emplace(edges_[e].id, static_cast<uint32_t>(e));
+            forward_edges.emplace_back(from, to);
+            reverse_edges.emplace_back(to, from);
+        }
+        node_of_symbol_.resize(symbols_.size(), kNoSymbol);
+        forward_.build(symbols_.size(), forward_edges);
+        reverse_.build(symbols_.size(), reverse_edges);
+        order_.invalidate();
 
-        adjacency_list_.clear();
-        reverse_adjacency_list_.clear();
+        index_dirty_ = false;
+    }
 
-        for (const auto& edge : edges_) {
-            adjacency_list_[edge.from].push_back(edge.to);
-            reverse_adjacency_list_[edge.to].push_back(edge.from);
+    void ensure_order() const {
+        if (order_.state() == TopologicalOrder::State::Unknown) {
+            order_.rebuild(symbols_.size(), forward_);
         }
+    }
 
-        adjacency_dirty_ = false;
+    static const std::vector<uint32_t>& empty_positions() {
+        static const std::vector<uint32_t> empty;
+        return empty;
+    }
+
+    uint32_t intern_endpoint(const std::string& node_id) {
+        const uint32_t symbol = symbols_.intern(node_id);
+        if (symbol == node_of_symbol_.size()) {
+            node_of_symbol_.push_back(kNoSymbol);
+            order_.addSymbol(symbol);
+        }
+        return symbol;
     }
 
 public:
@@ -117,58 +218,285 @@ public:
     void set_compartment_id(const std::string& comp_id) { compartment_id_ = comp_id; }
     void setCompartment(const std::string& comp_id) { compartment_id_ = comp_id; }  // Alias for compatibility
 
+    // Mutable access invalidates the index
     const std::vector<Node>& nodes() const { return nodes_; }
-    std::vector<Node>& nodes() { return nodes_; }
+    std::vector<Node>& nodes() { index_dirty_ = true; return nodes_; }
 
     const std::vector<Edge>& edges() const { return edges_; }
-    std::vector<Edge>& edges() { return edges_; }
+    std::vector<Edge>& edges() { index_dirty_ = true; return edges_; }
+
+    size_t nodes_count() const { return nodes_.size(); }
+    size_t edges_count() const { return edges_.size(); }
 
     // Node operations
     void add_node(const Node& node) {
+        if (!index_dirty_) {
+            const uint32_t symbol = intern_endpoint(node.id);
+            if (node_of_symbol_[symbol] == kNoSymbol) {
+                node_of_symbol_[symbol] = static_cast<uint32_t>(nodes_.size());
+            }
+            index_labels(node, static_cast<uint32_t>(nodes_.size()));
+        }
         nodes_.push_back(node);
     }
 
     void addNode(const Node& node) {  // CamelCase alias for compatibility
-        nodes_.push_back(node);
+        add_node(node);
     }
 
     Node* find_node(const std::string& node_id) {
-        for (auto& node : nodes_) {
-            if (node.id == node_id) return &node;
-        }
-        return nullptr;
+        const uint32_t position = node_position(node_id);
+        return position != kNoSymbol ? &nodes_[position] : nullptr;
     }
 
     const Node* find_node(const std::string& node_id) const {
-        for (const auto& node : nodes_) {
-            if (node.id == node_id) return &node;
-        }
-        return nullptr;
+        const uint32_t position = node_position(node_id);
+        return position != kNoSymbol ? &nodes_[position] : nullptr;
     }
 
     // Edge operations
     void add_edge(const Edge& edge) {
+        if (!index_dirty_) {
+            const uint32_t e = static_cast<uint32_t>(edges_.size());
+            const uint32_t from = intern_endpoint(edge.from);
+            const uint32_t to = intern_endpoint(edge.to);
+            edge_index_.emplace(edge.id, e);
+            forward_.insert(from, to, e);
+            reverse_.insert(to, from, e);
+            order_.insertEdge(from, to, forward_, reverse_);
+        }
         edges_.push_back(edge);
-        adjacency_dirty_ = true;
+    }
+
+    /**
+     * Add an edge unless it would close a cycle
+     *
+     * On an acyclic diagram the check only searches the nodes ordered
+     * between the edge's endpoints; on a cyclic one, what `to` reaches.
+     *
+     * @return false (nothing added) if `to` already reaches `from`
+     */
+    bool try_add_edge(const Edge& edge) {
+        rebuild_index();
+        ensure_order();
+        const uint32_t from = intern_endpoint(edge.from);
+        const uint32_t to = intern_endpoint(edge.to);
+        if (order_.wouldCycle(from, to, forward_)) return false;
+        add_edge(edge);
+        return true;
     }
 
     void addEdge(const Edge& edge) {  // CamelCase alias for compatibility
-        edges_.push_back(edge);
-        adjacency_dirty_ = true;
+        add_edge(edge);
     }
 
-    Edge* find_edge(const std::string& edge_id) {
-        for (auto& edge : edges_) {
-            if (edge.id == edge_id) return &edge;
+    /**
+     * Remove an edge by ID (assumes edge IDs are unique).  The last edge
+     * takes its slot, so edges() order is not preserved.
+     *
+     * @return false if no edge has this ID
+     */
+    bool remove_edge(const std::string& edge_id) {
+        const uint32_t position = edge_position(edge_id);
+        if (position == kNoSymbol) return false;
+        take_edge_at(position);
+        return true;
+    }
+
+    /**
+     * Swap-remove primitives and their exact inverses, for in-place rewrites
+     * and their undo logs.  take_*_at(p) moves the last element into slot p;
+     * put_*_at(p, x) moves the occupant of p back to the end and puts x in
+     * slot p, so replaying takes in reverse order with puts restores the
+     * nodes() / edges() order.  Node IDs are assumed unique.
+     */
+    Node take_node_at(uint32_t position) {
+        rebuild_index();
+        const uint32_t last = static_cast<uint32_t>(nodes_.size() - 1);
+        Node removed = std::move(nodes_[position]);
+        unindex_labels(removed, position);
+        const uint32_t symbol = symbols_.find(removed.id);
+        if (node_of_symbol_[symbol] == position) {
+            node_of_symbol_[symbol] = kNoSymbol;
+        }
+
+        if (position != last) {
+            unindex_labels(nodes_[last], last);
+            nodes_[position] = std::move(nodes_[last]);
+            index_labels(nodes_[position], position);
+            const uint32_t moved = symbols_.find(nodes_[position].id);
+            if (node_of_symbol_[moved] == last) {
+                node_of_symbol_[moved] = position;
+            }
         }
-        return nullptr;
+        nodes_.pop_back();
+        return removed;
     }
 
-    const Edge* find_edge(const std::string& edge_id) const {
-        for (const auto& edge : edges_) {
-            if (edge.id == edge_id) return &edge;
+    void put_node_at(uint32_t position, Node node) {
+        rebuild_index();
+        const uint32_t last = static_cast<uint32_t>(nodes_.size());
+        if (position == last) {
+            add_node(node);
+            return;
+        }
+
+        nodes_.push_back(std::move(nodes_[position]));
+        unindex_labels(nodes_[last], position);
+        index_labels(nodes_[last], last);
+        const uint32_t moved = symbols_.find(nodes_[last].id);
+        if (node_of_symbol_[moved] == position) {
+            node_of_symbol_[moved] = last;
+        }
+
+        nodes_[position] = std::move(node);
+        index_labels(nodes_[position], position);
+        const uint32_t symbol = intern_endpoint(nodes_[position].id);
+        if (node_of_symbol_[symbol] == kNoSymbol || node_of_symbol_[symbol] > position) {
+            node_of_symbol_[symbol] = position;
         }
-        return nullptr;
+    }
+
+    Edge take_edge_at(uint32_t position) {
+        rebuild_index();
+        const uint32_t last = static_cast<uint32_t>(edges_.size() - 1);
+        Edge removed = std::move(edges_[position]);
+        forward_.erase(symbols_.find(removed.from), position);
+        reverse_.erase(symbols_.find(removed.to), position);
+        order_.eraseEdge();
+        auto it = edge_index_.find(removed.id);
+        if (it != edge_index_.end() && it->second == position) {
+            edge_index_.erase(it);
+        }
+
+        if (position != last) {
+            edges_[position] = std::move(edges_[last]);
+            forward_.renameEdge(symbols_.find(edges_[position].from), last, position);
+            reverse_.renameEdge(symbols_.find(edges_[position].to), last, position);
+            auto moved = edge_index_.find(edges_[position].id);
+            if (moved != edge_index_.end() && moved->second == last) {
+                moved->second = position;
+            }
+        }
+        edges_.pop_back();
+        return removed;
+    }
+
+    void put_edge_at(uint32_t position, Edge edge) {
+        rebuild_index();
+        const uint32_t last = static_cast<uint32_t>(edges_.size());
+        if (position == last) {
+            add_edge(edge);
+            return;
+        }
+
+        edges_.push_back(std::move(edges_[position]));
+        forward_.renameEdge(symbols_.find(edges_[last].from), position, last);
+        reverse_.renameEdge(symbols_.find(edges_[last].to), position, last);
+        auto moved = edge_index_.find(edges_[last].id);
+        if (moved != edge_index_.end() && moved->second == position) {
+            moved->second = last;
+        }
+
+        edges_[position] = std::move(edge);
+        const uint32_t from = intern_endpoint(edges_[position].from);
+        const uint32_t to = intern_endpoint(edges_[position].to);
+        edge_index_[edges_[position].id] = position;
+        forward_.insert(from, to, position);
+        reverse_.insert(to, from, position);
+        order_.insertEdge(from, to, forward_, reverse_);
+    }
+
+    // Re-point an edge at another node, patching only its two rows
+    void set_edge_target(uint32_t position, const std::string& to_id) {
+        rebuild_index();
+        Edge& edge = edges_[position];
+        const uint32_t from = symbols_.find(edge.from);
+        const uint32_t to = intern_endpoint(to_id);
+        reverse_.erase(symbols_.find(edge.to), position);
+        forward_.retarget(from, position, to);
+        reverse_.insert(to, from, position);
+        order_.eraseEdge();
+        order_.insertEdge(from, to, forward_, reverse_);
+        edge.to = to_id;
+    }
+
+    // Position of the edge in edges(), or kNoSymbol
+    uint32_t edge_position(const std::string& edge_id) const {
+        rebuild_index();
+        auto it = edge_index_.find(edge_id);
+        return it != edge_index_.end() ? it->second : kNoSymbol;
+    }
+
+    Edge* find_edge(const std::string& edge_id) {
+        rebuild_index();
+        auto it = edge_index_.find(edge_id);
+        return it != edge_index_.end() ? &edges_[it->second] : nullptr;
+    }
+
+    const Edge* find_edge(const std::string& edge_id) const {
+        rebuild_index();
+        auto it = edge_index_.find(edge_id);
+        return it != edge_index_.end() ? &edges_[it->second] : nullptr;
+    }
+
+    // Integer-ID layer.  Symbols are stable until the index is invalidated;
+    // neighbour ranges only until the next modification.
+
+    // Dense symbol of a node ID (also IDs only referenced by edges), or kNoSymbol
+    uint32_t node_symbol(const std::string& node_id) const {
+        rebuild_index();
+        return symbols_.find(node_id);
+    }
+
+    const std::string& symbol_name(uint32_t symbol) const {
+        rebuild_index();
+        return symbols_.name(symbol);
+    }
+
+    size_t symbol_count() const {
+        rebuild_index();
+        return symbols_.size();
+    }
+
+    // Build the index now, e.g. before threads share the diagram read-only
+    // (queries on a clean index do not write)
+    void build_index() const {
+        rebuild_index();
+    }
+
+    // Position of the node in nodes(), or kNoSymbol
+    uint32_t node_position(const std::string& node_id) const {
+        rebuild_index();
+        const uint32_t symbol = symbols_.find(node_id);
+        return symbol != kNoSymbol ? node_of_symbol_[symbol] : kNoSymbol;
+    }
+
+    // Positions in nodes() of the nodes with this operator, ascending
+    const std::vector<uint32_t>& nodes_with_op(const std::string& op) const {
+        rebuild_index();
+        auto it = op_index_.find(op);
+        return it != op_index_.end() ? it->second : empty_positions();
+    }
+
+    // Positions of the nodes a literal atom pattern can match: P nodes with
+    // the atom in dof_refs, and nodes with it in meta["atom_args"]; ascending
+    const std::vector<uint32_t>& nodes_with_atom(const std::string& atom) const {
+        rebuild_index();
+        auto it = atom_index_.find(atom);
+        return it != atom_index_.end() ? it->second : empty_positions();
+    }
+
+    // Targets of the symbol's out-edges, in edge insertion order
+    NeighborRange successors(uint32_t symbol) const {
+        rebuild_index();
+        return forward_.row(symbol);
+    }
+
+    // Sources of the symbol's in-edges
+    NeighborRange predecessors(uint32_t symbol) const {
+        rebuild_index();
+        return reverse_.row(symbol);
     }
 
     /**
@@ -178,10 +506,9 @@ public:
     std::vector<std::string> get_inputs(const std::string& node_id) const {
         std::vector<std::pair<int, std::string>> port_edges;
 
-        for (const auto& edge : edges_) {
-            if (edge.to == node_id) {
-                port_edges.push_back({edge.port, edge.from});
-            }
+        const NeighborRange in = predecessors(node_symbol(node_id));
+        for (size_t i = 0; i < in.size(); ++i) {
+            port_edges.push_back({edges_[in.edges[i]].port, symbols_.name(in.first[i])});
         }
 
         // Sort by port number
@@ -202,84 +529,66 @@ public:
     std::vector<std::string> get_outputs(const std::string& node_id) const {
         std::vector<std::string> result;
 
-        for (const auto& edge : edges_) {
-            if (edge.from == node_id) {
-                result.push_back(edge.to);
-            }
+        const NeighborRange out = successors(node_symbol(node_id));
+        result.reserve(out.size());
+        for (uint32_t to : out) {
+            result.push_back(symbols_.name(to));
         }
 
         return result;
     }
 
     /**
-     * Iterative cycle detection using DFS
+     * Whether the diagram has a directed cycle
      *
-     * CRITICAL BUG FIX: Python version used recursive DFS which could hit
-     * recursion limit. This iterative version scales to large graphs.
+     * O(1) while the maintained topological order is current; the first
+     * query after the index is rebuilt (or after an edge is removed from a
+     * cyclic diagram) sorts every node, O(nodes + edges), iteratively
+     * (the Python version's recursive DFS hit the recursion limit).
      */
     bool has_cycle() const {
-        rebuild_adjacency();
-
-        std::set<std::string> visited;
-        std::set<std::string> rec_stack;
+        rebuild_index();
+        ensure_order();
+        return order_.state() == TopologicalOrder::State::Cyclic;
+    }
 
-        // Get all node IDs
-        std::vector<std::string> all_nodes;
-        for (const auto& node : nodes_) {
-            all_nodes.push_back(node.id);
-        }
+    /**
+     * Where sid_rewrite's nextNodeId / nextEdgeId resume probing prefix +
+     * index, so generating n IDs costs O(n) rather than O(n^2).  IDs are not
+     * reused after their node or edge is removed.
+     */
+    int& id_counter(const std::string& prefix) const {
+        return id_counters_.emplace(prefix, 1).first->second;
+    }
 
-        // Try starting DFS from each unvisited node
-        for (const auto& start : all_nodes) {
-            if (visited.count(start)) continue;
-
-            // Iterative DFS with explicit stack
-            std::stack<std::pair<std::string, bool>> dfs_stack;
-            dfs_stack.push({start, false});
-
-            while (!dfs_stack.empty()) {
-                auto [node_id, backtracking] = dfs_stack.top();
-                dfs_stack.pop();
-
-                if (backtracking) {
-                    // Remove from recursion stack when done exploring
-                    rec_stack.erase(node_id);
-                    continue;
-                }
-
-                if (visited.count(node_id)) continue;
-
-                // Check if already in recursion stack (cycle detected)
-                if (rec_stack.count(node_id)) {
-                    return true;
-                }
-
-                visited.insert(node_id);
-                rec_stack.insert(node_id);
-
-                // Mark for backtracking
-                dfs_stack.push({node_id, true});
-
-                // Push neighbors
-                auto it = adjacency_list_.find(node_id);
-                if (it != adjacency_list_.end()) {
-                    for (const auto& neighbor : it->second) {
-                        if (!visited.count(neighbor)) {
-                            dfs_stack.push({neighbor, false});
-                        }
-                    }
-                }
+    /**
+     * Whether any of the target symbols can be reached from `from` along
+     * one or more edges.  Visits only what `from` reaches, so a change known
+     * to be local can be cycle-checked without walking the whole diagram.
+     */
+    bool reaches_any(uint32_t from, const std::vector<uint32_t>& targets) const {
+        rebuild_index();
+        if (from == kNoSymbol) return false;
+
+        std::unordered_set<uint32_t> goal(targets.begin(), targets.end());
+        std::unordered_set<uint32_t> visited;
+        std::vector<uint32_t> stack(1, from);
+        while (!stack.empty()) {
+            const uint32_t current = stack.back();
+            stack.pop_back();
+            for (uint32_t next : forward_.row(current)) {
+                if (goal.count(next)) return true;
+                if (visited.insert(next).second) stack.push_back(next);
             }
         }
-
         return false;
     }
 
     /**
-     * Mark adjacency lists as dirty (call after modifying edges)
+     * Mark the index as dirty (call after modifying nodes or edges directly)
      */
     void mark_dirty() {
-        adjacency_dirty_ = true;
+        index_dirty_ = true;
     }
 };
 
@@ -127,7 +127,7 @@ inline BuildInfo buildExpr(const ASTNode& expr, DiagramBuildContext& ctx) {
     } else if (!atom_args.empty()) {
         // Other operators: store atoms in metadata for reference
         // (This is for tracking purposes; actual semantics use input edges)
-        node.meta["atom_args"] = atom_args;
+        node.meta[attr_keys::kAtomArgs] = atom_args;
     }
 
     ctx.nodes.push_back(node);
@@ -172,7 +172,7 @@ inline Diagram exprToDiagram(const ASTNode& expr,
         node.id = node_id;
         node.op = "P";
         node.dof_refs.push_back(info.atoms[0]);
-        node.meta["atom_only"] = true;
+        node.meta[attr_keys::kAtomOnly] = true;
         ctx.nodes.push_back(node);
         info.node_id = node_id;
     }
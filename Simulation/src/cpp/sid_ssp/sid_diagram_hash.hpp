@@ -0,0 +1,320 @@
+/**
+ * SID Diagram Hash - Canonical structural hash and rewrite memo table
+ *
+ * DiagramHasher gives a Diagram a 64-bit hash of the structure rewrite
+ * matching reads: each node's op, dof_refs, atom arguments and ordered
+ * inputs.  Node and edge IDs, node order and edges are left out, so two
+ * diagrams that differ only by renaming (e.g. the same state reached by
+ * different rewrite sequences) hash alike.
+ *
+ * Node hashes are Weisfeiler-Lehman style: round 0 hashes a node's own
+ * fields, round k mixes in the round k-1 hashes of its inputs in order.
+ * After kRounds rounds a node's hash stands for its input tree kRounds
+ * levels deep.  The diagram hash is the wrapping sum of the final node
+ * hashes (a multiset hash), so a local change only re-hashes the nodes
+ * within kRounds consumer hops of it: update() is O(changed region), not
+ * O(diagram).
+ *
+ * RewriteMemo is a bounded direct-mapped table of (diagram hash, rule)
+ * pairs known to have no match.  A rule whose pattern is at most kRounds
+ * deep and binds each variable once matches a diagram iff it matches any
+ * diagram of the same hash (up to 64-bit collisions), so a repeated search
+ * can be answered from the table.
+ */
+
+#pragma once
+
+#include "sid_diagram.hpp"
+#include "sid_rewrite.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+namespace sid {
+
+namespace hash_detail {
+
+inline uint64_t mix(uint64_t x) {
+    // splitmix64 finalizer
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t combine(uint64_t seed, uint64_t value) {
+    return mix(seed ^ (value + 0x632BE59BD9B4E019ull + (seed << 6) + (seed >> 2)));
+}
+
+// FNV-1a: stable across runs and platforms, unlike std::hash
+inline uint64_t hashString(const std::string& text) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (unsigned char c : text) {
+        h = (h ^ c) * 0x100000001B3ull;
+    }
+    return h;
+}
+
+inline uint64_t hashStrings(uint64_t seed, const std::vector<std::string>& values) {
+    seed = combine(seed, values.size());
+    for (const auto& value : values) {
+        seed = combine(seed, hashString(value));
+    }
+    return seed;
+}
+
+constexpr uint64_t kMissingInput = 0x5D1A6E0F2B7C4391ull;
+
+} // namespace hash_detail
+
+/**
+ * Incrementally maintained canonical hash of one Diagram
+ */
+class DiagramHasher {
+public:
+    static constexpr int kRounds = 4;
+
+private:
+    struct Entry {
+        std::vector<std::string> inputs;               // As hashed, to unlink on removal
+        std::array<uint64_t, kRounds + 1> rounds{};    // rounds[0] = own fields
+    };
+
+    std::unordered_map<std::string, Entry> entries_;
+    // Input ID -> IDs of nodes listing it (ID may name no node)
+    std::unordered_map<std::string, std::vector<std::string>> consumers_;
+    uint64_t total_ = 0;
+    bool valid_ = false;
+
+    static uint64_t labelHash(const Node& node) {
+        uint64_t h = hash_detail::hashString(node.op);
+        h = hash_detail::hashStrings(h, node.dof_refs);
+        auto meta_it = node.meta.find(attr_keys::kAtomArgs);
+        if (meta_it != node.meta.end() && std::holds_alternative<std::vector<std::string>>(meta_it->second)) {
+            h = hash_detail::hashStrings(hash_detail::combine(h, 1), std::get<std::vector<std::string>>(meta_it->second));
+        }
+        return hash_detail::combine(h, node.inputs.size());
+    }
+
+    uint64_t inputHash(const std::string& id, int round) const {
+        auto it = entries_.find(id);
+        return it == entries_.end() ? hash_detail::kMissingInput : it->second.rounds[round];
+    }
+
+    uint64_t roundHash(const Entry& entry, int round) const {
+        uint64_t h = hash_detail::combine(entry.rounds[round - 1], static_cast<uint64_t>(round));
+        for (const auto& input : entry.inputs) {
+            h = hash_detail::combine(h, inputHash(input, round - 1));
+        }
+        return h;
+    }
+
+    static uint64_t contribution(const Entry& entry) {
+        return hash_detail::mix(entry.rounds[kRounds]);
+    }
+
+    void link(const std::string& id, const Entry& entry) {
+        for (const auto& input : entry.inputs) {
+            consumers_[input].push_back(id);
+        }
+    }
+
+    void unlink(const std::string& id, const Entry& entry) {
+        for (const auto& input : entry.inputs) {
+            auto it = consumers_.find(input);
+            if (it == consumers_.end()) continue;
+            auto& list = it->second;
+            for (size_t i = 0; i < list.size(); ++i) {
+                if (list[i] == id) {
+                    list[i] = std::move(list.back());
+                    list.pop_back();
+                    break;
+                }
+            }
+            if (list.empty()) consumers_.erase(it);
+        }
+    }
+
+public:
+    bool valid() const { return valid_; }
+
+    // Forget the diagram; the next hash() needs a reset()
+    void invalidate() {
+        entries_.clear();
+        consumers_.clear();
+        total_ = 0;
+        valid_ = false;
+    }
+
+    // Hash every node of `diagram` from scratch: O(kRounds * nodes)
+    void reset(const Diagram& diagram) {
+        invalidate();
+        entries_.reserve(diagram.nodes_count());
+        for (const auto& node : diagram.nodes()) {
+            Entry entry;
+            entry.inputs = node.inputs;
+            entry.rounds[0] = labelHash(node);
+            link(node.id, entry);
+            entries_[node.id] = std::move(entry);
+        }
+        for (int round = 1; round <= kRounds; ++round) {
+            for (auto& [id, entry] : entries_) {
+                entry.rounds[round] = roundHash(entry, round);
+            }
+        }
+        for (const auto& [id, entry] : entries_) {
+            total_ += contribution(entry);
+        }
+        valid_ = true;
+    }
+
+    /**
+     * Re-hash after the nodes named in `changed` were added, removed or
+     * modified in `diagram` (other nodes unchanged).  Requires valid().
+     */
+    void update(const Diagram& diagram, const std::vector<std::string>& changed) {
+        for (const auto& id : changed) {
+            auto it = entries_.find(id);
+            if (it != entries_.end()) {
+                total_ -= contribution(it->second);
+                unlink(id, it->second);
+                entries_.erase(it);
+            }
+        }
+        for (const auto& id : changed) {
+            const Node* node = diagram.find_node(id);
+            if (!node || entries_.count(id)) continue;
+            Entry entry;
+            entry.inputs = node->inputs;
+            entry.rounds[0] = labelHash(*node);
+            link(id, entry);
+            entries_[id] = std::move(entry);
+        }
+
+        // Round k of a node changes only if it is within k consumer hops of
+        // a changed ID; subtract old contributions before any is rewritten
+        std::unordered_set<std::string> region(changed.begin(), changed.end());
+        std::vector<std::string> frontier(changed.begin(), changed.end());
+        std::vector<std::vector<std::string>> rings(kRounds + 1);
+        rings[0] = frontier;
+        for (int round = 1; round <= kRounds; ++round) {
+            std::vector<std::string> next;
+            for (const auto& id : frontier) {
+                auto it = consumers_.find(id);
+                if (it == consumers_.end()) continue;
+                for (const auto& consumer : it->second) {
+                    if (region.insert(consumer).second) next.push_back(consumer);
+                }
+            }
+            rings[round] = next;
+            frontier = std::move(next);
+        }
+
+        std::vector<Entry*> touched;
+        touched.reserve(region.size());
+        std::unordered_set<std::string> fresh(changed.begin(), changed.end());
+        for (const auto& id : region) {
+            auto it = entries_.find(id);
+            if (it == entries_.end()) continue;
+            if (!fresh.count(id)) total_ -= contribution(it->second);
+            touched.push_back(&it->second);
+        }
+
+        // Nodes in ring r keep rounds < r; recompute round k for rings <= k
+        for (int round = 1; round <= kRounds; ++round) {
+            for (int ring = 0; ring <= round; ++ring) {
+                for (const auto& id : rings[ring]) {
+                    auto it = entries_.find(id);
+                    if (it != entries_.end()) it->second.rounds[round] = roundHash(it->second, round);
+                }
+            }
+        }
+        for (const Entry* entry : touched) {
+            total_ += contribution(*entry);
+        }
+    }
+
+    uint64_t hash() const {
+        return hash_detail::combine(total_, entries_.size());
+    }
+};
+
+/**
+ * Whether RewriteMemo may answer for `rule`: its pattern must read no
+ * deeper than DiagramHasher::kRounds and bind each variable once
+ * (a repeated variable compares node identity, which the hash drops)
+ */
+inline bool ruleMemoizable(const CompiledRule& rule) {
+    if (!rule.valid) return false;
+    std::unordered_set<std::string> variables;
+    bool repeated = false;
+    std::function<int(const ASTNode&)> depth = [&](const ASTNode& expr) -> int {
+        if (expr.kind == ASTKind::Atom) {
+            if (isVariable(expr.atom_name) && !variables.insert(expr.atom_name).second) repeated = true;
+            return 0;
+        }
+        int deepest = -1;
+        for (const auto& arg : expr.args) {
+            deepest = std::max(deepest, depth(arg));
+        }
+        return deepest + 1;
+    };
+    return depth(rule.pattern) <= DiagramHasher::kRounds && !repeated;
+}
+
+/**
+ * Bounded (diagram hash, rule) -> no-match table
+ *
+ * Direct-mapped: a new entry overwrites whatever shared its slot, so
+ * memory stays at capacity slots however long the run.
+ */
+class RewriteMemo {
+private:
+    struct Slot {
+        uint64_t diagram_hash = 0;
+        uint64_t rule = ~0ull;   // ~0 = empty
+    };
+
+    std::vector<Slot> slots_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+
+    size_t slotOf(uint64_t diagram_hash, uint64_t rule) const {
+        return static_cast<size_t>(hash_detail::combine(diagram_hash, rule) & (slots_.size() - 1));
+    }
+
+public:
+    // capacity is rounded up to a power of two
+    explicit RewriteMemo(size_t capacity = 4096) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots_.resize(size);
+    }
+
+    bool knownNoMatch(uint64_t diagram_hash, uint64_t rule) {
+        const Slot& slot = slots_[slotOf(diagram_hash, rule)];
+        const bool hit = slot.rule == rule && slot.diagram_hash == diagram_hash;
+        (hit ? hits_ : misses_)++;
+        return hit;
+    }
+
+    void recordNoMatch(uint64_t diagram_hash, uint64_t rule) {
+        slots_[slotOf(diagram_hash, rule)] = Slot{diagram_hash, rule};
+    }
+
+    void clear() {
+        for (auto& slot : slots_) slot = Slot();
+    }
+
+    size_t capacity() const { return slots_.size(); }
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+};
+
+} // namespace sid
@@ -0,0 +1,500 @@
+/**
+ * SID Diagram I/O - Streaming JSON and compact binary (de)serialization
+ *
+ * JSON form (what SidTernaryEngine has always produced; keys sorted):
+ *
+ *   {"edges":[{"from":..,"id":..,"label":..,"port":N,"to":..},..],
+ *    "id":"..","nodes":[{"dof_refs":[..],"id":..,"inputs":[..],"op":".."},..]}
+ *
+ * readDiagramJson() builds the Diagram straight from nlohmann's SAX events,
+ * so no DOM is allocated for a 10^5-node diagram; it accepts exactly what
+ * the DOM reader did (missing keys take their defaults, unknown keys are
+ * skipped, nodes / edges without an id are dropped, non-string inputs /
+ * dof_refs are skipped, a wrongly typed field is an error).
+ * writeDiagramJson() appends the same bytes nlohmann's dump() of the DOM
+ * gives, without building one.  Strings are written as stored (no UTF-8
+ * validation).
+ *
+ * Binary form (little-endian, for checkpoints and binary transports):
+ *
+ *   "SIDD"  u8 version (1)
+ *   varint  string count, then per string: varint length, bytes
+ *   varint  diagram id (string index)
+ *   varint  node count, then per node: id, op, varint #inputs, inputs,
+ *           varint #dof_refs, dof_refs               (all string indices)
+ *   varint  edge count, then per edge: id, from, to, label, zigzag port
+ *
+ * Every distinct string is stored once, so node IDs repeated as edge
+ * endpoints and inputs cost one varint each.  Node attributes and meta are
+ * not part of either form.
+ */
+
+#pragma once
+
+#include "sid_diagram.hpp"
+#include "../../../dase_cli/src/json.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sid {
+
+namespace diagram_io_detail {
+
+// nlohmann::json SAX events -> Diagram parts
+class DiagramSaxBuilder {
+public:
+    using json = nlohmann::json;
+
+    std::string id = "sid_engine_diagram";
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::string error;
+
+    bool null() { return scalar(Scalar::Other, nullptr, 0); }
+    bool boolean(bool value) { return scalar(Scalar::Number, nullptr, value ? 1 : 0); }
+    bool number_integer(json::number_integer_t value) {
+        return scalar(Scalar::Number, nullptr, static_cast<int>(value));
+    }
+    bool number_unsigned(json::number_unsigned_t value) {
+        return scalar(Scalar::Number, nullptr, static_cast<int>(value));
+    }
+    bool number_float(json::number_float_t value, const json::string_t&) {
+        return scalar(Scalar::Number, nullptr, static_cast<int>(value));
+    }
+    bool string(json::string_t& value) { return scalar(Scalar::String, &value, 0); }
+    bool binary(json::binary_t&) { return scalar(Scalar::Other, nullptr, 0); }
+
+    bool key(json::string_t& value) {
+        key_ = std::move(value);
+        if (stack_.empty()) return true;
+        // Repeated keys: the last occurrence wins, as in a DOM
+        switch (stack_.back()) {
+            case Frame::Root:
+                if (key_ == "nodes") nodes.clear();
+                if (key_ == "edges") edges.clear();
+                break;
+            case Frame::Node:
+                if (key_ == "inputs") node_.inputs.clear();
+                if (key_ == "dof_refs") node_.dof_refs.clear();
+                break;
+            default:
+                break;
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        if (stack_.empty()) {
+            stack_.push_back(Frame::Root);
+            return true;
+        }
+        switch (stack_.back()) {
+            case Frame::Nodes:
+                node_ = Node();
+                stack_.push_back(Frame::Node);
+                return true;
+            case Frame::Edges:
+                edge_ = Edge();
+                edge_.label = "arg";
+                stack_.push_back(Frame::Edge);
+                return true;
+            default:
+                if (!compound()) return false;
+                stack_.push_back(Frame::Skip);
+                return true;
+        }
+    }
+
+    bool end_object() {
+        const Frame frame = stack_.back();
+        stack_.pop_back();
+        if (frame == Frame::Node && !node_.id.empty()) nodes.push_back(std::move(node_));
+        if (frame == Frame::Edge && !edge_.id.empty()) edges.push_back(std::move(edge_));
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        if (stack_.empty()) {
+            return fail("Diagram JSON must be an object");
+        }
+        const Frame parent = stack_.back();
+        if (parent == Frame::Root && (key_ == "nodes" || key_ == "edges")) {
+            stack_.push_back(key_ == "nodes" ? Frame::Nodes : Frame::Edges);
+            return true;
+        }
+        if (parent == Frame::Node && (key_ == "inputs" || key_ == "dof_refs")) {
+            strings_ = key_ == "inputs" ? &node_.inputs : &node_.dof_refs;
+            stack_.push_back(Frame::Strings);
+            return true;
+        }
+        if (!compound()) return false;
+        stack_.push_back(Frame::Skip);
+        return true;
+    }
+
+    bool end_array() {
+        stack_.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) {
+        error = ex.what();
+        return false;
+    }
+
+private:
+    enum class Frame : uint8_t { Root, Nodes, Edges, Node, Edge, Strings, Skip };
+    enum class Scalar : uint8_t { String, Number, Other };
+
+    std::vector<Frame> stack_;
+    std::string key_;
+    Node node_;
+    Edge edge_;
+    std::vector<std::string>* strings_ = nullptr;
+
+    bool fail(const std::string& message) {
+        error = message;
+        return false;
+    }
+
+    // An object or array value: wrong where a node / edge or a typed field
+    // is expected, skipped elsewhere
+    bool compound() {
+        switch (stack_.back()) {
+            case Frame::Nodes:
+            case Frame::Edges:
+                return fail("Diagram nodes and edges must be objects");
+            case Frame::Root:
+                return key_ != "id" || fail("Diagram id must be a string");
+            case Frame::Node:
+                return (key_ != "id" && key_ != "op") || fail("Node " + key_ + " must be a string");
+            case Frame::Edge:
+                return !isEdgeField() || fail("Edge " + key_ + " has the wrong type");
+            default:
+                return true;
+        }
+    }
+
+    bool isEdgeField() const {
+        return key_ == "id" || key_ == "from" || key_ == "to" || key_ == "label" || key_ == "port";
+    }
+
+    bool scalar(Scalar kind, std::string* text, int number) {
+        if (stack_.empty()) {
+            return fail("Diagram JSON must be an object");
+        }
+        switch (stack_.back()) {
+            case Frame::Root:
+                if (key_ != "id") return true;
+                if (kind != Scalar::String) return fail("Diagram id must be a string");
+                id = std::move(*text);
+                return true;
+            case Frame::Nodes:
+            case Frame::Edges:
+                return fail("Diagram nodes and edges must be objects");
+            case Frame::Node:
+                if (key_ != "id" && key_ != "op") return true;
+                if (kind != Scalar::String) return fail("Node " + key_ + " must be a string");
+                (key_ == "id" ? node_.id : node_.op) = std::move(*text);
+                return true;
+            case Frame::Edge:
+                if (key_ == "port") {
+                    if (kind != Scalar::Number) return fail("Edge port must be a number");
+                    edge_.port = number;
+                    return true;
+                }
+                if (!isEdgeField()) return true;
+                if (kind != Scalar::String) return fail("Edge " + key_ + " must be a string");
+                (key_ == "id" ? edge_.id : key_ == "from" ? edge_.from : key_ == "to" ? edge_.to : edge_.label) =
+                    std::move(*text);
+                return true;
+            case Frame::Strings:
+                if (kind == Scalar::String) strings_->push_back(std::move(*text));
+                return true;
+            case Frame::Skip:
+                return true;
+        }
+        return true;
+    }
+};
+
+inline void appendJsonString(std::string& out, const std::string& text) {
+    static const char* hex = "0123456789abcdef";
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += hex[(c >> 4) & 0xF];
+                    out += hex[c & 0xF];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+inline void appendStringArray(std::string& out, const std::vector<std::string>& values) {
+    out += '[';
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) out += ',';
+        appendJsonString(out, values[i]);
+    }
+    out += ']';
+}
+
+inline void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+// Bounds-checked reads over an encoded diagram
+class BinaryCursor {
+public:
+    BinaryCursor(const uint8_t* data, size_t size) : data_(data), end_(data + size) {}
+
+    bool varint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (data_ == end_) return false;
+            const uint8_t byte = *data_++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+    bool bytes(size_t count, const uint8_t*& out) {
+        if (static_cast<size_t>(end_ - data_) < count) return false;
+        out = data_;
+        data_ += count;
+        return true;
+    }
+
+    size_t remaining() const { return static_cast<size_t>(end_ - data_); }
+
+private:
+    const uint8_t* data_;
+    const uint8_t* end_;
+};
+
+} // namespace diagram_io_detail
+
+constexpr char kDiagramBinaryMagic[4] = {'S', 'I', 'D', 'D'};
+constexpr uint8_t kDiagramBinaryVersion = 1;
+
+/**
+ * Parse a JSON diagram into `out` (replaced only on success)
+ *
+ * @return false with `error` set on malformed JSON or a wrongly typed field
+ */
+inline bool readDiagramJson(const std::string& text, Diagram& out, std::string& error) {
+    diagram_io_detail::DiagramSaxBuilder builder;
+    if (!nlohmann::json::sax_parse(text, &builder)) {
+        error = builder.error.empty() ? "Invalid diagram JSON" : builder.error;
+        return false;
+    }
+    Diagram diagram(builder.id);
+    diagram.nodes() = std::move(builder.nodes);
+    diagram.edges() = std::move(builder.edges);
+    out = std::move(diagram);
+    return true;
+}
+
+/**
+ * Append the JSON form of `diagram` to `out`
+ */
+inline void writeDiagramJson(const Diagram& diagram, std::string& out) {
+    using diagram_io_detail::appendJsonString;
+    using diagram_io_detail::appendStringArray;
+
+    // Rough size up front: one allocation for typical diagrams
+    out.reserve(out.size() + 64 + diagram.nodes_count() * 64 + diagram.edges_count() * 80);
+
+    out += "{\"edges\":[";
+    bool first = true;
+    for (const auto& edge : diagram.edges()) {
+        out += first ? "{\"from\":" : ",{\"from\":";
+        first = false;
+        appendJsonString(out, edge.from);
+        out += ",\"id\":";
+        appendJsonString(out, edge.id);
+        out += ",\"label\":";
+        appendJsonString(out, edge.label);
+        out += ",\"port\":";
+        out += std::to_string(edge.port);
+        out += ",\"to\":";
+        appendJsonString(out, edge.to);
+        out += '}';
+    }
+    out += "],\"id\":";
+    appendJsonString(out, diagram.id());
+    out += ",\"nodes\":[";
+    first = true;
+    for (const auto& node : diagram.nodes()) {
+        out += first ? "{\"dof_refs\":" : ",{\"dof_refs\":";
+        first = false;
+        appendStringArray(out, node.dof_refs);
+        out += ",\"id\":";
+        appendJsonString(out, node.id);
+        out += ",\"inputs\":";
+        appendStringArray(out, node.inputs);
+        out += ",\"op\":";
+        appendJsonString(out, node.op);
+        out += '}';
+    }
+    out += "]}";
+}
+
+/**
+ * Append the binary form of `diagram` to `out`
+ */
+inline void writeDiagramBinary(const Diagram& diagram, std::string& out) {
+    using diagram_io_detail::appendVarint;
+
+    // String table in first-use order
+    std::unordered_map<std::string, uint64_t> index;
+    std::vector<const std::string*> table;
+    auto intern = [&](const std::string& s) {
+        auto inserted = index.emplace(s, table.size());
+        if (inserted.second) table.push_back(&inserted.first->first);
+        return inserted.first->second;
+    };
+
+    std::string body;
+    body.reserve(8 + diagram.nodes_count() * 8 + diagram.edges_count() * 10);
+    appendVarint(body, intern(diagram.id()));
+    appendVarint(body, diagram.nodes_count());
+    for (const auto& node : diagram.nodes()) {
+        appendVarint(body, intern(node.id));
+        appendVarint(body, intern(node.op));
+        appendVarint(body, node.inputs.size());
+        for (const auto& input : node.inputs) appendVarint(body, intern(input));
+        appendVarint(body, node.dof_refs.size());
+        for (const auto& dof : node.dof_refs) appendVarint(body, intern(dof));
+    }
+    appendVarint(body, diagram.edges_count());
+    for (const auto& edge : diagram.edges()) {
+        appendVarint(body, intern(edge.id));
+        appendVarint(body, intern(edge.from));
+        appendVarint(body, intern(edge.to));
+        appendVarint(body, intern(edge.label));
+        const int64_t port = edge.port;
+        appendVarint(body, (static_cast<uint64_t>(port) << 1) ^ static_cast<uint64_t>(port >> 63));
+    }
+
+    size_t strings_bytes = 0;
+    for (const std::string* s : table) strings_bytes += s->size() + 2;
+    out.reserve(out.size() + sizeof(kDiagramBinaryMagic) + 1 + 10 + strings_bytes + body.size());
+    out.append(kDiagramBinaryMagic, sizeof(kDiagramBinaryMagic));
+    out += static_cast<char>(kDiagramBinaryVersion);
+    appendVarint(out, table.size());
+    for (const std::string* s : table) {
+        appendVarint(out, s->size());
+        out += *s;
+    }
+    out += body;
+}
+
+/**
+ * Decode a binary diagram into `out` (replaced only on success)
+ *
+ * @return false with `error` set on a truncated or malformed encoding
+ */
+inline bool readDiagramBinary(const void* data, size_t size, Diagram& out, std::string& error) {
+    diagram_io_detail::BinaryCursor in(static_cast<const uint8_t*>(data), size);
+    const uint8_t* header = nullptr;
+    if (!in.bytes(sizeof(kDiagramBinaryMagic) + 1, header) ||
+        std::memcmp(header, kDiagramBinaryMagic, sizeof(kDiagramBinaryMagic)) != 0) {
+        error = "Not a binary SID diagram";
+        return false;
+    }
+    if (header[sizeof(kDiagramBinaryMagic)] != kDiagramBinaryVersion) {
+        error = "Unsupported binary SID diagram version " + std::to_string(header[sizeof(kDiagramBinaryMagic)]);
+        return false;
+    }
+
+    auto truncated = [&error]() {
+        error = "Truncated or malformed binary SID diagram";
+        return false;
+    };
+    // Counts are bounded by the bytes left (each entry takes at least one)
+    auto count = [&in](uint64_t& value) { return in.varint(value) && value <= in.remaining(); };
+
+    uint64_t string_count = 0;
+    if (!count(string_count)) return truncated();
+    std::vector<std::string> strings(static_cast<size_t>(string_count));
+    for (auto& s : strings) {
+        uint64_t length = 0;
+        const uint8_t* bytes = nullptr;
+        if (!in.varint(length) || length > in.remaining() || !in.bytes(static_cast<size_t>(length), bytes)) {
+            return truncated();
+        }
+        s.assign(reinterpret_cast<const char*>(bytes), static_cast<size_t>(length));
+    }
+    auto str = [&](std::string& value) {
+        uint64_t i = 0;
+        if (!in.varint(i) || i >= strings.size()) return false;
+        value = strings[static_cast<size_t>(i)];
+        return true;
+    };
+    auto strList = [&](std::vector<std::string>& values) {
+        uint64_t n = 0;
+        if (!count(n)) return false;
+        values.resize(static_cast<size_t>(n));
+        for (auto& value : values) {
+            if (!str(value)) return false;
+        }
+        return true;
+    };
+
+    std::string id;
+    uint64_t node_count = 0;
+    if (!str(id) || !count(node_count)) return truncated();
+    std::vector<Node> nodes(static_cast<size_t>(node_count));
+    for (auto& node : nodes) {
+        if (!str(node.id) || !str(node.op) || !strList(node.inputs) || !strList(node.dof_refs)) {
+            return truncated();
+        }
+    }
+    uint64_t edge_count = 0;
+    if (!count(edge_count)) return truncated();
+    std::vector<Edge> edges(static_cast<size_t>(edge_count));
+    for (auto& edge : edges) {
+        uint64_t port = 0;
+        if (!str(edge.id) || !str(edge.from) || !str(edge.to) || !str(edge.label) || !in.varint(port)) {
+            return truncated();
+        }
+        edge.port = static_cast<int>(static_cast<int64_t>(port >> 1) ^ -static_cast<int64_t>(port & 1));
+    }
+    if (in.remaining() != 0) {
+        error = "Trailing bytes after binary SID diagram";
+        return false;
+    }
+
+    Diagram diagram(id);
+    diagram.nodes() = std::move(nodes);
+    diagram.edges() = std::move(edges);
+    out = std::move(diagram);
+    return true;
+}
+
+} // namespace sid
@@ -0,0 +1,625 @@
+/**
+ * SID Field Kernels - Scalar and AVX2 loops over SemanticProcessor fields
+ *
+ * SID ternary fields are large and every per-step operation on them is a
+ * streaming pass, so the step cost is the number of passes.  These kernels
+ * cover the SemanticProcessor operations (sum, scale, uniform add, the two
+ * collapses), the engine's collapse-mask transfers (dense, indexed, bitset)
+ * and, for the mixer, "transform and measure" loops that update
+ * a field and return its FieldStatistics (sum, sum of squares, neighbour
+ * divergence) from the same pass.  Statistics are exactly what commit_step
+ * needs for the processor metrics, so a field changed this way does not
+ * have to be read again.
+ *
+ * Dispatch mirrors igsoa_simd_coupling.h: AVX2 is chosen at runtime via
+ * CPUFeatures, the caller passes its permission to use it, and the AVX2
+ * bodies carry a per-function target attribute so the header works in
+ * translation units built without -mavx2.
+ *
+ * Numerics: the scalar kernels perform the original loops' operations in
+ * the original order (bit-identical).  The AVX2 kernels sum in four lanes,
+ * so sums and statistics agree to round-off only; element-wise updates are
+ * exact either way.
+ *
+ * CompensatedSum keeps a running total (Kahan) that many small deltas are
+ * added to; the blocked kernels feed it one block sum per kFieldBlock
+ * elements, so compensation costs nothing per element.
+ */
+
+#pragma once
+
+#include "../cpu_features.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SID_HAVE_AVX2_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#if defined(SID_HAVE_AVX2_KERNELS) && (defined(__GNUC__) || defined(__clang__))
+#define SID_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SID_TARGET_AVX2
+#endif
+
+namespace sid {
+
+/**
+ * One pass worth of field statistics
+ */
+struct FieldStatistics {
+    double sum = 0.0;             // Σ x_i (the field's mass)
+    double sum_sq = 0.0;          // Σ x_i²
+    double divergence_sum = 0.0;  // Σ_{i>0} |x_i - x_{i-1}|
+};
+
+/**
+ * Kahan-compensated running total
+ */
+struct CompensatedSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(double x) {
+        const double y = x - compensation;
+        // volatile: keeps -ffast-math from folding the compensation to zero
+        volatile double t = sum + y;
+        const double total = t;
+        compensation = (total - sum) - y;
+        sum = total;
+    }
+
+    void reset(double value = 0.0) {
+        sum = value;
+        compensation = 0.0;
+    }
+
+    double value() const { return sum; }
+};
+
+// Elements per block sum fed to a CompensatedSum
+constexpr size_t kFieldBlock = 1024;
+
+/**
+ * Element-wise update applied by FieldKernels::transform
+ */
+enum class FieldOp {
+    None,             // x (measure only)
+    Scale,            // x * param
+    AddUniform,       // x + param
+    SubtractClamped   // x - clamp(param, 0, x): remove up to param per cell
+};
+
+struct FieldKernels {
+    /**
+     * True if the AVX2 kernels can run on this CPU (checked once)
+     */
+    static bool avx2Available() {
+#ifdef SID_HAVE_AVX2_KERNELS
+        static const bool available = CPUFeatures::hasAVX2() && CPUFeatures::hasFMA();
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    // ------------------------------------------------------------------
+    // Scalar kernels
+    // ------------------------------------------------------------------
+
+    static double sumScalar(const double* x, size_t n) {
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += x[i];
+        }
+        return sum;
+    }
+
+    static double applyScalar(FieldOp op, double x, double param) {
+        switch (op) {
+            case FieldOp::Scale:
+                return x * param;
+            case FieldOp::AddUniform:
+                return x + param;
+            case FieldOp::SubtractClamped: {
+                double delta = param;
+                if (delta < 0.0) delta = 0.0;
+                if (delta > x) delta = x;
+                return x - delta;
+            }
+            case FieldOp::None:
+            default:
+                return x;
+        }
+    }
+
+    /**
+     * Update x (unless op is None) and return its new statistics
+     */
+    static FieldStatistics transformScalar(double* x, size_t n, FieldOp op, double param) {
+        FieldStatistics stats;
+        if (n == 0) return stats;
+
+        double prev = applyScalar(op, x[0], param);
+        if (op != FieldOp::None) x[0] = prev;
+        stats.sum = prev;
+        stats.sum_sq = prev * prev;
+        for (size_t i = 1; i < n; ++i) {
+            const double v = applyScalar(op, x[i], param);
+            if (op != FieldOp::None) x[i] = v;
+            stats.sum += v;
+            stats.sum_sq += v * v;
+            stats.divergence_sum += std::abs(v - prev);
+            prev = v;
+        }
+        return stats;
+    }
+
+    /**
+     * x[i] -= clamp(mask[i] * amount, 0, x[i]) for i < n, stopping at the
+     * first mask value outside [0,1]
+     *
+     * @return Index of that value, or n
+     */
+    static size_t collapseMaskedScalar(double* x, const double* mask, size_t n, double amount) {
+        for (size_t i = 0; i < n; ++i) {
+            if (mask[i] < 0.0 || mask[i] > 1.0) {
+                return i;
+            }
+            double delta = mask[i] * amount;
+            if (delta < 0.0) delta = 0.0;
+            if (delta > x[i]) delta = x[i];
+            x[i] -= delta;
+        }
+        return n;
+    }
+
+    /**
+     * x[i] -= min(alpha * clamp(mask_I[i] + mask_N[i], 0, 1) * x[i], x[i])
+     */
+    static void collapseDualMaskScalar(double* x, const double* mask_I, const double* mask_N,
+                                       size_t n, double alpha) {
+        for (size_t i = 0; i < n; ++i) {
+            double total_mask = mask_I[i] + mask_N[i];
+            if (total_mask > 1.0) total_mask = 1.0;
+            if (total_mask < 0.0) total_mask = 0.0;
+
+            double delta = alpha * total_mask * x[i];
+            if (delta > x[i]) delta = x[i];
+
+            x[i] -= delta;
+        }
+    }
+
+    /**
+     * Move a fraction of U to I and N, half each:
+     *   t = U[i] * alpha * 0.5;  U[i] -= t + t;  I[i] += t;  N[i] += t
+     *
+     * @return Σ t (the mass each of I and N gained; U lost twice that)
+     */
+    static double collapseTransferScalar(double* field_I, double* field_N, double* field_U,
+                                         size_t n, double alpha) {
+        double moved = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double u_transfer = field_U[i] * alpha * 0.5;  // Half to I
+            const double n_transfer = field_U[i] * alpha * 0.5;  // Half to N
+
+            field_U[i] -= (u_transfer + n_transfer);
+            field_I[i] += u_transfer;
+            field_N[i] += n_transfer;
+            moved += u_transfer;
+        }
+        return moved;
+    }
+
+    /**
+     * Dual-mask transfer out of U (spec 03_COLLAPSE_MASKS.md):
+     *   tI = alpha * mask_I[i] * U[i];  tN = alpha * mask_N[i] * U[i]
+     *   U[i] -= tI + tN;  I[i] += tI;  N[i] += tN
+     * Masks must satisfy mask_I + mask_N <= 1, so U stays non-negative.
+     * Adds Σ tI / Σ tN to moved_I / moved_N.
+     */
+    static void maskTransferScalar(double* field_I, double* field_N, double* field_U,
+                                   const double* mask_I, const double* mask_N, size_t n, double alpha,
+                                   double& moved_I, double& moved_N) {
+        for (size_t i = 0; i < n; ++i) {
+            const double t_I = alpha * mask_I[i] * field_U[i];
+            const double t_N = alpha * mask_N[i] * field_U[i];
+            field_U[i] -= t_I + t_N;
+            field_I[i] += t_I;
+            field_N[i] += t_N;
+            moved_I += t_I;
+            moved_N += t_N;
+        }
+    }
+
+    /**
+     * maskTransferScalar at `count` listed cells only (weights per cell)
+     */
+    static void maskTransferIndexed(double* field_I, double* field_N, double* field_U,
+                                    const uint32_t* cells, const double* weight_I, const double* weight_N,
+                                    size_t count, double alpha, double& moved_I, double& moved_N) {
+        for (size_t k = 0; k < count; ++k) {
+            const uint32_t i = cells[k];
+            const double t_I = alpha * weight_I[k] * field_U[i];
+            const double t_N = alpha * weight_N[k] * field_U[i];
+            field_U[i] -= t_I + t_N;
+            field_I[i] += t_I;
+            field_N[i] += t_N;
+            moved_I += t_I;
+            moved_N += t_N;
+        }
+    }
+
+    static int lowestBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int bit = 0;
+        while (!(word & 1)) {
+            word >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    /**
+     * Binary-mask transfer: every set bit in words [first_word, end_word)
+     * of bits (cell = word * 64 + bit) sends alpha * U of its cell to `dst`
+     *
+     * @return Σ moved
+     */
+    static double bitsTransfer(double* dst, double* field_U, const uint64_t* bits,
+                               size_t first_word, size_t end_word, double alpha) {
+        double moved = 0.0;
+        for (size_t w = first_word; w < end_word; ++w) {
+            for (uint64_t word = bits[w]; word != 0; word &= word - 1) {
+                const size_t i = w * 64 + static_cast<size_t>(lowestBit(word));
+                const double t = alpha * field_U[i];
+                field_U[i] -= t;
+                dst[i] += t;
+                moved += t;
+            }
+        }
+        return moved;
+    }
+
+    // ------------------------------------------------------------------
+    // AVX2 kernels
+    // ------------------------------------------------------------------
+
+#ifdef SID_HAVE_AVX2_KERNELS
+    static SID_TARGET_AVX2 inline double horizontalSum(__m256d v) {
+        const __m128d lo = _mm256_castpd256_pd128(v);
+        const __m128d hi = _mm256_extractf128_pd(v, 1);
+        const __m128d pair = _mm_add_pd(lo, hi);
+        return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+    }
+
+    static SID_TARGET_AVX2 double sumAVX2(const double* x, size_t n) {
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(x + i));
+            acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(x + i + 4));
+        }
+        double sum = horizontalSum(_mm256_add_pd(acc0, acc1));
+        for (; i < n; ++i) {
+            sum += x[i];
+        }
+        return sum;
+    }
+
+    static SID_TARGET_AVX2 inline __m256d applyAVX2(FieldOp op, __m256d v, __m256d param) {
+        switch (op) {
+            case FieldOp::Scale:
+                return _mm256_mul_pd(v, param);
+            case FieldOp::AddUniform:
+                return _mm256_add_pd(v, param);
+            case FieldOp::SubtractClamped: {
+                // param is pre-clamped to >= 0, so x - min(param, x)
+                return _mm256_sub_pd(v, _mm256_min_pd(param, v));
+            }
+            case FieldOp::None:
+            default:
+                return v;
+        }
+    }
+
+    static SID_TARGET_AVX2 FieldStatistics transformAVX2(double* x, size_t n, FieldOp op, double param) {
+        if (n < 8) {
+            return transformScalar(x, n, op, param);
+        }
+        if (op == FieldOp::SubtractClamped && param < 0.0) {
+            param = 0.0;
+        }
+        const __m256d param_vec = _mm256_set1_pd(param);
+        const __m256d sign_mask = _mm256_set1_pd(-0.0);
+        __m256d sum = _mm256_setzero_pd();
+        __m256d sum_sq = _mm256_setzero_pd();
+        __m256d div = _mm256_setzero_pd();
+
+        // x[0] has no left neighbour: seed "previous" with itself so its
+        // divergence term is zero
+        __m256d prev = _mm256_set1_pd(applyScalar(op, x[0], param));
+
+        size_t i = 0;
+        const size_t n_avx2 = (n / 4) * 4;
+        for (; i < n_avx2; i += 4) {
+            const __m256d v = applyAVX2(op, _mm256_loadu_pd(x + i), param_vec);
+            if (op != FieldOp::None) _mm256_storeu_pd(x + i, v);
+
+            // [prev3, v0, v1, v2]: each lane's left neighbour
+            const __m256d rotated = _mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 3));
+            const __m256d carry = _mm256_permute4x64_pd(prev, _MM_SHUFFLE(2, 1, 0, 3));
+            const __m256d left = _mm256_blend_pd(rotated, carry, 0x1);
+
+            sum = _mm256_add_pd(sum, v);
+            sum_sq = _mm256_fmadd_pd(v, v, sum_sq);
+            div = _mm256_add_pd(div, _mm256_andnot_pd(sign_mask, _mm256_sub_pd(v, left)));
+            prev = v;
+        }
+
+        FieldStatistics stats;
+        stats.sum = horizontalSum(sum);
+        stats.sum_sq = horizontalSum(sum_sq);
+        stats.divergence_sum = horizontalSum(div);
+        double lanes[4];
+        _mm256_storeu_pd(lanes, prev);
+        double last = lanes[3];
+        for (; i < n; ++i) {
+            const double v = applyScalar(op, x[i], param);
+            if (op != FieldOp::None) x[i] = v;
+            stats.sum += v;
+            stats.sum_sq += v * v;
+            stats.divergence_sum += std::abs(v - last);
+            last = v;
+        }
+        return stats;
+    }
+
+    static SID_TARGET_AVX2 size_t collapseMaskedAVX2(double* x, const double* mask, size_t n, double amount) {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d amount_vec = _mm256_set1_pd(amount);
+        size_t i = 0;
+        const size_t n_avx2 = (n / 4) * 4;
+        for (; i < n_avx2; i += 4) {
+            const __m256d m = _mm256_loadu_pd(mask + i);
+            const __m256d bad = _mm256_or_pd(_mm256_cmp_pd(m, zero, _CMP_LT_OQ),
+                                             _mm256_cmp_pd(m, one, _CMP_GT_OQ));
+            if (_mm256_movemask_pd(bad)) {
+                break;   // The scalar loop stops at the exact element
+            }
+            const __m256d v = _mm256_loadu_pd(x + i);
+            const __m256d delta = _mm256_max_pd(_mm256_mul_pd(m, amount_vec), zero);
+            _mm256_storeu_pd(x + i, _mm256_sub_pd(v, _mm256_min_pd(delta, v)));
+        }
+        return i + collapseMaskedScalar(x + i, mask + i, n - i, amount);
+    }
+
+    static SID_TARGET_AVX2 void collapseDualMaskAVX2(double* x, const double* mask_I, const double* mask_N,
+                                                     size_t n, double alpha) {
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d alpha_vec = _mm256_set1_pd(alpha);
+        size_t i = 0;
+        const size_t n_avx2 = (n / 4) * 4;
+        for (; i < n_avx2; i += 4) {
+            __m256d total = _mm256_add_pd(_mm256_loadu_pd(mask_I + i), _mm256_loadu_pd(mask_N + i));
+            total = _mm256_max_pd(_mm256_min_pd(total, one), zero);
+            const __m256d v = _mm256_loadu_pd(x + i);
+            const __m256d delta = _mm256_mul_pd(_mm256_mul_pd(alpha_vec, total), v);
+            _mm256_storeu_pd(x + i, _mm256_sub_pd(v, _mm256_min_pd(delta, v)));
+        }
+        collapseDualMaskScalar(x + i, mask_I + i, mask_N + i, n - i, alpha);
+    }
+
+    static SID_TARGET_AVX2 double collapseTransferAVX2(double* field_I, double* field_N, double* field_U,
+                                                       size_t n, double alpha) {
+        const __m256d alpha_vec = _mm256_set1_pd(alpha);
+        const __m256d half = _mm256_set1_pd(0.5);
+        __m256d moved = _mm256_setzero_pd();
+        size_t i = 0;
+        const size_t n_avx2 = (n / 4) * 4;
+        for (; i < n_avx2; i += 4) {
+            const __m256d u = _mm256_loadu_pd(field_U + i);
+            const __m256d t = _mm256_mul_pd(_mm256_mul_pd(u, alpha_vec), half);
+            _mm256_storeu_pd(field_U + i, _mm256_sub_pd(u, _mm256_add_pd(t, t)));
+            _mm256_storeu_pd(field_I + i, _mm256_add_pd(_mm256_loadu_pd(field_I + i), t));
+            _mm256_storeu_pd(field_N + i, _mm256_add_pd(_mm256_loadu_pd(field_N + i), t));
+            moved = _mm256_add_pd(moved, t);
+        }
+        return horizontalSum(moved) + collapseTransferScalar(field_I + i, field_N + i, field_U + i, n - i, alpha);
+    }
+
+    static SID_TARGET_AVX2 void maskTransferAVX2(double* field_I, double* field_N, double* field_U,
+                                                 const double* mask_I, const double* mask_N, size_t n,
+                                                 double alpha, double& moved_I, double& moved_N) {
+        const __m256d alpha_vec = _mm256_set1_pd(alpha);
+        __m256d acc_I = _mm256_setzero_pd();
+        __m256d acc_N = _mm256_setzero_pd();
+        size_t i = 0;
+        const size_t n_avx2 = (n / 4) * 4;
+        for (; i < n_avx2; i += 4) {
+            const __m256d u = _mm256_loadu_pd(field_U + i);
+            const __m256d t_I = _mm256_mul_pd(_mm256_mul_pd(alpha_vec, _mm256_loadu_pd(mask_I + i)), u);
+            const __m256d t_N = _mm256_mul_pd(_mm256_mul_pd(alpha_vec, _mm256_loadu_pd(mask_N + i)), u);
+            _mm256_storeu_pd(field_U + i, _mm256_sub_pd(u, _mm256_add_pd(t_I, t_N)));
+            _mm256_storeu_pd(field_I + i, _mm256_add_pd(_mm256_loadu_pd(field_I + i), t_I));
+            _mm256_storeu_pd(field_N + i, _mm256_add_pd(_mm256_loadu_pd(field_N + i), t_N));
+            acc_I = _mm256_add_pd(acc_I, t_I);
+            acc_N = _mm256_add_pd(acc_N, t_N);
+        }
+        moved_I += horizontalSum(acc_I);
+        moved_N += horizontalSum(acc_N);
+        maskTransferScalar(field_I + i, field_N + i, field_U + i, mask_I + i, mask_N + i, n - i, alpha,
+                           moved_I, moved_N);
+    }
+
+    static SID_TARGET_AVX2 void scaleAVX2(double* x, size_t n, double scale) {
+        const __m256d s = _mm256_set1_pd(scale);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm256_storeu_pd(x + i, _mm256_mul_pd(_mm256_loadu_pd(x + i), s));
+        }
+        for (; i < n; ++i) {
+            x[i] *= scale;
+        }
+    }
+
+    static SID_TARGET_AVX2 void addUniformAVX2(double* x, size_t n, double amount) {
+        const __m256d a = _mm256_set1_pd(amount);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm256_storeu_pd(x + i, _mm256_add_pd(_mm256_loadu_pd(x + i), a));
+        }
+        for (; i < n; ++i) {
+            x[i] += amount;
+        }
+    }
+#endif
+
+    // ------------------------------------------------------------------
+    // Dispatching front ends (simd = caller's permission to use AVX2)
+    // ------------------------------------------------------------------
+
+    static double sum(bool simd, const double* x, size_t n) {
+#ifdef SID_HAVE_AVX2_KERNELS
+        if (simd) return sumAVX2(x, n);
+#else
+        (void)simd;
+#endif
+        return sumScalar(x, n);
+    }
+
+    static FieldStatistics transform(bool simd, double* x, size_t n, FieldOp op, double param) {
+#ifdef SID_HAVE_AVX2_KERNELS
+        if (simd) return transformAVX2(x, n, op, param);
+#else
+        (void)simd;
+#endif
+        return transformScalar(x, n, op, param);
+    }
+
+    // Statistics of a field that is not modified (FieldOp::None never writes)
+    static FieldStatistics statistics(bool simd, const double* x, size_t n) {
+        return transform(simd, const_cast<double*>(x), n, FieldOp::None, 0.0);
+    }
+
+    static void scale(bool simd, double* x, size_t n, double scale) {
+#ifdef SID_HAVE_AVX2_KERNELS
+        if (simd) {
+            scaleAVX2(x, n, scale);
+            return;
+        }
+#else
+        (void)simd;
+#endif
+        for (size_t i = 0; i < n; ++i) {
+            x[i] *= scale;
+        }
+    }
+
+    static void addUniform(bool simd, double* x, size_t n, double amount) {
+#ifdef SID_HAVE_AVX2_KERNELS
+        if (simd) {
+            addUniformAVX2(x, n, amount);
+            return;
+        }
+#else
+        (void)simd;
+#endif
+        for (size_t i = 0; i < n; ++i) {
+            x[i] += amount;
+        }
+    }
+
+    static size_t collapseMasked(bool simd, double* x, const double* mask, size_t n, double amount) {
+#ifdef SID_HAVE_AVX2_KERNELS
+        if (simd) return collapseMaskedAVX2(x, mask, n, amount);
+#else
+        (void)simd;
+#endif
+        return collapseMaskedScalar(x, mask, n, amount);
+    }
+
+    /**
+     * Σ x, accumulated per kFieldBlock into a CompensatedSum
+     */
+    static double compensatedSum(bool simd, const double* x, size_t n) {
+        CompensatedSum total;
+        for (size_t i = 0; i < n; i += kFieldBlock) {
+            total.add(sum(simd, x + i, std::min(kFieldBlock, n - i)));
+        }
+        return total.value();
+    }
+
+    /**
+     * collapseTransferScalar over the whole field, adding the moved mass
+     * to `moved` per kFieldBlock
+     */
+    static void collapseTransfer(bool simd, double* field_I, double* field_N, double* field_U,
+                                 size_t n, double alpha, CompensatedSum& moved) {
+        for (size_t i = 0; i < n; i += kFieldBlock) {
+            const size_t len = std::min(kFieldBlock, n - i);
+#ifdef SID_HAVE_AVX2_KERNELS
+            if (simd) {
+                moved.add(collapseTransferAVX2(field_I + i, field_N + i, field_U + i, len, alpha));
+                continue;
+            }
+#else
+            (void)simd;
+#endif
+            moved.add(collapseTransferScalar(field_I + i, field_N + i, field_U + i, len, alpha));
+        }
+    }
+
+    static void collapseDualMask(bool simd, double* x, const double* mask_I, const double* mask_N,
+                                 size_t n, double alpha) {
+#ifdef SID_HAVE_AVX2_KERNELS
+        if (simd) {
+            collapseDualMaskAVX2(x, mask_I, mask_N, n, alpha);
+            return;
+        }
+#else
+        (void)simd;
+#endif
+        collapseDualMaskScalar(x, mask_I, mask_N, n, alpha);
+    }
+
+    /**
+     * maskTransferScalar over the whole field, adding the moved masses per
+     * kFieldBlock
+     */
+    static void maskTransfer(bool simd, double* field_I, double* field_N, double* field_U,
+                             const double* mask_I, const double* mask_N, size_t n, double alpha,
+                             CompensatedSum& moved_I, CompensatedSum& moved_N) {
+        for (size_t i = 0; i < n; i += kFieldBlock) {
+            const size_t len = std::min(kFieldBlock, n - i);
+            double block_I = 0.0;
+            double block_N = 0.0;
+#ifdef SID_HAVE_AVX2_KERNELS
+            if (simd) {
+                maskTransferAVX2(field_I + i, field_N + i, field_U + i, mask_I + i, mask_N + i, len, alpha,
+                                 block_I, block_N);
+            } else
+#else
+            (void)simd;
+#endif
+            {
+                maskTransferScalar(field_I + i, field_N + i, field_U + i, mask_I + i, mask_N + i, len, alpha,
+                                   block_I, block_N);
+            }
+            moved_I.add(block_I);
+            moved_N.add(block_N);
+        }
+    }
+};
+
+} // namespace sid
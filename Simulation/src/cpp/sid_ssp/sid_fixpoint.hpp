@@ -0,0 +1,246 @@
+/**
+ * SID Fixpoint Rewriter - Worklist-driven rewriting to a fixed point
+ *
+ * The sweeping loop of sid_run_rewrites applies every rule once per pass
+ * over the whole diagram until a pass applies nothing, so each pass costs
+ * |rules| full matches however small the last change was.  Here every rule
+ * keeps a worklist of candidate roots instead.  The first pass seeds it from
+ * the diagram's label index (nodes with the rule's head operator or atom);
+ * a candidate that fails to match is dropped; after a rewrite only the
+ * touched neighbourhood is queued again, and only for rules whose pattern
+ * head admits it.  Reaching convergence costs the seeding plus work
+ * proportional to the number of rewrites.
+ *
+ * matchExpr reads a node's own fields and walks its `inputs`, and rewrites
+ * never change surviving nodes, so a node can only start matching when it
+ * is new or has a new node within pattern depth below it (via inputs).  The
+ * touched neighbourhood is therefore: the replacement's nodes, their
+ * consumers (nodes listing them in `inputs`, followed up to the deepest
+ * pattern), and the root that matched if it survived.
+ *
+ * Rules are tried in passes, ordered by the sid_run_rewrites policies; each
+ * rule applies at most once per pass.  Unlike the sweep, a match whose
+ * rewrite would introduce a cycle is skipped rather than ending the run.
+ * Rewrites run in place, so the diagram must be acyclic (see
+ * applyCompiledRewriteInPlace).
+ */
+
+#pragma once
+
+#include "sid_rewrite.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace sid {
+
+/**
+ * Rule order of one pass: P1 lexicographic, P2 reversed, P3 shuffled each
+ * pass.  P4 / P5 are placeholders and order like P1.
+ */
+inline std::vector<size_t> buildRuleOrder(size_t num_rules, const std::string& policy, std::mt19937& gen) {
+    std::vector<size_t> order(num_rules);
+    std::iota(order.begin(), order.end(), 0);
+    if (policy == "P2") {
+        std::reverse(order.begin(), order.end());
+    } else if (policy == "P3") {
+        std::shuffle(order.begin(), order.end(), gen);
+    }
+    return order;
+}
+
+struct FixpointOptions {
+    std::string policy = "P1";
+    uint64_t horizon_cap = 1000;   // Maximum rewrites
+    uint64_t seed = 42;            // P3 shuffle seed
+};
+
+struct FixpointResult {
+    uint64_t steps = 0;                  // Rewrites applied
+    bool horizon_hit = false;            // Stopped at horizon_cap, not at a fixed point
+    std::vector<size_t> applied_trace;   // Rule index of each rewrite, in order
+    uint64_t candidates_tried = 0;       // Roots matched against (the cost)
+};
+
+/**
+ * Depth of a pattern: 0 for an atom, 1 + deepest argument for an operator
+ */
+inline size_t patternDepth(const ASTNode& expr) {
+    size_t depth = 0;
+    for (const auto& arg : expr.args) {
+        depth = std::max(depth, patternDepth(arg) + 1);
+    }
+    return depth;
+}
+
+/**
+ * Whether a node can root a match of the pattern, from its own fields
+ * (operator and arity, or the atom it carries); a variable admits any node
+ */
+inline bool patternHeadAdmits(const ASTNode& expr, const Node& node) {
+    if (expr.kind == ASTKind::Op) {
+        return node.op == expr.op_name && arityAdmits(node, expr);
+    }
+    if (isVariable(expr.atom_name)) {
+        return true;
+    }
+    if (node.op == "P" &&
+        std::find(node.dof_refs.begin(), node.dof_refs.end(), expr.atom_name) != node.dof_refs.end()) {
+        return true;
+    }
+    auto meta_it = node.meta.find(attr_keys::kAtomArgs);
+    if (meta_it != node.meta.end() && std::holds_alternative<std::vector<std::string>>(meta_it->second)) {
+        const auto& atom_args = std::get<std::vector<std::string>>(meta_it->second);
+        return std::find(atom_args.begin(), atom_args.end(), expr.atom_name) != atom_args.end();
+    }
+    return false;
+}
+
+/**
+ * Rewrite a diagram in place until no rule matches or horizon_cap rewrites
+ * have run.  Null and invalid rules never apply.
+ *
+ * @param diagram Acyclic diagram to rewrite
+ * @param rules Compiled rules, indexed by FixpointResult::applied_trace
+ * @param options Policy, horizon and seed
+ * @param scratch Optional matcher working sets to reuse
+ */
+inline FixpointResult runRewriteFixpoint(Diagram& diagram,
+                                         const std::vector<const CompiledRule*>& rules,
+                                         const FixpointOptions& options,
+                                         MatchScratch* scratch = nullptr) {
+    FixpointResult result;
+    const Diagram& view = diagram;
+    MatchScratch local_scratch;
+    MatchScratch& match = scratch ? *scratch : local_scratch;
+
+    // Per-rule worklist of candidate root IDs, FIFO without duplicates
+    struct Worklist {
+        std::deque<std::string> queue;
+        std::unordered_set<std::string> queued;
+
+        void push(const std::string& node_id) {
+            if (queued.insert(node_id).second) queue.push_back(node_id);
+        }
+    };
+    std::vector<Worklist> worklists(rules.size());
+
+    size_t max_depth = 0;
+    for (size_t k = 0; k < rules.size(); ++k) {
+        const CompiledRule* rule = rules[k];
+        if (!rule || !rule->valid) continue;
+        max_depth = std::max(max_depth, patternDepth(rule->pattern));
+
+        const ASTNode& head = rule->pattern;
+        if (head.kind == ASTKind::Op) {
+            for (uint32_t position : view.nodes_with_op(head.op_name)) worklists[k].push(view.nodes()[position].id);
+        } else if (!isVariable(head.atom_name)) {
+            for (uint32_t position : view.nodes_with_atom(head.atom_name)) worklists[k].push(view.nodes()[position].id);
+        } else {
+            for (const auto& node : view.nodes()) worklists[k].push(node.id);
+        }
+    }
+
+    // input ID -> nodes listing it in `inputs` (entries for removed nodes go
+    // stale and are skipped when popped)
+    std::unordered_map<std::string, std::vector<std::string>> consumers;
+    for (const auto& node : view.nodes()) {
+        for (const auto& input : node.inputs) consumers[input].push_back(node.id);
+    }
+
+    auto enqueue = [&](const std::string& node_id) {
+        const Node* node = view.find_node(node_id);
+        if (!node) return;
+        for (size_t k = 0; k < rules.size(); ++k) {
+            if (rules[k] && rules[k]->valid && patternHeadAdmits(rules[k]->pattern, *node)) {
+                worklists[k].push(node_id);
+            }
+        }
+    };
+
+    // Queue what a rewrite touched (see the file comment)
+    auto enqueueNeighbourhood = [&](const std::vector<std::string>& added_nodes) {
+        std::vector<std::string> frontier;
+        std::unordered_set<std::string> seen;
+        for (const auto& node_id : added_nodes) {
+            const Node* node = view.find_node(node_id);
+            if (!node) continue;
+            for (const auto& input : node->inputs) consumers[input].push_back(node_id);
+            if (seen.insert(node_id).second) frontier.push_back(node_id);
+        }
+        for (size_t level = 0; !frontier.empty(); ++level) {
+            std::vector<std::string> next;
+            for (const auto& node_id : frontier) {
+                enqueue(node_id);
+                if (level >= max_depth) continue;
+                auto it = consumers.find(node_id);
+                if (it == consumers.end()) continue;
+                for (const auto& consumer : it->second) {
+                    if (seen.insert(consumer).second) next.push_back(consumer);
+                }
+            }
+            frontier.swap(next);
+        }
+    };
+
+    // Pop candidates of rule k until one rewrites
+    auto tryRule = [&](size_t k) {
+        const CompiledRule& rule = *rules[k];
+        Worklist& worklist = worklists[k];
+        while (!worklist.queue.empty()) {
+            const std::string root = std::move(worklist.queue.front());
+            worklist.queue.pop_front();
+            worklist.queued.erase(root);
+
+            const Node* node = view.find_node(root);
+            if (!node || !patternHeadAdmits(rule.pattern, *node)) continue;
+
+            result.candidates_tried++;
+            match.clear();
+            if (!matchExpr(rule.pattern, root, view, match.bindings, match.matched, match.bound_nodes)) {
+                continue;
+            }
+            InPlaceRewriteResult rewrite =
+                applyRewriteAtMatch(diagram, rule, match.bindings, match.matched, match.bound_nodes);
+            if (!rewrite.applied) {
+                continue;   // Would introduce a cycle
+            }
+
+            enqueueNeighbourhood(rewrite.added_nodes);
+            if (view.find_node(root)) {
+                worklist.push(root);   // Survived (bound), so it still matches
+            }
+            return true;
+        }
+        return false;
+    };
+
+    std::mt19937 rng(static_cast<uint32_t>(options.seed));
+    while (result.steps < options.horizon_cap) {
+        bool applied_pass = false;
+        for (size_t k : buildRuleOrder(rules.size(), options.policy, rng)) {
+            if (!rules[k] || !rules[k]->valid || !tryRule(k)) continue;
+
+            applied_pass = true;
+            result.steps++;
+            result.applied_trace.push_back(k);
+            if (result.steps >= options.horizon_cap) {
+                result.horizon_hit = true;
+                break;
+            }
+        }
+        if (!applied_pass) {
+            break;   // Every worklist drained without a rewrite: fixed point
+        }
+    }
+
+    return result;
+}
+
+} // namespace sid
@@ -0,0 +1,406 @@
+/**
+ * SID Graph Index - Interned IDs and CSR adjacency for sid::Diagram
+ *
+ * Diagrams name nodes and edges by string.  The index interns every node ID
+ * (including IDs that edges reference but no node defines) to a dense
+ * uint32 symbol, so traversals compare integers and index flat arrays
+ * instead of comparing strings and walking trees.
+ *
+ * Adjacency is CSR-like: all rows share one target array, and each row is a
+ * contiguous [offset, offset + size) slice with some spare capacity.  An
+ * insert into a full row moves that row to the end of the array with double
+ * the capacity, so adding an edge is amortized O(1).  Removing an edge
+ * shifts its row, which is O(degree).  Rows abandoned by moves are reclaimed
+ * when the array grows to twice its live size.
+ *
+ * TopologicalOrder keeps a topological order of the symbols under edge
+ * insertions and deletions (Pearce-Kelly), so whether the graph is acyclic
+ * is known without a traversal.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sid {
+
+constexpr uint32_t kNoSymbol = 0xFFFFFFFFu;
+
+/**
+ * String <-> dense uint32 interning
+ */
+class SymbolTable {
+private:
+    std::unordered_map<std::string, uint32_t> index_;
+    std::vector<std::string> names_;
+
+public:
+    uint32_t intern(const std::string& name) {
+        auto it = index_.find(name);
+        if (it != index_.end()) return it->second;
+        const uint32_t symbol = static_cast<uint32_t>(names_.size());
+        index_.emplace(name, symbol);
+        names_.push_back(name);
+        return symbol;
+    }
+
+    // kNoSymbol if never interned
+    uint32_t find(const std::string& name) const {
+        auto it = index_.find(name);
+        return it != index_.end() ? it->second : kNoSymbol;
+    }
+
+    const std::string& name(uint32_t symbol) const { return names_[symbol]; }
+    size_t size() const { return names_.size(); }
+
+    void clear() {
+        index_.clear();
+        names_.clear();
+    }
+
+    void reserve(size_t n) {
+        index_.reserve(n);
+        names_.reserve(n);
+    }
+};
+
+/**
+ * Neighbour slice of one adjacency row
+ */
+struct NeighborRange {
+    const uint32_t* first = nullptr;   // Neighbour symbols
+    const uint32_t* last = nullptr;
+    const uint32_t* edges = nullptr;   // Parallel: edge index of each neighbour
+
+    const uint32_t* begin() const { return first; }
+    const uint32_t* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+/**
+ * Row-per-symbol adjacency in one shared array, patchable in place
+ */
+class CsrAdjacency {
+private:
+    struct Row {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+        uint32_t capacity = 0;
+    };
+
+    std::vector<Row> rows_;
+    std::vector<uint32_t> targets_;
+    std::vector<uint32_t> edges_;
+    size_t live_ = 0;
+
+    void ensureRow(uint32_t row) {
+        if (row >= rows_.size()) rows_.resize(static_cast<size_t>(row) + 1);
+    }
+
+    // Move a full row to the end of the arrays with room to grow
+    void growRow(Row& r) {
+        const uint32_t capacity = r.capacity < 2 ? 4 : 2 * r.capacity;
+        const uint32_t offset = static_cast<uint32_t>(targets_.size());
+        targets_.resize(targets_.size() + capacity);
+        edges_.resize(edges_.size() + capacity);
+        for (uint32_t i = 0; i < r.size; ++i) {
+            targets_[offset + i] = targets_[r.offset + i];
+            edges_[offset + i] = edges_[r.offset + i];
+        }
+        r.offset = offset;
+        r.capacity = capacity;
+    }
+
+    void compact() {
+        std::vector<uint32_t> targets;
+        std::vector<uint32_t> edges;
+        targets.reserve(live_);
+        edges.reserve(live_);
+        for (Row& r : rows_) {
+            const uint32_t offset = static_cast<uint32_t>(targets.size());
+            targets.insert(targets.end(), targets_.begin() + r.offset, targets_.begin() + r.offset + r.size);
+            edges.insert(edges.end(), edges_.begin() + r.offset, edges_.begin() + r.offset + r.size);
+            r.offset = offset;
+            r.capacity = r.size;
+        }
+        targets_.swap(targets);
+        edges_.swap(edges);
+    }
+
+public:
+    /**
+     * Build from an edge list: row_target[e] is the (row, target) of edge
+     * e.  Rows keep edge order (counting sort).
+     */
+    void build(size_t num_rows, const std::vector<std::pair<uint32_t, uint32_t>>& row_target) {
+        rows_.assign(num_rows, Row());
+        for (const auto& rt : row_target) rows_[rt.first].size++;
+        uint32_t offset = 0;
+        for (Row& r : rows_) {
+            r.offset = offset;
+            r.capacity = r.size;
+            offset += r.size;
+            r.size = 0;
+        }
+        targets_.assign(row_target.size(), 0);
+        edges_.assign(row_target.size(), 0);
+        for (size_t e = 0; e < row_target.size(); ++e) {
+            Row& r = rows_[row_target[e].first];
+            targets_[r.offset + r.size] = row_target[e].second;
+            edges_[r.offset + r.size] = static_cast<uint32_t>(e);
+            r.size++;
+        }
+        live_ = row_target.size();
+    }
+
+    void insert(uint32_t row, uint32_t target, uint32_t edge) {
+        ensureRow(row);
+        if (rows_[row].size == rows_[row].capacity) {
+            if (targets_.size() > 2 * live_ + 64) {
+                compact();
+            }
+            growRow(rows_[row]);
+        }
+        Row& r = rows_[row];
+        targets_[r.offset + r.size] = target;
+        edges_[r.offset + r.size] = edge;
+        r.size++;
+        live_++;
+    }
+
+    // Remove the entry for `edge`, keeping the row's order
+    void erase(uint32_t row, uint32_t edge) {
+        if (row >= rows_.size()) return;
+        Row& r = rows_[row];
+        for (uint32_t i = 0; i < r.size; ++i) {
+            if (edges_[r.offset + i] != edge) continue;
+            for (uint32_t j = i + 1; j < r.size; ++j) {
+                targets_[r.offset + j - 1] = targets_[r.offset + j];
+                edges_[r.offset + j - 1] = edges_[r.offset + j];
+            }
+            r.size--;
+            live_--;
+            break;
+        }
+        if (targets_.size() > 2 * live_ + 64) {
+            compact();
+        }
+    }
+
+    // Renumber an edge (after the edge list moved it)
+    void renameEdge(uint32_t row, uint32_t from_edge, uint32_t to_edge) {
+        if (row >= rows_.size()) return;
+        const Row& r = rows_[row];
+        for (uint32_t i = 0; i < r.size; ++i) {
+            if (edges_[r.offset + i] == from_edge) {
+                edges_[r.offset + i] = to_edge;
+                return;
+            }
+        }
+    }
+
+    // Point the entry for `edge` at a new target, keeping its place in the row
+    void retarget(uint32_t row, uint32_t edge, uint32_t target) {
+        if (row >= rows_.size()) return;
+        const Row& r = rows_[row];
+        for (uint32_t i = 0; i < r.size; ++i) {
+            if (edges_[r.offset + i] == edge) {
+                targets_[r.offset + i] = target;
+                return;
+            }
+        }
+    }
+
+    NeighborRange row(uint32_t row) const {
+        NeighborRange range;
+        if (row < rows_.size() && rows_[row].size > 0) {
+            const Row& r = rows_[row];
+            range.first = targets_.data() + r.offset;
+            range.last = range.first + r.size;
+            range.edges = edges_.data() + r.offset;
+        }
+        return range;
+    }
+
+    void clear() {
+        rows_.clear();
+        targets_.clear();
+        edges_.clear();
+        live_ = 0;
+    }
+};
+
+/**
+ * Online topological order (Pearce & Kelly, "A dynamic topological sort
+ * algorithm for directed acyclic graphs", 2006)
+ *
+ * While the graph is acyclic, ord[] is a topological order: ord[u] < ord[v]
+ * for every edge u -> v.  Inserting u -> v with ord[u] > ord[v] searches
+ * only the affected region, the symbols ordered between v and u: forward
+ * from v and backward from u, then the two sets swap places within the
+ * order values they held.  Reaching u from v means the edge closed a
+ * cycle.  Deletions never invalidate an order.
+ *
+ * A cyclic graph has no order to maintain; deleting an edge from one may
+ * break the cycle, so it drops the state to Unknown and the next query
+ * re-sorts the whole graph (Kahn, O(symbols + edges)).
+ */
+class TopologicalOrder {
+public:
+    enum class State : uint8_t { Unknown, Acyclic, Cyclic };
+
+private:
+    std::vector<uint32_t> ord_;        // Order position of each symbol
+    uint32_t next_ord_ = 0;            // Above every position in use
+    State state_ = State::Unknown;
+
+    // Search scratch, kept between insertions
+    std::vector<uint8_t> visited_;
+    std::vector<uint32_t> stack_;
+    std::vector<uint32_t> forward_set_;
+    std::vector<uint32_t> backward_set_;
+    std::vector<uint32_t> positions_;
+
+    void sortByOrder(std::vector<uint32_t>& symbols) const {
+        std::sort(symbols.begin(), symbols.end(),
+                  [this](uint32_t a, uint32_t b) { return ord_[a] < ord_[b]; });
+    }
+
+    // Symbols reachable from `start` along `adjacency` whose order lies in
+    // [lower, upper], into `out`; true (search stopped) if `stop` is reached
+    bool collect(uint32_t start, const CsrAdjacency& adjacency, uint32_t lower, uint32_t upper,
+                 uint32_t stop, std::vector<uint32_t>& out) {
+        stack_.assign(1, start);
+        visited_[start] = 1;
+        out.push_back(start);
+        while (!stack_.empty()) {
+            const uint32_t current = stack_.back();
+            stack_.pop_back();
+            for (uint32_t next : adjacency.row(current)) {
+                if (next == stop) return true;
+                if (visited_[next] || ord_[next] < lower || ord_[next] > upper) continue;
+                visited_[next] = 1;
+                out.push_back(next);
+                stack_.push_back(next);
+            }
+        }
+        return false;
+    }
+
+    void clearVisited(const std::vector<uint32_t>& symbols) {
+        for (uint32_t symbol : symbols) visited_[symbol] = 0;
+    }
+
+public:
+    State state() const { return state_; }
+
+    void invalidate() { state_ = State::Unknown; }
+
+    // A new symbol (no edges yet) goes last
+    void addSymbol(uint32_t symbol) {
+        if (state_ == State::Unknown) return;
+        while (ord_.size() <= symbol) {
+            ord_.push_back(next_ord_++);
+            visited_.push_back(0);
+        }
+    }
+
+    // Re-sort every symbol from scratch (Kahn's algorithm)
+    void rebuild(size_t num_symbols, const CsrAdjacency& forward) {
+        std::vector<uint32_t> in_degree(num_symbols, 0);
+        for (uint32_t u = 0; u < num_symbols; ++u) {
+            for (uint32_t v : forward.row(u)) in_degree[v]++;
+        }
+        ord_.assign(num_symbols, 0);
+        visited_.assign(num_symbols, 0);
+        stack_.clear();
+        for (uint32_t u = 0; u < num_symbols; ++u) {
+            if (in_degree[u] == 0) stack_.push_back(u);
+        }
+        uint32_t placed = 0;
+        while (!stack_.empty()) {
+            const uint32_t u = stack_.back();
+            stack_.pop_back();
+            ord_[u] = placed++;
+            for (uint32_t v : forward.row(u)) {
+                if (--in_degree[v] == 0) stack_.push_back(v);
+            }
+        }
+        next_ord_ = placed;
+        state_ = placed == num_symbols ? State::Acyclic : State::Cyclic;
+    }
+
+    /**
+     * Account for edge from -> to, already in both adjacencies
+     *
+     * @return false if the edge closed a cycle (state becomes Cyclic)
+     */
+    bool insertEdge(uint32_t from, uint32_t to, const CsrAdjacency& forward, const CsrAdjacency& reverse) {
+        if (state_ != State::Acyclic) return state_ != State::Cyclic;
+        if (from == to) {
+            state_ = State::Cyclic;
+            return false;
+        }
+        const uint32_t lower = ord_[to];
+        const uint32_t upper = ord_[from];
+        if (lower > upper) return true;
+
+        forward_set_.clear();
+        backward_set_.clear();
+        const bool cycle = collect(to, forward, lower, upper, from, forward_set_);
+        clearVisited(forward_set_);
+        if (cycle) {
+            state_ = State::Cyclic;
+            return false;
+        }
+        collect(from, reverse, lower, upper, kNoSymbol, backward_set_);
+        clearVisited(backward_set_);
+
+        // Backward set first, then forward set, in the positions they held
+        sortByOrder(forward_set_);
+        sortByOrder(backward_set_);
+        positions_.clear();
+        for (uint32_t symbol : backward_set_) positions_.push_back(ord_[symbol]);
+        for (uint32_t symbol : forward_set_) positions_.push_back(ord_[symbol]);
+        std::sort(positions_.begin(), positions_.end());
+        size_t slot = 0;
+        for (uint32_t symbol : backward_set_) ord_[symbol] = positions_[slot++];
+        for (uint32_t symbol : forward_set_) ord_[symbol] = positions_[slot++];
+        return true;
+    }
+
+    void eraseEdge() {
+        if (state_ == State::Cyclic) state_ = State::Unknown;
+    }
+
+    /**
+     * Whether adding from -> to would close a cycle (nothing is changed).
+     * Acyclic: only symbols ordered between the two are searched; Cyclic:
+     * everything `to` reaches.  State must not be Unknown.
+     */
+    bool wouldCycle(uint32_t from, uint32_t to, const CsrAdjacency& forward) {
+        if (from == to) return true;
+        uint32_t lower = 0;
+        uint32_t upper = 0xFFFFFFFFu;
+        if (state_ == State::Acyclic) {
+            if (ord_[to] > ord_[from]) return false;
+            lower = ord_[to];
+            upper = ord_[from];
+        }
+        forward_set_.clear();
+        const bool cycle = collect(to, forward, lower, upper, from, forward_set_);
+        clearVisited(forward_set_);
+        return cycle;
+    }
+
+    uint32_t position(uint32_t symbol) const { return ord_[symbol]; }
+};
+
+} // namespace sid
@@ -0,0 +1,434 @@
+/**
+ * SID Match Network - Incremental multi-rule matching (Rete style)
+ *
+ * The worklist and parallel rewriters still run matchExpr from scratch for
+ * every candidate root, so rules sharing sub-patterns (many match P(...) or
+ * S+($x, $y) somewhere) walk the same diagram structure once per rule.
+ * Here the rule set is compiled into one network first:
+ *
+ *   network node  a distinct sub-pattern, with its variables renamed to
+ *                 slots 0, 1, ... in first-occurrence order, so
+ *                 S+($x, P($y)) and S+($a, P($b)) are one node and every
+ *                 variable is the same node
+ *   child link    argument i of an operator node: the child network node
+ *                 and where its slots land in the parent's
+ *   rule          a root network node plus the rule's variable names
+ *
+ * The memory holds, per diagram node, the result of every network node
+ * evaluated there (no match, or slot bindings with the matched and bound
+ * nodes), and per root network node the set of diagram nodes it matches at:
+ * the conflict set.  An operator node joins its children's results at the
+ * diagram node's inputs, so each sub-pattern is matched once per diagram
+ * node however many rules contain it.  Results are exactly matchExpr's.
+ *
+ * A result at a diagram node depends only on that node's fields and the
+ * results below it via `inputs`, and rewrites never change surviving nodes,
+ * so after a rewrite only the replacement's nodes, the removed nodes and
+ * their consumers up to the deepest pattern are re-evaluated (the same
+ * neighbourhood sid_fixpoint.hpp re-queues).  Everything else stays.
+ *
+ * runNetworkRewrites picks each round's rewrite from the conflict sets
+ * without matching anything: the first rule in the policy order that has
+ * a match, at its first root in nodes() order (a scan of the set's
+ * positions), moving on to the next rule when a rewrite would introduce a
+ * cycle.  That is runParallelRewrites' single mode, rewrite for rewrite.
+ * Rewrites run in place, so the diagram must be acyclic (see
+ * applyCompiledRewriteInPlace).
+ */
+
+#pragma once
+
+#include "sid_fixpoint.hpp"
+#include "sid_parallel_match.hpp"
+#include "sid_rewrite.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace sid {
+
+class MatchNetwork {
+public:
+    /**
+     * Compile the rules' patterns.  Null and invalid rules get no root and
+     * never match.
+     */
+    explicit MatchNetwork(const std::vector<const CompiledRule*>& rules) : rule_roots_(rules.size(), kNone) {
+        rule_vars_.resize(rules.size());
+        for (size_t k = 0; k < rules.size(); ++k) {
+            if (!rules[k] || !rules[k]->valid) continue;
+            const size_t root = compile(rules[k]->pattern, rule_vars_[k]);
+            rule_roots_[k] = root;
+            max_depth_ = std::max(max_depth_, patternDepth(rules[k]->pattern));
+            if (std::find(roots_.begin(), roots_.end(), root) == roots_.end()) {
+                roots_.push_back(root);
+                root_patterns_.push_back(&rules[k]->pattern);
+            }
+        }
+        conflict_.resize(roots_.size());
+        for (size_t k = 0; k < rules.size(); ++k) {
+            if (rule_roots_[k] == kNone) continue;
+            rule_roots_[k] = static_cast<size_t>(
+                std::find(roots_.begin(), roots_.end(), rule_roots_[k]) - roots_.begin());
+        }
+    }
+
+    /**
+     * Network nodes (distinct sub-patterns) and distinct rule roots
+     */
+    size_t node_count() const { return nodes_.size(); }
+    size_t root_count() const { return roots_.size(); }
+
+    /**
+     * Network node results computed so far (the matching cost)
+     */
+    uint64_t evaluations() const { return evaluations_; }
+
+    /**
+     * Drop the memory and fill the conflict sets from `diagram`
+     */
+    void attach(const Diagram& diagram) {
+        memory_.clear();
+        consumers_.clear();
+        for (auto& set : conflict_) set.clear();
+
+        diagram.build_index();
+        const auto& nodes = diagram.nodes();
+        for (const auto& node : nodes) {
+            for (const auto& input : node.inputs) consumers_[input].push_back(node.id);
+        }
+        for (size_t r = 0; r < roots_.size(); ++r) {
+            const ASTNode& head = *root_patterns_[r];
+            auto seed = [&](const Node& node) {
+                if (patternHeadAdmits(head, node) && evaluate(diagram, roots_[r], node.id).matched) {
+                    conflict_[r].insert(node.id);
+                }
+            };
+            if (head.kind == ASTKind::Op) {
+                for (uint32_t position : diagram.nodes_with_op(head.op_name)) seed(nodes[position]);
+            } else if (!isVariable(head.atom_name)) {
+                for (uint32_t position : diagram.nodes_with_atom(head.atom_name)) seed(nodes[position]);
+            } else {
+                for (const auto& node : nodes) seed(node);
+            }
+        }
+    }
+
+    /**
+     * Re-evaluate after a rewrite: `changed` holds the IDs it added and
+     * removed (see the file comment for what else is touched)
+     */
+    void update(const Diagram& diagram, const std::vector<std::string>& changed) {
+        std::vector<std::string> affected;
+        std::vector<std::string> frontier;
+        std::unordered_set<std::string> seen;
+        for (const auto& node_id : changed) {
+            if (const Node* node = diagram.find_node(node_id)) {
+                for (const auto& input : node->inputs) consumers_[input].push_back(node_id);
+            }
+            if (seen.insert(node_id).second) frontier.push_back(node_id);
+        }
+        for (size_t level = 0; !frontier.empty(); ++level) {
+            std::vector<std::string> next;
+            for (const auto& node_id : frontier) {
+                affected.push_back(node_id);
+                if (level >= max_depth_) continue;
+                auto it = consumers_.find(node_id);
+                if (it == consumers_.end()) continue;
+                for (const auto& consumer : it->second) {
+                    if (seen.insert(consumer).second) next.push_back(consumer);
+                }
+            }
+            frontier.swap(next);
+        }
+
+        // Forget first, so re-evaluation never joins a stale result below
+        for (const auto& node_id : affected) {
+            memory_.erase(node_id);
+            for (auto& set : conflict_) set.erase(node_id);
+        }
+        for (const auto& node_id : affected) {
+            const Node* node = diagram.find_node(node_id);
+            if (!node) continue;
+            for (size_t r = 0; r < roots_.size(); ++r) {
+                if (patternHeadAdmits(*root_patterns_[r], *node) && evaluate(diagram, roots_[r], node_id).matched) {
+                    conflict_[r].insert(node_id);
+                }
+            }
+        }
+    }
+
+    /**
+     * Matches of rule k in the conflict set
+     */
+    size_t match_count(size_t k) const {
+        return rule_roots_[k] == kNone ? 0 : conflict_[rule_roots_[k]].size();
+    }
+
+    /**
+     * Rule k's match at its first root in nodes() order, as matchExpr
+     * would return it; false when it has none
+     */
+    bool first_match(const Diagram& diagram, size_t k, RuleMatch& out) {
+        if (rule_roots_[k] == kNone) return false;
+        const auto& set = conflict_[rule_roots_[k]];
+        uint32_t best = std::numeric_limits<uint32_t>::max();
+        const std::string* best_id = nullptr;
+        for (const auto& node_id : set) {
+            const uint32_t position = diagram.node_position(node_id);
+            if (position < best) {
+                best = position;
+                best_id = &node_id;
+            }
+        }
+        if (!best_id) return false;
+
+        const Result& result = evaluate(diagram, roots_[rule_roots_[k]], *best_id);
+        out = RuleMatch();
+        out.rule = k;
+        out.root_position = best;
+        out.root_id = *best_id;
+        for (size_t slot = 0; slot < result.slots.size(); ++slot) {
+            if (!result.slots[slot].empty()) out.bindings[rule_vars_[k][slot]] = result.slots[slot];
+        }
+        out.matched.insert(result.matched_nodes.begin(), result.matched_nodes.end());
+        out.bound_nodes.insert(result.bound_nodes.begin(), result.bound_nodes.end());
+        return true;
+    }
+
+private:
+    static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+    struct Child {
+        size_t node;
+        std::vector<size_t> slot_map;   // Child slot -> parent slot
+    };
+
+    struct NetNode {
+        ASTKind kind;
+        bool variable = false;
+        std::string name;   // Operator or literal atom
+        std::vector<Child> args;
+        size_t slots = 0;
+    };
+
+    // Result of one network node at one diagram node
+    struct Result {
+        bool evaluated = false;
+        bool matched = false;
+        std::vector<std::string> slots;   // Node bound to each slot ("" = unbound)
+        std::vector<std::string> matched_nodes;
+        std::vector<std::string> bound_nodes;
+    };
+
+    std::vector<NetNode> nodes_;
+    std::unordered_map<std::string, size_t> interned_;   // Structural key -> network node
+    std::vector<size_t> roots_;                          // Distinct root network nodes
+    std::vector<const ASTNode*> root_patterns_;          // A pattern of each root (for its head)
+    std::vector<size_t> rule_roots_;                     // Rule -> index into roots_
+    std::vector<std::vector<std::string>> rule_vars_;    // Rule -> variable name of each slot
+    size_t max_depth_ = 0;
+
+    std::unordered_map<std::string, std::vector<Result>> memory_;   // Diagram node -> result per network node
+    std::unordered_map<std::string, std::vector<std::string>> consumers_;   // Input ID -> nodes listing it
+    std::vector<std::unordered_set<std::string>> conflict_;        // Root -> diagram nodes it matches at
+    uint64_t evaluations_ = 0;
+
+    size_t intern(NetNode node, const std::string& key) {
+        auto it = interned_.find(key);
+        if (it != interned_.end()) return it->second;
+        nodes_.push_back(std::move(node));
+        interned_.emplace(key, nodes_.size() - 1);
+        return nodes_.size() - 1;
+    }
+
+    // Network node of `expr`; `vars` receives its variable names by slot
+    size_t compile(const ASTNode& expr, std::vector<std::string>& vars) {
+        vars.clear();
+        NetNode node;
+        node.kind = expr.kind;
+        if (expr.kind == ASTKind::Atom) {
+            if (isVariable(expr.atom_name)) {
+                vars.push_back(expr.atom_name[0] == '$' ? expr.atom_name.substr(1) : expr.atom_name);
+                node.variable = true;
+                node.slots = 1;
+                return intern(std::move(node), "?");
+            }
+            node.name = expr.atom_name;
+            return intern(std::move(node), "a:" + expr.atom_name);
+        }
+
+        node.name = expr.op_name;
+        std::string key = "o:" + expr.op_name + "(";
+        for (const auto& arg : expr.args) {
+            std::vector<std::string> arg_vars;
+            Child child;
+            child.node = compile(arg, arg_vars);
+            for (const auto& name : arg_vars) {
+                auto it = std::find(vars.begin(), vars.end(), name);
+                child.slot_map.push_back(static_cast<size_t>(it - vars.begin()));
+                if (it == vars.end()) vars.push_back(name);
+            }
+            key += std::to_string(child.node) + "[";
+            for (size_t slot : child.slot_map) key += std::to_string(slot) + ",";
+            key += "]";
+            node.args.push_back(std::move(child));
+        }
+        key += ")";
+        node.slots = vars.size();
+        return intern(std::move(node), key);
+    }
+
+    // Literal atom match of matchExpr: a P node's DOF or a metadata atom argument
+    static bool carriesAtom(const Node& node, const std::string& atom) {
+        if (node.op == "P" && std::find(node.dof_refs.begin(), node.dof_refs.end(), atom) != node.dof_refs.end()) {
+            return true;
+        }
+        auto meta_it = node.meta.find(attr_keys::kAtomArgs);
+        if (meta_it != node.meta.end() && std::holds_alternative<std::vector<std::string>>(meta_it->second)) {
+            const auto& atom_args = std::get<std::vector<std::string>>(meta_it->second);
+            return std::find(atom_args.begin(), atom_args.end(), atom) != atom_args.end();
+        }
+        return false;
+    }
+
+    // matchExpr of network node `n` at `node_id`, memoized
+    const Result& evaluate(const Diagram& diagram, size_t n, const std::string& node_id) {
+        static const Result kNoMatch{true, false, {}, {}, {}};
+        const Node* node = diagram.find_node(node_id);
+        if (!node) return kNoMatch;
+
+        std::vector<Result>& results = memory_[node_id];   // Node-based map: stays valid
+        if (results.empty()) results.resize(nodes_.size());
+        if (results[n].evaluated) return results[n];
+        evaluations_++;
+
+        const NetNode& net = nodes_[n];
+        Result result;
+        result.evaluated = true;
+        result.slots.assign(net.slots, std::string());
+        auto bindSlot = [&](size_t slot, const std::string& id) {
+            std::string& bound = result.slots[slot];
+            if (!bound.empty() && bound != id) return false;   // Conflict
+            bound = id;
+            return true;
+        };
+
+        if (net.kind == ASTKind::Atom) {
+            if (net.variable) {
+                result.slots[0] = node_id;
+                result.bound_nodes.push_back(node_id);
+                result.matched = true;
+            } else {
+                result.matched = carriesAtom(*node, net.name);
+            }
+        } else if (node->op == net.name) {
+            result.matched = true;
+            result.matched_nodes.push_back(node_id);
+            if (!node->inputs.empty()) {
+                if (node->inputs.size() < net.args.size()) result.matched = false;
+                for (size_t i = 0; result.matched && i < net.args.size(); ++i) {
+                    const Child& child = net.args[i];
+                    const Result& below = evaluate(diagram, child.node, node->inputs[i]);
+                    if (!below.matched) {
+                        result.matched = false;
+                        break;
+                    }
+                    for (size_t slot = 0; slot < below.slots.size(); ++slot) {
+                        if (!below.slots[slot].empty() && !bindSlot(child.slot_map[slot], below.slots[slot])) {
+                            result.matched = false;
+                            break;
+                        }
+                    }
+                    result.matched_nodes.insert(result.matched_nodes.end(),
+                                                below.matched_nodes.begin(), below.matched_nodes.end());
+                    result.bound_nodes.insert(result.bound_nodes.end(),
+                                              below.bound_nodes.begin(), below.bound_nodes.end());
+                }
+            } else if (net.name == "P" && !net.args.empty()) {
+                // No inputs: the first argument is matched against the P node itself
+                const Child& child = net.args[0];
+                const NetNode& arg = nodes_[child.node];
+                if (arg.kind != ASTKind::Atom) {
+                    result.matched = false;
+                } else if (arg.variable) {
+                    bindSlot(child.slot_map[0], node_id);
+                    result.bound_nodes.push_back(node_id);
+                } else {
+                    result.matched = std::find(node->dof_refs.begin(), node->dof_refs.end(), arg.name) !=
+                                     node->dof_refs.end();
+                }
+            } else if (!net.args.empty()) {
+                result.matched = false;
+            }
+        }
+
+        if (!result.matched) {
+            result.slots.clear();
+            result.matched_nodes.clear();
+            result.bound_nodes.clear();
+        }
+        results[n] = std::move(result);
+        return results[n];
+    }
+};
+
+/**
+ * Rewrite through a match network until no rule matches, a round applies
+ * nothing, or options.horizon_cap rewrites have run.  Same rewrites as
+ * runParallelRewrites(..., batch = false); candidates_tried counts network
+ * results computed instead of roots tried.
+ *
+ * @param diagram Acyclic diagram to rewrite
+ * @param rules Compiled rules, indexed by FixpointResult::applied_trace
+ * @param options Policy (rule priority of each round), horizon and seed
+ */
+inline FixpointResult runNetworkRewrites(Diagram& diagram,
+                                         const std::vector<const CompiledRule*>& rules,
+                                         const FixpointOptions& options) {
+    FixpointResult result;
+    const Diagram& view = diagram;
+    std::mt19937 rng(static_cast<uint32_t>(options.seed));
+
+    MatchNetwork network(rules);
+    network.attach(view);
+    RuleMatch match;
+    while (result.steps < options.horizon_cap) {
+        bool applied_round = false;
+        for (size_t k : buildRuleOrder(rules.size(), options.policy, rng)) {
+            if (!network.first_match(view, k, match)) continue;
+
+            InPlaceRewriteResult rewrite = applyRewriteAtMatch(diagram, *rules[k], match.bindings,
+                                                               match.matched, match.bound_nodes);
+            if (!rewrite.applied) {
+                continue;   // Would introduce a cycle; the next rule's match is tried
+            }
+            std::vector<std::string> changed = std::move(rewrite.added_nodes);
+            for (const auto& node_id : match.matched) {
+                if (!match.bound_nodes.count(node_id)) changed.push_back(node_id);
+            }
+            network.update(view, changed);
+
+            applied_round = true;
+            result.steps++;
+            result.applied_trace.push_back(k);
+            if (result.steps >= options.horizon_cap) {
+                result.horizon_hit = true;
+            }
+            break;
+        }
+        if (!applied_round) {
+            break;   // Fixed point
+        }
+    }
+
+    result.candidates_tried = network.evaluations();
+    return result;
+}
+
+} // namespace sid
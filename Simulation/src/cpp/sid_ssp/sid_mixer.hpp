@@ -95,14 +95,119 @@ public:
     const MixerMetrics& metrics() const { return metrics_; }
     const MixerConfig& config() const { return config_; }
 
+    /**
+     * Observation state carried between steps (for checkpoints)
+     */
+    struct State {
+        bool initialized;
+        double I0, N0, U0;
+        double prev_I, prev_U;
+        uint64_t stable_count;
+        MixerMetrics metrics;
+    };
+
+    State state() const {
+        return State{initialized_, I0_, N0_, U0_, prev_I_, prev_U_, stable_count_, metrics_};
+    }
+
+    void restore_state(const State& state) {
+        initialized_ = state.initialized;
+        I0_ = state.I0;
+        N0_ = state.N0;
+        U0_ = state.U0;
+        prev_I_ = state.prev_I;
+        prev_U_ = state.prev_U;
+        stable_count_ = state.stable_count;
+        metrics_ = state.metrics;
+    }
+
     /**
      * Execute one mixer observation step
      *
-     * BUG FIX (HIGH): Added MAX_SCALE_FACTOR limit to prevent unbounded growth
+     * Reads I and N once and U once (plus one read-write pass over U if it
+     * needs a conservation correction); metrics are left to commit_step.
+     * See step_and_commit for the fused version.
      */
     void step(const SemanticProcessor& ssp_I, 
               const SemanticProcessor& ssp_N,
               SemanticProcessor& ssp_U) {
+        check_processors(ssp_I, ssp_N, ssp_U);
+
+        const double I = ssp_I.total_mass();
+        const double N = ssp_N.total_mass();
+        double U = ssp_U.total_mass();
+        const double total_before = I + N + U;
+
+        FieldStatistics corrected;
+        if (correct(ssp_U, I, N, U, corrected)) {
+            U = corrected.sum;
+        }
+        observe(I, N, U, total_before);
+    }
+
+    /**
+     * Fused mixer step and commit_step of all three processors
+     *
+     * Same result as step() followed by commit_step() on I, N and U, in one
+     * read pass per field: the masses come from the statistics pass that
+     * also feeds each processor's metrics, and a conservation correction of
+     * U measures the field while it rewrites it.
+     */
+    void step_and_commit(SemanticProcessor& ssp_I,
+                         SemanticProcessor& ssp_N,
+                         SemanticProcessor& ssp_U) {
+        check_processors(ssp_I, ssp_N, ssp_U);
+
+        const FieldStatistics stats_I = ssp_I.field_statistics();
+        const FieldStatistics stats_N = ssp_N.field_statistics();
+        FieldStatistics stats_U = ssp_U.field_statistics();
+        const double total_before = stats_I.sum + stats_N.sum + stats_U.sum;
+
+        FieldStatistics corrected;
+        if (correct(ssp_U, stats_I.sum, stats_N.sum, stats_U.sum, corrected)) {
+            stats_U = corrected;
+        }
+        observe(stats_I.sum, stats_N.sum, stats_U.sum, total_before);
+
+        ssp_I.commit_step(stats_I);
+        ssp_N.commit_step(stats_N);
+        ssp_U.commit_step(stats_U);
+    }
+
+    /**
+     * Mixer step from masses the caller keeps up to date, so I and N are
+     * not read at all and U only if it needs a correction
+     *
+     * @param I Mass of ssp_I's field
+     * @param N Mass of ssp_N's field
+     * @param U Mass of ssp_U's field
+     * @param ssp_U Undecided processor (corrected in place)
+     * @param corrected If not null, set to whether U was corrected
+     * @return Mass of U after the step (measured if corrected, else U)
+     */
+    double step_with_masses(double I, double N, double U, SemanticProcessor& ssp_U,
+                            bool* corrected = nullptr) {
+        if (ssp_U.role() != Role::U) {
+            throw std::logic_error("Mixer role mismatch for I/N/U processors");
+        }
+
+        const double total_before = I + N + U;
+        FieldStatistics stats_U;
+        const bool changed = correct(ssp_U, I, N, U, stats_U);
+        if (changed) {
+            U = stats_U.sum;
+        }
+        if (corrected) {
+            *corrected = changed;
+        }
+        observe(I, N, U, total_before);
+        return U;
+    }
+
+private:
+    void check_processors(const SemanticProcessor& ssp_I,
+                          const SemanticProcessor& ssp_N,
+                          const SemanticProcessor& ssp_U) const {
         if (ssp_I.role() != Role::I || ssp_N.role() != Role::N || ssp_U.role() != Role::U) {
             throw std::logic_error("Mixer role mismatch for I/N/U processors");
         }
@@ -111,26 +216,29 @@ public:
         if (ssp_I.field_len() != len || ssp_N.field_len() != len) {
             throw std::logic_error("Mixer field length mismatch");
         }
+    }
 
-        double I = ssp_I.total_mass();
-        double N = ssp_N.total_mass();
-        double U = ssp_U.total_mass();
-        double total = I + N + U;
-        double total_before = total;
+    /**
+     * Conservation correction of U, in one pass that also measures it
+     *
+     * BUG FIX (HIGH): Added MAX_SCALE_FACTOR limit to prevent unbounded growth
+     *
+     * @return true if U was changed (stats_U then describes the new field)
+     */
+    bool correct(SemanticProcessor& ssp_U, double I, double N, double U, FieldStatistics& stats_U) {
+        const uint64_t len = ssp_U.field_len();
+        const double total = I + N + U;
 
-        // Conservation correction
         if (total > C_ && U > 0.0) {
             const double excess = total - C_;
             double alpha = excess / U;
             if (alpha > 1.0) alpha = 1.0;
 
-            // Apply collapse to remove excess (simplified version)
-            std::vector<double> uniform_mask(len, 1.0);
-            ssp_U.apply_collapse(uniform_mask, alpha * U / len);
-
-            U = ssp_U.total_mass();
-            total = I + N + U;
-        } else if (total < C_) {
+            // Collapse with a uniform mask to remove the excess (simplified version)
+            stats_U = ssp_U.transform_field(FieldOp::SubtractClamped, alpha * U / len);
+            return true;
+        }
+        if (total < C_) {
             const double deficit = C_ - total;
             if (U > 0.0) {
                 // BUG FIX (HIGH): Limit scale factor
@@ -142,15 +250,21 @@ public:
                               << requested << " capped=" << MAX_SCALE_FACTOR
                               << " deficit=" << deficit << " U=" << U << std::endl;
                 }
-                ssp_U.scale_all(scale);
+                stats_U = ssp_U.transform_field(FieldOp::Scale, scale);
             } else {
                 const double amount_per_cell = deficit / static_cast<double>(len);
-                ssp_U.add_uniform(amount_per_cell);
+                stats_U = ssp_U.transform_field(FieldOp::AddUniform, amount_per_cell);
             }
-
-            U = ssp_U.total_mass();
-            total = I + N + U;
+            return true;
         }
+        return false;
+    }
+
+    /**
+     * Update the observables from the (corrected) masses
+     */
+    void observe(double I, double N, double U, double total_before) {
+        const double total = I + N + U;
 
         metrics_.admissible_volume = I;
         metrics_.excluded_volume = N;
@@ -219,6 +333,7 @@ public:
         prev_U_ = U;
     }
 
+public:
     /**
      * Request collapse of undecided field (policy-free stub)
      */
@@ -0,0 +1,226 @@
+/**
+ * SID Parallel Match Search - Concurrent multi-rule matching
+ *
+ * Searching for a match is read-only on the diagram, and with many rules
+ * per pass most of that time goes to candidates that fail.  Here each round
+ * searches all rules at once (OpenMP, dynamic schedule) against the diagram
+ * as it stands, then applies what it found in rule priority order:
+ *
+ *   single: the highest-priority match (first rule in the policy order that
+ *           matches, at its first root in nodes() order), one rewrite per
+ *           round, as a sweep would pick it
+ *   batch:  every match of every rule is found, and a greedy maximal set of
+ *           non-overlapping ones (no node shared between their matched and
+ *           bound nodes) is applied, highest priority first
+ *
+ * Matches that share no node stay valid while the others are applied:
+ * matchExpr reads only node fields, which rewrites never change on
+ * surviving nodes.  Rewrites run in place, so the diagram must be acyclic
+ * (see applyCompiledRewriteInPlace).  A match whose rewrite would introduce
+ * a cycle is skipped; a round that applies nothing ends the run.
+ *
+ * Without OpenMP the search runs serially with the same results.
+ */
+
+#pragma once
+
+#include "sid_fixpoint.hpp"
+#include "sid_rewrite.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace sid {
+
+/**
+ * A rule's pattern matched at one root
+ */
+struct RuleMatch {
+    size_t rule = 0;              // Index into the rule list
+    uint32_t root_position = 0;   // Root's position in nodes() when found
+    std::string root_id;
+    Bindings bindings;
+    std::unordered_set<std::string> matched;
+    std::unordered_set<std::string> bound_nodes;
+};
+
+/**
+ * Search every rule against a diagram concurrently
+ *
+ * @param diagram Diagram to search (not modified; its index is built first
+ *        so the threads only read it)
+ * @param rules Compiled rules; null and invalid ones never match
+ * @param all_matches Every match of every rule, or only each rule's first
+ * @param roots_tried If not null, incremented by the roots matched against
+ * @return Matches ordered by rule, then root position
+ */
+inline std::vector<RuleMatch> findRuleMatches(const Diagram& diagram,
+                                              const std::vector<const CompiledRule*>& rules,
+                                              bool all_matches,
+                                              uint64_t* roots_tried = nullptr) {
+    diagram.build_index();
+    const auto& nodes = diagram.nodes();
+
+    // Work items: (rule, candidate list) in first-match mode, (rule,
+    // candidate) in all-matches mode
+    std::vector<std::vector<uint32_t>> candidates(rules.size());
+    for (size_t k = 0; k < rules.size(); ++k) {
+        if (!rules[k] || !rules[k]->valid) continue;
+        const ASTNode& head = rules[k]->pattern;
+        if (head.kind == ASTKind::Op) {
+            candidates[k] = diagram.nodes_with_op(head.op_name);
+        } else if (!isVariable(head.atom_name)) {
+            candidates[k] = diagram.nodes_with_atom(head.atom_name);
+        } else {
+            candidates[k].resize(nodes.size());
+            for (uint32_t i = 0; i < nodes.size(); ++i) candidates[k][i] = i;
+        }
+    }
+    std::vector<std::pair<size_t, uint32_t>> items;   // (rule, index into candidates[rule])
+    for (size_t k = 0; k < rules.size(); ++k) {
+        if (all_matches) {
+            for (uint32_t i = 0; i < candidates[k].size(); ++i) items.emplace_back(k, i);
+        } else if (!candidates[k].empty()) {
+            items.emplace_back(k, 0);
+        }
+    }
+
+    int team = 1;
+#ifdef _OPENMP
+    team = omp_get_max_threads();
+#endif
+    std::vector<std::vector<RuleMatch>> found(static_cast<size_t>(team));
+    uint64_t tried = 0;
+
+    #pragma omp parallel num_threads(team) reduction(+:tried)
+    {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        MatchScratch scratch;
+        std::vector<RuleMatch>& out = found[static_cast<size_t>(tid)];
+
+        auto tryRoot = [&](size_t k, uint32_t position) {
+            const Node& node = nodes[position];
+            const ASTNode& pattern = rules[k]->pattern;
+            if (pattern.kind == ASTKind::Op && !arityAdmits(node, pattern)) return false;
+            tried++;
+            scratch.clear();
+            if (!matchExpr(pattern, node.id, diagram, scratch.bindings, scratch.matched, scratch.bound_nodes)) {
+                return false;
+            }
+            RuleMatch match;
+            match.rule = k;
+            match.root_position = position;
+            match.root_id = node.id;
+            match.bindings = scratch.bindings;
+            match.matched = scratch.matched;
+            match.bound_nodes = scratch.bound_nodes;
+            out.push_back(std::move(match));
+            return true;
+        };
+
+        #pragma omp for schedule(dynamic, 16)
+        for (long long item = 0; item < static_cast<long long>(items.size()); ++item) {
+            const size_t k = items[static_cast<size_t>(item)].first;
+            if (all_matches) {
+                tryRoot(k, candidates[k][items[static_cast<size_t>(item)].second]);
+            } else {
+                for (uint32_t position : candidates[k]) {
+                    if (tryRoot(k, position)) break;
+                }
+            }
+        }
+    }
+
+    if (roots_tried) {
+        *roots_tried += tried;
+    }
+    std::vector<RuleMatch> matches;
+    for (auto& thread_matches : found) {
+        for (auto& match : thread_matches) matches.push_back(std::move(match));
+    }
+    std::sort(matches.begin(), matches.end(), [](const RuleMatch& a, const RuleMatch& b) {
+        return a.rule != b.rule ? a.rule < b.rule : a.root_position < b.root_position;
+    });
+    return matches;
+}
+
+/**
+ * Rewrite with parallel match search until no rule matches, a round
+ * applies nothing, or options.horizon_cap rewrites have run
+ *
+ * @param diagram Acyclic diagram to rewrite
+ * @param rules Compiled rules, indexed by FixpointResult::applied_trace
+ * @param options Policy (rule priority of each round), horizon and seed
+ * @param batch Apply a maximal set of non-overlapping matches per round
+ *        instead of only the highest-priority one
+ */
+inline FixpointResult runParallelRewrites(Diagram& diagram,
+                                          const std::vector<const CompiledRule*>& rules,
+                                          const FixpointOptions& options,
+                                          bool batch) {
+    FixpointResult result;
+    std::mt19937 rng(static_cast<uint32_t>(options.seed));
+
+    while (result.steps < options.horizon_cap) {
+        const std::vector<size_t> order = buildRuleOrder(rules.size(), options.policy, rng);
+        std::vector<RuleMatch> matches = findRuleMatches(diagram, rules, batch, &result.candidates_tried);
+        if (matches.empty()) {
+            break;   // Fixed point
+        }
+
+        // Priority: rank of the rule in this round's order, then root position
+        std::vector<size_t> rank(rules.size());
+        for (size_t i = 0; i < order.size(); ++i) rank[order[i]] = i;
+        std::stable_sort(matches.begin(), matches.end(), [&](const RuleMatch& a, const RuleMatch& b) {
+            return rank[a.rule] < rank[b.rule];
+        });
+
+        bool applied_round = false;
+        std::unordered_set<std::string> claimed;   // Nodes of matches applied this round
+        for (const RuleMatch& match : matches) {
+            auto overlaps = [&](const std::unordered_set<std::string>& ids) {
+                for (const auto& id : ids) {
+                    if (claimed.count(id)) return true;
+                }
+                return false;
+            };
+            if (overlaps(match.matched) || overlaps(match.bound_nodes)) continue;
+
+            InPlaceRewriteResult rewrite = applyRewriteAtMatch(diagram, *rules[match.rule], match.bindings,
+                                                               match.matched, match.bound_nodes);
+            if (!rewrite.applied) {
+                continue;   // Would introduce a cycle
+            }
+            claimed.insert(match.matched.begin(), match.matched.end());
+            claimed.insert(match.bound_nodes.begin(), match.bound_nodes.end());
+            applied_round = true;
+            result.steps++;
+            result.applied_trace.push_back(match.rule);
+            if (result.steps >= options.horizon_cap) {
+                result.horizon_hit = true;
+                break;
+            }
+            if (!batch) {
+                break;
+            }
+        }
+        if (!applied_round) {
+            break;
+        }
+    }
+
+    return result;
+}
+
+} // namespace sid
@@ -3,12 +3,19 @@
  *
  * Parses SID expressions like "P(Freedom)", "O(S+(Peace))", etc.
  * Port from sids/sid_parser.py
+ *
+ * Tokens are views into the input (TokenView), and ArenaParser builds trees
+ * straight into an AstArena, so parsing allocates nothing per token or per
+ * node once the arena and the parser's buffers have grown.  parseExpression
+ * parses through an arena and converts the result to an owning ASTNode.
  */
 
 #pragma once
 
 #include "sid_ast.hpp"
+#include "sid_ast_arena.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 #include <cctype>
@@ -41,117 +48,118 @@ struct Token {
 };
 
 /**
- * Tokenizer - converts string to tokens
+ * Token referring into the tokenized text (which must outlive it)
  */
-class Tokenizer {
-private:
-    std::string text_;
-    size_t pos_;
+struct TokenView {
+    TokenKind kind;
+    std::string_view value;
+    size_t pos;
+};
 
-    void skipWhitespace() {
-        while (pos_ < text_.size() && std::isspace(text_[pos_])) {
-            pos_++;
+/**
+ * Tokenize into a reusable buffer without copying any text
+ *
+ * @throws ParseError on a character that starts no token
+ */
+inline void tokenizeView(std::string_view text, std::vector<TokenView>& tokens) {
+    tokens.clear();
+    size_t pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            pos++;
         }
-    }
+        if (pos >= text.size()) break;
 
-    bool tryParseOperator(Token& token) {
-        // Try two-character operators first (S+, S-)
-        if (pos_ + 1 < text_.size()) {
-            std::string two_char = text_.substr(pos_, 2);
-            if (OPERATORS.count(two_char)) {
-                token = Token(TokenKind::OPERATOR, two_char, pos_);
-                pos_ += 2;
-                return true;
-            }
-        }
+        const char ch = text[pos];
 
-        // Try single-character operators (P, O, C, T)
-        if (pos_ < text_.size()) {
-            std::string one_char = text_.substr(pos_, 1);
-            if (OPERATORS.count(one_char)) {
-                token = Token(TokenKind::OPERATOR, one_char, pos_);
-                pos_++;
-                return true;
-            }
+        // Operators, two-character ones first (S+, S-), then P, O, C, T
+        if (ch == 'S' && pos + 1 < text.size() && (text[pos + 1] == '+' || text[pos + 1] == '-')) {
+            tokens.push_back({TokenKind::OPERATOR, text.substr(pos, 2), pos});
+            pos += 2;
+            continue;
         }
-
-        return false;
-    }
-
-    bool tryParseIdentifier(Token& token) {
-        if (pos_ >= text_.size()) return false;
-
-        char first = text_[pos_];
-        // Identifiers start with $ (for variables) or letter or underscore
-        if (first != '$' && !std::isalpha(first) && first != '_') {
-            return false;
+        if (ch == 'P' || ch == 'O' || ch == 'C' || ch == 'T') {
+            tokens.push_back({TokenKind::OPERATOR, text.substr(pos, 1), pos});
+            pos++;
+            continue;
         }
 
-        size_t start = pos_;
-        pos_++;
-
-        // Continue with alphanumeric or underscore
-        while (pos_ < text_.size() &&
-               (std::isalnum(text_[pos_]) || text_[pos_] == '_')) {
-            pos_++;
+        // Identifiers start with $ (for variables) or letter or underscore,
+        // and continue with alphanumeric or underscore
+        if (ch == '$' || ch == '_' || std::isalpha(static_cast<unsigned char>(ch))) {
+            const size_t start = pos++;
+            while (pos < text.size() &&
+                   (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_')) {
+                pos++;
+            }
+            tokens.push_back({TokenKind::IDENT, text.substr(start, pos - start), start});
+            continue;
         }
 
-        token = Token(TokenKind::IDENT, text_.substr(start, pos_ - start), start);
-        return true;
+        // Single character tokens
+        if (ch == '(') {
+            tokens.push_back({TokenKind::LPAREN, text.substr(pos, 1), pos});
+        } else if (ch == ')') {
+            tokens.push_back({TokenKind::RPAREN, text.substr(pos, 1), pos});
+        } else if (ch == ',') {
+            tokens.push_back({TokenKind::COMMA, text.substr(pos, 1), pos});
+        } else {
+            // Unknown character
+            throw ParseError("Unexpected character '" + std::string(1, ch) +
+                           "' at position " + std::to_string(pos));
+        }
+        pos++;
     }
+}
+
+/**
+ * Tokenizer - converts string to owning tokens (see tokenizeView)
+ */
+class Tokenizer {
+private:
+    std::string text_;
 
 public:
-    explicit Tokenizer(const std::string& text) : text_(text), pos_(0) {}
+    explicit Tokenizer(const std::string& text) : text_(text) {}
 
     std::vector<Token> tokenize() {
+        std::vector<TokenView> views;
+        tokenizeView(text_, views);
         std::vector<Token> tokens;
-
-        while (pos_ < text_.size()) {
-            skipWhitespace();
-            if (pos_ >= text_.size()) break;
-
-            size_t start_pos = pos_;
-            Token token(TokenKind::END, "", pos_);
-
-            // Try to parse operator
-            if (tryParseOperator(token)) {
-                tokens.push_back(token);
-                continue;
-            }
-
-            // Try to parse identifier
-            if (tryParseIdentifier(token)) {
-                tokens.push_back(token);
-                continue;
-            }
-
-            // Single character tokens
-            char ch = text_[pos_];
-            if (ch == '(') {
-                tokens.push_back(Token(TokenKind::LPAREN, "(", pos_));
-                pos_++;
-                continue;
-            }
-            if (ch == ')') {
-                tokens.push_back(Token(TokenKind::RPAREN, ")", pos_));
-                pos_++;
-                continue;
-            }
-            if (ch == ',') {
-                tokens.push_back(Token(TokenKind::COMMA, ",", pos_));
-                pos_++;
-                continue;
-            }
-
-            // Unknown character
-            throw ParseError("Unexpected character '" + std::string(1, ch) +
-                           "' at position " + std::to_string(pos_));
+        tokens.reserve(views.size());
+        for (const auto& view : views) {
+            tokens.emplace_back(view.kind, std::string(view.value), view.pos);
         }
-
         return tokens;
     }
 };
 
+/**
+ * Operator arity constraints
+ *
+ * @throws ParseError if `op` cannot take `num_args` arguments
+ */
+inline void validateOperatorArity(std::string_view op, size_t num_args, size_t pos) {
+    if (op == "P" || op == "O" || op == "T") {
+        if (num_args != 1) {
+            throw ParseError(std::string(op) + " requires exactly 1 argument, got " +
+                           std::to_string(num_args) + " at position " +
+                           std::to_string(pos));
+        }
+    } else if (op == "C") {
+        if (num_args != 2) {
+            throw ParseError("C requires exactly 2 arguments, got " +
+                           std::to_string(num_args) + " at position " +
+                           std::to_string(pos));
+        }
+    } else if (op == "S+" || op == "S-") {
+        if (num_args < 1) {
+            throw ParseError(std::string(op) + " requires at least 1 argument at position " +
+                           std::to_string(pos));
+        }
+    }
+}
+
 /**
  * Recursive descent parser
  */
@@ -178,25 +186,7 @@ private:
     }
 
     void validateArity(const std::string& op, size_t num_args, size_t pos) {
-        // Operator arity constraints
-        if (op == "P" || op == "O" || op == "T") {
-            if (num_args != 1) {
-                throw ParseError(op + " requires exactly 1 argument, got " +
-                               std::to_string(num_args) + " at position " +
-                               std::to_string(pos));
-            }
-        } else if (op == "C") {
-            if (num_args != 2) {
-                throw ParseError("C requires exactly 2 arguments, got " +
-                               std::to_string(num_args) + " at position " +
-                               std::to_string(pos));
-            }
-        } else if (op == "S+" || op == "S-") {
-            if (num_args < 1) {
-                throw ParseError(op + " requires at least 1 argument at position " +
-                               std::to_string(pos));
-            }
-        }
+        validateOperatorArity(op, num_args, pos);
     }
 
     ASTNode parseExpr() {
@@ -265,6 +255,125 @@ public:
     }
 };
 
+/**
+ * Recursive descent parser into an AstArena
+ *
+ * Same grammar and errors as Parser.  Token and child buffers are kept
+ * between parse() calls, so one ArenaParser parsing many expressions
+ * allocates only as the arena grows.
+ */
+class ArenaParser {
+private:
+    AstArena& arena_;
+    std::vector<TokenView> tokens_;
+    std::vector<AstRef> stack_;   // Children of the operators being parsed
+    size_t pos_ = 0;
+
+    const TokenView* current() const {
+        if (pos_ >= tokens_.size()) return nullptr;
+        return &tokens_[pos_];
+    }
+
+    void consume(TokenKind expected) {
+        const TokenView* tok = current();
+        if (!tok) {
+            throw ParseError("Unexpected end of input");
+        }
+        if (tok->kind != expected) {
+            throw ParseError("Expected different token at position " +
+                           std::to_string(tok->pos));
+        }
+        pos_++;
+    }
+
+    AstRef parseExpr() {
+        const TokenView* tok = current();
+        if (!tok) {
+            throw ParseError("Empty expression");
+        }
+
+        if (tok->kind == TokenKind::OPERATOR) {
+            const std::string_view op = tok->value;
+            const size_t op_pos = tok->pos;
+            consume(TokenKind::OPERATOR);
+
+            // Arguments go on the stack until the operator is appended
+            const size_t base = stack_.size();
+            const TokenView* next = current();
+            if (next && next->kind == TokenKind::LPAREN) {
+                consume(TokenKind::LPAREN);
+                stack_.push_back(parseExpr());
+                while ((next = current()) && next->kind == TokenKind::COMMA) {
+                    consume(TokenKind::COMMA);
+                    stack_.push_back(parseExpr());
+                }
+                consume(TokenKind::RPAREN);
+            }
+
+            validateOperatorArity(op, stack_.size() - base, op_pos);
+
+            const AstRef ref = arena_.addOp(op, stack_.data() + base, stack_.size() - base);
+            stack_.resize(base);
+            return ref;
+        }
+
+        if (tok->kind == TokenKind::IDENT) {
+            const std::string_view name = tok->value;
+            consume(TokenKind::IDENT);
+            return arena_.addAtom(name);
+        }
+
+        throw ParseError("Unexpected token at position " + std::to_string(tok->pos));
+    }
+
+public:
+    explicit ArenaParser(AstArena& arena) : arena_(arena) {}
+
+    /**
+     * Parse one expression into the arena
+     *
+     * @return Root of the new tree
+     * @throws ParseError on syntax error (nodes parsed before the error stay
+     *         in the arena, unreferenced)
+     */
+    AstRef parse(std::string_view text) {
+        tokenizeView(text, tokens_);
+        stack_.clear();
+        pos_ = 0;
+
+        const AstRef root = parseExpr();
+
+        // Check for trailing tokens
+        if (current()) {
+            throw ParseError("Unexpected trailing tokens at position " +
+                           std::to_string(current()->pos));
+        }
+
+        return root;
+    }
+};
+
+/**
+ * Parse a batch of expressions (e.g. the patterns of a rule file) into one
+ * arena
+ *
+ * @return Root of each expression, in order
+ * @throws ParseError naming the index of the first expression that fails
+ */
+inline std::vector<AstRef> parseExpressions(const std::vector<std::string>& texts, AstArena& arena) {
+    ArenaParser parser(arena);
+    std::vector<AstRef> roots;
+    roots.reserve(texts.size());
+    for (size_t i = 0; i < texts.size(); ++i) {
+        try {
+            roots.push_back(parser.parse(texts[i]));
+        } catch (const ParseError& e) {
+            throw ParseError("Expression " + std::to_string(i) + ": " + e.what());
+        }
+    }
+    return roots;
+}
+
 /**
  * Parse SID expression string to AST
  *
@@ -273,10 +382,9 @@ public:
  * @throws ParseError on syntax error
  */
 inline ASTNode parseExpression(const std::string& text) {
-    Tokenizer tokenizer(text);
-    std::vector<Token> tokens = tokenizer.tokenize();
-    Parser parser(tokens);
-    return parser.parse();
+    AstArena arena;
+    ArenaParser parser(arena);
+    return arena.toASTNode(parser.parse(text));
 }
 
 } // namespace sid
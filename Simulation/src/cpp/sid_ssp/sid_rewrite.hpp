@@ -20,6 +20,7 @@
 #include <tuple>
 #include <stdexcept>
 #include <algorithm>
+#include <utility>
 
 namespace sid {
 
@@ -34,8 +35,9 @@ struct RewriteResult {
     Diagram diagram;
     std::vector<std::string> messages;
 
-    RewriteResult(bool app, const Diagram& diag, const std::vector<std::string>& msgs = {})
-        : applied(app), diagram(diag), messages(msgs) {}
+    // By value: callers move their working diagram and messages in
+    RewriteResult(bool app, Diagram diag, std::vector<std::string> msgs = {})
+        : applied(app), diagram(std::move(diag)), messages(std::move(msgs)) {}
 };
 
 /**
@@ -56,18 +58,14 @@ inline bool isVariable(const std::string& atom) {
  * Generate next unique node ID
  */
 inline std::string nextNodeId(const Diagram& diagram, const std::string& prefix) {
-    std::unordered_set<std::string> existing;
-    for (const auto& node : diagram.nodes()) {
-        existing.insert(node.id);
-    }
-
-    int idx = 1;
+    // Hash lookups in the diagram's index, resuming after the last ID issued
+    int& idx = diagram.id_counter(prefix);
     while (true) {
         std::string candidate = prefix + std::to_string(idx);
-        if (existing.find(candidate) == existing.end()) {
+        idx++;
+        if (!diagram.find_node(candidate)) {
             return candidate;
         }
-        idx++;
     }
 }
 
@@ -75,18 +73,14 @@ inline std::string nextNodeId(const Diagram& diagram, const std::string& prefix)
  * Generate next unique edge ID
  */
 inline std::string nextEdgeId(const Diagram& diagram, const std::string& prefix) {
-    std::unordered_set<std::string> existing;
-    for (const auto& edge : diagram.edges()) {
-        existing.insert(edge.id);
-    }
-
-    int idx = 1;
+    // Hash lookups in the diagram's index, resuming after the last ID issued
+    int& idx = diagram.id_counter(prefix);
     while (true) {
         std::string candidate = prefix + std::to_string(idx);
-        if (existing.find(candidate) == existing.end()) {
+        idx++;
+        if (!diagram.find_edge(candidate)) {
             return candidate;
         }
-        idx++;
     }
 }
 
@@ -216,7 +210,7 @@ inline bool matchExpr(const ASTNode& expr, const std::string& node_id,
         }
 
         // Check metadata
-        auto meta_it = node->meta.find("atom_args");
+        auto meta_it = node->meta.find(attr_keys::kAtomArgs);
         if (meta_it != node->meta.end()) {
             if (std::holds_alternative<std::vector<std::string>>(meta_it->second)) {
                 const auto& atom_args = std::get<std::vector<std::string>>(meta_it->second);
@@ -286,62 +280,145 @@ inline bool matchExpr(const ASTNode& expr, const std::string& node_id,
     return false;
 }
 
+/**
+ * Binding / match sets reused across candidate roots (and across calls when
+ * the caller keeps one), so a failed candidate costs a clear() instead of
+ * three fresh hash tables
+ */
+struct MatchScratch {
+    Bindings bindings;
+    std::unordered_set<std::string> matched;
+    std::unordered_set<std::string> bound_nodes;
+
+    void clear() {
+        bindings.clear();
+        matched.clear();
+        bound_nodes.clear();
+    }
+};
+
+/**
+ * Whether a node can root a match of an operator pattern, by arity alone
+ * (the cheap part of matchExpr's Op case)
+ */
+inline bool arityAdmits(const Node& node, const ASTNode& expr) {
+    if (!node.inputs.empty()) return node.inputs.size() >= expr.args.size();
+    return expr.args.empty() || expr.op_name == "P";
+}
+
 /**
  * Find expression match in diagram
  *
+ * Only nodes that can match the pattern head are tried: nodes with the head
+ * operator and a compatible arity for Op patterns, nodes carrying the atom
+ * for literal atoms (Diagram's label index); a variable matches any node.
+ * Candidates are tried in nodes() order, so the first match is the same as
+ * a scan of every node.
+ *
  * @param diagram Diagram to search
  * @param expr Pattern expression
+ * @param scratch Working sets; left holding the last candidate's state
  * @return Optional tuple of (root_id, bindings, matched_nodes, bound_nodes)
  */
 inline std::optional<std::tuple<std::string, Bindings, std::unordered_set<std::string>, std::unordered_set<std::string>>>
-findExprMatch(const Diagram& diagram, const ASTNode& expr) {
-    for (const auto& node : diagram.nodes()) {
-        Bindings bindings;
-        std::unordered_set<std::string> matched;
-        std::unordered_set<std::string> bound_nodes;
+findExprMatch(const Diagram& diagram, const ASTNode& expr, MatchScratch& scratch) {
+    const auto& nodes = diagram.nodes();
+    auto tryRoot = [&](const Node& node) {
+        scratch.clear();
+        return matchExpr(expr, node.id, diagram, scratch.bindings, scratch.matched, scratch.bound_nodes);
+    };
+    auto result = [&](const Node& node) {
+        return std::make_tuple(node.id, scratch.bindings, scratch.matched, scratch.bound_nodes);
+    };
+
+    if (expr.kind == ASTKind::Op) {
+        for (uint32_t position : diagram.nodes_with_op(expr.op_name)) {
+            const Node& node = nodes[position];
+            if (arityAdmits(node, expr) && tryRoot(node)) return result(node);
+        }
+        return std::nullopt;
+    }
 
-        if (matchExpr(expr, node.id, diagram, bindings, matched, bound_nodes)) {
-            return std::make_tuple(node.id, bindings, matched, bound_nodes);
+    if (expr.kind == ASTKind::Atom && !isVariable(expr.atom_name)) {
+        for (uint32_t position : diagram.nodes_with_atom(expr.atom_name)) {
+            if (tryRoot(nodes[position])) return result(nodes[position]);
         }
+        return std::nullopt;
     }
 
+    for (const auto& node : nodes) {
+        if (tryRoot(node)) return result(node);
+    }
     return std::nullopt;
 }
 
+inline std::optional<std::tuple<std::string, Bindings, std::unordered_set<std::string>, std::unordered_set<std::string>>>
+findExprMatch(const Diagram& diagram, const ASTNode& expr) {
+    MatchScratch scratch;
+    return findExprMatch(diagram, expr, scratch);
+}
+
+/**
+ * Rewrite rule parsed once, for repeated application
+ *
+ * A rule that failed to parse keeps its parse error, so applying it reports
+ * the same message an uncompiled applyExprRewrite would.
+ */
+struct CompiledRule {
+    std::string rule_id;
+    std::string pattern_text;
+    std::string replacement_text;
+    ASTNode pattern;
+    ASTNode replacement;
+    bool valid = false;
+    std::string parse_error;   // When !valid
+};
+
+inline CompiledRule compileRule(const std::string& pattern_text,
+                                const std::string& replacement_text,
+                                const std::string& rule_id) {
+    CompiledRule rule;
+    rule.rule_id = rule_id;
+    rule.pattern_text = pattern_text;
+    rule.replacement_text = replacement_text;
+    try {
+        rule.pattern = parseExpression(pattern_text);
+        rule.replacement = parseExpression(replacement_text);
+        rule.valid = true;
+    } catch (const ParseError& e) {
+        rule.parse_error = e.what();
+    }
+    return rule;
+}
+
 /**
- * Apply expression-based rewrite rule
+ * Apply a compiled rewrite rule
  *
  * This is the core rewrite operation used by the SID engine.
  *
  * @param diagram Diagram to rewrite
- * @param pattern_text Pattern expression string (e.g., "P(Freedom)")
- * @param replacement_text Replacement expression string
- * @param rule_id Rule identifier
+ * @param rule Rule from compileRule()
+ * @param scratch Optional matcher working sets to reuse across calls
  * @return RewriteResult with updated diagram
  */
-inline RewriteResult applyExprRewrite(const Diagram& diagram,
-                                      const std::string& pattern_text,
-                                      const std::string& replacement_text,
-                                      const std::string& rule_id) {
+inline RewriteResult applyCompiledRewrite(const Diagram& diagram, const CompiledRule& rule,
+                                          MatchScratch* scratch = nullptr) {
     std::vector<std::string> messages;
+    const std::string& rule_id = rule.rule_id;
 
-    // Parse expressions
-    ASTNode pattern_expr;
-    ASTNode replacement_expr;
-
-    try {
-        pattern_expr = parseExpression(pattern_text);
-        replacement_expr = parseExpression(replacement_text);
-    } catch (const ParseError& e) {
-        messages.push_back("ERROR: " + std::string(e.what()));
-        return RewriteResult(false, diagram, messages);
+    if (!rule.valid) {
+        messages.push_back("ERROR: " + rule.parse_error);
+        return RewriteResult(false, diagram, std::move(messages));
     }
+    const ASTNode& pattern_expr = rule.pattern;
+    const ASTNode& replacement_expr = rule.replacement;
 
     // Find match
-    auto match = findExprMatch(diagram, pattern_expr);
+    MatchScratch local_scratch;
+    auto match = findExprMatch(diagram, pattern_expr, scratch ? *scratch : local_scratch);
     if (!match.has_value()) {
         messages.push_back("Rewrite " + rule_id + " not applicable");
-        return RewriteResult(false, diagram, messages);
+        return RewriteResult(false, diagram, std::move(messages));
     }
 
     auto [root_id, bindings, matched_nodes, bound_nodes] = match.value();
@@ -385,18 +462,255 @@ inline RewriteResult applyExprRewrite(const Diagram& diagram,
     }
 
     // Update diagram
-    new_diagram.nodes() = new_nodes;
-    new_diagram.edges() = new_edges;
+    new_diagram.nodes() = std::move(new_nodes);
+    new_diagram.edges() = std::move(new_edges);
     new_diagram.mark_dirty();
 
     // Check for cycles
     if (new_diagram.has_cycle()) {
         messages.push_back("ERROR: Rewrite " + rule_id + " would introduce cycle");
-        return RewriteResult(false, diagram, messages);
+        return RewriteResult(false, diagram, std::move(messages));
     }
 
     messages.push_back("Rewrite " + rule_id + " applied");
-    return RewriteResult(true, new_diagram, messages);
+    return RewriteResult(true, std::move(new_diagram), std::move(messages));
+}
+
+/**
+ * Inverse of the edits an in-place rewrite made, in the order they were made
+ *
+ * Removed nodes and edges are kept whole with their slot; added ones only as
+ * a count, since by the time they are undone they are back at the end.
+ */
+struct RewriteUndoLog {
+    enum class Kind : uint8_t { AddedNodes, AddedEdges, RemovedNode, RemovedEdge, RetargetedEdge };
+
+    struct Entry {
+        Kind kind;
+        uint32_t position;   // Slot in nodes() / edges(); count for Added*
+        uint32_t payload;    // Index into nodes / edges / targets
+    };
+
+    std::vector<Entry> entries;
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::vector<std::string> targets;   // Previous `to` of retargeted edges
+
+    bool empty() const { return entries.empty(); }
+
+    void clear() {
+        entries.clear();
+        nodes.clear();
+        edges.clear();
+        targets.clear();
+    }
+};
+
+/**
+ * Roll a diagram back through an undo log (and clear the log).  Restores
+ * the nodes() / edges() order as well as their contents.
+ */
+inline void undoRewrite(Diagram& diagram, RewriteUndoLog& log) {
+    for (auto it = log.entries.rbegin(); it != log.entries.rend(); ++it) {
+        switch (it->kind) {
+            case RewriteUndoLog::Kind::AddedNodes:
+                for (uint32_t i = 0; i < it->position; ++i) {
+                    diagram.take_node_at(static_cast<uint32_t>(diagram.nodes_count() - 1));
+                }
+                break;
+            case RewriteUndoLog::Kind::AddedEdges:
+                for (uint32_t i = 0; i < it->position; ++i) {
+                    diagram.take_edge_at(static_cast<uint32_t>(diagram.edges_count() - 1));
+                }
+                break;
+            case RewriteUndoLog::Kind::RemovedNode:
+                diagram.put_node_at(it->position, std::move(log.nodes[it->payload]));
+                break;
+            case RewriteUndoLog::Kind::RemovedEdge:
+                diagram.put_edge_at(it->position, std::move(log.edges[it->payload]));
+                break;
+            case RewriteUndoLog::Kind::RetargetedEdge:
+                diagram.set_edge_target(it->position, log.targets[it->payload]);
+                break;
+        }
+    }
+    log.clear();
+}
+
+/**
+ * Result of an in-place rewrite.  The diagram itself holds the outcome.
+ */
+struct InPlaceRewriteResult {
+    bool applied = false;
+    bool matched = false;    // A match was found (the rewrite may still be rejected)
+    std::vector<std::string> messages;
+    std::string root_id;     // Root of the spliced-in replacement, when applied
+    std::vector<std::string> added_nodes;   // IDs the replacement created, when applied
+    RewriteUndoLog undo;     // Empty unless applied
+};
+
+/**
+ * Splice a rule's replacement in at a match found by matchExpr /
+ * findExprMatch: the second half of applyCompiledRewriteInPlace, for
+ * callers that pick the match themselves.  Preconditions as for
+ * applyCompiledRewriteInPlace; `rule` must be valid.
+ */
+inline InPlaceRewriteResult applyRewriteAtMatch(Diagram& diagram, const CompiledRule& rule,
+                                                const Bindings& bindings,
+                                                const std::unordered_set<std::string>& matched_nodes,
+                                                const std::unordered_set<std::string>& bound_nodes) {
+    InPlaceRewriteResult result;
+    result.matched = true;
+    const Diagram& view = diagram;   // Read through const accessors: they keep the index
+    const std::string& rule_id = rule.rule_id;
+
+    RewriteUndoLog& log = result.undo;
+    const uint32_t nodes_before = static_cast<uint32_t>(view.nodes_count());
+    const uint32_t edges_before = static_cast<uint32_t>(view.edges_count());
+    auto logAdded = [&]() {
+        log.entries.push_back({RewriteUndoLog::Kind::AddedNodes,
+                               static_cast<uint32_t>(view.nodes_count()) - nodes_before, 0});
+        log.entries.push_back({RewriteUndoLog::Kind::AddedEdges,
+                               static_cast<uint32_t>(view.edges_count()) - edges_before, 0});
+    };
+
+    // Build replacement (appends nodes and edges)
+    std::string new_root;
+    try {
+        new_root = buildExpr(rule.replacement, diagram, bindings, rule_id);
+    } catch (...) {
+        logAdded();
+        undoRewrite(diagram, log);
+        throw;
+    }
+    logAdded();
+
+    // The replacement's nodes: a new cycle has to pass through one of them
+    std::vector<uint32_t> replacement_symbols;
+    for (uint32_t i = nodes_before; i < view.nodes_count(); ++i) {
+        result.added_nodes.push_back(view.nodes()[i].id);
+        replacement_symbols.push_back(view.node_symbol(view.nodes()[i].id));
+    }
+    replacement_symbols.push_back(view.node_symbol(new_root));
+
+    // Nodes to remove (matched but not bound to variables)
+    std::vector<uint32_t> remove_positions;
+    std::unordered_set<uint32_t> remove_symbols;
+    for (const auto& node_id : matched_nodes) {
+        if (bound_nodes.find(node_id) == bound_nodes.end()) {
+            const uint32_t position = view.node_position(node_id);
+            if (position == kNoSymbol) continue;
+            remove_positions.push_back(position);
+            remove_symbols.insert(view.node_symbol(node_id));
+        }
+    }
+
+    // Edges into a removed node are redirected to the new root; edges out of
+    // one to a surviving node are dropped
+    std::vector<uint32_t> retarget_edges;
+    std::vector<uint32_t> drop_edges;
+    for (uint32_t symbol : remove_symbols) {
+        const NeighborRange in = view.predecessors(symbol);
+        retarget_edges.insert(retarget_edges.end(), in.edges, in.edges + in.size());
+        const NeighborRange out = view.successors(symbol);
+        for (size_t i = 0; i < out.size(); ++i) {
+            if (!remove_symbols.count(out.first[i])) drop_edges.push_back(out.edges[i]);
+        }
+    }
+    std::sort(retarget_edges.begin(), retarget_edges.end());
+    std::sort(drop_edges.begin(), drop_edges.end(), std::greater<uint32_t>());
+    std::sort(remove_positions.begin(), remove_positions.end(), std::greater<uint32_t>());
+
+    for (uint32_t e : retarget_edges) {
+        log.entries.push_back({RewriteUndoLog::Kind::RetargetedEdge, e,
+                               static_cast<uint32_t>(log.targets.size())});
+        log.targets.push_back(view.edges()[e].to);
+        diagram.set_edge_target(e, new_root);
+    }
+    // Descending, so the element each take moves into the hole is never one
+    // still to be removed
+    for (uint32_t e : drop_edges) {
+        log.entries.push_back({RewriteUndoLog::Kind::RemovedEdge, e,
+                               static_cast<uint32_t>(log.edges.size())});
+        log.edges.push_back(diagram.take_edge_at(e));
+    }
+    for (uint32_t position : remove_positions) {
+        log.entries.push_back({RewriteUndoLog::Kind::RemovedNode, position,
+                               static_cast<uint32_t>(log.nodes.size())});
+        log.nodes.push_back(diagram.take_node_at(position));
+    }
+
+    if (view.reaches_any(view.node_symbol(new_root), replacement_symbols)) {
+        undoRewrite(diagram, log);
+        result.added_nodes.clear();
+        result.messages.push_back("ERROR: Rewrite " + rule_id + " would introduce cycle");
+        return result;
+    }
+
+    result.applied = true;
+    result.root_id = new_root;
+    result.messages.push_back("Rewrite " + rule_id + " applied");
+    return result;
+}
+
+/**
+ * Apply a compiled rewrite rule to a diagram in place
+ *
+ * Same rewrite as applyCompiledRewrite (same node and edge sets, same
+ * messages), but instead of copying the diagram and filtering every node
+ * and edge it splices the replacement in and touches only the matched
+ * subgraph's edges.  Removals swap-remove, so nodes() / edges() order
+ * differs from the copying rewrite; undoRewrite() restores it.
+ *
+ * The cycle check only follows what the replacement root reaches: any new
+ * cycle must run through the replacement.  This equals a full has_cycle()
+ * when the diagram was acyclic before the rewrite, which the caller must
+ * ensure (a cyclic diagram fails every copying rewrite).
+ *
+ * On failure the diagram is left unchanged, also if building the
+ * replacement throws (the exception is rethrown).
+ *
+ * @param diagram Diagram to rewrite
+ * @param rule Rule from compileRule()
+ * @param scratch Optional matcher working sets to reuse across calls
+ * @return Result with the undo log of the applied rewrite
+ */
+inline InPlaceRewriteResult applyCompiledRewriteInPlace(Diagram& diagram, const CompiledRule& rule,
+                                                        MatchScratch* scratch = nullptr) {
+    if (!rule.valid) {
+        InPlaceRewriteResult result;
+        result.messages.push_back("ERROR: " + rule.parse_error);
+        return result;
+    }
+
+    MatchScratch local_scratch;
+    auto match = findExprMatch(static_cast<const Diagram&>(diagram), rule.pattern,
+                               scratch ? *scratch : local_scratch);
+    if (!match.has_value()) {
+        InPlaceRewriteResult result;
+        result.messages.push_back("Rewrite " + rule.rule_id + " not applicable");
+        return result;
+    }
+    const auto& [root_id, bindings, matched_nodes, bound_nodes] = *match;
+    (void)root_id;
+    return applyRewriteAtMatch(diagram, rule, bindings, matched_nodes, bound_nodes);
+}
+
+/**
+ * Apply expression-based rewrite rule (parses both expressions per call;
+ * use compileRule() + applyCompiledRewrite() for rules applied repeatedly)
+ *
+ * @param diagram Diagram to rewrite
+ * @param pattern_text Pattern expression string (e.g., "P(Freedom)")
+ * @param replacement_text Replacement expression string
+ * @param rule_id Rule identifier
+ * @return RewriteResult with updated diagram
+ */
+inline RewriteResult applyExprRewrite(const Diagram& diagram,
+                                      const std::string& pattern_text,
+                                      const std::string& replacement_text,
+                                      const std::string& rule_id) {
+    return applyCompiledRewrite(diagram, compileRule(pattern_text, replacement_text, rule_id));
 }
 
 /**
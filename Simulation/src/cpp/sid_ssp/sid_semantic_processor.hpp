@@ -3,10 +3,15 @@
  *
  * Manages semantic state fields with RAII memory safety
  * Includes bug fixes from SSP_SIDS_CODE_REVIEW_BUGS.md
+ *
+ * Field loops run through FieldKernels (AVX2 when the CPU has it; see
+ * sid_field_kernels.hpp for the numerics, and set_simd(false) for the
+ * bit-exact scalar loops).
  */
 
 #pragma once
 
+#include "sid_field_kernels.hpp"
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
@@ -72,7 +77,10 @@ private:
     uint64_t field_len_;
     double capacity_;
     std::vector<double> field_;
-    SemanticMetrics metrics_;
+    // Mutable: commit_step_deferred leaves the metrics to the next metrics() call
+    mutable SemanticMetrics metrics_;
+    mutable bool metrics_pending_ = false;
+    bool simd_ = FieldKernels::avx2Available();
 
     static double clamp01(double x) {
         if (x < 0.0) return 0.0;
@@ -80,7 +88,8 @@ private:
         return x;
     }
 
-    void compute_metrics() {
+    void set_metrics(const FieldStatistics& stats) const {
+        metrics_pending_ = false;
         if (field_.empty()) {
             metrics_.stability = 0.0;
             metrics_.coherence = 0.0;
@@ -88,36 +97,30 @@ private:
             return;
         }
 
-        // Pass 1: Compute sum, variance, and divergence
-        double sum = field_[0];
-        double sum_sq = field_[0] * field_[0];
-        double div = 0.0;
-
-        for (size_t i = 1; i < field_.size(); ++i) {
-            sum += field_[i];
-            sum_sq += field_[i] * field_[i];
-            div += std::abs(field_[i] - field_[i - 1]);
-        }
-
         // Stability: semantic headroom
-        double load = (capacity_ > 0.0) ? (sum / capacity_) : 1.0;
+        double load = (capacity_ > 0.0) ? (stats.sum / capacity_) : 1.0;
         metrics_.stability = 1.0 - clamp01(load);
 
         // Coherence: 1 / (1 + variance)
-        double mean = sum / static_cast<double>(field_.size());
-        double mean_sq = sum_sq / static_cast<double>(field_.size());
+        double mean = stats.sum / static_cast<double>(field_.size());
+        double mean_sq = stats.sum_sq / static_cast<double>(field_.size());
         double var = mean_sq - mean * mean;
         if (var < 0.0) var = 0.0;  // Numerical safety
         metrics_.coherence = 1.0 / (1.0 + var);
 
         // Divergence: mean absolute neighbor difference
         if (field_.size() > 1) {
-            metrics_.divergence = div / static_cast<double>(field_.size() - 1);
+            metrics_.divergence = stats.divergence_sum / static_cast<double>(field_.size() - 1);
         } else {
             metrics_.divergence = 0.0;
         }
     }
 
+    void compute_metrics() const {
+        // One pass: sum, sum of squares and divergence
+        set_metrics(FieldKernels::statistics(simd_, field_.data(), field_.size()));
+    }
+
 public:
     SemanticProcessor(Role role, uint64_t field_len, double semantic_capacity)
         : role_(role), field_len_(field_len), capacity_(semantic_capacity), field_(field_len, 0.0) {
@@ -134,12 +137,27 @@ public:
     uint64_t step() const { return step_; }
     uint64_t field_len() const { return field_len_; }
     double capacity() const { return capacity_; }
-    const SemanticMetrics& metrics() const { return metrics_; }
+    const SemanticMetrics& metrics() const {
+        if (metrics_pending_) {
+            compute_metrics();
+        }
+        return metrics_;
+    }
+
+    // Whether field loops may use AVX2 (default: if the CPU has it)
+    bool simd() const { return simd_; }
+    void set_simd(bool enabled) { simd_ = enabled && FieldKernels::avx2Available(); }
 
     // Field access
     std::vector<double>& field() { return field_; }
     const std::vector<double>& field() const { return field_; }
 
+    // Restore the step counter of a checkpoint (metrics follow the field)
+    void restore_step(uint64_t step) {
+        step_ = step;
+        metrics_pending_ = true;
+    }
+
     /**
      * Commit current step and recompute metrics
      */
@@ -148,6 +166,41 @@ public:
         ++step_;
     }
 
+    /**
+     * Commit with statistics of the current field already measured (by
+     * transform_field or FieldKernels), skipping the metrics pass
+     */
+    void commit_step(const FieldStatistics& stats) {
+        set_metrics(stats);
+        ++step_;
+    }
+
+    /**
+     * Commit without measuring the field: metrics are computed from the
+     * field as it is at the next metrics() call.  For owners that commit
+     * every step but rarely read the metrics (SidTernaryEngine).
+     */
+    void commit_step_deferred() {
+        metrics_pending_ = true;
+        ++step_;
+    }
+
+    /**
+     * Update the field element-wise and measure it in the same pass
+     *
+     * @return Statistics of the updated field
+     */
+    FieldStatistics transform_field(FieldOp op, double param) {
+        return FieldKernels::transform(simd_, field_.data(), field_.size(), op, param);
+    }
+
+    /**
+     * Statistics of the current field (one read pass)
+     */
+    FieldStatistics field_statistics() const {
+        return FieldKernels::statistics(simd_, field_.data(), field_.size());
+    }
+
     /**
      * Apply irreversible collapse to U field (legacy single-mask API)
      *
@@ -161,16 +214,10 @@ public:
             throw std::logic_error("apply_collapse mask length mismatch");
         }
 
-        for (size_t i = 0; i < field_len_; ++i) {
-            // BUG FIX: Validate mask range
-            if (mask[i] < 0.0 || mask[i] > 1.0) {
-                throw std::logic_error("apply_collapse mask values must be in [0,1]");
-            }
-            double m = mask[i];
-            double delta = m * amount;
-            if (delta < 0.0) delta = 0.0;
-            if (delta > field_[i]) delta = field_[i];
-            field_[i] -= delta;
+        // BUG FIX: Validate mask range (cells before the bad value are
+        // already collapsed, as in the original loop)
+        if (FieldKernels::collapseMasked(simd_, field_.data(), mask.data(), field_len_, amount) != field_len_) {
+            throw std::logic_error("apply_collapse mask values must be in [0,1]");
         }
     }
 
@@ -196,16 +243,8 @@ public:
 
         if (alpha > 1.0) alpha = 1.0;
 
-        for (size_t i = 0; i < field_len_; ++i) {
-            double total_mask = mask.mask_I[i] + mask.mask_N[i];
-            if (total_mask > 1.0) total_mask = 1.0;
-            if (total_mask < 0.0) total_mask = 0.0;
-
-            double delta = alpha * total_mask * field_[i];
-            if (delta > field_[i]) delta = field_[i];
-
-            field_[i] -= delta;
-        }
+        FieldKernels::collapseDualMask(simd_, field_.data(), mask.mask_I.data(), mask.mask_N.data(),
+                                       field_len_, alpha);
     }
 
     /**
@@ -244,9 +283,7 @@ public:
             throw std::logic_error("scale_all scale must be non-negative");
         }
 
-        for (auto& val : field_) {
-            val *= scale;
-        }
+        FieldKernels::scale(simd_, field_.data(), field_.size(), scale);
     }
 
     /**
@@ -259,20 +296,14 @@ public:
 
         if (amount_per_cell <= 0.0) return;
 
-        for (auto& val : field_) {
-            val += amount_per_cell;
-        }
+        FieldKernels::addUniform(simd_, field_.data(), field_.size(), amount_per_cell);
     }
 
     /**
      * Compute total mass in field
      */
     double total_mass() const {
-        double sum = 0.0;
-        for (const auto& val : field_) {
-            sum += val;
-        }
-        return sum;
+        return FieldKernels::sum(simd_, field_.data(), field_.size());
     }
 };
 
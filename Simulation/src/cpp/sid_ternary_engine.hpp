@@ -12,12 +12,23 @@
 #include "sid_ssp/sid_diagram.hpp"
 #include "sid_ssp/sid_parser_impl.hpp"
 #include "sid_ssp/sid_diagram_builder.hpp"
+#include "sid_ssp/sid_diagram_io.hpp"
+#include "sid_ssp/sid_diagram_hash.hpp"
+#include "sid_ssp/sid_collapse_mask.hpp"
 #include "sid_ssp/sid_rewrite.hpp"
-#include "../../dase_cli/src/json.hpp"
+#include "sid_ssp/sid_fixpoint.hpp"
+#include "sid_ssp/sid_parallel_match.hpp"
+#include "sid_ssp/sid_match_network.hpp"
+#include "engine_checkpoint.h"
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <memory>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
 
 namespace sid {
 
@@ -56,13 +67,117 @@ private:
     std::unique_ptr<SemanticProcessor> ssp_N_;
     std::unique_ptr<SemanticProcessor> ssp_U_;
     std::unique_ptr<Diagram> diagram_;
+    // Whether diagram_ is known to be acyclic, so rewrites may run in place
+    // with a local cycle check (reset whenever diagram_ is replaced)
+    bool diagram_acyclic_known_ = false;
+    bool diagram_acyclic_ = false;
 
     // Evolution state
     uint64_t step_count_ = 0;
 
-    // Rewrite tracking
+    // Running field masses, updated by every operation that changes a
+    // field (fields are only written by the methods below), so the mass
+    // getters are O(1).  Re-summed from the fields every
+    // mass_resync_interval_ steps when that is non-zero.
+    CompensatedSum mass_I_;
+    CompensatedSum mass_N_;
+    CompensatedSum mass_U_;
+    uint64_t mass_resync_interval_ = 0;
+    uint64_t steps_since_resync_ = 0;
+
+    // Rewrite tracking: message parts, joined with "; " by lastRewriteMessage()
     bool last_rewrite_applied_ = false;
-    std::string last_rewrite_message_;
+    std::vector<std::string> last_rewrite_messages_;
+
+    void setRewriteMessage(std::string message) {
+        last_rewrite_messages_.clear();
+        last_rewrite_messages_.push_back(std::move(message));
+    }
+
+    void installDiagram(std::unique_ptr<Diagram> diagram) {
+        diagram_ = std::move(diagram);
+        diagram_acyclic_known_ = false;
+        diagram_hash_.invalidate();
+        collapse_mask_stale_ = true;
+        last_rewrite_messages_.clear();
+    }
+
+    // Compiled rule cache: handle = index into compiled_rules_, looked up by
+    // rule_id + hash of the pattern / replacement text
+    std::vector<CompiledRule> compiled_rules_;
+    std::unordered_map<std::string, size_t> rule_cache_;
+    std::vector<bool> rule_memoizable_;   // Per handle: ruleMemoizable()
+    MatchScratch match_scratch_;  // Reused by every rewrite match
+
+    // Canonical hash of diagram_, kept up to date across in-place rewrites
+    // (rebuilt on demand after anything else replaces the diagram), and the
+    // (hash, handle) pairs already searched without a match.  The memo
+    // outlives diagram changes: it is keyed by content, not by diagram.
+    DiagramHasher diagram_hash_;
+    RewriteMemo rewrite_memo_;
+
+    // Collapse mask of diagram_'s node labels, rebuilt by collapse() after
+    // anything changed the diagram
+    SparseCollapseMask collapse_mask_;
+    bool collapse_mask_stale_ = true;
+
+    // Shared part of runFixpoint / runParallelRewrites / runNetworkRewrites:
+    // resolve handles,
+    // refuse cyclic diagrams, run `loop`, and report
+    template <typename Loop>
+    bool runRewriteLoop(const std::vector<int64_t>& handles, FixpointResult& result_out, Loop loop) {
+        result_out = FixpointResult();
+        std::vector<const CompiledRule*> rules;
+        rules.reserve(handles.size());
+        for (int64_t handle : handles) {
+            if (handle < 0 || static_cast<size_t>(handle) >= compiled_rules_.size()) {
+                setRewriteMessage("Unknown compiled rule");
+                last_rewrite_applied_ = false;
+                return false;
+            }
+            rules.push_back(&compiled_rules_[static_cast<size_t>(handle)]);
+        }
+        if (!diagram_) {
+            setRewriteMessage("No diagram loaded");
+            last_rewrite_applied_ = false;
+            return false;
+        }
+
+        try {
+            if (!diagram_acyclic_known_) {
+                diagram_acyclic_ = !diagram_->has_cycle();
+                diagram_acyclic_known_ = true;
+            }
+            if (!diagram_acyclic_) {
+                setRewriteMessage("ERROR: Diagram has a cycle; no rewrite applies");
+                last_rewrite_applied_ = false;
+                return true;
+            }
+
+            result_out = loop(rules);
+            if (result_out.steps > 0) {
+                diagram_hash_.invalidate();
+                collapse_mask_stale_ = true;
+            }
+            setRewriteMessage("Fixpoint: " + std::to_string(result_out.steps) + " rewrites, " +
+                              (result_out.horizon_hit ? "horizon reached" : "fixed point"));
+            last_rewrite_applied_ = result_out.steps > 0;
+            return true;
+
+        } catch (const std::exception& e) {
+            // The failing rewrite was rolled back; earlier ones stand
+            setRewriteMessage(std::string("Rewrite error: ") + e.what());
+            last_rewrite_applied_ = false;
+            return false;
+        }
+    }
+
+    static std::string ruleCacheKey(const std::string& pattern,
+                                    const std::string& replacement,
+                                    const std::string& rule_id) {
+        const size_t text_hash = std::hash<std::string>{}(pattern + '\x1f' + replacement);
+        return rule_id + '\x1f' + std::to_string(text_hash);
+    }
 
     // Initialization flag
     bool initialized_ = false;
@@ -106,6 +221,9 @@ public:
 
         // Create empty diagram
         diagram_ = std::make_unique<Diagram>("sid_engine_diagram");
+        diagram_acyclic_known_ = false;
+        diagram_hash_.invalidate();
+        collapse_mask_stale_ = true;
 
         // Initialize fields with uniform distribution
         initializeUniformFields();
@@ -136,9 +254,10 @@ public:
         }
 
         // Commit initial state
-        ssp_I_->commit_step();
-        ssp_N_->commit_step();
-        ssp_U_->commit_step();
+        ssp_I_->commit_step_deferred();
+        ssp_N_->commit_step_deferred();
+        ssp_U_->commit_step_deferred();
+        resyncMasses();
     }
 
     /**
@@ -149,21 +268,33 @@ public:
     void step(double alpha = 1.0) {
         if (!initialized_) return;
 
-        // Run mixer step (evolves I/N/U fields)
-        mixer_->step(*ssp_I_, *ssp_N_, *ssp_U_);
+        // Run mixer step (evolves I/N/U fields) from the running masses:
+        // only a conservation correction touches a field (U)
+        bool corrected = false;
+        const double U = mixer_->step_with_masses(mass_I_.value(), mass_N_.value(), mass_U_.value(),
+                                                  *ssp_U_, &corrected);
+        if (corrected) {
+            mass_U_.reset(U);
+        }
 
-        // Commit field updates
-        ssp_I_->commit_step();
-        ssp_N_->commit_step();
-        ssp_U_->commit_step();
+        // Commit field updates (metrics computed when read)
+        ssp_I_->commit_step_deferred();
+        ssp_N_->commit_step_deferred();
+        ssp_U_->commit_step_deferred();
 
         step_count_++;
+        if (mass_resync_interval_ > 0 && ++steps_since_resync_ >= mass_resync_interval_) {
+            resyncMasses();
+        }
     }
 
     /**
      * Force collapse operation
      *
-     * Moves mass from U to I/N based on collapse masks.
+     * With collapse labels on the diagram (see sid_collapse_mask.hpp, and
+     * labelCollapseNode), moves α·M_I·U to I and α·M_N·U to N at the
+     * labelled cells only; without any, moves α/2·U to each of I and N
+     * over the whole field.
      *
      * @param alpha Collapse strength parameter (0.0 to 1.0)
      */
@@ -173,41 +304,75 @@ public:
         // Clamp alpha to valid range
         alpha = std::max(0.0, std::min(1.0, alpha));
 
-        auto& field_I = ssp_I_->field();
-        auto& field_N = ssp_N_->field();
-        auto& field_U = ssp_U_->field();
-
-        // Simple collapse: move fraction of U to I (admissible)
-        // In full implementation, this would use collapse masks from diagram
-        for (size_t i = 0; i < num_nodes_; ++i) {
-            double u_transfer = field_U[i] * alpha * 0.5; // Half to I
-            double n_transfer = field_U[i] * alpha * 0.5; // Half to N
-
-            field_U[i] -= (u_transfer + n_transfer);
-            field_I[i] += u_transfer;
-            field_N[i] += n_transfer;
+        const SparseCollapseMask& mask = collapseMask();
+        if (mask.labelled()) {
+            CompensatedSum moved_I;
+            CompensatedSum moved_N;
+            mask.apply(ssp_U_->simd(), ssp_I_->field().data(), ssp_N_->field().data(),
+                       ssp_U_->field().data(), alpha, moved_I, moved_N);
+            mass_I_.add(moved_I.value());
+            mass_N_.add(moved_N.value());
+            mass_U_.add(-(moved_I.value() + moved_N.value()));
+        } else {
+            // Unlabelled diagram: move a fraction of U to I and N, half each
+            CompensatedSum moved;
+            FieldKernels::collapseTransfer(ssp_U_->simd(), ssp_I_->field().data(), ssp_N_->field().data(),
+                                           ssp_U_->field().data(), num_nodes_, alpha, moved);
+            mass_I_.add(moved.value());
+            mass_N_.add(moved.value());
+            mass_U_.add(-2.0 * moved.value());
         }
 
-        // Commit changes
-        ssp_I_->commit_step();
-        ssp_N_->commit_step();
-        ssp_U_->commit_step();
+        // Commit changes (metrics computed when read)
+        ssp_I_->commit_step_deferred();
+        ssp_N_->commit_step_deferred();
+        ssp_U_->commit_step_deferred();
 
         step_count_++;
     }
 
+    /**
+     * Collapse mask built from the diagram's node labels (rebuilt, O(diagram),
+     * only after the diagram changed)
+     */
+    const SparseCollapseMask& collapseMask() {
+        if (collapse_mask_stale_) {
+            collapse_mask_ = diagram_ ? SparseCollapseMask::fromDiagram(*diagram_, num_nodes_)
+                                      : SparseCollapseMask();
+            collapse_mask_stale_ = false;
+        }
+        return collapse_mask_;
+    }
+
+    /**
+     * Label a diagram node for collapse: `state` I / N routes `weight` of
+     * field cell `cell`'s U to I / N at each collapse(), U marks it
+     * undecided.  The label lives on the node, so a rewrite that removes
+     * the node removes it.
+     *
+     * @return false if the node does not exist, cell >= node count or
+     *         weight is outside [0,1]
+     */
+    bool labelCollapseNode(const std::string& node_id, Ternary state, uint64_t cell, double weight = 1.0) {
+        Node* node = diagram_ ? diagram_->find_node(node_id) : nullptr;
+        if (!node || cell >= num_nodes_ || cell > static_cast<uint64_t>(std::numeric_limits<int>::max()) ||
+            !(weight >= 0.0 && weight <= 1.0)) {
+            return false;
+        }
+        node->attributes[attr_keys::kCollapseState] = state;
+        node->attributes[attr_keys::kCollapseCell] = static_cast<int>(cell);
+        node->attributes[attr_keys::kCollapseWeight] = weight;
+        collapse_mask_stale_ = true;
+        return true;
+    }
+
     /**
      * Get total mass in I field (admissible states)
      */
     double getIMass() const {
         if (!initialized_) return 0.0;
 
-        double sum = 0.0;
-        const auto& field = ssp_I_->field();
-        for (size_t i = 0; i < num_nodes_; ++i) {
-            sum += field[i];
-        }
-        return sum;
+        return mass_I_.value();
     }
 
     /**
@@ -216,12 +381,7 @@ public:
     double getNMass() const {
         if (!initialized_) return 0.0;
 
-        double sum = 0.0;
-        const auto& field = ssp_N_->field();
-        for (size_t i = 0; i < num_nodes_; ++i) {
-            sum += field[i];
-        }
-        return sum;
+        return mass_N_.value();
     }
 
     /**
@@ -230,12 +390,38 @@ public:
     double getUMass() const {
         if (!initialized_) return 0.0;
 
-        double sum = 0.0;
-        const auto& field = ssp_U_->field();
-        for (size_t i = 0; i < num_nodes_; ++i) {
-            sum += field[i];
-        }
-        return sum;
+        return mass_U_.value();
+    }
+
+    /**
+     * Re-sum the three fields and reset the running masses from them
+     *
+     * @return Largest |running - re-summed| mass before the reset
+     */
+    double resyncMasses() {
+        const double I = FieldKernels::compensatedSum(ssp_I_->simd(), ssp_I_->field().data(), num_nodes_);
+        const double N = FieldKernels::compensatedSum(ssp_N_->simd(), ssp_N_->field().data(), num_nodes_);
+        const double U = FieldKernels::compensatedSum(ssp_U_->simd(), ssp_U_->field().data(), num_nodes_);
+        const double drift = std::max({std::abs(mass_I_.value() - I),
+                                       std::abs(mass_N_.value() - N),
+                                       std::abs(mass_U_.value() - U)});
+        mass_I_.reset(I);
+        mass_N_.reset(N);
+        mass_U_.reset(U);
+        steps_since_resync_ = 0;
+        return drift;
+    }
+
+    /**
+     * Re-sum the fields every `steps` steps (0, the default, never does)
+     */
+    void setMassResyncInterval(uint64_t steps) {
+        mass_resync_interval_ = steps;
+        steps_since_resync_ = 0;
+    }
+
+    uint64_t massResyncInterval() const {
+        return mass_resync_interval_;
     }
 
     /**
@@ -295,63 +481,20 @@ public:
     }
 
     /**
-     * Set diagram from JSON string
+     * Set diagram from JSON string (streaming parse, sid_diagram_io.hpp)
      *
      * @param json_str JSON diagram representation
      * @return true if successful
      */
     bool setDiagramJson(const std::string& json_str) {
-        try {
-            auto data = nlohmann::json::parse(json_str);
-            if (!data.is_object()) {
-                last_rewrite_message_ = "Diagram JSON must be an object";
-                return false;
-            }
-
-            auto new_diagram = std::make_unique<Diagram>(data.value("id", "sid_engine_diagram"));
-
-            if (data.contains("nodes") && data["nodes"].is_array()) {
-                for (const auto& n : data["nodes"]) {
-                    Node node;
-                    node.id = n.value("id", "");
-                    node.op = n.value("op", "");
-                    if (n.contains("inputs") && n["inputs"].is_array()) {
-                        for (const auto& inp : n["inputs"]) {
-                            if (inp.is_string()) node.inputs.push_back(inp.get<std::string>());
-                        }
-                    }
-                    if (n.contains("dof_refs") && n["dof_refs"].is_array()) {
-                        for (const auto& d : n["dof_refs"]) {
-                            if (d.is_string()) node.dof_refs.push_back(d.get<std::string>());
-                        }
-                    }
-                    if (!node.id.empty()) {
-                        new_diagram->add_node(node);
-                    }
-                }
-            }
-
-            if (data.contains("edges") && data["edges"].is_array()) {
-                for (const auto& e : data["edges"]) {
-                    Edge edge;
-                    edge.id = e.value("id", "");
-                    edge.from = e.value("from", "");
-                    edge.to = e.value("to", "");
-                    edge.label = e.value("label", "arg");
-                    edge.port = e.value("port", 0);
-                    if (!edge.id.empty()) {
-                        new_diagram->add_edge(edge);
-                    }
-                }
-            }
-
-            diagram_ = std::move(new_diagram);
-            last_rewrite_message_.clear();
-            return true;
-        } catch (const std::exception& e) {
-            last_rewrite_message_ = std::string("Diagram parse error: ") + e.what();
+        auto diagram = std::make_unique<Diagram>();
+        std::string error;
+        if (!readDiagramJson(json_str, *diagram, error)) {
+            setRewriteMessage("Diagram parse error: " + error);
             return false;
         }
+        installDiagram(std::move(diagram));
+        return true;
     }
 
     /**
@@ -360,31 +503,141 @@ public:
      * @return JSON representation of current diagram
      */
     std::string getDiagramJson() const {
-        nlohmann::json data;
-        data["id"] = diagram_->id();
-        data["nodes"] = nlohmann::json::array();
-        data["edges"] = nlohmann::json::array();
-
-        for (const auto& node : diagram_->nodes()) {
-            nlohmann::json n;
-            n["id"] = node.id;
-            n["op"] = node.op;
-            n["inputs"] = node.inputs;
-            n["dof_refs"] = node.dof_refs;
-            data["nodes"].push_back(n);
+        std::string json;
+        writeDiagramJson(*diagram_, json);
+        return json;
+    }
+
+    /**
+     * Set diagram from its binary form (sid_diagram_io.hpp)
+     *
+     * @return true if successful
+     */
+    bool setDiagramBinary(const void* data, size_t size) {
+        auto diagram = std::make_unique<Diagram>();
+        std::string error;
+        if (!readDiagramBinary(data, size, *diagram, error)) {
+            setRewriteMessage("Diagram decode error: " + error);
+            return false;
         }
+        installDiagram(std::move(diagram));
+        return true;
+    }
 
-        for (const auto& edge : diagram_->edges()) {
-            nlohmann::json e;
-            e["id"] = edge.id;
-            e["from"] = edge.from;
-            e["to"] = edge.to;
-            e["label"] = edge.label;
-            e["port"] = edge.port;
-            data["edges"].push_back(e);
+    /**
+     * Get diagram in its binary form
+     */
+    std::string getDiagramBinary() const {
+        std::string bytes;
+        writeDiagramBinary(*diagram_, bytes);
+        return bytes;
+    }
+
+    /**
+     * Add the engine's state to a checkpoint (engine_checkpoint.h): the
+     * I/N/U fields, running masses, mixer observation state, counters and
+     * the serialized diagram.  Compiled rules are a cache of the caller's
+     * rule text and are not saved.  The engine must not change until
+     * writer.write() returns.
+     *
+     *   sid.field_I / _N / _U   f64 [num_nodes]
+     *   sid.masses              f64 [I, I comp, N, N comp, U, U comp, total_mass]
+     *   sid.counters            u64 [num_nodes, steps, resync interval,
+     *                                steps since resync, I/N/U processor steps]
+     *   sid.mixer               Mixer::State record
+     *   sid.diagram_bin         binary diagram (sid_diagram_io.hpp); images
+     *                           written before it carry sid.diagram JSON text
+     *   sid.collapse_labels     text, one "state cell weight node_id" line per
+     *                           labelled node (the diagram forms drop
+     *                           attributes); absent when no node is labelled
+     */
+    void saveCheckpoint(dase::CheckpointWriter& writer) const {
+        writer.addF64("sid.field_I", ssp_I_->field().data(), num_nodes_);
+        writer.addF64("sid.field_N", ssp_N_->field().data(), num_nodes_);
+        writer.addF64("sid.field_U", ssp_U_->field().data(), num_nodes_);
+        writer.addValues("sid.masses", {mass_I_.sum, mass_I_.compensation,
+                                        mass_N_.sum, mass_N_.compensation,
+                                        mass_U_.sum, mass_U_.compensation, total_mass_});
+        writer.addValues("sid.counters", {static_cast<uint64_t>(num_nodes_), step_count_,
+                                          mass_resync_interval_, steps_since_resync_,
+                                          ssp_I_->step(), ssp_N_->step(), ssp_U_->step()});
+        writer.addRecord("sid.mixer", mixer_->state());
+        writer.addBytes("sid.diagram_bin", getDiagramBinary());
+
+        std::ostringstream labels;
+        labels.precision(17);
+        for (const Node& node : diagram_->nodes()) {
+            Ternary state;
+            uint32_t cell;
+            double weight;
+            if (SparseCollapseMask::readLabel(node, num_nodes_, state, cell, weight)) {
+                labels << ternary_to_string(state) << ' ' << cell << ' ' << weight << ' ' << node.id << '\n';
+            }
+        }
+        if (labels.tellp() > 0) {
+            writer.addText("sid.collapse_labels", labels.str());
+        }
+    }
+
+    /**
+     * Restore a checkpoint of an engine with the same node count
+     * @throws std::runtime_error if the image does not fit this engine
+     */
+    void restoreCheckpoint(const dase::CheckpointImage& image) {
+        uint64_t counters[7] = {};
+        double masses[7] = {};
+        image.readU64("sid.counters", counters, 7);
+        if (counters[0] != num_nodes_) {
+            throw std::runtime_error("Checkpoint has " + std::to_string(counters[0]) +
+                                     " nodes, engine has " + std::to_string(num_nodes_));
+        }
+        image.readF64("sid.masses", masses, 7);
+        const Mixer::State mixer_state = image.readRecord<Mixer::State>("sid.mixer");
+        auto diagram = std::make_unique<Diagram>();
+        std::string error;
+        bool decoded = false;
+        if (image.has("sid.diagram_bin")) {
+            size_t length = 0;
+            const char* bytes = image.bytes("sid.diagram_bin", length);
+            decoded = readDiagramBinary(bytes, length, *diagram, error);
+        } else {
+            decoded = readDiagramJson(image.text("sid.diagram"), *diagram, error);
+        }
+        if (!decoded) {
+            throw std::runtime_error("Checkpoint diagram: " + error);
+        }
+        image.readF64("sid.field_I", ssp_I_->field().data(), num_nodes_);
+        image.readF64("sid.field_N", ssp_N_->field().data(), num_nodes_);
+        image.readF64("sid.field_U", ssp_U_->field().data(), num_nodes_);
+        installDiagram(std::move(diagram));
+        if (image.has("sid.collapse_labels")) {
+            std::istringstream labels(image.text("sid.collapse_labels"));
+            std::string state;
+            uint64_t cell = 0;
+            double weight = 1.0;
+            while (labels >> state >> cell >> weight) {
+                std::string node_id;
+                labels.get();   // The separating space
+                std::getline(labels, node_id);
+                labelCollapseNode(node_id, state == "I" ? Ternary::I : (state == "N" ? Ternary::N : Ternary::U),
+                                  cell, weight);
+            }
         }
 
-        return data.dump();
+        mass_I_.sum = masses[0];
+        mass_I_.compensation = masses[1];
+        mass_N_.sum = masses[2];
+        mass_N_.compensation = masses[3];
+        mass_U_.sum = masses[4];
+        mass_U_.compensation = masses[5];
+        total_mass_ = masses[6];
+        step_count_ = counters[1];
+        mass_resync_interval_ = counters[2];
+        steps_since_resync_ = counters[3];
+        ssp_I_->restore_step(counters[4]);
+        ssp_N_->restore_step(counters[5]);
+        ssp_U_->restore_step(counters[6]);
+        mixer_->restore_state(mixer_state);
     }
 
     /**
@@ -398,40 +651,176 @@ public:
     bool applyRewrite(const std::string& pattern,
                       const std::string& replacement,
                       const std::string& rule_id) {
-        if (!diagram_) {
-            last_rewrite_message_ = "No diagram loaded";
+        const int64_t handle = compileRule(pattern, replacement, rule_id);
+        if (handle < 0) {
             last_rewrite_applied_ = false;
             return false;
         }
+        return applyCompiledRule(handle);
+    }
+
+    /**
+     * Parse a rewrite rule once and cache it
+     *
+     * The same rule_id, pattern and replacement always return the same
+     * handle.  A rule that does not parse still gets a handle; applying it
+     * reports the parse error.
+     *
+     * @return Handle for applyCompiledRule, or -1 on an internal error
+     *         (message in lastRewriteMessage)
+     */
+    int64_t compileRule(const std::string& pattern,
+                        const std::string& replacement,
+                        const std::string& rule_id) {
+        const std::string key = ruleCacheKey(pattern, replacement, rule_id);
+        auto it = rule_cache_.find(key);
+        if (it != rule_cache_.end()) {
+            const CompiledRule& cached = compiled_rules_[it->second];
+            if (cached.pattern_text == pattern && cached.replacement_text == replacement) {
+                return static_cast<int64_t>(it->second);
+            }
+        }
 
         try {
-            // Apply expression-based rewrite
-            RewriteResult result = applyExprRewrite(*diagram_, pattern, replacement, rule_id);
+            compiled_rules_.push_back(sid::compileRule(pattern, replacement, rule_id));
+            rule_memoizable_.push_back(ruleMemoizable(compiled_rules_.back()));
+        } catch (const std::exception& e) {
+            setRewriteMessage(std::string("Rewrite error: ") + e.what());
+            return -1;
+        }
+        const size_t handle = compiled_rules_.size() - 1;
+        if (it == rule_cache_.end()) {
+            rule_cache_.emplace(key, handle);  // (A hash collision stays uncached)
+        }
+        return static_cast<int64_t>(handle);
+    }
+
+    /**
+     * Apply a rule from compileRule() to the diagram
+     *
+     * @return true if rewrite was applied
+     */
+    bool applyCompiledRule(int64_t handle) {
+        if (handle < 0 || static_cast<size_t>(handle) >= compiled_rules_.size()) {
+            setRewriteMessage("Unknown compiled rule");
+            last_rewrite_applied_ = false;
+            return false;
+        }
+        if (!diagram_) {
+            setRewriteMessage("No diagram loaded");
+            last_rewrite_applied_ = false;
+            return false;
+        }
 
-            // Update diagram if rewrite was applied
-            if (result.applied) {
-                diagram_ = std::make_unique<Diagram>(result.diagram);
+        try {
+            const CompiledRule& rule = compiled_rules_[static_cast<size_t>(handle)];
+            const bool memoizable = rule_memoizable_[static_cast<size_t>(handle)];
+            const uint64_t rule_key = static_cast<uint64_t>(handle);
+            if (memoizable && rewrite_memo_.knownNoMatch(diagramHash(), rule_key)) {
+                setRewriteMessage("Rewrite " + rule.rule_id + " not applicable");
+                last_rewrite_applied_ = false;
+                return false;
+            }
+            if (!diagram_acyclic_known_) {
+                diagram_acyclic_ = !diagram_->has_cycle();
+                diagram_acyclic_known_ = true;
             }
 
-            // Collect messages
-            last_rewrite_message_ = "";
-            for (const auto& msg : result.messages) {
-                if (!last_rewrite_message_.empty()) {
-                    last_rewrite_message_ += "; ";
+            // Acyclic diagrams are rewritten in place (and stay acyclic); a
+            // cyclic one takes the copying path, which reports the cycle
+            bool applied = false;
+            std::vector<std::string> messages;
+            if (diagram_acyclic_) {
+                InPlaceRewriteResult result = applyCompiledRewriteInPlace(*diagram_, rule, &match_scratch_);
+                applied = result.applied;
+                messages = std::move(result.messages);
+                // Replacement nodes carry no attributes: only a removed
+                // label can change the collapse mask
+                for (const Node& removed : result.undo.nodes) {
+                    if (removed.attributes.count(attr_keys::kCollapseState)) {
+                        collapse_mask_stale_ = true;
+                    }
+                }
+                if (applied && diagram_hash_.valid()) {
+                    // Rewrites add and remove nodes but never change survivors
+                    std::vector<std::string>& changed = result.added_nodes;
+                    for (const Node& removed : result.undo.nodes) {
+                        changed.push_back(removed.id);
+                    }
+                    diagram_hash_.update(*diagram_, changed);
+                } else if (!result.matched && memoizable) {
+                    rewrite_memo_.recordNoMatch(diagramHash(), rule_key);
                 }
-                last_rewrite_message_ += msg;
+            } else {
+                RewriteResult result = applyCompiledRewrite(*diagram_, rule, &match_scratch_);
+                if (result.applied) {
+                    *diagram_ = std::move(result.diagram);
+                    diagram_acyclic_known_ = false;
+                    diagram_hash_.invalidate();
+                    collapse_mask_stale_ = true;
+                }
+                applied = result.applied;
+                messages = std::move(result.messages);
             }
 
-            last_rewrite_applied_ = result.applied;
-            return result.applied;
+            // Joined only when lastRewriteMessage() is queried
+            last_rewrite_messages_ = std::move(messages);
+
+            last_rewrite_applied_ = applied;
+            return applied;
 
         } catch (const std::exception& e) {
-            last_rewrite_message_ = std::string("Rewrite error: ") + e.what();
+            setRewriteMessage(std::string("Rewrite error: ") + e.what());
             last_rewrite_applied_ = false;
             return false;
         }
     }
 
+    /**
+     * Rewrite with compiled rules until none applies (worklist fixpoint,
+     * see sid_fixpoint.hpp) or options.horizon_cap rewrites have run
+     *
+     * A cyclic diagram takes no rewrites, as every copying rewrite of it
+     * would be rejected.
+     *
+     * @param handles Rules from compileRule(); result trace indexes this list
+     * @return false on an unknown handle or missing diagram (nothing applied)
+     */
+    bool runFixpoint(const std::vector<int64_t>& handles,
+                     const FixpointOptions& options,
+                     FixpointResult& result_out) {
+        return runRewriteLoop(handles, result_out, [&](const std::vector<const CompiledRule*>& rules) {
+            return runRewriteFixpoint(*diagram_, rules, options, &match_scratch_);
+        });
+    }
+
+    /**
+     * As runFixpoint, with every rule's match searched concurrently each
+     * round (see sid_parallel_match.hpp); batch applies a maximal set of
+     * non-overlapping matches per round instead of the best one
+     */
+    bool runParallelRewrites(const std::vector<int64_t>& handles,
+                             const FixpointOptions& options,
+                             bool batch,
+                             FixpointResult& result_out) {
+        return runRewriteLoop(handles, result_out, [&](const std::vector<const CompiledRule*>& rules) {
+            return sid::runParallelRewrites(*diagram_, rules, options, batch);
+        });
+    }
+
+    /**
+     * As runParallelRewrites without batch, with each round's match taken
+     * from an incrementally maintained match network (see
+     * sid_match_network.hpp) instead of a search
+     */
+    bool runNetworkRewrites(const std::vector<int64_t>& handles,
+                            const FixpointOptions& options,
+                            FixpointResult& result_out) {
+        return runRewriteLoop(handles, result_out, [&](const std::vector<const CompiledRule*>& rules) {
+            return sid::runNetworkRewrites(*diagram_, rules, options);
+        });
+    }
+
     /**
      * Set diagram from expression string
      *
@@ -448,18 +837,21 @@ public:
             Diagram new_diagram = exprToDiagram(ast, rule_id);
 
             // Replace current diagram
-            diagram_ = std::make_unique<Diagram>(new_diagram);
+            diagram_ = std::make_unique<Diagram>(std::move(new_diagram));
+            diagram_acyclic_known_ = false;
+            diagram_hash_.invalidate();
+            collapse_mask_stale_ = true;
 
-            last_rewrite_message_ = "Diagram set from expression: " + expr;
+            setRewriteMessage("Diagram set from expression: " + expr);
             last_rewrite_applied_ = true;
             return true;
 
         } catch (const ParseError& e) {
-            last_rewrite_message_ = std::string("Parse error: ") + e.what();
+            setRewriteMessage(std::string("Parse error: ") + e.what());
             last_rewrite_applied_ = false;
             return false;
         } catch (const std::exception& e) {
-            last_rewrite_message_ = std::string("Error: ") + e.what();
+            setRewriteMessage(std::string("Error: ") + e.what());
             last_rewrite_applied_ = false;
             return false;
         }
@@ -472,11 +864,50 @@ public:
         return last_rewrite_applied_;
     }
 
+    size_t compiledRuleCount() const {
+        return compiled_rules_.size();
+    }
+
+    // Drop all compiled rules (invalidates their handles)
+    void clearRuleCache() {
+        compiled_rules_.clear();
+        rule_cache_.clear();
+        rule_memoizable_.clear();
+        rewrite_memo_.clear();
+    }
+
+    /**
+     * Canonical structural hash of the diagram (see sid_diagram_hash.hpp):
+     * equal for diagrams that differ only in node / edge IDs and order.
+     * In-place rewrites update it locally; anything else that replaces the
+     * diagram has it rebuilt on the next call.  0 without a diagram.
+     */
+    uint64_t diagramHash() {
+        if (!diagram_) {
+            return 0;
+        }
+        if (!diagram_hash_.valid()) {
+            diagram_hash_.reset(*diagram_);
+        }
+        return diagram_hash_.hash();
+    }
+
+    const RewriteMemo& rewriteMemo() const {
+        return rewrite_memo_;
+    }
+
     /**
      * Get last rewrite message
      */
     std::string lastRewriteMessage() const {
-        return last_rewrite_message_;
+        std::string joined;
+        for (const auto& msg : last_rewrite_messages_) {
+            if (!joined.empty()) {
+                joined += "; ";
+            }
+            joined += msg;
+        }
+        return joined;
     }
 
     /**
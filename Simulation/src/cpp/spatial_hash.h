@@ -5,6 +5,13 @@
  * Instead of checking all N nodes, only check nodes in nearby cells
  *
  * Expected speedup: 5-20x for neighbor search
+ *
+ * SpatialGrid1D/2D/3D are the flat variants for points on a bounded grid
+ * (lattice sites, particles inside the box): a counting sort packs the
+ * point ids by cell into one array with per-cell start offsets, and
+ * forEachInRange() visits the candidates without allocating.  They visit
+ * the same candidates in the same order as the hash query (cells outside
+ * the grid are empty, ids ascend within a cell).
  */
 
 #pragma once
@@ -13,6 +20,9 @@
 #include <unordered_map>
 #include <cmath>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 
 namespace dase {
 namespace igsoa {
@@ -195,5 +205,142 @@ public:
     int getCellSize() const { return cell_size_; }
 };
 
+/**
+ * Flat uniform grid over [0, N) per axis (see file header)
+ *
+ * cell_start_[c] .. cell_start_[c + 1] index the ids of cell c in
+ * point_ids_; cells are x-fastest.
+ */
+template <int Dim>
+class SpatialGrid {
+    static_assert(Dim >= 1 && Dim <= 3, "SpatialGrid is 1D, 2D or 3D");
+
+public:
+    SpatialGrid(size_t N_x, double R_c) : SpatialGrid(N_x, 1, 1, R_c, 0) {
+        static_assert(Dim == 1, "1D extent");
+    }
+
+    SpatialGrid(size_t N_x, size_t N_y, double R_c) : SpatialGrid(N_x, N_y, 1, R_c, 0) {
+        static_assert(Dim == 2, "2D extent");
+    }
+
+    SpatialGrid(size_t N_x, size_t N_y, size_t N_z, double R_c) : SpatialGrid(N_x, N_y, N_z, R_c, 0) {
+        static_assert(Dim == 3, "3D extent");
+    }
+
+    /**
+     * Bin every lattice site (id = row-major index)
+     */
+    void buildLattice() {
+        const size_t count = extent_[0] * extent_[1] * extent_[2];
+        build(count, [&](size_t id, int (&coord)[3]) {
+            coord[0] = static_cast<int>(id % extent_[0]);
+            coord[1] = static_cast<int>((id / extent_[0]) % extent_[1]);
+            coord[2] = static_cast<int>(id / (extent_[0] * extent_[1]));
+        });
+    }
+
+    /**
+     * Bin count points; coords(id, int (&coord)[3]) writes point id's grid
+     * coordinates (each in [0, N) of its axis; unused axes 0)
+     */
+    template <typename Coords>
+    void build(size_t count, Coords&& coords) {
+        const size_t num_cells = cells_[0] * cells_[1] * cells_[2];
+        cell_start_.assign(num_cells + 1, 0);
+        point_cell_.resize(count);
+        point_ids_.resize(count);
+
+        // Counting sort: cell sizes, exclusive scan, stable scatter
+        for (size_t id = 0; id < count; ++id) {
+            int coord[3] = {0, 0, 0};
+            coords(id, coord);
+            const size_t cell = cellIndex(coord[0] / cell_size_, coord[1] / cell_size_, coord[2] / cell_size_);
+            point_cell_[id] = cell;
+            cell_start_[cell + 1]++;
+        }
+        for (size_t c = 0; c < num_cells; ++c) {
+            cell_start_[c + 1] += cell_start_[c];
+        }
+        cursor_.assign(cell_start_.begin(), cell_start_.end() - 1);
+        for (size_t id = 0; id < count; ++id) {
+            point_ids_[cursor_[point_cell_[id]]++] = static_cast<int>(id);
+        }
+    }
+
+    /**
+     * Call fn(id) for every point in the cells within range of (x, y, z)
+     * (z outer, x inner; cells outside the grid are skipped)
+     */
+    template <typename Fn>
+    void forEachInRange(int x, int y, int z, int range, Fn&& fn) const {
+        const int cell[3] = {x / cell_size_, y / cell_size_, z / cell_size_};
+        const int cell_range = (range + cell_size_ - 1) / cell_size_;
+        int lo[3];
+        int hi[3];
+        for (int a = 0; a < 3; ++a) {
+            const int reach = a < Dim ? cell_range : 0;
+            lo[a] = std::max(cell[a] - reach, 0);
+            hi[a] = std::min(cell[a] + reach, static_cast<int>(cells_[a]) - 1);
+        }
+        for (int cz = lo[2]; cz <= hi[2]; ++cz) {
+            for (int cy = lo[1]; cy <= hi[1]; ++cy) {
+                for (int cx = lo[0]; cx <= hi[0]; ++cx) {
+                    const size_t c = cellIndex(cx, cy, cz);
+                    for (size_t k = cell_start_[c]; k < cell_start_[c + 1]; ++k) {
+                        fn(point_ids_[k]);
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Fn>
+    void forEachInRange(int x, int y, int range, Fn&& fn) const {
+        forEachInRange(x, y, 0, range, std::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+    void forEachInRange(int x, int range, Fn&& fn) const {
+        forEachInRange(x, 0, 0, range, std::forward<Fn>(fn));
+    }
+
+    size_t getMemoryUsage() const {
+        return cell_start_.capacity() * sizeof(size_t) +
+               cursor_.capacity() * sizeof(size_t) +
+               point_cell_.capacity() * sizeof(size_t) +
+               point_ids_.capacity() * sizeof(int);
+    }
+
+    int getCellSize() const { return cell_size_; }
+
+private:
+    SpatialGrid(size_t N_x, size_t N_y, size_t N_z, double R_c, int)
+        : cell_size_(std::max(1, static_cast<int>(R_c)))
+        , extent_{N_x, N_y, N_z}
+    {
+        for (int a = 0; a < 3; ++a) {
+            cells_[a] = std::max<size_t>((extent_[a] + cell_size_ - 1) / cell_size_, 1);
+        }
+    }
+
+    size_t cellIndex(int cx, int cy, int cz) const {
+        return (static_cast<size_t>(cz) * cells_[1] + static_cast<size_t>(cy)) * cells_[0] +
+               static_cast<size_t>(cx);
+    }
+
+    int cell_size_;
+    size_t extent_[3];
+    size_t cells_[3];
+    std::vector<size_t> cell_start_;  // num_cells + 1
+    std::vector<size_t> cursor_;      // Scatter positions (build scratch)
+    std::vector<size_t> point_cell_;  // Cell of each point (build scratch)
+    std::vector<int> point_ids_;      // Ids sorted by cell
+};
+
+using SpatialGrid1D = SpatialGrid<1>;
+using SpatialGrid2D = SpatialGrid<2>;
+using SpatialGrid3D = SpatialGrid<3>;
+
 } // namespace igsoa
 } // namespace dase
@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * Lock-free single-producer / single-consumer ring buffer
+ *
+ * Fixed capacity, allocated once at construction; write() and read() never
+ * allocate, lock or block.  One thread may write and one other thread may
+ * read concurrently.  Positions are monotonic 64-bit element counts: the
+ * producer publishes its count with a release store after filling the
+ * slots, the consumer acquires it before reading them (and the reverse for
+ * freeing slots).  Each side caches the other's last seen count so a call
+ * touches the shared line only when the cache says it may be blocked.
+ *
+ * The capacity is exact (not rounded to a power of two); a call wraps at
+ * most once, so each transfer is at most two contiguous copies.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dase {
+
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity) : slots_(capacity) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const noexcept { return slots_.size(); }
+
+    // Storage, for locking it in memory
+    const T* data() const noexcept { return slots_.data(); }
+    size_t bytes() const noexcept { return slots_.size() * sizeof(T); }
+
+    // Producer side: free slots, and elements written since construction
+    size_t writeAvailable() noexcept { return freeSlots(slots_.size()); }
+    uint64_t written() const noexcept { return tail_.load(std::memory_order_relaxed); }
+
+    // Consumer side: elements ready to read
+    size_t readAvailable() noexcept { return readySlots(slots_.size()); }
+
+    /**
+     * Producer: fill(slot, offset, n) copies elements [offset, offset + n)
+     * of the caller's data into slot[0..n), once or twice; then they are
+     * published.  Writes min(count, writeAvailable()) elements.
+     * @return elements written
+     */
+    template <typename Fill>
+    size_t write(size_t count, Fill&& fill) noexcept {
+        const size_t n = std::min(count, freeSlots(count));
+        if (n == 0) {
+            return 0;
+        }
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t start = static_cast<size_t>(tail % slots_.size());
+        const size_t first = std::min(n, slots_.size() - start);
+        fill(slots_.data() + start, size_t(0), first);
+        if (first < n) {
+            fill(slots_.data(), first, n - first);
+        }
+        tail_.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    size_t write(const T* data, size_t count) noexcept {
+        return write(count, [data](T* slot, size_t offset, size_t n) {
+            std::copy_n(data + offset, n, slot);
+        });
+    }
+
+    /**
+     * Consumer: take(slot, offset, n) reads slot[0..n) as elements
+     * [offset, offset + n) of the transfer, once or twice; then the slots
+     * are freed.  Reads min(count, readAvailable()) elements.
+     * @return elements read
+     */
+    template <typename Take>
+    size_t read(size_t count, Take&& take) noexcept {
+        const size_t n = std::min(count, readySlots(count));
+        if (n == 0) {
+            return 0;
+        }
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        const size_t start = static_cast<size_t>(head % slots_.size());
+        const size_t first = std::min(n, slots_.size() - start);
+        take(static_cast<const T*>(slots_.data() + start), size_t(0), first);
+        if (first < n) {
+            take(static_cast<const T*>(slots_.data()), first, n - first);
+        }
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    size_t read(T* out, size_t count) noexcept {
+        return read(count, [out](const T* slot, size_t offset, size_t n) {
+            std::copy_n(slot, n, out + offset);
+        });
+    }
+
+private:
+    // Free / ready slots, from the cached position unless it shows fewer
+    // than `wanted`
+    size_t freeSlots(size_t wanted) noexcept {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        size_t free = slots_.size() - static_cast<size_t>(tail - cached_head_);
+        if (free < wanted) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free = slots_.size() - static_cast<size_t>(tail - cached_head_);
+        }
+        return free;
+    }
+
+    size_t readySlots(size_t wanted) noexcept {
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        size_t ready = static_cast<size_t>(cached_tail_ - head);
+        if (ready < wanted) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            ready = static_cast<size_t>(cached_tail_ - head);
+        }
+        return ready;
+    }
+
+    std::vector<T> slots_;
+
+    // Consumer-owned line: read position and its view of the producer
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t cached_tail_ = 0;
+
+    // Producer-owned line: write position and its view of the consumer
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    uint64_t cached_head_ = 0;
+};
+
+} // namespace dase
@@ -0,0 +1,212 @@
+#pragma once
+
+// ============================================================================
+// STATE DIGEST
+// ============================================================================
+//
+// A 64-bit fingerprint of engine state arrays for determinism checks:
+// comparing two runs, or a run against a golden, without shipping the
+// state as JSON.  Each value is canonicalized to one 64-bit word
+//
+//     tolerance == 0:  its IEEE-754 bits, with -0 folded into +0 and every
+//                      NaN into the quiet NaN 0x7ff8000000000000
+//     tolerance  > 0:  llround(value / tolerance) as a signed integer
+//                      (NaN and +-inf: fixed sentinels), so values within
+//                      rounding of the same multiple of the tolerance agree
+//
+// and the words are hashed with XXH64 (xxHash, seed 0) in little-endian
+// byte order, so digests are stable across platforms and builds.  A field
+// may also be hashed in blocks of block_size values, whose digests locate
+// where two runs diverge.  A set of fields combines into one digest by
+// hashing, per field in order, the hash of its name and its digest.
+//
+// Quantization is a bucket test, not a distance test: two values a hair
+// apart can still round to neighbouring multiples.  Pick a tolerance well
+// above the expected noise and well below a real difference.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace dase {
+
+class StateDigest {
+public:
+    // XXH64 of `size` bytes
+    static uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        const unsigned char* const end = p + size;
+        uint64_t h;
+        if (size >= 32) {
+            uint64_t v[4] = {seed + kP1 + kP2, seed + kP2, seed, seed - kP1};
+            for (; p + 32 <= end; p += 32) {
+                for (int lane = 0; lane < 4; ++lane) {
+                    v[lane] = round(v[lane], read64(p + 8 * lane));
+                }
+            }
+            h = mergeLanes(v);
+        } else {
+            h = seed + kP5;
+        }
+        h += static_cast<uint64_t>(size);
+        for (; p + 8 <= end; p += 8) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * kP1 + kP4;
+        }
+        if (p + 4 <= end) {
+            uint32_t word;
+            std::memcpy(&word, p, 4);
+            h ^= static_cast<uint64_t>(word) * kP1;
+            h = rotl(h, 23) * kP2 + kP3;
+            p += 4;
+        }
+        for (; p < end; ++p) {
+            h ^= static_cast<uint64_t>(*p) * kP5;
+            h = rotl(h, 11) * kP1;
+        }
+        return avalanche(h);
+    }
+
+    static uint64_t hashString(const std::string& text) {
+        return hashBytes(text.data(), text.size());
+    }
+
+    // The canonical word of a value (see the file comment)
+    static uint64_t canonical(double value, double tolerance) {
+        if (tolerance > 0.0) {
+            if (std::isnan(value)) {
+                return 0x7ff8000000000000ull;
+            }
+            const double scaled = value / tolerance;
+            if (!(std::fabs(scaled) < 9.2e18)) {
+                return value > 0.0 ? 0x7ff0000000000000ull : 0xfff0000000000000ull;
+            }
+            return static_cast<uint64_t>(std::llround(scaled));
+        }
+        if (std::isnan(value)) {
+            return 0x7ff8000000000000ull;
+        }
+        if (value == 0.0) {
+            return 0;
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    /**
+     * Digest of `count` values; with block_size > 0 also the digest of each
+     * block_size run of values (the last may be shorter) into blocks_out.
+     * Equals hashBytes over the canonical words in little-endian order.
+     */
+    static uint64_t field(const double* values, size_t count, double tolerance,
+                          size_t block_size = 0, std::vector<uint64_t>* blocks_out = nullptr) {
+        if (block_size > 0 && blocks_out) {
+            blocks_out->clear();
+            blocks_out->reserve((count + block_size - 1) / block_size);
+            for (size_t begin = 0; begin < count; begin += block_size) {
+                const size_t n = count - begin < block_size ? count - begin : block_size;
+                blocks_out->push_back(words(values + begin, n, tolerance));
+            }
+        }
+        return words(values, count, tolerance);
+    }
+
+    /**
+     * Combined digest of named field digests: XXH64 over, per field in
+     * order, hashString(name) then its digest
+     */
+    static uint64_t combine(const std::vector<std::string>& names, const std::vector<uint64_t>& digests) {
+        std::vector<unsigned char> bytes;
+        bytes.reserve(16 * digests.size());
+        for (size_t i = 0; i < digests.size() && i < names.size(); ++i) {
+            appendLE(bytes, hashString(names[i]));
+            appendLE(bytes, digests[i]);
+        }
+        return hashBytes(bytes.data(), bytes.size());
+    }
+
+    // 16 lowercase hex digits
+    static std::string hex(uint64_t digest) {
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(digest));
+        return text;
+    }
+
+private:
+    static constexpr uint64_t kP1 = 0x9E3779B185EBCA87ull;
+    static constexpr uint64_t kP2 = 0xC2B2AE3D27D4EB4Full;
+    static constexpr uint64_t kP3 = 0x165667B19E3779F9ull;
+    static constexpr uint64_t kP4 = 0x85EBCA77C2B2AE63ull;
+    static constexpr uint64_t kP5 = 0x27D4EB2F165667C5ull;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    static uint64_t round(uint64_t acc, uint64_t input) {
+        acc += input * kP2;
+        return rotl(acc, 31) * kP1;
+    }
+
+    static uint64_t mergeLanes(const uint64_t v[4]) {
+        uint64_t h = rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18);
+        for (int lane = 0; lane < 4; ++lane) {
+            h ^= round(0, v[lane]);
+            h = h * kP1 + kP4;
+        }
+        return h;
+    }
+
+    static uint64_t avalanche(uint64_t h) {
+        h ^= h >> 33;
+        h *= kP2;
+        h ^= h >> 29;
+        h *= kP3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    static uint64_t read64(const unsigned char* p) {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | p[i];
+        }
+        return value;
+    }
+
+    static void appendLE(std::vector<unsigned char>& bytes, uint64_t word) {
+        for (int i = 0; i < 8; ++i) {
+            bytes.push_back(static_cast<unsigned char>(word >> (8 * i)));
+        }
+    }
+
+    // XXH64 of the canonical words of `count` values, streamed without a
+    // copy (the input is a whole number of 8-byte words, so only the
+    // 8-byte tail path applies)
+    static uint64_t words(const double* values, size_t count, double tolerance) {
+        size_t i = 0;
+        uint64_t h;
+        if (count >= 4) {
+            uint64_t v[4] = {kP1 + kP2, kP2, 0, 0 - kP1};
+            for (; i + 4 <= count; i += 4) {
+                for (int lane = 0; lane < 4; ++lane) {
+                    v[lane] = round(v[lane], canonical(values[i + lane], tolerance));
+                }
+            }
+            h = mergeLanes(v);
+        } else {
+            h = kP5;
+        }
+        h += static_cast<uint64_t>(count) * 8;
+        for (; i < count; ++i) {
+            h ^= round(0, canonical(values[i], tolerance));
+            h = rotl(h, 27) * kP1 + kP4;
+        }
+        return avalanche(h);
+    }
+};
+
+} // namespace dase
@@ -0,0 +1,71 @@
+/**
+ * Step Loop - A whole mission inside one OpenMP parallel region
+ *
+ * The IGSOA and SATP steppers open a parallel region per step, so a small
+ * lattice (1k-50k nodes) with many steps pays a team fork/join and the
+ * region's closing barrier every step, which can exceed the step's own
+ * work.  StepLoop::run instead opens the region once per mission and keeps
+ * the team inside it:
+ *
+ *   every step s:   parallel(s)   on every team thread; its worksharing
+ *                                 loops (schedule(static): each thread keeps
+ *                                 its slice of the nodes from step to step)
+ *                                 split the work, their implicit barriers
+ *                                 order the phases
+ *                   serial(s)     on one thread once the team is done
+ *                                 (clock, counters, probes, observables);
+ *                                 false stops the mission after step s
+ *
+ * parallel(s) must end with a barrier - a worksharing loop without nowait
+ * or a single does - so serial(s) sees its writes; the barrier closing
+ * serial's single then publishes serial's writes and the stop flag to the
+ * team.  Between steps the team waits in OpenMP barriers, which spin
+ * briefly and then park (OMP_WAIT_POLICY / GOMP_SPINCOUNT tune the
+ * switch), so thread creation and wake-up are paid once per mission.
+ *
+ * Neither callable may throw (an exception cannot leave a parallel
+ * region).  With team = false (lattices below the engines' OpenMP
+ * threshold) the loop runs on the calling thread; the results are the
+ * same either way.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace dase {
+
+class StepLoop {
+public:
+    /**
+     * Run up to num_steps steps; returns the steps run.  parallel returns
+     * its thread's operation count for the step, summed into operations.
+     */
+    template <typename Parallel, typename Serial>
+    static uint64_t run(uint64_t num_steps, bool team, Parallel&& parallel, Serial&& serial,
+                        uint64_t& operations) {
+        uint64_t steps_run = num_steps;
+        bool stop = false;
+        uint64_t team_operations = 0;
+        #pragma omp parallel if(team) reduction(+:team_operations)
+        {
+            for (uint64_t step = 0; step < num_steps; ++step) {
+                team_operations += parallel(step);
+                #pragma omp single
+                {
+                    if (!serial(step)) {
+                        stop = true;
+                        steps_run = step + 1;
+                    }
+                }
+                if (stop) {
+                    break;
+                }
+            }
+        }
+        operations += team_operations;
+        return steps_run;
+    }
+};
+
+} // namespace dase
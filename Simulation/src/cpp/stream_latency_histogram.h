@@ -0,0 +1,66 @@
+#pragma once
+
+/**
+ * Block latency histogram of a streaming session (dase_stream_session.h)
+ *
+ * The processing thread records one latency per block with relaxed
+ * atomics (no locks, no allocation); any thread may read a snapshot.
+ * Bucket k counts latencies in [2^k, 2^(k+1)) ns; bucket 0 also takes
+ * 0 ns and the last bucket everything from 2^(kBuckets-1) ns (~9 min) up.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+namespace dase {
+
+class StreamLatencyHistogram {
+public:
+    static constexpr int kBuckets = 40;
+
+    void record(uint64_t latency_ns) noexcept {
+        int bucket = 0;
+        while (bucket + 1 < kBuckets && (latency_ns >> (bucket + 1)) != 0) {
+            ++bucket;
+        }
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        blocks_.fetch_add(1, std::memory_order_relaxed);
+        total_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+        uint64_t max = max_ns_.load(std::memory_order_relaxed);
+        while (latency_ns > max && !max_ns_.compare_exchange_weak(max, latency_ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Input samples refused because the input ring was full
+    void recordOverrun(uint64_t samples) noexcept {
+        overruns_.fetch_add(samples, std::memory_order_relaxed);
+    }
+
+    void reset() noexcept {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        blocks_.store(0, std::memory_order_relaxed);
+        overruns_.store(0, std::memory_order_relaxed);
+        total_ns_.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t blocks() const noexcept { return blocks_.load(std::memory_order_relaxed); }
+    uint64_t overruns() const noexcept { return overruns_.load(std::memory_order_relaxed); }
+    uint64_t maxNs() const noexcept { return max_ns_.load(std::memory_order_relaxed); }
+    double meanNs() const noexcept {
+        const uint64_t n = blocks();
+        return n > 0 ? static_cast<double>(total_ns_.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+    }
+    uint64_t bucket(int k) const noexcept { return buckets_[k].load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> buckets_[kBuckets] = {};
+    std::atomic<uint64_t> blocks_{0};
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<uint64_t> total_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+} // namespace dase
@@ -0,0 +1,164 @@
+/**
+ * Temporal Blocking Geometry
+ *
+ * Overlapped (trapezoidal) space-time tiling shared by the SATP and IGSOA
+ * 2D/3D blocked steppers (satp_higgs_temporal_blocking.h,
+ * igsoa_temporal_blocking.h).  The periodic lattice is cut into cubic core
+ * tiles; for a block of T steps of a radius-r stencil each tile copies its
+ * core plus a halo of T·r cells per side into a thread-private buffer,
+ * advances T steps there (the valid region shrinks by r per step, a
+ * trapezoid in space-time) and writes back only its core.  Tiles read the
+ * block's start state and write a second global buffer, so they are
+ * independent and run in parallel; halo cells are computed redundantly by
+ * neighbouring tiles.
+ *
+ * Each block streams the lattice state once instead of once per step.  The
+ * price is the redundant halo work, (1 + 2·T·r / tile)^dims at worst, so
+ * the tile must stay large against T·r while its buffer still fits in
+ * cache (DASE_TB_TILE_2D / DASE_TB_TILE_3D).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef DASE_TB_TILE_2D
+#define DASE_TB_TILE_2D 64
+#endif
+
+#ifndef DASE_TB_TILE_3D
+#define DASE_TB_TILE_3D 32
+#endif
+
+namespace dase {
+
+struct TemporalBlockingGrid {
+    size_t n[3] = {1, 1, 1};       // Lattice extent (x, y, z); 1 on unused axes
+    size_t core[3] = {1, 1, 1};    // Core tile extent
+    size_t halo[3] = {0, 0, 0};    // Halo per side (0 on unused axes)
+    size_t tiles[3] = {1, 1, 1};   // Tiles per axis
+
+    /**
+     * One tile: core placement and thread-local buffer shape
+     */
+    struct Box {
+        size_t origin[3];   // Core origin in the lattice
+        size_t extent[3];   // Core extent (edge tiles may be smaller)
+        size_t local[3];    // Local buffer extent (core + 2·halo)
+
+        size_t volume() const { return local[0] * local[1] * local[2]; }
+        size_t row() const { return local[0]; }
+        size_t plane() const { return local[0] * local[1]; }
+    };
+
+    TemporalBlockingGrid() = default;
+
+    /**
+     * @param dims Lattice dimensionality (2 or 3; the z extent is ignored in 2D)
+     * @param halo_width Halo per side, T · (stencil radius)
+     */
+    TemporalBlockingGrid(int dims, size_t N_x, size_t N_y, size_t N_z, size_t halo_width) {
+        const size_t lattice[3] = {N_x, N_y, dims == 3 ? N_z : 1};
+        const size_t tile = dims == 3 ? DASE_TB_TILE_3D : DASE_TB_TILE_2D;
+        for (int a = 0; a < 3; ++a) {
+            const bool active = a < dims;
+            n[a] = std::max<size_t>(lattice[a], 1);
+            core[a] = active ? std::min(tile, n[a]) : 1;
+            halo[a] = active ? halo_width : 0;
+            tiles[a] = (n[a] + core[a] - 1) / core[a];
+        }
+    }
+
+    size_t numTiles() const { return tiles[0] * tiles[1] * tiles[2]; }
+
+    Box box(size_t tile) const {
+        const size_t t[3] = {tile % tiles[0], (tile / tiles[0]) % tiles[1], tile / (tiles[0] * tiles[1])};
+        Box b;
+        for (int a = 0; a < 3; ++a) {
+            b.origin[a] = t[a] * core[a];
+            b.extent[a] = std::min(core[a], n[a] - b.origin[a]);
+            b.local[a] = b.extent[a] + 2 * halo[a];
+        }
+        return b;
+    }
+
+    /**
+     * Cells held by all local buffers over cells in the lattice (the halo
+     * overhead of one block; 1 = no overlap)
+     */
+    double overlap() const {
+        double local = 0.0;
+        for (size_t t = 0; t < numTiles(); ++t) {
+            local += static_cast<double>(box(t).volume());
+        }
+        return local / static_cast<double>(n[0] * n[1] * n[2]);
+    }
+
+    /**
+     * visit(local_index, lattice_index) for every cell of the local buffer
+     * (halo cells map periodically onto the lattice)
+     */
+    template <typename Visit>
+    void forEachLocal(const Box& b, Visit&& visit) const {
+        size_t start[3];
+        for (int a = 0; a < 3; ++a) {
+            // origin - halo, wrapped (halo may exceed the lattice on tiny grids)
+            start[a] = (b.origin[a] + n[a] - halo[a] % n[a]) % n[a];
+        }
+        size_t local = 0;
+        size_t gz = start[2];
+        for (size_t lz = 0; lz < b.local[2]; ++lz) {
+            size_t gy = start[1];
+            for (size_t ly = 0; ly < b.local[1]; ++ly) {
+                const size_t row = (gz * n[1] + gy) * n[0];
+                size_t gx = start[0];
+                for (size_t lx = 0; lx < b.local[0]; ++lx) {
+                    visit(local++, row + gx);
+                    gx = (gx + 1 == n[0]) ? 0 : gx + 1;
+                }
+                gy = (gy + 1 == n[1]) ? 0 : gy + 1;
+            }
+            gz = (gz + 1 == n[2]) ? 0 : gz + 1;
+        }
+    }
+
+    /**
+     * visit(local_index, lattice_index) for every core cell
+     */
+    template <typename Visit>
+    void forEachCore(const Box& b, Visit&& visit) const {
+        for (size_t z = 0; z < b.extent[2]; ++z) {
+            for (size_t y = 0; y < b.extent[1]; ++y) {
+                const size_t local = ((z + halo[2]) * b.local[1] + y + halo[1]) * b.local[0] + halo[0];
+                const size_t global = ((b.origin[2] + z) * n[1] + b.origin[1] + y) * n[0] + b.origin[0];
+                for (size_t x = 0; x < b.extent[0]; ++x) {
+                    visit(local + x, global + x);
+                }
+            }
+        }
+    }
+
+    /**
+     * visit(x_begin, x_end, row_base) for every x-row of the local region
+     * that lies `shrink` cells inside the buffer on each active axis
+     * (row_base = local index of x = 0 in that row)
+     */
+    template <typename Visit>
+    void forEachRow(const Box& b, size_t shrink, Visit&& visit) const {
+        size_t lo[3], hi[3];
+        for (int a = 0; a < 3; ++a) {
+            const size_t s = halo[a] > 0 ? shrink : 0;
+            lo[a] = s;
+            hi[a] = b.local[a] - s;
+        }
+        for (size_t z = lo[2]; z < hi[2]; ++z) {
+            for (size_t y = lo[1]; y < hi[1]; ++y) {
+                visit(lo[0], hi[0], (z * b.local[1] + y) * b.local[0]);
+            }
+        }
+    }
+};
+
+} // namespace dase
@@ -0,0 +1,263 @@
+#pragma once
+
+// ============================================================================
+// THREAD BUDGET
+// ============================================================================
+//
+// Process-wide share-out of cores between engines that run at the same time.
+// Every engine parallelises with its own OpenMP teams, and by default each
+// team is omp_get_max_threads() wide, so six engines stepping on six CLI job
+// workers (or six Python threads) each spawn a full-width team and the cores
+// thrash.
+//
+// A mission instead takes a Lease for the workers it wants (its thread
+// limit, or the current team width).  The budget holds one token per core;
+// a lease is granted
+//
+//     max(1, min(requested, free tokens, capacity / (holders + 1)))
+//
+// tokens, so a lone mission gets the whole machine and later arrivals get a
+// fair share as soon as earlier ones re-lease (the CLI leases per mission
+// block).  Grants never block: with every token held a lease still gets one
+// thread.  The lease sets the calling thread's OpenMP team width (a
+// per-thread ICV, as SweepScheduler does), so every parallel region the
+// mission opens on that thread is limited, and restores it on release.
+// Leases nested on one thread take no further tokens.
+//
+// A lease may also pin its team to a CPU list (per-engine affinity masks);
+// the team threads go back to the calling thread's previous mask on release.
+// Pinning is Linux-only, as in NumaPlacement.
+//
+// The budget is one per module: the CLI and the phase4b engine library each
+// have their own.  The OpenMP runtime, and so the team width a lease sets,
+// is shared, so a CLI lease around a library mission bounds the library's
+// own lease too.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace dase {
+
+struct ThreadBudgetStats {
+    int capacity = 0;           // Tokens (cores)
+    int in_use = 0;             // Tokens held by leases now
+    int holders = 0;            // Leases holding tokens now
+    int peak = 0;               // Most tokens held at once
+    uint64_t leases = 0;        // Token-holding leases granted
+    uint64_t reduced = 0;       // ... granted fewer threads than requested
+};
+
+class ThreadBudget {
+public:
+    // The budget of this module
+    static ThreadBudget& process() {
+        static ThreadBudget budget;
+        return budget;
+    }
+
+    // Cores the process may use (OpenMP's processor count, else hardware concurrency)
+    static int hardwareThreads() {
+#ifdef _OPENMP
+        return std::max(1, omp_get_num_procs());
+#else
+        return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+#endif
+    }
+
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept { *this = std::move(other); }
+        Lease& operator=(Lease&& other) noexcept {
+            if (this != &other) {
+                release();
+                budget_ = other.budget_;
+                threads_ = other.threads_;
+                tokens_ = other.tokens_;
+                previous_threads_ = other.previous_threads_;
+                previous_held_ = other.previous_held_;
+                pinned_ = other.pinned_;
+#ifdef __linux__
+                previous_mask_ = other.previous_mask_;
+#endif
+                other.budget_ = nullptr;
+            }
+            return *this;
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease() { release(); }
+
+        // Team width granted
+        int threads() const { return threads_; }
+        bool pinned() const { return pinned_; }
+
+        void release() {
+            if (!budget_) {
+                return;
+            }
+#ifdef __linux__
+            if (pinned_) {
+                pinTeam(threads_, nullptr, &previous_mask_);
+            }
+#endif
+#ifdef _OPENMP
+            omp_set_num_threads(previous_threads_);
+#endif
+            heldThreads() = previous_held_;
+            budget_->giveBack(tokens_);
+            budget_ = nullptr;
+        }
+
+    private:
+        friend class ThreadBudget;
+
+        ThreadBudget* budget_ = nullptr;
+        int threads_ = 1;
+        int tokens_ = 0;                // 0 for a nested lease
+        int previous_threads_ = 1;      // Team width before the lease
+        int previous_held_ = 0;
+        bool pinned_ = false;
+#ifdef __linux__
+        cpu_set_t previous_mask_;
+#endif
+    };
+
+    int capacity() const { return capacity_.load(); }
+
+    // Tokens of the budget; 0 = hardwareThreads().  Leases already granted
+    // keep their tokens.
+    void setCapacity(int threads) {
+        capacity_.store(threads > 0 ? threads : hardwareThreads());
+    }
+
+    /**
+     * Lease up to `requested` workers (<= 0: the calling thread's current
+     * team width), pinned to `cpus` if given
+     */
+    Lease acquire(int requested, const std::vector<int>* cpus = nullptr) {
+        int width = 1;
+#ifdef _OPENMP
+        width = omp_get_max_threads();
+#endif
+        if (requested <= 0) {
+            requested = width;
+        }
+
+        Lease lease;
+        lease.budget_ = this;
+        lease.previous_threads_ = width;
+        lease.previous_held_ = heldThreads();
+        if (lease.previous_held_ > 0) {
+            // Nested: stay inside the outer lease's width
+            lease.threads_ = std::max(1, std::min(requested, lease.previous_held_));
+        } else {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const int capacity = capacity_.load();
+            const int free = std::max(0, capacity - in_use_);
+            const int fair = std::max(1, capacity / (holders_ + 1));
+            lease.threads_ = std::max(1, std::min({requested, free, fair}));
+            lease.tokens_ = lease.threads_;
+            in_use_ += lease.tokens_;
+            holders_++;
+            peak_ = std::max(peak_, in_use_);
+            leases_++;
+            if (lease.threads_ < requested) {
+                reduced_++;
+            }
+        }
+        heldThreads() = lease.threads_;
+#ifdef _OPENMP
+        omp_set_num_threads(lease.threads_);
+#endif
+#ifdef __linux__
+        if (cpus && !cpus->empty() && sched_getaffinity(0, sizeof(lease.previous_mask_), &lease.previous_mask_) == 0) {
+            lease.pinned_ = pinTeam(lease.threads_, cpus, nullptr);
+        }
+#else
+        (void)cpus;
+#endif
+        return lease;
+    }
+
+    ThreadBudgetStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ThreadBudgetStats stats;
+        stats.capacity = capacity_.load();
+        stats.in_use = in_use_;
+        stats.holders = holders_;
+        stats.peak = peak_;
+        stats.leases = leases_;
+        stats.reduced = reduced_;
+        return stats;
+    }
+
+private:
+    ThreadBudget() : capacity_(hardwareThreads()) {}
+
+    // Width of the lease the calling thread holds (0: none)
+    static int& heldThreads() {
+        static thread_local int held = 0;
+        return held;
+    }
+
+    void giveBack(int tokens) {
+        if (tokens == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        in_use_ -= tokens;
+        holders_--;
+    }
+
+#ifdef __linux__
+    // Pin thread t of a `threads`-wide team to cpus[t % size], or every
+    // team thread to `mask`; false if any thread could not be pinned
+    static bool pinTeam(int threads, const std::vector<int>* cpus, const cpu_set_t* mask) {
+        int failures = 0;
+        #pragma omp parallel num_threads(threads) reduction(+:failures)
+        {
+            cpu_set_t set;
+            if (mask) {
+                set = *mask;
+            } else {
+                int tid = 0;
+#ifdef _OPENMP
+                tid = omp_get_thread_num();
+#endif
+                CPU_ZERO(&set);
+                const int cpu = (*cpus)[static_cast<size_t>(tid) % cpus->size()];
+                if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                    CPU_SET(cpu, &set);
+                }
+            }
+            if (CPU_COUNT(&set) == 0 || sched_setaffinity(0, sizeof(set), &set) != 0) {
+                failures++;
+            }
+        }
+        return failures == 0;
+    }
+#endif
+
+    std::atomic<int> capacity_;
+    mutable std::mutex mutex_;
+    int in_use_ = 0;
+    int holders_ = 0;
+    int peak_ = 0;
+    uint64_t leases_ = 0;
+    uint64_t reduced_ = 0;
+};
+
+} // namespace dase
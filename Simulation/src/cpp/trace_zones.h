@@ -0,0 +1,202 @@
+#pragma once
+
+// ============================================================================
+// TRACE ZONES
+// ============================================================================
+//
+// Scoped timing zones around engine step phases, exported as Chrome trace
+// JSON (chrome://tracing, ui.perfetto.dev) so a slow mission shows which
+// phase the time went to.
+//
+// DASE_TRACE_ZONE("name") compiles to nothing unless DASE_ENABLE_TRACE is
+// defined (CMake option DASE_ENABLE_TRACE).  When compiled in, a zone costs
+// one relaxed load while recording is off; while on, it appends a complete
+// event to the calling thread's own buffer, so OpenMP team members never
+// contend.  Names must be string literals (only the pointer is kept).
+//
+// TraceRecorder::start() clears the buffers and begins recording; stop()
+// ends it; writeChromeTrace() emits every buffered event.  Buffers are
+// capped per thread; events past the cap are counted as dropped.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dase {
+namespace trace {
+
+#ifdef DASE_ENABLE_TRACE
+constexpr bool kTraceCompiledIn = true;
+#else
+constexpr bool kTraceCompiledIn = false;
+#endif
+
+constexpr size_t kMaxEventsPerThread = size_t(1) << 20;
+
+struct TraceEvent {
+    const char* name;
+    uint64_t start_ns;   // Since TraceRecorder::start()
+    uint64_t dur_ns;
+};
+
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static TraceRecorder& instance() {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    bool recording() const { return recording_.load(std::memory_order_relaxed); }
+
+    void start() {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+        origin_ns_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+        recording_.store(true, std::memory_order_release);
+    }
+
+    void stop() { recording_.store(false, std::memory_order_release); }
+
+    void record(const char* name, Clock::time_point begin, Clock::time_point end) {
+        ThreadBuffer& buffer = localBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);   // Only contended by an export
+        if (buffer.events.size() >= kMaxEventsPerThread) {
+            ++buffer.dropped;
+            return;
+        }
+        const Clock::time_point origin{Clock::duration(origin_ns_.load(std::memory_order_relaxed))};
+        const auto since = [origin](Clock::time_point t) {
+            return t > origin ? static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(t - origin).count()) : 0;
+        };
+        const uint64_t start_ns = since(begin);
+        buffer.events.push_back({name, start_ns, since(end) - start_ns});
+    }
+
+    struct Summary {
+        uint64_t events = 0;
+        uint64_t dropped = 0;
+        uint64_t threads = 0;
+    };
+
+    Summary summary() const {
+        Summary out;
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            out.events += buffer->events.size();
+            out.dropped += buffer->dropped;
+            out.threads += buffer->events.empty() ? 0 : 1;
+        }
+        return out;
+    }
+
+    // Chrome trace event format: one "X" (complete) event per zone, ts/dur
+    // in microseconds, plus a thread_name record per thread
+    void writeChromeTrace(std::ostream& out) const {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        char number[64];
+        for (const auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            if (buffer->events.empty()) {
+                continue;
+            }
+            out << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                << buffer->tid << ",\"args\":{\"name\":\"thread " << buffer->tid << "\"}}";
+            first = false;
+            for (const TraceEvent& event : buffer->events) {
+                std::snprintf(number, sizeof(number), "%.3f,\"dur\":%.3f",
+                              static_cast<double>(event.start_ns) * 1.0e-3,
+                              static_cast<double>(event.dur_ns) * 1.0e-3);
+                out << ",{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                    << buffer->tid << ",\"ts\":" << number << "}";
+            }
+        }
+        out << "]}\n";
+    }
+
+    bool writeChromeTrace(const std::string& path) const {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        writeChromeTrace(out);
+        return static_cast<bool>(out);
+    }
+
+private:
+    struct ThreadBuffer {
+        uint32_t tid = 0;
+        uint64_t dropped = 0;
+        std::vector<TraceEvent> events;
+        mutable std::mutex mutex;
+    };
+
+    TraceRecorder() : origin_ns_(Clock::now().time_since_epoch().count()) {}
+
+    // Registered on a thread's first event; kept after the thread exits so
+    // its events still export
+    ThreadBuffer& localBuffer() {
+        thread_local ThreadBuffer* local = nullptr;
+        if (!local) {
+            auto buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            buffer->tid = static_cast<uint32_t>(buffers_.size() + 1);
+            buffers_.push_back(buffer);
+            local = buffer.get();
+        }
+        return *local;
+    }
+
+    std::atomic<bool> recording_{false};
+    std::atomic<Clock::rep> origin_ns_;   // Clock ticks of start()
+    mutable std::mutex registry_mutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+class TraceZone {
+public:
+    explicit TraceZone(const char* name)
+        : name_(TraceRecorder::instance().recording() ? name : nullptr) {
+        if (name_) {
+            begin_ = TraceRecorder::Clock::now();
+        }
+    }
+    ~TraceZone() {
+        if (name_) {
+            TraceRecorder::instance().record(name_, begin_, TraceRecorder::Clock::now());
+        }
+    }
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name_;
+    TraceRecorder::Clock::time_point begin_;
+};
+
+} // namespace trace
+} // namespace dase
+
+#ifdef DASE_ENABLE_TRACE
+#define DASE_TRACE_CONCAT_INNER(a, b) a##b
+#define DASE_TRACE_CONCAT(a, b) DASE_TRACE_CONCAT_INNER(a, b)
+#define DASE_TRACE_ZONE(name) ::dase::trace::TraceZone DASE_TRACE_CONCAT(dase_trace_zone_, __LINE__)(name)
+#else
+#define DASE_TRACE_ZONE(name) ((void)0)
+#endif
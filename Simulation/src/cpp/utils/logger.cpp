@@ -3,6 +3,8 @@
 #include <iomanip>
 #include <ctime>
 #include <chrono>
+#include <cstdint>
+#include <algorithm>
 
 namespace igsoa {
 
@@ -10,7 +12,8 @@ Logger::Logger()
     : console_level_(Level::WARNING),
       file_level_(Level::DEBUG),
       initialized_(false),
-      filename_("igsoa_sim.log") {
+      filename_("igsoa_sim.log"),
+      min_level_(static_cast<int>(Level::WARNING)) {
 }
 
 Logger::~Logger() {
@@ -41,10 +44,12 @@ void Logger::initialize(const std::string& filename, Level console_level, Level
         std::cerr << "[Logger] WARNING: Failed to open log file: " << filename_ << std::endl;
         std::cerr << "[Logger] Logging to console only." << std::endl;
         initialized_ = false;
+        updateMinLevel();
         return;
     }
 
     initialized_ = true;
+    updateMinLevel();
 
     // Log initialization
     file_ << "\n========================================\n";
@@ -59,19 +64,143 @@ void Logger::initialize(const std::string& filename, Level console_level, Level
 void Logger::setConsoleLevel(Level level) {
     std::lock_guard<std::mutex> lock(mutex_);
     console_level_ = level;
+    updateMinLevel();
 }
 
 void Logger::setFileLevel(Level level) {
     std::lock_guard<std::mutex> lock(mutex_);
     file_level_ = level;
+    updateMinLevel();
 }
 
 void Logger::log(Level level, const std::string& message, const char* file, int line) {
+    const auto now = std::chrono::system_clock::now();
+
+    if (async_.load(std::memory_order_acquire)) {
+        producers_.fetch_add(1, std::memory_order_acq_rel);
+        bool queued = false;
+        if (async_.load(std::memory_order_acquire)) {
+            Record record{level, now, file, line, message};
+            queued = tryPush(record);
+            if (queued) pushed_.fetch_add(1, std::memory_order_release);
+        }
+        producers_.fetch_sub(1, std::memory_order_acq_rel);
+        if (queued) {
+            if (level >= Level::FATAL) flush();
+            return;
+        }
+        // Ring full (or async stopping): write this one on the caller's thread
+    }
+
+    const std::string formatted_message = formatRecord(level, now, file, line, message);
     std::lock_guard<std::mutex> lock(mutex_);
+    writeLine(level, formatted_message);
+    flushSinks();
+}
+
+void Logger::startAsync(size_t capacity) {
+    if (async_.load(std::memory_order_acquire)) return;
+    size_t slots = 2;
+    while (slots < capacity) slots <<= 1;
+
+    ring_ = std::vector<Slot>(slots);
+    for (size_t i = 0; i < slots; ++i) {
+        ring_[i].seq.store(i, std::memory_order_relaxed);
+    }
+    ring_mask_ = slots - 1;
+    head_.store(0, std::memory_order_relaxed);
+    tail_ = 0;
+    pushed_.store(0, std::memory_order_relaxed);
+    written_.store(0, std::memory_order_relaxed);
+    stopping_.store(false, std::memory_order_relaxed);
+    writer_ = std::thread(&Logger::drainLoop, this);
+    async_.store(true, std::memory_order_release);
+}
+
+void Logger::stopAsync() {
+    if (!writer_.joinable()) return;
+    async_.store(false, std::memory_order_release);
+    // Let callers already past the async check finish their push
+    while (producers_.load(std::memory_order_acquire) != 0) {
+        std::this_thread::yield();
+    }
+    stopping_.store(true, std::memory_order_release);
+    wake_.notify_all();
+    writer_.join();
+}
+
+void Logger::flush() {
+    const size_t target = pushed_.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (written_.load(std::memory_order_acquire) < target && writer_.joinable()) {
+        wake_.notify_all();
+        drained_.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+void Logger::drainLoop() {
+    Record record;
+    for (;;) {
+        size_t batch = 0;
+        while (tryPop(record)) {
+            const std::string formatted_message =
+                formatRecord(record.level, record.when, record.file, record.line, record.message);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                writeLine(record.level, formatted_message);
+                if (++batch % 256 == 0) flushSinks();
+            }
+            written_.fetch_add(1, std::memory_order_release);
+        }
+        if (batch > 0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                flushSinks();
+            }
+            drained_.notify_all();
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) return;
+
+        // Producers never signal; poll so the hot path stays a ring push
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
 
-    // Build log message
+bool Logger::tryPush(Record& record) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = ring_[pos & ring_mask_];
+        const size_t seq = slot.seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = std::move(record);
+                slot.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;   // Full: the writer has not freed this slot yet
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::tryPop(Record& record) {
+    Slot& slot = ring_[tail_ & ring_mask_];
+    if (slot.seq.load(std::memory_order_acquire) != tail_ + 1) return false;
+    record = std::move(slot.record);
+    slot.seq.store(tail_ + ring_mask_ + 1, std::memory_order_release);
+    ++tail_;
+    return true;
+}
+
+std::string Logger::formatRecord(Level level, std::chrono::system_clock::time_point when,
+                                 const char* file, int line, const std::string& message) {
     std::ostringstream oss;
-    oss << "[" << getCurrentTimestamp() << "] ";
+    oss << "[" << formatTimestamp(when) << "] ";
     oss << "[" << levelToString(level) << "] ";
 
     // Add file:line if provided
@@ -80,26 +209,45 @@ void Logger::log(Level level, const std::string& message, const char* file, int
     }
 
     oss << message;
+    return oss.str();
+}
 
-    std::string formatted_message = oss.str();
-
+void Logger::writeLine(Level level, const std::string& line) {
     // Log to console if level is sufficient
     if (shouldLog(level, console_level_)) {
         if (level >= Level::ERROR) {
-            std::cerr << formatted_message << std::endl;
+            std::cerr << line << "\n";
         } else {
-            std::cout << formatted_message << std::endl;
+            std::cout << line << "\n";
         }
     }
 
     // Log to file if initialized and level is sufficient
     if (initialized_ && file_.is_open() && shouldLog(level, file_level_)) {
-        file_ << formatted_message << "\n";
+        file_ << line << "\n";
+    }
+}
+
+void Logger::flushSinks() {
+    std::cout.flush();
+    std::cerr.flush();
+    if (file_.is_open()) {
         file_.flush();  // Ensure immediate write (important for errors)
     }
 }
 
+void Logger::updateMinLevel() {
+    int level = static_cast<int>(console_level_);
+    if (initialized_ && file_.is_open()) {
+        level = std::min(level, static_cast<int>(file_level_));
+    }
+    min_level_.store(level, std::memory_order_relaxed);
+}
+
 void Logger::shutdown() {
+    // Pending async records go out before the trailer
+    stopAsync();
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (initialized_ && file_.is_open()) {
@@ -110,6 +258,7 @@ void Logger::shutdown() {
     }
 
     initialized_ = false;
+    updateMinLevel();
 }
 
 const char* Logger::levelToString(Level level) {
@@ -124,8 +273,10 @@ const char* Logger::levelToString(Level level) {
 }
 
 std::string Logger::getCurrentTimestamp() {
-    // Get current time
-    auto now = std::chrono::system_clock::now();
+    return formatTimestamp(std::chrono::system_clock::now());
+}
+
+std::string Logger::formatTimestamp(std::chrono::system_clock::time_point now) {
     auto now_c = std::chrono::system_clock::to_time_t(now);
     auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()
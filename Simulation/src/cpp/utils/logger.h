@@ -6,6 +6,24 @@
 #include <mutex>
 #include <memory>
 #include <sstream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+/**
+ * Compile-time minimum log level (0 = DEBUG ... 4 = FATAL).  Calls below it
+ * compile to nothing, message expression included.  Release builds
+ * (NDEBUG) strip DEBUG by default; override with -DIGSOA_LOG_MIN_LEVEL=N.
+ */
+#ifndef IGSOA_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define IGSOA_LOG_MIN_LEVEL 1
+#else
+#define IGSOA_LOG_MIN_LEVEL 0
+#endif
+#endif
 
 namespace igsoa {
 
@@ -20,6 +38,11 @@ namespace igsoa {
  *   Logger::getInstance().initialize("simulation.log");
  *   LOG_INFO("Simulation started with N=" + std::to_string(N));
  *   LOG_ERROR("Failed to allocate memory");
+ *
+ * In async mode (startAsync) callers only stamp the record and push it onto
+ * a lock-free ring; a background thread formats and writes it, so logging
+ * from parallel regions does not serialize the threads.  The LOG_* macros
+ * check the level before building the message.
  */
 class Logger {
 public:
@@ -74,6 +97,34 @@ public:
     void log(Level level, const std::string& message,
              const char* file = nullptr, int line = -1);
 
+    /**
+     * @brief Whether a message at this level would be written anywhere
+     *
+     * Lock-free; the LOG_* macros call it before evaluating the message.
+     */
+    bool enabled(Level level) const {
+        return static_cast<int>(level) >= min_level_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Hand records to a background writer thread
+     * @param capacity Ring slots (rounded up to a power of two); when the
+     *        ring is full a record is written synchronously instead
+     */
+    void startAsync(size_t capacity = 8192);
+
+    /**
+     * @brief Drain pending records and go back to synchronous writes
+     */
+    void stopAsync();
+
+    /**
+     * @brief Wait until every record logged so far has been written
+     */
+    void flush();
+
+    bool isAsync() const { return async_.load(std::memory_order_acquire); }
+
     /**
      * @brief Close the log file
      */
@@ -108,6 +159,59 @@ private:
      */
     static std::string getCurrentTimestamp();
 
+    /**
+     * @brief Format a time point as "YYYY-MM-DD HH:MM:SS.mmm"
+     */
+    static std::string formatTimestamp(std::chrono::system_clock::time_point when);
+
+    /**
+     * @brief One log line, "[time] [LEVEL] [file:line] message"
+     */
+    static std::string formatRecord(Level level, std::chrono::system_clock::time_point when,
+                                    const char* file, int line, const std::string& message);
+
+    /**
+     * @brief Write a formatted line to console and file (mutex_ held)
+     */
+    void writeLine(Level level, const std::string& line);
+
+    /**
+     * @brief Flush console and file (mutex_ held)
+     */
+    void flushSinks();
+
+    /**
+     * @brief Recompute min_level_ from the console and file levels (mutex_ held)
+     */
+    void updateMinLevel();
+
+    /**
+     * @brief Background writer loop for async mode
+     */
+    void drainLoop();
+
+    /**
+     * @brief Deferred-format record; `file` points at a __FILE__ literal
+     */
+    struct Record {
+        Level level;
+        std::chrono::system_clock::time_point when;
+        const char* file;
+        int line;
+        std::string message;
+    };
+
+    /**
+     * @brief Ring slot; seq implements a bounded MPSC queue (Vyukov)
+     */
+    struct Slot {
+        std::atomic<size_t> seq{0};
+        Record record;
+    };
+
+    bool tryPush(Record& record);
+    bool tryPop(Record& record);
+
     /**
      * @brief Extract filename from full path
      * @param filepath Full file path
@@ -129,41 +233,48 @@ private:
     Level file_level_;             ///< Minimum level for file output
     bool initialized_;             ///< Whether logger is initialized
     std::string filename_;         ///< Current log filename
+    std::atomic<int> min_level_;   ///< Lowest level any sink accepts
+
+    std::vector<Slot> ring_;                 ///< Async record ring
+    size_t ring_mask_ = 0;
+    std::atomic<size_t> head_{0};            ///< Next slot producers claim
+    size_t tail_ = 0;                        ///< Next slot the writer reads
+    std::atomic<bool> async_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> producers_{0};          ///< log() calls inside the async path
+    std::atomic<size_t> pushed_{0};          ///< Records enqueued
+    std::atomic<size_t> written_{0};         ///< Records the writer finished
+    std::thread writer_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;           ///< Wakes the writer
+    std::condition_variable drained_;        ///< Wakes flush()
 };
 
 } // namespace igsoa
 
 // Convenience macros for logging
-// Use :: prefix to ensure global namespace lookup (works from any namespace)
-#define LOG_DEBUG(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::DEBUG, msg, __FILE__, __LINE__)
-
-#define LOG_INFO(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::INFO, msg, __FILE__, __LINE__)
+// Use :: prefix to ensure global namespace lookup (works from any namespace).
+// The level is checked first, so a disabled call never builds its message.
+#define IGSOA_LOG_AT(level_value, level, msg, file, line)                           \
+    do {                                                                            \
+        if ((level_value) >= IGSOA_LOG_MIN_LEVEL &&                                 \
+            ::igsoa::Logger::getInstance().enabled(::igsoa::Logger::Level::level)) { \
+            ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::level, msg,   \
+                                               file, line);                         \
+        }                                                                           \
+    } while (0)
 
-#define LOG_WARNING(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::WARNING, msg, __FILE__, __LINE__)
-
-#define LOG_ERROR(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::ERROR, msg, __FILE__, __LINE__)
-
-#define LOG_FATAL(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::FATAL, msg, __FILE__, __LINE__)
+#define LOG_DEBUG(msg) IGSOA_LOG_AT(0, DEBUG, msg, __FILE__, __LINE__)
+#define LOG_INFO(msg) IGSOA_LOG_AT(1, INFO, msg, __FILE__, __LINE__)
+#define LOG_WARNING(msg) IGSOA_LOG_AT(2, WARNING, msg, __FILE__, __LINE__)
+#define LOG_ERROR(msg) IGSOA_LOG_AT(3, ERROR, msg, __FILE__, __LINE__)
+#define LOG_FATAL(msg) IGSOA_LOG_AT(4, FATAL, msg, __FILE__, __LINE__)
 
 // Alternative: Log without file/line information (cleaner output)
-#define LOG_DEBUG_SIMPLE(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::DEBUG, msg)
-
-#define LOG_INFO_SIMPLE(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::INFO, msg)
-
-#define LOG_WARNING_SIMPLE(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::WARNING, msg)
-
-#define LOG_ERROR_SIMPLE(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::ERROR, msg)
-
-#define LOG_FATAL_SIMPLE(msg) \
-    ::igsoa::Logger::getInstance().log(::igsoa::Logger::Level::FATAL, msg)
+#define LOG_DEBUG_SIMPLE(msg) IGSOA_LOG_AT(0, DEBUG, msg, nullptr, -1)
+#define LOG_INFO_SIMPLE(msg) IGSOA_LOG_AT(1, INFO, msg, nullptr, -1)
+#define LOG_WARNING_SIMPLE(msg) IGSOA_LOG_AT(2, WARNING, msg, nullptr, -1)
+#define LOG_ERROR_SIMPLE(msg) IGSOA_LOG_AT(3, ERROR, msg, nullptr, -1)
+#define LOG_FATAL_SIMPLE(msg) IGSOA_LOG_AT(4, FATAL, msg, nullptr, -1)
 
 #endif // IGSOA_LOGGER_H
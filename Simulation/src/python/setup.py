@@ -25,7 +25,9 @@ extra_link_args = [
 ext_modules = [
     Extension(
         'dase_engine',
-        ['../cpp/analog_universal_node_engine_avx2.cpp', '../cpp/python_bindings.cpp'],
+        ['../cpp/analog_universal_node_engine_avx2.cpp', '../cpp/dase_oscillator_bank.cpp',
+         '../cpp/dase_stream_filter.cpp',
+         '../cpp/python_bindings.cpp'],
         include_dirs=[
             pybind11.get_include(),
             '../cpp',  # Include cpp directory for header files
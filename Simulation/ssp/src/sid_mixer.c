@@ -22,13 +22,6 @@ struct sid_mixer {
     sid_mixer_metrics_t metrics;
 };
 
-static double sum_field(const sid_ssp_t* ssp, uint64_t len) {
-    const double* f = sid_ssp_field_ro(ssp);
-    double s = 0.0;
-    for (uint64_t i = 0; i < len; ++i) s += f[i];
-    return s;
-}
-
 static double absd(double x) { return x < 0.0 ? -x : x; }
 static double maxd(double a, double b) { return a > b ? a : b; }
 
@@ -105,9 +98,11 @@ void sid_mixer_step(
     assert(sid_ssp_role(ssp_N) == SID_ROLE_N);
     assert(sid_ssp_role(ssp_U) == SID_ROLE_U);
 
-    const double I = sum_field(ssp_I, len);
-    const double N = sum_field(ssp_N, len);
-    double U = sum_field(ssp_U, len);
+    /* Fused kernels return each field's mass as they write it, so the
+     * corrections below read every field at most once more */
+    const double I = sid_ssp_mass(ssp_I);
+    const double N = sid_ssp_mass(ssp_N);
+    double U = sid_ssp_mass(ssp_U);
     double total = I + N + U;
 
     /* Spec: mixer corrects conservation via SSP(U) when total deviates from C */
@@ -116,50 +111,39 @@ void sid_mixer_step(
         double alpha = excess / U;
         if (alpha > 1.0) alpha = 1.0;
 
-        const uint64_t MAX_LEN = SIZE_MAX / sizeof(double);
-        if (len <= MAX_LEN && alpha > 0.0) {
-            double* M_I = (double*)calloc(len, sizeof(double));
-            double* M_N = (double*)calloc(len, sizeof(double));
-            if (M_I && M_N) {
-                for (uint64_t i = 0; i < len; ++i) M_I[i] = 1.0;
-                sid_collapse_mask_t mask = { M_I, M_N, len };
-                sid_ssp_route_from_ssp(ssp_I, ssp_U, M_I, alpha);
-                sid_ssp_route_from_ssp(ssp_N, ssp_U, M_N, alpha);
-                sid_ssp_apply_collapse_mask(ssp_U, &mask, alpha);
-            }
-            free(M_I);
-            free(M_N);
+        /* Collapse with uniform admissibility (M_I = 1, M_N = 0): the
+         * excess moves from U into I, N is untouched */
+        double I_now = I;
+        if (alpha > 0.0) {
+            sid_ssp_transfer_uniform((sid_ssp_t*)ssp_I, ssp_U, alpha, &I_now, &U);
         }
 
-        /* Recompute U and total after correction */
-        U = sum_field(ssp_U, len);
+        /* Recompute total after correction */
         total = I + N + U;
         if (total > mixer->C) {
-            const double I_now = sum_field(ssp_I, len);
-            const double N_now = sum_field(ssp_N, len);
-            const double IN = I_now + N_now;
+            const double IN = I_now + N;
+            double I_scaled = I_now;
+            double N_scaled = N;
             if (IN > 0.0) {
                 double scale = (mixer->C - U) / IN;
                 if (scale < 0.0) scale = 0.0;
                 if (scale < 1.0) {
-                    sid_ssp_scale_fields(ssp_I, scale);
-                    sid_ssp_scale_fields(ssp_N, scale);
+                    I_scaled = sid_ssp_scale_fields((sid_ssp_t*)ssp_I, scale);
+                    N_scaled = sid_ssp_scale_fields((sid_ssp_t*)ssp_N, scale);
                 }
             }
-            U = sum_field(ssp_U, len);
-            total = sum_field(ssp_I, len) + sum_field(ssp_N, len) + U;
+            total = I_scaled + N_scaled + U;
         }
     } else if (total < mixer->C) {
         const double deficit = mixer->C - total;
         if (U > 0.0) {
             const double alpha = deficit / U;
-            sid_ssp_scale_fields(ssp_U, 1.0 + alpha);
+            U = sid_ssp_scale_fields(ssp_U, 1.0 + alpha);
         } else {
             const double amount_per_cell = deficit / (double)len;
-            sid_ssp_add_uniform(ssp_U, amount_per_cell);
+            U = sid_ssp_add_uniform(ssp_U, amount_per_cell);
         }
 
-        U = sum_field(ssp_U, len);
         total = I + N + U;
     }
 
@@ -228,32 +212,13 @@ void sid_mixer_request_collapse(
     assert(sid_ssp_role(ssp_N) == SID_ROLE_N);
     assert(sid_ssp_role(ssp_U) == SID_ROLE_U);
 
-    const uint64_t len = sid_ssp_field_len(ssp_U);
-
-    /* Check for integer overflow in allocation size */
-    const uint64_t MAX_LEN = SIZE_MAX / sizeof(double);
-    if (len > MAX_LEN) return;
+    assert(sid_ssp_field_len(ssp_I) == sid_ssp_field_len(ssp_U));
 
-    double* M_I = (double*)calloc(len, sizeof(double));
-    double* M_N = (double*)calloc(len, sizeof(double));
-    if (!M_I || !M_N) {
-        free(M_I);
-        free(M_N);
-        return;
-    }
-
-    for (uint64_t i = 0; i < len; ++i) M_I[i] = 1.0;
-
-    /* Policy-free stub: uniform admissibility, small alpha */
+    /* Policy-free stub: uniform admissibility (M_I = 1, M_N = 0), small
+     * alpha; N receives nothing, so only I and U are touched */
     const double alpha = 0.01;
-    sid_collapse_mask_t mask = { M_I, M_N, len };
-
-    sid_ssp_route_from_ssp(ssp_I, ssp_U, M_I, alpha);
-    sid_ssp_route_from_ssp(ssp_N, ssp_U, M_N, alpha);
-    sid_ssp_apply_collapse_mask(ssp_U, &mask, alpha);
-
-    free(M_I);
-    free(M_N);
+    (void)ssp_N;
+    sid_ssp_transfer_uniform(ssp_I, ssp_U, alpha, NULL, NULL);
 }
 
 sid_mixer_metrics_t sid_mixer_metrics(const sid_mixer_t* mixer) {
@@ -13,6 +13,113 @@ struct sid_ssp {
     sid_semantic_metrics_t metrics;
 };
 
+/* ========== Chunked field jobs ========== */
+
+/*
+ * Fields of at least parallel_threshold cells run as SID_SSP_CHUNK_CELLS
+ * chunks (a 256 KiB L2-sized slice each), across OpenMP threads when
+ * built with it. Each chunk reduces into its own partial and the partials
+ * are added in chunk order, so masses and metrics depend on the field
+ * length alone, not on the thread count or on OpenMP being present.
+ * Smaller fields take one kernel call on the calling thread.
+ */
+#define SID_SSP_CHUNK_CELLS ((uint64_t)1 << 15)
+
+static uint64_t parallel_threshold = SID_SSP_PARALLEL_MIN_DEFAULT;
+
+typedef enum {
+    FIELD_SUM,
+    FIELD_MOMENTS,
+    FIELD_SCALE,
+    FIELD_ADD,
+    FIELD_ROUTE,
+    FIELD_COLLAPSE,
+    FIELD_TRANSFER
+} field_op_t;
+
+typedef struct {
+    field_op_t op;
+    double* dst;          /* Written field (FIELD_SUM / MOMENTS: read) */
+    double* u;            /* FIELD_TRANSFER: U field */
+    const double* src;    /* FIELD_ROUTE: source field; FIELD_COLLAPSE: M_I */
+    const double* m;      /* FIELD_ROUTE: mask; FIELD_COLLAPSE: M_N */
+    double x;             /* alpha, scale or amount */
+} field_job_t;
+
+/* Run `job` over cells [begin, begin + len) into out[0..2] */
+static void run_chunk(const sid_simd_kernels_t* k, const field_job_t* job,
+                      uint64_t begin, uint64_t len, double out[3]) {
+    double* f = job->dst + begin;
+    out[1] = 0.0;
+    out[2] = 0.0;
+    switch (job->op) {
+        case FIELD_SUM:
+            out[0] = k->sum(f, len);
+            break;
+        case FIELD_MOMENTS:
+            k->moments(f, len, &out[0], &out[1], &out[2]);
+            /* The step into this chunk from the previous one */
+            if (begin > 0) out[2] += fabs(f[0] - f[-1]);
+            break;
+        case FIELD_SCALE:
+            out[0] = k->scale(f, len, job->x);
+            break;
+        case FIELD_ADD:
+            out[0] = k->add_uniform(f, len, job->x);
+            break;
+        case FIELD_ROUTE:
+            out[0] = k->route(f, job->src + begin, job->m + begin, len, job->x);
+            break;
+        case FIELD_COLLAPSE:
+            out[0] = k->collapse_mask(f, job->src + begin, job->m + begin, len, job->x);
+            break;
+        case FIELD_TRANSFER:
+            k->transfer(f, job->u + begin, len, job->x, &out[0], &out[1]);
+            break;
+    }
+}
+
+static void run_job(const field_job_t* job, uint64_t n, double out[3]) {
+    const sid_simd_kernels_t* k = sid_simd_kernels();
+    if (n < parallel_threshold || n <= SID_SSP_CHUNK_CELLS) {
+        run_chunk(k, job, 0, n, out);
+        return;
+    }
+
+    const uint64_t chunks = (n + SID_SSP_CHUNK_CELLS - 1) / SID_SSP_CHUNK_CELLS;
+    double* partials = (double*)malloc(chunks * 3 * sizeof(double));
+    if (!partials) {
+        run_chunk(k, job, 0, n, out);
+        return;
+    }
+
+    const int64_t count = (int64_t)chunks;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t c = 0; c < count; ++c) {
+        const uint64_t begin = (uint64_t)c * SID_SSP_CHUNK_CELLS;
+        const uint64_t len = (n - begin < SID_SSP_CHUNK_CELLS) ? n - begin : SID_SSP_CHUNK_CELLS;
+        run_chunk(k, job, begin, len, partials + 3 * c);
+    }
+
+    out[0] = out[1] = out[2] = 0.0;
+    for (uint64_t c = 0; c < chunks; ++c) {
+        out[0] += partials[3 * c];
+        out[1] += partials[3 * c + 1];
+        out[2] += partials[3 * c + 2];
+    }
+    free(partials);
+}
+
+void sid_ssp_set_parallel_threshold(uint64_t field_len) {
+    parallel_threshold = field_len;
+}
+
+uint64_t sid_ssp_parallel_threshold(void) {
+    return parallel_threshold;
+}
+
 static double clamp01(double x) {
     if (x < 0.0) return 0.0;
     if (x > 1.0) return 1.0;
@@ -22,6 +129,7 @@ static double clamp01(double x) {
 static void compute_metrics(const double* f, uint64_t n, double capacity,
                             sid_semantic_metrics_t* out) {
     assert(out);
+    out->isa = sid_simd_kernels()->isa;
     if (!f || n == 0) {
         out->stability = 0.0;
         out->coherence = 0.0;
@@ -30,15 +138,12 @@ static void compute_metrics(const double* f, uint64_t n, double capacity,
     }
 
     /* Pass 1: Compute sum, variance, and divergence simultaneously */
-    double sum = f[0];
-    double sum_sq = f[0] * f[0];
-    double div = 0.0;
-
-    for (uint64_t i = 1; i < n; ++i) {
-        sum += f[i];
-        sum_sq += f[i] * f[i];
-        div += fabs(f[i] - f[i - 1]);
-    }
+    const field_job_t job = { FIELD_MOMENTS, (double*)f, NULL, NULL, NULL, 0.0 };
+    double moments[3];
+    run_job(&job, n, moments);
+    const double sum = moments[0];
+    const double sum_sq = moments[1];
+    const double div = moments[2];
 
     /* Stability: semantic headroom per spec (clamped) */
     double load = (capacity > 0.0) ? (sum / capacity) : 1.0;
@@ -90,6 +195,7 @@ sid_ssp_t* sid_ssp_create(sid_role_t role, uint64_t field_len,
     ssp->metrics.stability = 0.0;
     ssp->metrics.coherence = 0.0;
     ssp->metrics.divergence = 0.0;
+    ssp->metrics.isa = sid_simd_kernels()->isa;
 
     return ssp;
 }
@@ -121,7 +227,11 @@ void sid_ssp_apply_collapse(sid_ssp_t* ssp, const double* mask, double amount) {
     assert(ssp->role == SID_ROLE_U);
     assert(mask);
 
-    for (uint64_t i = 0; i < ssp->field_len; ++i) {
+    const int64_t n = (int64_t)ssp->field_len;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (ssp->field_len >= parallel_threshold)
+#endif
+    for (int64_t i = 0; i < n; ++i) {
         double delta = mask[i] * amount;
         if (delta < 0.0) delta = 0.0;
         if (delta > ssp->field[i]) delta = ssp->field[i];
@@ -149,7 +259,15 @@ uint64_t sid_ssp_field_len(const sid_ssp_t* ssp) {
     return ssp->field_len;
 }
 
-void sid_ssp_apply_collapse_mask(
+double sid_ssp_mass(const sid_ssp_t* ssp) {
+    assert(ssp);
+    const field_job_t job = { FIELD_SUM, ssp->field, NULL, NULL, NULL, 0.0 };
+    double out[3];
+    run_job(&job, ssp->field_len, out);
+    return out[0];
+}
+
+double sid_ssp_apply_collapse_mask(
     sid_ssp_t* ssp,
     const sid_collapse_mask_t* mask,
     double alpha
@@ -163,24 +281,15 @@ void sid_ssp_apply_collapse_mask(
 
     if (alpha > 1.0) alpha = 1.0;
 
-    /* Spec: U'(x) = U(x) - alpha * (M_I(x) + M_N(x)) * U(x) */
-    for (uint64_t i = 0; i < ssp->field_len; ++i) {
-        double total_mask = mask->M_I[i] + mask->M_N[i];
-
-        /* Enforce constraint: M_I(x) + M_N(x) <= 1 */
-        if (total_mask > 1.0) total_mask = 1.0;
-        if (total_mask < 0.0) total_mask = 0.0;
-
-        double delta = alpha * total_mask * ssp->field[i];
-
-        /* Enforce U'(x) >= 0 */
-        if (delta > ssp->field[i]) delta = ssp->field[i];
-
-        ssp->field[i] -= delta;
-    }
+    /* Spec: U'(x) = U(x) - alpha * (M_I(x) + M_N(x)) * U(x),
+     * with M_I + M_N clamped to [0,1] and U'(x) >= 0 */
+    const field_job_t job = { FIELD_COLLAPSE, ssp->field, NULL, mask->M_I, mask->M_N, alpha };
+    double out[3];
+    run_job(&job, ssp->field_len, out);
+    return out[0];
 }
 
-void sid_ssp_route_from_field(
+double sid_ssp_route_from_field(
     sid_ssp_t* ssp,
     const double* src_field,
     uint64_t src_len,
@@ -193,17 +302,14 @@ void sid_ssp_route_from_field(
     assert(mask);
     assert(alpha >= 0.0);
 
-    for (uint64_t i = 0; i < ssp->field_len; ++i) {
-        double m = mask[i];
-        if (m < 0.0) m = 0.0;
-        if (m > 1.0) m = 1.0;
-        double delta = alpha * m * src_field[i];
-        if (delta < 0.0) delta = 0.0;
-        ssp->field[i] += delta;
-    }
+    (void)src_len;
+    const field_job_t job = { FIELD_ROUTE, ssp->field, NULL, src_field, mask, alpha };
+    double out[3];
+    run_job(&job, ssp->field_len, out);
+    return out[0];
 }
 
-void sid_ssp_route_from_ssp(
+double sid_ssp_route_from_ssp(
     sid_ssp_t* ssp_dst,
     const sid_ssp_t* ssp_src,
     const double* mask,
@@ -216,31 +322,56 @@ void sid_ssp_route_from_ssp(
     assert(ssp_dst->field_len == ssp_src->field_len);
 
     const double* src_field = sid_ssp_field_ro(ssp_src);
-    sid_ssp_route_from_field(ssp_dst, src_field, ssp_src->field_len, mask, alpha);
+    return sid_ssp_route_from_field(ssp_dst, src_field, ssp_src->field_len, mask, alpha);
 }
 
-void sid_ssp_scale_fields(
+double sid_ssp_scale_fields(
     sid_ssp_t* ssp,
     double scale
 ) {
     assert(ssp);
     assert(scale >= 0.0);
 
-    for (uint64_t i = 0; i < ssp->field_len; ++i) {
-        ssp->field[i] *= scale;
-    }
+    const field_job_t job = { FIELD_SCALE, ssp->field, NULL, NULL, NULL, scale };
+    double out[3];
+    run_job(&job, ssp->field_len, out);
+    return out[0];
 }
 
-void sid_ssp_add_uniform(
+double sid_ssp_add_uniform(
     sid_ssp_t* ssp,
     double amount_per_cell
 ) {
     assert(ssp);
     assert(amount_per_cell >= 0.0);
 
-    if (amount_per_cell <= 0.0) return;
+    if (amount_per_cell <= 0.0) return sid_ssp_mass(ssp);
 
-    for (uint64_t i = 0; i < ssp->field_len; ++i) {
-        ssp->field[i] += amount_per_cell;
-    }
+    const field_job_t job = { FIELD_ADD, ssp->field, NULL, NULL, NULL, amount_per_cell };
+    double out[3];
+    run_job(&job, ssp->field_len, out);
+    return out[0];
+}
+
+void sid_ssp_transfer_uniform(
+    sid_ssp_t* ssp_dst,
+    sid_ssp_t* ssp_U,
+    double alpha,
+    double* dst_mass,
+    double* U_mass
+) {
+    assert(ssp_dst);
+    assert(ssp_U);
+    assert(ssp_dst != ssp_U);
+    assert(ssp_U->role == SID_ROLE_U);
+    assert(ssp_dst->field_len == ssp_U->field_len);
+    assert(alpha >= 0.0);
+
+    if (alpha > 1.0) alpha = 1.0;
+
+    const field_job_t job = { FIELD_TRANSFER, ssp_dst->field, ssp_U->field, NULL, NULL, alpha };
+    double out[3];
+    run_job(&job, ssp_U->field_len, out);
+    if (dst_mass) *dst_mass = out[0];
+    if (U_mass) *U_mass = out[1];
 }
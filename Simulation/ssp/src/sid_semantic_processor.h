@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include "sid_simd.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +23,7 @@ typedef struct {
     double stability;   /**< Semantic headroom: 1 - clamp(load), range [0,1] */
     double coherence;   /**< Field uniformity: 1/(1+variance), range (0,1] */
     double divergence;  /**< Mean absolute neighbor difference, range [0,+inf) */
+    sid_simd_isa_t isa; /**< Field kernels that computed these (sid_simd.h) */
 } sid_semantic_metrics_t;
 
 /**
@@ -131,9 +133,11 @@ void sid_ssp_apply_collapse(
  * - M_I(x) + M_N(x) <= 1.0
  * - U'(x) >= 0.0
  *
+ * @return      Mass of the U field afterwards
+ *
  * Thread safety: Not thread-safe
  */
-void sid_ssp_apply_collapse_mask(
+double sid_ssp_apply_collapse_mask(
     sid_ssp_t* ssp,
     const sid_collapse_mask_t* mask,
     double alpha
@@ -147,10 +151,11 @@ void sid_ssp_apply_collapse_mask(
  * @param src_field  Source field array, length must match field_len
  * @param mask       Mask array, length must match field_len, range [0,1]
  * @param alpha      Routing intensity factor, must be >= 0
+ * @return           Mass of the destination field afterwards
  *
  * Thread safety: Not thread-safe
  */
-void sid_ssp_route_from_field(
+double sid_ssp_route_from_field(
     sid_ssp_t* ssp,
     const double* src_field,
     uint64_t src_len,
@@ -166,10 +171,11 @@ void sid_ssp_route_from_field(
  * @param ssp_src Source SSP (must not be NULL)
  * @param mask    Mask array, length must match field_len, range [0,1]
  * @param alpha   Routing intensity factor, must be >= 0
+ * @return        Mass of the destination field afterwards
  *
  * Thread safety: Not thread-safe
  */
-void sid_ssp_route_from_ssp(
+double sid_ssp_route_from_ssp(
     sid_ssp_t* ssp_dst,
     const sid_ssp_t* ssp_src,
     const double* mask,
@@ -181,10 +187,11 @@ void sid_ssp_route_from_ssp(
  *
  * @param ssp   SSP handle (must not be NULL)
  * @param scale Scale factor, must be >= 0
+ * @return      Field mass afterwards
  *
  * Thread safety: Not thread-safe
  */
-void sid_ssp_scale_fields(
+double sid_ssp_scale_fields(
     sid_ssp_t* ssp,
     double scale
 );
@@ -194,14 +201,60 @@ void sid_ssp_scale_fields(
  *
  * @param ssp              SSP handle (must not be NULL)
  * @param amount_per_cell  Amount to add to each cell, must be >= 0
+ * @return                 Field mass afterwards
  *
  * Thread safety: Not thread-safe
  */
-void sid_ssp_add_uniform(
+double sid_ssp_add_uniform(
     sid_ssp_t* ssp,
     double amount_per_cell
 );
 
+/**
+ * Move a fraction of every U cell into a destination SSP in one pass.
+ * Same result as sid_ssp_route_from_ssp(ssp_dst, ssp_U, ones, alpha)
+ * followed by sid_ssp_apply_collapse_mask(ssp_U, {ones, zeros}, alpha),
+ * without building the masks or re-reading either field.
+ *
+ * @param ssp_dst  Destination SSP (must not be NULL, not ssp_U)
+ * @param ssp_U    SSP with role U, same field_len
+ * @param alpha    Fraction moved, range [0,1] (larger values clamp to 1)
+ * @param dst_mass Receives the destination field mass afterwards (NULL ok)
+ * @param U_mass   Receives the U field mass afterwards (NULL ok)
+ *
+ * Thread safety: Not thread-safe
+ */
+void sid_ssp_transfer_uniform(
+    sid_ssp_t* ssp_dst,
+    sid_ssp_t* ssp_U,
+    double alpha,
+    double* dst_mass,
+    double* U_mass
+);
+
+/* ========== Parallel Field Operations ========== */
+
+/** Default field length from which field operations run in parallel */
+#define SID_SSP_PARALLEL_MIN_DEFAULT ((uint64_t)1 << 18)
+
+/**
+ * Set the field length from which field operations (masses, metrics,
+ * routing, collapse, scaling) run as fixed 32768-cell chunks, spread over
+ * OpenMP threads when built with OpenMP. Chunk partials are reduced in
+ * chunk order, so results depend on this threshold but never on the
+ * thread count. UINT64_MAX keeps every field on the calling thread.
+ *
+ * @param field_len Threshold in cells (default SID_SSP_PARALLEL_MIN_DEFAULT)
+ *
+ * Thread safety: Not thread-safe; process-wide
+ */
+void sid_ssp_set_parallel_threshold(uint64_t field_len);
+
+/**
+ * Get the parallel field length threshold.
+ */
+uint64_t sid_ssp_parallel_threshold(void);
+
 /* ========== Observation Interface ========== */
 
 /**
@@ -214,6 +267,16 @@ void sid_ssp_add_uniform(
  */
 sid_semantic_metrics_t sid_ssp_metrics(const sid_ssp_t* ssp);
 
+/**
+ * Field mass (sum of all cells), through the selected SIMD kernels.
+ *
+ * @param ssp SSP handle (must not be NULL)
+ * @return    Sum of the field
+ *
+ * Thread safety: Not thread-safe
+ */
+double sid_ssp_mass(const sid_ssp_t* ssp);
+
 /**
  * Get immutable role.
  *
@@ -1,4 +1,348 @@
 #include "sid_simd.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SID_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SID_SIMD_ARM64 1
+#include <arm_neon.h>
+#endif
+
+/* Per-function ISA targets; MSVC emits any intrinsic without one */
+#if defined(__GNUC__) || defined(__clang__)
+#define SID_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SID_TARGET(isa)
+#endif
+
+/* ========== Scalar reference ========== */
+
+/* Per-cell rules shared by every kernel set (vector tails included) */
+
+static inline double route_delta(double m, double src, double alpha) {
+    if (m < 0.0) m = 0.0;
+    if (m > 1.0) m = 1.0;
+    double delta = alpha * m * src;
+    if (delta < 0.0) delta = 0.0;
+    return delta;
+}
+
+static inline double collapse_delta(double m_I, double m_N, double u, double alpha) {
+    double total_mask = m_I + m_N;
+
+    /* Enforce constraint: M_I(x) + M_N(x) <= 1 */
+    if (total_mask > 1.0) total_mask = 1.0;
+    if (total_mask < 0.0) total_mask = 0.0;
+
+    double delta = alpha * total_mask * u;
+
+    /* Enforce U'(x) >= 0 */
+    if (delta > u) delta = u;
+    return delta;
+}
+
+static double sum_scalar(const double* f, uint64_t n) {
+    double s = 0.0;
+    for (uint64_t i = 0; i < n; ++i) s += f[i];
+    return s;
+}
+
+static void moments_scalar(const double* f, uint64_t n, double* sum, double* sum_sq, double* div) {
+    double s = f[0];
+    double s_sq = f[0] * f[0];
+    double s_div = 0.0;
+    for (uint64_t i = 1; i < n; ++i) {
+        s += f[i];
+        s_sq += f[i] * f[i];
+        s_div += fabs(f[i] - f[i - 1]);
+    }
+    *sum = s;
+    *sum_sq = s_sq;
+    *div = s_div;
+}
+
+static double scale_scalar(double* f, uint64_t n, double scale) {
+    double s = 0.0;
+    for (uint64_t i = 0; i < n; ++i) {
+        f[i] *= scale;
+        s += f[i];
+    }
+    return s;
+}
+
+static double add_uniform_scalar(double* f, uint64_t n, double amount) {
+    double s = 0.0;
+    for (uint64_t i = 0; i < n; ++i) {
+        f[i] += amount;
+        s += f[i];
+    }
+    return s;
+}
+
+static double route_scalar(double* dst, const double* src, const double* mask, uint64_t n, double alpha) {
+    double s = 0.0;
+    for (uint64_t i = 0; i < n; ++i) {
+        dst[i] += route_delta(mask[i], src[i], alpha);
+        s += dst[i];
+    }
+    return s;
+}
+
+static double collapse_mask_scalar(double* u, const double* m_I, const double* m_N, uint64_t n, double alpha) {
+    double s = 0.0;
+    for (uint64_t i = 0; i < n; ++i) {
+        u[i] -= collapse_delta(m_I[i], m_N[i], u[i], alpha);
+        s += u[i];
+    }
+    return s;
+}
+
+static void transfer_scalar(double* dst, double* u, uint64_t n, double alpha, double* dst_sum, double* u_sum) {
+    double s_dst = 0.0;
+    double s_u = 0.0;
+    for (uint64_t i = 0; i < n; ++i) {
+        dst[i] += route_delta(1.0, u[i], alpha);
+        u[i] -= collapse_delta(1.0, 0.0, u[i], alpha);
+        s_dst += dst[i];
+        s_u += u[i];
+    }
+    *dst_sum = s_dst;
+    *u_sum = s_u;
+}
+
+static const sid_simd_kernels_t kernels_scalar = {
+    SID_SIMD_SCALAR,
+    sum_scalar,
+    moments_scalar,
+    scale_scalar,
+    add_uniform_scalar,
+    route_scalar,
+    collapse_mask_scalar,
+    transfer_scalar
+};
+
+/* ========== x86 ========== */
+
+#ifdef SID_SIMD_X86
+
+static SID_TARGET("sse2") inline double hsum_sse2(__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+#define SID_SUFFIX sse2
+#define SID_ISA SID_SIMD_SSE2
+#define SID_KERNEL static SID_TARGET("sse2")
+#define SID_V __m128d
+#define SID_W 2
+#define SID_LOAD(p) _mm_loadu_pd(p)
+#define SID_STORE(p, v) _mm_storeu_pd((p), (v))
+#define SID_SET1(x) _mm_set1_pd(x)
+#define SID_ZERO() _mm_setzero_pd()
+#define SID_ADD(a, b) _mm_add_pd((a), (b))
+#define SID_SUB(a, b) _mm_sub_pd((a), (b))
+#define SID_MUL(a, b) _mm_mul_pd((a), (b))
+#define SID_MIN(a, b) _mm_min_pd((a), (b))
+#define SID_MAX(a, b) _mm_max_pd((a), (b))
+#define SID_ABS(v) _mm_andnot_pd(_mm_set1_pd(-0.0), (v))
+#define SID_HSUM(v) hsum_sse2(v)
+#include "sid_simd_kernels.inc"
+
+static SID_TARGET("avx2") inline double hsum_avx2(__m256d v) {
+    const __m128d half = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+}
+
+#define SID_SUFFIX avx2
+#define SID_ISA SID_SIMD_AVX2
+#define SID_KERNEL static SID_TARGET("avx2")
+#define SID_V __m256d
+#define SID_W 4
+#define SID_LOAD(p) _mm256_loadu_pd(p)
+#define SID_STORE(p, v) _mm256_storeu_pd((p), (v))
+#define SID_SET1(x) _mm256_set1_pd(x)
+#define SID_ZERO() _mm256_setzero_pd()
+#define SID_ADD(a, b) _mm256_add_pd((a), (b))
+#define SID_SUB(a, b) _mm256_sub_pd((a), (b))
+#define SID_MUL(a, b) _mm256_mul_pd((a), (b))
+#define SID_MIN(a, b) _mm256_min_pd((a), (b))
+#define SID_MAX(a, b) _mm256_max_pd((a), (b))
+#define SID_ABS(v) _mm256_andnot_pd(_mm256_set1_pd(-0.0), (v))
+#define SID_HSUM(v) hsum_avx2(v)
+#include "sid_simd_kernels.inc"
+
+#define SID_SUFFIX avx512
+#define SID_ISA SID_SIMD_AVX512
+#define SID_KERNEL static SID_TARGET("avx512f")
+#define SID_V __m512d
+#define SID_W 8
+#define SID_LOAD(p) _mm512_loadu_pd(p)
+#define SID_STORE(p, v) _mm512_storeu_pd((p), (v))
+#define SID_SET1(x) _mm512_set1_pd(x)
+#define SID_ZERO() _mm512_setzero_pd()
+#define SID_ADD(a, b) _mm512_add_pd((a), (b))
+#define SID_SUB(a, b) _mm512_sub_pd((a), (b))
+#define SID_MUL(a, b) _mm512_mul_pd((a), (b))
+#define SID_MIN(a, b) _mm512_min_pd((a), (b))
+#define SID_MAX(a, b) _mm512_max_pd((a), (b))
+#define SID_ABS(v) _mm512_abs_pd(v)
+#define SID_HSUM(v) _mm512_reduce_add_pd(v)
+#include "sid_simd_kernels.inc"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+static void x86_features(int* sse2, int* avx2, int* avx512) {
+    int r[4];
+    __cpuid(r, 0);
+    const int max_leaf = r[0];
+    __cpuid(r, 1);
+    *sse2 = (r[3] >> 26) & 1;
+    const int os_xsave = (r[2] >> 27) & 1;
+    const unsigned long long xcr0 = os_xsave ? _xgetbv(0) : 0;
+    int leaf7_ebx = 0;
+    if (max_leaf >= 7) {
+        __cpuidex(r, 7, 0);
+        leaf7_ebx = r[1];
+    }
+    /* The OS must save YMM (XCR0 bits 1-2) and ZMM / opmask (5-7) state */
+    *avx2 = ((xcr0 & 0x6) == 0x6) && ((leaf7_ebx >> 5) & 1);
+    *avx512 = ((xcr0 & 0xe6) == 0xe6) && ((leaf7_ebx >> 16) & 1);
+}
+#elif defined(__GNUC__) || defined(__clang__)
+static void x86_features(int* sse2, int* avx2, int* avx512) {
+    __builtin_cpu_init();
+    *sse2 = __builtin_cpu_supports("sse2") != 0;
+    *avx2 = __builtin_cpu_supports("avx2") != 0;
+    *avx512 = __builtin_cpu_supports("avx512f") != 0;
+}
+#else
+static void x86_features(int* sse2, int* avx2, int* avx512) {
+#if defined(__SSE2__) || defined(_M_X64)
+    *sse2 = 1;
+#else
+    *sse2 = 0;
+#endif
+    *avx2 = 0;
+    *avx512 = 0;
+}
+#endif
+
+#endif /* SID_SIMD_X86 */
+
+/* ========== AArch64 ========== */
+
+#ifdef SID_SIMD_ARM64
+
+#define SID_SUFFIX neon
+#define SID_ISA SID_SIMD_NEON
+#define SID_KERNEL static
+#define SID_V float64x2_t
+#define SID_W 2
+#define SID_LOAD(p) vld1q_f64(p)
+#define SID_STORE(p, v) vst1q_f64((p), (v))
+#define SID_SET1(x) vdupq_n_f64(x)
+#define SID_ZERO() vdupq_n_f64(0.0)
+#define SID_ADD(a, b) vaddq_f64((a), (b))
+#define SID_SUB(a, b) vsubq_f64((a), (b))
+#define SID_MUL(a, b) vmulq_f64((a), (b))
+#define SID_MIN(a, b) vminq_f64((a), (b))
+#define SID_MAX(a, b) vmaxq_f64((a), (b))
+#define SID_ABS(v) vabsq_f64(v)
+#define SID_HSUM(v) vaddvq_f64(v)
+#include "sid_simd_kernels.inc"
+
+#endif /* SID_SIMD_ARM64 */
+
+/* ========== Dispatch ========== */
+
+static const sid_simd_kernels_t* active = NULL;
+
+static const sid_simd_kernels_t* kernels_for(sid_simd_isa_t isa) {
+    if (!sid_simd_supported(isa)) return NULL;
+    switch (isa) {
+        case SID_SIMD_SCALAR: return &kernels_scalar;
+#ifdef SID_SIMD_X86
+        case SID_SIMD_SSE2:   return &kernels_sse2;
+        case SID_SIMD_AVX2:   return &kernels_avx2;
+        case SID_SIMD_AVX512: return &kernels_avx512;
+#endif
+#ifdef SID_SIMD_ARM64
+        case SID_SIMD_NEON:   return &kernels_neon;
+#endif
+        default:              return NULL;
+    }
+}
+
+int sid_simd_supported(sid_simd_isa_t isa) {
+    switch (isa) {
+        case SID_SIMD_SCALAR:
+            return 1;
+#ifdef SID_SIMD_X86
+        case SID_SIMD_SSE2:
+        case SID_SIMD_AVX2:
+        case SID_SIMD_AVX512: {
+            static int probed = 0, sse2 = 0, avx2 = 0, avx512 = 0;
+            if (!probed) {
+                x86_features(&sse2, &avx2, &avx512);
+                probed = 1;
+            }
+            return isa == SID_SIMD_SSE2 ? sse2 : (isa == SID_SIMD_AVX2 ? avx2 : avx512);
+        }
+#endif
+#ifdef SID_SIMD_ARM64
+        case SID_SIMD_NEON:
+            return 1;   /* Mandatory on AArch64 */
+#endif
+        default:
+            return 0;
+    }
+}
 
 void sid_simd_init(void) {
+    if (active) return;
+
+    const char* forced = getenv("SID_SIMD");
+    if (forced) {
+        for (int isa = SID_SIMD_SCALAR; isa <= SID_SIMD_NEON; ++isa) {
+            if (strcmp(forced, sid_simd_isa_name((sid_simd_isa_t)isa)) == 0) {
+                active = kernels_for((sid_simd_isa_t)isa);
+                break;
+            }
+        }
+        if (active) return;
+    }
+
+    static const sid_simd_isa_t preferred[] = {
+        SID_SIMD_AVX512, SID_SIMD_AVX2, SID_SIMD_NEON, SID_SIMD_SSE2, SID_SIMD_SCALAR
+    };
+    for (size_t k = 0; k < sizeof(preferred) / sizeof(preferred[0]) && !active; ++k) {
+        active = kernels_for(preferred[k]);
+    }
+}
+
+const sid_simd_kernels_t* sid_simd_kernels(void) {
+    if (!active) sid_simd_init();
+    return active;
+}
+
+int sid_simd_select(sid_simd_isa_t isa) {
+    const sid_simd_kernels_t* table = kernels_for(isa);
+    if (!table) return 0;
+    active = table;
+    return 1;
+}
+
+const char* sid_simd_isa_name(sid_simd_isa_t isa) {
+    switch (isa) {
+        case SID_SIMD_SCALAR: return "scalar";
+        case SID_SIMD_SSE2:   return "sse2";
+        case SID_SIMD_AVX2:   return "avx2";
+        case SID_SIMD_AVX512: return "avx512";
+        case SID_SIMD_NEON:   return "neon";
+        default:              return "unknown";
+    }
 }
@@ -1,11 +1,97 @@
 #pragma once
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Instruction sets the SSP / mixer field kernels are built for.
+ * Values are stable (reported through sid_semantic_metrics_t.isa).
+ */
+typedef enum {
+    SID_SIMD_SCALAR = 0,  /**< Portable C loops (reference results) */
+    SID_SIMD_SSE2   = 1,  /**< x86 SSE2, 2 doubles per vector */
+    SID_SIMD_AVX2   = 2,  /**< x86 AVX2, 4 doubles per vector */
+    SID_SIMD_AVX512 = 3,  /**< x86 AVX-512F, 8 doubles per vector */
+    SID_SIMD_NEON   = 4   /**< AArch64 Advanced SIMD, 2 doubles per vector */
+} sid_simd_isa_t;
+
+/**
+ * Field kernel dispatch table.
+ * Every kernel that writes a field returns that field's mass (sum of its
+ * cells) afterwards, computed in the same pass, so callers that need the
+ * mass do not read the field again.
+ *
+ * Vector kernels sum in lanes and may contract multiply-adds, so their
+ * results can differ from SID_SIMD_SCALAR in the last bits.
+ */
+typedef struct {
+    sid_simd_isa_t isa;
+
+    /** Sum of f[0..n) */
+    double (*sum)(const double* f, uint64_t n);
+
+    /** Sum, sum of squares and sum of |f[i] - f[i-1]| of f[0..n), n > 0 */
+    void (*moments)(const double* f, uint64_t n, double* sum, double* sum_sq, double* div);
+
+    /** f *= scale; returns sum(f) */
+    double (*scale)(double* f, uint64_t n, double scale);
+
+    /** f += amount; returns sum(f) */
+    double (*add_uniform)(double* f, uint64_t n, double amount);
+
+    /** dst += max(alpha * clamp01(mask) * src, 0); returns sum(dst) */
+    double (*route)(double* dst, const double* src, const double* mask, uint64_t n, double alpha);
+
+    /** u -= min(alpha * clamp01(m_I + m_N) * u, u); returns sum(u) */
+    double (*collapse_mask)(double* u, const double* m_I, const double* m_N, uint64_t n, double alpha);
+
+    /**
+     * Fused route + collapse with a uniform mask (M = 1 everywhere):
+     * dst += alpha * u, then u -= alpha * u, one pass over both fields.
+     * Writes sum(dst) and sum(u) afterwards.
+     */
+    void (*transfer)(double* dst, double* u, uint64_t n, double alpha, double* dst_sum, double* u_sum);
+} sid_simd_kernels_t;
+
+/**
+ * Select the widest kernels the CPU supports (idempotent).
+ * The environment variable SID_SIMD (scalar, sse2, avx2, avx512, neon)
+ * overrides the choice when that set is supported.
+ *
+ * Thread safety: Not thread-safe; call once before sharing SSPs
+ */
 void sid_simd_init(void);
 
+/**
+ * Current kernel table (calls sid_simd_init() on first use).
+ *
+ * @return Table valid for the life of the process
+ */
+const sid_simd_kernels_t* sid_simd_kernels(void);
+
+/**
+ * Force a kernel set, e.g. SID_SIMD_SCALAR for reference results.
+ *
+ * @param isa Instruction set to use
+ * @return    1 if supported and selected, 0 otherwise (selection unchanged)
+ *
+ * Thread safety: Not thread-safe
+ */
+int sid_simd_select(sid_simd_isa_t isa);
+
+/**
+ * Whether kernels for `isa` are built in and the CPU runs them.
+ */
+int sid_simd_supported(sid_simd_isa_t isa);
+
+/**
+ * Lower-case name of `isa` ("scalar", "sse2", "avx2", "avx512", "neon"),
+ * "unknown" for other values.
+ */
+const char* sid_simd_isa_name(sid_simd_isa_t isa);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,278 @@
+// In-process step runner shared by dase_step_runner and sid_step_runner.
+#include "step_runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "command_router.h"
+#include "line_server.h"
+
+namespace engine_api {
+
+namespace {
+
+bool contains(const std::vector<std::string>& keys, const std::string& key) {
+    return std::find(keys.begin(), keys.end(), key) != keys.end();
+}
+
+// A dropped member takes its own trailing comma with it; when it was the
+// last member the previous comma stays, exactly as the old
+// `"key"\s*:\s*[^,}]+,?` replacement left it
+void write_canonical(const json& value, const NormalizeProfile& profile, std::string& out) {
+    if (value.is_object()) {
+        out.push_back('{');
+        size_t remaining = value.size();
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            --remaining;
+            if (!it->is_structured() && contains(profile.dropped_keys, it.key())) continue;
+            out += json(it.key()).dump();
+            out.push_back(':');
+            if (it->is_string() && contains(profile.masked_keys, it.key())) {
+                out += "\"eng\"";
+            } else {
+                write_canonical(*it, profile, out);
+            }
+            if (remaining > 0) out.push_back(',');
+        }
+        out.push_back('}');
+    } else if (value.is_array()) {
+        out.push_back('[');
+        for (size_t i = 0; i < value.size(); ++i) {
+            if (i > 0) out.push_back(',');
+            write_canonical(value[i], profile, out);
+        }
+        out.push_back(']');
+    } else {
+        out += value.dump();
+    }
+}
+
+// Last numeric `key` in serialization order
+bool find_last_number(const json& value, const std::string& key, double& found) {
+    bool any = false;
+    if (value.is_object()) {
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            if (it.key() == key && it->is_number()) {
+                found = it->get<double>();
+                any = true;
+            }
+            any = find_last_number(*it, key, found) || any;
+        }
+    } else if (value.is_array()) {
+        for (const auto& element : value) {
+            any = find_last_number(element, key, found) || any;
+        }
+    }
+    return any;
+}
+
+bool read_file(const std::filesystem::path& path, std::string& content, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        error = "cannot open input: " + path.string();
+        return false;
+    }
+    content.assign(std::istreambuf_iterator<char>(in), {});
+    return true;
+}
+
+bool write_result(const std::filesystem::path& path, const StepResult& result) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+    out << "{\n";
+    out << "  \"status\": \"ok\",\n";
+    out << "  \"hash\": \"" << result.hash << "\",\n";
+    out << "  \"metrics\": {\"state_norm\": " << result.state_norm << "}\n";
+    out << "}\n";
+    return true;
+}
+
+template <typename Fn>
+void for_each_command(const std::string& payload, Fn&& fn) {
+    std::stringstream lines(payload);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (!fn(line)) return;
+    }
+}
+
+StepResult run_case(const StepCase& step_case, const NormalizeProfile& profile, const std::string& server) {
+    StepResult result;
+    std::string payload;
+    std::vector<json> messages;
+    if (!read_file(step_case.input, payload, result.error)) {
+        return result;
+    }
+    const bool ran = server.empty() ? run_in_process(payload, messages, result.error)
+                                    : run_on_server(server, payload, messages, result.error);
+    if (!ran) {
+        return result;
+    }
+    result = summarize(messages, profile);
+    if (!write_result(step_case.output, result)) {
+        result.ok = false;
+        result.error = "cannot open output: " + step_case.output.string();
+    }
+    return result;
+}
+
+}  // namespace
+
+NormalizeProfile dase_profile() {
+    return {{"execution_time_ms", "ns_per_op", "ops_per_sec", "speedup_factor"}, {"engine_id"}};
+}
+
+NormalizeProfile sid_profile() {
+    return {{"execution_time_ms"}, {"engine_id"}};
+}
+
+std::string fnv1a_64(const std::string& data) {
+    std::uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : data) {
+        h ^= static_cast<std::uint64_t>(c);
+        h *= 1099511628211ull;
+    }
+    std::ostringstream oss;
+    oss << std::hex << h;
+    return oss.str();
+}
+
+std::string canonical_response(const json& response, const NormalizeProfile& profile) {
+    std::string out;
+    write_canonical(response, profile, out);
+    return out;
+}
+
+bool run_in_process(const std::string& payload, std::vector<json>& messages, std::string& /*error*/) {
+    CommandRouter router;
+    router.setStreamSink([&messages](const json& message, dase::protocol::Segments& /*segments*/) {
+        messages.push_back(message);
+    });
+    // Malformed lines and handler exceptions became error replies on the
+    // CLI's stdout, which the canonical form drops anyway
+    for_each_command(payload, [&](const std::string& line) {
+        json command = json::parse(line, nullptr, false);
+        if (command.is_discarded()) return true;
+        try {
+            messages.push_back(router.execute(command));
+        } catch (const std::exception&) {
+        }
+        return true;
+    });
+    return true;
+}
+
+// Streamed run_mission_with_snapshots chunks precede the command's final reply.
+bool run_on_server(const std::string& endpoint_spec, const std::string& payload,
+                   std::vector<json>& messages, std::string& error) {
+    dase::LineEndpoint endpoint;
+    dase::LineClient client;
+    if (!dase::LineEndpoint::parse(endpoint_spec, endpoint, error) || !client.connect(endpoint, error)) {
+        return false;
+    }
+    bool ok = true;
+    for_each_command(payload, [&](const std::string& line) {
+        if (!client.writeLine(line)) {
+            error = "server closed the connection";
+            return ok = false;
+        }
+        json reply;
+        do {
+            std::string text;
+            if (!client.readLine(text)) {
+                error = "server closed the connection";
+                return ok = false;
+            }
+            reply = json::parse(text, nullptr, false);
+            if (!reply.is_discarded()) messages.push_back(reply);
+        } while (reply.is_object() && reply.value("status", "") == "streaming");
+        return true;
+    });
+    return ok;
+}
+
+StepResult summarize(const std::vector<json>& messages, const NormalizeProfile& profile) {
+    StepResult result;
+    std::string normalized;
+    for (const auto& message : messages) {
+        if (message.is_object() && message.value("status", "") == "success") {
+            write_canonical(message, profile, normalized);
+            normalized.push_back('\n');
+        }
+        find_last_number(message, "state_norm", result.state_norm);
+    }
+    result.ok = true;
+    result.hash = fnv1a_64(normalized);
+    return result;
+}
+
+std::vector<StepResult> run_cases(const std::vector<StepCase>& cases,
+                                  const NormalizeProfile& profile,
+                                  const std::string& server,
+                                  unsigned jobs) {
+    std::vector<StepResult> results(cases.size());
+    if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+    if (!server.empty()) jobs = 1;
+    jobs = std::min<unsigned>(jobs, static_cast<unsigned>(std::max<size_t>(1, cases.size())));
+
+    std::atomic<size_t> next{0};
+    const auto worker = [&]() {
+        for (size_t i = next++; i < cases.size(); i = next++) {
+            results[i] = run_case(cases[i], profile, server);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < jobs; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+    return results;
+}
+
+int step_runner_main(int argc, char** argv, const char* name, const NormalizeProfile& profile) {
+    std::vector<std::string> paths;
+    std::string server;
+    unsigned jobs = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, 9, "--server=") == 0) {
+            server = arg.substr(9);
+        } else if (arg.compare(0, 7, "--jobs=") == 0) {
+            jobs = static_cast<unsigned>(std::stoul(arg.substr(7)));
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty() || paths.size() % 2 != 0) {
+        std::cerr << "usage: " << name << " <input.json> <output.json> [<input> <output> ...]"
+                  << " [--jobs=N] [--server=<endpoint>]\n";
+        return 1;
+    }
+
+    std::vector<StepCase> cases;
+    for (size_t i = 0; i < paths.size(); i += 2) {
+        if (!std::filesystem::exists(paths[i])) {
+            std::cerr << "input missing: " << paths[i] << "\n";
+            return 1;
+        }
+        cases.push_back({paths[i], paths[i + 1]});
+    }
+
+    int rc = 0;
+    const auto results = run_cases(cases, profile, server, jobs);
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!results[i].ok) {
+            std::cerr << cases[i].input.string() << ": " << results[i].error << "\n";
+            rc = 1;
+        }
+    }
+    return rc;
+}
+
+}  // namespace engine_api
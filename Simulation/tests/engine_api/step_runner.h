@@ -0,0 +1,66 @@
+// In-process step runner shared by dase_step_runner and sid_step_runner.
+//
+// A step file is JSON lines of CLI commands.  Each file runs against its own
+// CommandRouter (the state a freshly spawned CLI would start from), so
+// several files run in parallel in one process.  The canonical output is
+// built by walking the response JSON: success responses only, volatile keys
+// (timings, throughput) dropped and engine ids masked.  It is byte-for-byte
+// the text the former regex pass produced over the CLI's stdout, so existing
+// golden hashes still hold.
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+namespace engine_api {
+
+using json = nlohmann::json;
+
+struct NormalizeProfile {
+    std::vector<std::string> dropped_keys;   // Scalar members removed wherever they appear
+    std::vector<std::string> masked_keys;    // String members replaced with "eng"
+};
+
+// execution_time_ms, ns_per_op, ops_per_sec and speedup_factor dropped
+NormalizeProfile dase_profile();
+// execution_time_ms dropped (SID metrics are deterministic)
+NormalizeProfile sid_profile();
+
+std::string fnv1a_64(const std::string& data);
+
+// One response in canonical form (no trailing newline)
+std::string canonical_response(const json& response, const NormalizeProfile& profile);
+
+struct StepCase {
+    std::filesystem::path input;
+    std::filesystem::path output;
+};
+
+struct StepResult {
+    bool ok = false;
+    std::string error;
+    std::string hash;
+    double state_norm = 0.0;   // Last state_norm in the transcript, 0 if none
+};
+
+// Every message the commands produced, streamed chunks ahead of their reply
+bool run_in_process(const std::string& payload, std::vector<json>& messages, std::string& error);
+bool run_on_server(const std::string& endpoint_spec, const std::string& payload,
+                   std::vector<json>& messages, std::string& error);
+
+StepResult summarize(const std::vector<json>& messages, const NormalizeProfile& profile);
+
+// Runs the cases on up to `jobs` threads (0 = hardware concurrency) and
+// writes each output JSON; with a server endpoint the cases run one at a
+// time, since they share the server's engine ids
+std::vector<StepResult> run_cases(const std::vector<StepCase>& cases,
+                                  const NormalizeProfile& profile,
+                                  const std::string& server,
+                                  unsigned jobs);
+
+// Command-line entry point of both runners
+int step_runner_main(int argc, char** argv, const char* name, const NormalizeProfile& profile);
+
+}  // namespace engine_api
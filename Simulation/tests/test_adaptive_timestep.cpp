@@ -0,0 +1,215 @@
+/**
+ * Adaptive timestep test
+ *
+ * IGSOA runMissionAdaptive must land exactly on the target time, beat a
+ * fixed step of the same step count against a fine fixed-step reference,
+ * reject an oversized first step and deliver the same total drive as the
+ * fixed-step schedule.  SATP satpEvolveAdaptive must keep
+ * dt within the CFL bound and reach the target time with finite fields.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma tests/test_adaptive_timestep.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_physics_1d.h"
+#include "../src/cpp/satp_higgs_adaptive.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase;
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+IGSOAComplexConfig makeConfig(double dt) {
+    IGSOAComplexConfig config;
+    config.num_nodes = 64;
+    config.R_c_default = 3.0;
+    config.dt = dt;
+    config.normalize_psi = false;
+    config.update_mode = IGSOAUpdateMode::DoubleBuffered;
+    return config;
+}
+
+void seed(IGSOAComplexEngine& engine) {
+    for (size_t i = 0; i < engine.getNumNodes(); ++i) {
+        const double x = static_cast<double>(i) / engine.getNumNodes();
+        engine.setNodePsi(i, std::exp(-40.0 * (x - 0.5) * (x - 0.5)), 0.0);
+    }
+}
+
+double maxError(const IGSOAComplexEngine& a, const IGSOAComplexEngine& b) {
+    double error = 0.0;
+    for (size_t i = 0; i < a.getNodes().size(); ++i) {
+        error = std::max(error, std::abs(a.getNodes()[i].psi - b.getNodes()[i].psi));
+        error = std::max(error, std::abs(a.getNodes()[i].phi - b.getNodes()[i].phi));
+    }
+    return error;
+}
+
+void checkIgsoa() {
+    const double T = 2.0;
+
+    IGSOAComplexEngine reference(makeConfig(1.0e-4));
+    seed(reference);
+    reference.runMission(static_cast<uint64_t>(T / 1.0e-4 + 0.5));
+
+    AdaptiveStepOptions options;
+    options.dt_min = 1.0e-5;
+    options.dt_max = 0.5;
+    options.tolerance = 1.0e-5;
+
+    IGSOAComplexEngine adaptive(makeConfig(0.01));
+    seed(adaptive);
+    const AdaptiveStepStats stats = adaptive.runMissionAdaptive(T, options);
+    const double adaptive_error = maxError(adaptive, reference);
+    std::cout << "  IGSOA adaptive: " << stats.accepted_steps << " accepted, " << stats.rejected_steps
+              << " rejected, dt " << stats.dt_min_used << " .. " << stats.dt_max_used
+              << ", error " << adaptive_error << std::endl;
+
+    expect(std::abs(adaptive.getCurrentTime() - T) < 1.0e-12, "adaptive run lands on the target time");
+    expect(std::abs(stats.simulated_time - T) < 1.0e-12, "stats record the simulated time");
+    expect(adaptive.getTotalSteps() == stats.accepted_steps, "total steps count accepted steps");
+    expect(stats.dt_max_used <= options.dt_max && stats.dt_min_used >= options.dt_min * 0.5,
+           "dt stays within bounds (last step may be split)");
+
+    // Fixed step taking as many steps as the adaptive run
+    IGSOAComplexEngine fixed(makeConfig(T / static_cast<double>(stats.accepted_steps)));
+    seed(fixed);
+    fixed.runMission(stats.accepted_steps);
+    const double fixed_error = maxError(fixed, reference);
+    std::cout << "  fixed dt " << T / stats.accepted_steps << ": error " << fixed_error << std::endl;
+    // Local errors within tolerance bound the global error by steps · tolerance
+    expect(adaptive_error < stats.accepted_steps * options.tolerance, "global error within summed tolerance");
+    expect(adaptive_error < fixed_error, "adaptive beats a fixed step at the same step count");
+    expect(stats.accepted_steps < 2000, "adaptive run takes far fewer steps than the reference");
+
+    // An oversized first trial is rejected and the run still converges
+    options.dt_initial = 0.5;
+    IGSOAComplexEngine oversized(makeConfig(0.01));
+    seed(oversized);
+    const AdaptiveStepStats rejected = oversized.runMissionAdaptive(T, options);
+    expect(rejected.rejected_steps > 0, "oversized first step is rejected");
+    expect(maxError(oversized, reference) < rejected.accepted_steps * options.tolerance,
+           "run after rejection stays accurate");
+
+    // The configured dt is restored for fixed-step missions
+    oversized.runMission(1);
+    expect(std::abs(oversized.getCurrentTime() - (T + 0.01)) < 1.0e-12, "configured dt restored");
+}
+
+void checkDriving() {
+    // Steps equal to the sample interval reproduce runMission's schedule
+    const int steps = 20;
+    std::vector<double> signal(steps), control(steps);
+    for (int i = 0; i < steps; ++i) {
+        signal[i] = 0.01 * std::sin(i * 0.3);
+        control[i] = 0.01 * std::cos(i * 0.3);
+    }
+
+    IGSOAComplexEngine fixed(makeConfig(0.01));
+    seed(fixed);
+    fixed.runMission(steps, signal.data(), control.data());
+
+    IGSOADrivingSchedule schedule;
+    schedule.input_signals = signal.data();
+    schedule.control_patterns = control.data();
+    schedule.count = steps;
+    schedule.interval = 0.01;
+    double s = 0.0, c = 0.0;
+    schedule.sum(0.0, steps * 0.01, s, c);
+    double expected = 0.0;
+    for (double v : signal) expected += v;
+    expect(std::abs(s - expected) < 1.0e-15, "schedule sums every sample once over the run");
+    schedule.sum(0.0, 0.01, s, c);
+    expect(s == signal[0], "one sample per interval");
+
+    AdaptiveStepOptions options;
+    options.dt_min = 0.01;
+    options.dt_max = 0.01;
+    IGSOAComplexEngine adaptive(makeConfig(0.01));
+    seed(adaptive);
+    adaptive.runMissionAdaptive(steps * 0.01, options, schedule);
+    // Accepted states are the dt/2 pair, so compare against the fixed run
+    // loosely: the drive must have been applied, not dropped or doubled
+    double phi_fixed = 0.0, phi_adaptive = 0.0;
+    for (size_t i = 0; i < fixed.getNodes().size(); ++i) {
+        phi_fixed += fixed.getNodes()[i].phi;
+        phi_adaptive += adaptive.getNodes()[i].phi;
+    }
+    expect(std::abs(phi_adaptive - phi_fixed) < 0.05 * std::abs(phi_fixed) + 1.0e-9,
+           "time-scheduled drive matches the step-scheduled drive");
+}
+
+void checkIgsoa2D() {
+    IGSOAComplexConfig config = makeConfig(0.01);
+    config.num_nodes = 16 * 16;
+    IGSOAComplexEngine2D engine(config, 16, 16);
+    engine.setNodePsi(8, 8, 1.0, 0.0);
+    AdaptiveStepOptions options;
+    options.dt_max = 0.2;
+    options.tolerance = 1.0e-4;
+    const AdaptiveStepStats stats = engine.runMissionAdaptive(0.5, options);
+    expect(std::abs(engine.getCurrentTime() - 0.5) < 1.0e-12, "2D adaptive run lands on the target time");
+    expect(stats.accepted_steps > 0 && std::isfinite(std::abs(engine.getNodes()[8 * 16 + 8].psi)),
+           "2D adaptive run stays finite");
+}
+
+void checkSatp() {
+    using namespace dase::satp_higgs;
+    SATPHiggsParams params;
+    const double dx = 0.1;
+    SATPHiggsEngine1D engine(128, dx, 0.001, params);
+    auto& nodes = engine.getNodesMutable();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const double x = (static_cast<double>(i) - 64.0) * dx;
+        nodes[i].phi = 0.5 * std::exp(-x * x);
+    }
+
+    AdaptiveStepOptions options;
+    options.dt_min = 1.0e-4;
+    options.dt_max = 1.0;
+    options.cfl = 0.5;
+    const double bound = satpStableTimestep(engine.getNodes(), engine.getParams(), dx, 1);
+    const AdaptiveStepStats stats = satpEvolveAdaptive(engine, 1, 3.0, options);
+    std::cout << "  SATP adaptive: " << stats.accepted_steps << " steps, dt " << stats.dt_min_used
+              << " .. " << stats.dt_max_used << " (stable " << bound << ")" << std::endl;
+
+    expect(std::abs(engine.getTime() - 3.0) < 1.0e-9, "SATP run lands on the target time");
+    expect(stats.dt_max_used <= bound * 1.0001 && stats.dt_max_used < dx, "SATP dt within the CFL bound");
+    expect(stats.rejected_steps == 0, "SATP stability control never rejects");
+    expect(engine.getDt() == 0.001, "SATP configured dt restored");
+    bool finite = true;
+    for (const auto& node : engine.getNodes()) {
+        finite = finite && std::isfinite(node.phi) && std::isfinite(node.h);
+    }
+    expect(finite, "SATP fields stay finite");
+}
+
+} // namespace
+
+int main() {
+    checkIgsoa();
+    checkDriving();
+    checkIgsoa2D();
+    checkSatp();
+
+    if (failures == 0) {
+        std::cout << "Adaptive timestep: PASS" << std::endl;
+        return 0;
+    }
+    return 1;
+}
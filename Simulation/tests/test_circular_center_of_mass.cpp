@@ -0,0 +1,202 @@
+/**
+ * Circular centre-of-mass test
+ *
+ * The tabulated, separable centre of mass (circular_statistics.h) of the
+ * SATP 1D / 2D / 3D and IGSOA 3D engines must match the per-cell cos / sin
+ * reference to round-off, follow a blob across the periodic seam, and be
+ * bit-identical for any OpenMP thread count.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_circular_center_of_mass.cpp
+ */
+
+#include "../src/cpp/circular_statistics.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_physics_2d.h"
+#include "../src/cpp/satp_higgs_physics_3d.h"
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool close(double a, double b) {
+    return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b));
+}
+
+// Per-cell reference: weights w[i] on an nx × ny × nz lattice, x fastest
+void referenceCenter(const std::vector<double>& w, size_t nx, size_t ny, size_t nz, double cm[3]) {
+    const size_t extent[3] = {nx, ny, nz};
+    double sum = 0.0, c[3] = {0.0, 0.0, 0.0}, s[3] = {0.0, 0.0, 0.0};
+    for (size_t z = 0; z < nz; ++z) {
+        for (size_t y = 0; y < ny; ++y) {
+            for (size_t x = 0; x < nx; ++x) {
+                const double weight = w[(z * ny + y) * nx + x];
+                const size_t coord[3] = {x, y, z};
+                sum += weight;
+                for (int axis = 0; axis < 3; ++axis) {
+                    const double theta = 2.0 * M_PI * static_cast<double>(coord[axis]) /
+                                         static_cast<double>(extent[axis]);
+                    c[axis] += weight * std::cos(theta);
+                    s[axis] += weight * std::sin(theta);
+                }
+            }
+        }
+    }
+    for (int axis = 0; axis < 3; ++axis) {
+        cm[axis] = sum > 1e-12 ? dase::circularMean(c[axis], s[axis], extent[axis]) : 0.0;
+    }
+}
+
+// Gaussian blob centred at (cx, cy, cz) with periodic distance
+double blob(size_t x, size_t y, size_t z, const size_t n[3], const double c[3]) {
+    const double coord[3] = {static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)};
+    double r2 = 0.0;
+    for (int axis = 0; axis < 3; ++axis) {
+        double d = std::abs(coord[axis] - c[axis]);
+        d = std::min(d, static_cast<double>(n[axis]) - d);
+        r2 += d * d;
+    }
+    return std::exp(-r2 / 8.0);
+}
+
+void testSatp2D() {
+    using namespace dase::satp_higgs;
+    const size_t n[3] = {48, 30, 1};
+    const double center[3] = {1.0, 28.5, 0.0};   // Straddles both seams
+    SATPHiggsEngine2D engine(n[0], n[1], 0.1, 0.01, SATPHiggsParams());
+    std::vector<double> w(n[0] * n[1]);
+    for (size_t y = 0; y < n[1]; ++y) {
+        for (size_t x = 0; x < n[0]; ++x) {
+            const double phi = (x % 2 ? -1.0 : 1.0) * blob(x, y, 0, n, center);
+            engine.getNodesMutable()[engine.getIndex(x, y)].phi = phi;
+            w[y * n[0] + x] = std::abs(phi);
+        }
+    }
+    double ref[3];
+    referenceCenter(w, n[0], n[1], 1, ref);
+    double x_cm = 0.0, y_cm = 0.0;
+    engine.getCenterOfMass(x_cm, y_cm);
+    expect(close(x_cm, ref[0]) && close(y_cm, ref[1]), "SATP 2D matches the per-cell reference");
+    expect(std::abs(x_cm - 1.0) < 0.05 && std::abs(y_cm - 28.5) < 0.05, "SATP 2D blob across the seam");
+
+    SATPHiggsEngine2D empty(8, 8, 0.1, 0.01, SATPHiggsParams());
+    empty.getCenterOfMass(x_cm, y_cm);
+    expect(x_cm == 0.0 && y_cm == 0.0, "zero field centres at the origin");
+}
+
+void testSatp3D() {
+    using namespace dase::satp_higgs;
+    const size_t n[3] = {20, 14, 11};
+    const double center[3] = {19.5, 3.0, 0.25};
+    SATPHiggsEngine3D engine(n[0], n[1], n[2], 0.1, 0.01, SATPHiggsParams());
+    std::vector<double> w(n[0] * n[1] * n[2]);
+    for (size_t z = 0; z < n[2]; ++z) {
+        for (size_t y = 0; y < n[1]; ++y) {
+            for (size_t x = 0; x < n[0]; ++x) {
+                const double phi = blob(x, y, z, n, center) + 1e-3 * std::sin(static_cast<double>(x + 3 * y));
+                engine.getNodesMutable()[engine.getIndex(x, y, z)].phi = phi;
+                w[(z * n[1] + y) * n[0] + x] = std::abs(phi);
+            }
+        }
+    }
+    double ref[3];
+    referenceCenter(w, n[0], n[1], n[2], ref);
+    double cm[3];
+    engine.getCenterOfMass(cm[0], cm[1], cm[2]);
+    expect(close(cm[0], ref[0]) && close(cm[1], ref[1]) && close(cm[2], ref[2]),
+           "SATP 3D matches the per-cell reference");
+
+    // Same bits on 1 and 5 threads
+    double one[3], five[3];
+    omp_set_num_threads(1);
+    engine.getCenterOfMass(one[0], one[1], one[2]);
+    omp_set_num_threads(5);
+    engine.getCenterOfMass(five[0], five[1], five[2]);
+    expect(one[0] == five[0] && one[1] == five[1] && one[2] == five[2], "SATP 3D thread-count independent");
+}
+
+void testSatp1D() {
+    using namespace dase::satp_higgs;
+    const size_t n = 64;
+    SATPHiggsParams params;
+    SATPHiggsEngine1D engine(n, 0.1, 0.01, params);
+    const size_t extent[3] = {n, 1, 1};
+    const double center[3] = {62.0, 0.0, 0.0};
+    std::vector<double> w_phi(n), w_h(n);
+    for (size_t i = 0; i < n; ++i) {
+        auto& node = engine.getNodesMutable()[i];
+        node.phi = blob(i, 0, 0, extent, center);
+        w_phi[i] = std::abs(node.phi);
+        w_h[i] = std::abs(node.h - engine.getParams().h_vev);
+    }
+    engine.getNodesMutable()[10].h += 0.5;
+    w_h[10] = std::abs(engine.getNodes()[10].h - engine.getParams().h_vev);
+
+    double ref_phi[3], ref_h[3];
+    referenceCenter(w_phi, n, 1, 1, ref_phi);
+    referenceCenter(w_h, n, 1, 1, ref_h);
+    double x_phi = 0.0, x_h = 0.0;
+    engine.getCenterOfMass(x_phi, x_h);
+    expect(close(x_phi, ref_phi[0]) && close(x_h, ref_h[0]) && close(x_h, 10.0), "SATP 1D φ and h centres");
+}
+
+void testIgsoa3D() {
+    dase::igsoa::IGSOAComplexConfig config;
+    config.R_c_default = 1.5;
+    config.omp_min_nodes = 1;
+    const size_t n[3] = {16, 12, 10};
+    dase::igsoa::IGSOAComplexEngine3D engine(config, n[0], n[1], n[2]);
+    const double center[3] = {15.0, 6.0, 9.5};
+    auto& nodes = engine.getNodesMutable();
+    for (size_t z = 0; z < n[2]; ++z) {
+        for (size_t y = 0; y < n[1]; ++y) {
+            for (size_t x = 0; x < n[0]; ++x) {
+                nodes[(z * n[1] + y) * n[0] + x].psi = std::complex<double>(std::sqrt(blob(x, y, z, n, center)), 0.1);
+            }
+        }
+    }
+    double cm[3];
+    engine.getCenterOfMass(cm[0], cm[1], cm[2]);
+    std::vector<double> w(nodes.size());
+    for (size_t i = 0; i < w.size(); ++i) w[i] = engine.getNodes()[i].F;
+    double ref[3];
+    referenceCenter(w, n[0], n[1], n[2], ref);
+    expect(close(cm[0], ref[0]) && close(cm[1], ref[1]) && close(cm[2], ref[2]),
+           "IGSOA 3D matches the per-cell reference");
+
+    double one[3], three[3];
+    omp_set_num_threads(1);
+    engine.getCenterOfMass(one[0], one[1], one[2]);
+    omp_set_num_threads(3);
+    engine.getCenterOfMass(three[0], three[1], three[2]);
+    expect(one[0] == three[0] && one[1] == three[1] && one[2] == three[2], "IGSOA 3D thread-count independent");
+}
+
+} // namespace
+
+int main() {
+    testSatp2D();
+    testSatp3D();
+    testSatp1D();
+    testIgsoa3D();
+
+    if (failures != 0) {
+        std::cerr << "test_circular_center_of_mass: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_circular_center_of_mass: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * dase_cli in-process analysis test
+ *
+ * Native field statistics must match the textbook definitions and field
+ * peaks must be the lattice's local maxima (periodic, one per plateau).
+ * The persistent Python worker, when Python is installed, must run
+ * several scripts in one interpreter and report their exit codes and
+ * output like a fresh interpreter would.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_analysis_native.cpp
+ *        dase_cli/src/engine_fft_analysis.cpp dase_cli/src/python_bridge.cpp
+ * Run from Simulation/ (finds analysis/analysis_worker.py)
+ */
+
+#include "../dase_cli/src/engine_fft_analysis.h"
+#include "../dase_cli/src/python_bridge.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+bool near(double a, double b) {
+    return std::fabs(a - b) <= 1e-12 * (1.0 + std::fabs(b));
+}
+
+}  // namespace
+
+int main() {
+    bool ok = true;
+
+    // Statistics of {1, 2, 3, 4, 10}
+    {
+        const std::vector<double> field = {1.0, 2.0, 3.0, 4.0, 10.0};
+        const auto stats = analysis::EngineFFTAnalysis::computeStatistics(field, "phi");
+        const double mean = 4.0;
+        const double variance = (9.0 + 4.0 + 1.0 + 0.0 + 36.0) / 5.0;
+        if (stats.N != 5 || !near(stats.mean, mean) || !near(stats.variance, variance) ||
+            !near(stats.std_dev, std::sqrt(variance)) || stats.min != 1.0 || stats.max != 10.0 ||
+            stats.argmin != 0 || stats.argmax != 4 || !near(stats.energy, 130.0) ||
+            !near(stats.rms, std::sqrt(26.0))) {
+            std::cerr << "statistics wrong: " << analysis::EngineFFTAnalysis::toJSON(stats).dump() << std::endl;
+            ok = false;
+        }
+    }
+
+    // 1D peaks: periodic wrap, plateau counted once, threshold applied
+    {
+        //                              0    1    2    3    4    5    6    7
+        const std::vector<double> field = {5.0, 1.0, 3.0, 3.0, 0.0, 0.02, 0.0, 4.0};
+        auto peaks = analysis::EngineFFTAnalysis::findFieldPeaks(field, 8, 1, 1, 10, 0.1);
+        // Node 0 beats 7 across the wrap; {2,3} plateau -> 2; 0.02 < 0.1 * 5
+        if (peaks.size() != 2 || peaks[0].index != 0 || peaks[1].index != 2) {
+            std::cerr << "1D peaks wrong: " << analysis::EngineFFTAnalysis::toJSON(peaks).dump() << std::endl;
+            ok = false;
+        }
+        peaks = analysis::EngineFFTAnalysis::findFieldPeaks(field, 8, 1, 1, 1, 0.0);
+        if (peaks.size() != 1 || peaks[0].index != 0) {
+            std::cerr << "n_peaks not applied" << std::endl;
+            ok = false;
+        }
+    }
+
+    // 2D peaks: only the node above all four neighbours
+    {
+        std::vector<double> field(4 * 3, 0.0);
+        field[1 + 4 * 1] = 2.0;     // (1, 1) peak
+        field[2 + 4 * 1] = 1.0;     // (2, 1) lower than its x neighbour
+        const auto peaks = analysis::EngineFFTAnalysis::findFieldPeaks(field, 4, 3, 1, 10, 0.01);
+        if (peaks.size() != 1 || peaks[0].x != 1 || peaks[0].y != 1 || peaks[0].value != 2.0) {
+            std::cerr << "2D peaks wrong: " << analysis::EngineFFTAnalysis::toJSON(peaks).dump() << std::endl;
+            ok = false;
+        }
+    }
+
+    // Persistent worker: two scripts in one interpreter
+    const std::string worker_script = python::PythonWorker::findWorkerScript();
+    if (worker_script.empty() || python::PythonBridge::getPythonVersion("python").empty()) {
+        std::cout << "python worker check skipped (no Python or analysis_worker.py)" << std::endl;
+    } else {
+        const std::string script = "test_cli_analysis_native_script.py";
+        const std::string state = "test_cli_analysis_native_state.json";
+        {
+            std::ofstream out(script);
+            out << "import json, sys\n"
+                   "state = json.load(open(sys.argv[1]))\n"
+                   "print(len(state['phi']), sys.argv[2:])\n"
+                   "sys.exit(int(state['exit']))\n";
+            std::ofstream(state) << R"({"phi": [1, 2, 3], "exit": 0})";
+        }
+
+        python::PythonWorker worker("python", worker_script);
+        python::PythonAnalysisConfig config;
+        config.script_path = script;
+        config.output_dir.clear();
+        config.args = {{"positional", "2.0"}, {"verbose", ""}};
+        python::PythonAnalysisResult result{};
+        if (!worker.run(state, config, result) || !result.success ||
+            result.stdout_output != "3 ['2.0', '--verbose']\n") {
+            std::cerr << "worker run wrong: '" << result.stdout_output << "' " << result.stderr_output << std::endl;
+            ok = false;
+        }
+
+        std::ofstream(state) << R"({"phi": [1], "exit": 3})";
+        result = python::PythonAnalysisResult{};
+        if (!worker.run(state, config, result) || result.success || result.exit_code != 3 ||
+            result.stdout_output != "1 ['2.0', '--verbose']\n") {
+            std::cerr << "worker exit code wrong: " << result.exit_code << std::endl;
+            ok = false;
+        }
+
+        config.script_path = "no_such_script.py";
+        result = python::PythonAnalysisResult{};
+        if (!worker.run(state, config, result) || result.success || result.stderr_output.empty()) {
+            std::cerr << "missing script not reported" << std::endl;
+            ok = false;
+        }
+        std::remove(script.c_str());
+        std::remove(state.c_str());
+    }
+
+    std::cout << (ok ? "CLI analysis native test passed" : "CLI analysis native test FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
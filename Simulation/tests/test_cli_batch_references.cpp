@@ -0,0 +1,74 @@
+/**
+ * dase_cli batch reference test
+ *
+ * "$<index>.<path>" strings in a batch command's params must be replaced by
+ * the named value of an earlier response (result first, then the response
+ * itself), keep that value's type, leave other strings alone, and fail
+ * for commands that have not run or keys that do not exist.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_batch_references.cpp dase_cli/src/batch_references.cpp
+ */
+
+#include "../dase_cli/src/batch_references.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase;
+using json = nlohmann::json;
+
+int main() {
+    bool ok = true;
+
+    const std::vector<json> responses = {
+        {{"status", "success"}, {"command", "create_engine"},
+         {"result", {{"engine_id", "engine_007"}, {"num_nodes", 4096}}}},
+        {{"status", "success"}, {"command", "get_metrics"},
+         {"result", {{"metrics", {{"ns_per_op", 1.5}}}, {"nodes", json::array({3, 5, 8})}}}}
+    };
+
+    {
+        json params = {
+            {"engine_id", "$0.engine_id"},
+            {"num_steps", "$0.num_nodes"},
+            {"nested", {{"values", json::array({"$1.nodes.2", "$1.metrics.ns_per_op"})}}},
+            {"status_of_first", "$0.status"},
+            {"whole", "$1"},
+            {"literal", "$$0.engine_id"},
+            {"plain", "$segment"},
+            {"not_ref", "$1abc"}
+        };
+        std::string error;
+        if (!resolveBatchReferences(params, responses, error)) {
+            std::cerr << "resolution failed: " << error << std::endl;
+            ok = false;
+        }
+        const json expected = {
+            {"engine_id", "engine_007"},
+            {"num_steps", 4096},
+            {"nested", {{"values", json::array({8, 1.5})}}},
+            {"status_of_first", "success"},
+            {"whole", responses[1]["result"]},
+            {"literal", "$0.engine_id"},
+            {"plain", "$segment"},
+            {"not_ref", "$1abc"}
+        };
+        if (params != expected) {
+            std::cerr << "resolved params wrong: " << params.dump() << std::endl;
+            ok = false;
+        }
+    }
+
+    // References to later commands or missing keys are errors
+    for (const char* bad : {"$2.engine_id", "$0.missing", "$1.nodes.9", "$1.nodes.x"}) {
+        json params = {{"engine_id", bad}};
+        std::string error;
+        if (resolveBatchReferences(params, responses, error) || error.empty()) {
+            std::cerr << "bad reference accepted: " << bad << std::endl;
+            ok = false;
+        }
+    }
+
+    std::cout << (ok ? "CLI batch reference test passed" : "CLI batch reference test FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/**
+ * dase_cli binary protocol test
+ *
+ * Frames must round-trip in both envelope formats with their float64
+ * segments bit-exact, segment references must expand into arrays, and
+ * malformed input (bad magic, truncation, dangling reference) must be
+ * reported rather than accepted.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_binary_protocol.cpp dase_cli/src/binary_protocol.cpp dase_cli/src/segment_codec.cpp
+ */
+
+#include "../dase_cli/src/binary_protocol.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+using namespace dase::protocol;
+
+int main() {
+    bool ok = true;
+
+    std::vector<double> psi(1000);
+    for (size_t i = 0; i < psi.size(); i++) {
+        psi[i] = std::sin(0.37 * static_cast<double>(i)) * 1e-3;
+    }
+    psi[1] = std::numeric_limits<double>::denorm_min();
+    psi[2] = -0.0;
+
+    for (EnvelopeFormat format : {EnvelopeFormat::CBOR, EnvelopeFormat::MsgPack}) {
+        Frame out;
+        out.format = format;
+        out.envelope = {{"status", "success"}, {"result", {{"psi_real", segmentReference(0, psi.size())},
+                                                           {"phi", segmentReference(1, 0)}}}};
+        out.segments = {psi, {}};
+
+        // Two frames back to back, then a clean end of stream
+        std::stringstream stream;
+        writeFrame(stream, out);
+        writeFrame(stream, out);
+
+        for (int copy = 0; copy < 2; copy++) {
+            Frame in;
+            std::string error;
+            if (readFrame(stream, in, error) != ReadStatus::Ok) {
+                std::cerr << "round trip failed: " << error << std::endl;
+                ok = false;
+                break;
+            }
+            if (in.format != format || in.envelope != out.envelope || in.segments.size() != 2 ||
+                in.segments[0].size() != psi.size() || !in.segments[1].empty()) {
+                std::cerr << "frame contents changed in round trip" << std::endl;
+                ok = false;
+                break;
+            }
+            for (size_t i = 0; i < psi.size(); i++) {
+                if (std::memcmp(&in.segments[0][i], &psi[i], sizeof(double)) != 0) {
+                    std::cerr << "segment value " << i << " not bit-exact" << std::endl;
+                    ok = false;
+                    break;
+                }
+            }
+
+            json expanded = in.envelope;
+            if (!expandSegments(expanded, in.segments, error) ||
+                expanded["result"]["psi_real"].get<std::vector<double>>() != psi ||
+                !expanded["result"]["phi"].is_array() || !expanded["result"]["phi"].empty()) {
+                std::cerr << "segment expansion failed: " << error << std::endl;
+                ok = false;
+            }
+        }
+        Frame tail;
+        std::string error;
+        if (readFrame(stream, tail, error) != ReadStatus::EndOfStream) {
+            std::cerr << "expected end of stream after the last frame" << std::endl;
+            ok = false;
+        }
+    }
+
+    // Rejections: bad magic, truncated segment, reference past the segments
+    {
+        Frame out;
+        out.envelope = {{"command", "get_state"}};
+        out.segments = {psi};
+        std::stringstream good;
+        writeFrame(good, out);
+        const std::string bytes = good.str();
+
+        Frame in;
+        std::string error;
+        std::stringstream bad_magic("XXXX" + bytes.substr(4));
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 8));
+        if (readFrame(bad_magic, in, error) != ReadStatus::Error ||
+            readFrame(truncated, in, error) != ReadStatus::Error) {
+            std::cerr << "malformed frame was accepted" << std::endl;
+            ok = false;
+        }
+
+        json dangling = {{"params", {{"values", segmentReference(3, 1)}}}};
+        if (expandSegments(dangling, out.segments, error)) {
+            std::cerr << "dangling segment reference was accepted" << std::endl;
+            ok = false;
+        }
+    }
+
+    std::cout << (ok ? "CLI binary protocol test passed" : "CLI binary protocol test FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
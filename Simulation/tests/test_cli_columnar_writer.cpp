@@ -0,0 +1,416 @@
+/**
+ * dase_cli columnar writer test
+ *
+ * A batch of every column type, split into record batches / row groups by
+ * maxRows(), must come back from the files as written: the Arrow stream
+ * is walked message by message (FlatBuffers read through their vtables,
+ * buffers decoded from the body) and the Parquet footer and page headers
+ * are decoded as Thrift compact structs, the PLAIN pages compared value by
+ * value.  Ragged and mistyped batches must be rejected.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_columnar_writer.cpp dase_cli/src/columnar_writer.cpp
+ */
+
+#include "../dase_cli/src/columnar_writer.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace dase::columnar;
+
+namespace {
+
+bool ok = true;
+
+void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ok = false;
+    }
+}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::vector<uint8_t> bytes;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return bytes;
+    int c;
+    while ((c = std::fgetc(file)) != EOF) bytes.push_back(static_cast<uint8_t>(c));
+    std::fclose(file);
+    return bytes;
+}
+
+template <typename T>
+T load(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+// Source rows
+const std::vector<ColumnSchema> kSchema = {
+    {"id", Type::Int32}, {"step", Type::UInt64}, {"t", Type::Int64}, {"x", Type::Float32},
+    {"v", Type::Float64}, {"flag", Type::Bool}, {"name", Type::Utf8}
+};
+const size_t kRows = 11;
+
+int32_t idAt(size_t r) { return static_cast<int32_t>(r) - 3; }
+uint64_t stepAt(size_t r) { return (uint64_t(1) << 63) + r; }
+int64_t tAt(size_t r) { return -static_cast<int64_t>(r) * 1000000007LL; }
+float xAt(size_t r) { return 0.5f * static_cast<float>(r); }
+double vAt(size_t r) { return 1.0 / (1.0 + static_cast<double>(r)); }
+bool flagAt(size_t r) { return r % 3 == 0; }
+std::string nameAt(size_t r) { return r == 4 ? std::string() : "row-" + std::string(r, 'x'); }
+
+ColumnBatch makeBatch() {
+    ColumnBatch batch(kSchema);
+    for (size_t r = 0; r < kRows; ++r) {
+        batch.appendInt32(0, idAt(r));
+        batch.appendUInt64(1, stepAt(r));
+        batch.appendInt64(2, tAt(r));
+        batch.appendFloat32(3, xAt(r));
+        batch.appendFloat64(4, vAt(r));
+        batch.appendBool(5, flagAt(r));
+        batch.appendString(6, nameAt(r));
+    }
+    return batch;
+}
+
+// ----------------------------------------------------------------------------
+// FlatBuffers reading
+// ----------------------------------------------------------------------------
+
+struct FlatTable {
+    const uint8_t* base = nullptr;   // Buffer start
+    size_t pos = 0;                  // Table start
+
+    const uint8_t* field(int id) const {
+        const size_t vtable = pos - load<int32_t>(base + pos);
+        const uint16_t vtable_bytes = load<uint16_t>(base + vtable);
+        if (4 + 2 * static_cast<size_t>(id) >= vtable_bytes) return nullptr;
+        const uint16_t offset = load<uint16_t>(base + vtable + 4 + 2 * id);
+        return offset ? base + pos + offset : nullptr;
+    }
+    template <typename T>
+    T scalar(int id, T fallback) const {
+        const uint8_t* p = field(id);
+        return p ? load<T>(p) : fallback;
+    }
+    // Target of the uoffset field `id` (0 when absent)
+    size_t ref(int id) const {
+        const uint8_t* p = field(id);
+        return p ? static_cast<size_t>(p - base) + load<uint32_t>(p) : 0;
+    }
+    FlatTable table(int id) const { return FlatTable{base, ref(id)}; }
+    std::string string(int id) const {
+        const size_t at = ref(id);
+        return at ? std::string(reinterpret_cast<const char*>(base + at + 4), load<uint32_t>(base + at)) : "";
+    }
+    uint32_t vectorLength(int id) const { return ref(id) ? load<uint32_t>(base + ref(id)) : 0; }
+    FlatTable vectorTable(int id, size_t i) const {
+        const size_t slot = ref(id) + 4 + 4 * i;
+        return FlatTable{base, slot + load<uint32_t>(base + slot)};
+    }
+    const uint8_t* vectorData(int id) const { return base + ref(id) + 4; }
+};
+
+void checkArrow(const std::string& path, size_t max_rows) {
+    const std::vector<uint8_t> bytes = readFile(path);
+    size_t at = 0;
+    int message_index = 0;
+    size_t row = 0;
+    bool eos = false;
+    while (at + 8 <= bytes.size()) {
+        check(load<uint32_t>(&bytes[at]) == 0xFFFFFFFFu, "Arrow continuation marker");
+        const uint32_t length = load<uint32_t>(&bytes[at + 4]);
+        at += 8;
+        if (length == 0) {
+            eos = true;
+            break;
+        }
+        check(length % 8 == 0, "Arrow metadata padded to 8 bytes");
+        const uint8_t* fb = &bytes[at];
+        const FlatTable message{fb, load<uint32_t>(fb)};
+        check(message.scalar<int16_t>(0, 0) == 4, "Arrow metadata version V5");
+        const uint8_t header_type = message.scalar<uint8_t>(1, 0);
+        const int64_t body_length = message.scalar<int64_t>(3, 0);
+        const FlatTable header = message.table(2);
+        const uint8_t* body = fb + length;
+        at += length + static_cast<size_t>(body_length);
+
+        if (message_index++ == 0) {
+            check(header_type == 1 && body_length == 0, "Arrow stream starts with a schema");
+            check(header.scalar<int16_t>(0, 0) == 0, "Arrow schema little-endian");
+            check(header.vectorLength(1) == kSchema.size(), "Arrow schema field count");
+            const uint8_t expected_types[] = {2, 2, 2, 3, 3, 6, 5};
+            for (size_t c = 0; c < kSchema.size() && c < header.vectorLength(1); ++c) {
+                const FlatTable field = header.vectorTable(1, c);
+                check(field.string(0) == kSchema[c].name, "Arrow field name " + kSchema[c].name);
+                check(field.scalar<uint8_t>(1, 1) == 0, "Arrow field non-nullable");
+                check(field.scalar<uint8_t>(2, 0) == expected_types[c], "Arrow field type " + kSchema[c].name);
+                check(field.ref(5) != 0 && field.vectorLength(5) == 0, "Arrow field children present and empty");
+                const FlatTable type = field.table(3);
+                if (c < 3) {
+                    check(type.scalar<int32_t>(0, 0) == (c == 0 ? 32 : 64) &&
+                          type.scalar<uint8_t>(1, 0) == (c == 1 ? 0 : 1), "Arrow int width / sign");
+                } else if (c < 5) {
+                    check(type.scalar<int16_t>(0, 0) == (c == 3 ? 1 : 2), "Arrow float precision");
+                }
+            }
+            check(header.vectorLength(2) == 1 && header.vectorTable(2, 0).string(0) == "table" &&
+                  header.vectorTable(2, 0).string(1) == "probes", "Arrow schema custom metadata");
+            continue;
+        }
+
+        check(header_type == 3, "Arrow record batch message");
+        const size_t rows = static_cast<size_t>(header.scalar<int64_t>(0, -1));
+        check(rows == std::min(max_rows, kRows - row), "Arrow record batch length");
+        check(header.vectorLength(1) == kSchema.size(), "Arrow field node count");
+        check(header.vectorLength(2) == 2 * kSchema.size() + 1, "Arrow buffer count");
+        const uint8_t* nodes = header.vectorData(1);
+        const uint8_t* buffers = header.vectorData(2);
+        check((buffers - fb) % 8 == 0, "Arrow buffer structs aligned");
+        size_t b = 0;
+        auto next_buffer = [&]() {
+            const int64_t offset = load<int64_t>(buffers + 16 * b);
+            const int64_t buffer_length = load<int64_t>(buffers + 16 * b + 8);
+            b++;
+            check(offset % 8 == 0 && offset + buffer_length <= body_length, "Arrow buffer inside the body");
+            return body + offset;
+        };
+        for (size_t c = 0; c < kSchema.size(); ++c) {
+            check(load<int64_t>(nodes + 16 * c) == static_cast<int64_t>(rows) &&
+                  load<int64_t>(nodes + 16 * c + 8) == 0, "Arrow field node");
+            next_buffer();   // Validity (none)
+            const uint8_t* data = next_buffer();
+            bool same = true;
+            for (size_t r = 0; r < rows; ++r) {
+                const size_t s = row + r;
+                switch (c) {
+                    case 0: same = same && load<int32_t>(data + 4 * r) == idAt(s); break;
+                    case 1: same = same && load<uint64_t>(data + 8 * r) == stepAt(s); break;
+                    case 2: same = same && load<int64_t>(data + 8 * r) == tAt(s); break;
+                    case 3: same = same && load<float>(data + 4 * r) == xAt(s); break;
+                    case 4: same = same && load<double>(data + 8 * r) == vAt(s); break;
+                    case 5: same = same && (((data[r / 8] >> (r % 8)) & 1) != 0) == flagAt(s); break;
+                    default: break;
+                }
+            }
+            if (c == 6) {
+                const uint8_t* chars = next_buffer();
+                for (size_t r = 0; r < rows; ++r) {
+                    const int32_t begin = load<int32_t>(data + 4 * r);
+                    const int32_t end = load<int32_t>(data + 4 * r + 4);
+                    same = same && std::string(reinterpret_cast<const char*>(chars) + begin, end - begin) ==
+                                   nameAt(row + r);
+                }
+            }
+            check(same, "Arrow column " + kSchema[c].name + " values");
+        }
+        row += rows;
+    }
+    check(eos && at == bytes.size(), "Arrow end-of-stream marker ends the file");
+    check(row == kRows && message_index == 1 + static_cast<int>((kRows + max_rows - 1) / max_rows),
+          "Arrow record batches cover every row");
+}
+
+// ----------------------------------------------------------------------------
+// Thrift compact reading
+// ----------------------------------------------------------------------------
+
+struct Thrift {
+    int64_t i = 0;
+    std::string s;
+    std::vector<Thrift> list;
+    std::map<int, Thrift> fields;
+
+    const Thrift& operator[](int id) const {
+        static const Thrift missing;
+        auto it = fields.find(id);
+        return it == fields.end() ? missing : it->second;
+    }
+    bool has(int id) const { return fields.count(id) != 0; }
+};
+
+class ThriftReader {
+public:
+    ThriftReader(const uint8_t* data, size_t size) : p_(data), end_(data + size) {}
+
+    Thrift readStruct() {
+        Thrift out;
+        int16_t last = 0;
+        while (p_ < end_) {
+            const uint8_t byte = *p_++;
+            if (byte == 0) break;
+            const int type = byte & 0x0F;
+            const int16_t id = (byte >> 4) ? static_cast<int16_t>(last + (byte >> 4))
+                                           : static_cast<int16_t>(unzigzag(varint()));
+            last = id;
+            out.fields[id] = readValue(type);
+        }
+        return out;
+    }
+    size_t consumed(const uint8_t* start) const { return static_cast<size_t>(p_ - start); }
+
+private:
+    const uint8_t* p_;
+    const uint8_t* end_;
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; p_ < end_; shift += 7) {
+            const uint8_t byte = *p_++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        return value;
+    }
+    static int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    Thrift readValue(int type) {
+        Thrift value;
+        switch (type) {
+            case 1: value.i = 1; break;
+            case 2: value.i = 0; break;
+            case 3: value.i = static_cast<int8_t>(*p_++); break;
+            case 4: case 5: case 6: value.i = unzigzag(varint()); break;
+            case 7: p_ += 8; break;
+            case 8: {
+                const size_t n = static_cast<size_t>(varint());
+                value.s.assign(reinterpret_cast<const char*>(p_), n);
+                p_ += n;
+                break;
+            }
+            case 9: {
+                const uint8_t header = *p_++;
+                size_t n = header >> 4;
+                if (n == 15) n = static_cast<size_t>(varint());
+                for (size_t k = 0; k < n; ++k) value.list.push_back(readValue(header & 0x0F));
+                break;
+            }
+            case 12: value = readStruct(); break;
+            default: p_ = end_; break;
+        }
+        return value;
+    }
+};
+
+void checkParquet(const std::string& path, size_t max_rows) {
+    const std::vector<uint8_t> bytes = readFile(path);
+    if (bytes.size() < 12) {
+        check(false, "Parquet file written");
+        return;
+    }
+    check(std::memcmp(bytes.data(), "PAR1", 4) == 0 && std::memcmp(&bytes[bytes.size() - 4], "PAR1", 4) == 0,
+          "Parquet magic at both ends");
+    const uint32_t footer = load<uint32_t>(&bytes[bytes.size() - 8]);
+    const uint8_t* meta_start = &bytes[bytes.size() - 8 - footer];
+    ThriftReader reader(meta_start, footer);
+    const Thrift meta = reader.readStruct();
+    check(reader.consumed(meta_start) == footer, "Parquet footer length");
+    check(meta[1].i == 1 && meta[3].i == static_cast<int64_t>(kRows), "Parquet version and row count");
+
+    const std::vector<Thrift>& schema = meta[2].list;
+    check(schema.size() == kSchema.size() + 1 && schema[0][4].s == "schema" &&
+          schema[0][5].i == static_cast<int64_t>(kSchema.size()), "Parquet root schema element");
+    const int64_t physical[] = {1, 2, 2, 4, 5, 0, 6};
+    for (size_t c = 0; c < kSchema.size() && c + 1 < schema.size(); ++c) {
+        const Thrift& element = schema[c + 1];
+        check(element[4].s == kSchema[c].name && element[1].i == physical[c] && element[3].i == 0 &&
+              element.has(3), "Parquet schema element " + kSchema[c].name);
+        const int64_t converted = c == 1 ? 14 : c == 6 ? 0 : -1;
+        check(converted < 0 ? !element.has(6) : element[6].i == converted,
+              "Parquet converted type " + kSchema[c].name);
+    }
+    check(meta[5].list.size() == 1 && meta[5].list[0][1].s == "table" && meta[5].list[0][2].s == "probes",
+          "Parquet key/value metadata");
+
+    const std::vector<Thrift>& groups = meta[4].list;
+    check(groups.size() == (kRows + max_rows - 1) / max_rows, "Parquet row group count");
+    size_t row = 0;
+    for (const Thrift& group : groups) {
+        const size_t rows = static_cast<size_t>(group[3].i);
+        check(rows == std::min(max_rows, kRows - row), "Parquet row group size");
+        check(group[1].list.size() == kSchema.size(), "Parquet column chunk count");
+        for (size_t c = 0; c < kSchema.size() && c < group[1].list.size(); ++c) {
+            const Thrift& chunk = group[1].list[c][3];
+            check(chunk[1].i == physical[c] && chunk[3].list.size() == 1 && chunk[3].list[0].s == kSchema[c].name &&
+                  chunk[4].i == 0 && chunk[5].i == static_cast<int64_t>(rows), "Parquet column metadata");
+            const uint8_t* page_start = &bytes[static_cast<size_t>(chunk[9].i)];
+            ThriftReader page_reader(page_start, bytes.size() - static_cast<size_t>(chunk[9].i));
+            const Thrift page = page_reader.readStruct();
+            const size_t header_bytes = page_reader.consumed(page_start);
+            check(page[1].i == 0 && page[2].i == page[3].i && page[5][1].i == static_cast<int64_t>(rows) &&
+                  page[5][2].i == 0, "Parquet data page header");
+            check(chunk[6].i == static_cast<int64_t>(header_bytes) + page[2].i, "Parquet chunk size");
+            const uint8_t* data = page_start + header_bytes;
+            bool same = true;
+            size_t at = 0;
+            for (size_t r = 0; r < rows; ++r) {
+                const size_t s = row + r;
+                switch (c) {
+                    case 0: same = same && load<int32_t>(data + 4 * r) == idAt(s); break;
+                    case 1: same = same && load<uint64_t>(data + 8 * r) == stepAt(s); break;
+                    case 2: same = same && load<int64_t>(data + 8 * r) == tAt(s); break;
+                    case 3: same = same && load<float>(data + 4 * r) == xAt(s); break;
+                    case 4: same = same && load<double>(data + 8 * r) == vAt(s); break;
+                    case 5: same = same && (((data[r / 8] >> (r % 8)) & 1) != 0) == flagAt(s); break;
+                    case 6: {
+                        const uint32_t n = load<uint32_t>(data + at);
+                        same = same && std::string(reinterpret_cast<const char*>(data) + at + 4, n) == nameAt(s);
+                        at += 4 + n;
+                        break;
+                    }
+                }
+            }
+            check(same, "Parquet column " + kSchema[c].name + " values");
+        }
+        row += rows;
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::pair<std::string, std::string>> metadata = {{"table", "probes"}};
+    const ColumnBatch batch = makeBatch();
+
+    for (Format format : {Format::Arrow, Format::Parquet}) {
+        const std::string path = std::string("test_cli_columnar_writer") + formatExtension(format);
+        for (size_t max_rows : {size_t(4), size_t(100)}) {
+            std::unique_ptr<ColumnarWriter> writer = ColumnarWriter::create(format);
+            writer->setMaxRows(max_rows);
+            std::string error;
+            const bool written = writer->open(path, kSchema, metadata, error) && writer->write(batch, error) &&
+                                 writer->close(error);
+            check(written && writer->rowsWritten() == kRows, "write " + path + ": " + error);
+            check(writer->bytesWritten() == readFile(path).size(), "bytesWritten counts the file");
+            if (format == Format::Arrow) {
+                checkArrow(path, max_rows);
+            } else {
+                checkParquet(path, max_rows);
+            }
+        }
+
+        // Ragged and mistyped batches
+        std::unique_ptr<ColumnarWriter> writer = ColumnarWriter::create(format);
+        std::string error;
+        check(writer->open(path, kSchema, {}, error), "reopen " + path);
+        ColumnBatch ragged(kSchema);
+        ragged.appendInt32(0, 1);
+        check(!writer->write(ragged, error), "ragged batch rejected");
+        ColumnBatch other({{"id", Type::Int64}});
+        check(!writer->write(other, error), "batch of another schema rejected");
+        check(writer->close(error), "close after rejected batches");
+        std::remove(path.c_str());
+    }
+
+    Format format;
+    check(parseFormat("parquet", format) && format == Format::Parquet && !parseFormat("csv", format),
+          "format names");
+
+    std::cout << (ok ? "CLI columnar writer test passed" : "CLI columnar writer test FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
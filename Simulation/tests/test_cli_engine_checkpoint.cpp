@@ -0,0 +1,276 @@
+/**
+ * Engine checkpoint / restore test
+ *
+ * An engine stepped, checkpointed, stepped further and then restored must
+ * reproduce those further steps bit for bit (IGSOA 2D, SATP+Higgs 1D and
+ * the SID ternary engine).  Images with a bad magic, a truncated body or
+ * another lattice must be rejected without touching the engine.  In-memory
+ * images (clone_engine) must match the file image byte for byte and branch
+ * several clones that each reproduce the source's run.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -I src/cpp tests/test_cli_engine_checkpoint.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_physics_1d.h"
+#include "../src/cpp/sid_ternary_engine.hpp"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+std::string tempPath(const std::string& tag) {
+    return "/tmp/dase_checkpoint_test_" + tag + "_" + std::to_string(getpid()) + ".ckpt";
+}
+
+template <typename Save>
+void writeCheckpoint(const std::string& path, Save save) {
+    CheckpointWriter writer;
+    save(writer);
+    writer.write(path);
+}
+
+bool sameIgsoa(const std::vector<igsoa::IGSOAComplexNode>& a,
+               const std::vector<igsoa::IGSOAComplexNode>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].psi != b[i].psi || a[i].psi_dot != b[i].psi_dot ||
+            a[i].phi != b[i].phi || a[i].phi_dot != b[i].phi_dot) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameSatp(const std::vector<satp_higgs::SATPHiggsNode>& a,
+              const std::vector<satp_higgs::SATPHiggsNode>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].phi != b[i].phi || a[i].phi_dot != b[i].phi_dot ||
+            a[i].h != b[i].h || a[i].h_dot != b[i].h_dot) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool rejected(const std::string& path) {
+    try {
+        CheckpointImage image(path);
+        return false;
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+
+    // IGSOA 2D: Gaussian packet, 5 steps, checkpoint, 7 more
+    {
+        igsoa::IGSOAComplexConfig config;
+        config.num_nodes = 16 * 12;
+        config.R_c_default = 2.0;
+        config.normalize_psi = false;
+        igsoa::IGSOAComplexEngine2D engine(config, 16, 12);
+        auto& nodes = engine.getNodesMutable();
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const double x = static_cast<double>(i % 16) - 8.0;
+            const double y = static_cast<double>(i / 16) - 6.0;
+            nodes[i].psi = std::complex<double>(std::exp(-(x * x + y * y) / 8.0), 0.1 * x);
+            nodes[i].phi = 0.05 * y;
+        }
+        engine.runMission(5);
+
+        const std::string path = tempPath("igsoa2d");
+        writeCheckpoint(path, [&](CheckpointWriter& w) { engine.saveCheckpoint(w); });
+        engine.runMission(7);
+        const auto expected = engine.getNodes();
+        const double expected_time = engine.getCurrentTime();
+
+        igsoa::IGSOAComplexEngine2D restored(config, 16, 12);
+        restored.restoreCheckpoint(CheckpointImage(path));
+        restored.runMission(7);
+        if (!sameIgsoa(restored.getNodes(), expected) || restored.getCurrentTime() != expected_time) {
+            std::cerr << "IGSOA 2D restore does not reproduce the run" << std::endl;
+            ok = false;
+        }
+
+        // Another lattice is refused and left alone
+        igsoa::IGSOAComplexConfig other_config = config;
+        other_config.num_nodes = 12 * 16;
+        igsoa::IGSOAComplexEngine2D other(other_config, 12, 16);
+        const auto before = other.getNodes();
+        try {
+            other.restoreCheckpoint(CheckpointImage(path));
+            std::cerr << "IGSOA 2D restore accepted another lattice" << std::endl;
+            ok = false;
+        } catch (const std::runtime_error&) {
+            if (!sameIgsoa(other.getNodes(), before)) {
+                std::cerr << "Rejected IGSOA 2D restore modified the engine" << std::endl;
+                ok = false;
+            }
+        }
+
+        // Corrupt magic and truncated images are refused when opened
+        std::vector<char> bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        const std::string bad_magic = tempPath("bad_magic");
+        const std::string truncated = tempPath("truncated");
+        {
+            std::vector<char> corrupt = bytes;
+            corrupt[0] ^= 0x20;
+            std::ofstream(bad_magic, std::ios::binary).write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+            std::ofstream(truncated, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+        }
+        if (!rejected(bad_magic) || !rejected(truncated) || !rejected(tempPath("missing"))) {
+            std::cerr << "Corrupt checkpoint accepted" << std::endl;
+            ok = false;
+        }
+        std::remove(bad_magic.c_str());
+        std::remove(truncated.c_str());
+        std::remove(path.c_str());
+    }
+
+    // SATP+Higgs 1D: φ pulse, 10 steps, checkpoint, 15 more
+    {
+        satp_higgs::SATPHiggsParams params;
+        params.gamma_phi = 0.01;
+        satp_higgs::SATPHiggsEngine1D engine(128, 0.1, 0.01, params);
+        auto& nodes = engine.getNodesMutable();
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const double x = static_cast<double>(i) - 64.0;
+            nodes[i].phi = std::exp(-x * x / 32.0);
+            nodes[i].updateDerived();
+        }
+        engine.evolve(10);
+
+        const std::string path = tempPath("satp1d");
+        writeCheckpoint(path, [&](CheckpointWriter& w) { engine.saveCheckpoint(w); });
+        engine.evolve(15);
+        const auto expected = engine.getNodes();
+
+        satp_higgs::SATPHiggsEngine1D restored(128, 0.1, 0.01, satp_higgs::SATPHiggsParams());
+        restored.restoreCheckpoint(CheckpointImage(path));
+        restored.evolve(15);
+        if (!sameSatp(restored.getNodes(), expected) ||
+            restored.getTime() != engine.getTime() ||
+            restored.getStepCount() != engine.getStepCount() ||
+            restored.getParams().gamma_phi != params.gamma_phi) {
+            std::cerr << "SATP 1D restore does not reproduce the run" << std::endl;
+            ok = false;
+        }
+
+        satp_higgs::SATPHiggsEngine1D shorter(64, 0.1, 0.01, params);
+        try {
+            shorter.restoreCheckpoint(CheckpointImage(path));
+            std::cerr << "SATP 1D restore accepted another lattice" << std::endl;
+            ok = false;
+        } catch (const std::runtime_error&) {
+        }
+        std::remove(path.c_str());
+    }
+
+    // SID ternary: diagram, collapse and mixer steps, checkpoint, more steps
+    {
+        sid::SidTernaryEngine engine(64, 100.0);
+        engine.setDiagramExpr("P(Freedom)", "seed");
+        for (int i = 0; i < 4; ++i) engine.step(0.3);
+        engine.collapse(0.5);
+        engine.step(0.7);
+
+        const std::string path = tempPath("sid");
+        writeCheckpoint(path, [&](CheckpointWriter& w) { engine.saveCheckpoint(w); });
+        for (int i = 0; i < 6; ++i) engine.step(0.4);
+
+        sid::SidTernaryEngine restored(64, 100.0);
+        restored.restoreCheckpoint(CheckpointImage(path));
+        for (int i = 0; i < 6; ++i) restored.step(0.4);
+        if (restored.getIField() != engine.getIField() ||
+            restored.getNField() != engine.getNField() ||
+            restored.getUField() != engine.getUField() ||
+            restored.getIMass() != engine.getIMass() ||
+            restored.getStepCount() != engine.getStepCount() ||
+            restored.getDiagramJson() != engine.getDiagramJson()) {
+            std::cerr << "SID restore does not reproduce the run" << std::endl;
+            ok = false;
+        }
+
+        sid::SidTernaryEngine smaller(32, 100.0);
+        try {
+            smaller.restoreCheckpoint(CheckpointImage(path));
+            std::cerr << "SID restore accepted another node count" << std::endl;
+            ok = false;
+        } catch (const std::runtime_error&) {
+        }
+        std::remove(path.c_str());
+    }
+
+    // In-memory image: same bytes as the file, one image branches many clones
+    {
+        sid::SidTernaryEngine engine(64, 100.0);
+        engine.setDiagramExpr("P(Freedom)", "seed");
+        for (int i = 0; i < 3; ++i) engine.step(0.3);
+
+        const std::string path = tempPath("memory");
+        CheckpointWriter writer;
+        engine.saveCheckpoint(writer);
+        writer.write(path);
+        const auto buffer = writer.writeMemory();
+        std::vector<char> bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        if (bytes.size() != buffer->size() || !std::equal(bytes.begin(), bytes.end(), buffer->data()) ||
+            reinterpret_cast<uintptr_t>(buffer->data()) % kCheckpointAlignment != 0) {
+            std::cerr << "In-memory image differs from the file image" << std::endl;
+            ok = false;
+        }
+        std::remove(path.c_str());
+
+        const CheckpointImage image(*buffer);
+        std::vector<std::unique_ptr<sid::SidTernaryEngine>> clones;
+        for (int c = 0; c < 3; ++c) {
+            clones.push_back(std::make_unique<sid::SidTernaryEngine>(64, 100.0));
+            clones.back()->restoreCheckpoint(image);
+        }
+        for (int i = 0; i < 5; ++i) engine.step(0.4);
+        for (auto& clone : clones) {
+            for (int i = 0; i < 5; ++i) clone->step(0.4);
+            if (clone->getIField() != engine.getIField() || clone->getUField() != engine.getUField() ||
+                clone->getStepCount() != engine.getStepCount() ||
+                clone->getDiagramJson() != engine.getDiagramJson()) {
+                std::cerr << "Clone from an in-memory image does not reproduce the run" << std::endl;
+                ok = false;
+            }
+        }
+
+        CheckpointBuffer corrupt(buffer->size());
+        std::copy_n(buffer->data(), buffer->size(), corrupt.data());
+        corrupt.data()[0] ^= 0x20;
+        try {
+            CheckpointImage rejected_image(corrupt);
+            std::cerr << "Corrupt in-memory image accepted" << std::endl;
+            ok = false;
+        } catch (const std::runtime_error&) {
+        }
+    }
+
+    std::cout << (ok ? "Engine checkpoint test passed" : "Engine checkpoint test FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+/**
+ * dase_cli engine pipeline test
+ *
+ * FieldResampler must copy matching lattices, reproduce fields linear in
+ * every axis when refining or coarsening (cell-centre interpolation,
+ * clamped at the edges), broadcast a one-cell axis, and preserve
+ * constants.  reduceField must give the mean, rms and max_abs of a field.
+ *
+ * Build: g++ -std=c++17 -fopenmp -Idase_cli/src tests/test_cli_engine_pipeline.cpp dase_cli/src/engine_pipeline.cpp
+ */
+
+#include "../dase_cli/src/engine_pipeline.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Cell-centre coordinate of index i on an axis of n cells, in [0, 1]
+double centre(size_t i, size_t n) {
+    return (static_cast<double>(i) + 0.5) / static_cast<double>(n);
+}
+
+std::vector<double> linearField(const size_t dims[3]) {
+    std::vector<double> field(dims[0] * dims[1] * dims[2]);
+    for (size_t z = 0; z < dims[2]; ++z) {
+        for (size_t y = 0; y < dims[1]; ++y) {
+            for (size_t x = 0; x < dims[0]; ++x) {
+                field[(z * dims[1] + y) * dims[0] + x] =
+                    1.0 + 2.0 * centre(x, dims[0]) - 3.0 * centre(y, dims[1]) + 0.5 * centre(z, dims[2]);
+            }
+        }
+    }
+    return field;
+}
+
+void testIdentity() {
+    const size_t dims[3] = {5, 4, 3};
+    FieldResampler resampler(dims, dims);
+    expect(resampler.isIdentity(), "matching lattices are an identity");
+    const std::vector<double> in = linearField(dims);
+    std::vector<double> out(resampler.outputSize());
+    resampler.apply(in.data(), out.data());
+    expect(out == in, "identity copies");
+}
+
+void testLinear() {
+    // Interior cells of a linear field come out exact; edge cells clamp
+    const size_t in_dims[3] = {8, 6, 4};
+    const size_t out_dims[3] = {16, 3, 8};
+    FieldResampler resampler(in_dims, out_dims);
+    expect(!resampler.isIdentity() && resampler.outputSize() == 16 * 3 * 8, "resampled output size");
+    const std::vector<double> in = linearField(in_dims);
+    std::vector<double> out(resampler.outputSize());
+    resampler.apply(in.data(), out.data());
+    const std::vector<double> expected = linearField(out_dims);
+    double max_error = 0.0;
+    for (size_t z = 1; z + 1 < out_dims[2]; ++z) {
+        for (size_t y = 0; y < out_dims[1]; ++y) {
+            for (size_t x = 1; x + 1 < out_dims[0]; ++x) {
+                const size_t i = (z * out_dims[1] + y) * out_dims[0] + x;
+                max_error = std::max(max_error, std::fabs(out[i] - expected[i]));
+            }
+        }
+    }
+    expect(max_error < 1e-12, "linear field reproduced away from the edges");
+}
+
+void testBroadcastAndConstant() {
+    // 1D chain onto a 2D lattice: every row is the chain resampled along x
+    const size_t chain[3] = {4, 1, 1};
+    const size_t plane[3] = {4, 6, 1};
+    FieldResampler resampler(chain, plane);
+    const std::vector<double> in = {1.0, 2.0, 3.0, 4.0};
+    std::vector<double> out(resampler.outputSize());
+    resampler.apply(in.data(), out.data());
+    bool rows_match = true;
+    for (size_t y = 0; y < plane[1]; ++y) {
+        for (size_t x = 0; x < plane[0]; ++x) {
+            rows_match = rows_match && out[y * plane[0] + x] == in[x];
+        }
+    }
+    expect(rows_match, "one-cell axis broadcast");
+
+    const size_t coarse[3] = {7, 5, 3};
+    const size_t fine[3] = {11, 13, 2};
+    FieldResampler constant(coarse, fine);
+    const std::vector<double> ones(constant.inputSize(), 2.5);
+    std::vector<double> resampled(constant.outputSize());
+    constant.apply(ones.data(), resampled.data());
+    bool preserved = true;
+    for (double value : resampled) {
+        preserved = preserved && std::fabs(value - 2.5) < 1e-14;
+    }
+    expect(preserved, "constants preserved");
+}
+
+void testReduce() {
+    const std::vector<double> values = {3.0, -4.0, 0.0, 1.0};
+    expect(reduceField(values, PipelineReduce::Mean) == 0.0, "mean");
+    expect(std::fabs(reduceField(values, PipelineReduce::Rms) - std::sqrt(26.0 / 4.0)) < 1e-15, "rms");
+    expect(reduceField(values, PipelineReduce::MaxAbs) == 4.0, "max_abs");
+    expect(reduceField({}, PipelineReduce::Rms) == 0.0, "empty field reduces to 0");
+
+    PipelineReduce reduce = PipelineReduce::Mean;
+    PipelineInput input = PipelineInput::Source;
+    expect(parsePipelineReduce("max_abs", reduce) && reduce == PipelineReduce::MaxAbs, "reduce parsed");
+    expect(std::string(pipelineReduceName(reduce)) == "max_abs", "reduce name round-trips");
+    expect(parsePipelineInput("drive", input) && input == PipelineInput::Drive, "input parsed");
+    expect(!parsePipelineInput("sink", input) && !parsePipelineReduce("median", reduce), "unknown names rejected");
+}
+
+} // namespace
+
+int main() {
+    testIdentity();
+    testLinear();
+    testBroadcastAndConstant();
+    testReduce();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_engine_pipeline: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_engine_pipeline: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * dase_cli extraction buffers test
+ *
+ * BufferPool must hand released capacity back out (smallest buffer that
+ * fits, else the largest one grown), free what exceeds its buffer and
+ * byte limits, and RequestArena must return its buffers and fields to the
+ * pool when it goes away - so a repeated poll reuses the same memory.
+ *
+ * Build: g++ -std=c++17 -pthread -Idase_cli/src tests/test_cli_extraction_buffers.cpp dase_cli/src/extraction_buffers.cpp
+ */
+
+#include "../dase_cli/src/extraction_buffers.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+void testReuse() {
+    BufferPool pool;
+    std::vector<double> first = pool.acquire(1000);
+    expect(first.size() == 1000, "acquire sizes the buffer");
+    const double* data = first.data();
+    pool.release(std::move(first));
+    expect(pool.stats()["buffers"] == 1, "released buffer pooled");
+
+    std::vector<double> again = pool.acquire(800);
+    expect(again.data() == data && again.size() == 800, "smaller request reuses the buffer");
+    expect(pool.stats()["reused"] == 1 && pool.stats()["buffers"] == 0, "reuse counted");
+    pool.release(std::move(again));
+
+    std::vector<double> small(100);
+    pool.release(std::move(small));
+    std::vector<double> fit = pool.acquire(50);
+    expect(fit.capacity() == 100, "smallest buffer that fits is chosen");
+    std::vector<double> grown = pool.acquire(5000);
+    expect(grown.size() == 5000 && pool.stats()["buffers"] == 0, "largest buffer grown when none fits");
+
+    pool.release(std::vector<double>());
+    expect(pool.stats()["buffers"] == 0, "empty buffers are not pooled");
+}
+
+void testLimits() {
+    BufferPool pool(2, 1000 * sizeof(double));
+    pool.release(std::vector<double>(400));
+    pool.release(std::vector<double>(400));
+    pool.release(std::vector<double>(10));
+    expect(pool.stats()["buffers"] == 2 && pool.stats()["dropped"] == 1, "buffer count limit");
+
+    pool.clear();
+    pool.release(std::vector<double>(800));
+    pool.release(std::vector<double>(400));
+    expect(pool.stats()["buffers"] == 1 && pool.stats()["pooled_bytes"] == 800 * sizeof(double),
+           "byte limit");
+}
+
+void testArena() {
+    BufferPool pool;
+    const double* scratch_data = nullptr;
+    const double* field_data = nullptr;
+    {
+        RequestArena arena(pool);
+        std::vector<double>& scratch = arena.take(256);
+        scratch_data = scratch.data();
+        auto& fields = arena.fields();
+        fields.resize(2);
+        fields[0] = pool.acquire(512);
+        field_data = fields[0].data();
+        fields[1] = pool.acquire(64);
+        std::vector<double> moved_out = std::move(fields[1]);   // Left empty, as after a segment move
+        bool threw = false;
+        try {
+            for (size_t i = 1; i <= RequestArena::kMaxBuffers; ++i) {
+                arena.take(1);
+            }
+        } catch (const std::length_error&) {
+            threw = true;
+        }
+        expect(threw, "arena refuses more than kMaxBuffers");
+    }
+    expect(pool.stats()["buffers"] == 9, "arena returns its buffers and fields");
+
+    // A second identical request is served entirely from the pool
+    const auto reused_before = pool.stats()["reused"].get<uint64_t>();
+    {
+        RequestArena arena(pool);
+        const double* got_field = pool.acquire(512).data();
+        expect(got_field == field_data, "field buffer reused");
+        expect(arena.take(256).data() == scratch_data, "scratch buffer reused");
+    }
+    expect(pool.stats()["reused"].get<uint64_t>() == reused_before + 2, "second poll allocates nothing");
+}
+
+} // namespace
+
+int main() {
+    testReuse();
+    testLimits();
+    testArena();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_extraction_buffers: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_extraction_buffers: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * dase_cli JSON text writer test
+ *
+ * A response without segment references must be written exactly as
+ * dump() writes it; segment references must become JSON arrays that parse
+ * back to the same doubles bit for bit (shortest round-trip) or to within
+ * the requested significant digits, with integral values kept floats,
+ * non-finite values written as null and dangling references as null.
+ * References tagged "precision": "f32" must be written as the shortest
+ * text of their float32 values.
+ *
+ * Build: g++ -std=c++17 -O2 -Idase_cli/src tests/test_cli_json_text_writer.cpp dase_cli/src/json_text_writer.cpp dase_cli/src/binary_protocol.cpp dase_cli/src/segment_codec.cpp
+ */
+
+#include "../dase_cli/src/json_text_writer.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace dase::protocol;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+void testPlain() {
+    const json response = {
+        {"status", "success"},
+        {"command", "get_state"},
+        {"result", {{"num_nodes", 3}, {"label", "a \"quoted\"\nline"}, {"values", {1.5, -2.0, 3}}}},
+        {"execution_time_ms", 0.25}
+    };
+    expect(dumpJsonText(response, {}) == response.dump(), "plain envelope written as dump()");
+}
+
+void testSegments() {
+    std::vector<double> psi(2000);
+    for (size_t i = 0; i < psi.size(); ++i) {
+        psi[i] = std::sin(0.37 * static_cast<double>(i)) * std::pow(10.0, static_cast<double>(i % 40) - 20.0);
+    }
+    psi[1] = std::numeric_limits<double>::denorm_min();
+    psi[2] = -0.0;
+    psi[3] = 3.0;
+    psi[4] = 1e300;
+    const Segments segments = {psi, {std::numeric_limits<double>::quiet_NaN(), 2.0}};
+    const json response = {
+        {"status", "success"},
+        {"result", {{"psi_real", segmentReference(0, psi.size())},
+                    {"snapshots", json::array({{{"phi", segmentReference(1, 2)}, {"step", 4}}})},
+                    {"missing", segmentReference(7, 3)}}}
+    };
+
+    const std::string text = dumpJsonText(response, segments);
+    const json parsed = json::parse(text);
+    const json& values = parsed["result"]["psi_real"];
+    bool exact = values.is_array() && values.size() == psi.size();
+    for (size_t i = 0; exact && i < psi.size(); ++i) {
+        exact = values[i].is_number_float() && sameBits(values[i].get<double>(), psi[i]);
+    }
+    expect(exact, "shortest round-trip values parse back bit for bit");
+    expect(text.find("3.0,") != std::string::npos, "integral value kept a float");
+    expect(parsed["result"]["snapshots"][0]["phi"][0].is_null() &&
+           parsed["result"]["snapshots"][0]["phi"][1].get<double>() == 2.0, "NaN written as null");
+    expect(parsed["result"]["snapshots"][0]["step"] == 4, "nested envelope fields kept");
+    expect(parsed["result"]["missing"].is_null(), "dangling reference written as null");
+
+    json dom = response;
+    dom["result"]["psi_real"] = psi;
+    dom["result"]["snapshots"][0]["phi"] = {nullptr, 2.0};
+    dom["result"]["missing"] = nullptr;
+    expect(parsed == json::parse(dom.dump()), "same document as the DOM dump");
+
+    const std::string short_text = dumpJsonText(response, segments, 9);
+    const json short_parsed = json::parse(short_text);
+    const json& rounded = short_parsed["result"]["psi_real"];
+    bool close = rounded.size() == psi.size();
+    for (size_t i = 0; close && i < psi.size(); ++i) {
+        close = std::fabs(rounded[i].get<double>() - psi[i]) <= 1e-8 * std::fabs(psi[i]);
+    }
+    expect(close, "9 significant digits");
+    expect(short_text.size() < text.size(), "fewer digits, shorter text");
+
+    std::vector<double> narrowed(psi.begin() + 10, psi.begin() + 210);   // within float range
+    for (double& value : narrowed) value = static_cast<float>(value);
+    json f32_ref = segmentReference(0, narrowed.size());
+    f32_ref["precision"] = "f32";
+    const std::string f32_text = dumpJsonText({{"phi", f32_ref}}, {narrowed});
+    const std::string f64_text = dumpJsonText({{"phi", segmentReference(0, narrowed.size())}}, {narrowed});
+    const json f32_values = json::parse(f32_text)["phi"];
+    bool narrow = f32_values.size() == narrowed.size();
+    for (size_t i = 0; narrow && i < narrowed.size(); ++i) {
+        narrow = static_cast<float>(f32_values[i].get<double>()) == static_cast<float>(narrowed[i]);
+    }
+    expect(narrow, "f32 references round-trip their float32 values");
+    expect(f32_text.size() < f64_text.size(), "f32 references written shorter");
+
+    // Informational: DOM build + dump against the direct writer
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::string dom_text = json(psi).dump();
+    const auto t1 = std::chrono::steady_clock::now();
+    std::string direct;
+    appendNumberArray(direct, psi.data(), psi.size());
+    const auto t2 = std::chrono::steady_clock::now();
+    std::cout << "DOM dump " << std::chrono::duration<double, std::micro>(t1 - t0).count()
+              << " us, direct " << std::chrono::duration<double, std::micro>(t2 - t1).count()
+              << " us (" << psi.size() << " values)" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    testPlain();
+    testSegments();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_json_text_writer: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_json_text_writer: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * dase_cli line pipeline test
+ *
+ * LinePipeline must answer every non-empty line once, in input order, with
+ * streamed messages ahead of their command's response; pass parse errors
+ * through to the executor; turn executor and serializer exceptions into
+ * INTERNAL_ERROR lines; and hold no more than queue_depth requests ahead
+ * of execution.  Serialization must run off the executor thread.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_line_pipeline.cpp dase_cli/src/line_pipeline.cpp -pthread
+ */
+
+#include "../dase_cli/src/line_pipeline.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::vector<std::string> lines(const std::string& text) {
+    std::vector<std::string> result;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        result.push_back(line);
+    }
+    return result;
+}
+
+void testOrderAndStreaming() {
+    std::string input;
+    const int count = 500;
+    for (int i = 0; i < count; ++i) {
+        input += "{\"n\": " + std::to_string(i) + "}\n";
+        if (i % 7 == 0) input += "\n";                  // Skipped
+    }
+    input += "{not json\n";
+    input += "{\"throw\": true}\n";
+    input += "{\"bad_dump\": true}\n";
+
+    std::istringstream in(input);
+    std::ostringstream out;
+    LinePipelineOptions options;
+    options.queue_depth = 4;
+    options.flush_bytes = 100;
+    LinePipeline pipeline(options);
+
+    const std::thread::id executor = std::this_thread::get_id();
+    std::atomic<bool> serialized_off_executor{true};
+    std::atomic<int> parse_errors{0};
+
+    pipeline.run(in, out,
+        [&](PipelineRequest& request, PipelineResponse& response) {
+            if (!request.parse_error.empty()) {
+                parse_errors++;
+                response.envelope = {{"status", "error"}, {"error_code", "PARSE_ERROR"}};
+                return;
+            }
+            if (request.command.contains("throw")) {
+                throw std::runtime_error("boom");
+            }
+            if (request.command.contains("bad_dump")) {
+                response.envelope = {{"dump", "throw"}};
+                return;
+            }
+            const int n = request.command["n"].get<int>();
+            if (n % 50 == 0) {
+                pipeline.emit("stream " + std::to_string(n));
+            }
+            response.envelope = {{"n", n}};
+            response.bytes_in = request.line.size();
+        },
+        [&](PipelineResponse& response) {
+            if (std::this_thread::get_id() == executor) {
+                serialized_off_executor = false;
+            }
+            if (response.envelope.contains("dump")) {
+                throw std::runtime_error("cannot dump");
+            }
+            return response.envelope.dump();
+        });
+
+    const std::vector<std::string> output = lines(out.str());
+    expect(output.size() == static_cast<size_t>(count + count / 50 + 3), "one line per request and message");
+
+    size_t k = 0;
+    bool in_order = true;
+    for (int i = 0; i < count && k < output.size(); ++i) {
+        if (i % 50 == 0) {
+            in_order = in_order && output[k++] == "stream " + std::to_string(i);
+        }
+        in_order = in_order && k < output.size() && output[k++] == json({{"n", i}}).dump();
+    }
+    expect(in_order, "responses in input order, streamed messages first");
+    expect(parse_errors == 1, "parse error reaches the executor");
+    expect(k + 3 == output.size() && output[k].find("PARSE_ERROR") != std::string::npos,
+           "parse error answered in place");
+    expect(k + 3 == output.size() && output[k + 1].find("INTERNAL_ERROR") != std::string::npos &&
+           output[k + 1].find("boom") != std::string::npos, "executor exception becomes INTERNAL_ERROR");
+    expect(k + 3 == output.size() && output[k + 2].find("INTERNAL_ERROR") != std::string::npos &&
+           output[k + 2].find("cannot dump") != std::string::npos, "serializer exception becomes INTERNAL_ERROR");
+    expect(serialized_off_executor, "serialization runs on the writer thread");
+}
+
+// Input that hands the reader one line per underflow and counts them
+class CountingLines : public std::streambuf {
+public:
+    explicit CountingLines(int count) : count_(count) {}
+    size_t served() const { return served_.load(); }
+
+protected:
+    int_type underflow() override {
+        if (static_cast<int>(served_.load()) == count_) {
+            return traits_type::eof();
+        }
+        line_ = "{\"n\": " + std::to_string(served_.load()) + "}\n";
+        served_++;
+        setg(&line_[0], &line_[0], &line_[0] + line_.size());
+        return traits_type::to_int_type(line_[0]);
+    }
+
+private:
+    const int count_;
+    std::atomic<size_t> served_{0};
+    std::string line_;
+};
+
+void testBoundedReadAhead() {
+    CountingLines buffer(1000);
+    std::istream in(&buffer);
+    std::ostringstream out;
+
+    LinePipelineOptions options;
+    options.queue_depth = 8;
+    LinePipeline pipeline(options);
+    size_t max_ahead = 0;
+    size_t executed = 0;
+    pipeline.run(in, out,
+        [&](PipelineRequest&, PipelineResponse& response) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            // Lines read beyond this one: the queue, one being pushed and
+            // one being read
+            max_ahead = std::max(max_ahead, buffer.served() - executed - 1);
+            executed++;
+            response.envelope = json::object();
+        },
+        [](PipelineResponse& response) { return response.envelope.dump(); });
+
+    expect(executed == 1000, "every request executed");
+    expect(max_ahead <= options.queue_depth + 2, "reader stays within queue_depth of the executor");
+}
+
+} // namespace
+
+int main() {
+    testOrderAndStreaming();
+    testBoundedReadAhead();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_line_pipeline: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_line_pipeline: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * dase_cli line server test
+ *
+ * A LineServer on an ephemeral TCP port must give every client its own
+ * session, deliver request lines in order (CRLF stripped), carry any number
+ * of replies per request, and shut down cleanly while a client is still
+ * connected.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_line_server.cpp dase_cli/src/line_server.cpp -pthread
+ */
+
+#include "../dase_cli/src/line_server.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace dase;
+
+namespace {
+
+std::atomic<int> live_sessions{0};
+
+// Replies "<n>:<line>" for the session's n-th line; "twice" gets two replies
+class CountingSession : public LineSession {
+public:
+    CountingSession() { live_sessions++; }
+    ~CountingSession() override { live_sessions--; }
+
+    void onLine(const std::string& line, LineWriter& out) override {
+        ++count_;
+        out.writeLine(std::to_string(count_) + ":" + line);
+        if (line == "twice") {
+            out.writeLine(std::to_string(count_) + ":again");
+        }
+    }
+
+private:
+    int count_ = 0;
+};
+
+}  // namespace
+
+int main() {
+    bool ok = true;
+
+    LineEndpoint endpoint;
+    std::string error;
+    if (!LineEndpoint::parse("tcp:127.0.0.1:0", endpoint, error)) {
+        std::cerr << "endpoint parse failed: " << error << std::endl;
+        return 1;
+    }
+    LineEndpoint rejected;
+    if (LineEndpoint::parse("pipe:foo", rejected, error) || LineEndpoint::parse("tcp:70000", rejected, error)) {
+        std::cerr << "invalid endpoint was accepted" << std::endl;
+        ok = false;
+    }
+
+    LineServer server;
+    if (!server.listen(endpoint, error) || server.port() == 0) {
+        std::cerr << "listen failed: " << error << std::endl;
+        return 1;
+    }
+    endpoint.port = server.port();
+    std::thread serving([&server] {
+        server.serve([] { return std::make_unique<CountingSession>(); });
+    });
+
+    LineClient first;
+    LineClient second;
+    if (!first.connect(endpoint, error) || !second.connect(endpoint, error)) {
+        std::cerr << "connect failed: " << error << std::endl;
+        ok = false;
+    } else {
+        std::string reply;
+        first.writeLine("alpha\r");
+        first.writeLine("twice");
+        second.writeLine("beta");
+
+        const char* first_expected[] = {"1:alpha", "2:twice", "2:again"};
+        for (const char* expected : first_expected) {
+            if (!first.readLine(reply) || reply != expected) {
+                std::cerr << "first client got '" << reply << "', expected '" << expected << "'" << std::endl;
+                ok = false;
+            }
+        }
+        // Sessions are independent: the second client's count starts at 1
+        if (!second.readLine(reply) || reply != "1:beta") {
+            std::cerr << "second client got '" << reply << "'" << std::endl;
+            ok = false;
+        }
+
+        // A disconnected client's session is destroyed
+        first.close();
+        for (int i = 0; i < 100 && live_sessions.load() != 1; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (live_sessions.load() != 1) {
+            std::cerr << "session not released on disconnect" << std::endl;
+            ok = false;
+        }
+    }
+
+    // stop() must end serve() even with the second client still connected
+    server.stop();
+    serving.join();
+    if (live_sessions.load() != 0) {
+        std::cerr << "sessions outlived the server" << std::endl;
+        ok = false;
+    }
+    std::string reply;
+    if (second.readLine(reply)) {
+        std::cerr << "connection still open after stop" << std::endl;
+        ok = false;
+    }
+
+    std::cout << (ok ? "CLI line server test passed" : "CLI line server test FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
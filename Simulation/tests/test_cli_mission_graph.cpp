@@ -0,0 +1,246 @@
+/**
+ * dase_cli mission graph test
+ *
+ * MissionGraph must order nodes after their explicit and referenced
+ * dependencies, reject duplicate / unknown ids and cycles, run independent
+ * nodes at the same time within the thread, memory and concurrency limits,
+ * run exclusive nodes alone, hand each node its dependencies' results,
+ * give hinted nodes their OMP team, and skip the dependents of a failure
+ * (everything not yet started with stop_on_error).
+ *
+ * Build: g++ -std=c++17 -fopenmp -pthread -Idase_cli/src tests/test_cli_mission_graph.cpp dase_cli/src/mission_graph.cpp dase_cli/src/batch_references.cpp
+ */
+
+#include "../dase_cli/src/mission_graph.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase;
+using json = nlohmann::json;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool allConcurrent(const std::string&) { return true; }
+
+size_t position(const MissionGraph& graph, const std::string& id) {
+    for (size_t k = 0; k < graph.order().size(); ++k) {
+        if (graph.nodes()[graph.order()[k]].id == id) return k;
+    }
+    return graph.order().size();
+}
+
+json success(const json& result) {
+    return {{"status", "success"}, {"result", result}};
+}
+
+void testBuild() {
+    MissionGraph graph;
+    std::string error;
+    const json nodes = json::parse(R"([
+        {"id": "combine", "command": "analyze", "params": {"a": "$run_a.value", "b": "$run_b"}},
+        {"id": "run_a", "command": "run_mission", "params": {"engine_id": "$make_a.engine_id"}},
+        {"id": "make_a", "command": "create_engine"},
+        {"id": "run_b", "command": "run_mission", "depends_on": ["make_a"], "threads": 2, "memory_mb": 1.5},
+        {"id": "other", "command": "get_metrics", "params": {"path": "$HOME/x", "lit": "$$run_a"}}
+    ])");
+    expect(graph.build(nodes, [](const std::string& c) { return c != "analyze"; }, error), "graph builds: " + error);
+    expect(graph.nodes().size() == 5 && graph.order().size() == 5, "every node ordered");
+    expect(position(graph, "make_a") < position(graph, "run_a") && position(graph, "make_a") < position(graph, "run_b") &&
+           position(graph, "run_a") < position(graph, "combine") && position(graph, "run_b") < position(graph, "combine"),
+           "dependencies come first");
+    expect(graph.nodes()[0].depends_on.size() == 2 && graph.nodes()[1].depends_on.size() == 1,
+           "references are dependencies");
+    expect(graph.nodes()[4].depends_on.empty(), "non-node and escaped references are not dependencies");
+    expect(graph.nodes()[0].exclusive && !graph.nodes()[1].exclusive, "exclusive commands marked");
+    expect(graph.nodes()[3].threads == 2 && graph.nodes()[3].memory_bytes == 1572864, "resource hints read");
+
+    const char* bad[] = {
+        R"([{"id": "a", "command": "x"}, {"id": "a", "command": "y"}])",
+        R"([{"id": "a", "command": "x", "depends_on": ["b"]}])",
+        R"([{"id": "a", "command": "x", "params": {"p": "$b.v"}}, {"id": "b", "command": "y", "depends_on": ["a"]}])",
+        R"([{"id": "a", "command": "x", "params": {"p": "$a.v"}}])",
+        R"([{"id": "1a", "command": "x"}])",
+        R"([{"id": "a"}])",
+        R"([{"id": "a", "command": "x", "threads": -1}])",
+        R"([])"
+    };
+    for (const char* text : bad) {
+        MissionGraph rejected;
+        std::string why;
+        expect(!rejected.build(json::parse(text), allConcurrent, why) && !why.empty(),
+               std::string("rejected: ") + text);
+    }
+    MissionGraph cyclic;
+    cyclic.build(json::parse(R"([{"id": "a", "command": "x", "depends_on": ["b"]},
+                                 {"id": "b", "command": "x", "depends_on": ["a"]}])"), allConcurrent, error);
+    expect(error.find("cycle") != std::string::npos, "cycle reported");
+}
+
+void testConcurrencyAndResults() {
+    MissionGraph graph;
+    std::string error;
+    graph.build(json::parse(R"([
+        {"id": "a", "command": "create", "params": {"value": 1}},
+        {"id": "b", "command": "create", "params": {"value": 2}},
+        {"id": "c", "command": "create", "params": {"value": 3}},
+        {"id": "sum", "command": "combine", "params": {"inputs": ["$a.value", "$b.value", "$c.value"]}}
+    ])"), allConcurrent, error);
+
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    MissionGraphLimits limits;
+    limits.threads = 8;
+    const auto responses = graph.run([&](const MissionGraphNode& node, const json& command) -> json {
+        const int now = ++running;
+        int expected = peak.load();
+        while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        --running;
+        if (node.id == "sum") {
+            int total = 0;
+            for (const auto& v : command["params"]["inputs"]) total += v.get<int>();
+            return success({{"total", total}});
+        }
+        return success({{"value", command["params"]["value"].get<int>() * 10}});
+    }, limits);
+
+    expect(responses.size() == 4 && responses[3]["result"]["total"] == 60, "dependency results reach the node");
+    expect(peak == 3 && graph.lastStats().peak_running == 3, "independent nodes run at the same time");
+    expect(responses[0]["id"] == "a" && responses[3]["depends_on"].size() == 3 &&
+           responses[3]["started_ms"].get<double>() >= responses[0]["wall_ms"].get<double>(),
+           "results annotated; dependents start after their dependencies");
+    expect(graph.lastStats().executed == 4 && graph.lastStats().failed == 0, "all nodes executed");
+}
+
+void testLimits() {
+    MissionGraph graph;
+    std::string error;
+    graph.build(json::parse(R"([
+        {"id": "w1", "command": "run", "threads": 3},
+        {"id": "w2", "command": "run", "threads": 3},
+        {"id": "w3", "command": "run", "threads": 16},
+        {"id": "m1", "command": "run", "memory_mb": 60},
+        {"id": "m2", "command": "run", "memory_mb": 60},
+        {"id": "x", "command": "exclusive"},
+        {"id": "y", "command": "run"}
+    ])"), [](const std::string& c) { return c != "exclusive"; }, error);
+
+    std::mutex mutex;
+    std::vector<std::string> active;
+    bool exclusive_overlapped = false;
+    std::vector<int> teams(7, 0);
+    MissionGraphLimits limits;
+    limits.threads = 4;
+    limits.memory_bytes = 100ull * 1024 * 1024;
+    graph.run([&](const MissionGraphNode& node, const json&) -> json {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if ((node.exclusive && !active.empty()) || (!active.empty() && active[0] == "x")) {
+                exclusive_overlapped = true;
+            }
+            active.push_back(node.id);
+        }
+#ifdef _OPENMP
+        if (node.threads > 0) {
+            teams[node.id == "w1" ? 0 : node.id == "w2" ? 1 : 2] = omp_get_max_threads();
+        }
+#endif
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<std::mutex> lock(mutex);
+        active.erase(std::find(active.begin(), active.end(), node.id));
+        return success(json::object());
+    }, limits);
+
+    const auto stats = graph.lastStats();
+    expect(stats.executed == 7 && stats.peak_threads <= 4, "thread tokens stay within the budget");
+    expect(stats.peak_memory_bytes <= limits.memory_bytes, "memory hints stay within the limit");
+    expect(!exclusive_overlapped, "exclusive node runs alone");
+#ifdef _OPENMP
+    expect(teams[0] == 3 && teams[1] == 3 && teams[2] == 4, "hinted nodes run with their (clamped) team");
+#endif
+
+    MissionGraph serial;
+    serial.build(json::parse(R"([{"id": "a", "command": "run"}, {"id": "b", "command": "run"},
+                                 {"id": "c", "command": "run"}])"), allConcurrent, error);
+    limits.max_concurrent = 1;
+    serial.run([](const MissionGraphNode&, const json&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return success(json::object());
+    }, limits);
+    expect(serial.lastStats().peak_running == 1, "max_concurrent caps running nodes");
+}
+
+void testFailures() {
+    const json nodes = json::parse(R"([
+        {"id": "bad", "command": "fail"},
+        {"id": "child", "command": "run", "params": {"v": "$bad.value"}},
+        {"id": "grandchild", "command": "run", "depends_on": ["child"]},
+        {"id": "slow", "command": "run", "params": {"sleep": 40}},
+        {"id": "after_slow", "command": "run", "depends_on": ["slow"]},
+        {"id": "bad_ref", "command": "run", "params": {"v": "$slow.missing"}}
+    ])");
+    const auto runner = [](const MissionGraphNode&, const json& command) -> json {
+        if (command["command"] == "fail") {
+            return {{"status", "error"}, {"error", "boom"}};
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(command["params"].value("sleep", 1)));
+        return success({{"value", 1}});
+    };
+
+    MissionGraph graph;
+    std::string error;
+    graph.build(nodes, allConcurrent, error);
+    MissionGraphLimits limits;
+    limits.threads = 8;
+    limits.stop_on_error = false;
+    auto responses = graph.run(runner, limits);
+    expect(responses[0]["status"] == "error", "failing node reported");
+    expect(responses[1]["status"] == "skipped" && responses[1]["error_code"] == "DEPENDENCY_FAILED" &&
+           responses[2]["status"] == "skipped", "dependents of a failure skipped");
+    expect(responses[4]["status"] == "success", "unrelated branch runs on");
+    expect(responses[5]["status"] == "error" && responses[5]["error_code"] == "INVALID_REFERENCE",
+           "missing key in a dependency's result fails the node");
+    expect(graph.lastStats().failed == 2 && graph.lastStats().skipped == 2, "failure counts");
+
+    limits.stop_on_error = true;
+    responses = graph.run(runner, limits);
+    expect(responses[4]["status"] == "skipped" && responses[4]["error_code"] == "GRAPH_STOPPED",
+           "stop_on_error skips nodes not yet started");
+    expect(responses[3]["status"] == "success", "running nodes finish");
+}
+
+} // namespace
+
+int main() {
+    testBuild();
+    testConcurrencyAndResults();
+    testLimits();
+    testFailures();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_mission_graph: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_mission_graph: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * dase_cli router stats test
+ *
+ * Latency histogram percentiles must stay within the bucket precision (~3%)
+ * from nanoseconds to seconds, and RouterStats must key rows by command,
+ * ignore transport records for commands it never dispatched, and clear on
+ * reset.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_router_stats.cpp dase_cli/src/router_stats.cpp -pthread
+ */
+
+#include "../dase_cli/src/router_stats.h"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool near(uint64_t value, uint64_t expected, double tolerance) {
+    return std::fabs(static_cast<double>(value) - static_cast<double>(expected)) <=
+           tolerance * static_cast<double>(expected) + 1.0;
+}
+
+} // namespace
+
+int main() {
+    // Uniform 1..100000 ns: percentile p is p% of the range
+    LatencyHistogram uniform;
+    for (uint64_t ns = 1; ns <= 100000; ++ns) {
+        uniform.record(ns);
+    }
+    expect(uniform.count() == 100000, "histogram count");
+    expect(near(uniform.percentile(50.0), 50000, 0.035), "uniform p50");
+    expect(near(uniform.percentile(99.0), 99000, 0.035), "uniform p99");
+    expect(uniform.percentile(100.0) == 100000, "p100 is the max");
+    expect(uniform.percentile(0.0) == 1, "p0 is the min");
+
+    // Exact below 32 ns, relative precision across many octaves
+    LatencyHistogram small;
+    small.record(7);
+    expect(small.percentile(50.0) == 7, "small values are exact");
+    for (uint64_t ns : {uint64_t(1000), uint64_t(123456789), uint64_t(5000000000ull)}) {
+        LatencyHistogram one;
+        one.record(ns);
+        one.record(ns * 2);
+        expect(near(one.percentile(50.0), ns, 0.035), "single value at " + std::to_string(ns));
+    }
+
+    RouterStats stats;
+    stats.recordExecute("get_state", 2000000, true);
+    stats.recordExecute("get_state", 4000000, false);
+    stats.recordTransport("get_state", 1000, 9000000, 60, 5000000);
+    stats.recordTransport("made_up", 1000, 1000, 10, 10);   // Never dispatched
+    stats.recordParseError(17);
+
+    json table = stats.toJson();
+    const json& row = table["commands"]["get_state"];
+    expect(row["calls"] == 2 && row["errors"] == 1, "call / error counts");
+    expect(row["bytes_in"] == 60 && row["bytes_out"] == 5000000, "byte counts");
+    expect(row["execute"]["count"] == 2 && row["serialize"]["count"] == 1, "phase counts");
+    expect(std::fabs(row["serialize"]["p50_us"].get<double>() - 9000.0) < 9000.0 * 0.035, "serialize p50");
+    expect(!table["commands"].contains("made_up"), "undispatched command kept out");
+    expect(table["totals"]["parse_errors"] == 1 && table["totals"]["bytes_in"] == 77, "totals");
+    expect(stats.toJson("run_steps")["commands"].empty(), "command filter");
+
+    stats.reset();
+    expect(stats.toJson()["commands"].empty(), "reset clears rows");
+
+    if (failures == 0) {
+        std::cout << "Router stats: PASS" << std::endl;
+        return 0;
+    }
+    return 1;
+}
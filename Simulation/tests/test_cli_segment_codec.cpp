@@ -0,0 +1,200 @@
+/**
+ * dase_cli segment codec test
+ *
+ * f32 / f16 quantization must round to nearest and report the largest
+ * error; blocks of every quantization / delta / compression combination
+ * must decode to the quantized values bit for bit, delta blocks of a
+ * slowly evolving field must be much smaller than key blocks, a delta
+ * block without its reference must be rejected, and encoded frames must
+ * round-trip through writeFrame / readFrame with per-stream delta state.
+ *
+ * Build: g++ -std=c++17 -O2 -Idase_cli/src tests/test_cli_segment_codec.cpp dase_cli/src/segment_codec.cpp dase_cli/src/binary_protocol.cpp
+ *        (add -DDASE_HAVE_ZLIB ... -lz to cover zlib)
+ */
+
+#include "../dase_cli/src/binary_protocol.h"
+#include "../dase_cli/src/segment_codec.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dase::protocol;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool sameBits(const std::vector<double>& a, const std::vector<double>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0);
+}
+
+// A static background with a pulse evolving over its first sixteenth
+std::vector<double> field(size_t n, double t) {
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double x = static_cast<double>(i);
+        values[i] = std::sin(0.01 * x) * std::exp(-1e-4 * x);
+        if (i < n / 16) {
+            values[i] += 1e-2 * std::sin(0.05 * x + 0.3 * t);
+        }
+    }
+    return values;
+}
+
+void testQuantize() {
+    std::vector<double> values = {1.0, 0.1, -2.5, 65504.0, 1e5, 3e-8, 0.0, std::numeric_limits<double>::quiet_NaN()};
+    const double error = quantize(Quantization::F16, values.data(), values.size());
+    expect(values[0] == 1.0 && values[2] == -2.5 && values[3] == 65504.0, "f16 keeps representable values");
+    expect(values[1] == 0.0999755859375, "f16 rounds 0.1 to nearest");
+    expect(std::isinf(values[4]) && std::isinf(error), "f16 overflow reported as infinite error");
+    expect(values[5] == std::ldexp(1.0, -24), "f16 subnormal rounds to nearest");
+    expect(std::isnan(values[7]), "NaN stays NaN");
+
+    std::vector<double> smooth = field(1000, 0.0);
+    const std::vector<double> original = smooth;
+    const double f32_error = quantize(Quantization::F32, smooth.data(), smooth.size());
+    double max_seen = 0.0;
+    for (size_t i = 0; i < smooth.size(); ++i) {
+        expect(smooth[i] == static_cast<double>(static_cast<float>(original[i])), "f32 rounds like a float cast");
+        max_seen = std::max(max_seen, std::fabs(smooth[i] - original[i]));
+    }
+    expect(f32_error == max_seen && f32_error > 0.0 && f32_error < 1e-7, "f32 max error reported");
+    expect(quantize(Quantization::F64, smooth.data(), smooth.size()) == 0.0, "f64 is exact");
+}
+
+void testBlocks() {
+    const Compression compressions[] = {Compression::None, Compression::Rle, Compression::Zlib};
+    for (Quantization quantization : {Quantization::F64, Quantization::F32, Quantization::F16}) {
+        for (Compression compression : compressions) {
+            if (!compressionAvailable(compression)) {
+                continue;
+            }
+            for (bool delta : {false, true}) {
+                SegmentEncoding encoding;
+                encoding.quantization = quantization;
+                encoding.compression = compression;
+                encoding.delta = delta;
+                SegmentEncoder encoder;
+                SegmentDecoder decoder;
+                const std::string label = encoding.describe().dump();
+                size_t key_bytes = 0;
+                size_t delta_bytes = 0;
+                for (int snapshot = 0; snapshot < 4; ++snapshot) {
+                    std::vector<double> values = field(4096, snapshot);
+                    quantize(quantization, values.data(), values.size());
+                    std::vector<uint8_t> block;
+                    encoder.encode(3, encoding, values.data(), values.size(), block);
+                    (snapshot == 0 ? key_bytes : delta_bytes) = block.size();
+                    std::vector<double> decoded;
+                    std::string error;
+                    expect(decoder.decode(block.data(), block.size(), decoded, error) && sameBits(decoded, values),
+                           label + ": block round-trips bit for bit " + error);
+                }
+                if (delta && compression != Compression::None) {
+                    expect(delta_bytes * 4 < key_bytes, label + ": delta blocks of a slow field are small");
+                }
+                if (quantization == Quantization::F16 && compression == Compression::None && !delta) {
+                    expect(key_bytes == kCodecBlockHeaderBytes + 2 * 4096, label + ": two bytes per f16 value");
+                }
+            }
+        }
+    }
+
+    // A delta block needs its reference
+    SegmentEncoding encoding;
+    encoding.delta = true;
+    encoding.compression = Compression::Rle;
+    SegmentEncoder encoder;
+    std::vector<uint8_t> first;
+    std::vector<uint8_t> second;
+    const std::vector<double> a = field(256, 0.0);
+    const std::vector<double> b = field(256, 1.0);
+    encoder.encode(0, encoding, a.data(), a.size(), first);
+    encoder.encode(0, encoding, b.data(), b.size(), second);
+    SegmentDecoder fresh;
+    std::vector<double> decoded;
+    std::string error;
+    expect(!fresh.decode(second.data(), second.size(), decoded, error), "delta block without reference rejected");
+    first[1] = 0x80;
+    expect(!fresh.decode(first.data(), first.size(), decoded, error), "unknown block flag rejected");
+
+    std::vector<uint8_t> key;
+    encoder.encode(0, encoding, b.data(), b.size(), key, true);
+    expect(fresh.decode(key.data(), key.size(), decoded, error) && sameBits(decoded, b), "forced key block");
+
+    SegmentEncoding parsed;
+    expect(SegmentEncoding::parse({{"quantize", "f16"}, {"delta", true}, {"compression", "rle"}}, parsed, error) &&
+           parsed.quantization == Quantization::F16 && parsed.delta, "encoding parsed");
+    expect(!SegmentEncoding::parse({{"quantize", "f8"}}, parsed, error) &&
+           !SegmentEncoding::parse({{"compression", "zstd"}}, parsed, error), "bad encodings rejected");
+}
+
+void testFrames() {
+    SegmentEncoder encoder;
+    SegmentDecoder decoder;
+    std::stringstream stream;
+    std::vector<std::vector<double>> sent;
+    uint64_t encoded_bytes = 0;
+    uint64_t raw_bytes = 0;
+    for (int snapshot = 0; snapshot < 5; ++snapshot) {
+        std::vector<double> phi = field(8192, snapshot);
+        quantize(Quantization::F32, phi.data(), phi.size());
+        sent.push_back(phi);
+
+        json reference = segmentReference(0, phi.size());
+        reference["encoding"] = {{"quantize", "f32"}, {"delta", true}, {"compression", "rle"}};
+        reference["channel"] = 0;
+        Frame frame;
+        frame.envelope = {{"status", "streaming"}, {"snapshot", {{"phi", reference}, {"steps", segmentReference(1, 2)}}}};
+        frame.segments = {phi, {1.0, 2.0}};
+        encoded_bytes += writeFrame(stream, frame, &encoder);
+        raw_bytes += 20 + 16 + json::to_cbor(frame.envelope).size() + (phi.size() + 2) * sizeof(double);
+    }
+    expect(encoded_bytes * 4 < raw_bytes, "encoded frames at least 4x smaller");
+
+    for (size_t snapshot = 0; snapshot < sent.size(); ++snapshot) {
+        Frame in;
+        std::string error;
+        const bool read = readFrame(stream, in, error, &decoder) == ReadStatus::Ok;
+        expect(read && in.encoded && in.segments.size() == 2 && sameBits(in.segments[0], sent[snapshot]) &&
+               in.segments[1] == std::vector<double>{1.0, 2.0}, "encoded frame " + std::to_string(snapshot) + " " + error);
+    }
+
+    // Without an encoder the tags are ignored and the frame stays raw
+    Frame plain;
+    plain.envelope = {{"phi", segmentReference(0, 1)}};
+    plain.envelope["phi"]["encoding"] = {{"quantize", "f16"}};
+    plain.segments = {{0.5}};
+    std::stringstream raw;
+    writeFrame(raw, plain);
+    Frame in;
+    std::string error;
+    expect(readFrame(raw, in, error) == ReadStatus::Ok && !in.encoded && in.segments[0] == std::vector<double>{0.5},
+           "no encoder, raw frame");
+}
+
+} // namespace
+
+int main() {
+    testQuantize();
+    testBlocks();
+    testFrames();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_segment_codec: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_segment_codec: PASS" << std::endl;
+    return 0;
+}
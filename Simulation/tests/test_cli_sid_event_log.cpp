@@ -0,0 +1,124 @@
+/**
+ * dase_cli SID event log test
+ *
+ * The ring must keep the newest `capacity` events under never-reused IDs,
+ * page from an event-ID cursor (one older than the oldest retained event
+ * resumes there), drop non-applied events with applied_only, keep its
+ * string / metadata pools bounded by the retained events, shrink and grow
+ * on configure, and round-trip through its checkpoint JSON.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_sid_event_log.cpp dase_cli/src/sid_event_log.cpp
+ */
+
+#include "../dase_cli/src/sid_event_log.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using dase::SidEventLog;
+using json = nlohmann::json;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+SidEventLog::Options options(size_t capacity, bool applied_only = false) {
+    SidEventLog::Options opts;
+    opts.capacity = capacity;
+    opts.applied_only = applied_only;
+    return opts;
+}
+
+void recordMany(SidEventLog& log, int count, int first = 0) {
+    const json metadata = {{"mode", "semantic_motion"}, {"epsilon", 0.01}};
+    for (int i = first; i < first + count; ++i) {
+        const std::string rule = "rw" + std::to_string(i % 3);
+        log.record(rule, i % 2 == 0, "Rewrite " + rule + (i % 2 == 0 ? " applied" : " not applicable"),
+                   metadata, static_cast<double>(i));
+    }
+}
+
+void testRing() {
+    SidEventLog log(options(10));
+    recordMany(log, 25);
+    expect(log.size() == 10 && log.firstId() == 15 && log.nextId() == 25, "ring keeps the newest");
+    expect(log.at(15).timestamp == 15.0 && log.at(24).rule_id == "rw0", "IDs address events");
+
+    std::vector<SidEventLog::Event> page;
+    uint64_t next = log.page(0, 4, page);
+    expect(page.size() == 4 && page.front().event_id == 15 && next == 19, "stale cursor resumes at the oldest");
+    next = log.page(next, 0, page);
+    expect(page.size() == 6 && page.back().event_id == 24 && next == 25, "limit 0 pages to the end");
+    next = log.page(next, 5, page);
+    expect(page.empty() && next == 25, "caught-up cursor is empty");
+    expect(log.page(1000, 5, page) == 25 && page.empty(), "future cursor clamps");
+    const SidEventLog::EventRef ref = log.at(20);
+    expect(ref.message == "Rewrite rw2 applied" && ref.metadata["epsilon"] == 0.01 && ref.applied,
+           "event fields");
+}
+
+void testAppliedOnly() {
+    SidEventLog log(options(100, true));
+    recordMany(log, 20);
+    expect(log.size() == 10 && log.nextId() == 10, "applied_only records applied events only");
+    expect(log.at(3).applied && log.at(3).timestamp == 6.0, "filtered events take no ID");
+}
+
+void testPoolsBounded() {
+    SidEventLog log(options(50));
+    for (int i = 0; i < 20000; ++i) {
+        // Unique messages and metadata: the pools must still be compacted
+        log.record("rw" + std::to_string(i), true, "message " + std::to_string(i), json{{"i", i}}, 0.0);
+    }
+    expect(log.size() == 50 && log.at(19999).metadata["i"] == 19999 && log.at(19950).message == "message 19950",
+           "compaction keeps retained events");
+    const json saved = log.eventsJson();
+    expect(saved.size() == 50, "retained events saved");
+}
+
+void testConfigure() {
+    SidEventLog log(options(10));
+    recordMany(log, 25);
+    log.configure(options(4));
+    expect(log.size() == 4 && log.firstId() == 21 && log.at(21).timestamp == 21.0, "shrink keeps the newest");
+    log.configure(options(8));
+    recordMany(log, 6, 25);
+    expect(log.size() == 8 && log.firstId() == 23 && log.at(30).timestamp == 30.0, "grow after shrink");
+
+    SidEventLog restored(options(8));
+    restored.restore(log.eventsJson());
+    expect(restored.firstId() == 23 && restored.nextId() == 31 && restored.eventsJson() == log.eventsJson(),
+           "checkpoint round trip");
+    restored.clear();
+    expect(restored.size() == 0 && restored.firstId() == 31, "clear keeps IDs increasing");
+
+    SidEventLog::Options parsed = options(8);
+    std::string error;
+    expect(SidEventLog::parseOptions(json{{"capacity", 3}, {"applied_only", true}}, parsed, error) &&
+           parsed.capacity == 3 && parsed.applied_only, "options parse");
+    expect(!SidEventLog::parseOptions(json{{"capacity", 0}}, parsed, error) && !error.empty(), "zero capacity rejected");
+    expect(!SidEventLog::parseOptions(json{{"applied_only", 1}}, parsed, error), "non-boolean applied_only rejected");
+}
+
+} // namespace
+
+int main() {
+    testRing();
+    testAppliedOnly();
+    testPoolsBounded();
+    testConfigure();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_sid_event_log: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_sid_event_log: PASS" << std::endl;
+    return 0;
+}
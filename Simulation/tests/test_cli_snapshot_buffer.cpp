@@ -0,0 +1,144 @@
+/**
+ * dase_cli snapshot buffer test
+ *
+ * Frames must be preallocated to the selection, a lease must pin the
+ * latest published frame, and the writer must skip a publication when
+ * every frame but the latest is leased.  With a writer thread publishing
+ * as fast as it can and reader threads leasing concurrently, every leased
+ * frame must be complete (all values from one publication) and readers
+ * must never see the sequence go backwards.
+ *
+ * Build: g++ -std=c++17 -pthread -Idase_cli/src tests/test_cli_snapshot_buffer.cpp dase_cli/src/snapshot_buffer.cpp dase_cli/src/snapshot_stream.cpp dase_cli/src/segment_codec.cpp
+ */
+
+#include "../dase_cli/src/snapshot_buffer.h"
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dase;
+using json = nlohmann::json;
+
+namespace {
+
+bool ok = true;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ok = false;
+    }
+}
+
+// Fill every value of a frame with the publication's step
+void publish(SnapshotBuffer& buffer, uint64_t step) {
+    SnapshotBuffer::Frame* frame = buffer.beginPublish();
+    if (!frame) {
+        return;
+    }
+    for (auto& field : frame->fields) {
+        for (double& value : field) {
+            value = static_cast<double>(step);
+        }
+    }
+    buffer.endPublish(frame, step, 0.01 * static_cast<double>(step));
+}
+
+} // namespace
+
+int main() {
+    const size_t dims[3] = {8, 4, 2};
+    SnapshotSelection selection;
+    std::string error;
+    expect(selection.parse(json{{"fields", {"phi", "psi_real"}}, {"stride", 2}}, dims, error), "selection parsed");
+
+    {
+        SnapshotBuffer buffer(selection, 2, 1);
+        expect(buffer.frameCount() == 2 && buffer.memoryBytes() == 2 * 2 * 8 * sizeof(double),
+               "frames preallocated to the selection");
+        expect(!buffer.lease(), "nothing to lease before the first publication");
+
+        publish(buffer, 1);
+        SnapshotBuffer::Lease first = buffer.lease();
+        expect(first && first->step == 1 && first->sequence == 1 && first->fields.size() == 2 &&
+               first->fields[0].size() == 8, "lease pins the latest frame");
+
+        // The other frame is free: publish step 2, the lease still sees step 1
+        publish(buffer, 2);
+        expect(first->step == 1 && first->fields[1][0] == 1.0, "leased frame unchanged by a publication");
+
+        // Both frames now pinned or latest: the next publication is skipped
+        SnapshotBuffer::Lease second = buffer.lease();
+        publish(buffer, 3);
+        expect(second && second->step == 2 && buffer.published() == 2 && buffer.skipped() == 1,
+               "publication skipped while every other frame is leased");
+
+        first.release();
+        publish(buffer, 4);
+        SnapshotBuffer::Lease third = buffer.lease();
+        expect(third && third->step == 4 && third->sequence == 3 && buffer.published() == 3,
+               "released frame reused");
+        expect(buffer.describe()["skipped"] == 1, "describe reports the counters");
+    }
+
+    {
+        // Concurrent writer and readers
+        SnapshotBuffer buffer(selection, 3, 1);
+        std::atomic<bool> done{false};
+        std::atomic<uint64_t> torn{0};
+        std::atomic<uint64_t> backwards{0};
+        std::atomic<uint64_t> leases{0};
+        std::thread writer([&] {
+            for (uint64_t step = 1; step <= 200000; ++step) {
+                publish(buffer, step);
+            }
+            done = true;
+        });
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                uint64_t last = 0;
+                while (!done.load()) {
+                    SnapshotBuffer::Lease frame = buffer.lease();
+                    if (!frame) {
+                        continue;
+                    }
+                    leases++;
+                    if (frame->sequence < last) {
+                        backwards++;
+                    }
+                    last = frame->sequence;
+                    const double expected = static_cast<double>(frame->step);
+                    for (const auto& field : frame->fields) {
+                        for (double value : field) {
+                            if (value != expected) {
+                                torn++;
+                                break;
+                            }
+                        }
+                    }
+                }
+            });
+        }
+        writer.join();
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        expect(torn == 0, "no torn frames");
+        expect(backwards == 0, "sequence never goes backwards for a reader");
+        expect(buffer.published() + buffer.skipped() == 200000, "every publication published or skipped");
+        SnapshotBuffer::Lease last = buffer.lease();
+        expect(last && last->sequence == buffer.published(), "latest frame is the last publication");
+        std::cout << "concurrent: " << buffer.published() << " published, " << buffer.skipped()
+                  << " skipped, " << leases.load() << " leases" << std::endl;
+    }
+
+    if (!ok) {
+        std::cerr << "test_cli_snapshot_buffer: FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_snapshot_buffer: PASS" << std::endl;
+    return 0;
+}
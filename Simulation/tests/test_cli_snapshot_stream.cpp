@@ -0,0 +1,239 @@
+/**
+ * dase_cli snapshot stream test
+ *
+ * Field selection, region of interest, slices and stride must pick the
+ * right nodes of a row-major lattice (in engine field order, for IGSOA and
+ * SATP field families), bad selections must be rejected, and the snapshot
+ * file must hold the header and fixed-size records it promises, in float64
+ * or float32, or the codec blocks of an encoded file with its key blocks.
+ *
+ * Build: g++ -std=c++17 -Idase_cli/src tests/test_cli_snapshot_stream.cpp dase_cli/src/snapshot_stream.cpp dase_cli/src/segment_codec.cpp
+ */
+
+#include "../dase_cli/src/snapshot_stream.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase;
+using json = nlohmann::json;
+
+int main() {
+    bool ok = true;
+    const size_t dims[3] = {6, 4, 3};
+    std::vector<double> field(6 * 4 * 3);
+    for (size_t i = 0; i < field.size(); i++) {
+        field[i] = static_cast<double>(i);
+    }
+
+    // Defaults: every field, whole lattice, identity copy
+    {
+        SnapshotSelection selection;
+        std::string error;
+        std::vector<double> out;
+        if (!selection.parse(json::object(), dims, error) || !selection.isIdentity() ||
+            selection.fields().size() != 3 || selection.count() != field.size()) {
+            std::cerr << "default selection wrong: " << error << std::endl;
+            ok = false;
+        }
+        selection.select(field, out);
+        if (out != field) {
+            std::cerr << "identity selection changed the field" << std::endl;
+            ok = false;
+        }
+    }
+
+    // Region [1,5) x [1,4) x [1,3) with stride 2: x in {1,3}, y in {1,3}, z in {1}
+    SnapshotSelection selection;
+    {
+        std::string error;
+        const json params = {{"fields", {"phi"}},
+                             {"region", {{"x0", 1}, {"y0", 1}, {"z0", 1}, {"nx", 4}, {"ny", 3}, {"nz", 2}}},
+                             {"stride", 2}};
+        if (!selection.parse(params, dims, error) || selection.isIdentity() ||
+            selection.fields() != std::vector<std::string>{"phi"} || selection.count() != 4) {
+            std::cerr << "region selection wrong: " << error << std::endl;
+            ok = false;
+        }
+        std::vector<double> out;
+        selection.select(field, out);
+        const std::vector<double> want = {
+            static_cast<double>((1 * 4 + 1) * 6 + 1), static_cast<double>((1 * 4 + 1) * 6 + 3),
+            static_cast<double>((1 * 4 + 3) * 6 + 1), static_cast<double>((1 * 4 + 3) * 6 + 3)};
+        if (out != want) {
+            std::cerr << "region / stride picked the wrong nodes" << std::endl;
+            ok = false;
+        }
+    }
+
+    // y = 2 plane of the SATP fields, every 3rd x: fields kept in engine order
+    {
+        SnapshotSelection slice;
+        std::string error;
+        const json params = {{"fields", {"h", "phi"}}, {"slice", {{"axis", "y"}, {"index", 2}}},
+                             {"stride", 3}, {"dtype", "f32"}};
+        if (!slice.parse(params, dims, SnapshotSelection::satpFields(), error) ||
+            slice.fields() != std::vector<std::string>{"phi", "h"} || slice.count() != 2 * 1 * 1 ||
+            !slice.float32() || slice.isDefault() || slice.describe()["dtype"] != "f32") {
+            std::cerr << "slice selection wrong: " << error << std::endl;
+            ok = false;
+        }
+        std::vector<size_t> visited;
+        slice.forEachIndex([&](size_t i) { visited.push_back(i); });
+        if (visited != std::vector<size_t>{(0 * 4 + 2) * 6 + 0, (0 * 4 + 2) * 6 + 3}) {
+            std::cerr << "slice visited the wrong nodes" << std::endl;
+            ok = false;
+        }
+
+        SnapshotSelection plane;
+        if (!plane.parse({{"slice", {{"axis", 2}, {"index", 1}}}}, dims, error) ||
+            plane.count() != 6 * 4 || plane.isIdentity()) {
+            std::cerr << "numeric slice axis wrong: " << error << std::endl;
+            ok = false;
+        }
+        SnapshotSelection all;
+        if (!all.parse(json::object(), dims, SnapshotSelection::satpFields(), error) ||
+            !all.isDefault() || all.fields() != SnapshotSelection::satpFields()) {
+            std::cerr << "default SATP selection wrong: " << error << std::endl;
+            ok = false;
+        }
+    }
+
+    // Rejections
+    {
+        SnapshotSelection bad;
+        std::string error;
+        if (bad.parse({{"fields", {"psi"}}}, dims, error) ||
+            bad.parse({{"fields", {"h"}}}, dims, error) ||
+            bad.parse({{"fields", {"psi_real"}}}, dims, SnapshotSelection::satpFields(), error) ||
+            bad.parse({{"region", {{"x0", 4}, {"nx", 3}}}}, dims, error) ||
+            bad.parse({{"slice", {{"axis", "w"}}}}, dims, error) ||
+            bad.parse({{"slice", {{"axis", "z"}, {"index", 3}}}}, dims, error) ||
+            bad.parse({{"dtype", "f16"}}, dims, error) ||
+            bad.parse({{"stride", 0}}, dims, error)) {
+            std::cerr << "invalid selection was accepted" << std::endl;
+            ok = false;
+        }
+    }
+
+    // Snapshot file: magic, JSON header, then one record per append
+    const std::string path = "test_cli_snapshot_stream.bin";
+    {
+        SnapshotFileWriter writer;
+        std::string error;
+        std::vector<double> out;
+        selection.select(field, out);
+        if (!writer.open(path, selection.describe(), error) ||
+            !writer.append(10, {&out}) || !writer.append(20, {&out}) || !writer.close()) {
+            std::cerr << "snapshot file write failed: " << error << std::endl;
+            ok = false;
+        }
+
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        char magic[8] = {};
+        uint64_t header_bytes = 0;
+        if (!file || std::fread(magic, 1, 8, file) != 8 || std::memcmp(magic, "DASNAP1", 8) != 0 ||
+            std::fread(&header_bytes, sizeof(header_bytes), 1, file) != 1) {
+            std::cerr << "snapshot file preamble wrong" << std::endl;
+            ok = false;
+        } else {
+            std::string text(header_bytes, '\0');
+            const size_t got = std::fread(&text[0], 1, text.size(), file);
+            const json header = json::parse(text.substr(0, got), nullptr, false);
+            if (header.is_discarded() || header.value("count", 0) != 4) {
+                std::cerr << "snapshot file header wrong" << std::endl;
+                ok = false;
+            }
+            for (int64_t expected_step : {10, 20}) {
+                int64_t step = 0;
+                std::vector<double> values(4);
+                if (std::fread(&step, sizeof(step), 1, file) != 1 || step != expected_step ||
+                    std::fread(values.data(), sizeof(double), 4, file) != 4 || values != out) {
+                    std::cerr << "snapshot record " << expected_step << " wrong" << std::endl;
+                    ok = false;
+                }
+            }
+            if (std::fgetc(file) != EOF) {
+                std::cerr << "trailing bytes after the last record" << std::endl;
+                ok = false;
+            }
+        }
+        if (file) std::fclose(file);
+        std::remove(path.c_str());
+    }
+
+    // float32 records: 4 bytes per value, values rounded
+    {
+        SnapshotFileWriter writer;
+        std::string error;
+        const std::vector<double> values = {0.1, -2.5, 1e-3, 7.0};
+        if (!writer.open(path, json::object(), error, true) || !writer.append(5, {&values}) ||
+            !writer.close() || writer.bytesWritten() != 8 + 8 + 2 + 8 + 4 * sizeof(float)) {
+            std::cerr << "float32 snapshot file write failed: " << error << std::endl;
+            ok = false;
+        }
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        std::vector<float> stored(4);
+        if (!file || std::fseek(file, 8 + 8 + 2 + 8, SEEK_SET) != 0 ||
+            std::fread(stored.data(), sizeof(float), 4, file) != 4 ||
+            stored != std::vector<float>{0.1f, -2.5f, 1e-3f, 7.0f}) {
+            std::cerr << "float32 snapshot record wrong" << std::endl;
+            ok = false;
+        }
+        if (file) std::fclose(file);
+        std::remove(path.c_str());
+    }
+
+    // Encoded records: u64 block bytes + codec block per field
+    {
+        protocol::SegmentEncoding encoding;
+        encoding.quantization = protocol::Quantization::F16;
+        encoding.delta = true;
+        encoding.compression = protocol::Compression::Rle;
+        SnapshotFileWriter writer;
+        std::string error;
+        writer.setEncoding(encoding, 2);
+        std::vector<std::vector<double>> records;
+        if (!writer.open(path, {{"encoding", encoding.describe()}}, error)) {
+            ok = false;
+        }
+        for (int step = 0; step < 3; ++step) {
+            std::vector<double> values(field);
+            values[0] += step;
+            protocol::quantize(encoding.quantization, values.data(), values.size());
+            records.push_back(values);
+            ok = writer.append(step, {&records.back()}) && ok;
+        }
+        ok = writer.close() && ok;
+
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        uint64_t header_bytes = 0;
+        char magic[8] = {};
+        bool read = file && std::fread(magic, 1, 8, file) == 8 &&
+                    std::fread(&header_bytes, sizeof(header_bytes), 1, file) == 1 &&
+                    std::fseek(file, static_cast<long>(header_bytes), SEEK_CUR) == 0;
+        protocol::SegmentDecoder decoder;
+        for (int step = 0; read && step < 3; ++step) {
+            int64_t timestep = -1;
+            uint64_t block_bytes = 0;
+            read = std::fread(&timestep, sizeof(timestep), 1, file) == 1 && timestep == step &&
+                   std::fread(&block_bytes, sizeof(block_bytes), 1, file) == 1;
+            std::vector<uint8_t> block(read ? block_bytes : 0);
+            std::vector<double> decoded;
+            read = read && std::fread(block.data(), 1, block.size(), file) == block.size() &&
+                   decoder.decode(block.data(), block.size(), decoded, error) && decoded == records[step] &&
+                   ((block[1] & 1) != 0) == (step == 1);   // Key blocks at records 0 and 2
+        }
+        if (!read || std::fgetc(file) != EOF) {
+            std::cerr << "encoded snapshot records wrong: " << error << std::endl;
+            ok = false;
+        }
+        if (file) std::fclose(file);
+        std::remove(path.c_str());
+    }
+
+    std::cout << (ok ? "CLI snapshot stream test passed" : "CLI snapshot stream test FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/**
+ * dase_cli sweep scheduler test
+ *
+ * SweepScheduler must run every task exactly once, never hold more budget
+ * tokens than its capacity, let idle workers steal the tasks dealt to a
+ * busy one, run each task with its budget as OMP team, size budgets from
+ * the work per thread, and rethrow a task's exception after the run.
+ *
+ * Build: g++ -std=c++17 -fopenmp -Idase_cli/src tests/test_cli_sweep_scheduler.cpp dase_cli/src/sweep_scheduler.cpp
+ */
+
+#include "../dase_cli/src/sweep_scheduler.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+void testBudgets() {
+    SweepScheduler scheduler(8);
+    expect(scheduler.capacity() == 8, "explicit capacity");
+    expect(scheduler.threadBudget(1000, 32768) == 1, "small run gets one thread");
+    expect(scheduler.threadBudget(65537, 32768) == 3, "budget rounds up");
+    expect(scheduler.threadBudget(1 << 20, 32768) == 8, "budget clamped to capacity");
+    expect(SweepScheduler(0).capacity() >= 1, "default capacity");
+}
+
+void testRun() {
+    SweepScheduler scheduler(4);
+    std::vector<std::atomic<int>> runs(24);
+    std::atomic<int> in_use{0};
+    std::atomic<int> peak{0};
+    std::atomic<bool> team_ok{true};
+    std::vector<SweepTask> tasks;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        SweepTask task;
+        task.threads = (i == 0) ? 4 : 1 + static_cast<int>(i % 2);
+        task.cost = (i == 0) ? 100.0 : 1.0;
+        task.body = [&, i, threads = task.threads] {
+            const int now = in_use.fetch_add(threads) + threads;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+#ifdef _OPENMP
+            if (omp_get_max_threads() != threads) team_ok = false;
+#endif
+            // The costly task blocks its worker; the rest must be stolen
+            std::this_thread::sleep_for(std::chrono::milliseconds(i == 0 ? 40 : 2));
+            runs[i].fetch_add(1);
+            in_use.fetch_sub(threads);
+        };
+        tasks.push_back(std::move(task));
+    }
+    scheduler.run(std::move(tasks));
+
+    bool once = true;
+    for (const auto& count : runs) once = once && count.load() == 1;
+    expect(once, "every task ran exactly once");
+    expect(peak.load() <= 4 && scheduler.lastStats().peak_threads <= 4, "budget tokens never oversubscribed");
+    expect(scheduler.lastStats().workers == 4, "one worker per narrowest budget");
+    expect(scheduler.lastStats().steals > 0, "idle workers steal");
+    expect(team_ok.load(), "tasks run with their budget as OMP team");
+
+    std::vector<SweepTask> capped(6);
+    std::atomic<int> concurrent{0};
+    std::atomic<int> max_concurrent{0};
+    for (auto& task : capped) {
+        task.body = [&] {
+            const int now = ++concurrent;
+            int seen = max_concurrent.load();
+            while (now > seen && !max_concurrent.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            --concurrent;
+        };
+    }
+    scheduler.run(std::move(capped), 2);
+    expect(max_concurrent.load() <= 2 && scheduler.lastStats().workers == 2, "max_workers caps concurrency");
+}
+
+void testException() {
+    SweepScheduler scheduler(2);
+    std::atomic<int> ran{0};
+    std::vector<SweepTask> tasks(5);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i].body = [&ran, i] {
+            ran++;
+            if (i == 2) throw std::runtime_error("run 2 failed");
+        };
+    }
+    bool thrown = false;
+    try {
+        scheduler.run(std::move(tasks));
+    } catch (const std::runtime_error& e) {
+        thrown = std::string(e.what()) == "run 2 failed";
+    }
+    expect(thrown, "task exception rethrown");
+    expect(ran.load() == 5, "other tasks still ran");
+}
+
+} // namespace
+
+int main() {
+    testBudgets();
+    testRun();
+    testException();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_sweep_scheduler: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_sweep_scheduler: PASS" << std::endl;
+    return 0;
+}
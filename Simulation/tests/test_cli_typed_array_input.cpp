@@ -0,0 +1,181 @@
+/**
+ * dase_cli typed array input test
+ *
+ * Every source of the "arrays" state profile must resolve to the values it
+ * holds: inline arrays, base64 f64 / f32 payloads, request segments, NPY
+ * files (v1 and v2 headers, f8 and f4, multi-dimensional C order), raw
+ * files with an offset, and map_state shared-memory exports looked up by
+ * field.  Malformed base64, big-endian or Fortran-order NPY data and
+ * dangling segment references must be rejected.
+ *
+ * Build: g++ -std=c++17 -O2 -Idase_cli/src tests/test_cli_typed_array_input.cpp dase_cli/src/typed_array_input.cpp dase_cli/src/state_export.cpp
+ *        (add -lrt on older glibc)
+ */
+
+#include "../dase_cli/src/typed_array_input.h"
+#include "../dase_cli/src/state_export.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using dase::ArrayDtype;
+using dase::TypedArray;
+using json = nlohmann::json;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::string encodeBase64(const void* data, size_t bytes) {
+    static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const auto* in = static_cast<const uint8_t*>(data);
+    std::string out;
+    for (size_t i = 0; i < bytes; i += 3) {
+        const uint32_t group = (uint32_t(in[i]) << 16) | (i + 1 < bytes ? uint32_t(in[i + 1]) << 8 : 0) |
+                               (i + 2 < bytes ? uint32_t(in[i + 2]) : 0);
+        out += alphabet[(group >> 18) & 63];
+        out += alphabet[(group >> 12) & 63];
+        out += i + 1 < bytes ? alphabet[(group >> 6) & 63] : '=';
+        out += i + 2 < bytes ? alphabet[group & 63] : '=';
+    }
+    return out;
+}
+
+// NPY file of `values` with the given descr / shape text, as numpy writes it
+template <typename T>
+void writeNpy(const std::string& path, const std::vector<T>& values, const std::string& descr,
+              const std::string& shape, int major = 1, const std::string& fortran = "False") {
+    std::string header = "{'descr': '" + descr + "', 'fortran_order': " + fortran + ", 'shape': " + shape + ", }";
+    const size_t prefix = major == 1 ? 10 : 12;
+    while ((prefix + header.size() + 1) % 64 != 0) header += ' ';
+    header += '\n';
+    std::ofstream out(path, std::ios::binary);
+    out.write("\x93NUMPY", 6);
+    out.put(static_cast<char>(major));
+    out.put(0);
+    const uint32_t length = static_cast<uint32_t>(header.size());
+    out.write(reinterpret_cast<const char*>(&length), major == 1 ? 2 : 4);
+    out << header;
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+bool holds(const TypedArray& array, const std::vector<double>& expected) {
+    if (array.size() != expected.size()) {
+        return false;
+    }
+    bool same = true;
+    array.forEach([&](size_t i, double v) { same = same && v == expected[i]; });
+    return same;
+}
+
+std::vector<double> ramp(size_t n) {
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; ++i) values[i] = 0.25 * static_cast<double>(i) - 3.0;
+    return values;
+}
+
+void testInline() {
+    TypedArray array;
+    std::string error;
+    expect(TypedArray::resolve(json::array({1.0, 2.5, -3}), nullptr, array, error) &&
+           holds(array, {1.0, 2.5, -3.0}) && array.origin() == "inline", "inline array");
+    expect(!TypedArray::resolve(json::array({1.0, "x"}), nullptr, array, error), "non-numeric inline rejected");
+
+    const std::vector<double> f64 = ramp(37);
+    expect(TypedArray::resolve({{"base64", encodeBase64(f64.data(), f64.size() * 8)}}, nullptr, array, error) &&
+           holds(array, f64) && array.dtype() == ArrayDtype::F64, "base64 f64 " + error);
+    const std::vector<float> f32 = {0.5f, -1.25f, 3.0f};
+    expect(TypedArray::resolve({{"base64", encodeBase64(f32.data(), 12)}, {"dtype", "f32"}}, nullptr, array, error) &&
+           holds(array, {0.5, -1.25, 3.0}) && array[1] == -1.25, "base64 f32 " + error);
+    expect(!TypedArray::resolve({{"base64", "AAAA*AAA"}}, nullptr, array, error), "bad base64 character rejected");
+    expect(!TypedArray::resolve({{"base64", encodeBase64(f32.data(), 12)}}, nullptr, array, error),
+           "base64 of a partial f64 rejected");
+
+    const std::vector<std::vector<double>> segments = {{9.0}, ramp(5)};
+    expect(TypedArray::resolve({{"$segment", 1}, {"count", 5}}, &segments, array, error) &&
+           holds(array, ramp(5)) && array.origin() == "segment", "request segment");
+    expect(!TypedArray::resolve({{"$segment", 2}}, &segments, array, error) &&
+           !TypedArray::resolve({{"$segment", 0}}, nullptr, array, error), "dangling segment rejected");
+}
+
+void testFiles() {
+    const std::string npy = "/tmp/dase_typed_array_test.npy";
+    const std::vector<double> values = ramp(4 * 8);
+    writeNpy(npy, values, "<f8", "(4, 8)");
+    TypedArray array;
+    std::string error;
+    expect(TypedArray::resolve({{"file", npy}}, nullptr, array, error) && holds(array, values) &&
+           array.origin() == "npy", "NPY v1 f8 (4, 8) " + error);
+
+    std::vector<float> narrow(values.begin(), values.end());
+    writeNpy(npy, narrow, "<f4", "(32,)", 2);
+    expect(TypedArray::resolve({{"file", npy}}, nullptr, array, error) && holds(array, values) &&
+           array.dtype() == ArrayDtype::F32, "NPY v2 f4 " + error);
+
+    writeNpy(npy, values, ">f8", "(32,)");
+    expect(!TypedArray::resolve({{"file", npy}}, nullptr, array, error), "big-endian NPY rejected");
+    writeNpy(npy, values, "<f8", "(4, 8)", 1, "True");
+    expect(!TypedArray::resolve({{"file", npy}}, nullptr, array, error), "Fortran-order NPY rejected");
+    writeNpy(npy, values, "<f8", "(4, 16)");
+    expect(!TypedArray::resolve({{"file", npy}}, nullptr, array, error), "NPY shorter than its shape rejected");
+    std::remove(npy.c_str());
+
+    const std::string raw = "/tmp/dase_typed_array_test.bin";
+    {
+        std::ofstream out(raw, std::ios::binary);
+        const double pad = 99.0;
+        out.write(reinterpret_cast<const char*>(&pad), sizeof(pad));
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * 8));
+    }
+    expect(TypedArray::resolve({{"file", raw}, {"offset", 8}}, nullptr, array, error) && holds(array, values) &&
+           array.origin() == "file", "raw file with offset " + error);
+    expect(TypedArray::resolve({{"file", raw}, {"offset", 8}, {"count", 4}}, nullptr, array, error) &&
+           holds(array, ramp(4)), "raw file count");
+    std::remove(raw.c_str());
+    expect(!TypedArray::resolve({{"file", raw}}, nullptr, array, error), "missing file rejected");
+}
+
+void testSharedMemory() {
+    const uint32_t dims[3] = {6, 1, 1};
+    std::string error;
+    auto exported = dase::SharedStateExport::create("dase_typed_array_test", {"psi_real", "phi"}, 6, dims, error);
+    expect(exported != nullptr, "create export " + error);
+    if (!exported) {
+        return;
+    }
+    const std::vector<double> phi = ramp(6);
+    std::memcpy(exported->field(1), phi.data(), phi.size() * sizeof(double));
+
+    TypedArray array;
+    expect(TypedArray::resolve({{"shm", "dase_typed_array_test"}, {"field", "phi"}}, nullptr, array, error) &&
+           holds(array, phi) && array.origin() == "shm", "map_state field " + error);
+    expect(!TypedArray::resolve({{"shm", "dase_typed_array_test"}, {"field", "h"}}, nullptr, array, error),
+           "unknown export field rejected");
+    expect(!TypedArray::resolve({{"shm", "dase_typed_array_missing"}}, nullptr, array, error),
+           "missing segment rejected");
+}
+
+} // namespace
+
+int main() {
+    testInline();
+    testFiles();
+    testSharedMemory();
+
+    if (failures != 0) {
+        std::cerr << "test_cli_typed_array_input: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_cli_typed_array_input: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,212 @@
+/**
+ * DASE oscillator bank test
+ *
+ * OscillatorBank must render a_i sin(phi_i + n w_i) to float precision
+ * for every oscillator (a bank size that is not a multiple of the SIMD
+ * width, blocks shorter and longer than the anchor interval), continue
+ * the same waveforms across calls without drift, and give a sum equal to
+ * the sum of its channels.  Also prints the per-sample cost against one
+ * oscillate_inplace-style loop per tone.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -Isrc/cpp -I. tests/test_dase_oscillator_bank.cpp src/cpp/dase_oscillator_bank.cpp
+ */
+
+#include "../src/cpp/dase_oscillator_bank.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using dase::OscillatorBank;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+struct Tones {
+    std::vector<double> frequencies;
+    std::vector<double> phases;
+    std::vector<double> amplitudes;
+};
+
+Tones randomTones(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> frequency(20.0, 20000.0);
+    std::uniform_real_distribution<double> phase(-10.0, 10.0);
+    std::uniform_real_distribution<double> amplitude(0.0, 1.0);
+    Tones tones;
+    for (size_t i = 0; i < count; ++i) {
+        tones.frequencies.push_back(frequency(rng));
+        tones.phases.push_back(phase(rng));
+        tones.amplitudes.push_back(amplitude(rng));
+    }
+    return tones;
+}
+
+// Reference sample n (from the start of the stream) of tone i, in long double
+double reference(const Tones& tones, size_t i, uint64_t n, double sample_rate) {
+    const long double w = 2.0L * static_cast<long double>(M_PI) * tones.frequencies[i] / sample_rate;
+    return static_cast<double>(tones.amplitudes[i] *
+                               std::sin(static_cast<long double>(tones.phases[i]) + w * n));
+}
+
+void testChannelsAcrossCalls() {
+    const double sample_rate = 48000.0;
+    const Tones tones = randomTones(13, 5);
+    OscillatorBank bank(tones.frequencies, sample_rate, tones.phases, tones.amplitudes);
+
+    const size_t blocks[] = {1, 255, 256, 257, 1000, 7};
+    uint64_t position = 0;
+    double error = 0.0;
+    for (int round = 0; round < 40; ++round) {
+        for (size_t length : blocks) {
+            std::vector<float> out(bank.size() * length);
+            bank.renderChannels(out.data(), length);
+            for (size_t i = 0; i < bank.size(); ++i) {
+                for (size_t n = 0; n < length; ++n) {
+                    const double expected = reference(tones, i, position + n, sample_rate);
+                    error = std::max(error, std::fabs(out[i * length + n] - expected));
+                }
+            }
+            position += length;
+        }
+    }
+    expect(bank.samplesRendered() == position, "samples counted");
+    expect(error < 1e-6, "channels follow a sin(phi + n w) across calls (error " + std::to_string(error) + ")");
+}
+
+void testSumMatchesChannels() {
+    const double sample_rate = 44100.0;
+    const Tones tones = randomTones(301, 9);
+    OscillatorBank channels(tones.frequencies, sample_rate, tones.phases, tones.amplitudes);
+    OscillatorBank summed(tones.frequencies, sample_rate, tones.phases, tones.amplitudes);
+
+    double error = 0.0;
+    for (size_t length : {size_t(3000), size_t(513), size_t(64)}) {
+        std::vector<float> rows(channels.size() * length);
+        channels.renderChannels(rows.data(), length);
+        std::vector<float> sum(length, 1.0f);
+        summed.renderSum(sum.data(), length, true);   // Added to the existing 1.0
+        for (size_t n = 0; n < length; ++n) {
+            double expected = 1.0;
+            for (size_t i = 0; i < channels.size(); ++i) expected += rows[i * length + n];
+            error = std::max(error, std::fabs(sum[n] - expected));
+        }
+    }
+    expect(error < 1e-3, "sum equals the sum of the channels (error " + std::to_string(error) + ")");
+    for (size_t i = 0; i < summed.size(); ++i) {
+        if (std::fabs(summed.phase(i) - channels.phase(i)) > 1e-12) {
+            expect(false, "sum and channel renders carry the same phases");
+            break;
+        }
+    }
+}
+
+void testNoDrift() {
+    // 10^7 samples in 2048-sample blocks: phase stays on the exact grid
+    const double sample_rate = 48000.0;
+    const Tones tones = {{440.0, 1234.5}, {0.0, 1.0}, {1.0, 0.5}};
+    OscillatorBank bank(tones.frequencies, sample_rate, tones.phases, tones.amplitudes);
+    std::vector<float> out(2 * 2048);
+    uint64_t position = 0;
+    for (int block = 0; block < 4883; ++block) {
+        bank.renderChannels(out.data(), 2048);
+        position += 2048;
+    }
+    bank.renderChannels(out.data(), 2048);
+    double error = 0.0;
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t n = 0; n < 2048; ++n) {
+            error = std::max(error, std::fabs(out[i * 2048 + n] - reference(tones, i, position + n, sample_rate)));
+        }
+    }
+    expect(error < 1e-5, "no phase drift over 10^7 samples (error " + std::to_string(error) + ")");
+}
+
+void testEditsAndErrors() {
+    OscillatorBank bank({1000.0, 2000.0}, 8000.0);
+    bank.setAmplitude(1, 0.0);
+    bank.setFrequency(0, 2000.0);   // A quarter turn per sample
+    bank.setPhase(0, 0.0);
+    std::vector<float> out(4);
+    bank.renderSum(out.data(), 4);
+    expect(std::fabs(out[0]) < 1e-7 && std::fabs(out[1] - 1.0f) < 1e-7 &&
+           std::fabs(out[2]) < 1e-7 && std::fabs(out[3] + 1.0f) < 1e-7, "edits apply from the next sample");
+    expect(std::fabs(bank.phase(0)) < 1e-12 || std::fabs(bank.phase(0) - 2.0 * M_PI) < 1e-12,
+           "phase wraps after a whole turn");
+
+    bool threw = false;
+    try {
+        OscillatorBank bad({1.0}, 0.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "non-positive sample rate rejected");
+    threw = false;
+    try {
+        OscillatorBank bad({1.0, 2.0}, 100.0, {0.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "mismatched phases rejected");
+    threw = false;
+    try {
+        bank.setFrequency(2, 1.0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    expect(threw, "out-of-range oscillator rejected");
+}
+
+void timeBank(size_t tones, size_t samples) {
+    const Tones bank_tones = randomTones(tones, 3);
+    OscillatorBank bank(bank_tones.frequencies, 48000.0, bank_tones.phases, bank_tones.amplitudes);
+    std::vector<float> sum(samples);
+    auto start = std::chrono::steady_clock::now();
+    bank.renderSum(sum.data(), samples);
+    const double bank_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    // One tone per loop, as separate oscillate calls would
+    std::vector<float> tone(samples);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < tones; ++i) {
+        const float w = static_cast<float>(2.0 * M_PI * bank_tones.frequencies[i] / 48000.0);
+        for (size_t n = 0; n < samples; ++n) tone[n] = std::sin(n * w);
+        for (size_t n = 0; n < samples; ++n) sum[n] += tone[n];
+    }
+    const double loop_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << tones << " tones x " << samples << " samples: bank "
+              << bank_ns / (tones * samples) << " ns/tone-sample, per-tone loop "
+              << loop_ns / (tones * samples) << " ns/tone-sample" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    testChannelsAcrossCalls();
+    testSumMatchesChannels();
+    testNoDrift();
+    testEditsAndErrors();
+    timeBank(4000, 4096);
+
+    if (failures != 0) {
+        std::cerr << "test_dase_oscillator_bank: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_dase_oscillator_bank: PASS" << std::endl;
+    return 0;
+}
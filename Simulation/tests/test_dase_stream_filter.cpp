@@ -0,0 +1,161 @@
+/**
+ * DASE streaming FIR filter test
+ *
+ * StreamFilter must produce the direct linear convolution of the whole
+ * stream however it is split into calls (chunks shorter and longer than
+ * the hop, tails longer than a chunk), for every channel of a batch that
+ * spans several channel groups, in place, and again from scratch after
+ * reset().  A filter designed from a low-pass response must pass DC at
+ * unit gain and stop a tone near Nyquist.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -Isrc/cpp -I. tests/test_dase_stream_filter.cpp src/cpp/dase_stream_filter.cpp -lfftw3
+ */
+
+#include "../src/cpp/dase_stream_filter.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using dase::StreamFilter;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::vector<double> convolve(const std::vector<float>& x, const std::vector<double>& h) {
+    std::vector<double> y(x.size(), 0.0);
+    for (size_t n = 0; n < x.size(); ++n) {
+        for (size_t m = 0; m < h.size() && m <= n; ++m) {
+            y[n] += h[m] * x[n - m];
+        }
+    }
+    return y;
+}
+
+double maxError(const std::vector<float>& out, const std::vector<double>& expected) {
+    double error = 0.0;
+    for (size_t i = 0; i < out.size(); ++i) {
+        error = std::max(error, std::fabs(out[i] - expected[i]));
+    }
+    return error;
+}
+
+void testStreamingMatchesConvolution() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    std::vector<double> taps(37);
+    for (double& tap : taps) tap = unit(rng) / 8.0;
+
+    const int channels = 11;            // Two channel groups, the second partial
+    const size_t total = 1500;
+    StreamFilter filter(taps, 50, channels);
+    expect(filter.fftSize() == 128 && filter.blockSize() == 50, "FFT size covers hop + taps - 1");
+
+    std::vector<std::vector<float>> streams(channels, std::vector<float>(total));
+    for (auto& stream : streams) {
+        for (float& sample : stream) sample = static_cast<float>(unit(rng));
+    }
+
+    // Ragged chunks: shorter than the tail, shorter and longer than the hop
+    const size_t chunks[] = {1, 7, 50, 3, 130, 64, 245};
+    std::vector<std::vector<float>> filtered(channels);
+    size_t position = 0;
+    for (size_t c = 0; position < total; ++c) {
+        const size_t length = std::min(chunks[c % 7], total - position);
+        std::vector<float> block(static_cast<size_t>(channels) * length);
+        for (int ch = 0; ch < channels; ++ch) {
+            std::copy(streams[ch].begin() + position, streams[ch].begin() + position + length,
+                      block.begin() + static_cast<size_t>(ch) * length);
+        }
+        filter.process(block.data(), block.data(), length);   // In place
+        for (int ch = 0; ch < channels; ++ch) {
+            filtered[ch].insert(filtered[ch].end(), block.begin() + static_cast<size_t>(ch) * length,
+                                block.begin() + static_cast<size_t>(ch + 1) * length);
+        }
+        position += length;
+    }
+    expect(filter.samplesProcessed() == total, "samples counted");
+
+    double error = 0.0;
+    for (int ch = 0; ch < channels; ++ch) {
+        error = std::max(error, maxError(filtered[ch], convolve(streams[ch], taps)));
+    }
+    expect(error < 1e-5, "stream equals the direct convolution (error " + std::to_string(error) + ")");
+
+    // After reset the history is gone: one call equals a fresh convolution
+    filter.reset();
+    std::vector<float> once(static_cast<size_t>(channels) * 200);
+    for (int ch = 0; ch < channels; ++ch) {
+        std::copy(streams[ch].begin(), streams[ch].begin() + 200, once.begin() + static_cast<size_t>(ch) * 200);
+    }
+    std::vector<float> out(once.size());
+    filter.process(once.data(), out.data(), 200);
+    const std::vector<float> first(out.begin(), out.begin() + 200);
+    const std::vector<float> head(streams[0].begin(), streams[0].begin() + 200);
+    expect(maxError(first, convolve(head, taps)) < 1e-5, "reset clears the stream history");
+}
+
+void testDesignedLowPass() {
+    // Pass below a quarter of the sample rate, stop above
+    std::vector<double> gains(65);
+    for (size_t i = 0; i < gains.size(); ++i) gains[i] = i < 32 ? 1.0 : 0.0;
+    const std::vector<double> taps = StreamFilter::designFromResponse(gains, 101);
+    double dc = 0.0;
+    for (double tap : taps) dc += tap;
+    expect(std::fabs(dc - 1.0) < 1e-12, "designed filter passes DC at unit gain");
+    expect(std::fabs(taps[0] - taps[100]) < 1e-15 && std::fabs(taps[10] - taps[90]) < 1e-15,
+           "designed filter is linear phase (symmetric)");
+
+    StreamFilter filter(taps);
+    const size_t total = 4096;
+    std::vector<float> tone(total);
+    for (size_t n = 0; n < total; ++n) tone[n] = static_cast<float>(std::cos(0.9 * M_PI * n));
+    std::vector<float> out(total);
+    filter.process(tone.data(), out.data(), total);
+    double peak = 0.0;
+    for (size_t n = 200; n < total; ++n) peak = std::max(peak, std::fabs(static_cast<double>(out[n])));
+    expect(peak < 0.05, "designed filter stops a tone near Nyquist (peak " + std::to_string(peak) + ")");
+
+    bool threw = false;
+    try {
+        StreamFilter::designFromResponse(gains, 100);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "even tap counts rejected");
+    threw = false;
+    try {
+        StreamFilter empty(std::vector<double>{}, 0, 1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "empty taps rejected");
+}
+
+} // namespace
+
+int main() {
+    testStreamingMatchesConvolution();
+    testDesignedLowPass();
+
+    if (failures != 0) {
+        std::cerr << "test_dase_stream_filter: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_dase_stream_filter: PASS" << std::endl;
+    return 0;
+}
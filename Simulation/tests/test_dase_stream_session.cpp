@@ -0,0 +1,221 @@
+/**
+ * DASE real-time streaming session test
+ *
+ * SpscRing must hand every element over in order across wraps, alone and
+ * with a producer and a consumer thread.  A StreamSession fed in uneven
+ * chunks must produce exactly what runStreamBlock gives on a twin engine
+ * for the whole signal, one block at a time; input refused on a full ring
+ * must count as overruns; and the engine's metrics must report one latency
+ * per block.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -pthread -Isrc/cpp -I. tests/test_dase_stream_session.cpp src/cpp/dase_stream_session.cpp src/cpp/analog_universal_node_engine_avx2.cpp -lfftw3
+ */
+
+#include "../src/cpp/dase_stream_session.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using dase::SpscRing;
+using dase::StreamSession;
+using dase::StreamSessionOptions;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+void testRingWraps() {
+    SpscRing<int> ring(5);
+    const int first[3] = {1, 2, 3};
+    const int second[4] = {4, 5, 6, 7};
+    int out[8] = {};
+
+    expect(ring.write(first, 3) == 3, "ring takes 3 of 5");
+    expect(ring.read(out, 2) == 2 && out[0] == 1 && out[1] == 2, "ring reads the first 2");
+    expect(ring.write(second, 4) == 4, "ring takes 4 across the wrap");
+    expect(ring.writeAvailable() == 0 && ring.write(first, 1) == 0, "full ring refuses");
+    expect(ring.read(out, 8) == 5, "ring reads all 5 across the wrap");
+    for (int i = 0; i < 5; ++i) {
+        expect(out[i] == i + 3, "ring order across the wrap");
+    }
+    expect(ring.readAvailable() == 0 && ring.written() == 7, "ring drained");
+
+    // Producer and consumer threads, odd capacity and chunk sizes
+    constexpr uint64_t kCount = 1 << 20;
+    SpscRing<uint64_t> shared(97);
+    bool in_order = true;
+    std::thread consumer([&] {
+        uint64_t chunk[13];
+        uint64_t expected = 0;
+        while (expected < kCount) {
+            const size_t n = shared.read(chunk, 13);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < n; ++i) {
+                in_order = in_order && chunk[i] == expected++;
+            }
+        }
+    });
+    uint64_t chunk[29];
+    for (uint64_t next = 0; next < kCount;) {
+        size_t n = 0;
+        while (n < 29 && next + n < kCount) {
+            chunk[n] = next + n;
+            ++n;
+        }
+        const size_t written = shared.write(chunk, n);
+        if (written == 0) {
+            std::this_thread::yield();
+        }
+        next += written;
+    }
+    consumer.join();
+    expect(in_order, "threaded ring delivers every element in order");
+}
+
+// Pop until `count` outputs have arrived (or a generous timeout)
+size_t popAll(StreamSession& session, double* outputs, size_t count) {
+    size_t received = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (received < count && std::chrono::steady_clock::now() < deadline) {
+        const size_t n = session.pop(outputs + received, count - received);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        received += n;
+    }
+    return received;
+}
+
+void testSessionMatchesDirectBlocks() {
+    const size_t nodes = 301;           // Not a multiple of the SIMD width
+    const size_t block = 16;
+    const size_t total = 10 * block;
+    const uint32_t iterations = 5;
+
+    std::vector<double> input(total);
+    std::vector<double> control(total);
+    for (size_t i = 0; i < total; ++i) {
+        input[i] = std::sin(0.05 * static_cast<double>(i));
+        control[i] = 0.5 * std::cos(0.11 * static_cast<double>(i));
+    }
+
+    AnalogCellularEngineAVX2 twin(nodes);
+    std::vector<double> expected(total);
+    twin.runStreamBlock(input.data(), control.data(), total, iterations, expected.data());
+
+    AnalogCellularEngineAVX2 engine(nodes);
+    StreamSessionOptions options;
+    options.block_size = block;
+    options.ring_blocks = 16;
+    options.iterations_per_node = iterations;
+    options.cpu = 0;
+    StreamSession session(engine, options);
+
+    // Uneven chunks straddling block boundaries; the ring holds the whole
+    // signal, so nothing is refused
+    std::vector<double> outputs(total);
+    size_t pushed = 0;
+    size_t received = 0;
+    const size_t chunks[] = {5, 23, 1, 40, 7};
+    for (size_t c = 0; pushed < total; ++c) {
+        const size_t n = std::min(chunks[c % 5], total - pushed);
+        expect(session.push(input.data() + pushed, control.data() + pushed, n) == n, "chunk taken");
+        pushed += n;
+        received += session.pop(outputs.data() + received, total - received);
+    }
+    received += popAll(session, outputs.data() + received, total - received);
+    expect(received == total, "session returns one output per sample");
+
+    bool identical = true;
+    for (size_t i = 0; i < total; ++i) {
+        identical = identical && outputs[i] == expected[i];
+    }
+    expect(identical, "session outputs match runStreamBlock over the whole signal");
+
+    session.stop();
+    expect(!session.running(), "stopped session is not running");
+    const EngineMetrics metrics = engine.getMetrics();
+    expect(metrics.stream_blocks == total / block, "one latency per block");
+    uint64_t bucketed = 0;
+    for (int k = 0; k < EngineMetrics::kStreamLatencyBuckets; ++k) {
+        bucketed += metrics.stream_latency_histogram[k];
+    }
+    expect(bucketed == metrics.stream_blocks, "histogram holds every block");
+    expect(metrics.stream_latency_max_ns > 0 &&
+           metrics.stream_latency_mean_ns <= static_cast<double>(metrics.stream_latency_max_ns),
+           "latency max >= mean > 0");
+    expect(metrics.stream_overruns == 0, "paced producer does not overrun");
+}
+
+void testOverrunsAndOptions() {
+    AnalogCellularEngineAVX2 engine(64);
+    StreamSessionOptions options;
+    options.block_size = 8;
+    options.ring_blocks = 2;
+    options.iterations_per_node = 1;
+    options.lock_memory = false;
+    StreamSession session(engine, options);
+
+    // The input ring (16 samples) is empty, so exactly 16 are taken
+    std::vector<double> signal(1000, 0.25);
+    const size_t taken = session.push(signal.data(), signal.data(), signal.size());
+    expect(taken == 16, "push takes what fits in the input ring");
+    expect(engine.getMetrics().stream_overruns == signal.size() - taken, "refused samples are overruns");
+
+    std::vector<double> outputs(taken);
+    expect(popAll(session, outputs.data(), taken) == taken, "accepted samples are processed");
+    session.stop();
+    expect(engine.getMetrics().stream_blocks == 2, "two blocks processed");
+
+    engine.resetMetrics();
+    expect(engine.getMetrics().stream_overruns == 0 && engine.getMetrics().stream_blocks == 0,
+           "resetMetrics clears the stream counters");
+
+    const auto rejects = [&](StreamSessionOptions bad) {
+        try {
+            StreamSession rejected(engine, bad);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    StreamSessionOptions bad = options;
+    bad.block_size = 0;
+    expect(rejects(bad), "block_size 0 rejected");
+    bad = options;
+    bad.ring_blocks = 1;
+    expect(rejects(bad), "single-block ring rejected");
+    bad = options;
+    bad.cpu = -2;
+    expect(rejects(bad), "cpu < -1 rejected");
+}
+
+} // namespace
+
+int main() {
+    testRingWraps();
+    testSessionMatchesDirectBlocks();
+    testOverrunsAndOptions();
+
+    if (failures != 0) {
+        std::cerr << "test_dase_stream_session: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_dase_stream_session: PASS" << std::endl;
+    return 0;
+}
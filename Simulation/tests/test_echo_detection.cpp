@@ -6,6 +6,7 @@
  * - Prime gap calculation
  * - Echo schedule generation
  * - Echo signal timing
+ * - Indexed active-echo lookup and field-level echo source
  */
 
 #define _USE_MATH_DEFINES
@@ -15,6 +16,7 @@
 #include <fstream>
 #include <cassert>
 #include <iomanip>
+#include <algorithm>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -280,6 +282,91 @@ bool test_echo_export() {
     return true;
 }
 
+// ============================================================================
+// Test 8: Indexed Lookup and Field-Level Echo Source
+// ============================================================================
+
+bool test_echo_source_field() {
+    std::cout << "\n=== Test 8: Indexed Lookup and Echo Source Field ===" << std::endl;
+
+    EchoConfig config;
+    config.fundamental_timescale = 0.001;
+    config.max_primes = 150;
+    config.max_prime_value = 2000;
+    config.echo_gaussian_width = 3.0;
+    config.auto_detect_merger = false;
+
+    EchoGenerator generator(config);
+    generator.setMergerTime(0.5);
+    const auto& schedule = generator.getEchoSchedule();
+
+    // Indexed queries against a linear scan of the schedule
+    for (int n = 0; n < 4000; n++) {
+        double t = 0.49 + n * 0.00025;
+        for (double sigma : {0.5, 3.0, 7.5}) {
+            std::vector<int> expected;
+            for (const auto& echo : schedule) {
+                if (std::abs(t - echo.time) < config.fundamental_timescale * sigma) {
+                    expected.push_back(echo.echo_number);
+                }
+            }
+            auto active = generator.getActiveEchoes(t, sigma);
+            TEST_ASSERT(active.size() == expected.size(), "Active echo count mismatch");
+            for (size_t m = 0; m < active.size(); m++) {
+                TEST_ASSERT(active[m].echo_number == expected[m], "Active echo mismatch");
+            }
+        }
+
+        EchoEvent expected_next;
+        for (const auto& echo : schedule) {
+            if (echo.time > t) {
+                expected_next = echo;
+                break;
+            }
+        }
+        TEST_ASSERT(generator.getNextEcho(t).echo_number == expected_next.echo_number,
+                    "Next echo mismatch");
+    }
+
+    // Field-level source against the per-point source, with one backward jump
+    SymmetryFieldConfig field_config;
+    field_config.nx = 6;
+    field_config.ny = 5;
+    field_config.nz = 4;
+    field_config.dx = 1.0;
+    field_config.dy = 1.0;
+    field_config.dz = 1.0;
+    SymmetryField field(field_config);
+    Vector3D center(2.5, 2.0, 1.5);
+
+    std::vector<std::complex<double>> sources;
+    double max_source = 0.0;
+    const double times[] = {0.4, 0.502, 0.5035, 0.504, 0.51, 0.503, 0.52, 0.6, 5.0};
+    for (double t : times) {
+        generator.computeEchoSourceField(t, field, center, sources);
+        TEST_ASSERT(static_cast<int>(sources.size()) == field.getTotalPoints(),
+                    "Echo source field size mismatch");
+        std::vector<std::complex<double>> expected(sources.size());
+        double max_at_t = 0.0;
+        for (int idx = 0; idx < field.getTotalPoints(); idx++) {
+            int i, j, k;
+            field.fromFlatIndex(idx, i, j, k);
+            expected[idx] = generator.computeEchoSource(t, field.toPosition(i, j, k), center);
+            max_at_t = std::max(max_at_t, std::abs(expected[idx]));
+        }
+        // Separate code paths: equal up to rounding (FMA contraction, fast-math)
+        for (size_t idx = 0; idx < sources.size(); idx++) {
+            TEST_ASSERT(std::abs(sources[idx] - expected[idx]) <= 1e-12 * max_at_t,
+                        "Echo source field mismatch");
+        }
+        max_source = std::max(max_source, max_at_t);
+    }
+    TEST_ASSERT(max_source > 1e-6, "Echo source field should be non-trivial");
+
+    std::cout << "✓ Indexed echo lookup and echo source field test passed" << std::endl;
+    return true;
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -290,7 +377,7 @@ int main() {
     std::cout << "========================================" << std::endl;
 
     int tests_passed = 0;
-    int tests_total = 7;
+    int tests_total = 8;
 
     if (test_prime_generation()) tests_passed++;
     if (test_prime_gaps()) tests_passed++;
@@ -299,6 +386,7 @@ int main() {
     if (test_prime_statistics()) tests_passed++;
     if (test_active_echoes()) tests_passed++;
     if (test_echo_export()) tests_passed++;
+    if (test_echo_source_field()) tests_passed++;
 
     std::cout << "\n========================================" << std::endl;
     std::cout << "Test Results: " << tests_passed << "/" << tests_total << " passed" << std::endl;
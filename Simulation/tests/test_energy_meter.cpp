@@ -0,0 +1,131 @@
+/**
+ * Energy meter test
+ *
+ * Against a fake powercap tree the meter must sum the package zones and
+ * their DRAM subzones (not core subzones, not the intel-rapl-mmio
+ * duplicates), convert microjoules to joules, undo a counter wrap, fall
+ * back to psys when there is no package zone, and refuse to open when no
+ * counter is readable.
+ *
+ * Build: g++ -std=c++17 tests/test_energy_meter.cpp
+ */
+
+#include "../src/cpp/energy_meter.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+void writeFile(const std::string& path, const std::string& text) {
+    std::ofstream(path) << text << "\n";
+}
+
+// A zone directory with name, energy_uj and max_energy_range_uj
+void makeZone(const std::string& dir, const std::string& name, unsigned long long energy,
+              unsigned long long range = 262143328850ULL) {
+    mkdir(dir.c_str(), 0755);
+    writeFile(dir + "/name", name);
+    writeFile(dir + "/energy_uj", std::to_string(energy));
+    writeFile(dir + "/max_energy_range_uj", std::to_string(range));
+}
+
+std::string makeRoot(const std::string& tag) {
+    const std::string root = "/tmp/dase_powercap_" + tag + "_" + std::to_string(getpid());
+    std::system(("rm -rf " + root).c_str());
+    mkdir(root.c_str(), 0755);
+    return root;
+}
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+void testPackageAndDram() {
+    const std::string root = makeRoot("pkg");
+    makeZone(root + "/intel-rapl:0", "package-0", 1000000);
+    makeZone(root + "/intel-rapl:0/intel-rapl:0:0", "dram", 500000);
+    makeZone(root + "/intel-rapl:0/intel-rapl:0:1", "core", 700000);
+    makeZone(root + "/intel-rapl:1", "package-1", 2000000, 3000000);
+    makeZone(root + "/intel-rapl-mmio:0", "package-0", 9000000);
+
+    EnergyMeter meter(root);
+    expect(meter.open(), "fake tree opens");
+    const auto names = meter.domainNames();
+    expect(meter.domains() == 3 && names[0] == "package-0" && names[1] == "package-0/dram" &&
+           names[2] == "package-1", "packages and DRAM are summed, core and mmio are not");
+    expect(std::string(meter.source()) == "rapl", "source is rapl");
+
+    meter.start();
+    writeFile(root + "/intel-rapl:0/energy_uj", "3000000");                  // +2 J
+    writeFile(root + "/intel-rapl:0/intel-rapl:0:0/energy_uj", "1500000");   // +1 J
+    writeFile(root + "/intel-rapl:0/intel-rapl:0:1/energy_uj", "9700000");   // Not summed
+    writeFile(root + "/intel-rapl:1/energy_uj", "500000");                   // Wrapped: +1.5 J
+    const EnergySample sample = meter.stop();
+    expect(sample.valid && near(sample.joules, 4.5), "joules summed with one wrap undone");
+    expect(sample.seconds >= 0.0, "interval timed");
+
+    writeFile(root + "/intel-rapl:1/energy_uj", "not a number");
+    meter.start();
+    expect(!meter.stop().valid, "unreadable counter invalidates the sample");
+
+    meter.close();
+    expect(!meter.isOpen() && !meter.stop().valid, "closed meter reports nothing");
+    std::system(("rm -rf " + root).c_str());
+}
+
+void testPsysFallback() {
+    const std::string root = makeRoot("psys");
+    makeZone(root + "/intel-rapl:0", "psys", 100);
+    EnergyMeter meter(root);
+    expect(meter.open() && meter.domains() == 1 && meter.domainNames()[0] == "psys",
+           "psys used without a package zone");
+    meter.start();
+    writeFile(root + "/intel-rapl:0/energy_uj", "250100");
+    const EnergySample sample = meter.stop();
+    expect(sample.valid && near(sample.joules, 0.25), "psys joules");
+    std::system(("rm -rf " + root).c_str());
+}
+
+void testNothingReadable() {
+    const std::string empty = makeRoot("empty");
+    EnergyMeter none(empty);
+    expect(!none.open() && !none.isOpen(), "empty tree does not open");
+
+    makeZone(empty + "/intel-rapl:0", "package-0", 0);
+    std::remove((empty + "/intel-rapl:0/energy_uj").c_str());
+    expect(!none.open(), "package without a readable counter does not open");
+
+    EnergyMeter missing("/nonexistent/powercap");
+    expect(!missing.open(), "missing root does not open");
+    std::system(("rm -rf " + empty).c_str());
+}
+
+} // namespace
+
+int main() {
+    testPackageAndDram();
+    testPsysFallback();
+    testNothingReadable();
+
+    if (failures != 0) {
+        std::cerr << "test_energy_meter: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_energy_meter: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * Engine memory footprint test
+ *
+ * The static estimateMemory() of every header-only engine must match, per
+ * category, the memoryFootprint() of an engine built from the same
+ * configuration after it has stepped: IGSOA 1D / 2D / 3D under Euler, RK2
+ * and RK4 in double and float precision, Stencil coupling, the ensemble in
+ * both update modes and SATP+Higgs 1D / 2D / 3D.  getMemoryUsage() must be
+ * the footprint total.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_engine_memory.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_ensemble_engine.h"
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_physics_1d.h"
+#include "../src/cpp/satp_higgs_engine_2d.h"
+#include "../src/cpp/satp_higgs_physics_2d.h"
+#include "../src/cpp/satp_higgs_engine_3d.h"
+#include "../src/cpp/satp_higgs_physics_3d.h"
+#include <iostream>
+#include <string>
+
+using dase::MemoryFootprint;
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::string describe(const MemoryFootprint& bytes) {
+    return std::to_string(bytes.state) + "/" + std::to_string(bytes.caches) + "/" +
+           std::to_string(bytes.history) + "/" + std::to_string(bytes.scratch);
+}
+
+void expectSame(const MemoryFootprint& estimate, const MemoryFootprint& measured, const std::string& what) {
+    const bool same = estimate.state == measured.state && estimate.caches == measured.caches &&
+                      estimate.history == measured.history && estimate.scratch == measured.scratch;
+    expect(same, what + ": estimate " + describe(estimate) + " measured " + describe(measured));
+}
+
+IGSOAComplexConfig makeConfig(uint32_t num_nodes, IGSOAIntegrator integrator, IGSOAPrecision precision) {
+    IGSOAComplexConfig config;
+    config.num_nodes = num_nodes;
+    config.R_c_default = 2.5;
+    config.dt = 0.01;
+    config.integrator = integrator;
+    config.precision = precision;
+    config.normalize_psi = false;
+    return config;
+}
+
+void testIgsoa() {
+    const IGSOAIntegrator integrators[] = {IGSOAIntegrator::Euler, IGSOAIntegrator::RK2, IGSOAIntegrator::RK4};
+    const IGSOAPrecision precisions[] = {IGSOAPrecision::Double, IGSOAPrecision::Float};
+    for (IGSOAIntegrator integrator : integrators) {
+        for (IGSOAPrecision precision : precisions) {
+            const std::string label = " integrator " + std::to_string(static_cast<int>(integrator)) +
+                                      " precision " + std::to_string(static_cast<int>(precision));
+
+            const IGSOAComplexConfig config1d = makeConfig(257, integrator, precision);
+            IGSOAComplexEngine engine1d(config1d);
+            engine1d.setNodePsi(3, 1.0, 0.5);
+            engine1d.runMission(3);
+            expectSame(IGSOAComplexEngine::estimateMemory(config1d), engine1d.memoryFootprint(), "1D" + label);
+            expect(engine1d.getMemoryUsage() == engine1d.memoryFootprint().total(), "1D total" + label);
+
+            IGSOAComplexConfig config2d = makeConfig(24 * 20, integrator, precision);
+            config2d.coupling_mode = precision == IGSOAPrecision::Float ? IGSOACouplingMode::Stencil
+                                                                        : IGSOACouplingMode::Direct;
+            IGSOAComplexEngine2D engine2d(config2d, 24, 20);
+            engine2d.setNodePsi(4, 5, 1.0, 0.0);
+            engine2d.runMission(3);
+            expectSame(IGSOAComplexEngine2D::estimateMemory(config2d, 24, 20), engine2d.memoryFootprint(),
+                       "2D" + label);
+
+            const IGSOAComplexConfig config3d = makeConfig(10 * 9 * 8, integrator, precision);
+            IGSOAComplexEngine3D engine3d(config3d, 10, 9, 8);
+            engine3d.setNodePsi(2, 3, 4, 1.0, 0.0);
+            engine3d.runMission(2);
+            expectSame(IGSOAComplexEngine3D::estimateMemory(config3d, 10, 9, 8), engine3d.memoryFootprint(),
+                       "3D" + label);
+        }
+    }
+
+    IGSOAComplexConfig stencil3d = makeConfig(12 * 12 * 12, IGSOAIntegrator::Euler, IGSOAPrecision::Double);
+    stencil3d.coupling_mode = IGSOACouplingMode::Stencil;
+    IGSOAComplexEngine3D engine(stencil3d, 12, 12, 12);
+    engine.runMission(2);
+    const MemoryFootprint measured = engine.memoryFootprint();
+    expectSame(IGSOAComplexEngine3D::estimateMemory(stencil3d, 12, 12, 12), measured, "3D stencil");
+    expect(measured.caches > 0, "3D stencil table counted as a cache");
+}
+
+void testEnsemble() {
+    const IGSOAUpdateMode modes[] = {IGSOAUpdateMode::InPlace, IGSOAUpdateMode::DoubleBuffered};
+    for (IGSOAUpdateMode mode : modes) {
+        IGSOAComplexConfig config = makeConfig(64, IGSOAIntegrator::Euler, IGSOAPrecision::Double);
+        config.update_mode = mode;
+        IGSOAEnsembleEngine1D ensemble(config, 5);
+        ensemble.runMission(2);
+        expectSame(IGSOAEnsembleEngine1D::estimateMemory(config, 5), ensemble.memoryFootprint(),
+                   "ensemble mode " + std::to_string(static_cast<int>(mode)));
+    }
+}
+
+void testSatp() {
+    dase::satp_higgs::SATPHiggsParams params;
+    dase::satp_higgs::SATPHiggsEngine1D engine1d(300, 0.1, 0.001, params);
+    engine1d.evolve(3);
+    expectSame(dase::satp_higgs::SATPHiggsEngine1D::estimateMemory(300), engine1d.memoryFootprint(), "SATP 1D");
+
+    dase::satp_higgs::SATPHiggsEngine2D engine2d(20, 16, 0.1, 0.001, params);
+    engine2d.evolve(3);
+    expectSame(dase::satp_higgs::SATPHiggsEngine2D::estimateMemory(20, 16), engine2d.memoryFootprint(), "SATP 2D");
+
+    dase::satp_higgs::SATPHiggsEngine3D engine3d(8, 7, 6, 0.1, 0.001, params);
+    engine3d.evolve(3);
+    expectSame(dase::satp_higgs::SATPHiggsEngine3D::estimateMemory(8, 7, 6), engine3d.memoryFootprint(), "SATP 3D");
+}
+
+} // namespace
+
+int main() {
+    testIgsoa();
+    testEnsemble();
+    testSatp();
+
+    if (failures != 0) {
+        std::cerr << "test_engine_memory: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_engine_memory: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * Zero-copy field view C API test
+ *
+ * igsoa_get_field_view, igsoa2d_get_field_view and satp_get_field_view
+ * must describe the engines' own memory: every element reached through
+ * data / dims / byte strides equals the per-node accessor, writes through
+ * a writable view reach the next step, and an unknown layout version or
+ * field is refused.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -Isrc/cpp tests/test_field_view_capi.cpp src/cpp/igsoa_capi.cpp src/cpp/igsoa_capi_2d.cpp src/cpp/satp_capi.cpp
+ */
+
+#include "../src/cpp/igsoa_capi.h"
+#include "../src/cpp/igsoa_capi_2d.h"
+#include "../src/cpp/satp_capi.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+DaseFieldView freshView() {
+    DaseFieldView view;
+    std::memset(&view, 0, sizeof(view));
+    view.version = DASE_FIELD_VIEW_VERSION;
+    return view;
+}
+
+double* element(const DaseFieldView& view, int64_t i0, int64_t i1 = 0, int64_t i2 = 0) {
+    char* base = static_cast<char*>(view.data);
+    base += i0 * view.strides[0];
+    if (view.ndim > 1) base += i1 * view.strides[1];
+    if (view.ndim > 2) base += i2 * view.strides[2];
+    return reinterpret_cast<double*>(base);
+}
+
+void testIGSOA1D() {
+    const uint32_t n = 16;
+    IGSOAEngineHandle engine = igsoa_create_engine(n, 2.0, 1.0, 0.1, 0.01);
+    for (uint32_t i = 0; i < n; ++i) {
+        igsoa_set_node_psi(engine, i, 0.1 * i, -0.05 * i);
+        igsoa_set_node_phi(engine, i, 0.2 * i);
+    }
+
+    DaseFieldView phi = freshView();
+    expect(igsoa_get_field_view(engine, IGSOA_FIELD_PHI, &phi), "1D Φ view");
+    expect(phi.ndim == 1 && phi.dims[0] == n && phi.element_type == DASE_ELEMENT_FLOAT64 &&
+           phi.element_size == sizeof(double) && phi.writable == 1, "1D Φ view layout");
+    bool same = true;
+    for (uint32_t i = 0; i < n; ++i) {
+        same = same && *element(phi, i) == igsoa_get_node_phi(engine, i);
+    }
+    expect(same, "1D Φ view reads the node state");
+
+    DaseFieldView psi = freshView();
+    expect(igsoa_get_field_view(engine, IGSOA_FIELD_PSI, &psi), "1D Ψ view");
+    expect(psi.element_type == DASE_ELEMENT_COMPLEX128 && psi.element_size == 2 * sizeof(double) &&
+           psi.strides[0] == phi.strides[0], "1D Ψ view is complex128 with the node stride");
+    double re = 0.0, im = 0.0;
+    igsoa_get_node_psi(engine, 5, &re, &im);
+    expect(element(psi, 5)[0] == re && element(psi, 5)[1] == im, "1D Ψ view reads (re, im)");
+
+    DaseFieldView f = freshView();
+    expect(igsoa_get_field_view(engine, IGSOA_FIELD_F, &f) && f.writable == 0, "1D F view is read-only");
+
+    *element(phi, 3) = 7.5;
+    expect(igsoa_get_node_phi(engine, 3) == 7.5, "1D Φ written through the view");
+
+    DaseFieldView stale = freshView();
+    stale.version = DASE_FIELD_VIEW_VERSION + 1;
+    expect(!igsoa_get_field_view(engine, IGSOA_FIELD_PHI, &stale) && stale.data == nullptr,
+           "1D unknown view version refused");
+    expect(!igsoa_get_field_view(engine, IGSOA_FIELD_PHI, nullptr), "1D null view refused");
+    igsoa_destroy_engine(engine);
+}
+
+void testIGSOA2D() {
+    const size_t nx = 6, ny = 4;
+    IGSOA2DEngineHandle engine = igsoa2d_create_engine(nx, ny, 1.5, 1.0, 0.1, 0.01);
+    for (size_t y = 0; y < ny; ++y) {
+        for (size_t x = 0; x < nx; ++x) {
+            igsoa2d_set_node_phi(engine, x, y, 10.0 * y + x);
+        }
+    }
+    DaseFieldView phi = freshView();
+    expect(igsoa2d_get_field_view(engine, IGSOA_FIELD_PHI, &phi), "2D Φ view");
+    expect(phi.ndim == 2 && phi.dims[0] == ny && phi.dims[1] == nx &&
+           phi.strides[0] == static_cast<int64_t>(nx) * phi.strides[1], "2D Φ view is (N_y, N_x), row major");
+    bool same = true;
+    for (size_t y = 0; y < ny; ++y) {
+        for (size_t x = 0; x < nx; ++x) {
+            same = same && *element(phi, y, x) == igsoa2d_get_node_phi(engine, x, y);
+        }
+    }
+    expect(same, "2D Φ view reads the node state");
+    igsoa2d_destroy_engine(engine);
+}
+
+void testSATP() {
+    SATPParams params;
+    satp_params_init(&params);
+    params.gamma_phi = 0.1;
+
+    SATPEngineHandle engine = satp_create_engine(3, 5, 4, 3, 0.1, 0.01, &params);
+    expect(engine != nullptr, "SATP 3D engine created");
+    size_t nx = 0, ny = 0, nz = 0;
+    expect(satp_get_dimensions(engine, &nx, &ny, &nz) && nx == 5 && ny == 4 && nz == 3, "SATP 3D dimensions");
+
+    DaseFieldView phi_dot = freshView();
+    expect(satp_get_field_view(engine, SATP_FIELD_PHI_DOT, &phi_dot), "SATP φ̇ view");
+    expect(phi_dot.ndim == 3 && phi_dot.dims[0] == 3 && phi_dot.dims[1] == 4 && phi_dot.dims[2] == 5 &&
+           phi_dot.strides[1] == 5 * phi_dot.strides[2] && phi_dot.strides[0] == 4 * phi_dot.strides[1] &&
+           phi_dot.writable == 1, "SATP 3D view is (N_z, N_y, N_x), C order");
+
+    // A kick written through the view moves φ on the next step (φ += φ̇ dt)
+    *element(phi_dot, 1, 2, 3) = 1.0;
+    expect(satp_evolve(engine, 1), "SATP evolve");
+    DaseFieldView phi = freshView();
+    expect(satp_get_field_view(engine, SATP_FIELD_PHI, &phi), "SATP φ view after a step");
+    expect(*element(phi, 1, 2, 3) > 0.005 && std::fabs(*element(phi, 0, 0, 0)) < 1e-12,
+           "write through the view reaches the next step");
+    expect(satp_get_step_count(engine) == 1 && std::fabs(satp_get_time(engine) - 0.01) < 1e-15,
+           "SATP step count and time");
+
+    DaseFieldView energy = freshView();
+    expect(satp_get_field_view(engine, SATP_FIELD_ENERGY_DENSITY, &energy) && energy.writable == 0 &&
+           *element(energy, 1, 2, 3) > 0.0, "SATP energy density view is read-only and current");
+    expect(!satp_get_field_view(engine, static_cast<SATPField>(9), &energy), "unknown SATP field refused");
+    satp_destroy_engine(engine);
+
+    SATPEngineHandle line = satp_create_engine(1, 32, 0, 0, 0.1, 0.01, nullptr);
+    DaseFieldView h = freshView();
+    expect(line != nullptr && satp_get_field_view(line, SATP_FIELD_H, &h) && h.ndim == 1 && h.dims[0] == 32,
+           "SATP 1D view");
+    satp_destroy_engine(line);
+
+    SATPEngineHandle plane = satp_create_engine(2, 8, 6, 0, 0.1, 0.01, nullptr);
+    DaseFieldView h2 = freshView();
+    expect(plane != nullptr && satp_get_field_view(plane, SATP_FIELD_H, &h2) && h2.ndim == 2 &&
+           h2.dims[0] == 6 && h2.dims[1] == 8 && std::fabs(*element(h2, 5, 7) - *element(h2, 0, 0)) < 1e-15,
+           "SATP 2D view");
+    satp_destroy_engine(plane);
+
+    expect(satp_create_engine(4, 8, 8, 8, 0.1, 0.01, nullptr) == nullptr &&
+           satp_create_engine(2, 8, 0, 0, 0.1, 0.01, nullptr) == nullptr, "invalid SATP sizes rejected");
+}
+
+} // namespace
+
+int main() {
+    testIGSOA1D();
+    testIGSOA2D();
+    testSATP();
+
+    if (failures != 0) {
+        std::cerr << "test_field_view_capi: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_field_view_capi: PASS" << std::endl;
+    return 0;
+}
@@ -5,12 +5,28 @@
  * - SymmetryField 3D grid operations
  * - FractionalSolver SOE kernel
  * - Basic field evolution
+ * - Binary merger source terms
+ * - Binary field snapshots
+ * - Registered-observer strain extraction
+ * - Tabulated Mittag-Leffler evaluation
+ * - Adaptive-rank SOE kernels and the kernel cache
+ * - Batched waveform template banks
+ * - Field-wide projection arrays
+ * - Binned many-source catalogs
  */
 
 #define _USE_MATH_DEFINES  // Enable M_PI on MSVC
 #include <cmath>
 #include "../src/cpp/igsoa_gw_engine/core/symmetry_field.h"
 #include "../src/cpp/igsoa_gw_engine/core/fractional_solver.h"
+#include "../src/cpp/igsoa_gw_engine/core/soe_kernel_cache.h"
+#include "../src/cpp/igsoa_gw_engine/core/source_manager.h"
+#include "../src/cpp/igsoa_gw_engine/core/field_snapshot.h"
+#include "../src/cpp/igsoa_gw_engine/core/projection_operators.h"
+#include "../src/cpp/igsoa_gw_engine/core/template_bank.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 
@@ -210,6 +226,111 @@ bool test_fractional_solver() {
 
     std::cout << "✓ Precomputed " << num_cached << " kernels" << std::endl;
 
+    if (num_cached != 10) {
+        std::cout << "FAILED: Expected 10 cached kernels" << std::endl;
+        return false;
+    }
+
+    // Unmatched α quantizes onto the table instead of growing it
+    const SOEKernel* k_first = &solver.getKernel(1.37);
+    solver.getKernel(1.3701);
+    solver.getKernel(1.9999);
+    if (solver.getNumCachedKernels() != num_cached || &solver.getKernel(1.37) != k_first) {
+        std::cout << "FAILED: Kernel table changed on lookup" << std::endl;
+        return false;
+    }
+    if (solver.getKernelIndex(1.0) != 0 || solver.getKernelIndex(2.0) != 9 ||
+        solver.getKernelIndex(0.5) != 0 || solver.getKernelIndex(2.5) != 9) {
+        std::cout << "FAILED: Kernel index lookup out of range" << std::endl;
+        return false;
+    }
+
+    // Bound per-point α must give the same history as the per-call α path
+    std::vector<double> alphas(num_points);
+    std::vector<std::complex<double>> second(num_points);
+    for (int i = 0; i < num_points; ++i) {
+        alphas[i] = 1.0 + static_cast<double>(i) / (num_points - 1);
+        second[i] = std::complex<double>(0.01 * i, -0.02 * i);
+    }
+    FractionalSolver bound(config, num_points);
+    bound.precomputeKernels(10);
+    bound.setPointAlphas(alphas);
+    for (int step = 0; step < 5; ++step) {
+        solver.updateHistory(second, second, alphas, 0.01);
+        bound.updateHistory(second, 0.01);
+    }
+    auto d_ref = solver.computeDerivatives(alphas);
+    auto d_bound = bound.computeDerivatives(alphas);
+    for (int i = 0; i < num_points; ++i) {
+        if (d_ref[i] != d_bound[i]) {
+            std::cout << "FAILED: Bound α history differs at point " << i << std::endl;
+            return false;
+        }
+    }
+    std::cout << "✓ Bound per-point kernel indices match per-call lookup" << std::endl;
+
+    // Flat history (both layouts, fused pass) must match per-point HistoryState
+    std::vector<HistoryState> reference(num_points, HistoryState(config.soe_rank));
+    FractionalSolverConfig rank_major_config = config;
+    rank_major_config.history_layout = HistoryLayout::RankMajor;
+    FractionalSolver rank_major(rank_major_config, num_points);
+    rank_major.precomputeKernels(10);
+    rank_major.setPointAlphas(alphas);
+    std::vector<std::complex<double>> fused;
+    for (int step = 0; step < 5; ++step) {
+        for (int i = 0; i < num_points; ++i) {
+            reference[i].update(bound.getKernel(alphas[i]), second[i], 0.01);
+        }
+        rank_major.updateHistoryAndDerivatives(second, 0.01, fused);
+    }
+    // Separate code paths: equal up to rounding (FMA contraction, fast-math)
+    d_bound = bound.computeDerivatives(alphas);
+    const auto close = [](std::complex<double> a, std::complex<double> b) {
+        return std::abs(a - b) <= 1e-12 * std::abs(b);
+    };
+    for (int i = 0; i < num_points; ++i) {
+        if (!close(fused[i], d_bound[i]) || !close(reference[i].computeDerivative(), d_bound[i])) {
+            std::cout << "FAILED: Flat SOE history differs from HistoryState at point " << i << std::endl;
+            return false;
+        }
+    }
+    std::cout << "✓ Flat history (point/rank-major, fused) matches HistoryState" << std::endl;
+
+    // Single-precision history: half the state memory, double arithmetic
+    for (HistoryLayout layout : {HistoryLayout::PointMajor, HistoryLayout::RankMajor}) {
+        FractionalSolverConfig single_config = config;
+        single_config.history_layout = layout;
+        single_config.history_precision = HistoryPrecision::Single;
+        FractionalSolver single(single_config, num_points);
+        FractionalSolverConfig double_config = single_config;
+        double_config.history_precision = HistoryPrecision::Double;
+        FractionalSolver full(double_config, num_points);
+        single.setPointAlphas(alphas);
+        full.setPointAlphas(alphas);
+
+        std::vector<std::complex<double>> d_single, d_full;
+        for (int step = 0; step < 200; ++step) {
+            single.updateHistoryAndDerivatives(second, 0.01, d_single);
+            full.updateHistoryAndDerivatives(second, 0.01, d_full);
+        }
+        double max_rel = 0.0;
+        for (int i = 1; i < num_points; ++i) {
+            max_rel = std::max(max_rel, std::abs(d_single[i] - d_full[i]) / std::abs(d_full[i]));
+            if (single.computeDerivativeAt(i, alphas[i]) != d_single[i]) {
+                std::cout << "FAILED: Single-precision derivative paths disagree" << std::endl;
+                return false;
+            }
+        }
+        const size_t history_double = static_cast<size_t>(num_points) * config.soe_rank * 2 * sizeof(double);
+        if (max_rel > 1e-5 || full.getMemoryUsage() - single.getMemoryUsage() != history_double / 2) {
+            std::cout << "FAILED: Single-precision history (rel err " << max_rel
+                      << ", memory " << single.getMemoryUsage() << " vs "
+                      << full.getMemoryUsage() << ")" << std::endl;
+            return false;
+        }
+    }
+    std::cout << "✓ Single-precision history halves state memory (rel err < 1e-5)" << std::endl;
+
     // Test memory usage
     size_t mem = solver.getMemoryUsage();
     std::cout << "✓ Memory usage: " << mem / 1024.0 / 1024.0 << " MB" << std::endl;
@@ -384,14 +505,787 @@ bool test_interpolation() {
     return true;
 }
 
+// Test 8: Fused evolution step
+bool test_evolve_step_caches() {
+    std::cout << "\n=== Test 8: Fused Evolution Step ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 20;
+    config.ny = 18;
+    config.nz = 16;
+    config.dx = 1.0;
+    config.dy = 1.5;
+    config.dz = 2.0;
+    config.dt = 0.01;
+
+    SymmetryField field(config);
+    const int total = field.getTotalPoints();
+
+    for (int idx = 0; idx < total; idx++) {
+        int i, j, k;
+        field.fromFlatIndex(idx, i, j, k);
+        field.setDeltaPhi(i, j, k, std::complex<double>(
+            0.1 * std::sin(0.37 * idx), 0.05 * std::cos(0.11 * idx)));
+    }
+    field.updatePotentialCache();
+
+    // The fused sweep and the per-point reference agree up to rounding
+    // (FMA contraction, fast-math reassociation)
+    const auto close = [](auto a, auto b) { return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(b)); };
+    std::vector<std::complex<double>> frac(total), source(total), expected(total);
+    for (int step = 0; step < 3; step++) {
+        for (int idx = 0; idx < total; idx++) {
+            frac[idx] = std::complex<double>(0.01 * std::cos(0.2 * idx + step), 0.0);
+            source[idx] = std::complex<double>(0.0, 0.02 * std::sin(0.3 * idx - step));
+        }
+
+        // Reference: the original per-point update (interior only)
+        for (int idx = 0; idx < total; idx++) {
+            int i, j, k;
+            field.fromFlatIndex(idx, i, j, k);
+            std::complex<double> psi = field.getDeltaPhi(i, j, k);
+            expected[idx] = psi;
+            if (i > 0 && i < config.nx - 1 && j > 0 && j < config.ny - 1 &&
+                k > 0 && k < config.nz - 1) {
+                std::complex<double> rhs = field.computeLaplacian(i, j, k) - frac[idx]
+                                         - field.getPotential(i, j, k) * psi + source[idx];
+                expected[idx] = psi + config.dt * rhs;
+            }
+        }
+
+        field.evolveStep(frac, source);
+
+        for (int idx = 0; idx < total; idx++) {
+            int i, j, k;
+            field.fromFlatIndex(idx, i, j, k);
+            if (!close(field.getDeltaPhi(i, j, k), expected[idx]) ||
+                !close(field.getGradientMagnitude(i, j, k), field.computeGradient(i, j, k).magnitude()) ||
+                !close(field.getPotential(i, j, k), field.computePotential(i, j, k))) {
+                std::cout << "FAILED: Fused step mismatch at (" << i << ", " << j << ", "
+                          << k << ") on step " << step << std::endl;
+                return false;
+            }
+        }
+    }
+
+    if (std::abs(field.getCurrentTime() - 3 * config.dt) > 1e-15) {
+        std::cout << "FAILED: Time not advanced: " << field.getCurrentTime() << std::endl;
+        return false;
+    }
+
+    // Diagnostics read the totals of the last sweep; per-point sums agree
+    const double dV = config.dx * config.dy * config.dz;
+    double energy = 0.0, sum_amplitude = 0.0, max_amplitude = 0.0, sum_gradient = 0.0, max_gradient = 0.0;
+    for (int idx = 0; idx < total; idx++) {
+        int i, j, k;
+        field.fromFlatIndex(idx, i, j, k);
+        const std::complex<double> value = field.getDeltaPhi(i, j, k);
+        energy += std::norm(value) * dV;
+        sum_amplitude += std::abs(value);
+        max_amplitude = std::max(max_amplitude, std::abs(value));
+        sum_gradient += field.getGradientMagnitude(i, j, k);
+        max_gradient = std::max(max_gradient, field.getGradientMagnitude(i, j, k));
+    }
+    const auto stats = field.getStatistics();
+    if (!close(field.computeTotalEnergy(), energy) || !close(field.computeMaxAmplitude(), max_amplitude) ||
+        !close(stats.total_energy, energy) || !close(stats.mean_amplitude, sum_amplitude / total) ||
+        !close(stats.max_amplitude, max_amplitude) || !close(stats.mean_gradient, sum_gradient / total) ||
+        stats.max_gradient != max_gradient) {
+        std::cout << "FAILED: Swept diagnostics differ from per-point sums" << std::endl;
+        return false;
+    }
+
+    // A direct edit is picked up by the next diagnostic
+    const std::complex<double> old_value = field.getDeltaPhi(3, 4, 5);
+    field.setDeltaPhi(3, 4, 5, std::complex<double>(10.0, 0.0));
+    if (field.computeMaxAmplitude() != 10.0 ||
+        !close(field.computeTotalEnergy(), energy + (100.0 - std::norm(old_value)) * dV)) {
+        std::cout << "FAILED: Diagnostics stale after setDeltaPhi" << std::endl;
+        return false;
+    }
+
+    std::cout << "✓ Fused step matches per-point field, gradient, potential and diagnostics" << std::endl;
+    return true;
+}
+
+// Test 9: Truncated-support source terms
+bool test_truncated_sources() {
+    std::cout << "\n=== Test 9: Truncated Source Support ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 24;
+    config.ny = 24;
+    config.nz = 24;
+    config.dx = 1.0;
+    config.dy = 1.0;
+    config.dz = 1.0;
+    SymmetryField field(config);
+    const int total = field.getTotalPoints();
+
+    // One BH orbits partly off the grid
+    BinaryMergerConfig merger_config;
+    merger_config.mass2 = 20.0;
+    merger_config.initial_separation = 14.0;
+    merger_config.center = Vector3D(5.0, 12.0, 12.0);
+    merger_config.gaussian_width = 2.0;
+
+    BinaryMerger full(merger_config);
+    merger_config.source_cutoff_sigmas = 6.0;
+    BinaryMerger truncated(merger_config);
+
+    const double dt = 1e-10;
+    for (int step = 0; step < 12; step++) {
+        const std::vector<std::complex<double>> reference = full.computeSourceTerms(field, 0.0);
+        const std::vector<std::complex<double>>& reused = full.updateSourceTerms(field, 0.0);
+        const std::vector<std::complex<double>> fresh = truncated.computeSourceTerms(field, 0.0);
+        const std::vector<std::complex<double>>& boxed = truncated.updateSourceTerms(field, 0.0);
+
+        if (static_cast<int>(reused.size()) != total || static_cast<int>(boxed.size()) != total) {
+            std::cout << "FAILED: Source buffer size mismatch" << std::endl;
+            return false;
+        }
+
+        double max_error = 0.0;
+        for (int idx = 0; idx < total; idx++) {
+            // Disabled cutoff is exact; the reused buffer must match a fresh one
+            if (reused[idx] != reference[idx] || boxed[idx] != fresh[idx]) {
+                std::cout << "FAILED: Reused source buffer mismatch at " << idx
+                          << " on step " << step << std::endl;
+                return false;
+            }
+            max_error = std::max(max_error, std::abs(boxed[idx] - reference[idx]));
+        }
+
+        // Truncation error is bounded by the Gaussian tail at 6σ
+        if (max_error > 2.0 * std::exp(-18.0)) {
+            std::cout << "FAILED: Truncation error too large: " << max_error << std::endl;
+            return false;
+        }
+
+        full.evolveOrbit(dt);
+        truncated.evolveOrbit(dt);
+    }
+
+    std::cout << "✓ Truncated sources match full evaluation within the 6σ tail" << std::endl;
+    return true;
+}
+
+// Test 10: Binary field snapshots
+bool test_field_snapshot() {
+    std::cout << "\n=== Test 10: Binary Field Snapshots ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 7;
+    config.ny = 5;
+    config.nz = 3;
+    config.dx = 1.0;
+    config.dy = 2.0;
+    config.dz = 3.0;
+    SymmetryField field(config);
+    const int total = field.getTotalPoints();
+
+    for (int idx = 0; idx < total; idx++) {
+        int i, j, k;
+        field.fromFlatIndex(idx, i, j, k);
+        field.setDeltaPhi(i, j, k, std::complex<double>(0.1 * idx, -0.01 * idx));
+        field.setAlpha(i, j, k, 1.0 + 0.5 * (idx % 3));
+    }
+    field.updateGradientCache();
+    field.updatePotentialCache();
+    field.setCurrentTime(0.125);
+
+    auto matches = [&](const FieldSnapshot& snap) {
+        return snap.nx == config.nx && snap.ny == config.ny && snap.nz == config.nz &&
+               snap.dx == config.dx && snap.dy == config.dy && snap.dz == config.dz &&
+               snap.time == field.getCurrentTime() &&
+               snap.delta_phi == field.getDeltaPhiFlat() &&
+               snap.alpha == field.getAlphaFlat() &&
+               snap.gradient_magnitude == field.getGradientMagnitudeFlat() &&
+               snap.potential == field.getPotentialFlat();
+    };
+
+    const std::string sync_file = "test_field_snapshot_sync.bin";
+    const std::string async_file = "test_field_snapshot_async.bin";
+    bool ok = true;
+    try {
+        field.exportBinary(sync_file);
+        if (!matches(FieldSnapshot::read(sync_file))) {
+            std::cout << "FAILED: Synchronous snapshot round trip mismatch" << std::endl;
+            ok = false;
+        }
+
+        FieldSnapshotWriter writer;
+        writer.submit(field, async_file);
+        // The writer owns its copy; later changes must not leak into the file
+        field.setDeltaPhi(0, 0, 0, std::complex<double>(42.0, 0.0));
+        writer.flush();
+        field.setDeltaPhi(0, 0, 0, std::complex<double>(0.0, 0.0));
+        if (writer.getWrittenCount() != 1 || !matches(FieldSnapshot::read(async_file))) {
+            std::cout << "FAILED: Background snapshot round trip mismatch" << std::endl;
+            ok = false;
+        }
+
+        bool threw = false;
+        writer.submit(field, "nonexistent_dir/snapshot.bin");
+        try {
+            writer.flush();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            std::cout << "FAILED: Background write error not reported" << std::endl;
+            ok = false;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "FAILED: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(sync_file.c_str());
+    std::remove(async_file.c_str());
+
+    if (ok) {
+        std::cout << "✓ Binary snapshots round-trip (sync and background)" << std::endl;
+    }
+    return ok;
+}
+
+// Test 11: Registered observers match the full strain path
+bool test_registered_observers() {
+    std::cout << "\n=== Test 11: Registered Observer Strain ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 9;
+    config.ny = 8;
+    config.nz = 7;
+    config.dx = 1.0;
+    config.dy = 1.5;
+    config.dz = 0.5;
+    SymmetryField field(config);
+
+    ProjectionConfig proj_config;
+    proj_config.observer_history_capacity = 3;
+    ProjectionOperators projector(proj_config);
+
+    // Interior point, boundary point and a position clamped onto the grid
+    const Vector3D positions[3] = {Vector3D(4.2, 6.1, 1.4), Vector3D(0.0, 3.0, 3.0),
+                                   Vector3D(100.0, -5.0, 1.0)};
+    for (const Vector3D& pos : positions) {
+        projector.registerObserver(field, pos);
+    }
+    const Vector3D interp_pos(3.3, 4.4, 2.2);
+    const int interp_id = projector.registerObserver(
+        field, interp_pos, ProjectionOperators::ObserverSampling::Trilinear);
+
+    bool ok = true;
+    const int steps = 5;
+    for (int step = 0; step < steps; step++) {
+        for (int idx = 0; idx < field.getTotalPoints(); idx++) {
+            int i, j, k;
+            field.fromFlatIndex(idx, i, j, k);
+            Vector3D pos = field.toPosition(i, j, k);
+            field.setDeltaPhi(i, j, k, std::complex<double>(
+                std::sin(0.4 * pos.x + 0.3 * step) * std::cos(0.2 * pos.y),
+                0.5 * std::cos(0.6 * pos.z - 0.1 * pos.x * step)));
+            field.setAlpha(i, j, k, 1.5);
+        }
+        field.updateGradientCache();
+        field.updatePotentialCache();
+        field.setCurrentTime(0.1 * step);
+        projector.sampleObservers(field);
+
+        for (int n = 0; n < 3; n++) {
+            ProjectionConfig single = proj_config;
+            single.observer_position = positions[n];
+            auto expected = ProjectionOperators(single).compute_strain_at_observer(field);
+            auto got = projector.getObserverSample(n, 0).strain;
+            // Same strain up to rounding; the phase compares modulo 2π
+            const double tol = 1e-12 * expected.amplitude;
+            if (std::abs(got.h_plus - expected.h_plus) > tol ||
+                std::abs(got.h_cross - expected.h_cross) > tol ||
+                std::abs(got.amplitude - expected.amplitude) > tol ||
+                std::abs(std::remainder(got.phase - expected.phase, 2.0 * M_PI)) > 1e-10) {
+                std::cout << "FAILED: Observer " << n << " differs from compute_strain_at_observer"
+                          << std::endl;
+                ok = false;
+            }
+        }
+
+        // Trilinear: weighted strain of the 8 surrounding grid points
+        int i0 = static_cast<int>(std::floor(interp_pos.x / config.dx));
+        int j0 = static_cast<int>(std::floor(interp_pos.y / config.dy));
+        int k0 = static_cast<int>(std::floor(interp_pos.z / config.dz));
+        double tx = interp_pos.x / config.dx - i0;
+        double ty = interp_pos.y / config.dy - j0;
+        double tz = interp_pos.z / config.dz - k0;
+        double h_plus = 0.0, h_cross = 0.0;
+        for (int c = 0; c < 8; c++) {
+            int di = (c >> 2) & 1, dj = (c >> 1) & 1, dk = c & 1;
+            double w = (di ? tx : 1.0 - tx) * (dj ? ty : 1.0 - ty) * (dk ? tz : 1.0 - tz);
+            auto corner = projector.compute_strain(
+                projector.compute_stress_energy_tensor(field, i0 + di, j0 + dj, k0 + dk),
+                proj_config.detector_normal);
+            h_plus += w * corner.h_plus;
+            h_cross += w * corner.h_cross;
+        }
+        auto interp = projector.getObserverSample(interp_id, 0).strain;
+        if (std::abs(interp.h_plus - h_plus) > 1e-12 || std::abs(interp.h_cross - h_cross) > 1e-12) {
+            std::cout << "FAILED: Trilinear observer mismatch" << std::endl;
+            ok = false;
+        }
+    }
+
+    // Ring buffer keeps the newest `capacity` samples, oldest first
+    std::vector<ProjectionOperators::StrainSample> history;
+    projector.copyObserverHistory(0, history);
+    if (projector.getObserverSampleCount() != 3 || history.size() != 3 ||
+        history.front().time != 0.1 * (steps - 3) || history.back().time != 0.1 * (steps - 1)) {
+        std::cout << "FAILED: Ring buffer did not retain the latest samples" << std::endl;
+        ok = false;
+    }
+
+    bool threw = false;
+    try {
+        projector.getObserverSample(0, 3);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cout << "FAILED: Out-of-history sample not rejected" << std::endl;
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "✓ Registered observers match compute_strain_at_observer" << std::endl;
+    }
+    return ok;
+}
+
+// Test 12: Tabulated Mittag-Leffler matches the series
+bool test_mittag_leffler_table() {
+    std::cout << "\n=== Test 12: Tabulated Mittag-Leffler ===" << std::endl;
+
+    MittagLefflerFunction::clear_table_cache();
+    bool ok = true;
+    double max_rel_error = 0.0;
+
+    const double alphas[] = {1.0, 1.3, 1.7, 2.0};
+    for (double alpha : alphas) {
+        for (double beta : {1.0, alpha}) {
+            for (int n = 0; n <= 1000; n++) {
+                double z = -7.9 + 15.8 * n / 1000.0 + 1e-4 * std::sin(n);
+                double exact = MittagLefflerFunction::evaluate_real(alpha, beta, z);
+                double table = MittagLefflerFunction::evaluate_real_tabulated(alpha, beta, z);
+                max_rel_error = std::max(max_rel_error,
+                                         std::abs(table - exact) / std::max(std::abs(exact), 1e-3));
+            }
+        }
+    }
+    std::cout << "Max relative error vs series: " << std::scientific << max_rel_error << std::endl;
+    if (max_rel_error > 1e-9) {
+        std::cout << "FAILED: Table deviates from the series" << std::endl;
+        ok = false;
+    }
+
+    // E_1,1(z) = exp(z); E_2,1(-z²) = cos(z)
+    if (std::abs(MittagLefflerFunction::evaluate_real_tabulated(1.0, 1.0, 2.5) - std::exp(2.5)) >
+            1e-9 * std::exp(2.5) ||
+        std::abs(MittagLefflerFunction::evaluate_real_tabulated(2.0, 1.0, -4.0) - std::cos(2.0)) > 1e-9) {
+        std::cout << "FAILED: Known closed forms not reproduced" << std::endl;
+        ok = false;
+    }
+
+    // Out-of-range arguments take the series path unchanged
+    if (MittagLefflerFunction::evaluate_real_tabulated(1.5, 1.0, 9.0) !=
+        MittagLefflerFunction::evaluate_real(1.5, 1.0, 9.0)) {
+        std::cout << "FAILED: Out-of-range argument not evaluated by the series" << std::endl;
+        ok = false;
+    }
+
+    // Cache stays bounded and reuses tables
+    auto first = MittagLefflerFunction::get_table(1.0, 1.0);
+    if (MittagLefflerFunction::get_table(1.0, 1.0) != first) {
+        std::cout << "FAILED: Table not reused" << std::endl;
+        ok = false;
+    }
+    for (int n = 0; n < 40; n++) {
+        MittagLefflerFunction::get_table(1.0 + 0.025 * n, 0.5);
+    }
+    if (MittagLefflerFunction::get_table_cache_size() > 16) {
+        std::cout << "FAILED: Table cache exceeded its bound" << std::endl;
+        ok = false;
+    }
+    MittagLefflerFunction::clear_table_cache();
+
+    if (ok) {
+        std::cout << "✓ Tabulated Mittag-Leffler within 1e-9 of the series" << std::endl;
+    }
+    return ok;
+}
+
+// Test 13: Accuracy-targeted SOE kernels with the on-disk cache
+bool test_fitted_soe_kernels() {
+    std::cout << "\n=== Test 13: Fitted SOE Kernels ===" << std::endl;
+
+    const std::string cache_file = "test_soe_kernel_cache.txt";
+    std::remove(cache_file.c_str());
+
+    FractionalSolverConfig config;
+    config.T_max = 1.0;
+    config.dt = 0.01;
+    config.soe_rank = 24;
+    config.alpha_min = 1.1;
+    config.alpha_max = 1.9;
+    config.alpha_table_size = 9;
+    config.soe_tolerance = 1e-4;
+    config.soe_cache_path = cache_file;
+
+    const int num_points = 50;
+    bool ok = true;
+    try {
+        FractionalSolver fitted(config, num_points);
+        std::cout << "History rank " << fitted.getHistoryRank() << " (limit "
+                  << config.soe_rank << ")" << std::endl;
+        if (fitted.getHistoryRank() >= config.soe_rank) {
+            std::cout << "FAILED: Fit did not reduce the rank" << std::endl;
+            ok = false;
+        }
+
+        auto result = fitted.validateSOEApproximation(1.3, config.soe_tolerance);
+        std::cout << "Max relative error over [dt, T_max]: " << result.max_error << std::endl;
+        if (!result.passed) {
+            std::cout << "FAILED: Fitted kernel exceeds soe_tolerance" << std::endl;
+            ok = false;
+        }
+
+        // Same table from the disk cache, bit for bit
+        SOEKernelCache cache(cache_file);
+        FractionalSolver reloaded(config, num_points);
+        if (cache.size() != static_cast<size_t>(config.alpha_table_size)) {
+            std::cout << "FAILED: Cache holds " << cache.size() << " kernels" << std::endl;
+            ok = false;
+        }
+        for (int i = 0; i < config.alpha_table_size; i++) {
+            double alpha = config.alpha_min + (config.alpha_max - config.alpha_min) * i /
+                           (config.alpha_table_size - 1);
+            const SOEKernel& a = fitted.getKernel(alpha);
+            const SOEKernel& b = reloaded.getKernel(alpha);
+            SOEKernel direct;
+            direct.fit(alpha, config.T_max, config.dt, config.soe_tolerance, config.soe_rank);
+            if (a.weights != b.weights || a.exponents != b.exponents ||
+                a.weights != direct.weights || a.exponents != direct.exponents) {
+                std::cout << "FAILED: Cached kernel differs for alpha = " << alpha << std::endl;
+                ok = false;
+            }
+        }
+
+        // Mixed-rank kernels padded into one history match HistoryState
+        std::vector<double> alphas(num_points);
+        std::vector<std::complex<double>> second(num_points);
+        std::vector<HistoryState> reference;
+        for (int i = 0; i < num_points; ++i) {
+            alphas[i] = 1.1 + 0.8 * i / (num_points - 1);
+            second[i] = std::complex<double>(std::sin(0.3 * i), 0.1 * i);
+            reference.emplace_back(fitted.getKernel(alphas[i]).rank);
+        }
+        fitted.setPointAlphas(alphas);
+        std::vector<std::complex<double>> derivs;
+        for (int step = 0; step < 20; ++step) {
+            fitted.updateHistoryAndDerivatives(second, config.dt, derivs);
+            for (int i = 0; i < num_points; ++i) {
+                reference[i].update(fitted.getKernel(alphas[i]), second[i], config.dt);
+            }
+        }
+        for (int i = 0; i < num_points; ++i) {
+            if (std::abs(derivs[i] - reference[i].computeDerivative()) >
+                1e-12 * std::abs(reference[i].computeDerivative())) {
+                std::cout << "FAILED: Padded history differs at point " << i << std::endl;
+                ok = false;
+                break;
+            }
+        }
+
+        // History memory follows the fitted rank
+        FractionalSolverConfig fixed_config = config;
+        fixed_config.soe_tolerance = 0.0;
+        FractionalSolver fixed(fixed_config, num_points);
+        const size_t saved = static_cast<size_t>(num_points) *
+            (config.soe_rank - reloaded.getHistoryRank()) * 2 * sizeof(double);
+        if (fixed.getMemoryUsage() - reloaded.getMemoryUsage() != saved) {
+            std::cout << "FAILED: History not sized by the fitted rank" << std::endl;
+            ok = false;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "FAILED: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(cache_file.c_str());
+
+    if (ok) {
+        std::cout << "✓ Fitted kernels meet tolerance at reduced rank and reload from cache" << std::endl;
+    }
+    return ok;
+}
+
 // Main test runner
+// Test 14: Batched template bank matches members run alone
+bool test_template_bank() {
+    std::cout << "\n=== Test 14: Waveform Template Bank ===" << std::endl;
+
+    TemplateBankConfig config;
+    config.field.nx = 12;
+    config.field.ny = 12;
+    config.field.nz = 8;
+    config.field.dx = config.field.dy = config.field.dz = 2000.0;
+    config.field.dt = 0.001;
+    config.solver.T_max = 0.1;
+    config.solver.soe_rank = 6;
+    config.solver.alpha_table_size = 2;   // Exactly the two member α values
+    config.merger.center = Vector3D(12000.0, 12000.0, 8000.0);
+    config.merger.initial_separation = 6000.0;
+    config.merger.gaussian_width = 3000.0;
+    config.observers = {Vector3D(4000.0, 12000.0, 8000.0), Vector3D(18000.0, 6000.0, 6000.0)};
+    config.num_steps = 24;
+    config.sample_interval = 4;
+    config.threads_per_member = 2;
+    config.concurrent_members = 2;
+
+    std::vector<TemplateParameters> members;
+    for (double alpha : {1.2, 1.8}) {
+        for (double mass : {20.0, 35.0}) {
+            members.push_back(TemplateParameters(mass, 0.8 * mass, alpha, 0.001));
+        }
+    }
+
+    bool ok = true;
+    const std::string bank_file = "test_template_bank.bin";
+    try {
+        TemplateBank bank(config, members);
+        bank.generate();
+        const auto& strains = bank.getStrains();
+        const size_t per_member = static_cast<size_t>(bank.getObserverCount()) * bank.getSampleCount() * 2;
+        if (bank.getSampleCount() != 6 || strains.size() != per_member * members.size()) {
+            std::cout << "FAILED: Strain array shape" << std::endl;
+            ok = false;
+        }
+
+        // Concurrent members give the same bits as each member alone
+        bool same = true;
+        bool distinct = true;
+        for (int m = 0; ok && m < bank.getMemberCount(); m++) {
+            const std::vector<double> alone = bank.generateMember(m);
+            same = same && std::equal(alone.begin(), alone.end(), strains.begin() + per_member * m);
+            if (m > 0) {
+                distinct = distinct && !std::equal(alone.begin(), alone.end(), strains.begin() + per_member * (m - 1));
+            }
+        }
+        double peak = 0.0;
+        for (double h : strains) peak = std::max(peak, std::abs(h));
+        if (!same || !distinct || peak == 0.0) {
+            std::cout << "FAILED: Bank members differ from solo runs or are empty" << std::endl;
+            ok = false;
+        }
+
+        bank.write(bank_file);
+        std::FILE* f = std::fopen(bank_file.c_str(), "rb");
+        unsigned char header[64] = {};
+        std::vector<double> table(members.size() * 4), data(strains.size());
+        const bool read = f && std::fread(header, 1, 64, f) == 64 &&
+                          std::fread(table.data(), sizeof(double), table.size(), f) == table.size() &&
+                          std::fread(data.data(), sizeof(double), data.size(), f) == data.size() &&
+                          std::fgetc(f) == EOF;
+        if (f) std::fclose(f);
+        int32_t dims[3] = {};
+        std::memcpy(dims, header + 16, sizeof(dims));
+        if (!read || std::memcmp(header, "IGSOATB1", 8) != 0 || dims[0] != 4 || dims[1] != 2 || dims[2] != 6 ||
+            table[2] != 1.2 || table[14] != 1.8 || data != strains) {
+            std::cout << "FAILED: Bank file round trip" << std::endl;
+            ok = false;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "FAILED: " << e.what() << std::endl;
+        ok = false;
+    }
+    std::remove(bank_file.c_str());
+
+    if (ok) {
+        std::cout << "✓ Template bank matches solo runs and round-trips" << std::endl;
+    }
+    return ok;
+}
+
+// Test 15: Field-wide projections match the point-by-point operators
+bool test_projection_fields() {
+    std::cout << "\n=== Test 15: Field-wide Projections ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 7;
+    config.ny = 5;
+    config.nz = 6;
+    config.dx = 1.0;
+    config.dy = 0.5;
+    config.dz = 2.0;
+    SymmetryField field(config);
+    for (int idx = 0; idx < field.getTotalPoints(); idx++) {
+        int i, j, k;
+        field.fromFlatIndex(idx, i, j, k);
+        // Zero at one point to reach the |δΦ|² cutoff of B_μ
+        const double scale = (idx == 11) ? 0.0 : 1.0;
+        field.setDeltaPhi(i, j, k, scale * std::complex<double>(std::sin(0.7 * i + 0.2 * k) * std::cos(0.4 * j),
+                                                                0.3 * std::cos(0.5 * k - 0.3 * i)));
+    }
+    field.updateGradientCache();
+    field.updatePotentialCache();
+
+    ProjectionConfig proj_config;
+    ProjectionOperators projector(proj_config);
+    ProjectionOperators::ProjectionFields all;
+    projector.compute_projection_fields(field,
+        ProjectionOperators::FIELD_O_ALL | ProjectionOperators::FIELD_B_ALL | ProjectionOperators::FIELD_STRAIN, all);
+
+    const auto close = [](double a, double b) { return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(b)); };
+    bool ok = true;
+    for (int idx = 0; idx < field.getTotalPoints() && ok; idx++) {
+        int i, j, k;
+        field.fromFlatIndex(idx, i, j, k);
+        const Tensor4x4 O = projector.compute_stress_energy_tensor(field, i, j, k);
+        const auto B = projector.compute_causal_flow(field, i, j, k);
+        const auto strain = projector.compute_strain(O, proj_config.detector_normal);
+        ok = close(all.O00[idx], O(0, 0)) && close(all.O11[idx], O(1, 1)) && close(all.O22[idx], O(2, 2)) &&
+             close(all.O33[idx], O(3, 3)) && close(all.O12[idx], O(1, 2)) && close(all.O13[idx], O(1, 3)) &&
+             close(all.O23[idx], O(2, 3)) && close(all.B1[idx], B.B1) && close(all.B2[idx], B.B2) &&
+             close(all.B3[idx], B.B3) && close(all.B_magnitude[idx], B.magnitude) &&
+             close(all.h_plus[idx], strain.h_plus) && close(all.h_cross[idx], strain.h_cross);
+        if (!ok) {
+            std::cout << "FAILED: Field projection differs at point (" << i << ", " << j << ", " << k << ")"
+                      << std::endl;
+        }
+    }
+
+    // Only the requested arrays are filled
+    ProjectionOperators::ProjectionFields energy_only = all;
+    projector.compute_projection_fields(field, ProjectionOperators::FIELD_O00, energy_only);
+    if (energy_only.O00 != all.O00 || !energy_only.O11.empty() || !energy_only.B1.empty() ||
+        !energy_only.h_plus.empty() || energy_only.components != ProjectionOperators::FIELD_O00) {
+        std::cout << "FAILED: Single-component request filled other arrays" << std::endl;
+        ok = false;
+    }
+
+    SymmetryFieldConfig flat = config;
+    flat.nz = 1;
+    SymmetryField thin(flat);
+    bool threw = false;
+    try {
+        projector.compute_projection_fields(thin, ProjectionOperators::FIELD_O00, energy_only);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cout << "FAILED: Single-plane grid not rejected" << std::endl;
+        ok = false;
+    }
+
+    if (ok) {
+        std::cout << "✓ Field-wide O_μν, B_μ and strain match the point operators" << std::endl;
+    }
+    return ok;
+}
+
+// Test 16: Binned source catalog matches its binaries summed
+bool test_source_catalog() {
+    std::cout << "\n=== Test 16: Binned Source Catalog ===" << std::endl;
+
+    SymmetryFieldConfig config;
+    config.nx = 48;
+    config.ny = 32;
+    config.nz = 24;
+    config.dx = 1.0;
+    config.dy = 1.0;
+    config.dz = 1.0;
+    SymmetryField field(config);
+    const int total = field.getTotalPoints();
+
+    // A dozen binaries of assorted widths and masses; some orbit partly or
+    // wholly off the grid, two carry their own cutoff
+    std::vector<BinaryMergerConfig> configs;
+    for (int b = 0; b < 12; b++) {
+        BinaryMergerConfig merger_config;
+        merger_config.mass1 = 20.0 + 3.0 * b;
+        merger_config.mass2 = 15.0 + 2.0 * (b % 5);
+        merger_config.initial_separation = 3.0 + (b % 4);
+        merger_config.initial_orbital_phase = 0.5 * b;
+        merger_config.center = Vector3D(-4.0 + 4.5 * b, 3.0 + 2.5 * (b % 7), 2.0 + 2.0 * (b % 9));
+        merger_config.gaussian_width = 0.6 + 0.1 * (b % 3);
+        merger_config.source_amplitude = 1.0 + 0.25 * b;
+        merger_config.source_cutoff_sigmas = (b % 5 == 0) ? 3.0 : 0.0;
+        configs.push_back(merger_config);
+    }
+
+    for (int tile : {8, 5}) {
+        SourceCatalogConfig catalog_config;
+        catalog_config.cutoff_sigmas = 4.0;
+        catalog_config.tile_size = tile;
+        SourceCatalog catalog(catalog_config);
+
+        // Reference: each binary on its own with the catalog's truncation
+        std::vector<BinaryMerger> alone;
+        for (const BinaryMergerConfig& merger_config : configs) {
+            catalog.addBinary(merger_config);
+            BinaryMergerConfig truncated = merger_config;
+            if (truncated.source_cutoff_sigmas <= 0.0) {
+                truncated.source_cutoff_sigmas = catalog_config.cutoff_sigmas;
+            }
+            alone.emplace_back(truncated);
+        }
+
+        const double dt = 2e-9;
+        for (int step = 0; step < 6; step++) {
+            std::vector<std::complex<double>> reference(total);
+            for (BinaryMerger& merger : alone) {
+                const std::vector<std::complex<double>>& part = merger.updateSourceTerms(field, 0.0);
+                for (int idx = 0; idx < total; idx++) {
+                    reference[idx] += part[idx];
+                }
+            }
+            const std::vector<std::complex<double>>& binned = catalog.updateSourceTerms(field, 0.0);
+
+            double max_error = 0.0;
+            double max_value = 0.0;
+            for (int idx = 0; idx < total; idx++) {
+                max_error = std::max(max_error, std::abs(binned[idx] - reference[idx]));
+                max_value = std::max(max_value, std::abs(reference[idx]));
+            }
+            if (max_value <= 0.0 || max_error > 1e-12 * max_value) {
+                std::cout << "FAILED: Catalog mismatch " << max_error << " (tile " << tile
+                          << ", step " << step << ")" << std::endl;
+                return false;
+            }
+
+            // Only overlapping source-point pairs are evaluated
+            const uint64_t naive = static_cast<uint64_t>(catalog.getActiveSourceCount()) * total;
+            if (catalog.getLastPairCount() == 0 || catalog.getLastPairCount() * 20 > naive) {
+                std::cout << "FAILED: Catalog evaluated " << catalog.getLastPairCount()
+                          << " pairs of " << naive << std::endl;
+                return false;
+            }
+
+            for (BinaryMerger& merger : alone) {
+                merger.evolveOrbit(dt);
+            }
+            catalog.evolveOrbits(dt);
+        }
+    }
+
+    std::cout << "✓ Binned catalog matches the binaries summed, evaluating only overlapping pairs" << std::endl;
+    return true;
+}
+
 int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "IGSOA GW Engine - Basic Functionality Tests" << std::endl;
     std::cout << "========================================" << std::endl;
 
     int passed = 0;
-    int total = 7;
+    int total = 16;
 
     if (test_symmetry_field_basic()) {
         passed++;
@@ -442,6 +1336,69 @@ int main() {
         std::cout << "✗ Test 7 FAILED" << std::endl;
     }
 
+    if (test_evolve_step_caches()) {
+        passed++;
+        std::cout << "✓ Test 8 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 8 FAILED" << std::endl;
+    }
+
+    if (test_truncated_sources()) {
+        passed++;
+        std::cout << "✓ Test 9 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 9 FAILED" << std::endl;
+    }
+
+    if (test_field_snapshot()) {
+        passed++;
+        std::cout << "✓ Test 10 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 10 FAILED" << std::endl;
+    }
+
+    if (test_registered_observers()) {
+        passed++;
+        std::cout << "✓ Test 11 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 11 FAILED" << std::endl;
+    }
+
+    if (test_mittag_leffler_table()) {
+        passed++;
+        std::cout << "✓ Test 12 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 12 FAILED" << std::endl;
+    }
+
+    if (test_fitted_soe_kernels()) {
+        passed++;
+        std::cout << "✓ Test 13 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 13 FAILED" << std::endl;
+    }
+
+    if (test_template_bank()) {
+        passed++;
+        std::cout << "✓ Test 14 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 14 FAILED" << std::endl;
+    }
+
+    if (test_projection_fields()) {
+        passed++;
+        std::cout << "✓ Test 15 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 15 FAILED" << std::endl;
+    }
+
+    if (test_source_catalog()) {
+        passed++;
+        std::cout << "✓ Test 16 PASSED" << std::endl;
+    } else {
+        std::cout << "✗ Test 16 FAILED" << std::endl;
+    }
+
     std::cout << "\n========================================" << std::endl;
     std::cout << "Results: " << passed << "/" << total << " tests passed" << std::endl;
     std::cout << "========================================" << std::endl;
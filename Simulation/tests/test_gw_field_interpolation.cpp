@@ -0,0 +1,167 @@
+/**
+ * IGSOA GW Engine - Batched Field Interpolation Test
+ *
+ * SymmetryField::getDeltaPhiAt / getAlphaAt over position arrays must be
+ * bit-identical to the single-point calls (to 1e-12 under -ffast-math,
+ * which lets the vectorized pass round differently) inside the grid, on
+ * its edges, outside it and at NaN, with and without prefetch, for
+ * batches that run in parallel and on a field with an origin and a
+ * k_offset.  Also prints the per-point cost of both paths.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -I. -Isrc/cpp tests/test_gw_field_interpolation.cpp src/cpp/igsoa_gw_engine/core/symmetry_field.cpp src/cpp/igsoa_gw_engine/core/slab_decomposition.cpp src/cpp/igsoa_gw_engine/core/field_snapshot.cpp src/cpp/utils/logger.cpp
+ */
+
+#include "../src/cpp/igsoa_gw_engine/core/symmetry_field.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa::gw;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+void fill(SymmetryField& field) {
+    std::vector<int> indices(field.getTotalPoints());
+    std::vector<std::complex<double>> values(indices.size());
+    for (int idx = 0; idx < field.getTotalPoints(); idx++) {
+        int i, j, k;
+        field.fromFlatIndex(idx, i, j, k);
+        indices[idx] = idx;
+        values[idx] = std::complex<double>(std::sin(0.37 * i + 0.11 * j * k), std::cos(0.23 * j - 0.41 * k));
+        field.setAlpha(i, j, k, 1.0 + 0.5 * (1.0 + std::sin(0.3 * i + 0.7 * j + 0.2 * k)));
+    }
+    field.assignDeltaPhi(indices, values.data());
+}
+
+void checkBatch(const SymmetryField& field, size_t count, bool prefetch, const std::string& label) {
+    const SymmetryFieldConfig& config = field.getConfig();
+    const double span[3] = {config.nx * config.dx, config.ny * config.dy, config.nz * config.dz};
+    const double origin[3] = {config.origin_x, config.origin_y, config.origin_z + config.k_offset * config.dz};
+    std::mt19937_64 rng(count);
+    std::uniform_real_distribution<double> unit(-0.1, 1.1);   // Some points fall outside
+
+    std::vector<double> x(count);
+    std::vector<double> y(count);
+    std::vector<double> z(count);
+    for (size_t n = 0; n < count; n++) {
+        x[n] = origin[0] + unit(rng) * span[0];
+        y[n] = origin[1] + unit(rng) * span[1];
+        z[n] = origin[2] + unit(rng) * span[2];
+    }
+    // Grid vertices, the last vertex on each axis (outside: no upper cell) and NaN
+    if (count >= 4) {
+        const Vector3D vertex = field.toPosition(1, 2, 3);
+        x[0] = vertex.x; y[0] = vertex.y; z[0] = vertex.z;
+        const Vector3D last = field.toPosition(config.nx - 1, 1, 1);
+        x[1] = last.x; y[1] = last.y; z[1] = last.z;
+        const Vector3D corner = field.toPosition(0, 0, 0);
+        x[2] = corner.x; y[2] = corner.y; z[2] = corner.z;
+        x[3] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    std::vector<std::complex<double>> phi(count);
+    std::vector<double> alpha(count);
+    field.getDeltaPhiAt(x.data(), y.data(), z.data(), count, phi.data(), prefetch);
+    field.getAlphaAt(x.data(), y.data(), z.data(), count, alpha.data(), prefetch);
+
+    bool identical = true;
+    size_t inside = 0;
+    for (size_t n = 0; n < count; n++) {
+        if (n == 3 && count >= 4) {
+            identical = identical && phi[n] == std::complex<double>(0.0, 0.0) && alpha[n] == config.alpha_max;
+            continue;
+        }
+        const Vector3D pos(x[n], y[n], z[n]);
+        const std::complex<double> expected = field.getDeltaPhiAt(pos);
+#ifdef __FAST_MATH__
+        const bool same = std::abs(phi[n] - expected) <= 1e-12 &&
+                          std::fabs(alpha[n] - field.getAlphaAt(pos)) <= 1e-12;
+#else
+        const bool same = sameBits(phi[n].real(), expected.real()) &&
+                          sameBits(phi[n].imag(), expected.imag()) && sameBits(alpha[n], field.getAlphaAt(pos));
+#endif
+        identical = identical && same;
+        inside += phi[n] != std::complex<double>(0.0, 0.0) ? 1 : 0;
+    }
+    expect(identical, "batch matches single-point calls (" + label + ")");
+    expect(inside > count / 4, "most points land inside the grid (" + label + ")");
+}
+
+void timeBatch(const SymmetryField& field, size_t count) {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<double> x(count);
+    std::vector<double> y(count);
+    std::vector<double> z(count);
+    for (size_t n = 0; n < count; n++) {
+        x[n] = unit(rng) * (field.getNx() - 1) * field.getDx();
+        y[n] = unit(rng) * (field.getNy() - 1) * field.getDy();
+        z[n] = unit(rng) * (field.getNz() - 1) * field.getDz();
+    }
+    std::vector<std::complex<double>> out(count);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t n = 0; n < count; n++) {
+        out[n] = field.getDeltaPhiAt(Vector3D(x[n], y[n], z[n]));
+    }
+    const double single_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    field.getDeltaPhiAt(x.data(), y.data(), z.data(), count, out.data());
+    const double batch_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << count << " points: single " << single_ns / count << " ns/point, batch "
+              << batch_ns / count << " ns/point" << std::endl;
+}
+
+} // namespace
+
+int main() {
+    SymmetryFieldConfig config;
+    config.nx = 23;
+    config.ny = 17;
+    config.nz = 19;
+    config.dx = 0.5;
+    config.dy = 0.75;
+    config.dz = 0.6;
+    config.dt = 0.01;
+    SymmetryField field(config);
+    fill(field);
+    checkBatch(field, 1, false, "one point");
+    checkBatch(field, 101, false, "partial block");
+    checkBatch(field, 101, true, "prefetch");
+    checkBatch(field, 50000, false, "parallel");
+
+    // Offset patch (origin) on a slab (k_offset)
+    config.origin_x = -3.25;
+    config.origin_y = 2.0;
+    config.origin_z = 1.5;
+    config.k_offset = 4;
+    SymmetryField offset(config);
+    fill(offset);
+    checkBatch(offset, 5000, true, "origin and k_offset");
+
+    timeBatch(field, 1000000);
+
+    if (failures != 0) {
+        std::cerr << "test_gw_field_interpolation: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_gw_field_interpolation: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,316 @@
+/**
+ * IGSOA GW Engine - Mesh Refinement Test
+ *
+ * Prolongation and restriction must reproduce linear fields and preserve
+ * Σ δΦ dV of data inside a patch.  Patches must contain their tagged points
+ * with the margin and follow them on regrid, keeping the overlap (δΦ and
+ * history).  A subcycled step must leave the base equal to the restriction
+ * of the patch, the patch clock on the base clock, and a source-free zero
+ * field at zero.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -I. -Isrc/cpp tests/test_gw_mesh_refinement.cpp src/cpp/igsoa_gw_engine/core/mesh_refinement.cpp src/cpp/igsoa_gw_engine/core/symmetry_field.cpp src/cpp/igsoa_gw_engine/core/fractional_solver.cpp src/cpp/igsoa_gw_engine/core/soe_kernel_cache.cpp src/cpp/igsoa_gw_engine/core/slab_decomposition.cpp src/cpp/igsoa_gw_engine/core/field_snapshot.cpp src/cpp/utils/logger.cpp
+ */
+
+#include "../src/cpp/igsoa_gw_engine/core/mesh_refinement.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa::gw;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+SymmetryFieldConfig baseConfig(int n) {
+    SymmetryFieldConfig config;
+    config.nx = config.ny = config.nz = n;
+    config.dx = config.dy = config.dz = 1.0;
+    config.dt = 0.01;
+    return config;
+}
+
+FractionalSolverConfig solverConfig() {
+    FractionalSolverConfig config;
+    config.dt = 0.01;
+    config.soe_rank = 4;
+    return config;
+}
+
+void fillLinear(SymmetryField& field) {
+    std::vector<int> indices(field.getTotalPoints());
+    std::vector<std::complex<double>> values(indices.size());
+    for (int idx = 0; idx < field.getTotalPoints(); idx++) {
+        int i, j, k;
+        field.fromFlatIndex(idx, i, j, k);
+        const Vector3D p = field.toPosition(i, j, k);
+        indices[idx] = idx;
+        values[idx] = std::complex<double>(1.0 + 0.5 * p.x - 0.25 * p.y + 0.125 * p.z, p.x - p.z);
+    }
+    field.assignDeltaPhi(indices, values.data());
+}
+
+// A box around the centre of an n³ parent
+RefinementBox centredBox(int lo, int hi) {
+    RefinementBox box;
+    for (int axis = 0; axis < 3; axis++) {
+        box.lo[axis] = lo;
+        box.hi[axis] = hi;
+    }
+    return box;
+}
+
+// Patch of `parent` at `box`, filled by prolongation
+SymmetryFieldConfig patchConfig(const SymmetryField& parent, const RefinementBox& box, int r) {
+    SymmetryFieldConfig config = parent.getConfig();
+    config.nx = r * (box.hi[0] - box.lo[0]) + 1;
+    config.ny = r * (box.hi[1] - box.lo[1]) + 1;
+    config.nz = r * (box.hi[2] - box.lo[2]) + 1;
+    config.dx /= r;
+    config.dy /= r;
+    config.dz /= r;
+    config.dt /= r;
+    const Vector3D origin = parent.toPosition(box.lo[0], box.lo[1], box.lo[2]);
+    config.origin_x = origin.x;
+    config.origin_y = origin.y;
+    config.origin_z = origin.z;
+    return config;
+}
+
+void prolong(const SymmetryField& parent, const RefinementBox& box, int r, SymmetryField& patch) {
+    const auto& phi = parent.getDeltaPhiFlat();
+    std::vector<int> indices(patch.getTotalPoints());
+    std::vector<std::complex<double>> values(indices.size());
+    int taps[8];
+    double weights[8];
+    for (int idx = 0; idx < patch.getTotalPoints(); idx++) {
+        int a, b, c;
+        patch.fromFlatIndex(idx, a, b, c);
+        MeshHierarchy::parentStencil(parent, box, r, a, b, c, taps, weights);
+        std::complex<double> value(0.0, 0.0);
+        for (int n = 0; n < 8; n++) {
+            value += weights[n] * phi[taps[n]];
+        }
+        indices[idx] = idx;
+        values[idx] = value;
+    }
+    patch.assignDeltaPhi(indices, values.data());
+}
+
+std::complex<double> integral(const SymmetryField& field) {
+    std::complex<double> sum(0.0, 0.0);
+    for (const auto& value : field.getDeltaPhiFlat()) {
+        sum += value;
+    }
+    return sum * (field.getDx() * field.getDy() * field.getDz());
+}
+
+void testLinearTransfers() {
+    for (int r : {2, 3}) {
+        SymmetryField parent(baseConfig(12));
+        fillLinear(parent);
+        const RefinementBox box = centredBox(3, 8);
+        SymmetryField patch(patchConfig(parent, box, r));
+        prolong(parent, box, r, patch);
+
+        SymmetryField exact(patchConfig(parent, box, r));
+        fillLinear(exact);
+        double max_error = 0.0;
+        for (int idx = 0; idx < patch.getTotalPoints(); idx++) {
+            max_error = std::max(max_error, std::abs(patch.getDeltaPhiFlat()[idx] - exact.getDeltaPhiFlat()[idx]));
+        }
+        expect(max_error < 1e-12, "prolongation reproduces a linear field (r = " + std::to_string(r) + ")");
+
+        std::vector<int> indices;
+        std::vector<std::complex<double>> values;
+        MeshHierarchy::restrictInto(exact, parent, box, r, indices, values);
+        expect(indices.size() == 4 * 4 * 4, "restriction covers the parent vertices inside the box");
+        max_error = 0.0;
+        for (size_t n = 0; n < indices.size(); n++) {
+            max_error = std::max(max_error, std::abs(values[n] - parent.getDeltaPhiFlat()[indices[n]]));
+        }
+        expect(max_error < 1e-12, "restriction reproduces a linear field (r = " + std::to_string(r) + ")");
+    }
+}
+
+void testConservation() {
+    const int r = 2;
+    const RefinementBox box = centredBox(2, 13);
+
+    // Prolongation: a parent blob inside the box keeps Σ δΦ dV
+    SymmetryField parent(baseConfig(16));
+    std::vector<int> indices;
+    std::vector<std::complex<double>> values;
+    for (int idx = 0; idx < parent.getTotalPoints(); idx++) {
+        int i, j, k;
+        parent.fromFlatIndex(idx, i, j, k);
+        if (i >= 5 && i <= 10 && j >= 5 && j <= 10 && k >= 5 && k <= 10) {
+            indices.push_back(idx);
+            values.push_back(std::complex<double>(std::exp(-0.3 * ((i - 7.5) * (i - 7.5) + (j - 8) * (j - 8))), 0.1 * k));
+        }
+    }
+    parent.assignDeltaPhi(indices, values.data());
+    SymmetryField patch(patchConfig(parent, box, r));
+    prolong(parent, box, r, patch);
+    expect(std::abs(integral(patch) - integral(parent)) < 1e-10 * std::abs(integral(parent)),
+           "prolongation preserves the integral");
+
+    // Restriction: a fine blob inside the box keeps Σ δΦ dV
+    SymmetryField fine(patchConfig(parent, box, r));
+    indices.clear();
+    values.clear();
+    for (int idx = 0; idx < fine.getTotalPoints(); idx++) {
+        int a, b, c;
+        fine.fromFlatIndex(idx, a, b, c);
+        if (a >= 6 && a <= 15 && b >= 7 && b <= 16 && c >= 5 && c <= 17) {
+            indices.push_back(idx);
+            values.push_back(std::complex<double>(std::sin(0.7 * a + 0.3 * b) + 1.5, std::cos(0.2 * c)));
+        }
+    }
+    fine.assignDeltaPhi(indices, values.data());
+    SymmetryField coarse(baseConfig(16));
+    indices.clear();
+    values.clear();
+    MeshHierarchy::restrictInto(fine, coarse, box, r, indices, values);
+    coarse.assignDeltaPhi(indices, values.data());
+    expect(std::abs(integral(coarse) - integral(fine)) < 1e-10 * std::abs(integral(fine)),
+           "restriction preserves the integral");
+}
+
+bool contains(const SymmetryField& parent, const RefinementBox& box, const Vector3D& tag, double margin) {
+    const double u[3] = {tag.x / parent.getDx(), tag.y / parent.getDy(), tag.z / parent.getDz()};
+    for (int axis = 0; axis < 3; axis++) {
+        if (u[axis] < box.lo[axis] + margin || u[axis] > box.hi[axis] - margin) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testFollowsSources() {
+    SymmetryField base(baseConfig(32));
+    FractionalSolver solver(solverConfig(), base.getTotalPoints());
+    solver.setPointAlphas(base.getAlphaFlat());
+
+    MeshRefinementConfig config;
+    config.levels = 2;
+    MeshHierarchy hierarchy(base, config);
+    std::vector<Vector3D> tags = {Vector3D(10.2, 12.0, 15.5), Vector3D(13.0, 12.5, 16.0)};
+    hierarchy.regrid(base, solver, tags);
+    expect(hierarchy.getNumLevels() == 2, "two refined levels");
+    expect(contains(base, hierarchy.getLevelBox(1), tags[0], config.margin - 1) &&
+           contains(base, hierarchy.getLevelBox(1), tags[1], config.margin - 1),
+           "level 1 holds both sources with the margin");
+    const SymmetryField& level1 = hierarchy.getLevelField(1);
+    const SymmetryField& level2 = hierarchy.getLevelField(2);
+    expect(std::fabs(level1.getDx() - 0.5) < 1e-15 && std::fabs(level2.getDx() - 0.25) < 1e-15,
+           "spacing halves per level");
+    expect(std::fabs(level2.getTimestep() - 0.0025) < 1e-15, "timestep halves per level");
+    expect(!hierarchy.regridIfNeeded(base, solver, tags), "no regrid while the sources stay put");
+
+    // Mark a level-1 point shared by the old and new patch, then move the sources
+    const Vector3D marked(12.0, 12.0, 16.0);
+    int i, j, k;
+    level1.toIndices(marked, i, j, k);
+    const_cast<SymmetryField&>(level1).setDeltaPhi(i, j, k, std::complex<double>(3.0, -1.0));
+    std::vector<Vector3D> moved = {Vector3D(8.0, 12.0, 15.5), Vector3D(11.0, 12.5, 16.0)};
+    expect(hierarchy.regridIfNeeded(base, solver, moved), "regrid once a source nears the edge");
+    expect(hierarchy.getRegridCount() == 2, "regrid counted");
+    expect(contains(base, hierarchy.getLevelBox(1), moved[0], config.margin - 1), "the patch follows the source");
+    expect(std::abs(hierarchy.getLevelField(1).getDeltaPhiAt(marked) - std::complex<double>(3.0, -1.0)) < 1e-15,
+           "overlap kept on regrid");
+    expect(hierarchy.getLevelSolver(1).getHistoryRank() == solver.getHistoryRank(), "per-level history shares the rank");
+}
+
+void testSubcycledStep() {
+    SymmetryField base(baseConfig(20));
+    FractionalSolver solver(solverConfig(), base.getTotalPoints());
+    solver.setPointAlphas(base.getAlphaFlat());
+    std::vector<std::complex<double>> frac(base.getTotalPoints());
+    std::vector<std::complex<double>> zero(base.getTotalPoints());
+    std::vector<std::complex<double>> sources(base.getTotalPoints());
+
+    MeshRefinementConfig config;
+    config.levels = 2;
+    MeshHierarchy hierarchy(base, config);
+    const std::vector<Vector3D> tags = {Vector3D(9.0, 9.5, 10.0)};
+    hierarchy.regrid(base, solver, tags);
+
+    // Gaussian source at the tag, on every grid
+    auto gaussian = [&tags](const SymmetryField& field, double, std::vector<std::complex<double>>& out) {
+        out.assign(field.getTotalPoints(), std::complex<double>(0.0, 0.0));
+        for (int idx = 0; idx < field.getTotalPoints(); idx++) {
+            int i, j, k;
+            field.fromFlatIndex(idx, i, j, k);
+            const Vector3D d = field.toPosition(i, j, k) - tags[0];
+            out[idx] = std::complex<double>(std::exp(-d.dot(d)), 0.0);
+        }
+    };
+
+    // Zero sources keep the zero field
+    for (int step = 0; step < 3; step++) {
+        hierarchy.beginStep(base);
+        solver.computeDerivatives(frac);
+        base.evolveStep(frac, zero);
+        hierarchy.endStep(base, [](const SymmetryField& field, double, std::vector<std::complex<double>>& out) {
+            out.assign(field.getTotalPoints(), std::complex<double>(0.0, 0.0));
+        });
+    }
+    double max_abs = 0.0;
+    for (const auto& value : hierarchy.getLevelField(2).getDeltaPhiFlat()) {
+        max_abs = std::max(max_abs, std::abs(value));
+    }
+    expect(max_abs == 0.0, "source-free zero field stays zero");
+
+    for (int step = 0; step < 4; step++) {
+        const double t = base.getCurrentTime();
+        gaussian(base, t, sources);
+        hierarchy.beginStep(base);
+        solver.computeDerivatives(frac);
+        base.evolveStep(frac, sources);
+        hierarchy.endStep(base, gaussian);
+    }
+    expect(std::fabs(hierarchy.getLevelField(1).getCurrentTime() - base.getCurrentTime()) < 1e-15 &&
+           std::fabs(hierarchy.getLevelField(2).getCurrentTime() - base.getCurrentTime()) < 1e-15,
+           "patch clocks follow the base");
+
+    std::vector<int> indices;
+    std::vector<std::complex<double>> values;
+    MeshHierarchy::restrictInto(hierarchy.getLevelField(1), base, hierarchy.getLevelBox(1), 2, indices, values);
+    double max_error = 0.0;
+    double peak = 0.0;
+    for (size_t n = 0; n < indices.size(); n++) {
+        max_error = std::max(max_error, std::abs(values[n] - base.getDeltaPhiFlat()[indices[n]]));
+        peak = std::max(peak, std::abs(values[n]));
+    }
+    expect(max_error == 0.0, "base holds the restricted patch");
+    expect(peak > 0.0 && std::isfinite(peak), "the source drives the patch");
+    expect(hierarchy.getPointUpdatesPerStep() ==
+           static_cast<uint64_t>(hierarchy.getLevelField(1).getTotalPoints()) * 2 +
+           static_cast<uint64_t>(hierarchy.getLevelField(2).getTotalPoints()) * 4,
+           "point updates count the substeps");
+}
+
+} // namespace
+
+int main() {
+    testLinearTransfers();
+    testConservation();
+    testFollowsSources();
+    testSubcycledStep();
+
+    if (failures != 0) {
+        std::cerr << "test_gw_mesh_refinement: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_gw_mesh_refinement: PASS" << std::endl;
+    return 0;
+}
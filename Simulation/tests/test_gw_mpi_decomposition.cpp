@@ -0,0 +1,153 @@
+/**
+ * IGSOA GW Engine - MPI Slab Decomposition Test
+ *
+ * Run with several ranks (e.g. mpirun -np 3).  Every rank also evolves the
+ * whole grid serially and checks that its owned planes of the distributed
+ * field match it exactly, including the Laplacian across slab boundaries,
+ * the gradient cache, sources and per-slab fractional history; global
+ * diagnostics must agree to round-off.
+ */
+
+#include "../src/cpp/igsoa_gw_engine/core/symmetry_field.h"
+#include "../src/cpp/igsoa_gw_engine/core/fractional_solver.h"
+#include "../src/cpp/igsoa_gw_engine/core/source_manager.h"
+#include "../src/cpp/igsoa_gw_engine/core/slab_decomposition.h"
+#include <mpi.h>
+#include <cmath>
+#include <iostream>
+
+using namespace dase::igsoa::gw;
+
+namespace {
+
+void initField(SymmetryField& field) {
+    for (int idx = 0; idx < field.getTotalPoints(); idx++) {
+        int i, j, k;
+        field.fromFlatIndex(idx, i, j, k);
+        Vector3D pos = field.toPosition(i, j, k);
+        field.setDeltaPhi(i, j, k, std::complex<double>(
+            0.1 * std::sin(0.7 * pos.x + 0.3 * pos.y - 0.5 * pos.z),
+            0.05 * std::cos(0.2 * pos.x * pos.z)));
+        field.setAlpha(i, j, k, 1.5 + 0.25 * std::sin(pos.x + pos.y + pos.z));
+    }
+    field.updateGradientCache();
+    field.updatePotentialCache();
+}
+
+struct GWStepper {
+    SymmetryField field;
+    FractionalSolver solver;
+    BinaryMerger merger;
+    std::vector<std::complex<double>> frac_derivs;
+
+    GWStepper(const SymmetryFieldConfig& field_config,
+              const FractionalSolverConfig& solver_config,
+              const BinaryMergerConfig& merger_config,
+              const SlabDecomposition* decomposition)
+        : field(field_config)
+        , solver(solver_config, field.getTotalPoints())
+        , merger(merger_config)
+    {
+        field.setDecomposition(decomposition);
+        initField(field);
+        solver.setPointAlphas(field.getAlphaFlat());
+        solver.computeDerivatives(frac_derivs);
+    }
+
+    void step() {
+        const auto& sources = merger.updateSourceTerms(field, field.getCurrentTime());
+        field.evolveStep(frac_derivs, sources);
+        // Synthetic point-local history drive
+        solver.updateHistoryAndDerivatives(field.getDeltaPhiFlat(), field.getTimestep(), frac_derivs);
+        merger.evolveOrbit(field.getTimestep());
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    bool ok = true;
+    int rank = 0;
+    int num_ranks = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+    try {
+        SymmetryFieldConfig global_config;
+        global_config.nx = 10;
+        global_config.ny = 9;
+        global_config.nz = 13;
+        global_config.dx = 1.0;
+        global_config.dy = 1.0;
+        global_config.dz = 1.0;
+        global_config.dt = 0.01;
+
+        FractionalSolverConfig solver_config;
+        solver_config.dt = global_config.dt;
+        solver_config.soe_rank = 6;
+
+        BinaryMergerConfig merger_config;
+        merger_config.initial_separation = 4.0;
+        merger_config.center = Vector3D(5.0, 4.5, 6.5);
+        merger_config.gaussian_width = 1.5;
+        merger_config.source_cutoff_sigmas = 4.0;
+
+        SlabDecomposition decomposition(global_config.nz, MPI_COMM_WORLD);
+        GWStepper distributed(decomposition.makeLocalConfig(global_config),
+                              solver_config, merger_config, &decomposition);
+        GWStepper reference(global_config, solver_config, merger_config, nullptr);
+
+        for (int step = 0; step < 8; step++) {
+            distributed.step();
+            reference.step();
+        }
+
+        const SymmetryField& local = distributed.field;
+        const int offset = decomposition.getLocalOffset();
+        for (int k = decomposition.getOwnedBegin(); k < decomposition.getOwnedEnd(); k++) {
+            for (int j = 0; j < global_config.ny; j++) {
+                for (int i = 0; i < global_config.nx; i++) {
+                    if (local.getDeltaPhi(i, j, k - offset) != reference.field.getDeltaPhi(i, j, k) ||
+                        local.getGradientMagnitude(i, j, k - offset) !=
+                            reference.field.getGradientMagnitude(i, j, k) ||
+                        local.getPotential(i, j, k - offset) != reference.field.getPotential(i, j, k)) {
+                        std::cerr << "Rank " << rank << ": mismatch at (" << i << ", " << j
+                                  << ", " << k << ")" << std::endl;
+                        ok = false;
+                    }
+                }
+            }
+        }
+
+        auto close = [](double a, double b) {
+            return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(b));
+        };
+        const auto local_stats = local.getStatistics();
+        const auto global_stats = reference.field.getStatistics();
+        if (!close(local.computeTotalEnergy(), reference.field.computeTotalEnergy()) ||
+            local.computeMaxAmplitude() != reference.field.computeMaxAmplitude() ||
+            !close(local_stats.mean_amplitude, global_stats.mean_amplitude) ||
+            !close(local_stats.mean_gradient, global_stats.mean_gradient) ||
+            !close(local_stats.total_energy, global_stats.total_energy) ||
+            local_stats.max_gradient != global_stats.max_gradient) {
+            std::cerr << "Rank " << rank << ": global diagnostics mismatch" << std::endl;
+            ok = false;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Rank " << rank << ": " << e.what() << std::endl;
+        ok = false;
+    }
+
+    int local_ok = ok ? 1 : 0;
+    int all_ok = 0;
+    MPI_Allreduce(&local_ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (rank == 0) {
+        std::cout << (all_ok ? "MPI slab decomposition test passed on "
+                             : "MPI slab decomposition test FAILED on ")
+                  << num_ranks << " ranks" << std::endl;
+    }
+
+    MPI_Finalize();
+    return all_ok ? 0 : 1;
+}
@@ -50,5 +50,34 @@ int main() {
     std::cout << "Initial center: (" << x0 << ", " << y0 << ")\n";
     std::cout << "Final center: (" << x1 << ", " << y1 << ")\n";
     std::cout << "Drift: " << drift << std::endl;
+
+    // Precomputed stencil coupling must reproduce the direct path exactly
+    // (scalar accumulation; the SIMD kernels only agree to round-off)
+    IGSOAComplexConfig direct_config = config;
+    direct_config.simd_coupling = false;
+    IGSOAComplexConfig stencil_config = direct_config;
+    stencil_config.coupling_mode = IGSOACouplingMode::Stencil;
+    IGSOAComplexEngine2D direct(direct_config, N_x, N_y);
+    IGSOAComplexEngine2D stencil(stencil_config, N_x, N_y);
+    for (auto* e : {&direct, &stencil}) {
+        IGSOAStateInit2D::initCircularGaussian(
+            *e, 1.0, 10.0, 20.0, 3.0, 0.0, "overwrite", 1.0);
+        e->runMission(5);
+    }
+    if (direct.getTotalOperations() != stencil.getTotalOperations()) {
+        std::cerr << "Stencil operation count mismatch" << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < N_x * N_y; ++i) {
+        if (direct.getNodes()[i].psi != stencil.getNodes()[i].psi) {
+            std::cerr << "Stencil coupling diverged at node " << i << std::endl;
+            return 1;
+        }
+    }
+    if (stencil.getMemoryUsage() <= direct.getMemoryUsage()) {
+        std::cerr << "Stencil memory not reported" << std::endl;
+        return 1;
+    }
+    std::cout << "Stencil coupling matches direct coupling" << std::endl;
     return 0;
 }
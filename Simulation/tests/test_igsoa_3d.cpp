@@ -1,5 +1,6 @@
 #include "../src/cpp/igsoa_complex_engine_3d.h"
 #include "../src/cpp/igsoa_state_init_3d.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -71,5 +72,31 @@ int main() {
     std::cout << "Initial center: (" << x0 << ", " << y0 << ", " << z0 << ")\n";
     std::cout << "Final center: (" << x1 << ", " << y1 << ", " << z1 << ")\n";
     std::cout << "Drift: " << drift << std::endl;
+
+    if (IGSOASpectralCoupling::isAvailable()) {
+        // FFT coupling (auto-selected for large R_c) must track the direct sum
+        IGSOAComplexConfig jacobi = config;
+        jacobi.R_c_default = 8.0;
+        jacobi.update_mode = IGSOAUpdateMode::DoubleBuffered;
+        IGSOAComplexConfig direct_config = jacobi;
+        direct_config.fft_min_R_c = 1.0e9;
+
+        IGSOAComplexEngine3D spectral(jacobi, N_x, N_y, N_z);
+        IGSOAComplexEngine3D direct(direct_config, N_x, N_y, N_z);
+        for (auto* e : {&spectral, &direct}) {
+            IGSOAStateInit3D::initSphericalGaussian(
+                *e, 1.0, 5.0, 8.0, 11.0, 2.5, 0.0, "overwrite", 1.0);
+            e->runMission(2);
+        }
+        double max_diff = 0.0;
+        for (size_t i = 0; i < N_x * N_y * N_z; ++i) {
+            max_diff = std::max(max_diff, std::abs(spectral.getNodes()[i].psi - direct.getNodes()[i].psi));
+        }
+        if (max_diff > 1e-10) {
+            std::cerr << "FFT coupling diverged from direct sum: " << max_diff << std::endl;
+            return 1;
+        }
+        std::cout << "FFT coupling max deviation: " << max_diff << std::endl;
+    }
     return 0;
 }
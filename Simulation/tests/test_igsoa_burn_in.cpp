@@ -0,0 +1,204 @@
+/**
+ * IGSOA coarse-to-fine burn-in test
+ *
+ * Restricting a smooth state and prolonging it back must reproduce it to
+ * interpolation accuracy (constants exactly), and a burn-in must advance
+ * the fine engine's clock by its steps, keep normalize_psi lattices
+ * normalized, land a smooth packet close to the full-resolution run in 2D
+ * and 3D (the cold start, left unevolved, is the yardstick: without the
+ * coarse coupling_gain the 3D error is ~0.7 of it), match the coarse gain
+ * to factor^(d-1) for a well-resolved R_c, and reject factors that do not
+ * fit the lattice or R_c.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_igsoa_burn_in.cpp
+ */
+
+#include "../src/cpp/igsoa_burn_in.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+IGSOAComplexConfig makeConfig(size_t nodes, bool normalize) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(nodes);
+    config.R_c_default = 4.0;
+    config.dt = 0.01;
+    config.normalize_psi = normalize;
+    config.update_mode = IGSOAUpdateMode::DoubleBuffered;
+    return config;
+}
+
+// Relative L2 distance of the Ψ fields
+template <typename Engine>
+double relativeError(const Engine& a, const Engine& b) {
+    double diff = 0.0;
+    double norm = 0.0;
+    for (size_t i = 0; i < a.getNodes().size(); ++i) {
+        diff += std::norm(a.getNodes()[i].psi - b.getNodes()[i].psi);
+        norm += std::norm(b.getNodes()[i].psi);
+    }
+    return std::sqrt(diff / std::max(norm, 1e-300));
+}
+
+void testTransfer() {
+    const double two_pi = 6.283185307179586;
+    for (uint32_t factor : {2u, 4u}) {
+        const size_t n_x = 64;
+        const size_t n_y = 48;
+        std::vector<IGSOAComplexNode> fine(n_x * n_y);
+        for (size_t y = 0; y < n_y; ++y) {
+            for (size_t x = 0; x < n_x; ++x) {
+                IGSOAComplexNode& node = fine[y * n_x + x];
+                node.psi = {std::sin(two_pi * x / n_x), std::cos(two_pi * y / n_y)};
+                node.phi = 0.25;
+                node.R_c = 4.0;
+            }
+        }
+        std::vector<IGSOAComplexNode> coarse(fine.size() / (factor * factor));
+        IGSOABurnIn::restrictState(fine, n_x, n_y, 1, factor, coarse);
+        expect(coarse[0].R_c == 4.0 / factor, "restriction scales R_c");
+        IGSOAComplexConfig wide = makeConfig(n_x * n_y, false);
+        wide.R_c_default = 16.0;
+        for (int dims : {2, 3}) {
+            const double gain = IGSOABurnIn::coarseConfig(wide, factor, coarse.size(), dims).coupling_gain;
+            const double continuum = std::pow(static_cast<double>(factor), dims - 1);
+            expect(std::abs(gain / continuum - 1.0) < 0.1,
+                   "coarse coupling gain near factor^(d-1) (" + std::to_string(gain) + ")");
+        }
+
+        std::vector<IGSOAComplexNode> back = fine;
+        IGSOABurnIn::prolongState(coarse, n_x, n_y, 1, factor, false, back);
+        double error = 0.0;
+        bool phi_exact = true;
+        for (size_t i = 0; i < fine.size(); ++i) {
+            error = std::max(error, std::abs(back[i].psi - fine[i].psi));
+            phi_exact = phi_exact && std::abs(back[i].phi - 0.25) < 1e-15;
+        }
+        const std::string label = "factor " + std::to_string(factor);
+        expect(phi_exact, label + ": constant field prolongs exactly");
+        expect(error < (factor == 2 ? 0.01 : 0.05), label + ": smooth field round-trips");
+        expect(back[5].R_c == 4.0, label + ": prolongation keeps the fine R_c");
+    }
+}
+
+void testClockAndNormalization() {
+    const size_t n = 32;
+    IGSOAComplexEngine2D engine(makeConfig(n * n, true), n, n);
+    IGSOAStateInit2D::initCircularGaussian(engine, 1.0, 16.0, 16.0, 5.0);
+    IGSOABurnInOptions options;
+    options.steps = 12;
+    options.factor = 2;
+    expect(engine.runBurnIn(options) == 12, "burn-in runs its steps");
+    expect(engine.getTotalSteps() == 12, "burn-in advances the step count");
+    expect(std::abs(engine.getCurrentTime() - 12 * 0.01) < 1e-12, "burn-in advances the clock");
+    bool normalized = true;
+    for (const auto& node : engine.getNodes()) {
+        normalized = normalized && std::abs(std::abs(node.psi) - 1.0) < 1e-12;
+    }
+    expect(normalized, "normalize_psi lattice stays normalized");
+    engine.runMission(5);
+    expect(engine.getTotalSteps() == 17, "mission continues after the burn-in");
+}
+
+void testTracks2D() {
+    // Measured errors: 0.0078 (factor 2) and 0.031 (factor 4, one coarse
+    // neighbour ring) against a cold-start error of 0.39
+    for (uint32_t factor : {2u, 4u}) {
+        const size_t n = 64;
+        IGSOAComplexEngine2D full(makeConfig(n * n, false), n, n);
+        IGSOAComplexEngine2D burned(makeConfig(n * n, false), n, n);
+        IGSOAComplexEngine2D initial(makeConfig(n * n, false), n, n);
+        for (IGSOAComplexEngine2D* engine : {&full, &burned, &initial}) {
+            IGSOAStateInit2D::initCircularGaussian(*engine, 1.0, 32.0, 32.0, 10.0);
+        }
+        IGSOABurnInOptions options;
+        options.steps = 100;
+        options.factor = factor;
+        full.runMission(options.steps);
+        burned.runBurnIn(options);
+        const double error = relativeError(burned, full);
+        const double tolerance = factor == 2 ? 0.02 : 0.06;
+        expect(error < tolerance && error < 0.2 * relativeError(initial, full),
+               "2D factor " + std::to_string(factor) + " burn-in tracks the full-resolution run (error " +
+               std::to_string(error) + ")");
+    }
+}
+
+void testTracks3D() {
+    const size_t n = 16;
+    IGSOAComplexEngine3D full(makeConfig(n * n * n, false), n, n, n);
+    IGSOAComplexEngine3D burned(makeConfig(n * n * n, false), n, n, n);
+    IGSOAComplexEngine3D initial(makeConfig(n * n * n, false), n, n, n);
+    for (IGSOAComplexEngine3D* engine : {&full, &burned, &initial}) {
+        IGSOAStateInit3D::initSphericalGaussian(*engine, 1.0, 8.0, 8.0, 8.0, 4.0);
+    }
+    IGSOABurnInOptions options;
+    options.steps = 10;
+    full.runMission(options.steps);
+    burned.runBurnIn(options);
+    expect(burned.getTotalSteps() == 10, "3D burn-in advances the step count");
+    // Measured: 0.079 against a cold-start error of 0.52 (0.38 without the gain)
+    const double error = relativeError(burned, full);
+    expect(error < 0.15 && error < 0.25 * relativeError(initial, full),
+           "3D burn-in tracks the full-resolution run (error " + std::to_string(error) + ")");
+}
+
+void testRejects() {
+    IGSOABurnInOptions options;
+    options.steps = 4;
+    std::string error;
+    options.factor = 3;
+    expect(!options.validate(makeConfig(36, false), 6, 6, 1, &error), "factor 3 rejected");
+    options.factor = 4;
+    expect(!options.validate(makeConfig(36, false), 6, 6, 1, &error), "indivisible lattice rejected");
+    IGSOAComplexConfig narrow = makeConfig(64, false);
+    narrow.R_c_default = 3.0;
+    expect(!options.validate(narrow, 8, 8, 1, &error), "R_c below one coarse spacing rejected");
+
+    IGSOAComplexEngine2D engine(makeConfig(30 * 30, false), 30, 30);
+    bool threw = false;
+    try {
+        engine.runBurnIn(options);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw && engine.getTotalSteps() == 0, "engine rejects an invalid burn-in untouched");
+}
+
+} // namespace
+
+int main() {
+    testTransfer();
+    testClockAndNormalization();
+    testTracks2D();
+    testTracks3D();
+    testRejects();
+
+    if (failures != 0) {
+        std::cerr << "test_igsoa_burn_in: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_igsoa_burn_in: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,196 @@
+/**
+ * IGSOA distributed 3D engine test
+ *
+ * IGSOADistributedEngine3D must track IGSOAComplexEngine3D (DoubleBuffered,
+ * Stencil coupling) on every rank's owned planes within 1e-12, for radii
+ * with and without a compile-time interior kernel, lattices whose slabs are
+ * thinner than 2·R_c (no overlapped planes) and driven missions.  Global
+ * energy and entropy rate must match the serial engine (centre of mass
+ * within 1e-9), and the coordinator must drive the worker ranks and gather
+ * the lattice.  Runs on 1-3 ranks (N_z = 9 with R_c = 3 caps the count).
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_igsoa_distributed_3d.cpp
+ * MPI:   mpicxx -std=c++17 -O2 -fopenmp -mavx2 -mfma -DIGSOA_USE_MPI -Isrc/cpp \
+ *          tests/test_igsoa_distributed_3d.cpp && mpirun -np 3 ./a.out
+ */
+
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_distributed_engine_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+int rank = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL (rank " << rank << "): " << what << std::endl;
+        failures++;
+    }
+}
+
+bool close(double a, double b) {
+    return std::abs(a - b) <= 1.0e-12 * std::max(1.0, std::abs(b));
+}
+
+IGSOAComplexConfig makeConfig(size_t nodes, double R_c) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(nodes);
+    config.R_c_default = R_c;
+    config.dt = 0.01;
+    config.update_mode = IGSOAUpdateMode::DoubleBuffered;
+    config.coupling_mode = IGSOACouplingMode::Stencil;
+    config.fft_min_R_c = 1.0e9;
+    return config;
+}
+
+std::complex<double> seedPsi(size_t i) {
+    return std::complex<double>(std::cos(0.13 * i), std::sin(0.07 * i));
+}
+
+IGSOADistributedEngine3D makeDistributed(const IGSOAComplexConfig& config, size_t N_x, size_t N_y, size_t N_z) {
+#ifdef IGSOA_USE_MPI
+    return IGSOADistributedEngine3D(config, N_x, N_y, N_z, MPI_COMM_WORLD);
+#else
+    return IGSOADistributedEngine3D(config, N_x, N_y, N_z);
+#endif
+}
+
+void checkAgainstSerial(const std::string& label, size_t N_x, size_t N_y, size_t N_z, double R_c,
+                        bool driven) {
+    const IGSOAComplexConfig config = makeConfig(N_x * N_y * N_z, R_c);
+    IGSOAComplexEngine3D serial(config, N_x, N_y, N_z);
+    IGSOADistributedEngine3D distributed = makeDistributed(config, N_x, N_y, N_z);
+
+    auto& nodes = serial.getNodesMutable();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].psi = seedPsi(i);
+    }
+    const size_t plane = N_x * N_y;
+    const size_t begin = distributed.getDecomposition().getOwnedBegin();
+    auto& local = distributed.getLocalNodesMutable();
+    for (size_t i = 0; i < local.size(); ++i) {
+        local[i].psi = seedPsi(begin * plane + i);
+    }
+
+    const uint64_t steps = 12;
+    std::vector<double> signals(steps), controls(steps);
+    for (uint64_t s = 0; s < steps; ++s) {
+        signals[s] = 0.01 * std::sin(0.5 * s);
+        controls[s] = 0.02 * std::cos(0.3 * s);
+    }
+    serial.runMission(steps, driven ? signals.data() : nullptr, driven ? controls.data() : nullptr);
+    distributed.runMission(steps, driven ? signals.data() : nullptr, driven ? controls.data() : nullptr);
+
+    double diff = 0.0;
+    for (size_t i = 0; i < local.size(); ++i) {
+        const IGSOAComplexNode& expected = serial.getNodes()[begin * plane + i];
+        diff = std::max(diff, std::abs(local[i].psi - expected.psi));
+        diff = std::max(diff, std::abs(local[i].phi - expected.phi));
+        diff = std::max(diff, std::abs(local[i].F_gradient - expected.F_gradient));
+    }
+    expect(diff < 1.0e-12, label + ": owned planes match the serial engine (max diff " + std::to_string(diff) + ")");
+
+    expect(close(distributed.getTotalEnergy(), serial.getTotalEnergy()), label + ": total energy");
+    expect(close(distributed.getTotalEntropyRate(), serial.getTotalEntropyRate()), label + ": entropy rate");
+    double sx, sy, sz, dx, dy, dz;
+    serial.getCenterOfMass(sx, sy, sz);
+    distributed.getCenterOfMass(dx, dy, dz);
+    // (per-rank partial sums reorder the circular statistics)
+    expect(std::abs(dx - sx) < 1.0e-9 && std::abs(dy - sy) < 1.0e-9 && std::abs(dz - sz) < 1.0e-9,
+           label + ": centre of mass");
+
+    double ns_per_op, ops_per_sec, speedup, serial_ns, serial_ops, serial_speedup;
+    uint64_t total_ops, serial_total;
+    distributed.getMetrics(ns_per_op, ops_per_sec, speedup, total_ops);
+    serial.getMetrics(serial_ns, serial_ops, serial_speedup, serial_total);
+    // The serial engine defers ∇F to its first read (one pass per step
+    // fewer; normalizing steps keep F / Ṡ), the distributed one does not
+    expect(total_ops == serial_total + steps * N_x * N_y * N_z,
+           label + ": global operation count matches the serial engine");
+    expect(distributed.getCurrentTime() == serial.getCurrentTime(), label + ": simulated time");
+}
+
+void checkCoordinator() {
+    const size_t n = 8;
+    const IGSOAComplexConfig config = makeConfig(n * n * n, 1.0);
+    IGSOADistributedEngine3D distributed = makeDistributed(config, n, n, n);
+    IGSOADistributedCoordinator3D coordinator(distributed);
+
+    if (!coordinator.isRoot()) {
+        coordinator.serve();
+        return;
+    }
+
+    IGSOAComplexEngine3D serial(config, n, n, n);
+    std::vector<IGSOAComplexNode> lattice = serial.getNodes();
+    for (size_t i = 0; i < lattice.size(); ++i) {
+        lattice[i].psi = seedPsi(i);
+        serial.getNodesMutable()[i].psi = seedPsi(i);
+    }
+    coordinator.scatterNodes(lattice);
+
+    std::vector<double> signals(5, 0.01), controls(5, -0.02);
+    coordinator.runMission(5, signals.data(), controls.data());
+    coordinator.runMission(3);
+    serial.runMission(5, signals.data(), controls.data());
+    serial.runMission(3);
+
+    expect(close(coordinator.getTotalEnergy(), serial.getTotalEnergy()), "coordinator: total energy");
+    std::vector<IGSOAComplexNode> gathered;
+    coordinator.gatherNodes(gathered);
+    double diff = gathered.size() == lattice.size() ? 0.0 : 1.0;
+    for (size_t i = 0; i < gathered.size() && i < serial.getNodes().size(); ++i) {
+        diff = std::max(diff, std::abs(gathered[i].psi - serial.getNodes()[i].psi));
+    }
+    expect(diff < 1.0e-12, "coordinator: gathered lattice matches the serial engine");
+    coordinator.shutdown();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int num_ranks = 1;
+#ifdef IGSOA_USE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
+    try {
+        checkAgainstSerial("R_c=2 (fixed kernel)", 10, 9, 12, 2.0, false);
+        checkAgainstSerial("R_c=1.5 (run table)", 9, 8, 11, 1.5, false);
+        checkAgainstSerial("R_c=3 thin slabs, driven", 11, 10, 9, 3.0, true);
+        checkCoordinator();
+    } catch (const std::exception& e) {
+        expect(false, std::string("exception: ") + e.what());
+    }
+
+    int all_failures = failures;
+#ifdef IGSOA_USE_MPI
+    MPI_Allreduce(&failures, &all_failures, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+#endif
+    if (rank == 0) {
+        if (all_failures != 0) {
+            std::cerr << "test_igsoa_distributed_3d: " << all_failures << " failure(s) on "
+                      << num_ranks << " rank(s)" << std::endl;
+        } else {
+            std::cout << "test_igsoa_distributed_3d: PASS (" << num_ranks << " rank(s))" << std::endl;
+        }
+    }
+#ifdef IGSOA_USE_MPI
+    MPI_Finalize();
+#endif
+    return all_failures == 0 ? 0 : 1;
+}
@@ -220,6 +220,41 @@ void test_reset() {
     std::cout << "PASS" << std::endl;
 }
 
+void test_soa_tracks_node_edits() {
+    std::cout << "Test: SoA Mirror Tracks Direct Node Edits... ";
+
+    IGSOAComplexConfig config;
+    config.num_nodes = 32;
+
+    IGSOAComplexEngine engine(config);
+    std::vector<IGSOAComplexNode> reference(config.num_nodes);
+    for (auto& node : reference) {
+        node.R_c = config.R_c_default;
+        node.kappa = config.kappa;
+        node.gamma = config.gamma;
+    }
+
+    // Edit through the AoS accessor, bypassing setNodePsi
+    for (size_t i = 0; i < engine.getNumNodes(); i++) {
+        std::complex<double> psi(std::sin(0.3 * i), std::cos(0.2 * i));
+        engine.getNodesMutable()[i].psi = psi;
+        reference[i].psi = psi;
+    }
+
+    engine.runMission(10);
+    for (int step = 0; step < 10; step++) {
+        IGSOAPhysics::timeStep(reference, config);
+    }
+
+    const auto& nodes = engine.getNodes();
+    for (size_t i = 0; i < nodes.size(); i++) {
+        assert(nodes[i].psi == reference[i].psi);
+        assert(nodes[i].F_gradient == reference[i].F_gradient);
+    }
+
+    std::cout << "PASS" << std::endl;
+}
+
 void test_performance_benchmark() {
     std::cout << "Test: Performance Benchmark... ";
 
@@ -268,6 +303,7 @@ int main() {
         test_energy_entropy();
         test_average_quantities();
         test_reset();
+        test_soa_tracks_node_edits();
         test_performance_benchmark();
 
         std::cout << std::endl;
@@ -0,0 +1,180 @@
+/**
+ * IGSOA ensemble engine test
+ *
+ * Every replica of IGSOAEnsembleEngine1D must track its own
+ * IGSOAComplexEngine (same config, that replica's κ / γ and initial state)
+ * within 1e-12 for both update modes, with and without normalize_psi,
+ * driven missions and rings short enough to alias the stencil.  Bulk field
+ * access must round-trip replica-major buffers, and non-Euler / float
+ * configs must be rejected.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_igsoa_ensemble.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_ensemble_engine.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool close(double a, double b) {
+    return std::abs(a - b) <= 1.0e-12 * std::max(1.0, std::abs(b));
+}
+
+IGSOAComplexConfig makeConfig(size_t nodes, double R_c, IGSOAUpdateMode mode, bool normalize) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(nodes);
+    config.R_c_default = R_c;
+    config.dt = 0.01;
+    config.normalize_psi = normalize;
+    config.update_mode = mode;
+    config.simd_coupling = false;
+    config.omp_min_nodes = 0;   // Exercise the threaded split on small lattices
+    return config;
+}
+
+void checkAgainstEngines(const std::string& label, size_t N, size_t E, double R_c,
+                         IGSOAUpdateMode mode, bool normalize, bool driven) {
+    const IGSOAComplexConfig config = makeConfig(N, R_c, mode, normalize);
+    IGSOAEnsembleEngine1D ensemble(config, E);
+
+    std::vector<std::unique_ptr<IGSOAComplexEngine>> engines;
+    for (size_t r = 0; r < E; ++r) {
+        IGSOAComplexConfig replica = config;
+        replica.kappa = 0.5 + 0.1 * r;
+        replica.gamma = 0.02 * r;
+        engines.emplace_back(new IGSOAComplexEngine(replica));
+        ensemble.setReplicaCoupling(r, replica.kappa, replica.gamma);
+        for (size_t i = 0; i < N; ++i) {
+            const double re = std::cos(0.13 * i + 0.7 * r);
+            const double im = std::sin(0.07 * i * (r + 1));
+            const double phi = 0.1 * std::sin(0.3 * i - r);
+            engines[r]->setNodePsi(i, re, im);
+            engines[r]->setNodePhi(i, phi);
+            ensemble.setNodePsi(r, i, re, im);
+            ensemble.setNodePhi(r, i, phi);
+        }
+    }
+
+    const uint64_t steps = 15;
+    std::vector<double> signals(steps), controls(steps);
+    for (uint64_t s = 0; s < steps; ++s) {
+        signals[s] = 0.01 * std::sin(0.5 * s);
+        controls[s] = 0.02 * std::cos(0.3 * s);
+    }
+    const double* in = driven ? signals.data() : nullptr;
+    const double* ctl = driven ? controls.data() : nullptr;
+    ensemble.runMission(steps, in, ctl);
+    for (auto& engine : engines) {
+        engine->runMission(steps, in, ctl);
+    }
+
+    double diff = 0.0;
+    bool totals = true;
+    for (size_t r = 0; r < E; ++r) {
+        const auto& nodes = engines[r]->getNodes();
+        for (size_t i = 0; i < N; ++i) {
+            double re, im;
+            ensemble.getNodePsi(r, i, re, im);
+            diff = std::max(diff, std::abs(std::complex<double>(re, im) - nodes[i].psi));
+            diff = std::max(diff, std::abs(ensemble.getNodePhi(r, i) - nodes[i].phi));
+            diff = std::max(diff, std::abs(ensemble.getNodeF(r, i) - nodes[i].F));
+        }
+        totals = totals && close(ensemble.getTotalEnergy(r), engines[r]->getTotalEnergy()) &&
+                 close(ensemble.getTotalEntropyRate(r), engines[r]->getTotalEntropyRate());
+    }
+    expect(diff < 1.0e-12, label + ": replicas match their own engines (max diff " + std::to_string(diff) + ")");
+    expect(totals, label + ": per-replica energy and entropy rate");
+    expect(ensemble.getCurrentTime() == engines[0]->getCurrentTime(), label + ": simulated time");
+    expect(ensemble.getRoofline().bytes_per_step > 0.0, label + ": traffic model");
+}
+
+void testBulkAccess() {
+    const size_t N = 12, E = 5;
+    IGSOAEnsembleEngine1D ensemble(makeConfig(N, 2.0, IGSOAUpdateMode::DoubleBuffered, false), E);
+    std::vector<double> in(3 * N), out(3 * N, -1.0);
+    for (size_t k = 0; k < in.size(); ++k) {
+        in[k] = 0.25 * k - 1.0;
+    }
+    expect(ensemble.setField(IGSOANodeField::PsiReal, 1, 3, in.data()), "set Re Psi of replicas 1-3");
+    expect(ensemble.getField(IGSOANodeField::PsiReal, 1, 3, out.data()) && out == in,
+           "Re Psi round-trips replica-major");
+    double re, im;
+    ensemble.getNodePsi(2, 4, re, im);
+    expect(re == in[N + 4], "replica-major index (r - first) * N + i");
+    expect(ensemble.getNodeF(2, 4) == re * re, "writing Psi refreshes F");
+    ensemble.getNodePsi(0, 4, re, im);
+    expect(re == 0.0, "replicas outside the range are untouched");
+
+    expect(!ensemble.setField(IGSOANodeField::F, 0, 1, in.data()), "F is read-only");
+    expect(!ensemble.getField(IGSOANodeField::Phi, 3, 3, out.data()), "replica range past the ensemble");
+    expect(!ensemble.setReplicaCoupling(E, 1.0, 0.0), "replica coupling out of range");
+}
+
+void testRejectedConfigs() {
+    IGSOAComplexConfig rk = makeConfig(16, 2.0, IGSOAUpdateMode::DoubleBuffered, false);
+    rk.integrator = IGSOAIntegrator::RK4;
+    bool threw = false;
+    try {
+        IGSOAEnsembleEngine1D ensemble(rk, 4);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "RK4 ensembles are rejected");
+
+    IGSOAComplexConfig single = makeConfig(16, 2.0, IGSOAUpdateMode::DoubleBuffered, false);
+    single.precision = IGSOAPrecision::Float;
+    threw = false;
+    try {
+        IGSOAEnsembleEngine1D ensemble(single, 4);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "float precision ensembles are rejected");
+
+    threw = false;
+    try {
+        IGSOAEnsembleEngine1D ensemble(makeConfig(16, 2.0, IGSOAUpdateMode::DoubleBuffered, false), 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    expect(threw, "empty ensembles are rejected");
+}
+
+} // namespace
+
+int main() {
+    checkAgainstEngines("DoubleBuffered R_c=3", 64, 19, 3.0, IGSOAUpdateMode::DoubleBuffered, false, false);
+    checkAgainstEngines("InPlace R_c=2", 48, 21, 2.0, IGSOAUpdateMode::InPlace, false, false);
+    checkAgainstEngines("DoubleBuffered normalized, driven", 40, 8, 1.5, IGSOAUpdateMode::DoubleBuffered, true, true);
+    checkAgainstEngines("InPlace normalized, driven", 40, 33, 2.5, IGSOAUpdateMode::InPlace, true, true);
+    checkAgainstEngines("aliased ring N=5 R_c=3", 5, 6, 3.0, IGSOAUpdateMode::DoubleBuffered, false, true);
+    checkAgainstEngines("aliased ring InPlace", 5, 6, 3.0, IGSOAUpdateMode::InPlace, false, false);
+    testBulkAccess();
+    testRejectedConfigs();
+
+    if (failures != 0) {
+        std::cerr << "test_igsoa_ensemble: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_igsoa_ensemble: PASS" << std::endl;
+    return 0;
+}
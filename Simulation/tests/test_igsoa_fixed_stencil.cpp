@@ -0,0 +1,203 @@
+/**
+ * Fixed-radius stencil test
+ *
+ * For R_c = 1..4 the compile-time run tables must equal the runtime
+ * NeighborStencil2D/3D runs entry for entry, and the unrolled interior sums
+ * must be bit-identical to the generic run walk in both SIMD modes (1D
+ * against the zero-centre span).  Other radii and lattices too small for
+ * the runs to match report no fixed radius.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma tests/test_igsoa_fixed_stencil.cpp
+ */
+
+#include "../src/cpp/igsoa_fixed_stencil.h"
+#include "../src/cpp/neighbor_cache.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+size_t checked = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+struct Lattice {
+    std::vector<double> re;
+    std::vector<double> im;
+
+    explicit Lattice(size_t n) : re(n), im(n) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (size_t i = 0; i < n; ++i) {
+            re[i] = dist(rng);
+            im[i] = dist(rng);
+        }
+    }
+};
+
+template <int Dim, int R, typename Stencil>
+void checkRuns(const Stencil& stencil, std::ptrdiff_t row, std::ptrdiff_t plane, const std::string& name) {
+    using Shape = FixedStencilShape<Dim, R>;
+    expect(stencil.fixedRadius() == R, name + " fixed radius");
+    expect(stencil.size() == Shape::kNeighbors, name + " neighbour count");
+    expect(stencil.numRuns() == Shape::kNumRuns, name + " run count");
+    if (stencil.numRuns() != Shape::kNumRuns) return;
+    for (size_t r = 0; r < Shape::kNumRuns; ++r) {
+        const auto& run = Shape::kRuns[r];
+        expect(stencil.runBegin()[r] == run.begin && stencil.runLength()[r] == run.length &&
+               stencil.linearOffset()[run.begin] == run.linearOffset(row, plane),
+               name + " run " + std::to_string(r));
+    }
+}
+
+template <int Dim, typename Stencil>
+void checkSums(const Stencil& stencil, const Lattice& lattice, const std::vector<size_t>& nodes,
+               std::ptrdiff_t row, std::ptrdiff_t plane, const std::string& name) {
+    for (bool simd : {false, true}) {
+        if (simd && !IGSOACouplingKernels::avx2Available()) continue;
+        for (size_t i : nodes) {
+            const double self_re = lattice.re[i];
+            const double self_im = lattice.im[i];
+            double generic_re = 0.0, generic_im = 0.0;
+            for (size_t r = 0; r < stencil.numRuns(); ++r) {
+                const size_t k0 = stencil.runBegin()[r];
+                const size_t j0 = static_cast<size_t>(static_cast<std::ptrdiff_t>(i) + stencil.linearOffset()[k0]);
+                IGSOACouplingKernels::accumulateContiguous(
+                    simd, lattice.re.data() + j0, lattice.im.data() + j0, stencil.weight() + k0,
+                    stencil.runLength()[r], self_re, self_im, generic_re, generic_im);
+            }
+            double fixed_re = 0.0, fixed_im = 0.0;
+            const bool handled = FixedStencilKernels::accumulateInterior<Dim>(
+                stencil.fixedRadius(), simd, lattice.re.data() + i, lattice.im.data() + i, row, plane,
+                stencil.weight(), self_re, self_im, fixed_re, fixed_im);
+            expect(handled, name + " specialized");
+            expect(sameBits(generic_re, fixed_re) && sameBits(generic_im, fixed_im),
+                   name + (simd ? " avx2" : " scalar") + " sum at node " + std::to_string(i));
+            checked++;
+        }
+    }
+}
+
+template <int R>
+void check1D() {
+    const size_t N = 64;
+    const std::string name = "1D R=" + std::to_string(R);
+    Lattice lattice(N);
+    // Interior span of IGSOAPhysics: 2R+1 weights, zero at the centre
+    std::vector<double> weights(2 * R + 1, 0.0);
+    for (int offset = -R; offset <= R; ++offset) {
+        if (offset != 0) {
+            weights[static_cast<size_t>(offset + R)] = std::exp(-std::abs(offset) / static_cast<double>(R)) / R;
+        }
+    }
+    expect(FixedStencilKernels::fixedRadius(R, N) == R, name + " fixed radius");
+    expect(FixedStencilShape<1, R>::kNeighbors == static_cast<size_t>(2 * R), name + " neighbour count");
+    for (bool simd : {false, true}) {
+        if (simd && !IGSOACouplingKernels::avx2Available()) continue;
+        for (size_t i = R; i + R < N; i += 7) {
+            double generic_re = 0.0, generic_im = 0.0;
+            IGSOACouplingKernels::accumulateContiguous(
+                simd, lattice.re.data() + (i - R), lattice.im.data() + (i - R), weights.data(), weights.size(),
+                lattice.re[i], lattice.im[i], generic_re, generic_im);
+            double fixed_re = 0.0, fixed_im = 0.0;
+            FixedStencilKernels::accumulateInterior<1>(
+                R, simd, lattice.re.data() + i, lattice.im.data() + i, 0, 0, weights.data(),
+                lattice.re[i], lattice.im[i], fixed_re, fixed_im);
+            expect(sameBits(generic_re, fixed_re) && sameBits(generic_im, fixed_im),
+                   name + (simd ? " avx2" : " scalar") + " sum at node " + std::to_string(i));
+            checked++;
+        }
+    }
+}
+
+template <int R>
+void check2D() {
+    const size_t N_x = 19, N_y = 13;   // Non-square, both >= 2R+2
+    const std::string name = "2D R=" + std::to_string(R);
+    NeighborStencil2D stencil;
+    stencil.build(N_x, N_y, R);
+    checkRuns<2, R>(stencil, static_cast<std::ptrdiff_t>(N_x), 0, name);
+
+    Lattice lattice(N_x * N_y);
+    std::vector<size_t> interior;
+    for (size_t y = R; y + R < N_y; ++y) {
+        for (size_t x = R; x + R < N_x; x += 3) {
+            interior.push_back(y * N_x + x);
+        }
+    }
+    checkSums<2>(stencil, lattice, interior, static_cast<std::ptrdiff_t>(N_x), 0, name);
+}
+
+template <int R>
+void check3D() {
+    const size_t N_x = 13, N_y = 11, N_z = 10;
+    const std::string name = "3D R=" + std::to_string(R);
+    NeighborStencil3D stencil;
+    stencil.build(N_x, N_y, N_z, R);
+    const auto row = static_cast<std::ptrdiff_t>(N_x);
+    const auto plane = static_cast<std::ptrdiff_t>(N_x * N_y);
+    checkRuns<3, R>(stencil, row, plane, name);
+
+    Lattice lattice(N_x * N_y * N_z);
+    std::vector<size_t> interior;
+    for (size_t z = R; z + R < N_z; z += 2) {
+        for (size_t y = R; y + R < N_y; y += 2) {
+            for (size_t x = R; x + R < N_x; x += 3) {
+                interior.push_back((z * N_y + y) * N_x + x);
+            }
+        }
+    }
+    checkSums<3>(stencil, lattice, interior, row, plane, name);
+}
+
+} // namespace
+
+int main() {
+    check1D<1>();
+    check1D<2>();
+    check1D<3>();
+    check1D<4>();
+    check2D<1>();
+    check2D<2>();
+    check2D<3>();
+    check2D<4>();
+    check3D<1>();
+    check3D<2>();
+    check3D<3>();
+    check3D<4>();
+
+    // Uncommon radii and lattices where rows could merge keep the generic path
+    expect(FixedStencilKernels::fixedRadius(2.5, 64, 64) == 0, "R_c = 2.5 is not specialized");
+    expect(FixedStencilKernels::fixedRadius(5.0, 64, 64) == 0, "R_c = 5 is not specialized");
+    expect(FixedStencilKernels::fixedRadius(0.0, 64) == 0, "R_c = 0 is not specialized");
+    NeighborStencil2D narrow;
+    narrow.build(7, 32, 3.0);   // 2R+1 = 7 columns: rows become one run
+    expect(narrow.fixedRadius() == 0, "narrow lattice keeps the generic path");
+    double acc_re = 0.0, acc_im = 0.0;
+    const double unused = 0.0;
+    expect(!FixedStencilKernels::accumulateInterior<2>(0, false, &unused, &unused, 0, 0, &unused,
+                                                       0.0, 0.0, acc_re, acc_im) &&
+           acc_re == 0.0 && acc_im == 0.0, "radius 0 adds nothing");
+
+    if (failures == 0) {
+        std::cout << "Fixed stencils: " << checked << " interior sums bit-identical, PASS" << std::endl;
+        return 0;
+    }
+    return 1;
+}
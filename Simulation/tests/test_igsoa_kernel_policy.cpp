@@ -0,0 +1,163 @@
+/**
+ * IGSOA coupling kernel policy test
+ *
+ * ExponentialKernel must reproduce the legacy exp(-r/R_c)/R_c bit for bit,
+ * and the Gaussian and Wendland laws must respect their support.  Under each
+ * law, the precomputed paths (uniform-R_c stencil, CSR graph rows) must be
+ * bit-identical to the direct loop in 2D and 3D, and a 1D engine must differ
+ * from the exponential run.  Switching the law of a Stencil-mode engine
+ * between missions must rebuild its table.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_igsoa_kernel_policy.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_kernel_policy.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+const IGSOAKernelPolicy kLaws[] = {
+    IGSOAKernelPolicy::Exponential, IGSOAKernelPolicy::Gaussian, IGSOAKernelPolicy::Wendland
+};
+
+IGSOAComplexConfig makeConfig(size_t nodes, IGSOACouplingMode coupling, IGSOAKernelPolicy law) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(nodes);
+    config.R_c_default = 2.5;
+    config.dt = 0.01;
+    config.update_mode = IGSOAUpdateMode::DoubleBuffered;
+    config.coupling_mode = coupling;
+    config.kernel_policy = law;
+    config.simd_coupling = false;   // Scalar sums: stencil runs match the direct loop bit for bit
+    config.omp_min_nodes = 0;
+    return config;
+}
+
+template <typename Engine>
+double maxDifference(const Engine& a, const Engine& b) {
+    double diff = 0.0;
+    for (size_t i = 0; i < a.getNodes().size(); ++i) {
+        diff = std::max(diff, std::abs(a.getNodes()[i].psi - b.getNodes()[i].psi));
+        diff = std::max(diff, std::abs(a.getNodes()[i].phi - b.getNodes()[i].phi));
+    }
+    return diff;
+}
+
+void testLaws() {
+    for (double r : {0.5, 1.0, 2.0, 2.9}) {
+        expect(ExponentialKernel::evaluate(r, 3.0) == std::exp(-r / 3.0) / 3.0, "exponential matches legacy kernel");
+        expect(GaussianKernel::evaluate(r, 3.0) > 0.0, "gaussian positive inside R_c");
+        expect(WendlandKernel::evaluate(r, 3.0) > 0.0, "wendland positive inside R_c");
+    }
+    expect(WendlandKernel::evaluate(3.0, 3.0) == 0.0 && WendlandKernel::evaluate(4.0, 3.0) == 0.0,
+           "wendland vanishes at and beyond R_c");
+    expect(WendlandKernel::evaluate(1.0, 3.0) > WendlandKernel::evaluate(2.0, 3.0), "wendland decreasing");
+    for (IGSOAKernelPolicy law : kLaws) {
+        expect(kernelWeight(law, 0.0, 3.0) == 0.0 && kernelWeight(law, 1.0, 0.0) == 0.0,
+               std::string(kernelPolicyName(law)) + ": no self or zero-radius coupling");
+        IGSOAKernelPolicy parsed = IGSOAKernelPolicy::Exponential;
+        expect(parseKernelPolicy(kernelPolicyName(law), parsed) && parsed == law,
+               std::string(kernelPolicyName(law)) + ": name round-trips");
+    }
+    IGSOAKernelPolicy unused;
+    expect(!parseKernelPolicy("lorentzian", unused), "unknown law rejected");
+}
+
+void test2D(IGSOAKernelPolicy law, bool rc_map) {
+    const std::string label = std::string("2D ") + kernelPolicyName(law) + (rc_map ? " graph" : " stencil");
+    const size_t n_x = 20;
+    const size_t n_y = 18;
+    IGSOAComplexEngine2D direct(makeConfig(n_x * n_y, IGSOACouplingMode::Direct, law), n_x, n_y);
+    IGSOAComplexEngine2D table(makeConfig(n_x * n_y, IGSOACouplingMode::Stencil, law), n_x, n_y);
+    for (IGSOAComplexEngine2D* engine : {&direct, &table}) {
+        IGSOAStateInit2D::initCircularGaussian(*engine, 1.0, 10.0, 9.0, 3.0);
+        if (rc_map) {
+            auto& nodes = engine->getNodesMutable();
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                nodes[i].R_c = 1.2 + 0.5 * static_cast<double>(i % 4);
+            }
+        }
+    }
+    direct.runMission(15);
+    table.runMission(15);
+    expect(maxDifference(table, direct) == 0.0, label + ": bit-identical to direct");
+}
+
+void test3D(IGSOAKernelPolicy law) {
+    const std::string label = std::string("3D ") + kernelPolicyName(law);
+    const size_t n = 9;
+    IGSOAComplexEngine3D direct(makeConfig(n * n * n, IGSOACouplingMode::Direct, law), n, n, n);
+    IGSOAComplexEngine3D stencil(makeConfig(n * n * n, IGSOACouplingMode::Stencil, law), n, n, n);
+    for (IGSOAComplexEngine3D* engine : {&direct, &stencil}) {
+        IGSOAStateInit3D::initSphericalGaussian(*engine, 1.0, 4.5, 4.5, 4.5, 2.0);
+    }
+    direct.runMission(8);
+    stencil.runMission(8);
+    expect(maxDifference(stencil, direct) == 0.0, label + ": stencil bit-identical to direct");
+}
+
+void test1D() {
+    IGSOAComplexEngine exponential(makeConfig(256, IGSOACouplingMode::Direct, IGSOAKernelPolicy::Exponential));
+    IGSOAComplexEngine wendland(makeConfig(256, IGSOACouplingMode::Direct, IGSOAKernelPolicy::Wendland));
+    for (IGSOAComplexEngine* engine : {&exponential, &wendland}) {
+        engine->setNodePsi(128, 1.0, 0.0);
+        engine->runMission(10);
+    }
+    expect(maxDifference(exponential, wendland) > 1.0e-6, "1D: the law changes the dynamics");
+}
+
+void testSwitchLaw() {
+    // A Stencil-mode engine switched to another law between missions must
+    // rebuild its table and follow an engine created with that law
+    const size_t n = 16;
+    IGSOAComplexEngine2D switched(makeConfig(n * n, IGSOACouplingMode::Stencil, IGSOAKernelPolicy::Exponential), n, n);
+    IGSOAComplexEngine2D reference(makeConfig(n * n, IGSOACouplingMode::Direct, IGSOAKernelPolicy::Exponential), n, n);
+    for (IGSOAComplexEngine2D* engine : {&switched, &reference}) {
+        IGSOAStateInit2D::initCircularGaussian(*engine, 1.0, 8.0, 8.0, 2.0);
+        engine->runMission(5);
+        engine->setKernelPolicy(IGSOAKernelPolicy::Gaussian);
+        engine->runMission(5);
+    }
+    expect(switched.getKernelPolicy() == IGSOAKernelPolicy::Gaussian, "setKernelPolicy");
+    expect(maxDifference(switched, reference) == 0.0, "law switch rebuilds the stencil");
+}
+
+} // namespace
+
+int main() {
+    testLaws();
+    for (IGSOAKernelPolicy law : kLaws) {
+        test2D(law, false);
+        test2D(law, true);
+        test3D(law);
+    }
+    test1D();
+    testSwitchLaw();
+
+    if (failures != 0) {
+        std::cerr << "test_igsoa_kernel_policy: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_igsoa_kernel_policy: PASS" << std::endl;
+    return 0;
+}
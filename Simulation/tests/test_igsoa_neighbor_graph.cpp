@@ -0,0 +1,211 @@
+/**
+ * IGSOA neighbor graph test
+ *
+ * Lattices with a spatially varying R_c map, stepped in Stencil mode (CSR
+ * graph rows, igsoa_neighbor_graph.h), must be bit-identical to Direct
+ * coupling for 2D/3D, both update modes and RK4, and track it closely with
+ * float sums.  A refresh() after editing a few R_c values must rebuild only
+ * those rows (in place and repacked) and match a fresh build entry for
+ * entry, and the threaded build must match the serial one.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_igsoa_neighbor_graph.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_neighbor_graph.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+IGSOAComplexConfig makeConfig(size_t nodes, IGSOACouplingMode coupling, IGSOAUpdateMode mode) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(nodes);
+    config.R_c_default = 2.0;
+    config.dt = 0.01;
+    config.update_mode = mode;
+    config.coupling_mode = coupling;
+    config.omp_min_nodes = 0;
+    return config;
+}
+
+// R_c between 0.8 and 3.2, varying per node
+double rcAt(size_t i) {
+    return 0.8 + 0.6 * static_cast<double>((i * 7) % 5);
+}
+
+void applyRcMap(std::vector<IGSOAComplexNode>& nodes) {
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].R_c = rcAt(i);
+    }
+}
+
+template <typename Engine>
+double maxDifference(const Engine& a, const Engine& b) {
+    double diff = 0.0;
+    for (size_t i = 0; i < a.getNodes().size(); ++i) {
+        diff = std::max(diff, std::abs(a.getNodes()[i].psi - b.getNodes()[i].psi));
+        diff = std::max(diff, std::abs(a.getNodes()[i].phi - b.getNodes()[i].phi));
+    }
+    return diff;
+}
+
+void test2D(IGSOAUpdateMode mode, IGSOAIntegrator integrator, IGSOAPrecision precision,
+            double tolerance, const std::string& label) {
+    const size_t n_x = 24;
+    const size_t n_y = 20;
+    IGSOAComplexEngine2D direct(makeConfig(n_x * n_y, IGSOACouplingMode::Direct, mode), n_x, n_y);
+    IGSOAComplexEngine2D graph(makeConfig(n_x * n_y, IGSOACouplingMode::Stencil, mode), n_x, n_y);
+    for (IGSOAComplexEngine2D* engine : {&direct, &graph}) {
+        IGSOAStateInit2D::initCircularGaussian(*engine, 1.0, 12.0, 10.0, 3.0);
+        applyRcMap(engine->getNodesMutable());
+        engine->setIntegrator(integrator);
+        engine->setPrecision(precision);
+    }
+    const size_t direct_bytes = direct.getMemoryUsage();
+    direct.runMission(20);
+    graph.runMission(20);
+    const double diff = maxDifference(graph, direct);
+    expect(diff <= tolerance, label + ": graph matches direct (max diff " + std::to_string(diff) + ")");
+    expect(graph.getMemoryUsage() > direct_bytes, label + ": graph counted in memory usage");
+}
+
+void test3D(IGSOAUpdateMode mode, const std::string& label) {
+    const size_t n_x = 10;
+    const size_t n_y = 9;
+    const size_t n_z = 8;
+    IGSOAComplexEngine3D direct(makeConfig(n_x * n_y * n_z, IGSOACouplingMode::Direct, mode), n_x, n_y, n_z);
+    IGSOAComplexEngine3D graph(makeConfig(n_x * n_y * n_z, IGSOACouplingMode::Stencil, mode), n_x, n_y, n_z);
+    for (IGSOAComplexEngine3D* engine : {&direct, &graph}) {
+        IGSOAStateInit3D::initSphericalGaussian(*engine, 1.0, 5.0, 4.5, 4.0, 2.0);
+        applyRcMap(engine->getNodesMutable());
+    }
+    direct.runMission(10);
+    graph.runMission(10);
+    expect(maxDifference(graph, direct) == 0.0, label + ": graph is bit-identical to direct");
+}
+
+template <int Dim>
+bool sameGraph(const IGSOANeighborGraph<Dim>& a, const IGSOANeighborGraph<Dim>& b) {
+    if (a.numRows() != b.numRows() || a.numEntries() != b.numEntries()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.numRows(); ++i) {
+        if (a.rowBegin(i) != b.rowBegin(i) || a.rowEnd(i) != b.rowEnd(i)) {
+            return false;
+        }
+    }
+    for (uint64_t k = 0; k < a.numEntries(); ++k) {
+        if (a.index()[k] != b.index()[k] || a.weight()[k] != b.weight()[k] ||
+            a.weight32()[k] != b.weight32()[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testIncrementalRefresh() {
+    const size_t n_x = 16;
+    const size_t n_y = 12;
+    const size_t n_z = 6;
+    std::vector<IGSOAComplexNode> nodes(n_x * n_y * n_z);
+    applyRcMap(nodes);
+
+    IGSOANeighborGraph3D graph;
+    IGSOANeighborGraph3D serial;
+    expect(graph.build(nodes, n_x, n_y, n_z, 0), "threaded build");
+    expect(serial.build(nodes, n_x, n_y, n_z, static_cast<size_t>(-1)), "serial build");
+    expect(sameGraph(graph, serial), "threaded build matches serial build");
+    expect(graph.lastRebuiltRows() == nodes.size(), "build packs every row");
+
+    expect(graph.refresh(nodes, n_x, n_y, n_z, 0) && graph.lastRebuiltRows() == 0,
+           "unchanged R_c rebuilds nothing");
+
+    // Same row lengths: 1.5 -> 1.6 keeps the 18 neighbours within sqrt(2)
+    nodes[5].R_c = 1.5;
+    nodes[77].R_c = 1.5;
+    graph.refresh(nodes, n_x, n_y, n_z, 0);
+    nodes[5].R_c = 1.6;
+    nodes[77].R_c = 1.6;
+    const uint64_t entries = graph.numEntries();
+    expect(graph.refresh(nodes, n_x, n_y, n_z, 0) && graph.lastRebuiltRows() == 2,
+           "in-place refresh rebuilds the changed rows only");
+    expect(graph.numEntries() == entries, "in-place refresh keeps the packing");
+    IGSOANeighborGraph3D fresh;
+    fresh.build(nodes, n_x, n_y, n_z, 0);
+    expect(sameGraph(graph, fresh), "in-place refresh matches a fresh build");
+
+    // Longer and shorter rows: repacked around the unchanged ones
+    nodes[0].R_c = 3.5;
+    nodes[400].R_c = 0.5;
+    nodes[nodes.size() - 1].R_c = 2.2;
+    expect(graph.refresh(nodes, n_x, n_y, n_z, 0) && graph.lastRebuiltRows() == 3,
+           "repacking refresh rebuilds the changed rows only");
+    fresh.build(nodes, n_x, n_y, n_z, 0);
+    expect(sameGraph(graph, fresh), "repacking refresh matches a fresh build");
+    expect(graph.rowEnd(400) == graph.rowBegin(400), "R_c below one lattice step has no neighbours");
+
+    // A new lattice shape is a full build
+    std::vector<IGSOAComplexNode> plane(n_x * n_y);
+    applyRcMap(plane);
+    IGSOANeighborGraph2D flat;
+    flat.build(plane, n_x, n_y, 1, 0);
+    plane.resize(n_x * (n_y - 2));
+    expect(flat.refresh(plane, n_x, n_y - 2, 1, 0) && flat.lastRebuiltRows() == plane.size(),
+           "reshaped lattice rebuilds every row");
+    expect(!flat.build(plane, n_x, n_y, 1, 0) && flat.numEntries() == 0, "mismatched node count is rejected");
+}
+
+void testEngineRefresh() {
+    // R_c edits between missions keep the graph path exact
+    const size_t n = 16;
+    IGSOAComplexEngine2D direct(makeConfig(n * n, IGSOACouplingMode::Direct, IGSOAUpdateMode::InPlace), n, n);
+    IGSOAComplexEngine2D graph(makeConfig(n * n, IGSOACouplingMode::Stencil, IGSOAUpdateMode::InPlace), n, n);
+    for (IGSOAComplexEngine2D* engine : {&direct, &graph}) {
+        IGSOAStateInit2D::initCircularGaussian(*engine, 1.0, 8.0, 8.0, 2.0);
+        applyRcMap(engine->getNodesMutable());
+        engine->runMission(5);
+        engine->getNodesMutable()[17].R_c = 2.7;
+        engine->getNodesMutable()[200].R_c = 1.1;
+        engine->runMission(5);
+    }
+    expect(maxDifference(graph, direct) == 0.0, "R_c edits between missions");
+}
+
+} // namespace
+
+int main() {
+    test2D(IGSOAUpdateMode::InPlace, IGSOAIntegrator::Euler, IGSOAPrecision::Double, 0.0, "2D InPlace");
+    test2D(IGSOAUpdateMode::DoubleBuffered, IGSOAIntegrator::Euler, IGSOAPrecision::Double, 0.0, "2D DoubleBuffered");
+    test2D(IGSOAUpdateMode::DoubleBuffered, IGSOAIntegrator::RK4, IGSOAPrecision::Double, 0.0, "2D RK4");
+    test2D(IGSOAUpdateMode::DoubleBuffered, IGSOAIntegrator::Euler, IGSOAPrecision::MixedFloat, 0.0, "2D MixedFloat");
+    test2D(IGSOAUpdateMode::DoubleBuffered, IGSOAIntegrator::Euler, IGSOAPrecision::Float, 1.0e-5, "2D Float");
+    test3D(IGSOAUpdateMode::InPlace, "3D InPlace");
+    test3D(IGSOAUpdateMode::DoubleBuffered, "3D DoubleBuffered");
+    testIncrementalRefresh();
+    testEngineRefresh();
+
+    if (failures != 0) {
+        std::cerr << "test_igsoa_neighbor_graph: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_igsoa_neighbor_graph: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * IGSOA precision test
+ *
+ * MixedFloat and Float (IGSOAPrecision) missions must track the Double
+ * mission on 1D/2D/3D lattices, for stencil and direct coupling and both
+ * update modes, within the documented float-mirror bounds: after 100 steps
+ * max |ΔΨ| < 1e-6 (MixedFloat) and < 2e-6 (Float).  RK4 must ignore the
+ * setting (double stages), and the traffic model must count half the
+ * mirror bytes.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_igsoa_precision.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+const int kSteps = 100;
+
+IGSOAComplexConfig makeConfig(uint32_t nodes, double R_c, IGSOAPrecision precision) {
+    IGSOAComplexConfig config;
+    config.num_nodes = nodes;
+    config.R_c_default = R_c;
+    config.dt = 0.01;
+    config.update_mode = IGSOAUpdateMode::DoubleBuffered;
+    config.coupling_mode = IGSOACouplingMode::Stencil;
+    config.fft_min_R_c = 1.0e9;
+    config.precision = precision;
+    return config;
+}
+
+template <typename Engine>
+void seed(Engine& engine) {
+    auto& nodes = engine.getNodesMutable();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].psi = std::complex<double>(std::cos(0.13 * i), std::sin(0.07 * i));
+    }
+}
+
+template <typename Engine>
+double maxDifference(const Engine& a, const Engine& b) {
+    double diff = 0.0;
+    for (size_t i = 0; i < a.getNodes().size(); ++i) {
+        diff = std::max(diff, std::abs(a.getNodes()[i].psi - b.getNodes()[i].psi));
+        diff = std::max(diff, std::abs(a.getNodes()[i].phi - b.getNodes()[i].phi));
+    }
+    return diff;
+}
+
+// Run the same mission in all three precisions and check the bounds
+template <typename Make>
+void checkModes(const std::string& label, Make make) {
+    auto reference = make(IGSOAPrecision::Double);
+    auto mixed = make(IGSOAPrecision::MixedFloat);
+    auto single = make(IGSOAPrecision::Float);
+    seed(reference);
+    seed(mixed);
+    seed(single);
+    reference.runMission(kSteps);
+    mixed.runMission(kSteps);
+    single.runMission(kSteps);
+
+    const double mixed_error = maxDifference(reference, mixed);
+    const double float_error = maxDifference(reference, single);
+    std::cout << "  " << label << ": MixedFloat " << mixed_error << ", Float " << float_error << std::endl;
+    expect(mixed_error > 0.0, label + " MixedFloat actually rounds the mirror");
+    expect(mixed_error < 1.0e-6, label + " MixedFloat within bound");
+    expect(float_error < 2.0e-6, label + " Float within bound");
+}
+
+} // namespace
+
+int main() {
+    checkModes("1D R_c=3", [](IGSOAPrecision p) { return IGSOAComplexEngine(makeConfig(4096, 3.0, p)); });
+    checkModes("1D R_c=5.5", [](IGSOAPrecision p) { return IGSOAComplexEngine(makeConfig(4096, 5.5, p)); });
+    checkModes("1D in-place", [](IGSOAPrecision p) {
+        IGSOAComplexConfig config = makeConfig(512, 3.0, p);
+        config.update_mode = IGSOAUpdateMode::InPlace;
+        return IGSOAComplexEngine(config);
+    });
+    checkModes("2D stencil R_c=3", [](IGSOAPrecision p) {
+        return IGSOAComplexEngine2D(makeConfig(64 * 48, 3.0, p), 64, 48);
+    });
+    checkModes("2D stencil R_c=6", [](IGSOAPrecision p) {
+        return IGSOAComplexEngine2D(makeConfig(64 * 48, 6.0, p), 64, 48);
+    });
+    checkModes("2D direct", [](IGSOAPrecision p) {
+        IGSOAComplexConfig config = makeConfig(40 * 40, 2.5, p);
+        config.coupling_mode = IGSOACouplingMode::Direct;
+        return IGSOAComplexEngine2D(config, 40, 40);
+    });
+    checkModes("3D stencil R_c=2", [](IGSOAPrecision p) {
+        return IGSOAComplexEngine3D(makeConfig(20 * 18 * 16, 2.0, p), 20, 18, 16);
+    });
+
+    // RK stages read the double mirror whatever the setting
+    IGSOAComplexConfig rk = makeConfig(1024, 3.0, IGSOAPrecision::Double);
+    rk.integrator = IGSOAIntegrator::RK4;
+    IGSOAComplexEngine rk_double(rk);
+    rk.precision = IGSOAPrecision::Float;
+    IGSOAComplexEngine rk_float(rk);
+    seed(rk_double);
+    seed(rk_float);
+    rk_double.runMission(20);
+    rk_float.runMission(20);
+    expect(maxDifference(rk_double, rk_float) == 0.0, "RK4 ignores the float mirror");
+
+    // Traffic model: the mirror gather and neighbour reads shrink
+    const IGSOAComplexConfig traffic_double = makeConfig(4096, 3.0, IGSOAPrecision::Double);
+    const IGSOAComplexConfig traffic_float = makeConfig(4096, 3.0, IGSOAPrecision::MixedFloat);
+    const double bytes_double = IGSOAStepTraffic::model(traffic_double, 4096, 1, 6.0, false, false).bytes();
+    const double bytes_float = IGSOAStepTraffic::model(traffic_float, 4096, 1, 6.0, false, false).bytes();
+    expect(bytes_double - bytes_float == 4096.0 * 16.0, "float mirror saves 8 B per node on gather and sweep");
+
+    // Checkpoints carry the setting
+    const std::string path = "/tmp/dase_precision_test_" + std::to_string(getpid()) + ".ckpt";
+    IGSOAComplexEngine saved(makeConfig(256, 3.0, IGSOAPrecision::Float));
+    dase::CheckpointWriter writer;
+    saved.saveCheckpoint(writer);
+    writer.write(path);
+    IGSOAComplexEngine restored(makeConfig(256, 3.0, IGSOAPrecision::Double));
+    restored.restoreCheckpoint(dase::CheckpointImage(path));
+    std::remove(path.c_str());
+    expect(restored.getPrecision() == IGSOAPrecision::Float, "checkpoint restores the precision");
+
+    if (failures == 0) {
+        std::cout << "IGSOA precision: PASS" << std::endl;
+        return 0;
+    }
+    return 1;
+}
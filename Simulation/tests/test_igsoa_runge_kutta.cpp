@@ -0,0 +1,146 @@
+/**
+ * IGSOA Runge-Kutta integrator test
+ *
+ * With Φ held fixed the Ψ equation is linear, so the global error of each
+ * integrator against a fine RK4 reference must shrink by 2 (Euler), 4 (RK2)
+ * and 16 (RK4) when dt halves, and RK4 at 8x the Euler step must still be
+ * more accurate in fewer coupling passes.  The 2D/3D stencil paths must
+ * match the direct coupling loop under the Runge-Kutta stages too.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma tests/test_igsoa_runge_kutta.cpp
+ */
+
+#include "../src/cpp/igsoa_physics.h"
+#include "../src/cpp/igsoa_physics_2d.h"
+#include "../src/cpp/igsoa_physics_3d.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::vector<IGSOAComplexNode> makeNodes(size_t n, double R_c) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<IGSOAComplexNode> nodes(n);
+    for (auto& node : nodes) {
+        node.psi = {dist(rng), dist(rng)};
+        node.phi = 0.5 * dist(rng);
+        node.kappa = 1.0;
+        node.gamma = 0.1;
+        node.R_c = R_c;
+    }
+    return nodes;
+}
+
+// Ψ after `steps` coupling-only steps (Φ fixed); counts coupling passes
+std::vector<IGSOAComplexNode> integrate1D(IGSOAIntegrator integrator, double dt, int steps, int& passes) {
+    auto nodes = makeNodes(32, 3.0);
+    IGSOAStateSoA soa(nodes.size());
+    soa.reserveStages(integrator);
+    for (int s = 0; s < steps; ++s) {
+        IGSOAPhysics::evolveQuantumState(nodes, soa, dt, 1.0, IGSOAUpdateMode::DoubleBuffered, true, integrator);
+    }
+    passes = steps * IGSOARungeKutta::stages(integrator);
+    return nodes;
+}
+
+double maxError(const std::vector<IGSOAComplexNode>& a, const std::vector<IGSOAComplexNode>& b) {
+    double error = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        error = std::max(error, std::abs(a[i].psi - b[i].psi));
+    }
+    return error;
+}
+
+void checkConvergence() {
+    const double T = 0.64;
+    int passes = 0;
+    const auto reference = integrate1D(IGSOAIntegrator::RK4, T / 1024.0, 1024, passes);
+
+    struct Scheme { IGSOAIntegrator integrator; const char* name; double order; };
+    for (const Scheme& scheme : {Scheme{IGSOAIntegrator::Euler, "Euler", 1.0},
+                                 Scheme{IGSOAIntegrator::RK2, "RK2", 2.0},
+                                 Scheme{IGSOAIntegrator::RK4, "RK4", 4.0}}) {
+        const double coarse = maxError(integrate1D(scheme.integrator, T / 16.0, 16, passes), reference);
+        const double fine = maxError(integrate1D(scheme.integrator, T / 32.0, 32, passes), reference);
+        const double observed = std::log2(coarse / fine);
+        std::cout << "  " << scheme.name << ": error " << coarse << " -> " << fine
+                  << ", order " << observed << std::endl;
+        expect(std::abs(observed - scheme.order) < 0.25, std::string(scheme.name) + " convergence order");
+    }
+
+    int euler_passes = 0, rk4_passes = 0;
+    const double euler = maxError(integrate1D(IGSOAIntegrator::Euler, T / 128.0, 128, euler_passes), reference);
+    const double rk4 = maxError(integrate1D(IGSOAIntegrator::RK4, T / 16.0, 16, rk4_passes), reference);
+    expect(rk4 < euler && rk4_passes < euler_passes, "RK4 at 8x dt beats Euler in fewer passes");
+}
+
+void checkStencilPaths() {
+    IGSOAComplexConfig config;
+    config.dt = 0.05;
+    config.normalize_psi = false;
+    config.update_mode = IGSOAUpdateMode::DoubleBuffered;
+
+    for (IGSOAIntegrator integrator : {IGSOAIntegrator::RK2, IGSOAIntegrator::RK4}) {
+        config.integrator = integrator;
+        const std::string name = integrator == IGSOAIntegrator::RK2 ? "RK2" : "RK4";
+
+        const size_t N_x = 12, N_y = 10;
+        auto direct_2d = makeNodes(N_x * N_y, 2.0);
+        auto stencil_2d = direct_2d;
+        NeighborStencil2D table_2d;
+        table_2d.build(N_x, N_y, 2.0);
+        IGSOAStateSoA soa_direct(direct_2d.size()), soa_stencil(stencil_2d.size());
+        for (int s = 0; s < 5; ++s) {
+            IGSOAPhysics2D::timeStep(direct_2d, soa_direct, config, N_x, N_y);
+            IGSOAPhysics2D::timeStep(stencil_2d, soa_stencil, config, N_x, N_y, &table_2d);
+        }
+        expect(maxError(direct_2d, stencil_2d) < 1e-12, "2D " + name + " stencil matches direct");
+
+        const size_t M = 8;
+        auto direct_3d = makeNodes(M * M * M, 1.0);
+        auto stencil_3d = direct_3d;
+        NeighborStencil3D table_3d;
+        table_3d.build(M, M, M, 1.0);
+        IGSOAStateSoA soa_direct_3d(direct_3d.size()), soa_stencil_3d(stencil_3d.size());
+        for (int s = 0; s < 5; ++s) {
+            IGSOAPhysics3D::timeStep(direct_3d, soa_direct_3d, config, M, M, M);
+            IGSOAPhysics3D::timeStep(stencil_3d, soa_stencil_3d, config, M, M, M, &table_3d);
+        }
+        expect(maxError(direct_3d, stencil_3d) < 1e-12, "3D " + name + " stencil matches direct");
+        expect(std::isfinite(std::abs(stencil_3d[0].psi)), "3D " + name + " stays finite");
+    }
+
+    // Euler never allocates stage buffers
+    IGSOAStateSoA euler_soa(64);
+    const size_t before = euler_soa.memoryBytes();
+    euler_soa.reserveStages(IGSOAIntegrator::Euler);
+    expect(euler_soa.memoryBytes() == before, "Euler reserves no stage buffers");
+}
+
+} // namespace
+
+int main() {
+    checkConvergence();
+    checkStencilPaths();
+
+    if (failures == 0) {
+        std::cout << "Runge-Kutta integrators: PASS" << std::endl;
+        return 0;
+    }
+    return 1;
+}
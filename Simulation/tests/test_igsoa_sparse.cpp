@@ -0,0 +1,170 @@
+/**
+ * IGSOA sparse evolution test
+ *
+ * A localized Gaussian packet on mostly empty 2D/3D lattices, stepped with
+ * an activity mask (config.sparse_threshold), must track the dense mission
+ * within the threshold while skipping more than half of the node updates,
+ * for both update modes.  Threshold 0, RK4 and normalize_psi must run
+ * dense (bit-identical, skipped fraction 0), and the settings must survive
+ * a checkpoint.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_igsoa_sparse.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+IGSOAComplexConfig makeConfig(size_t nodes, IGSOAUpdateMode mode) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(nodes);
+    config.R_c_default = 2.0;
+    config.dt = 0.01;
+    config.normalize_psi = false;
+    config.update_mode = mode;
+    config.coupling_mode = IGSOACouplingMode::Stencil;
+    config.fft_min_R_c = 1.0e9;
+    return config;
+}
+
+template <typename Engine>
+double maxDifference(const Engine& a, const Engine& b) {
+    double diff = 0.0;
+    for (size_t i = 0; i < a.getNodes().size(); ++i) {
+        diff = std::max(diff, std::abs(a.getNodes()[i].psi - b.getNodes()[i].psi));
+        diff = std::max(diff, std::abs(a.getNodes()[i].phi - b.getNodes()[i].phi));
+    }
+    return diff;
+}
+
+void test2D(IGSOAUpdateMode mode, const std::string& label) {
+    const size_t n = 96;
+    const double threshold = 1.0e-8;
+    IGSOAComplexEngine2D dense(makeConfig(n * n, mode), n, n);
+    IGSOAComplexEngine2D sparse(makeConfig(n * n, mode), n, n);
+    IGSOAStateInit2D::initCircularGaussian(dense, 1.0, 48.0, 48.0, 2.0);
+    IGSOAStateInit2D::initCircularGaussian(sparse, 1.0, 48.0, 48.0, 2.0);
+    sparse.setSparseEvolution(threshold, 8);
+
+    dense.runMission(100);
+    sparse.runMission(100);
+    const double fraction = sparse.getSparseSkippedFraction();
+    const double diff = maxDifference(sparse, dense);
+    expect(fraction > 0.5, label + ": more than half of the updates skipped (" + std::to_string(fraction) + ")");
+    expect(diff < threshold, label + ": tracks the dense mission (max diff " + std::to_string(diff) + ")");
+    expect(dense.getSparseSkippedFraction() == 0.0, label + ": dense mission skips nothing");
+    expect(std::abs(sparse.getTotalEnergy() - dense.getTotalEnergy()) < 1.0e-9 * dense.getTotalEnergy(),
+           label + ": total energy");
+}
+
+void test3D(IGSOAUpdateMode mode, const std::string& label) {
+    const size_t n = 32;
+    const double threshold = 1.0e-4;
+    IGSOAComplexConfig config = makeConfig(n * n * n, mode);
+    config.R_c_default = 1.0;
+    IGSOAComplexEngine3D dense(config, n, n, n);
+    IGSOAComplexEngine3D sparse(config, n, n, n);
+    IGSOAStateInit3D::initSphericalGaussian(dense, 1.0, 16.0, 16.0, 16.0, 1.5);
+    IGSOAStateInit3D::initSphericalGaussian(sparse, 1.0, 16.0, 16.0, 16.0, 1.5);
+    sparse.setSparseEvolution(threshold, 4);
+
+    dense.runMission(50);
+    sparse.runMission(50);
+    const double fraction = sparse.getSparseSkippedFraction();
+    const double diff = maxDifference(sparse, dense);
+    expect(fraction > 0.5, label + ": more than half of the updates skipped (" + std::to_string(fraction) + ")");
+    expect(diff < threshold, label + ": tracks the dense mission (max diff " + std::to_string(diff) + ")");
+}
+
+void testDenseFallbacks() {
+    const size_t n = 48;
+    IGSOAComplexConfig base = makeConfig(n * n, IGSOAUpdateMode::DoubleBuffered);
+
+    // Threshold 0 is the dense path
+    IGSOAComplexEngine2D reference(base, n, n);
+    IGSOAComplexEngine2D zero(base, n, n);
+    IGSOAStateInit2D::initCircularGaussian(reference, 1.0, 24.0, 24.0, 2.0);
+    IGSOAStateInit2D::initCircularGaussian(zero, 1.0, 24.0, 24.0, 2.0);
+    zero.setSparseEvolution(0.0);
+    reference.runMission(20);
+    zero.runMission(20);
+    expect(maxDifference(zero, reference) == 0.0, "threshold 0 is bit-identical to dense");
+
+    // RK4 and per-node normalization ignore the mask
+    IGSOAComplexConfig rk = base;
+    rk.integrator = IGSOAIntegrator::RK4;
+    rk.sparse_threshold = 1.0e-6;
+    IGSOAComplexEngine2D rk_engine(rk, n, n);
+    IGSOAStateInit2D::initCircularGaussian(rk_engine, 1.0, 24.0, 24.0, 2.0);
+    rk_engine.runMission(5);
+    expect(rk_engine.getSparseSkippedFraction() == 0.0, "RK4 missions run dense");
+
+    IGSOAComplexConfig normalized = base;
+    normalized.normalize_psi = true;
+    normalized.sparse_threshold = 1.0e-6;
+    IGSOAComplexEngine2D normalized_engine(normalized, n, n);
+    IGSOAStateInit2D::initCircularGaussian(normalized_engine, 1.0, 24.0, 24.0, 2.0);
+    normalized_engine.runMission(5);
+    expect(normalized_engine.getSparseSkippedFraction() == 0.0, "normalize_psi missions run dense");
+
+    IGSOAComplexConfig invalid = base;
+    invalid.sparse_block = 0;
+    expect(!invalid.validate(), "sparse_block 0 is rejected");
+    invalid.sparse_block = 8;
+    invalid.sparse_threshold = -1.0;
+    expect(!invalid.validate(), "negative sparse_threshold is rejected");
+}
+
+void testCheckpoint() {
+    const size_t n = 16;
+    IGSOAComplexEngine2D source(makeConfig(n * n, IGSOAUpdateMode::DoubleBuffered), n, n);
+    IGSOAComplexEngine2D target(makeConfig(n * n, IGSOAUpdateMode::DoubleBuffered), n, n);
+    source.setSparseEvolution(1.0e-5, 4);
+    const std::string path = "/tmp/dase_sparse_test_" + std::to_string(getpid()) + ".ckpt";
+    dase::CheckpointWriter writer;
+    source.saveCheckpoint(writer);
+    writer.write(path);
+    target.restoreCheckpoint(dase::CheckpointImage(path));
+    std::remove(path.c_str());
+    expect(target.getSparseThreshold() == 1.0e-5 && target.getSparseBlock() == 4,
+           "sparse settings survive a checkpoint");
+}
+
+} // namespace
+
+int main() {
+    test2D(IGSOAUpdateMode::DoubleBuffered, "2D DoubleBuffered");
+    test2D(IGSOAUpdateMode::InPlace, "2D InPlace");
+    test3D(IGSOAUpdateMode::DoubleBuffered, "3D DoubleBuffered");
+    test3D(IGSOAUpdateMode::InPlace, "3D InPlace");
+    testDenseFallbacks();
+    testCheckpoint();
+
+    if (failures != 0) {
+        std::cerr << "test_igsoa_sparse: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_igsoa_sparse: PASS" << std::endl;
+    return 0;
+}
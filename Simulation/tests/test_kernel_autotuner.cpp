@@ -0,0 +1,107 @@
+/**
+ * Kernel autotuner test
+ *
+ * tune must time every candidate on a miss and keep the fastest, take a
+ * stored choice without timing anything, and re-time with force.  Stored
+ * choices must survive a reload of the database file, and keys must
+ * differ by engine shape and R_c and carry the host fingerprint.
+ *
+ * Build: g++ -std=c++17 -fopenmp tests/test_kernel_autotuner.cpp
+ */
+
+#include "../src/cpp/kernel_autotuner.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+bool ok = true;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ok = false;
+    }
+}
+
+std::vector<KernelTuning> makeCandidates() {
+    std::vector<KernelTuning> candidates;
+    for (int variant = 0; variant < 2; ++variant) {
+        for (uint32_t block : {1u, 4u, 8u}) {
+            KernelTuning candidate;
+            candidate.variant = variant;
+            candidate.temporal_block_steps = block;
+            candidate.threads = variant == 0 ? 0 : 2;
+            candidates.push_back(candidate);
+        }
+    }
+    return candidates;
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "test_kernel_tuning.tmp/kernel_tuning.txt";
+    std::remove(path.c_str());
+    KernelAutotuner::initialize(path);
+    expect(KernelAutotuner::size() == 0, "empty database");
+
+    const size_t dims[3] = {64, 32, 1};
+    const std::string key = KernelAutotuner::key("igsoa_complex_2d", dims, 3.0);
+    expect(key.find(KernelAutotuner::hostFingerprint()) != std::string::npos, "key carries the host");
+    const size_t other_dims[3] = {64, 64, 1};
+    expect(key != KernelAutotuner::key("igsoa_complex_2d", other_dims, 3.0), "key differs by shape");
+    expect(key != KernelAutotuner::key("igsoa_complex_2d", dims, 4.0), "key differs by R_c");
+
+    const std::vector<KernelTuning> candidates = makeCandidates();
+    int timed = 0;
+    // Fastest: variant 1, block 1
+    auto measure = [&](const KernelTuning& candidate) {
+        timed++;
+        return 100.0 + 10.0 * candidate.temporal_block_steps - 50.0 * candidate.variant;
+    };
+
+    bool measured = false;
+    KernelTuning best = KernelAutotuner::tune(key, candidates, measure, false, measured);
+    expect(measured && timed == static_cast<int>(candidates.size()), "miss times every candidate");
+    expect(best.variant == 1 && best.temporal_block_steps == 1 && best.threads == 2, "fastest candidate chosen");
+    expect(best.ns_per_step == 60.0, "chosen time kept");
+
+    timed = 0;
+    best = KernelAutotuner::tune(key, candidates, measure, false, measured);
+    expect(!measured && timed == 0 && best.variant == 1, "stored choice taken without timing");
+
+    // Reload from disk
+    KernelAutotuner::initialize(path);
+    KernelTuning loaded;
+    expect(KernelAutotuner::lookup(key, loaded), "choice persisted");
+    expect(loaded.variant == 1 && loaded.temporal_block_steps == 1 && loaded.threads == 2 &&
+           loaded.ns_per_step == 60.0, "persisted choice round-trips");
+
+    // Force re-times and replaces the stored choice
+    timed = 0;
+    auto slower_variant = [&](const KernelTuning& candidate) {
+        timed++;
+        return 100.0 + 50.0 * candidate.variant - static_cast<double>(candidate.temporal_block_steps);
+    };
+    best = KernelAutotuner::tune(key, candidates, slower_variant, true, measured);
+    expect(measured && timed == static_cast<int>(candidates.size()), "force re-times");
+    expect(best.variant == 0 && best.temporal_block_steps == 8, "force replaces the choice");
+    KernelAutotuner::initialize(path);
+    expect(KernelAutotuner::lookup(key, loaded) && loaded.temporal_block_steps == 8 && KernelAutotuner::size() == 1,
+           "forced choice persisted");
+
+    std::remove(path.c_str());
+    std::remove("test_kernel_tuning.tmp");
+
+    if (!ok) {
+        std::cerr << "test_kernel_autotuner: FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "test_kernel_autotuner: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * Kernel cache batch evaluation test
+ *
+ * KernelCache::evaluateBatch (double and float) must match the scalar
+ * evaluateInterpolated form to round-off on the AVX2 path and for every
+ * tail length, stay within the interpolation error of the exact kernel,
+ * return 0 outside (0, R_c], and NeighborCache2D weights must come out of
+ * the batch path.
+ *
+ * Build: g++ -std=c++17 -O2 -Isrc/cpp tests/test_kernel_cache.cpp
+ */
+
+#include "../src/cpp/kernel_cache.h"
+#include "../src/cpp/neighbor_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+double exactKernel(double r, double R_c) {
+    return (r <= 0.0 || r > R_c) ? 0.0 : std::exp(-r / R_c) / R_c;
+}
+
+void testBatch(double R_c) {
+    const std::string label = "R_c " + std::to_string(R_c);
+    KernelCache cache(R_c, 1024);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> uniform(-0.1 * R_c, 1.1 * R_c);
+    std::vector<double> distances(1003);
+    for (double& d : distances) {
+        d = uniform(rng);
+    }
+    distances[0] = 0.0;
+    distances[1] = R_c;
+    distances[2] = 0.25 * R_c;
+    distances[3] = std::nextafter(R_c, 2.0 * R_c);
+
+    std::vector<double> simd(distances.size());
+    std::vector<double> scalar(distances.size());
+    cache.evaluateBatch(distances.data(), simd.data(), distances.size());
+    cache.evaluateBatch(distances.data(), scalar.data(), distances.size(), false);
+
+    double simd_error = 0.0;
+    double exact_error = 0.0;
+    bool range_ok = true;
+    for (size_t m = 0; m < distances.size(); ++m) {
+        const double exact = exactKernel(distances[m], R_c);
+        simd_error = std::max(simd_error, std::abs(simd[m] - scalar[m]) * R_c);
+        exact_error = std::max(exact_error, std::abs(scalar[m] - exact) * R_c);
+        if (exact == 0.0) {
+            range_ok = range_ok && simd[m] == 0.0 && scalar[m] == 0.0;
+        }
+        if (distances[m] > 0.0 && distances[m] < 0.25 * R_c) {
+            range_ok = range_ok && scalar[m] == exact;
+        }
+    }
+    expect(simd_error < 1.0e-14, label + ": AVX2 matches scalar (" + std::to_string(simd_error) + ")");
+    expect(exact_error < 2.0e-7, label + ": interpolation error (" + std::to_string(exact_error) + ")");
+    expect(range_ok, label + ": zero outside (0, R_c], tier 1 exact");
+
+    // Every tail length
+    bool tails_ok = true;
+    for (size_t n = 0; n < 10; ++n) {
+        std::vector<double> out(n, -1.0);
+        cache.evaluateBatch(distances.data() + 5, out.data(), n);
+        for (size_t m = 0; m < n; ++m) {
+            tails_ok = tails_ok && std::abs(out[m] - scalar[5 + m]) * R_c < 1.0e-14;
+        }
+    }
+    expect(tails_ok, label + ": tail lengths");
+
+    // Float variant
+    std::vector<float> distances32(distances.begin(), distances.end());
+    std::vector<float> out32(distances.size());
+    cache.evaluateBatch(distances32.data(), out32.data(), distances32.size());
+    double float_error = 0.0;
+    for (size_t m = 0; m < distances.size(); ++m) {
+        const double reference = cache.evaluateInterpolated(static_cast<double>(distances32[m]));
+        float_error = std::max(float_error, std::abs(static_cast<double>(out32[m]) - reference) * R_c);
+    }
+    expect(float_error < 1.0e-7, label + ": float batch (" + std::to_string(float_error) + ")");
+}
+
+void testNeighborCacheWeights() {
+    // A unit Ψ at one neighbour isolates its weight in computeCoupling
+    const double R_c = 3.0;
+    NeighborCache2D cache(12, 12, R_c);
+    cache.build();
+    KernelCache reference(R_c, 1024);
+    const size_t i = 6 * 12 + 6;
+    expect(cache.getNeighborCount(i) == 28, "interior neighbour count");
+    bool weights_ok = true;
+    for (int offset : {1, 13, 2, 26, 3}) {
+        std::vector<IGSOAComplexNode> nodes(144);
+        for (auto& node : nodes) {
+            node.psi = 0.0;
+        }
+        nodes[i + offset].psi = 1.0;
+        const int dx = offset % 12 > 6 ? offset % 12 - 12 : offset % 12;
+        const int dy = (offset - dx) / 12;
+        const double expected = reference.evaluateInterpolated(std::sqrt(static_cast<double>(dx * dx + dy * dy)));
+        weights_ok = weights_ok && std::abs(cache.computeCoupling(i, nodes).real() - expected) < 1.0e-15;
+    }
+    expect(weights_ok, "cache weights come from the batch path");
+}
+
+} // namespace
+
+int main() {
+    testBatch(1.0);
+    testBatch(3.7);
+    testBatch(24.0);
+    testNeighborCacheWeights();
+
+    if (failures != 0) {
+        std::cerr << "test_kernel_cache: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_kernel_cache: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * Kernel traffic model test
+ *
+ * The per-step bytes / FLOPs model must scale with lattice size and
+ * coupling reach, follow the storage layout (SATP 3D tiled SoA moves less
+ * than the AoS reference), and produce achieved rates only after a timed
+ * mission.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma tests/test_kernel_traffic.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_physics_3d.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace dase;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+KernelRoofline igsoa2D(size_t side, double R_c, uint64_t steps) {
+    igsoa::IGSOAComplexConfig config;
+    config.num_nodes = side * side;
+    config.R_c_default = R_c;
+    igsoa::IGSOAComplexEngine2D engine(config, side, side);
+    igsoa::IGSOAStateInit2D::initCircularGaussian(engine, 1.0, side / 2.0, side / 2.0, 3.0, 0.0, "overwrite", 1.0);
+    engine.runMission(steps);
+    return engine.getRoofline();
+}
+
+} // namespace
+
+int main() {
+    // Before any mission the model is empty and no rates are reported
+    {
+        igsoa::IGSOAComplexConfig config;
+        config.num_nodes = 16 * 16;
+        igsoa::IGSOAComplexEngine2D engine(config, 16, 16);
+        expect(!engine.getRoofline().valid, "IGSOA roofline invalid before a mission");
+    }
+
+    const KernelRoofline small = igsoa2D(32, 2.0, 4);
+    const KernelRoofline large = igsoa2D(64, 2.0, 4);
+    const KernelRoofline wide = igsoa2D(32, 4.0, 4);
+    expect(small.valid && small.achieved_gbps > 0.0 && small.achieved_gflops > 0.0, "IGSOA rates after a mission");
+    expect(std::fabs(large.bytes_per_step / small.bytes_per_step - 4.0) < 1e-9, "IGSOA bytes scale with nodes");
+    expect(wide.flops_per_step > small.flops_per_step, "IGSOA FLOPs grow with R_c");
+    expect(wide.bytes_per_step == small.bytes_per_step, "IGSOA bytes independent of R_c (neighbours cached)");
+    expect(wide.arithmetic_intensity > small.arithmetic_intensity, "IGSOA intensity grows with R_c");
+
+    satp_higgs::SATPHiggsParams params;
+    satp_higgs::SATPHiggsEngine3D engine(16, 16, 16, 0.1, 0.01, params);
+    expect(!engine.getRoofline().valid, "SATP roofline invalid before evolve");
+    engine.evolve(3);
+    const KernelRoofline reference = engine.getRoofline();
+    engine.setStencilMode(satp_higgs::SATPStencilMode::Tiled);
+    engine.evolve(3);
+    const KernelRoofline tiled = engine.getRoofline();
+    expect(reference.valid && tiled.valid, "SATP rates after evolve");
+    expect(tiled.bytes_per_step < reference.bytes_per_step, "SATP tiled SoA moves fewer bytes");
+
+    if (failures == 0) {
+        std::cout << "Kernel traffic: IGSOA 2D " << small.achieved_gbps << " GB/s, "
+                  << small.achieved_gflops << " GFLOP/s, AI " << small.arithmetic_intensity
+                  << "; SATP 3D tiled AI " << tiled.arithmetic_intensity << ", PASS" << std::endl;
+        return 0;
+    }
+    return 1;
+}
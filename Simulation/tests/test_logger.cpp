@@ -2,7 +2,8 @@
  * @file test_logger.cpp
  * @brief Test the Logger utility class
  *
- * Tests basic logging functionality, log levels, and file output.
+ * Tests basic logging functionality, log levels, file output, async mode
+ * and lazy message evaluation.
  */
 
 #include "utils/logger.h"
@@ -11,6 +12,8 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <cstdio>
+#include <vector>
 
 using namespace igsoa;
 
@@ -135,6 +138,82 @@ void verifyLogFile() {
     }
 }
 
+int countLines(const std::string& path, const std::string& needle) {
+    std::ifstream file(path);
+    int count = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.find(needle) != std::string::npos) count++;
+    }
+    return count;
+}
+
+bool testAsyncLogging() {
+    std::cout << "\n=== Test 7: Async Logging ===\n";
+
+    const std::string path = "test_logger_async.log";
+    std::remove(path.c_str());
+    Logger& logger = Logger::getInstance();
+    logger.initialize(path, Logger::Level::FATAL, Logger::Level::DEBUG);
+    // A small ring so some records take the synchronous fallback
+    logger.startAsync(64);
+
+    const int threads = 8;
+    const int per_thread = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([t] {
+            for (int i = 0; i < per_thread; i++) {
+                LOG_INFO("async thread " + std::to_string(t) + " message " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    logger.flush();
+    const int flushed = countLines(path, "async thread");
+    logger.shutdown();
+    const int total = countLines(path, "async thread");
+
+    if (flushed != threads * per_thread || total != threads * per_thread) {
+        std::cerr << "✗ Test 7 FAILED: expected " << threads * per_thread << " records, found "
+                  << flushed << " after flush and " << total << " after shutdown\n";
+        return false;
+    }
+    std::remove(path.c_str());
+    std::cout << "✓ Test 7 passed: " << total << " async records written\n";
+    return true;
+}
+
+int evaluations = 0;
+
+std::string countedMessage() {
+    evaluations++;
+    return "counted message";
+}
+
+bool testLazyEvaluation() {
+    std::cout << "\n=== Test 8: Lazy Message Evaluation ===\n";
+
+    const std::string path = "test_logger_lazy.log";
+    Logger& logger = Logger::getInstance();
+    logger.initialize(path, Logger::Level::FATAL, Logger::Level::WARNING);
+
+    LOG_DEBUG(countedMessage());
+    LOG_INFO(countedMessage());
+    LOG_WARNING(countedMessage());
+    logger.shutdown();
+    std::remove(path.c_str());
+
+    if (evaluations != 1) {
+        std::cerr << "✗ Test 8 FAILED: message built " << evaluations
+                  << " times, expected once (WARNING only)\n";
+        return false;
+    }
+    std::cout << "✓ Test 8 passed: disabled levels skip the message\n";
+    return true;
+}
+
 int main() {
     std::cout << "========================================\n";
     std::cout << "Logger Test Suite\n";
@@ -147,6 +226,9 @@ int main() {
         testWithNumbers();
         testThreadSafety();
         verifyLogFile();
+        if (!testAsyncLogging() || !testLazyEvaluation()) {
+            return 1;
+        }
 
         std::cout << "\n========================================\n";
         std::cout << "✓ ALL TESTS PASSED!\n";
@@ -0,0 +1,205 @@
+/**
+ * Mission executor test
+ *
+ * An AsyncMission must run its steps in chunks on a pool worker, report
+ * progress at its cadence, and finish exactly once: completed, cancelled
+ * (while queued, or between chunks while running), failed with the step's
+ * error, or short when a chunk runs fewer steps.  Several missions must
+ * run at once on one executor, each inside a thread budget lease, and
+ * shutdown() must cancel whatever is left.
+ *
+ * Build: g++ -std=c++17 -fopenmp -pthread tests/test_mission_executor.cpp
+ */
+
+#include "../src/cpp/mission_executor.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+bool ok = true;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ok = false;
+    }
+}
+
+void sleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void testCompletesInChunks() {
+    MissionExecutor executor(2);
+    std::vector<uint64_t> chunks;
+    std::vector<uint64_t> reports;
+    int finishes = 0;
+    auto mission = std::make_shared<AsyncMission>(100, 16, [&](uint64_t first, uint64_t steps) {
+        chunks.push_back(first);
+        return steps;
+    });
+    mission->setProgress(32, [&](uint64_t done) {
+        reports.push_back(done);
+        return true;
+    });
+    mission->setOnFinish([&](AsyncMission& m) {
+        finishes++;
+        expect(m.state() == MissionState::Completed, "state is final when onFinish runs");
+    });
+    executor.submit(mission);
+    expect(mission->wait(10.0), "mission finishes");
+    expect(mission->state() == MissionState::Completed && mission->stepsDone() == 100, "all steps run");
+    expect(chunks.size() == 7 && chunks[1] == 16 && chunks[6] == 96, "chunks cover the mission in order");
+    expect(reports == std::vector<uint64_t>({32, 64, 96, 100}), "progress every 32 steps and at the end");
+    expect(finishes == 1, "onFinish runs once");
+    expect(!mission->cancel(), "cancel after completion is refused");
+}
+
+void testCancelRunning() {
+    MissionExecutor executor(1);
+    std::atomic<bool> started{false};
+    auto mission = std::make_shared<AsyncMission>(1000000, 1, [&](uint64_t, uint64_t steps) {
+        started = true;
+        sleepMs(1);
+        return steps;
+    });
+    executor.submit(mission);
+    while (!started) {
+        sleepMs(1);
+    }
+    expect(!mission->wait(0.01), "wait times out while running");
+    expect(mission->cancel(), "running mission accepts cancel");
+    expect(mission->wait(10.0) && mission->state() == MissionState::Cancelled, "running mission stops");
+    expect(mission->stepsDone() > 0 && mission->stepsDone() < 1000000, "cancelled between chunks");
+}
+
+void testCancelQueued() {
+    MissionExecutor executor(1);
+    std::atomic<bool> release{false};
+    auto blocker = std::make_shared<AsyncMission>(1, 0, [&](uint64_t, uint64_t steps) {
+        while (!release) {
+            sleepMs(1);
+        }
+        return steps;
+    });
+    bool queued_ran = false;
+    int finishes = 0;
+    auto queued = std::make_shared<AsyncMission>(10, 0, [&](uint64_t, uint64_t steps) {
+        queued_ran = true;
+        return steps;
+    });
+    queued->setOnFinish([&](AsyncMission&) { finishes++; });
+    executor.submit(blocker);
+    executor.submit(queued);
+    expect(queued->state() == MissionState::Queued, "second mission waits for the only worker");
+    expect(queued->cancel() && queued->done(), "queued mission cancelled at once");
+    release = true;
+    expect(blocker->wait(10.0), "blocking mission finishes");
+    sleepMs(20);
+    expect(!queued_ran && finishes == 1 && queued->state() == MissionState::Cancelled,
+           "cancelled queued mission never starts");
+}
+
+void testFailureShortAndProgressStop() {
+    MissionExecutor executor(2);
+    auto failing = std::make_shared<AsyncMission>(10, 2, [](uint64_t first, uint64_t steps) -> uint64_t {
+        if (first >= 4) {
+            throw std::runtime_error("diverged");
+        }
+        return steps;
+    });
+    auto short_mission = std::make_shared<AsyncMission>(50, 10, [](uint64_t first, uint64_t steps) {
+        return first == 20 ? uint64_t(3) : steps;   // e.g. an observable trigger
+    });
+    auto stopped = std::make_shared<AsyncMission>(100, 10, [](uint64_t, uint64_t steps) { return steps; });
+    stopped->setProgress(10, [](uint64_t done) { return done < 30; });
+
+    executor.submit(failing);
+    executor.submit(short_mission);
+    executor.submit(stopped);
+    expect(failing->wait(10.0) && failing->state() == MissionState::Failed && failing->error() == "diverged" &&
+           failing->stepsDone() == 4, "step exception fails the mission");
+    expect(short_mission->wait(10.0) && short_mission->state() == MissionState::Completed &&
+           short_mission->stepsDone() == 23, "short chunk ends the mission");
+    expect(stopped->wait(10.0) && stopped->state() == MissionState::Cancelled && stopped->stepsDone() == 30,
+           "progress returning false cancels");
+}
+
+void testConcurrentMissionsShareBudget() {
+    MissionExecutor executor(4);
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> leased{0};
+    std::vector<std::shared_ptr<AsyncMission>> missions;
+    for (int i = 0; i < 4; ++i) {
+        auto mission = std::make_shared<AsyncMission>(20, 1, [&](uint64_t first, uint64_t steps) {
+            if (first == 0) {
+                const int now = ++running;
+                int expected = peak.load();
+                while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+                }
+                if (ThreadBudget::process().stats().holders > 0) {
+                    leased++;
+                }
+            }
+            sleepMs(2);
+            if (first == 19) {
+                running--;
+            }
+            return steps;
+        });
+        missions.push_back(mission);
+        executor.submit(mission);
+    }
+    for (const auto& mission : missions) {
+        expect(mission->wait(10.0) && mission->state() == MissionState::Completed, "concurrent mission completes");
+    }
+    expect(peak > 1, "missions run at the same time");
+    expect(leased == 4, "every mission runs inside a thread budget lease");
+    expect(executor.pending() == 0, "nothing pending afterwards");
+}
+
+void testShutdown() {
+    MissionExecutor executor(1);
+    auto running = std::make_shared<AsyncMission>(1000000, 1, [](uint64_t, uint64_t steps) {
+        sleepMs(1);
+        return steps;
+    });
+    auto queued = std::make_shared<AsyncMission>(10, 0, [](uint64_t, uint64_t steps) { return steps; });
+    executor.submit(running);
+    executor.submit(queued);
+    sleepMs(10);
+    executor.shutdown();
+    expect(running->done() && running->state() == MissionState::Cancelled, "shutdown cancels a running mission");
+    expect(queued->state() == MissionState::Cancelled && queued->stepsDone() == 0,
+           "shutdown cancels a queued mission");
+    auto late = std::make_shared<AsyncMission>(10, 0, [](uint64_t, uint64_t steps) { return steps; });
+    executor.submit(late);
+    expect(late->state() == MissionState::Cancelled, "submission after shutdown is cancelled");
+}
+
+} // namespace
+
+int main() {
+    testCompletesInChunks();
+    testCancelRunning();
+    testCancelQueued();
+    testFailureShortAndProgressStop();
+    testConcurrentMissionsShareBudget();
+    testShutdown();
+
+    if (!ok) {
+        std::cerr << "test_mission_executor: FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "test_mission_executor: PASS" << std::endl;
+    return 0;
+}
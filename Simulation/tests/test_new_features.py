@@ -90,6 +90,32 @@ except Exception as e:
     import traceback
     traceback.print_exc()
 
+# Test 4b: Batched Filter
+print("\n[4b] Batched Frequency Domain Filter Test:")
+try:
+    import numpy as np
+    blocks = np.array([[math.sin(2 * math.pi * i / (8 + b)) for i in range(256)]
+                       for b in range(16)], dtype=np.float32)
+    expected = np.array([node.process_block_frequency_domain(list(row)) for row in blocks],
+                        dtype=np.float32)
+
+    start = time.perf_counter()
+    node.process_blocks_frequency_domain_np(blocks)
+    elapsed = time.perf_counter() - start
+
+    print(f"    Blocks: {blocks.shape[0]} x {blocks.shape[1]} samples")
+    print(f"    Processing time: {elapsed*1000:.3f} ms")
+    max_diff = float(np.max(np.abs(blocks - expected)))
+    if max_diff < 1e-5:
+        print(f"    PASSED: Batched filter matches per-block filter (max diff {max_diff:.2e})")
+    else:
+        print(f"    FAILED: Batched filter differs by {max_diff:.2e}")
+
+except Exception as e:
+    print(f"    FAILED: {e}")
+    import traceback
+    traceback.print_exc()
+
 # Test 5: Basic Operations Still Work
 print("\n[5] Verify Basic Operations Still Work:")
 try:
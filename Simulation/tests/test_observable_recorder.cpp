@@ -0,0 +1,374 @@
+/**
+ * Observable recorder test
+ *
+ * Every ObservableRecorder kind must match a direct reduction of the same
+ * box (sub-boxes of a 3D lattice, a correlation across two fields and
+ * regions, the circular centre of mass), keep the newest `capacity`
+ * samples at its decimation and drain oldest first, and give bit-identical
+ * values on one thread and several.  Observables on IGSOA 1D/2D/3D engines
+ * must report the reductions that one-step missions read back, and invalid
+ * specs must be rejected.  Triggers must fire on the sample their condition
+ * (held for `hold` samples) first holds, and a Stop trigger must end an
+ * engine's mission on that step.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_observable_recorder.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include "../src/cpp/observable_recorder.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase;
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool near(double a, double b, double tolerance) {
+    return std::fabs(a - b) <= tolerance * std::max(1.0, std::fabs(b));
+}
+
+IGSOAComplexConfig makeConfig(size_t nodes) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(nodes);
+    config.R_c_default = 2.0;
+    config.dt = 0.01;
+    config.update_mode = IGSOAUpdateMode::DoubleBuffered;
+    config.omp_min_nodes = 0;
+    return config;
+}
+
+ObservableBox makeBox(size_t x0, size_t y0, size_t z0, size_t nx, size_t ny, size_t nz) {
+    ObservableBox box;
+    box.x0 = x0;
+    box.y0 = y0;
+    box.z0 = z0;
+    box.nx = nx;
+    box.ny = ny;
+    box.nz = nz;
+    return box;
+}
+
+ObservableSpec makeSpec(ObservableKind kind, int field, ObservableBox box = ObservableBox(),
+                        uint32_t decimation = 1, size_t capacity = 16) {
+    ObservableSpec spec;
+    spec.kind = kind;
+    spec.field = field;
+    spec.box = box;
+    spec.decimation = decimation;
+    spec.capacity = capacity;
+    return spec;
+}
+
+// Two fields on a 40 x 30 x 20 lattice (large enough for several sum blocks)
+constexpr size_t kNx = 40, kNy = 30, kNz = 20;
+
+// Minimum-image distance on a ring of n cells
+double wrapped(double a, double b, size_t n) {
+    const double d = std::fabs(a - b);
+    return std::min(d, static_cast<double>(n) - d);
+}
+
+// Field 0: a ripple on a large offset; field 1: a periodic blob at
+// (38, 1, 10), straddling the x and y seams
+double fieldValue(uint64_t i, int field) {
+    const double x = static_cast<double>(i % kNx);
+    const double y = static_cast<double>((i / kNx) % kNy);
+    const double z = static_cast<double>(i / (kNx * kNy));
+    if (field == 0) {
+        return 1000.0 + std::sin(0.3 * x) * std::cos(0.2 * y) + 0.01 * z;
+    }
+    const double dx = wrapped(x, 38.0, kNx);
+    const double dy = wrapped(y, 1.0, kNy);
+    const double dz = wrapped(z, 10.0, kNz);
+    return std::exp(-0.1 * (dx * dx + dy * dy + dz * dz));
+}
+
+template <typename Fn>
+void forBox(const ObservableBox& box, Fn&& fn) {
+    for (size_t z = box.z0; z < box.z0 + box.nz; ++z)
+        for (size_t y = box.y0; y < box.y0 + box.ny; ++y)
+            for (size_t x = box.x0; x < box.x0 + box.nx; ++x)
+                fn((z * kNy + y) * kNx + x);
+}
+
+std::vector<double> evaluateOnce(const ObservableSpec& spec) {
+    ObservableRecorder recorder;
+    const int id = recorder.add(spec, kNx, kNy, kNz, 2);
+    recorder.record(1, fieldValue);
+    std::vector<uint64_t> steps;
+    std::vector<double> values;
+    recorder.drain(id, steps, values);
+    return values;
+}
+
+void testKinds() {
+    const ObservableBox box = makeBox(3, 5, 2, 31, 17, 13);
+    double sum = 0.0, sum_sq = 0.0, lo = 1e300, hi = -1e300;
+    forBox(box, [&](size_t i) {
+        const double v = fieldValue(i, 0);
+        sum += v;
+        sum_sq += (v - 1000.0) * (v - 1000.0);
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+    });
+    const double count = static_cast<double>(box.count());
+    const double mean = sum / count;
+    const double variance = sum_sq / count - (mean - 1000.0) * (mean - 1000.0);
+
+    expect(near(evaluateOnce(makeSpec(ObservableKind::Sum, 0, box))[0], sum, 1e-12), "sum");
+    expect(near(evaluateOnce(makeSpec(ObservableKind::Mean, 0, box))[0], mean, 1e-12), "mean");
+    expect(evaluateOnce(makeSpec(ObservableKind::Min, 0, box))[0] == lo, "min");
+    expect(evaluateOnce(makeSpec(ObservableKind::Max, 0, box))[0] == hi, "max");
+    expect(evaluateOnce(makeSpec(ObservableKind::MaxAbs, 0, box))[0] == hi, "max |v|");
+    const std::vector<double> moments = evaluateOnce(makeSpec(ObservableKind::Moments, 0, box));
+    expect(moments.size() == 2 && near(moments[0], mean, 1e-12) && near(moments[1], variance, 1e-9),
+           "moments without cancellation at a large offset");
+
+    // Correlation of field 0 over `box` against field 1 over a shifted box
+    ObservableSpec correlation = makeSpec(ObservableKind::Correlation, 0, makeBox(0, 0, 0, 20, 10, 10));
+    correlation.other_field = 1;
+    correlation.other_box = makeBox(20, 20, 10, 20, 10, 10);
+    std::vector<double> a, b;
+    forBox(correlation.box, [&](size_t i) { a.push_back(fieldValue(i, 0)); });
+    forBox(correlation.other_box, [&](size_t i) { b.push_back(fieldValue(i, 1)); });
+    double ma = 0.0, mb = 0.0;
+    for (size_t k = 0; k < a.size(); ++k) { ma += a[k]; mb += b[k]; }
+    ma /= static_cast<double>(a.size());
+    mb /= static_cast<double>(b.size());
+    double cab = 0.0, caa = 0.0, cbb = 0.0;
+    for (size_t k = 0; k < a.size(); ++k) {
+        cab += (a[k] - ma) * (b[k] - mb);
+        caa += (a[k] - ma) * (a[k] - ma);
+        cbb += (b[k] - mb) * (b[k] - mb);
+    }
+    expect(near(evaluateOnce(correlation)[0], cab / std::sqrt(caa * cbb), 1e-9), "correlation of two regions");
+    ObservableSpec self = makeSpec(ObservableKind::Correlation, 1, box);
+    expect(near(evaluateOnce(self)[0], 1.0, 1e-12), "self-correlation is 1");
+
+    // The blob straddles the seams, so a plain mean would land mid-box
+    const std::vector<double> com = evaluateOnce(makeSpec(ObservableKind::CenterOfMass, 1));
+    expect(com.size() == 3 && std::fabs(com[0] - 38.0) < 1e-9 && std::fabs(com[1] - 1.0) < 1e-9 &&
+           std::fabs(com[2] - 10.0) < 1e-9, "circular centre of mass across the seams");
+
+#ifdef _OPENMP
+    const int threads = omp_get_max_threads();
+    for (ObservableKind kind : {ObservableKind::Sum, ObservableKind::Moments, ObservableKind::MaxAbs,
+                                ObservableKind::CenterOfMass}) {
+        omp_set_num_threads(1);
+        const std::vector<double> one = evaluateOnce(makeSpec(kind, 1));
+        omp_set_num_threads(4);
+        const std::vector<double> four = evaluateOnce(makeSpec(kind, 1));
+        expect(one == four, "kind " + std::to_string(static_cast<int>(kind)) + " independent of the thread count");
+    }
+    omp_set_num_threads(threads);
+#endif
+}
+
+void testRing() {
+    ObservableRecorder recorder;
+    const int id = recorder.add(makeSpec(ObservableKind::Sum, 0, makeBox(0, 0, 0, 2, 1, 1), 2, 3), 4, 1, 1, 1);
+    expect(id > 0 && recorder.active(), "observable added");
+    expect(recorder.due(4) && !recorder.due(5) && recorder.due(4, 0) && !recorder.due(4, 1), "due at the decimation");
+    for (uint64_t step = 1; step <= 10; ++step) {
+        recorder.record(step, [step](uint64_t i, int) { return static_cast<double>(step * 10 + i); });
+    }
+    expect(recorder.pending(id) == 3, "ring keeps capacity samples");
+    std::vector<uint64_t> steps;
+    std::vector<double> values;
+    uint64_t dropped = 0;
+    expect(recorder.drain(id, steps, values, &dropped), "drained");
+    expect(steps == std::vector<uint64_t>({6, 8, 10}) && values == std::vector<double>({121, 161, 201}) &&
+           dropped == 2, "oldest first, overwritten samples counted");
+    expect(recorder.pending(id) == 0 && recorder.drain(id, steps, values, &dropped) && steps.empty() &&
+           dropped == 0, "drained ring is empty");
+
+    expect(recorder.add(makeSpec(ObservableKind::Sum, 1), 4, 1, 1, 1) == -1, "field out of range rejected");
+    expect(recorder.add(makeSpec(ObservableKind::Sum, 0, makeBox(3, 0, 0, 2, 1, 1)), 4, 1, 1, 1) == -1,
+           "box leaving the lattice rejected");
+    expect(recorder.add(makeSpec(ObservableKind::Sum, 0, ObservableBox(), 0), 4, 1, 1, 1) == -1,
+           "zero decimation rejected");
+    expect(recorder.add(makeSpec(ObservableKind::Sum, 0, ObservableBox(), 1, 0), 4, 1, 1, 1) == -1,
+           "zero capacity rejected");
+    expect(recorder.add(makeSpec(ObservableKind::CenterOfMass, 0, makeBox(0, 0, 0, 2, 1, 1)), 4, 1, 1, 1) == -1,
+           "centre of mass of a sub-box rejected");
+    ObservableSpec mismatched = makeSpec(ObservableKind::Correlation, 0, makeBox(0, 0, 0, 2, 1, 1));
+    mismatched.other_box = makeBox(1, 0, 0, 3, 1, 1);
+    expect(recorder.add(mismatched, 4, 1, 1, 1) == -1, "correlation of boxes of different shapes rejected");
+    expect(recorder.remove(id) && !recorder.active(), "observable removed");
+}
+
+TriggerSpec makeTrigger(int observable, TriggerCondition condition, double threshold,
+                        TriggerAction action = TriggerAction::Stop, uint32_t hold = 1) {
+    TriggerSpec spec;
+    spec.observable = observable;
+    spec.condition = condition;
+    spec.threshold = threshold;
+    spec.action = action;
+    spec.hold = hold;
+    return spec;
+}
+
+void testTriggers() {
+    // One-node sum: the sample is the recorded value itself
+    ObservableRecorder recorder;
+    const int id = recorder.add(makeSpec(ObservableKind::Sum, 0, ObservableBox(), 1, 64), 1, 1, 1, 1);
+    TriggerSpec held = makeTrigger(id, TriggerCondition::Above, 2.5, TriggerAction::Emit, 2);
+    held.repeat = true;
+    const int above = recorder.addTrigger(held);
+    const int down = recorder.addTrigger(makeTrigger(id, TriggerCondition::CrossesDown, 1.5));
+    TriggerSpec drive = makeTrigger(id, TriggerCondition::Settles, 0.25, TriggerAction::Drive);
+    drive.drive_gain = 0.5;
+    drive.repeat = true;
+    const int settles = recorder.addTrigger(drive);
+    expect(above > 0 && down > 0 && settles > 0, "triggers added");
+
+    const double series[] = {1.0, 2.0, 3.0, 4.0, 4.1, 1.0, 0.9, 3.0, 4.0};
+    std::vector<TriggerEvent> events;
+    std::vector<uint64_t> interrupted_at;
+    for (uint64_t step = 1; step <= 9; ++step) {
+        const double v = series[step - 1];
+        recorder.record(step, [v](uint64_t, int) { return v; });
+        if (recorder.interrupted()) {
+            interrupted_at.push_back(step);
+            recorder.takeEvents(events);
+        }
+    }
+    recorder.takeEvents(events);
+    // above: 3.0, 4.0 hold from step 4 (once per run: again at 9);
+    // settles: |4.1 - 4.0| at step 5 and |0.9 - 1.0| at step 7;
+    // crossing down: 4.1 -> 1.0 at step 6
+    expect(events.size() == 5, "five trigger events");
+    if (events.size() == 5) {
+        expect(events[0].trigger == above && events[0].step == 4 && events[0].value == 4.0 &&
+               events[0].action == TriggerAction::Emit, "above fires once held for two samples");
+        expect(events[1].trigger == settles && events[1].step == 5, "settles fires on a small step");
+        expect(events[2].trigger == down && events[2].step == 6 && events[2].action == TriggerAction::Stop,
+               "crossing down fires on the crossing");
+        expect(events[3].trigger == settles && events[3].step == 7, "repeating trigger fires on its next run");
+        expect(events[4].trigger == above && events[4].step == 9, "above fires again on a new run");
+    }
+    expect(interrupted_at == std::vector<uint64_t>({5, 6, 7}), "only non-emit actions interrupt");
+    expect(recorder.driveGain() == 0.5, "drive trigger sets the gain");
+    uint64_t fired = 0;
+    bool armed = true;
+    expect(recorder.triggerState(down, fired, armed) && fired == 1 && !armed, "one-shot trigger disarmed");
+    expect(recorder.triggerState(settles, fired, armed) && fired == 2 && armed, "repeating trigger stays armed");
+    expect(!recorder.interrupted() && recorder.takeEvents(events) == 0, "events taken");
+
+    expect(recorder.addTrigger(makeTrigger(id + 1, TriggerCondition::Above, 0.0)) == -1, "unknown observable rejected");
+    TriggerSpec wide = makeTrigger(id, TriggerCondition::Above, 0.0);
+    wide.component = 1;
+    expect(recorder.addTrigger(wide) == -1, "component past the width rejected");
+    expect(recorder.addTrigger(makeTrigger(id, TriggerCondition::Above, 0.0, TriggerAction::Stop, 0)) == -1,
+           "zero hold rejected");
+    expect(recorder.addTrigger(makeTrigger(id, TriggerCondition::CrossesUp, 0.0, TriggerAction::Stop, 2)) == -1,
+           "held crossing rejected");
+    expect(recorder.addTrigger(makeTrigger(id, TriggerCondition::Settles, 0.0)) == -1,
+           "non-positive settle bound rejected");
+    expect(recorder.addTrigger(makeTrigger(id, TriggerCondition::Above, 0.0, TriggerAction::Snapshot)) == -1,
+           "snapshot without a path rejected");
+    expect(recorder.remove(id) && recorder.triggerIds().empty(), "removing an observable removes its triggers");
+}
+
+// Observables over a mission match reductions of one-step missions
+template <typename Engine, typename Init>
+void testEngine(const std::string& label, size_t N_x, size_t N_y, size_t N_z, Init init) {
+    std::unique_ptr<Engine> observed_engine = init();
+    std::unique_ptr<Engine> stepped_engine = init();
+    Engine& observed = *observed_engine;
+    Engine& stepped = *stepped_engine;
+    const int total = observed.observables().add(
+        makeSpec(ObservableKind::Sum, static_cast<int>(IGSOANodeField::F), ObservableBox(), 3, 64),
+        N_x, N_y, N_z, IGSOABulkAccess::kNumFields);
+    const int peak = observed.observables().add(
+        makeSpec(ObservableKind::MaxAbs, static_cast<int>(IGSOANodeField::Phi), ObservableBox(), 5, 64),
+        N_x, N_y, N_z, IGSOABulkAccess::kNumFields);
+    expect(total > 0 && peak > 0, label + ": observables added");
+    observed.runMission(30);
+
+    std::vector<double> expected_total, expected_peak;
+    for (int step = 1; step <= 30; ++step) {
+        stepped.runMission(1);
+        const auto& nodes = stepped.getNodes();
+        if (step % 3 == 0) {
+            expected_total.push_back(reproducibleSum(static_cast<int64_t>(nodes.size()),
+                [&](int64_t i) { return nodes[static_cast<size_t>(i)].F; }));
+        }
+        if (step % 5 == 0) {
+            double top = 0.0;
+            for (const auto& node : nodes) top = std::max(top, std::fabs(node.phi));
+            expected_peak.push_back(top);
+        }
+    }
+
+    std::vector<uint64_t> steps;
+    std::vector<double> values;
+    expect(observed.observables().drain(total, steps, values) && steps.size() == 10 && steps.back() == 30 &&
+           values == expected_total, label + ": total |Psi|^2 matches one-step missions");
+    expect(observed.observables().drain(peak, steps, values) && steps.size() == 6 &&
+           values == expected_peak, label + ": max |Phi| matches one-step missions");
+
+    // A Stop trigger met by the next total sample (step 33) ends the mission there
+    const double lowest = *std::min_element(expected_total.begin(), expected_total.end());
+    const int stop = observed.observables().addTrigger(makeTrigger(total, TriggerCondition::Above, lowest - 1.0));
+    const uint64_t before = observed.getTotalSteps();
+    const uint64_t ran = observed.runMission(30);
+    std::vector<TriggerEvent> events;
+    observed.observables().takeEvents(events);
+    expect(stop > 0 && ran == 3 && observed.getTotalSteps() == before + 3 && events.size() == 1 &&
+           events[0].step == before + 3, label + ": stop trigger ends the mission on its step");
+    expect(observed.runMission(6) == 6, label + ": disarmed trigger lets the next mission run");
+}
+
+} // namespace
+
+int main() {
+    testKinds();
+    testRing();
+    testTriggers();
+    testEngine<IGSOAComplexEngine>("1D", 64, 1, 1, [] {
+        auto engine = std::make_unique<IGSOAComplexEngine>(makeConfig(64));
+        for (size_t i = 0; i < 64; ++i) {
+            engine->setNodePsi(i, std::exp(-0.05 * (i - 32.0) * (i - 32.0)), 0.0);
+        }
+        return engine;
+    });
+    testEngine<IGSOAComplexEngine2D>("2D", 16, 12, 1, [] {
+        auto engine = std::make_unique<IGSOAComplexEngine2D>(makeConfig(16 * 12), 16, 12);
+        IGSOAStateInit2D::initCircularGaussian(*engine, 1.0, 8.0, 6.0, 2.0);
+        return engine;
+    });
+    testEngine<IGSOAComplexEngine3D>("3D", 8, 8, 6, [] {
+        auto engine = std::make_unique<IGSOAComplexEngine3D>(makeConfig(8 * 8 * 6), 8, 8, 6);
+        IGSOAStateInit3D::initSphericalGaussian(*engine, 1.0, 4.0, 4.0, 3.0, 1.5);
+        return engine;
+    });
+
+    if (failures != 0) {
+        std::cerr << "test_observable_recorder: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_observable_recorder: PASS" << std::endl;
+    return 0;
+}
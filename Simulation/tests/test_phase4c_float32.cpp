@@ -0,0 +1,178 @@
+/**
+ * Phase 4C float32 mission kernel validation
+ *
+ * A standard mission (input sin(0.01 step), control cos(0.01 step), 30
+ * iterations per node, feedback gains spread over [-1, 1]) runs on twin
+ * engines, one with double state and one with StatePrecision::Float32.
+ * The float outputs and integrators must stay within tolerance of the
+ * double ones, previous input must match exactly, every float kernel
+ * variant this CPU runs must agree (AVX2 and AVX-512 bit for bit), tail
+ * nodes must take the exact update, and switching back to Float64 must
+ * restore the double path.  Also prints ns per node update of both
+ * precisions at 1M nodes.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp -I. tests/test_phase4c_float32.cpp src/cpp/analog_universal_node_engine_avx2.cpp -lfftw3
+ */
+
+#include "../src/cpp/analog_universal_node_engine_avx2.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+struct Drive {
+    std::vector<double> input;
+    std::vector<double> control;
+};
+
+Drive standardDrive(size_t steps) {
+    Drive drive{std::vector<double>(steps), std::vector<double>(steps)};
+    for (size_t s = 0; s < steps; ++s) {
+        drive.input[s] = std::sin(0.01 * static_cast<double>(s));
+        drive.control[s] = std::cos(0.01 * static_cast<double>(s));
+    }
+    return drive;
+}
+
+void seedFeedback(AnalogCellularEngineAVX2& engine) {
+    for (size_t i = 0; i < engine.getNodeCount(); ++i) {
+        engine.getNode(i).setFeedback(-1.0 + 2.0 * static_cast<double>(i % 101) / 100.0);
+    }
+}
+
+double maxDiff(AnalogCellularEngineAVX2& a, AnalogCellularEngineAVX2& b,
+               AnalogCellularEngineAVX2::StateArray array, size_t end) {
+    const double* x = a.getStateArray(array);
+    const double* y = b.getStateArray(array);
+    double diff = 0.0;
+    for (size_t i = 0; i < end; ++i) {
+        diff = std::max(diff, std::fabs(x[i] - y[i]));
+    }
+    return diff;
+}
+
+bool sameArray(AnalogCellularEngineAVX2& a, AnalogCellularEngineAVX2& b,
+               AnalogCellularEngineAVX2::StateArray array) {
+    return std::memcmp(a.getStateArray(array), b.getStateArray(array), a.getNodeCount() * sizeof(double)) == 0;
+}
+
+void testMatchesDouble() {
+    using StateArray = AnalogCellularEngineAVX2::StateArray;
+    const size_t nodes = 4099;         // Ragged: 16-, 8- and 4-node groups plus a 3-node tail
+    const size_t steps = 2000;
+    const Drive drive = standardDrive(steps);
+
+    AnalogCellularEngineAVX2 reference(nodes);
+    AnalogCellularEngineAVX2 single(nodes);
+    seedFeedback(reference);
+    seedFeedback(single);
+    single.setStatePrecision(StatePrecision::Float32);
+    expect(single.getStatePrecision() == StatePrecision::Float32, "precision set");
+
+    // Two missions, so the second starts from float-rounded state
+    for (int mission = 0; mission < 2; ++mission) {
+        reference.runMissionOptimized_Phase4C(drive.input.data(), drive.control.data(), steps, 30);
+        single.runMissionOptimized_Phase4C(drive.input.data(), drive.control.data(), steps, 30);
+    }
+
+    const size_t grouped = nodes - nodes % 4;
+    double output_scale = 0.0;
+    const double* output = reference.getStateArray(StateArray::CurrentOutput);
+    for (size_t i = 0; i < nodes; ++i) output_scale = std::max(output_scale, std::fabs(output[i]));
+    const double output_error = maxDiff(reference, single, StateArray::CurrentOutput, grouped);
+    const double integrator_error = maxDiff(reference, single, StateArray::IntegratorState, grouped);
+    std::cout << "float32 vs float64 over " << steps * 2 << " steps: max |output| " << output_scale
+              << ", max output error " << output_error << ", max integrator error " << integrator_error
+              << std::endl;
+    expect(output_scale > 1e-3, "mission drives the outputs");
+    expect(output_error <= 1e-5 * std::max(output_scale, 1.0), "float outputs within 1e-5 of double");
+    expect(integrator_error <= 1e-5, "float integrators within 1e-5 of double");
+    expect(sameArray(reference, single, StateArray::PreviousInput), "previous input is the last input");
+    expect(maxDiff(reference, single, StateArray::CurrentOutput, nodes) <= 1e-5 * std::max(output_scale, 1.0),
+           "tail nodes take the exact update");
+
+    // Every variant this CPU runs agrees; AVX2 and AVX-512 exactly
+    AnalogCellularEngineAVX2 scalar(nodes);
+    seedFeedback(scalar);
+    scalar.setStatePrecision(StatePrecision::Float32);
+    scalar.setMissionKernelISA(KernelISA::Scalar);
+    scalar.runMissionOptimized_Phase4C(drive.input.data(), drive.control.data(), steps, 30);
+
+    std::vector<KernelISA> simd;
+    if (CPUFeatures::supportsKernelISA(KernelISA::AVX2)) simd.push_back(KernelISA::AVX2);
+    if (CPUFeatures::supportsKernelISA(KernelISA::AVX512)) simd.push_back(KernelISA::AVX512);
+    std::vector<std::unique_ptr<AnalogCellularEngineAVX2>> variants;
+    for (KernelISA isa : simd) {
+        variants.push_back(std::make_unique<AnalogCellularEngineAVX2>(nodes));
+        AnalogCellularEngineAVX2& engine = *variants.back();
+        seedFeedback(engine);
+        engine.setStatePrecision(StatePrecision::Float32);
+        engine.setMissionKernelISA(isa);
+        engine.runMissionOptimized_Phase4C(drive.input.data(), drive.control.data(), steps, 30);
+        expect(maxDiff(scalar, engine, StateArray::CurrentOutput, nodes) <= 1e-6,
+               std::string(CPUFeatures::kernelISAName(isa)) + " float kernel matches scalar");
+    }
+    if (variants.size() == 2) {
+        expect(sameArray(*variants[0], *variants[1], StateArray::CurrentOutput) &&
+               sameArray(*variants[0], *variants[1], StateArray::IntegratorState),
+               "AVX2 and AVX-512 float kernels bit-identical");
+    }
+
+    // Back to double: bit-identical to a double engine from the same state
+    AnalogCellularEngineAVX2 twin(nodes);
+    seedFeedback(twin);
+    std::copy_n(single.getStateArray(StateArray::IntegratorState), nodes, twin.getStateArray(StateArray::IntegratorState));
+    single.setStatePrecision(StatePrecision::Float64);
+    single.runMissionOptimized_Phase4C(drive.input.data(), drive.control.data(), 10, 30);
+    twin.runMissionOptimized_Phase4C(drive.input.data(), drive.control.data(), 10, 30);
+    expect(sameArray(single, twin, StateArray::CurrentOutput), "Float64 restores the double kernel");
+}
+
+void reportThroughput() {
+    const size_t nodes = 1 << 20;
+    const size_t steps = 64;
+    const uint32_t iterations = 1;    // Bandwidth-bound end of the range
+    const Drive drive = standardDrive(steps);
+
+    for (StatePrecision precision : {StatePrecision::Float64, StatePrecision::Float32}) {
+        AnalogCellularEngineAVX2 engine(nodes);
+        engine.setStatePrecision(precision);
+        engine.runMissionOptimized_Phase4C(drive.input.data(), drive.control.data(), 4, iterations);
+        const auto start = std::chrono::steady_clock::now();
+        engine.runMissionOptimized_Phase4C(drive.input.data(), drive.control.data(), steps, iterations);
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (precision == StatePrecision::Float32 ? "float32" : "float64") << ": "
+                  << ns / static_cast<double>(nodes * steps) << " ns per node update ("
+                  << CPUFeatures::kernelISAName(engine.getMissionKernelISA()) << ", "
+                  << iterations << " iteration)" << std::endl;
+    }
+}
+
+} // namespace
+
+int main() {
+    testMatchesDouble();
+    reportThroughput();
+
+    if (failures != 0) {
+        std::cerr << "test_phase4c_float32: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_phase4c_float32: PASS" << std::endl;
+    return 0;
+}
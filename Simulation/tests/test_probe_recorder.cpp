@@ -0,0 +1,163 @@
+/**
+ * Probe recorder test
+ *
+ * ProbeRecorder rings must keep the newest `capacity` samples of each
+ * probe at its decimation, count overwritten ones and drain oldest first
+ * (whole or partial), and feed taps every sample as recorded.  Probes on IGSOA 1D/2D/3D engines must record exactly
+ * the node fields that one-step missions read back, and invalid specs must
+ * be rejected.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_probe_recorder.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_complex_engine_3d.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../src/cpp/igsoa_state_init_3d.h"
+#include "../src/cpp/probe_recorder.h"
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dase;
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+IGSOAComplexConfig makeConfig(size_t nodes) {
+    IGSOAComplexConfig config;
+    config.num_nodes = static_cast<uint32_t>(nodes);
+    config.R_c_default = 2.0;
+    config.dt = 0.01;
+    config.update_mode = IGSOAUpdateMode::DoubleBuffered;
+    config.omp_min_nodes = 0;
+    return config;
+}
+
+ProbeSpec makeSpec(std::vector<uint64_t> points, std::vector<int> fields, uint32_t decimation, size_t capacity) {
+    ProbeSpec spec;
+    spec.points = std::move(points);
+    spec.fields = std::move(fields);
+    spec.decimation = decimation;
+    spec.capacity = capacity;
+    return spec;
+}
+
+void testRing() {
+    ProbeRecorder recorder;
+    const int id = recorder.add(makeSpec({0, 2}, {0, 1}, 2, 3), 4, 2);
+    expect(id > 0, "probe added");
+    std::vector<uint64_t> tapped_steps;
+    std::vector<double> tapped;
+    const int tap = recorder.addTap(id, [&](uint64_t step, const double* sample) {
+        tapped_steps.push_back(step);
+        tapped.insert(tapped.end(), sample, sample + 4);
+    });
+    expect(tap > 0 && recorder.addTap(id + 1, [](uint64_t, const double*) {}) == -1, "tap added");
+    for (uint64_t step = 1; step <= 10; ++step) {
+        recorder.record(step, [step](uint64_t point, int field) {
+            return static_cast<double>(step * 100 + point * 10 + static_cast<uint64_t>(field));
+        });
+    }
+    expect(recorder.pending(id) == 3, "ring keeps capacity samples");
+    expect(tapped_steps.size() == 5 && tapped_steps.front() == 2 && tapped.size() == 20 &&
+           tapped[0] == 200 && tapped[1] == 220 && tapped[2] == 201 && tapped[19] == 1021,
+           "tap sees every sample, even overwritten ones");
+    expect(recorder.removeTap(id, tap) && !recorder.removeTap(id, tap), "tap removed");
+
+    uint64_t steps[2] = {};
+    double values[8] = {};
+    uint64_t dropped = 0;
+    expect(recorder.drain(id, steps, values, 2, &dropped) == 2, "partial drain");
+    expect(dropped == 2, "overwritten samples counted");
+    expect(steps[0] == 6 && steps[1] == 8, "oldest first at the decimation");
+    // values[(s * fields + f) * points + p]
+    expect(values[0] == 600 && values[1] == 620 && values[2] == 601 && values[3] == 621 && values[4] == 800,
+           "sample layout");
+
+    std::vector<uint64_t> rest;
+    std::vector<double> rest_values;
+    expect(recorder.drain(id, rest, rest_values, &dropped) && rest.size() == 1 && rest[0] == 10 &&
+           rest_values.size() == 4 && dropped == 0, "drain the remainder");
+    expect(recorder.pending(id) == 0, "drained ring is empty");
+
+    expect(recorder.add(makeSpec({4}, {0}, 1, 1), 4, 2) == -1, "point out of range rejected");
+    expect(recorder.add(makeSpec({0}, {2}, 1, 1), 4, 2) == -1, "field out of range rejected");
+    expect(recorder.add(makeSpec({0}, {0}, 0, 1), 4, 2) == -1, "zero decimation rejected");
+    expect(recorder.add(makeSpec({0}, {0}, 1, 0), 4, 2) == -1, "zero capacity rejected");
+    expect(recorder.remove(id) && !recorder.active(), "probe removed");
+}
+
+// A probe over a mission matches one-step missions read back node by node
+template <typename Engine, typename Init>
+void testEngine(const std::string& label, Init init) {
+    std::unique_ptr<Engine> probed_engine = init();
+    std::unique_ptr<Engine> stepped_engine = init();
+    Engine& probed = *probed_engine;
+    Engine& stepped = *stepped_engine;
+    const std::vector<uint64_t> points = {0, 7, probed.getNodes().size() - 1};
+    const std::vector<int> fields = {0, 1, 2, 3};
+    const int id = probed.probes().add(makeSpec(points, fields, 3, 64), probed.getNodes().size(),
+                                       IGSOABulkAccess::kNumFields);
+    expect(id > 0, label + ": probe added");
+    probed.runMission(30);
+
+    std::vector<double> expected;
+    for (int step = 1; step <= 30; ++step) {
+        stepped.runMission(1);
+        if (step % 3 != 0) continue;
+        for (int field : fields) {
+            for (uint64_t point : points) {
+                expected.push_back(IGSOABulkAccess::value(stepped.getNodes()[point], static_cast<IGSOANodeField>(field)));
+            }
+        }
+    }
+
+    std::vector<uint64_t> steps;
+    std::vector<double> values;
+    expect(probed.probes().drain(id, steps, values), label + ": drained");
+    expect(steps.size() == 10 && steps.front() == 3 && steps.back() == 30, label + ": one sample per 3 steps");
+    expect(values == expected, label + ": samples match one-step missions");
+}
+
+} // namespace
+
+int main() {
+    testRing();
+    testEngine<IGSOAComplexEngine>("1D", [] {
+        auto engine = std::make_unique<IGSOAComplexEngine>(makeConfig(64));
+        for (size_t i = 0; i < 64; ++i) {
+            engine->setNodePsi(i, std::exp(-0.05 * (i - 32.0) * (i - 32.0)), 0.0);
+        }
+        return engine;
+    });
+    testEngine<IGSOAComplexEngine2D>("2D", [] {
+        auto engine = std::make_unique<IGSOAComplexEngine2D>(makeConfig(16 * 12), 16, 12);
+        IGSOAStateInit2D::initCircularGaussian(*engine, 1.0, 8.0, 6.0, 2.0);
+        return engine;
+    });
+    testEngine<IGSOAComplexEngine3D>("3D", [] {
+        auto engine = std::make_unique<IGSOAComplexEngine3D>(makeConfig(8 * 8 * 6), 8, 8, 6);
+        IGSOAStateInit3D::initSphericalGaussian(*engine, 1.0, 4.0, 4.0, 3.0, 1.5);
+        return engine;
+    });
+
+    if (failures != 0) {
+        std::cerr << "test_probe_recorder: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_probe_recorder: PASS" << std::endl;
+    return 0;
+}
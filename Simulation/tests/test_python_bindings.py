@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""
+Smoke test for the dase_engine field views (src/cpp/python_bindings.cpp)
+
+IGSOA psi / phi are zero-copy views over the node records: C-order shapes
+(N), (N_y, N_x) and (N_z, N_y, N_x), strides of one node record, writes
+that reach the next mission, and views that stay valid across missions.
+SATP fields are copies (evolve() swaps the node buffers) written back by
+assigning a whole array.
+
+Run: PYTHONPATH=<dir of the built dase_engine module> python -m pytest tests/test_python_bindings.py
+"""
+
+import pytest
+
+np = pytest.importorskip("numpy")
+de = pytest.importorskip("dase_engine")
+
+
+def igsoa_config(num_nodes):
+    config = de.IGSOAComplexConfig()
+    config.num_nodes = num_nodes
+    config.R_c_default = 2.0
+    config.normalize_psi = False
+    return config
+
+
+def make_igsoa(dims):
+    if dims == 1:
+        return de.IGSOAComplexEngine(igsoa_config(24)), (24,)
+    if dims == 2:
+        return de.IGSOAComplexEngine2D(igsoa_config(6 * 4), 6, 4), (4, 6)
+    return de.IGSOAComplexEngine3D(igsoa_config(5 * 4 * 3), 5, 4, 3), (3, 4, 5)
+
+
+@pytest.mark.parametrize("dims", [1, 2, 3])
+def test_igsoa_views_shape_and_strides(dims):
+    engine, shape = make_igsoa(dims)
+    psi = engine.psi
+    phi = engine.phi
+
+    assert psi.shape == shape and phi.shape == shape
+    assert psi.dtype == np.complex128 and phi.dtype == np.float64
+    # One node record between neighbours along x, a row along y, a plane along z
+    record = psi.strides[-1]
+    assert record >= psi.itemsize and phi.strides[-1] == record
+    for axis in range(dims - 1):
+        assert psi.strides[axis] == psi.strides[axis + 1] * shape[axis + 1]
+    assert psi.flags.writeable and phi.flags.writeable
+    assert not engine.F.flags.writeable
+    assert psi.base is not None   # The engine keeps the view's memory alive
+
+
+@pytest.mark.parametrize("dims", [1, 2, 3])
+def test_igsoa_views_write_through(dims):
+    engine, shape = make_igsoa(dims)
+    psi = engine.psi
+    phi = engine.phi
+    index = tuple(n // 2 for n in shape)
+
+    psi[...] = 0.0
+    psi[index] = 0.5 + 0.25j
+    phi[index] = 0.75
+    assert engine.psi[index] == 0.5 + 0.25j
+    assert engine.phi[index] == 0.75
+    assert engine.psi[tuple(0 for _ in shape)] == 0.0
+
+    # The written state drives the mission: the packet spreads to its
+    # neighbours, and the views taken before it still see the lattice
+    engine.run_mission(1)
+    assert engine.total_steps == 1
+    assert np.array_equal(psi, engine.psi)
+    assert np.count_nonzero(psi) > 1
+
+
+def test_satp_fields_are_copies():
+    engine = de.SATPHiggsEngine2D(8, 6, 0.1, 0.01)
+    phi = engine.phi
+    assert phi.shape == (6, 8) and phi.flags.c_contiguous and phi.flags.owndata
+
+    phi[2, 3] = 1.0
+    assert engine.phi[2, 3] == 0.0   # Editing a copy leaves the engine alone
+    engine.phi = phi                 # Assigning writes the field
+    assert engine.phi[2, 3] == 1.0
+
+    before = engine.phi
+    engine.evolve(3)
+    assert before[2, 3] == 1.0       # Copies survive evolve()'s buffer swap
+    assert engine.phi.shape == (6, 8)
+
+    with pytest.raises(ValueError):
+        engine.h = np.zeros((8, 6))
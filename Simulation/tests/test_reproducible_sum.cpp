@@ -0,0 +1,156 @@
+/**
+ * Reproducible parallel sum test
+ *
+ * reproducibleSums() must give the same bits for every OpenMP team size and
+ * with parallelism switched off, and a single block must be the plain
+ * sequential sum.  The engine totals built on it (IGSOA computeTotals and
+ * average density, SATP+Higgs energy and RMS) must likewise not change in
+ * the last bit between 1 and N threads.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_reproducible_sum.cpp
+ */
+
+#include "../src/cpp/reproducible_sum.h"
+#include "../src/cpp/igsoa_physics.h"
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_physics_1d.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+int maxThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads() < 4 ? 4 : omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+void setThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+// Values of wildly different magnitude, so any change of association shows
+std::vector<double> illConditioned(size_t n) {
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-20, 20);
+    std::vector<double> values(n);
+    for (double& v : values) {
+        v = std::ldexp(mantissa(rng), exponent(rng));
+    }
+    return values;
+}
+
+void testSums() {
+    const size_t sizes[] = {1, 100, dase::kSumBlock, dase::kSumBlock + 1, 5 * dase::kSumBlock + 17, 200000};
+    for (size_t n : sizes) {
+        const std::vector<double> values = illConditioned(n);
+        auto sum = [&](bool parallel) {
+            return dase::reproducibleSums<2>(static_cast<int64_t>(n), [&](int64_t i, double* acc) {
+                acc[0] += values[static_cast<size_t>(i)];
+                acc[1] += values[static_cast<size_t>(i)] * values[static_cast<size_t>(i)];
+            }, parallel);
+        };
+
+        setThreads(1);
+        const auto reference = sum(false);
+        for (int threads = 1; threads <= maxThreads(); ++threads) {
+            setThreads(threads);
+            const auto got = sum(true);
+            expect(sameBits(got[0], reference[0]) && sameBits(got[1], reference[1]),
+                   "n " + std::to_string(n) + " threads " + std::to_string(threads));
+        }
+
+        if (n <= static_cast<size_t>(dase::kSumBlock)) {
+            double sequential = 0.0;
+            for (double v : values) sequential += v;
+            expect(sameBits(reference[0], sequential), "single block is sequential, n " + std::to_string(n));
+        }
+    }
+    expect(dase::reproducibleSum(0, [](int64_t) { return 1.0; }) == 0.0, "empty sum");
+}
+
+void testEngineTotals() {
+    IGSOAComplexConfig config;
+    config.num_nodes = 3 * static_cast<uint32_t>(dase::kSumBlock) + 11;
+    config.R_c_default = 2.0;
+    config.normalize_psi = false;
+    config.omp_min_nodes = 1;
+    IGSOAComplexEngine engine(config);
+    const std::vector<double> values = illConditioned(config.num_nodes);
+    for (size_t i = 0; i < config.num_nodes; ++i) {
+        engine.setNodePsi(i, values[i], 0.5 * values[(i + 7) % values.size()]);
+    }
+    engine.runMission(2);
+
+    double energy0 = 0.0, entropy0 = 0.0;
+    setThreads(1);
+    IGSOAPhysics::computeTotals(engine.getNodes(), energy0, entropy0, 1);
+    const double density0 = engine.getAverageInformationalDensity();
+
+    const size_t satp_points = 2 * static_cast<size_t>(dase::kSumBlock) + 5;
+    dase::satp_higgs::SATPHiggsParams params;
+    dase::satp_higgs::SATPHiggsEngine1D satp(satp_points, 0.1, 0.001, params);
+    auto& satp_nodes = satp.getNodesMutable();
+    for (size_t i = 0; i < satp_nodes.size(); ++i) {
+        satp_nodes[i].phi = values[i];
+        satp_nodes[i].h = params.h_vev + 0.1 * values[i + 1];
+    }
+    const double satp_energy0 = satp.computeTotalEnergy();
+    const double satp_phi_rms0 = satp.computePhiRMS();
+
+    for (int threads = 2; threads <= maxThreads(); ++threads) {
+        setThreads(threads);
+        const std::string label = " threads " + std::to_string(threads);
+        double energy = 0.0, entropy = 0.0;
+        IGSOAPhysics::computeTotals(engine.getNodes(), energy, entropy, 1);
+        expect(sameBits(energy, energy0) && sameBits(entropy, entropy0), "computeTotals" + label);
+        expect(sameBits(engine.getAverageInformationalDensity(), density0), "average density" + label);
+        expect(sameBits(satp.computeTotalEnergy(), satp_energy0), "SATP energy" + label);
+        expect(sameBits(satp.computePhiRMS(), satp_phi_rms0), "SATP phi RMS" + label);
+    }
+}
+
+} // namespace
+
+int main() {
+    testSums();
+    testEngineTotals();
+
+    if (failures != 0) {
+        std::cerr << "test_reproducible_sum: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_reproducible_sum: PASS" << std::endl;
+    return 0;
+}
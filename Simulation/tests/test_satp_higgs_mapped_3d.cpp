@@ -0,0 +1,164 @@
+/**
+ * SATP+Higgs file-backed 3D engine test
+ *
+ * SATPHiggsMappedEngine3D must follow the in-memory engine's reference
+ * path step for step (damping, point-wise source, several evolve calls)
+ * for any slab height: one slab, slabs that divide N_z, a short last slab.
+ * Also checks the plane accessors, the prefetch / evict schedule and the
+ * backing file's lifetime.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -Isrc/cpp tests/test_satp_higgs_mapped_3d.cpp
+ */
+
+#include "../src/cpp/satp_higgs_mapped_3d.h"
+#include "../src/cpp/satp_higgs_physics_3d.h"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace dase::satp_higgs;
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool fileExists(const std::string& path) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (f) std::fclose(f);
+    return f != nullptr;
+}
+
+SATPHiggsParams dampedParams() {
+    SATPHiggsParams params;
+    params.gamma_phi = 0.05;
+    params.gamma_h = 0.02;
+    params.lambda = 0.3;
+    params.updateVEV();
+    return params;
+}
+
+void testMatchesInMemory(size_t slab_planes) {
+    const size_t nx = 12, ny = 10, nz = 9;
+    const SATPHiggsParams params = dampedParams();
+    SATPHiggsEngine3D reference(nx, ny, nz, 0.1, 0.01, params);
+    SATPMappedOptions options;
+    options.path = "test_satp_higgs_mapped_3d.state";
+    options.slab_planes = slab_planes;
+    options.prefetch_slabs = 1;
+    SATPHiggsMappedEngine3D mapped(nx, ny, nz, 0.1, 0.01, params, options);
+
+    std::mt19937 rng(static_cast<unsigned>(slab_planes));
+    std::uniform_real_distribution<double> value(-0.5, 0.5);
+    auto& nodes = reference.getNodesMutable();
+    for (size_t z = 0; z < nz; ++z) {
+        for (size_t y = 0; y < ny; ++y) {
+            for (size_t x = 0; x < nx; ++x) {
+                SATPHiggsNode& node = nodes[reference.getIndex(x, y, z)];
+                node.phi = value(rng);
+                node.phi_dot = value(rng);
+                node.h += value(rng);
+                node.h_dot = value(rng);
+                mapped.setNode(x, y, z, node);
+            }
+        }
+    }
+    const SourceFunction3D source = [](double t, double x, double y, double z, int, int, int) {
+        return 0.3 * std::sin(5.0 * t) * std::exp(-(x - 0.5) * (x - 0.5) - y * y - z * z);
+    };
+    reference.setSource(source);
+    mapped.setSource(source);
+
+    for (size_t steps : {size_t(7), size_t(1), size_t(5)}) {
+        reference.evolve(steps);
+        mapped.evolve(steps);
+    }
+
+    double error = 0.0;
+    for (size_t z = 0; z < nz; ++z) {
+        for (size_t y = 0; y < ny; ++y) {
+            for (size_t x = 0; x < nx; ++x) {
+                const SATPHiggsNode& a = reference.getNodes()[reference.getIndex(x, y, z)];
+                const SATPHiggsNode b = mapped.getNode(x, y, z);
+                error = std::max({error, std::fabs(a.phi - b.phi), std::fabs(a.phi_dot - b.phi_dot),
+                                  std::fabs(a.h - b.h), std::fabs(a.h_dot - b.h_dot)});
+            }
+        }
+    }
+    const std::string tag = " (slab_planes " + std::to_string(slab_planes) + ")";
+    expect(error < 1e-12, "mapped engine matches the in-memory engine" + tag + ", error " + std::to_string(error));
+    expect(mapped.getStepCount() == 13 && std::fabs(mapped.getTime() - reference.getTime()) < 1e-15,
+           "step count and time advance" + tag);
+    expect(mapped.getStore().numSlabs() == (nz + slab_planes - 1) / slab_planes, "slab count" + tag);
+    expect(mapped.getStore().prefetches() > 0 && mapped.getStore().evictions() >= mapped.getStore().numSlabs(),
+           "sweep prefetches and evicts slabs" + tag);
+}
+
+void testPlanesAndFile() {
+    const std::string path = "test_satp_higgs_mapped_3d.planes";
+    {
+        SATPMappedOptions options;
+        options.path = path;
+        options.slab_planes = 2;
+        SATPHiggsMappedEngine3D engine(4, 3, 5, 0.1, 0.01, SATPHiggsParams(), options);
+        expect(fileExists(path), "backing file created");
+        expect(engine.getStore().fileBytes() % engine.getStore().slabBytes() == 0 &&
+               engine.getStore().slabBytes() % 4096 == 0, "slabs are page aligned");
+
+        std::vector<double> h(12);
+        engine.readPlane(4, nullptr, nullptr, h.data(), nullptr);
+        expect(std::fabs(h[7] - engine.getParams().h_vev) < 1e-15, "fields start at the Higgs VEV");
+
+        std::vector<double> phi(12);
+        for (size_t i = 0; i < phi.size(); ++i) phi[i] = static_cast<double>(i);
+        engine.writePlane(3, phi.data(), nullptr, nullptr, nullptr);
+        expect(engine.getNode(2, 1, 3).phi == 6.0 && engine.getNode(2, 1, 2).phi == 0.0,
+               "writePlane sets one plane of one field");
+    }
+    expect(!fileExists(path), "backing file removed with the engine");
+
+    {
+        SATPMappedOptions options;
+        options.path = path;
+        options.keep_file = true;
+        SATPHiggsMappedEngine3D engine(3, 3, 3, 0.1, 0.01, SATPHiggsParams(), options);
+        engine.flush();
+    }
+    expect(fileExists(path), "keep_file leaves the backing file");
+    std::remove(path.c_str());
+
+    bool threw = false;
+    try {
+        SATPMappedOptions options;
+        options.path = "no_such_directory/state";
+        SATPHiggsMappedEngine3D engine(4, 4, 4, 0.1, 0.01, SATPHiggsParams(), options);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    expect(threw, "unwritable backing file rejected");
+}
+
+} // namespace
+
+int main() {
+    for (size_t slab_planes : {size_t(1), size_t(2), size_t(4), size_t(9)}) {
+        testMatchesInMemory(slab_planes);
+    }
+    testPlanesAndFile();
+
+    if (failures != 0) {
+        std::cerr << "test_satp_higgs_mapped_3d: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_satp_higgs_mapped_3d: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,187 @@
+/**
+ * SATP+Higgs pseudo-spectral mode test
+ *
+ * Without an FFT backend the spectral modes must be refused and the engines
+ * keep the finite-difference path.  With USE_FFTW3 the spectral ∇² must be
+ * exact for lattice Fourier modes, a standing wave on a coarse lattice must
+ * beat the finite-difference error by orders of magnitude (SpectralETD
+ * exactly, at several times the stencil CFL step), and point-wise and
+ * Separable sources must give the same fields.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_satp_higgs_spectral.cpp
+ *        (spectral checks: add -DUSE_FFTW3 and -lfftw3)
+ */
+
+#include "../src/cpp/satp_higgs_physics_2d.h"
+#include "../src/cpp/satp_higgs_physics_3d.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace dase::satp_higgs;
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+void testUnavailableFallsBack() {
+    SATPHiggsEngine2D engine(8, 8, 0.1, 0.01, SATPHiggsParams());
+    SATPHiggsEngine3D engine3d(8, 6, 4, 0.1, 0.01, SATPHiggsParams());
+    expect(engine.setLaplacianMode(SATPLaplacianMode::FiniteDifference), "finite difference always accepted");
+    if (SATPSpectralSolver::isAvailable()) return;
+
+    expect(!engine.setLaplacianMode(SATPLaplacianMode::Spectral) &&
+           !engine3d.setLaplacianMode(SATPLaplacianMode::SpectralETD), "spectral refused without FFT");
+    expect(engine.getLaplacianMode() == SATPLaplacianMode::FiniteDifference &&
+           engine3d.getLaplacianMode() == SATPLaplacianMode::FiniteDifference, "mode unchanged");
+
+    // Still the reference path
+    SATPHiggsEngine2D reference(8, 8, 0.1, 0.01, SATPHiggsParams());
+    engine.getNodesMutable()[9].phi = reference.getNodesMutable()[9].phi = 0.5;
+    engine.evolve(5);
+    reference.evolve(5);
+    expect(engine.getNodes()[9].phi == reference.getNodes()[9].phi, "fallback matches the reference");
+}
+
+#ifdef USE_FFTW3
+// Free massless waves: no damping, potential or coupling
+SATPHiggsParams linearParams() {
+    SATPHiggsParams params;
+    params.lambda = 0.0;
+    params.mu_squared = 0.0;
+    params.lambda_h = 0.0;
+    params.updateVEV();
+    return params;
+}
+
+// Standing wave φ = sin(k·x) cos(c|k|t) with mode (mx, my) on an n × n box
+double standingWave(size_t x, size_t y, size_t n, double dx, int mx, int my, double c, double t) {
+    const double L = static_cast<double>(n) * dx;
+    const double kx = 2.0 * M_PI * mx / L;
+    const double ky = 2.0 * M_PI * my / L;
+    const double k = std::sqrt(kx * kx + ky * ky);
+    return std::sin(kx * static_cast<double>(x) * dx + ky * static_cast<double>(y) * dx) * std::cos(c * k * t);
+}
+
+// Max |φ - exact| after num_steps from the standing wave at t = 0
+double standingWaveError(SATPLaplacianMode mode, size_t n, double dx, double dt, size_t num_steps) {
+    const int mx = 3, my = 2;
+    SATPHiggsEngine2D engine(n, n, dx, dt, linearParams());
+    expect(engine.setLaplacianMode(mode), "mode accepted");
+    for (size_t y = 0; y < n; ++y) {
+        for (size_t x = 0; x < n; ++x) {
+            engine.getNodesMutable()[engine.getIndex(x, y)].phi = standingWave(x, y, n, dx, mx, my, 1.0, 0.0);
+        }
+    }
+    engine.evolve(num_steps);
+    double error = 0.0;
+    for (size_t y = 0; y < n; ++y) {
+        for (size_t x = 0; x < n; ++x) {
+            const double exact = standingWave(x, y, n, dx, mx, my, 1.0, engine.getTime());
+            error = std::max(error, std::abs(engine.getNodes()[engine.getIndex(x, y)].phi - exact));
+        }
+    }
+    return error;
+}
+
+void testLaplacianExact() {
+    // Odd and even extents; the mode sits well below Nyquist
+    const size_t n[3] = {12, 9, 10};
+    const double dx = 0.3;
+    SATPSpectralSolver solver;
+    expect(solver.configure(n[0], n[1], n[2], dx), "configure 3D");
+    const size_t N = n[0] * n[1] * n[2];
+    std::vector<double> f(N), lap(N);
+    const double k[3] = {2.0 * M_PI * 2 / (n[0] * dx), 2.0 * M_PI * 3 / (n[1] * dx), 2.0 * M_PI / (n[2] * dx)};
+    for (size_t z = 0; z < n[2]; ++z) {
+        for (size_t y = 0; y < n[1]; ++y) {
+            for (size_t x = 0; x < n[0]; ++x) {
+                f[(z * n[1] + y) * n[0] + x] = std::sin(k[0] * x * dx) * std::cos(k[1] * y * dx + 0.4) *
+                                                std::sin(k[2] * z * dx + 1.0) + 0.25;
+            }
+        }
+    }
+    solver.laplacian(f.data(), lap.data());
+    const double k_sq = k[0] * k[0] + k[1] * k[1] + k[2] * k[2];
+    double error = 0.0;
+    for (size_t i = 0; i < N; ++i) {
+        error = std::max(error, std::abs(lap[i] + k_sq * (f[i] - 0.25)));
+    }
+    expect(error < 1e-9 * k_sq, "∇² exact for a lattice Fourier mode");
+}
+
+void testStandingWaveAccuracy() {
+    // 16² cells for a (3, 2) mode: ~4 cells per wavelength along x
+    const size_t n = 16;
+    const double dx = 0.1;
+    // (small dt, so the Verlet phase error stays below the spatial one)
+    const double dt = 0.05 * computeMaxStableTimestep2D(1.0, dx);
+    const double fd = standingWaveError(SATPLaplacianMode::FiniteDifference, n, dx, dt, 2000);
+    const double spectral = standingWaveError(SATPLaplacianMode::Spectral, n, dx, dt, 2000);
+    expect(spectral < 0.05 * fd, "Spectral beats the stencil on a coarse lattice");
+
+    // ETD: exact for the linear wave at 4× the stencil CFL step
+    const double dt_etd = 4.0 * computeMaxStableTimestep2D(1.0, dx);
+    const double etd = standingWaveError(SATPLaplacianMode::SpectralETD, n, dx, dt_etd, 25);
+    expect(etd < 1e-10, "SpectralETD exact for the linear wave beyond the CFL step");
+    expect(maxStableTimestepSpectral(1.0, dx, 2) < computeMaxStableTimestep2D(1.0, dx),
+           "Spectral Verlet step bound below the stencil one");
+}
+
+void testSourcesAgree() {
+    const size_t n[3] = {8, 6, 5};
+    const double dx = 0.2;
+    SATPSourceEnvelope envelope;
+    envelope.shape = SATPSourceEnvelope::Shape::Sinusoid;
+    envelope.frequency = 0.7;
+    std::vector<double> profile(n[0] * n[1] * n[2]);
+    for (size_t i = 0; i < profile.size(); ++i) profile[i] = std::cos(0.3 * static_cast<double>(i));
+
+    for (SATPLaplacianMode mode : {SATPLaplacianMode::Spectral, SATPLaplacianMode::SpectralETD}) {
+        SATPHiggsParams params;
+        params.gamma_phi = 0.05;
+        SATPHiggsEngine3D separable(n[0], n[1], n[2], dx, 0.02, params);
+        SATPHiggsEngine3D pointwise(n[0], n[1], n[2], dx, 0.02, params);
+        expect(separable.setLaplacianMode(mode) && pointwise.setLaplacianMode(mode), "3D mode accepted");
+        separable.setSeparableSource(profile, envelope);
+        pointwise.setSource([&](double t, double, double, double, int ix, int iy, int iz) {
+            return envelope(t) * profile[(static_cast<size_t>(iz) * n[1] + iy) * n[0] + ix];
+        });
+        separable.evolve(30);
+        pointwise.evolve(30);
+        bool same = true;
+        for (size_t i = 0; i < profile.size(); ++i) {
+            same = same && separable.getNodes()[i].phi == pointwise.getNodes()[i].phi &&
+                   separable.getNodes()[i].h_dot == pointwise.getNodes()[i].h_dot;
+        }
+        expect(same, "point-wise and Separable sources agree");
+        expect(separable.getStepCount() == 30 && separable.getRoofline().valid, "step count and roofline");
+    }
+}
+#endif
+
+} // namespace
+
+int main() {
+    testUnavailableFallsBack();
+#ifdef USE_FFTW3
+    testLaplacianExact();
+    testStandingWaveAccuracy();
+    testSourcesAgree();
+#endif
+
+    if (failures != 0) {
+        std::cerr << "test_satp_higgs_spectral: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_satp_higgs_spectral: PASS" << std::endl;
+    return 0;
+}
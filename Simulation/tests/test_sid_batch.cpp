@@ -0,0 +1,108 @@
+/**
+ * SID batched engine API test
+ *
+ * sid_batch_run over an ensemble must leave every engine exactly as the
+ * same per-engine sid_step / sid_collapse calls do and report the masses
+ * the per-engine getters return; a repeated engine must be refused
+ * without running anything and a NULL one reported as not ok.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -Isrc/cpp -Isrc/cpp/sid_ssp tests/test_sid_batch.cpp src/cpp/sid_ssp/sid_capi.cpp
+ */
+
+#include "../src/cpp/sid_ssp/sid_capi.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+std::vector<sid_engine*> makeEnsemble(size_t count) {
+    std::vector<sid_engine*> engines;
+    for (size_t i = 0; i < count; ++i) {
+        sid_engine* eng = sid_create_engine(256 + 16 * i, 10.0 + static_cast<double>(i));
+        sid_set_diagram_expr(eng, "S+(P(A), P(B))", "d");
+        if (i % 3 == 0) {
+            // Labelled members collapse through their masks
+            sid_label_collapse_node(eng, "n1", 'I', i, 0.5);
+        }
+        engines.push_back(eng);
+    }
+    return engines;
+}
+
+void destroy(std::vector<sid_engine*>& engines) {
+    for (sid_engine* eng : engines) sid_destroy_engine(eng);
+    engines.clear();
+}
+
+void testMatchesSequential() {
+    const size_t count = 24;
+    std::vector<sid_engine*> batched = makeEnsemble(count);
+    std::vector<sid_engine*> sequential = makeEnsemble(count);
+
+    std::vector<sid_batch_result> results(count);
+    expect(sid_batch_run(batched.data(), count, SID_BATCH_STEP | SID_BATCH_COLLAPSE, 0.3, 5, 1e-6, results.data()),
+           "batch runs");
+    for (sid_engine* eng : sequential) {
+        for (int round = 0; round < 5; ++round) {
+            sid_step(eng, 0.3);
+            sid_collapse(eng, 0.3);
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const sid_batch_result& r = results[i];
+        sid_engine* ref = sequential[i];
+        expect(r.ok && r.I_mass == sid_get_I_mass(ref) && r.N_mass == sid_get_N_mass(ref) &&
+               r.U_mass == sid_get_U_mass(ref) && r.step_count == sid_get_step_count(ref) &&
+               r.instantaneous_gain == sid_get_instantaneous_gain(ref) &&
+               r.is_conserved == sid_is_conserved(ref, 1e-6),
+               "engine " + std::to_string(i) + " matches per-engine calls");
+        expect(r.step_count == 10 && r.is_conserved, "rounds counted, mass conserved");
+    }
+
+    // ops = 0 only reads
+    std::vector<sid_batch_result> read(count);
+    expect(sid_batch_run(batched.data(), count, 0, 0.3, 5, 1e-6, read.data()) &&
+           read[4].step_count == 10 && read[4].U_mass == results[4].U_mass, "read-only batch");
+
+    destroy(batched);
+    destroy(sequential);
+}
+
+void testRejects() {
+    std::vector<sid_engine*> engines = makeEnsemble(3);
+    std::vector<sid_engine*> listed = {engines[0], engines[1], engines[0]};
+    std::vector<sid_batch_result> results(3);
+    expect(!sid_batch_run(listed.data(), 3, SID_BATCH_STEP, 1.0, 1, 1e-6, results.data()) &&
+           sid_get_step_count(engines[0]) == 0, "repeated engine refused, nothing run");
+
+    listed = {engines[0], nullptr, engines[2]};
+    expect(sid_batch_run(listed.data(), 3, SID_BATCH_STEP, 1.0, 2, 1e-6, results.data()) &&
+           results[0].ok && !results[1].ok && results[2].step_count == 2, "NULL engine skipped");
+    expect(sid_batch_run(nullptr, 0, SID_BATCH_STEP, 1.0, 1, 1e-6, nullptr), "empty batch");
+    expect(!sid_batch_run(listed.data(), 3, SID_BATCH_STEP, 1.0, 1, 1e-6, nullptr), "results required");
+    destroy(engines);
+}
+
+} // namespace
+
+int main() {
+    testMatchesSequential();
+    testRejects();
+
+    if (failures != 0) {
+        std::cerr << "test_sid_batch: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_sid_batch: PASS" << std::endl;
+    return 0;
+}
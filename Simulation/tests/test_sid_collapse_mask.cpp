@@ -0,0 +1,272 @@
+/**
+ * SID sparse collapse mask test
+ *
+ * Each mask form (indexed, bitset, dense) must collapse exactly like the
+ * dense reference loop over its toDense() mask, be chosen by density and
+ * weights, and be built from the diagram's node labels.  The engine must
+ * collapse only labelled cells, keep its running masses, fall back to the
+ * half/half collapse without labels, drop a label with its node, and carry
+ * labels through a checkpoint.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -Isrc/cpp tests/test_sid_collapse_mask.cpp
+ */
+
+#include "../src/cpp/sid_ssp/sid_collapse_mask.hpp"
+#include "../src/cpp/sid_ternary_engine.hpp"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace sid;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+struct Fields {
+    std::vector<double> I, N, U;
+};
+
+Fields randomFields(size_t n, std::mt19937& rng) {
+    std::uniform_real_distribution<double> value(0.0, 2.0);
+    Fields f{std::vector<double>(n), std::vector<double>(n), std::vector<double>(n)};
+    for (size_t i = 0; i < n; ++i) {
+        f.I[i] = value(rng);
+        f.N[i] = value(rng);
+        f.U[i] = value(rng);
+    }
+    return f;
+}
+
+// Spec formula over every cell of a dense mask
+void referenceCollapse(Fields& f, const CollapseMask& mask, double alpha) {
+    for (size_t i = 0; i < f.U.size(); ++i) {
+        const double t_I = alpha * mask.mask_I[i] * f.U[i];
+        const double t_N = alpha * mask.mask_N[i] * f.U[i];
+        f.U[i] -= t_I + t_N;
+        f.I[i] += t_I;
+        f.N[i] += t_N;
+    }
+}
+
+std::vector<SparseCollapseMask::Cell> randomCells(size_t n, size_t count, bool binary, std::mt19937& rng) {
+    std::uniform_real_distribution<double> weight(0.0, 1.0);
+    std::vector<SparseCollapseMask::Cell> cells;
+    for (size_t k = 0; k < count; ++k) {
+        const uint32_t cell = static_cast<uint32_t>(rng() % n);
+        if (binary) {
+            cells.push_back(rng() % 2 ? SparseCollapseMask::Cell{cell, 1.0, 0.0} : SparseCollapseMask::Cell{cell, 0.0, 1.0});
+        } else {
+            cells.push_back(SparseCollapseMask::Cell{cell, weight(rng) * 0.6, weight(rng) * 0.6});
+        }
+    }
+    return cells;
+}
+
+void testForms() {
+    std::mt19937 rng(11);
+    const size_t n = 5000;
+    struct Case {
+        size_t count;
+        bool binary;
+        SparseCollapseMask::Form form;
+        const char* name;
+    };
+    const Case cases[] = {
+        {40, false, SparseCollapseMask::Form::Indexed, "weighted sparse"},
+        {40, true, SparseCollapseMask::Form::Indexed, "very sparse binary"},
+        {400, true, SparseCollapseMask::Form::Bitset, "binary"},
+        {400, false, SparseCollapseMask::Form::Indexed, "weighted"},
+        {3000, false, SparseCollapseMask::Form::Dense, "dense weighted"},
+        {3000, true, SparseCollapseMask::Form::Dense, "dense binary"},
+    };
+    for (const Case& c : cases) {
+        std::vector<SparseCollapseMask::Cell> cells = randomCells(n, c.count, c.binary, rng);
+        if (c.binary) {
+            // One role per cell, so the merged mask stays binary
+            std::vector<int> role(n, -1);
+            for (auto& cell : cells) {
+                if (role[cell.cell] < 0) role[cell.cell] = cell.weight_I == 1.0 ? 0 : 1;
+                cell.weight_I = role[cell.cell] == 0 ? 1.0 : 0.0;
+                cell.weight_N = 1.0 - cell.weight_I;
+            }
+        }
+        const SparseCollapseMask mask = SparseCollapseMask::fromCells(n, cells);
+        expect(mask.form() == c.form, std::string("form: ") + c.name);
+        const CollapseMask dense = mask.toDense();
+        expect(dense.is_valid(), std::string("valid: ") + c.name);
+
+        for (bool simd : {false, FieldKernels::avx2Available()}) {
+            Fields ref = randomFields(n, rng);
+            Fields got = ref;
+            referenceCollapse(ref, dense, 0.7);
+            CompensatedSum moved_I;
+            CompensatedSum moved_N;
+            mask.apply(simd, got.I.data(), got.N.data(), got.U.data(), 0.7, moved_I, moved_N);
+            // AVX2 builds may contract into FMAs, so only the scalar path is bit-exact
+            const double tolerance = simd ? 1e-14 : 0.0;
+            bool same = true;
+            for (size_t i = 0; i < n; ++i) {
+                same = same && std::abs(got.I[i] - ref.I[i]) <= tolerance &&
+                       std::abs(got.N[i] - ref.N[i]) <= tolerance && std::abs(got.U[i] - ref.U[i]) <= tolerance;
+            }
+            expect(same, std::string("fields: ") + c.name + (simd ? " (AVX2)" : ""));
+            expect(moved_I.value() >= 0.0 && moved_N.value() >= 0.0, std::string("moved: ") + c.name);
+        }
+    }
+
+    // Repeats add up and are scaled to M_I + M_N <= 1
+    const SparseCollapseMask merged = SparseCollapseMask::fromCells(
+        100, {{5, 0.75, 0.0}, {5, 0.0, 0.75}, {7, 0.25, 0.0}, {7, 0.25, 0.0}, {200, 1.0, 0.0}});
+    const CollapseMask merged_dense = merged.toDense();
+    expect(merged.size() == 2 && merged_dense.mask_I[5] == 0.5 && merged_dense.mask_N[5] == 0.5 &&
+           merged_dense.mask_I[7] == 0.5, "merged weights");
+
+    CollapseMask dense(64);
+    dense.mask_I[3] = 0.25;
+    dense.mask_N[9] = 1.0;
+    const SparseCollapseMask from_dense = SparseCollapseMask::fromDense(dense);
+    expect(from_dense.size() == 2 && from_dense.toDense().mask_I == dense.mask_I &&
+           from_dense.toDense().mask_N == dense.mask_N, "fromDense round trip");
+}
+
+// Moved totals equal the field changes
+void testMovedMass() {
+    std::mt19937 rng(3);
+    const size_t n = 20000;
+    for (size_t count : {size_t(50), size_t(1000), size_t(9000)}) {
+        for (bool binary : {false, true}) {
+            std::vector<SparseCollapseMask::Cell> cells = randomCells(n, count, binary, rng);
+            const SparseCollapseMask mask = SparseCollapseMask::fromCells(n, cells);
+            Fields f = randomFields(n, rng);
+            const Fields before = f;
+            CompensatedSum moved_I;
+            CompensatedSum moved_N;
+            mask.apply(FieldKernels::avx2Available(), f.I.data(), f.N.data(), f.U.data(), 0.5, moved_I, moved_N);
+            double gained_I = 0.0;
+            double gained_N = 0.0;
+            double lost_U = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                gained_I += f.I[i] - before.I[i];
+                gained_N += f.N[i] - before.N[i];
+                lost_U += before.U[i] - f.U[i];
+            }
+            expect(std::abs(gained_I - moved_I.value()) < 1e-9 && std::abs(gained_N - moved_N.value()) < 1e-9 &&
+                   std::abs(lost_U - moved_I.value() - moved_N.value()) < 1e-9,
+                   "moved mass, " + std::to_string(count) + " cells");
+        }
+    }
+}
+
+void testDiagramLabels() {
+    Diagram diagram("d");
+    for (int i = 0; i < 6; ++i) {
+        Node node("n" + std::to_string(i), "P");
+        diagram.add_node(node);
+    }
+    auto label = [&](const std::string& id, Ternary state, int cell) {
+        Node* node = diagram.find_node(id);
+        node->attributes[attr_keys::kCollapseState] = state;
+        node->attributes[attr_keys::kCollapseCell] = cell;
+    };
+    expect(!SparseCollapseMask::fromDiagram(diagram, 100).labelled(), "unlabelled diagram");
+    label("n0", Ternary::I, 10);
+    label("n1", Ternary::N, 20);
+    label("n2", Ternary::U, 30);
+    label("n3", Ternary::I, 500);   // Out of range: ignored
+    diagram.find_node("n1")->attributes[attr_keys::kCollapseWeight] = 0.25;
+    diagram.find_node("n4")->attributes[attr_keys::kCollapseState] = Ternary::N;   // No cell: ignored
+
+    const SparseCollapseMask mask = SparseCollapseMask::fromDiagram(diagram, 100);
+    const CollapseMask dense = mask.toDense();
+    expect(mask.labelled() && mask.size() == 2 && mask.form() == SparseCollapseMask::Form::Indexed, "labels read");
+    expect(dense.mask_I[10] == 1.0 && dense.mask_N[20] == 0.25 && dense.mask_I[30] == 0.0 &&
+           dense.mask_N[30] == 0.0, "label weights");
+}
+
+void testEngine() {
+    const size_t n = 1000;
+    SidTernaryEngine engine(n, 30.0);
+    engine.setDiagramExpr("S+(P(A), P(B))", "d");
+    const Diagram diagram = exprToDiagram(parseExpression("S+(P(A), P(B))"), "d");
+    std::string sum_node;
+    std::string atom_node;
+    for (const Node& node : diagram.nodes()) {
+        (node.op == "S+" ? sum_node : atom_node) = node.id;
+    }
+
+    // Unlabelled: half/half over every cell
+    SidTernaryEngine plain(n, 30.0);
+    plain.setDiagramExpr("S+(P(A), P(B))", "d");
+    const double u0 = plain.getUField()[0];
+    plain.collapse(0.5);
+    expect(std::abs(plain.getIField()[999] - (u0 + u0 * 0.25)) < 1e-15, "unlabelled collapse is half/half");
+
+    expect(engine.labelCollapseNode(sum_node, Ternary::I, 3) && engine.labelCollapseNode(atom_node, Ternary::N, 7, 0.5),
+           "labels set");
+    expect(!engine.labelCollapseNode("missing", Ternary::I, 1) && !engine.labelCollapseNode(sum_node, Ternary::I, n) &&
+           !engine.labelCollapseNode(sum_node, Ternary::I, 1, 1.5), "bad labels rejected");
+
+    const std::vector<double> I0 = engine.getIField();
+    const std::vector<double> N0 = engine.getNField();
+    const std::vector<double> U0 = engine.getUField();
+    engine.collapse(0.8);
+    const std::vector<double>& I = engine.getIField();
+    const std::vector<double>& N = engine.getNField();
+    const std::vector<double>& U = engine.getUField();
+    size_t changed = 0;
+    for (size_t i = 0; i < n; ++i) {
+        changed += (I[i] != I0[i] || N[i] != N0[i] || U[i] != U0[i]) ? 1 : 0;
+    }
+    expect(changed == 2, "only labelled cells collapse");
+    expect(I[3] == I0[3] + 0.8 * U0[3] && U[3] == U0[3] - 0.8 * U0[3], "I label moves α·U to I");
+    expect(N[7] == N0[7] + 0.8 * 0.5 * U0[7], "weighted N label");
+    expect(engine.isConserved(1e-12), "running masses match the fields");
+    expect(std::abs(engine.getIMass() + engine.getNMass() + engine.getUMass() - 30.0) < 1e-12, "mass conserved");
+
+    // Checkpoint carries the labels
+    const std::string path = "/tmp/dase_sid_collapse_mask.ckpt";
+    dase::CheckpointWriter writer;
+    engine.saveCheckpoint(writer);
+    writer.write(path);
+    SidTernaryEngine restored(n, 30.0);
+    restored.restoreCheckpoint(dase::CheckpointImage(path));
+    std::remove(path.c_str());
+    expect(restored.collapseMask().size() == 2 &&
+           restored.collapseMask().toDense().mask_N == engine.collapseMask().toDense().mask_N,
+           "checkpoint restores labels");
+
+    // A rewrite that removes a labelled node drops its label
+    const int64_t rule = engine.compileRule("S+($x, $y)", "S-($x, $y)", "swap");
+    expect(engine.applyCompiledRule(rule) && engine.collapseMask().size() == 1 &&
+           engine.collapseMask().toDense().mask_N[7] == 0.5, "removed node takes its label");
+
+    engine.setDiagramExpr("P(A)", "d");
+    expect(!engine.collapseMask().labelled(), "new diagram has no labels");
+}
+
+} // namespace
+
+int main() {
+    testForms();
+    testMovedMass();
+    testDiagramLabels();
+    testEngine();
+
+    if (failures != 0) {
+        std::cerr << "test_sid_collapse_mask: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_sid_collapse_mask: PASS" << std::endl;
+    return 0;
+}
@@ -11,9 +11,15 @@
 #include "../src/cpp/sid_ssp/sid_semantic_processor.hpp"
 #include "../src/cpp/sid_ssp/sid_mixer.hpp"
 #include "../src/cpp/sid_ssp/sid_rewrite.hpp"
+#include "../src/cpp/sid_ssp/sid_fixpoint.hpp"
+#include "../src/cpp/sid_ssp/sid_parallel_match.hpp"
+#include "../src/cpp/sid_ssp/sid_match_network.hpp"
+#include "../src/cpp/sid_ternary_engine.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -179,6 +185,37 @@ TEST(parser_invalid_expression_throws) {
     REQUIRE(caught, "Expected parse error");
 }
 
+TEST(parser_arena_bulk_parse) {
+    AstArena arena;
+    auto roots = parseExpressions({"C(P(ax), O(S+(ax, by)))", "S-(ax)", "$x"}, arena);
+    REQUIRE(roots.size() == 3, "Expected three roots");
+
+    // Children are index spans; names are interned once per arena
+    const AstRef coupling = roots[0];
+    REQUIRE(arena.kind(coupling) == ASTKind::Op && arena.name(coupling) == "C", "Wrong root");
+    REQUIRE(arena.children(coupling).size() == 2, "Wrong child count");
+    const AstRef first_ax = arena.children(arena.children(coupling)[0])[0];
+    REQUIRE(arena.name(first_ax) == "ax", "Wrong atom");
+    REQUIRE(arena.node(first_ax).symbol == arena.node(arena.children(roots[1])[0]).symbol,
+            "Atom should be interned across expressions");
+
+    // Conversion matches the owning parser
+    ASTNode converted = arena.toASTNode(coupling);
+    REQUIRE(converted.op_name == "C" && converted.args.size() == 2, "Conversion mismatch");
+    REQUIRE(converted.args[1].args[0].op_name == "S+" &&
+            converted.args[1].args[0].args[1].atom_name == "by", "Nested conversion mismatch");
+    REQUIRE(arena.toASTNode(arena.fromASTNode(converted)).args[1].args[0].args.size() == 2,
+            "Round trip mismatch");
+
+    bool caught = false;
+    try {
+        parseExpressions({"P(ax)", "C(ax)"}, arena);
+    } catch (const ParseError& e) {
+        caught = std::string(e.what()).find("Expression 1: C requires exactly 2 arguments") == 0;
+    }
+    REQUIRE(caught, "Expected indexed parse error");
+}
+
 // ============================================================================
 // Diagram Tests
 // ============================================================================
@@ -257,6 +294,57 @@ TEST(diagram_cycle_detection_with_cycle) {
     REQUIRE(diagram.has_cycle(), "Expected cycle not detected");
 }
 
+TEST(diagram_incremental_cycle_order) {
+    // The maintained order must agree with a from-scratch check (a copy
+    // with a dirty index re-sorts) through random inserts and removals
+    Diagram diagram;
+    const int num_nodes = 40;
+    for (int i = 0; i < num_nodes; ++i) {
+        diagram.add_node(Node("n" + std::to_string(i), "P"));
+    }
+    REQUIRE(!diagram.has_cycle(), "Empty edge set is acyclic");
+
+    uint32_t rng = 12345;
+    auto next = [&rng]() {
+        rng = rng * 1664525u + 1013904223u;
+        return rng >> 8;
+    };
+    int rejected = 0;
+    for (int step = 0; step < 600; ++step) {
+        const std::string from = "n" + std::to_string(next() % num_nodes);
+        const std::string to = "n" + std::to_string(next() % num_nodes);
+        const std::string edge_id = "e" + std::to_string(step);
+        if (step % 5 == 4 && diagram.edges_count() > 0) {
+            diagram.take_edge_at(static_cast<uint32_t>(next() % diagram.edges_count()));
+        } else if (step % 3 == 0) {
+            diagram.add_edge(Edge(edge_id, from, to));
+        } else {
+            Diagram probe = diagram;
+            probe.edges().push_back(Edge(edge_id, from, to));
+            const bool was_acyclic = !diagram.has_cycle();
+            const bool added = diagram.try_add_edge(Edge(edge_id, from, to));
+            if (was_acyclic) {
+                REQUIRE(added == !probe.has_cycle(), "try_add_edge disagrees with a full check");
+            }
+            rejected += added ? 0 : 1;
+        }
+        Diagram fresh = diagram;
+        fresh.mark_dirty();
+        REQUIRE(diagram.has_cycle() == fresh.has_cycle(), "Incremental has_cycle differs at step " +
+                std::to_string(step));
+    }
+    REQUIRE(rejected > 0, "Expected some edges to be refused");
+
+    Diagram chain;
+    chain.add_edge(Edge("a", "x", "y"));
+    chain.add_edge(Edge("b", "y", "z"));
+    REQUIRE(!chain.has_cycle() && !chain.try_add_edge(Edge("c", "z", "x")) && !chain.has_cycle(),
+            "Back edge should be refused");
+    chain.add_edge(Edge("c", "z", "x"));
+    REQUIRE(chain.has_cycle(), "Back edge closes the cycle");
+    REQUIRE(chain.remove_edge("b") && !chain.has_cycle(), "Removing an edge of the cycle breaks it");
+}
+
 TEST(diagram_remove_node_cleans_edges) {
     Diagram diagram;
 
@@ -276,6 +364,84 @@ TEST(diagram_remove_node_cleans_edges) {
     REQUIRE(diagram.find_edge("e3") != nullptr, "Edge e3 should remain");
 }
 
+TEST(diagram_index_incremental_patch) {
+    Diagram diagram;
+
+    // Build a chain, query it (index built), then extend and prune it
+    for (int i = 0; i < 200; ++i) {
+        diagram.add_node(Node("n" + std::to_string(i), "A"));
+    }
+    for (int i = 0; i + 1 < 200; ++i) {
+        diagram.add_edge(Edge("e" + std::to_string(i), "n" + std::to_string(i), "n" + std::to_string(i + 1), "arg"));
+    }
+    REQUIRE(!diagram.has_cycle(), "Unexpected cycle in chain");
+
+    diagram.add_node(Node("hub", "B"));
+    for (int i = 0; i < 50; ++i) {
+        Edge edge("h" + std::to_string(i), "hub", "n" + std::to_string(i), "arg");
+        edge.port = 50 - i;
+        diagram.add_edge(edge);
+    }
+    REQUIRE(diagram.find_node("hub") != nullptr, "Node added after indexing not found");
+    REQUIRE(diagram.get_outputs("hub").size() == 50, "Hub out-degree mismatch");
+    REQUIRE(diagram.get_inputs("n10").size() == 2, "n10 in-degree mismatch");
+
+    diagram.add_edge(Edge("back", "n199", "n0", "arg"));
+    REQUIRE(diagram.has_cycle(), "Cycle added after indexing not detected");
+    REQUIRE(diagram.remove_edge("back"), "Remove edge failed");
+    REQUIRE(!diagram.has_cycle(), "Cycle remains after removing its edge");
+    REQUIRE(!diagram.remove_edge("back"), "Removed edge removed twice");
+
+    // Every incremental result must match a full rebuild
+    for (int i = 0; i < 50; i += 3) {
+        REQUIRE(diagram.remove_edge("h" + std::to_string(i)), "Remove hub edge failed");
+    }
+    Diagram rebuilt = diagram;
+    rebuilt.mark_dirty();
+    for (const auto& node : rebuilt.nodes()) {
+        REQUIRE(diagram.get_inputs(node.id) == rebuilt.get_inputs(node.id), "Incremental inputs differ from rebuild");
+        auto outputs = diagram.get_outputs(node.id);
+        auto expected = rebuilt.get_outputs(node.id);
+        std::sort(outputs.begin(), outputs.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(outputs == expected, "Incremental outputs differ from rebuild");
+    }
+    for (const auto& edge : rebuilt.edges()) {
+        const Edge* found = diagram.find_edge(edge.id);
+        REQUIRE(found && found->from == edge.from && found->to == edge.to, "Edge lookup differs from rebuild");
+    }
+}
+
+TEST(diagram_flat_attributes) {
+    Node node("n1", "P");
+    node.attributes["weight"] = 2.0;
+    node.attributes["label"] = std::string("left");
+    node.attributes["weight"] = 3.0;   // Overwrite, not a second entry
+    REQUIRE(node.attributes.size() == 2, "Expected two attributes");
+    REQUIRE(std::get<double>(node.attributes.find("weight")->second) == 3.0, "Wrong weight");
+    REQUIRE(node.attributes.find(AttrKeys::intern("label")) != node.attributes.end(), "Lookup by key failed");
+
+    // Kept sorted by key regardless of insertion order
+    AttrKey previous = 0;
+    bool first = true;
+    for (const auto& item : node.attributes) {
+        REQUIRE(first || item.first > previous, "Attributes not sorted by key");
+        previous = item.first;
+        first = false;
+    }
+
+    // Unknown names are not found and not interned
+    REQUIRE(node.attributes.find("never_set_anywhere") == node.attributes.end(), "Unexpected attribute");
+    REQUIRE(AttrKeys::find("never_set_anywhere") == kNoAttrKey, "Lookup should not intern");
+
+    Node copy = node;
+    REQUIRE(copy.attributes == node.attributes, "Copy should compare equal");
+    REQUIRE(copy.attributes.erase("label") == 1 && copy.attributes.size() == 1, "Erase failed");
+    REQUIRE(copy.attributes != node.attributes, "Erase should not affect the original");
+
+    REQUIRE(AttrKeys::name(attr_keys::kAtomArgs) == "atom_args", "Wrong built-in key name");
+}
+
 // ============================================================================
 // Validator Tests
 // ============================================================================
@@ -360,6 +526,296 @@ TEST(rewrite_apply_expr) {
     REQUIRE(found_o, "Expected O node after rewrite");
 }
 
+TEST(rewrite_compiled_rule_matches_expr) {
+    ASTNode ast = parseExpression("S+(P(A), P(B))");
+    Diagram diagram = exprToDiagram(ast, "d_compiled");
+
+    CompiledRule rule = compileRule("P($x)", "O($x)", "rw1");
+    REQUIRE(rule.valid, "Rule should compile");
+
+    // Reusing one compiled rule must reproduce the uncompiled rewrites
+    Diagram compiled = diagram;
+    Diagram parsed = diagram;
+    for (int i = 0; i < 3; ++i) {
+        auto a = applyCompiledRewrite(compiled, rule);
+        auto b = applyExprRewrite(parsed, "P($x)", "O($x)", "rw1");
+        REQUIRE(a.applied == b.applied && a.messages == b.messages, "Compiled rewrite result differs");
+        REQUIRE(a.diagram.nodes().size() == b.diagram.nodes().size(), "Compiled rewrite diagram differs");
+        compiled = a.diagram;
+        parsed = b.diagram;
+    }
+
+    CompiledRule broken = compileRule("P(", "O($x)", "rw_bad");
+    REQUIRE(!broken.valid, "Malformed rule should not compile");
+    auto result = applyCompiledRewrite(diagram, broken);
+    REQUIRE(!result.applied && !result.messages.empty() &&
+            result.messages[0].rfind("ERROR: ", 0) == 0, "Expected parse error message");
+}
+
+TEST(rewrite_match_uses_label_index) {
+    ASTNode ast = parseExpression("S+(P(A), P(B))");
+    Diagram diagram = exprToDiagram(ast, "d_index");
+    const size_t sum_position = diagram.nodes_with_op("S+").at(0);
+
+    // Added after the index was built: patched in, not yet matchable
+    Node narrow("narrow", "S+");
+    narrow.inputs.push_back(diagram.nodes()[0].id);
+    diagram.add_node(narrow);
+    Node tagged("tagged", "O");
+    tagged.meta["atom_args"] = std::vector<std::string>{"tag"};
+    diagram.add_node(tagged);
+
+    REQUIRE(diagram.nodes_with_op("S+").size() == 2, "Expected both S+ nodes indexed");
+    REQUIRE(diagram.nodes_with_op("missing").empty(), "Unknown op should have no nodes");
+    REQUIRE(diagram.nodes_with_atom("A").size() == 1, "Expected one node carrying A");
+    REQUIRE(diagram.nodes_with_atom("tag").size() == 1, "Expected atom_args indexed");
+
+    // The one-input S+ is filtered by arity; the match roots at the original
+    MatchScratch scratch;
+    auto match = findExprMatch(diagram, parseExpression("S+(P($x), P($y))"), scratch);
+    REQUIRE(match.has_value(), "Expected a match");
+    REQUIRE(std::get<0>(*match) == diagram.nodes()[sum_position].id, "Wrong root");
+    REQUIRE(std::get<1>(*match).size() == 2, "Expected two bindings");
+
+    // Scratch reuse must not leak state between searches
+    auto atom = findExprMatch(diagram, ASTNode::makeAtom("tag"), scratch);
+    REQUIRE(atom.has_value() && std::get<0>(*atom) == "tagged", "Expected atom_args match");
+    REQUIRE(std::get<1>(*atom).empty(), "Stale bindings from previous search");
+    REQUIRE(!findExprMatch(diagram, parseExpression("S-(P(A), P(B))"), scratch).has_value(), "Unexpected match");
+}
+
+// Node IDs and (id, from, to) of every edge, order-insensitive
+static std::pair<std::set<std::string>, std::set<std::string>> diagramContents(const Diagram& diagram) {
+    std::set<std::string> nodes;
+    std::set<std::string> edges;
+    for (const auto& node : diagram.nodes()) nodes.insert(node.id + ":" + node.op);
+    for (const auto& edge : diagram.edges()) edges.insert(edge.id + ":" + edge.from + "->" + edge.to);
+    return {nodes, edges};
+}
+
+TEST(rewrite_in_place_matches_copy) {
+    const std::vector<std::pair<std::string, std::string>> rules = {
+        {"P($x)", "O($x)"},
+        {"S+(P($x), P($y))", "S-(P($y), P($x))"},
+        {"O($x)", "T($x)"},
+    };
+    int applied = 0;
+    for (const auto& [pattern, replacement] : rules) {
+        Diagram copied = exprToDiagram(parseExpression("S+(P(A), O(P(B)))"), "d_inplace");
+        Diagram in_place = copied;
+        CompiledRule rule = compileRule(pattern, replacement, "rw");
+        for (int i = 0; i < 3; ++i) {
+            auto a = applyCompiledRewrite(copied, rule);
+            auto b = applyCompiledRewriteInPlace(in_place, rule);
+            REQUIRE(a.applied == b.applied && a.messages == b.messages, "In-place result differs");
+            applied += a.applied ? 1 : 0;
+            copied = a.diagram;
+            REQUIRE(diagramContents(copied) == diagramContents(in_place), "In-place diagram differs");
+            for (const auto& node : in_place.nodes()) {
+                REQUIRE(in_place.find_node(node.id) == &node, "Stale node index after in-place rewrite");
+            }
+        }
+    }
+    REQUIRE(applied >= 3, "Expected the rules to apply");
+}
+
+TEST(rewrite_in_place_undo_restores_diagram) {
+    Diagram diagram = exprToDiagram(parseExpression("S+(P(A), P(B))"), "d_undo");
+    const std::vector<Node> nodes_before = diagram.nodes();
+    const std::vector<Edge> edges_before = diagram.edges();
+
+    auto result = applyCompiledRewriteInPlace(diagram, compileRule("S+($x, $y)", "C($y, $x)", "rw"));
+    REQUIRE(result.applied && !result.undo.empty(), "Expected an applied rewrite with an undo log");
+    REQUIRE(diagram.nodes_with_op("S+").empty() && diagram.nodes_with_op("C").size() == 1,
+            "Label index not patched");
+
+    undoRewrite(diagram, result.undo);
+    REQUIRE(result.undo.empty(), "Undo log should be consumed");
+    REQUIRE(diagram.nodes().size() == nodes_before.size() && diagram.edges().size() == edges_before.size(),
+            "Undo changed the sizes");
+    for (size_t i = 0; i < nodes_before.size(); ++i) {
+        REQUIRE(diagram.nodes()[i].id == nodes_before[i].id, "Undo did not restore node order");
+        REQUIRE(diagram.node_position(nodes_before[i].id) == i, "Undo left a stale node index");
+    }
+    for (size_t i = 0; i < edges_before.size(); ++i) {
+        REQUIRE(diagram.edges()[i].id == edges_before[i].id &&
+                diagram.edges()[i].to == edges_before[i].to, "Undo did not restore edges");
+        REQUIRE(diagram.edge_position(edges_before[i].id) == i, "Undo left a stale edge index");
+    }
+    REQUIRE(diagram.nodes_with_op("S+").size() == 1 && diagram.nodes_with_op("C").empty(),
+            "Undo left a stale label index");
+}
+
+TEST(rewrite_in_place_rejects_cycle) {
+    // Collapsing O(x) onto x turns the edge x -> O into a self-loop
+    Diagram diagram = exprToDiagram(parseExpression("O(P(A))"), "d_inplace_cycle");
+    const auto contents = diagramContents(diagram);
+
+    auto result = applyCompiledRewriteInPlace(diagram, compileRule("O($x)", "$x", "rw_cycle"));
+    REQUIRE(!result.applied && result.undo.empty(), "Rewrite should reject cycle");
+    REQUIRE(!result.messages.empty() && result.messages[0].find("cycle") != std::string::npos,
+            "Expected cycle error");
+    REQUIRE(diagramContents(diagram) == contents, "Rejected rewrite changed the diagram");
+    REQUIRE(!diagram.has_cycle(), "Rejected rewrite left a cycle");
+}
+
+// n independent S+(P(ax), P(bx)) components
+static Diagram sumComponents(size_t n) {
+    Diagram diagram("d_components");
+    for (size_t i = 0; i < n; ++i) {
+        const std::string tag = std::to_string(i);
+        Node a("a" + tag, "P");
+        a.dof_refs.push_back("ax");
+        Node b("b" + tag, "P");
+        b.dof_refs.push_back("bx");
+        Node sum("s" + tag, "S+");
+        sum.inputs = {a.id, b.id};
+        diagram.add_node(a);
+        diagram.add_node(b);
+        diagram.add_node(sum);
+        diagram.add_edge(Edge("ea" + tag, a.id, sum.id, "arg"));
+        diagram.add_edge(Edge("eb" + tag, b.id, sum.id, "arg"));
+    }
+    return diagram;
+}
+
+TEST(fixpoint_converges_with_local_work) {
+    const size_t n = 200;
+    Diagram diagram = sumComponents(n);
+    CompiledRule swap = compileRule("S+($x, $y)", "S-($y, $x)", "swap");
+    CompiledRule close = compileRule("S-($x, $y)", "C($x, $y)", "close");
+    CompiledRule broken = compileRule("P(", "O($x)", "broken");
+    std::vector<const CompiledRule*> rules = {&swap, &close, &broken, nullptr};
+
+    FixpointResult result = runRewriteFixpoint(diagram, rules, FixpointOptions());
+    REQUIRE(!result.horizon_hit && result.steps == 2 * n, "Expected two rewrites per component");
+    REQUIRE(diagram.nodes_with_op("C").size() == n, "Expected every component closed");
+    for (const CompiledRule* rule : {&swap, &close}) {
+        REQUIRE(!findExprMatch(diagram, rule->pattern).has_value(), "Not a fixed point");
+    }
+    // Seeding plus a few candidates per rewrite, not passes x diagram size
+    REQUIRE(result.candidates_tried <= 4 * n, "Fixpoint rescanned the diagram");
+    REQUIRE(!diagram.has_cycle(), "Fixpoint introduced a cycle");
+}
+
+TEST(fixpoint_policy_and_horizon) {
+    Diagram diagram = sumComponents(1);
+    CompiledRule swap = compileRule("S+($x, $y)", "S-($y, $x)", "swap");
+    CompiledRule collapse = compileRule("P($x)", "O($x)", "collapse");   // P nodes survive: never converges
+    std::vector<const CompiledRule*> rules = {&swap, &collapse};
+
+    FixpointOptions options;
+    options.policy = "P2";
+    options.horizon_cap = 5;
+    FixpointResult result = runRewriteFixpoint(diagram, rules, options);
+    REQUIRE(result.horizon_hit && result.steps == 5, "Expected to stop at the horizon");
+    REQUIRE(result.applied_trace.size() == 5 && result.applied_trace[0] == 1 && result.applied_trace[1] == 0,
+            "P2 should try the last rule first");
+}
+
+TEST(parallel_match_single_priority) {
+    Diagram diagram = sumComponents(3);
+    CompiledRule swap = compileRule("S+($x, $y)", "S-($y, $x)", "swap");
+    CompiledRule close = compileRule("S-($x, $y)", "C($x, $y)", "close");
+    std::vector<const CompiledRule*> rules = {&swap, &close};
+
+    auto first = findRuleMatches(diagram, rules, false);
+    REQUIRE(first.size() == 1 && first[0].rule == 0 && first[0].root_id == "s0",
+            "Expected only swap to match, at its first root");
+    auto all = findRuleMatches(diagram, rules, true);
+    REQUIRE(all.size() == 3 && all[2].root_id == "s2", "Expected every swap match in node order");
+
+    FixpointResult result = runParallelRewrites(diagram, rules, FixpointOptions(), false);
+    REQUIRE(!result.horizon_hit && result.steps == 6, "Expected two rewrites per component");
+    REQUIRE(diagram.nodes_with_op("C").size() == 3, "Expected every component closed");
+    // Under P1 every swap outranks every close
+    const std::vector<size_t> expected = {0, 0, 0, 1, 1, 1};
+    REQUIRE(result.applied_trace == expected, "Wrong priority order");
+}
+
+TEST(parallel_match_batch_disjoint) {
+    const size_t n = 50;
+    Diagram diagram = sumComponents(n);
+    CompiledRule swap = compileRule("S+($x, $y)", "S-($y, $x)", "swap");
+    CompiledRule shadow = compileRule("S+(P($x), P($y))", "T($x)", "shadow");   // Same roots as swap
+    CompiledRule close = compileRule("S-($x, $y)", "C($x, $y)", "close");
+    std::vector<const CompiledRule*> rules = {&swap, &shadow, &close};
+
+    FixpointResult result = runParallelRewrites(diagram, rules, FixpointOptions(), true);
+    REQUIRE(!result.horizon_hit && result.steps == 2 * n, "Expected swap then close on every component");
+    for (size_t i = 0; i < n; ++i) {
+        REQUIRE(result.applied_trace[i] == 0, "swap outranks the overlapping shadow rule");
+        REQUIRE(result.applied_trace[n + i] == 2, "Second round should close every component");
+    }
+    REQUIRE(diagram.nodes_with_op("T").empty() && diagram.nodes_with_op("C").size() == n,
+            "Overlapping matches applied");
+    REQUIRE(!diagram.has_cycle(), "Batch introduced a cycle");
+}
+
+TEST(match_network_shares_subpatterns) {
+    CompiledRule swap = compileRule("S+($x, $y)", "S-($y, $x)", "swap");
+    CompiledRule renamed = compileRule("S+($a, $b)", "C($a, $b)", "renamed");   // Same network root
+    CompiledRule nested = compileRule("S-(P($x), S+($y, $z))", "T($x)", "nested");
+    CompiledRule broken = compileRule("P(", "O($x)", "broken");
+    std::vector<const CompiledRule*> rules = {&swap, &renamed, &nested, &broken, nullptr};
+
+    // ?, S+(?, ?), P(?), S-(P(?), S+(?, ?))
+    MatchNetwork network(rules);
+    REQUIRE(network.node_count() == 4 && network.root_count() == 2, "Sub-patterns not shared");
+
+    Diagram diagram = sumComponents(3);
+    network.attach(diagram);
+    REQUIRE(network.match_count(0) == 3 && network.match_count(1) == 3 && network.match_count(2) == 0 &&
+            network.match_count(3) == 0 && network.match_count(4) == 0, "Wrong conflict sets");
+
+    RuleMatch match;
+    REQUIRE(network.first_match(diagram, 1, match), "Expected a match");
+    MatchScratch scratch;
+    REQUIRE(matchExpr(renamed.pattern, "s0", diagram, scratch.bindings, scratch.matched, scratch.bound_nodes),
+            "matchExpr disagrees");
+    REQUIRE(match.root_id == "s0" && match.bindings == scratch.bindings && match.matched == scratch.matched &&
+            match.bound_nodes == scratch.bound_nodes, "Network match differs from matchExpr");
+}
+
+TEST(match_network_rewrites_like_parallel) {
+    const size_t n = 200;
+    CompiledRule swap = compileRule("S+($x, $y)", "S-($y, $x)", "swap");
+    CompiledRule shadow = compileRule("S+(P($x), P($y))", "T($x)", "shadow");
+    CompiledRule close = compileRule("S-($x, $y)", "C($x, $y)", "close");
+    CompiledRule lift = compileRule("C($x, P(ax))", "O($x)", "lift");   // Matches the P left bound by close
+    std::vector<const CompiledRule*> rules = {&swap, &shadow, &close, &lift};
+
+    for (const char* policy : {"P1", "P2", "P3"}) {
+        FixpointOptions options;
+        options.policy = policy;
+        options.seed = 7;
+        Diagram searched = sumComponents(n);
+        Diagram networked = sumComponents(n);
+        FixpointResult expected = runParallelRewrites(searched, rules, options, false);
+        FixpointResult result = runNetworkRewrites(networked, rules, options);
+        REQUIRE(result.applied_trace == expected.applied_trace && result.horizon_hit == expected.horizon_hit,
+                std::string("Network trace differs from parallel under ") + policy);
+        REQUIRE(diagramContents(networked) == diagramContents(searched),
+                std::string("Network result differs from parallel under ") + policy);
+        REQUIRE(!networked.has_cycle(), "Network introduced a cycle");
+        // Seeding plus the touched neighbourhood of each rewrite
+        REQUIRE(result.candidates_tried <= 10 * n + 10 * result.steps, "Network re-matched the diagram");
+    }
+
+    // Horizon, and a rule whose rewrite is rejected as a cycle falls through
+    Diagram cyclic = exprToDiagram(parseExpression("O(P(A))"), "d_network_cycle");
+    CompiledRule collapse = compileRule("O($x)", "$x", "rw_cycle");
+    CompiledRule wrap = compileRule("P($x)", "O($x)", "wrap");
+    std::vector<const CompiledRule*> cycle_rules = {&collapse, &wrap};
+    FixpointOptions options;
+    options.horizon_cap = 3;
+    Diagram searched = cyclic;
+    FixpointResult expected = runParallelRewrites(searched, cycle_rules, options, false);
+    FixpointResult result = runNetworkRewrites(cyclic, cycle_rules, options);
+    REQUIRE(result.horizon_hit && result.applied_trace == expected.applied_trace &&
+            diagramContents(cyclic) == diagramContents(searched), "Cycle fallthrough differs from parallel");
+}
+
 TEST(rewrite_rejects_cycle) {
     Diagram diagram("d_cycle");
     Node n1("n1", "P");
@@ -448,6 +904,129 @@ TEST(ssp_mixer_collapse) {
             "Conservation error exceeded tolerance after collapse");
 }
 
+TEST(ssp_field_kernels_simd_matches_scalar) {
+    if (!FieldKernels::avx2Available()) {
+        return;   // Only the scalar kernels exist on this CPU
+    }
+
+    const size_t len = 1003;   // Not a multiple of the vector width
+    std::vector<double> base(len);
+    for (size_t i = 0; i < len; ++i) {
+        base[i] = 0.5 + 0.25 * std::sin(0.37 * static_cast<double>(i)) + (i % 7 == 0 ? -0.6 : 0.0);
+    }
+    auto close = [](double a, double b) { return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(a)); };
+
+    const FieldOp ops[] = {FieldOp::None, FieldOp::Scale, FieldOp::AddUniform, FieldOp::SubtractClamped};
+    for (FieldOp op : ops) {
+        std::vector<double> scalar = base;
+        std::vector<double> simd = base;
+        FieldStatistics a = FieldKernels::transform(false, scalar.data(), len, op, 0.3);
+        FieldStatistics b = FieldKernels::transform(true, simd.data(), len, op, 0.3);
+        REQUIRE(scalar == simd, "Element-wise update should be exact");
+        REQUIRE(close(a.sum, b.sum) && close(a.sum_sq, b.sum_sq) && close(a.divergence_sum, b.divergence_sum),
+                "Statistics mismatch");
+        REQUIRE(close(a.sum, FieldKernels::sum(true, simd.data(), len)), "Sum mismatch");
+    }
+
+    // Masked collapse stops at the same bad mask value, with the same prefix
+    std::vector<double> mask(len, 0.5);
+    mask[517] = 1.5;
+    std::vector<double> scalar = base;
+    std::vector<double> simd = base;
+    REQUIRE(FieldKernels::collapseMasked(false, scalar.data(), mask.data(), len, 0.2) == 517 &&
+            FieldKernels::collapseMasked(true, simd.data(), mask.data(), len, 0.2) == 517,
+            "Expected stop at the invalid mask value");
+    REQUIRE(scalar == simd, "Collapse prefix mismatch");
+}
+
+TEST(ssp_mixer_step_and_commit_matches_step) {
+    const uint64_t len = 257;
+    const double total_mass = 90.0;
+    const double u_start[] = {40.0, 20.0, 0.0};   // Excess, deficit (scale), deficit (add)
+
+    for (double u_mass : u_start) {
+        SemanticProcessor I1(Role::I, len, total_mass), N1(Role::N, len, total_mass), U1(Role::U, len, total_mass);
+        SemanticProcessor I2(Role::I, len, total_mass), N2(Role::N, len, total_mass), U2(Role::U, len, total_mass);
+        for (SemanticProcessor* p : {&I1, &N1, &U1, &I2, &N2, &U2}) {
+            p->set_simd(false);   // Bit-exact comparison
+        }
+        for (size_t i = 0; i < len; ++i) {
+            const double w = 1.0 + 0.5 * std::cos(static_cast<double>(i));
+            I1.field()[i] = I2.field()[i] = 30.0 * w / len;
+            N1.field()[i] = N2.field()[i] = 30.0 / len;
+            U1.field()[i] = U2.field()[i] = u_mass * w / len;
+        }
+
+        Mixer separate(total_mass);
+        Mixer fused(total_mass);
+        for (int step = 0; step < 3; ++step) {
+            separate.step(I1, N1, U1);
+            I1.commit_step();
+            N1.commit_step();
+            U1.commit_step();
+            fused.step_and_commit(I2, N2, U2);
+        }
+
+#ifdef __FAST_MATH__
+        // -ffast-math may vectorize the scalar sums: equal up to summation order
+        auto same = [](double a, double b) { return std::abs(a - b) <= 1e-12 * std::max(1.0, std::abs(a)); };
+#else
+        auto same = [](double a, double b) { return a == b; };
+#endif
+        for (size_t i = 0; i < len; ++i) {
+            REQUIRE(same(U1.field()[i], U2.field()[i]), "Fused step changed the U field differently");
+        }
+        REQUIRE(same(separate.metrics().undecided_volume, fused.metrics().undecided_volume) &&
+                same(separate.metrics().loop_gain, fused.metrics().loop_gain) &&
+                same(separate.metrics().conservation_error, fused.metrics().conservation_error),
+                "Mixer metrics mismatch");
+        REQUIRE(same(U1.metrics().coherence, U2.metrics().coherence) &&
+                same(U1.metrics().divergence, U2.metrics().divergence) &&
+                same(I1.metrics().stability, I2.metrics().stability),
+                "Processor metrics mismatch");
+        REQUIRE(U1.step() == U2.step(), "Step counters differ");
+    }
+}
+
+TEST(ssp_engine_running_masses) {
+    SidTernaryEngine engine(4099, 300.0);
+    auto resum = [](const std::vector<double>& field) {
+        double sum = 0.0;
+        for (double v : field) sum += v;
+        return sum;
+    };
+
+    for (int round = 0; round < 20; ++round) {
+        engine.step();
+        engine.collapse(0.05);
+        engine.step();
+    }
+
+    // Getters read the running totals; they track the fields to round-off
+    REQUIRE(std::abs(engine.getIMass() - resum(engine.getIField())) < 1e-9, "I mass drifted");
+    REQUIRE(std::abs(engine.getNMass() - resum(engine.getNField())) < 1e-9, "N mass drifted");
+    REQUIRE(std::abs(engine.getUMass() - resum(engine.getUField())) < 1e-9, "U mass drifted");
+    REQUIRE(engine.getIMass() > engine.getUMass(), "Collapse should have moved U into I");
+    REQUIRE(engine.isConserved(1e-6), "Expected conservation");
+
+    REQUIRE(engine.resyncMasses() < 1e-9, "Resync found drift");
+    engine.setMassResyncInterval(3);
+    for (int i = 0; i < 7; ++i) engine.step();
+    REQUIRE(std::abs(engine.getUMass() - resum(engine.getUField())) < 1e-9, "U mass drifted after resync");
+}
+
+TEST(ssp_engine_rewrite_messages) {
+    SidTernaryEngine engine(16, 10.0);
+    REQUIRE(engine.setDiagramExpr("S+(P(A), P(B))", "d_messages"), "Diagram should parse");
+
+    REQUIRE(engine.applyRewrite("P($x)", "O($x)", "rw1"), "Rewrite should apply");
+    REQUIRE(engine.lastRewriteMessage() == "Rewrite rw1 applied", "Unexpected rewrite message");
+    REQUIRE(!engine.applyRewrite("O(Missing)", "P(Missing)", "rw2"), "Rewrite should not apply");
+    REQUIRE(engine.lastRewriteMessage() == "Rewrite rw2 not applicable", "Unexpected miss message");
+    REQUIRE(engine.applyCompiledRule(-1) == false && engine.lastRewriteMessage() == "Unknown compiled rule",
+            "Unexpected handle message");
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -468,6 +1047,7 @@ int main() {
     run_test_parser_nested_operators();
     run_test_parser_multi_arg_operator();
     run_test_parser_invalid_expression_throws();
+    run_test_parser_arena_bulk_parse();
 
     // Diagram tests
     run_test_diagram_add_nodes();
@@ -475,7 +1055,10 @@ int main() {
     run_test_diagram_get_inputs();
     run_test_diagram_cycle_detection_no_cycle();
     run_test_diagram_cycle_detection_with_cycle();
+    run_test_diagram_incremental_cycle_order();
     run_test_diagram_remove_node_cleans_edges();
+    run_test_diagram_index_incremental_patch();
+    run_test_diagram_flat_attributes();
 
     // Validator tests
     run_test_validator_valid_diagram();
@@ -487,6 +1070,17 @@ int main() {
 
     // Rewrite tests
     run_test_rewrite_apply_expr();
+    run_test_rewrite_compiled_rule_matches_expr();
+    run_test_rewrite_match_uses_label_index();
+    run_test_rewrite_in_place_matches_copy();
+    run_test_rewrite_in_place_undo_restores_diagram();
+    run_test_rewrite_in_place_rejects_cycle();
+    run_test_fixpoint_converges_with_local_work();
+    run_test_fixpoint_policy_and_horizon();
+    run_test_parallel_match_single_priority();
+    run_test_parallel_match_batch_disjoint();
+    run_test_match_network_shares_subpatterns();
+    run_test_match_network_rewrites_like_parallel();
     run_test_rewrite_rejects_cycle();
 
     // SSP tests
@@ -495,6 +1089,10 @@ int main() {
     run_test_ssp_scale_all();
     run_test_ssp_mixer_conservation();
     run_test_ssp_mixer_collapse();
+    run_test_ssp_field_kernels_simd_matches_scalar();
+    run_test_ssp_mixer_step_and_commit_matches_step();
+    run_test_ssp_engine_running_masses();
+    run_test_ssp_engine_rewrite_messages();
 
     std::cout << "\n=======================================\n";
     std::cout << "Results: " << tests_passed << " passed, " << tests_failed << " failed\n";
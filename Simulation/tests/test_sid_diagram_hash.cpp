@@ -0,0 +1,165 @@
+/**
+ * SID diagram hash / rewrite memo test
+ *
+ * The canonical hash must ignore node IDs and order but see ops, atoms and
+ * input order.  After every in-place rewrite the engine's incrementally
+ * updated hash must equal a from-scratch hash of its diagram, and rewrites
+ * answered from the no-match memo must leave exactly the diagrams and
+ * messages of uncached rewrites.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -Isrc/cpp tests/test_sid_diagram_hash.cpp
+ */
+
+#include "../src/cpp/sid_ssp/sid_diagram_hash.hpp"
+#include "../src/cpp/sid_ternary_engine.hpp"
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace sid;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+uint64_t freshHash(const Diagram& diagram) {
+    DiagramHasher hasher;
+    hasher.reset(diagram);
+    return hasher.hash();
+}
+
+Node makeNode(const std::string& id, const std::string& op, std::vector<std::string> inputs,
+              std::vector<std::string> dofs = {}) {
+    Node node(id, op);
+    node.inputs = std::move(inputs);
+    node.dof_refs = std::move(dofs);
+    return node;
+}
+
+void testCanonical() {
+    Diagram a("a");
+    a.add_node(makeNode("p", "P", {}, {"A"}));
+    a.add_node(makeNode("q", "P", {}, {"B"}));
+    a.add_node(makeNode("s", "S+", {"p", "q"}));
+
+    Diagram b("b");
+    b.add_node(makeNode("z", "S+", {"x", "y"}));
+    b.add_node(makeNode("y", "P", {}, {"B"}));
+    b.add_node(makeNode("x", "P", {}, {"A"}));
+    b.add_edge(Edge("e", "x", "z", "arg"));
+    expect(freshHash(a) == freshHash(b), "renamed, reordered diagram hashes alike");
+
+    Diagram swapped("c");
+    swapped.add_node(makeNode("p", "P", {}, {"A"}));
+    swapped.add_node(makeNode("q", "P", {}, {"B"}));
+    swapped.add_node(makeNode("s", "S+", {"q", "p"}));
+    expect(freshHash(a) != freshHash(swapped), "input order is seen");
+
+    Diagram other_atom("d");
+    other_atom.add_node(makeNode("p", "P", {}, {"A"}));
+    other_atom.add_node(makeNode("q", "P", {}, {"C"}));
+    other_atom.add_node(makeNode("s", "S+", {"p", "q"}));
+    expect(freshHash(a) != freshHash(other_atom), "atoms are seen");
+
+    // update() after hand edits equals a fresh hash
+    DiagramHasher hasher;
+    hasher.reset(a);
+    a.add_node(makeNode("t", "O", {"s"}));
+    hasher.update(a, {"t"});
+    expect(hasher.hash() == freshHash(a), "update after an added node");
+    a.take_node_at(static_cast<uint32_t>(a.node_position("q")));
+    hasher.update(a, {"q"});
+    expect(hasher.hash() == freshHash(a), "update after a removed input");
+    a.add_node(makeNode("q", "P", {}, {"B"}));
+    hasher.update(a, {"q"});
+    expect(hasher.hash() == freshHash(a), "update after a re-added input");
+}
+
+void testMemo() {
+    const CompiledRule plain = compileRule("S+($x, $y)", "S-($x, $y)", "r");
+    const CompiledRule repeated = compileRule("S+($x, $x)", "P(A)", "r");
+    const CompiledRule deep = compileRule("O(O(O(O(O($x)))))", "P(A)", "r");
+    expect(ruleMemoizable(plain), "plain rule is memoizable");
+    expect(!ruleMemoizable(repeated), "repeated variable is not memoizable");
+    expect(!ruleMemoizable(deep), "pattern deeper than the hash is not memoizable");
+
+    RewriteMemo memo(100);
+    expect(memo.capacity() == 128, "capacity rounds to a power of two");
+    memo.recordNoMatch(7, 1);
+    expect(memo.knownNoMatch(7, 1) && !memo.knownNoMatch(7, 2) && !memo.knownNoMatch(8, 1), "memo keys");
+    expect(memo.hits() == 1 && memo.misses() == 2, "memo counters");
+}
+
+// Random rewrite sequences through the engine (memo, incremental hash)
+// against the same sequence of plain in-place rewrites
+void testEngineTrajectory() {
+    const std::vector<std::pair<std::string, std::string>> rules = {
+        {"S+($x, $y)", "S-($y, $x)"}, {"S-($x, $y)", "C($x, $y)"}, {"C($x, $y)", "S+($x, $y)"},
+        {"P(A)", "P(B)"}, {"P(B)", "P(A)"}, {"O($x)", "$x"}, {"T($x)", "O($x)"},
+        {"S+($x, $x)", "P(C)"}, {"C(P(A), $y)", "T($y)"},
+    };
+    std::mt19937 rng(7);
+    size_t applied_total = 0;
+    uint64_t memo_hits = 0;
+    for (int trial = 0; trial < 20; ++trial) {
+        SidTernaryEngine engine(8, 10.0);
+        const std::string expr = "S+(C(P(A), S+(P(B), T(P(A)))), S-(O(P(B)), S+(P(A), P(A))))";
+        expect(engine.setDiagramExpr(expr, "d"), "diagram parses");
+        Diagram reference = exprToDiagram(parseExpression(expr), "d");
+
+        std::vector<int64_t> handles;
+        std::vector<CompiledRule> compiled;
+        for (size_t i = 0; i < rules.size(); ++i) {
+            const std::string id = "rw" + std::to_string(i);
+            handles.push_back(engine.compileRule(rules[i].first, rules[i].second, id));
+            compiled.push_back(compileRule(rules[i].first, rules[i].second, id));
+        }
+
+        for (int step = 0; step < 60; ++step) {
+            const size_t r = rng() % rules.size();
+            const bool applied = engine.applyCompiledRule(handles[r]);
+            InPlaceRewriteResult expected = applyCompiledRewriteInPlace(reference, compiled[r]);
+            expect(applied == expected.applied, "same outcome, trial " + std::to_string(trial));
+            applied_total += applied ? 1 : 0;
+            expect(engine.lastRewriteMessage() == expected.messages.front(), "same message");
+
+            std::string text;
+            writeDiagramJson(reference, text);
+            expect(engine.getDiagramJson() == text, "same diagram, step " + std::to_string(step));
+            expect(engine.diagramHash() == freshHash(reference), "incremental hash, step " + std::to_string(step));
+        }
+        memo_hits += engine.rewriteMemo().hits();
+    }
+    expect(applied_total > 100 && memo_hits > 100, "trajectories rewrite and hit the memo");
+
+    SidTernaryEngine engine(8, 10.0);
+    engine.setDiagramExpr("S+(P(A), P(B))", "d");
+    const int64_t miss = engine.compileRule("O($x)", "P(A)", "miss");
+    const uint64_t hits = engine.rewriteMemo().hits();
+    expect(!engine.applyCompiledRule(miss) && !engine.applyCompiledRule(miss), "rule misses");
+    expect(engine.rewriteMemo().hits() == hits + 1, "second miss answered from the memo");
+    expect(engine.lastRewriteMessage() == "Rewrite miss not applicable", "memo miss message");
+}
+
+} // namespace
+
+int main() {
+    testCanonical();
+    testMemo();
+    testEngineTrajectory();
+
+    if (failures != 0) {
+        std::cerr << "test_sid_diagram_hash: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_sid_diagram_hash: PASS" << std::endl;
+    return 0;
+}
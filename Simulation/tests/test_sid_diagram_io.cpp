@@ -0,0 +1,175 @@
+/**
+ * SID diagram I/O test
+ *
+ * The streaming JSON writer must produce the bytes nlohmann's dump() of the
+ * former DOM gave, and the SAX reader must accept, default and reject
+ * exactly what the DOM reader did.  The binary form must round-trip
+ * (ports of either sign, shared strings, empty lists) and reject truncated
+ * or trailing data.  Engine checkpoints carry the binary diagram.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -Isrc/cpp tests/test_sid_diagram_io.cpp
+ */
+
+#include "../src/cpp/sid_ssp/sid_diagram_io.hpp"
+#include "../src/cpp/sid_ternary_engine.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace sid;
+using json = nlohmann::json;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+// The DOM writer the streaming one replaces
+std::string domWrite(const Diagram& diagram) {
+    json data;
+    data["id"] = diagram.id();
+    data["nodes"] = json::array();
+    data["edges"] = json::array();
+    for (const auto& node : diagram.nodes()) {
+        data["nodes"].push_back({{"id", node.id}, {"op", node.op}, {"inputs", node.inputs},
+                                 {"dof_refs", node.dof_refs}});
+    }
+    for (const auto& edge : diagram.edges()) {
+        data["edges"].push_back({{"id", edge.id}, {"from", edge.from}, {"to", edge.to},
+                                 {"label", edge.label}, {"port", edge.port}});
+    }
+    return data.dump();
+}
+
+bool sameDiagram(const Diagram& a, const Diagram& b) {
+    if (a.id() != b.id() || a.nodes_count() != b.nodes_count() || a.edges_count() != b.edges_count()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.nodes_count(); ++i) {
+        const Node& x = a.nodes()[i];
+        const Node& y = b.nodes()[i];
+        if (x.id != y.id || x.op != y.op || x.inputs != y.inputs || x.dof_refs != y.dof_refs) return false;
+    }
+    for (size_t i = 0; i < a.edges_count(); ++i) {
+        const Edge& x = a.edges()[i];
+        const Edge& y = b.edges()[i];
+        if (x.id != y.id || x.from != y.from || x.to != y.to || x.label != y.label || x.port != y.port) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Diagram sample(size_t nodes) {
+    Diagram diagram("sample \"quoted\"\n");
+    for (size_t i = 0; i < nodes; ++i) {
+        Node node("n" + std::to_string(i), i % 3 == 0 ? "P" : "S+");
+        if (i % 3 == 0) node.dof_refs.push_back(i % 2 ? "Freedom" : "tab\there");
+        if (i > 0) node.inputs.push_back("n" + std::to_string(i - 1));
+        diagram.add_node(node);
+        if (i > 0) {
+            Edge edge("e" + std::to_string(i), "n" + std::to_string(i - 1), node.id, i % 4 ? "arg" : "ctl\x01");
+            edge.port = static_cast<int>(i % 7) - 3;
+            diagram.add_edge(edge);
+        }
+    }
+    return diagram;
+}
+
+void testJson() {
+    const Diagram diagram = sample(50);
+    std::string streamed;
+    writeDiagramJson(diagram, streamed);
+    expect(streamed == domWrite(diagram), "streaming writer matches DOM dump");
+    std::string empty;
+    writeDiagramJson(Diagram("e"), empty);
+    expect(empty == domWrite(Diagram("e")), "empty diagram matches DOM dump");
+
+    Diagram read;
+    std::string error;
+    expect(readDiagramJson(streamed, read, error) && sameDiagram(read, diagram), "JSON round trip " + error);
+
+    // Defaults, skipping and dropping as the DOM reader did
+    const std::string loose = R"({"extra":{"nodes":[1]},"nodes":[{"id":"a","inputs":["x",3,null],"more":[{}]},)"
+                              R"({"op":"P"}],"edges":[{"id":"e","from":"a","to":"b","port":2.9},{"from":"a"}]})";
+    expect(readDiagramJson(loose, read, error), "loose diagram reads " + error);
+    expect(read.id() == "sid_engine_diagram" && read.nodes_count() == 1 && read.nodes()[0].inputs.size() == 1 &&
+           read.edges_count() == 1 && read.edges()[0].label == "arg" && read.edges()[0].port == 2,
+           "defaults and skipped entries");
+    expect(readDiagramJson(R"({"nodes":[{"id":"a"}],"nodes":[]})", read, error) && read.nodes_count() == 0,
+           "repeated key: last wins");
+
+    Diagram untouched = sample(3);
+    const char* bad[] = {"[1]", "5", "{\"id\":3}", "{\"nodes\":[1]}", "{\"nodes\":[{\"id\":[\"a\"]}]}",
+                         "{\"edges\":[{\"id\":\"e\",\"port\":\"1\"}]}", "{\"edges\":[{\"id\":null}]}", "{\"id\":"};
+    for (const char* text : bad) {
+        expect(!readDiagramJson(text, untouched, error) && !error.empty(), std::string("rejected: ") + text);
+    }
+    expect(sameDiagram(untouched, sample(3)), "failed read leaves the diagram alone");
+}
+
+void testBinary() {
+    const Diagram diagram = sample(200);
+    std::string bytes;
+    writeDiagramBinary(diagram, bytes);
+    Diagram read;
+    std::string error;
+    expect(readDiagramBinary(bytes.data(), bytes.size(), read, error) && sameDiagram(read, diagram),
+           "binary round trip " + error);
+    std::string as_json;
+    writeDiagramJson(diagram, as_json);
+    expect(bytes.size() * 2 < as_json.size(), "binary form is compact");
+
+    for (size_t cut : {size_t(0), size_t(3), size_t(5), bytes.size() / 2, bytes.size() - 1}) {
+        expect(!readDiagramBinary(bytes.data(), cut, read, error), "truncated at " + std::to_string(cut));
+    }
+    std::string trailing = bytes + '\0';
+    expect(!readDiagramBinary(trailing.data(), trailing.size(), read, error), "trailing bytes rejected");
+    std::string version = bytes;
+    version[4] = 2;
+    expect(!readDiagramBinary(version.data(), version.size(), read, error), "unknown version rejected");
+    expect(sameDiagram(read, diagram), "failed decode leaves the diagram alone");
+}
+
+void testEngine() {
+    SidTernaryEngine engine(8, 10.0);
+    const Diagram diagram = sample(40);
+    std::string text;
+    writeDiagramJson(diagram, text);
+    expect(engine.setDiagramJson(text) && engine.getDiagramJson() == text, "engine JSON round trip");
+    const std::string bytes = engine.getDiagramBinary();
+    expect(engine.setDiagramExpr("P(A)", "d") && engine.setDiagramBinary(bytes.data(), bytes.size()) &&
+           engine.getDiagramJson() == text, "engine binary round trip");
+    expect(!engine.setDiagramJson("{\"nodes\":[1]}") && engine.getDiagramJson() == text &&
+           engine.lastRewriteMessage().rfind("Diagram parse error: ", 0) == 0, "engine keeps diagram on error");
+
+    const std::string path = "/tmp/dase_sid_diagram_io.ckpt";
+    dase::CheckpointWriter writer;
+    engine.saveCheckpoint(writer);
+    writer.write(path);
+    SidTernaryEngine restored(8, 10.0);
+    restored.restoreCheckpoint(dase::CheckpointImage(path));
+    expect(restored.getDiagramJson() == text, "checkpoint carries the binary diagram");
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    testJson();
+    testBinary();
+    testEngine();
+
+    if (failures != 0) {
+        std::cerr << "test_sid_diagram_io: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_sid_diagram_io: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * Spatial grid test
+ *
+ * SpatialGrid1D/2D/3D (flat counting-sort cells, spatial_hash.h) must visit
+ * exactly the candidates of the SpatialHash query, in the same order, for
+ * lattice sites and scattered points, and NeighborCache2D/3D built on the
+ * grid must find every wrapped neighbour inside the lattice interior.
+ *
+ * Build: g++ -std=c++17 -O2 -Isrc/cpp tests/test_spatial_grid.cpp
+ */
+
+#include "../src/cpp/neighbor_cache.h"
+#include "../src/cpp/spatial_hash.h"
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dase::igsoa;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+void testLattice2D() {
+    const size_t n_x = 23;
+    const size_t n_y = 17;
+    const double R_c = 3.0;
+    SpatialHash2D hash(n_x, n_y, R_c);
+    SpatialGrid2D grid(n_x, n_y, R_c);
+    for (size_t i = 0; i < n_x * n_y; ++i) {
+        hash.insert(static_cast<int>(i), static_cast<int>(i % n_x), static_cast<int>(i / n_x));
+    }
+    grid.buildLattice();
+
+    bool same = true;
+    std::vector<int> visited;
+    for (size_t i = 0; i < n_x * n_y && same; ++i) {
+        const int x = static_cast<int>(i % n_x);
+        const int y = static_cast<int>(i / n_x);
+        for (int range : {1, 3, 7}) {
+            visited.clear();
+            grid.forEachInRange(x, y, range, [&](int id) { visited.push_back(id); });
+            same = same && visited == hash.query(x, y, range);
+        }
+    }
+    expect(same, "2D lattice: grid visits the hash candidates in order");
+}
+
+void testPoints3D() {
+    const size_t n = 20;
+    const double R_c = 2.5;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> coord(0, static_cast<int>(n) - 1);
+    std::vector<int> px(500), py(500), pz(500);
+    SpatialHash3D hash(n, n, n, R_c);
+    for (size_t k = 0; k < px.size(); ++k) {
+        px[k] = coord(rng);
+        py[k] = coord(rng);
+        pz[k] = coord(rng);
+        hash.insert(static_cast<int>(k), px[k], py[k], pz[k]);
+    }
+    SpatialGrid3D grid(n, n, n, R_c);
+    grid.build(px.size(), [&](size_t id, int (&c)[3]) {
+        c[0] = px[id];
+        c[1] = py[id];
+        c[2] = pz[id];
+    });
+
+    bool same = true;
+    std::vector<int> visited;
+    for (int q = 0; q < 200 && same; ++q) {
+        const int x = coord(rng);
+        const int y = coord(rng);
+        const int z = coord(rng);
+        visited.clear();
+        grid.forEachInRange(x, y, z, 4, [&](int id) { visited.push_back(id); });
+        same = visited == hash.query(x, y, z, 4);
+    }
+    expect(same, "3D points: grid visits the hash candidates in order");
+}
+
+void testLattice1D() {
+    const size_t n = 50;
+    SpatialHash1D hash(n, 4.0);
+    SpatialGrid1D grid(n, 4.0);
+    for (size_t i = 0; i < n; ++i) {
+        hash.insert(static_cast<int>(i), static_cast<int>(i));
+    }
+    grid.buildLattice();
+    bool same = true;
+    std::vector<int> visited;
+    for (int x = 0; x < static_cast<int>(n); ++x) {
+        visited.clear();
+        grid.forEachInRange(x, 5, [&](int id) { visited.push_back(id); });
+        same = same && visited == hash.query(x, 5);
+    }
+    expect(same, "1D lattice: grid visits the hash candidates in order");
+}
+
+void testNeighborCache() {
+    // Interior nodes see the full disc / ball (12 sites within 2 in 2D,
+    // 18 within 1.5 in 3D)
+    NeighborCache2D cache2d(16, 16, 2.0);
+    cache2d.build();
+    expect(cache2d.getNeighborCount(8 * 16 + 8) == 12, "2D cache interior neighbour count");
+    NeighborCache3D cache3d(10, 10, 10, 1.5);
+    cache3d.build();
+    expect(cache3d.getNeighborCount((5 * 10 + 5) * 10 + 5) == 18, "3D cache interior neighbour count");
+    expect(cache3d.getMemoryUsage() > 0, "3D cache memory usage");
+}
+
+} // namespace
+
+int main() {
+    testLattice1D();
+    testLattice2D();
+    testPoints3D();
+    testNeighborCache();
+
+    if (failures != 0) {
+        std::cerr << "test_spatial_grid: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_spatial_grid: PASS" << std::endl;
+    return 0;
+}
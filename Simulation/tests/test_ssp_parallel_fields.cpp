@@ -0,0 +1,155 @@
+/**
+ * C SSP parallel field operations test
+ *
+ * Above the parallel threshold every SSP field operation must give
+ * bit-identical fields, masses and metrics for one thread and several,
+ * agree with the single-call path to round-off (divergence across chunk
+ * boundaries included), and the threshold must switch between the two.
+ *
+ * Build: gcc -std=c11 -O2 -fopenmp -c ssp/src/sid_simd.c ssp/src/sid_semantic_processor.c ssp/src/sid_mixer.c &&
+ *        g++ -std=c++17 -O2 -fopenmp -Issp/src tests/test_ssp_parallel_fields.cpp sid_simd.o sid_semantic_processor.o sid_mixer.o
+ */
+
+extern "C" {
+#include "../ssp/src/sid_mixer.h"
+#include "../ssp/src/sid_semantic_processor.h"
+}
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+struct Run {
+    std::vector<double> I, N, U;
+    std::vector<double> masses;
+    sid_semantic_metrics_t metrics{};
+    sid_mixer_metrics_t mixer{};
+};
+
+// Fixed sequence of every field operation on fields of n cells
+Run runSequence(uint64_t n, int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+    const double C = 3.0 * static_cast<double>(n);
+    sid_ssp_t* I = sid_ssp_create(SID_ROLE_I, n, C);
+    sid_ssp_t* N = sid_ssp_create(SID_ROLE_N, n, C);
+    sid_ssp_t* U = sid_ssp_create(SID_ROLE_U, n, C);
+    std::vector<double> mask_I(n), mask_N(n);
+    for (uint64_t i = 0; i < n; ++i) {
+        sid_ssp_field(U)[i] = 2.0 + std::sin(0.001 * static_cast<double>(i));
+        sid_ssp_field(I)[i] = 0.5 + 0.25 * std::cos(0.01 * static_cast<double>(i));
+        mask_I[i] = (i % 7) / 7.0;
+        mask_N[i] = (i % 3) / 4.0;
+    }
+
+    Run run;
+    run.masses.push_back(sid_ssp_route_from_ssp(N, U, mask_I.data(), 0.2));
+    sid_collapse_mask_t mask = {mask_I.data(), mask_N.data(), n};
+    run.masses.push_back(sid_ssp_apply_collapse_mask(U, &mask, 0.3));
+    run.masses.push_back(sid_ssp_scale_fields(I, 1.1));
+    run.masses.push_back(sid_ssp_add_uniform(N, 0.01));
+    double moved = 0.0, left = 0.0;
+    sid_ssp_transfer_uniform(I, U, 0.05, &moved, &left);
+    run.masses.push_back(moved);
+    run.masses.push_back(left);
+    sid_ssp_apply_collapse(U, mask_N.data(), 0.1);
+    run.masses.push_back(sid_ssp_mass(U));
+
+    sid_mixer_t* mixer = sid_mixer_create(C);
+    sid_mixer_step(mixer, I, N, U);
+    sid_mixer_request_collapse(mixer, I, N, U);
+    sid_mixer_step(mixer, I, N, U);
+    run.mixer = sid_mixer_metrics(mixer);
+    sid_ssp_commit_step(U);
+    run.metrics = sid_ssp_metrics(U);
+
+    run.I.assign(sid_ssp_field_ro(I), sid_ssp_field_ro(I) + n);
+    run.N.assign(sid_ssp_field_ro(N), sid_ssp_field_ro(N) + n);
+    run.U.assign(sid_ssp_field_ro(U), sid_ssp_field_ro(U) + n);
+    sid_mixer_destroy(mixer);
+    sid_ssp_destroy(I);
+    sid_ssp_destroy(N);
+    sid_ssp_destroy(U);
+    return run;
+}
+
+bool identical(const Run& a, const Run& b) {
+    return a.I == b.I && a.N == b.N && a.U == b.U && a.masses == b.masses &&
+           std::memcmp(&a.metrics, &b.metrics, sizeof(a.metrics)) == 0 &&
+           std::memcmp(&a.mixer, &b.mixer, sizeof(a.mixer)) == 0;
+}
+
+bool close(double a, double b) {
+    return std::fabs(a - b) <= 1e-9 * std::fmax(1.0, std::fabs(b));
+}
+
+void testDeterministicAcrossThreads() {
+    const uint64_t n = (uint64_t(1) << 19) + 1234;   // Ragged last chunk
+    expect(sid_ssp_parallel_threshold() == SID_SSP_PARALLEL_MIN_DEFAULT && n >= SID_SSP_PARALLEL_MIN_DEFAULT,
+           "default threshold, field above it");
+    const Run one = runSequence(n, 1);
+    const Run four = runSequence(n, 4);
+    const Run seven = runSequence(n, 7);
+    expect(identical(one, four) && identical(one, seven), "bit-identical for 1, 4 and 7 threads");
+
+    // The single-call path sums in another order, but the same cells
+    sid_ssp_set_parallel_threshold(UINT64_MAX);
+    const Run serial = runSequence(n, 4);
+    sid_ssp_set_parallel_threshold(SID_SSP_PARALLEL_MIN_DEFAULT);
+    bool masses = serial.masses.size() == one.masses.size();
+    for (size_t i = 0; masses && i < one.masses.size(); ++i) masses = close(one.masses[i], serial.masses[i]);
+    expect(masses, "chunked masses match the single call");
+    expect(close(one.metrics.stability, serial.metrics.stability) &&
+           close(one.metrics.coherence, serial.metrics.coherence) &&
+           close(one.metrics.divergence, serial.metrics.divergence), "chunked metrics match, boundaries included");
+    expect(close(one.mixer.admissible_volume, serial.mixer.admissible_volume) &&
+           close(one.mixer.undecided_volume, serial.mixer.undecided_volume), "mixer volumes match");
+}
+
+void testSmallFieldsStaySerial() {
+    // Below the threshold the result is the single-call one whatever it is set to
+    const uint64_t n = 100000;
+    const Run below = runSequence(n, 4);
+    sid_ssp_set_parallel_threshold(UINT64_MAX);
+    const Run serial = runSequence(n, 4);
+    sid_ssp_set_parallel_threshold(SID_SSP_PARALLEL_MIN_DEFAULT);
+    expect(identical(below, serial), "small fields take the serial path");
+
+    sid_ssp_set_parallel_threshold(1);
+    const Run forced = runSequence(n, 4);
+    sid_ssp_set_parallel_threshold(SID_SSP_PARALLEL_MIN_DEFAULT);
+    expect(close(forced.metrics.divergence, serial.metrics.divergence) && close(forced.masses[0], serial.masses[0]),
+           "lowered threshold chunks small fields");
+}
+
+} // namespace
+
+int main() {
+    testDeterministicAcrossThreads();
+    testSmallFieldsStaySerial();
+
+    if (failures != 0) {
+        std::cerr << "test_ssp_parallel_fields: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_ssp_parallel_fields: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * C SSP SIMD dispatch test
+ *
+ * Every kernel set the CPU supports must match the scalar reference
+ * (to round-off: vector kernels sum in lanes) on fields whose length is
+ * not a multiple of any vector width, including the mass each writing
+ * kernel returns; sid_ssp_transfer_uniform must equal the route +
+ * collapse-mask pair it fuses, and the SSP metrics must name the
+ * selected kernels.
+ *
+ * Build: gcc -std=c11 -O2 -c ssp/src/sid_simd.c ssp/src/sid_semantic_processor.c ssp/src/sid_mixer.c &&
+ *        g++ -std=c++17 -O2 -Issp/src tests/test_ssp_simd_dispatch.cpp sid_simd.o sid_semantic_processor.o sid_mixer.o
+ */
+
+extern "C" {
+#include "../ssp/src/sid_mixer.h"
+#include "../ssp/src/sid_semantic_processor.h"
+#include "../ssp/src/sid_simd.h"
+}
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        failures++;
+    }
+}
+
+bool close(double a, double b, double scale) {
+    return std::fabs(a - b) <= 1e-12 * (scale > 1.0 ? scale : 1.0);
+}
+
+bool closeAll(const std::vector<double>& a, const std::vector<double>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!close(a[i], b[i], std::fabs(b[i]))) return false;
+    }
+    return true;
+}
+
+std::vector<double> randomField(std::mt19937_64& rng, size_t n, double lo, double hi) {
+    std::uniform_real_distribution<double> dist(lo, hi);
+    std::vector<double> f(n);
+    for (double& x : f) x = dist(rng);
+    return f;
+}
+
+void compareKernels(sid_simd_isa_t isa) {
+    const sid_simd_kernels_t* ref = nullptr;
+    expect(sid_simd_select(SID_SIMD_SCALAR) == 1, "scalar always selectable");
+    ref = sid_simd_kernels();
+    expect(sid_simd_select(isa) == 1, std::string("select ") + sid_simd_isa_name(isa));
+    const sid_simd_kernels_t* k = sid_simd_kernels();
+    expect(k->isa == isa, "selected table");
+    const std::string name = sid_simd_isa_name(isa);
+
+    std::mt19937_64 rng(42);
+    for (size_t n : {1u, 3u, 7u, 8u, 17u, 1000u, 1027u}) {
+        const std::string at = name + " n=" + std::to_string(n);
+        const std::vector<double> f = randomField(rng, n, 0.0, 2.0);
+        // Masks partly outside [0,1] to exercise the clamps
+        const std::vector<double> m_I = randomField(rng, n, -0.2, 1.1);
+        const std::vector<double> m_N = randomField(rng, n, -0.2, 0.6);
+        const std::vector<double> src = randomField(rng, n, -0.5, 3.0);
+
+        expect(close(k->sum(f.data(), n), ref->sum(f.data(), n), n), at + " sum");
+
+        double s[2], sq[2], dv[2];
+        ref->moments(f.data(), n, &s[0], &sq[0], &dv[0]);
+        k->moments(f.data(), n, &s[1], &sq[1], &dv[1]);
+        expect(close(s[1], s[0], n) && close(sq[1], sq[0], n) && close(dv[1], dv[0], n), at + " moments");
+
+        std::vector<double> a = f, b = f;
+        double ma = ref->scale(a.data(), n, 0.7), mb = k->scale(b.data(), n, 0.7);
+        expect(closeAll(b, a) && close(mb, ma, n), at + " scale");
+        ma = ref->add_uniform(a.data(), n, 0.25);
+        mb = k->add_uniform(b.data(), n, 0.25);
+        expect(closeAll(b, a) && close(mb, ma, n), at + " add_uniform");
+        ma = ref->route(a.data(), src.data(), m_I.data(), n, 0.4);
+        mb = k->route(b.data(), src.data(), m_I.data(), n, 0.4);
+        expect(closeAll(b, a) && close(mb, ma, n), at + " route");
+        ma = ref->collapse_mask(a.data(), m_I.data(), m_N.data(), n, 0.9);
+        mb = k->collapse_mask(b.data(), m_I.data(), m_N.data(), n, 0.9);
+        expect(closeAll(b, a) && close(mb, ma, n), at + " collapse_mask");
+        bool nonneg = true;
+        for (double x : b) nonneg = nonneg && x >= 0.0;
+        expect(nonneg, at + " collapse keeps U >= 0");
+
+        std::vector<double> dst_a = src, dst_b = src, u_a = f, u_b = f;
+        double d_sum[2], u_sum[2];
+        ref->transfer(dst_a.data(), u_a.data(), n, 0.3, &d_sum[0], &u_sum[0]);
+        k->transfer(dst_b.data(), u_b.data(), n, 0.3, &d_sum[1], &u_sum[1]);
+        expect(closeAll(dst_b, dst_a) && closeAll(u_b, u_a) && close(d_sum[1], d_sum[0], n) &&
+               close(u_sum[1], u_sum[0], n), at + " transfer");
+    }
+}
+
+void testTransferMatchesPair() {
+    expect(sid_simd_select(SID_SIMD_SCALAR) == 1, "scalar");
+    const uint64_t n = 37;
+    sid_ssp_t* I_fused = sid_ssp_create(SID_ROLE_I, n, 100.0);
+    sid_ssp_t* U_fused = sid_ssp_create(SID_ROLE_U, n, 100.0);
+    sid_ssp_t* I_pair = sid_ssp_create(SID_ROLE_I, n, 100.0);
+    sid_ssp_t* U_pair = sid_ssp_create(SID_ROLE_U, n, 100.0);
+    for (uint64_t i = 0; i < n; ++i) {
+        sid_ssp_field(I_fused)[i] = sid_ssp_field(I_pair)[i] = 0.1 * (double)i;
+        sid_ssp_field(U_fused)[i] = sid_ssp_field(U_pair)[i] = 2.0 + std::sin((double)i);
+    }
+
+    double I_mass = 0.0, U_mass = 0.0;
+    sid_ssp_transfer_uniform(I_fused, U_fused, 0.25, &I_mass, &U_mass);
+
+    std::vector<double> ones(n, 1.0), zeros(n, 0.0);
+    const double routed = sid_ssp_route_from_ssp(I_pair, U_pair, ones.data(), 0.25);
+    sid_collapse_mask_t mask = {ones.data(), zeros.data(), n};
+    const double left = sid_ssp_apply_collapse_mask(U_pair, &mask, 0.25);
+
+    expect(std::memcmp(sid_ssp_field_ro(I_fused), sid_ssp_field_ro(I_pair), n * sizeof(double)) == 0 &&
+           std::memcmp(sid_ssp_field_ro(U_fused), sid_ssp_field_ro(U_pair), n * sizeof(double)) == 0,
+           "fused transfer is the route + collapse pair");
+    expect(I_mass == routed && U_mass == left && U_mass == sid_ssp_mass(U_fused), "returned masses");
+
+    sid_ssp_commit_step(U_fused);
+    expect(sid_ssp_metrics(U_fused).isa == SID_SIMD_SCALAR, "metrics report the scalar kernels");
+
+    sid_ssp_destroy(I_fused);
+    sid_ssp_destroy(U_fused);
+    sid_ssp_destroy(I_pair);
+    sid_ssp_destroy(U_pair);
+}
+
+void testMixerConserves(sid_simd_isa_t isa) {
+    expect(sid_simd_select(isa) == 1, "select for mixer");
+    const uint64_t n = 131;
+    const double C = 1000.0;
+    sid_ssp_t* I = sid_ssp_create(SID_ROLE_I, n, C);
+    sid_ssp_t* N = sid_ssp_create(SID_ROLE_N, n, C);
+    sid_ssp_t* U = sid_ssp_create(SID_ROLE_U, n, C);
+    sid_mixer_t* mixer = sid_mixer_create(C);
+    for (uint64_t i = 0; i < n; ++i) sid_ssp_field(U)[i] = 1.05 * C / (double)n;   // 5% excess
+
+    for (int t = 0; t < 10; ++t) {
+        sid_mixer_step(mixer, I, N, U);
+        sid_mixer_request_collapse(mixer, I, N, U);
+    }
+    sid_mixer_step(mixer, I, N, U);
+    const sid_mixer_metrics_t m = sid_mixer_metrics(mixer);
+    expect(m.conservation_error < 1e-9 && m.admissible_volume > 0.0,
+           std::string("mixer conserves with ") + sid_simd_isa_name(isa));
+    sid_ssp_commit_step(I);
+    expect(sid_ssp_metrics(I).isa == isa, "metrics report the selected kernels");
+
+    sid_mixer_destroy(mixer);
+    sid_ssp_destroy(I);
+    sid_ssp_destroy(N);
+    sid_ssp_destroy(U);
+}
+
+} // namespace
+
+int main() {
+    sid_simd_init();
+    const sid_simd_isa_t chosen = sid_simd_kernels()->isa;
+    expect(sid_simd_supported(chosen), "init picks a supported set");
+    expect(!sid_simd_select(static_cast<sid_simd_isa_t>(99)) && sid_simd_kernels()->isa == chosen,
+           "unknown set refused, selection unchanged");
+    expect(std::string(sid_simd_isa_name(SID_SIMD_AVX512)) == "avx512", "names");
+
+    for (int isa = SID_SIMD_SCALAR; isa <= SID_SIMD_NEON; ++isa) {
+        if (!sid_simd_supported(static_cast<sid_simd_isa_t>(isa))) continue;
+        compareKernels(static_cast<sid_simd_isa_t>(isa));
+        testMixerConserves(static_cast<sid_simd_isa_t>(isa));
+    }
+    testTransferMatchesPair();
+
+    if (failures != 0) {
+        std::cerr << "test_ssp_simd_dispatch: " << failures << " failure(s)" << std::endl;
+        return 1;
+    }
+    std::cout << "test_ssp_simd_dispatch: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * State digest test
+ *
+ * hashBytes must reproduce the published XXH64 vectors, and field() must
+ * equal hashBytes over the canonical little-endian words.  -0 / +0 and
+ * NaN payloads must digest alike, a one-ulp change must not (exactly),
+ * quantized digests must absorb noise below the tolerance, block digests
+ * must locate a change, and combined digests must depend on field names
+ * and order.
+ *
+ * Build: g++ -std=c++17 -O2 tests/test_state_digest.cpp
+ */
+
+#include "../src/cpp/state_digest.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+bool ok = true;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ok = false;
+    }
+}
+
+std::vector<double> makeField(size_t n) {
+    std::vector<double> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i] = std::sin(0.013 * static_cast<double>(i)) * 1e-3 + 0.25;
+    }
+    return values;
+}
+
+} // namespace
+
+int main() {
+    // Published XXH64 (seed 0) vectors
+    expect(StateDigest::hex(StateDigest::hashBytes("", 0)) == "ef46db3751d8e999", "XXH64 of the empty string");
+    expect(StateDigest::hex(StateDigest::hashString("abc")) == "44bc2cf5ad770999", "XXH64 of abc");
+    expect(StateDigest::hex(StateDigest::hashString("Nobody inspects the spammish repetition")) ==
+           "fbcea83c8a378bf1", "XXH64 of a 39-byte string");
+
+    // field() == hashBytes over the canonical words (short and striped inputs)
+    for (size_t n : {size_t(0), size_t(3), size_t(4), size_t(37)}) {
+        const std::vector<double> values = makeField(n);
+        std::vector<unsigned char> bytes;
+        for (double value : values) {
+            const uint64_t word = StateDigest::canonical(value, 0.0);
+            for (int i = 0; i < 8; ++i) {
+                bytes.push_back(static_cast<unsigned char>(word >> (8 * i)));
+            }
+        }
+        expect(StateDigest::field(values.data(), n, 0.0) == StateDigest::hashBytes(bytes.data(), bytes.size()),
+               "field digest streams the canonical words (n = " + std::to_string(n) + ")");
+    }
+
+    // Canonical zero and NaN; one ulp differs exactly
+    {
+        std::vector<double> a = makeField(64);
+        std::vector<double> b = a;
+        a[5] = 0.0;
+        b[5] = -0.0;
+        a[9] = std::numeric_limits<double>::quiet_NaN();
+        b[9] = -std::numeric_limits<double>::quiet_NaN();
+        expect(StateDigest::field(a.data(), a.size(), 0.0) == StateDigest::field(b.data(), b.size(), 0.0),
+               "-0 and NaN payloads folded");
+        b[20] = std::nextafter(b[20], 1.0);
+        expect(StateDigest::field(a.data(), a.size(), 0.0) != StateDigest::field(b.data(), b.size(), 0.0),
+               "one-ulp change detected exactly");
+        expect(StateDigest::field(a.data(), a.size(), 1e-9) == StateDigest::field(b.data(), b.size(), 1e-9),
+               "one-ulp change absorbed by a tolerance");
+    }
+
+    // Quantization: noise well inside a bucket agrees, a bucket step does not
+    {
+        const double tolerance = 1e-6;
+        std::vector<double> a(256);
+        for (size_t i = 0; i < a.size(); ++i) {
+            a[i] = tolerance * static_cast<double>(i);
+        }
+        std::vector<double> b = a;
+        for (size_t i = 0; i < b.size(); ++i) {
+            b[i] += (i % 2 ? 1.0 : -1.0) * 1e-3 * tolerance;
+        }
+        expect(StateDigest::field(a.data(), a.size(), tolerance) == StateDigest::field(b.data(), b.size(), tolerance),
+               "noise below the tolerance absorbed");
+        b[100] += tolerance;
+        expect(StateDigest::field(a.data(), a.size(), tolerance) != StateDigest::field(b.data(), b.size(), tolerance),
+               "a tolerance step detected");
+    }
+
+    // Block digests locate a change
+    {
+        const std::vector<double> a = makeField(1000);
+        std::vector<double> b = a;
+        b[517] += 1.0;
+        std::vector<uint64_t> blocks_a;
+        std::vector<uint64_t> blocks_b;
+        StateDigest::field(a.data(), a.size(), 0.0, 128, &blocks_a);
+        StateDigest::field(b.data(), b.size(), 0.0, 128, &blocks_b);
+        expect(blocks_a.size() == 8 && blocks_b.size() == 8, "one digest per block, last block short");
+        size_t differing = 0;
+        size_t where = 0;
+        for (size_t k = 0; k < blocks_a.size() && k < blocks_b.size(); ++k) {
+            if (blocks_a[k] != blocks_b[k]) {
+                differing++;
+                where = k;
+            }
+        }
+        expect(differing == 1 && where == 517 / 128, "only the changed block differs");
+        expect(StateDigest::field(a.data() + 896, 104, 0.0) == blocks_a.back(), "block digest is the block's field digest");
+    }
+
+    // Combined digest depends on names and order
+    {
+        const std::vector<uint64_t> digests = {1, 2};
+        const uint64_t base = StateDigest::combine({"phi", "h"}, digests);
+        expect(base == StateDigest::combine({"phi", "h"}, digests), "combine is deterministic");
+        expect(base != StateDigest::combine({"h", "phi"}, digests), "combine depends on field names");
+        expect(base != StateDigest::combine({"phi", "h"}, {2, 1}), "combine depends on order");
+        expect(StateDigest::hex(base).size() == 16, "16 hex digits");
+    }
+
+    if (!ok) {
+        std::cerr << "test_state_digest: FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "test_state_digest: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * Step loop test
+ *
+ * StepLoop::run must run every step with the team's writes visible to the
+ * serial part, sum the team's operation counts, and stop after the step
+ * whose serial part returns false.  IGSOA 1D missions (one team per
+ * mission) must match a loop of per-step timeSteps bit for bit, with and
+ * without a team, and SATP 3D tiled missions must match the reference
+ * path.  Prints the mission time of a small lattice both ways.
+ *
+ * Build: g++ -std=c++17 -O2 -fopenmp -mavx2 -mfma -Isrc/cpp tests/test_step_loop.cpp
+ */
+
+#include "../src/cpp/igsoa_complex_engine.h"
+#include "../src/cpp/satp_higgs_engine_1d.h"
+#include "../src/cpp/satp_higgs_physics_3d.h"
+#include "../src/cpp/step_loop.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+bool ok = true;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ok = false;
+    }
+}
+
+igsoa::IGSOAComplexConfig makeConfig(size_t nodes, size_t omp_min_nodes) {
+    igsoa::IGSOAComplexConfig config;
+    config.num_nodes = nodes;
+    config.R_c_default = 3.0;
+    config.omp_min_nodes = omp_min_nodes;
+    return config;
+}
+
+void seed(igsoa::IGSOAComplexEngine& engine) {
+    for (size_t i = 0; i < engine.getNumNodes(); ++i) {
+        engine.setNodePsi(i, std::sin(0.1 * static_cast<double>(i)), std::cos(0.07 * static_cast<double>(i)));
+    }
+}
+
+bool sameState(const igsoa::IGSOAComplexEngine& a, const std::vector<igsoa::IGSOAComplexNode>& b) {
+    for (size_t i = 0; i < b.size(); ++i) {
+        double re = 0.0;
+        double im = 0.0;
+        a.getNodePsi(i, re, im);
+        if (re != b[i].psi.real() || im != b[i].psi.imag() || a.getNodePhi(i) != b[i].phi) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    {
+        // Team writes visible to serial, operations summed, early stop
+        std::vector<double> values(1000, 0.0);
+        std::vector<double> sums;
+        uint64_t operations = 0;
+        const uint64_t ran = StepLoop::run(10, true,
+            [&](uint64_t step) -> uint64_t {
+                uint64_t done = 0;
+                #pragma omp for schedule(static)
+                for (int64_t i = 0; i < 1000; ++i) {
+                    values[static_cast<size_t>(i)] += static_cast<double>(step);
+                    done++;
+                }
+                return done;
+            },
+            [&](uint64_t step) {
+                double sum = 0.0;
+                for (double value : values) {
+                    sum += value;
+                }
+                sums.push_back(sum);
+                return step < 6;
+            },
+            operations);
+        expect(ran == 7 && sums.size() == 7, "stops after the step whose serial part returns false");
+        expect(operations == 7000, "team operations summed");
+        expect(sums.back() == 1000.0 * 21.0, "serial part sees the team's writes");
+    }
+
+    {
+        // IGSOA 1D: one team per mission == per-step timeSteps (team and alone)
+        const uint64_t steps = 50;
+        std::vector<double> input(steps);
+        std::vector<double> control(steps);
+        for (uint64_t s = 0; s < steps; ++s) {
+            input[s] = std::sin(0.01 * static_cast<double>(s));
+            control[s] = std::cos(0.01 * static_cast<double>(s));
+        }
+        for (size_t omp_min_nodes : {size_t(0), size_t(1) << 30}) {
+            const igsoa::IGSOAComplexConfig config = makeConfig(2048, omp_min_nodes);
+            igsoa::IGSOAComplexEngine engine(config);
+            seed(engine);
+            std::vector<igsoa::IGSOAComplexNode> reference = engine.getNodes();
+
+            expect(engine.runMission(steps, input.data(), control.data()) == steps, "mission runs every step");
+            igsoa::IGSOAStateSoA soa;
+            uint64_t operations = 0;
+            for (uint64_t s = 0; s < steps; ++s) {
+                const std::complex<double> drive(input[s], control[s]);
+                operations += igsoa::IGSOAPhysics::timeStep(reference, soa, config, false, &drive) + reference.size();
+            }
+            expect(engine.getTotalOperations() == operations, "operation count unchanged");
+            expect(sameState(engine, reference), std::string("1D mission matches per-step timeSteps") +
+                   (omp_min_nodes == 0 ? " (team)" : " (alone)"));
+            expect(engine.getTotalSteps() == steps && std::abs(engine.getCurrentTime() - steps * config.dt) < 1e-12,
+                   "clock and step count advanced");
+        }
+    }
+
+    {
+        // SATP 3D tiled (one team per mission) == reference path
+        using satp_higgs::SATPHiggsEngine3D;
+        using satp_higgs::SATPStencilMode;
+        const satp_higgs::SATPHiggsParams params;
+        SATPHiggsEngine3D tiled(16, 16, 16, 0.1, 0.01, params);
+        SATPHiggsEngine3D reference(16, 16, 16, 0.1, 0.01, params);
+        for (auto* engine : {&tiled, &reference}) {
+            auto& nodes = engine->getNodesMutable();
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                nodes[i].phi = 0.1 * std::sin(0.37 * static_cast<double>(i));
+            }
+        }
+        tiled.setStencilMode(SATPStencilMode::Tiled);
+        reference.setStencilMode(SATPStencilMode::Reference);
+        tiled.evolve(40);
+        reference.evolve(40);
+        double max_diff = 0.0;
+        for (size_t i = 0; i < tiled.getN(); ++i) {
+            max_diff = std::max(max_diff, std::abs(tiled.getNodes()[i].phi - reference.getNodes()[i].phi));
+            max_diff = std::max(max_diff, std::abs(tiled.getNodes()[i].h_dot - reference.getNodes()[i].h_dot));
+        }
+        expect(max_diff < 1e-12, "SATP 3D mission matches the reference path");
+        expect(tiled.getStepCount() == 40 && std::abs(tiled.getTime() - 0.4) < 1e-12,
+               "SATP clock advanced per step");
+    }
+
+    {
+        // Small lattice, many steps: one team vs a region per step
+        const igsoa::IGSOAComplexConfig config = makeConfig(4096, 0);
+        igsoa::IGSOAComplexEngine engine(config);
+        seed(engine);
+        std::vector<igsoa::IGSOAComplexNode> nodes = engine.getNodes();
+        igsoa::IGSOAStateSoA soa;
+        const uint64_t steps = 2000;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t s = 0; s < steps; ++s) {
+            igsoa::IGSOAPhysics::timeStep(nodes, soa, config, false);
+        }
+        const double per_step = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        engine.runMission(steps);
+        const double one_team = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "4096 nodes x " << steps << " steps: region per step " << per_step / steps
+                  << " us/step, one team " << one_team / steps << " us/step" << std::endl;
+    }
+
+    if (!ok) {
+        std::cerr << "test_step_loop: FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "test_step_loop: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * Thread budget test
+ *
+ * A lone lease must get what it asks for up to the capacity, later leases
+ * their fair share of what is free (never less than one thread), and
+ * nested leases on one thread no further tokens.  Releasing a lease must
+ * restore the caller's OpenMP team width and give its tokens back.  Leases
+ * taken from concurrent threads must never hold more tokens than the
+ * capacity plus the one-thread minimum of each holder.
+ *
+ * Build: g++ -std=c++17 -fopenmp -pthread tests/test_thread_budget.cpp
+ */
+
+#include "../src/cpp/thread_budget.h"
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dase;
+
+namespace {
+
+bool ok = true;
+
+void expect(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ok = false;
+    }
+}
+
+int teamWidth() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+} // namespace
+
+int main() {
+    ThreadBudget& budget = ThreadBudget::process();
+    budget.setCapacity(8);
+    const int width = teamWidth();
+
+    {
+        ThreadBudget::Lease a = budget.acquire(6);
+        expect(a.threads() == 6 && budget.stats().in_use == 6, "lone lease granted what it asked for");
+#ifdef _OPENMP
+        expect(teamWidth() == 6, "lease sets the team width");
+#endif
+        {
+            ThreadBudget::Lease nested = budget.acquire(16);
+            expect(nested.threads() == 6 && budget.stats().in_use == 6 && budget.stats().holders == 1,
+                   "nested lease stays inside the outer lease and takes no tokens");
+        }
+        expect(budget.stats().in_use == 6, "nested release keeps the outer lease's tokens");
+#ifdef _OPENMP
+        expect(teamWidth() == 6, "nested release restores the outer width");
+#endif
+
+        // Another thread: min(requested, free = 2, fair = 8 / 2)
+        int second = 0;
+        int third = 0;
+        std::thread other([&] {
+            ThreadBudget::Lease b = budget.acquire(8);
+            second = b.threads();
+            std::thread more([&] {
+                ThreadBudget::Lease d = budget.acquire(8);
+                third = d.threads();
+            });
+            more.join();
+        });
+        other.join();
+        expect(second == 2, "second lease limited to the free tokens");
+        expect(third == 1, "lease with no free tokens still gets one thread");
+        expect(budget.stats().reduced >= 2, "reduced grants counted");
+    }
+    expect(budget.stats().in_use == 0 && budget.stats().holders == 0, "tokens given back");
+    expect(teamWidth() == width, "release restores the team width");
+
+    {
+        // Fair share: two holders of 12 -> a third asking 12 gets 12 / 3
+        budget.setCapacity(12);
+        ThreadBudget::Lease a;
+        ThreadBudget::Lease b;
+        int granted = 0;
+        std::thread t1([&] { a = budget.acquire(4); });
+        t1.join();
+        std::thread t2([&] { b = budget.acquire(4); });
+        t2.join();
+        std::thread t3([&] {
+            ThreadBudget::Lease c = budget.acquire(12);
+            granted = c.threads();
+        });
+        t3.join();
+        expect(granted == 4, "third lease gets a fair share");
+        expect(budget.stats().peak >= 12, "peak tracked");
+    }
+
+    {
+        // Capacity 0 = hardware threads; default request = team width
+        budget.setCapacity(0);
+        expect(budget.capacity() == ThreadBudget::hardwareThreads(), "capacity 0 means the hardware");
+        ThreadBudget::Lease lease = budget.acquire(0);
+        expect(lease.threads() == std::min(width, budget.capacity()), "request 0 asks for the team width");
+    }
+
+    {
+        // Concurrent leases never overcommit free tokens
+        budget.setCapacity(4);
+        std::atomic<int> overcommitted{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 2000; ++i) {
+                    ThreadBudget::Lease lease = budget.acquire(3);
+                    const ThreadBudgetStats stats = budget.stats();
+                    if (stats.in_use > stats.capacity + stats.holders) {
+                        overcommitted++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        expect(overcommitted == 0, "grants stay within capacity plus one per holder");
+        expect(budget.stats().in_use == 0, "all tokens returned");
+    }
+
+#ifdef __linux__
+    {
+        // Pinning: thread 0 of the team runs on the given CPU, then unpinned
+        cpu_set_t before;
+        sched_getaffinity(0, sizeof(before), &before);
+        int cpu = 0;
+        while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &before)) {
+            cpu++;
+        }
+        budget.setCapacity(2);
+        {
+            const std::vector<int> cpus = {cpu};
+            ThreadBudget::Lease lease = budget.acquire(2, &cpus);
+            cpu_set_t now;
+            sched_getaffinity(0, sizeof(now), &now);
+            expect(lease.pinned() && CPU_COUNT(&now) == 1 && CPU_ISSET(cpu, &now), "team pinned to the CPU list");
+        }
+        cpu_set_t after;
+        sched_getaffinity(0, sizeof(after), &after);
+        expect(CPU_EQUAL(&before, &after), "release restores the affinity mask");
+    }
+#endif
+
+    if (!ok) {
+        std::cerr << "test_thread_budget: FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "test_thread_budget: PASS" << std::endl;
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * Trace zone test
+ *
+ * Built with DASE_ENABLE_TRACE: an IGSOA 2D mission records its step phases
+ * from every OpenMP team member into per-thread buffers, nothing is
+ * recorded outside start()/stop(), and the export is valid Chrome trace
+ * JSON.
+ */
+
+#ifndef DASE_ENABLE_TRACE
+#define DASE_ENABLE_TRACE
+#endif
+
+#include "../src/cpp/trace_zones.h"
+#include "../src/cpp/igsoa_complex_engine_2d.h"
+#include "../src/cpp/igsoa_state_init_2d.h"
+#include "../dase_cli/src/json.hpp"
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace dase::igsoa;
+using dase::trace::TraceRecorder;
+
+namespace {
+
+void runMission(int steps) {
+    IGSOAComplexConfig config;
+    config.num_nodes = 64 * 64;
+    config.R_c_default = 2.0;
+    config.omp_min_nodes = 1;   // Team even on a small lattice
+    IGSOAComplexEngine2D engine(config, 64, 64);
+    IGSOAStateInit2D::initCircularGaussian(engine, 1.0, 32.0, 32.0, 5.0, 0.0, "overwrite", 1.0);
+    engine.runMission(steps);
+}
+
+} // namespace
+
+int main() {
+    auto& recorder = TraceRecorder::instance();
+    int failures = 0;
+
+    runMission(2);
+    if (recorder.summary().events != 0) {
+        std::cerr << "FAIL: zones recorded before start()" << std::endl;
+        failures++;
+    }
+
+    recorder.start();
+    runMission(3);
+    recorder.stop();
+    const auto summary = recorder.summary();
+    runMission(2);
+    if (recorder.summary().events != summary.events) {
+        std::cerr << "FAIL: zones recorded after stop()" << std::endl;
+        failures++;
+    }
+
+    std::ostringstream out;
+    recorder.writeChromeTrace(out);
+    nlohmann::json trace;
+    try {
+        trace = nlohmann::json::parse(out.str());
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL: export is not JSON: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::set<std::string> names;
+    std::set<int> tids;
+    size_t complete = 0;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            names.insert(event["name"].get<std::string>());
+            tids.insert(event["tid"].get<int>());
+            if (event["dur"].get<double>() < 0.0) {
+                std::cerr << "FAIL: negative duration" << std::endl;
+                failures++;
+            }
+            complete++;
+        }
+    }
+    for (const char* phase : {"igsoa.coupling", "igsoa.causal_field", "igsoa.derived", "igsoa.gradients"}) {
+        if (!names.count(phase)) {
+            std::cerr << "FAIL: no " << phase << " zone" << std::endl;
+            failures++;
+        }
+    }
+    if (complete != summary.events || summary.dropped != 0) {
+        std::cerr << "FAIL: exported " << complete << " of " << summary.events << " events" << std::endl;
+        failures++;
+    }
+
+#ifdef _OPENMP
+    // Every team member records its own share of each phase
+    const size_t expected_threads = static_cast<size_t>(omp_get_max_threads());
+#else
+    const size_t expected_threads = 1;
+#endif
+    if (tids.size() != expected_threads) {
+        std::cerr << "FAIL: zones from " << tids.size() << " threads, expected " << expected_threads << std::endl;
+        failures++;
+    }
+
+    if (failures == 0) {
+        std::cout << "Trace zones: " << complete << " events from " << tids.size() << " threads, PASS" << std::endl;
+        return 0;
+    }
+    return 1;
+}
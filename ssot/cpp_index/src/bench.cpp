@@ -0,0 +1,252 @@
+#include "search_index.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Peak resident set of this process or of its finished children, in KiB
+// (-1 where getrusage is unavailable)
+long peak_rss_kib(bool children) {
+#ifdef _WIN32
+    (void)children;
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(children ? RUSAGE_CHILDREN : RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;   // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+std::string quote(const std::string& arg) {
+    std::string out = "\"";
+    for (char c : arg) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+// `synth` queries of one to three terms, each drawn with probability
+// proportional to its document frequency in the first segment, so the
+// mix resembles a log dominated by common terms
+std::vector<std::string> synthesize_queries(const SearchIndex& index, size_t synth, uint32_t seed) {
+    std::vector<std::string> vocab;
+    std::vector<double> weights;
+    index.segments[0]->lexicon.for_each([&](const TermInfo& info) {
+        vocab.emplace_back(info.term);
+        weights.push_back(static_cast<double>(info.count));
+    });
+    std::vector<std::string> queries;
+    if (vocab.empty()) return queries;
+    std::mt19937 rng(seed);
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+    std::uniform_int_distribution<int> length(1, 3);
+    for (size_t i = 0; i < synth; ++i) {
+        std::string query;
+        for (int t = length(rng); t > 0; --t) {
+            if (!query.empty()) query += ' ';
+            query += vocab[pick(rng)];
+        }
+        queries.push_back(std::move(query));
+    }
+    return queries;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const size_t rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+int bench_search(const std::string& index_dir, const std::string& query_file, size_t synth, uint32_t seed,
+                 const std::string& mode, size_t limit, size_t threads, size_t repeat) {
+    SearchIndex index;
+    std::string error;
+    if (!open_index(index_dir, index, error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    std::vector<std::string> queries;
+    if (!query_file.empty()) {
+        std::ifstream in(query_file);
+        if (!in) {
+            std::cerr << "Failed to open " << query_file << "\n";
+            return 1;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty()) queries.push_back(line);
+        }
+    } else {
+        queries = synthesize_queries(index, synth, seed);
+    }
+    std::vector<std::vector<std::string>> terms;
+    for (const auto& query : queries) {
+        auto t = query_terms(query);
+        if (!t.empty()) terms.push_back(std::move(t));
+    }
+    if (terms.empty()) {
+        std::cerr << "No queries.\n";
+        return 1;
+    }
+
+    const size_t total = terms.size() * repeat;
+    std::vector<double> latency_us(total, 0.0);
+    std::vector<QueryStats> stats(threads);
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    const auto start = Clock::now();
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < threads; ++w) {
+        workers.emplace_back([&, w] {
+            std::string out;
+            std::string err;
+            for (size_t i = next++; i < total; i = next++) {
+                const auto t0 = Clock::now();
+                if (!run_query(index, terms[i % terms.size()], mode, limit, out, err, &stats[w])) {
+                    failed = true;
+                }
+                latency_us[i] = std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    const double wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+    if (failed) {
+        std::cerr << "Some queries failed.\n";
+        return 1;
+    }
+
+    QueryStats sum;
+    for (const auto& s : stats) {
+        sum.blocks_decoded += s.blocks_decoded;
+        sum.postings_decoded += s.postings_decoded;
+        sum.postings_bytes += s.postings_bytes;
+    }
+    std::sort(latency_us.begin(), latency_us.end());
+    const double n = static_cast<double>(total);
+    std::cout << std::fixed << std::setprecision(1)
+              << "queries: " << total << " (" << terms.size() << " distinct, mode " << mode << ", limit " << limit
+              << ")\n"
+              << "threads: " << threads << "\n"
+              << "qps: " << n / wall_s << "\n"
+              << "latency_us p50: " << percentile(latency_us, 0.50) << "  p95: " << percentile(latency_us, 0.95)
+              << "  p99: " << percentile(latency_us, 0.99) << "  max: " << latency_us.back() << "\n"
+              << "per query: postings decoded " << static_cast<double>(sum.postings_decoded) / n << ", blocks decoded "
+              << static_cast<double>(sum.blocks_decoded) / n << ", postings bytes read "
+              << static_cast<double>(sum.postings_bytes) / n << "\n"
+              << "peak_rss_kib: " << peak_rss_kib(false) << "\n";
+    return 0;
+}
+
+int bench_build(const std::string& indexer, const std::string& db_path, const std::string& out_dir,
+                const std::vector<std::string>& indexer_args) {
+    std::string command = quote(indexer) + " --db " + quote(db_path) + " --out " + quote(out_dir);
+    for (const auto& arg : indexer_args) command += " " + quote(arg);
+    const auto start = Clock::now();
+    const int status = std::system(command.c_str());
+    const double wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+    if (status != 0) {
+        std::cerr << "Indexer failed: " << command << "\n";
+        return 1;
+    }
+
+    uint64_t docs = 0;
+    for (const auto& name : read_segment_list(out_dir)) {
+        docs += read_index_meta(fs::path(out_dir) / name / "index_meta.json").doc_count;
+    }
+    std::error_code ec;
+    const double db_mb = static_cast<double>(fs::file_size(db_path, ec)) / (1024.0 * 1024.0);
+    std::cout << std::fixed << std::setprecision(3) << "build_s: " << wall_s << "\n"
+              << std::setprecision(1) << "docs: " << docs << "\n"
+              << "docs_per_s: " << static_cast<double>(docs) / wall_s << "\n"
+              << "db_mb_per_s: " << (ec ? 0.0 : db_mb / wall_s) << "\n"
+              << "indexer_peak_rss_kib: " << peak_rss_kib(true) << "\n";
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string index_dir = "ssot_index_cpp";
+    std::string query_file;
+    std::string mode = "full";
+    size_t synth = 1000;
+    uint32_t seed = 1;
+    size_t limit = 10;
+    size_t threads = 1;
+    size_t repeat = 1;
+    bool build = false;
+    std::string db_path;
+    fs::path indexer = fs::path(argv[0]).parent_path() / "ssot_indexer";
+    std::vector<std::string> indexer_args;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--index" && i + 1 < argc) {
+            index_dir = argv[++i];
+        } else if (arg == "--queries" && i + 1 < argc) {
+            query_file = argv[++i];
+        } else if (arg == "--synth" && i + 1 < argc) {
+            synth = static_cast<size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--mode" && i + 1 < argc) {
+            mode = argv[++i];
+        } else if (arg == "--limit" && i + 1 < argc) {
+            limit = static_cast<size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max<size_t>(1, static_cast<size_t>(std::stoull(argv[++i])));
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max<size_t>(1, static_cast<size_t>(std::stoull(argv[++i])));
+        } else if (arg == "--build") {
+            build = true;
+        } else if (arg == "--db" && i + 1 < argc) {
+            db_path = argv[++i];
+        } else if (arg == "--indexer" && i + 1 < argc) {
+            indexer = argv[++i];
+        } else if (arg == "--" && build) {
+            indexer_args.assign(argv + i + 1, argv + argc);
+            break;
+        } else {
+            std::cerr << "Usage: ssot_bench --index <dir> [--queries FILE | --synth N] [--seed N]\n"
+                         "                  [--mode keyword|full] [--limit N] [--threads N] [--repeat N]\n"
+                         "       ssot_bench --build --db <path> --index <dir> [--indexer PATH] [-- indexer args]\n";
+            return 1;
+        }
+    }
+
+    if (build) {
+        if (db_path.empty()) {
+            std::cerr << "--build needs --db\n";
+            return 1;
+        }
+        return bench_build(indexer.string(), db_path, index_dir, indexer_args);
+    }
+    return bench_search(index_dir, query_file, synth, seed, mode, limit, threads, repeat);
+}
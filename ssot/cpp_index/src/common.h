@@ -1,10 +1,26 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+// lexicon_dir.bin lists the offset of every kLexiconBlock-th lexicon.bin
+// record: u32 block size, u32 reserved, then one u64 offset per block
+constexpr uint32_t kLexiconBlock = 64;
+
+// BM25 parameters; the indexer bakes them into per-block score bounds
+constexpr double kBm25K1 = 1.2;
+constexpr double kBm25B = 0.75;
+
+// BM25 term score without the idf factor
+inline double bm25_tf_weight(double tf, double doc_len, double avg_doc_len) {
+    double denom = tf + kBm25K1 * (1.0 - kBm25B + kBm25B * doc_len / avg_doc_len);
+    return tf * (kBm25K1 + 1.0) / denom;
+}
+
 inline void write_varint(std::ofstream& out, uint64_t value) {
     while (value >= 0x80) {
         uint8_t byte = static_cast<uint8_t>(value) | 0x80;
@@ -15,14 +31,12 @@ inline void write_varint(std::ofstream& out, uint64_t value) {
     out.write(reinterpret_cast<const char*>(&byte), 1);
 }
 
-inline bool read_varint(std::ifstream& in, uint64_t& value) {
+// Decode the varint at p and advance past it; false if it runs past end
+inline bool read_varint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
     value = 0;
     uint64_t shift = 0;
-    while (true) {
-        uint8_t byte = 0;
-        if (!in.read(reinterpret_cast<char*>(&byte), 1)) {
-            return false;
-        }
+    while (p < end) {
+        uint8_t byte = *p++;
         value |= static_cast<uint64_t>(byte & 0x7F) << shift;
         if ((byte & 0x80) == 0) {
             return true;
@@ -32,46 +46,53 @@ inline bool read_varint(std::ifstream& in, uint64_t& value) {
             return false;
         }
     }
+    return false;
 }
 
-inline bool read_varint_with_len(std::ifstream& in, uint64_t& value, uint32_t& bytes_read) {
-    value = 0;
-    bytes_read = 0;
-    uint64_t shift = 0;
-    while (true) {
-        uint8_t byte = 0;
-        if (!in.read(reinterpret_cast<char*>(&byte), 1)) {
-            return false;
-        }
-        ++bytes_read;
-        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
-        if ((byte & 0x80) == 0) {
-            return true;
-        }
-        shift += 7;
-        if (shift > 63) {
-            return false;
-        }
-    }
+// Fixed-width value at a possibly unaligned address
+template <typename T>
+inline T load_unaligned(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
 }
 
-inline bool read_string_at(std::ifstream& in, uint64_t offset, std::string& out, uint64_t* end_offset = nullptr) {
-    in.clear();
-    in.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
-    if (!in.good()) {
+// Varint-length string at data[offset] (viewed in place, not copied)
+inline bool read_string_at(const uint8_t* data, size_t size, uint64_t offset,
+                           std::string_view& out, uint64_t* end_offset = nullptr) {
+    if (offset >= size) {
         return false;
     }
+    const uint8_t* p = data + offset;
+    const uint8_t* end = data + size;
     uint64_t len = 0;
-    uint32_t len_bytes = 0;
-    if (!read_varint_with_len(in, len, len_bytes)) {
-        return false;
-    }
-    out.resize(static_cast<size_t>(len));
-    if (!in.read(&out[0], static_cast<std::streamsize>(len))) {
+    if (!read_varint(p, end, len) || len > static_cast<uint64_t>(end - p)) {
         return false;
     }
+    out = std::string_view(reinterpret_cast<const char*>(p), static_cast<size_t>(len));
     if (end_offset) {
-        *end_offset = offset + len_bytes + len;
+        *end_offset = static_cast<uint64_t>(p - data) + len;
     }
     return true;
 }
+
+// Decode one front-coded string at p into out, which holds the previous one
+inline bool read_front_coded(const uint8_t*& p, const uint8_t* end, std::string& out) {
+    uint64_t shared = 0;
+    uint64_t len = 0;
+    if (!read_varint(p, end, shared) || !read_varint(p, end, len)) return false;
+    if (shared > out.size() || len > static_cast<uint64_t>(end - p)) return false;
+    out.resize(static_cast<size_t>(shared));
+    out.append(reinterpret_cast<const char*>(p), static_cast<size_t>(len));
+    p += len;
+    return true;
+}
+
+// Decode one varint-length string at p into out
+inline bool read_whole(const uint8_t*& p, const uint8_t* end, std::string& out) {
+    uint64_t len = 0;
+    if (!read_varint(p, end, len) || len > static_cast<uint64_t>(end - p)) return false;
+    out.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(len));
+    p += len;
+    return true;
+}
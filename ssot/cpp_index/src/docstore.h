@@ -0,0 +1,120 @@
+#pragma once
+
+#include "common.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A segment's (id, file_path) records come in one of two layouts:
+//   plain       docstore_offsets.bin, one u64 offset per doc into
+//               docstore_data.bin, where each record is a varint-length id
+//               then a varint-length path
+//   compressed  docstore_blocks.bin: u32 block size, u32 reserved, u64 doc
+//               count, then one u64 docstore_data.bin offset per block of
+//               kDocStoreBlock docs.  A block's first record is stored
+//               whole; each later one as (varint shared prefix, varint
+//               suffix length, suffix) for the id and then the path, both
+//               relative to the previous record
+// The compressed layout is used when docstore_blocks.bin exists.
+constexpr const char* kDocBlocksFile = "docstore_blocks.bin";
+constexpr uint32_t kDocStoreBlock = 16;
+constexpr size_t kDocBlocksHeader = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+class DocStoreReader {
+public:
+    bool open(const std::filesystem::path& dir) {
+        if (!data_.open(dir / "docstore_data.bin")) return false;
+        if (blocks_.open(dir / kDocBlocksFile)) {
+            if (blocks_.size() < kDocBlocksHeader) return false;
+            block_size_ = load_unaligned<uint32_t>(blocks_.data());
+            count_ = static_cast<size_t>(load_unaligned<uint64_t>(blocks_.data() + 2 * sizeof(uint32_t)));
+            const size_t blocks = block_size_ ? (count_ + block_size_ - 1) / block_size_ : 0;
+            if (block_size_ == 0 || blocks_.size() < kDocBlocksHeader + blocks * sizeof(uint64_t)) return false;
+            compressed_ = true;
+            return true;
+        }
+        if (!offsets_.open(dir / "docstore_offsets.bin")) return false;
+        count_ = offsets_.size() / sizeof(uint64_t);
+        compressed_ = false;
+        return true;
+    }
+
+    size_t count() const { return count_; }
+    bool compressed() const { return compressed_; }
+
+    bool read(uint32_t doc_id, std::string& id, std::string& path) const {
+        const uint32_t one[1] = {doc_id};
+        return read_sorted(one, 1, [&](size_t, const std::string& i, const std::string& p) {
+            id = i;
+            path = p;
+        });
+    }
+
+    // fn(k, id, path) for each readable doc_ids[k]; the ids must ascend, so
+    // the data is read in one forward pass and each compressed block is
+    // decoded at most once.  False if any record was unreadable.
+    template <typename Fn>
+    bool read_sorted(const uint32_t* doc_ids, size_t n, Fn fn) const {
+        std::string id;
+        std::string path;
+        const uint8_t* end = data_.data() + data_.size();
+        bool all_ok = true;
+        if (!compressed_) {
+            for (size_t k = 0; k < n; ++k) {
+                const uint64_t offset = doc_ids[k] < count_ ? offset_of(doc_ids[k]) : UINT64_MAX;
+                const uint8_t* p = data_.data() + (offset < data_.size() ? offset : 0);
+                if (offset >= data_.size() || !read_whole(p, end, id) || !read_whole(p, end, path)) {
+                    all_ok = false;
+                    continue;
+                }
+                fn(k, id, path);
+            }
+            return all_ok;
+        }
+
+        const uint8_t* p = nullptr;
+        uint64_t block = UINT64_MAX;
+        uint32_t next = 0;   // Doc whose record p points at
+        for (size_t k = 0; k < n; ++k) {
+            const uint32_t doc_id = doc_ids[k];
+            if (doc_id >= count_) {
+                all_ok = false;
+                continue;
+            }
+            if (doc_id / block_size_ != block || doc_id < next) {
+                block = doc_id / block_size_;
+                next = static_cast<uint32_t>(block * block_size_);
+                const uint64_t offset = load_unaligned<uint64_t>(blocks_.data() + kDocBlocksHeader + block * sizeof(uint64_t));
+                p = data_.data() + (offset < data_.size() ? offset : data_.size());
+            }
+            bool ok = true;
+            for (; ok && next <= doc_id; ++next) {
+                ok = (next % block_size_ == 0) ? read_whole(p, end, id) && read_whole(p, end, path)
+                                               : read_front_coded(p, end, id) && read_front_coded(p, end, path);
+            }
+            if (!ok) {
+                block = UINT64_MAX;   // The rest of the block can't be trusted
+                all_ok = false;
+                continue;
+            }
+            fn(k, id, path);
+        }
+        return all_ok;
+    }
+
+private:
+    uint64_t offset_of(uint32_t doc_id) const {
+        return load_unaligned<uint64_t>(offsets_.data() + size_t(doc_id) * sizeof(uint64_t));
+    }
+
+    MappedFile data_;
+    MappedFile offsets_;
+    MappedFile blocks_;
+    size_t count_ = 0;
+    uint32_t block_size_ = kDocStoreBlock;
+    bool compressed_ = false;
+};
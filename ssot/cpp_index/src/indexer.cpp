@@ -1,22 +1,38 @@
 #include "common.h"
+#include "docstore.h"
+#include "lexicon.h"
+#include "mapped_file.h"
+#include "postings_codec.h"
+#include "segments.h"
 #include "tokenizer.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <sqlite3.h>
 
 namespace fs = std::filesystem;
 
+// Chunk files: u32 term count, that many (u32 length, bytes) terms in
+// sorted order, then (u32 term, u32 doc_id, u32 tf) records sorted by
+// (term, doc_id), where term indexes the chunk's own term table
 struct Entry {
-    std::string term;
+    uint32_t term_id;
     uint32_t doc_id;
     uint32_t tf;
 };
@@ -27,97 +43,660 @@ struct LexEntry {
     uint32_t postings_count;
 };
 
-struct ChunkReader {
-    std::ifstream in;
-    Entry current;
+constexpr uint32_t kDroppedDoc = UINT32_MAX;
+
+// One input of the k-way merge: entries sorted by (term, doc_id) from a
+// spilled chunk or from a segment being compacted.  `terms` is the
+// source's sorted term table; once global_ids maps it onto the merged
+// vocabulary, advance() yields entries carrying global term ids.
+struct EntrySource {
+    std::vector<std::string> terms;
+    std::vector<uint32_t> global_ids;
+    Entry current{};
     bool valid = false;
+    bool ok = true;   // False after a read or decode error
+
+    virtual ~EntrySource() = default;
+    virtual void advance() = 0;
+};
+
+struct ChunkReader : EntrySource {
+    std::ifstream in;
+    std::vector<Entry> buffer;
+    size_t pos = 0;
 
     explicit ChunkReader(const fs::path& path) : in(path, std::ios::binary) {
-        advance();
+        uint32_t count = 0;
+        ok = false;
+        if (!in.read(reinterpret_cast<char*>(&count), sizeof(count))) return;
+        terms.resize(count);
+        for (auto& term : terms) {
+            uint32_t len = 0;
+            if (!in.read(reinterpret_cast<char*>(&len), sizeof(len))) return;
+            term.resize(len);
+            if (len > 0 && !in.read(&term[0], len)) return;
+        }
+        ok = true;
+        valid = true;
     }
 
-    void advance() {
-        if (!in.good()) {
-            valid = false;
-            return;
+    void advance() override {
+        if (pos == buffer.size()) {
+            buffer.resize(4096);
+            in.read(reinterpret_cast<char*>(buffer.data()),
+                    static_cast<std::streamsize>(buffer.size() * sizeof(Entry)));
+            buffer.resize(static_cast<size_t>(in.gcount()) / sizeof(Entry));
+            pos = 0;
+            if (buffer.empty()) {
+                valid = false;
+                return;
+            }
         }
-        uint32_t term_len = 0;
-        if (!in.read(reinterpret_cast<char*>(&term_len), sizeof(term_len))) {
-            valid = false;
-            return;
+        current = buffer[pos++];
+        current.term_id = global_ids[current.term_id];
+        valid = true;
+    }
+};
+
+// How new segments are written
+struct SegmentOptions {
+    bool compress_docstore = false;                        // --compress-docstore
+    bool compress_lexicon = false;                         // --compress-lexicon
+    uint32_t postings_format = kPostingsFormatBlockMax;    // kPostingsFormatImpact with --impacts
+};
+
+// An existing segment's files, for updates and merges
+struct SegmentFiles {
+    std::string name;
+    fs::path dir;
+    IndexMeta meta;
+    Lexicon lexicon;
+    MappedFile postings;
+    DocStoreReader docs;
+    MappedFile lengths;
+    MappedFile hashes;
+    std::vector<uint8_t> tombstones;
+    bool tombstones_changed = false;
+
+    bool open(const fs::path& index_dir, const std::string& segment_name) {
+        name = segment_name;
+        dir = index_dir / segment_name;
+        meta = read_index_meta(dir / "index_meta.json");
+        if (!lexicon.open(dir) || !postings.open(dir / "postings.bin") ||
+            !docs.open(dir) || !lengths.open(dir / "docstore_doclen.bin")) {
+            return false;
         }
-        current.term.resize(term_len);
-        if (!in.read(&current.term[0], term_len)) {
-            valid = false;
-            return;
+        if (!hashes.open(dir / kDocHashFile) || hashes.size() != size_t(doc_count()) * sizeof(uint64_t)) {
+            hashes.close();
         }
-        if (!in.read(reinterpret_cast<char*>(&current.doc_id), sizeof(current.doc_id))) {
-            valid = false;
-            return;
+        std::ifstream in(dir / kTombstoneFile, std::ios::binary);
+        tombstones.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        tombstones.resize((doc_count() + 7) / 8, 0);
+        return true;
+    }
+
+    uint32_t doc_count() const { return static_cast<uint32_t>(docs.count()); }
+    bool has_hashes() const { return hashes.is_open(); }
+    uint64_t hash(uint32_t doc_id) const { return load_unaligned<uint64_t>(hashes.data() + size_t(doc_id) * 8); }
+
+    uint32_t length(uint32_t doc_id) const {
+        if (size_t(doc_id) * sizeof(uint32_t) >= lengths.size()) return 0;
+        return load_unaligned<uint32_t>(lengths.data() + size_t(doc_id) * sizeof(uint32_t));
+    }
+
+    bool is_deleted(uint32_t doc_id) const {
+        return is_tombstoned(tombstones.data(), tombstones.size(), doc_id);
+    }
+
+    std::vector<uint32_t> live_docs() const {
+        std::vector<uint32_t> docs;
+        for (uint32_t d = 0; d < doc_count(); ++d) {
+            if (!is_deleted(d)) docs.push_back(d);
         }
-        if (!in.read(reinterpret_cast<char*>(&current.tf), sizeof(current.tf))) {
-            valid = false;
+        return docs;
+    }
+
+    void tombstone(uint32_t doc_id) {
+        tombstones[doc_id / 8] |= static_cast<uint8_t>(1u << (doc_id % 8));
+        tombstones_changed = true;
+    }
+
+    bool has_deletes() const {
+        return std::any_of(tombstones.begin(), tombstones.end(), [](uint8_t b) { return b != 0; });
+    }
+};
+
+// A segment's postings term by term, doc ids renumbered through doc_map
+// (kDroppedDoc for docs left out of the merge)
+struct SegmentSource : EntrySource {
+    const SegmentFiles& seg;
+    const std::vector<uint32_t>& doc_map;
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> counts;
+    size_t next_term = 0;
+    uint32_t term_id = 0;
+    std::vector<uint32_t> doc_ids;
+    std::vector<uint32_t> tfs;
+    size_t pos = 0;
+
+    SegmentSource(const SegmentFiles& segment, const std::vector<uint32_t>& map) : seg(segment), doc_map(map) {
+        // Either lexicon layout (lexicon.h)
+        if (!seg.lexicon.for_each([&](const TermInfo& info) {
+                terms.emplace_back(info.term);
+                offsets.push_back(info.offset);
+                counts.push_back(info.count);
+            })) {
+            ok = false;
             return;
         }
         valid = true;
     }
+
+    void advance() override {
+        while (true) {
+            while (pos < doc_ids.size()) {
+                const uint32_t doc = doc_ids[pos];
+                const uint32_t tf = tfs[pos];
+                ++pos;
+                if (doc < doc_map.size() && doc_map[doc] != kDroppedDoc) {
+                    current = Entry{global_ids[term_id], doc_map[doc], tf};
+                    valid = true;
+                    return;
+                }
+            }
+            if (next_term >= offsets.size()) {
+                valid = false;
+                return;
+            }
+            term_id = static_cast<uint32_t>(next_term++);
+            pos = 0;
+            if (!decode_postings(seg.meta.postings_format, seg.postings.data(), seg.postings.size(),
+                                 offsets[term_id], counts[term_id], doc_ids, tfs)) {
+                ok = false;
+                valid = false;
+                return;
+            }
+        }
+    }
 };
 
 struct ReaderCmp {
-    bool operator()(const ChunkReader* a, const ChunkReader* b) const {
-        if (a->current.term != b->current.term) {
-            return a->current.term > b->current.term;
+    bool operator()(const EntrySource* a, const EntrySource* b) const {
+        if (a->current.term_id != b->current.term_id) {
+            return a->current.term_id > b->current.term_id;
         }
         return a->current.doc_id > b->current.doc_id;
     }
 };
 
-void write_chunk(std::vector<Entry>& entries, const fs::path& path) {
-    std::sort(entries.begin(), entries.end(),
-              [](const Entry& a, const Entry& b) {
-                  if (a.term != b.term) return a.term < b.term;
-                  return a.doc_id < b.doc_id;
-              });
-    std::ofstream out(path, std::ios::binary);
-    for (const auto& e : entries) {
-        uint32_t len = static_cast<uint32_t>(e.term.size());
-        out.write(reinterpret_cast<const char*>(&len), sizeof(len));
-        out.write(e.term.data(), len);
-        out.write(reinterpret_cast<const char*>(&e.doc_id), sizeof(e.doc_id));
-        out.write(reinterpret_cast<const char*>(&e.tf), sizeof(e.tf));
-    }
-    entries.clear();
-    entries.shrink_to_fit();
-}
+// Rows handed from the SQLite reader to the tokenizer workers
+constexpr size_t kBatchDocs = 256;
 
-int main(int argc, char** argv) {
-    std::string db_path = "ssot_parallel.db";
-    std::string out_dir = "ssot_index_cpp";
-    size_t chunk_limit = 1000000;
+struct DocBatch {
+    uint32_t first_doc_id = 0;
+    std::vector<std::string> contents;
+};
 
-    for (int i = 1; i < argc; ++i) {
-        std::string arg = argv[i];
-        if (arg == "--db" && i + 1 < argc) {
-            db_path = argv[++i];
-        } else if (arg == "--out" && i + 1 < argc) {
-            out_dir = argv[++i];
-        } else if (arg == "--chunk" && i + 1 < argc) {
-            chunk_limit = static_cast<size_t>(std::stoull(argv[++i]));
+// Bounded queue: push() blocks while full, pop() fails once closed and drained
+class BatchQueue {
+public:
+    explicit BatchQueue(size_t capacity) : capacity_(capacity) {}
+
+    void push(DocBatch&& batch) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&] { return batches_.size() < capacity_; });
+        batches_.push_back(std::move(batch));
+        not_empty_.notify_one();
+    }
+
+    bool pop(DocBatch& batch) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [&] { return closed_ || !batches_.empty(); });
+        if (batches_.empty()) return false;
+        batch = std::move(batches_.front());
+        batches_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    std::deque<DocBatch> batches_;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+// One tokenizer worker's state.  Terms are interned to per-worker ids so
+// buffered postings are 12-byte Entry records instead of a heap string
+// each; both the per-document counts and the ids live in TermTables,
+// which stop allocating once warm.  A worker pops batches in queue order, so its doc ids only grow
+// and a stable counting sort on the term rank orders a spill by
+// (term, doc_id).
+class ChunkBuilder {
+public:
+    ChunkBuilder(fs::path tmp_path, size_t worker, size_t entry_limit)
+        : tmp_path_(std::move(tmp_path)), worker_(worker), entry_limit_(std::max<size_t>(entry_limit, 1)) {
+        entries_.reserve(entry_limit_);
+    }
+
+    void add_document(uint32_t doc_id, const std::string& content) {
+        counts_.clear();
+        uint32_t token_count = 0;
+        tokenize_to_counts(content, counts_, token_count);
+        doc_lengths.emplace_back(doc_id, token_count);
+        total_tokens += token_count;
+
+        for (uint32_t local = 0; local < counts_.size(); ++local) {
+            const std::string_view term = counts_.term(local);
+            const uint32_t term_id = term_ids_.intern(term.data(), term.size());
+            entries_.push_back(Entry{term_id, doc_id, counts_.value(local)});
+            if (entries_.size() >= entry_limit_) {
+                spill();
+            }
+        }
+    }
+
+    void spill() {
+        if (entries_.empty()) return;
+
+        // Terms used by this chunk, sorted, become its local ids
+        std::vector<uint32_t> counts(term_ids_.size(), 0);
+        for (const auto& e : entries_) ++counts[e.term_id];
+        std::vector<uint32_t> used;
+        for (uint32_t id = 0; id < counts.size(); ++id) {
+            if (counts[id] > 0) used.push_back(id);
+        }
+        std::sort(used.begin(), used.end(),
+                  [&](uint32_t a, uint32_t b) { return term_ids_.term(a) < term_ids_.term(b); });
+
+        std::vector<uint32_t> local(term_ids_.size(), 0);
+        std::vector<size_t> start(used.size() + 1, 0);
+        for (uint32_t r = 0; r < used.size(); ++r) {
+            local[used[r]] = r;
+            start[r + 1] = start[r] + counts[used[r]];
+        }
+        sorted_.resize(entries_.size());
+        for (const auto& e : entries_) {
+            const uint32_t r = local[e.term_id];
+            sorted_[start[r]++] = Entry{r, e.doc_id, e.tf};
+        }
+
+        fs::path path = tmp_path_ / ("chunk_" + std::to_string(worker_) + "_" +
+                                     std::to_string(chunk_files.size()) + ".bin");
+        std::ofstream out(path, std::ios::binary);
+        const uint32_t term_count = static_cast<uint32_t>(used.size());
+        out.write(reinterpret_cast<const char*>(&term_count), sizeof(term_count));
+        for (uint32_t id : used) {
+            const std::string_view term = term_ids_.term(id);
+            uint32_t len = static_cast<uint32_t>(term.size());
+            out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+            out.write(term.data(), len);
+        }
+        out.write(reinterpret_cast<const char*>(sorted_.data()),
+                  static_cast<std::streamsize>(sorted_.size() * sizeof(Entry)));
+        chunk_files.push_back(path);
+        entries_.clear();
+    }
+
+    std::vector<fs::path> chunk_files;
+    std::vector<std::pair<uint32_t, uint32_t>> doc_lengths;   // (doc_id, token count)
+    uint64_t total_tokens = 0;
+
+private:
+    fs::path tmp_path_;
+    size_t worker_;
+    size_t entry_limit_;
+    TermTable term_ids_;   // Worker-wide term ids (values unused)
+    std::vector<Entry> entries_;
+    std::vector<Entry> sorted_;
+    TermTable counts_;     // This document's terms, reused across documents
+};
+
+
+// docstore_data.bin, docstore_hash.bin and docstore_offsets.bin (or, when
+// compressed, docstore_blocks.bin; see docstore.h) of a segment being
+// written; finish() adds docstore_doclen.bin
+class DocStoreWriter {
+public:
+    DocStoreWriter(const fs::path& dir, bool compressed)
+        : dir_(dir), data_(dir / "docstore_data.bin", std::ios::binary), compressed_(compressed) {}
+
+    void add(std::string_view id, std::string_view path, uint64_t hash) {
+        const uint64_t offset = static_cast<uint64_t>(data_.tellp());
+        if (!compressed_ || count_ % kDocStoreBlock == 0) {
+            offsets_.push_back(offset);
+            write_whole(id);
+            write_whole(path);
         } else {
-            std::cerr << "Usage: indexer --db <path> --out <dir> [--chunk N]\n";
-            return 1;
+            write_front_coded(prev_id_, id);
+            write_front_coded(prev_path_, path);
+        }
+        if (compressed_) {
+            prev_id_.assign(id);
+            prev_path_.assign(path);
         }
+        hashes_.push_back(hash);
+        ++count_;
     }
 
-    fs::path out_path(out_dir);
-    fs::create_directories(out_path);
-    fs::path tmp_path = out_path / "tmp";
-    fs::create_directories(tmp_path);
+    uint32_t count() const { return count_; }
+
+    void finish(const std::vector<uint32_t>& doc_lengths) {
+        data_.close();
+        // A rebuild in place must not leave the other layout's file behind
+        std::error_code ec;
+        if (compressed_) {
+            std::ofstream out(dir_ / kDocBlocksFile, std::ios::binary);
+            const uint32_t header[2] = {kDocStoreBlock, 0};
+            const uint64_t count = count_;
+            out.write(reinterpret_cast<const char*>(header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            out.write(reinterpret_cast<const char*>(offsets_.data()),
+                      static_cast<std::streamsize>(offsets_.size() * sizeof(uint64_t)));
+            fs::remove(dir_ / "docstore_offsets.bin", ec);
+        } else {
+            write_array(dir_ / "docstore_offsets.bin", offsets_);
+            fs::remove(dir_ / kDocBlocksFile, ec);
+        }
+        write_array(dir_ / "docstore_doclen.bin", doc_lengths);
+        write_array(dir_ / kDocHashFile, hashes_);
+    }
+
+private:
+    template <typename T>
+    static void write_array(const fs::path& path, const std::vector<T>& values) {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    void write_whole(std::string_view s) {
+        write_varint(data_, s.size());
+        data_.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+    void write_front_coded(const std::string& prev, std::string_view s) {
+        size_t shared = 0;
+        while (shared < prev.size() && shared < s.size() && prev[shared] == s[shared]) ++shared;
+        write_varint(data_, shared);
+        write_whole(s.substr(shared));
+    }
+
+    fs::path dir_;
+    std::ofstream data_;
+    bool compressed_;
+    uint32_t count_ = 0;
+    std::vector<uint64_t> offsets_;   // Per doc, or per block when compressed
+    std::vector<uint64_t> hashes_;
+    std::string prev_id_;
+    std::string prev_path_;
+};
+
+// lexicon.bin in either layout (lexicon.h) plus its directory; a rebuild
+// in place must not leave the other layout's directory behind
+bool write_lexicon(const fs::path& out_path, const std::vector<LexEntry>& lexicon, bool compressed) {
+    std::ofstream lex_out(out_path / "lexicon.bin", std::ios::binary);
+    const uint32_t block_size = compressed ? kLexiconFrontCodedBlock : kLexiconBlock;
+    std::vector<uint64_t> lex_blocks;
+    for (size_t i = 0; i < lexicon.size(); ++i) {
+        const auto& lex = lexicon[i];
+        if (i % block_size == 0) {
+            lex_blocks.push_back(static_cast<uint64_t>(lex_out.tellp()));
+        }
+        if (!compressed) {
+            uint32_t len = static_cast<uint32_t>(lex.term.size());
+            lex_out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+            lex_out.write(lex.term.data(), len);
+            lex_out.write(reinterpret_cast<const char*>(&lex.postings_offset), sizeof(lex.postings_offset));
+            lex_out.write(reinterpret_cast<const char*>(&lex.postings_count), sizeof(lex.postings_count));
+            continue;
+        }
+        std::string_view suffix = lex.term;
+        uint64_t postings = lex.postings_offset;
+        if (i % block_size != 0) {
+            const std::string& prev = lexicon[i - 1].term;
+            size_t shared = 0;
+            while (shared < prev.size() && shared < lex.term.size() && prev[shared] == lex.term[shared]) ++shared;
+            write_varint(lex_out, shared);
+            suffix = suffix.substr(shared);
+            postings -= lexicon[i - 1].postings_offset;
+        }
+        write_varint(lex_out, suffix.size());
+        lex_out.write(suffix.data(), static_cast<std::streamsize>(suffix.size()));
+        write_varint(lex_out, postings);
+        write_varint(lex_out, lex.postings_count);
+    }
+    if (!lex_out) return false;
+
+    // Sparse directory: lets the searcher binary-search the mapped lexicon
+    std::error_code ec;
+    std::ofstream dir_out(out_path / (compressed ? kLexiconBlocksFile : kLexiconDirFile), std::ios::binary);
+    const uint32_t block_header[2] = {block_size, 0};
+    dir_out.write(reinterpret_cast<const char*>(block_header), sizeof(block_header));
+    if (compressed) {
+        const uint64_t term_count = lexicon.size();
+        dir_out.write(reinterpret_cast<const char*>(&term_count), sizeof(term_count));
+    }
+    dir_out.write(reinterpret_cast<const char*>(lex_blocks.data()),
+                  static_cast<std::streamsize>(lex_blocks.size() * sizeof(uint64_t)));
+    fs::remove(out_path / (compressed ? kLexiconDirFile : kLexiconBlocksFile), ec);
+    return static_cast<bool>(dir_out);
+}
+
+// k-way merge of the sources into postings.bin, lexicon.bin, its
+// lexicon_dir.bin or (front-coded) lexicon_blocks.bin, and index_meta.json
+bool write_postings(const fs::path& out_path, std::vector<std::unique_ptr<EntrySource>>& sources,
+                    const std::vector<uint32_t>& doc_lengths, uint64_t total_tokens,
+                    const std::string& source_db, uint32_t postings_format, bool compress_lexicon) {
+    // Merged vocabulary in term order; the heap then compares integer ids
+    std::vector<std::string> vocab;
+    for (const auto& source : sources) {
+        if (!source->ok) return false;
+        vocab.insert(vocab.end(), source->terms.begin(), source->terms.end());
+    }
+    std::sort(vocab.begin(), vocab.end());
+    vocab.erase(std::unique(vocab.begin(), vocab.end()), vocab.end());
+
+    std::priority_queue<EntrySource*, std::vector<EntrySource*>, ReaderCmp> heap;
+    for (auto& source : sources) {
+        if (!source->valid) continue;
+        source->global_ids.reserve(source->terms.size());
+        auto it = vocab.begin();
+        for (const auto& term : source->terms) {
+            it = std::lower_bound(it, vocab.end(), term);
+            source->global_ids.push_back(static_cast<uint32_t>(it - vocab.begin()));
+        }
+        source->terms.clear();
+        source->terms.shrink_to_fit();
+        source->advance();
+        if (source->valid) {
+            heap.push(source.get());
+        }
+    }
+
+    double avg_doc_len = doc_lengths.empty()
+                             ? 0.0
+                             : static_cast<double>(total_tokens) / static_cast<double>(doc_lengths.size());
+    // Block bounds use avg_doc_len as the searcher will parse it back from
+    // index_meta.json, so they hold for the scores it computes
+    std::ostringstream avg_text;
+    avg_text << avg_doc_len;
+    double bound_avg_doc_len = std::stod(avg_text.str());
+    if (bound_avg_doc_len <= 0.0) {
+        bound_avg_doc_len = 1.0;
+    }
+    auto posting_weight = [&](uint32_t doc, uint32_t tf) {
+        return bm25_tf_weight(static_cast<double>(tf), static_cast<double>(doc_lengths[doc]), bound_avg_doc_len);
+    };
+
+    std::ofstream postings(out_path / "postings.bin", std::ios::binary);
+    std::vector<LexEntry> lexicon;
+    uint32_t current_term = 0;
+    std::vector<uint32_t> term_doc_ids;
+    std::vector<uint32_t> term_tfs;
+    std::vector<uint8_t> encoded;
+    uint64_t postings_offset = 0;
+    bool have_term = false;
+
+    auto flush_term = [&]() {
+        encoded.clear();
+        encode_posting_blocks(term_doc_ids, term_tfs, posting_weight, postings_format, encoded);
+        lexicon.push_back(LexEntry{vocab[current_term], postings_offset, static_cast<uint32_t>(term_doc_ids.size())});
+        postings.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        postings_offset += encoded.size();
+        term_doc_ids.clear();
+        term_tfs.clear();
+    };
+
+    while (!heap.empty()) {
+        EntrySource* source = heap.top();
+        heap.pop();
+
+        const Entry& e = source->current;
+        if (!have_term || e.term_id != current_term) {
+            if (have_term) {
+                flush_term();
+            }
+            current_term = e.term_id;
+            have_term = true;
+        }
+
+        term_doc_ids.push_back(e.doc_id);
+        term_tfs.push_back(e.tf);
+
+        source->advance();
+        if (source->valid) {
+            heap.push(source);
+        }
+    }
+
+    if (have_term) {
+        flush_term();
+    }
+    for (const auto& source : sources) {
+        if (!source->ok) return false;
+    }
+
+    if (!write_lexicon(out_path, lexicon, compress_lexicon)) return false;
+
+    std::ofstream meta(out_path / "index_meta.json");
+    meta << "{\n";
+    meta << "  \"doc_count\": " << doc_lengths.size() << ",\n";
+    meta << "  \"avg_doc_len\": " << avg_doc_len << ",\n";
+    meta << "  \"total_tokens\": " << total_tokens << ",\n";
+    meta << "  \"postings_format\": " << postings_format << ",\n";
+    meta << "  \"source_db\": \"" << source_db << "\"\n";
+    meta << "}\n";
+    return true;
+}
+
+// Builds one segment from rows: this thread writes the docstore in row
+// order while the workers tokenize batches and spill chunks.  --chunk
+// bounds the buffered postings across all workers.
+class SegmentBuilder {
+public:
+    SegmentBuilder(const fs::path& dir, size_t num_threads, size_t chunk_limit, const SegmentOptions& options)
+        : dir_(dir), tmp_path_(dir / "tmp"), queue_(2 * num_threads), options_(options) {
+        fs::create_directories(tmp_path_);
+        docs_ = std::make_unique<DocStoreWriter>(dir_, options.compress_docstore);
+        for (size_t w = 0; w < num_threads; ++w) {
+            builders_.push_back(std::make_unique<ChunkBuilder>(tmp_path_, w, chunk_limit / num_threads));
+        }
+        for (size_t w = 0; w < num_threads; ++w) {
+            workers_.emplace_back([this, builder = builders_[w].get()] {
+                DocBatch batch;
+                while (queue_.pop(batch)) {
+                    for (size_t i = 0; i < batch.contents.size(); ++i) {
+                        builder->add_document(batch.first_doc_id + static_cast<uint32_t>(i), batch.contents[i]);
+                    }
+                }
+                builder->spill();
+            });
+        }
+        batch_.contents.reserve(kBatchDocs);
+    }
+
+    ~SegmentBuilder() { stop_workers(); }
+
+    uint32_t doc_count() const { return docs_->count(); }
+
+    void add(std::string_view id, std::string_view path, std::string&& content, uint64_t hash) {
+        if (batch_.contents.empty()) {
+            batch_.first_doc_id = docs_->count();
+        }
+        docs_->add(id, path, hash);
+        batch_.contents.push_back(std::move(content));
+        if (batch_.contents.size() >= kBatchDocs) {
+            queue_.push(std::move(batch_));
+            batch_ = DocBatch();
+            batch_.contents.reserve(kBatchDocs);
+        }
+    }
+
+    bool finish(const std::string& source_db) {
+        if (!batch_.contents.empty()) {
+            queue_.push(std::move(batch_));
+        }
+        stop_workers();
+
+        std::vector<uint32_t> doc_lengths(docs_->count(), 0);
+        uint64_t total_tokens = 0;
+        std::vector<fs::path> chunk_files;
+        for (const auto& builder : builders_) {
+            for (const auto& [doc, length] : builder->doc_lengths) {
+                doc_lengths[doc] = length;
+            }
+            total_tokens += builder->total_tokens;
+            chunk_files.insert(chunk_files.end(), builder->chunk_files.begin(), builder->chunk_files.end());
+        }
+        docs_->finish(doc_lengths);
+
+        std::vector<std::unique_ptr<EntrySource>> readers;
+        readers.reserve(chunk_files.size());
+        for (const auto& path : chunk_files) {
+            readers.push_back(std::make_unique<ChunkReader>(path));
+        }
+        const bool ok = write_postings(dir_, readers, doc_lengths, total_tokens, source_db, options_.postings_format,
+                                       options_.compress_lexicon);
+        readers.clear();
+        std::error_code ec;
+        fs::remove_all(tmp_path_, ec);
+        return ok;
+    }
+
+private:
+    void stop_workers() {
+        queue_.close();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) worker.join();
+        }
+    }
 
+    fs::path dir_;
+    fs::path tmp_path_;
+    BatchQueue queue_;
+    SegmentOptions options_;
+    std::unique_ptr<DocStoreWriter> docs_;
+    std::vector<std::unique_ptr<ChunkBuilder>> builders_;
+    std::vector<std::thread> workers_;
+    DocBatch batch_;
+};
+
+// Step every (id, file_path, content) row of the DB
+template <typename RowFn>
+bool for_each_row(const std::string& db_path, RowFn on_row) {
     sqlite3* db = nullptr;
     if (sqlite3_open(db_path.c_str(), &db) != SQLITE_OK) {
         std::cerr << "Failed to open DB: " << sqlite3_errmsg(db) << "\n";
-        return 1;
+        sqlite3_close(db);
+        return false;
     }
 
     const char* sql =
@@ -128,19 +707,9 @@ int main(int argc, char** argv) {
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
         std::cerr << "Failed to prepare SQL: " << sqlite3_errmsg(db) << "\n";
         sqlite3_close(db);
-        return 1;
+        return false;
     }
 
-    std::vector<Entry> entries;
-    entries.reserve(chunk_limit);
-    std::vector<fs::path> chunk_files;
-    std::vector<uint64_t> doc_offsets;
-    std::vector<uint32_t> doc_lengths;
-    uint64_t total_tokens = 0;
-
-    std::ofstream doc_data(out_path / "docstore_data.bin", std::ios::binary);
-
-    uint32_t doc_id = 0;
     uint64_t row_count = 0;
     while (sqlite3_step(stmt) == SQLITE_ROW) {
         const unsigned char* id_text = sqlite3_column_text(stmt, 0);
@@ -150,32 +719,8 @@ int main(int argc, char** argv) {
         std::string id = id_text ? reinterpret_cast<const char*>(id_text) : "";
         std::string content = content_text ? reinterpret_cast<const char*>(content_text) : "";
         std::string path = path_text ? reinterpret_cast<const char*>(path_text) : "";
+        on_row(id, path, std::move(content));
 
-        uint64_t offset = static_cast<uint64_t>(doc_data.tellp());
-        doc_offsets.push_back(offset);
-        write_varint(doc_data, id.size());
-        doc_data.write(id.data(), static_cast<std::streamsize>(id.size()));
-        write_varint(doc_data, path.size());
-        doc_data.write(path.data(), static_cast<std::streamsize>(path.size()));
-
-        std::unordered_map<std::string, uint32_t> counts;
-        counts.reserve(128);
-        uint32_t token_count = 0;
-        tokenize_to_counts(content, counts, token_count);
-        doc_lengths.push_back(token_count);
-        total_tokens += token_count;
-
-        for (const auto& kv : counts) {
-            entries.push_back(Entry{kv.first, doc_id, kv.second});
-            if (entries.size() >= chunk_limit) {
-                fs::path chunk_file = tmp_path / ("chunk_" + std::to_string(chunk_files.size()) + ".bin");
-                write_chunk(entries, chunk_file);
-                chunk_files.push_back(chunk_file);
-                entries.reserve(chunk_limit);
-            }
-        }
-
-        ++doc_id;
         ++row_count;
         if (row_count % 5000 == 0) {
             std::cerr << "Indexed " << row_count << " docs...\n";
@@ -184,97 +729,276 @@ int main(int argc, char** argv) {
 
     sqlite3_finalize(stmt);
     sqlite3_close(db);
+    return true;
+}
 
-    if (!entries.empty()) {
-        fs::path chunk_file = tmp_path / ("chunk_" + std::to_string(chunk_files.size()) + ".bin");
-        write_chunk(entries, chunk_file);
-        chunk_files.push_back(chunk_file);
-    }
+// Files a segment directory holds; "." segments share the index directory
+const char* const kSegmentFiles[] = {
+    "lexicon.bin", kLexiconDirFile, kLexiconBlocksFile, "postings.bin", "docstore_data.bin",
+    "docstore_offsets.bin", kDocBlocksFile, "docstore_doclen.bin", kDocHashFile, kTombstoneFile, "index_meta.json",
+};
 
-    std::ofstream doc_offsets_out(out_path / "docstore_offsets.bin", std::ios::binary);
-    for (uint64_t off : doc_offsets) {
-        doc_offsets_out.write(reinterpret_cast<const char*>(&off), sizeof(off));
+void remove_segment(const fs::path& index_dir, const std::string& name) {
+    std::error_code ec;
+    if (name != ".") {
+        fs::remove_all(index_dir / name, ec);
+        return;
     }
+    for (const char* file : kSegmentFiles) {
+        fs::remove(index_dir / file, ec);
+    }
+    fs::remove_all(index_dir / "tmp", ec);
+}
 
-    std::ofstream doc_len_out(out_path / "docstore_doclen.bin", std::ios::binary);
-    for (uint32_t len : doc_lengths) {
-        doc_len_out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+std::string next_segment_name(const std::vector<std::string>& segments) {
+    unsigned long next = 1;
+    for (const auto& name : segments) {
+        if (name.rfind("seg_", 0) == 0) {
+            next = std::max(next, std::stoul(name.substr(4)) + 1);
+        }
     }
+    std::string digits = std::to_string(next);
+    return "seg_" + std::string(digits.size() < 6 ? 6 - digits.size() : 0, '0') + digits;
+}
 
-    std::ofstream postings(out_path / "postings.bin", std::ios::binary);
-    std::vector<LexEntry> lexicon;
+bool open_segments(const fs::path& index_dir, std::vector<std::unique_ptr<SegmentFiles>>& segments) {
+    for (const auto& name : read_segment_list(index_dir)) {
+        auto seg = std::make_unique<SegmentFiles>();
+        if (!seg->open(index_dir, name)) {
+            std::cerr << "Failed to open segment: " << name << "\n";
+            return false;
+        }
+        segments.push_back(std::move(seg));
+    }
+    return true;
+}
 
-    std::vector<std::unique_ptr<ChunkReader>> readers;
-    readers.reserve(chunk_files.size());
-    for (const auto& path : chunk_files) {
-        readers.push_back(std::make_unique<ChunkReader>(path));
+// Full rebuild into the index directory itself, replacing any segments
+int build_full(const std::string& db_path, const fs::path& out_path, size_t num_threads, size_t chunk_limit,
+               const SegmentOptions& options) {
+    fs::create_directories(out_path);
+    if (fs::exists(out_path / kSegmentsFile)) {
+        for (const auto& name : read_segment_list(out_path)) {
+            remove_segment(out_path, name);
+        }
+        fs::remove(out_path / kSegmentsFile);
+    }
+    std::error_code ec;
+    fs::remove(out_path / kTombstoneFile, ec);
+
+    SegmentBuilder builder(out_path, num_threads, chunk_limit, options);
+    if (!for_each_row(db_path, [&](const std::string& id, const std::string& path, std::string&& content) {
+            const uint64_t hash = doc_hash(path, content);
+            builder.add(id, path, std::move(content), hash);
+        })) {
+        return 1;
     }
+    if (!builder.finish(db_path)) {
+        std::cerr << "Failed to write index\n";
+        return 1;
+    }
+    bump_generation(out_path);
+    std::cerr << "Index build complete. Docs: " << builder.doc_count() << "\n";
+    return 0;
+}
 
-    std::priority_queue<ChunkReader*, std::vector<ChunkReader*>, ReaderCmp> heap;
-    for (auto& reader : readers) {
-        if (reader->valid) {
-            heap.push(reader.get());
+// New and changed rows go into a new delta segment; their old copies and
+// rows gone from the DB are tombstoned in place.  The manifest is
+// replaced before the tombstones, so a concurrent search may briefly see
+// a changed doc twice but never miss it.
+int update_index(const std::string& db_path, const fs::path& out_path, size_t num_threads, size_t chunk_limit,
+                 const SegmentOptions& options) {
+    if (!fs::exists(out_path / kSegmentsFile) && !fs::exists(out_path / "lexicon.bin")) {
+        return build_full(db_path, out_path, num_threads, chunk_limit, options);
+    }
+    std::vector<std::unique_ptr<SegmentFiles>> segments;
+    if (!open_segments(out_path, segments)) return 1;
+
+    struct DocRef {
+        uint32_t segment;
+        uint32_t doc_id;
+        bool seen;
+    };
+    std::unordered_map<std::string, DocRef> live;
+    for (uint32_t s = 0; s < segments.size(); ++s) {
+        const SegmentFiles& seg = *segments[s];
+        if (!seg.has_hashes()) {
+            std::cerr << "Segment " << seg.name << " has no doc hashes; all its docs are re-indexed\n";
         }
+        const std::vector<uint32_t> docs = seg.live_docs();
+        seg.docs.read_sorted(docs.data(), docs.size(), [&](size_t k, const std::string& id, const std::string&) {
+            live[id] = DocRef{s, docs[k], false};
+        });
     }
 
-    std::string current_term;
-    uint64_t postings_offset = 0;
-    uint32_t postings_count = 0;
-    uint32_t prev_doc_id = 0;
-    bool have_term = false;
+    std::vector<std::string> names;
+    for (const auto& seg : segments) names.push_back(seg->name);
+    const std::string delta_name = next_segment_name(names);
+    size_t removed = 0;
+
+    auto delta = std::make_unique<SegmentBuilder>(out_path / delta_name, num_threads, chunk_limit, options);
+    if (!for_each_row(db_path, [&](const std::string& id, const std::string& path, std::string&& content) {
+            const uint64_t hash = doc_hash(path, content);
+            auto it = live.find(id);
+            if (it != live.end()) {
+                it->second.seen = true;
+                SegmentFiles& seg = *segments[it->second.segment];
+                if (seg.has_hashes() && seg.hash(it->second.doc_id) == hash) return;
+                seg.tombstone(it->second.doc_id);
+            }
+            delta->add(id, path, std::move(content), hash);
+        })) {
+        delta.reset();
+        remove_segment(out_path, delta_name);
+        return 1;
+    }
+    for (const auto& [id, ref] : live) {
+        if (ref.seen) continue;
+        segments[ref.segment]->tombstone(ref.doc_id);
+        ++removed;
+    }
 
-    while (!heap.empty()) {
-        ChunkReader* reader = heap.top();
-        heap.pop();
+    const uint32_t added = delta->doc_count();
+    if (added > 0) {
+        if (!delta->finish(db_path)) {
+            std::cerr << "Failed to write segment " << delta_name << "\n";
+            delta.reset();
+            remove_segment(out_path, delta_name);
+            return 1;
+        }
+        names.push_back(delta_name);
+    }
+    delta.reset();
+    if (added == 0) {
+        remove_segment(out_path, delta_name);
+    }
 
-        const Entry& e = reader->current;
-        if (!have_term || e.term != current_term) {
-            if (have_term) {
-                lexicon.push_back(LexEntry{current_term, postings_offset, postings_count});
-            }
-            current_term = e.term;
-            postings_offset = static_cast<uint64_t>(postings.tellp());
-            postings_count = 0;
-            prev_doc_id = 0;
-            have_term = true;
+    if (added > 0 && !write_segment_list(out_path, names)) {
+        std::cerr << "Failed to write " << kSegmentsFile << "\n";
+        return 1;
+    }
+    bool changed = added > 0;
+    for (const auto& seg : segments) {
+        if (!seg->tombstones_changed) continue;
+        changed = true;
+        if (!replace_file(seg->dir / kTombstoneFile, seg->tombstones.data(), seg->tombstones.size())) {
+            std::cerr << "Failed to write tombstones for segment " << seg->name << "\n";
+            return 1;
         }
+    }
+    if (changed) bump_generation(out_path);
 
-        uint32_t delta = e.doc_id - prev_doc_id;
-        write_varint(postings, delta);
-        write_varint(postings, e.tf);
-        prev_doc_id = e.doc_id;
-        ++postings_count;
+    std::cerr << "Update complete. Added or changed: " << added << ", deleted: " << removed
+              << ", segments: " << names.size() << "\n";
+    return 0;
+}
 
-        reader->advance();
-        if (reader->valid) {
-            heap.push(reader);
+// Compact every segment into one, dropping tombstoned docs
+int merge_segments(const fs::path& out_path, const SegmentOptions& options) {
+    std::vector<std::unique_ptr<SegmentFiles>> segments;
+    if (!open_segments(out_path, segments)) return 1;
+    if (segments.size() == 1 && !segments[0]->has_deletes()) {
+        std::cerr << "Nothing to merge.\n";
+        return 0;
+    }
+
+    std::vector<std::string> names;
+    for (const auto& seg : segments) names.push_back(seg->name);
+    const std::string merged_name = next_segment_name(names);
+    const fs::path merged_dir = out_path / merged_name;
+    fs::create_directories(merged_dir);
+
+    std::vector<std::vector<uint32_t>> doc_maps(segments.size());
+    std::vector<uint32_t> doc_lengths;
+    uint64_t total_tokens = 0;
+    {
+        DocStoreWriter docs(merged_dir, options.compress_docstore);
+        for (size_t s = 0; s < segments.size(); ++s) {
+            const SegmentFiles& seg = *segments[s];
+            doc_maps[s].assign(seg.doc_count(), kDroppedDoc);
+            const std::vector<uint32_t> live = seg.live_docs();
+            seg.docs.read_sorted(live.data(), live.size(),
+                                 [&](size_t k, const std::string& id, const std::string& path) {
+                                     const uint32_t d = live[k];
+                                     doc_maps[s][d] = docs.count();
+                                     // Docs without a stored hash keep 0, so an update re-indexes them
+                                     docs.add(id, path, seg.has_hashes() ? seg.hash(d) : 0);
+                                     doc_lengths.push_back(seg.length(d));
+                                     total_tokens += seg.length(d);
+                                 });
         }
+        docs.finish(doc_lengths);
     }
 
-    if (have_term) {
-        lexicon.push_back(LexEntry{current_term, postings_offset, postings_count});
+    std::vector<std::unique_ptr<EntrySource>> sources;
+    for (size_t s = 0; s < segments.size(); ++s) {
+        sources.push_back(std::make_unique<SegmentSource>(*segments[s], doc_maps[s]));
+    }
+    if (!write_postings(merged_dir, sources, doc_lengths, total_tokens, segments.back()->meta.source_db,
+                        options.postings_format, options.compress_lexicon)) {
+        std::cerr << "Failed to merge segments\n";
+        remove_segment(out_path, merged_name);
+        return 1;
     }
+    sources.clear();
+    segments.clear();
 
-    std::ofstream lex_out(out_path / "lexicon.bin", std::ios::binary);
-    for (const auto& lex : lexicon) {
-        uint32_t len = static_cast<uint32_t>(lex.term.size());
-        lex_out.write(reinterpret_cast<const char*>(&len), sizeof(len));
-        lex_out.write(lex.term.data(), len);
-        lex_out.write(reinterpret_cast<const char*>(&lex.postings_offset), sizeof(lex.postings_offset));
-        lex_out.write(reinterpret_cast<const char*>(&lex.postings_count), sizeof(lex.postings_count));
+    if (!write_segment_list(out_path, {merged_name})) {
+        std::cerr << "Failed to write " << kSegmentsFile << "\n";
+        return 1;
+    }
+    bump_generation(out_path);
+    for (const auto& name : names) {
+        remove_segment(out_path, name);
     }
 
-    double avg_doc_len = doc_lengths.empty()
-                             ? 0.0
-                             : static_cast<double>(total_tokens) / static_cast<double>(doc_lengths.size());
+    std::cerr << "Merge complete. Docs: " << doc_lengths.size() << ", segments merged: " << names.size() << "\n";
+    return 0;
+}
 
-    std::ofstream meta(out_path / "index_meta.json");
-    meta << "{\n";
-    meta << "  \"doc_count\": " << doc_lengths.size() << ",\n";
-    meta << "  \"avg_doc_len\": " << avg_doc_len << ",\n";
-    meta << "  \"source_db\": \"" << db_path << "\"\n";
-    meta << "}\n";
+int main(int argc, char** argv) {
+    std::string db_path = "ssot_parallel.db";
+    std::string out_dir = "ssot_index_cpp";
+    size_t chunk_limit = 1000000;
+    size_t num_threads = std::max(1u, std::thread::hardware_concurrency());
+    bool update = false;
+    bool merge = false;
+    SegmentOptions options;
 
-    std::cerr << "Index build complete. Docs: " << doc_lengths.size() << "\n";
-    return 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--db" && i + 1 < argc) {
+            db_path = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (arg == "--chunk" && i + 1 < argc) {
+            chunk_limit = static_cast<size_t>(std::stoull(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            num_threads = std::max<size_t>(1, static_cast<size_t>(std::stoull(argv[++i])));
+        } else if (arg == "--update") {
+            update = true;
+        } else if (arg == "--merge") {
+            merge = true;
+        } else if (arg == "--compress-docstore") {
+            options.compress_docstore = true;
+        } else if (arg == "--compress-lexicon") {
+            options.compress_lexicon = true;
+        } else if (arg == "--impacts") {
+            options.postings_format = kPostingsFormatImpact;
+        } else {
+            std::cerr << "Usage: indexer --db <path> --out <dir> [--chunk N] [--threads N] [--update]\n"
+                         "               [--compress-docstore] [--compress-lexicon] [--impacts]\n"
+                         "       indexer --out <dir> --merge [--compress-docstore] [--compress-lexicon] [--impacts]\n";
+            return 1;
+        }
+    }
+
+    fs::path out_path(out_dir);
+    if (merge) {
+        return merge_segments(out_path, options);
+    }
+    if (update) {
+        return update_index(db_path, out_path, num_threads, chunk_limit, options);
+    }
+    return build_full(db_path, out_path, num_threads, chunk_limit, options);
 }
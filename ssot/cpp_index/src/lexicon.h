@@ -0,0 +1,249 @@
+#pragma once
+
+#include "common.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A segment's lexicon.bin maps each term, in term order, to its postings
+// offset and count, in one of two layouts:
+//   plain        records of (u32 length, term, u64 postings offset, u32
+//                postings count); lexicon_dir.bin lists the offset of every
+//                kLexiconBlock-th record
+//   front-coded  lexicon_blocks.bin: u32 block size, u32 reserved, u64 term
+//                count, then one u64 lexicon.bin offset per block of
+//                kLexiconFrontCodedBlock terms.  A block's first record is
+//                (varint length, term, varint postings offset, varint
+//                count); each later one is (varint shared prefix, varint
+//                suffix length, suffix, varint offset delta, varint count),
+//                relative to the previous record
+// The front-coded layout is used when lexicon_blocks.bin exists.  Terms
+// of a vocabulary of identifiers share long prefixes, so it is typically
+// a third to half the size of the plain one.
+constexpr const char* kLexiconDirFile = "lexicon_dir.bin";
+constexpr const char* kLexiconBlocksFile = "lexicon_blocks.bin";
+constexpr uint32_t kLexiconFrontCodedBlock = 16;
+constexpr size_t kLexiconBlocksHeader = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+struct TermInfo {
+    std::string_view term;   // Into the mapped lexicon (plain) or a decode buffer
+    uint64_t offset;
+    uint32_t count;
+};
+
+// lexicon.bin mapped in place.  Lookups binary-search the first term of
+// each block, then decode one block.  Scans decode forward from the block
+// that holds their first term, so a prefix or range of terms costs one
+// search plus the records it covers.
+class Lexicon {
+public:
+    bool open(const std::filesystem::path& dir) {
+        if (!file_.open(dir / "lexicon.bin")) return false;
+        front_coded_ = false;
+        term_count_ = 0;
+
+        if (dir_file_.open(dir / kLexiconBlocksFile)) {
+            if (dir_file_.size() < kLexiconBlocksHeader) return false;
+            block_size_ = load_unaligned<uint32_t>(dir_file_.data());
+            term_count_ = load_unaligned<uint64_t>(dir_file_.data() + 2 * sizeof(uint32_t));
+            num_blocks_ = block_size_ ? static_cast<size_t>((term_count_ + block_size_ - 1) / block_size_) : 0;
+            if (block_size_ == 0 || dir_file_.size() < kLexiconBlocksHeader + num_blocks_ * sizeof(uint64_t)) {
+                return false;
+            }
+            dir_ = dir_file_.data() + kLexiconBlocksHeader;
+            front_coded_ = true;
+            return true;
+        }
+
+        if (dir_file_.open(dir / kLexiconDirFile) && dir_file_.size() >= 2 * sizeof(uint32_t) &&
+            (dir_file_.size() - 2 * sizeof(uint32_t)) % sizeof(uint64_t) == 0) {
+            block_size_ = load_unaligned<uint32_t>(dir_file_.data());
+            dir_ = dir_file_.data() + 2 * sizeof(uint32_t);
+            num_blocks_ = (dir_file_.size() - 2 * sizeof(uint32_t)) / sizeof(uint64_t);
+            if (block_size_ > 0) return true;
+        }
+
+        // Older index without a directory: one pass over the record headers
+        block_size_ = kLexiconBlock;
+        built_dir_.clear();
+        uint64_t offset = 0;
+        for (size_t i = 0; offset < file_.size(); ++i) {
+            TermInfo info;
+            uint64_t next = 0;
+            if (!read_record(offset, info, next)) return false;
+            if (i % block_size_ == 0) built_dir_.push_back(offset);
+            offset = next;
+        }
+        dir_ = reinterpret_cast<const uint8_t*>(built_dir_.data());
+        num_blocks_ = built_dir_.size();
+        return true;
+    }
+
+    bool front_coded() const { return front_coded_; }
+    size_t size_bytes() const { return file_.size() + dir_file_.size(); }
+
+    // out.term is `term` itself
+    bool find(std::string_view term, TermInfo& out) const {
+        bool ok = true;
+        const size_t block = find_block(term, ok);
+        if (!ok || block == kNoBlock) return false;
+        Cursor cursor = cursor_at(block);
+        TermInfo info;
+        for (uint32_t i = 0; i < block_size_ && next(cursor, info, ok); ++i) {
+            if (info.term == term) {
+                out = TermInfo{term, info.offset, info.count};
+                return true;
+            }
+            if (info.term > term) return false;
+        }
+        return false;
+    }
+
+    // fn(info) for every term in order; false if a record is unreadable.
+    // info.term is valid during the call only.
+    template <typename Fn>
+    bool for_each(Fn fn) const {
+        return for_each_from(std::string_view(), [&](const TermInfo& info) {
+            fn(info);
+            return true;
+        });
+    }
+
+    // fn(info) for the terms from the first one >= `from`, in order, until
+    // fn returns false; false if a record is unreadable
+    template <typename Fn>
+    bool for_each_from(std::string_view from, Fn fn) const {
+        bool ok = true;
+        size_t block = from.empty() ? 0 : find_block(from, ok);
+        if (!ok) return false;
+        if (block == kNoBlock) block = 0;
+        if (num_blocks_ == 0) return true;
+        Cursor cursor = cursor_at(block);
+        TermInfo info;
+        while (next(cursor, info, ok)) {
+            if (info.term < from) continue;
+            if (!fn(info)) break;
+        }
+        return ok;
+    }
+
+private:
+    static constexpr size_t kNoBlock = SIZE_MAX;
+
+    // Decoding position; term and postings carry the previous front-coded
+    // record
+    struct Cursor {
+        uint64_t offset = 0;
+        uint64_t index = 0;
+        std::string term;
+        uint64_t postings = 0;
+    };
+
+    Cursor cursor_at(size_t block) const {
+        Cursor cursor;
+        cursor.offset = block_start(block);
+        cursor.index = uint64_t(block) * block_size_;
+        return cursor;
+    }
+
+    // The record at the cursor, then step past it; false at the end, or
+    // with ok = false for an unreadable record
+    bool next(Cursor& cursor, TermInfo& out, bool& ok) const {
+        if (!front_coded_) {
+            if (cursor.offset >= file_.size()) return false;
+            uint64_t next_offset = 0;
+            if (!read_record(cursor.offset, out, next_offset)) {
+                ok = false;
+                return false;
+            }
+            cursor.offset = next_offset;
+            ++cursor.index;
+            return true;
+        }
+
+        if (cursor.index >= term_count_) return false;
+        if (cursor.offset > file_.size()) {
+            ok = false;
+            return false;
+        }
+        const uint8_t* p = file_.data() + cursor.offset;
+        const uint8_t* end = file_.data() + file_.size();
+        uint64_t postings = 0;
+        uint64_t count = 0;
+        const bool first = cursor.index % block_size_ == 0;
+        if (!(first ? read_whole(p, end, cursor.term) : read_front_coded(p, end, cursor.term)) ||
+            !read_varint(p, end, postings) || !read_varint(p, end, count) || count > UINT32_MAX) {
+            ok = false;
+            return false;
+        }
+        cursor.postings = first ? postings : cursor.postings + postings;
+        out = TermInfo{cursor.term, cursor.postings, static_cast<uint32_t>(count)};
+        cursor.offset = static_cast<uint64_t>(p - file_.data());
+        ++cursor.index;
+        return true;
+    }
+
+    // Last block whose first term is <= term, or kNoBlock
+    size_t find_block(std::string_view term, bool& ok) const {
+        size_t lo = 0;
+        size_t hi = num_blocks_;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            std::string_view first;
+            if (!first_term(mid, first)) {
+                ok = false;
+                return kNoBlock;
+            }
+            if (first <= term) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo == 0 ? kNoBlock : lo - 1;
+    }
+
+    // A block's first term, stored whole in both layouts
+    bool first_term(size_t block, std::string_view& out) const {
+        if (front_coded_) {
+            return read_string_at(file_.data(), file_.size(), block_start(block), out);
+        }
+        TermInfo info;
+        uint64_t next_offset = 0;
+        if (!read_record(block_start(block), info, next_offset)) return false;
+        out = info.term;
+        return true;
+    }
+
+    bool read_record(uint64_t offset, TermInfo& out, uint64_t& next) const {
+        const size_t size = file_.size();
+        if (offset > size || size - offset < sizeof(uint32_t)) return false;
+        const uint8_t* p = file_.data() + offset;
+        const uint32_t len = load_unaligned<uint32_t>(p);
+        const uint64_t record_size = sizeof(uint32_t) + uint64_t(len) + sizeof(uint64_t) + sizeof(uint32_t);
+        if (size - offset < record_size) return false;
+        p += sizeof(uint32_t);
+        out.term = std::string_view(reinterpret_cast<const char*>(p), len);
+        out.offset = load_unaligned<uint64_t>(p + len);
+        out.count = load_unaligned<uint32_t>(p + len + sizeof(uint64_t));
+        next = offset + record_size;
+        return true;
+    }
+
+    uint64_t block_start(size_t block) const {
+        return load_unaligned<uint64_t>(dir_ + block * sizeof(uint64_t));
+    }
+
+    MappedFile file_;
+    MappedFile dir_file_;               // lexicon_blocks.bin or lexicon_dir.bin
+    const uint8_t* dir_ = nullptr;      // One u64 record offset per block
+    size_t num_blocks_ = 0;
+    uint32_t block_size_ = kLexiconBlock;
+    bool front_coded_ = false;
+    uint64_t term_count_ = 0;           // Front-coded only
+    std::vector<uint64_t> built_dir_;   // Backs dir_ when lexicon_dir.bin is absent
+};
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "common.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <immintrin.h>
+#define SSOT_POSTINGS_SIMD 1
+#endif
+
+// Postings formats (index_meta.json "postings_format"; absent = 1):
+//   1  one varint doc-id delta and one varint tf per entry
+//   2  blocks of kPostingBlock entries (the last may be shorter), each
+//        u32 max_doc_id   last (largest) doc id of the block
+//        u32 max_tf
+//        u32 doc_bytes    size of the doc-id delta stream
+//        u32 tf_bytes     size of the tf stream
+//        delta stream, then tf stream (Stream VByte)
+//   3  as 2, with an f32 max_weight after tf_bytes: the largest
+//      bm25_tf_weight() in the block, rounded up
+//   4  as 3, with a u32 impact_bytes after max_weight and, after the tf
+//      stream, one u8 impact per posting: its bm25_tf_weight() in
+//      kImpactStep units, rounded to nearest.  max_weight is then the
+//      block's largest dequantized impact
+//
+// The first delta of a block is relative to the previous block's
+// max_doc_id (0 for the first block).  A Stream VByte stream of n values
+// is ceil(n / 4) control bytes, 2 bits per value giving its byte length
+// minus one, followed by the values' low bytes, little-endian.
+constexpr uint32_t kPostingsFormatVarint = 1;
+constexpr uint32_t kPostingsFormatBlocked = 2;
+constexpr uint32_t kPostingsFormatBlockMax = 3;
+constexpr uint32_t kPostingsFormatImpact = 4;
+constexpr uint32_t kPostingBlock = 128;
+
+// bm25_tf_weight() is below k1 + 1, so 8 bits cover it in these steps
+constexpr double kImpactStep = (kBm25K1 + 1.0) / 255.0;
+
+inline uint8_t quantize_impact(double weight) {
+    const double q = std::round(weight / kImpactStep);
+    return static_cast<uint8_t>(q < 0.0 ? 0.0 : q > 255.0 ? 255.0 : q);
+}
+
+inline double impact_weight(uint32_t impact) {
+    return impact * kImpactStep;
+}
+
+inline size_t posting_block_header_size(uint32_t format) {
+    const size_t words = format >= kPostingsFormatImpact ? 6 : format >= kPostingsFormatBlockMax ? 5 : 4;
+    return words * sizeof(uint32_t);
+}
+
+namespace postings_detail {
+
+struct StreamVByteTables {
+    uint8_t length[256];        // Data bytes of a 4-value group
+    uint8_t shuffle[256][16];   // pshufb mask expanding a group to 4 x u32
+};
+
+inline const StreamVByteTables& tables() {
+    static const StreamVByteTables t = [] {
+        StreamVByteTables built{};
+        for (int control = 0; control < 256; ++control) {
+            int pos = 0;
+            for (int k = 0; k < 4; ++k) {
+                const int len = ((control >> (2 * k)) & 3) + 1;
+                for (int b = 0; b < 4; ++b) {
+                    built.shuffle[control][4 * k + b] = (b < len) ? static_cast<uint8_t>(pos + b) : 0xFF;
+                }
+                pos += len;
+            }
+            built.length[control] = static_cast<uint8_t>(pos);
+        }
+        return built;
+    }();
+    return t;
+}
+
+inline uint32_t value_length(const uint8_t* control, size_t i) {
+    return ((control[i / 4] >> ((i % 4) * 2)) & 3) + 1;
+}
+
+inline uint32_t load_value(const uint8_t* data, uint32_t len) {
+    uint32_t value = 0;
+    for (uint32_t b = 0; b < len; ++b) {
+        value |= static_cast<uint32_t>(data[b]) << (8 * b);
+    }
+    return value;
+}
+
+} // namespace postings_detail
+
+// Append n values as a Stream VByte stream; returns its size in bytes
+inline size_t streamvbyte_encode(const uint32_t* in, size_t n, std::vector<uint8_t>& out) {
+    const size_t start = out.size();
+    out.resize(start + (n + 3) / 4, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t v = in[i];
+        const uint32_t len = v < (1u << 8) ? 1 : v < (1u << 16) ? 2 : v < (1u << 24) ? 3 : 4;
+        out[start + i / 4] |= static_cast<uint8_t>((len - 1) << ((i % 4) * 2));
+        for (uint32_t b = 0; b < len; ++b) {
+            out.push_back(static_cast<uint8_t>(v >> (8 * b)));
+        }
+    }
+    return out.size() - start;
+}
+
+// Decode n values of the stream at `in`, which must end exactly at
+// stream_end; SIMD loads may read (but not use) bytes up to readable_end
+inline bool streamvbyte_decode(const uint8_t* in, const uint8_t* stream_end,
+                               const uint8_t* readable_end, size_t n, uint32_t* out) {
+    using namespace postings_detail;
+    const StreamVByteTables& t = tables();
+    const size_t control_bytes = (n + 3) / 4;
+    if (static_cast<size_t>(stream_end - in) < control_bytes) return false;
+    const uint8_t* control = in;
+    const uint8_t* data = in + control_bytes;
+
+    const size_t groups = n / 4;
+    size_t data_bytes = 0;
+    for (size_t g = 0; g < groups; ++g) data_bytes += t.length[control[g]];
+    for (size_t i = groups * 4; i < n; ++i) data_bytes += value_length(control, i);
+    if (static_cast<size_t>(stream_end - data) != data_bytes) return false;
+
+    for (size_t g = 0; g < groups; ++g) {
+        const uint8_t c = control[g];
+#ifdef SSOT_POSTINGS_SIMD
+        if (readable_end - data >= 16) {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.shuffle[c]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * g), _mm_shuffle_epi8(packed, mask));
+            data += t.length[c];
+            continue;
+        }
+#endif
+        for (size_t k = 0; k < 4; ++k) {
+            const uint32_t len = ((c >> (2 * k)) & 3) + 1;
+            out[4 * g + k] = load_value(data, len);
+            data += len;
+        }
+    }
+    for (size_t i = groups * 4; i < n; ++i) {
+        const uint32_t len = value_length(control, i);
+        out[i] = load_value(data, len);
+        data += len;
+    }
+    return true;
+}
+
+// In-place prefix sum of n deltas on top of base
+inline void delta_decode(uint32_t* values, size_t n, uint32_t base) {
+    size_t i = 0;
+#ifdef SSOT_POSTINGS_SIMD
+    __m128i carry = _mm_set1_epi32(static_cast<int>(base));
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), x);
+        carry = _mm_shuffle_epi32(x, 0xFF);
+    }
+    if (i > 0) base = values[i - 1];
+#endif
+    for (; i < n; ++i) {
+        base += values[i];
+        values[i] = base;
+    }
+}
+
+// Append one term's postings (doc ids ascending) as format-3 blocks, or
+// format-4 ones; weight(doc_id, tf) gives each posting's bm25_tf_weight()
+template <typename WeightFn>
+void encode_posting_blocks(const std::vector<uint32_t>& doc_ids,
+                           const std::vector<uint32_t>& tfs,
+                           WeightFn weight, uint32_t format, std::vector<uint8_t>& out) {
+    uint32_t deltas[kPostingBlock];
+    uint8_t impacts[kPostingBlock];
+    uint32_t prev = 0;
+    const bool with_impacts = format >= kPostingsFormatImpact;
+    const size_t header_size = posting_block_header_size(format);
+    for (size_t start = 0; start < doc_ids.size(); start += kPostingBlock) {
+        const size_t n = std::min<size_t>(kPostingBlock, doc_ids.size() - start);
+        uint32_t max_tf = 0;
+        double max_weight = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            deltas[i] = doc_ids[start + i] - prev;
+            prev = doc_ids[start + i];
+            max_tf = std::max(max_tf, tfs[start + i]);
+            double w = weight(doc_ids[start + i], tfs[start + i]);
+            if (with_impacts) {
+                impacts[i] = quantize_impact(w);
+                w = impact_weight(impacts[i]);
+            }
+            max_weight = std::max(max_weight, w);
+        }
+
+        const size_t header_pos = out.size();
+        out.resize(header_pos + header_size);
+        const uint32_t doc_bytes = static_cast<uint32_t>(streamvbyte_encode(deltas, n, out));
+        const uint32_t tf_bytes = static_cast<uint32_t>(streamvbyte_encode(&tfs[start], n, out));
+        if (with_impacts) out.insert(out.end(), impacts, impacts + n);
+        // Round up so the stored bound never undercuts a posting's weight
+        const float bound = std::nextafter(static_cast<float>(max_weight), INFINITY);
+        const uint32_t header[4] = {prev, max_tf, doc_bytes, tf_bytes};
+        std::memcpy(&out[header_pos], header, sizeof(header));
+        std::memcpy(&out[header_pos + sizeof(header)], &bound, sizeof(bound));
+        if (with_impacts) {
+            const uint32_t impact_bytes = static_cast<uint32_t>(n);
+            std::memcpy(&out[header_pos + sizeof(header) + sizeof(bound)], &impact_bytes, sizeof(impact_bytes));
+        }
+    }
+}
+
+struct PostingBlockHeader {
+    uint32_t max_doc_id;
+    uint32_t max_tf;
+    uint32_t doc_bytes;
+    uint32_t tf_bytes;
+    float max_weight;   // Format 3 and up; negative when absent
+    uint32_t impact_bytes;   // Format 4 only; 0 when absent
+    uint32_t header_size;
+};
+
+// Header of the block at p; false if the header or its streams run past end
+inline bool read_posting_block_header(const uint8_t* p, const uint8_t* end, uint32_t format,
+                                      PostingBlockHeader& header) {
+    header.header_size = static_cast<uint32_t>(posting_block_header_size(format));
+    if (static_cast<size_t>(end - p) < header.header_size) return false;
+    uint32_t words[4];
+    std::memcpy(words, p, sizeof(words));
+    header.max_doc_id = words[0];
+    header.max_tf = words[1];
+    header.doc_bytes = words[2];
+    header.tf_bytes = words[3];
+    header.max_weight = -1.0f;
+    header.impact_bytes = 0;
+    if (format >= kPostingsFormatBlockMax) {
+        std::memcpy(&header.max_weight, p + sizeof(words), sizeof(header.max_weight));
+    }
+    if (format >= kPostingsFormatImpact) {
+        std::memcpy(&header.impact_bytes, p + sizeof(words) + sizeof(float), sizeof(header.impact_bytes));
+    }
+    const size_t body = static_cast<size_t>(end - p) - header.header_size;
+    return header.doc_bytes <= body && header.tf_bytes <= body - header.doc_bytes &&
+           header.impact_bytes <= body - header.doc_bytes - header.tf_bytes;
+}
+
+inline size_t posting_block_size(const PostingBlockHeader& header) {
+    return size_t(header.header_size) + header.doc_bytes + header.tf_bytes + header.impact_bytes;
+}
+
+// Decode the n postings of the block at p (header already read); base is
+// the previous block's max_doc_id
+inline bool decode_posting_block(const uint8_t* p, const uint8_t* end, const PostingBlockHeader& header,
+                                 size_t n, uint32_t base, uint32_t* doc_ids, uint32_t* tfs) {
+    const uint8_t* docs = p + header.header_size;
+    const uint8_t* tf_stream = docs + header.doc_bytes;
+    if (!streamvbyte_decode(docs, tf_stream, end, n, doc_ids)) return false;
+    if (!streamvbyte_decode(tf_stream, tf_stream + header.tf_bytes, end, n, tfs)) return false;
+    delta_decode(doc_ids, n, base);
+    return true;
+}
+
+// As decode_posting_block, with a format-4 block's impacts in place of tfs
+inline bool decode_posting_block_impacts(const uint8_t* p, const uint8_t* end, const PostingBlockHeader& header,
+                                         size_t n, uint32_t base, uint32_t* doc_ids, uint32_t* impacts) {
+    const uint8_t* docs = p + header.header_size;
+    const uint8_t* tf_stream = docs + header.doc_bytes;
+    if (header.impact_bytes != n) return false;
+    if (!streamvbyte_decode(docs, tf_stream, end, n, doc_ids)) return false;
+    const uint8_t* impact = tf_stream + header.tf_bytes;
+    for (size_t i = 0; i < n; ++i) impacts[i] = impact[i];
+    delta_decode(doc_ids, n, base);
+    return true;
+}
+
+// Decode a whole `count`-posting list at data[offset] in any format
+inline bool decode_postings(uint32_t format, const uint8_t* data, size_t size, uint64_t offset, uint32_t count,
+                            std::vector<uint32_t>& doc_ids, std::vector<uint32_t>& tfs) {
+    doc_ids.resize(count);
+    tfs.resize(count);
+    if (offset > size) return false;
+    const uint8_t* p = data + offset;
+    const uint8_t* end = data + size;
+    if (format < kPostingsFormatBlocked) {
+        uint32_t doc_id = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint64_t delta = 0;
+            uint64_t tf = 0;
+            if (!read_varint(p, end, delta)) return false;
+            if (!read_varint(p, end, tf)) return false;
+            doc_id += static_cast<uint32_t>(delta);
+            doc_ids[i] = doc_id;
+            tfs[i] = static_cast<uint32_t>(tf);
+        }
+        return true;
+    }
+    uint32_t base = 0;
+    for (size_t done = 0; done < count;) {
+        const size_t n = std::min<size_t>(kPostingBlock, count - done);
+        PostingBlockHeader header;
+        if (!read_posting_block_header(p, end, format, header)) return false;
+        if (!decode_posting_block(p, end, header, n, base, &doc_ids[done], &tfs[done])) return false;
+        p += posting_block_size(header);
+        base = header.max_doc_id;
+        done += n;
+    }
+    return true;
+}
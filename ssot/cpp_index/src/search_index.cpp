@@ -0,0 +1,433 @@
+#include "search_index.h"
+
+#include <cmath>
+#include <queue>
+#include <sstream>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool open_segment(const fs::path& dir, Segment& seg, std::string& error) {
+    seg.meta = read_index_meta(dir / "index_meta.json");
+    if (seg.meta.postings_format < kPostingsFormatVarint || seg.meta.postings_format > kPostingsFormatImpact) {
+        error = "Unsupported postings format: " + std::to_string(seg.meta.postings_format);
+        return false;
+    }
+    if (!seg.lexicon.open(dir)) {
+        error = "Failed to load lexicon.";
+        return false;
+    }
+    if (!seg.postings.open(dir / "postings.bin")) {
+        error = "Failed to open postings.bin";
+        return false;
+    }
+    if (!seg.docs.open(dir)) {
+        error = "Failed to open docstore files";
+        return false;
+    }
+    if (fs::exists(dir / kTombstoneFile) && !seg.tombstones.open(dir / kTombstoneFile)) {
+        error = std::string("Failed to open ") + kTombstoneFile;
+        return false;
+    }
+    for (size_t byte = 0; byte < seg.tombstones.size(); ++byte) {
+        if (seg.tombstones.data()[byte] == 0) continue;
+        for (uint32_t bit = 0; bit < 8; ++bit) {
+            const uint32_t doc_id = static_cast<uint32_t>(byte * 8 + bit);
+            if (doc_id >= seg.docs.count() || !seg.is_deleted(doc_id)) continue;
+            ++seg.deleted;
+            if (doc_id < seg.docs.length_count()) seg.deleted_tokens += seg.docs.length(doc_id);
+        }
+    }
+    return true;
+}
+
+struct TermPostings {
+    std::string term;
+    size_t term_index;   // Position in the query's term list
+    PostingCursor cursor;
+};
+
+// Next doc id >= target present in every list, or kNoDoc.  lists[0] (the
+// shortest) proposes candidates and the others gallop to them.
+uint32_t next_match(std::vector<TermPostings>& lists, uint32_t target) {
+    uint32_t doc = lists.front().cursor.next_geq(target);
+    size_t i = 1;
+    while (doc != kNoDoc && i < lists.size()) {
+        const uint32_t found = lists[i].cursor.next_geq(doc);
+        if (found == doc) {
+            ++i;
+            continue;
+        }
+        doc = (found == kNoDoc) ? kNoDoc : lists.front().cursor.next_geq(found);
+        i = 1;
+    }
+    return doc;
+}
+
+// The lexicon terms matching `pattern`, at most kMaxPatternTerms of them
+// (those with the most postings).  Only the terms sharing the literal
+// prefix before its first wildcard are scanned.
+bool expand_pattern(const Lexicon& lexicon, std::string_view pattern, std::vector<TermInfo>& out) {
+    out.clear();
+    const std::string_view prefix = pattern.substr(0, pattern.find_first_of("*?"));
+    const bool ok = lexicon.for_each_from(prefix, [&](const TermInfo& info) {
+        if (info.term.compare(0, prefix.size(), prefix) != 0) return false;
+        if (pattern_matches(pattern, info.term)) out.push_back(TermInfo{std::string_view(), info.offset, info.count});
+        return true;
+    });
+    if (out.size() > kMaxPatternTerms) {
+        std::nth_element(out.begin(), out.begin() + kMaxPatternTerms, out.end(),
+                         [](const TermInfo& a, const TermInfo& b) { return a.count > b.count; });
+        out.resize(kMaxPatternTerms);
+    }
+    // Postings order keeps the union's reads sequential
+    std::sort(out.begin(), out.end(), [](const TermInfo& a, const TermInfo& b) { return a.offset < b.offset; });
+    return ok;
+}
+
+}  // namespace
+
+bool is_pattern(std::string_view term) {
+    return term.find_first_of("*?") != std::string_view::npos;
+}
+
+bool pattern_matches(std::string_view pattern, std::string_view term) {
+    // Greedy match, backtracking to the last '*' on a mismatch
+    size_t p = 0;
+    size_t t = 0;
+    size_t star = std::string_view::npos;
+    size_t star_t = 0;
+    while (t < term.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == term[t])) {
+            ++p;
+            ++t;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            star_t = t;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            t = ++star_t;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+bool open_index(const fs::path& dir, SearchIndex& index, std::string& error) {
+    index.segments.clear();
+    index.generation = read_generation(dir);
+    for (const auto& name : read_segment_list(dir)) {
+        auto seg = std::make_unique<Segment>();
+        if (!open_segment(dir / name, *seg, error)) return false;
+        index.segments.push_back(std::move(seg));
+    }
+    return true;
+}
+
+std::vector<std::string> query_terms(const std::string& query) {
+    std::vector<std::string> terms;
+    std::string term;
+    auto flush = [&]() {
+        // A pattern of wildcards alone would match every term
+        if (term.find_first_not_of("*?") != std::string::npos) terms.push_back(term);
+        term.clear();
+    };
+    for (const char c : query) {
+        const char lower = static_cast<char>(c | 0x20);
+        if ((lower >= 'a' && lower <= 'z') || (c >= '0' && c <= '9')) {
+            term.push_back(lower);
+        } else if (c == '*' || c == '?') {
+            term.push_back(c);
+        } else {
+            flush();
+        }
+    }
+    flush();
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    return terms;
+}
+
+bool run_query(const SearchIndex& index, const std::vector<std::string>& terms, const std::string& mode,
+               size_t limit, std::string& out, std::string& error, QueryStats* stats) {
+    if (terms.empty()) {
+        error = "No valid terms in query.";
+        return false;
+    }
+    if (mode != "keyword" && mode != "full") {
+        error = "Unknown mode: " + mode;
+        return false;
+    }
+    std::ostringstream os;
+
+    // Collection statistics over live docs; a lone segment without
+    // deletes keeps the avg_doc_len its block bounds were computed with
+    double N = 0.0;
+    double live_tokens = 0.0;
+    for (const auto& seg : index.segments) {
+        N += static_cast<double>(seg->docs.count() - seg->deleted);
+        live_tokens += seg->live_tokens();
+    }
+    double avg_doc_len = (index.segments.size() == 1 && index.segments[0]->deleted == 0)
+                             ? index.segments[0]->meta.avg_doc_len
+                             : (N > 0.0 ? live_tokens / N : 0.0);
+    if (avg_doc_len <= 0.0) {
+        avg_doc_len = 1.0;
+    }
+
+    // Per segment, the cursors of a query whose terms all occur in it (AND);
+    // document frequencies are summed over every segment, tombstoned docs
+    // included
+    struct SegmentQuery {
+        size_t segment;
+        bool stored_bounds;   // Block bounds and impacts assumed avg_doc_len
+        std::vector<TermPostings> term_lists;
+    };
+    std::vector<SegmentQuery> queries;
+    std::vector<double> dfs(terms.size(), 0.0);
+    const bool has_pattern = std::any_of(terms.begin(), terms.end(), [](const std::string& t) { return is_pattern(t); });
+    std::vector<TermInfo> expansions;
+    for (size_t s = 0; s < index.segments.size(); ++s) {
+        const Segment& seg = *index.segments[s];
+        SegmentQuery sq;
+        sq.segment = s;
+        sq.stored_bounds = (seg.meta.avg_doc_len > 0.0 ? seg.meta.avg_doc_len : 1.0) == avg_doc_len;
+        // Full mode scores format-4 segments from their impacts, unless a
+        // pattern's summed tfs must be weighted instead
+        const bool impacts = mode == "full" && sq.stored_bounds && !has_pattern;
+        bool all_found = true;
+        for (size_t t = 0; t < terms.size(); ++t) {
+            TermInfo info{};
+            TermPostings tp;
+            tp.term = terms[t];
+            tp.term_index = t;
+            if (is_pattern(terms[t])) {
+                // A pattern's document frequency is its union's length, so
+                // the union is built even where another term is missing
+                if (!expand_pattern(seg.lexicon, terms[t], expansions)) {
+                    error = "Failed to read lexicon.";
+                    return false;
+                }
+                if (expansions.empty()) {
+                    all_found = false;
+                    continue;
+                }
+                if (!tp.cursor.open_union(seg.meta.postings_format, seg.postings, expansions)) {
+                    error = "Failed to load postings for term: " + terms[t];
+                    return false;
+                }
+                dfs[t] += tp.cursor.count();
+                if (!all_found) continue;
+            } else {
+                if (!seg.lexicon.find(terms[t], info)) {
+                    all_found = false;
+                    continue;
+                }
+                dfs[t] += info.count;
+                if (!all_found) continue;
+                if (!tp.cursor.open(seg.meta.postings_format, seg.postings, info, impacts)) {
+                    error = "Failed to load postings for term: " + terms[t];
+                    return false;
+                }
+            }
+            sq.term_lists.push_back(std::move(tp));
+        }
+        if (!all_found) continue;
+        std::sort(sq.term_lists.begin(), sq.term_lists.end(),
+                  [](const TermPostings& a, const TermPostings& b) {
+                      return a.cursor.count() < b.cursor.count();
+                  });
+        queries.push_back(std::move(sq));
+    }
+    if (queries.empty()) {
+        out = "No results.\n";
+        return true;
+    }
+
+    auto postings_ok = [&]() {
+        if (stats) {
+            for (const auto& sq : queries) {
+                for (const auto& tp : sq.term_lists) tp.cursor.add_stats(*stats);
+            }
+        }
+        for (const auto& sq : queries) {
+            for (const auto& tp : sq.term_lists) {
+                if (!tp.cursor.ok()) {
+                    error = "Failed to load postings for term: " + tp.term;
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+
+    if (mode == "keyword") {
+        // Matches come in doc order, so each segment's docstore records are
+        // read in one forward pass once its matches are known
+        size_t printed = 0;
+        bool matched = false;
+        std::vector<uint32_t> hits;
+        for (auto& sq : queries) {
+            const Segment& seg = *index.segments[sq.segment];
+            hits.clear();
+            for (uint32_t doc_id = next_match(sq.term_lists, 0); doc_id != kNoDoc;
+                 doc_id = next_match(sq.term_lists, doc_id + 1)) {
+                if (seg.is_deleted(doc_id)) continue;
+                matched = true;
+                if (doc_id >= seg.docs.count()) continue;
+                hits.push_back(doc_id);
+                if (++printed >= limit) break;
+            }
+            seg.docs.records.read_sorted(hits.data(), hits.size(),
+                                         [&](size_t, const std::string& id, const std::string& path) {
+                                             os << id << "\t" << path << "\n";
+                                         });
+            if (printed > 0 && printed >= limit) break;
+        }
+        if (!postings_ok()) return false;
+        out = matched ? os.str() : "No results.\n";
+        return true;
+    }
+
+    std::vector<double> idfs;
+    for (double df : dfs) {
+        idfs.push_back(std::log((N - df + 0.5) / (df + 0.5) + 1.0));
+    }
+
+    // Scores carry (segment << 32 | doc id)
+    using ScoredDoc = std::pair<double, uint64_t>;
+    auto cmp = [](const ScoredDoc& a, const ScoredDoc& b) { return a.first > b.first; };
+    std::priority_queue<ScoredDoc, std::vector<ScoredDoc>, decltype(cmp)> topk(cmp);
+
+    // Block-max pruning: within its current block a term scores at most
+    // idf * max_weight (idf * weight(max_tf, dl = 0) for indexes without
+    // stored bounds, or whose bounds assumed another avg_doc_len).  While
+    // the sum of those bounds cannot beat the k-th best score, every doc up
+    // to the nearest block end is skipped without being decoded.  Only docs
+    // that could enter the heap are passed over, so results match
+    // exhaustive evaluation exactly.  The heap is shared by all segments.
+    // Format-4 segments whose impacts assumed this avg_doc_len are scored
+    // as the sum of idf * dequantized impact, with no doc length lookup;
+    // their block bounds are the largest dequantized impacts.
+    bool matched = false;
+    for (auto& sq : queries) {
+        const Segment& seg = *index.segments[sq.segment];
+        auto& term_lists = sq.term_lists;
+        const bool stored_bounds = sq.stored_bounds;
+        const bool impacts = !term_lists.empty() && term_lists[0].cursor.impacts();
+
+        uint32_t doc_id = 0;
+        double block_bound = 0.0;
+        uint32_t bound_end = 0;      // block_bound holds for docs up to here
+        bool have_bound = false;
+        while (true) {
+            if (limit > 0 && topk.size() >= limit) {
+                if (!have_bound || doc_id > bound_end) {
+                    block_bound = 0.0;
+                    bound_end = kNoDoc;
+                    bool ended = false;
+                    for (auto& tp : term_lists) {
+                        PostingCursor& cursor = tp.cursor;
+                        if (!cursor.seek_block(doc_id)) {
+                            ended = true;
+                            break;
+                        }
+                        const double max_weight =
+                            (stored_bounds && cursor.block_max_weight() >= 0.0)
+                                ? cursor.block_max_weight()
+                                : bm25_tf_weight(static_cast<double>(cursor.block_max_tf()), 0.0, avg_doc_len);
+                        block_bound += idfs[tp.term_index] * max_weight;
+                        bound_end = std::min(bound_end, cursor.block_max_doc());
+                    }
+                    if (ended) break;
+                    have_bound = true;
+                }
+                if (block_bound <= topk.top().first) {
+                    if (bound_end == kNoDoc) break;
+                    doc_id = bound_end + 1;
+                    continue;
+                }
+            }
+
+            doc_id = next_match(term_lists, doc_id);
+            if (doc_id == kNoDoc) break;
+            if (seg.is_deleted(doc_id)) {
+                ++doc_id;
+                continue;
+            }
+            matched = true;
+
+            double score = 0.0;
+            if (impacts) {
+                for (const auto& tp : term_lists) {
+                    score += idfs[tp.term_index] * impact_weight(tp.cursor.tf());
+                }
+            } else {
+                double dl = (doc_id < seg.docs.length_count()) ? seg.docs.length(doc_id) : avg_doc_len;
+                for (const auto& tp : term_lists) {
+                    score += idfs[tp.term_index] * bm25_tf_weight(static_cast<double>(tp.cursor.tf()), dl, avg_doc_len);
+                }
+            }
+            const uint64_t key = (uint64_t(sq.segment) << 32) | doc_id;
+            if (topk.size() < limit) {
+                topk.push({score, key});
+            } else if (!topk.empty() && score > topk.top().first) {
+                topk.pop();
+                topk.push({score, key});
+            }
+            ++doc_id;
+        }
+    }
+    if (!postings_ok()) return false;
+    if (!matched) {
+        out = "No results.\n";
+        return true;
+    }
+
+    std::vector<ScoredDoc> results;
+    results.reserve(topk.size());
+    while (!topk.empty()) {
+        results.push_back(topk.top());
+        topk.pop();
+    }
+    std::sort(results.begin(), results.end(),
+              [](const ScoredDoc& a, const ScoredDoc& b) { return a.first > b.first; });
+
+    // Materialize the top-k in (segment, doc id) order for locality, then
+    // print them by score
+    std::vector<uint32_t> order(results.size());
+    for (uint32_t r = 0; r < order.size(); ++r) order[r] = r;
+    std::sort(order.begin(), order.end(),
+              [&](uint32_t a, uint32_t b) { return results[a].second < results[b].second; });
+    std::vector<std::pair<std::string, std::string>> records(results.size());
+    std::vector<char> readable(results.size(), 0);
+    std::vector<uint32_t> doc_ids;
+    for (size_t start = 0; start < order.size();) {
+        const uint64_t segment = results[order[start]].second >> 32;
+        size_t stop = start;
+        doc_ids.clear();
+        while (stop < order.size() && (results[order[stop]].second >> 32) == segment) {
+            doc_ids.push_back(static_cast<uint32_t>(results[order[stop]].second));
+            ++stop;
+        }
+        index.segments[segment]->docs.records.read_sorted(
+            doc_ids.data(), doc_ids.size(), [&](size_t k, const std::string& id, const std::string& path) {
+                const uint32_t r = order[start + k];
+                records[r] = {id, path};
+                readable[r] = 1;
+            });
+        start = stop;
+    }
+
+    for (size_t r = 0; r < results.size(); ++r) {
+        if (!readable[r]) continue;
+        os << results[r].first << "\t" << records[r].first << "\t" << records[r].second << "\n";
+    }
+
+    out = os.str();
+    return true;
+}
@@ -0,0 +1,291 @@
+#pragma once
+
+#include "common.h"
+#include "docstore.h"
+#include "lexicon.h"
+#include "mapped_file.h"
+#include "postings_codec.h"
+#include "segments.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A segment's docstore records (docstore.h) and docstore_doclen.bin (u32
+// per doc), all mapped
+struct DocStore {
+    DocStoreReader records;
+    MappedFile lengths;
+
+    bool open(const std::filesystem::path& base) {
+        return records.open(base) && lengths.open(base / "docstore_doclen.bin");
+    }
+
+    size_t count() const { return records.count(); }
+    size_t length_count() const { return lengths.size() / sizeof(uint32_t); }
+
+    uint32_t length(uint32_t doc_id) const {
+        return load_unaligned<uint32_t>(lengths.data() + size_t(doc_id) * sizeof(uint32_t));
+    }
+};
+
+constexpr uint32_t kNoDoc = UINT32_MAX;
+
+// Postings work done by a query, for ssot_bench
+struct QueryStats {
+    uint64_t blocks_decoded = 0;
+    uint64_t postings_decoded = 0;
+    uint64_t postings_bytes = 0;   // Block headers and the streams decoded; format 1 not counted
+};
+
+// Document-at-a-time cursor over one term's postings.  Format-2 lists are
+// walked block by block and seek_block() reads only block headers, so
+// blocks skipped by an intersection or by block-max pruning are never
+// decoded.  A format-1 list is decoded up front and treated as one block.
+// Opened with `impacts` on a format-4 list, the cursor decodes the
+// quantized impacts instead of the tfs.
+class PostingCursor {
+public:
+    bool open(uint32_t format, const MappedFile& postings, const TermInfo& term, bool impacts = false) {
+        count_ = term.count;
+        impacts_ = impacts && format >= kPostingsFormatImpact;
+        consumed_ = 0;
+        pos_ = 0;
+        if (format < kPostingsFormatBlocked) {
+            blocked_ = false;
+            if (!decode_postings(format, postings.data(), postings.size(), term.offset, term.count, doc_ids_, tfs_)) {
+                return false;
+            }
+            block_n_ = count_;
+            header_.max_doc_id = doc_ids_.empty() ? 0 : doc_ids_.back();
+            header_.max_tf = doc_ids_.empty() ? 0 : *std::max_element(tfs_.begin(), tfs_.end());
+            header_.max_weight = -1.0f;
+            decoded_ = true;
+            exhausted_ = (count_ == 0);
+            blocks_decoded_ = 1;
+            postings_decoded_ = count_;
+            return true;
+        }
+
+        blocked_ = true;
+        format_ = format;
+        if (term.offset > postings.size()) return false;
+        p_ = postings.data() + term.offset;
+        end_ = postings.data() + postings.size();
+        base_ = 0;
+        doc_ids_.resize(kPostingBlock);
+        tfs_.resize(kPostingBlock);
+        exhausted_ = (count_ == 0);
+        return exhausted_ || load_header();
+    }
+
+    // The union of several terms' postings (a pattern's expansions): each
+    // list is walked through the block codec and merged up front into one
+    // decoded list, tfs of a doc summed, then served like a format-1 list
+    bool open_union(uint32_t format, const MappedFile& postings, const std::vector<TermInfo>& terms) {
+        std::vector<PostingCursor> parts(terms.size());
+        using Head = std::pair<uint32_t, size_t>;   // (doc id, part)
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+        for (size_t i = 0; i < terms.size(); ++i) {
+            if (!parts[i].open(format, postings, terms[i])) return false;
+            const uint32_t doc = parts[i].next_geq(0);
+            if (doc != kNoDoc) heads.push({doc, i});
+        }
+        doc_ids_.clear();
+        tfs_.clear();
+        while (!heads.empty()) {
+            const auto [doc, i] = heads.top();
+            heads.pop();
+            if (!doc_ids_.empty() && doc_ids_.back() == doc) {
+                tfs_.back() += parts[i].tf();
+            } else {
+                doc_ids_.push_back(doc);
+                tfs_.push_back(parts[i].tf());
+            }
+            const uint32_t next = parts[i].next_geq(doc + 1);
+            if (next != kNoDoc) heads.push({next, i});
+        }
+        blocks_decoded_ = postings_decoded_ = bytes_read_ = 0;
+        for (const auto& part : parts) {
+            if (!part.ok()) return false;
+            blocks_decoded_ += part.blocks_decoded_;
+            postings_decoded_ += part.postings_decoded_;
+            bytes_read_ += part.bytes_read_;
+        }
+
+        blocked_ = false;
+        impacts_ = false;
+        count_ = static_cast<uint32_t>(doc_ids_.size());
+        consumed_ = 0;
+        pos_ = 0;
+        block_n_ = count_;
+        header_.max_doc_id = doc_ids_.empty() ? 0 : doc_ids_.back();
+        header_.max_tf = tfs_.empty() ? 0 : *std::max_element(tfs_.begin(), tfs_.end());
+        header_.max_weight = -1.0f;
+        decoded_ = true;
+        exhausted_ = (count_ == 0);
+        return true;
+    }
+
+    uint32_t count() const { return count_; }
+    bool ok() const { return ok_; }
+    void add_stats(QueryStats& stats) const {
+        stats.blocks_decoded += blocks_decoded_;
+        stats.postings_decoded += postings_decoded_;
+        stats.postings_bytes += bytes_read_;
+    }
+
+    // Largest doc id and tf of the current block, and its largest
+    // bm25_tf_weight() (negative unless the index stores it)
+    uint32_t block_max_doc() const { return header_.max_doc_id; }
+    uint32_t block_max_tf() const { return header_.max_tf; }
+    double block_max_weight() const { return header_.max_weight; }
+
+    // Move to the block that may hold `target` without decoding anything;
+    // false once the list ends before target
+    bool seek_block(uint32_t target) {
+        while (!exhausted_ && header_.max_doc_id < target) next_block();
+        return !exhausted_;
+    }
+
+    // First posting with doc id >= target, or kNoDoc
+    uint32_t next_geq(uint32_t target) {
+        if (!seek_block(target)) return kNoDoc;
+        if (!decoded_) {
+            const bool decoded =
+                impacts_ ? decode_posting_block_impacts(p_, end_, header_, block_n_, base_, doc_ids_.data(), tfs_.data())
+                         : decode_posting_block(p_, end_, header_, block_n_, base_, doc_ids_.data(), tfs_.data());
+            if (!decoded) {
+                fail();
+                return kNoDoc;
+            }
+            ++blocks_decoded_;
+            postings_decoded_ += block_n_;
+            bytes_read_ += header_.doc_bytes + (impacts_ ? header_.impact_bytes : header_.tf_bytes);
+            decoded_ = true;
+            pos_ = 0;
+        }
+        // Gallop from the current position; the block's last id is >= target
+        size_t lo = pos_;
+        size_t step = 1;
+        while (lo + step < block_n_ && doc_ids_[lo + step] < target) {
+            lo += step;
+            step *= 2;
+        }
+        const size_t hi = std::min(lo + step, block_n_ - 1) + 1;
+        pos_ = static_cast<size_t>(std::lower_bound(doc_ids_.begin() + lo, doc_ids_.begin() + hi, target) -
+                                   doc_ids_.begin());
+        return doc_ids_[pos_];
+    }
+
+    // The current posting's tf, or its impact when opened for impacts
+    uint32_t tf() const { return tfs_[pos_]; }
+    bool impacts() const { return impacts_; }
+
+private:
+    void next_block() {
+        consumed_ += block_n_;
+        if (!blocked_ || consumed_ >= count_) {
+            exhausted_ = true;
+            return;
+        }
+        p_ += posting_block_size(header_);
+        base_ = header_.max_doc_id;
+        load_header();
+    }
+
+    bool load_header() {
+        block_n_ = std::min<size_t>(kPostingBlock, count_ - consumed_);
+        decoded_ = false;
+        pos_ = 0;
+        if (!read_posting_block_header(p_, end_, format_, header_)) {
+            fail();
+            return false;
+        }
+        bytes_read_ += header_.header_size;
+        return true;
+    }
+
+    void fail() {
+        ok_ = false;
+        exhausted_ = true;
+    }
+
+    bool blocked_ = false;
+    bool impacts_ = false;
+    uint32_t format_ = kPostingsFormatVarint;
+    const uint8_t* p_ = nullptr;     // Current block header
+    const uint8_t* end_ = nullptr;
+    PostingBlockHeader header_{};
+    uint32_t base_ = 0;              // Previous block's max_doc_id
+    uint32_t count_ = 0;
+    uint32_t consumed_ = 0;          // Postings before the current block
+    size_t block_n_ = 0;
+    size_t pos_ = 0;
+    bool decoded_ = false;
+    bool exhausted_ = true;
+    bool ok_ = true;
+    std::vector<uint32_t> doc_ids_;  // Current block (whole list for format 1)
+    std::vector<uint32_t> tfs_;      // Or impacts
+    uint64_t blocks_decoded_ = 0;
+    uint64_t postings_decoded_ = 0;
+    uint64_t bytes_read_ = 0;
+};
+
+// One segment's mapped files, statistics and tombstones
+struct Segment {
+    IndexMeta meta;
+    Lexicon lexicon;
+    MappedFile postings;
+    DocStore docs;
+    MappedFile tombstones;        // Empty when nothing is deleted
+    size_t deleted = 0;
+    double deleted_tokens = 0.0;
+
+    bool is_deleted(uint32_t doc_id) const {
+        return is_tombstoned(tombstones.data(), tombstones.size(), doc_id);
+    }
+
+    // Tokens in live docs
+    double live_tokens() const {
+        const double total = meta.total_tokens >= 0.0 ? meta.total_tokens
+                                                      : meta.avg_doc_len * static_cast<double>(docs.count());
+        return total - deleted_tokens;
+    }
+};
+
+// Every segment of an index directory, opened read-only.  Nothing is
+// modified after open_index(), so one index serves concurrent queries.
+struct SearchIndex {
+    std::vector<std::unique_ptr<Segment>> segments;
+    uint64_t generation = 0;
+};
+
+bool open_index(const std::filesystem::path& dir, SearchIndex& index, std::string& error);
+
+// Sorted, deduplicated terms of a query (empty if it has none).  Terms
+// split like the tokenizer's, except that '*' (any run of characters) and
+// '?' (one character) stay in a term and make it a pattern.
+std::vector<std::string> query_terms(const std::string& query);
+
+// A pattern matches at most this many terms per segment: those with the
+// most postings
+constexpr size_t kMaxPatternTerms = 256;
+
+bool is_pattern(std::string_view term);
+bool pattern_matches(std::string_view pattern, std::string_view term);
+
+// Evaluate an AND query in "keyword" or "full" mode; a pattern term
+// matches the union of its expansions' postings, whose length is its
+// document frequency.  On success returns
+// true with the searcher's output text (id/path or score/id/path rows, or
+// "No results.") in `out`; otherwise false with the reason in `error`.
+// `stats`, when given, accumulates the postings work done.
+bool run_query(const SearchIndex& index, const std::vector<std::string>& terms, const std::string& mode,
+               size_t limit, std::string& out, std::string& error, QueryStats* stats = nullptr);
@@ -0,0 +1,341 @@
+#include "search_server.h"
+
+#include "search_index.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using socket_t = SOCKET;
+constexpr socket_t kBadSocket = INVALID_SOCKET;
+inline void close_socket(socket_t s) { closesocket(s); }
+#else
+#include <arpa/inet.h>
+#include <csignal>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using socket_t = int;
+constexpr socket_t kBadSocket = -1;
+inline void close_socket(socket_t s) { ::close(s); }
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t kMaxRequestBytes = 16 * 1024;
+
+// Query text by key, least recently used evicted first
+class QueryCache {
+public:
+    explicit QueryCache(size_t capacity) : capacity_(capacity) {}
+
+    bool get(const std::string& key, std::string& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(key);
+        if (it == map_.end()) return false;
+        order_.splice(order_.begin(), order_, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    void put(const std::string& key, const std::string& value) {
+        if (capacity_ == 0) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(key);
+        if (it != map_.end()) {
+            it->second->second = value;
+            order_.splice(order_.begin(), order_, it->second);
+            return;
+        }
+        order_.emplace_front(key, value);
+        map_[key] = order_.begin();
+        if (order_.size() > capacity_) {
+            map_.erase(order_.back().first);
+            order_.pop_back();
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.clear();
+        order_.clear();
+    }
+
+private:
+    using Entry = std::pair<std::string, std::string>;
+    size_t capacity_;
+    std::mutex mutex_;
+    std::list<Entry> order_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> map_;
+};
+
+// The open index, reopened when the generation file moves.  Requests hold
+// a shared_ptr, so a reopen never unmaps files a query is still reading.
+class IndexHolder {
+public:
+    IndexHolder(fs::path dir, QueryCache& cache) : dir_(std::move(dir)), cache_(cache) {}
+
+    std::shared_ptr<const SearchIndex> current(std::string& error) {
+        const uint64_t generation = read_generation(dir_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (index_ && index_->generation == generation) return index_;
+        auto fresh = std::make_shared<SearchIndex>();
+        if (!open_index(dir_, *fresh, error)) {
+            // Keep serving the last good index while the new one is unreadable
+            if (index_) return index_;
+            return nullptr;
+        }
+        index_ = std::move(fresh);
+        cache_.clear();
+        return index_;
+    }
+
+private:
+    fs::path dir_;
+    QueryCache& cache_;
+    std::mutex mutex_;
+    std::shared_ptr<const SearchIndex> index_;
+};
+
+class SocketQueue {
+public:
+    void push(socket_t s) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sockets_.push_back(s);
+        }
+        ready_.notify_one();
+    }
+
+    socket_t pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [&] { return !sockets_.empty(); });
+        socket_t s = sockets_.front();
+        sockets_.pop_front();
+        return s;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<socket_t> sockets_;
+};
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string url_decode(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '+') {
+            out += ' ';
+        } else if (s[i] == '%' && i + 2 < s.size() && hex_value(s[i + 1]) >= 0 && hex_value(s[i + 2]) >= 0) {
+            out += static_cast<char>(hex_value(s[i + 1]) * 16 + hex_value(s[i + 2]));
+            i += 2;
+        } else {
+            out += s[i];
+        }
+    }
+    return out;
+}
+
+std::unordered_map<std::string, std::string> parse_params(const std::string& query_string) {
+    std::unordered_map<std::string, std::string> params;
+    size_t start = 0;
+    while (start <= query_string.size()) {
+        size_t end = query_string.find('&', start);
+        if (end == std::string::npos) end = query_string.size();
+        const std::string pair = query_string.substr(start, end - start);
+        const size_t eq = pair.find('=');
+        if (!pair.empty()) {
+            params[url_decode(pair.substr(0, eq))] = eq == std::string::npos ? "" : url_decode(pair.substr(eq + 1));
+        }
+        start = end + 1;
+    }
+    return params;
+}
+
+struct Response {
+    int status = 200;
+    std::string body;
+};
+
+const char* status_text(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        default: return "Internal Server Error";
+    }
+}
+
+class Server {
+public:
+    explicit Server(const ServerOptions& options)
+        : cache_(options.cache_entries), index_(options.index_dir, cache_) {}
+
+    bool warm_up(std::string& error) { return index_.current(error) != nullptr; }
+
+    Response handle(const std::string& method, const std::string& target) {
+        if (method != "GET") return {405, "Only GET is supported.\n"};
+        const size_t qmark = target.find('?');
+        const std::string path = target.substr(0, qmark);
+        const auto params = parse_params(qmark == std::string::npos ? "" : target.substr(qmark + 1));
+
+        std::string error;
+        auto index = index_.current(error);
+        if (!index) return {500, error + "\n"};
+
+        if (path == "/health") return {200, "ok " + std::to_string(index->generation) + "\n"};
+        if (path != "/search") return {404, "Unknown path: " + path + "\n"};
+
+        auto param = [&](const char* name, const char* fallback) {
+            auto it = params.find(name);
+            return it == params.end() ? std::string(fallback) : it->second;
+        };
+        const std::string query = param("q", "");
+        const std::string mode = param("mode", "keyword");
+        size_t limit = 0;
+        try {
+            limit = static_cast<size_t>(std::stoull(param("limit", "10")));
+        } catch (const std::exception&) {
+            return {400, "Bad limit.\n"};
+        }
+        if (query.empty()) return {400, "Query is empty.\n"};
+
+        // Queries with the same term set share an entry, whatever their order
+        const std::vector<std::string> terms = query_terms(query);
+        std::string key = std::to_string(index->generation) + '\n' + mode + '\n' + std::to_string(limit);
+        for (const auto& term : terms) {
+            key += '\n';
+            key += term;
+        }
+        Response response;
+        if (cache_.get(key, response.body)) return response;
+        if (!run_query(*index, terms, mode, limit, response.body, error)) {
+            const bool bad_query = terms.empty() || (mode != "keyword" && mode != "full");
+            return {bad_query ? 400 : 500, error + "\n"};
+        }
+        cache_.put(key, response.body);
+        return response;
+    }
+
+    void serve(socket_t client) {
+        std::string request;
+        char buf[4096];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequestBytes) {
+            const auto got = recv(client, buf, sizeof(buf), 0);
+            if (got <= 0) break;
+            request.append(buf, static_cast<size_t>(got));
+        }
+
+        Response response;
+        const size_t line_end = request.find("\r\n");
+        const size_t sp1 = request.find(' ');
+        const size_t sp2 = sp1 == std::string::npos ? sp1 : request.find(' ', sp1 + 1);
+        if (line_end == std::string::npos || sp2 == std::string::npos || sp2 > line_end) {
+            response = {400, "Malformed request.\n"};
+        } else {
+            response = handle(request.substr(0, sp1), request.substr(sp1 + 1, sp2 - sp1 - 1));
+        }
+
+        std::string out = "HTTP/1.1 " + std::to_string(response.status) + " " + status_text(response.status) +
+                          "\r\nContent-Type: text/plain; charset=utf-8\r\nContent-Length: " +
+                          std::to_string(response.body.size()) + "\r\nConnection: close\r\n\r\n" + response.body;
+        size_t sent = 0;
+        while (sent < out.size()) {
+            const auto n = send(client, out.data() + sent, static_cast<int>(out.size() - sent), 0);
+            if (n <= 0) break;
+            sent += static_cast<size_t>(n);
+        }
+        close_socket(client);
+    }
+
+private:
+    QueryCache cache_;
+    IndexHolder index_;
+};
+
+}  // namespace
+
+int run_server(const ServerOptions& options) {
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        std::cerr << "WSAStartup failed.\n";
+        return 1;
+    }
+#else
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    Server server(options);
+    std::string error;
+    if (!server.warm_up(error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    socket_t listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == kBadSocket) {
+        std::cerr << "Failed to create socket.\n";
+        return 1;
+    }
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(options.port));
+    if (inet_pton(AF_INET, options.host.c_str(), &addr.sin_addr) != 1) {
+        std::cerr << "Bad listen address: " << options.host << "\n";
+        close_socket(listener);
+        return 1;
+    }
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listener, 128) != 0) {
+        std::cerr << "Failed to listen on " << options.host << ":" << options.port << "\n";
+        close_socket(listener);
+        return 1;
+    }
+
+    size_t threads = options.threads ? options.threads : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    SocketQueue queue;
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&] {
+            for (;;) server.serve(queue.pop());
+        });
+    }
+    std::cerr << "Serving " << options.index_dir << " on " << options.host << ":" << options.port << " with "
+              << threads << " threads\n";
+
+    for (;;) {
+        socket_t client = accept(listener, nullptr, nullptr);
+        if (client == kBadSocket) continue;
+        queue.push(client);
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// `ssot_searcher --serve`: a localhost HTTP daemon that keeps the index
+// mapped between queries.
+//   GET /search?q=...&mode=keyword|full&limit=N
+//       200 text/plain, the same lines the CLI prints; 400 on a bad query
+//   GET /health
+//       200 "ok <generation>"
+// Results are cached (LRU) per index generation; when the indexer bumps
+// the generation file the index is reopened and the cache dropped.
+struct ServerOptions {
+    std::string index_dir;
+    std::string host = "127.0.0.1";
+    int port = 8765;
+    size_t threads = 0;            // 0 = hardware concurrency
+    size_t cache_entries = 1024;   // 0 disables the cache
+};
+
+int run_server(const ServerOptions& options);
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "postings_codec.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// An index directory holds one or more segments, each a full set of index
+// files.  The "segments" manifest lists their subdirectory names in doc
+// order, one per line; without it the directory itself is the only
+// segment ("."), which is what a full build writes.  A segment's
+// deleted.bin, when present, is a bitmap of tombstoned docs (bit d % 8 of
+// byte d / 8).
+constexpr const char* kSegmentsFile = "segments";
+constexpr const char* kTombstoneFile = "deleted.bin";
+constexpr const char* kDocHashFile = "docstore_hash.bin";
+
+inline std::vector<std::string> read_segment_list(const std::filesystem::path& index_dir) {
+    std::vector<std::string> segments;
+    std::ifstream in(index_dir / kSegmentsFile);
+    if (!in) {
+        segments.push_back(".");
+        return segments;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) segments.push_back(line);
+    }
+    return segments;
+}
+
+// Replace a file through a temporary and a rename, so readers see either
+// the old or the new contents
+inline bool replace_file(const std::filesystem::path& path, const void* data, size_t size) {
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!out) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+inline bool write_segment_list(const std::filesystem::path& index_dir, const std::vector<std::string>& segments) {
+    std::string text;
+    for (const auto& name : segments) {
+        text += name;
+        text += '\n';
+    }
+    return replace_file(index_dir / kSegmentsFile, text.data(), text.size());
+}
+
+// The "generation" file holds a counter the indexer bumps on every change;
+// a long-running searcher reopens the index when it moves.  0 when absent.
+constexpr const char* kGenerationFile = "generation";
+
+inline uint64_t read_generation(const std::filesystem::path& index_dir) {
+    uint64_t generation = 0;
+    std::ifstream in(index_dir / kGenerationFile);
+    in >> generation;
+    return in ? generation : 0;
+}
+
+inline bool bump_generation(const std::filesystem::path& index_dir) {
+    const std::string text = std::to_string(read_generation(index_dir) + 1) + "\n";
+    return replace_file(index_dir / kGenerationFile, text.data(), text.size());
+}
+
+inline bool is_tombstoned(const uint8_t* bits, size_t size, uint32_t doc_id) {
+    return size_t(doc_id / 8) < size && ((bits[doc_id / 8] >> (doc_id % 8)) & 1) != 0;
+}
+
+// FNV-1a over path and content; an update re-indexes a doc when it changes
+inline uint64_t doc_hash(std::string_view path, std::string_view content) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&](std::string_view s) {
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 0x100000001b3ull;
+        }
+    };
+    mix(path);
+    h ^= 0xff;   // Separator so ("ab", "c") and ("a", "bc") differ
+    h *= 0x100000001b3ull;
+    mix(content);
+    return h;
+}
+
+struct IndexMeta {
+    uint64_t doc_count = 0;
+    double avg_doc_len = 0.0;
+    double total_tokens = -1.0;   // Negative when the index predates it
+    uint32_t postings_format = kPostingsFormatVarint;
+    std::string source_db;
+};
+
+// index_meta.json is written one key per line by the indexer
+inline IndexMeta read_index_meta(const std::filesystem::path& path) {
+    IndexMeta meta;
+    std::ifstream meta_in(path);
+    std::string line;
+    while (std::getline(meta_in, line)) {
+        auto pos = line.find(':');
+        if (pos == std::string::npos) continue;
+        if (line.find("\"doc_count\"") != std::string::npos) {
+            meta.doc_count = std::stoull(line.substr(pos + 1));
+        } else if (line.find("\"avg_doc_len\"") != std::string::npos) {
+            meta.avg_doc_len = std::stod(line.substr(pos + 1));
+        } else if (line.find("\"total_tokens\"") != std::string::npos) {
+            meta.total_tokens = std::stod(line.substr(pos + 1));
+        } else if (line.find("\"postings_format\"") != std::string::npos) {
+            meta.postings_format = static_cast<uint32_t>(std::stoul(line.substr(pos + 1)));
+        } else if (line.find("\"source_db\"") != std::string::npos) {
+            auto open = line.find('"', pos);
+            auto close = line.rfind('"');
+            if (open != std::string::npos && close > open) {
+                meta.source_db = line.substr(open + 1, close - open - 1);
+            }
+        }
+    }
+    return meta;
+}
@@ -1,87 +1,200 @@
 #include "tokenizer.h"
 
-#include <array>
-#include <vector>
+#include <cstring>
 
-#if defined(__AVX2__)
+#if defined(__AVX2__) || defined(__AVX512BW__)
 #include <immintrin.h>
 #endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace {
 
-std::array<uint8_t, 256> build_token_table() {
-    std::array<uint8_t, 256> table{};
-    for (int c = 0; c < 256; ++c) {
-        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
-            table[static_cast<size_t>(c)] = 1;
+// Lowercase letters and digits all have bit 0x20 set ('0'-'9' are
+// 0x30-0x39), so OR-ing 0x20 lowercases any token byte
+constexpr uint64_t kLowerMask = 0x2020202020202020ULL;
+
+inline unsigned count_trailing_zeros(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+// Bit i set when p[i] is a token byte, for the 64 bytes at p
+inline uint64_t token_mask64(const unsigned char* p) {
+#if defined(__AVX512BW__)
+    const __m512i v = _mm512_loadu_si512(p);
+    const __m512i lower = _mm512_or_si512(v, _mm512_set1_epi8(0x20));
+    const __mmask64 alpha = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(lower, _mm512_set1_epi8('a')),
+                                                   _mm512_set1_epi8(26));
+    const __mmask64 digit = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(v, _mm512_set1_epi8('0')),
+                                                   _mm512_set1_epi8(10));
+    return static_cast<uint64_t>(alpha | digit);
+#elif defined(__AVX2__)
+    // Unsigned x < n as min(x, n - 1) == x
+    const __m256i bit5 = _mm256_set1_epi8(0x20);
+    const __m256i a = _mm256_set1_epi8('a');
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i last_alpha = _mm256_set1_epi8(25);
+    const __m256i last_digit = _mm256_set1_epi8(9);
+    uint64_t mask = 0;
+    for (int half = 0; half < 2; ++half) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * half));
+        const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(v, bit5), a);
+        const __m256i digit = _mm256_sub_epi8(v, zero);
+        const __m256i is_token = _mm256_or_si256(
+            _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, last_alpha), alpha),
+            _mm256_cmpeq_epi8(_mm256_min_epu8(digit, last_digit), digit));
+        mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(is_token))) << (32 * half);
+    }
+    return mask;
+#else
+    uint64_t mask = 0;
+    for (unsigned i = 0; i < 64; ++i) {
+        const unsigned char lower = static_cast<unsigned char>(p[i] | 0x20);
+        const bool is_token = (lower >= 'a' && lower <= 'z') || (p[i] >= '0' && p[i] <= '9');
+        mask |= static_cast<uint64_t>(is_token) << i;
+    }
+    return mask;
+#endif
+}
+
+// Calls emit(offset, length) for every term of data[0..n), in order.
+// Each 64-byte block becomes a token-byte mask; its set bits XOR the mask
+// shifted by one are the term boundaries, taken lowest first.
+template <typename Emit>
+void scan_terms(const char* data, size_t n, Emit&& emit) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    bool in_term = false;
+    size_t start = 0;
+    for (size_t base = 0; base < n; base += 64) {
+        uint64_t mask;
+        if (n - base >= 64) {
+            mask = token_mask64(bytes + base);
+        } else {
+            // Tail: zero padding ends a term running to the last byte
+            alignas(64) unsigned char tail[64] = {};
+            std::memcpy(tail, bytes + base, n - base);
+            mask = token_mask64(tail);
+        }
+        uint64_t edges = mask ^ ((mask << 1) | (in_term ? 1u : 0u));
+        while (edges) {
+            const size_t pos = base + count_trailing_zeros(edges);
+            edges &= edges - 1;
+            if (in_term) {
+                emit(start, pos - start);
+            } else {
+                start = pos;
+            }
+            in_term = !in_term;
         }
     }
-    return table;
+    if (in_term) {
+        emit(start, n - start);
+    }
+}
+
+inline uint64_t load_word(const char* p, size_t len) {
+    uint64_t word = 0;
+    std::memcpy(&word, p, len < 8 ? len : 8);
+    return word;
 }
 
-const std::array<uint8_t, 256> kTokenTable = build_token_table();
-
-void lowercase_ascii_inplace(std::string& s) {
-    size_t i = 0;
-#if defined(__AVX2__)
-    const __m256i A1 = _mm256_set1_epi8(static_cast<char>('A' - 1));
-    const __m256i Z1 = _mm256_set1_epi8(static_cast<char>('Z' + 1));
-    const __m256i diff = _mm256_set1_epi8(32);
-    for (; i + 32 <= s.size(); i += 32) {
-        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.data() + i));
-        __m256i geA = _mm256_cmpgt_epi8(v, A1);
-        __m256i leZ = _mm256_cmpgt_epi8(Z1, v);
-        __m256i mask = _mm256_and_si256(geA, leZ);
-        __m256i add = _mm256_and_si256(mask, diff);
-        v = _mm256_add_epi8(v, add);
-        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.data() + i), v);
+// Hash of the lowercased term, read 8 bytes at a time
+inline uint64_t hash_term(const char* p, size_t len) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ len;
+    for (size_t i = 0; i < len; i += 8) {
+        h = (h ^ (load_word(p + i, len - i) | kLowerMask)) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
     }
-#endif
-    for (; i < s.size(); ++i) {
-        char c = s[i];
-        if (c >= 'A' && c <= 'Z') {
-            s[i] = static_cast<char>(c + 32);
+    return h ^ (h >> 29);
+}
+
+// Whether p[0..len) lowercases to the stored (lowercase) term
+inline bool term_equals(const char* p, const char* stored, size_t len) {
+    for (size_t i = 0; i < len; i += 8) {
+        if ((load_word(p + i, len - i) | kLowerMask) != (load_word(stored + i, len - i) | kLowerMask)) {
+            return false;
         }
     }
+    return true;
 }
 
-void split_terms(const std::string& text, std::vector<std::string>& out_terms) {
-    std::string buffer = text;
-    lowercase_ascii_inplace(buffer);
+}  // namespace
 
-    const unsigned char* data = reinterpret_cast<const unsigned char*>(buffer.data());
-    size_t n = buffer.size();
-    size_t i = 0;
-    while (i < n) {
-        while (i < n && !kTokenTable[data[i]]) {
-            ++i;
+uint32_t TermTable::intern(const char* token, size_t len) {
+    if (2 * (entries_.size() + 1) > slots_.size()) {
+        grow();
+    }
+    const uint64_t hash = hash_term(token, len);
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+        const uint32_t stored = slots_[slot];
+        if (stored == 0) {
+            const uint32_t id = static_cast<uint32_t>(entries_.size());
+            entries_.push_back(Entry{hash, static_cast<uint32_t>(bytes_.size()), static_cast<uint32_t>(len),
+                                     static_cast<uint32_t>(slot)});
+            values_.push_back(0);
+            for (size_t i = 0; i < len; ++i) {
+                bytes_.push_back(static_cast<char>(token[i] | 0x20));
+            }
+            slots_[slot] = id + 1;
+            return id;
         }
-        size_t start = i;
-        while (i < n && kTokenTable[data[i]]) {
-            ++i;
+        const Entry& entry = entries_[stored - 1];
+        if (entry.hash == hash && entry.len == len && term_equals(token, bytes_.data() + entry.offset, len)) {
+            return stored - 1;
         }
-        if (i > start) {
-            out_terms.emplace_back(buffer.substr(start, i - start));
+    }
+}
+
+void TermTable::grow() {
+    slots_.assign(slots_.empty() ? 64 : slots_.size() * 2, 0);
+    const size_t mask = slots_.size() - 1;
+    for (uint32_t id = 0; id < entries_.size(); ++id) {
+        size_t slot = static_cast<size_t>(entries_[id].hash) & mask;
+        while (slots_[slot] != 0) {
+            slot = (slot + 1) & mask;
         }
+        slots_[slot] = id + 1;
+        entries_[id].slot = static_cast<uint32_t>(slot);
     }
 }
 
-}  // namespace
+void TermTable::clear() {
+    for (const Entry& entry : entries_) {
+        slots_[entry.slot] = 0;
+    }
+    entries_.clear();
+    values_.clear();
+    bytes_.clear();
+}
 
-void tokenize_to_counts(const std::string& text,
-                        std::unordered_map<std::string, uint32_t>& counts,
+void tokenize_to_counts(std::string_view text,
+                        TermTable& counts,
                         uint32_t& token_count) {
-    std::vector<std::string> terms;
-    terms.reserve(64);
-    split_terms(text, terms);
-    token_count = static_cast<uint32_t>(terms.size());
-    for (const auto& term : terms) {
-        ++counts[term];
-    }
+    const char* data = text.data();
+    uint32_t tokens = 0;
+    scan_terms(data, text.size(), [&](size_t offset, size_t len) {
+        ++counts.value(counts.intern(data + offset, len));
+        ++tokens;
+    });
+    token_count = tokens;
 }
 
 void tokenize_to_terms(const std::string& text,
                        std::vector<std::string>& terms) {
     terms.clear();
-    split_terms(text, terms);
+    scan_terms(text.data(), text.size(), [&](size_t offset, size_t len) {
+        std::string term(text, offset, len);
+        for (char& c : term) {
+            c = static_cast<char>(c | 0x20);
+        }
+        terms.push_back(std::move(term));
+    });
 }
@@ -1,12 +1,54 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
-void tokenize_to_counts(const std::string& text,
-                        std::unordered_map<std::string, uint32_t>& counts,
+// Terms are maximal runs of ASCII letters and digits, lowercased; every
+// other byte (including non-ASCII) separates them.
+
+// Open-addressing table of lowercased terms.  Ids are dense, in insertion
+// order, and each carries a uint32_t value (a count, for tokenize_to_counts).
+// clear() forgets the terms but keeps every allocation, so a table reused
+// across documents stops allocating once it has seen the largest one.
+class TermTable {
+public:
+    // Id of the term token[0..len) (any case; lowercased here), added with
+    // value 0 if new
+    uint32_t intern(const char* token, size_t len);
+
+    uint32_t& value(uint32_t id) { return values_[id]; }
+    uint32_t value(uint32_t id) const { return values_[id]; }
+    // Lowercased; valid until the next intern()
+    std::string_view term(uint32_t id) const {
+        return std::string_view(bytes_.data() + entries_[id].offset, entries_[id].len);
+    }
+    size_t size() const { return entries_.size(); }
+
+    void clear();
+
+private:
+    struct Entry {
+        uint64_t hash;
+        uint32_t offset;   // Into bytes_
+        uint32_t len;
+        uint32_t slot;     // Its index in slots_
+    };
+
+    void grow();
+
+    std::vector<uint32_t> slots_;   // Id + 1, 0 = empty; power-of-two size
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> values_;
+    std::string bytes_;
+};
+
+// Adds each term's occurrences to `counts` (not cleared first);
+// token_count is the number of terms in `text`
+void tokenize_to_counts(std::string_view text,
+                        TermTable& counts,
                         uint32_t& token_count);
 
 void tokenize_to_terms(const std::string& text,
@@ -0,0 +1,287 @@
+import argparse
+import hashlib
+import json
+import os
+import platform
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Tuple
+
+ROOT = Path(__file__).resolve().parents[1]
+BASELINES_DIR = ROOT / "validation" / "perf_baselines"
+THRESHOLDS_PATH = ROOT / "validation" / "perf_thresholds.json"
+ARTIFACTS_DIR = ROOT / "artifacts" / "validation"
+DEFAULT_BENCHMARKS = ROOT / "Simulation" / "build" / "dase_benchmarks"
+PROBLEM_ID = "perf_regression"
+RUNNER = "validation/run_perf_regression.py"
+
+
+def utc_now() -> str:
+    return datetime.now(timezone.utc).isoformat()
+
+
+def load_json(path: Path) -> Dict[str, Any]:
+    with path.open("r", encoding="utf-8") as f:
+        return json.load(f)
+
+
+def write_json(path: Path, data: Dict[str, Any]) -> None:
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with path.open("w", encoding="utf-8") as f:
+        json.dump(data, f, indent=2)
+
+
+def cpu_model() -> str:
+    cpuinfo = Path("/proc/cpuinfo")
+    if cpuinfo.exists():
+        for line in cpuinfo.read_text(encoding="utf-8", errors="replace").splitlines():
+            if line.startswith("model name"):
+                return line.split(":", 1)[1].strip()
+    return platform.processor() or platform.machine()
+
+
+def hardware_fingerprint(context: Dict[str, Any]) -> Dict[str, Any]:
+    """Machine identity for baselines: CPU, core count, caches, OS and thread setting.
+    Baselines only compare against runs with the same fingerprint id."""
+    caches = [
+        {"type": c.get("type"), "level": c.get("level"), "size": c.get("size")}
+        for c in context.get("caches", [])
+    ]
+    identity = {
+        "cpu_model": cpu_model(),
+        "num_cpus": context.get("num_cpus", os.cpu_count()),
+        "caches": caches,
+        "machine": platform.machine(),
+        "system": platform.system(),
+        "omp_num_threads": os.environ.get("OMP_NUM_THREADS", ""),
+    }
+    digest = hashlib.sha256(json.dumps(identity, sort_keys=True).encode("utf-8")).hexdigest()[:16]
+    identity["id"] = digest
+    identity["hostname"] = platform.node()
+    identity["mhz_per_cpu"] = context.get("mhz_per_cpu")
+    return identity
+
+
+def to_ns(value: float, unit: str) -> float:
+    scale = {"ns": 1.0, "us": 1.0e3, "ms": 1.0e6, "s": 1.0e9}
+    return value * scale.get(unit, 1.0)
+
+
+def list_benchmarks(binary: Path, pattern: str) -> List[str]:
+    out = subprocess.run(
+        [str(binary), "--benchmark_list_tests=true", f"--benchmark_filter={pattern}"],
+        check=True, capture_output=True, text=True,
+    )
+    return [line.strip() for line in out.stdout.splitlines() if line.strip()]
+
+
+def run_one(binary: Path, name: str, repetitions: int, min_time: Optional[float]) -> Tuple[Dict[str, Any], int]:
+    """Run one benchmark in its own process; return the Google Benchmark JSON and peak RSS (KiB)."""
+    with tempfile.TemporaryDirectory() as tmp:
+        out_path = Path(tmp) / "result.json"
+        cmd = [
+            str(binary),
+            f"--benchmark_filter=^{re.escape(name)}$",
+            f"--benchmark_repetitions={repetitions}",
+            "--benchmark_report_aggregates_only=false",
+            f"--benchmark_out={out_path}",
+            "--benchmark_out_format=json",
+        ]
+        if min_time is not None:
+            cmd.append(f"--benchmark_min_time={min_time}")
+        proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+        peak_rss_kib = -1
+        if hasattr(os, "wait4"):
+            _, status, usage = os.wait4(proc.pid, 0)
+            proc.returncode = os.waitstatus_to_exitcode(status)
+            peak_rss_kib = int(usage.ru_maxrss // 1024) if sys.platform == "darwin" else int(usage.ru_maxrss)
+            stderr = proc.stderr.read().decode("utf-8", errors="replace") if proc.stderr else ""
+        else:
+            _, stderr_bytes = proc.communicate()
+            stderr = stderr_bytes.decode("utf-8", errors="replace")
+        if proc.returncode != 0:
+            raise RuntimeError(f"{name} failed (exit {proc.returncode}): {stderr.strip()[-400:]}")
+        return load_json(out_path), peak_rss_kib
+
+
+def summarize(name: str, data: Dict[str, Any], peak_rss_kib: int) -> Dict[str, Any]:
+    """Median and spread of the repetitions of one benchmark."""
+    runs = [b for b in data.get("benchmarks", []) if b.get("run_type", "iteration") == "iteration"]
+    if not runs:
+        raise RuntimeError(f"{name} produced no iterations")
+    ns = [to_ns(b["real_time"], b.get("time_unit", "ns")) for b in runs]
+    items = [b["items_per_second"] for b in runs if "items_per_second" in b]
+    bytes_ = [b["bytes_per_second"] for b in runs if "bytes_per_second" in b]
+    median_ns = statistics.median(ns)
+    summary = {
+        "ns_per_op": median_ns,
+        "ns_per_op_cv": (statistics.stdev(ns) / median_ns) if len(ns) > 1 and median_ns > 0 else 0.0,
+        "repetitions": len(ns),
+        "peak_rss_kib": peak_rss_kib,
+    }
+    if items:
+        summary["items_per_second"] = statistics.median(items)
+    if bytes_:
+        summary["bytes_per_second"] = statistics.median(bytes_)
+    if runs[0].get("label"):
+        summary["label"] = runs[0]["label"]
+    return summary
+
+
+def threshold_for(name: str, thresholds: Dict[str, Any], key: str) -> float:
+    """First matching pattern in thresholds["benchmarks"] wins, else the default."""
+    default = float(thresholds.get("default", {}).get(key, 0.10))
+    for pattern, override in thresholds.get("benchmarks", {}).items():
+        if re.search(pattern, name):
+            return float(override.get(key, default))
+    return default
+
+
+def compare(name: str, base: Dict[str, Any], new: Dict[str, Any], thresholds: Dict[str, Any]) -> Dict[str, Any]:
+    time_tol = threshold_for(name, thresholds, "time")
+    rss_tol = threshold_for(name, thresholds, "peak_rss")
+    checks: Dict[str, Any] = {}
+
+    def check(metric: str, higher_is_worse: bool, tol: float) -> None:
+        if metric not in base or metric not in new or base[metric] in (0, None) or base[metric] < 0:
+            return
+        change = (new[metric] - base[metric]) / base[metric]
+        regressed = change > tol if higher_is_worse else change < -tol
+        checks[metric] = {
+            "baseline": base[metric],
+            "current": new[metric],
+            "change": change,
+            "tolerance": tol,
+            "regressed": regressed,
+        }
+
+    check("ns_per_op", True, time_tol)
+    check("items_per_second", False, time_tol)
+    check("bytes_per_second", False, time_tol)
+    check("peak_rss_kib", True, rss_tol)
+
+    # A time regression that stays inside the run's own spread (noise_sigmas
+    # coefficients of variation past the tolerance) is reported as noisy
+    # rather than failed; rerun with more repetitions to settle it
+    cv = new.get("ns_per_op_cv", 0.0)
+    margin = float(thresholds.get("noise_sigmas", 2.0)) * cv
+    regressed = [m for m, c in checks.items() if c["regressed"]]
+    clear = [m for m in regressed if m == "peak_rss_kib" or abs(checks[m]["change"]) > checks[m]["tolerance"] + margin]
+    if clear:
+        status = "regressed"
+    elif regressed:
+        status = "noisy"
+    else:
+        status = "ok"
+    return {"status": status, "cv": cv, "checks": checks}
+
+
+def measure(binary: Path, pattern: str, repetitions: int, min_time: Optional[float]) -> Tuple[Dict[str, Any], Dict[str, Any]]:
+    results: Dict[str, Any] = {}
+    context: Dict[str, Any] = {}
+    for name in list_benchmarks(binary, pattern):
+        data, rss = run_one(binary, name, repetitions, min_time)
+        context = context or data.get("context", {})
+        results[name] = summarize(name, data, rss)
+        print(f"[INFO] {name}: {results[name]['ns_per_op']:.0f} ns/op", file=sys.stderr)
+    return results, context
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Record or check DASE performance baselines.")
+    parser.add_argument("--benchmarks", type=Path, default=DEFAULT_BENCHMARKS,
+                        help="dase_benchmarks executable (BUILD_BENCHMARKS=ON)")
+    parser.add_argument("--filter", default=".", help="Benchmark name regex")
+    parser.add_argument("--repetitions", type=int, default=5, help="Trials per benchmark (median compared)")
+    parser.add_argument("--min_time", type=float, default=None, help="Seconds per trial (Google Benchmark default if omitted)")
+    parser.add_argument("--record", action="store_true", help="Store this run as the baseline for this machine")
+    parser.add_argument("--baseline", type=Path, help="Baseline file (default: perf_baselines/<fingerprint>.json)")
+    parser.add_argument("--thresholds", type=Path, default=THRESHOLDS_PATH, help="Tolerance config")
+    parser.add_argument("--label", default="", help="Build/version label stored with the run")
+    args = parser.parse_args()
+
+    if not args.benchmarks.exists():
+        print(f"[ERROR] benchmark executable not found: {args.benchmarks}", file=sys.stderr)
+        return 1
+
+    results, context = measure(args.benchmarks, args.filter, max(1, args.repetitions), args.min_time)
+    fingerprint = hardware_fingerprint(context)
+    baseline_path = args.baseline or BASELINES_DIR / f"{fingerprint['id']}.json"
+    run_config = {
+        "benchmarks": str(args.benchmarks),
+        "filter": args.filter,
+        "repetitions": args.repetitions,
+        "min_time": args.min_time,
+        "label": args.label,
+        "library_build_type": context.get("library_build_type"),
+    }
+
+    if args.record:
+        write_json(baseline_path, {
+            "recorded_utc": utc_now(),
+            "fingerprint": fingerprint,
+            "run_config": run_config,
+            "results": results,
+        })
+        print(f"[INFO] baseline written to {baseline_path}", file=sys.stderr)
+        return 0
+
+    thresholds = load_json(args.thresholds) if args.thresholds.exists() else {}
+    report: Dict[str, Any] = {
+        "problem_id": PROBLEM_ID,
+        "timestamp_utc": utc_now(),
+        "runner": RUNNER,
+        "known_invariants": ["no_performance_regression"],
+        "expected_behavior": {"thresholds": thresholds},
+        "run_config": dict(run_config, fingerprint=fingerprint, baseline=str(baseline_path)),
+    }
+
+    if not baseline_path.exists():
+        report["observations"] = {"results": results}
+        report["verdict"] = "not_run"
+        report["notes"] = "No baseline for this machine; record one with --record."
+    else:
+        baseline = load_json(baseline_path)
+        comparisons = {}
+        missing = []
+        for name, base in baseline.get("results", {}).items():
+            if not re.search(args.filter, name):
+                continue
+            if name not in results:
+                missing.append(name)
+                continue
+            comparisons[name] = compare(name, base, results[name], thresholds)
+        regressed = sorted(n for n, c in comparisons.items() if c["status"] == "regressed")
+        noisy = sorted(n for n, c in comparisons.items() if c["status"] == "noisy")
+        report["observations"] = {
+            "baseline_recorded_utc": baseline.get("recorded_utc"),
+            "compared": len(comparisons),
+            "regressed": regressed,
+            "noisy": noisy,
+            "missing": missing,
+            "comparisons": comparisons,
+        }
+        if regressed:
+            report["verdict"] = "fail"
+        elif noisy:
+            report["verdict"] = "passes_within_tolerance"
+        else:
+            report["verdict"] = "pass"
+        report["notes"] = (f"{len(regressed)} regressed, {len(noisy)} too noisy to judge, "
+                           f"{len(missing)} baseline benchmarks missing from this run.")
+
+    ARTIFACTS_DIR.mkdir(parents=True, exist_ok=True)
+    fname = f"{PROBLEM_ID}_{report['timestamp_utc'].replace(':', '').replace('-', '')}.json"
+    out_path = ARTIFACTS_DIR / fname
+    write_json(out_path, report)
+    print(f"[INFO] {report['verdict']}: {out_path}", file=sys.stderr)
+    return 1 if report["verdict"] == "fail" else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -10,20 +10,14 @@
 #include <sstream>
 #include <cmath>
 #include <optional>
+#include <algorithm>
 #include "../Simulation/src/cpp/sid_ssp/sid_capi.hpp"
 #include "json.hpp"
+#include "line_server.h"
+#include "sid_event_log.h"
 
 using json = nlohmann::json;
 
-struct Event {
-    uint64_t event_id;
-    std::string rule_id;
-    bool applied;
-    std::string message;
-    json metadata;
-    double timestamp;
-};
-
 struct WrapperState {
     double I_mass{1.0 / 3.0};
     double N_mass{1.0 / 3.0};
@@ -45,7 +39,7 @@ struct EngineEntry {
     double R_c{1.0};
     int sid_role{2};
     uint64_t ssp_steps{0};
-    std::vector<Event> events;
+    dase::SidEventLog events;   // Bounded; see sid_rewrite_log
     WrapperState wrapper;
 };
 
@@ -60,6 +54,21 @@ static bool masses_finite(double I, double N, double U) {
 
 class SidCli {
 public:
+    SidCli() = default;
+    SidCli(const SidCli&) = delete;
+    SidCli& operator=(const SidCli&) = delete;
+
+    // Engines live as long as the CLI (or server session) that made them
+    ~SidCli() {
+        for (auto& entry : engines_) {
+            if (entry.second.type == EngineEntry::Type::Ternary) {
+                sid_destroy_engine(static_cast<sid_engine*>(entry.second.handle));
+            } else {
+                sid_ssp_destroy(static_cast<sid_ssp_t*>(entry.second.handle));
+            }
+        }
+    }
+
     json handle(const json& cmd) {
         const std::string name = cmd.value("command", "");
         if (name == "sid_create") return handleCreate(cmd.value("params", json::object()));
@@ -70,9 +79,11 @@ public:
         if (name == "sid_get_diagram_json") return handleGetDiagramJson(cmd.value("params", json::object()));
         if (name == "sid_rewrite") return handleRewrite(cmd.value("params", json::object()));
         if (name == "sid_rewrite_events") return handleEvents(cmd.value("params", json::object()));
+        if (name == "sid_rewrite_log") return handleEventLog(cmd.value("params", json::object()));
         if (name == "sid_wrapper_apply_motion") return handleApplyMotion(cmd.value("params", json::object()));
         if (name == "sid_wrapper_metrics") return handleWrapperMetrics(cmd.value("params", json::object()));
         if (name == "sid_run") return handleRun(cmd.value("params", json::object())); // SSP steps
+        if (name == "sid_batch") return handleBatch(cmd.value("params", json::object()));
         return error(name, "Unknown command", "UNKNOWN_COMMAND");
     }
 
@@ -231,22 +242,8 @@ private:
         if (p.contains("mode")) metadata["mode"] = p["mode"];
         if (p.contains("epsilon")) metadata["epsilon"] = p["epsilon"];
 
-        bool applied = sid_apply_rewrite(static_cast<sid_engine*>(it->second.handle), pattern.c_str(), replacement.c_str(), rule_id.c_str());
-        const char* msg = sid_last_rewrite_message(static_cast<sid_engine*>(it->second.handle));
-        std::string message = msg ? msg : "";
-
-        // record event
-        Event ev{};
-        ev.event_id = static_cast<uint64_t>(it->second.events.size());
-        ev.rule_id = rule_id;
-        ev.applied = applied;
-        ev.message = message;
-        ev.metadata = metadata;
-        ev.timestamp = now_seconds();
-        it->second.events.push_back(ev);
-        it->second.wrapper.rewrite_calls++;
-        if (applied) it->second.wrapper.rewrites_applied++;
-
+        std::string message;
+        const bool applied = rewrite(it->second, pattern, replacement, rule_id, metadata, message);
         json res = {{"engine_id", id}, {"rule_id", rule_id}, {"applied", applied}, {"message", message}};
         if (!metadata.empty()) res["rule_metadata"] = metadata;
         return success("sid_rewrite", res);
@@ -254,20 +251,33 @@ private:
 
     json handleEvents(const json& p) {
         const std::string id = p.value("engine_id", "");
-        size_t cursor = static_cast<size_t>(p.value("cursor", 0));
+        uint64_t cursor = p.value("cursor", static_cast<uint64_t>(0));
         size_t limit = static_cast<size_t>(p.value("limit", 100));
         auto it = engines_.find(id);
         if (it == engines_.end()) return error("sid_rewrite_events", "engine not found", "ENGINE_NOT_FOUND");
-        auto& evs = it->second.events;
-        if (cursor > evs.size()) cursor = evs.size();
-        size_t end = evs.size();
-        if (limit > 0 && cursor + limit < end) end = cursor + limit;
+        const auto& log = it->second.events;
+        std::vector<dase::SidEventLog::Event> evs;
+        const uint64_t next_cursor = log.page(cursor, limit, evs);
         json out = json::array();
-        for (size_t i = cursor; i < end; ++i) {
-            const auto& ev = evs[i];
+        for (const auto& ev : evs) {
             out.push_back({{"event_id", ev.event_id}, {"rule_id", ev.rule_id}, {"applied", ev.applied}, {"message", ev.message}, {"timestamp", ev.timestamp}, {"metadata", ev.metadata}});
         }
-        return success("sid_rewrite_events", {{"engine_id", id}, {"events", out}, {"next_cursor", cursor + out.size()}});
+        return success("sid_rewrite_events", {{"engine_id", id}, {"events", out}, {"next_cursor", next_cursor},
+                                              {"first_event_id", log.firstId()}, {"dropped", cursor < log.firstId()}});
+    }
+
+    json handleEventLog(const json& p) {
+        const std::string id = p.value("engine_id", "");
+        auto it = engines_.find(id);
+        if (it == engines_.end()) return error("sid_rewrite_log", "engine not found", "ENGINE_NOT_FOUND");
+        auto& log = it->second.events;
+        dase::SidEventLog::Options options = log.options();
+        std::string message;
+        if (!dase::SidEventLog::parseOptions(p, options, message)) return error("sid_rewrite_log", message, "INVALID_PARAMETER");
+        log.configure(options);
+        json res = log.optionsJson();
+        res["engine_id"] = id;
+        return success("sid_rewrite_log", res);
     }
 
     json handleApplyMotion(const json& p) {
@@ -277,11 +287,54 @@ private:
         if (it == engines_.end() || it->second.type != EngineEntry::Type::Ternary) {
             return error("sid_wrapper_apply_motion", "engine not found or not sid_ternary", "ENGINE_NOT_FOUND");
         }
-        auto& entry = it->second;
+        applyMotion(it->second, max_events);
+        return wrapperMetricsResponse("sid_wrapper_apply_motion", id, it->second.wrapper);
+    }
+
+    json handleWrapperMetrics(const json& p) {
+        const std::string id = p.value("engine_id", "");
+        auto it = engines_.find(id);
+        if (it == engines_.end() || it->second.type != EngineEntry::Type::Ternary) {
+            return error("sid_wrapper_metrics", "engine not found or not sid_ternary", "ENGINE_NOT_FOUND");
+        }
+        return wrapperMetricsResponse("sid_wrapper_metrics", id, it->second.wrapper);
+    }
+
+    json handleRun(const json& p) {
+        const std::string id = p.value("engine_id", "");
+        int steps = p.value("steps", 1);
+        auto it = engines_.find(id);
+        if (it == engines_.end() || it->second.type != EngineEntry::Type::SSP) {
+            return error("sid_run", "engine not found or not sid_ssp", "ENGINE_NOT_FOUND");
+        }
+        auto* ssp = static_cast<sid_ssp_t*>(it->second.handle);
+        for (int i = 0; i < steps; ++i) sid_ssp_commit_step(ssp);
+        it->second.ssp_steps += static_cast<uint64_t>(steps);
+        return success("sid_run", {{"engine_id", id}, {"steps_completed", steps}, {"total_steps", it->second.ssp_steps}});
+    }
+
+    // Apply one rewrite and log it for semantic motion
+    bool rewrite(EngineEntry& entry, const std::string& pattern, const std::string& replacement,
+                 const std::string& rule_id, const json& metadata, std::string& message) {
+        auto* h = static_cast<sid_engine*>(entry.handle);
+        const bool applied = sid_apply_rewrite(h, pattern.c_str(), replacement.c_str(), rule_id.c_str());
+        const char* msg = sid_last_rewrite_message(h);
+        message = msg ? msg : "";
+
+        entry.events.record(rule_id, applied, message, metadata, now_seconds());
+        entry.wrapper.rewrite_calls++;
+        if (applied) entry.wrapper.rewrites_applied++;
+        return applied;
+    }
+
+    // Semantic motion for the logged events from the wrapper's cursor on
+    // (at most max_events of them, 0 = all)
+    void applyMotion(EngineEntry& entry, size_t max_events) {
         auto& w = entry.wrapper;
-        auto& evs = entry.events;
-        size_t start = w.event_cursor;
-        size_t end = evs.size();
+        const auto& evs = entry.events;
+        // event_cursor is the next event ID; events the log dropped are skipped
+        uint64_t start = std::max<uint64_t>(w.event_cursor, evs.firstId());
+        uint64_t end = evs.nextId();
         if (max_events > 0 && start + max_events < end) end = start + max_events;
 
         auto apply_motion = [&](double eps, const std::string& rule_id) {
@@ -306,9 +359,9 @@ private:
             w.last_motion = {{"rule_id", rule_id}, {"applied", true}, {"reason", "applied"}};
         };
 
-        for (size_t i = start; i < end; ++i) {
-            const auto& ev = evs[i];
-            w.event_cursor = i + 1;
+        for (uint64_t i = start; i < end; ++i) {
+            const auto ev = evs.at(i);
+            w.event_cursor = static_cast<size_t>(i + 1);
             bool semantic_motion = false;
             double epsilon = 0.0;
             if (ev.metadata.is_object()) {
@@ -328,35 +381,139 @@ private:
                 apply_motion(epsilon, ev.rule_id);
             }
         }
+    }
 
-        return wrapperMetricsResponse("sid_wrapper_apply_motion", id, w);
+    /**
+     * A whole scripted scenario in one command: on `engine_id`, or on a
+     * sid_ternary engine made from the sid_create params (destroyed after
+     * unless keep_engine), load diagram_expr / diagram / diagram_json,
+     * apply `rules` in order `repeat` times (semantic motion after each
+     * unless motion is false), and sample metrics after the rewrites listed
+     * in `checkpoints` (1-based; 0 = before the first), every
+     * checkpoint_every rewrites, and at the end.  Results are columnar:
+     * `applied` is one '0'/'1' per rewrite, `metrics` one array per value.
+     */
+    json handleBatch(const json& p) {
+        std::string id = p.value("engine_id", "");
+        const bool owned = id.empty();
+        if (owned) {
+            json params = p;
+            params["engine_type"] = "sid_ternary";
+            json created = handleCreate(params);
+            if (created["status"] != "success") {
+                created["command"] = "sid_batch";
+                return created;
+            }
+            id = created["result"]["engine_id"].get<std::string>();
+        }
+        json res = runBatch(id, p);
+        if (owned && !p.value("keep_engine", false)) {
+            handleDestroy({{"engine_id", id}});
+        }
+        return res;
     }
 
-    json handleWrapperMetrics(const json& p) {
-        const std::string id = p.value("engine_id", "");
+    json runBatch(const std::string& id, const json& p) {
         auto it = engines_.find(id);
         if (it == engines_.end() || it->second.type != EngineEntry::Type::Ternary) {
-            return error("sid_wrapper_metrics", "engine not found or not sid_ternary", "ENGINE_NOT_FOUND");
+            return error("sid_batch", "engine not found or not sid_ternary", "ENGINE_NOT_FOUND");
         }
-        return wrapperMetricsResponse("sid_wrapper_metrics", id, it->second.wrapper);
-    }
+        EngineEntry& entry = it->second;
+        auto* h = static_cast<sid_engine*>(entry.handle);
 
-    json handleRun(const json& p) {
-        const std::string id = p.value("engine_id", "");
-        int steps = p.value("steps", 1);
-        auto it = engines_.find(id);
-        if (it == engines_.end() || it->second.type != EngineEntry::Type::SSP) {
-            return error("sid_run", "engine not found or not sid_ssp", "ENGINE_NOT_FOUND");
+        if (p.contains("diagram_expr")) {
+            const std::string expr = p.value("diagram_expr", "");
+            if (!sid_set_diagram_expr(h, expr.c_str(), p.value("rule_id", "init").c_str())) {
+                return error("sid_batch", "diagram_expr failed: " + std::string(sid_last_rewrite_message(h)), "EXECUTION_FAILED");
+            }
+        } else if (p.contains("diagram") || p.contains("diagram_json")) {
+            const std::string text = p.contains("diagram_json") && p["diagram_json"].is_string()
+                                         ? p["diagram_json"].get<std::string>() : p.value("diagram", json::object()).dump();
+            if (!sid_set_diagram_json(h, text.c_str())) {
+                return error("sid_batch", "diagram failed: " + std::string(sid_last_rewrite_message(h)), "EXECUTION_FAILED");
+            }
         }
-        auto* ssp = static_cast<sid_ssp_t*>(it->second.handle);
-        for (int i = 0; i < steps; ++i) sid_ssp_commit_step(ssp);
-        it->second.ssp_steps += static_cast<uint64_t>(steps);
-        return success("sid_run", {{"engine_id", id}, {"steps_completed", steps}, {"total_steps", it->second.ssp_steps}});
+
+        struct Rule {
+            std::string pattern, replacement, rule_id;
+            json metadata;
+        };
+        std::vector<Rule> rules;
+        for (const auto& r : p.value("rules", json::array())) {
+            if (!r.is_object()) return error("sid_batch", "rules must be objects", "INVALID_PARAMETER");
+            Rule rule{r.value("pattern", ""), r.value("replacement", ""), r.value("rule_id", "rw"),
+                      r.value("rule_metadata", json::object())};
+            if (rule.pattern.empty() || rule.replacement.empty()) {
+                return error("sid_batch", "each rule needs pattern and replacement", "MISSING_PARAMETER");
+            }
+            if (r.contains("mode")) rule.metadata["mode"] = r["mode"];
+            if (r.contains("epsilon")) rule.metadata["epsilon"] = r["epsilon"];
+            rules.push_back(std::move(rule));
+        }
+        const int64_t repeat = p.value("repeat", int64_t(1));
+        const int64_t every = p.value("checkpoint_every", int64_t(0));
+        if (repeat < 0 || every < 0) return error("sid_batch", "repeat / checkpoint_every must be >= 0", "INVALID_PARAMETER");
+        std::vector<uint64_t> marks;
+        for (const auto& m : p.value("checkpoints", json::array())) {
+            if (!m.is_number_unsigned()) return error("sid_batch", "checkpoints must be non-negative integers", "INVALID_PARAMETER");
+            marks.push_back(m.get<uint64_t>());
+        }
+        std::sort(marks.begin(), marks.end());
+        const bool motion = p.value("motion", true);
+
+        json metrics = {{"step", json::array()}, {"I_mass", json::array()}, {"N_mass", json::array()},
+                        {"U_mass", json::array()}, {"is_conserved_wrapper", json::array()},
+                        {"engine_I_mass", json::array()}, {"engine_N_mass", json::array()},
+                        {"engine_U_mass", json::array()}, {"rewrites_applied", json::array()},
+                        {"motion_applied_count", json::array()}, {"motion_refused_count", json::array()}};
+        const WrapperState& w = entry.wrapper;
+        auto sample = [&](uint64_t step) {
+            metrics["step"].push_back(step);
+            metrics["I_mass"].push_back(w.I_mass);
+            metrics["N_mass"].push_back(w.N_mass);
+            metrics["U_mass"].push_back(w.U_mass);
+            metrics["is_conserved_wrapper"].push_back(wrapperConserved(w));
+            metrics["engine_I_mass"].push_back(sid_get_I_mass(h));
+            metrics["engine_N_mass"].push_back(sid_get_N_mass(h));
+            metrics["engine_U_mass"].push_back(sid_get_U_mass(h));
+            metrics["rewrites_applied"].push_back(w.rewrites_applied);
+            metrics["motion_applied_count"].push_back(w.motion_applied_count);
+            metrics["motion_refused_count"].push_back(w.motion_refused_count);
+        };
+
+        size_t next_mark = 0;
+        auto due = [&](uint64_t step) {
+            bool hit = every > 0 && step > 0 && step % static_cast<uint64_t>(every) == 0;
+            for (; next_mark < marks.size() && marks[next_mark] <= step; ++next_mark) {
+                hit = hit || marks[next_mark] == step;
+            }
+            return hit;
+        };
+
+        std::string applied;
+        uint64_t step = 0;
+        std::string message;
+        if (due(0)) sample(0);
+        for (int64_t pass = 0; pass < repeat; ++pass) {
+            for (const Rule& rule : rules) {
+                const bool ok = rewrite(entry, rule.pattern, rule.replacement, rule.rule_id, rule.metadata, message);
+                if (motion) applyMotion(entry, 0);
+                applied.push_back(ok ? '1' : '0');
+                if (due(++step)) sample(step);
+            }
+        }
+        if (metrics["step"].empty() || metrics["step"].back() != step) sample(step);
+
+        return success("sid_batch", {{"engine_id", id}, {"steps", step}, {"applied", applied}, {"metrics", metrics}});
     }
 
-    json wrapperMetricsResponse(const std::string& cmd, const std::string& id, const WrapperState& w) {
+    static bool wrapperConserved(const WrapperState& w) {
         double total = w.I_mass + w.N_mass + w.U_mass;
-        bool conserved = std::abs(total - 1.0) < 1e-9 && w.I_mass >= -1e-12 && w.N_mass >= -1e-12 && w.U_mass >= -1e-12;
+        return std::abs(total - 1.0) < 1e-9 && w.I_mass >= -1e-12 && w.N_mass >= -1e-12 && w.U_mass >= -1e-12;
+    }
+
+    json wrapperMetricsResponse(const std::string& cmd, const std::string& id, const WrapperState& w) {
+        const bool conserved = wrapperConserved(w);
         json res = {
             {"engine_id", id},
             {"I_mass", w.I_mass},
@@ -382,20 +539,54 @@ private:
     }
 };
 
-int main() {
+static std::string handleLine(SidCli& cli, const std::string& line) {
+    try {
+        auto cmd = json::parse(line);
+        return cli.handle(cmd).dump();
+    } catch (const std::exception& e) {
+        json resp = {{"status", "error"}, {"error", std::string("parse/exec error: ") + e.what()}, {"error_code", "INTERNAL_ERROR"}, {"execution_time_ms", 0}};
+        return resp.dump();
+    }
+}
+
+// --serve=<endpoint>: each connection is a session with its own SidCli, so
+// engine IDs and engines are per client and released on disconnect
+class SidSession : public dase::LineSession {
+public:
+    void onLine(const std::string& line, dase::LineWriter& out) override {
+        out.writeLine(handleLine(cli_, line));
+    }
+
+private:
+    SidCli cli_;
+};
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.compare(0, 8, "--serve=") != 0) continue;
+
+        dase::LineEndpoint endpoint;
+        dase::LineServer server;
+        std::string error;
+        if (!dase::LineEndpoint::parse(arg.substr(8), endpoint, error) || !server.listen(endpoint, error)) {
+            std::cerr << "FATAL: " << error << std::endl;
+            return 1;
+        }
+        if (endpoint.kind == dase::LineEndpoint::Kind::Tcp) {
+            endpoint.port = server.port();
+        }
+        std::cerr << "sid_cli serving on " << endpoint.describe() << std::endl;
+        server.serve([] { return std::make_unique<SidSession>(); });
+        return 0;
+    }
+
     std::ios::sync_with_stdio(false);
     SidCli cli;
     std::string line;
     while (std::getline(std::cin, line)) {
         if (line.empty()) continue;
-        try {
-            auto cmd = json::parse(line);
-            auto resp = cli.handle(cmd);
-            std::cout << resp.dump() << std::endl;
-        } catch (const std::exception& e) {
-            json resp = {{"status", "error"}, {"error", std::string("parse/exec error: ") + e.what()}, {"error_code", "INTERNAL_ERROR"}, {"execution_time_ms", 0}};
-            std::cout << resp.dump() << std::endl;
-        }
+        std::cout << handleLine(cli, line) << std::endl;
     }
     return 0;
 }